@@ -293,6 +293,146 @@ float4 AreaSampling(float3 uvw, float gamma)
 	return avg_color / (area_corners + area_edges + area_center);
 }
 
+/***** Edge Adaptive Upscaling *****/
+
+// Based on the EASU pass of AMD FidelityFX Super Resolution 1.0, MIT license.
+// https://github.com/GPUOpen-Effects/FidelityFX-FSR
+// A 12 tap Lanczos like filter, which is stretched along the local edge direction
+// and shortened across it, so that edges stay sharp without adding ringing.
+// Only meant for upscaling.
+
+// Accumulates the edge direction and length of one of the 4 bilinear quads around the sample.
+//    a
+//  b c d
+//    e
+void EasuSetDirection(inout float2 dir, inout float len, float w,
+                      float la, float lb, float lc, float ld, float le)
+{
+	float dc = ld - lc;
+	float cb = lc - lb;
+	float len_x = max(abs(dc), abs(cb));
+	len_x = len_x > 0.0 ? 1.0 / len_x : 0.0;
+	float dir_x = ld - lb;
+	len_x = clamp(abs(dir_x) * len_x, 0.0, 1.0);
+	dir.x += dir_x * w;
+	len += len_x * len_x * w;
+
+	float ec = le - lc;
+	float ca = lc - la;
+	float len_y = max(abs(ec), abs(ca));
+	len_y = len_y > 0.0 ? 1.0 / len_y : 0.0;
+	float dir_y = le - la;
+	len_y = clamp(abs(dir_y) * len_y, 0.0, 1.0);
+	dir.y += dir_y * w;
+	len += len_y * len_y * w;
+}
+
+// Adds a tap weighted by the rotated and scaled approximation of the Lanczos 2 kernel.
+void EasuTap(inout float4 color_sum, inout float weight_sum, float2 offset, float2 dir,
+             float2 len2, float lob, float clp, float4 color)
+{
+	float2 v = float2(offset.x * dir.x + offset.y * dir.y, offset.y * dir.x - offset.x * dir.y);
+	v *= len2;
+	float d2 = min(dot(v, v), clp);
+	// (25/16 * (2/5 * x^2 - 1)^2 - (25/16 - 1)) * (1/4 * x^2 - 1)^2, with a variable lobe
+	float wb = 2.0 / 5.0 * d2 - 1.0;
+	float wa = lob * d2 - 1.0;
+	wb *= wb;
+	wa *= wa;
+	wb = 25.0 / 16.0 * wb - (25.0 / 16.0 - 1.0);
+	float w = wb * wa;
+	color_sum += color * w;
+	weight_sum += w;
+}
+
+float EasuLuma(float4 color)
+{
+	return color.r * 0.5 + color.b * 0.5 + color.g;
+}
+
+float4 EasuSample(float3 uvw, float gamma)
+{
+	float2 pixel = (uvw.xy * GetResolution()) - 0.5;
+	float2 int_pixel = floor(pixel);
+	float2 pp = pixel - int_pixel;
+
+	// 12 taps around the sample, f is the closest top left one
+	//    b c
+	//  e f g h
+	//  i j k l
+	//    n o
+	float4 b = QuickSampleByPixel(int_pixel + float2(+0.5, -0.5), uvw.z, gamma);
+	float4 c = QuickSampleByPixel(int_pixel + float2(+1.5, -0.5), uvw.z, gamma);
+	float4 e = QuickSampleByPixel(int_pixel + float2(-0.5, +0.5), uvw.z, gamma);
+	float4 f = QuickSampleByPixel(int_pixel + float2(+0.5, +0.5), uvw.z, gamma);
+	float4 g = QuickSampleByPixel(int_pixel + float2(+1.5, +0.5), uvw.z, gamma);
+	float4 h = QuickSampleByPixel(int_pixel + float2(+2.5, +0.5), uvw.z, gamma);
+	float4 i = QuickSampleByPixel(int_pixel + float2(-0.5, +1.5), uvw.z, gamma);
+	float4 j = QuickSampleByPixel(int_pixel + float2(+0.5, +1.5), uvw.z, gamma);
+	float4 k = QuickSampleByPixel(int_pixel + float2(+1.5, +1.5), uvw.z, gamma);
+	float4 l = QuickSampleByPixel(int_pixel + float2(+2.5, +1.5), uvw.z, gamma);
+	float4 n = QuickSampleByPixel(int_pixel + float2(+0.5, +2.5), uvw.z, gamma);
+	float4 o = QuickSampleByPixel(int_pixel + float2(+1.5, +2.5), uvw.z, gamma);
+
+	float bl = EasuLuma(b);
+	float cl = EasuLuma(c);
+	float el = EasuLuma(e);
+	float fl = EasuLuma(f);
+	float gl = EasuLuma(g);
+	float hl = EasuLuma(h);
+	float il = EasuLuma(i);
+	float jl = EasuLuma(j);
+	float kl = EasuLuma(k);
+	float ll = EasuLuma(l);
+	float nl = EasuLuma(n);
+	float ol = EasuLuma(o);
+
+	// Edge direction and length, bilinearly weighted between the 4 quads.
+	float2 dir = float2(0.0, 0.0);
+	float len = 0.0;
+	EasuSetDirection(dir, len, (1.0 - pp.x) * (1.0 - pp.y), bl, el, fl, gl, jl);
+	EasuSetDirection(dir, len, pp.x * (1.0 - pp.y), cl, fl, gl, hl, kl);
+	EasuSetDirection(dir, len, (1.0 - pp.x) * pp.y, fl, il, jl, kl, nl);
+	EasuSetDirection(dir, len, pp.x * pp.y, gl, jl, kl, ll, ol);
+
+	float dir_r = dot(dir, dir);
+	if (dir_r < 1.0 / 32768.0)
+		dir = float2(1.0, 0.0);
+	else
+		dir *= inversesqrt(dir_r);
+
+	// Shape the length: 0 on flat areas, 1 on edges
+	len = len * 0.5;
+	len *= len;
+
+	// Stretch the kernel along the edge, and squeeze it across it
+	float stretch = dot(dir, dir) / max(abs(dir.x), abs(dir.y));
+	float2 len2 = float2(1.0 + (stretch - 1.0) * len, 1.0 - 0.5 * len);
+	// Go from a Lanczos 2 lobe on flat areas to a sharper one on edges
+	float lob = 0.5 + ((1.0 / 4.0 - 0.04) - 0.5) * len;
+	float clp = 1.0 / lob;
+
+	float4 color_sum = float4(0.0, 0.0, 0.0, 0.0);
+	float weight_sum = 0.0;
+	EasuTap(color_sum, weight_sum, float2(+0.0, -1.0) - pp, dir, len2, lob, clp, b);
+	EasuTap(color_sum, weight_sum, float2(+1.0, -1.0) - pp, dir, len2, lob, clp, c);
+	EasuTap(color_sum, weight_sum, float2(-1.0, +1.0) - pp, dir, len2, lob, clp, i);
+	EasuTap(color_sum, weight_sum, float2(+0.0, +1.0) - pp, dir, len2, lob, clp, j);
+	EasuTap(color_sum, weight_sum, float2(+0.0, +0.0) - pp, dir, len2, lob, clp, f);
+	EasuTap(color_sum, weight_sum, float2(-1.0, +0.0) - pp, dir, len2, lob, clp, e);
+	EasuTap(color_sum, weight_sum, float2(+1.0, +1.0) - pp, dir, len2, lob, clp, k);
+	EasuTap(color_sum, weight_sum, float2(+2.0, +1.0) - pp, dir, len2, lob, clp, l);
+	EasuTap(color_sum, weight_sum, float2(+2.0, +0.0) - pp, dir, len2, lob, clp, h);
+	EasuTap(color_sum, weight_sum, float2(+1.0, +0.0) - pp, dir, len2, lob, clp, g);
+	EasuTap(color_sum, weight_sum, float2(+1.0, +2.0) - pp, dir, len2, lob, clp, o);
+	EasuTap(color_sum, weight_sum, float2(+0.0, +2.0) - pp, dir, len2, lob, clp, n);
+
+	// Remove ringing by clamping to the 4 nearest pixels
+	float4 min4 = min(min(f, g), min(j, k));
+	float4 max4 = max(max(f, g), max(j, k));
+	return clamp(color_sum / weight_sum, min4, max4);
+}
+
 /***** Main Functions *****/
 
 // Returns an accurate (gamma corrected) sample of a gamma space space texture.
@@ -334,6 +474,14 @@ float4 LinearGammaCorrectedSample(float gamma)
 	{
 		color = BicubicSample(uvw, gamma, CUBIC_COEFF_GEN(0.0, 0.0));
 	}
+	else if (resampling_method == 9) // Edge Adaptive
+	{
+		// The filter doesn't handle downscaling, which area sampling does best
+		if (any(lessThan(GetWindowResolution(), GetResolution())))
+			color = AreaSampling(uvw, gamma);
+		else
+			color = EasuSample(uvw, gamma);
+	}
 
 	return color;
 }
@@ -177,11 +177,17 @@ private:
   // size (in samples)
   std::vector<std::vector<cplx>> signal;
 
+  // the channel allocation map of the setup, and for every channel the index
+  // of its L/C/R phase, looked up once by Init() instead of for every bin
+  const std::vector<std::vector<float *>> *alloc;
+  std::vector<int> phase_index;
+
   // helper functions
   inline float sqr(double x);
   inline double amplitude(const cplx &x);
   inline double phase(const cplx &x);
   inline cplx polar(double a, double p);
+  inline cplx phasor(const cplx &x);
   inline float min(double a, double b);
   inline float max(double a, double b);
   inline float clamp(double x);
@@ -53,6 +53,10 @@ void DPL2FSDecoder::Init(channel_setup chsetup, unsigned int blsize,
     forward = kiss_fftr_alloc(N, 0, 0, 0);
     inverse = kiss_fftr_alloc(N, 1, 0, 0);
     C = static_cast<unsigned int>(chn_alloc[setup].size());
+    alloc = &chn_alloc[setup];
+    phase_index.resize(C);
+    for (unsigned int c = 0; c < C; c++)
+      phase_index[c] = 1 + static_cast<int>(sign(chn_xsf[setup][c]));
 
     // Allocate per-channel buffers
     outbuf.resize((N + N / 2) * C);
@@ -129,6 +133,11 @@ inline double DPL2FSDecoder::phase(const cplx &x) {
 inline cplx DPL2FSDecoder::polar(double a, double p) {
   return cplx(a * cos(p), a * sin(p));
 }
+// polar(1, phase(x)), without the trigonometric functions
+inline cplx DPL2FSDecoder::phasor(const cplx &x) {
+  double a = sqrt(x.real() * x.real() + x.imag() * x.imag());
+  return a == 0 ? cplx(1, 0) : x / a;
+}
 inline float DPL2FSDecoder::min(double a, double b) {
   return static_cast<float>(a < b ? a : b);
 }
@@ -193,10 +202,8 @@ void DPL2FSDecoder::buffered_decode(float *input) {
 
     // get total signal amplitude
     double amp_total = sqrt(ampL * ampL + ampR * ampR);
-    // and total L/C/R signal phases
-    double phase_of[] = {
-        phaseL, atan2(lf[f].imag() + rf[f].imag(), lf[f].real() + rf[f].real()),
-        phaseR};
+    // and total L/C/R signal phases, as unit phasors
+    cplx phase_of[] = {phasor(lf[f]), phasor(lf[f] + rf[f]), phasor(rf[f])};
     // compute 2d channel map indexes p/q and update x/y to fractional offsets
     // in the map grid
     int p = map_to_grid(x), q = map_to_grid(y);
@@ -205,11 +212,12 @@ void DPL2FSDecoder::buffered_decode(float *input) {
       // look up channel map at respective position (with bilinear
       // interpolation) and build the
       // signal
-      std::vector<float *> &a = chn_alloc[setup][c];
-      signal[c][f] = polar(
-          amp_total * ((1 - x) * (1 - y) * a[q][p] + x * (1 - y) * a[q][p + 1] +
-                       (1 - x) * y * a[q + 1][p] + x * y * a[q + 1][p + 1]),
-          phase_of[1 + static_cast<int>(sign(chn_xsf[setup][c]))]);
+      const std::vector<float *> &a = (*alloc)[c];
+      signal[c][f] =
+          amp_total *
+          ((1 - x) * (1 - y) * a[q][p] + x * (1 - y) * a[q][p + 1] +
+           (1 - x) * y * a[q + 1][p] + x * y * a[q + 1][p + 1]) *
+          phase_of[phase_index[c]];
     }
 
     // optionally redirect bass
@@ -219,7 +227,7 @@ void DPL2FSDecoder::buffered_decode(float *input) {
           f < lo_cut ? 1
                      : 0.5 * (1 + cos(pi * (f - lo_cut) / (hi_cut - lo_cut)));
       // assign LFE channel
-      signal[C - 1][f] = lfe_level * polar(amp_total, phase_of[1]);
+      signal[C - 1][f] = lfe_level * amp_total * phase_of[1];
       // subtract the signal from the other channels
       for (unsigned int c = 0; c < C - 1; c++)
         signal[c][f] *= (1 - lfe_level);
@@ -232,6 +240,9 @@ void DPL2FSDecoder::buffered_decode(float *input) {
   memset(&outbuf[C * N], 0, C * 4 * N / 2);
   // backtransform each channel and overlap-add
   for (unsigned int c = 0; c < C; c++) {
+    // without bass redirection, the LFE channel is silent
+    if (c == C - 1 && !use_lfe)
+      continue;
     // back-transform into time domain
     kiss_fftri(inverse, (kiss_fft_cpx *)&signal[c][0], &dst[0]);
     // add the result to the last 2/3 of the output buffer, windowed (and
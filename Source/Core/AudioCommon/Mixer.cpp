@@ -140,6 +140,12 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   s[1] = read_buffer((indexR - 2) & INDEX_MASK);
   s[0] = (s[0] * rvolume) >> 8;
   s[1] = (s[1] * lvolume) >> 8;
+
+  // Most fifos (the GBA ones, for instance) sit idle with silence as their last sample. Adding
+  // that to every output sample would change nothing, so skip it.
+  if (s[0] == 0 && s[1] == 0)
+    currentSample = numSamples * 2;
+
   for (; currentSample < numSamples * 2; currentSample += 2)
   {
     int sampleR = std::clamp(s[0] + samples[currentSample + 0], -32767, 32767);
@@ -202,15 +208,26 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
   }
   else
   {
-    m_dma_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
+    const unsigned int dma_samples =
+        m_dma_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
     m_streaming_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
     m_wiimote_speaker_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
     m_skylander_portal_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
     for (auto& mixer : m_gba_mixers)
       mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
     m_is_stretching = false;
+
+    // Only count the first callback of a dropout, and not the ones before the game starts audio
+    const bool underrun = dma_samples < num_samples;
+    if (underrun && !m_dma_underrun)
+      g_perf_metrics.CountAudioUnderrun();
+    m_dma_underrun = underrun;
   }
 
+  // What is left in the DMA fifo plays after what was just handed to the backend
+  g_perf_metrics.CountAudioLatency(std::chrono::duration_cast<DT>(
+      DT_s(static_cast<double>(m_dma_mixer.AvailableSamples() + num_samples) / m_sampleRate)));
+
   return num_samples;
 }
 
@@ -107,6 +107,7 @@ private:
   unsigned int m_sampleRate;
 
   bool m_is_stretching = false;
+  bool m_dma_underrun = true;
   AudioCommon::AudioStretcher m_stretcher;
   AudioCommon::SurroundDecoder m_surround_decoder;
   std::array<short, MAX_SAMPLES * 2> m_scratch_buffer{};
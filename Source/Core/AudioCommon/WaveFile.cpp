@@ -5,6 +5,8 @@
 #include "AudioCommon/Mixer.h"
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -15,6 +17,7 @@
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 
@@ -93,11 +96,18 @@ bool WaveFileWriter::Start(const std::string& filename, u32 sample_rate_divisor)
   if (file.Tell() != 44)
     PanicAlertFmt("Wrong offset: {}", file.Tell());
 
+  write_buffer.reserve(WRITE_BUFFER_SIZE);
+  write_thread.Reset("WaveFileWriter",
+                     [this](std::vector<u8> data) { file.WriteBytes(data.data(), data.size()); });
+
   return true;
 }
 
 void WaveFileWriter::Stop()
 {
+  FlushWriteBuffer();
+  write_thread.Shutdown();
+
   file.Seek(4, File::SeekOrigin::Begin);
   Write(audio_size + 36);
 
@@ -117,6 +127,16 @@ void WaveFileWriter::Write4(const char* ptr)
   file.WriteBytes(ptr, 4);
 }
 
+void WaveFileWriter::FlushWriteBuffer()
+{
+  if (write_buffer.empty())
+    return;
+
+  write_thread.Push(std::move(write_buffer));
+  write_buffer = {};
+  write_buffer.reserve(WRITE_BUFFER_SIZE);
+}
+
 void WaveFileWriter::AddStereoSamplesBE(const short* sample_data, u32 count,
                                         u32 sample_rate_divisor, int l_volume, int r_volume)
 {
@@ -167,6 +187,10 @@ void WaveFileWriter::AddStereoSamplesBE(const short* sample_data, u32 count,
     current_sample_rate_divisor = sample_rate_divisor;
   }
 
-  file.WriteBytes(conv_buffer.data(), count * 4);
+  const u8* data = reinterpret_cast<const u8*>(conv_buffer.data());
+  write_buffer.insert(write_buffer.end(), data, data + count * 4);
   audio_size += count * 4;
+
+  if (write_buffer.size() >= WRITE_BUFFER_SIZE)
+    FlushWriteBuffer();
 }
@@ -9,15 +9,18 @@
 // The float variant will convert from -1.0-1.0 range and clamp.
 // Alternatively, AddSamplesBE for big endian wave data.
 // If Stop is not called when it destructs, the destructor will call Stop().
+// Samples are written to disk on a separate thread, so that adding them never waits for the disk.
 // ---------------------------------------------------------------------------------
 
 #pragma once
 
 #include <array>
 #include <string>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "Common/WorkQueueThread.h"
 
 class WaveFileWriter
 {
@@ -41,9 +44,12 @@ public:
 
 private:
   static constexpr size_t BUFFER_SIZE = 32 * 1024;
+  // About a second and a half of 48 kHz audio
+  static constexpr size_t WRITE_BUFFER_SIZE = 256 * 1024;
 
   void Write(u32 value);
   void Write4(const char* ptr);
+  void FlushWriteBuffer();
 
   File::IOFile file;
   std::string basename;
@@ -53,5 +59,9 @@ private:
   u32 current_sample_rate_divisor;
   std::array<short, BUFFER_SIZE> conv_buffer{};
 
+  // Samples waiting to be handed to write_thread, which owns the file while it is running
+  std::vector<u8> write_buffer;
+  Common::WorkQueueThread<std::vector<u8>> write_thread;
+
   bool skip_silence = false;
 };
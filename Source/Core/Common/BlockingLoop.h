@@ -3,10 +3,13 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <mutex>
 #include <thread>
 
+#include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
 
@@ -28,6 +31,19 @@ public:
     BlockAndGiveUp,
   };
 
+  struct Statistics
+  {
+    // How often the worker went to sleep and how often Wakeup() had to wake it up again.
+    u64 sleeps;
+    u64 wakeups;
+    // Total time between Wakeup() setting the event and the worker running again.
+    std::chrono::microseconds total_wakeup_latency;
+    // How often new work arrived while the worker was still spinning.
+    u64 spin_hits;
+    // The current spin duration chosen by adaptive spinning.
+    std::chrono::microseconds spin_duration;
+  };
+
   BlockingLoop() { m_stopped.Set(); }
   ~BlockingLoop() { Stop(StopMode::BlockAndGiveUp); }
   // Triggers to rerun the payload of the Run() function at least once again.
@@ -45,9 +61,31 @@ public:
       return;
 
     // Else as the worker thread may sleep now, we have to set the event.
+    m_wakeup_time.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
     m_new_work_event.Set();
   }
 
+  // By default, the worker busy loops after running out of work until AllowSleep() or Wait() is
+  // called. With adaptive spinning, it instead goes to sleep on its own once it has spun for a
+  // while without new work. The spin duration adapts between min and max: It grows when work
+  // tends to arrive shortly after going to sleep, and shrinks when spinning is wasted.
+  void SetAdaptiveSpinning(bool enabled, std::chrono::microseconds min,
+                           std::chrono::microseconds max)
+  {
+    m_min_spin_duration = min;
+    m_max_spin_duration = std::max(min, max);
+    SetSpinDuration(m_spin_duration.load());
+    m_adaptive_spinning = enabled;
+  }
+
+  Statistics GetStatistics() const
+  {
+    return {m_sleeps.load(std::memory_order_relaxed),
+            m_wakeups.load(std::memory_order_relaxed),
+            std::chrono::microseconds(m_total_wakeup_latency_us.load(std::memory_order_relaxed)),
+            m_spin_hits.load(std::memory_order_relaxed), m_spin_duration.load()};
+  }
+
   // Wait for a complete payload run after the last Wakeup() call.
   // If stopped, this returns immediately.
   void Wait()
@@ -129,11 +167,24 @@ public:
     // But a good implementation should call this before already.
     Prepare();
 
+    Clock::time_point spin_start{};
+    bool spinning = false;
+
     while (!m_shutdown.IsSet())
     {
       payload();
 
-      switch (m_running_state.load())
+      const int state = m_running_state.load();
+      if (spinning && state > STATE_DONE)
+      {
+        // New work came in while spinning.
+        spinning = false;
+        m_spin_hits.fetch_add(1, std::memory_order_relaxed);
+        if (m_adaptive_spinning)
+          OnSpinHit(Clock::now() - spin_start);
+      }
+
+      switch (state)
       {
       case STATE_NEED_EXECUTION:
         // We won't get notified while we are in the STATE_NEED_EXECUTION state, so maybe Wakeup was
@@ -162,7 +213,14 @@ public:
       case STATE_DONE:
         // We're done now. So time to check if we want to sleep or if we want to stay in a busy
         // loop.
-        if (m_may_sleep.TestAndClear())
+        if (!spinning)
+        {
+          spinning = true;
+          spin_start = Clock::now();
+        }
+
+        if (m_may_sleep.TestAndClear() ||
+            (m_adaptive_spinning && Clock::now() - spin_start >= m_spin_duration.load()))
         {
           // Try to set the sleeping state.
           if (m_running_state-- != STATE_DONE)
@@ -176,17 +234,40 @@ public:
         [[fallthrough]];
 
       case STATE_SLEEPING:
+      {
         // Just relax
+        spinning = false;
+        m_sleeps.fetch_add(1, std::memory_order_relaxed);
+        const Clock::time_point sleep_start = Clock::now();
+        bool woken;
         if (timeout > 0)
         {
-          m_new_work_event.WaitFor(std::chrono::milliseconds(timeout));
+          woken = m_new_work_event.WaitFor(std::chrono::milliseconds(timeout));
         }
         else
         {
           m_new_work_event.Wait();
+          woken = true;
+        }
+
+        if (woken)
+        {
+          const Clock::time_point now = Clock::now();
+          const Clock::time_point wakeup_time{
+              Clock::duration(m_wakeup_time.load(std::memory_order_relaxed))};
+          m_wakeups.fetch_add(1, std::memory_order_relaxed);
+          if (wakeup_time >= sleep_start)
+          {
+            m_total_wakeup_latency_us.fetch_add(
+                std::chrono::duration_cast<std::chrono::microseconds>(now - wakeup_time).count(),
+                std::memory_order_relaxed);
+          }
+          if (m_adaptive_spinning)
+            OnSleepEnded(now - sleep_start);
         }
         break;
       }
+      }
     }
 
     // Shutdown down, so get a safe state
@@ -233,6 +314,34 @@ public:
   void AllowSleep() { m_may_sleep.Set(); }
 
 private:
+  using Clock = std::chrono::steady_clock;
+
+  // Work arriving while spinning means the spin duration was long enough. Let it shrink slowly
+  // towards twice the time it took, so that variance in arrival times doesn't push us into sleep.
+  void OnSpinHit(Clock::duration waited)
+  {
+    const auto target = std::chrono::duration_cast<std::chrono::microseconds>(waited * 2);
+    const std::chrono::microseconds current = m_spin_duration.load();
+    if (target < current)
+      SetSpinDuration(current - (current - target) / 8);
+  }
+
+  // Waking up shortly after going to sleep means spinning a bit longer would have avoided the
+  // wakeup, while long sleeps mean the spinning before them was wasted.
+  void OnSleepEnded(Clock::duration slept)
+  {
+    const std::chrono::microseconds current = m_spin_duration.load();
+    if (slept < m_max_spin_duration.load())
+      SetSpinDuration(current + current / 4 + std::chrono::microseconds(1));
+    else
+      SetSpinDuration(current - current / 8);
+  }
+
+  void SetSpinDuration(std::chrono::microseconds duration)
+  {
+    m_spin_duration = std::clamp(duration, m_min_spin_duration.load(), m_max_spin_duration.load());
+  }
+
   std::mutex m_wait_lock;
   std::mutex m_prepare_lock;
 
@@ -253,5 +362,16 @@ private:
 
   Flag m_may_sleep;  // If this is set, we fall back from the busy loop to an event based
                      // synchronization.
+
+  std::atomic<bool> m_adaptive_spinning{false};
+  std::atomic<std::chrono::microseconds> m_min_spin_duration{std::chrono::microseconds{0}};
+  std::atomic<std::chrono::microseconds> m_max_spin_duration{std::chrono::microseconds{0}};
+  std::atomic<std::chrono::microseconds> m_spin_duration{std::chrono::microseconds{0}};
+
+  std::atomic<Clock::rep> m_wakeup_time{0};
+  std::atomic<u64> m_sleeps{0};
+  std::atomic<u64> m_wakeups{0};
+  std::atomic<u64> m_total_wakeup_latency_us{0};
+  std::atomic<u64> m_spin_hits{0};
 };
 }  // namespace Common
@@ -16,6 +16,7 @@
 #include <cstddef>
 #include <cstring>
 #include <deque>
+#include <functional>
 #include <list>
 #include <map>
 #include <optional>
@@ -46,17 +47,49 @@ public:
     Verify,
   };
 
+  // A region of memory which DoArrayByReference recorded instead of copying it into the buffer.
+  // It logically belongs at the given offset of the buffer.
+  struct Span
+  {
+    size_t offset;
+    const u8* data;
+    size_t size;
+  };
+
+  // Fills in the next region which was recorded as a span when saving. Returns false on failure.
+  using SpanReader = std::function<bool(u8* data, size_t size)>;
+
 private:
   u8** m_ptr_current;
+  u8* m_ptr_start;
   u8* m_ptr_end;
   Mode m_mode;
+  std::vector<Span>* m_spans = nullptr;
+  const SpanReader* m_span_reader = nullptr;
 
 public:
   PointerWrap(u8** ptr, size_t size, Mode mode)
-      : m_ptr_current(ptr), m_ptr_end(*ptr + size), m_mode(mode)
+      : m_ptr_current(ptr), m_ptr_start(*ptr), m_ptr_end(*ptr + size), m_mode(mode)
   {
   }
 
+  // In Write and Measure mode, regions passed to DoArrayByReference neither get copied into nor
+  // take up space in the buffer, and are appended to spans instead (when writing). The actual
+  // state is the buffer with every span inserted at its offset.
+  PointerWrap(u8** ptr, size_t size, Mode mode, std::vector<Span>* spans)
+      : PointerWrap(ptr, size, mode)
+  {
+    m_spans = spans;
+  }
+
+  // In Read mode, regions passed to DoArrayByReference are filled in by span_reader rather than
+  // read from the buffer, for loading the result of the constructor above.
+  PointerWrap(u8** ptr, size_t size, Mode mode, const SpanReader& span_reader)
+      : PointerWrap(ptr, size, mode)
+  {
+    m_span_reader = &span_reader;
+  }
+
   void SetMeasureMode() { m_mode = Mode::Measure; }
   void SetVerifyMode() { m_mode = Mode::Verify; }
   bool IsReadMode() const { return m_mode == Mode::Read; }
@@ -214,6 +247,31 @@ public:
     DoArray(arr, static_cast<u32>(N));
   }
 
+  // Like DoArray, but when this PointerWrap collects spans, the array is referenced rather than
+  // copied. It then needs to stay valid and unchanged until the spans have been consumed.
+  template <typename T, typename std::enable_if_t<std::is_trivially_copyable_v<T>, int> = 0>
+  void DoArrayByReference(T* x, u32 count)
+  {
+    if (m_span_reader)
+    {
+      if (IsReadMode() && !(*m_span_reader)(reinterpret_cast<u8*>(x), count * sizeof(T)))
+        SetMeasureMode();
+      return;
+    }
+
+    if (!m_spans || !(IsWriteMode() || IsMeasureMode()))
+    {
+      DoArray(x, count);
+      return;
+    }
+
+    if (IsWriteMode())
+    {
+      m_spans->push_back({static_cast<size_t>(*m_ptr_current - m_ptr_start),
+                          reinterpret_cast<const u8*>(x), count * sizeof(T)});
+    }
+  }
+
   // The caller is required to inspect the mode of this PointerWrap
   // and deal with the pointer returned from this function themself.
   [[nodiscard]] u8* DoExternal(u32& count)
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
@@ -39,12 +40,99 @@ struct CachedValue
   u64 config_version;
 };
 
+namespace detail
+{
+template <typename T, bool = std::is_trivially_copyable_v<T>>
+struct IsLockFreeCacheable : std::false_type
+{
+};
+
+template <typename T>
+struct IsLockFreeCacheable<T, true> : std::bool_constant<std::atomic<T>::is_always_lock_free>
+{
+};
+
+// Holds the cached value of a setting, which is read by every Config::Get call
+template <typename T, bool LockFree = IsLockFreeCacheable<T>::value>
+class CachedValueStorage
+{
+public:
+  CachedValueStorage() = default;
+  explicit CachedValueStorage(const T& value) : m_cached_value{value, 0} {}
+
+  CachedValue<T> Get() const
+  {
+    std::shared_lock lock(m_mutex);
+    return m_cached_value;
+  }
+
+  void Set(const CachedValue<T>& cached_value)
+  {
+    std::unique_lock lock(m_mutex);
+    if (m_cached_value.config_version < cached_value.config_version)
+      m_cached_value = cached_value;
+  }
+
+  void Reset(const CachedValue<T>& cached_value)
+  {
+    std::unique_lock lock(m_mutex);
+    m_cached_value = cached_value;
+  }
+
+private:
+  CachedValue<T> m_cached_value;
+  mutable std::shared_mutex m_mutex;
+};
+
+// For settings which fit in an atomic, like bools, numbers and enums, reads don't write to shared
+// memory at all, so threads reading the same setting don't slow each other down.
+template <typename T>
+class CachedValueStorage<T, true>
+{
+public:
+  CachedValueStorage() = default;
+  explicit CachedValueStorage(const T& value) : m_value(value) {}
+
+  CachedValue<T> Get() const
+  {
+    // The value is stored before the version is released, so the value read here is at least as
+    // new as the version. A newer value is fine, the version only decides when to refresh.
+    const u64 config_version = m_config_version.load(std::memory_order_acquire);
+    return {m_value.load(std::memory_order_relaxed), config_version};
+  }
+
+  void Set(const CachedValue<T>& cached_value)
+  {
+    std::lock_guard lock(m_set_mutex);
+    if (m_config_version.load(std::memory_order_relaxed) < cached_value.config_version)
+      Store(cached_value);
+  }
+
+  void Reset(const CachedValue<T>& cached_value)
+  {
+    std::lock_guard lock(m_set_mutex);
+    Store(cached_value);
+  }
+
+private:
+  void Store(const CachedValue<T>& cached_value)
+  {
+    m_value.store(cached_value.value, std::memory_order_relaxed);
+    m_config_version.store(cached_value.config_version, std::memory_order_release);
+  }
+
+  std::atomic<T> m_value;
+  std::atomic<u64> m_config_version = 0;
+  std::mutex m_set_mutex;
+};
+}  // namespace detail
+
 template <typename T>
 class Info
 {
 public:
   constexpr Info(const Location& location, const T& default_value)
-      : m_location{location}, m_default_value{default_value}, m_cached_value{default_value, 0}
+      : m_location{location}, m_default_value{default_value}, m_cached_value{default_value}
   {
   }
 
@@ -66,7 +154,7 @@ public:
   {
     m_location = other.GetLocation();
     m_default_value = other.GetDefaultValue();
-    m_cached_value = other.GetCachedValue();
+    m_cached_value.Reset(other.GetCachedValue());
     return *this;
   }
 
@@ -75,7 +163,7 @@ public:
   {
     m_location = std::move(other.m_location);
     m_default_value = std::move(other.m_default_value);
-    m_cached_value = std::move(other.m_cached_value);
+    m_cached_value.Reset(other.GetCachedValue());
     return *this;
   }
 
@@ -87,38 +175,31 @@ public:
   {
     m_location = other.GetLocation();
     m_default_value = static_cast<T>(other.GetDefaultValue());
-    m_cached_value = other.template GetCachedValueCasted<T>();
+    m_cached_value.Reset(other.template GetCachedValueCasted<T>());
     return *this;
   }
 
   constexpr const Location& GetLocation() const { return m_location; }
   constexpr const T& GetDefaultValue() const { return m_default_value; }
 
-  CachedValue<T> GetCachedValue() const
-  {
-    std::shared_lock lock(m_cached_value_mutex);
-    return m_cached_value;
-  }
+  CachedValue<T> GetCachedValue() const { return m_cached_value.Get(); }
 
   template <typename U>
   CachedValue<U> GetCachedValueCasted() const
   {
-    std::shared_lock lock(m_cached_value_mutex);
-    return CachedValue<U>{static_cast<U>(m_cached_value.value), m_cached_value.config_version};
+    const CachedValue<T> cached_value = m_cached_value.Get();
+    return CachedValue<U>{static_cast<U>(cached_value.value), cached_value.config_version};
   }
 
   void SetCachedValue(const CachedValue<T>& cached_value) const
   {
-    std::unique_lock lock(m_cached_value_mutex);
-    if (m_cached_value.config_version < cached_value.config_version)
-      m_cached_value = cached_value;
+    m_cached_value.Set(cached_value);
   }
 
 private:
   Location m_location;
   T m_default_value;
 
-  mutable CachedValue<T> m_cached_value;
-  mutable std::shared_mutex m_cached_value_mutex;
+  mutable detail::CachedValueStorage<T> m_cached_value;
 };
 }  // namespace Config
@@ -3,7 +3,10 @@
 
 #include "SHA1.h"
 
+#include <algorithm>
 #include <array>
+#include <cstring>
+#include <iterator>
 #include <memory>
 
 #include <mbedtls/sha1.h>
@@ -59,10 +62,18 @@ private:
 
 class BlockContext : public Context
 {
+public:
+  virtual void SetState(const State& state) = 0;
+  virtual State GetState() const = 0;
+
+  void ProcessBlocks(const u8* blocks, size_t num_blocks)
+  {
+    for (size_t i = 0; i < num_blocks; i++)
+      ProcessBlock(&blocks[i * BLOCK_LEN]);
+  }
+
 protected:
-  static constexpr size_t BLOCK_LEN = 64;
   static constexpr u32 K[4]{0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xca62c1d6};
-  static constexpr u32 H[5]{0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
 
   virtual void ProcessBlock(const u8* msg) = 0;
   virtual Digest GetDigest() = 0;
@@ -159,10 +170,21 @@ private:
 class ContextX64SHA1 final : public BlockContext
 {
 public:
-  ContextX64SHA1()
+  ContextX64SHA1() { SetState(INITIAL_STATE); }
+
+  virtual void SetState(const State& new_state) override
   {
-    state[0] = _mm_set_epi32(H[0], H[1], H[2], H[3]);
-    state[1] = _mm_set_epi32(H[4], 0, 0, 0);
+    state[0] = _mm_set_epi32(new_state[0], new_state[1], new_state[2], new_state[3]);
+    state[1] = _mm_set_epi32(new_state[4], 0, 0, 0);
+  }
+
+  virtual State GetState() const override
+  {
+    // The words are held in reverse order, with e in the highest lane of the second register
+    std::array<u32, 8> words;
+    _mm_storeu_si128((__m128i*)&words[0], state[0]);
+    _mm_storeu_si128((__m128i*)&words[4], state[1]);
+    return {words[3], words[2], words[1], words[0], words[7]};
   }
 
 private:
@@ -267,10 +289,20 @@ private:
 class ContextNeon final : public BlockContext
 {
 public:
-  ContextNeon()
+  ContextNeon() { SetState(INITIAL_STATE); }
+
+  virtual void SetState(const State& new_state) override
+  {
+    state.abcd = vld1q_u32(&new_state[0]);
+    state.e = new_state[4];
+  }
+
+  virtual State GetState() const override
   {
-    state.abcd = vld1q_u32(&H[0]);
-    state.e = H[4];
+    State words;
+    vst1q_u32(&words[0], state.abcd);
+    words[4] = state.e;
+    return words;
   }
 
 private:
@@ -362,7 +394,7 @@ private:
 
 #endif
 
-std::unique_ptr<Context> CreateContext()
+static std::unique_ptr<BlockContext> CreateHwContext()
 {
   if (cpu_info.bSHA1)
   {
@@ -376,9 +408,38 @@ std::unique_ptr<Context> CreateContext()
     return std::make_unique<ContextNeon>();
 #endif
   }
+  return nullptr;
+}
+
+std::unique_ptr<Context> CreateContext()
+{
+  if (auto ctx = CreateHwContext())
+    return ctx;
   return std::make_unique<ContextMbed>();
 }
 
+void ProcessBlocks(State* state, const u8* blocks, size_t num_blocks)
+{
+  if (num_blocks == 0)
+    return;
+
+  if (auto ctx = CreateHwContext())
+  {
+    ctx->SetState(*state);
+    ctx->ProcessBlocks(blocks, num_blocks);
+    *state = ctx->GetState();
+    return;
+  }
+
+  mbedtls_sha1_context ctx;
+  mbedtls_sha1_init(&ctx);
+  std::copy(state->begin(), state->end(), std::begin(ctx.state));
+  for (size_t i = 0; i < num_blocks; i++)
+    ASSERT(!mbedtls_internal_sha1_process(&ctx, &blocks[i * BLOCK_LEN]));
+  std::copy(std::begin(ctx.state), std::end(ctx.state), state->begin());
+  mbedtls_sha1_free(&ctx);
+}
+
 Digest CalculateDigest(const u8* msg, size_t len)
 {
   auto ctx = CreateContext();
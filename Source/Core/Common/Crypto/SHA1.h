@@ -30,6 +30,15 @@ public:
 
 std::unique_ptr<Context> CreateContext();
 
+// The hash of the blocks processed so far, for callers which have to keep it themselves instead
+// of holding on to a Context (like the IOS SHA engine, whose state is in emulated memory)
+using State = std::array<u32, 5>;
+static constexpr size_t BLOCK_LEN = 64;
+static constexpr State INITIAL_STATE{0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+
+// Hashes whole blocks into state. Padding the message is left to the caller.
+void ProcessBlocks(State* state, const u8* blocks, size_t num_blocks);
+
 Digest CalculateDigest(const u8* msg, size_t len);
 
 template <typename T>
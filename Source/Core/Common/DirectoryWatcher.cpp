@@ -0,0 +1,410 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/DirectoryWatcher.h"
+
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonFuncs.h"
+#include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+
+#if defined(_WIN32)
+#include <array>
+
+#include <Windows.h>
+
+#include "Common/StringUtil.h"
+#elif defined(__APPLE__)
+#include <CoreServices/CoreServices.h>
+#include <dispatch/dispatch.h>
+
+#include "Common/FileUtil.h"
+#elif defined(__linux__)
+#include <cerrno>
+#include <unordered_map>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace Common
+{
+#if defined(_WIN32)
+struct DirectoryWatcher::Impl
+{
+  struct WatchedDirectory
+  {
+    std::string path;
+    HANDLE handle = INVALID_HANDLE_VALUE;
+    OVERLAPPED overlapped{};
+    alignas(DWORD) std::array<u8, 16384> buffer;
+  };
+
+  explicit Impl(const Callback& callback) : m_callback(callback) {}
+
+  ~Impl()
+  {
+    if (m_port == nullptr)
+      return;
+
+    // A completion without a directory tells the thread to exit
+    PostQueuedCompletionStatus(m_port, 0, 0, nullptr);
+    m_thread.join();
+
+    for (const auto& directory : m_directories)
+    {
+      // The buffer can only be freed once the pending read has been cancelled
+      DWORD bytes;
+      if (CancelIoEx(directory->handle, &directory->overlapped))
+        GetOverlappedResult(directory->handle, &directory->overlapped, &bytes, TRUE);
+      CloseHandle(directory->handle);
+    }
+    CloseHandle(m_port);
+  }
+
+  bool Watch(const std::string& path)
+  {
+    auto directory = std::make_unique<WatchedDirectory>();
+    directory->path = path;
+    directory->handle =
+        CreateFileW(UTF8ToWString(path).c_str(), FILE_LIST_DIRECTORY,
+                    FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                    FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+    if (directory->handle == INVALID_HANDLE_VALUE)
+    {
+      WARN_LOG_FMT(COMMON, "Failed to open directory '{}' to watch it: {}", path,
+                   GetLastErrorString());
+      return false;
+    }
+
+    if (m_port == nullptr)
+    {
+      m_port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1);
+      if (m_port == nullptr)
+      {
+        WARN_LOG_FMT(COMMON, "Failed to create a completion port: {}", GetLastErrorString());
+        CloseHandle(directory->handle);
+        return false;
+      }
+      m_thread = std::thread(&Impl::Run, this);
+    }
+
+    if (CreateIoCompletionPort(directory->handle, m_port,
+                               reinterpret_cast<ULONG_PTR>(directory.get()), 0) == nullptr ||
+        !QueueRead(directory.get()))
+    {
+      WARN_LOG_FMT(COMMON, "Failed to watch directory '{}': {}", path, GetLastErrorString());
+      CloseHandle(directory->handle);
+      return false;
+    }
+
+    m_directories.push_back(std::move(directory));
+    return true;
+  }
+
+  static bool QueueRead(WatchedDirectory* directory)
+  {
+    return ReadDirectoryChangesW(directory->handle, directory->buffer.data(),
+                                 static_cast<DWORD>(directory->buffer.size()), FALSE,
+                                 FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE |
+                                     FILE_NOTIFY_CHANGE_SIZE,
+                                 nullptr, &directory->overlapped, nullptr);
+  }
+
+  void Run()
+  {
+    Common::SetCurrentThreadName("Directory watcher");
+
+    while (true)
+    {
+      DWORD bytes = 0;
+      ULONG_PTR key = 0;
+      OVERLAPPED* overlapped = nullptr;
+      const BOOL result = GetQueuedCompletionStatus(m_port, &bytes, &key, &overlapped, INFINITE);
+      if (key == 0)
+        return;
+
+      auto* const directory = reinterpret_cast<WatchedDirectory*>(key);
+      if (!result)
+        continue;
+
+      // No bytes means that the buffer was too small to hold all the changes
+      if (bytes == 0)
+        m_callback({});
+
+      for (DWORD offset = 0; bytes != 0;)
+      {
+        const auto* info =
+            reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(directory->buffer.data() + offset);
+        const std::wstring_view name(info->FileName, info->FileNameLength / sizeof(WCHAR));
+        m_callback(directory->path + '/' + WStringToUTF8(name));
+
+        if (info->NextEntryOffset == 0)
+          break;
+        offset += info->NextEntryOffset;
+      }
+
+      if (!QueueRead(directory))
+      {
+        WARN_LOG_FMT(COMMON, "Stopped watching directory '{}': {}", directory->path,
+                     GetLastErrorString());
+        m_callback({});
+      }
+    }
+  }
+
+  const Callback& m_callback;
+  HANDLE m_port = nullptr;
+  std::vector<std::unique_ptr<WatchedDirectory>> m_directories;
+  std::thread m_thread;
+};
+#elif defined(__APPLE__)
+struct DirectoryWatcher::Impl
+{
+  explicit Impl(const Callback& callback)
+      : m_callback(callback),
+        m_queue(dispatch_queue_create("org.dolphin-emu.directory-watcher", DISPATCH_QUEUE_SERIAL))
+  {
+  }
+
+  ~Impl()
+  {
+    StopStream();
+    dispatch_release(m_queue);
+  }
+
+  bool Watch(const std::string& path)
+  {
+    // FSEvents also accepts paths that don't exist yet
+    if (!File::IsDirectory(path))
+      return false;
+
+    m_directories.push_back(path);
+
+    // The paths of a stream can't be changed, so a new one replaces it. Changes that happen
+    // while no stream is running aren't reported, so any file may have changed.
+    const bool had_stream = m_stream != nullptr;
+    StopStream();
+    const bool started = StartStream();
+    if (!started)
+    {
+      WARN_LOG_FMT(COMMON, "Failed to watch directory '{}'", path);
+      m_directories.pop_back();
+      StartStream();
+    }
+    if (had_stream)
+      m_callback({});
+    return started;
+  }
+
+  bool StartStream()
+  {
+    if (m_directories.empty())
+      return false;
+
+    std::vector<CFStringRef> paths;
+    paths.reserve(m_directories.size());
+    for (const std::string& directory : m_directories)
+    {
+      paths.push_back(
+          CFStringCreateWithCString(kCFAllocatorDefault, directory.c_str(), kCFStringEncodingUTF8));
+    }
+    const CFArrayRef path_array =
+        CFArrayCreate(kCFAllocatorDefault, reinterpret_cast<const void**>(paths.data()),
+                      static_cast<CFIndex>(paths.size()), &kCFTypeArrayCallBacks);
+    for (const CFStringRef path : paths)
+      CFRelease(path);
+
+    FSEventStreamContext context{0, this, nullptr, nullptr, nullptr};
+    m_stream = FSEventStreamCreate(kCFAllocatorDefault, &Impl::OnEvents, &context, path_array,
+                                   kFSEventStreamEventIdSinceNow, 0.1,
+                                   kFSEventStreamCreateFlagFileEvents |
+                                       kFSEventStreamCreateFlagNoDefer);
+    CFRelease(path_array);
+    if (m_stream == nullptr)
+      return false;
+
+    FSEventStreamSetDispatchQueue(m_stream, m_queue);
+    if (!FSEventStreamStart(m_stream))
+    {
+      StopStream();
+      return false;
+    }
+    return true;
+  }
+
+  void StopStream()
+  {
+    if (m_stream == nullptr)
+      return;
+
+    FSEventStreamStop(m_stream);
+    FSEventStreamInvalidate(m_stream);
+    // Wait for callbacks that were already dispatched
+    dispatch_sync_f(m_queue, nullptr, [](void*) {});
+    FSEventStreamRelease(m_stream);
+    m_stream = nullptr;
+  }
+
+  static void OnEvents(ConstFSEventStreamRef, void* info, size_t event_count, void* event_paths,
+                       const FSEventStreamEventFlags event_flags[], const FSEventStreamEventId[])
+  {
+    const auto* impl = static_cast<const Impl*>(info);
+    const auto* paths = static_cast<const char* const*>(event_paths);
+    for (size_t i = 0; i < event_count; ++i)
+    {
+      constexpr FSEventStreamEventFlags lost_events_flags = kFSEventStreamEventFlagMustScanSubDirs |
+                                                            kFSEventStreamEventFlagUserDropped |
+                                                            kFSEventStreamEventFlagKernelDropped;
+      if (event_flags[i] & lost_events_flags)
+        impl->m_callback({});
+      else
+        impl->m_callback(paths[i]);
+    }
+  }
+
+  const Callback& m_callback;
+  dispatch_queue_t m_queue;
+  FSEventStreamRef m_stream = nullptr;
+  std::vector<std::string> m_directories;
+};
+#elif defined(__linux__)
+struct DirectoryWatcher::Impl
+{
+  explicit Impl(const Callback& callback) : m_callback(callback) {}
+
+  ~Impl()
+  {
+    if (m_inotify_fd < 0)
+      return;
+
+    const u64 value = 1;
+    if (write(m_shutdown_fd, &value, sizeof(value)) == sizeof(value))
+      m_thread.join();
+    else
+      m_thread.detach();
+    close(m_shutdown_fd);
+    close(m_inotify_fd);
+  }
+
+  bool Watch(const std::string& path)
+  {
+    if (m_inotify_fd < 0)
+    {
+      m_inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+      if (m_inotify_fd < 0)
+      {
+        WARN_LOG_FMT(COMMON, "Failed to initialize inotify: {}", LastStrerrorString());
+        return false;
+      }
+
+      m_shutdown_fd = eventfd(0, EFD_CLOEXEC);
+      if (m_shutdown_fd < 0)
+      {
+        WARN_LOG_FMT(COMMON, "Failed to create an eventfd: {}", LastStrerrorString());
+        close(m_inotify_fd);
+        m_inotify_fd = -1;
+        return false;
+      }
+      m_thread = std::thread(&Impl::Run, this);
+    }
+
+    // Files that are saved by renaming a temporary file over them are reported as moved
+    const int wd = inotify_add_watch(m_inotify_fd, path.c_str(),
+                                     IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE |
+                                         IN_DELETE | IN_ATTRIB | IN_ONLYDIR);
+    if (wd < 0)
+    {
+      WARN_LOG_FMT(COMMON, "Failed to watch directory '{}': {}", path, LastStrerrorString());
+      return false;
+    }
+
+    std::lock_guard lk(m_lock);
+    m_directories[wd] = path;
+    return true;
+  }
+
+  void Run()
+  {
+    Common::SetCurrentThreadName("Directory watcher");
+
+    alignas(inotify_event) char buffer[4096];
+    pollfd fds[2] = {{m_inotify_fd, POLLIN, 0}, {m_shutdown_fd, POLLIN, 0}};
+    while (true)
+    {
+      if (poll(fds, 2, -1) < 0)
+      {
+        if (errno == EINTR)
+          continue;
+        ERROR_LOG_FMT(COMMON, "Failed to wait for inotify events: {}", LastStrerrorString());
+        return;
+      }
+      if (fds[1].revents != 0)
+        return;
+
+      const ssize_t size = read(m_inotify_fd, buffer, sizeof(buffer));
+      for (ssize_t offset = 0; offset < size;)
+      {
+        const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+        offset += sizeof(inotify_event) + event->len;
+
+        if (event->mask & IN_Q_OVERFLOW)
+        {
+          m_callback({});
+          continue;
+        }
+        if (event->len == 0)
+          continue;
+
+        std::string path;
+        {
+          std::lock_guard lk(m_lock);
+          const auto it = m_directories.find(event->wd);
+          if (it == m_directories.end())
+            continue;
+          path = it->second + '/' + event->name;
+        }
+        m_callback(path);
+      }
+    }
+  }
+
+  const Callback& m_callback;
+  int m_inotify_fd = -1;
+  int m_shutdown_fd = -1;
+  std::thread m_thread;
+
+  std::mutex m_lock;
+  std::unordered_map<int, std::string> m_directories;
+};
+#else
+struct DirectoryWatcher::Impl
+{
+  explicit Impl(const Callback&) {}
+
+  bool Watch(const std::string&) { return false; }
+};
+#endif
+
+DirectoryWatcher::DirectoryWatcher(Callback callback)
+    : m_callback(std::move(callback)), m_impl(std::make_unique<Impl>(m_callback))
+{
+}
+
+DirectoryWatcher::~DirectoryWatcher() = default;
+
+bool DirectoryWatcher::Watch(const std::string& directory)
+{
+  std::lock_guard lk(m_lock);
+  const auto [it, inserted] = m_directories.try_emplace(directory);
+  if (inserted)
+    it->second = m_impl->Watch(directory);
+  return it->second;
+}
+}  // namespace Common
@@ -0,0 +1,45 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace Common
+{
+// Reports changes to the files in a set of directories using the change notifications of the OS
+// (inotify, FSEvents or ReadDirectoryChangesW), so that they don't have to be polled.
+// The callback is called on a thread of the watcher with the path of the file that changed, or
+// with an empty path if notifications were lost and any file may have changed.
+// Subdirectories may or may not be reported depending on the OS.
+class DirectoryWatcher
+{
+public:
+  using Callback = std::function<void(const std::string& path)>;
+
+  explicit DirectoryWatcher(Callback callback);
+  ~DirectoryWatcher();
+  DirectoryWatcher(const DirectoryWatcher&) = delete;
+  DirectoryWatcher(DirectoryWatcher&&) = delete;
+  DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+  DirectoryWatcher& operator=(DirectoryWatcher&&) = delete;
+
+  // Starts watching the files in the directory, if it isn't watched already
+  // Returns false if the directory can't be watched, for instance because the OS doesn't support
+  // change notifications, in which case the caller has to poll the files itself
+  bool Watch(const std::string& directory);
+
+private:
+  struct Impl;
+
+  Callback m_callback;
+
+  std::mutex m_lock;
+  std::map<std::string, bool> m_directories;
+  std::unique_ptr<Impl> m_impl;
+};
+}  // namespace Common
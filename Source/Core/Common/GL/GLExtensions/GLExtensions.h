@@ -27,6 +27,7 @@
 #include "Common/GL/GLExtensions/ARB_shader_storage_buffer_object.h"
 #include "Common/GL/GLExtensions/ARB_sync.h"
 #include "Common/GL/GLExtensions/ARB_texture_compression_bptc.h"
+#include "Common/GL/GLExtensions/ARB_timer_query.h"
 #include "Common/GL/GLExtensions/ARB_texture_multisample.h"
 #include "Common/GL/GLExtensions/ARB_texture_storage.h"
 #include "Common/GL/GLExtensions/ARB_texture_storage_multisample.h"
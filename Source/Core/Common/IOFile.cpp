@@ -3,8 +3,10 @@
 
 #include "Common/IOFile.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdio>
+#include <limits>
 #include <string>
 
 #ifdef _WIN32
@@ -13,12 +15,11 @@
 #include "Common/CommonFuncs.h"
 #include "Common/StringUtil.h"
 #else
+#include <fcntl.h>
 #include <unistd.h>
 #endif
 
 #ifdef ANDROID
-#include <algorithm>
-
 #include "jni/AndroidCommon/AndroidCommon.h"
 #endif
 
@@ -178,4 +179,19 @@ bool IOFile::Resize(u64 size)
   return m_good;
 }
 
+void IOFile::HintWillRead(u64 offset, u64 size) const
+{
+  if (!IsOpen() || size == 0)
+    return;
+
+#if defined(__linux__) || defined(__FreeBSD__)
+  posix_fadvise(fileno(m_file), static_cast<off_t>(offset), static_cast<off_t>(size),
+                POSIX_FADV_WILLNEED);
+#elif defined(__APPLE__)
+  radvisory advisory{static_cast<off_t>(offset),
+                     static_cast<int>(std::min<u64>(size, std::numeric_limits<int>::max()))};
+  fcntl(fileno(m_file), F_RDADVISE, &advisory);
+#endif
+}
+
 }  // namespace File
@@ -7,12 +7,15 @@
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
+#include <cstring>
 #include <string>
+#include <vector>
 
 #include <fmt/format.h>
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
 
 #ifdef _WIN32
@@ -21,6 +24,13 @@
 #include <unistd.h>
 #endif
 
+#ifdef __linux__
+#include <elf.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#endif
+
 #if defined USE_OPROFILE && USE_OPROFILE
 #include <opagent.h>
 #endif
@@ -36,11 +46,172 @@ static op_agent_t s_agent = nullptr;
 
 static File::IOFile s_perf_map_file;
 
+#ifdef __linux__
+// See tools/perf/Documentation/jitdump-specification.txt in the Linux source tree.
+namespace JitDump
+{
+constexpr u32 MAGIC = 0x4A695444;
+constexpr u32 VERSION = 1;
+
+enum RecordType : u32
+{
+  JIT_CODE_LOAD = 0,
+  JIT_CODE_DEBUG_INFO = 2,
+};
+
+struct FileHeader
+{
+  u32 magic;
+  u32 version;
+  u32 total_size;
+  u32 elf_mach;
+  u32 pad1;
+  u32 pid;
+  u64 timestamp;
+  u64 flags;
+};
+
+struct RecordHeader
+{
+  u32 id;
+  u32 total_size;
+  u64 timestamp;
+};
+
+struct CodeLoad
+{
+  u32 pid;
+  u32 tid;
+  u64 vma;
+  u64 code_addr;
+  u64 code_size;
+  u64 code_index;
+};
+
+struct DebugInfo
+{
+  u64 code_addr;
+  u64 nr_entry;
+};
+
+struct DebugEntry
+{
+  u64 code_addr;
+  u32 line;
+  u32 discrim;
+};
+
+static File::IOFile s_file;
+static void* s_marker = nullptr;
+static size_t s_marker_size = 0;
+static u64 s_code_index = 0;
+
+static u64 GetTimestamp()
+{
+  // perf record has to be run with -k mono for these to match up with the samples.
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<u64>(ts.tv_sec) * 1'000'000'000 + static_cast<u64>(ts.tv_nsec);
+}
+
+template <typename T>
+static void Append(std::vector<u8>* buffer, const T& value)
+{
+  const auto* ptr = reinterpret_cast<const u8*>(&value);
+  buffer->insert(buffer->end(), ptr, ptr + sizeof(T));
+}
+
+static void AppendString(std::vector<u8>* buffer, std::string_view str)
+{
+  buffer->insert(buffer->end(), str.begin(), str.end());
+  buffer->push_back(0);
+}
+
+static void WriteRecord(RecordType type, std::vector<u8>* payload)
+{
+  const RecordHeader header{type, static_cast<u32>(sizeof(RecordHeader) + payload->size()),
+                            GetTimestamp()};
+  s_file.WriteBytes(&header, sizeof(header));
+  s_file.WriteBytes(payload->data(), payload->size());
+}
+
+static void Open(const std::string& dir)
+{
+  const std::string filename = fmt::format("{}/jit-{}.dump", dir, getpid());
+  if (!s_file.Open(filename, "w+b"))
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to open jitdump file {}", filename);
+    return;
+  }
+
+#if defined(_M_X86_64)
+  constexpr u32 elf_mach = EM_X86_64;
+#elif defined(_M_ARM_64)
+  constexpr u32 elf_mach = EM_AARCH64;
+#else
+  constexpr u32 elf_mach = EM_NONE;
+#endif
+  const FileHeader header{MAGIC,        VERSION, sizeof(FileHeader), elf_mach, 0,
+                          static_cast<u32>(getpid()), GetTimestamp(), 0};
+  s_file.WriteBytes(&header, sizeof(header));
+  s_file.Flush();
+
+  // perf finds the file through an executable mapping of it showing up in the trace.
+  s_marker_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  s_marker = mmap(nullptr, s_marker_size, PROT_READ | PROT_EXEC, MAP_PRIVATE,
+                  fileno(s_file.GetHandle()), 0);
+  if (s_marker == MAP_FAILED)
+    s_marker = nullptr;
+
+  s_code_index = 0;
+}
+
+static void Close()
+{
+  if (s_marker)
+    munmap(s_marker, s_marker_size);
+  s_marker = nullptr;
+
+  if (s_file.IsOpen())
+    s_file.Close();
+}
+
+static void Register(const void* base_address, u32 code_size, const std::string& symbol_name,
+                     std::span<const Common::JitRegister::LineInfo> line_info)
+{
+  const u64 code_addr = reinterpret_cast<u64>(base_address);
+  std::vector<u8> payload;
+
+  // Debug info has to precede the code load record it belongs to.
+  if (!line_info.empty())
+  {
+    Append(&payload, DebugInfo{code_addr, line_info.size()});
+    for (const Common::JitRegister::LineInfo& entry : line_info)
+    {
+      // There are no source files for guest code, so the guest PC serves as the file name.
+      Append(&payload, DebugEntry{reinterpret_cast<u64>(entry.host_address), 1, 0});
+      AppendString(&payload, fmt::format("{:08x}", entry.guest_address));
+    }
+    WriteRecord(JIT_CODE_DEBUG_INFO, &payload);
+    payload.clear();
+  }
+
+  Append(&payload, CodeLoad{static_cast<u32>(getpid()), static_cast<u32>(syscall(SYS_gettid)),
+                            code_addr, code_addr, code_size, s_code_index++});
+  AppendString(&payload, symbol_name);
+  const auto* code = static_cast<const u8*>(base_address);
+  payload.insert(payload.end(), code, code + code_size);
+  WriteRecord(JIT_CODE_LOAD, &payload);
+}
+}  // namespace JitDump
+#endif
+
 namespace Common::JitRegister
 {
 static bool s_is_enabled = false;
+static bool s_is_line_info_enabled = false;
 
-void Init(const std::string& perf_dir)
+void Init(const std::string& perf_dir, bool jitdump)
 {
 #if defined USE_OPROFILE && USE_OPROFILE
   s_agent = op_open_agent();
@@ -56,6 +227,14 @@ void Init(const std::string& perf_dir)
     // if the event of a crash:
     std::setvbuf(s_perf_map_file.GetHandle(), nullptr, _IONBF, 0);
     s_is_enabled = true;
+
+#ifdef __linux__
+    if (jitdump)
+    {
+      JitDump::Open(dir);
+      s_is_line_info_enabled = JitDump::s_file.IsOpen();
+    }
+#endif
   }
 }
 
@@ -73,7 +252,12 @@ void Shutdown()
   if (s_perf_map_file.IsOpen())
     s_perf_map_file.Close();
 
+#ifdef __linux__
+  JitDump::Close();
+#endif
+
   s_is_enabled = false;
+  s_is_line_info_enabled = false;
 }
 
 bool IsEnabled()
@@ -81,7 +265,13 @@ bool IsEnabled()
   return s_is_enabled;
 }
 
-void Register(const void* base_address, u32 code_size, const std::string& symbol_name)
+bool IsLineInfoEnabled()
+{
+  return s_is_line_info_enabled;
+}
+
+void Register(const void* base_address, u32 code_size, const std::string& symbol_name,
+              std::span<const LineInfo> line_info)
 {
 #if !(defined USE_OPROFILE && USE_OPROFILE) && !defined(USE_VTUNE)
   if (!s_perf_map_file.IsOpen())
@@ -105,6 +295,11 @@ void Register(const void* base_address, u32 code_size, const std::string& symbol
   if (!s_perf_map_file.IsOpen())
     return;
 
+#ifdef __linux__
+  if (JitDump::s_file.IsOpen())
+    JitDump::Register(base_address, code_size, symbol_name, line_info);
+#endif
+
   const auto entry = fmt::format("{} {:x} {}\n", fmt::ptr(base_address), code_size, symbol_name);
   s_perf_map_file.WriteBytes(entry.data(), entry.size());
 }
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <span>
 #include <string>
 
 #include <fmt/format.h>
@@ -11,10 +12,22 @@
 
 namespace Common::JitRegister
 {
-void Init(const std::string& perf_dir);
+// Maps the host code starting at host_address to the guest instruction at guest_address.
+struct LineInfo
+{
+  const void* host_address;
+  u32 guest_address;
+};
+
+// If jitdump is set, a perf jitdump file is written in addition to the perf map. Unlike perf
+// maps, it contains the emitted code itself and line info mapping it back to guest instructions,
+// so `perf inject --jit` can annotate samples with the guest PC they belong to.
+void Init(const std::string& perf_dir, bool jitdump);
 void Shutdown();
-void Register(const void* base_address, u32 code_size, const std::string& symbol_name);
+void Register(const void* base_address, u32 code_size, const std::string& symbol_name,
+              std::span<const LineInfo> line_info = {});
 bool IsEnabled();
+bool IsLineInfoEnabled();
 
 template <typename... Args>
 inline void Register(const void* base_address, u32 code_size, fmt::format_string<Args...> format,
@@ -5,26 +5,49 @@
 
 #include <algorithm>
 #include <cstring>
-#include <memory>
+#include <functional>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 #include "Common/Version.h"
 
 // On disk format:
 // header{
-// u32 'DCAC';
-// u32 version;  // svn_rev
+// u32 'DCA2';
 // u16 sizeof(key_type);
 // u16 sizeof(value_type);
+// char version[40];  // scm rev
 //}
 
 // key_value_pair{
 // u32 value_size;
 // key_type   key;
 // value_type[value_size]   value;
+// u32 entry_number;  // starting at 1, used to detect partially written entries
+//}
+
+// Written after the last key_value_pair when the cache is closed:
+// index_entry[num_index_entries]{
+// key_type key;
+// u32 value_size;
+// u64 value_offset;
+//}
+// footer{
+// u64 index_offset;
+// u32 num_entries;
+// u32 num_index_entries;
+// u32 'DCIX';
+// u32 padding;
 //}
 
 namespace Common
@@ -36,12 +59,16 @@ public:
   virtual void Read(const K& key, const V* value, u32 value_size) = 0;
 };
 
-// Dead simple unsorted key-value store with append functionality.
-// No random read functionality, all reading is done in OpenAndRead.
+// Simple unsorted key-value store with append functionality.
+// Opening a cache only reads its index. Values are mapped into memory and read from disk when
+// they are looked up with Lookup() or passed to the reader of OpenAndRead().
 // Keys and values can contain any characters, including \0.
 //
+// Appending a key which is already in the cache replaces its value. The old entry stays in the
+// file until the cache is compacted, which happens in Close() once replaced entries take up more
+// space than live ones.
+//
 // Suitable for caching generated shader bytecode between executions.
-// Not tuned for extreme performance but should be reasonably fast.
 // Does not support keys or values larger than 2GB, which should be reasonable.
 // Keys must have non-zero length; values can have zero length.
 
@@ -52,82 +79,110 @@ template <typename K, typename V>
 class LinearDiskCache
 {
 public:
-  // return number of read entries
-  u32 OpenAndRead(const std::string& filename, LinearDiskCacheReader<K, V>& reader)
+  LinearDiskCache() = default;
+  ~LinearDiskCache() { Close(); }
+  LinearDiskCache(const LinearDiskCache&) = delete;
+  LinearDiskCache& operator=(const LinearDiskCache&) = delete;
+
+  // Opens the cache without reading any values, creating it if it doesn't exist or is invalid.
+  // Returns the number of entries.
+  u32 Open(const std::string& filename)
   {
     // Since we're reading/writing directly to the storage of K instances,
     // K must be trivially copyable.
     static_assert(std::is_trivially_copyable<K>::value, "K must be a trivially copyable type");
+    // Values are accessed in place in the mapped file.
+    static_assert(alignof(V) <= alignof(u32) && sizeof(K) % alignof(V) == 0,
+                  "Values must be aligned within the file");
 
     // close any currently opened file
     Close();
-    m_num_entries = 0;
+    m_filename = filename;
 
     // try opening for reading/writing
     m_file.Open(filename, "r+b");
 
-    const u64 file_size = m_file.GetSize();
-
     m_header.Init();
     if (m_file.IsOpen() && ValidateHeader())
     {
-      // good header, read some key/value pairs
-      K key;
+      const u64 file_size = m_file.GetSize();
+      if (!ReadIndex(file_size))
+        ScanEntries(file_size);
+      m_file.ClearError();
 
-      std::unique_ptr<V[]> value = nullptr;
-      u32 value_size = 0;
-      u32 entry_number = 0;
-      u64 last_valid_value_start = m_file.Tell();
+      // Drop the index, as well as anything after the last valid entry, so that new entries can
+      // be appended directly. The index is written again in Close().
+      if (m_data_end != file_size)
+        m_file.Resize(m_data_end);
+      m_file.Seek(m_data_end, File::SeekOrigin::Begin);
 
-      while (m_file.ReadArray(&value_size, 1))
-      {
-        const u64 next_extent = m_file.Tell() + sizeof(value_size) + value_size;
-        if (next_extent > file_size)
-          break;
-
-        // TODO: use make_unique_for_overwrite in C++20
-        value = std::unique_ptr<V[]>(new V[value_size]);
-
-        // read key/value and pass to reader
-        if (m_file.ReadArray(&key, 1) && m_file.ReadArray(value.get(), value_size) &&
-            m_file.ReadArray(&entry_number, 1) && entry_number == m_num_entries + 1)
-        {
-          last_valid_value_start = m_file.Tell();
-          reader.Read(key, value.get(), value_size);
-        }
-        else
-        {
-          break;
-        }
-
-        m_num_entries++;
-      }
-      m_file.ClearError();
-      m_file.Seek(last_valid_value_start, File::SeekOrigin::Begin);
+      // If this fails, values are read from the file instead.
+      m_mapping.Map(m_file, m_data_end);
 
-      return m_num_entries;
+      return static_cast<u32>(m_index.size());
     }
 
     // failed to open file for reading or bad header
     // close and recreate file
-    Close();
-    m_file.Open(filename, "wb");
+    m_file.Close();
+    m_file.Open(filename, "w+b");
     WriteHeader();
+    m_data_end = sizeof(Header);
     return 0;
   }
 
+  // Opens the cache and passes every entry to reader, in the order they were appended.
+  // Returns the number of entries.
+  u32 OpenAndRead(const std::string& filename, LinearDiskCacheReader<K, V>& reader)
+  {
+    const u32 count = Open(filename);
+    for (const auto& [key, location] : GetEntriesInFileOrder())
+    {
+      if (const auto value = ReadValue(location))
+        reader.Read(*key, value->data(), location.value_size);
+    }
+    return count;
+  }
+
+  // Returns the value stored for key, which stays valid until the cache is modified or closed.
+  std::optional<std::span<const V>> Lookup(const K& key)
+  {
+    const auto it = m_index.find(key);
+    if (it == m_index.end())
+      return std::nullopt;
+    return ReadValue(it->second);
+  }
+
   void Sync() { m_file.Flush(); }
   void Close()
   {
     if (m_file.IsOpen())
+    {
+      // If a write failed, leave the index out. The entries are scanned on the next Open().
+      if (m_file.IsGood())
+      {
+        const u64 wasted_bytes = m_data_end - sizeof(Header) - m_live_bytes;
+        if (wasted_bytes <= m_live_bytes || !Compact())
+          WriteIndex(m_file, m_num_entries, GetIndexEntries());
+      }
+
+      m_mapping.Unmap();
       m_file.Close();
+    }
+
+    m_index.clear();
+    m_num_entries = 0;
+    m_data_end = 0;
+    m_live_bytes = 0;
+    std::vector<V>().swap(m_read_buffer);
   }
 
   // Appends a key-value pair to the store.
   void Append(const K& key, const V* value, u32 value_size)
   {
-    // TODO: Should do a check that we don't already have "key"? (I think each caller does that
-    // already.)
+    AddToIndex(key, {m_data_end + sizeof(value_size) + sizeof(K), value_size});
+    m_data_end += GetEntrySize(value_size);
+
     m_file.WriteArray(&value_size, 1);
     m_file.WriteArray(&key, 1);
     m_file.WriteArray(value, value_size);
@@ -136,6 +191,49 @@ public:
   }
 
 private:
+  struct Location
+  {
+    u64 value_offset;
+    u32 value_size;
+  };
+
+  struct IndexEntry
+  {
+    K key;
+    u32 value_size;
+    u64 value_offset;
+  };
+
+  struct Footer
+  {
+    u64 index_offset;
+    u32 num_entries;
+    u32 num_index_entries;
+    u32 id;
+    u32 padding;
+  };
+
+  struct KeyHash
+  {
+    size_t operator()(const K& key) const
+    {
+      return std::hash<std::string_view>{}(
+          std::string_view(reinterpret_cast<const char*>(&key), sizeof(K)));
+    }
+  };
+
+  struct KeyEqual
+  {
+    bool operator()(const K& a, const K& b) const { return std::memcmp(&a, &b, sizeof(K)) == 0; }
+  };
+
+  static constexpr u32 INDEX_ID = 0x58494344;  // 'DCIX'
+
+  static constexpr u64 GetEntrySize(u32 value_size)
+  {
+    return sizeof(u32) + sizeof(K) + u64{value_size} * sizeof(V) + sizeof(u32);
+  }
+
   void WriteHeader() { m_file.WriteArray(&m_header, 1); }
   bool ValidateHeader()
   {
@@ -145,12 +243,184 @@ private:
             !memcmp((const char*)&m_header, file_header, sizeof(Header)));
   }
 
+  void AddToIndex(const K& key, const Location& location)
+  {
+    const auto [it, inserted] = m_index.try_emplace(key, location);
+    if (!inserted)
+    {
+      m_live_bytes -= GetEntrySize(it->second.value_size);
+      it->second = location;
+    }
+    m_live_bytes += GetEntrySize(location.value_size);
+  }
+
+  bool ReadIndex(u64 file_size)
+  {
+    Footer footer;
+    if (file_size < sizeof(Header) + sizeof(Footer) ||
+        !m_file.Seek(file_size - sizeof(Footer), File::SeekOrigin::Begin) ||
+        !m_file.ReadArray(&footer, 1) || footer.id != INDEX_ID)
+    {
+      return false;
+    }
+
+    const u64 index_size = u64{footer.num_index_entries} * sizeof(IndexEntry);
+    if (footer.index_offset < sizeof(Header) || footer.index_offset > file_size ||
+        file_size - footer.index_offset != index_size + sizeof(Footer))
+    {
+      return false;
+    }
+
+    std::vector<IndexEntry> entries(footer.num_index_entries);
+    if (!m_file.Seek(footer.index_offset, File::SeekOrigin::Begin) ||
+        !m_file.ReadArray(entries.data(), entries.size()))
+    {
+      return false;
+    }
+
+    for (const IndexEntry& entry : entries)
+    {
+      if (entry.value_offset + u64{entry.value_size} * sizeof(V) > footer.index_offset)
+      {
+        m_index.clear();
+        m_live_bytes = 0;
+        return false;
+      }
+      AddToIndex(entry.key, {entry.value_offset, entry.value_size});
+    }
+
+    m_num_entries = footer.num_entries;
+    m_data_end = footer.index_offset;
+    return true;
+  }
+
+  // Used when the file has no valid index, e.g. because Dolphin didn't shut down cleanly.
+  void ScanEntries(u64 file_size)
+  {
+    m_file.Seek(sizeof(Header), File::SeekOrigin::Begin);
+
+    u64 offset = sizeof(Header);
+    u32 value_size;
+    K key;
+    u32 entry_number;
+    while (m_file.ReadArray(&value_size, 1))
+    {
+      const u64 entry_size = GetEntrySize(value_size);
+      if (offset + entry_size > file_size)
+        break;
+
+      if (!m_file.ReadArray(&key, 1) ||
+          !m_file.Seek(static_cast<s64>(u64{value_size} * sizeof(V)), File::SeekOrigin::Current) ||
+          !m_file.ReadArray(&entry_number, 1) || entry_number != m_num_entries + 1)
+      {
+        break;
+      }
+
+      AddToIndex(key, {offset + sizeof(value_size) + sizeof(K), value_size});
+      m_num_entries++;
+      offset += entry_size;
+    }
+
+    m_data_end = offset;
+  }
+
+  std::optional<std::span<const V>> ReadValue(const Location& location)
+  {
+    const u64 value_bytes = u64{location.value_size} * sizeof(V);
+    if (location.value_offset + value_bytes <= m_mapping.GetSize())
+    {
+      return std::span<const V>(
+          reinterpret_cast<const V*>(m_mapping.GetData() + location.value_offset),
+          location.value_size);
+    }
+
+    // Appended after the file was mapped.
+    m_read_buffer.resize(location.value_size);
+    const bool success = m_file.Flush() &&
+                         m_file.Seek(location.value_offset, File::SeekOrigin::Begin) &&
+                         m_file.ReadArray(m_read_buffer.data(), m_read_buffer.size());
+    m_file.ClearError();
+    m_file.Seek(m_data_end, File::SeekOrigin::Begin);
+    if (!success)
+      return std::nullopt;
+    return std::span<const V>(m_read_buffer);
+  }
+
+  std::vector<std::pair<const K*, Location>> GetEntriesInFileOrder() const
+  {
+    std::vector<std::pair<const K*, Location>> entries;
+    entries.reserve(m_index.size());
+    for (const auto& [key, location] : m_index)
+      entries.emplace_back(&key, location);
+    std::ranges::sort(entries, {}, [](const auto& entry) { return entry.second.value_offset; });
+    return entries;
+  }
+
+  std::vector<IndexEntry> GetIndexEntries() const
+  {
+    std::vector<IndexEntry> entries;
+    entries.reserve(m_index.size());
+    for (const auto& [key, location] : m_index)
+      entries.push_back({key, location.value_size, location.value_offset});
+    return entries;
+  }
+
+  // Must be called with file positioned directly after the last entry.
+  static bool WriteIndex(File::IOFile& file, u32 num_entries, std::span<const IndexEntry> entries)
+  {
+    const Footer footer{file.Tell(), num_entries, static_cast<u32>(entries.size()), INDEX_ID, 0};
+    return file.WriteArray(entries.data(), entries.size()) && file.WriteArray(&footer, 1);
+  }
+
+  // Rewrites the file with only the live entries, keeping their order, and replaces the current
+  // one with it. Returns false without closing the file if the new one couldn't be written.
+  bool Compact()
+  {
+    const std::string temp_filename = m_filename + ".tmp";
+    File::IOFile temp_file(temp_filename, "wb");
+    bool success = temp_file.WriteArray(&m_header, 1);
+
+    std::vector<IndexEntry> index;
+    index.reserve(m_index.size());
+    u32 entry_number = 0;
+    for (const auto& [key, location] : GetEntriesInFileOrder())
+    {
+      const auto value = ReadValue(location);
+      if (!success || !value)
+      {
+        success = false;
+        break;
+      }
+
+      index.push_back({*key, location.value_size, temp_file.Tell() + sizeof(u32) + sizeof(K)});
+      entry_number++;
+      success = temp_file.WriteArray(&location.value_size, 1) && temp_file.WriteArray(key, 1) &&
+                temp_file.WriteArray(value->data(), value->size()) &&
+                temp_file.WriteArray(&entry_number, 1);
+    }
+
+    success = success && WriteIndex(temp_file, entry_number, index) && temp_file.Close();
+    if (!success)
+    {
+      temp_file.Close();
+      File::Delete(temp_filename);
+      return false;
+    }
+
+    // The old file is still valid if this fails, it just has to be scanned on the next Open().
+    m_mapping.Unmap();
+    m_file.Close();
+    if (!File::Rename(temp_filename, m_filename))
+      File::Delete(temp_filename);
+    return true;
+  }
+
   struct Header
   {
     void Init()
     {
       // Null-terminator is intentionally not copied.
-      std::memcpy(&id, "DCAC", sizeof(u32));
+      std::memcpy(&id, "DCA2", sizeof(u32));
       std::memcpy(ver, Common::GetScmRevGitStr().c_str(),
                   std::min(Common::GetScmRevGitStr().size(), sizeof(ver)));
     }
@@ -162,7 +432,15 @@ private:
 
   } m_header;
 
+  std::string m_filename;
   File::IOFile m_file;
+  File::MappedFile m_mapping;
+  std::unordered_map<K, Location, KeyHash, KeyEqual> m_index;
   u32 m_num_entries = 0;
+  // Offset of the end of the last entry.
+  u64 m_data_end = 0;
+  // Size of the entries that haven't been replaced.
+  u64 m_live_bytes = 0;
+  std::vector<V> m_read_buffer;
 };
 }  // namespace Common
@@ -4,13 +4,18 @@
 #include "Common/Logging/LogManager.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <cstdarg>
 #include <cstring>
 #include <locale>
+#include <memory>
 #include <mutex>
 #include <ostream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <fmt/chrono.h>
 #include <fmt/format.h>
@@ -21,6 +26,7 @@
 #include "Common/Logging/ConsoleListener.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
 
 namespace Common::Log
 {
@@ -32,6 +38,57 @@ const Config::Info<bool> LOGGER_WRITE_TO_WINDOW{
     {Config::System::Logger, "Options", "WriteToWindow"}, true};
 const Config::Info<LogLevel> LOGGER_VERBOSITY{{Config::System::Logger, "Options", "Verbosity"},
                                               LogLevel::LNOTICE};
+const Config::Info<bool> LOGGER_WRITE_ASYNCHRONOUSLY{
+    {Config::System::Logger, "Options", "WriteAsynchronously"}, false};
+
+struct AsyncLogRecord
+{
+  u64 sequence;
+  std::chrono::system_clock::time_point time;
+  LogLevel level;
+  LogType type;
+  int line;
+  // Assigned to rather than recreated, so that the buffers get reused
+  std::string file;
+  std::string message;
+};
+
+// A single producer, single consumer ring of log records. The producer is the thread that owns
+// the ring, and the consumer is the LogManager's background thread.
+class AsyncLogRing
+{
+public:
+  static constexpr size_t SIZE = 1024;
+
+  std::array<AsyncLogRecord, SIZE> records;
+  // Both only ever increase. The consumer owns read_index, the producer owns write_index.
+  std::atomic<size_t> read_index = 0;
+  std::atomic<size_t> write_index = 0;
+  std::atomic<u64> dropped = 0;
+  // Set once the owning thread has exited, so the ring can be removed after it's drained
+  std::atomic<bool> orphaned = false;
+};
+
+namespace
+{
+struct ThreadAsyncRing
+{
+  ThreadAsyncRing() = default;
+  ThreadAsyncRing(const ThreadAsyncRing&) = delete;
+  ThreadAsyncRing& operator=(const ThreadAsyncRing&) = delete;
+  ~ThreadAsyncRing()
+  {
+    if (ring)
+      ring->orphaned.store(true, std::memory_order_release);
+  }
+
+  std::shared_ptr<AsyncLogRing> ring;
+  u64 owner_id = 0;
+};
+
+thread_local ThreadAsyncRing t_async_ring;
+std::atomic<u64> s_next_instance_id = 1;
+}  // namespace
 
 class FileLogListener : public LogListener
 {
@@ -93,7 +150,7 @@ static size_t DeterminePathCutOffPoint()
   return 0;
 }
 
-LogManager::LogManager()
+LogManager::LogManager() : m_instance_id(s_next_instance_id++)
 {
   // create log containers
   m_log[LogType::ACHIEVEMENTS] = {"RetroAchievements", "Achievements"};
@@ -169,10 +226,15 @@ LogManager::LogManager()
   }
 
   m_path_cutoff_point = DeterminePathCutOffPoint();
+
+  SetAsynchronous(Config::Get(LOGGER_WRITE_ASYNCHRONOUSLY));
 }
 
 LogManager::~LogManager()
 {
+  // Write out everything that is still queued up while the listeners are still around
+  SetAsynchronous(false);
+
   // The log window listener pointer is owned by the GUI code.
   delete m_listeners[LogListener::CONSOLE_LISTENER];
   delete m_listeners[LogListener::FILE_LISTENER];
@@ -188,6 +250,7 @@ void LogManager::SaveSettings()
   Config::SetBaseOrCurrent(LOGGER_WRITE_TO_WINDOW,
                            IsListenerEnabled(LogListener::LOG_WINDOW_LISTENER));
   Config::SetBaseOrCurrent(LOGGER_VERBOSITY, GetLogLevel());
+  Config::SetBaseOrCurrent(LOGGER_WRITE_ASYNCHRONOUSLY, IsAsynchronous());
 
   for (const auto& container : m_log)
   {
@@ -206,23 +269,57 @@ void LogManager::Log(LogLevel level, LogType type, const char* file, int line, c
   LogWithFullPath(level, type, file + m_path_cutoff_point, line, message);
 }
 
-std::string LogManager::GetTimestamp()
+std::string LogManager::GetTimestamp(std::chrono::system_clock::time_point time)
 {
   // NOTE: the Qt LogWidget hardcodes the expected length of the timestamp portion of the log line,
   // so ensure they stay in sync
 
   // We want milliseconds *and not hours*, so can't directly use STL formatters
-  const auto now = std::chrono::system_clock::now();
-  const auto now_s = std::chrono::floor<std::chrono::seconds>(now);
-  const auto now_ms = std::chrono::floor<std::chrono::milliseconds>(now);
-  return fmt::format("{:%M:%S}:{:03}", now_s, (now_ms - now_s).count());
+  const auto time_s = std::chrono::floor<std::chrono::seconds>(time);
+  const auto time_ms = std::chrono::floor<std::chrono::milliseconds>(time);
+  return fmt::format("{:%M:%S}:{:03}", time_s, (time_ms - time_s).count());
 }
 
 void LogManager::LogWithFullPath(LogLevel level, LogType type, const char* file, int line,
                                  const char* message)
+{
+  const auto now = std::chrono::system_clock::now();
+  if (!m_async.load(std::memory_order_relaxed))
+  {
+    Dispatch(level, type, file, line, now, message);
+    return;
+  }
+
+  AsyncLogRing& ring = GetAsyncRing();
+  const size_t write_index = ring.write_index.load(std::memory_order_relaxed);
+  const size_t queued = write_index - ring.read_index.load(std::memory_order_acquire);
+  if (queued == AsyncLogRing::SIZE)
+  {
+    ring.dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  AsyncLogRecord& record = ring.records[write_index % AsyncLogRing::SIZE];
+  record.sequence = m_async_sequence.fetch_add(1, std::memory_order_relaxed);
+  record.time = now;
+  record.level = level;
+  record.type = type;
+  record.line = line;
+  record.file.assign(file);
+  record.message.assign(message);
+  ring.write_index.store(write_index + 1, std::memory_order_release);
+
+  // The background thread checks the rings regularly anyway, only wake it up early if this one
+  // is filling up
+  if (queued == AsyncLogRing::SIZE / 2)
+    m_async_event.Set();
+}
+
+void LogManager::Dispatch(LogLevel level, LogType type, const char* file, int line,
+                          std::chrono::system_clock::time_point time, const char* message)
 {
   const std::string msg =
-      fmt::format("{} {}:{} {}[{}]: {}\n", GetTimestamp(), file, line,
+      fmt::format("{} {}:{} {}[{}]: {}\n", GetTimestamp(time), file, line,
                   LOG_LEVEL_TO_CHAR[static_cast<int>(level)], GetShortName(type), message);
 
   for (const auto listener_id : m_listener_ids)
@@ -232,6 +329,118 @@ void LogManager::LogWithFullPath(LogLevel level, LogType type, const char* file,
   }
 }
 
+AsyncLogRing& LogManager::GetAsyncRing()
+{
+  if (t_async_ring.owner_id != m_instance_id)
+  {
+    if (t_async_ring.ring)
+      t_async_ring.ring->orphaned.store(true, std::memory_order_release);
+
+    t_async_ring.ring = std::make_shared<AsyncLogRing>();
+    t_async_ring.owner_id = m_instance_id;
+
+    std::lock_guard lk(m_async_rings_mutex);
+    m_async_rings.push_back(t_async_ring.ring);
+  }
+  return *t_async_ring.ring;
+}
+
+void LogManager::SetAsynchronous(bool enable)
+{
+  std::lock_guard lk(m_async_thread_mutex);
+  if (enable == m_async_thread_running)
+    return;
+
+  if (enable)
+  {
+    m_async_thread_running = true;
+    m_async_thread = std::thread(&LogManager::AsyncThreadFunc, this);
+    m_async = true;
+  }
+  else
+  {
+    m_async = false;
+    m_async_thread_running = false;
+    m_async_event.Set();
+    m_async_thread.join();
+  }
+}
+
+bool LogManager::IsAsynchronous() const
+{
+  return m_async.load(std::memory_order_relaxed);
+}
+
+u64 LogManager::GetDroppedMessageCount() const
+{
+  return m_async_dropped.load(std::memory_order_relaxed);
+}
+
+void LogManager::AsyncThreadFunc()
+{
+  Common::SetCurrentThreadName("Logger");
+
+  while (m_async_thread_running)
+  {
+    m_async_event.WaitFor(std::chrono::milliseconds(10));
+    DrainAsyncRings();
+  }
+
+  // Messages logged right before asynchronous mode was turned off
+  DrainAsyncRings();
+}
+
+void LogManager::DrainAsyncRings()
+{
+  std::vector<std::shared_ptr<AsyncLogRing>> rings;
+  {
+    std::lock_guard lk(m_async_rings_mutex);
+    rings = m_async_rings;
+  }
+
+  // Records stay valid until read_index is advanced past them. Messages from different threads
+  // are written out in the order they were logged in.
+  std::vector<const AsyncLogRecord*> records;
+  std::vector<size_t> write_indices(rings.size());
+  u64 dropped = 0;
+  for (size_t i = 0; i < rings.size(); ++i)
+  {
+    AsyncLogRing& ring = *rings[i];
+    write_indices[i] = ring.write_index.load(std::memory_order_acquire);
+    for (size_t j = ring.read_index.load(std::memory_order_relaxed); j != write_indices[i]; ++j)
+      records.push_back(&ring.records[j % AsyncLogRing::SIZE]);
+    dropped += ring.dropped.exchange(0, std::memory_order_relaxed);
+  }
+
+  std::sort(records.begin(), records.end(), [](const AsyncLogRecord* a, const AsyncLogRecord* b) {
+    return a->sequence < b->sequence;
+  });
+  for (const AsyncLogRecord* record : records)
+  {
+    Dispatch(record->level, record->type, record->file.c_str(), record->line, record->time,
+             record->message.c_str());
+  }
+
+  for (size_t i = 0; i < rings.size(); ++i)
+    rings[i]->read_index.store(write_indices[i], std::memory_order_release);
+
+  if (dropped != 0)
+  {
+    m_async_dropped.fetch_add(dropped, std::memory_order_relaxed);
+    const std::string message = fmt::format("{} log messages were dropped", dropped);
+    Dispatch(LogLevel::LWARNING, LogType::COMMON, __FILE__ + m_path_cutoff_point, __LINE__,
+             std::chrono::system_clock::now(), message.c_str());
+  }
+
+  // Rings of threads that have exited can go once everything in them has been written out
+  std::lock_guard lk(m_async_rings_mutex);
+  std::erase_if(m_async_rings, [](const std::shared_ptr<AsyncLogRing>& ring) {
+    return ring->orphaned.load(std::memory_order_acquire) &&
+           ring->read_index.load(std::memory_order_relaxed) ==
+               ring->write_index.load(std::memory_order_acquire);
+  });
+}
+
 LogLevel LogManager::GetLogLevel() const
 {
   return m_level;
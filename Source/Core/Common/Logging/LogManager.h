@@ -4,16 +4,26 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdarg>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "Common/BitSet.h"
+#include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
+#include "Common/Event.h"
 #include "Common/Logging/Log.h"
 
 namespace Common::Log
 {
+class AsyncLogRing;
+
 // pure virtual interface
 class LogListener
 {
@@ -57,6 +67,13 @@ public:
   void EnableListener(LogListener::LISTENER id, bool enable);
   bool IsListenerEnabled(LogListener::LISTENER id) const;
 
+  // In asynchronous mode, logging only copies the message into a ring buffer owned by the calling
+  // thread. A background thread formats the messages and passes them on to the listeners. If a
+  // thread logs faster than the background thread can keep up with, its messages are dropped.
+  void SetAsynchronous(bool enable);
+  bool IsAsynchronous() const;
+  u64 GetDroppedMessageCount() const;
+
   void SaveSettings();
 
 private:
@@ -75,12 +92,31 @@ private:
   LogManager(LogManager&&) = delete;
   LogManager& operator=(LogManager&&) = delete;
 
-  static std::string GetTimestamp();
+  static std::string GetTimestamp(std::chrono::system_clock::time_point time);
+
+  void Dispatch(LogLevel level, LogType type, const char* file, int line,
+                std::chrono::system_clock::time_point time, const char* message);
+
+  AsyncLogRing& GetAsyncRing();
+  void AsyncThreadFunc();
+  void DrainAsyncRings();
 
   LogLevel m_level;
   EnumMap<LogContainer, LAST_LOG_TYPE> m_log{};
   std::array<LogListener*, LogListener::NUMBER_OF_LISTENERS> m_listeners{};
   BitSet32 m_listener_ids;
   size_t m_path_cutoff_point = 0;
+
+  // Tells the rings of threads apart which were registered with an earlier LogManager
+  const u64 m_instance_id;
+  std::atomic<bool> m_async = false;
+  std::atomic<u64> m_async_sequence = 0;
+  std::atomic<u64> m_async_dropped = 0;
+  std::mutex m_async_rings_mutex;
+  std::vector<std::shared_ptr<AsyncLogRing>> m_async_rings;
+  std::mutex m_async_thread_mutex;
+  std::thread m_async_thread;
+  std::atomic<bool> m_async_thread_running = false;
+  Common::Event m_async_event;
 };
 }  // namespace Common::Log
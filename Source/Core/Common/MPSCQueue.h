@@ -0,0 +1,72 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// a lockless thread-safe,
+// multiple producer, single consumer queue
+//
+// Push() is wait-free: it only swaps the head pointer and links the new element in. Until that
+// link is made the consumer may see the queue as ending before the element, so Pop() can briefly
+// report an empty queue while a Push() from another thread is in flight. Elements pushed by the
+// same thread are always popped in the order they were pushed.
+
+#include <atomic>
+#include <utility>
+
+namespace Common
+{
+template <typename T>
+class MPSCQueue
+{
+public:
+  MPSCQueue() { m_head = m_tail = new ElementPtr(); }
+  MPSCQueue(const MPSCQueue&) = delete;
+  MPSCQueue& operator=(const MPSCQueue&) = delete;
+  ~MPSCQueue()
+  {
+    while (m_tail)
+    {
+      ElementPtr* next = m_tail->next.load(std::memory_order_relaxed);
+      delete m_tail;
+      m_tail = next;
+    }
+  }
+
+  // Only meaningful on the consumer thread.
+  bool Empty() const { return !m_tail->next.load(std::memory_order_acquire); }
+
+  template <typename Arg>
+  void Push(Arg&& t)
+  {
+    ElementPtr* new_ptr = new ElementPtr();
+    new_ptr->current = std::forward<Arg>(t);
+    ElementPtr* prev = m_head.exchange(new_ptr, std::memory_order_acq_rel);
+    prev->next.store(new_ptr, std::memory_order_release);
+  }
+
+  // Must only be called from the consumer thread.
+  bool Pop(T& t)
+  {
+    ElementPtr* next = m_tail->next.load(std::memory_order_acquire);
+    if (!next)
+      return false;
+
+    // The old tail was already consumed; next becomes the new (consumed) tail.
+    t = std::move(next->current);
+    delete m_tail;
+    m_tail = next;
+    return true;
+  }
+
+private:
+  struct ElementPtr
+  {
+    T current{};
+    std::atomic<ElementPtr*> next{nullptr};
+  };
+
+  std::atomic<ElementPtr*> m_head;
+  ElementPtr* m_tail;
+};
+}  // namespace Common
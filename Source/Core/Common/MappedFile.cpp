@@ -0,0 +1,103 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/MappedFile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+namespace File
+{
+MappedFile::~MappedFile()
+{
+  Unmap();
+}
+
+bool MappedFile::Map(IOFile& file, u64 size)
+{
+  Unmap();
+  if (!file.IsOpen() || size == 0 || size > std::numeric_limits<size_t>::max())
+    return false;
+
+#ifdef _WIN32
+  const HANDLE file_handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file.GetHandle())));
+  m_mapping_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY,
+                                        static_cast<DWORD>(size >> 32), static_cast<DWORD>(size),
+                                        nullptr);
+  if (!m_mapping_handle)
+  {
+    ERROR_LOG_FMT(COMMON, "CreateFileMapping failed: {}", GetLastError());
+    return false;
+  }
+
+  void* const data =
+      MapViewOfFile(m_mapping_handle, FILE_MAP_READ, 0, 0, static_cast<SIZE_T>(size));
+  if (!data)
+  {
+    ERROR_LOG_FMT(COMMON, "MapViewOfFile failed: {}", GetLastError());
+    CloseHandle(m_mapping_handle);
+    m_mapping_handle = nullptr;
+    return false;
+  }
+#else
+  void* const data =
+      mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_SHARED, fileno(file.GetHandle()), 0);
+  if (data == MAP_FAILED)
+  {
+    ERROR_LOG_FMT(COMMON, "mmap failed");
+    return false;
+  }
+#endif
+
+  m_data = static_cast<const u8*>(data);
+  m_size = size;
+  return true;
+}
+
+void MappedFile::Unmap()
+{
+  if (!m_data)
+    return;
+
+#ifdef _WIN32
+  UnmapViewOfFile(m_data);
+  CloseHandle(m_mapping_handle);
+  m_mapping_handle = nullptr;
+#else
+  munmap(const_cast<u8*>(m_data), static_cast<size_t>(m_size));
+#endif
+
+  m_data = nullptr;
+  m_size = 0;
+}
+
+void MappedFile::HintWillNeed(u64 offset, u64 size) const
+{
+  if (!m_data || offset >= m_size)
+    return;
+  size = std::min(size, m_size - offset);
+
+#ifdef _WIN32
+  WIN32_MEMORY_RANGE_ENTRY range{const_cast<u8*>(m_data) + offset, static_cast<SIZE_T>(size)};
+  PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+  // madvise needs a page aligned address
+  const u64 page_size = static_cast<u64>(sysconf(_SC_PAGESIZE));
+  const u64 aligned_offset = offset / page_size * page_size;
+  madvise(const_cast<u8*>(m_data) + aligned_offset,
+          static_cast<size_t>(size + offset - aligned_offset), MADV_WILLNEED);
+#endif
+}
+}  // namespace File
@@ -0,0 +1,40 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace File
+{
+class IOFile;
+
+// Read-only view of the start of an open file. Pages are only read from disk once they are
+// accessed, so large files can be opened without reading them in full.
+class MappedFile final
+{
+public:
+  MappedFile() = default;
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  // Maps the first size bytes of file, which has to stay open until Unmap() is called. The file
+  // can't be truncated while it is mapped, and data written past size doesn't show up in the view.
+  bool Map(IOFile& file, u64 size);
+  void Unmap();
+
+  // Tells the OS that the given range of the view is going to be accessed soon
+  void HintWillNeed(u64 offset, u64 size) const;
+
+  const u8* GetData() const { return m_data; }
+  u64 GetSize() const { return m_size; }
+
+private:
+  const u8* m_data = nullptr;
+  u64 m_size = 0;
+#ifdef _WIN32
+  void* m_mapping_handle = nullptr;
+#endif
+};
+}  // namespace File
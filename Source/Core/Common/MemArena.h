@@ -46,8 +46,10 @@ public:
   /// @param size The amount of bytes that should be allocated in this region.
   /// @param base_name A base name for the shared memory region, if applicable for this platform.
   /// Will be extended with the process ID.
+  /// @param huge_pages Whether to ask the OS to back the memory with huge pages to reduce TLB
+  /// misses. Only supported on Linux, where the kernel may still decide to use normal pages.
   ///
-  void GrabSHMSegment(size_t size, std::string_view base_name);
+  void GrabSHMSegment(size_t size, std::string_view base_name, bool huge_pages);
 
   ///
   /// Release the memory segment previously allocated with GrabSHMSegment().
@@ -122,6 +124,7 @@ private:
   WindowsMemoryFunctions m_memory_functions;
 #else
   int m_shm_fd = 0;
+  bool m_huge_pages = false;
   void* m_reserved_region = nullptr;
   std::size_t m_reserved_region_size = 0;
 #endif
@@ -65,8 +65,9 @@ static int AshmemCreateFileMapping(const char* name, size_t size)
 MemArena::MemArena() = default;
 MemArena::~MemArena() = default;
 
-void MemArena::GrabSHMSegment(size_t size, std::string_view base_name)
+void MemArena::GrabSHMSegment(size_t size, std::string_view base_name, bool huge_pages)
 {
+  // huge_pages is ignored, ashmem has no huge page support.
   const std::string name = fmt::format("{}.{}", base_name, getpid());
   m_shm_fd = AshmemCreateFileMapping(name.c_str(), size);
   if (m_shm_fd < 0)
@@ -16,10 +16,13 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
+#include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 
@@ -28,8 +31,59 @@ namespace Common
 MemArena::MemArena() = default;
 MemArena::~MemArena() = default;
 
-void MemArena::GrabSHMSegment(size_t size, std::string_view base_name)
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+// Logs whether the kernel backs shared memory with huge pages when asked to
+static void LogShmemHugePageMode()
 {
+  std::string modes;
+  if (!File::ReadFileToString("/sys/kernel/mm/transparent_hugepage/shmem_enabled", modes))
+  {
+    WARN_LOG_FMT(MEMMAP, "Huge pages were requested, but the kernel has no transparent huge pages");
+    return;
+  }
+
+  // The active mode is the one in brackets, e.g. "always within_size [advise] never deny force"
+  const size_t begin = modes.find('[');
+  const size_t end = modes.find(']', begin);
+  const std::string mode = begin != std::string::npos && end != std::string::npos ?
+                               modes.substr(begin + 1, end - begin - 1) :
+                               modes;
+  if (mode == "never" || mode == "deny")
+  {
+    WARN_LOG_FMT(MEMMAP,
+                 "Huge pages were requested, but transparent huge pages for shared memory are "
+                 "disabled (shmem_enabled is {})",
+                 mode);
+  }
+  else
+  {
+    NOTICE_LOG_FMT(MEMMAP, "Using transparent huge pages for emulated memory (shmem_enabled is {})",
+                   mode);
+  }
+}
+#endif
+
+void MemArena::GrabSHMSegment(size_t size, std::string_view base_name, bool huge_pages)
+{
+  m_huge_pages = false;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  // /dev/shm, where shm_open creates its files, is usually mounted without huge page support.
+  // Memory from memfd_create follows the shmem_enabled setting instead.
+  if (huge_pages)
+  {
+    m_shm_fd = memfd_create(std::string(base_name).c_str(), MFD_CLOEXEC);
+    if (m_shm_fd != -1)
+    {
+      if (ftruncate(m_shm_fd, size) < 0)
+        ERROR_LOG_FMT(MEMMAP, "Failed to allocate low memory space");
+      m_huge_pages = true;
+      LogShmemHugePageMode();
+      return;
+    }
+    WARN_LOG_FMT(MEMMAP, "memfd_create failed, not using huge pages: {}", LastStrerrorString());
+  }
+#endif
+
   const std::string file_name = fmt::format("/{}.{}", base_name, getpid());
   m_shm_fd = shm_open(file_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
   if (m_shm_fd == -1)
@@ -47,9 +101,52 @@ void MemArena::ReleaseSHMSegment()
   close(m_shm_fd);
 }
 
+// Huge pages can only be mapped at addresses which are aligned to their size, which mmap doesn't
+// guarantee. Returns MAP_FAILED if the alignment is 0 or the address space can't be reserved.
+static void* ReserveAlignedAddressSpace(size_t size, size_t alignment)
+{
+  if (alignment == 0)
+    return MAP_FAILED;
+
+  const size_t mapped_size = size + alignment;
+  void* const mapped = mmap(nullptr, mapped_size, PROT_NONE, MAP_ANON | MAP_PRIVATE, -1, 0);
+  if (mapped == MAP_FAILED)
+    return MAP_FAILED;
+
+  u8* const begin = static_cast<u8*>(mapped);
+  u8* const aligned =
+      reinterpret_cast<u8*>(Common::AlignUp(reinterpret_cast<uintptr_t>(mapped), alignment));
+  if (aligned != begin)
+    munmap(begin, aligned - begin);
+  munmap(aligned + size, begin + mapped_size - (aligned + size));
+  return aligned;
+}
+
+static bool AdviseHugePages(void* view, size_t size)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (madvise(view, size, MADV_HUGEPAGE) == 0)
+    return true;
+  WARN_LOG_FMT(MEMMAP, "madvise(MADV_HUGEPAGE) failed, not using huge pages: {}",
+               LastStrerrorString());
+#endif
+  return false;
+}
+
 void* MemArena::CreateView(s64 offset, size_t size)
 {
-  void* retval = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_shm_fd, offset);
+  void* address = nullptr;
+  int flags = MAP_SHARED;
+  if (m_huge_pages)
+  {
+    address = ReserveAlignedAddressSpace(size, GetTransparentHugePageSize());
+    if (address != MAP_FAILED)
+      flags |= MAP_FIXED;
+    else
+      address = nullptr;
+  }
+
+  void* retval = mmap(address, size, PROT_READ | PROT_WRITE, flags, m_shm_fd, offset);
   if (retval == MAP_FAILED)
   {
     NOTICE_LOG_FMT(MEMMAP, "mmap failed");
@@ -57,6 +154,8 @@ void* MemArena::CreateView(s64 offset, size_t size)
   }
   else
   {
+    if (m_huge_pages)
+      m_huge_pages = AdviseHugePages(retval, size);
     return retval;
   }
 }
@@ -68,8 +167,14 @@ void MemArena::ReleaseView(void* view, size_t size)
 
 u8* MemArena::ReserveMemoryRegion(size_t memory_size)
 {
-  const int flags = MAP_ANON | MAP_PRIVATE;
-  void* base = mmap(nullptr, memory_size, PROT_NONE, flags, -1, 0);
+  void* base = MAP_FAILED;
+  if (m_huge_pages)
+    base = ReserveAlignedAddressSpace(memory_size, GetTransparentHugePageSize());
+  if (base == MAP_FAILED)
+  {
+    const int flags = MAP_ANON | MAP_PRIVATE;
+    base = mmap(nullptr, memory_size, PROT_NONE, flags, -1, 0);
+  }
   if (base == MAP_FAILED)
   {
     PanicAlertFmt("Failed to map enough memory space: {}", LastStrerrorString());
@@ -99,6 +204,8 @@ void* MemArena::MapInMemoryRegion(s64 offset, size_t size, void* base)
   }
   else
   {
+    if (m_huge_pages)
+      m_huge_pages = AdviseHugePages(retval, size);
     return retval;
   }
 }
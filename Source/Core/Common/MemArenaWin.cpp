@@ -117,8 +117,10 @@ static DWORD GetLowDWORD(u64 value)
   return static_cast<DWORD>(value);
 }
 
-void MemArena::GrabSHMSegment(size_t size, std::string_view base_name)
+void MemArena::GrabSHMSegment(size_t size, std::string_view base_name, bool huge_pages)
 {
+  // huge_pages is ignored. Views of a SEC_LARGE_PAGES section have to be aligned to the large page
+  // size, but views are mapped for every 128 KiB BAT block.
   const std::string name = fmt::format("{}.{}", base_name, GetCurrentProcessId());
   m_memory_handle =
       CreateFileMapping(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, GetHighDWORD(size),
@@ -3,12 +3,15 @@
 
 #include "Common/MemoryUtil.h"
 
+#include <atomic>
 #include <cstddef>
 #include <cstdlib>
 #include <string>
 
+#include "Common/Align.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 
@@ -34,18 +37,123 @@ namespace Common
 // This is purposely not a full wrapper for virtualalloc/mmap, but it
 // provides exactly the primitive operations that Dolphin needs.
 
-void* AllocateExecutableMemory(size_t size)
+#if defined(_WIN32)
+// Large pages can only be allocated with SeLockMemoryPrivilege, which has to be granted to the
+// user by an administrator and then enabled for the process.
+static bool EnableLockMemoryPrivilege()
+{
+  HANDLE token;
+  if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+    return false;
+
+  TOKEN_PRIVILEGES privileges{};
+  privileges.PrivilegeCount = 1;
+  privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+  // AdjustTokenPrivileges succeeds with ERROR_NOT_ALL_ASSIGNED if the user lacks the privilege.
+  const bool enabled =
+      LookupPrivilegeValue(nullptr, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid) &&
+      AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) &&
+      GetLastError() == ERROR_SUCCESS;
+  CloseHandle(token);
+  return enabled;
+}
+
+static void* AllocateExecutableLargePages(size_t size)
+{
+  const size_t large_page_size = GetLargePageMinimum();
+  if (large_page_size == 0 || !EnableLockMemoryPrivilege())
+    return nullptr;
+
+  return VirtualAlloc(nullptr, Common::AlignUp(size, large_page_size),
+                      MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_EXECUTE_READWRITE);
+}
+#elif defined(__linux__) && defined(MADV_HUGEPAGE)
+// Transparent huge pages are only used for ranges which are aligned to the huge page size, so this
+// maps a larger range and trims it down to an aligned one.
+static void* AllocateExecutableHugePages(size_t size, int map_flags)
+{
+  const size_t huge_page_size = GetTransparentHugePageSize();
+  if (huge_page_size == 0)
+    return nullptr;
+
+  const size_t mapped_size = size + huge_page_size;
+  void* const mapped =
+      mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE | PROT_EXEC, map_flags, -1, 0);
+  if (mapped == MAP_FAILED)
+    return nullptr;
+
+  u8* const begin = reinterpret_cast<u8*>(mapped);
+  u8* const ptr = reinterpret_cast<u8*>(
+      Common::AlignUp(reinterpret_cast<uintptr_t>(mapped), huge_page_size));
+  if (ptr != begin)
+    munmap(begin, ptr - begin);
+  munmap(ptr + size, begin + mapped_size - (ptr + size));
+
+  if (madvise(ptr, size, MADV_HUGEPAGE) != 0)
+  {
+    munmap(ptr, size);
+    return nullptr;
+  }
+  return ptr;
+}
+#endif
+
+size_t GetTransparentHugePageSize()
 {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  std::string size;
+  if (File::ReadFileToString("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", size))
+    return std::strtoull(size.c_str(), nullptr, 10);
+#endif
+  return 0;
+}
+
+void* AllocateExecutableMemory(size_t size, bool huge_pages)
+{
+  void* ptr = nullptr;
 #if defined(_WIN32)
-  void* ptr = VirtualAlloc(nullptr, size, MEM_COMMIT, PAGE_EXECUTE_READWRITE);
+  if (huge_pages)
+  {
+    ptr = AllocateExecutableLargePages(size);
+    if (ptr)
+      NOTICE_LOG_FMT(COMMON, "Using large pages for {} MiB of executable memory", size >> 20);
+    else
+      WARN_LOG_FMT(COMMON, "Large pages are not available for executable memory");
+  }
+
+  if (!ptr)
+    ptr = VirtualAlloc(nullptr, size, MEM_COMMIT, PAGE_EXECUTE_READWRITE);
 #else
   int map_flags = MAP_ANON | MAP_PRIVATE;
 #if defined(__APPLE__)
   map_flags |= MAP_JIT;
 #endif
-  void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE | PROT_EXEC, map_flags, -1, 0);
-  if (ptr == MAP_FAILED)
-    ptr = nullptr;
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (huge_pages)
+  {
+    ptr = AllocateExecutableHugePages(size, map_flags);
+    if (ptr)
+    {
+      NOTICE_LOG_FMT(COMMON, "Using transparent huge pages for {} MiB of executable memory",
+                     size >> 20);
+    }
+    else
+    {
+      WARN_LOG_FMT(COMMON, "Transparent huge pages are not available for executable memory");
+    }
+  }
+#else
+  if (huge_pages)
+    WARN_LOG_FMT(COMMON, "Huge pages are not supported for executable memory on this platform");
+#endif
+
+  if (!ptr)
+  {
+    ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE | PROT_EXEC, map_flags, -1, 0);
+    if (ptr == MAP_FAILED)
+      ptr = nullptr;
+  }
 #endif
 
   if (ptr == nullptr)
@@ -65,6 +173,34 @@ static int& JITPageWriteNestCounter()
   return nest_counter;
 }
 
+// State of the JITPageWriteBatch* functions, wrapped for the same reason as the counter above.
+struct JITPageWriteBatchState
+{
+  int depth = 0;
+  // Whether memory has been made writable during the batch and was left writable
+  bool writable = false;
+};
+
+static JITPageWriteBatchState& JITPageWriteBatch()
+{
+  static thread_local JITPageWriteBatchState batch;
+  return batch;
+}
+
+static std::atomic<u64> s_jit_page_write_toggles{0};
+
+static void SetJITPageWriteProtect([[maybe_unused]] bool protect)
+{
+#if defined(_M_ARM_64) && defined(__APPLE__)
+  if (__builtin_available(macOS 11.0, *))
+  {
+    pthread_jit_write_protect_np(protect ? 1 : 0);
+    if (!protect)
+      s_jit_page_write_toggles.fetch_add(1, std::memory_order_relaxed);
+  }
+#endif
+}
+
 // Certain platforms (Mac OS on ARM) enforce that a single thread can only have write or
 // execute permissions to pages at any given point of time. The two below functions
 // are used to toggle between having write permissions or execute permissions.
@@ -94,15 +230,12 @@ static int& JITPageWriteNestCounter()
 // Allows a thread to write to executable memory, but not execute the data.
 void JITPageWriteEnableExecuteDisable()
 {
-#if defined(_M_ARM_64) && defined(__APPLE__)
-  if (JITPageWriteNestCounter() == 0)
+  JITPageWriteBatchState& batch = JITPageWriteBatch();
+  if (JITPageWriteNestCounter() == 0 && !batch.writable)
   {
-    if (__builtin_available(macOS 11.0, *))
-    {
-      pthread_jit_write_protect_np(0);
-    }
+    SetJITPageWriteProtect(false);
+    batch.writable = batch.depth > 0;
   }
-#endif
   JITPageWriteNestCounter()++;
 }
 // Allows a thread to execute memory allocated for execution, but not write to it.
@@ -116,15 +249,35 @@ void JITPageWriteDisableExecuteEnable()
   if (JITPageWriteNestCounter() < 0)
     PanicAlertFmt("JITPageWriteNestCounter() underflowed");
 
-#if defined(_M_ARM_64) && defined(__APPLE__)
+  // Inside a batch, the memory stays writable until the batch ends.
+  if (JITPageWriteNestCounter() == 0 && !JITPageWriteBatch().writable)
+    SetJITPageWriteProtect(true);
+}
+
+void JITPageWriteBatchBegin()
+{
+  JITPageWriteBatch().depth++;
+}
+
+void JITPageWriteBatchEnd()
+{
+  JITPageWriteBatchState& batch = JITPageWriteBatch();
+  batch.depth--;
+  if (batch.depth < 0)
+    PanicAlertFmt("JITPageWriteBatch() underflowed");
+
+  if (batch.depth > 0 || !batch.writable)
+    return;
+
+  batch.writable = false;
+  // Memory that was only made writable by an enclosing scope stays writable until that scope ends.
   if (JITPageWriteNestCounter() == 0)
-  {
-    if (__builtin_available(macOS 11.0, *))
-    {
-      pthread_jit_write_protect_np(1);
-    }
-  }
-#endif
+    SetJITPageWriteProtect(true);
+}
+
+u64 GetJITPageWriteToggleCount()
+{
+  return s_jit_page_write_toggles.load(std::memory_order_relaxed);
 }
 
 void* AllocateMemoryPages(size_t size)
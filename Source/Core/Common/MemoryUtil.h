@@ -6,9 +6,16 @@
 #include <cstddef>
 #include <string>
 
+#include "Common/CommonTypes.h"
+
 namespace Common
 {
-void* AllocateExecutableMemory(size_t size);
+// If huge_pages is set, tries to back the memory with huge pages to reduce TLB misses, which is
+// logged along with whether it worked. Falls back to normal pages.
+void* AllocateExecutableMemory(size_t size, bool huge_pages = false);
+
+// Returns the size of the transparent huge pages of the system, or 0 if there are none.
+size_t GetTransparentHugePageSize();
 
 // These two functions control the executable/writable state of the W^X memory
 // allocations. More detailed documentation about them is in the .cpp file.
@@ -26,6 +33,21 @@ struct ScopedJITPageWriteAndNoExecute
   ScopedJITPageWriteAndNoExecute() { JITPageWriteEnableExecuteDisable(); }
   ~ScopedJITPageWriteAndNoExecute() { JITPageWriteDisableExecuteEnable(); }
 };
+
+// While a batch is open, executable memory which has been made writable stays writable until the
+// batch ends, so that many small writes only switch the W^X state once. Opening a batch doesn't
+// make memory writable by itself. No JIT code may run on the thread while a batch is open.
+void JITPageWriteBatchBegin();
+void JITPageWriteBatchEnd();
+struct ScopedJITPageWriteBatch
+{
+  ScopedJITPageWriteBatch() { JITPageWriteBatchBegin(); }
+  ~ScopedJITPageWriteBatch() { JITPageWriteBatchEnd(); }
+};
+
+// Number of times any thread has made executable memory writable. Only counts on platforms which
+// enforce W^X per thread.
+u64 GetJITPageWriteToggleCount();
 void* AllocateMemoryPages(size_t size);
 bool FreeMemoryPages(void* ptr, size_t size);
 void* AllocateAlignedMemory(size_t size, size_t alignment);
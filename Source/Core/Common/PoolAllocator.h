@@ -0,0 +1,125 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace Common
+{
+// Keeps freed blocks around in per-size free lists so that they can be handed out again without
+// going through the global allocator. Blocks are only returned to the system when the pool itself
+// is destroyed. Not thread-safe.
+class FreeListPool
+{
+public:
+  FreeListPool() = default;
+  FreeListPool(const FreeListPool&) = delete;
+  FreeListPool& operator=(const FreeListPool&) = delete;
+
+  ~FreeListPool()
+  {
+    for (FreeList& list : m_lists)
+    {
+      while (list.head)
+      {
+        FreeBlock* const next = list.head->next;
+        ::operator delete(list.head);
+        list.head = next;
+      }
+    }
+  }
+
+  void* Allocate(size_t size)
+  {
+    FreeList& list = GetList(size);
+    if (!list.head)
+      return ::operator new(std::max(size, sizeof(FreeBlock)));
+
+    FreeBlock* const block = list.head;
+    list.head = block->next;
+    return block;
+  }
+
+  void Deallocate(void* ptr, size_t size)
+  {
+    FreeList& list = GetList(size);
+    list.head = new (ptr) FreeBlock{list.head};
+  }
+
+private:
+  struct FreeBlock
+  {
+    FreeBlock* next;
+  };
+
+  struct FreeList
+  {
+    size_t size;
+    FreeBlock* head;
+  };
+
+  FreeList& GetList(size_t size)
+  {
+    // Containers only ever allocate a handful of distinct node sizes, so a linear search is fine.
+    auto it = std::find_if(m_lists.begin(), m_lists.end(),
+                           [size](const FreeList& list) { return list.size == size; });
+    if (it != m_lists.end())
+      return *it;
+    return m_lists.emplace_back(FreeList{size, nullptr});
+  }
+
+  std::vector<FreeList> m_lists;
+};
+
+// Standard allocator which serves single-object allocations (node-based containers,
+// std::allocate_shared) from a FreeListPool. The pool is shared by every copy and rebind of the
+// allocator, so it stays alive for as long as anything allocated from it does.
+template <typename T>
+class PoolAllocator
+{
+public:
+  using value_type = T;
+
+  static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                "PoolAllocator does not support over-aligned types");
+
+  PoolAllocator() : m_pool(std::make_shared<FreeListPool>()) {}
+
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>& other) : m_pool(other.m_pool)
+  {
+  }
+
+  T* allocate(size_t n)
+  {
+    if (n != 1)
+      return std::allocator<T>().allocate(n);
+    return static_cast<T*>(m_pool->Allocate(sizeof(T)));
+  }
+
+  void deallocate(T* ptr, size_t n)
+  {
+    if (n != 1)
+      std::allocator<T>().deallocate(ptr, n);
+    else
+      m_pool->Deallocate(ptr, sizeof(T));
+  }
+
+  template <typename U>
+  bool operator==(const PoolAllocator<U>& other) const
+  {
+    return m_pool == other.m_pool;
+  }
+
+private:
+  template <typename U>
+  friend class PoolAllocator;
+
+  std::shared_ptr<FreeListPool> m_pool;
+};
+}  // namespace Common
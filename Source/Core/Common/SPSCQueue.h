@@ -7,6 +7,7 @@
 // single producer, single consumer queue
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <cstddef>
 
@@ -106,4 +107,160 @@ private:
   ElementPtr* m_read_ptr;
   std::atomic<u32> m_size;
 };
+
+// A variant of SPSCQueue which stores the elements in fixed-size segments instead of allocating
+// one list node per element. Segments the reader is done with are handed back to the writer for
+// reuse, so a queue which doesn't keep growing doesn't allocate at all. Unlike a fixed-size ring
+// buffer it never becomes full, so a writer can't end up waiting for a reader that waits for it.
+template <typename T, bool NeedSize = true, size_t SegmentSize = 64>
+class SPSCSegmentedQueue
+{
+public:
+  SPSCSegmentedQueue() { m_write_segment = m_read_segment = new Segment(); }
+  ~SPSCSegmentedQueue()
+  {
+    DeleteSegments(m_read_segment);
+    delete m_spare_segment.load(std::memory_order_relaxed);
+  }
+
+  SPSCSegmentedQueue(const SPSCSegmentedQueue&) = delete;
+  SPSCSegmentedQueue& operator=(const SPSCSegmentedQueue&) = delete;
+
+  u32 Size() const
+  {
+    static_assert(NeedSize, "using Size() on SPSCSegmentedQueue without NeedSize");
+    return static_cast<u32>(m_write_count.load(std::memory_order_acquire) -
+                            m_read_count.load(std::memory_order_acquire));
+  }
+
+  bool Empty() const
+  {
+    return m_read_count.load(std::memory_order_acquire) ==
+           m_write_count.load(std::memory_order_acquire);
+  }
+  T& Front() const { return m_read_segment->elements[m_read_index]; }
+
+  template <typename Arg>
+  void Push(Arg&& t)
+  {
+    WriteElement(std::forward<Arg>(t));
+    m_write_count.store(m_write_count.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_release);
+  }
+
+  // Pushes all elements in the range, which the reader only sees once all of them are written.
+  template <typename Iterator>
+  void PushBatch(Iterator begin, Iterator end)
+  {
+    u64 count = 0;
+    for (; begin != end; ++begin, ++count)
+      WriteElement(*begin);
+    m_write_count.store(m_write_count.load(std::memory_order_relaxed) + count,
+                        std::memory_order_release);
+  }
+
+  void Pop()
+  {
+    // Release whatever the element owns right away, like SPSCQueue does.
+    Front() = T{};
+    AdvanceRead();
+    m_read_count.store(m_read_count.load(std::memory_order_relaxed) + 1,
+                       std::memory_order_release);
+  }
+
+  bool Pop(T& t)
+  {
+    if (Empty())
+      return false;
+
+    t = std::move(Front());
+    AdvanceRead();
+    m_read_count.store(m_read_count.load(std::memory_order_relaxed) + 1,
+                       std::memory_order_release);
+    return true;
+  }
+
+  // Pops up to max_count elements into out and returns how many were popped.
+  template <typename OutputIterator>
+  size_t PopBatch(OutputIterator out, size_t max_count)
+  {
+    const u64 read_count = m_read_count.load(std::memory_order_relaxed);
+    const u64 available = m_write_count.load(std::memory_order_acquire) - read_count;
+    const size_t count = static_cast<size_t>(std::min<u64>(available, max_count));
+    for (size_t i = 0; i < count; ++i)
+    {
+      *out++ = std::move(Front());
+      AdvanceRead();
+    }
+    m_read_count.store(read_count + count, std::memory_order_release);
+    return count;
+  }
+
+  // not thread-safe
+  void Clear()
+  {
+    while (!Empty())
+      Pop();
+  }
+
+private:
+  struct Segment
+  {
+    std::array<T, SegmentSize> elements{};
+    std::atomic<Segment*> next = nullptr;
+  };
+
+  static void DeleteSegments(Segment* segment)
+  {
+    while (segment)
+    {
+      Segment* const next = segment->next.load(std::memory_order_relaxed);
+      delete segment;
+      segment = next;
+    }
+  }
+
+  template <typename Arg>
+  void WriteElement(Arg&& t)
+  {
+    m_write_segment->elements[m_write_index] = std::forward<Arg>(t);
+    if (++m_write_index != SegmentSize)
+      return;
+
+    // The next segment is linked before the last element of this one is published, so the reader
+    // always finds it.
+    Segment* segment = m_spare_segment.exchange(nullptr, std::memory_order_acquire);
+    if (!segment)
+      segment = new Segment();
+    m_write_segment->next.store(segment, std::memory_order_relaxed);
+    m_write_segment = segment;
+    m_write_index = 0;
+  }
+
+  void AdvanceRead()
+  {
+    if (++m_read_index != SegmentSize)
+      return;
+
+    Segment* const segment = m_read_segment;
+    m_read_segment = segment->next.load(std::memory_order_relaxed);
+    m_read_index = 0;
+
+    // Only one spare segment is kept, which is enough unless the queue keeps growing.
+    segment->next.store(nullptr, std::memory_order_relaxed);
+    delete m_spare_segment.exchange(segment, std::memory_order_acq_rel);
+  }
+
+  // Only accessed by the writer
+  alignas(64) Segment* m_write_segment;
+  size_t m_write_index = 0;
+  std::atomic<u64> m_write_count = 0;
+
+  // Only accessed by the reader
+  alignas(64) Segment* m_read_segment;
+  size_t m_read_index = 0;
+  std::atomic<u64> m_read_count = 0;
+
+  alignas(64) std::atomic<Segment*> m_spare_segment = nullptr;
+};
 }  // namespace Common
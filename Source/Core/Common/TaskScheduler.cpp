@@ -0,0 +1,214 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/TaskScheduler.h"
+
+#include <algorithm>
+
+#ifdef __APPLE__
+#include <pthread.h>
+#include <sys/qos.h>
+#endif
+
+#include "Common/Thread.h"
+
+namespace Common
+{
+namespace
+{
+thread_local TaskScheduler* s_current_scheduler = nullptr;
+thread_local u32 s_current_worker = 0;
+
+void SetCurrentThreadPriority(TaskPriority priority)
+{
+#ifdef __APPLE__
+  qos_class_t qos_class = QOS_CLASS_USER_INITIATED;
+  switch (priority)
+  {
+  case TaskPriority::High:
+    qos_class = QOS_CLASS_USER_INTERACTIVE;
+    break;
+  case TaskPriority::Normal:
+    qos_class = QOS_CLASS_USER_INITIATED;
+    break;
+  case TaskPriority::Background:
+    qos_class = QOS_CLASS_UTILITY;
+    break;
+  }
+  pthread_set_qos_class_self_np(qos_class, 0);
+#endif
+}
+}  // namespace
+
+TaskScheduler::TaskScheduler(u32 thread_count)
+{
+  thread_count = std::max(thread_count, 1u);
+  for (u32 i = 0; i < thread_count; ++i)
+    m_workers.push_back(std::make_unique<Worker>());
+  for (u32 i = 0; i < thread_count; ++i)
+    m_workers[i]->thread = std::thread(&TaskScheduler::WorkerLoop, this, i);
+}
+
+TaskScheduler::~TaskScheduler()
+{
+  {
+    std::lock_guard lk(m_idle_lock);
+    m_shutdown = true;
+  }
+  m_idle_cond_var.notify_all();
+
+  for (auto& worker : m_workers)
+    worker->thread.join();
+}
+
+TaskScheduler& TaskScheduler::GetInstance()
+{
+  static TaskScheduler s_instance(std::thread::hardware_concurrency());
+  return s_instance;
+}
+
+void TaskScheduler::Schedule(TaskPriority priority, Task task)
+{
+  const u32 index = s_current_scheduler == this ?
+                        s_current_worker :
+                        m_next_worker.fetch_add(1, std::memory_order_relaxed) % GetThreadCount();
+
+  // The count is raised first so that it never drops below the number of queued tasks. A worker
+  // which sees the task before it is queued just looks again.
+  m_queued_tasks.fetch_add(1);
+  {
+    Worker& worker = *m_workers[index];
+    std::lock_guard lk(worker.lock);
+    worker.queues[static_cast<size_t>(priority)].push_back(std::move(task));
+  }
+
+  // Taking the lock makes sure a worker which is about to sleep sees the new count.
+  {
+    std::lock_guard lk(m_idle_lock);
+  }
+  m_idle_cond_var.notify_one();
+}
+
+bool TaskScheduler::PopTask(u32 index, Task* task, TaskPriority* priority)
+{
+  const u32 thread_count = GetThreadCount();
+  for (size_t i = 0; i < NUM_PRIORITIES; ++i)
+  {
+    // Take the oldest task of our own queue, or steal the newest task from another worker.
+    for (u32 j = 0; j < thread_count; ++j)
+    {
+      Worker& worker = *m_workers[(index + j) % thread_count];
+      std::lock_guard lk(worker.lock);
+      auto& queue = worker.queues[i];
+      if (queue.empty())
+        continue;
+
+      if (j == 0)
+      {
+        *task = std::move(queue.front());
+        queue.pop_front();
+      }
+      else
+      {
+        *task = std::move(queue.back());
+        queue.pop_back();
+      }
+      *priority = static_cast<TaskPriority>(i);
+      m_queued_tasks.fetch_sub(1);
+      return true;
+    }
+  }
+  return false;
+}
+
+void TaskScheduler::WorkerLoop(u32 index)
+{
+  Common::SetCurrentThreadName("Task Scheduler Worker");
+  s_current_scheduler = this;
+  s_current_worker = index;
+
+  TaskPriority current_priority = TaskPriority::Normal;
+  SetCurrentThreadPriority(current_priority);
+
+  Task task;
+  TaskPriority priority;
+  while (true)
+  {
+    if (PopTask(index, &task, &priority))
+    {
+      if (priority != current_priority)
+      {
+        SetCurrentThreadPriority(priority);
+        current_priority = priority;
+      }
+      task();
+      task = nullptr;
+      continue;
+    }
+
+    std::unique_lock lk(m_idle_lock);
+    if (m_shutdown && m_queued_tasks.load() == 0)
+      return;
+    m_idle_cond_var.wait(lk, [&] { return m_queued_tasks.load() != 0 || m_shutdown; });
+  }
+}
+
+TaskGroup::TaskGroup(TaskPriority priority) : m_scheduler(nullptr), m_priority(priority)
+{
+}
+
+TaskGroup::TaskGroup(TaskScheduler& scheduler, TaskPriority priority)
+    : m_scheduler(&scheduler), m_priority(priority)
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+  Cancel();
+  Wait();
+}
+
+void TaskGroup::Schedule(TaskScheduler::Task task)
+{
+  if (!m_scheduler)
+    m_scheduler = &TaskScheduler::GetInstance();
+
+  u64 generation;
+  {
+    std::lock_guard lk(m_state->lock);
+    generation = m_state->generation;
+    ++m_state->pending;
+  }
+
+  m_scheduler->Schedule(m_priority, [state = m_state, generation, task = std::move(task)] {
+    {
+      std::lock_guard lk(state->lock);
+      if (state->generation != generation)
+        return;
+      ++state->running;
+    }
+
+    task();
+
+    std::lock_guard lk(state->lock);
+    --state->running;
+    if (--state->pending == 0)
+      state->cond_var.notify_all();
+  });
+}
+
+void TaskGroup::Cancel()
+{
+  std::lock_guard lk(m_state->lock);
+  ++m_state->generation;
+  m_state->pending = m_state->running;
+  if (m_state->pending == 0)
+    m_state->cond_var.notify_all();
+}
+
+void TaskGroup::Wait()
+{
+  std::unique_lock lk(m_state->lock);
+  m_state->cond_var.wait(lk, [&] { return m_state->pending == 0; });
+}
+}  // namespace Common
@@ -0,0 +1,117 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+enum class TaskPriority
+{
+  // Work which emulation is waiting for
+  High,
+  Normal,
+  // Work nobody is waiting for, like writing caches
+  Background,
+};
+
+// A pool of worker threads which subsystems share for running short tasks, so that running
+// several of them at once doesn't start more threads than there are CPU cores.
+// Every worker has its own queues, and workers which run out of tasks steal tasks from the others.
+// Higher priority tasks are always taken first. On macOS, tasks run with a matching QoS class.
+// Tasks must not block waiting for other tasks, since every worker could end up waiting.
+class TaskScheduler
+{
+public:
+  using Task = std::function<void()>;
+
+  explicit TaskScheduler(u32 thread_count);
+  // Runs all tasks which are still queued before returning.
+  ~TaskScheduler();
+
+  TaskScheduler(const TaskScheduler&) = delete;
+  TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+  // The scheduler shared by the whole process, which has one worker per hardware thread.
+  static TaskScheduler& GetInstance();
+
+  u32 GetThreadCount() const { return static_cast<u32>(m_workers.size()); }
+
+  // Tasks scheduled from a worker go to the queue of that worker. Other tasks are spread over all
+  // workers.
+  void Schedule(TaskPriority priority, Task task);
+
+private:
+  static constexpr size_t NUM_PRIORITIES = 3;
+
+  struct Worker
+  {
+    std::mutex lock;
+    std::array<std::deque<Task>, NUM_PRIORITIES> queues;
+    std::thread thread;
+  };
+
+  void WorkerLoop(u32 index);
+  bool PopTask(u32 index, Task* task, TaskPriority* priority);
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  std::atomic<u32> m_next_worker = 0;
+
+  // Counts tasks which were scheduled but haven't been taken by a worker yet
+  std::atomic<u32> m_queued_tasks = 0;
+  std::mutex m_idle_lock;
+  std::condition_variable m_idle_cond_var;
+  bool m_shutdown = false;
+};
+
+// Tasks of one subsystem, which can be waited for or cancelled together. This lets a subsystem
+// make sure none of its tasks are left when it shuts down.
+class TaskGroup
+{
+public:
+  // Uses the scheduler of the process, which is only created once the first task is scheduled.
+  explicit TaskGroup(TaskPriority priority);
+  TaskGroup(TaskScheduler& scheduler, TaskPriority priority);
+  // Cancels the tasks which haven't started yet and waits for the others.
+  ~TaskGroup();
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  void Schedule(TaskScheduler::Task task);
+
+  // Drops the tasks which haven't started yet. Running tasks are not interrupted.
+  void Cancel();
+
+  // Blocks until all tasks of the group are done or cancelled.
+  // Must not be called from a task of the group.
+  void Wait();
+
+private:
+  // Shared with the queued tasks, since cancelled ones can still be queued after the group is gone
+  struct State
+  {
+    std::mutex lock;
+    std::condition_variable cond_var;
+    u64 generation = 0;
+    // Tasks of the current generation which haven't finished, plus running tasks of older ones
+    u32 pending = 0;
+    u32 running = 0;
+  };
+
+  TaskScheduler* m_scheduler;
+  TaskPriority m_priority;
+  std::shared_ptr<State> m_state = std::make_shared<State>();
+};
+}  // namespace Common
@@ -3,6 +3,14 @@
 
 #include "Common/Thread.h"
 
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
 #ifdef _WIN32
 #include <Windows.h>
 #include <processthreadsapi.h>
@@ -13,6 +21,7 @@
 
 #ifdef __APPLE__
 #include <mach/mach.h>
+#include <sys/qos.h>
 #elif defined BSD4_4 || defined __FreeBSD__ || defined __OpenBSD__
 #include <pthread_np.h>
 #elif defined __NetBSD__
@@ -26,8 +35,15 @@
 #pragma comment(lib, "libittnotify.lib")
 #endif
 
+#if defined(__linux__) && !defined(ANDROID)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
+
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
 
 namespace Common
@@ -223,4 +239,282 @@ std::tuple<void*, size_t> GetCurrentThreadStack()
 
 #endif
 
+namespace
+{
+struct CPUTopology
+{
+  // Performance cores which share an L3 cache, for the emulation threads
+  std::vector<u32> emulation_cpus;
+  // Empty if the CPU only has one type of core
+  std::vector<u32> efficiency_cpus;
+};
+
+std::atomic<bool> s_pin_threads = false;
+std::atomic<bool> s_adjust_priorities = false;
+
+// Picks the L3 cache which is shared by the most performance cores, since spreading the emulation
+// threads over several core complexes makes them wait on each other's caches.
+CPUTopology BuildCPUTopology(std::vector<u32> performance_cpus, std::vector<u32> efficiency_cpus,
+                             const std::vector<std::vector<u32>>& l3_groups)
+{
+  CPUTopology topology;
+  topology.efficiency_cpus = std::move(efficiency_cpus);
+  topology.emulation_cpus = std::move(performance_cpus);
+
+  std::vector<u32> best_group;
+  for (const std::vector<u32>& group : l3_groups)
+  {
+    std::vector<u32> cpus;
+    for (const u32 cpu : group)
+    {
+      if (std::ranges::find(topology.emulation_cpus, cpu) != topology.emulation_cpus.end())
+        cpus.push_back(cpu);
+    }
+    if (cpus.size() > best_group.size())
+      best_group = std::move(cpus);
+  }
+
+  // The CPU, GPU and DSP threads need at least two cores between them.
+  if (best_group.size() >= 2)
+    topology.emulation_cpus = std::move(best_group);
+  return topology;
+}
+
+#ifdef _WIN32
+std::vector<u32> MaskToCPUs(KAFFINITY mask)
+{
+  std::vector<u32> cpus;
+  for (u32 i = 0; i < sizeof(mask) * 8; ++i)
+  {
+    if ((mask >> i) & 1)
+      cpus.push_back(i);
+  }
+  return cpus;
+}
+
+// Only processor group 0 is looked at, which is the group threads start in and covers up to 64
+// logical CPUs.
+CPUTopology DetectCPUTopology()
+{
+  DWORD length = 0;
+  GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+  std::vector<u8> buffer(length);
+  if (!GetLogicalProcessorInformationEx(
+          RelationAll, reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()),
+          &length))
+  {
+    return {};
+  }
+
+  std::vector<std::pair<KAFFINITY, BYTE>> cores;
+  std::vector<std::vector<u32>> l3_groups;
+  BYTE max_efficiency_class = 0;
+  for (DWORD offset = 0; offset < length;)
+  {
+    const auto* info =
+        reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+    if (info->Relationship == RelationProcessorCore && info->Processor.GroupMask[0].Group == 0)
+    {
+      // A higher efficiency class means a faster core
+      cores.emplace_back(info->Processor.GroupMask[0].Mask, info->Processor.EfficiencyClass);
+      max_efficiency_class = std::max(max_efficiency_class, info->Processor.EfficiencyClass);
+    }
+    else if (info->Relationship == RelationCache && info->Cache.Level == 3 &&
+             info->Cache.GroupMask.Group == 0)
+    {
+      l3_groups.push_back(MaskToCPUs(info->Cache.GroupMask.Mask));
+    }
+    offset += info->Size;
+  }
+
+  std::vector<u32> performance_cpus;
+  std::vector<u32> efficiency_cpus;
+  for (const auto& [mask, efficiency_class] : cores)
+  {
+    auto& cpus = efficiency_class == max_efficiency_class ? performance_cpus : efficiency_cpus;
+    for (const u32 cpu : MaskToCPUs(mask))
+      cpus.push_back(cpu);
+  }
+  return BuildCPUTopology(std::move(performance_cpus), std::move(efficiency_cpus), l3_groups);
+}
+
+void SetCurrentThreadCPUs(const std::vector<u32>& cpus)
+{
+  KAFFINITY mask = 0;
+  for (const u32 cpu : cpus)
+  {
+    if (cpu < sizeof(mask) * 8)
+      mask |= KAFFINITY(1) << cpu;
+  }
+  if (mask != 0)
+    SetThreadAffinityMask(GetCurrentThread(), mask);
+}
+
+void SetCurrentThreadRolePriority(ThreadRole role)
+{
+  SetThreadPriority(GetCurrentThread(), role == ThreadRole::Emulation ?
+                                            THREAD_PRIORITY_ABOVE_NORMAL :
+                                            THREAD_PRIORITY_BELOW_NORMAL);
+}
+#elif defined(__linux__) && !defined(ANDROID)
+std::string ReadSysfsFile(const std::string& path)
+{
+  std::string contents;
+  File::ReadFileToString(path, contents);
+  return std::string(StripWhitespace(contents));
+}
+
+// Parses the CPU lists used by sysfs, like "0-3,8,10-11"
+std::vector<u32> ParseCPUList(const std::string& list)
+{
+  std::vector<u32> cpus;
+  if (list.empty())
+    return cpus;
+
+  for (const std::string& range : SplitString(list, ','))
+  {
+    const size_t dash = range.find('-');
+    u32 first;
+    u32 last;
+    if (dash == std::string::npos)
+    {
+      if (!TryParse(range, &first))
+        continue;
+      last = first;
+    }
+    else if (!TryParse(range.substr(0, dash), &first) || !TryParse(range.substr(dash + 1), &last))
+    {
+      continue;
+    }
+
+    for (u32 cpu = first; cpu <= last; ++cpu)
+      cpus.push_back(cpu);
+  }
+  return cpus;
+}
+
+CPUTopology DetectCPUTopology()
+{
+  const std::vector<u32> online_cpus =
+      ParseCPUList(ReadSysfsFile("/sys/devices/system/cpu/online"));
+
+  // Hybrid Intel CPUs list the CPUs of each core type
+  std::vector<u32> performance_cpus = ParseCPUList(ReadSysfsFile("/sys/devices/cpu_core/cpus"));
+  std::vector<u32> efficiency_cpus = ParseCPUList(ReadSysfsFile("/sys/devices/cpu_atom/cpus"));
+  if (performance_cpus.empty())
+  {
+    // Other CPUs with several core types, like ARM ones, report the relative capacity of each core
+    std::vector<std::pair<u32, u32>> capacities;
+    u32 max_capacity = 0;
+    for (const u32 cpu : online_cpus)
+    {
+      u32 capacity;
+      if (!TryParse(ReadSysfsFile(fmt::format("/sys/devices/system/cpu/cpu{}/cpu_capacity", cpu)),
+                    &capacity))
+      {
+        capacities.clear();
+        break;
+      }
+      capacities.emplace_back(cpu, capacity);
+      max_capacity = std::max(max_capacity, capacity);
+    }
+
+    if (capacities.empty())
+      performance_cpus = online_cpus;
+    efficiency_cpus.clear();
+    for (const auto& [cpu, capacity] : capacities)
+    {
+      auto& cpus = capacity * 4 >= max_capacity * 3 ? performance_cpus : efficiency_cpus;
+      cpus.push_back(cpu);
+    }
+  }
+
+  std::vector<std::vector<u32>> l3_groups;
+  for (const u32 cpu : online_cpus)
+  {
+    for (u32 index = 0;; ++index)
+    {
+      const std::string cache_path =
+          fmt::format("/sys/devices/system/cpu/cpu{}/cache/index{}/", cpu, index);
+      const std::string level = ReadSysfsFile(cache_path + "level");
+      if (level.empty())
+        break;
+      if (level != "3")
+        continue;
+
+      std::vector<u32> group = ParseCPUList(ReadSysfsFile(cache_path + "shared_cpu_list"));
+      if (std::ranges::find(l3_groups, group) == l3_groups.end())
+        l3_groups.push_back(std::move(group));
+      break;
+    }
+  }
+
+  return BuildCPUTopology(std::move(performance_cpus), std::move(efficiency_cpus), l3_groups);
+}
+
+void SetCurrentThreadCPUs(const std::vector<u32>& cpus)
+{
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const u32 cpu : cpus)
+  {
+    if (cpu < CPU_SETSIZE)
+      CPU_SET(cpu, &cpu_set);
+  }
+  pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+}
+
+void SetCurrentThreadRolePriority(ThreadRole role)
+{
+  // Linux keeps a nice value for every thread
+  const int nice = role == ThreadRole::Emulation ? -5 : 5;
+  if (setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), nice) != 0)
+    WARN_LOG_FMT(COMMON, "Failed to set the nice value of a thread to {}: {}", nice,
+                 LastStrerrorString());
+}
+#endif
+
+#if defined(_WIN32) || (defined(__linux__) && !defined(ANDROID))
+const CPUTopology& GetCPUTopology()
+{
+  static const CPUTopology s_topology = [] {
+    CPUTopology topology = DetectCPUTopology();
+    INFO_LOG_FMT(COMMON, "CPUs for emulation threads: {}, efficiency CPUs: {}",
+                 fmt::join(topology.emulation_cpus, ","), fmt::join(topology.efficiency_cpus, ","));
+    return topology;
+  }();
+  return s_topology;
+}
+#endif
+}  // namespace
+
+void SetThreadPlacement(bool pin_threads, bool adjust_priorities)
+{
+  s_pin_threads.store(pin_threads, std::memory_order_relaxed);
+  s_adjust_priorities.store(adjust_priorities, std::memory_order_relaxed);
+}
+
+void SetCurrentThreadRole([[maybe_unused]] ThreadRole role)
+{
+#ifdef __APPLE__
+  if (s_pin_threads.load(std::memory_order_relaxed) ||
+      s_adjust_priorities.load(std::memory_order_relaxed))
+  {
+    pthread_set_qos_class_self_np(
+        role == ThreadRole::Emulation ? QOS_CLASS_USER_INTERACTIVE : QOS_CLASS_UTILITY, 0);
+  }
+#elif defined(_WIN32) || (defined(__linux__) && !defined(ANDROID))
+  if (s_pin_threads.load(std::memory_order_relaxed))
+  {
+    const CPUTopology& topology = GetCPUTopology();
+    const std::vector<u32>& cpus =
+        role == ThreadRole::Emulation ? topology.emulation_cpus : topology.efficiency_cpus;
+    if (!cpus.empty())
+      SetCurrentThreadCPUs(cpus);
+  }
+  if (s_adjust_priorities.load(std::memory_order_relaxed))
+    SetCurrentThreadRolePriority(role);
+#endif
+}
+
 }  // namespace Common
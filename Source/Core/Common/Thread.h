@@ -39,6 +39,24 @@ inline void YieldCPU()
 
 void SetCurrentThreadName(const char* name);
 
+enum class ThreadRole
+{
+  // Threads emulation speed depends on, like the CPU, GPU and DSP threads
+  Emulation,
+  // Threads doing work nothing is waiting for, like compiling shaders ahead of time
+  Background,
+};
+
+// Configures what SetCurrentThreadRole does. With pin_threads, emulation threads are pinned to the
+// performance cores which share an L3 cache, and background threads to the efficiency cores if
+// the CPU has any. With adjust_priorities, emulation threads get a higher priority and background
+// threads a lower one. Raising the priority may need extra privileges on Linux.
+void SetThreadPlacement(bool pin_threads, bool adjust_priorities);
+
+// Places the current thread according to its role. On macOS, where threads can't be pinned, the
+// role picks a QoS class instead, which the OS uses to choose between core types.
+void SetCurrentThreadRole(ThreadRole role);
+
 #ifndef _WIN32
 // Returns the lowest address of the stack and the size of the stack
 std::tuple<void*, size_t> GetCurrentThreadStack();
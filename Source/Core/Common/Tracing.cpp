@@ -0,0 +1,148 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/Tracing.h"
+
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+
+namespace Common::Tracing
+{
+namespace detail
+{
+std::atomic<bool> s_enabled = false;
+}
+
+namespace
+{
+// Keeps a forgotten trace from using up all memory, at roughly 100 MB worth of events
+constexpr size_t MAX_EVENTS = 1 << 20;
+
+struct Event
+{
+  const char* category;
+  std::string name;
+  u64 start_us;
+  u64 duration_us;
+  int thread_id;
+};
+
+std::mutex s_mutex;
+std::string s_path;
+u64 s_start_us = 0;
+std::vector<Event> s_events;
+u64 s_dropped_events = 0;
+
+std::string EscapeJSON(std::string_view str)
+{
+  std::string result;
+  result.reserve(str.size());
+  for (const char c : str)
+  {
+    if (c == '"' || c == '\\')
+    {
+      result.push_back('\\');
+      result.push_back(c);
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      result += fmt::format("\\u{:04x}", static_cast<int>(c));
+    }
+    else
+    {
+      result.push_back(c);
+    }
+  }
+  return result;
+}
+}  // namespace
+
+void Start(std::string path)
+{
+  std::lock_guard lock(s_mutex);
+  s_path = std::move(path);
+  s_start_us = Timer::NowUs();
+  s_events.clear();
+  s_dropped_events = 0;
+  detail::s_enabled.store(true, std::memory_order_relaxed);
+}
+
+bool Stop()
+{
+  std::vector<Event> events;
+  std::string path;
+  u64 start_us;
+  u64 dropped_events;
+  {
+    std::lock_guard lock(s_mutex);
+    if (!IsEnabled())
+      return true;
+
+    detail::s_enabled.store(false, std::memory_order_relaxed);
+    events = std::move(s_events);
+    s_events = {};
+    path = std::move(s_path);
+    start_us = s_start_us;
+    dropped_events = s_dropped_events;
+  }
+
+  if (dropped_events != 0)
+    WARN_LOG_FMT(COMMON, "Trace was full, {} events were dropped", dropped_events);
+
+  File::IOFile file(path, "w");
+  if (!file)
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to open {} for writing the trace", path);
+    return false;
+  }
+
+  file.WriteString("{\"traceEvents\":[\n");
+  for (size_t i = 0; i < events.size(); ++i)
+  {
+    const Event& event = events[i];
+    // Events that started before the trace (e.g. scopes that were entered right before) begin at 0
+    const u64 timestamp = event.start_us > start_us ? event.start_us - start_us : 0;
+    file.WriteString(fmt::format("{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"ts\":{},"
+                                 "\"dur\":{},\"pid\":1,\"tid\":{}}}{}\n",
+                                 EscapeJSON(event.name), event.category, timestamp,
+                                 event.duration_us, event.thread_id,
+                                 i + 1 < events.size() ? "," : ""));
+  }
+  file.WriteString("]}\n");
+
+  if (!file.IsGood())
+  {
+    ERROR_LOG_FMT(COMMON, "Failed to write the trace to {}", path);
+    return false;
+  }
+
+  INFO_LOG_FMT(COMMON, "Wrote {} trace events to {}", events.size(), path);
+  return true;
+}
+
+void AddEvent(const char* category, std::string name, u64 start_us, u64 duration_us)
+{
+  const int thread_id = CurrentThreadId();
+
+  std::lock_guard lock(s_mutex);
+  if (!IsEnabled())
+    return;
+
+  if (s_events.size() >= MAX_EVENTS)
+  {
+    ++s_dropped_events;
+    return;
+  }
+
+  s_events.push_back({category, std::move(name), start_us, duration_us, thread_id});
+}
+}  // namespace Common::Tracing
@@ -0,0 +1,60 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "Common/Timer.h"
+
+// Records timed events from any thread and writes them as a Chrome trace-event JSON file, which
+// can be opened in chrome://tracing or Perfetto. While no trace is being recorded, the only cost
+// of a trace point is checking IsEnabled().
+namespace Common::Tracing
+{
+namespace detail
+{
+extern std::atomic<bool> s_enabled;
+}
+
+inline bool IsEnabled()
+{
+  return detail::s_enabled.load(std::memory_order_relaxed);
+}
+
+// Starts recording events, which are written to the file when the trace is stopped.
+void Start(std::string path);
+// Stops recording and writes the trace. Returns false if the file couldn't be written.
+bool Stop();
+
+// Adds an event that started at start_us (from Common::Timer::NowUs) on the calling thread.
+// The category must be a string literal.
+void AddEvent(const char* category, std::string name, u64 start_us, u64 duration_us);
+
+// Adds an event covering the lifetime of the object, if a trace was being recorded when it was
+// created. The category and name must be string literals.
+class ScopedEvent
+{
+public:
+  ScopedEvent(const char* category, const char* name)
+      : m_category(category), m_name(name), m_start_us(IsEnabled() ? Timer::NowUs() : 0)
+  {
+  }
+  ~ScopedEvent()
+  {
+    if (m_start_us != 0)
+      AddEvent(m_category, m_name, m_start_us, Timer::NowUs() - m_start_us);
+  }
+  ScopedEvent(const ScopedEvent&) = delete;
+  ScopedEvent(ScopedEvent&&) = delete;
+  ScopedEvent& operator=(const ScopedEvent&) = delete;
+  ScopedEvent& operator=(ScopedEvent&&) = delete;
+
+private:
+  const char* m_category;
+  const char* m_name;
+  u64 m_start_us;
+};
+}  // namespace Common::Tracing
@@ -1,23 +1,41 @@
 // SPDX-License-Identifier: CC0-1.0
 
 // The central server implementation.
+// Packets are handled by several worker threads. On Linux, every worker has its own pair of
+// sockets and SO_REUSEPORT spreads the clients over them, elsewhere the workers share one pair.
+// The packets for a host can arrive on any worker, so the tables of hosts and of packets waiting
+// for an ack are split into shards which each have their own lock.
+#include <algorithm>
 #include <arpa/inet.h>
+#include <array>
+#include <atomic>
 #include <cerrno>
 #include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <fcntl.h>
+#include <memory>
+#include <mutex>
 #include <netinet/in.h>
-#include <sys/select.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <thread>
 #include <tuple>
 #include <unistd.h>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#if defined(__linux__)
+#include <sys/epoll.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__)
+#include <sys/event.h>
+#define HAVE_KQUEUE 1
+#else
+#include <poll.h>
+#endif
+
 #include <fmt/format.h>
 
 #ifdef HAVE_LIBSYSTEMD
@@ -31,8 +49,20 @@
 #define NUMBER_OF_TRIES 5
 #define PORT 6262
 #define PORT_ALT 6226
-
-static u64 currentTime;
+#define CLIENT_EXPIRY_TIME (30 * 1000000)  // 30s
+#define SHARD_BITS 6
+#define NUMBER_OF_SHARDS (1 << SHARD_BITS)
+// Packets which are received or sent with one system call
+#define BATCH_SIZE 64
+// Batches which are received before looking at the packets which need to be resent
+#define MAX_BATCHES 16
+#define RESEND_CHECK_INTERVAL 100000   // 100ms
+#define EXPIRY_CHECK_INTERVAL 5000000  // 5s
+#define STATISTICS_INTERVAL 60000000   // 60s
+
+// Each worker has its own clock, so the times stored in the tables can be slightly ahead of the
+// clock of the worker looking at them.
+static thread_local u64 currentTime;
 
 struct OutgoingPacketInfo
 {
@@ -63,7 +93,6 @@ EvictFindResult<V> EvictFind(std::unordered_map<K, EvictEntry<V>>& map, const K&
                              bool refresh = false)
 {
 retry:
-  const u64 expiryTime = 30 * 1000000;  // 30s
   EvictFindResult<V> result;
   if (map.bucket_count())
   {
@@ -71,7 +100,7 @@ retry:
     auto it = map.begin(bucket);
     for (; it != map.end(bucket); ++it)
     {
-      if (currentTime - it->second.updateTime > expiryTime)
+      if (currentTime > it->second.updateTime + CLIENT_EXPIRY_TIME)
       {
         map.erase(it->first);
         goto retry;
@@ -124,10 +153,73 @@ using ConnectedClients =
     std::unordered_map<Common::TraversalHostId, EvictEntry<Common::TraversalInetAddress>>;
 using OutgoingPackets = std::unordered_map<Common::TraversalRequestId, OutgoingPacketInfo>;
 
-static int sock;
-static int sockAlt;
-static OutgoingPackets outgoingPackets;
-static ConnectedClients connectedClients;
+template <typename Map>
+struct Shard
+{
+  std::mutex lock;
+  Map map;
+};
+
+struct QueuedSend
+{
+  Common::TraversalPacket packet;
+  sockaddr_in6 dest;
+  bool fromAlt;
+};
+
+// Only written by the worker which owns them
+struct Statistics
+{
+  std::atomic<u64> packetsReceived = 0;
+  std::atomic<u64> packetsSent = 0;
+  std::atomic<u64> badPackets = 0;
+  std::atomic<u64> sendErrors = 0;
+  std::atomic<u64> resends = 0;
+  std::atomic<u64> timeouts = 0;
+};
+
+struct Worker
+{
+  size_t index;
+  int sock;
+  int sockAlt;
+  int poller;
+  std::vector<QueuedSend> sends;
+  Statistics statistics;
+};
+
+static std::array<Shard<ConnectedClients>, NUMBER_OF_SHARDS> clientShards;
+static std::array<Shard<OutgoingPackets>, NUMBER_OF_SHARDS> packetShards;
+static std::vector<std::unique_ptr<Worker>> workers;
+static thread_local Worker* worker;
+
+static size_t GetShardIndex(u64 hash)
+{
+  // The host IDs are made of hex digits, so the bits of their hash have to be mixed first.
+  return static_cast<size_t>((hash * 0x9E3779B97F4A7C15ULL) >> (64 - SHARD_BITS));
+}
+
+static Shard<ConnectedClients>& GetClientShard(const Common::TraversalHostId& hostId)
+{
+  return clientShards[GetShardIndex(std::hash<Common::TraversalHostId>{}(hostId))];
+}
+
+static Shard<OutgoingPackets>& GetPacketShard(Common::TraversalRequestId requestId)
+{
+  return packetShards[GetShardIndex(requestId)];
+}
+
+static void Count(std::atomic<u64>& counter, u64 count = 1)
+{
+  counter.store(counter.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+}
+
+static void UpdateCurrentTime()
+{
+  currentTime = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::system_clock::now().time_since_epoch())
+                    .count();
+}
 
 static Common::TraversalInetAddress MakeInetAddress(const sockaddr_in6& addr)
 {
@@ -187,84 +279,177 @@ static void GetRandomHostId(Common::TraversalHostId* hostId)
 
 static const char* SenderName(sockaddr_in6* addr)
 {
-  static char buf[INET6_ADDRSTRLEN + 10]{};
+  static thread_local char buf[INET6_ADDRSTRLEN + 10]{};
   inet_ntop(PF_INET6, &addr->sin6_addr, buf, sizeof(buf));
   fmt::format_to(buf + strlen(buf), ":{}", ntohs(addr->sin6_port));
   return buf;
 }
 
-static void TrySend(const void* buffer, size_t size, sockaddr_in6* addr, bool fromAlt)
+static void TrySend(const Common::TraversalPacket& packet, const sockaddr_in6& addr, bool fromAlt)
 {
 #if DEBUG
-  const auto* packet = static_cast<const Common::TraversalPacket*>(buffer);
-  fmt::print("{}-> {} {} {}\n", fromAlt ? "alt " : "", static_cast<int>(packet->type),
-             static_cast<long long>(packet->requestId), SenderName(addr));
+  sockaddr_in6 debugAddr = addr;
+  fmt::print("{}-> {} {} {}\n", fromAlt ? "alt " : "", static_cast<int>(packet.type),
+             static_cast<long long>(packet.requestId), SenderName(&debugAddr));
 #endif
-  if ((size_t)sendto(fromAlt ? sockAlt : sock, buffer, size, 0, (sockaddr*)addr, sizeof(*addr)) !=
-      size)
+  worker->sends.push_back({packet, addr, fromAlt});
+}
+
+#ifdef __linux__
+static void SendBatch(int sendsock, mmsghdr* msgs, size_t count)
+{
+  size_t done = 0;
+  while (done < count)
   {
-    perror("sendto");
+    const int rv = sendmmsg(sendsock, msgs + done, static_cast<unsigned int>(count - done), 0);
+    if (rv < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      // Skip the packet which couldn't be sent
+      perror("sendmmsg");
+      Count(worker->statistics.sendErrors);
+      ++done;
+      continue;
+    }
+    Count(worker->statistics.packetsSent, rv);
+    done += rv;
   }
 }
+#endif
 
-static Common::TraversalPacket* AllocPacket(const sockaddr_in6& dest, bool fromAlt,
-                                            Common::TraversalRequestId misc = 0)
+static void FlushSends()
+{
+#ifdef __linux__
+  std::array<mmsghdr, BATCH_SIZE> msgs;
+  std::array<iovec, BATCH_SIZE> iovecs;
+  for (const bool fromAlt : {false, true})
+  {
+    const int sendsock = fromAlt ? worker->sockAlt : worker->sock;
+    size_t count = 0;
+    for (QueuedSend& send : worker->sends)
+    {
+      if (send.fromAlt != fromAlt)
+        continue;
+      iovecs[count] = {&send.packet, sizeof(send.packet)};
+      msgs[count] = {};
+      msgs[count].msg_hdr.msg_name = &send.dest;
+      msgs[count].msg_hdr.msg_namelen = sizeof(send.dest);
+      msgs[count].msg_hdr.msg_iov = &iovecs[count];
+      msgs[count].msg_hdr.msg_iovlen = 1;
+      if (++count == BATCH_SIZE)
+      {
+        SendBatch(sendsock, msgs.data(), count);
+        count = 0;
+      }
+    }
+    SendBatch(sendsock, msgs.data(), count);
+  }
+#else
+  for (QueuedSend& send : worker->sends)
+  {
+    if (sendto(send.fromAlt ? worker->sockAlt : worker->sock, &send.packet, sizeof(send.packet), 0,
+               (sockaddr*)&send.dest, sizeof(send.dest)) != sizeof(send.packet))
+    {
+      perror("sendto");
+      Count(worker->statistics.sendErrors);
+    }
+    else
+    {
+      Count(worker->statistics.packetsSent);
+    }
+  }
+#endif
+  worker->sends.clear();
+}
+
+// Sends a packet which is resent until the destination acks it.
+static void SendReliably(Common::TraversalPacket packet, const sockaddr_in6& dest, bool fromAlt,
+                         Common::TraversalRequestId misc = 0)
 {
   Common::TraversalRequestId requestId{};
   Common::Random::Generate(&requestId, sizeof(requestId));
-  OutgoingPacketInfo* info = &outgoingPackets[requestId];
-  info->fromAlt = fromAlt;
-  info->dest = dest;
-  info->misc = misc;
-  info->tries = 0;
-  info->sendTime = currentTime;
-  Common::TraversalPacket* result = &info->packet;
-  memset(result, 0, sizeof(*result));
-  result->requestId = requestId;
-  return result;
+  packet.requestId = requestId;
+  {
+    auto& shard = GetPacketShard(requestId);
+    std::lock_guard lk(shard.lock);
+    OutgoingPacketInfo* info = &shard.map[requestId];
+    info->packet = packet;
+    info->fromAlt = fromAlt;
+    info->dest = dest;
+    info->misc = misc;
+    info->tries = 1;
+    info->sendTime = currentTime;
+  }
+  TrySend(packet, dest, fromAlt);
 }
 
 static void SendPacket(OutgoingPacketInfo* info)
 {
   info->tries++;
   info->sendTime = currentTime;
-  TrySend(&info->packet, sizeof(info->packet), &info->dest, info->fromAlt);
+  TrySend(info->packet, info->dest, info->fromAlt);
+  Count(worker->statistics.resends);
 }
 
+// Each worker looks after the shards whose index modulo the number of workers is its own index.
 static void ResendPackets()
 {
   std::vector<std::tuple<Common::TraversalInetAddress, bool, Common::TraversalRequestId>>
       todoFailures;
-  todoFailures.clear();
-  for (auto it = outgoingPackets.begin(); it != outgoingPackets.end();)
+  for (size_t i = worker->index; i < packetShards.size(); i += workers.size())
   {
-    OutgoingPacketInfo* info = &it->second;
-    if (currentTime - info->sendTime >= (u64)(300000 * info->tries))
+    auto& shard = packetShards[i];
+    std::lock_guard lk(shard.lock);
+    for (auto it = shard.map.begin(); it != shard.map.end();)
     {
-      if (info->tries >= NUMBER_OF_TRIES)
+      OutgoingPacketInfo* info = &it->second;
+      if (currentTime >= info->sendTime + (u64)(300000 * info->tries))
       {
-        if (info->packet.type == Common::TraversalPacketType::PleaseSendPacket)
+        if (info->tries >= NUMBER_OF_TRIES)
         {
-          todoFailures.push_back(
-              std::make_tuple(info->packet.pleaseSendPacket.address, info->fromAlt, info->misc));
+          if (info->packet.type == Common::TraversalPacketType::PleaseSendPacket)
+          {
+            todoFailures.push_back(
+                std::make_tuple(info->packet.pleaseSendPacket.address, info->fromAlt, info->misc));
+          }
+          Count(worker->statistics.timeouts);
+          it = shard.map.erase(it);
+          continue;
+        }
+        else
+        {
+          SendPacket(info);
         }
-        it = outgoingPackets.erase(it);
-        continue;
-      }
-      else
-      {
-        SendPacket(info);
       }
+      ++it;
     }
-    ++it;
   }
 
   for (const auto& p : todoFailures)
   {
-    Common::TraversalPacket* fail = AllocPacket(MakeSinAddr(std::get<0>(p)), std::get<1>(p));
-    fail->type = Common::TraversalPacketType::ConnectFailed;
-    fail->connectFailed.requestId = std::get<2>(p);
-    fail->connectFailed.reason = Common::TraversalConnectFailedReason::ClientDidntRespond;
+    Common::TraversalPacket fail{};
+    fail.type = Common::TraversalPacketType::ConnectFailed;
+    fail.connectFailed.requestId = std::get<2>(p);
+    fail.connectFailed.reason = Common::TraversalConnectFailedReason::ClientDidntRespond;
+    SendReliably(fail, MakeSinAddr(std::get<0>(p)), std::get<1>(p));
+  }
+}
+
+// Lookups only drop the expired hosts in the bucket they look at, so the others are dropped here.
+static void EvictExpiredClients()
+{
+  for (size_t i = worker->index; i < clientShards.size(); i += workers.size())
+  {
+    auto& shard = clientShards[i];
+    std::lock_guard lk(shard.lock);
+    for (auto it = shard.map.begin(); it != shard.map.end();)
+    {
+      if (currentTime > it->second.updateTime + CLIENT_EXPIRY_TIME)
+        it = shard.map.erase(it);
+      else
+        ++it;
+    }
   }
 }
 
@@ -279,106 +464,133 @@ static void HandlePacket(Common::TraversalPacket* packet, sockaddr_in6* addr, bo
   {
   case Common::TraversalPacketType::Ack:
   {
-    auto it = outgoingPackets.find(packet->requestId);
-    if (it == outgoingPackets.end())
-      break;
-
-    OutgoingPacketInfo* info = &it->second;
+    // Only one shard is locked at a time, so the packet is taken out of the table first.
+    OutgoingPacketInfo info;
+    {
+      auto& shard = GetPacketShard(packet->requestId);
+      std::lock_guard lk(shard.lock);
+      auto it = shard.map.find(packet->requestId);
+      if (it == shard.map.end())
+        break;
+      info = it->second;
+      shard.map.erase(it);
+    }
 
-    if (info->packet.type == Common::TraversalPacketType::PleaseSendPacket)
+    if (info.packet.type == Common::TraversalPacketType::PleaseSendPacket)
     {
-      auto* ready = AllocPacket(MakeSinAddr(info->packet.pleaseSendPacket.address), toAlt);
+      Common::TraversalPacket ready{};
       if (packet->ack.ok)
       {
-        ready->type = Common::TraversalPacketType::ConnectReady;
-        ready->connectReady.requestId = info->misc;
-        ready->connectReady.address = MakeInetAddress(info->dest);
+        ready.type = Common::TraversalPacketType::ConnectReady;
+        ready.connectReady.requestId = info.misc;
+        ready.connectReady.address = MakeInetAddress(info.dest);
       }
       else
       {
-        ready->type = Common::TraversalPacketType::ConnectFailed;
-        ready->connectFailed.requestId = info->misc;
-        ready->connectFailed.reason = Common::TraversalConnectFailedReason::ClientFailure;
+        ready.type = Common::TraversalPacketType::ConnectFailed;
+        ready.connectFailed.requestId = info.misc;
+        ready.connectFailed.reason = Common::TraversalConnectFailedReason::ClientFailure;
       }
+      SendReliably(ready, MakeSinAddr(info.packet.pleaseSendPacket.address), toAlt);
     }
-
-    outgoingPackets.erase(it);
     break;
   }
   case Common::TraversalPacketType::Ping:
   {
-    auto r = EvictFind(connectedClients, packet->ping.hostId, true);
+    auto& shard = GetClientShard(packet->ping.hostId);
+    std::lock_guard lk(shard.lock);
+    auto r = EvictFind(shard.map, packet->ping.hostId, true);
     packetOk = r.found;
     break;
   }
   case Common::TraversalPacketType::HelloFromClient:
   {
     u8 ok = packet->helloFromClient.protoVersion <= Common::TraversalProtoVersion;
-    Common::TraversalPacket* reply = AllocPacket(*addr, toAlt);
-    reply->type = Common::TraversalPacketType::HelloFromServer;
-    reply->helloFromServer.ok = ok;
+    Common::TraversalPacket reply{};
+    reply.type = Common::TraversalPacketType::HelloFromServer;
+    reply.helloFromServer.ok = ok;
     if (ok)
     {
       Common::TraversalHostId hostId{};
-      Common::TraversalInetAddress* iaddr{};
+      const Common::TraversalInetAddress iaddr = MakeInetAddress(*addr);
       // not that there is any significant change of
       // duplication, but...
       while (true)
       {
         GetRandomHostId(&hostId);
-        auto r = EvictFind(connectedClients, hostId);
+        auto& shard = GetClientShard(hostId);
+        std::lock_guard lk(shard.lock);
+        auto r = EvictFind(shard.map, hostId);
         if (!r.found)
         {
-          iaddr = EvictSet(connectedClients, hostId);
+          *EvictSet(shard.map, hostId) = iaddr;
           break;
         }
       }
 
-      *iaddr = MakeInetAddress(*addr);
-
-      reply->helloFromServer.yourAddress = *iaddr;
-      reply->helloFromServer.yourHostId = hostId;
+      reply.helloFromServer.yourAddress = iaddr;
+      reply.helloFromServer.yourHostId = hostId;
     }
+    SendReliably(reply, *addr, toAlt);
     break;
   }
   case Common::TraversalPacketType::ConnectPlease:
   {
     Common::TraversalHostId& hostId = packet->connectPlease.hostId;
-    auto r = EvictFind(connectedClients, hostId);
-    if (!r.found)
+    Common::TraversalInetAddress hostAddr;
+    bool found;
     {
-      Common::TraversalPacket* reply = AllocPacket(*addr, toAlt);
-      reply->type = Common::TraversalPacketType::ConnectFailed;
-      reply->connectFailed.requestId = packet->requestId;
-      reply->connectFailed.reason = Common::TraversalConnectFailedReason::NoSuchClient;
+      auto& shard = GetClientShard(hostId);
+      std::lock_guard lk(shard.lock);
+      auto r = EvictFind(shard.map, hostId);
+      found = r.found;
+      if (found)
+        hostAddr = *r.value;
+    }
+    if (!found)
+    {
+      Common::TraversalPacket reply{};
+      reply.type = Common::TraversalPacketType::ConnectFailed;
+      reply.connectFailed.requestId = packet->requestId;
+      reply.connectFailed.reason = Common::TraversalConnectFailedReason::NoSuchClient;
+      SendReliably(reply, *addr, toAlt);
     }
     else
     {
-      Common::TraversalPacket* please =
-          AllocPacket(MakeSinAddr(*r.value), toAlt, packet->requestId);
-      please->type = Common::TraversalPacketType::PleaseSendPacket;
-      please->pleaseSendPacket.address = MakeInetAddress(*addr);
+      Common::TraversalPacket please{};
+      please.type = Common::TraversalPacketType::PleaseSendPacket;
+      please.pleaseSendPacket.address = MakeInetAddress(*addr);
+      SendReliably(please, MakeSinAddr(hostAddr), toAlt, packet->requestId);
     }
     break;
   }
   case Common::TraversalPacketType::TestPlease:
   {
     Common::TraversalHostId& hostId = packet->testPlease.hostId;
-    auto r = EvictFind(connectedClients, hostId);
-    if (r.found)
+    Common::TraversalInetAddress hostAddr;
+    bool found;
+    {
+      auto& shard = GetClientShard(hostId);
+      std::lock_guard lk(shard.lock);
+      auto r = EvictFind(shard.map, hostId);
+      found = r.found;
+      if (found)
+        hostAddr = *r.value;
+    }
+    if (found)
     {
       Common::TraversalPacket ack = {};
       ack.type = Common::TraversalPacketType::Ack;
       ack.requestId = packet->requestId;
       ack.ack.ok = true;
-      sockaddr_in6 mainAddr = MakeSinAddr(*r.value);
-      TrySend(&ack, sizeof(ack), &mainAddr, toAlt);
+      TrySend(ack, MakeSinAddr(hostAddr), toAlt);
     }
     break;
   }
   default:
     fmt::print(stderr, "received unknown packet type {} from {}\n", static_cast<int>(packet->type),
                SenderName(addr));
+    Count(worker->statistics.badPackets);
     break;
   }
   if (packet->type != Common::TraversalPacketType::Ack)
@@ -387,144 +599,310 @@ static void HandlePacket(Common::TraversalPacket* packet, sockaddr_in6* addr, bo
     ack.type = Common::TraversalPacketType::Ack;
     ack.requestId = packet->requestId;
     ack.ack.ok = packetOk;
-    TrySend(&ack, sizeof(ack), addr,
-            packet->type != Common::TraversalPacketType::TestPlease ? toAlt : !toAlt);
+    TrySend(ack, *addr, packet->type != Common::TraversalPacketType::TestPlease ? toAlt : !toAlt);
   }
 }
 
-int main()
+static int CreatePoller(int sock, int sockAlt)
 {
-  int rv;
-  sock = socket(PF_INET6, SOCK_DGRAM, 0);
-  if (sock == -1)
+#if defined(__linux__)
+  const int poller = epoll_create1(0);
+  if (poller == -1)
+    return -1;
+  for (const int s : {sock, sockAlt})
   {
-    perror("socket");
-    return 1;
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = s;
+    if (epoll_ctl(poller, EPOLL_CTL_ADD, s, &event) < 0)
+    {
+      close(poller);
+      return -1;
+    }
   }
-  sockAlt = socket(PF_INET6, SOCK_DGRAM, 0);
-  if (sockAlt == -1)
+  return poller;
+#elif defined(HAVE_KQUEUE)
+  const int poller = kqueue();
+  if (poller == -1)
+    return -1;
+  struct kevent changes[2];
+  EV_SET(&changes[0], sock, EVFILT_READ, EV_ADD, 0, 0, nullptr);
+  EV_SET(&changes[1], sockAlt, EVFILT_READ, EV_ADD, 0, 0, nullptr);
+  if (kevent(poller, changes, 2, nullptr, 0, nullptr) < 0)
   {
-    perror("socket alt");
-    return 1;
+    close(poller);
+    return -1;
   }
-  int no = 0;
-  rv = setsockopt(sock, IPPROTO_IPV6, IPV6_V6ONLY, &no, sizeof(no));
-  if (rv < 0)
+  return poller;
+#else
+  return 0;
+#endif
+}
+
+// Returns when a socket might be readable or the timeout expired.
+static void WaitForPackets(int timeoutMs)
+{
+#if defined(__linux__)
+  epoll_event events[2];
+  const int rv = epoll_wait(worker->poller, events, 2, timeoutMs);
+#elif defined(HAVE_KQUEUE)
+  struct kevent events[2];
+  const timespec timeout{0, timeoutMs * 1000000L};
+  const int rv = kevent(worker->poller, nullptr, 0, events, 2, &timeout);
+#else
+  pollfd fds[2] = {{worker->sock, POLLIN, 0}, {worker->sockAlt, POLLIN, 0}};
+  const int rv = poll(fds, 2, timeoutMs);
+#endif
+  if (rv < 0 && errno != EINTR)
   {
-    perror("setsockopt IPV6_V6ONLY");
-    return 1;
+    perror("wait");
+    exit(1);
+  }
+}
+
+// Returns the number of packets received, which is 0 if there are none left.
+static size_t ReceiveBatch(int recvsock, Common::TraversalPacket* packets, sockaddr_in6* addrs,
+                           size_t* sizes)
+{
+#ifdef __linux__
+  std::array<mmsghdr, BATCH_SIZE> msgs;
+  std::array<iovec, BATCH_SIZE> iovecs;
+  for (size_t i = 0; i < BATCH_SIZE; i++)
+  {
+    iovecs[i] = {&packets[i], sizeof(packets[i])};
+    msgs[i] = {};
+    msgs[i].msg_hdr.msg_name = &addrs[i];
+    msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+    msgs[i].msg_hdr.msg_iov = &iovecs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
   }
-  rv = setsockopt(sockAlt, IPPROTO_IPV6, IPV6_V6ONLY, &no, sizeof(no));
+  const int rv = recvmmsg(recvsock, msgs.data(), BATCH_SIZE, MSG_DONTWAIT, nullptr);
   if (rv < 0)
   {
-    perror("setsockopt IPV6_V6ONLY alt");
-    return 1;
+    if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK)
+    {
+      perror("recvmmsg");
+      exit(1);
+    }
+    return 0;
   }
-  in6_addr any = IN6ADDR_ANY_INIT;
-  sockaddr_in6 addr;
-#ifdef SIN6_LEN
-  addr.sin6_len = sizeof(addr);
+  for (int i = 0; i < rv; i++)
+    sizes[i] = msgs[i].msg_len;
+  return rv;
+#else
+  size_t count = 0;
+  for (; count < BATCH_SIZE; count++)
+  {
+    socklen_t addrLen = sizeof(addrs[count]);
+    const ssize_t rv = recvfrom(recvsock, &packets[count], sizeof(packets[count]), MSG_DONTWAIT,
+                                (sockaddr*)&addrs[count], &addrLen);
+    if (rv < 0)
+    {
+      if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK)
+      {
+        perror("recvfrom");
+        exit(1);
+      }
+      break;
+    }
+    sizes[count] = rv;
+  }
+  return count;
 #endif
-  addr.sin6_family = AF_INET6;
-  addr.sin6_port = htons(PORT);
-  addr.sin6_flowinfo = 0;
-  addr.sin6_addr = any;
-  addr.sin6_scope_id = 0;
+}
 
-  rv = bind(sock, (sockaddr*)&addr, sizeof(addr));
-  if (rv < 0)
+static void ReceivePackets(int recvsock, bool fromAlt)
+{
+  std::array<Common::TraversalPacket, BATCH_SIZE> packets;
+  std::array<sockaddr_in6, BATCH_SIZE> addrs;
+  std::array<size_t, BATCH_SIZE> sizes;
+  for (int batch = 0; batch < MAX_BATCHES; batch++)
   {
-    perror("bind");
-    return 1;
+    const size_t count = ReceiveBatch(recvsock, packets.data(), addrs.data(), sizes.data());
+    Count(worker->statistics.packetsReceived, count);
+    for (size_t i = 0; i < count; i++)
+    {
+      if (sizes[i] < sizeof(packets[i]))
+      {
+        fmt::print(stderr, "received short packet from {}\n", SenderName(&addrs[i]));
+        Count(worker->statistics.badPackets);
+      }
+      else
+      {
+        HandlePacket(&packets[i], &addrs[i], fromAlt);
+      }
+    }
+    FlushSends();
+    if (count < BATCH_SIZE)
+      break;
   }
-  addr.sin6_port = htons(PORT_ALT);
-  rv = bind(sockAlt, (sockaddr*)&addr, sizeof(addr));
-  if (rv < 0)
+}
+
+static void PrintStatistics()
+{
+  u64 received = 0, sent = 0, bad = 0, sendErrors = 0, resends = 0, timeouts = 0;
+  for (const auto& w : workers)
   {
-    perror("bind alt");
-    return 1;
+    received += w->statistics.packetsReceived.load(std::memory_order_relaxed);
+    sent += w->statistics.packetsSent.load(std::memory_order_relaxed);
+    bad += w->statistics.badPackets.load(std::memory_order_relaxed);
+    sendErrors += w->statistics.sendErrors.load(std::memory_order_relaxed);
+    resends += w->statistics.resends.load(std::memory_order_relaxed);
+    timeouts += w->statistics.timeouts.load(std::memory_order_relaxed);
   }
-
-  timeval tv;
-  tv.tv_sec = 0;
-  tv.tv_usec = 300000;
-  rv = setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
-  if (rv < 0)
+  size_t hosts = 0, outstanding = 0;
+  for (auto& shard : clientShards)
   {
-    perror("setsockopt SO_RCVTIMEO");
-    return 1;
+    std::lock_guard lk(shard.lock);
+    hosts += shard.map.size();
   }
-  rv = setsockopt(sockAlt, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
-  if (rv < 0)
+  for (auto& shard : packetShards)
   {
-    perror("setsockopt SO_RCVTIMEO alt");
-    return 1;
+    std::lock_guard lk(shard.lock);
+    outstanding += shard.map.size();
   }
 
+  fmt::print("hosts: {}, waiting for ack: {}, received: {}, sent: {}, resent: {}, timed out: {}, "
+             "bad packets: {}, send errors: {}\n",
+             hosts, outstanding, received, sent, resends, timeouts, bad, sendErrors);
+  fflush(stdout);
 #ifdef HAVE_LIBSYSTEMD
-  sd_notifyf(0, "READY=1\nSTATUS=Listening on port %d (alt port: %d)", PORT, PORT_ALT);
+  sd_notifyf(0, "STATUS=Listening on port %d (alt port: %d), %zu hosts", PORT, PORT_ALT, hosts);
 #endif
+}
 
+static void WorkerLoop(Worker* w)
+{
+  worker = w;
+  UpdateCurrentTime();
+  u64 lastResendCheck = currentTime;
+  u64 lastExpiryCheck = currentTime;
+  u64 lastStatistics = currentTime;
   while (true)
   {
-    tv.tv_sec = 0;
-    tv.tv_usec = 300000;
-    fd_set readSet;
-    FD_ZERO(&readSet);
-    FD_SET(sock, &readSet);
-    FD_SET(sockAlt, &readSet);
-    rv = select(std::max(sock, sockAlt) + 1, &readSet, nullptr, nullptr, &tv);
-    if (rv < 0)
+    WaitForPackets(RESEND_CHECK_INTERVAL / 1000);
+    UpdateCurrentTime();
+    ReceivePackets(worker->sock, false);
+    ReceivePackets(worker->sockAlt, true);
+
+    if (currentTime >= lastResendCheck + RESEND_CHECK_INTERVAL)
     {
-      if (errno != EINTR && errno != EAGAIN)
-      {
-        perror("recvfrom");
-        return 1;
-      }
+      ResendPackets();
+      FlushSends();
+      lastResendCheck = currentTime;
     }
-
-    int recvsock;
-    if (FD_ISSET(sock, &readSet))
+    if (currentTime >= lastExpiryCheck + EXPIRY_CHECK_INTERVAL)
     {
-      recvsock = sock;
+      EvictExpiredClients();
+      lastExpiryCheck = currentTime;
     }
-    else if (FD_ISSET(sockAlt, &readSet))
+    if (worker->index == 0)
     {
-      recvsock = sockAlt;
+      if (currentTime >= lastStatistics + STATISTICS_INTERVAL)
+      {
+        PrintStatistics();
+        lastStatistics = currentTime;
+      }
+#ifdef HAVE_LIBSYSTEMD
+      sd_notify(0, "WATCHDOG=1");
+#endif
     }
-    else
+  }
+}
+
+static int CreateSocket(u16 port, bool reusePort)
+{
+  const int s = socket(PF_INET6, SOCK_DGRAM, 0);
+  if (s == -1)
+  {
+    perror("socket");
+    return -1;
+  }
+  int no = 0;
+  if (setsockopt(s, IPPROTO_IPV6, IPV6_V6ONLY, &no, sizeof(no)) < 0)
+  {
+    perror("setsockopt IPV6_V6ONLY");
+    close(s);
+    return -1;
+  }
+#ifdef __linux__
+  int yes = 1;
+  if (reusePort && setsockopt(s, SOL_SOCKET, SO_REUSEPORT, &yes, sizeof(yes)) < 0)
+  {
+    perror("setsockopt SO_REUSEPORT");
+    close(s);
+    return -1;
+  }
+#endif
+
+  in6_addr any = IN6ADDR_ANY_INIT;
+  sockaddr_in6 addr;
+#ifdef SIN6_LEN
+  addr.sin6_len = sizeof(addr);
+#endif
+  addr.sin6_family = AF_INET6;
+  addr.sin6_port = htons(port);
+  addr.sin6_flowinfo = 0;
+  addr.sin6_addr = any;
+  addr.sin6_scope_id = 0;
+  if (bind(s, (sockaddr*)&addr, sizeof(addr)) < 0)
+  {
+    fmt::print(stderr, "failed to bind port {}: {}\n", port, strerror(errno));
+    close(s);
+    return -1;
+  }
+  return s;
+}
+
+int main(int argc, char** argv)
+{
+  size_t threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+  if (argc > 1)
+  {
+    char* end;
+    threadCount = strtoul(argv[1], &end, 10);
+    if (argc > 2 || *end != '\0' || threadCount == 0)
     {
-      ResendPackets();
-      continue;
+      fmt::print(stderr, "usage: {} [number of threads]\n", argv[0]);
+      return 1;
     }
-    sockaddr_in6 raddr;
-    socklen_t addrLen = sizeof(raddr);
-    Common::TraversalPacket packet{};
-    // note: switch to recvmmsg (yes, mmsg) if this becomes
-    // expensive
-    rv = recvfrom(recvsock, &packet, sizeof(packet), 0, (sockaddr*)&raddr, &addrLen);
-    currentTime = std::chrono::duration_cast<std::chrono::microseconds>(
-                      std::chrono::system_clock::now().time_since_epoch())
-                      .count();
-    if (rv < 0)
+  }
+
+#ifdef __linux__
+  const bool socketPerWorker = true;
+#else
+  const bool socketPerWorker = false;
+#endif
+  for (size_t i = 0; i < threadCount; i++)
+  {
+    auto w = std::make_unique<Worker>();
+    w->index = i;
+    if (i == 0 || socketPerWorker)
     {
-      if (errno != EINTR && errno != EAGAIN)
-      {
-        perror("recvfrom");
+      w->sock = CreateSocket(PORT, threadCount > 1);
+      w->sockAlt = CreateSocket(PORT_ALT, threadCount > 1);
+      if (w->sock == -1 || w->sockAlt == -1)
         return 1;
-      }
     }
-    else if ((size_t)rv < sizeof(packet))
+    else
     {
-      fmt::print(stderr, "received short packet from {}\n", SenderName(&raddr));
+      w->sock = workers[0]->sock;
+      w->sockAlt = workers[0]->sockAlt;
     }
-    else
+    w->poller = CreatePoller(w->sock, w->sockAlt);
+    if (w->poller == -1)
     {
-      HandlePacket(&packet, &raddr, recvsock == sockAlt);
+      perror("poller");
+      return 1;
     }
-    ResendPackets();
+    workers.push_back(std::move(w));
+  }
+
 #ifdef HAVE_LIBSYSTEMD
-    sd_notify(0, "WATCHDOG=1");
+  sd_notifyf(0, "READY=1\nSTATUS=Listening on port %d (alt port: %d)", PORT, PORT_ALT);
 #endif
-  }
+
+  for (size_t i = 1; i < workers.size(); i++)
+    std::thread(WorkerLoop, workers[i].get()).detach();
+  WorkerLoop(workers[0].get());
 }
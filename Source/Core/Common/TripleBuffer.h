@@ -0,0 +1,50 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// a lockless way for one thread to publish values to another one,
+// which reads the latest of them without ever waiting for the writer
+
+#include <array>
+#include <atomic>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+template <typename T>
+class TripleBuffer
+{
+public:
+  // Writer: fill in the buffer, then publish it. Publishing again before the reader updated
+  // replaces the value it hasn't seen yet.
+  T& GetWriteBuffer() { return m_buffers[m_write_index]; }
+  void Publish()
+  {
+    m_write_index =
+        m_shared.exchange(m_write_index | NEW_DATA_FLAG, std::memory_order_acq_rel) & INDEX_MASK;
+  }
+
+  // Reader: returns false if nothing was published since the last update, in which case the read
+  // buffer keeps the value it had.
+  bool Update()
+  {
+    if (!(m_shared.load(std::memory_order_relaxed) & NEW_DATA_FLAG))
+      return false;
+    m_read_index = m_shared.exchange(m_read_index, std::memory_order_acq_rel) & INDEX_MASK;
+    return true;
+  }
+  const T& GetReadBuffer() const { return m_buffers[m_read_index]; }
+
+private:
+  static constexpr u8 INDEX_MASK = 0x3;
+  static constexpr u8 NEW_DATA_FLAG = 0x4;
+
+  std::array<T, 3> m_buffers{};
+  // Each index is owned by one side, and the shared one by whichever side takes it next
+  u8 m_write_index = 0;
+  std::atomic<u8> m_shared = 1;
+  u8 m_read_index = 2;
+};
+}  // namespace Common
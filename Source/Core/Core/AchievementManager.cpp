@@ -5,7 +5,9 @@
 
 #include "Core/AchievementManager.h"
 
+#include <algorithm>
 #include <cctype>
+#include <cstring>
 #include <memory>
 
 #include <fmt/format.h>
@@ -22,6 +24,7 @@
 #include "Common/WorkQueueThread.h"
 #include "Core/Config/AchievementSettings.h"
 #include "Core/Core.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/System.h"
 #include "DiscIO/Blob.h"
@@ -33,6 +36,26 @@
 static const Common::HttpRequest::Headers USER_AGENT_HEADER = {
     {"User-Agent", Common::GetUserAgentStr()}};
 
+// Set while a frame is evaluated, when memory is read from the snapshot
+static thread_local bool s_reading_memory_snapshot = false;
+
+// Like MemoryManager::GetPointerForRange, but without a panic alert for ranges outside of RAM
+static const u8* GetRAMPointer(Memory::MemoryManager& memory, u32 address, u32 size)
+{
+  if (address < memory.GetRamSizeReal())
+    return size <= memory.GetRamSizeReal() - address ? memory.GetRAM() + address : nullptr;
+
+  const u32 exram_address = address & 0x0FFFFFFF;
+  if (memory.GetEXRAM() && (address >> 28) == 0x1 && exram_address < memory.GetExRamSizeReal())
+  {
+    return size <= memory.GetExRamSizeReal() - exram_address ?
+               memory.GetEXRAM() + exram_address :
+               nullptr;
+  }
+
+  return nullptr;
+}
+
 AchievementManager& AchievementManager::GetInstance()
 {
   static AchievementManager s_instance;
@@ -222,9 +245,81 @@ void AchievementManager::DoFrame()
 {
   if (!IsGameLoaded() || !Core::IsCPUThread())
     return;
+
+  // The previous frame is usually evaluated long before the next one ends.
+  m_frame_evaluation.Wait();
   {
     std::lock_guard lg{m_lock};
+    UpdateMemorySnapshot();
+  }
+  m_frame_evaluation.Schedule([this] { EvaluateFrame(); });
+}
+
+void AchievementManager::UpdateMemorySnapshot()
+{
+  if (!m_missed_snapshot_blocks.empty())
+  {
+    m_snapshot_blocks.insert(m_snapshot_blocks.end(), m_missed_snapshot_blocks.begin(),
+                             m_missed_snapshot_blocks.end());
+    m_missed_snapshot_blocks.clear();
+    std::ranges::sort(m_snapshot_blocks);
+    m_snapshot_blocks.erase(std::ranges::unique(m_snapshot_blocks).begin(),
+                            m_snapshot_blocks.end());
+    m_snapshot_data.resize(m_snapshot_blocks.size() * SNAPSHOT_BLOCK_SIZE);
+  }
+
+  auto& memory = Core::System::GetInstance().GetMemory();
+  for (size_t i = 0; i < m_snapshot_blocks.size(); ++i)
+  {
+    u8* const dest = m_snapshot_data.data() + i * SNAPSHOT_BLOCK_SIZE;
+    const u8* const src = GetRAMPointer(memory, m_snapshot_blocks[i], SNAPSHOT_BLOCK_SIZE);
+    if (src)
+      std::memcpy(dest, src, SNAPSHOT_BLOCK_SIZE);
+    else
+      std::memset(dest, 0, SNAPSHOT_BLOCK_SIZE);
+  }
+}
+
+u32 AchievementManager::ReadMemorySnapshot(u32 address, u8* buffer, u32 num_bytes)
+{
+  u32 num_read = 0;
+  while (num_read < num_bytes)
+  {
+    const u32 current_address = address + num_read;
+    const u32 block = current_address & ~(SNAPSHOT_BLOCK_SIZE - 1);
+    const u32 offset = current_address - block;
+    const u32 size = std::min(num_bytes - num_read, SNAPSHOT_BLOCK_SIZE - offset);
+
+    const auto it = std::ranges::lower_bound(m_snapshot_blocks, block);
+    if (it != m_snapshot_blocks.end() && *it == block)
+    {
+      const size_t index = static_cast<size_t>(it - m_snapshot_blocks.begin());
+      std::memcpy(buffer + num_read,
+                  m_snapshot_data.data() + index * SNAPSHOT_BLOCK_SIZE + offset, size);
+    }
+    else
+    {
+      // The block is copied from the next frame on. Until then, read it while the CPU thread
+      // keeps running, like the GPU thread reads guest memory in dual core mode.
+      const u8* const src =
+          GetRAMPointer(Core::System::GetInstance().GetMemory(), current_address, size);
+      if (!src)
+        return num_read;
+      std::memcpy(buffer + num_read, src, size);
+      m_missed_snapshot_blocks.push_back(block);
+    }
+    num_read += size;
+  }
+  return num_read;
+}
+
+void AchievementManager::EvaluateFrame()
+{
+  {
+    std::lock_guard lg{m_lock};
+    s_reading_memory_snapshot = true;
     rc_client_do_frame(m_client);
+    s_reading_memory_snapshot = false;
   }
   if (!m_system)
     return;
@@ -368,6 +463,7 @@ void AchievementManager::DoState(PointerWrap& p)
 {
   if (!m_client || !Config::Get(Config::RA_ENABLED))
     return;
+  m_frame_evaluation.Wait();
   size_t size = 0;
   if (!p.IsReadMode())
     size = rc_client_progress_size(m_client);
@@ -406,6 +502,8 @@ void AchievementManager::DoState(PointerWrap& p)
 
 void AchievementManager::CloseGame()
 {
+  // Must not hold the lock here, which the frame evaluation takes
+  m_frame_evaluation.Wait();
   {
     std::lock_guard lg{m_lock};
     if (rc_client_get_game_info(m_client))
@@ -419,6 +517,9 @@ void AchievementManager::CloseGame()
       m_locked_badges.clear();
       m_leaderboard_map.clear();
       m_rich_presence.fill('\0');
+      m_snapshot_blocks.clear();
+      m_snapshot_data.clear();
+      m_missed_snapshot_blocks.clear();
       rc_api_destroy_fetch_game_data_response(&m_game_data);
       m_game_data = {};
       m_queue.Cancel();
@@ -436,9 +537,9 @@ void AchievementManager::CloseGame()
 
 void AchievementManager::Logout()
 {
+  CloseGame();
   {
     std::lock_guard lg{m_lock};
-    CloseGame();
     m_player_badge.width = 0;
     m_player_badge.height = 0;
     m_player_badge.data.clear();
@@ -918,6 +1019,8 @@ u32 AchievementManager::MemoryPeeker(u32 address, u8* buffer, u32 num_bytes, rc_
 {
   if (buffer == nullptr)
     return 0u;
+  if (s_reading_memory_snapshot)
+    return GetInstance().ReadMemorySnapshot(address, buffer, num_bytes);
   auto& system = Core::System::GetInstance();
   Core::CPUThreadGuard threadguard(system);
   for (u32 num_read = 0; num_read < num_bytes; num_read++)
@@ -27,6 +27,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/HttpRequest.h"
+#include "Common/TaskScheduler.h"
 #include "Common/WorkQueueThread.h"
 #include "DiscIO/Volume.h"
 #include "VideoCommon/Assets/CustomTextureData.h"
@@ -178,6 +179,9 @@ private:
   static void Request(const rc_api_request_t* request, rc_client_server_callback_t callback,
                       void* callback_data, rc_client_t* client);
   static u32 MemoryPeeker(u32 address, u8* buffer, u32 num_bytes, rc_client_t* client);
+  void UpdateMemorySnapshot();
+  u32 ReadMemorySnapshot(u32 address, u8* buffer, u32 num_bytes);
+  void EvaluateFrame();
   void FetchBadge(Badge* badge, u32 badge_type, const BadgeNameFunction function,
                   const UpdatedItems callback_data);
   static void EventHandler(const rc_client_event_t* event, rc_client_t* client);
@@ -210,10 +214,20 @@ private:
   std::unordered_set<AchievementId> m_active_challenges;
   std::vector<rc_client_leaderboard_tracker_t> m_active_leaderboards;
 
+  // Guest memory read by the achievement set, copied in blocks on the CPU thread at the end of
+  // every frame so that the frame can be evaluated on another thread while emulation goes on.
+  // The CPU thread waits for the evaluation of a frame before copying the next one.
+  static constexpr u32 SNAPSHOT_BLOCK_SIZE = 64;
+  std::vector<u32> m_snapshot_blocks;
+  std::vector<u8> m_snapshot_data;
+  std::vector<u32> m_missed_snapshot_blocks;
+
   Common::WorkQueueThread<std::function<void()>> m_queue;
   Common::WorkQueueThread<std::function<void()>> m_image_queue;
   mutable std::recursive_mutex m_lock;
   std::recursive_mutex m_filereader_lock;
+  // Destroyed first, since the frame evaluation uses the other members
+  Common::TaskGroup m_frame_evaluation{Common::TaskPriority::High};
 };  // class AchievementManager
 
 #else  // USE_RETRO_ACHIEVEMENTS
@@ -23,8 +23,11 @@
 #include <algorithm>
 #include <atomic>
 #include <bit>
+#include <cstring>
 #include <iterator>
 #include <mutex>
+#include <optional>
+#include <span>
 #include <string>
 #include <utility>
 #include <variant>
@@ -37,11 +40,16 @@
 #include "Common/IniFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/Swap.h"
 
 #include "Core/ARDecrypt.h"
 #include "Core/CheatCodes.h"
 #include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
 
 namespace ActionReplay
 {
@@ -110,6 +118,57 @@ struct ARAddr
   operator u32() const { return address; }
 };
 
+// An AR line decoded ahead of time. Codes which only use these lines run from their compiled form
+// after the first run, which doesn't have to decode every line again each frame and can access RAM
+// through host pointers when the BATs allow it.
+struct CompiledOp
+{
+  enum class Kind : u8
+  {
+    Write,
+    Add,
+    AddFloat,
+    WriteToPointer,
+    Conditional,
+    // "00000000 40000000", which also ends skipping for CONDTIONAL_ALL_LINES_UNTIL
+    EndIf,
+    // Other lines of zero code type ZCODE_NORM
+    NoOp,
+    EndOfCodes,
+  };
+
+  Kind kind;
+  // Access size in bytes
+  u8 size = 0;
+  // For Conditional
+  u8 compare_type = 0;
+  u8 skip_type = 0;
+  // For WriteToPointer, which accesses the pointer as 32 bits
+  u8 pointer_write_size = 0;
+  u32 address = 0;
+  u32 value = 0;
+  // Number of consecutive writes, for fills
+  u32 count = 1;
+  // Host memory for all bytes accessed at address, or nullptr if the access goes through the MMU
+  u8* host_pointer = nullptr;
+};
+
+// The state which the host pointers of the compiled codes depend on
+struct HostPointerKey
+{
+  u64 dbat_generation = 0;
+  bool has_memchecks = false;
+  bool dcache_enabled = false;
+  bool data_translation = false;
+
+  bool operator==(const HostPointerKey&) const = default;
+};
+
+// Parallel to s_active_codes. Codes which have to be interpreted have no compiled form.
+static std::vector<std::optional<std::vector<CompiledOp>>> s_compiled_codes;
+static bool s_compiled_codes_valid = false;
+static std::optional<HostPointerKey> s_host_pointer_key;
+
 // ----------------------
 // AR Remote Functions
 void ApplyCodes(std::span<const ARCode> codes)
@@ -119,6 +178,7 @@ void ApplyCodes(std::span<const ARCode> codes)
 
   std::lock_guard guard(s_lock);
   s_disable_logging = false;
+  s_compiled_codes_valid = false;
   s_active_codes.clear();
   std::copy_if(codes.begin(), codes.end(), std::back_inserter(s_active_codes),
                [](const ARCode& code) { return code.enabled; });
@@ -127,6 +187,7 @@ void ApplyCodes(std::span<const ARCode> codes)
 
 void SetSyncedCodesAsActive()
 {
+  s_compiled_codes_valid = false;
   s_active_codes.clear();
   s_active_codes.reserve(s_synced_codes.size());
   s_active_codes = s_synced_codes;
@@ -147,6 +208,7 @@ std::vector<ARCode> ApplyAndReturnCodes(std::span<const ARCode> codes)
   {
     std::lock_guard guard(s_lock);
     s_disable_logging = false;
+    s_compiled_codes_valid = false;
     s_active_codes.clear();
     std::copy_if(codes.begin(), codes.end(), std::back_inserter(s_active_codes),
                  [](const ARCode& code) { return code.enabled; });
@@ -165,6 +227,7 @@ void AddCode(ARCode code)
   {
     std::lock_guard guard(s_lock);
     s_disable_logging = false;
+    s_compiled_codes_valid = false;
     s_active_codes.emplace_back(std::move(code));
   }
 }
@@ -988,6 +1051,294 @@ static bool RunCodeLocked(const Core::CPUThreadGuard& guard, const ARCode& arcod
   return true;
 }
 
+// Returns nullopt for lines which only the interpreter supports.
+static std::optional<CompiledOp> CompileLine(const AREntry& entry)
+{
+  const ARAddr addr(entry.cmd_addr);
+  const u32 data = entry.value;
+
+  // ActionReplay program self modification codes
+  if (addr >= 0x00002000 && addr < 0x00003000)
+    return std::nullopt;
+
+  CompiledOp op;
+  if (addr == 0)
+  {
+    switch (data >> 29)
+    {
+    case ZCODE_END:
+      op.kind = CompiledOp::Kind::EndOfCodes;
+      return op;
+    case ZCODE_NORM:
+      op.kind = data == 0x40000000 ? CompiledOp::Kind::EndIf : CompiledOp::Kind::NoOp;
+      return op;
+    default:
+      // Fill & slide and memory copy take the next line as their data
+      return std::nullopt;
+    }
+  }
+
+  op.address = addr.GCAddress();
+  op.size = addr.size == DATATYPE_8BIT ? 1 : addr.size == DATATYPE_16BIT ? 2 : 4;
+  op.value = data;
+
+  if (addr.type != 0)
+  {
+    op.kind = CompiledOp::Kind::Conditional;
+    op.compare_type = addr.type;
+    op.skip_type = addr.subtype;
+    op.value = data & (op.size == 1 ? 0xFF : op.size == 2 ? 0xFFFF : 0xFFFFFFFF);
+    return op;
+  }
+
+  switch (addr.subtype)
+  {
+  case SUB_RAM_WRITE:
+    op.kind = CompiledOp::Kind::Write;
+    if (op.size == 1)
+    {
+      op.count = (data >> 8) + 1;
+      op.value = data & 0xFF;
+    }
+    else if (op.size == 2)
+    {
+      op.count = (data >> 16) + 1;
+      op.value = data & 0xFFFF;
+    }
+    return op;
+
+  case SUB_WRITE_POINTER:
+    op.kind = CompiledOp::Kind::WriteToPointer;
+    op.pointer_write_size = op.size;
+    op.size = 4;
+    return op;
+
+  case SUB_ADD_CODE:
+    op.kind =
+        addr.size == DATATYPE_32BIT_FLOAT ? CompiledOp::Kind::AddFloat : CompiledOp::Kind::Add;
+    return op;
+
+  default:
+    return std::nullopt;
+  }
+}
+
+static void CompileCodesLocked()
+{
+  s_compiled_codes.clear();
+  s_compiled_codes.reserve(s_active_codes.size());
+  for (const ARCode& code : s_active_codes)
+  {
+    std::optional<std::vector<CompiledOp>>& compiled = s_compiled_codes.emplace_back();
+    compiled.emplace();
+    compiled->reserve(code.ops.size());
+    for (const AREntry& entry : code.ops)
+    {
+      const std::optional<CompiledOp> op = CompileLine(entry);
+      if (!op)
+      {
+        compiled.reset();
+        break;
+      }
+      compiled->push_back(*op);
+    }
+  }
+  s_compiled_codes_valid = true;
+  s_host_pointer_key.reset();
+}
+
+static u8* GetHostPointer(const Core::CPUThreadGuard& guard, u32 address, u32 size)
+{
+  // Larger ranges could span BAT pages which are neither checked nor physically adjacent
+  if (size > PowerPC::BAT_PAGE_SIZE)
+    return nullptr;
+
+  auto& mmu = guard.GetSystem().GetMMU();
+  if (!mmu.IsOptimizableRAMAddress(address, size * 8))
+    return nullptr;
+
+  const std::optional<u32> first = mmu.GetTranslatedAddress(address);
+  const std::optional<u32> last = mmu.GetTranslatedAddress(address + size - 1);
+  if (!first || !last || *last - *first != size - 1)
+    return nullptr;
+
+  const std::span<u8> span = guard.GetSystem().GetMemory().GetSpanForAddress(*first);
+  return span.size() >= size ? span.data() : nullptr;
+}
+
+static void UpdateHostPointersLocked(const Core::CPUThreadGuard& guard)
+{
+  auto& system = guard.GetSystem();
+  const auto& ppc_state = system.GetPPCState();
+  const HostPointerKey key{
+      .dbat_generation = system.GetMMU().GetDBATGeneration(),
+      .has_memchecks = system.GetPowerPC().GetMemChecks().HasAny(),
+      .dcache_enabled = ppc_state.m_enable_dcache,
+      .data_translation = static_cast<bool>(ppc_state.msr.DR),
+  };
+  if (s_host_pointer_key == key)
+    return;
+
+  for (auto& compiled : s_compiled_codes)
+  {
+    if (!compiled)
+      continue;
+    for (CompiledOp& op : *compiled)
+    {
+      const bool accesses_memory =
+          op.kind != CompiledOp::Kind::EndIf && op.kind != CompiledOp::Kind::NoOp &&
+          op.kind != CompiledOp::Kind::EndOfCodes;
+      op.host_pointer = accesses_memory ? GetHostPointer(guard, op.address, op.size * op.count) :
+                                          nullptr;
+    }
+  }
+  s_host_pointer_key = key;
+}
+
+static u32 ReadCompiled(const Core::CPUThreadGuard& guard, const CompiledOp& op)
+{
+  if (op.host_pointer)
+  {
+    switch (op.size)
+    {
+    case 1:
+      return *op.host_pointer;
+    case 2:
+      return Common::swap16(op.host_pointer);
+    default:
+      return Common::swap32(op.host_pointer);
+    }
+  }
+
+  switch (op.size)
+  {
+  case 1:
+    return PowerPC::MMU::HostRead_U8(guard, op.address);
+  case 2:
+    return PowerPC::MMU::HostRead_U16(guard, op.address);
+  default:
+    return PowerPC::MMU::HostRead_U32(guard, op.address);
+  }
+}
+
+static void WriteCompiled(const Core::CPUThreadGuard& guard, const CompiledOp& op, u32 index,
+                          u32 value)
+{
+  const u32 offset = index * op.size;
+  if (op.host_pointer)
+  {
+    u8* const pointer = op.host_pointer + offset;
+    switch (op.size)
+    {
+    case 1:
+      *pointer = static_cast<u8>(value);
+      break;
+    case 2:
+    {
+      const u16 swapped = Common::swap16(static_cast<u16>(value));
+      std::memcpy(pointer, &swapped, sizeof(swapped));
+      break;
+    }
+    default:
+    {
+      const u32 swapped = Common::swap32(value);
+      std::memcpy(pointer, &swapped, sizeof(swapped));
+      break;
+    }
+    }
+    return;
+  }
+
+  switch (op.size)
+  {
+  case 1:
+    PowerPC::MMU::HostWrite_U8(guard, value, op.address + offset);
+    break;
+  case 2:
+    PowerPC::MMU::HostWrite_U16(guard, value, op.address + offset);
+    break;
+  default:
+    PowerPC::MMU::HostWrite_U32(guard, value, op.address + offset);
+    break;
+  }
+}
+
+// Does the same as RunCodeLocked for a compiled code, without logging.
+static void RunCompiledCodeLocked(const Core::CPUThreadGuard& guard,
+                                  const std::vector<CompiledOp>& ops)
+{
+  int skip_count = 0;
+
+  for (const CompiledOp& op : ops)
+  {
+    if (skip_count)
+    {
+      if (skip_count > 0)
+        --skip_count;
+      else if (-CONDTIONAL_ALL_LINES == skip_count)
+        return;
+      else if (-CONDTIONAL_ALL_LINES_UNTIL == skip_count && op.kind == CompiledOp::Kind::EndIf)
+        skip_count = 0;
+      continue;
+    }
+
+    switch (op.kind)
+    {
+    case CompiledOp::Kind::Write:
+      for (u32 i = 0; i < op.count; ++i)
+        WriteCompiled(guard, op, i, op.value);
+      break;
+
+    case CompiledOp::Kind::Add:
+      WriteCompiled(guard, op, 0, ReadCompiled(guard, op) + op.value);
+      break;
+
+    case CompiledOp::Kind::AddFloat:
+    {
+      const float read_float = std::bit_cast<float>(ReadCompiled(guard, op));
+      WriteCompiled(guard, op, 0, std::bit_cast<u32>(read_float + static_cast<float>(op.value)));
+      break;
+    }
+
+    case CompiledOp::Kind::WriteToPointer:
+    {
+      // The target depends on the pointer, so it always goes through the MMU
+      const u32 ptr = ReadCompiled(guard, op);
+      switch (op.pointer_write_size)
+      {
+      case 1:
+        PowerPC::MMU::HostWrite_U8(guard, op.value & 0xFF, ptr + (op.value >> 8));
+        break;
+      case 2:
+        PowerPC::MMU::HostWrite_U16(guard, op.value & 0xFFFF, ptr + ((op.value >> 16) << 1));
+        break;
+      default:
+        PowerPC::MMU::HostWrite_U32(guard, op.value, ptr);
+        break;
+      }
+      break;
+    }
+
+    case CompiledOp::Kind::Conditional:
+      if (!CompareValues(ReadCompiled(guard, op), op.value, op.compare_type))
+      {
+        if (op.skip_type == CONDTIONAL_ONE_LINE || op.skip_type == CONDTIONAL_TWO_LINES)
+          skip_count = op.skip_type + 1;
+        else
+          skip_count = -static_cast<int>(op.skip_type);
+      }
+      break;
+
+    case CompiledOp::Kind::EndIf:
+    case CompiledOp::Kind::NoOp:
+      break;
+
+    case CompiledOp::Kind::EndOfCodes:
+      return;
+    }
+  }
+}
+
 void RunAllActive(const Core::CPUThreadGuard& cpu_guard)
 {
   if (!Config::AreCheatsEnabled())
@@ -997,12 +1348,37 @@ void RunAllActive(const Core::CPUThreadGuard& cpu_guard)
   // are only atomic ops unless contested. It should be rare for this to
   // be contested.
   std::lock_guard guard(s_lock);
-  std::erase_if(s_active_codes, [&cpu_guard](const ARCode& code) {
-    const bool success = RunCodeLocked(cpu_guard, code);
-    LogInfo("\n");
-    return !success;
+
+  // The first run after the codes have changed is interpreted, which logs every line and removes
+  // codes with errors.
+  if (!s_disable_logging)
+  {
+    std::erase_if(s_active_codes, [&cpu_guard](const ARCode& code) {
+      const bool success = RunCodeLocked(cpu_guard, code);
+      LogInfo("\n");
+      return !success;
+    });
+    s_disable_logging = true;
+    s_compiled_codes_valid = false;
+    return;
+  }
+
+  if (!s_compiled_codes_valid)
+    CompileCodesLocked();
+  UpdateHostPointersLocked(cpu_guard);
+
+  size_t index = 0;
+  std::erase_if(s_active_codes, [&cpu_guard, &index](const ARCode& code) {
+    const auto& compiled = s_compiled_codes[index++];
+    if (compiled)
+    {
+      RunCompiledCodeLocked(cpu_guard, *compiled);
+      return false;
+    }
+    return !RunCodeLocked(cpu_guard, code);
   });
-  s_disable_logging = true;
+  if (s_active_codes.size() != s_compiled_codes.size())
+    s_compiled_codes_valid = false;
 }
 
 }  // namespace ActionReplay
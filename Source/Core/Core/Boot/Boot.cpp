@@ -234,7 +234,8 @@ std::unique_ptr<BootParameters> BootParameters::GenerateFromFile(std::vector<std
 #endif
 
   static const std::unordered_set<std::string> disc_image_extensions = {
-      {".gcm", ".iso", ".tgc", ".wbfs", ".ciso", ".gcz", ".wia", ".rvz", ".nfs", ".dol", ".elf"}};
+      {".gcm", ".iso", ".tgc", ".wbfs", ".ciso", ".gcz", ".wia", ".rvz", ".nfs", ".ddup", ".dol",
+       ".elf"}};
   if (disc_image_extensions.find(extension) != disc_image_extensions.end())
   {
     std::unique_ptr<DiscIO::VolumeDisc> disc = DiscIO::CreateDisc(path);
@@ -371,11 +372,20 @@ bool CBoot::FindMapFile(std::string* existing_map_file, std::string* writable_ma
   return false;
 }
 
+std::string CBoot::GetSymbolCacheFile()
+{
+  const std::string& game_id = SConfig::GetInstance().m_debugger_game_id;
+  if (game_id.empty())
+    return {};
+  return File::GetUserPath(D_CACHE_IDX) + SYMBOLCACHE_DIR DIR_SEP + game_id + ".sym";
+}
+
 bool CBoot::LoadMapFromFilename(const Core::CPUThreadGuard& guard, PPCSymbolDB& ppc_symbol_db)
 {
   std::string strMapFilename;
   bool found = FindMapFile(&strMapFilename, nullptr);
-  if (found && ppc_symbol_db.LoadMap(guard, strMapFilename))
+  if (found ? ppc_symbol_db.LoadMap(guard, strMapFilename) :
+              ppc_symbol_db.LoadSymbolCache(guard, GetSymbolCacheFile()))
   {
     Host_PPCSymbolsChanged();
     return true;
@@ -170,6 +170,9 @@ public:
   //
   // Returns true if a map file exists, false if none could be found.
   static bool FindMapFile(std::string* existing_map_file, std::string* writable_map_file);
+  // Path to the symbol cache for the active title, see PPCSymbolDB::LoadSymbolCache
+  static std::string GetSymbolCacheFile();
+  // Loads the map file for the current game, or the symbol cache if there is no map file
   static bool LoadMapFromFilename(const Core::CPUThreadGuard& guard, PPCSymbolDB& ppc_symbol_db);
 
 private:
@@ -3,11 +3,17 @@
 
 #include "Core/CheatSearch.h"
 
+#include <algorithm>
+#include <array>
 #include <bit>
+#include <cstring>
 #include <functional>
+#include <future>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <variant>
 #include <vector>
@@ -15,6 +21,7 @@
 #include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/StringUtil.h"
+#include "Common/Swap.h"
 
 #include "Core/AchievementManager.h"
 #include "Core/Core.h"
@@ -198,14 +205,153 @@ TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
 {
   return PowerPC::MMU::HostTryReadF64(guard, addr, space);
 }
-}  // namespace
+
+
+// Each word of a search bitmap holds the comparison results for this many consecutive values.
+constexpr size_t BITS_PER_WORD = 64;
+
+// Number of bitmap words that a thread fills in one go.
+constexpr size_t WORDS_PER_CHUNK = 4096;
+
+// A copy of a range of emulated memory. It is taken one page at a time, so that every page only has
+// to be translated once rather than for every value in it.
+struct MemorySnapshot
+{
+  u32 start;
+  std::vector<u8> data;
+
+  // Whether each page that data covers is backed by RAM, starting with the page containing start.
+  std::vector<bool> accessible_pages;
+
+  bool IsAccessible(u64 offset, size_t size) const
+  {
+    const u64 first = (start & PowerPC::HW_PAGE_MASK) + offset;
+    const u64 first_page = first >> PowerPC::HW_PAGE_INDEX_SHIFT;
+    const u64 last_page = (first + size - 1) >> PowerPC::HW_PAGE_INDEX_SHIFT;
+    return accessible_pages[first_page] && accessible_pages[last_page];
+  }
+};
+
+static MemorySnapshot TakeSnapshot(const Core::CPUThreadGuard& guard, u32 start, u64 length,
+                                   PowerPC::RequestedAddressSpace space)
+{
+  // The emulated data cache can hold newer data than RAM, so go through the regular reads then
+  const bool use_dcache = guard.GetSystem().GetPPCState().m_enable_dcache;
+
+  MemorySnapshot snapshot{start, std::vector<u8>(length), {}};
+  for (u64 offset = 0; offset < length;)
+  {
+    const u32 address = static_cast<u32>(start + offset);
+    const size_t size = static_cast<size_t>(
+        std::min<u64>(PowerPC::HW_PAGE_SIZE - (address & PowerPC::HW_PAGE_MASK), length - offset));
+    u8* const out = snapshot.data.data() + offset;
+
+    bool accessible = true;
+    if (!use_dcache)
+    {
+      const std::span<const u8> page = PowerPC::MMU::HostGetPageSpan(guard, address, space);
+      accessible = !page.empty();
+      if (accessible)
+        std::memcpy(out, page.data(), size);
+    }
+    else
+    {
+      for (size_t i = 0; i < size && accessible; ++i)
+      {
+        const auto value = PowerPC::MMU::HostTryReadU8(guard, static_cast<u32>(address + i), space);
+        accessible = value.has_value();
+        if (accessible)
+          out[i] = value->value;
+      }
+    }
+
+    snapshot.accessible_pages.push_back(accessible);
+    offset += size;
+  }
+
+  return snapshot;
+}
 
 template <typename T>
-Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
-Cheats::NewSearch(const Core::CPUThreadGuard& guard,
-                  const std::vector<Cheats::MemoryRange>& memory_ranges,
-                  PowerPC::RequestedAddressSpace address_space, bool aligned,
-                  const std::function<bool(const T& value)>& validator)
+static T ReadBigEndianValue(const u8* data)
+{
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return Common::FromBigEndian(value);
+}
+
+// Returns a word with bit i set if the i-th of count values starting at data passes the validator.
+// This is kept free of branches so that the compiler can vectorize it for plain comparisons.
+template <typename T, size_t stride, typename Validator>
+static u64 CompareBlock(const u8* data, size_t count, const Validator& validator)
+{
+  std::array<u8, BITS_PER_WORD> matches{};
+  for (size_t i = 0; i < count; ++i)
+    matches[i] = validator(ReadBigEndianValue<T>(data + i * stride));
+
+  u64 word = 0;
+  for (size_t i = 0; i < BITS_PER_WORD; ++i)
+    word |= static_cast<u64>(matches[i]) << i;
+  return word;
+}
+
+// Runs function(i) for every i in [0, count) spread over all available threads.
+template <typename F>
+static void ForEachChunkInParallel(size_t count, F function)
+{
+  const size_t threads =
+      std::min(count, std::max<size_t>(1, std::thread::hardware_concurrency()));
+
+  std::vector<std::future<void>> futures(threads);
+  for (size_t i = 0; i < threads; ++i)
+  {
+    futures[i] = std::async(std::launch::async, [&function, count, threads, i]() {
+      for (size_t j = i; j < count; j += threads)
+        function(j);
+    });
+  }
+
+  for (std::future<void>& future : futures)
+    future.get();
+}
+
+// Compares count values that are stride bytes apart, starting at data. Returns a bitmap of which of
+// them passed the validator.
+template <typename T, size_t stride, typename Validator>
+static std::vector<u64> CompareSnapshot(const u8* data, u64 count, const Validator& validator)
+{
+  std::vector<u64> bitmap((count + BITS_PER_WORD - 1) / BITS_PER_WORD);
+  const size_t chunks = (bitmap.size() + WORDS_PER_CHUNK - 1) / WORDS_PER_CHUNK;
+  ForEachChunkInParallel(chunks, [&](size_t chunk) {
+    const size_t first_word = chunk * WORDS_PER_CHUNK;
+    const size_t end_word = std::min(first_word + WORDS_PER_CHUNK, bitmap.size());
+    for (size_t word = first_word; word < end_word; ++word)
+    {
+      const u64 first = word * BITS_PER_WORD;
+      const size_t block_count = static_cast<size_t>(std::min<u64>(BITS_PER_WORD, count - first));
+      bitmap[word] = CompareBlock<T, stride>(data + first * stride, block_count, validator);
+    }
+  });
+  return bitmap;
+}
+
+static Cheats::SearchResultValueState GetValueState(const PowerPC::PowerPCState& ppc_state,
+                                                    PowerPC::RequestedAddressSpace address_space)
+{
+  // Matches what the HostTryRead functions report
+  const bool translated = address_space == PowerPC::RequestedAddressSpace::Virtual ||
+                          (address_space == PowerPC::RequestedAddressSpace::Effective &&
+                           ppc_state.msr.DR);
+  return translated ? Cheats::SearchResultValueState::ValueFromVirtualMemory :
+                      Cheats::SearchResultValueState::ValueFromPhysicalMemory;
+}
+
+template <typename T, typename Validator>
+static Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
+NewSearchImpl(const Core::CPUThreadGuard& guard,
+              const std::vector<Cheats::MemoryRange>& memory_ranges,
+              PowerPC::RequestedAddressSpace address_space, bool aligned,
+              const Validator& validator)
 {
   if (AchievementManager::GetInstance().IsHardcoreModeActive())
     return Cheats::SearchErrorCode::DisabledInHardcoreMode;
@@ -219,6 +365,8 @@ Cheats::NewSearch(const Core::CPUThreadGuard& guard,
   if (address_space == PowerPC::RequestedAddressSpace::Virtual && !ppc_state.msr.DR)
     return Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
 
+  const Cheats::SearchResultValueState value_state = GetValueState(ppc_state, address_space);
+
   for (const Cheats::MemoryRange& range : memory_ranges)
   {
     if (range.m_length < sizeof(T))
@@ -232,26 +380,77 @@ Cheats::NewSearch(const Core::CPUThreadGuard& guard,
       continue;
 
     const u64 length = aligned_length - (sizeof(T) - 1);
-    for (u64 i = 0; i < length; i += increment_per_loop)
-    {
-      const u32 addr = start_address + i;
-      const auto current_value = TryReadValueFromEmulatedMemory<T>(guard, addr, address_space);
-      if (!current_value)
-        continue;
+    const u64 count = (length + increment_per_loop - 1) / increment_per_loop;
+    const u64 first_offset = start_address - range.m_start;
+
+    const MemorySnapshot snapshot =
+        TakeSnapshot(guard, range.m_start, range.m_length, address_space);
+    const u8* const data = snapshot.data.data() + first_offset;
+    const std::vector<u64> bitmap =
+        aligned ? CompareSnapshot<T, sizeof(T)>(data, count, validator) :
+                  CompareSnapshot<T, 1>(data, count, validator);
 
-      if (validator(current_value->value))
+    for (size_t word = 0; word < bitmap.size(); ++word)
+    {
+      for (u64 bits = bitmap[word]; bits != 0; bits &= bits - 1)
       {
+        const u64 index = word * BITS_PER_WORD + std::countr_zero(bits);
+        const u64 offset = first_offset + index * increment_per_loop;
+        if (!snapshot.IsAccessible(offset, sizeof(T)))
+          continue;
+
         auto& r = results.emplace_back();
-        r.m_value = current_value->value;
-        r.m_value_state = current_value->translated ?
-                              Cheats::SearchResultValueState::ValueFromVirtualMemory :
-                              Cheats::SearchResultValueState::ValueFromPhysicalMemory;
-        r.m_address = addr;
+        r.m_value = ReadBigEndianValue<T>(snapshot.data.data() + offset);
+        r.m_value_state = value_state;
+        r.m_address = static_cast<u32>(range.m_start + offset);
       }
     }
   }
   return results;
 }
+}  // namespace
+
+template <typename T>
+Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
+Cheats::NewSearch(const Core::CPUThreadGuard& guard,
+                  const std::vector<Cheats::MemoryRange>& memory_ranges,
+                  PowerPC::RequestedAddressSpace address_space, bool aligned,
+                  const std::function<bool(const T& value)>& validator)
+{
+  return NewSearchImpl<T>(guard, memory_ranges, address_space, aligned, validator);
+}
+
+template <typename T>
+Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
+Cheats::NewSearch(const Core::CPUThreadGuard& guard,
+                  const std::vector<Cheats::MemoryRange>& memory_ranges,
+                  PowerPC::RequestedAddressSpace address_space, bool aligned,
+                  Cheats::CompareType compare_type, const T& target)
+{
+  const auto search = [&](auto compare) {
+    return NewSearchImpl<T>(guard, memory_ranges, address_space, aligned,
+                            [&target, compare](const T& value) { return compare(value, target); });
+  };
+
+  switch (compare_type)
+  {
+  case Cheats::CompareType::Equal:
+    return search(std::equal_to<T>());
+  case Cheats::CompareType::NotEqual:
+    return search(std::not_equal_to<T>());
+  case Cheats::CompareType::Less:
+    return search(std::less<T>());
+  case Cheats::CompareType::LessOrEqual:
+    return search(std::less_equal<T>());
+  case Cheats::CompareType::Greater:
+    return search(std::greater<T>());
+  case Cheats::CompareType::GreaterOrEqual:
+    return search(std::greater_equal<T>());
+  default:
+    DEBUG_ASSERT(false);
+    return Cheats::SearchErrorCode::InvalidParameters;
+  }
+}
 
 template <typename T>
 Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
@@ -272,10 +471,35 @@ Cheats::NextSearch(const Core::CPUThreadGuard& guard,
   if (address_space == PowerPC::RequestedAddressSpace::Virtual && !ppc_state.msr.DR)
     return Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
 
+  const Cheats::SearchResultValueState value_state = GetValueState(ppc_state, address_space);
+  const bool use_dcache = ppc_state.m_enable_dcache;
+
+  // Results are sorted by address, so consecutive results are usually in the same page
+  std::optional<u32> cached_page;
+  std::span<const u8> cached_page_span;
+
   for (const auto& previous_result : previous_results)
   {
     const u32 addr = previous_result.m_address;
-    const auto current_value = TryReadValueFromEmulatedMemory<T>(guard, addr, address_space);
+    const u32 offset_in_page = addr & PowerPC::HW_PAGE_MASK;
+
+    std::optional<T> current_value;
+    if (!use_dcache && offset_in_page + sizeof(T) <= PowerPC::HW_PAGE_SIZE)
+    {
+      const u32 page = addr - offset_in_page;
+      if (cached_page != page)
+      {
+        cached_page = page;
+        cached_page_span = PowerPC::MMU::HostGetPageSpan(guard, page, address_space);
+      }
+      if (!cached_page_span.empty())
+        current_value = ReadBigEndianValue<T>(cached_page_span.data() + offset_in_page);
+    }
+    else if (const auto result = TryReadValueFromEmulatedMemory<T>(guard, addr, address_space))
+    {
+      current_value = result->value;
+    }
+
     if (!current_value)
     {
       auto& r = results.emplace_back();
@@ -286,13 +510,11 @@ Cheats::NextSearch(const Core::CPUThreadGuard& guard,
 
     // if the previous state was invalid we always update the value to avoid getting stuck in an
     // invalid state
-    if (!previous_result.IsValueValid() || validator(current_value->value, previous_result.m_value))
+    if (!previous_result.IsValueValid() || validator(*current_value, previous_result.m_value))
     {
       auto& r = results.emplace_back();
-      r.m_value = current_value->value;
-      r.m_value_state = current_value->translated ?
-                            Cheats::SearchResultValueState::ValueFromVirtualMemory :
-                            Cheats::SearchResultValueState::ValueFromPhysicalMemory;
+      r.m_value = *current_value;
+      r.m_value_state = value_state;
       r.m_address = addr;
     }
   }
@@ -434,16 +656,17 @@ Cheats::SearchErrorCode Cheats::CheatSearchSession<T>::RunSearch(const Core::CPU
     if (!m_value)
       return Cheats::SearchErrorCode::InvalidParameters;
 
-    auto func = MakeCompareFunctionForSpecificValue<T>(m_compare_type, *m_value);
     if (m_first_search_done)
     {
+      auto func = MakeCompareFunctionForSpecificValue<T>(m_compare_type, *m_value);
       result = Cheats::NextSearch<T>(
           guard, m_search_results, m_address_space,
           [&func](const T& new_value, const T& old_value) { return func(new_value); });
     }
     else
     {
-      result = Cheats::NewSearch<T>(guard, m_memory_ranges, m_address_space, m_aligned, func);
+      result = Cheats::NewSearch<T>(guard, m_memory_ranges, m_address_space, m_aligned,
+                                    m_compare_type, *m_value);
     }
   }
   else if (m_filter_type == FilterType::CompareAgainstLastValue)
@@ -113,13 +113,22 @@ DataType GetDataType(const SearchValue& value);
 std::vector<u8> GetValueAsByteVector(const SearchValue& value);
 
 // Do a new search across the given memory region in the given address space, only keeping values
-// for which the given validator returns true.
+// for which the given validator returns true. The memory is copied out in bulk and searched on
+// several threads, so the validator may be called concurrently.
 template <typename T>
 Common::Result<SearchErrorCode, std::vector<SearchResult<T>>>
 NewSearch(const Core::CPUThreadGuard& guard, const std::vector<MemoryRange>& memory_ranges,
           PowerPC::RequestedAddressSpace address_space, bool aligned,
           const std::function<bool(const T& value)>& validator);
 
+// Same as above, but only keeps values which compare to the given target as requested. Unlike a
+// std::function, the comparison can be vectorized, so prefer this when possible.
+template <typename T>
+Common::Result<SearchErrorCode, std::vector<SearchResult<T>>>
+NewSearch(const Core::CPUThreadGuard& guard, const std::vector<MemoryRange>& memory_ranges,
+          PowerPC::RequestedAddressSpace address_space, bool aligned, CompareType compare_type,
+          const T& target);
+
 // Refresh the values for the given results in the given address space, only keeping values for
 // which the given validator returns true.
 template <typename T>
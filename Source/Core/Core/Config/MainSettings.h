@@ -57,14 +57,23 @@ extern const Info<PowerPC::CPUCore> MAIN_CPU_CORE;
 extern const Info<bool> MAIN_JIT_FOLLOW_BRANCH;
 extern const Info<bool> MAIN_FASTMEM;
 extern const Info<bool> MAIN_FASTMEM_ARENA;
+extern const Info<bool> MAIN_HUGE_PAGES;
 extern const Info<bool> MAIN_LARGE_ENTRY_POINTS_MAP;
+extern const Info<bool> MAIN_JIT_PERSISTENT_CACHE;
+extern const Info<bool> MAIN_JIT_TIERED_COMPILATION;
+extern const Info<bool> MAIN_JIT_DEFERRED_COMPILATION;
 extern const Info<bool> MAIN_ACCURATE_CPU_CACHE;
 // Should really be in the DSP section, but we're kind of stuck with bad decisions made in the past.
 extern const Info<bool> MAIN_DSP_HLE;
 extern const Info<int> MAIN_MAX_FALLBACK;
 extern const Info<int> MAIN_TIMING_VARIANCE;
 extern const Info<bool> MAIN_CPU_THREAD;
+extern const Info<bool> MAIN_PIN_THREADS;
+extern const Info<bool> MAIN_ADJUST_THREAD_PRIORITIES;
 extern const Info<bool> MAIN_SYNC_ON_SKIP_IDLE;
+extern const Info<bool> MAIN_REWIND_ENABLE;
+extern const Info<int> MAIN_REWIND_FRAME_INTERVAL;
+extern const Info<int> MAIN_REWIND_MAX_MEMORY_MB;
 extern const Info<std::string> MAIN_DEFAULT_ISO;
 extern const Info<bool> MAIN_ENABLE_CHEATS;
 extern const Info<int> MAIN_GC_LANGUAGE;
@@ -105,6 +114,9 @@ extern const Info<bool> MAIN_WII_SD_CARD;
 extern const Info<bool> MAIN_WII_SD_CARD_ENABLE_FOLDER_SYNC;
 extern const Info<u64> MAIN_WII_SD_CARD_FILESIZE;
 extern const Info<bool> MAIN_WII_KEYBOARD;
+extern const Info<bool> MAIN_ASYNC_IOS_REQUESTS;
+// In MiB
+extern const Info<u32> MAIN_WII_NAND_CACHE_SIZE;
 extern const Info<bool> MAIN_WIIMOTE_CONTINUOUS_SCANNING;
 extern const Info<bool> MAIN_WIIMOTE_ENABLE_SPEAKER;
 extern const Info<bool> MAIN_CONNECT_WIIMOTES_FOR_CONTROLLER_INTERFACE;
@@ -115,7 +127,14 @@ extern const Info<bool> MAIN_SYNC_GPU;
 extern const Info<int> MAIN_SYNC_GPU_MAX_DISTANCE;
 extern const Info<int> MAIN_SYNC_GPU_MIN_DISTANCE;
 extern const Info<float> MAIN_SYNC_GPU_OVERCLOCK;
+extern const Info<bool> MAIN_GPU_ADAPTIVE_SPIN;
+extern const Info<int> MAIN_GPU_SPIN_MIN_US;
+extern const Info<int> MAIN_GPU_SPIN_MAX_US;
 extern const Info<bool> MAIN_FAST_DISC_SPEED;
+extern const Info<int> MAIN_DVD_READ_AHEAD_MB;
+extern const Info<int> MAIN_WIA_RVZ_CHUNK_CACHE_MB;
+extern const Info<int> MAIN_WIA_RVZ_DECOMPRESSION_THREADS;
+extern const Info<bool> MAIN_MAP_PLAIN_DISC_IMAGES;
 extern const Info<bool> MAIN_LOW_DCBZ_HACK;
 extern const Info<bool> MAIN_FLOAT_EXCEPTIONS;
 extern const Info<bool> MAIN_DIVIDE_BY_ZERO_EXCEPTIONS;
@@ -145,11 +164,15 @@ extern const Info<std::string> MAIN_GPU_DETERMINISM_MODE;
 GPUDeterminismMode GetGPUDeterminismMode();
 
 extern const Info<std::string> MAIN_PERF_MAP_DIR;
+extern const Info<bool> MAIN_PERF_JITDUMP;
 extern const Info<bool> MAIN_CUSTOM_RTC_ENABLE;
 extern const Info<u32> MAIN_CUSTOM_RTC_VALUE;
 extern const Info<bool> MAIN_AUTO_DISC_CHANGE;
 extern const Info<bool> MAIN_ALLOW_SD_WRITES;
 extern const Info<bool> MAIN_ENABLE_SAVESTATES;
+extern const Info<bool> MAIN_SAVESTATE_ZSTD_COMPRESSION;
+// Lets emulation continue while RAM is being compressed, by only copying pages once they change
+extern const Info<bool> MAIN_SAVESTATE_COPY_ON_WRITE;
 extern const Info<DiscIO::Region> MAIN_FALLBACK_REGION;
 extern const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS;
 extern const Info<s32> MAIN_OVERRIDE_BOOT_IOS;
@@ -159,6 +182,10 @@ extern const Info<bool> MAIN_WII_WIILINK_ENABLE;
 // Main.DSP
 
 extern const Info<bool> MAIN_DSP_THREAD;
+// How many DSP updates the DSP thread may fall behind the CPU. 0 keeps the two in lockstep.
+extern const Info<int> MAIN_DSP_THREAD_MAX_LAG;
+// How many threads DSP HLE may process AX voices on. 0 or 1 processes them on the DSP thread only.
+extern const Info<int> MAIN_DSP_HLE_VOICE_THREADS;
 extern const Info<bool> MAIN_DSP_CAPTURE_LOG;
 extern const Info<bool> MAIN_DSP_JIT;
 extern const Info<bool> MAIN_DUMP_AUDIO;
@@ -200,6 +227,8 @@ extern const Info<bool> MAIN_SHOW_FRAME_COUNT;
 extern const Info<std::string> MAIN_WIRELESS_MAC;
 extern const Info<std::string> MAIN_GDB_SOCKET;
 extern const Info<int> MAIN_GDB_PORT;
+extern const Info<bool> MAIN_MEMORY_WATCHER_BINARY_OUTPUT;
+extern const Info<bool> MAIN_MEMORY_WATCHER_SHARED_MEMORY;
 extern const Info<int> MAIN_ISO_PATH_COUNT;
 extern const Info<std::string> MAIN_SKYLANDERS_PATH;
 std::vector<std::string> GetIsoPaths();
@@ -225,6 +254,7 @@ extern const Info<bool> MAIN_NETWORK_SSL_DUMP_PEER_CERT;
 extern const Info<bool> MAIN_NETWORK_DUMP_BBA;
 extern const Info<bool> MAIN_NETWORK_DUMP_AS_PCAP;
 extern const Info<int> MAIN_NETWORK_TIMEOUT;
+extern const Info<int> MAIN_NETWORK_METRICS_SERVER_PORT;
 
 // Main.Interface
 
@@ -300,6 +330,7 @@ extern const Info<bool> MAIN_GAMELIST_COLUMN_TAGS;
 
 extern const Info<bool> MAIN_FIFOPLAYER_LOOP_REPLAY;
 extern const Info<bool> MAIN_FIFOPLAYER_EARLY_MEMORY_UPDATES;
+extern const Info<bool> MAIN_FIFOPLAYER_COMPRESS_RECORDINGS;
 
 // Main.AutoUpdate
 
@@ -315,10 +346,14 @@ extern const Info<bool> MAIN_MOVIE_DUMP_FRAMES_SILENT;
 extern const Info<bool> MAIN_MOVIE_SHOW_INPUT_DISPLAY;
 extern const Info<bool> MAIN_MOVIE_SHOW_RTC;
 extern const Info<bool> MAIN_MOVIE_SHOW_RERECORD;
+// Store savestates taken during movie playback next to the movie, to speed up seeking in it later
+extern const Info<bool> MAIN_MOVIE_SEEK_INDEX;
 
 // Main.Input
 
 extern const Info<bool> MAIN_INPUT_BACKGROUND_INPUT;
+// Sample GameCube controllers when the game reads their data instead of when the SI polls them
+extern const Info<bool> MAIN_INPUT_LATE_SAMPLING;
 
 // Main.Debug
 
@@ -336,6 +371,7 @@ extern const Info<bool> MAIN_DEBUG_JIT_SYSTEM_REGISTERS_OFF;
 extern const Info<bool> MAIN_DEBUG_JIT_BRANCH_OFF;
 extern const Info<bool> MAIN_DEBUG_JIT_REGISTER_CACHE_OFF;
 extern const Info<bool> MAIN_DEBUG_JIT_ENABLE_PROFILING;
+extern const Info<bool> MAIN_DEBUG_COUNT_MMIO_ACCESSES;
 
 // Main.BluetoothPassthrough
 
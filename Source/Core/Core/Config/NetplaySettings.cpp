@@ -57,5 +57,7 @@ const Info<std::string> NETPLAY_NETWORK_MODE{{System::Main, "NetPlay", "NetworkM
                                              "fixeddelay"};
 const Info<bool> NETPLAY_GOLF_MODE_OVERLAY{{System::Main, "NetPlay", "GolfModeOverlay"}, true};
 const Info<bool> NETPLAY_HIDE_REMOTE_GBAS{{System::Main, "NetPlay", "HideRemoteGBAs"}, false};
+const Info<bool> NETPLAY_ROLLBACK{{System::Main, "NetPlay", "Rollback"}, false};
+const Info<bool> NETPLAY_DESYNC_RECOVERY{{System::Main, "NetPlay", "DesyncRecovery"}, false};
 
 }  // namespace Config
@@ -7,6 +7,7 @@
 #include <atomic>
 #include <cstring>
 #include <functional>
+#include <future>
 #include <mutex>
 #include <queue>
 #include <utility>
@@ -37,6 +38,7 @@
 #include "Common/StringUtil.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Common/Tracing.h"
 #include "Common/Version.h"
 
 #include "Core/AchievementManager.h"
@@ -72,6 +74,7 @@
 #include "Core/PowerPC/GDBStub.h"
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/Rewind.h"
 #include "Core/State.h"
 #include "Core/System.h"
 #include "Core/WiiRoot.h"
@@ -80,7 +83,9 @@
 #include "Core/MemoryWatcher.h"
 #endif
 
+#include "DiscIO/FileBlob.h"
 #include "DiscIO/RiivolutionPatcher.h"
+#include "DiscIO/WIABlob.h"
 
 #include "InputCommon/ControlReference/ControlReference.h"
 #include "InputCommon/ControllerInterface/ControllerInterface.h"
@@ -177,6 +182,12 @@ void OnFrameEnd(Core::System& system)
     s_memory_watcher->Step(guard);
   }
 #endif
+
+  system.GetMovie().OnFrameEnd();
+  ::State::Rewind::OnFrameEnd(system);
+
+  if (NetPlay::IsNetPlayRunning())
+    NetPlay::NetPlayClient::OnFrameEnd(system);
 }
 
 // Display messages and return values
@@ -375,6 +386,7 @@ static void CpuThread(Core::System& system, const std::optional<std::string>& sa
     Common::SetCurrentThreadName("CPU thread");
   else
     Common::SetCurrentThreadName("CPU-GPU thread");
+  Common::SetCurrentThreadRole(Common::ThreadRole::Emulation);
 
   // This needs to be delayed until after the video backend is ready.
   DolphinAnalytics::Instance().ReportGameStart();
@@ -454,6 +466,7 @@ static void FifoPlayerThread(Core::System& system, const std::optional<std::stri
     Common::SetCurrentThreadName("FIFO player thread");
   else
     Common::SetCurrentThreadName("FIFO-GPU thread");
+  Common::SetCurrentThreadRole(Common::ThreadRole::Emulation);
 
   // Enter CPU run loop. When we leave it - we are done.
   if (auto cpu_core = system.GetFifoPlayer().GetCPUCore())
@@ -497,6 +510,21 @@ static void EmuThread(Core::System& system, std::unique_ptr<BootParameters> boot
 
   Common::SetCurrentThreadName("Emuthread - Starting");
 
+  // Logs how long each step of the boot took, to find out where the time until the first frame
+  // is spent. The steps are also added to the performance trace if one is being recorded.
+  const u64 boot_start_us = Common::Timer::NowUs();
+  u64 last_boot_step_us = boot_start_us;
+  const auto log_boot_step = [&](std::string_view step) {
+    const u64 now_us = Common::Timer::NowUs();
+    INFO_LOG_FMT(BOOT, "{} took {} ms", step, (now_us - last_boot_step_us) / 1000);
+    if (Common::Tracing::IsEnabled())
+    {
+      Common::Tracing::AddEvent("boot", std::string(step), last_boot_step_us,
+                                now_us - last_boot_step_us);
+    }
+    last_boot_step_us = now_us;
+  };
+
   DeclareAsGPUThread();
 
   // For a time this acts as the CPU thread...
@@ -515,20 +543,31 @@ static void EmuThread(Core::System& system, std::unique_ptr<BootParameters> boot
   Pad::LoadGBAConfig();
   Keyboard::LoadConfig();
 
+  DiscIO::SetWIARVZChunkCacheLimits(
+      static_cast<u64>(std::max(Config::Get(Config::MAIN_WIA_RVZ_CHUNK_CACHE_MB), 1)) * 1024 * 1024,
+      static_cast<u32>(std::max(Config::Get(Config::MAIN_WIA_RVZ_DECOMPRESSION_THREADS), 0)));
+  DiscIO::SetMapPlainFiles(Config::Get(Config::MAIN_MAP_PLAIN_DISC_IMAGES));
+
   BootSessionData boot_session_data = std::move(boot->boot_session_data);
   const std::optional<std::string>& savestate_path = boot_session_data.GetSavestatePath();
   const bool delete_savestate =
       boot_session_data.GetDeleteSavestate() == DeleteSavestateAfterBoot::Yes;
 
+  log_boot_step("Input and disc setup");
+
+  // Building the SD card image can take a while for large folders. It only has to be done before
+  // IOS opens the image in HW::Init, so it runs while the next subsystems are initialized.
   bool sync_sd_folder = system.IsWii() && Config::Get(Config::MAIN_WII_SD_CARD) &&
                         Config::Get(Config::MAIN_WII_SD_CARD_ENABLE_FOLDER_SYNC);
+  std::future<bool> sd_folder_sync;
   if (sync_sd_folder)
   {
-    sync_sd_folder =
-        Common::SyncSDFolderToSDImage([]() { return false; }, Core::WantsDeterminism());
+    sd_folder_sync = std::async(std::launch::async, [] {
+      return Common::SyncSDFolderToSDImage([]() { return false; }, Core::WantsDeterminism());
+    });
   }
 
-  Common::ScopeGuard sd_folder_sync_guard{[sync_sd_folder] {
+  Common::ScopeGuard sd_folder_sync_guard{[&sync_sd_folder] {
     if (sync_sd_folder && Config::Get(Config::MAIN_ALLOW_SD_WRITES))
     {
       const bool sync_ok = Common::SyncSDImageToSDFolder([]() { return false; });
@@ -558,6 +597,13 @@ static void EmuThread(Core::System& system, std::unique_ptr<BootParameters> boot
 
   AudioCommon::InitSoundStream(system);
   Common::ScopeGuard audio_guard([&system] { AudioCommon::ShutdownSoundStream(system); });
+  log_boot_step("Audio, movie and asset loader init");
+
+  if (sd_folder_sync.valid())
+  {
+    sync_sd_folder = sd_folder_sync.get();
+    log_boot_step("Waiting for SD card sync");
+  }
 
   HW::Init(system,
            NetPlay::IsNetPlayRunning() ? &(boot_session_data.GetNetplaySettings()->sram) : nullptr);
@@ -578,6 +624,8 @@ static void EmuThread(Core::System& system, std::unique_ptr<BootParameters> boot
     system.GetPowerPC().GetDebugInterface().Clear(guard);
   }};
 
+  log_boot_step("HW init");
+
   VideoBackendBase::PopulateBackendInfo(wsi);
 
   if (!g_video_backend->Initialize(wsi))
@@ -591,6 +639,7 @@ static void EmuThread(Core::System& system, std::unique_ptr<BootParameters> boot
 
     g_video_backend->Shutdown();
   }};
+  log_boot_step("Video backend init");
 
   if (cpu_info.HTT)
     Config::SetBaseOrCurrent(Config::MAIN_DSP_THREAD, cpu_info.num_cores > 4);
@@ -605,6 +654,7 @@ static void EmuThread(Core::System& system, std::unique_ptr<BootParameters> boot
   }
 
   AudioCommon::PostInitSoundStream(system);
+  log_boot_step("DSP init");
 
   // Set execution state to known values (CPU/FIFO/Audio Paused)
   system.GetCPU().Break();
@@ -630,6 +680,7 @@ static void EmuThread(Core::System& system, std::unique_ptr<BootParameters> boot
     if (!CBoot::BootUp(system, guard, std::move(boot)))
       return;
   }
+  log_boot_step("Boot");
 
   // Initialise Wii filesystem contents.
   // This is done here after Boot and not in BootManager to ensure that we operate
@@ -642,6 +693,9 @@ static void EmuThread(Core::System& system, std::unique_ptr<BootParameters> boot
     Core::InitializeWiiFileSystemContents(savegame_redirect, boot_session_data);
   else
     wiifs_guard.Dismiss();
+  log_boot_step("Wii filesystem setup");
+  INFO_LOG_FMT(BOOT, "Initialization finished after {} ms",
+               (Common::Timer::NowUs() - boot_start_us) / 1000);
 
   // This adds the SyncGPU handler to CoreTiming, so now CoreTiming::Advance might block.
   system.GetFifo().Prepare();
@@ -664,6 +718,7 @@ static void EmuThread(Core::System& system, std::unique_ptr<BootParameters> boot
     // This thread, after creating the EmuWindow, spawns a CPU
     // thread, and then takes over and becomes the video thread
     Common::SetCurrentThreadName("Video thread");
+    Common::SetCurrentThreadRole(Common::ThreadRole::Emulation);
     UndeclareAsCPUThread();
     Common::FPU::LoadDefaultSIMDState();
 
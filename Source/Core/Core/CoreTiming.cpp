@@ -4,8 +4,8 @@
 #include "Core/CoreTiming.h"
 
 #include <algorithm>
-#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -14,7 +14,7 @@
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/Logging/Log.h"
-#include "Common/SPSCQueue.h"
+#include "Common/MPSCQueue.h"
 
 #include "Core/AchievementManager.h"
 #include "Core/CPUThreadConfigCallback.h"
@@ -118,7 +118,6 @@ void CoreTimingManager::Init()
 
 void CoreTimingManager::Shutdown()
 {
-  std::lock_guard lk(m_ts_write_lock);
   MoveEvents();
   ClearPendingEvents();
   UnregisterAllEvents();
@@ -152,7 +151,6 @@ void CoreTimingManager::RefreshConfig()
 
 void CoreTimingManager::DoState(PointerWrap& p)
 {
-  std::lock_guard lk(m_ts_write_lock);
   p.Do(m_globals.slice_length);
   p.Do(m_globals.global_timer);
   p.Do(m_idled_cycles);
@@ -167,6 +165,7 @@ void CoreTimingManager::DoState(PointerWrap& p)
   p.DoMarker("CoreTimingData");
 
   MoveEvents();
+  CompactEventQueue();
   p.DoEachElement(m_event_queue, [this](PointerWrap& pw, Event& ev) {
     pw.Do(ev.time);
     pw.Do(ev.fifo_order);
@@ -207,6 +206,15 @@ void CoreTimingManager::DoState(PointerWrap& p)
     // and library version specific.
     std::make_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
 
+    // The fifo_order values of the loaded events are unrelated to those of any earlier removals.
+    for (auto& [name, event_type] : m_event_types)
+    {
+      event_type.removed_before_fifo_order = 0;
+      event_type.num_pending = 0;
+    }
+    for (const Event& ev : m_event_queue)
+      ++ev.type->num_pending;
+
     // The stave state has changed the time, so our previous Throttle targets are invalid.
     // Especially when global_time goes down; So we create a fake throttle update.
     ResetThrottle(m_globals.global_timer);
@@ -234,6 +242,44 @@ u64 CoreTimingManager::GetIdleTicks() const
 void CoreTimingManager::ClearPendingEvents()
 {
   m_event_queue.clear();
+  m_num_removed_events = 0;
+  for (auto& [name, event_type] : m_event_types)
+  {
+    event_type.removed_before_fifo_order = 0;
+    event_type.num_pending = 0;
+  }
+}
+
+void CoreTimingManager::PushEvent(Event ev)
+{
+  ++ev.type->num_pending;
+  m_event_queue.emplace_back(std::move(ev));
+  std::push_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+}
+
+bool CoreTimingManager::IsRemoved(const Event& ev) const
+{
+  return ev.fifo_order < ev.type->removed_before_fifo_order;
+}
+
+void CoreTimingManager::PopRemovedEvents()
+{
+  while (!m_event_queue.empty() && IsRemoved(m_event_queue.front()))
+  {
+    std::pop_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+    m_event_queue.pop_back();
+    --m_num_removed_events;
+  }
+}
+
+void CoreTimingManager::CompactEventQueue()
+{
+  if (m_num_removed_events == 0)
+    return;
+
+  std::erase_if(m_event_queue, [this](const Event& e) { return IsRemoved(e); });
+  std::make_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+  m_num_removed_events = 0;
 }
 
 void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
@@ -262,8 +308,7 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
     if (!m_is_global_timer_sane)
       ForceExceptionCheck(cycles_into_future);
 
-    m_event_queue.emplace_back(Event{timeout, m_event_fifo_id++, userdata, event_type});
-    std::push_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+    PushEvent(Event{timeout, m_event_fifo_id++, userdata, event_type});
   }
   else
   {
@@ -275,22 +320,23 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
                     *event_type->name);
     }
 
-    std::lock_guard lk(m_ts_write_lock);
     m_ts_queue.Push(Event{m_globals.global_timer + cycles_into_future, 0, userdata, event_type});
   }
 }
 
 void CoreTimingManager::RemoveEvent(EventType* event_type)
 {
-  auto itr = std::remove_if(m_event_queue.begin(), m_event_queue.end(),
-                            [&](const Event& e) { return e.type == event_type; });
+  if (event_type->num_pending == 0)
+    return;
 
-  // Removing random items breaks the invariant so we have to re-establish it.
-  if (itr != m_event_queue.end())
-  {
-    m_event_queue.erase(itr, m_event_queue.end());
-    std::make_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
-  }
+  event_type->removed_before_fifo_order = m_event_fifo_id;
+  m_num_removed_events += event_type->num_pending;
+  event_type->num_pending = 0;
+
+  // Removing random items breaks the heap invariant, so only do it once it's worth the cost of
+  // re-establishing it.
+  if (m_num_removed_events > m_event_queue.size() / 2)
+    CompactEventQueue();
 }
 
 void CoreTimingManager::RemoveAllEvents(EventType* event_type)
@@ -317,8 +363,7 @@ void CoreTimingManager::MoveEvents()
   for (Event ev; m_ts_queue.Pop(ev);)
   {
     ev.fifo_order = m_event_fifo_id++;
-    m_event_queue.emplace_back(std::move(ev));
-    std::push_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+    PushEvent(std::move(ev));
   }
 }
 
@@ -339,14 +384,17 @@ void CoreTimingManager::Advance()
 
   m_is_global_timer_sane = true;
 
+  PopRemovedEvents();
   while (!m_event_queue.empty() && m_event_queue.front().time <= m_globals.global_timer)
   {
     Event evt = std::move(m_event_queue.front());
     std::pop_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
     m_event_queue.pop_back();
+    --evt.type->num_pending;
 
     Throttle(evt.time);
     evt.type->callback(m_system, evt.userdata, m_globals.global_timer - evt.time);
+    PopRemovedEvents();
   }
 
   m_is_global_timer_sane = false;
@@ -441,6 +489,7 @@ bool CoreTimingManager::UseSyncOnSkipIdle() const
 void CoreTimingManager::LogPendingEvents() const
 {
   auto clone = m_event_queue;
+  std::erase_if(clone, [this](const Event& e) { return IsRemoved(e); });
   std::sort(clone.begin(), clone.end());
   for (const Event& ev : clone)
   {
@@ -466,6 +515,8 @@ void CoreTimingManager::Idle()
 {
   if (m_config_sync_on_skip_idle)
   {
+    PerformanceMetrics::ScopedFrameSection frame_section(
+        PerformanceMetrics::FrameSection::IdleSkip);
     // When the FIFO is processing data we must not advance because in this way
     // the VI will be desynchronized. So, We are waiting until the FIFO finish and
     // while we process only the events required by the FIFO.
@@ -484,6 +535,7 @@ std::string CoreTimingManager::GetScheduledEventsSummary() const
   text.reserve(1000);
 
   auto clone = m_event_queue;
+  std::erase_if(clone, [this](const Event& e) { return IsRemoved(e); });
   std::sort(clone.begin(), clone.end());
   for (const Event& ev : clone)
   {
@@ -16,13 +16,12 @@
 // inside callback:
 //   ScheduleEvent(periodInCycles - cyclesLate, callback, "whatever")
 
-#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
-#include "Common/SPSCQueue.h"
+#include "Common/MPSCQueue.h"
 #include "Core/CPUThreadConfigCallback.h"
 
 class PointerWrap;
@@ -50,6 +49,12 @@ struct EventType
 {
   TimedCallback callback;
   const std::string* name;
+
+  // Events of this type which were queued before this fifo_order have been removed, but may still
+  // be in the queue until they reach the front of it or the queue gets compacted.
+  u64 removed_before_fifo_order = 0;
+  // How many events of this type in the queue haven't been removed.
+  u32 num_pending = 0;
 };
 
 struct Event
@@ -167,10 +172,13 @@ private:
   // We don't use std::priority_queue because we need to be able to serialize, unserialize and
   // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't accomodated
   // by the standard adaptor class.
+  // RemoveEvent() doesn't touch the queue itself, it only marks the events as removed through their
+  // EventType. Removed events are then skipped when they reach the front of the queue, and only
+  // erased in bulk once they make up most of it.
   std::vector<Event> m_event_queue;
   u64 m_event_fifo_id = 0;
-  std::mutex m_ts_write_lock;
-  Common::SPSCQueue<Event, false> m_ts_queue;
+  size_t m_num_removed_events = 0;
+  Common::MPSCQueue<Event> m_ts_queue;
 
   float m_last_oc_factor = 0.0f;
 
@@ -200,6 +208,11 @@ private:
 
   void ResetThrottle(s64 cycle);
 
+  void PushEvent(Event ev);
+  bool IsRemoved(const Event& ev) const;
+  void PopRemovedEvents();
+  void CompactEventQueue();
+
   int DowncountToCycles(int downcount) const;
   int CyclesToDowncount(int cycles) const;
 };
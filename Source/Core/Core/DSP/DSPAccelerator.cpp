@@ -160,6 +160,12 @@ u16 Accelerator::Read(const s16* coefs)
   return val;
 }
 
+void Accelerator::ReadSamples(s16* samples, u32 count, const s16* coefs)
+{
+  for (u32 i = 0; i < count; ++i)
+    samples[i] = static_cast<s16>(Read(coefs));
+}
+
 void Accelerator::DoState(PointerWrap& p)
 {
   p.Do(m_start_address);
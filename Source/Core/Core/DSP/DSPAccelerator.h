@@ -15,6 +15,9 @@ public:
   virtual ~Accelerator() = default;
 
   u16 Read(const s16* coefs);
+  // Same as calling Read count times, but lets the compiler keep the accelerator state in
+  // registers for the whole run.
+  void ReadSamples(s16* samples, u32 count, const s16* coefs);
   // Zelda ucode reads ARAM through 0xffd3.
   u16 ReadD3();
   void WriteD3(u16 value);
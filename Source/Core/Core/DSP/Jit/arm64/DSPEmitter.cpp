@@ -0,0 +1,304 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/DSP/Jit/arm64/DSPEmitter.h"
+
+#include <algorithm>
+#include <cstddef>
+
+#include "Common/Arm64Emitter.h"
+#include "Common/BitSet.h"
+#include "Common/ChunkFile.h"
+#include "Common/CommonTypes.h"
+#include "Common/MemoryUtil.h"
+
+#include "Core/DSP/DSPAnalyzer.h"
+#include "Core/DSP/DSPCore.h"
+#include "Core/DSP/DSPHost.h"
+#include "Core/DSP/DSPTables.h"
+#include "Core/DSP/Interpreter/DSPIntTables.h"
+#include "Core/DSP/Interpreter/DSPInterpreter.h"
+
+using namespace Arm64Gen;
+
+namespace DSP::JIT::arm64
+{
+constexpr size_t COMPILED_CODE_SIZE = 2097152;
+constexpr size_t MAX_BLOCK_SIZE = 250;
+constexpr u16 DSP_IDLE_SKIP_CYCLES = 0x1000;
+
+// Generously above the size of the largest block we can emit
+constexpr size_t MAX_BLOCK_CODE_SIZE = 0x20000;
+
+// Held for the whole block, so that every call into the interpreter only needs a register move
+constexpr ARM64Reg STATE_REG = ARM64Reg::X19;
+constexpr ARM64Reg INTERPRETER_REG = ARM64Reg::X20;
+constexpr ARM64Reg CORE_REG = ARM64Reg::X21;
+constexpr BitSet32 SAVED_REGS{19, 20, 21, 30};
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+#endif
+constexpr s32 PC_OFFSET = static_cast<s32>(offsetof(SDSP, pc));
+constexpr s32 EXCEPTIONS_OFFSET = static_cast<s32>(offsetof(SDSP, exceptions));
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+
+DSPEmitter::DSPEmitter(DSPCore& dsp) : m_blocks(MAX_BLOCKS), m_dsp_core{dsp}
+{
+  AllocCodeSpace(COMPILED_CODE_SIZE);
+}
+
+DSPEmitter::~DSPEmitter()
+{
+  FreeCodeSpace();
+}
+
+u16 DSPEmitter::RunCycles(u16 cycles)
+{
+  SDSP& state = m_dsp_core.DSPState();
+
+  if (state.external_interrupt_waiting.exchange(false, std::memory_order_acquire))
+  {
+    m_dsp_core.CheckExternalInterrupt();
+    m_dsp_core.CheckExceptions();
+  }
+
+  m_cycles_left = cycles;
+  while (m_cycles_left > 0)
+  {
+    if (Host::OnThread() && state.external_interrupt_waiting.load(std::memory_order_relaxed))
+      break;
+
+    // DSP gave up the remaining cycles.
+    if ((state.control_reg & CR_HALT) != 0)
+      break;
+
+    CompiledBlock block = m_blocks[state.pc];
+    if (!block)
+      block = Compile(state.pc);
+
+    const u16 cycles_executed = block();
+    m_cycles_left -= std::min(cycles_executed, m_cycles_left);
+  }
+
+  if (state.reset_dspjit_codespace)
+    ClearIRAMandDSPJITCodespaceReset();
+
+  return m_cycles_left;
+}
+
+void DSPEmitter::DoState(PointerWrap& p)
+{
+  p.Do(m_cycles_left);
+}
+
+void DSPEmitter::ClearIRAM()
+{
+  std::fill_n(m_blocks.begin(), DSP_IRAM_SIZE, nullptr);
+  m_dsp_core.DSPState().reset_dspjit_codespace = true;
+}
+
+void DSPEmitter::ClearIRAMandDSPJITCodespaceReset()
+{
+  {
+    const Common::ScopedJITPageWriteAndNoExecute enable_jit_page_writes;
+    ClearCodeSpace();
+  }
+
+  std::fill(m_blocks.begin(), m_blocks.end(), nullptr);
+  m_dsp_core.DSPState().reset_dspjit_codespace = false;
+}
+
+static void CheckExceptionsThunk(DSPCore* dsp)
+{
+  dsp->CheckExceptions();
+}
+
+static void FallbackThunk(Interpreter::Interpreter* interpreter, UDSPInstruction inst)
+{
+  (interpreter->*Interpreter::GetOp(inst))(inst);
+}
+
+static void FallbackExtThunk(Interpreter::Interpreter* interpreter, UDSPInstruction inst)
+{
+  (interpreter->*Interpreter::GetExtOp(inst))(inst);
+}
+
+static void ApplyWriteBackLogThunk(Interpreter::Interpreter* interpreter)
+{
+  interpreter->ApplyWriteBackLog();
+}
+
+// Same as Interpreter::HandleLoop, except that the address of the instruction is known at compile
+// time. Returns true if the looping hardware is active, in which case the block has to be left
+// since pc may have changed.
+static bool HandleLoopThunk(SDSP* state, u16 next_pc)
+{
+  const u16 loop_address = state->r.st[2];
+  u16& loop_counter = state->r.st[3];
+
+  if (loop_address == 0 || loop_counter == 0)
+    return false;
+
+  if (static_cast<u16>(next_pc - 1) == loop_address)
+  {
+    loop_counter--;
+    if (loop_counter > 0)
+    {
+      state->pc = state->r.st[0];
+    }
+    else
+    {
+      // end of loop
+      state->PopStack(StackRegister::Call);
+      state->PopStack(StackRegister::LoopAddress);
+      state->PopStack(StackRegister::LoopCounter);
+    }
+  }
+
+  return true;
+}
+
+void DSPEmitter::WriteBlockExit(u16 cycles)
+{
+  MOVI2R(ARM64Reg::W0, cycles);
+  ABI_PopRegisters(SAVED_REGS);
+  RET();
+}
+
+// Must go out of block if exception is detected
+void DSPEmitter::CheckExceptions(u16 retval)
+{
+  LDRB(IndexType::Unsigned, ARM64Reg::W0, STATE_REG, EXCEPTIONS_OFFSET);
+  FixupBranch skip_check = CBZ(ARM64Reg::W0);
+
+  MOVI2R(ARM64Reg::W0, m_compile_pc);
+  STRH(IndexType::Unsigned, ARM64Reg::W0, STATE_REG, PC_OFFSET);
+  ABI_CallFunction(&CheckExceptionsThunk, CORE_REG);
+  WriteBlockExit(retval);
+
+  SetJumpTarget(skip_check);
+}
+
+// For conditional branches, which are left to the interpreter. Look at pc to find out whether the
+// branch was taken.
+void DSPEmitter::WriteBlockExitIfBranched(u16 cycles)
+{
+  LDRH(IndexType::Unsigned, ARM64Reg::W0, STATE_REG, PC_OFFSET);
+  CMPI2R(ARM64Reg::W0, m_compile_pc, ARM64Reg::W1);
+  FixupBranch no_branch = B(CC_EQ);
+  WriteBlockExit(cycles);
+  SetJumpTarget(no_branch);
+}
+
+u16 DSPEmitter::GetBlockCycles(u16 start_addr) const
+{
+  if (!Host::OnThread() && m_dsp_core.DSPState().GetAnalyzer().IsIdleSkip(start_addr))
+    return DSP_IDLE_SKIP_CYCLES;
+  return m_block_size;
+}
+
+void DSPEmitter::EmitInstruction(UDSPInstruction inst)
+{
+  const DSPOPCTemplate* const op_template = GetOpTemplate(inst);
+
+  if (op_template->reads_pc)
+  {
+    // Fallbacks to interpreter need this for fetching immediate values
+    MOVI2R(ARM64Reg::W0, static_cast<u16>(m_compile_pc + 1));
+    STRH(IndexType::Unsigned, ARM64Reg::W0, STATE_REG, PC_OFFSET);
+  }
+
+  if (op_template->extended)
+    ABI_CallFunction(&FallbackExtThunk, INTERPRETER_REG, inst);
+
+  ABI_CallFunction(&FallbackThunk, INTERPRETER_REG, inst);
+
+  if (op_template->extended)
+    ABI_CallFunction(&ApplyWriteBackLogThunk, INTERPRETER_REG);
+}
+
+DSPEmitter::CompiledBlock DSPEmitter::Compile(u16 start_addr)
+{
+  if (GetSpaceLeft() < MAX_BLOCK_CODE_SIZE)
+    ClearIRAMandDSPJITCodespaceReset();
+
+  const Common::ScopedJITPageWriteAndNoExecute enable_jit_page_writes;
+
+  SDSP& state = m_dsp_core.DSPState();
+  const Analyzer& analyzer = state.GetAnalyzer();
+
+  const u8* entry_point = AlignCode16();
+  ABI_PushRegisters(SAVED_REGS);
+  MOVP2R(STATE_REG, &state);
+  MOVP2R(INTERPRETER_REG, &m_dsp_core.GetInterpreter());
+  MOVP2R(CORE_REG, &m_dsp_core);
+
+  m_compile_pc = start_addr;
+  m_block_size = 0;
+  bool fixup_pc = false;
+
+  while (m_compile_pc < start_addr + MAX_BLOCK_SIZE)
+  {
+    if (analyzer.IsCheckExceptions(m_compile_pc))
+      CheckExceptions(m_block_size);
+
+    const UDSPInstruction inst = state.ReadIMEM(m_compile_pc);
+    const DSPOPCTemplate* opcode = GetOpTemplate(inst);
+
+    EmitInstruction(inst);
+
+    m_block_size++;
+    m_compile_pc += opcode->size;
+
+    fixup_pc = true;
+
+    // Handle loop condition, only if current instruction was flagged as a loop destination
+    // by the analyzer.
+    if (analyzer.IsLoopEnd(static_cast<u16>(m_compile_pc - 1u)))
+    {
+      if (!opcode->branch)
+      {
+        // branch insns update the g_dsp.pc
+        MOVI2R(ARM64Reg::W0, m_compile_pc);
+        STRH(IndexType::Unsigned, ARM64Reg::W0, STATE_REG, PC_OFFSET);
+      }
+
+      ABI_CallFunction(&HandleLoopThunk, STATE_REG, m_compile_pc);
+      FixupBranch no_loop = TBZ(ARM64Reg::W0, 0);
+      WriteBlockExit(GetBlockCycles(start_addr));
+      SetJumpTarget(no_loop);
+    }
+
+    if (opcode->branch)
+    {
+      // don't update g_dsp.pc -- the branch insn already did
+      fixup_pc = false;
+      if (opcode->uncond_branch)
+        break;
+
+      WriteBlockExitIfBranched(GetBlockCycles(start_addr));
+    }
+
+    // End the block if we're before an idle skip address
+    if (analyzer.IsIdleSkip(m_compile_pc))
+      break;
+  }
+
+  if (fixup_pc)
+  {
+    MOVI2R(ARM64Reg::W0, m_compile_pc);
+    STRH(IndexType::Unsigned, ARM64Reg::W0, STATE_REG, PC_OFFSET);
+  }
+
+  WriteBlockExit(GetBlockCycles(start_addr));
+  FlushIcache();
+
+  const auto block = reinterpret_cast<CompiledBlock>(entry_point);
+  m_blocks[start_addr] = block;
+  return block;
+}
+}  // namespace DSP::JIT::arm64
@@ -0,0 +1,56 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Common/Arm64Emitter.h"
+#include "Common/CommonTypes.h"
+
+#include "Core/DSP/DSPCommon.h"
+#include "Core/DSP/Jit/DSPEmitterBase.h"
+
+class PointerWrap;
+
+namespace DSP::JIT::arm64
+{
+// Compiles blocks of DSP code into a sequence of calls to the interpreter's opcode functions.
+// This gets rid of the fetch, decode and dispatch work that the interpreter does for every
+// instruction, as well as the per-instruction loop and exception checks, which the analyzer lets
+// us resolve at compile time.
+class DSPEmitter final : public JIT::DSPEmitter, public Arm64Gen::ARM64CodeBlock
+{
+public:
+  explicit DSPEmitter(DSPCore& dsp);
+  ~DSPEmitter() override;
+
+  u16 RunCycles(u16 cycles) override;
+  void DoState(PointerWrap& p) override;
+  void ClearIRAM() override;
+
+private:
+  // Returns the number of cycles that the block used up.
+  using CompiledBlock = u16 (*)();
+
+  static constexpr size_t MAX_BLOCKS = 0x10000;
+
+  CompiledBlock Compile(u16 start_addr);
+  void ClearIRAMandDSPJITCodespaceReset();
+
+  void EmitInstruction(UDSPInstruction inst);
+  void CheckExceptions(u16 retval);
+  void WriteBlockExit(u16 cycles);
+  void WriteBlockExitIfBranched(u16 cycles);
+  u16 GetBlockCycles(u16 start_addr) const;
+
+  std::vector<CompiledBlock> m_blocks;
+
+  u16 m_compile_pc = 0;
+  u16 m_block_size = 0;
+  u16 m_cycles_left = 0;
+
+  DSPCore& m_dsp_core;
+};
+}  // namespace DSP::JIT::arm64
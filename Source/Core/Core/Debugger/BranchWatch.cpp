@@ -4,22 +4,85 @@
 #include "Core/Debugger/BranchWatch.h"
 
 #include <algorithm>
+#include <bit>
 #include <cstddef>
 #include <cstdio>
+#include <mutex>
+#include <thread>
 
 #include <fmt/format.h>
 
 #include "Common/Assert.h"
 #include "Common/BitField.h"
 #include "Common/CommonTypes.h"
+#include "Common/Thread.h"
 #include "Core/Core.h"
 #include "Core/PowerPC/Gekko.h"
 #include "Core/PowerPC/MMU.h"
 
 namespace Core
 {
+BranchWatch::~BranchWatch()
+{
+  StopAggregationThread();
+}
+
+void BranchWatch::SetRecordingActive(bool active)
+{
+  if (active && !m_aggregation_thread.joinable())
+  {
+    m_aggregation_thread_running.Set();
+    m_aggregation_thread = std::thread(&BranchWatch::AggregationThread, this);
+  }
+
+  m_recording_active = active;
+
+  if (!active)
+    StopAggregationThread();
+}
+
+void BranchWatch::AggregationThread()
+{
+  Common::SetCurrentThreadName("Branch Watch");
+
+  while (m_aggregation_thread_running.IsSet())
+  {
+    m_aggregation_event.WaitFor(AGGREGATION_INTERVAL);
+
+    std::lock_guard lock(m_aggregation_mutex);
+    AggregateBufferedHits();
+  }
+}
+
+void BranchWatch::StopAggregationThread()
+{
+  if (!m_aggregation_thread.joinable())
+    return;
+
+  m_aggregation_thread_running.Clear();
+  m_aggregation_event.Set();
+  m_aggregation_thread.join();
+}
+
+void BranchWatch::AggregateBufferedHits()
+{
+  const u32 read = m_hit_buffer_read.load(std::memory_order_relaxed);
+  const u32 write = m_hit_buffer_write.load(std::memory_order_acquire);
+  for (u32 i = read; i != write; ++i)
+  {
+    const BufferedHit& hit = m_hit_buffer[i % HIT_BUFFER_SIZE];
+    GetCollection(hit.is_virtual, hit.condition)[{
+        std::bit_cast<FakeBranchWatchCollectionKey>(hit.fake_key), hit.inst}]
+        .total_hits += hit.count;
+  }
+  m_hit_buffer_read.store(write, std::memory_order_release);
+}
+
 void BranchWatch::Clear(const CPUThreadGuard&)
 {
+  std::lock_guard lock(m_aggregation_mutex);
+  AggregateBufferedHits();
+
   m_selection.clear();
   m_collection_vt.clear();
   m_collection_vf.clear();
@@ -59,7 +122,7 @@ union USnapshotMetadata
   }
 };
 
-void BranchWatch::Save(const CPUThreadGuard& guard, std::FILE* file) const
+void BranchWatch::Save(const CPUThreadGuard& guard, std::FILE* file)
 {
   if (!CanSave())
   {
@@ -69,6 +132,9 @@ void BranchWatch::Save(const CPUThreadGuard& guard, std::FILE* file) const
   if (file == nullptr)
     return;
 
+  std::lock_guard lock(m_aggregation_mutex);
+  AggregateBufferedHits();
+
   const auto routine = [&](const Collection& collection, bool is_virtual, bool condition) {
     for (const Collection::value_type& kv : collection)
     {
@@ -96,6 +162,8 @@ void BranchWatch::Load(const CPUThreadGuard& guard, std::FILE* file)
 
   Clear(guard);
 
+  std::lock_guard lock(m_aggregation_mutex);
+
   u32 origin_addr, destin_addr, inst_hex;
   std::size_t total_hits, hits_snapshot;
   USnapshotMetadata snapshot_metadata = {};
@@ -131,6 +199,9 @@ void BranchWatch::Load(const CPUThreadGuard& guard, std::FILE* file)
 
 void BranchWatch::IsolateHasExecuted(const CPUThreadGuard&)
 {
+  std::lock_guard lock(m_aggregation_mutex);
+  AggregateBufferedHits();
+
   switch (m_recording_phase)
   {
   case Phase::Blacklist:
@@ -169,6 +240,9 @@ void BranchWatch::IsolateHasExecuted(const CPUThreadGuard&)
 
 void BranchWatch::IsolateNotExecuted(const CPUThreadGuard&)
 {
+  std::lock_guard lock(m_aggregation_mutex);
+  AggregateBufferedHits();
+
   switch (m_recording_phase)
   {
   case Phase::Blacklist:
@@ -203,6 +277,10 @@ void BranchWatch::IsolateWasOverwritten(const CPUThreadGuard& guard)
     ASSERT_MSG(CORE, false, "Core is uninitialized.");
     return;
   }
+
+  std::lock_guard lock(m_aggregation_mutex);
+  AggregateBufferedHits();
+
   switch (m_recording_phase)
   {
   case Phase::Blacklist:
@@ -251,6 +329,10 @@ void BranchWatch::IsolateNotOverwritten(const CPUThreadGuard& guard)
     ASSERT_MSG(CORE, false, "Core is uninitialized.");
     return;
   }
+
+  std::lock_guard lock(m_aggregation_mutex);
+  AggregateBufferedHits();
+
   switch (m_recording_phase)
   {
   case Phase::Blacklist:
@@ -290,6 +372,9 @@ void BranchWatch::IsolateNotOverwritten(const CPUThreadGuard& guard)
 
 void BranchWatch::UpdateHitsSnapshot()
 {
+  std::lock_guard lock(m_aggregation_mutex);
+  AggregateBufferedHits();
+
   switch (m_recording_phase)
   {
   case Phase::Reduction:
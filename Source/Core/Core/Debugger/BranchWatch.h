@@ -3,15 +3,21 @@
 
 #pragma once
 
+#include <atomic>
 #include <bit>
+#include <chrono>
 #include <cstddef>
 #include <cstdio>
 #include <functional>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/EnumUtils.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
 #include "Core/PowerPC/Gekko.h"
 
 namespace Core
@@ -116,13 +122,18 @@ public:
   using Phase = BranchWatchPhase;
   using SelectionInspection = BranchWatchSelectionInspection;
 
+  BranchWatch() = default;
+  BranchWatch(const BranchWatch&) = delete;
+  BranchWatch& operator=(const BranchWatch&) = delete;
+  ~BranchWatch();
+
   bool GetRecordingActive() const { return m_recording_active; }
-  void SetRecordingActive(bool active) { m_recording_active = active; }
+  void SetRecordingActive(bool active);
   void Start() { SetRecordingActive(true); }
   void Pause() { SetRecordingActive(false); }
   void Clear(const CPUThreadGuard& guard);
 
-  void Save(const CPUThreadGuard& guard, std::FILE* file) const;
+  void Save(const CPUThreadGuard& guard, std::FILE* file);
   void Load(const CPUThreadGuard& guard, std::FILE* file);
 
   void IsolateHasExecuted(const CPUThreadGuard& guard);
@@ -136,6 +147,7 @@ public:
   Selection& GetSelection() { return m_selection; }
   const Selection& GetSelection() const { return m_selection; }
 
+  // Hits are added to the collections in batches, so this can lag behind while recording.
   std::size_t GetCollectionSize() const
   {
     return m_collection_vt.size() + m_collection_vf.size() + m_collection_pt.size() +
@@ -152,40 +164,38 @@ public:
   // functions. HitXX_fk are optimized for when origin and destination can be passed in one register
   // easily as a Core::FakeBranchWatchCollectionKey (abbreviated as "fk"). HitXX_fk_n are the same,
   // but also increment the total_hits by N (see dcbx JIT code).
+  //
+  // A hit is only appended to a ring buffer here. A worker thread adds the buffered hits to the
+  // collections while recording, and all functions above that look at the collections add any
+  // remaining ones first.
   static void HitVirtualTrue_fk(BranchWatch* branch_watch, u64 fake_key, u32 inst)
   {
-    branch_watch->m_collection_vt[{std::bit_cast<FakeBranchWatchCollectionKey>(fake_key), inst}]
-        .total_hits += 1;
+    branch_watch->RecordHit(true, true, fake_key, inst, 1);
   }
 
   static void HitPhysicalTrue_fk(BranchWatch* branch_watch, u64 fake_key, u32 inst)
   {
-    branch_watch->m_collection_pt[{std::bit_cast<FakeBranchWatchCollectionKey>(fake_key), inst}]
-        .total_hits += 1;
+    branch_watch->RecordHit(false, true, fake_key, inst, 1);
   }
 
   static void HitVirtualFalse_fk(BranchWatch* branch_watch, u64 fake_key, u32 inst)
   {
-    branch_watch->m_collection_vf[{std::bit_cast<FakeBranchWatchCollectionKey>(fake_key), inst}]
-        .total_hits += 1;
+    branch_watch->RecordHit(true, false, fake_key, inst, 1);
   }
 
   static void HitPhysicalFalse_fk(BranchWatch* branch_watch, u64 fake_key, u32 inst)
   {
-    branch_watch->m_collection_pf[{std::bit_cast<FakeBranchWatchCollectionKey>(fake_key), inst}]
-        .total_hits += 1;
+    branch_watch->RecordHit(false, false, fake_key, inst, 1);
   }
 
   static void HitVirtualTrue_fk_n(BranchWatch* branch_watch, u64 fake_key, u32 inst, u32 n)
   {
-    branch_watch->m_collection_vt[{std::bit_cast<FakeBranchWatchCollectionKey>(fake_key), inst}]
-        .total_hits += n;
+    branch_watch->RecordHit(true, true, fake_key, inst, n);
   }
 
   static void HitPhysicalTrue_fk_n(BranchWatch* branch_watch, u64 fake_key, u32 inst, u32 n)
   {
-    branch_watch->m_collection_pt[{std::bit_cast<FakeBranchWatchCollectionKey>(fake_key), inst}]
-        .total_hits += n;
+    branch_watch->RecordHit(false, true, fake_key, inst, n);
   }
 
   // HitVirtualFalse_fk_n and HitPhysicalFalse_fk_n are never used, so they are omitted here.
@@ -240,6 +250,42 @@ public:
   }
 
 private:
+  struct BufferedHit
+  {
+    u64 fake_key;
+    u32 inst;
+    u32 count;
+    bool is_virtual;
+    bool condition;
+  };
+
+  // Must be a power of two. Large enough that the worker thread rarely falls behind.
+  static constexpr u32 HIT_BUFFER_SIZE = 1 << 16;
+  static constexpr auto AGGREGATION_INTERVAL = std::chrono::milliseconds(10);
+
+  void RecordHit(bool is_virtual, bool condition, u64 fake_key, u32 inst, u32 count)
+  {
+    const u32 write = m_hit_buffer_write.load(std::memory_order_relaxed);
+    if (write - m_hit_buffer_read.load(std::memory_order_acquire) == HIT_BUFFER_SIZE)
+    {
+      // The worker thread has fallen behind (or isn't running). Rather than dropping hits, make
+      // room on this thread.
+      std::lock_guard lock(m_aggregation_mutex);
+      AggregateBufferedHits();
+    }
+
+    m_hit_buffer[write % HIT_BUFFER_SIZE] = {fake_key, inst, count, is_virtual, condition};
+    m_hit_buffer_write.store(write + 1, std::memory_order_release);
+
+    if (write % (HIT_BUFFER_SIZE / 2) == 0)
+      m_aggregation_event.Set();
+  }
+
+  // m_aggregation_mutex must be held.
+  void AggregateBufferedHits();
+  void AggregationThread();
+  void StopAggregationThread();
+
   Collection& GetCollectionV(bool condition)
   {
     if (condition)
@@ -269,6 +315,15 @@ private:
   Collection m_collection_pt;  // physical address space | true path
   Collection m_collection_pf;  // physical address space | false path
   Selection m_selection;
+
+  // Single producer (the CPU thread), the consumers are serialized by m_aggregation_mutex.
+  std::vector<BufferedHit> m_hit_buffer = std::vector<BufferedHit>(HIT_BUFFER_SIZE);
+  std::atomic<u32> m_hit_buffer_write = 0;
+  std::atomic<u32> m_hit_buffer_read = 0;
+  std::mutex m_aggregation_mutex;
+  std::thread m_aggregation_thread;
+  Common::Event m_aggregation_event;
+  Common::Flag m_aggregation_thread_running;
 };
 
 #if _M_X86_64
@@ -0,0 +1,179 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/Debugger/TraceRecorder.h"
+
+#include "Common/Assert.h"
+#include "Common/Logging/Log.h"
+#include "Core/Core.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PPCAnalyst.h"
+#include "Core/PowerPC/PPCTables.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+namespace Core
+{
+// Records are written to the file in blocks of this many, which keeps the cost of writing them
+// out negligible compared to running the JIT code in between.
+static constexpr size_t BUFFER_RECORDS = 1 << 16;
+
+TraceRecorder::TraceRecorder(PowerPC::PowerPCState& ppc_state) : m_ppc_state(ppc_state)
+{
+}
+
+TraceRecorder::~TraceRecorder()
+{
+  Shutdown();
+}
+
+bool TraceRecorder::Start(const CPUThreadGuard& guard, const std::string& path)
+{
+  if (m_recording)
+    Stop(guard);
+
+  m_file.Open(path, "wb");
+  const TraceFileHeader header{MAGIC, VERSION, sizeof(TraceRecord), 0};
+  if (!m_file || !m_file.WriteArray(&header, 1))
+  {
+    ERROR_LOG_FMT(POWERPC, "Failed to open the trace file {}", path);
+    m_file.Close();
+    return false;
+  }
+
+  m_buffer.clear();
+  m_buffer.reserve(BUFFER_RECORDS);
+  m_record_count = 0;
+  m_recording = true;
+  guard.GetSystem().GetJitInterface().ClearCache(guard);
+  return true;
+}
+
+void TraceRecorder::Stop(const CPUThreadGuard& guard)
+{
+  if (!m_recording)
+    return;
+
+  guard.GetSystem().GetJitInterface().ClearCache(guard);
+  Shutdown();
+}
+
+void TraceRecorder::Shutdown()
+{
+  if (!m_recording)
+    return;
+
+  Flush();
+  m_file.Close();
+  m_recording = false;
+
+  // No compiled code refers to these anymore
+  m_instructions.clear();
+  m_buffer = {};
+
+  NOTICE_LOG_FMT(POWERPC, "Recorded {} instructions to the trace file", m_record_count);
+}
+
+const TraceRecorder::InstructionInfo*
+TraceRecorder::GetInstructionInfo(const PPCAnalyst::CodeOp& op)
+{
+  const u64 key = (static_cast<u64>(op.address) << 32) | op.inst.hex;
+  const auto [it, inserted] = m_instructions.try_emplace(key);
+  InstructionInfo& info = it->second;
+  if (!inserted)
+    return &info;
+
+  const UGeckoInstruction inst = op.inst;
+  info.record.pc = op.address;
+  info.record.inst = inst.hex;
+  info.record.gprs_read = op.regsIn.m_val;
+  info.record.gprs_written = op.regsOut.m_val;
+  info.record.fprs_read = op.fregsIn.m_val;
+  info.record.fprs_written = op.GetFregsOut().m_val;
+  info.record.memory_address = 0;
+  info.record.flags = 0;
+  info.address_mode = AddressMode::None;
+  info.ra = static_cast<u8>(inst.RA);
+  info.rb = static_cast<u8>(inst.RB);
+  info.offset = 0;
+
+  if (!(op.opinfo->flags & FL_LOADSTORE))
+    return &info;
+
+  if (inst.OPCD >= 32 && inst.OPCD <= 55)
+  {
+    info.address_mode = AddressMode::ImmediateOffset;
+    info.offset = inst.SIMM_16;
+  }
+  else if (inst.OPCD == 56 || inst.OPCD == 57 || inst.OPCD == 60 || inst.OPCD == 61)
+  {
+    info.address_mode = AddressMode::ImmediateOffset;
+    info.offset = static_cast<s16>(inst.SIMM_12);
+  }
+  else if (inst.OPCD == 31 && (inst.SUBOP10 == 597 || inst.SUBOP10 == 725))
+  {
+    // lswi and stswi
+    info.address_mode = AddressMode::Base;
+  }
+  else if (inst.OPCD == 31 || inst.OPCD == 4)
+  {
+    info.address_mode = AddressMode::Indexed;
+  }
+
+  if (info.address_mode != AddressMode::None)
+    info.record.flags |= TRACE_FLAG_HAS_MEMORY_ADDRESS;
+
+  switch (op.opinfo->type)
+  {
+  case OpType::Load:
+  case OpType::LoadFP:
+  case OpType::LoadPS:
+    info.record.flags |= TRACE_FLAG_LOAD;
+    break;
+  case OpType::Store:
+  case OpType::StoreFP:
+  case OpType::StorePS:
+    info.record.flags |= TRACE_FLAG_STORE;
+    break;
+  default:
+    break;
+  }
+
+  return &info;
+}
+
+void TraceRecorder::Record(TraceRecorder* recorder, const InstructionInfo* info)
+{
+  DEBUG_ASSERT(recorder->m_recording);
+
+  TraceRecord& record = recorder->m_buffer.emplace_back(info->record);
+  const auto& gpr = recorder->m_ppc_state.gpr;
+  const u32 base = info->ra != 0 ? gpr[info->ra] : 0;
+  switch (info->address_mode)
+  {
+  case AddressMode::ImmediateOffset:
+    record.memory_address = base + info->offset;
+    break;
+  case AddressMode::Indexed:
+    record.memory_address = base + gpr[info->rb];
+    break;
+  case AddressMode::Base:
+    record.memory_address = base;
+    break;
+  case AddressMode::None:
+    break;
+  }
+
+  if (recorder->m_buffer.size() == BUFFER_RECORDS)
+    recorder->Flush();
+}
+
+void TraceRecorder::Flush()
+{
+  if (!m_buffer.empty() && !m_file.WriteArray(m_buffer.data(), m_buffer.size()))
+    ERROR_LOG_FMT(POWERPC, "Failed to write {} records to the trace file", m_buffer.size());
+
+  m_record_count += m_buffer.size();
+  m_buffer.clear();
+}
+}  // namespace Core
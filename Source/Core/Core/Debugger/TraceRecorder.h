@@ -0,0 +1,129 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+
+namespace Core
+{
+class CPUThreadGuard;
+}
+namespace PowerPC
+{
+struct PowerPCState;
+}
+namespace PPCAnalyst
+{
+struct CodeOp;
+}
+
+namespace Core
+{
+// A trace file is a TraceFileHeader followed by one TraceRecord for every instruction that was
+// executed while recording, in the order they were executed. Everything is in the host's byte
+// order. Records are only written by JIT code, so an instruction that causes an exception still
+// shows up in the trace even though it didn't complete.
+struct TraceFileHeader
+{
+  u32 magic;
+  u32 version;
+  u32 record_size;
+  u32 padding;
+};
+static_assert(sizeof(TraceFileHeader) == 16);
+
+enum TraceRecordFlags : u32
+{
+  TRACE_FLAG_HAS_MEMORY_ADDRESS = 1u << 0,
+  TRACE_FLAG_LOAD = 1u << 1,
+  TRACE_FLAG_STORE = 1u << 2,
+};
+
+struct TraceRecord
+{
+  u32 pc;
+  u32 inst;
+  // One bit per GPR or FPR, as found by the block analyzer
+  u32 gprs_read;
+  u32 gprs_written;
+  u32 fprs_read;
+  u32 fprs_written;
+  // The effective address of a load, store or cache instruction, before it was executed
+  u32 memory_address;
+  u32 flags;
+};
+static_assert(sizeof(TraceRecord) == 32);
+
+// Records a compact binary trace of everything the JIT executes. Because the record for an
+// instruction is mostly known when the instruction is compiled, the JIT only calls Record with a
+// pointer to the precomputed part, and the only thing left to do at run time is to compute the
+// memory address. Traces of many millions of instructions can be recorded this way, and can be
+// queried offline with "dolphin-tool trace".
+class TraceRecorder final
+{
+public:
+  static constexpr u32 MAGIC = 0x43525444;  // "DTRC"
+  static constexpr u32 VERSION = 1;
+
+  enum class AddressMode : u8
+  {
+    None,
+    // (rA|0) + offset
+    ImmediateOffset,
+    // (rA|0) + rB
+    Indexed,
+    // (rA|0)
+    Base,
+  };
+
+  // What the JIT knows about an instruction when compiling it
+  struct InstructionInfo
+  {
+    TraceRecord record;
+    AddressMode address_mode;
+    u8 ra;
+    u8 rb;
+    s16 offset;
+  };
+
+  explicit TraceRecorder(PowerPC::PowerPCState& ppc_state);
+  TraceRecorder(const TraceRecorder&) = delete;
+  TraceRecorder(TraceRecorder&&) = delete;
+  TraceRecorder& operator=(const TraceRecorder&) = delete;
+  TraceRecorder& operator=(TraceRecorder&&) = delete;
+  ~TraceRecorder();
+
+  // Both clear the JIT cache, so that code is recompiled with or without the calls to Record.
+  bool Start(const CPUThreadGuard& guard, const std::string& path);
+  void Stop(const CPUThreadGuard& guard);
+  // Finishes the trace file when emulation stops, at which point the JIT is gone already
+  void Shutdown();
+
+  bool IsRecording() const { return m_recording; }
+  u64 GetRecordCount() const { return m_record_count + m_buffer.size(); }
+
+  // Called by the JIT while compiling. The returned pointer stays valid until recording stops.
+  const InstructionInfo* GetInstructionInfo(const PPCAnalyst::CodeOp& op);
+
+  // Called by JIT code before each instruction, with all guest registers flushed to ppc_state
+  static void Record(TraceRecorder* recorder, const InstructionInfo* info);
+
+private:
+  void Flush();
+
+  PowerPC::PowerPCState& m_ppc_state;
+
+  bool m_recording = false;
+  File::IOFile m_file;
+  std::vector<TraceRecord> m_buffer;
+  u64 m_record_count = 0;
+
+  std::unordered_map<u64, InstructionInfo> m_instructions;
+};
+}  // namespace Core
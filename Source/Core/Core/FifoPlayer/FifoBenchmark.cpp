@@ -0,0 +1,164 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/FifoPlayer/FifoBenchmark.h"
+
+#include <string_view>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
+#include "VideoCommon/AbstractGfx.h"
+#include "VideoCommon/VideoEvents.h"
+
+static std::string FormatMilliseconds(std::optional<u64> ns, std::string_view missing)
+{
+  if (!ns)
+    return std::string(missing);
+  return fmt::format("{:.4f}", *ns / 1000000.0);
+}
+
+FifoBenchmark::FifoBenchmark(std::string output_path, u32 loops)
+    : m_output_path(std::move(output_path)), m_loops(loops)
+{
+  m_before_present_hook = BeforePresentEvent::Register(
+      [this](PresentInfo& present_info) { OnBeforePresent(present_info); }, "FifoBenchmark");
+  m_after_present_hook = AfterPresentEvent::Register(
+      [this](PresentInfo& present_info) { OnAfterPresent(present_info); }, "FifoBenchmark");
+}
+
+FifoBenchmark::~FifoBenchmark() = default;
+
+void FifoBenchmark::BeginFrame(u32 loop, u32 frame)
+{
+  m_submitted_frames.push_back({loop, frame, 0});
+  m_submit_start = Clock::now();
+}
+
+void FifoBenchmark::EndFrame()
+{
+  const auto duration = Clock::now() - m_submit_start;
+  m_submitted_frames.back().submit_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+}
+
+void FifoBenchmark::OnBeforePresent(const PresentInfo& present_info)
+{
+  if (present_info.reason == PresentInfo::PresentReason::VideoInterfaceDuplicate)
+    return;
+
+  m_present_start = Clock::now();
+}
+
+void FifoBenchmark::OnAfterPresent(const PresentInfo& present_info)
+{
+  if (present_info.reason == PresentInfo::PresentReason::VideoInterfaceDuplicate)
+    return;
+
+  const Clock::time_point now = Clock::now();
+
+  std::lock_guard lk(m_present_mutex);
+
+  PresentedFrame& presented = m_presented_frames.emplace_back();
+  presented.present_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_present_start).count();
+  if (m_last_present)
+  {
+    presented.frame_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - *m_last_present).count();
+  }
+  m_last_present = now;
+
+  // The timer runs from one present to the next, so it covers all of the GPU work of a frame
+  g_gfx->StopGPUTimer();
+  while (const std::optional<u64> gpu_time = g_gfx->PopGPUTimerResult())
+    m_gpu_times.push_back(*gpu_time);
+  g_gfx->StartGPUTimer();
+}
+
+bool FifoBenchmark::Save() const
+{
+  std::lock_guard lk(m_present_mutex);
+
+  const bool json = m_output_path.ends_with(".json");
+  const std::string_view missing = json ? "null" : "";
+
+  std::string output;
+  if (json)
+  {
+    output += fmt::format("{{\n  \"video_backend\": \"{}\",\n  \"loops\": {},\n  \"frames\": [\n",
+                          Config::Get(Config::MAIN_GFX_BACKEND), m_loops);
+  }
+  else
+  {
+    output += "frame,loop,fifo_frame,submit_ms,gpu_ms,present_ms,frame_ms\n";
+  }
+
+  u64 total_submit_ns = 0;
+  u64 total_frame_ns = 0;
+  size_t frame_count = 0;
+  for (size_t i = 0; i < m_submitted_frames.size(); ++i)
+  {
+    const SubmittedFrame& submitted = m_submitted_frames[i];
+
+    std::optional<u64> present_ns;
+    std::optional<u64> frame_ns;
+    if (i < m_presented_frames.size())
+    {
+      present_ns = m_presented_frames[i].present_ns;
+      frame_ns = m_presented_frames[i].frame_ns;
+    }
+
+    // The first GPU time is measured from the first present to the second one
+    std::optional<u64> gpu_ns;
+    if (i != 0 && i - 1 < m_gpu_times.size())
+      gpu_ns = m_gpu_times[i - 1];
+
+    total_submit_ns += submitted.submit_ns;
+    if (frame_ns)
+    {
+      total_frame_ns += *frame_ns;
+      ++frame_count;
+    }
+
+    if (json)
+    {
+      output += fmt::format(
+          "    {{\"loop\": {}, \"fifo_frame\": {}, \"submit_ms\": {}, \"gpu_ms\": {}, "
+          "\"present_ms\": {}, \"frame_ms\": {}}}{}\n",
+          submitted.loop, submitted.frame, FormatMilliseconds(submitted.submit_ns, missing),
+          FormatMilliseconds(gpu_ns, missing), FormatMilliseconds(present_ns, missing),
+          FormatMilliseconds(frame_ns, missing), i + 1 < m_submitted_frames.size() ? "," : "");
+    }
+    else
+    {
+      output += fmt::format("{},{},{},{},{},{},{}\n", i, submitted.loop, submitted.frame,
+                            FormatMilliseconds(submitted.submit_ns, missing),
+                            FormatMilliseconds(gpu_ns, missing),
+                            FormatMilliseconds(present_ns, missing),
+                            FormatMilliseconds(frame_ns, missing));
+    }
+  }
+
+  if (json)
+    output += "  ]\n}\n";
+
+  if (!m_submitted_frames.empty())
+  {
+    NOTICE_LOG_FMT(VIDEO, "FIFO benchmark: {} frames, {:.4f} ms submit, {:.4f} ms per frame",
+                   m_submitted_frames.size(),
+                   total_submit_ns / 1000000.0 / m_submitted_frames.size(),
+                   frame_count != 0 ? total_frame_ns / 1000000.0 / frame_count : 0.0);
+  }
+
+  if (!File::WriteStringToFile(m_output_path, output))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to write the FIFO benchmark results to {}", m_output_path);
+    return false;
+  }
+
+  return true;
+}
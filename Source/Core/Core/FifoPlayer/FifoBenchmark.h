@@ -0,0 +1,76 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Timings of a fifolog which is played back a number of times without a frame limit. Since the
+// GPU workload is exactly the same every time, they can be compared between video backends and
+// between builds.
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/HookableEvent.h"
+
+struct PresentInfo;
+
+class FifoBenchmark
+{
+public:
+  FifoBenchmark(std::string output_path, u32 loops);
+  FifoBenchmark(const FifoBenchmark&) = delete;
+  FifoBenchmark& operator=(const FifoBenchmark&) = delete;
+  ~FifoBenchmark();
+
+  u32 GetLoops() const { return m_loops; }
+
+  // NOTE: CPU Thread. Called around writing a frame of the fifolog to the FIFO.
+  void BeginFrame(u32 loop, u32 frame);
+  void EndFrame();
+
+  // Writes a row for every frame that was written, as JSON if the output path ends in .json and
+  // as CSV otherwise. The n-th row combines the n-th frame written by the CPU with the n-th frame
+  // presented by the GPU, and timings which weren't measured are left empty.
+  bool Save() const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct SubmittedFrame
+  {
+    u32 loop;
+    u32 frame;
+    u64 submit_ns;
+  };
+
+  struct PresentedFrame
+  {
+    u64 present_ns;
+    // The time since the previous present, which the first one doesn't have
+    std::optional<u64> frame_ns;
+  };
+
+  // NOTE: GPU Thread
+  void OnBeforePresent(const PresentInfo& present_info);
+  void OnAfterPresent(const PresentInfo& present_info);
+
+  std::string m_output_path;
+  u32 m_loops;
+
+  std::vector<SubmittedFrame> m_submitted_frames;
+  Clock::time_point m_submit_start;
+
+  mutable std::mutex m_present_mutex;
+  std::vector<PresentedFrame> m_presented_frames;
+  // Each one measures the GPU time from one present to the next
+  std::vector<u64> m_gpu_times;
+  Clock::time_point m_present_start;
+  std::optional<Clock::time_point> m_last_present;
+
+  Common::EventHook m_before_present_hook;
+  Common::EventHook m_after_present_hook;
+};
@@ -9,18 +9,23 @@
 #include <string>
 #include <vector>
 
+#include <zstd.h>
+
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
 
 constexpr u32 FILE_ID = 0x0d01f1f0;
-constexpr u32 VERSION_NUMBER = 5;
+constexpr u32 VERSION_NUMBER = 6;
 constexpr u32 MIN_LOADER_VERSION = 1;
 // This value is only used if the DFF file was created with overridden RAM sizes.
 // If the MIN_LOADER_VERSION ever exceeds this, it's alright to remove it.
 constexpr u32 MIN_LOADER_VERSION_FOR_RAM_OVERRIDE = 5;
+// Likewise, this is only used if the frames of the DFF file are compressed.
+constexpr u32 MIN_LOADER_VERSION_FOR_COMPRESSION = 6;
 
 #pragma pack(push, 1)
 
@@ -58,7 +63,13 @@ struct FileFrameInfo
   u32 fifoEnd;
   u64 memoryUpdatesOffset;
   u32 numMemoryUpdates;
-  u8 reserved[32];
+  // These are only used in compressed files. The frame's FIFO data, memory update list and
+  // memory update data are compressed together into one block, and the offsets of the frame and
+  // its memory updates are relative to the start of the decompressed block.
+  u64 compressedDataOffset;
+  u32 compressedDataSize;
+  u32 uncompressedDataSize;
+  u8 reserved[16];
 };
 static_assert(sizeof(FileFrameInfo) == 64, "FileFrameInfo should be 64 bytes");
 
@@ -75,6 +86,120 @@ static_assert(sizeof(FileMemoryUpdate) == 24, "FileMemoryUpdate should be 24 byt
 
 #pragma pack(pop)
 
+// Lays out a frame as its FIFO data, its memory update list and then the data of its memory
+// updates, with all offsets counted from base_offset
+static std::vector<u8> SerializeFrame(const FifoFrameInfo& frame, u64 base_offset,
+                                      FileFrameInfo* info)
+{
+  std::vector<u8> data(frame.fifoData.begin(), frame.fifoData.end());
+
+  const u64 updates_offset = data.size();
+  data.resize(updates_offset + frame.memoryUpdates.size() * sizeof(FileMemoryUpdate));
+
+  for (size_t i = 0; i < frame.memoryUpdates.size(); ++i)
+  {
+    const MemoryUpdate& srcUpdate = frame.memoryUpdates[i];
+
+    FileMemoryUpdate dstUpdate{};
+    dstUpdate.address = srcUpdate.address;
+    dstUpdate.dataOffset = base_offset + data.size();
+    dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
+    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
+    dstUpdate.type = static_cast<u8>(srcUpdate.type);
+    std::memcpy(data.data() + updates_offset + i * sizeof(FileMemoryUpdate), &dstUpdate,
+                sizeof(FileMemoryUpdate));
+
+    data.insert(data.end(), srcUpdate.data.begin(), srcUpdate.data.end());
+  }
+
+  info->fifoDataOffset = base_offset;
+  info->fifoDataSize = static_cast<u32>(frame.fifoData.size());
+  info->fifoStart = frame.fifoStart;
+  info->fifoEnd = frame.fifoEnd;
+  info->memoryUpdatesOffset = base_offset + updates_offset;
+  info->numMemoryUpdates = static_cast<u32>(frame.memoryUpdates.size());
+
+  return data;
+}
+
+// Reads the parts of a frame through read, which takes offsets below source_size. Everything is
+// bounds checked first, since the sizes are used for allocations.
+template <typename ReadFunction>
+static bool ParseFrame(const FileFrameInfo& src, u64 source_size, const ReadFunction& read,
+                       FifoFrameInfo* dst)
+{
+  const auto in_range = [source_size](u64 offset, u64 size) {
+    return offset <= source_size && size <= source_size - offset;
+  };
+
+  const u64 updates_size = u64{src.numMemoryUpdates} * sizeof(FileMemoryUpdate);
+  if (!in_range(src.fifoDataOffset, src.fifoDataSize) ||
+      !in_range(src.memoryUpdatesOffset, updates_size))
+  {
+    return false;
+  }
+
+  dst->fifoData.resize(src.fifoDataSize);
+  if (!read(src.fifoDataOffset, src.fifoDataSize, dst->fifoData.data()))
+    return false;
+
+  std::vector<FileMemoryUpdate> srcUpdates(src.numMemoryUpdates);
+  if (!read(src.memoryUpdatesOffset, updates_size, reinterpret_cast<u8*>(srcUpdates.data())))
+    return false;
+
+  dst->memoryUpdates.resize(srcUpdates.size());
+  for (size_t i = 0; i < srcUpdates.size(); ++i)
+  {
+    const FileMemoryUpdate& srcUpdate = srcUpdates[i];
+    if (!in_range(srcUpdate.dataOffset, srcUpdate.dataSize))
+      return false;
+
+    MemoryUpdate& dstUpdate = dst->memoryUpdates[i];
+    dstUpdate.address = srcUpdate.address;
+    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
+    dstUpdate.data.resize(srcUpdate.dataSize);
+    dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
+
+    if (!read(srcUpdate.dataOffset, srcUpdate.dataSize, dstUpdate.data.data()))
+      return false;
+  }
+
+  return true;
+}
+
+// Compresses a frame into a block of a compressed file. Returns an empty block on failure.
+static std::vector<u8> CompressFrame(const FifoFrameInfo& frame, FileFrameInfo* info)
+{
+  const std::vector<u8> data = SerializeFrame(frame, 0, info);
+
+  std::vector<u8> compressed(ZSTD_compressBound(data.size()));
+  const size_t compressedSize = ZSTD_compress(compressed.data(), compressed.size(), data.data(),
+                                              data.size(), ZSTD_CLEVEL_DEFAULT);
+  if (ZSTD_isError(compressedSize))
+    return {};
+
+  compressed.resize(compressedSize);
+  info->compressedDataSize = static_cast<u32>(compressedSize);
+  info->uncompressedDataSize = static_cast<u32>(data.size());
+  return compressed;
+}
+
+static bool DecompressFrame(const FileFrameInfo& src, const u8* compressed, FifoFrameInfo* dst)
+{
+  std::vector<u8> block(src.uncompressedDataSize);
+  if (ZSTD_decompress(block.data(), block.size(), compressed, src.compressedDataSize) !=
+      block.size())
+  {
+    return false;
+  }
+
+  const auto read_block = [&block](u64 offset, u64 size, u8* out) {
+    std::copy_n(block.begin() + offset, size, out);
+    return true;
+  };
+  return ParseFrame(src, block.size(), read_block, dst);
+}
+
 FifoDataFile::FifoDataFile() = default;
 
 FifoDataFile::~FifoDataFile() = default;
@@ -101,21 +226,138 @@ bool FifoDataFile::GetIsWii() const
 
 void FifoDataFile::AddFrame(const FifoFrameInfo& frameInfo)
 {
-  m_Frames.push_back(frameInfo);
+  FileFrameInfo info{};
+  std::vector<u8> block = CompressFrame(frameInfo, &info);
+  if (block.empty())
+    ERROR_LOG_FMT(VIDEO, "Failed to compress a recorded FIFO frame");
+
+  std::lock_guard lk(m_recorded_frames_mutex);
+  m_recorded_frames.push_back(info);
+  m_recorded_blocks.push_back(std::move(block));
+}
+
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::GetFrame(u32 frame) const
+{
+  {
+    std::lock_guard lk(m_frame_cache_mutex);
+    const auto it = std::find_if(m_frame_cache.begin(), m_frame_cache.end(),
+                                 [frame](const auto& entry) { return entry.first == frame; });
+    if (it != m_frame_cache.end())
+      return it->second;
+  }
+
+  std::shared_ptr<const FifoFrameInfo> result = ReadFrame(frame);
+
+  std::lock_guard lk(m_frame_cache_mutex);
+  m_frame_cache.emplace_front(frame, result);
+  if (m_frame_cache.size() > FRAME_CACHE_SIZE)
+    m_frame_cache.pop_back();
+
+  return result;
+}
+
+u32 FifoDataFile::GetFrameCount() const
+{
+  if (m_file.IsOpen())
+    return static_cast<u32>(m_file_frames.size());
+
+  std::lock_guard lk(m_recorded_frames_mutex);
+  return static_cast<u32>(m_recorded_frames.size());
+}
+
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::ReadFrame(u32 frame) const
+{
+  auto dstFrame = std::make_shared<FifoFrameInfo>();
+
+  bool success;
+  if (!m_file.IsOpen())
+  {
+    std::lock_guard lk(m_recorded_frames_mutex);
+    const FileFrameInfo& srcFrame = m_recorded_frames[frame];
+    dstFrame->fifoStart = srcFrame.fifoStart;
+    dstFrame->fifoEnd = srcFrame.fifoEnd;
+    success = DecompressFrame(srcFrame, m_recorded_blocks[frame].data(), dstFrame.get());
+  }
+  else
+  {
+    success = ReadFileFrame(frame, dstFrame.get());
+  }
+
+  if (!success)
+  {
+    // Playback goes on with the frame left empty, just like with a frame that has no commands
+    ERROR_LOG_FMT(VIDEO, "Failed to read frame {} of the DFF file", frame);
+    dstFrame->fifoData.clear();
+    dstFrame->memoryUpdates.clear();
+  }
+
+  return dstFrame;
+}
+
+bool FifoDataFile::ReadFileFrame(u32 frame, FifoFrameInfo* dstFrame) const
+{
+  const FileFrameInfo& srcFrame = m_file_frames[frame];
+  dstFrame->fifoStart = srcFrame.fifoStart;
+  dstFrame->fifoEnd = srcFrame.fifoEnd;
+
+  // Frames are usually played back in order, so get the next one off the disk in the meantime
+  if (frame + 1 < m_file_frames.size())
+  {
+    const FileFrameInfo& nextFrame = m_file_frames[frame + 1];
+    if (GetFlag(FLAG_COMPRESSED))
+      m_mapped_file.HintWillNeed(nextFrame.compressedDataOffset, nextFrame.compressedDataSize);
+    else
+      m_mapped_file.HintWillNeed(nextFrame.fifoDataOffset, nextFrame.fifoDataSize);
+  }
+
+  if (GetFlag(FLAG_COMPRESSED))
+  {
+    std::vector<u8> compressed(srcFrame.compressedDataSize);
+    return ReadFileData(srcFrame.compressedDataOffset, compressed.size(), compressed.data()) &&
+           DecompressFrame(srcFrame, compressed.data(), dstFrame);
+  }
+
+  const auto read_file = [this](u64 offset, u64 size, u8* out) {
+    return ReadFileData(offset, size, out);
+  };
+  return ParseFrame(srcFrame, m_file_size, read_file, dstFrame);
+}
+
+bool FifoDataFile::ReadFileData(u64 offset, u64 size, u8* out) const
+{
+  if (offset > m_file_size || size > m_file_size - offset)
+    return false;
+  if (size == 0)
+    return true;
+
+  if (m_mapped_file.GetData())
+  {
+    std::memcpy(out, m_mapped_file.GetData() + offset, size);
+    return true;
+  }
+
+  std::lock_guard lk(m_file_mutex);
+  if (m_file.Seek(offset, File::SeekOrigin::Begin) && m_file.ReadBytes(out, size))
+    return true;
+
+  m_file.ClearError();
+  return false;
 }
 
-bool FifoDataFile::Save(const std::string& filename)
+bool FifoDataFile::Save(const std::string& filename, bool compress)
 {
   File::IOFile file;
   if (!file.Open(filename, "wb"))
     return false;
 
+  const u32 frameCount = GetFrameCount();
+
   // Add space for header
   PadFile(sizeof(FileHeader), file);
 
   // Add space for frame list
   u64 frameListOffset = file.Tell();
-  PadFile(m_Frames.size() * sizeof(FileFrameInfo), file);
+  PadFile(frameCount * sizeof(FileFrameInfo), file);
 
   u64 bpMemOffset = file.Tell();
   file.WriteArray(m_BPMem);
@@ -141,6 +383,11 @@ bool FifoDataFile::Save(const std::string& filename)
     header.min_loader_version = MIN_LOADER_VERSION_FOR_RAM_OVERRIDE;
   else
     header.min_loader_version = MIN_LOADER_VERSION;
+  if (compress)
+  {
+    header.min_loader_version =
+        std::max(header.min_loader_version, MIN_LOADER_VERSION_FOR_COMPRESSION);
+  }
 
   header.bpMemOffset = bpMemOffset;
   header.bpMemSize = BP_MEM_SIZE;
@@ -158,9 +405,11 @@ bool FifoDataFile::Save(const std::string& filename)
   header.texMemSize = TEX_MEM_SIZE;
 
   header.frameListOffset = frameListOffset;
-  header.frameCount = (u32)m_Frames.size();
+  header.frameCount = frameCount;
 
-  header.flags = m_Flags;
+  header.flags = m_Flags & ~FLAG_COMPRESSED;
+  if (compress)
+    header.flags |= FLAG_COMPRESSED;
 
   auto& system = Core::System::GetInstance();
   auto& memory = system.GetMemory();
@@ -170,32 +419,43 @@ bool FifoDataFile::Save(const std::string& filename)
   file.Seek(0, File::SeekOrigin::Begin);
   file.WriteBytes(&header, sizeof(FileHeader));
 
-  // Write frames list
-  for (unsigned int i = 0; i < m_Frames.size(); ++i)
+  // Write frames
+  std::vector<FileFrameInfo> frameList(frameCount);
+  file.Seek(0, File::SeekOrigin::End);
+  for (u32 i = 0; i < frameCount; ++i)
   {
-    const FifoFrameInfo& srcFrame = m_Frames[i];
-
-    // Write FIFO data
-    file.Seek(0, File::SeekOrigin::End);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
-
-    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
-
-    FileFrameInfo dstFrame;
-    dstFrame.fifoDataSize = static_cast<u32>(srcFrame.fifoData.size());
-    dstFrame.fifoDataOffset = dataOffset;
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
-    dstFrame.memoryUpdatesOffset = memoryUpdatesOffset;
-    dstFrame.numMemoryUpdates = static_cast<u32>(srcFrame.memoryUpdates.size());
-
-    // Write frame info
-    u64 frameOffset = frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, File::SeekOrigin::Begin);
-    file.WriteBytes(&dstFrame, sizeof(FileFrameInfo));
+    FileFrameInfo& dstFrame = frameList[i];
+    const u64 dataOffset = file.Tell();
+
+    if (!compress)
+    {
+      const std::vector<u8> data = SerializeFrame(*GetFrame(i), dataOffset, &dstFrame);
+      file.WriteBytes(data.data(), data.size());
+      continue;
+    }
+
+    // Recorded frames are already compressed
+    if (!m_file.IsOpen())
+    {
+      std::lock_guard lk(m_recorded_frames_mutex);
+      dstFrame = m_recorded_frames[i];
+      dstFrame.compressedDataOffset = dataOffset;
+      file.WriteBytes(m_recorded_blocks[i].data(), m_recorded_blocks[i].size());
+      continue;
+    }
+
+    const std::vector<u8> compressed = CompressFrame(*GetFrame(i), &dstFrame);
+    if (compressed.empty())
+      return false;
+
+    dstFrame.compressedDataOffset = dataOffset;
+    file.WriteBytes(compressed.data(), compressed.size());
   }
 
+  // Write frame list
+  file.Seek(frameListOffset, File::SeekOrigin::Begin);
+  file.WriteArray(frameList.data(), frameList.size());
+
   if (!file.Close())
     return false;
 
@@ -316,32 +576,37 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
   dataFile->m_ram_size_real = header.mem1_size;
   dataFile->m_exram_size_real = header.mem2_size;
 
-  // Read frames
-  for (u32 i = 0; i < header.frameCount; ++i)
-  {
-    u64 frameOffset = header.frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, File::SeekOrigin::Begin);
-    FileFrameInfo srcFrame;
-    if (!file.ReadBytes(&srcFrame, sizeof(FileFrameInfo)))
-      return panic_failed_to_read();
-
-    FifoFrameInfo dstFrame;
-    dstFrame.fifoData.resize(srcFrame.fifoDataSize);
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
-
-    file.Seek(srcFrame.fifoDataOffset, File::SeekOrigin::Begin);
-    file.ReadBytes(dstFrame.fifoData.data(), srcFrame.fifoDataSize);
-
-    ReadMemoryUpdates(srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates,
-                      dstFrame.memoryUpdates, file);
+  // Read the frame list. The frames themselves are only read when they are requested, which
+  // keeps large files from having to fit into memory.
+  const u64 fileSize = file.GetSize();
+  const u64 frameListSize = u64{header.frameCount} * sizeof(FileFrameInfo);
+  if (header.frameListOffset > fileSize || frameListSize > fileSize - header.frameListOffset)
+    return panic_failed_to_read();
 
-    if (!file.IsGood())
-      return panic_failed_to_read();
+  dataFile->m_file_frames.resize(header.frameCount);
+  file.Seek(header.frameListOffset, File::SeekOrigin::Begin);
+  if (!file.ReadArray(dataFile->m_file_frames.data(), dataFile->m_file_frames.size()))
+    return panic_failed_to_read();
 
-    dataFile->AddFrame(dstFrame);
+  if (dataFile->GetFlag(FLAG_COMPRESSED))
+  {
+    for (const FileFrameInfo& frame : dataFile->m_file_frames)
+    {
+      if (frame.compressedDataOffset > fileSize ||
+          frame.compressedDataSize > fileSize - frame.compressedDataOffset)
+      {
+        return panic_failed_to_read();
+      }
+    }
   }
 
+  // Reading through the mapping doesn't need a lock, so the frames that are being played and the
+  // ones shown by the analyzer can be read at the same time
+  dataFile->m_file = std::move(file);
+  dataFile->m_file_size = fileSize;
+  if (!dataFile->m_mapped_file.Map(dataFile->m_file, fileSize))
+    WARN_LOG_FMT(VIDEO, "Failed to map the DFF file, reading it through the file instead");
+
   return dataFile;
 }
 
@@ -363,57 +628,3 @@ bool FifoDataFile::GetFlag(u32 flag) const
 {
   return !!(m_Flags & flag);
 }
-
-u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates,
-                                     File::IOFile& file)
-{
-  // Add space for memory update list
-  u64 updateListOffset = file.Tell();
-  PadFile(memUpdates.size() * sizeof(FileMemoryUpdate), file);
-
-  for (unsigned int i = 0; i < memUpdates.size(); ++i)
-  {
-    const MemoryUpdate& srcUpdate = memUpdates[i];
-
-    // Write memory
-    file.Seek(0, File::SeekOrigin::End);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcUpdate.data.data(), srcUpdate.data.size());
-
-    FileMemoryUpdate dstUpdate;
-    dstUpdate.address = srcUpdate.address;
-    dstUpdate.dataOffset = dataOffset;
-    dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
-    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
-    dstUpdate.type = static_cast<u8>(srcUpdate.type);
-
-    u64 updateOffset = updateListOffset + (i * sizeof(FileMemoryUpdate));
-    file.Seek(updateOffset, File::SeekOrigin::Begin);
-    file.WriteBytes(&dstUpdate, sizeof(FileMemoryUpdate));
-  }
-
-  return updateListOffset;
-}
-
-void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
-                                     std::vector<MemoryUpdate>& memUpdates, File::IOFile& file)
-{
-  memUpdates.resize(numUpdates);
-
-  for (u32 i = 0; i < numUpdates; ++i)
-  {
-    u64 updateOffset = fileOffset + (i * sizeof(FileMemoryUpdate));
-    file.Seek(updateOffset, File::SeekOrigin::Begin);
-    FileMemoryUpdate srcUpdate;
-    file.ReadBytes(&srcUpdate, sizeof(FileMemoryUpdate));
-
-    MemoryUpdate& dstUpdate = memUpdates[i];
-    dstUpdate.address = srcUpdate.address;
-    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
-    dstUpdate.data.resize(srcUpdate.dataSize);
-    dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
-
-    file.Seek(srcUpdate.dataOffset, File::SeekOrigin::Begin);
-    file.ReadBytes(dstUpdate.data.data(), srcUpdate.dataSize);
-  }
-}
@@ -4,17 +4,19 @@
 #pragma once
 
 #include <array>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 #include "VideoCommon/XFMemory.h"
 
-namespace File
-{
-class IOFile;
-}
+struct FileFrameInfo;
 
 struct MemoryUpdate
 {
@@ -72,27 +74,37 @@ public:
   u32 GetRamSizeReal() { return m_ram_size_real; }
   u32 GetExRamSizeReal() { return m_exram_size_real; }
 
+  // Only for files which are being recorded. Frames are compressed as they are added, which can
+  // be done from another thread than the one reading the file.
   void AddFrame(const FifoFrameInfo& frameInfo);
-  const FifoFrameInfo& GetFrame(u32 frame) const { return m_Frames[frame]; }
-  u32 GetFrameCount() const { return static_cast<u32>(m_Frames.size()); }
-  bool Save(const std::string& filename);
+  // The frames of a loaded file are read from it when they are requested, so a frame should only
+  // be held on to while it is used
+  std::shared_ptr<const FifoFrameInfo> GetFrame(u32 frame) const;
+  u32 GetFrameCount() const;
+  // Compressed files can't be read by versions of Dolphin from before the compression was added
+  bool Save(const std::string& filename, bool compress = false);
 
   static std::unique_ptr<FifoDataFile> Load(const std::string& filename, bool flagsOnly);
 
 private:
   enum
   {
-    FLAG_IS_WII = 1
+    FLAG_IS_WII = 1,
+    // Every frame is compressed on its own, so that they can still be read in any order
+    FLAG_COMPRESSED = 2,
   };
 
+  // How many of the most recently requested frames of a loaded file are kept around
+  static constexpr size_t FRAME_CACHE_SIZE = 4;
+
   void PadFile(size_t numBytes, File::IOFile& file);
 
   void SetFlag(u32 flag, bool set);
   bool GetFlag(u32 flag) const;
 
-  u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
-  static void ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
-                                std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
+  std::shared_ptr<const FifoFrameInfo> ReadFrame(u32 frame) const;
+  bool ReadFileFrame(u32 frame, FifoFrameInfo* dstFrame) const;
+  bool ReadFileData(u64 offset, u64 size, u8* out) const;
 
   std::array<u32, BP_MEM_SIZE> m_BPMem{};
   std::array<u32, CP_MEM_SIZE> m_CPMem{};
@@ -105,5 +117,18 @@ private:
   u32 m_Flags = 0;
   u32 m_Version = 0;
 
-  std::vector<FifoFrameInfo> m_Frames;
+  // The frames of a file which is being recorded, compressed like those of a compressed file
+  mutable std::mutex m_recorded_frames_mutex;
+  std::vector<FileFrameInfo> m_recorded_frames;
+  std::vector<std::vector<u8>> m_recorded_blocks;
+
+  // A loaded file is kept open, and mapped unless that fails
+  mutable File::IOFile m_file;
+  File::MappedFile m_mapped_file;
+  u64 m_file_size = 0;
+  mutable std::mutex m_file_mutex;
+  std::vector<FileFrameInfo> m_file_frames;
+
+  mutable std::mutex m_frame_cache_mutex;
+  mutable std::deque<std::pair<u32, std::shared_ptr<const FifoFrameInfo>>> m_frame_cache;
 };
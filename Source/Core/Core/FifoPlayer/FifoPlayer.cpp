@@ -11,9 +11,11 @@
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 #include "Common/MsgHandler.h"
+#include "Core/Config/GraphicsSettings.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
+#include "Core/FifoPlayer/FifoBenchmark.h"
 #include "Core/FifoPlayer/FifoDataFile.h"
 #include "Core/HW/CPU.h"
 #include "Core/HW/GPFifo.h"
@@ -82,7 +84,8 @@ void FifoPlaybackAnalyzer::AnalyzeFrames(FifoDataFile* file,
 
   for (u32 frame_no = 0; frame_no < file->GetFrameCount(); frame_no++)
   {
-    const FifoFrameInfo& frame = file->GetFrame(frame_no);
+    const std::shared_ptr<const FifoFrameInfo> frame_data = file->GetFrame(frame_no);
+    const FifoFrameInfo& frame = *frame_data;
     AnalyzedFrameInfo& analyzed = frame_info[frame_no];
 
     u32 offset = 0;
@@ -232,9 +235,27 @@ public:
 
     m_parent->m_CurrentFrame = m_parent->m_FrameRangeStart;
     m_parent->LoadMemory();
+
+    if (m_parent->m_benchmark_loops != 0)
+    {
+      m_parent->m_benchmark = std::make_unique<FifoBenchmark>(
+          std::move(m_parent->m_benchmark_output_path), m_parent->m_benchmark_loops);
+      m_parent->m_benchmark_loops = 0;
+      m_parent->m_benchmark_loop = 0;
+    }
   }
 
-  void Shutdown() override { IsPlayingBackFifologWithBrokenEFBCopies = false; }
+  void Shutdown() override
+  {
+    IsPlayingBackFifologWithBrokenEFBCopies = false;
+
+    // Also saves what was measured when the benchmark is stopped early
+    if (m_parent->m_benchmark)
+    {
+      m_parent->m_benchmark->Save();
+      m_parent->m_benchmark.reset();
+    }
+  }
   void ClearCache() override
   {
     // Nothing to clear.
@@ -279,8 +300,15 @@ CPU::State FifoPlayer::AdvanceFrame()
 {
   if (m_CurrentFrame > m_FrameRangeEnd)
   {
-    if (!m_Loop)
+    if (m_benchmark)
+    {
+      if (++m_benchmark_loop == m_benchmark->GetLoops())
+        return CPU::State::PowerDown;
+    }
+    else if (!m_Loop)
+    {
       return CPU::State::PowerDown;
+    }
 
     // When looping, reload the contents of all the BP/CP/CF registers.
     // This ensures that each time the first frame is played back, the state of the
@@ -297,7 +325,11 @@ CPU::State FifoPlayer::AdvanceFrame()
   if (m_EarlyMemoryUpdates && m_CurrentFrame == m_FrameRangeStart)
     WriteAllMemoryUpdates();
 
-  WriteFrame(m_File->GetFrame(m_CurrentFrame), m_FrameInfo[m_CurrentFrame]);
+  if (m_benchmark)
+    m_benchmark->BeginFrame(m_benchmark_loop, m_CurrentFrame);
+  WriteFrame(*m_File->GetFrame(m_CurrentFrame), m_FrameInfo[m_CurrentFrame]);
+  if (m_benchmark)
+    m_benchmark->EndFrame();
 
   ++m_CurrentFrame;
   return CPU::State::Running;
@@ -365,6 +397,16 @@ u32 FifoPlayer::GetCurrentFrameObjectCount() const
   return GetFrameObjectCount(m_CurrentFrame);
 }
 
+void FifoPlayer::SetBenchmark(u32 loops, std::string output_path)
+{
+  m_benchmark_loops = loops;
+  m_benchmark_output_path = std::move(output_path);
+
+  // Only for this run, which makes frames get written and presented as fast as possible
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+  Config::SetCurrent(Config::GFX_VSYNC, false);
+}
+
 void FifoPlayer::SetFrameRangeStart(u32 start)
 {
   if (m_File)
@@ -482,8 +524,8 @@ void FifoPlayer::WriteAllMemoryUpdates()
 
   for (u32 frameNum = 0; frameNum < m_File->GetFrameCount(); ++frameNum)
   {
-    const FifoFrameInfo& frame = m_File->GetFrame(frameNum);
-    for (auto& update : frame.memoryUpdates)
+    const std::shared_ptr<const FifoFrameInfo> frame = m_File->GetFrame(frameNum);
+    for (auto& update : frame->memoryUpdates)
     {
       WriteMemory(update);
     }
@@ -547,7 +589,8 @@ void FifoPlayer::SetupFifo()
   WriteCP(CommandProcessor::CTRL_REGISTER, 0);   // disable read, BP, interrupts
   WriteCP(CommandProcessor::CLEAR_REGISTER, 7);  // clear overflow, underflow, metrics
 
-  const FifoFrameInfo& frame = m_File->GetFrame(m_CurrentFrame);
+  const std::shared_ptr<const FifoFrameInfo> frame_data = m_File->GetFrame(m_CurrentFrame);
+  const FifoFrameInfo& frame = *frame_data;
 
   // Set fifo bounds
   WriteCP(CommandProcessor::FIFO_BASE_LO, frame.fifoStart);
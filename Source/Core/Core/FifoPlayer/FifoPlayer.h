@@ -16,6 +16,7 @@
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/OpcodeDecoding.h"
 
+class FifoBenchmark;
 class FifoDataFile;
 struct MemoryUpdate;
 
@@ -133,6 +134,11 @@ public:
   u32 GetObjectRangeEnd() const { return m_ObjectRangeEnd; }
   void SetObjectRangeEnd(u32 end) { m_ObjectRangeEnd = end; }
 
+  // Makes the next playback a benchmark, which plays the frame range the given number of times
+  // without a frame limit, stops, and writes the timing of every frame to output_path. Has to be
+  // called before the fifolog is booted.
+  void SetBenchmark(u32 loops, std::string output_path);
+
   // Callbacks
   void SetFileLoadedCallback(CallbackFunc callback);
   void SetFrameWrittenCallback(CallbackFunc callback) { m_FrameWrittenCb = std::move(callback); }
@@ -204,5 +210,10 @@ private:
 
   std::unique_ptr<FifoDataFile> m_File;
 
+  u32 m_benchmark_loops = 0;
+  std::string m_benchmark_output_path;
+  std::unique_ptr<FifoBenchmark> m_benchmark;
+  u32 m_benchmark_loop = 0;
+
   std::vector<AnalyzedFrameInfo> m_FrameInfo;
 };
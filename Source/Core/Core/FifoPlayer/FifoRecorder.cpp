@@ -5,6 +5,9 @@
 
 #include <algorithm>
 #include <cstring>
+#include <utility>
+
+#include <xxhash.h>
 
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
@@ -21,6 +24,12 @@
 #include "VideoCommon/XFMemory.h"
 #include "VideoCommon/XFStructs.h"
 
+// Memory is compared with the recorded copy of it in pages. A whole page is compared by its hash,
+// which saves reading the copy, and only the pages of a range that changed are recorded.
+constexpr u32 MEMORY_PAGE_SIZE = 0x1000;
+// The hash of a page whose copy was changed without hashing it
+constexpr u64 UNKNOWN_PAGE_HASH = 0;
+
 class FifoRecorder::FifoRecordAnalyzer : public OpcodeDecoder::Callback
 {
 public:
@@ -216,12 +225,22 @@ FifoRecorder::FifoRecorder(Core::System& system) : m_system(system)
 {
 }
 
-FifoRecorder::~FifoRecorder() = default;
+FifoRecorder::~FifoRecorder()
+{
+  m_frame_thread.Shutdown();
+}
 
 void FifoRecorder::StartRecording(s32 numFrames, CallbackFunc finishedCb)
 {
   std::lock_guard lk(m_mutex);
 
+  // Finishes the frames of the previous recording before its file is replaced
+  m_frame_thread.Reset("FIFO Recorder", [this](RecordedFrame recorded) {
+    m_File->AddFrame(recorded.frame);
+    if (recorded.is_last && m_FinishedCb)
+      m_FinishedCb();
+  });
+
   m_File = std::make_unique<FifoDataFile>();
 
   // TODO: This, ideally, would be deallocated when done recording.
@@ -242,6 +261,10 @@ void FifoRecorder::StartRecording(s32 numFrames, CallbackFunc finishedCb)
 
   std::fill(m_Ram.begin(), m_Ram.end(), 0);
   std::fill(m_ExRam.begin(), m_ExRam.end(), 0);
+  m_RamPageHashes.assign((m_Ram.size() + MEMORY_PAGE_SIZE - 1) / MEMORY_PAGE_SIZE,
+                         UNKNOWN_PAGE_HASH);
+  m_ExRamPageHashes.assign((m_ExRam.size() + MEMORY_PAGE_SIZE - 1) / MEMORY_PAGE_SIZE,
+                           UNKNOWN_PAGE_HASH);
 
   m_File->SetIsWii(m_system.IsWii());
 
@@ -333,20 +356,18 @@ void FifoRecorder::WriteGPCommand(const u8* data, u32 size)
 
   if (m_FrameEnded && !m_FifoData.empty())
   {
-    m_CurrentFrame.fifoData = m_FifoData;
+    m_CurrentFrame.fifoData = std::move(m_FifoData);
 
+    bool is_last;
     {
       std::lock_guard lk(m_mutex);
-
-      // Copy frame to file
-      // The file will be responsible for freeing the memory allocated for each frame's fifoData
-      m_File->AddFrame(m_CurrentFrame);
-
-      if (m_FinishedCb && m_RequestedRecordingEnd)
-        m_FinishedCb();
+      is_last = m_RequestedRecordingEnd;
     }
 
-    m_CurrentFrame.memoryUpdates.clear();
+    // The frame is compressed into the file on the frame thread
+    m_frame_thread.Push(RecordedFrame{std::move(m_CurrentFrame), is_last});
+
+    m_CurrentFrame = {};
     m_FifoData.clear();
     m_FrameEnded = false;
   }
@@ -359,37 +380,81 @@ void FifoRecorder::UseMemory(u32 address, u32 size, MemoryUpdate::Type type, boo
   auto& memory = m_system.GetMemory();
 
   u8* curData;
-  u8* newData;
+  const u8* newData;
+  u64* pageHashes;
+  u32 offset;
   if (address & 0x10000000)
   {
-    curData = &m_ExRam[address & memory.GetExRamMask()];
-    newData = &memory.GetEXRAM()[address & memory.GetExRamMask()];
+    offset = address & memory.GetExRamMask();
+    size = std::min<u32>(size, static_cast<u32>(m_ExRam.size()) - offset);
+    curData = m_ExRam.data();
+    newData = memory.GetEXRAM();
+    pageHashes = m_ExRamPageHashes.data();
   }
   else
   {
-    curData = &m_Ram[address & memory.GetRamMask()];
-    newData = &memory.GetRAM()[address & memory.GetRamMask()];
+    offset = address & memory.GetRamMask();
+    size = std::min<u32>(size, static_cast<u32>(m_Ram.size()) - offset);
+    curData = m_Ram.data();
+    newData = memory.GetRAM();
+    pageHashes = m_RamPageHashes.data();
   }
 
-  if (!dynamicUpdate && memcmp(curData, newData, size) != 0)
+  // Consecutive pages which changed are recorded as one memory update
+  MemoryUpdate* memUpdate = nullptr;
+
+  const u32 end = offset + size;
+  for (u32 start = offset; start < end;)
   {
-    // Update current memory
-    memcpy(curData, newData, size);
+    const u32 page = start / MEMORY_PAGE_SIZE;
+    const u32 pageEnd = std::min(end, (page + 1) * MEMORY_PAGE_SIZE);
+    const u32 length = pageEnd - start;
+
+    bool changed;
+    if (dynamicUpdate)
+    {
+      // Shadow the data so it won't be recorded as changed by a future UseMemory
+      changed = true;
+    }
+    else if (length == MEMORY_PAGE_SIZE)
+    {
+      const u64 hash = XXH3_64bits(newData + start, MEMORY_PAGE_SIZE);
+      changed = hash != pageHashes[page] &&
+                (pageHashes[page] != UNKNOWN_PAGE_HASH ||
+                 memcmp(curData + start, newData + start, MEMORY_PAGE_SIZE) != 0);
+      pageHashes[page] = hash;
+    }
+    else
+    {
+      changed = memcmp(curData + start, newData + start, length) != 0;
+    }
+
+    if (changed)
+    {
+      // Update current memory
+      memcpy(curData + start, newData + start, length);
+      if (length != MEMORY_PAGE_SIZE || dynamicUpdate)
+        pageHashes[page] = UNKNOWN_PAGE_HASH;
+    }
+
+    if (!changed || dynamicUpdate)
+    {
+      memUpdate = nullptr;
+      start = pageEnd;
+      continue;
+    }
 
     // Record memory update
-    MemoryUpdate memUpdate;
-    memUpdate.address = address;
-    memUpdate.fifoPosition = (u32)(m_FifoData.size());
-    memUpdate.type = type;
-    memUpdate.data.resize(size);
-    std::copy(newData, newData + size, memUpdate.data.begin());
-
-    m_CurrentFrame.memoryUpdates.push_back(std::move(memUpdate));
-  }
-  else if (dynamicUpdate)
-  {
-    // Shadow the data so it won't be recorded as changed by a future UseMemory
-    memcpy(curData, newData, size);
+    if (!memUpdate)
+    {
+      memUpdate = &m_CurrentFrame.memoryUpdates.emplace_back();
+      memUpdate->address = address + (start - offset);
+      memUpdate->fifoPosition = static_cast<u32>(m_FifoData.size());
+      memUpdate->type = type;
+    }
+    memUpdate->data.insert(memUpdate->data.end(), newData + start, newData + pageEnd);
+
+    start = pageEnd;
   }
 }
 
@@ -10,6 +10,7 @@
 
 #include "Common/Assert.h"
 #include "Common/HookableEvent.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/FifoPlayer/FifoDataFile.h"
 
 namespace Core
@@ -60,6 +61,12 @@ public:
 private:
   class FifoRecordAnalyzer;
 
+  struct RecordedFrame
+  {
+    FifoFrameInfo frame;
+    bool is_last;
+  };
+
   void RecordInitialVideoMemory();
 
   // Accessed from both GUI and video threads
@@ -82,8 +89,15 @@ private:
   FifoFrameInfo m_CurrentFrame;
   std::unique_ptr<FifoRecordAnalyzer> m_record_analyzer;
   std::vector<u8> m_FifoData;
+  // The memory as of the last memory update that was recorded for it, and a hash of each of its
+  // pages if it's known to match the emulated memory
   std::vector<u8> m_Ram;
   std::vector<u8> m_ExRam;
+  std::vector<u64> m_RamPageHashes;
+  std::vector<u64> m_ExRamPageHashes;
+
+  // Compresses the finished frames into m_File, so that the video thread doesn't have to wait
+  Common::WorkQueueThread<RecordedFrame> m_frame_thread;
 
   Common::EventHook m_end_of_frame_event;
 
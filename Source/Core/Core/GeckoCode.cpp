@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <iterator>
 #include <mutex>
+#include <optional>
 #include <tuple>
 #include <vector>
 
@@ -18,6 +19,7 @@
 #include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PPCCache.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
 
@@ -64,8 +66,409 @@ static Installation s_code_handler_installed = Installation::Uninstalled;
 // the currently active codes
 static std::vector<GeckoCode> s_active_codes;
 static std::vector<GeckoCode> s_synced_codes;
+// The active codes split into the ones which are run natively and the ones which need the guest
+// code handler
+static std::vector<GeckoCode> s_native_codes;
+static std::vector<GeckoCode> s_handler_codes;
 static std::mutex s_active_codes_lock;
 
+static constexpr u32 DEFAULT_BASE_ADDRESS = 0x80000000;
+
+// Code types, with the pointer flag (0x10) and the address bit (0x01) of the first byte cleared.
+// Types 0xC0 and above don't have the flags and use the whole first byte.
+enum CodeType : u8
+{
+  CODE_WRITE_8 = 0x00,
+  CODE_WRITE_16 = 0x02,
+  CODE_WRITE_32 = 0x04,
+  CODE_WRITE_STRING = 0x06,
+  CODE_WRITE_SERIAL = 0x08,
+  CODE_IF_EQUAL_32 = 0x20,
+  CODE_IF_NOT_EQUAL_32 = 0x22,
+  CODE_IF_GREATER_32 = 0x24,
+  CODE_IF_LESS_32 = 0x26,
+  CODE_IF_EQUAL_16 = 0x28,
+  CODE_IF_NOT_EQUAL_16 = 0x2A,
+  CODE_IF_GREATER_16 = 0x2C,
+  CODE_IF_LESS_16 = 0x2E,
+  CODE_LOAD_BA = 0x40,
+  CODE_SET_BA = 0x42,
+  CODE_STORE_BA = 0x44,
+  CODE_LOAD_PO = 0x48,
+  CODE_SET_PO = 0x4A,
+  CODE_STORE_PO = 0x4C,
+  CODE_IF_BA_IN_RANGE = 0xCE,
+  CODE_IF_PO_IN_RANGE = 0xDE,
+  CODE_FULL_TERMINATOR = 0xE0,
+  CODE_ENDIF = 0xE2,
+  CODE_END_OF_LIST = 0xF0,
+};
+
+static u8 GetCodeType(const GeckoCode::Code& code)
+{
+  const u8 first_byte = static_cast<u8>(code.address >> 24);
+  return first_byte >= 0xC0 ? first_byte : first_byte & 0xEE;
+}
+
+static bool UsesPointer(const GeckoCode::Code& code)
+{
+  return (code.address & 0x10000000) != 0;
+}
+
+// Returns how many lines of the code list the code starting at the given line takes up
+static size_t GetCodeLength(std::span<const GeckoCode::Code> codes, size_t index)
+{
+  switch (GetCodeType(codes[index]))
+  {
+  case CODE_WRITE_STRING:
+    return 1 + (static_cast<size_t>(codes[index].data) + CODE_SIZE - 1) / CODE_SIZE;
+  case CODE_WRITE_SERIAL:
+    return 2;
+  default:
+    return 1;
+  }
+}
+
+// Codes which branch to or run guest code, use the code list's own address, or use gecko
+// registers are left to the guest code handler.
+static bool CanRunNatively(const GeckoCode& gecko_code)
+{
+  const std::span<const GeckoCode::Code> codes = gecko_code.codes;
+  for (size_t i = 0; i < codes.size(); i += GetCodeLength(codes, i))
+  {
+    if (GetCodeLength(codes, i) > codes.size() - i)
+      return false;
+
+    const GeckoCode::Code& code = codes[i];
+    switch (GetCodeType(code))
+    {
+    case CODE_WRITE_SERIAL:
+      // 8, 16 and 32 bit writes
+      if ((codes[i + 1].address >> 28) > 2)
+        return false;
+      break;
+    case CODE_WRITE_8:
+    case CODE_WRITE_16:
+    case CODE_WRITE_32:
+    case CODE_WRITE_STRING:
+    case CODE_IF_EQUAL_32:
+    case CODE_IF_NOT_EQUAL_32:
+    case CODE_IF_GREATER_32:
+    case CODE_IF_LESS_32:
+    case CODE_IF_EQUAL_16:
+    case CODE_IF_NOT_EQUAL_16:
+    case CODE_IF_GREATER_16:
+    case CODE_IF_LESS_16:
+    case CODE_IF_BA_IN_RANGE:
+    case CODE_IF_PO_IN_RANGE:
+    case CODE_FULL_TERMINATOR:
+    case CODE_ENDIF:
+      break;
+    case CODE_LOAD_BA:
+    case CODE_SET_BA:
+    case CODE_STORE_BA:
+    case CODE_LOAD_PO:
+    case CODE_SET_PO:
+    case CODE_STORE_PO:
+      // Only adding ba or po, but not a gecko register, to the address is supported
+      if ((code.address & 0x0000F00F) != 0 || ((code.address >> 16) & 0xF) > 1)
+        return false;
+      break;
+    default:
+      return false;
+    }
+  }
+  return true;
+}
+
+// Requires s_active_codes_lock
+static void SplitActiveCodesLocked()
+{
+  s_native_codes.clear();
+  s_handler_codes.clear();
+  for (const GeckoCode& code : s_active_codes)
+    (CanRunNatively(code) ? s_native_codes : s_handler_codes).push_back(code);
+}
+
+namespace
+{
+// Runs codes directly at the frame boundary, the way codehandler.bin would run them.
+// Unlike the code handler, this doesn't need any emulated CPU time, and it only invalidates the
+// instruction cache for writes which actually change memory.
+class NativeCodeRunner
+{
+public:
+  explicit NativeCodeRunner(const Core::CPUThreadGuard& guard) : m_guard(guard) {}
+
+  // Returns false once the end of the code list is reached
+  bool Run(std::span<const GeckoCode::Code> codes)
+  {
+    for (size_t i = 0; i < codes.size(); i += GetCodeLength(codes, i))
+    {
+      if (!RunCode(codes, i))
+        return false;
+    }
+    return true;
+  }
+
+private:
+  bool IsExecuting() const { return (m_execution_status & 1) == 0; }
+
+  u32 GetAddress(const GeckoCode::Code& code) const
+  {
+    return (UsesPointer(code) ? m_pointer : m_base_address) + (code.address & 0x01FFFFFF);
+  }
+
+  void PushCondition(bool condition)
+  {
+    m_execution_status = (m_execution_status << 1) | (IsExecuting() && condition ? 0 : 1);
+  }
+
+  void SetAddressesIfNonZero(u32 data)
+  {
+    if ((data & 0xFFFF0000) != 0)
+      m_base_address = data & 0xFFFF0000;
+    if ((data & 0x0000FFFF) != 0)
+      m_pointer = data << 16;
+  }
+
+  u32 Read32(u32 address) const
+  {
+    const auto result = PowerPC::MMU::HostTryReadU32(m_guard, address);
+    return result ? result->value : 0;
+  }
+
+  u16 Read16(u32 address) const
+  {
+    const auto result = PowerPC::MMU::HostTryReadU16(m_guard, address);
+    return result ? result->value : 0;
+  }
+
+  void Write(u32 address, u32 value, u32 size)
+  {
+    // Most codes write the same values every frame, so the instruction cache is only invalidated
+    // when the value changes.
+    std::optional<u32> old_value;
+    bool written = false;
+    switch (size)
+    {
+    case 1:
+      if (const auto result = PowerPC::MMU::HostTryReadU8(m_guard, address))
+        old_value = result->value;
+      if (old_value && *old_value != (value & 0xFF))
+        written = PowerPC::MMU::HostTryWriteU8(m_guard, value, address).has_value();
+      break;
+    case 2:
+      if (const auto result = PowerPC::MMU::HostTryReadU16(m_guard, address))
+        old_value = result->value;
+      if (old_value && *old_value != (value & 0xFFFF))
+        written = PowerPC::MMU::HostTryWriteU16(m_guard, value, address).has_value();
+      break;
+    default:
+      if (const auto result = PowerPC::MMU::HostTryReadU32(m_guard, address))
+        old_value = result->value;
+      if (old_value && *old_value != value)
+        written = PowerPC::MMU::HostTryWriteU32(m_guard, value, address).has_value();
+      break;
+    }
+
+    if (written)
+    {
+      auto& system = m_guard.GetSystem();
+      system.GetPPCState().iCache.Invalidate(system.GetMemory(), system.GetJitInterface(),
+                                             address);
+    }
+  }
+
+  bool RunCode(std::span<const GeckoCode::Code> codes, size_t index)
+  {
+    const GeckoCode::Code& code = codes[index];
+    const u8 type = GetCodeType(code);
+
+    // Conditionals and terminators are looked at even if the code isn't executing, since they
+    // change the execution status.
+    switch (type)
+    {
+    case CODE_IF_EQUAL_32:
+    case CODE_IF_NOT_EQUAL_32:
+    case CODE_IF_GREATER_32:
+    case CODE_IF_LESS_32:
+    case CODE_IF_EQUAL_16:
+    case CODE_IF_NOT_EQUAL_16:
+    case CODE_IF_GREATER_16:
+    case CODE_IF_LESS_16:
+    {
+      // The lowest address bit applies an endif first
+      if (code.address & 1)
+        m_execution_status >>= 1;
+      if (!IsExecuting())
+      {
+        PushCondition(false);
+        return true;
+      }
+
+      const u32 address = GetAddress(code) & ~1U;
+      bool condition;
+      if (type < CODE_IF_EQUAL_16)
+      {
+        const u32 value = Read32(address);
+        if (type == CODE_IF_EQUAL_32)
+          condition = value == code.data;
+        else if (type == CODE_IF_NOT_EQUAL_32)
+          condition = value != code.data;
+        else if (type == CODE_IF_GREATER_32)
+          condition = value > code.data;
+        else
+          condition = value < code.data;
+      }
+      else
+      {
+        const u16 mask = static_cast<u16>(code.data >> 16);
+        const u16 value = Read16(address) & ~mask;
+        const u16 comparand = static_cast<u16>(code.data);
+        if (type == CODE_IF_EQUAL_16)
+          condition = value == comparand;
+        else if (type == CODE_IF_NOT_EQUAL_16)
+          condition = value != comparand;
+        else if (type == CODE_IF_GREATER_16)
+          condition = value > comparand;
+        else
+          condition = value < comparand;
+      }
+      PushCondition(condition);
+      return true;
+    }
+    case CODE_IF_BA_IN_RANGE:
+    case CODE_IF_PO_IN_RANGE:
+    {
+      if (code.address & 1)
+        m_execution_status >>= 1;
+      const u32 value = type == CODE_IF_PO_IN_RANGE ? m_pointer : m_base_address;
+      PushCondition(value >= (code.data & 0xFFFF0000) && value < (code.data << 16));
+      return true;
+    }
+    case CODE_FULL_TERMINATOR:
+      m_execution_status = 0;
+      SetAddressesIfNonZero(code.data);
+      return true;
+    case CODE_ENDIF:
+    {
+      const u32 endif_count = code.address & 0xFF;
+      m_execution_status = endif_count < 32 ? m_execution_status >> endif_count : 0;
+      // Else: invert the condition of the current level, unless the level around it is false
+      if ((code.address & 0x00100000) && (m_execution_status & 2) == 0)
+        m_execution_status ^= 1;
+      SetAddressesIfNonZero(code.data);
+      return true;
+    }
+    case CODE_END_OF_LIST:
+      return false;
+    default:
+      break;
+    }
+
+    if (!IsExecuting())
+      return true;
+
+    switch (type)
+    {
+    case CODE_WRITE_8:
+    {
+      const u32 address = GetAddress(code);
+      const u32 count = (code.data >> 16) + 1;
+      for (u32 i = 0; i < count; ++i)
+        Write(address + i, code.data & 0xFF, 1);
+      break;
+    }
+    case CODE_WRITE_16:
+    {
+      const u32 address = GetAddress(code);
+      const u32 count = (code.data >> 16) + 1;
+      for (u32 i = 0; i < count; ++i)
+        Write(address + i * 2, code.data & 0xFFFF, 2);
+      break;
+    }
+    case CODE_WRITE_32:
+      Write(GetAddress(code), code.data, 4);
+      break;
+    case CODE_WRITE_STRING:
+    {
+      const u32 address = GetAddress(code);
+      for (u32 i = 0; i < code.data; ++i)
+      {
+        const GeckoCode::Code& line = codes[index + 1 + i / CODE_SIZE];
+        const u32 word = (i % CODE_SIZE) < 4 ? line.address : line.data;
+        Write(address + i, word >> (24 - (i % 4) * 8), 1);
+      }
+      break;
+    }
+    case CODE_WRITE_SERIAL:
+    {
+      const GeckoCode::Code& parameters = codes[index + 1];
+      const u32 size = 1u << (parameters.address >> 28);
+      const u32 count = ((parameters.address >> 16) & 0xFFF) + 1;
+      const u32 address_increment = parameters.address & 0xFFFF;
+      u32 address = GetAddress(code);
+      u32 value = code.data;
+      for (u32 i = 0; i < count; ++i)
+      {
+        Write(address, value, size);
+        address += address_increment;
+        value += parameters.data;
+      }
+      break;
+    }
+    case CODE_LOAD_BA:
+    case CODE_SET_BA:
+    case CODE_STORE_BA:
+    case CODE_LOAD_PO:
+    case CODE_SET_PO:
+    case CODE_STORE_PO:
+    {
+      // 40TY000N XXXXXXXX: T = 1 adds to ba/po instead of setting it, Y = 1 adds ba (for 4x) or
+      // po (for 5x) to X
+      u32 address = code.data;
+      if (((code.address >> 16) & 0xF) == 1)
+        address += UsesPointer(code) ? m_pointer : m_base_address;
+
+      const bool is_po = type >= CODE_LOAD_PO;
+      u32& target = is_po ? m_pointer : m_base_address;
+      if (type == CODE_STORE_BA || type == CODE_STORE_PO)
+      {
+        Write(address, target, 4);
+        break;
+      }
+
+      const u32 value = type == CODE_LOAD_BA || type == CODE_LOAD_PO ? Read32(address) : address;
+      target = (code.address & 0x00100000) ? target + value : value;
+      break;
+    }
+    default:
+      break;
+    }
+    return true;
+  }
+
+  const Core::CPUThreadGuard& m_guard;
+  u32 m_base_address = DEFAULT_BASE_ADDRESS;
+  u32 m_pointer = DEFAULT_BASE_ADDRESS;
+  // One bit per nested conditional, where a set bit means the codes of that level are skipped
+  u32 m_execution_status = 0;
+};
+}  // namespace
+
+// Requires s_active_codes_lock
+static void RunNativeCodesLocked(const Core::CPUThreadGuard& guard)
+{
+  // Like in the code list of the code handler, the state carries over from one code to the next.
+  NativeCodeRunner runner(guard);
+  for (const GeckoCode& code : s_native_codes)
+  {
+    if (!runner.Run(code.codes))
+      break;
+  }
+}
+
 void SetActiveCodes(std::span<const GeckoCode> gcodes)
 {
   std::lock_guard lk(s_active_codes_lock);
@@ -78,6 +481,7 @@ void SetActiveCodes(std::span<const GeckoCode> gcodes)
                  [](const GeckoCode& code) { return code.enabled; });
   }
   s_active_codes.shrink_to_fit();
+  SplitActiveCodesLocked();
 
   s_code_handler_installed = Installation::Uninstalled;
 }
@@ -87,6 +491,7 @@ void SetSyncedCodesAsActive()
   s_active_codes.clear();
   s_active_codes.reserve(s_synced_codes.size());
   s_active_codes = s_synced_codes;
+  SplitActiveCodesLocked();
 }
 
 void UpdateSyncedCodes(std::span<const GeckoCode> gcodes)
@@ -110,6 +515,7 @@ std::vector<GeckoCode> SetAndReturnActiveCodes(std::span<const GeckoCode> gcodes
                  [](const GeckoCode& code) { return code.enabled; });
   }
   s_active_codes.shrink_to_fit();
+  SplitActiveCodesLocked();
 
   s_code_handler_installed = Installation::Uninstalled;
 
@@ -173,8 +579,8 @@ static Installation InstallCodeHandlerLocked(const Core::CPUThreadGuard& guard)
   const u32 end_address = codelist_end_address - CODE_SIZE;
   u32 next_address = start_address;
 
-  // NOTE: Only active codes are in the list
-  for (const GeckoCode& active_code : s_active_codes)
+  // NOTE: Only active codes which can't be run natively are in the list
+  for (const GeckoCode& active_code : s_handler_codes)
   {
     // If the code is not going to fit in the space we have left then we have to skip it
     if (next_address + active_code.codes.size() * CODE_SIZE > end_address)
@@ -233,6 +639,8 @@ void Shutdown()
 {
   std::lock_guard codes_lock(s_active_codes_lock);
   s_active_codes.clear();
+  s_native_codes.clear();
+  s_handler_codes.clear();
   s_code_handler_installed = Installation::Uninstalled;
 }
 
@@ -244,11 +652,17 @@ void RunCodeHandler(const Core::CPUThreadGuard& guard)
   // NOTE: Need to release the lock because of GUI deadlocks with PanicAlert in HostWrite_*
   {
     std::lock_guard codes_lock(s_active_codes_lock);
+
+    // This only uses the HostTry* functions, which don't raise alerts.
+    RunNativeCodesLocked(guard);
+    if (s_handler_codes.empty())
+      return;
+
     if (s_code_handler_installed != Installation::Installed)
     {
       // Don't spam retry if the install failed. The corrupt / missing disk file is not likely to be
       // fixed within 1 frame of the last error.
-      if (s_active_codes.empty() || s_code_handler_installed == Installation::Failed)
+      if (s_code_handler_installed == Installation::Failed)
         return;
       s_code_handler_installed = InstallCodeHandlerLocked(guard);
 
@@ -13,6 +13,7 @@
 #include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/GeckoCode.h"
+#include "Core/HLE/HLE_Libc.h"
 #include "Core/HLE/HLE_Misc.h"
 #include "Core/HLE/HLE_OS.h"
 #include "Core/HW/Memmap.h"
@@ -21,13 +22,15 @@
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
 
+#include "VideoCommon/PerformanceMetrics.h"
+
 namespace HLE
 {
 // Map addresses to the HLE hook index
 static std::map<u32, u32> s_hooked_addresses;
 
 // clang-format off
-constexpr std::array<Hook, 23> os_patches{{
+constexpr std::array<Hook, 27> os_patches{{
     // Placeholder, os_patches[0] is the "non-existent function" index
     {"FAKE_TO_SKIP_0",               HLE_Misc::UnimplementedFunction,       HookType::Replace, HookFlag::Generic},
 
@@ -57,6 +60,12 @@ constexpr std::array<Hook, 23> os_patches{{
     {"___blank",                     HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,   HookFlag::Debug}, // used for early init things (normally)
     {"__write_console",              HLE_OS::HLE_write_console,             HookType::Start,   HookFlag::Debug}, // used by sysmenu (+more?)
 
+    // C library
+    {"memcpy",                       HLE_Libc::HLE_memmove,                 HookType::Replace, HookFlag::Generic},
+    {"memmove",                      HLE_Libc::HLE_memmove,                 HookType::Replace, HookFlag::Generic},
+    {"memset",                       HLE_Libc::HLE_memset,                  HookType::Replace, HookFlag::Generic},
+    {"strlen",                       HLE_Libc::HLE_strlen,                  HookType::Replace, HookFlag::Generic},
+
     {"GeckoCodehandler",             HLE_Misc::GeckoCodeHandlerICacheFlush, HookType::Start,   HookFlag::Fixed},
     {"GeckoHandlerReturnTrampoline", HLE_Misc::GeckoReturnTrampoline,       HookType::Replace, HookFlag::Fixed},
     {"AppLoaderReport",              HLE_OS::HLE_GeneralDebugPrint,         HookType::Start,   HookFlag::Fixed} // apploader needs OSReport-like function
@@ -163,6 +172,8 @@ void Execute(const Core::CPUThreadGuard& guard, u32 current_pc, u32 hook_index)
   hook_index &= 0xFFFFF;
   if (hook_index > 0 && hook_index < os_patches.size())
   {
+    PerformanceMetrics::ScopedFrameSection frame_section(
+        PerformanceMetrics::FrameSection::HLE);
     os_patches[hook_index].function(guard);
   }
   else
@@ -0,0 +1,156 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HLE/HLE_Libc.h"
+
+#include <algorithm>
+#include <array>
+#include <span>
+
+#include "Common/CommonTypes.h"
+#include "Core/Core.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+namespace HLE_Libc
+{
+namespace
+{
+// The size of the pieces that memmove copies through a buffer.
+constexpr u32 COPY_CHUNK_SIZE = 0x1000;
+
+// Returns the host memory backing the guest memory at the address, or an empty span if it has to be
+// accessed through HostRead and HostWrite. That is the case for anything but plain RAM, and for
+// everything when the data cache is emulated.
+std::span<u8> GetPageSpan(const Core::CPUThreadGuard& guard, u32 address)
+{
+  if (guard.GetSystem().GetPPCState().m_enable_dcache)
+    return {};
+  return PowerPC::MMU::HostGetWritablePageSpan(guard, address);
+}
+
+void ReadGuestMemory(const Core::CPUThreadGuard& guard, u32 address, std::span<u8> buffer)
+{
+  size_t done = 0;
+  while (done < buffer.size())
+  {
+    const u32 current_address = address + static_cast<u32>(done);
+    const std::span<const u8> page = GetPageSpan(guard, current_address);
+    if (page.empty())
+    {
+      buffer[done++] = PowerPC::MMU::HostRead_U8(guard, current_address);
+      continue;
+    }
+
+    const size_t size = std::min(page.size(), buffer.size() - done);
+    std::copy_n(page.begin(), size, buffer.begin() + done);
+    done += size;
+  }
+}
+
+void WriteGuestMemory(const Core::CPUThreadGuard& guard, u32 address, std::span<const u8> buffer)
+{
+  size_t done = 0;
+  while (done < buffer.size())
+  {
+    const u32 current_address = address + static_cast<u32>(done);
+    const std::span<u8> page = GetPageSpan(guard, current_address);
+    if (page.empty())
+    {
+      PowerPC::MMU::HostWrite_U8(guard, buffer[done++], current_address);
+      continue;
+    }
+
+    const size_t size = std::min(page.size(), buffer.size() - done);
+    std::copy_n(buffer.begin() + done, size, page.begin());
+    done += size;
+  }
+}
+
+void Return(PowerPC::PowerPCState& ppc_state, u32 value)
+{
+  ppc_state.gpr[3] = value;
+  ppc_state.npc = LR(ppc_state);
+}
+}  // namespace
+
+// void* memmove(void* dst, const void* src, size_t n)
+void HLE_memmove(const Core::CPUThreadGuard& guard)
+{
+  auto& ppc_state = guard.GetSystem().GetPPCState();
+  const u32 dst = ppc_state.gpr[3];
+  const u32 src = ppc_state.gpr[4];
+  const u32 n = ppc_state.gpr[5];
+
+  // Copy the chunks starting from the end if the start of the destination overlaps the source.
+  const bool backwards = dst - src < n;
+  std::array<u8, COPY_CHUNK_SIZE> buffer;
+  for (u32 done = 0; done < n;)
+  {
+    const u32 size = std::min(COPY_CHUNK_SIZE, n - done);
+    const u32 offset = backwards ? n - done - size : done;
+    const std::span<u8> chunk(buffer.data(), size);
+    ReadGuestMemory(guard, src + offset, chunk);
+    WriteGuestMemory(guard, dst + offset, chunk);
+    done += size;
+  }
+
+  Return(ppc_state, dst);
+}
+
+// void* memset(void* dst, int value, size_t n)
+void HLE_memset(const Core::CPUThreadGuard& guard)
+{
+  auto& ppc_state = guard.GetSystem().GetPPCState();
+  const u32 dst = ppc_state.gpr[3];
+  const u8 value = static_cast<u8>(ppc_state.gpr[4]);
+  const u32 n = ppc_state.gpr[5];
+
+  for (u32 done = 0; done < n;)
+  {
+    const u32 current_address = dst + done;
+    const std::span<u8> page = GetPageSpan(guard, current_address);
+    if (page.empty())
+    {
+      PowerPC::MMU::HostWrite_U8(guard, value, current_address);
+      ++done;
+      continue;
+    }
+
+    const u32 size = static_cast<u32>(std::min<size_t>(page.size(), n - done));
+    std::fill_n(page.begin(), size, value);
+    done += size;
+  }
+
+  Return(ppc_state, dst);
+}
+
+// size_t strlen(const char* str)
+void HLE_strlen(const Core::CPUThreadGuard& guard)
+{
+  auto& ppc_state = guard.GetSystem().GetPPCState();
+  const u32 str = ppc_state.gpr[3];
+
+  u32 length = 0;
+  while (true)
+  {
+    const u32 current_address = str + length;
+    const std::span<const u8> page = GetPageSpan(guard, current_address);
+    if (page.empty())
+    {
+      if (PowerPC::MMU::HostRead_U8(guard, current_address) == 0)
+        break;
+      ++length;
+      continue;
+    }
+
+    const auto terminator = std::find(page.begin(), page.end(), u8(0));
+    length += static_cast<u32>(terminator - page.begin());
+    if (terminator != page.end())
+      break;
+  }
+
+  Return(ppc_state, length);
+}
+}  // namespace HLE_Libc
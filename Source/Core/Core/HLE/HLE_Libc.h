@@ -0,0 +1,20 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+namespace Core
+{
+class CPUThreadGuard;
+};
+
+// Native replacements for memory and string functions of the guest's C library, which games
+// spend a lot of time in. Only the time the guest code would have taken is lost.
+namespace HLE_Libc
+{
+// Also used for memcpy, whose result only differs from memmove's for overlapping ranges. Those are
+// undefined behavior for memcpy, so games can't rely on them.
+void HLE_memmove(const Core::CPUThreadGuard& guard);
+void HLE_memset(const Core::CPUThreadGuard& guard);
+void HLE_strlen(const Core::CPUThreadGuard& guard);
+}  // namespace HLE_Libc
@@ -23,7 +23,9 @@
 
 #include "Core/HW/DSP.h"
 
+#include <algorithm>
 #include <memory>
+#include <span>
 
 #include "AudioCommon/AudioCommon.h"
 
@@ -79,7 +81,7 @@ constexpr int DSP_MAIL_SLICE = 72;
 void DSPManager::DoState(PointerWrap& p)
 {
   if (!m_aram.wii_mode)
-    p.DoArray(m_aram.ptr, m_aram.size);
+    p.DoArrayByReference(m_aram.ptr, m_aram.size);
   p.Do(m_dsp_control);
   p.Do(m_audio_dma);
   p.Do(m_aram_dma);
@@ -464,7 +466,15 @@ void DSPManager::Do_ARAM_DMA()
   int ticksToTransfer = (m_aram_dma.Cnt.count / 32) * 246;
   core_timing.ScheduleEvent(ticksToTransfer, m_event_type_complete_aram);
 
-  // Real hardware DMAs in 32byte chunks, but we can get by with 8byte chunks
+  const auto advance = [this](u32 length) {
+    m_aram_dma.MMAddr += length;
+    m_aram_dma.ARAddr += length;
+    m_aram_dma.Cnt.count -= length;
+  };
+
+  // Real hardware DMAs in 32byte chunks, but as nothing can observe the transfer until it has
+  // completed, we copy as much as possible at once. A transfer is only split where it wraps around
+  // the end of ARAM.
   if (m_aram_dma.Cnt.dir)
   {
     // ARAM -> MRAM
@@ -478,29 +488,13 @@ void DSPManager::Do_ARAM_DMA()
 
     if (m_aram_dma.ARAddr < m_aram.size)
     {
+      // The ARAM memory map set up by m_aram_info doesn't affect reads
       while (m_aram_dma.Cnt.count)
       {
-        // These are logically separated in code to show that a memory map has been set up
-        // See below in the write section for more information
-        if ((m_aram_info.Hex & 0xf) == 3)
-        {
-          memory.Write_U64_Swap(*(u64*)&m_aram.ptr[m_aram_dma.ARAddr & m_aram.mask],
-                                m_aram_dma.MMAddr);
-        }
-        else if ((m_aram_info.Hex & 0xf) == 4)
-        {
-          memory.Write_U64_Swap(*(u64*)&m_aram.ptr[m_aram_dma.ARAddr & m_aram.mask],
-                                m_aram_dma.MMAddr);
-        }
-        else
-        {
-          memory.Write_U64_Swap(*(u64*)&m_aram.ptr[m_aram_dma.ARAddr & m_aram.mask],
-                                m_aram_dma.MMAddr);
-        }
-
-        m_aram_dma.MMAddr += 8;
-        m_aram_dma.ARAddr += 8;
-        m_aram_dma.Cnt.count -= 8;
+        const u32 offset = m_aram_dma.ARAddr & m_aram.mask;
+        const u32 length = std::min<u32>(m_aram_dma.Cnt.count, m_aram.mask + 1 - offset);
+        memory.DMACopyToEmu(m_aram_dma.MMAddr, std::span(m_aram.ptr + offset, length));
+        advance(length);
       }
     }
     else if (!m_aram.wii_mode)
@@ -508,9 +502,7 @@ void DSPManager::Do_ARAM_DMA()
       while (m_aram_dma.Cnt.count)
       {
         memory.Write_U64(m_system.GetHSP().Read(m_aram_dma.ARAddr), m_aram_dma.MMAddr);
-        m_aram_dma.MMAddr += 8;
-        m_aram_dma.ARAddr += 8;
-        m_aram_dma.Cnt.count -= 8;
+        advance(8);
       }
     }
   }
@@ -529,30 +521,21 @@ void DSPManager::Do_ARAM_DMA()
     {
       while (m_aram_dma.Cnt.count)
       {
-        if ((m_aram_info.Hex & 0xf) == 3)
-        {
-          *(u64*)&m_aram.ptr[m_aram_dma.ARAddr & m_aram.mask] =
-              Common::swap64(memory.Read_U64(m_aram_dma.MMAddr));
-        }
-        else if ((m_aram_info.Hex & 0xf) == 4)
-        {
-          if (m_aram_dma.ARAddr < 0x400000)
-          {
-            *(u64*)&m_aram.ptr[(m_aram_dma.ARAddr + 0x400000) & m_aram.mask] =
-                Common::swap64(memory.Read_U64(m_aram_dma.MMAddr));
-          }
-          *(u64*)&m_aram.ptr[m_aram_dma.ARAddr & m_aram.mask] =
-              Common::swap64(memory.Read_U64(m_aram_dma.MMAddr));
-        }
-        else
+        const u32 offset = m_aram_dma.ARAddr & m_aram.mask;
+        u32 length = std::min<u32>(m_aram_dma.Cnt.count, m_aram.mask + 1 - offset);
+
+        // With memory map 4, the lowest 4MB of ARAM are also written to the 4MB above them
+        if ((m_aram_info.Hex & 0xf) == 4 && m_aram_dma.ARAddr < 0x400000)
         {
-          *(u64*)&m_aram.ptr[m_aram_dma.ARAddr & m_aram.mask] =
-              Common::swap64(memory.Read_U64(m_aram_dma.MMAddr));
+          const u32 mirror_offset = (m_aram_dma.ARAddr + 0x400000) & m_aram.mask;
+          length = std::min({length, 0x400000 - m_aram_dma.ARAddr,
+                             m_aram.mask + 1 - mirror_offset});
+          memory.DMACopyFromEmu(std::span(m_aram.ptr + mirror_offset, length),
+                                m_aram_dma.MMAddr);
         }
 
-        m_aram_dma.MMAddr += 8;
-        m_aram_dma.ARAddr += 8;
-        m_aram_dma.Cnt.count -= 8;
+        memory.DMACopyFromEmu(std::span(m_aram.ptr + offset, length), m_aram_dma.MMAddr);
+        advance(length);
       }
     }
     else if (!m_aram.wii_mode)
@@ -560,10 +543,7 @@ void DSPManager::Do_ARAM_DMA()
       while (m_aram_dma.Cnt.count)
       {
         m_system.GetHSP().Write(m_aram_dma.ARAddr, memory.Read_U64(m_aram_dma.MMAddr));
-
-        m_aram_dma.MMAddr += 8;
-        m_aram_dma.ARAddr += 8;
-        m_aram_dma.Cnt.count -= 8;
+        advance(8);
       }
     }
   }
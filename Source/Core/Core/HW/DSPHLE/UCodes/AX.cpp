@@ -10,16 +10,19 @@
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
 #include "Common/Hash.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/DSPHLE.h"
 #include "Core/HW/DSPHLE/MailHandler.h"
+#include "Core/HW/DSPHLE/UCodes/AXMix.h"
 #include "Core/HW/DSPHLE/UCodes/AXStructs.h"
 
 #define AX_GC
@@ -29,6 +32,9 @@ namespace DSP::HLE
 {
 AXUCode::AXUCode(DSPHLE* dsphle, u32 crc, bool dummy) : UCodeInterface(dsphle, crc)
 {
+  const int voice_threads = Config::Get(Config::MAIN_DSP_HLE_VOICE_THREADS);
+  if (voice_threads > 1)
+    m_voice_thread_pool = std::make_unique<AXVoiceThreadPool>(static_cast<u32>(voice_threads));
 }
 
 AXUCode::AXUCode(DSPHLE* dsphle, u32 crc) : AXUCode(dsphle, crc, false)
@@ -36,6 +42,16 @@ AXUCode::AXUCode(DSPHLE* dsphle, u32 crc) : AXUCode(dsphle, crc, false)
   INFO_LOG_FMT(DSPHLE, "Instantiating AXUCode: crc={:08x}", crc);
 
   m_accelerator = std::make_unique<HLEAccelerator>(dsphle->GetSystem().GetDSP());
+
+  if (m_voice_thread_pool)
+  {
+    for (u32 i = 1; i < m_voice_thread_pool->GetThreadCount(); ++i)
+    {
+      m_voice_thread_accelerators.push_back(
+          std::make_unique<HLEAccelerator>(dsphle->GetSystem().GetDSP()));
+      m_voice_thread_buffers.emplace_back(9 * 32 * 5);
+    }
+  }
 }
 
 AXUCode::~AXUCode() = default;
@@ -414,6 +430,9 @@ void AXUCode::DownloadAndMixWithVolume(u32 addr, u16 vol_main, u16 vol_auxa, u16
 
 void AXUCode::ProcessPBList(u32 pb_addr)
 {
+  if (m_voice_thread_pool && ProcessPBListInParallel(pb_addr))
+    return;
+
   // Samples per millisecond. In theory DSP sampling rate can be changed from
   // 32KHz to 48KHz, but AX always process at 32KHz.
   constexpr u32 spms = 32;
@@ -450,6 +469,97 @@ void AXUCode::ProcessPBList(u32 pb_addr)
   }
 }
 
+bool AXUCode::ProcessPBListInParallel(u32 pb_addr)
+{
+  constexpr u32 spms = 32;
+
+  auto& memory = m_dsphle->GetSystem().GetMemory();
+
+  // Voices don't depend on each other, so they can be processed in any order as long as the PBs
+  // are written back in list order. Finding the next PB requires applying the updates, which are
+  // applied again when the voice gets processed.
+  std::vector<u32> addresses;
+  std::vector<AXPB> pbs;
+  while (pb_addr)
+  {
+    // Processing a PB twice in one frame depends on the first pass, so leave that to the
+    // sequential path
+    if (std::find(addresses.begin(), addresses.end(), pb_addr) != addresses.end())
+      return false;
+
+    AXPB& pb = pbs.emplace_back();
+    ReadPB(memory, pb_addr, pb, m_crc);
+    addresses.push_back(pb_addr);
+
+    AXPB updated_pb = pb;
+    u16* updates = (u16*)HLEMemory_Get_Pointer(memory, HILO_TO_32(pb.updates.data));
+    for (int curr_ms = 0; curr_ms < 5; ++curr_ms)
+      ApplyUpdatesForMs(curr_ms, updated_pb, updated_pb.updates.num_updates, updates);
+
+    pb_addr = HILO_TO_32(updated_pb.next_pb);
+  }
+
+  if (pbs.size() < 2)
+    return false;
+
+  int* const main_buffers[9] = {m_samples_main_left, m_samples_main_right, m_samples_main_surround,
+                                m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
+                                m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround};
+
+  for (std::vector<int>& buffer : m_voice_thread_buffers)
+    std::fill(buffer.begin(), buffer.end(), 0);
+
+  const u32 thread_count = m_voice_thread_pool->GetThreadCount();
+  m_voice_thread_pool->Run([&](u32 thread_index) {
+    Accelerator* accelerator = m_accelerator.get();
+    int* thread_buffers[9];
+    std::copy(std::begin(main_buffers), std::end(main_buffers), thread_buffers);
+    if (thread_index != 0)
+    {
+      accelerator = m_voice_thread_accelerators[thread_index - 1].get();
+      for (size_t i = 0; i < std::size(thread_buffers); ++i)
+        thread_buffers[i] = m_voice_thread_buffers[thread_index - 1].data() + i * 32 * 5;
+    }
+
+    for (size_t i = thread_index; i < pbs.size(); i += thread_count)
+    {
+      AXPB& pb = pbs[i];
+      AXBuffers buffers = {{thread_buffers[0], thread_buffers[1], thread_buffers[2],
+                            thread_buffers[3], thread_buffers[4], thread_buffers[5],
+                            thread_buffers[6], thread_buffers[7], thread_buffers[8]}};
+
+      u16* updates = (u16*)HLEMemory_Get_Pointer(memory, HILO_TO_32(pb.updates.data));
+      for (int curr_ms = 0; curr_ms < 5; ++curr_ms)
+      {
+        ApplyUpdatesForMs(curr_ms, pb, pb.updates.num_updates, updates);
+
+        ProcessVoice(static_cast<HLEAccelerator*>(accelerator), pb, buffers, spms,
+                     ConvertMixerControl(pb.mixer_control),
+                     m_coeffs_checksum ? m_coeffs.data() : nullptr);
+
+        for (auto& ptr : buffers.ptrs)
+          ptr += spms;
+      }
+    }
+  });
+
+  // Mixing only ever adds to the buffers, so summing them up gives the same result as processing
+  // the voices one after another
+  for (const std::vector<int>& thread_buffer : m_voice_thread_buffers)
+  {
+    for (size_t i = 0; i < std::size(main_buffers); ++i)
+    {
+      for (u32 j = 0; j < 32 * 5; ++j)
+        main_buffers[i][j] += thread_buffer[i * 32 * 5 + j];
+    }
+  }
+
+  for (size_t i = 0; i < pbs.size(); ++i)
+    WritePB(memory, addresses[i], pbs[i], m_crc);
+
+  return true;
+}
+
 void AXUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr)
 {
   int* buffers[3] = {nullptr};
@@ -14,6 +14,7 @@
 #include <array>
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
@@ -30,6 +31,7 @@ class Accelerator;
 
 namespace DSP::HLE
 {
+class AXVoiceThreadPool;
 class DSPHLE;
 
 // We can't directly use the mixer_control field from the PB because it does
@@ -110,6 +112,13 @@ protected:
 
   std::unique_ptr<Accelerator> m_accelerator;
 
+  // Only set up if voices may be processed on more than one thread. Every thread except the calling
+  // one has its own accelerator and mixes into its own buffers, which get added to the main ones
+  // afterwards.
+  std::unique_ptr<AXVoiceThreadPool> m_voice_thread_pool;
+  std::vector<std::unique_ptr<Accelerator>> m_voice_thread_accelerators;
+  std::vector<std::vector<int>> m_voice_thread_buffers;
+
   // Constructs without any GC-specific state, so it can be used by the deriving AXWii.
   AXUCode(DSPHLE* dsphle, u32 crc, bool dummy);
 
@@ -181,6 +190,7 @@ protected:
   void SetupProcessing(u32 init_addr);
   void DownloadAndMixWithVolume(u32 addr, u16 vol_main, u16 vol_auxa, u16 vol_auxb);
   void ProcessPBList(u32 pb_addr);
+  bool ProcessPBListInParallel(u32 pb_addr);
   void MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr);
   void UploadLRS(u32 dst_addr);
   void SetMainLR(u32 src_addr);
@@ -0,0 +1,155 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DSPHLE/UCodes/AXMix.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+
+#include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
+
+#if defined(_M_X86_64)
+#include "Common/CPUDetect.h"
+#include "Common/Intrinsics.h"
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
+namespace DSP::HLE
+{
+// An s16 sample times a u16 volume always fits in an s32, so the SIMD paths can work on 32-bit
+// lanes without losing any precision compared to the scalar path.
+static s32 ScaleSample(s16 input, u16 volume)
+{
+  const s32 sample = (static_cast<s32>(input) * volume) >> 15;
+  return std::clamp(sample, -32767, 32767);  // -32768 ?
+}
+
+void MixAddWithVolumeRampScalar(int* out, const s16* input, u32 count, u16* volume,
+                                u16 volume_delta, s16* dpop)
+{
+  for (u32 i = 0; i < count; ++i)
+  {
+    const s16 sample = static_cast<s16>(ScaleSample(input[i], *volume));
+    out[i] += sample;
+    *volume += volume_delta;
+
+    *dpop = sample;
+  }
+}
+
+// Handles samples four at a time. Returns how many samples were handled, leaving the rest for the
+// scalar path.
+#if defined(_M_X86_64)
+FUNCTION_TARGET_SSR41
+static u32 MixAddWithVolumeRampSSE41(int* out, const s16* input, u32 count, u16* volume,
+                                     u16 volume_delta, s16* dpop)
+{
+  const u32 vector_count = count & ~3u;
+  if (vector_count == 0)
+    return 0;
+
+  const __m128i mask = _mm_set1_epi32(0xFFFF);
+  const __m128i min = _mm_set1_epi32(-32767);
+  const __m128i max = _mm_set1_epi32(32767);
+  const __m128i step = _mm_set1_epi32(volume_delta * 4);
+  __m128i volumes = _mm_and_si128(
+      _mm_setr_epi32(*volume, *volume + volume_delta, *volume + volume_delta * 2,
+                     *volume + volume_delta * 3),
+      mask);
+
+  __m128i samples = _mm_setzero_si128();
+  for (u32 i = 0; i < vector_count; i += 4)
+  {
+    const __m128i in =
+        _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(input + i)));
+    samples = _mm_srai_epi32(_mm_mullo_epi32(in, volumes), 15);
+    samples = _mm_min_epi32(_mm_max_epi32(samples, min), max);
+
+    __m128i* const out_ptr = reinterpret_cast<__m128i*>(out + i);
+    _mm_storeu_si128(out_ptr, _mm_add_epi32(_mm_loadu_si128(out_ptr), samples));
+
+    volumes = _mm_and_si128(_mm_add_epi32(volumes, step), mask);
+  }
+
+  *volume = static_cast<u16>(*volume + volume_delta * vector_count);
+  *dpop = static_cast<s16>(_mm_extract_epi32(samples, 3));
+  return vector_count;
+}
+#elif defined(_M_ARM_64)
+static u32 MixAddWithVolumeRampNEON(int* out, const s16* input, u32 count, u16* volume,
+                                    u16 volume_delta, s16* dpop)
+{
+  const u32 vector_count = count & ~3u;
+  if (vector_count == 0)
+    return 0;
+
+  const int32_t initial_volumes[4] = {*volume, static_cast<u16>(*volume + volume_delta),
+                                      static_cast<u16>(*volume + volume_delta * 2),
+                                      static_cast<u16>(*volume + volume_delta * 3)};
+  const int32x4_t mask = vdupq_n_s32(0xFFFF);
+  const int32x4_t min = vdupq_n_s32(-32767);
+  const int32x4_t max = vdupq_n_s32(32767);
+  const int32x4_t step = vdupq_n_s32(volume_delta * 4);
+  int32x4_t volumes = vld1q_s32(initial_volumes);
+
+  int32x4_t samples = vdupq_n_s32(0);
+  for (u32 i = 0; i < vector_count; i += 4)
+  {
+    const int32x4_t in = vmovl_s16(vld1_s16(input + i));
+    samples = vshrq_n_s32(vmulq_s32(in, volumes), 15);
+    samples = vminq_s32(vmaxq_s32(samples, min), max);
+
+    vst1q_s32(out + i, vaddq_s32(vld1q_s32(out + i), samples));
+
+    volumes = vandq_s32(vaddq_s32(volumes, step), mask);
+  }
+
+  *volume = static_cast<u16>(*volume + volume_delta * vector_count);
+  *dpop = static_cast<s16>(vgetq_lane_s32(samples, 3));
+  return vector_count;
+}
+#endif
+
+void MixAddWithVolumeRamp(int* out, const s16* input, u32 count, u16* volume, u16 volume_delta,
+                          s16* dpop)
+{
+  u32 done = 0;
+#if defined(_M_X86_64)
+  if (cpu_info.bSSE4_1)
+    done = MixAddWithVolumeRampSSE41(out, input, count, volume, volume_delta, dpop);
+#elif defined(_M_ARM_64)
+  done = MixAddWithVolumeRampNEON(out, input, count, volume, volume_delta, dpop);
+#endif
+
+  MixAddWithVolumeRampScalar(out + done, input + done, count - done, volume, volume_delta, dpop);
+}
+
+AXVoiceThreadPool::AXVoiceThreadPool(u32 thread_count)
+{
+  for (u32 i = 1; i < thread_count; ++i)
+  {
+    m_threads.push_back(std::make_unique<Common::WorkQueueThread<u32>>(
+        "AX Voice Worker", [this](u32 index) { (*m_function)(index); }));
+  }
+}
+
+AXVoiceThreadPool::~AXVoiceThreadPool() = default;
+
+void AXVoiceThreadPool::Run(const std::function<void(u32)>& function)
+{
+  m_function = &function;
+
+  for (size_t i = 0; i < m_threads.size(); ++i)
+    m_threads[i]->Push(static_cast<u32>(i + 1));
+
+  function(0);
+
+  for (auto& thread : m_threads)
+    thread->WaitForCompletion();
+
+  m_function = nullptr;
+}
+}  // namespace DSP::HLE
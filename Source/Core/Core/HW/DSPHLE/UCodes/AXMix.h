@@ -0,0 +1,46 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
+
+namespace DSP::HLE
+{
+// Adds count samples from input to out, scaled by *volume. *volume is incremented by volume_delta
+// (wrapping around) after every sample, and *dpop is set to the last scaled sample.
+// Uses SIMD where available.
+void MixAddWithVolumeRamp(int* out, const s16* input, u32 count, u16* volume, u16 volume_delta,
+                          s16* dpop);
+
+// Same as MixAddWithVolumeRamp, but never uses SIMD. The SIMD paths must match it bit for bit.
+void MixAddWithVolumeRampScalar(int* out, const s16* input, u32 count, u16* volume,
+                                u16 volume_delta, s16* dpop);
+
+// A small set of threads for processing independent voices at the same time.
+class AXVoiceThreadPool
+{
+public:
+  // thread_count includes the calling thread.
+  explicit AXVoiceThreadPool(u32 thread_count);
+  ~AXVoiceThreadPool();
+
+  AXVoiceThreadPool(const AXVoiceThreadPool&) = delete;
+  AXVoiceThreadPool& operator=(const AXVoiceThreadPool&) = delete;
+
+  u32 GetThreadCount() const { return static_cast<u32>(m_threads.size()) + 1; }
+
+  // Calls function(i) for every i below GetThreadCount() and returns once all calls are done.
+  // function(0) is called on the calling thread.
+  void Run(const std::function<void(u32)>& function);
+
+private:
+  std::vector<std::unique_ptr<Common::WorkQueueThread<u32>>> m_threads;
+  const std::function<void(u32)>* m_function = nullptr;
+};
+}  // namespace DSP::HLE
@@ -12,14 +12,16 @@
 #endif
 
 #include <algorithm>
-#include <functional>
+#include <array>
 #include <memory>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Core/DSP/DSPAccelerator.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/UCodes/AX.h"
+#include "Core/HW/DSPHLE/UCodes/AXMix.h"
 #include "Core/HW/DSPHLE/UCodes/AXStructs.h"
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
@@ -210,16 +212,20 @@ void AcceleratorSetup(HLEAccelerator* accelerator, PB_TYPE* pb)
   accelerator->SetPredScale(pb->adpcm.pred_scale);
 }
 
-// Reads a sample from the accelerator. Also handles looping and
-// disabling streams that reached the end (this is done by an exception raised
-// by the accelerator on real hardware).
-u16 AcceleratorGetSample(HLEAccelerator* accelerator)
+// Returns how many input samples ResampleAudio reads to produce <count> samples.
+u32 GetResampleInputCount(u32 count, u32 curr_pos, u32 ratio, int srctype)
 {
-  return accelerator->Read(accelerator->acc_pb->adpcm.coefs);
+  if (srctype != SRCTYPE_LINEAR && srctype != SRCTYPE_POLYPHASE)
+    return count;
+
+  // The position only ever moves forward by <ratio>, and an input sample is read each time it
+  // crosses an integer.
+  return static_cast<u32>((curr_pos + static_cast<u64>(ratio) * count) >> 16);
 }
 
-// Reads samples from the input callback, resamples them to <count> samples at
-// the wanted sample rate (computed from the ratio, see below).
+// Reads samples from <input>, resamples them to <count> samples at
+// the wanted sample rate (computed from the ratio, see below). <input> must
+// hold at least GetResampleInputCount samples.
 //
 // If srctype is SRCTYPE_POLYPHASE, coefficients need to be provided as well
 // (or the srctype will automatically be changed to LINEAR).
@@ -238,8 +244,8 @@ u16 AcceleratorGetSample(HLEAccelerator* accelerator)
 // We start getting samples not from sample 0, but 0.<curr_pos_frac>. This
 // avoids discontinuities in the audio stream, especially with very low ratios
 // which interpolate a lot of values between two "real" samples.
-u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count, s16* last_samples,
-                  u32 curr_pos, u32 ratio, int srctype, const s16* coeffs)
+u32 ResampleAudio(const s16* input, s16* output, u32 count, s16* last_samples, u32 curr_pos,
+                  u32 ratio, int srctype, const s16* coeffs)
 {
   int read_samples_count = 0;
 
@@ -259,7 +265,7 @@ u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count
       curr_pos += ratio;
       while (curr_pos >= 0x10000)
       {
-        temp[idx++ & 3] = input_callback(read_samples_count++);
+        temp[idx++ & 3] = input[read_samples_count++];
         curr_pos -= 0x10000;
       }
 
@@ -302,7 +308,7 @@ u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count
       // circular buffer.
       while (curr_pos >= 0x10000)
       {
-        temp[idx++ & 3] = input_callback(read_samples_count++);
+        temp[idx++ & 3] = input[read_samples_count++];
         curr_pos -= 0x10000;
       }
 
@@ -342,7 +348,7 @@ u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count
     // No sample rate conversion here: simply read samples from the
     // accelerator to the output buffer.
     for (u32 i = 0; i < count; ++i)
-      output[i] = input_callback(i);
+      output[i] = input[i];
 
     memcpy(last_samples, output + count - 4, 4 * sizeof(u16));
   }
@@ -359,9 +365,25 @@ void GetInputSamples(HLEAccelerator* accelerator, PB_TYPE& pb, s16* samples, u16
 
   if (coeffs)
     coeffs += pb.coef_select * 0x200;
-  u32 curr_pos = ResampleAudio([accelerator](u32) { return AcceleratorGetSample(accelerator); },
-                               samples, count, pb.src.last_samples, pb.src.cur_addr_frac,
-                               HILO_TO_32(pb.src.ratio), pb.src_type, coeffs);
+
+  // Decode everything the resampler needs in one go rather than calling into the accelerator
+  // once per sample. Only very high ratios need more than the buffer on the stack. This also
+  // handles looping and disabling streams that reached the end (done by an exception raised by
+  // the accelerator on real hardware).
+  const u32 ratio = HILO_TO_32(pb.src.ratio);
+  const u32 input_count = GetResampleInputCount(count, pb.src.cur_addr_frac, ratio, pb.src_type);
+  std::array<s16, MAX_SAMPLES_PER_FRAME * 4> input_buffer;
+  std::vector<s16> large_input_buffer;
+  s16* input = input_buffer.data();
+  if (input_count > input_buffer.size())
+  {
+    large_input_buffer.resize(input_count);
+    input = large_input_buffer.data();
+  }
+  accelerator->ReadSamples(input, input_count, accelerator->acc_pb->adpcm.coefs);
+
+  u32 curr_pos = ResampleAudio(input, samples, count, pb.src.last_samples, pb.src.cur_addr_frac,
+                               ratio, pb.src_type, coeffs);
   pb.src.cur_addr_frac = (curr_pos & 0xFFFF);
 
   // Update current position, YN1, YN2 and pred scale in the PB.
@@ -375,27 +397,12 @@ void GetInputSamples(HLEAccelerator* accelerator, PB_TYPE& pb, s16* samples, u16
 // Add samples to an output buffer, with optional volume ramping.
 void MixAdd(int* out, const s16* input, u32 count, VolumeData* vd, s16* dpop, bool ramp)
 {
-  u16& volume = vd->volume;
-  u16 volume_delta = vd->volume_delta;
-
   // If volume ramping is disabled, set volume_delta to 0. That way, the
   // mixing loop can avoid testing if volume ramping is enabled at each step,
   // and just add volume_delta.
-  if (!ramp)
-    volume_delta = 0;
+  const u16 volume_delta = ramp ? vd->volume_delta : 0;
 
-  for (u32 i = 0; i < count; ++i)
-  {
-    s64 sample = input[i];
-    sample *= volume;
-    sample >>= 15;
-    sample = std::clamp((s32)sample, -32767, 32767);  // -32768 ?
-
-    out[i] += (s16)sample;
-    volume += volume_delta;
-
-    *dpop = (s16)sample;
-  }
+  MixAddWithVolumeRamp(out, input, count, &vd->volume, volume_delta, dpop);
 }
 
 // Execute a low pass filter on the samples using one history value. Returns
@@ -535,9 +542,8 @@ void ProcessVoice(HLEAccelerator* accelerator, PB_TYPE& pb, const AXBuffers& buf
 
     // We use ratio 0x55555 == (5 * 65536 + 21845) / 65536 == 5.3333 which
     // is the nearest we can get to 96/18
-    u32 curr_pos = ResampleAudio([&samples](u32 i) { return samples[i]; }, wm_samples, wm_count,
-                                 pb.remote_src.last_samples, pb.remote_src.cur_addr_frac, 0x55555,
-                                 SRCTYPE_POLYPHASE, coeffs);
+    u32 curr_pos = ResampleAudio(samples, wm_samples, wm_count, pb.remote_src.last_samples,
+                                 pb.remote_src.cur_addr_frac, 0x55555, SRCTYPE_POLYPHASE, coeffs);
     pb.remote_src.cur_addr_frac = curr_pos & 0xFFFF;
 
 // Mix to main[0-3] and aux[0-3]
@@ -7,6 +7,8 @@
 
 #include <algorithm>
 #include <array>
+#include <iterator>
+#include <vector>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -14,6 +16,7 @@
 #include "Common/Swap.h"
 #include "Core/HW/DSPHLE/DSPHLE.h"
 #include "Core/HW/DSPHLE/MailHandler.h"
+#include "Core/HW/DSPHLE/UCodes/AXMix.h"
 #include "Core/HW/DSPHLE/UCodes/AXStructs.h"
 #include "Core/HW/DSPHLE/UCodes/AXVoice.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
@@ -31,6 +34,16 @@ AXWiiUCode::AXWiiUCode(DSPHLE* dsphle, u32 crc)
   m_old_axwii = (crc == 0xfa450138) || (crc == 0x7699af32);
 
   m_accelerator = std::make_unique<HLEAccelerator>(dsphle->GetSystem().GetDSP());
+
+  if (m_voice_thread_pool)
+  {
+    for (u32 i = 1; i < m_voice_thread_pool->GetThreadCount(); ++i)
+    {
+      m_voice_thread_accelerators.push_back(
+          std::make_unique<HLEAccelerator>(dsphle->GetSystem().GetDSP()));
+      m_voice_thread_buffers.emplace_back(12 * 32 * 3 + 8 * 6 * 3);
+    }
+  }
 }
 
 void AXWiiUCode::Initialize()
@@ -421,6 +434,9 @@ void AXWiiUCode::ReinjectUpdatesFields(AXPBWii& pb, u16* num_updates, u32 update
 
 void AXWiiUCode::ProcessPBList(u32 pb_addr)
 {
+  if (m_voice_thread_pool && ProcessPBListInParallel(pb_addr))
+    return;
+
   // Samples per millisecond. In theory DSP sampling rate can be changed from
   // 32KHz to 48KHz, but AX always process at 32KHz.
   constexpr u32 spms = 32;
@@ -470,6 +486,130 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
   }
 }
 
+bool AXWiiUCode::ProcessPBListInParallel(u32 pb_addr)
+{
+  constexpr u32 spms = 32;
+
+  struct Voice
+  {
+    u32 pb_addr;
+    AXPBWii pb;
+    bool has_updates;
+    u16 num_updates[3];
+    u16 updates[1024];
+    u32 updates_addr;
+  };
+
+  auto& memory = m_dsphle->GetSystem().GetMemory();
+
+  // See AXUCode::ProcessPBListInParallel
+  std::vector<Voice> voices;
+  while (pb_addr)
+  {
+    if (std::any_of(voices.begin(), voices.end(),
+                    [pb_addr](const Voice& voice) { return voice.pb_addr == pb_addr; }))
+    {
+      return false;
+    }
+
+    Voice& voice = voices.emplace_back();
+    voice.pb_addr = pb_addr;
+    ReadPB(memory, pb_addr, voice.pb, m_crc);
+    voice.has_updates =
+        ExtractUpdatesFields(voice.pb, voice.num_updates, voice.updates, &voice.updates_addr);
+
+    AXPBWii updated_pb = voice.pb;
+    if (voice.has_updates)
+    {
+      for (int curr_ms = 0; curr_ms < 3; ++curr_ms)
+        ApplyUpdatesForMs(curr_ms, updated_pb, voice.num_updates, voice.updates);
+    }
+
+    pb_addr = HILO_TO_32(updated_pb.next_pb);
+  }
+
+  if (voices.size() < 2)
+    return false;
+
+  int* const main_buffers[20] = {m_samples_main_left, m_samples_main_right, m_samples_main_surround,
+                                 m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
+                                 m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround,
+                                 m_samples_auxC_left, m_samples_auxC_right, m_samples_auxC_surround,
+                                 m_samples_wm0,       m_samples_aux0,       m_samples_wm1,
+                                 m_samples_aux1,      m_samples_wm2,        m_samples_aux2,
+                                 m_samples_wm3,       m_samples_aux3};
+
+  // The first 12 buffers hold 3 ms of main audio, the rest 3 ms of Wii Remote audio
+  const auto buffer_size = [](size_t i) -> u32 { return i < 12 ? 32 * 3 : 6 * 3; };
+
+  for (std::vector<int>& buffer : m_voice_thread_buffers)
+    std::fill(buffer.begin(), buffer.end(), 0);
+
+  const u32 thread_count = m_voice_thread_pool->GetThreadCount();
+  m_voice_thread_pool->Run([&](u32 thread_index) {
+    Accelerator* accelerator = m_accelerator.get();
+    int* thread_buffers[20];
+    std::copy(std::begin(main_buffers), std::end(main_buffers), thread_buffers);
+    if (thread_index != 0)
+    {
+      accelerator = m_voice_thread_accelerators[thread_index - 1].get();
+      int* ptr = m_voice_thread_buffers[thread_index - 1].data();
+      for (size_t i = 0; i < std::size(thread_buffers); ++i)
+      {
+        thread_buffers[i] = ptr;
+        ptr += buffer_size(i);
+      }
+    }
+
+    for (size_t i = thread_index; i < voices.size(); i += thread_count)
+    {
+      Voice& voice = voices[i];
+      AXBuffers buffers;
+      std::copy(std::begin(thread_buffers), std::end(thread_buffers), buffers.ptrs);
+
+      if (voice.has_updates)
+      {
+        for (int curr_ms = 0; curr_ms < 3; ++curr_ms)
+        {
+          ApplyUpdatesForMs(curr_ms, voice.pb, voice.num_updates, voice.updates);
+          ProcessVoice(static_cast<HLEAccelerator*>(accelerator), voice.pb, buffers, spms,
+                       ConvertMixerControl(HILO_TO_32(voice.pb.mixer_control)),
+                       m_coeffs_checksum ? m_coeffs.data() : nullptr);
+
+          // Unlike ProcessPBList, don't run past the end of the Wii Remote buffers
+          for (size_t j = 0; j < std::size(buffers.ptrs); ++j)
+            buffers.ptrs[j] += buffer_size(j) / 3;
+        }
+      }
+      else
+      {
+        ProcessVoice(static_cast<HLEAccelerator*>(accelerator), voice.pb, buffers, 96,
+                     ConvertMixerControl(HILO_TO_32(voice.pb.mixer_control)),
+                     m_coeffs_checksum ? m_coeffs.data() : nullptr);
+      }
+    }
+  });
+
+  for (const std::vector<int>& thread_buffer : m_voice_thread_buffers)
+  {
+    const int* ptr = thread_buffer.data();
+    for (size_t i = 0; i < std::size(main_buffers); ++i)
+    {
+      for (u32 j = 0; j < buffer_size(i); ++j)
+        main_buffers[i][j] += *ptr++;
+    }
+  }
+
+  for (Voice& voice : voices)
+  {
+    if (voice.has_updates)
+      ReinjectUpdatesFields(voice.pb, voice.num_updates, voice.updates_addr);
+    WritePB(memory, voice.pb_addr, voice.pb, m_crc);
+  }
+
+  return true;
+}
+
 void AXWiiUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr, u16 volume)
 {
   std::array<u16, 96> volume_ramp;
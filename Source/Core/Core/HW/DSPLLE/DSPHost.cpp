@@ -92,9 +92,7 @@ void CodeLoaded(DSPCore& dsp, const u8* ptr, size_t size)
 
   NOTICE_LOG_FMT(DSPLLE, "g_dsp.iram_crc: {:08x}", iram_crc);
 
-  Symbols::Clear();
-  Symbols::AutoDisassembly(state, 0x0, 0x1000);
-  Symbols::AutoDisassembly(state, 0x8000, 0x9000);
+  Symbols::SetCode(state);
 
   UpdateDebugger();
 
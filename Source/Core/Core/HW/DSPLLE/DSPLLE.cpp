@@ -3,6 +3,8 @@
 
 #include "Core/HW/DSPLLE/DSPLLE.h"
 
+#include <algorithm>
+#include <chrono>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -25,6 +27,7 @@
 #include "Core/DSP/DSPTables.h"
 #include "Core/DSP/Interpreter/DSPInterpreter.h"
 #include "Core/DSP/Jit/DSPEmitterBase.h"
+#include "Core/HW/DSPLLE/DSPSymbols.h"
 #include "Core/HW/Memmap.h"
 #include "Core/Host.h"
 
@@ -57,6 +60,7 @@ void DSPLLE::DoState(PointerWrap& p)
 void DSPLLE::DSPThread(DSPLLE* dsp_lle)
 {
   Common::SetCurrentThreadName("DSP thread");
+  Common::SetCurrentThreadRole(Common::ThreadRole::Emulation);
 
   while (dsp_lle->m_is_running.IsSet())
   {
@@ -74,7 +78,8 @@ void DSPLLE::DSPThread(DSPLLE* dsp_lle)
         {
           dsp_lle->m_dsp_core.GetInterpreter().RunCyclesThread(cycles);
         }
-        dsp_lle->m_cycle_count.store(0);
+        // In asynchronous mode, the CPU thread may have added cycles in the meantime
+        dsp_lle->m_cycle_count.fetch_sub(static_cast<u32>(cycles));
         continue;
       }
     }
@@ -120,7 +125,7 @@ static bool FillDSPInitOptions(DSPInitOptions* opts)
     return false;
 
   opts->core_type = DSPInitOptions::CoreType::Interpreter;
-#ifdef _M_X86_64
+#if defined(_M_X86_64) || defined(_M_ARM_64)
   if (Config::Get(Config::MAIN_DSP_JIT))
     opts->core_type = DSPInitOptions::CoreType::JIT64;
 #endif
@@ -150,6 +155,7 @@ bool DSPLLE::Initialize(bool wii, bool dsp_thread)
 
   m_wii = wii;
   m_is_dsp_on_thread = dsp_thread;
+  m_max_lag = static_cast<u32>(std::max(Config::Get(Config::MAIN_DSP_THREAD_MAX_LAG), 0));
 
   m_dsp_core.Reset();
 
@@ -179,6 +185,7 @@ void DSPLLE::DSP_StopSoundStream()
 void DSPLLE::Shutdown()
 {
   m_dsp_core.Shutdown();
+  Symbols::Clear();
 }
 
 u16 DSPLLE::DSP_WriteControlRegister(u16 value)
@@ -274,13 +281,26 @@ void DSPLLE::DSP_Update(int cycles)
     // ~1/6th as many cycles as the period PPC-side.
     m_dsp_core.RunCycles(dsp_cycles);
   }
-  else
+  else if (m_max_lag == 0)
   {
     // Wait for DSP thread to complete its cycle. Note: this logic should be thought through.
     m_ppc_event.Wait();
     m_cycle_count.fetch_add(dsp_cycles);
     m_dsp_event.Set();
   }
+  else
+  {
+    // Let the DSP thread run behind, but only by a bounded amount so that it can't drift away
+    // from CoreTiming. If it falls too far behind, wait until it has caught up.
+    const u32 max_pending_cycles = m_max_lag * static_cast<u32>(dsp_cycles);
+    const u32 pending_cycles = m_cycle_count.fetch_add(dsp_cycles) + dsp_cycles;
+    m_dsp_event.Set();
+    if (pending_cycles > max_pending_cycles)
+    {
+      while (m_cycle_count.load() != 0 && m_is_running.IsSet())
+        m_ppc_event.WaitFor(std::chrono::milliseconds(1));
+    }
+  }
 }
 
 u32 DSPLLE::DSP_UpdateRate()
@@ -301,7 +321,8 @@ void DSPLLE::PauseAndLock(bool do_lock)
     if (m_is_dsp_on_thread)
     {
       // Signal the DSP thread so it can perform any outstanding work now (if any)
-      m_ppc_event.Wait();
+      if (m_max_lag == 0)
+        m_ppc_event.Wait();
       m_dsp_event.Set();
     }
   }
@@ -48,6 +48,10 @@ private:
   Common::Flag m_is_running;
   std::atomic<u32> m_cycle_count{};
 
+  // Number of updates the DSP thread may fall behind. 0 means DSP_Update waits for the DSP thread
+  // to finish the previous update before handing it the next one.
+  u32 m_max_lag = 0;
+
   Common::Event m_dsp_event;
   Common::Event m_ppc_event;
   bool m_request_disable_thread = false;
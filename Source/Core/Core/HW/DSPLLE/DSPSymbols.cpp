@@ -19,9 +19,22 @@ static std::map<u16, int> addr_to_line;
 static std::map<int, u16> line_to_addr;
 static std::vector<std::string> lines;
 static int line_counter = 0;
+static const SDSP* pending_dsp = nullptr;
+
+static void DisassemblePendingCode()
+{
+  if (!pending_dsp)
+    return;
+
+  const SDSP& dsp = *pending_dsp;
+  pending_dsp = nullptr;
+  AutoDisassembly(dsp, 0x0, 0x1000);
+  AutoDisassembly(dsp, 0x8000, 0x9000);
+}
 
 int Addr2Line(u16 address)  // -1 for not found
 {
+  DisassemblePendingCode();
   std::map<u16, int>::iterator iter = addr_to_line.find(address);
   if (iter != addr_to_line.end())
     return iter->second;
@@ -31,6 +44,7 @@ int Addr2Line(u16 address)  // -1 for not found
 
 int Line2Addr(int line)  // -1 for not found
 {
+  DisassemblePendingCode();
   std::map<int, u16>::iterator iter = line_to_addr.find(line);
   if (iter != line_to_addr.end())
     return iter->second;
@@ -40,6 +54,7 @@ int Line2Addr(int line)  // -1 for not found
 
 const char* GetLineText(int line)
 {
+  DisassemblePendingCode();
   if (line >= 0 && line < (int)lines.size())
   {
     return lines[line].c_str();
@@ -78,8 +93,15 @@ void AutoDisassembly(const SDSP& dsp, u16 start_addr, u16 end_addr)
   }
 }
 
+void SetCode(const SDSP& dsp)
+{
+  Clear();
+  pending_dsp = &dsp;
+}
+
 void Clear()
 {
+  pending_dsp = nullptr;
   addr_to_line.clear();
   line_to_addr.clear();
   lines.clear();
@@ -17,6 +17,10 @@ namespace DSP::Symbols
 {
 void AutoDisassembly(const SDSP& dsp, u16 start_addr, u16 end_addr);
 
+// Clears the symbols and disassembles IRAM and IROM the first time they are looked up, which is
+// usually never. Disassembling on every ucode upload would slow down ucode switches.
+void SetCode(const SDSP& dsp);
+
 void Clear();
 
 int Addr2Line(u16 address);
@@ -3,6 +3,7 @@
 
 #include "Core/HW/DVD/DVDThread.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -20,6 +21,9 @@
 #include "Common/SPSCQueue.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
+#include "Common/Tracing.h"
+
+#include "Core/Config/MainSettings.h"
 
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
@@ -55,6 +59,9 @@ void DVDThread::Start()
   // much, because this will never get exposed to the emulated game.
   m_next_id = 0;
 
+  m_read_ahead.SetMaxSize(
+      static_cast<size_t>(std::max(Config::Get(Config::MAIN_DVD_READ_AHEAD_MB), 0)) * 1024 * 1024);
+
   StartDVDThread();
 }
 
@@ -68,6 +75,7 @@ void DVDThread::StartDVDThread()
 void DVDThread::Stop()
 {
   StopDVDThread();
+  m_read_ahead.Clear();
   m_disc.reset();
 }
 
@@ -92,7 +100,7 @@ void DVDThread::DoState(PointerWrap& p)
   WaitUntilIdle();
 
   // Move all results from result_queue to result_map because
-  // PointerWrap::Do supports std::map but not Common::SPSCQueue.
+  // PointerWrap::Do supports std::map but not Common::SPSCSegmentedQueue.
   // This won't affect the behavior of FinishRead.
   ReadResult result;
   while (m_result_queue.Pop(result))
@@ -131,6 +139,7 @@ void DVDThread::DoState(PointerWrap& p)
 void DVDThread::SetDisc(std::unique_ptr<DiscIO::Volume> disc)
 {
   WaitUntilIdle();
+  m_read_ahead.Clear();
   m_disc = std::move(disc);
 }
 
@@ -318,7 +327,7 @@ void DVDThread::FinishRead(u64 id, s64 cycles_late)
     if (request.copy_to_ram)
     {
       auto& memory = m_system.GetMemory();
-      memory.CopyToEmu(request.output_address, buffer.data(), request.length);
+      memory.DMACopyToEmu(request.output_address, buffer);
     }
 
     interrupt = DVD::DIInterruptType::TCINT;
@@ -328,6 +337,23 @@ void DVDThread::FinishRead(u64 id, s64 cycles_late)
   dvd_interface.FinishExecutingCommand(request.reply_type, interrupt, cycles_late, buffer);
 }
 
+DVDThread::ReadLatencyHistogram DVDThread::GetReadLatencyHistogram() const
+{
+  ReadLatencyHistogram histogram;
+  for (size_t i = 0; i < m_read_latency_buckets.size(); ++i)
+    histogram.bucket_counts[i] = m_read_latency_buckets[i].load(std::memory_order_relaxed);
+  histogram.total_us = m_read_latency_total_us.load(std::memory_order_relaxed);
+  return histogram;
+}
+
+void DVDThread::CountReadLatency(u64 latency_us)
+{
+  const auto bucket = std::ranges::lower_bound(READ_LATENCY_BUCKETS_US, latency_us);
+  m_read_latency_buckets[bucket - READ_LATENCY_BUCKETS_US.begin()].fetch_add(
+      1, std::memory_order_relaxed);
+  m_read_latency_total_us.fetch_add(latency_us, std::memory_order_relaxed);
+}
+
 void DVDThread::DVDThreadMain()
 {
   Common::SetCurrentThreadName("DVD thread");
@@ -340,15 +366,35 @@ void DVDThread::DVDThreadMain()
       return;
 
     ReadRequest request;
-    while (m_request_queue.Pop(request))
+    while (true)
     {
+      if (!m_request_queue.Pop(request))
+      {
+        // Use the time until the next request comes in for reading ahead
+        if (!m_disc || !m_read_ahead.Prefetch(*m_disc))
+          break;
+        if (m_dvd_thread_exiting.IsSet())
+          return;
+        continue;
+      }
+
       m_file_logger.Log(*m_disc, request.partition, request.dvd_offset);
 
       std::vector<u8> buffer(request.length);
-      if (!m_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
-        buffer.resize(0);
+      {
+        Common::Tracing::ScopedEvent trace_event("dvd", "Read");
+        if (!m_read_ahead.Read(request.partition, request.dvd_offset, request.length,
+                               buffer.data()) &&
+            !m_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
+        {
+          buffer.resize(0);
+        }
+      }
 
       request.realtime_done_us = Common::Timer::NowUs();
+      CountReadLatency(request.realtime_done_us - request.realtime_started_us);
+
+      m_read_ahead.OnRead(*m_disc, request.partition, request.dvd_offset, request.length);
 
       m_result_queue.Push(ReadResult(std::move(request), std::move(buffer)));
       m_result_queue_expanded.Set();
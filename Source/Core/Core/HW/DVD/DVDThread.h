@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <optional>
@@ -17,6 +19,7 @@
 
 #include "Core/HW/DVD/DVDInterface.h"
 #include "Core/HW/DVD/FileMonitor.h"
+#include "Core/HW/DVD/ReadAheadCache.h"
 
 #include "DiscIO/Volume.h"
 
@@ -86,10 +89,27 @@ public:
                               const DiscIO::Partition& partition, DVD::ReplyType reply_type,
                               s64 ticks_until_completion);
 
+  // Upper bounds of the buckets of the read latency histogram, in microseconds.
+  static constexpr std::array<u64, 8> READ_LATENCY_BUCKETS_US = {
+      100, 500, 1000, 5000, 10000, 50000, 100000, 500000};
+
+  struct ReadLatencyHistogram
+  {
+    // The number of reads that took at most as long as each bucket's bound. The last entry counts
+    // the reads that took longer than all bounds.
+    std::array<u64, READ_LATENCY_BUCKETS_US.size() + 1> bucket_counts;
+    u64 total_us;
+  };
+
+  // The time from queueing a read until the data has been read from the disc image. Can be called
+  // from any thread.
+  ReadLatencyHistogram GetReadLatencyHistogram() const;
+
 private:
   void StartDVDThread();
   void StopDVDThread();
   void WaitUntilIdle();
+  void CountReadLatency(u64 latency_us);
 
   void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offset, u32 length,
                          const DiscIO::Partition& partition, DVD::ReplyType reply_type,
@@ -135,13 +155,18 @@ private:
   Common::Event m_result_queue_expanded;                    // Is set by DVD thread
   Common::Flag m_dvd_thread_exiting = Common::Flag(false);  // Is set by CPU thread
 
-  Common::SPSCQueue<ReadRequest, false> m_request_queue;
-  Common::SPSCQueue<ReadResult, false> m_result_queue;
+  Common::SPSCSegmentedQueue<ReadRequest, false> m_request_queue;
+  Common::SPSCSegmentedQueue<ReadResult, false> m_result_queue;
   std::map<u64, ReadResult> m_result_map;
 
   std::unique_ptr<DiscIO::Volume> m_disc;
 
   FileMonitor::FileLogger m_file_logger;
+  ReadAheadCache m_read_ahead;
+
+  // Written by the DVD thread
+  std::array<std::atomic<u64>, READ_LATENCY_BUCKETS_US.size() + 1> m_read_latency_buckets{};
+  std::atomic<u64> m_read_latency_total_us = 0;
 
   Core::System& m_system;
 };
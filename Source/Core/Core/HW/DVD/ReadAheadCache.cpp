@@ -0,0 +1,153 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DVD/ReadAheadCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include "Common/CommonTypes.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/Filesystem.h"
+#include "DiscIO/Volume.h"
+
+namespace DVD
+{
+// Small enough that a prefetch doesn't hold up a read from the game for long.
+static constexpr u32 CHUNK_SIZE = 256 * 1024;
+
+void ReadAheadCache::SetMaxSize(size_t max_size)
+{
+  m_max_size = max_size;
+  Clear();
+}
+
+void ReadAheadCache::Clear()
+{
+  m_chunks.clear();
+  m_size = 0;
+  m_previous_partition = DiscIO::Partition();
+  m_previous_file_offset = 0;
+  m_prefetch_offset = 0;
+  m_prefetch_end = 0;
+}
+
+const ReadAheadCache::Chunk* ReadAheadCache::FindChunk(const DiscIO::Partition& partition,
+                                                       u64 offset) const
+{
+  const auto it = std::find_if(m_chunks.begin(), m_chunks.end(), [&](const Chunk& chunk) {
+    return chunk.partition == partition && offset >= chunk.offset &&
+           offset - chunk.offset < chunk.data.size();
+  });
+  return it != m_chunks.end() ? &*it : nullptr;
+}
+
+bool ReadAheadCache::Read(const DiscIO::Partition& partition, u64 offset, u32 length,
+                          u8* buffer) const
+{
+  if (m_chunks.empty())
+    return false;
+
+  // Make sure that the whole range is cached before copying anything
+  const u64 end = offset + length;
+  for (u64 position = offset; position < end;)
+  {
+    const Chunk* chunk = FindChunk(partition, position);
+    if (!chunk)
+      return false;
+    position = chunk->offset + chunk->data.size();
+  }
+
+  for (u64 position = offset; position < end;)
+  {
+    const Chunk* chunk = FindChunk(partition, position);
+    const u64 chunk_offset = position - chunk->offset;
+    const u64 copy_length = std::min<u64>(chunk->data.size() - chunk_offset, end - position);
+    std::memcpy(buffer + (position - offset), chunk->data.data() + chunk_offset, copy_length);
+    position += copy_length;
+  }
+
+  return true;
+}
+
+void ReadAheadCache::OnRead(const DiscIO::Volume& volume, const DiscIO::Partition& partition,
+                            u64 offset, u32 length)
+{
+  if (m_max_size == 0)
+    return;
+
+  const DiscIO::FileSystem* file_system = volume.GetFileSystem(partition);
+  if (!file_system)
+    return;
+
+  const std::unique_ptr<DiscIO::FileInfo> file_info = file_system->FindFileInfo(offset);
+  if (!file_info)
+  {
+    m_previous_partition = DiscIO::Partition();
+    return;
+  }
+
+  // A single read from a file doesn't say much, as it might only be a header. Only start
+  // prefetching once the game comes back for more.
+  const u64 file_offset = file_info->GetOffset();
+  const bool same_file = m_previous_partition == partition && m_previous_file_offset == file_offset;
+  m_previous_partition = partition;
+  m_previous_file_offset = file_offset;
+  if (!same_file)
+    return;
+
+  const u64 read_end = offset + length;
+  const u64 file_end = file_offset + file_info->GetSize();
+  if (read_end >= file_end)
+    return;
+
+  // Don't get so far ahead that prefetching evicts data the game hasn't read yet
+  m_prefetch_partition = partition;
+  m_prefetch_offset = read_end;
+  m_prefetch_end = std::min<u64>(file_end, read_end + m_max_size / 2);
+
+  // For plain disc images, this lets the OS fetch the whole range in the background while
+  // Prefetch goes through it one chunk at a time
+  const u64 raw_start = volume.PartitionOffsetToRawOffset(m_prefetch_offset, partition);
+  const u64 raw_end = volume.PartitionOffsetToRawOffset(m_prefetch_end, partition);
+  if (raw_end > raw_start)
+    volume.GetBlobReader().Prefetch(raw_start, raw_end - raw_start);
+}
+
+bool ReadAheadCache::Prefetch(const DiscIO::Volume& volume)
+{
+  while (m_prefetch_offset < m_prefetch_end)
+  {
+    if (const Chunk* chunk = FindChunk(m_prefetch_partition, m_prefetch_offset))
+    {
+      m_prefetch_offset = chunk->offset + chunk->data.size();
+      continue;
+    }
+
+    const u32 length =
+        static_cast<u32>(std::min<u64>(CHUNK_SIZE, m_prefetch_end - m_prefetch_offset));
+    std::vector<u8> data(length);
+    if (!volume.Read(m_prefetch_offset, length, data.data(), m_prefetch_partition))
+    {
+      m_prefetch_end = m_prefetch_offset;
+      return false;
+    }
+
+    m_chunks.push_back(Chunk{m_prefetch_partition, m_prefetch_offset, std::move(data)});
+    m_size += length;
+    m_prefetch_offset += length;
+
+    while (m_size > m_max_size)
+    {
+      m_size -= m_chunks.front().data.size();
+      m_chunks.pop_front();
+    }
+
+    return true;
+  }
+
+  return false;
+}
+}  // namespace DVD
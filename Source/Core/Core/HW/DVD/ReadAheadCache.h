@@ -0,0 +1,58 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "DiscIO/Volume.h"
+
+namespace DVD
+{
+// Prefetches the rest of the file that the game is currently streaming while the DVD thread is
+// otherwise idle, so that the following reads don't have to wait for the disc image (which can be
+// slow for compressed images on network storage). Only used on the DVD thread.
+class ReadAheadCache
+{
+public:
+  void SetMaxSize(size_t max_size);
+  void Clear();
+
+  // Copies the requested range into buffer and returns true if all of it is cached.
+  bool Read(const DiscIO::Partition& partition, u64 offset, u32 length, u8* buffer) const;
+
+  // Records a read issued by the game. If it continues a file that was read from before, the
+  // remainder of that file is queued for prefetching.
+  void OnRead(const DiscIO::Volume& volume, const DiscIO::Partition& partition, u64 offset,
+              u32 length);
+
+  // Reads one chunk of the queued prefetch range. Returns false if there is nothing left to do.
+  bool Prefetch(const DiscIO::Volume& volume);
+
+private:
+  struct Chunk
+  {
+    DiscIO::Partition partition;
+    u64 offset;
+    std::vector<u8> data;
+  };
+
+  const Chunk* FindChunk(const DiscIO::Partition& partition, u64 offset) const;
+
+  // Oldest first
+  std::deque<Chunk> m_chunks;
+  size_t m_size = 0;
+  size_t m_max_size = 0;
+
+  // The file accessed by the previous read
+  DiscIO::Partition m_previous_partition;
+  u64 m_previous_file_offset = 0;
+
+  DiscIO::Partition m_prefetch_partition;
+  u64 m_prefetch_offset = 0;
+  u64 m_prefetch_end = 0;
+};
+}  // namespace DVD
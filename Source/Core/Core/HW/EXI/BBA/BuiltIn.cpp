@@ -137,7 +137,7 @@ bool CEXIETHERNET::BuiltInBBAInterface::WillQueueOverrun() const
   return ((m_queue_write + 1) & 15) == m_queue_read;
 }
 
-void CEXIETHERNET::BuiltInBBAInterface::PollData(std::size_t* datasize)
+void CEXIETHERNET::BuiltInBBAInterface::PollData()
 {
   for (auto& net_ref : m_network_ref)
   {
@@ -161,28 +161,15 @@ void CEXIETHERNET::BuiltInBBAInterface::PollData(std::size_t* datasize)
     }
 
     // Check for connection data
-    if (*datasize == 0)
-    {
-      // Send it to the network buffer if empty
-      const auto socket_data = TryGetDataFromSocket(&net_ref);
-      if (socket_data.has_value())
-      {
-        *datasize = socket_data->size();
-        std::memcpy(m_eth_ref->mRecvBuffer.get(), socket_data->data(), *datasize);
-      }
-    }
-    else if (!WillQueueOverrun())
-    {
-      // Otherwise, enqueue it
-      const auto socket_data = TryGetDataFromSocket(&net_ref);
-      if (socket_data.has_value())
-        WriteToQueue(*socket_data);
-    }
-    else
+    if (WillQueueOverrun())
     {
       WARN_LOG_FMT(SP1, "BBA queue might overrun, can't poll more data");
       return;
     }
+
+    const auto socket_data = TryGetDataFromSocket(&net_ref);
+    if (socket_data.has_value())
+      WriteToQueue(*socket_data);
   }
 }
 
@@ -694,12 +681,53 @@ bool CEXIETHERNET::BuiltInBBAInterface::SendFrame(const u8* frame, u32 size)
   return true;
 }
 
+bool CEXIETHERNET::BuiltInBBAInterface::CanReceiveFrame() const
+{
+  u8 wp = m_eth_ref->page_ptr(BBA_RWP);
+  const u8 rp = m_eth_ref->page_ptr(BBA_RRP);
+  if (rp > wp)
+    wp += 16;
+
+  return (wp - rp) < 8;
+}
+
+void CEXIETHERNET::BuiltInBBAInterface::ReceiveQueuedFrame()
+{
+  const std::vector<u8>& frame = m_queue_data[m_queue_read];
+  std::size_t datasize = frame.size();
+  if (datasize > BBA_RECV_SIZE)
+  {
+    ERROR_LOG_FMT(SP1, "Frame size is exceiding BBA capacity, frame stack might be corrupted"
+                       "Killing Dolphin...");
+    std::exit(0);
+  }
+
+  u8* buffer = reinterpret_cast<u8*>(m_eth_ref->mRecvBuffer.get());
+  std::memcpy(buffer, frame.data(), datasize);
+  m_queue_read++;
+  m_queue_read &= 15;
+
+  Common::PacketView packet(buffer, datasize);
+  const auto packet_type = packet.GetEtherType();
+  if (packet_type.has_value() && packet_type == Common::IPV4_ETHERTYPE)
+  {
+    SetIPIdentification(buffer, datasize, ++m_ip_frame_id);
+  }
+  if (datasize < 64)
+  {
+    std::fill(buffer + datasize, buffer + 64, 0);
+    datasize = 64;
+  }
+  m_eth_ref->mRecvBufferLength = static_cast<u32>(datasize);
+  m_eth_ref->RecvHandlePacket();
+}
+
 void CEXIETHERNET::BuiltInBBAInterface::ReadThreadHandler(CEXIETHERNET::BuiltInBBAInterface* self)
 {
-  std::size_t datasize = 0;
+  std::size_t frames_received = 0;
   while (!self->m_read_thread_shutdown.IsSet())
   {
-    if (datasize == 0)
+    if (frames_received == 0)
     {
       // Make thread less CPU hungry
       std::this_thread::sleep_for(std::chrono::milliseconds(1));
@@ -708,57 +736,24 @@ void CEXIETHERNET::BuiltInBBAInterface::ReadThreadHandler(CEXIETHERNET::BuiltInB
     if (!self->m_read_enabled.IsSet())
       continue;
 
-    u8 wp = self->m_eth_ref->page_ptr(BBA_RWP);
-    const u8 rp = self->m_eth_ref->page_ptr(BBA_RRP);
-    if (rp > wp)
-      wp += 16;
-
-    if ((wp - rp) >= 8)
+    if (!self->CanReceiveFrame())
       continue;
 
     std::lock_guard<std::mutex> lock(self->m_mtx);
-    // process queue file first
-    if (self->m_queue_read != self->m_queue_write)
-    {
-      datasize = self->m_queue_data[self->m_queue_read].size();
-      if (datasize > BBA_RECV_SIZE)
-      {
-        ERROR_LOG_FMT(SP1, "Frame size is exceiding BBA capacity, frame stack might be corrupted"
-                           "Killing Dolphin...");
-        std::exit(0);
-      }
-      std::memcpy(self->m_eth_ref->mRecvBuffer.get(), self->m_queue_data[self->m_queue_read].data(),
-                  datasize);
-      self->m_queue_read++;
-      self->m_queue_read &= 15;
-    }
-    else
-    {
-      datasize = 0;
-    }
 
     // Check network stack references
-    self->PollData(&datasize);
+    self->PollData();
 
     // Check for new UPnP client
     self->HandleUPnPClient();
 
-    if (datasize > 0)
+    // Pass as many queued frames as the receive buffer can take, rather than polling every
+    // socket again for each of them
+    frames_received = 0;
+    while (self->m_queue_read != self->m_queue_write && self->CanReceiveFrame())
     {
-      u8* buffer = reinterpret_cast<u8*>(self->m_eth_ref->mRecvBuffer.get());
-      Common::PacketView packet(buffer, datasize);
-      const auto packet_type = packet.GetEtherType();
-      if (packet_type.has_value() && packet_type == Common::IPV4_ETHERTYPE)
-      {
-        SetIPIdentification(buffer, datasize, ++self->m_ip_frame_id);
-      }
-      if (datasize < 64)
-      {
-        std::fill(buffer + datasize, buffer + 64, 0);
-        datasize = 64;
-      }
-      self->m_eth_ref->mRecvBufferLength = static_cast<u32>(datasize);
-      self->m_eth_ref->RecvHandlePacket();
+      self->ReceiveQueuedFrame();
+      ++frames_received;
     }
   }
 }
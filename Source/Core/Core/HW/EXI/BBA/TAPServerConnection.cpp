@@ -14,6 +14,8 @@
 #include <unistd.h>
 #endif
 
+#include <algorithm>
+#include <array>
 #include <cstdlib>
 #include <cstring>
 
@@ -243,16 +245,20 @@ void TAPServerConnection::ReadThreadHandler()
   enum class ReadState
   {
     SIZE,
-    SIZE_HIGH,
     DATA,
     SKIP,
   };
   ReadState read_state = ReadState::SIZE;
 
+  std::size_t size_bytes_received = 0;
   std::size_t frame_bytes_received = 0;
   std::size_t frame_bytes_expected = 0;
   std::string frame_data;
 
+  // Everything that is available is read at once and may contain several frames, rather than
+  // reading the size field and the data of each frame with separate calls.
+  std::array<char, 0x10000> buffer;
+
   while (!m_read_shutdown.IsSet())
   {
     fd_set rfds;
@@ -271,93 +277,66 @@ void TAPServerConnection::ReadThreadHandler()
     if (select_res == 0)
       continue;
 
+    const ws_ssize_t recv_res = recv(m_fd, buffer.data(), static_cast<int>(buffer.size()), 0);
+    if (recv_res <= 0)
+    {
+      ERROR_LOG_FMT(SP1, "Failed to read data from destination: {}", Common::StrNetworkError());
+      continue;
+    }
+    const std::size_t bytes_read = static_cast<std::size_t>(recv_res);
+
     // The tapserver protocol is very simple: there is a 16-bit little-endian
     // size field, followed by that many bytes of packet data
-    switch (read_state)
-    {
-    case ReadState::SIZE:
+    std::size_t offset = 0;
+    while (offset < bytes_read)
     {
-      u8 size_bytes[2];
-      const ws_ssize_t bytes_read = recv(m_fd, reinterpret_cast<char*>(size_bytes), 2, 0);
-      if (bytes_read == 1)
-      {
-        read_state = ReadState::SIZE_HIGH;
-        frame_bytes_expected = size_bytes[0];
-      }
-      else if (bytes_read == 2)
+      if (read_state == ReadState::SIZE)
       {
-        frame_bytes_expected = size_bytes[0] | (size_bytes[1] << 8);
-        frame_data.resize(frame_bytes_expected, '\0');
+        frame_bytes_expected |= static_cast<std::size_t>(static_cast<u8>(buffer[offset++]))
+                                << (size_bytes_received * 8);
+        if (++size_bytes_received < 2)
+          continue;
+
         if (frame_bytes_expected > m_max_frame_size)
         {
           ERROR_LOG_FMT(SP1, "Packet is too large ({} bytes); dropping it", frame_bytes_expected);
           read_state = ReadState::SKIP;
         }
+        else if (frame_bytes_expected == 0)
+        {
+          read_state = ReadState::SKIP;
+        }
         else
         {
           // If read is disabled, we still need to actually read the frame in
           // order to avoid applying backpressure on the remote end, but we
           // should drop the frame instead of forwarding it to the client.
           read_state = m_read_enabled.IsSet() ? ReadState::DATA : ReadState::SKIP;
+          frame_data.reserve(frame_bytes_expected);
         }
       }
       else
       {
-        ERROR_LOG_FMT(SP1, "Failed to read size field from destination: {}",
-                      Common::StrNetworkError());
-      }
-      break;
-    }
-    case ReadState::SIZE_HIGH:
-    {
-      // This handles the annoying case where only one byte of the size field
-      // was available earlier.
-      u8 size_high = 0;
-      const ws_ssize_t bytes_read = recv(m_fd, reinterpret_cast<char*>(&size_high), 1, 0);
-      if (bytes_read != 1)
-      {
-        ERROR_LOG_FMT(SP1, "Failed to read split size field from destination: {}",
-                      Common::StrNetworkError());
-        break;
-      }
-      frame_bytes_expected |= (size_high << 8);
-      frame_data.resize(frame_bytes_expected, '\0');
-      if (frame_bytes_expected > m_max_frame_size)
-      {
-        ERROR_LOG_FMT(SP1, "Packet is too large ({} bytes); dropping it", frame_bytes_expected);
-        read_state = ReadState::SKIP;
-      }
-      else
-      {
-        read_state = m_read_enabled.IsSet() ? ReadState::DATA : ReadState::SKIP;
-      }
-      break;
-    }
-    case ReadState::DATA:
-    case ReadState::SKIP:
-    {
-      const std::size_t bytes_to_read = frame_data.size() - frame_bytes_received;
-      const ws_ssize_t bytes_read = recv(m_fd, frame_data.data() + frame_bytes_received,
-                                         static_cast<ws_ssize_t>(bytes_to_read), 0);
-      if (bytes_read <= 0)
-      {
-        ERROR_LOG_FMT(SP1, "Failed to read data from destination: {}", Common::StrNetworkError());
-        break;
+        const std::size_t bytes_to_copy =
+            std::min(frame_bytes_expected - frame_bytes_received, bytes_read - offset);
+        if (read_state == ReadState::DATA)
+          frame_data.append(buffer.data() + offset, bytes_to_copy);
+        frame_bytes_received += bytes_to_copy;
+        offset += bytes_to_copy;
       }
-      frame_bytes_received += bytes_read;
-      if (frame_bytes_received == frame_bytes_expected)
+
+      if (read_state != ReadState::SIZE && frame_bytes_received == frame_bytes_expected)
       {
         if (read_state == ReadState::DATA)
         {
           m_recv_cb(std::move(frame_data));
         }
         frame_data.clear();
+        size_bytes_received = 0;
         frame_bytes_received = 0;
         frame_bytes_expected = 0;
         read_state = ReadState::SIZE;
       }
-      break;
-    }
     }
   }
 }
@@ -4,6 +4,7 @@
 #include "Core/HW/EXI/EXI_DeviceEthernet.h"
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <optional>
 #include <string>
@@ -540,6 +541,28 @@ inline void CEXIETHERNET::set_rwp(u16 value)
 
 // This function is on the critical path for receiving data.
 // Be very careful about calling into the logger and other slow things
+void CEXIETHERNET::UpdateRecvStats()
+{
+  static constexpr auto LOG_INTERVAL = std::chrono::seconds(10);
+
+  const auto now = std::chrono::steady_clock::now();
+  if (m_recv_stats_frames == 0)
+    m_recv_stats_start = now;
+
+  m_recv_stats_frames++;
+  m_recv_stats_bytes += mRecvBufferLength;
+
+  const std::chrono::duration<double> elapsed = now - m_recv_stats_start;
+  if (elapsed < LOG_INTERVAL)
+    return;
+
+  INFO_LOG_FMT(SP1, "Received {} frames ({} bytes) in {:.1f} s, {:.1f} frames/s",
+               m_recv_stats_frames, m_recv_stats_bytes, elapsed.count(),
+               m_recv_stats_frames / elapsed.count());
+  m_recv_stats_frames = 0;
+  m_recv_stats_bytes = 0;
+}
+
 bool CEXIETHERNET::RecvHandlePacket()
 {
   u8* write_ptr;
@@ -624,6 +647,7 @@ bool CEXIETHERNET::RecvHandlePacket()
   }
 
   descriptor->set(current_rwp, 4 + mRecvBufferLength, status);
+  UpdateRecvStats();
 
   set_rwp(current_rwp);
 
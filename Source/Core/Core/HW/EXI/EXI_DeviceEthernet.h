@@ -4,6 +4,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <map>
 #include <mutex>
 #include <thread>
@@ -309,6 +310,7 @@ private:
   void inc_rwp();
   void set_rwp(u16 value);
   bool RecvHandlePacket();
+  void UpdateRecvStats();
 
   std::unique_ptr<u8[]> mBbaMem;
   std::unique_ptr<u8[]> tx_fifo;
@@ -464,7 +466,9 @@ private:
 #endif
     void WriteToQueue(const std::vector<u8>& data);
     bool WillQueueOverrun() const;
-    void PollData(std::size_t* datasize);
+    bool CanReceiveFrame() const;
+    void ReceiveQueuedFrame();
+    void PollData();
     std::optional<std::vector<u8>> TryGetDataFromSocket(StackRef* ref);
 
     void HandleARP(const Common::ARPPacket& packet);
@@ -480,5 +484,10 @@ private:
 
   std::unique_ptr<u8[]> mRecvBuffer;
   u32 mRecvBufferLength = 0;
+
+  // Frames received since m_recv_stats_start, periodically logged to measure the packet rate
+  u32 m_recv_stats_frames = 0;
+  u64 m_recv_stats_bytes = 0;
+  std::chrono::steady_clock::time_point m_recv_stats_start;
 };
 }  // namespace ExpansionInterface
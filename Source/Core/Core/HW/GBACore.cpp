@@ -3,6 +3,8 @@
 
 #include "Core/HW/GBACore.h"
 
+#include <utility>
+
 #define PYCPARSE  // Remove static functions from the header
 #include <mgba/core/interface.h>
 #undef PYCPARSE
@@ -479,8 +481,9 @@ void Core::SendJoybusCommand(u64 gc_ticks, int transfer_time, u8* buffer, u16 ke
   {
     std::lock_guard<std::mutex> lock(m_queue_mutex);
     m_command_queue.push(command);
-    m_idle = false;
-    m_command_cv.notify_one();
+    // A busy thread picks the command up after its current batch without being woken up
+    if (std::exchange(m_idle, false))
+      m_command_cv.notify_one();
   }
   else
   {
@@ -514,21 +517,25 @@ void Core::ThreadLoop()
 {
   Common::SetCurrentThreadName(fmt::format("GBA{}", m_device_number + 1).c_str());
   std::unique_lock<std::mutex> queue_lock(m_queue_mutex);
+  std::queue<Command> commands;
   while (true)
   {
     m_command_cv.wait(queue_lock, [&] { return !m_command_queue.empty() || m_exit_loop; });
     if (m_exit_loop)
       break;
-    Command command{m_command_queue.front()};
-    m_command_queue.pop();
+    // Take every queued command at once instead of locking the queue for each of them
+    std::swap(commands, m_command_queue);
     queue_lock.unlock();
 
-    RunCommand(command);
+    for (; !commands.empty(); commands.pop())
+      RunCommand(commands.front());
 
     queue_lock.lock();
     if (m_command_queue.empty())
+    {
       m_idle = true;
-    m_response_cv.notify_one();
+      m_response_cv.notify_one();
+    }
   }
 }
 
@@ -3,12 +3,15 @@
 
 #include "Core/HW/GCMemcard/GCMemcardRaw.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstring>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -79,6 +82,7 @@ MemoryCard::MemoryCard(const std::string& filename, ExpansionInterface::Slot car
   // Class members (including inherited ones) have now been initialized, so
   // it's safe to startup the flush thread (which reads them).
   m_flush_buffer = std::make_unique<u8[]>(m_memory_card_size);
+  m_dirty_blocks.resize((m_memory_card_size + Memcard::BLOCK_SIZE - 1) / Memcard::BLOCK_SIZE);
   m_flush_thread = std::thread(&MemoryCard::FlushThread, this);
 }
 
@@ -121,6 +125,8 @@ void MemoryCard::FlushThread()
     // file doesn't disappear out from under us after the first check.
     File::IOFile file(m_filename, "r+b");
 
+    // Only the modified blocks are written, unless the file doesn't match the card anymore.
+    const bool write_all = !file || file.GetSize() != m_memory_card_size;
     if (!file)
     {
       std::string dir;
@@ -147,15 +153,58 @@ void MemoryCard::FlushThread()
       return;
     }
 
+    const auto start_time = std::chrono::steady_clock::now();
+
+    // Runs of consecutive modified blocks, as (offset, size) pairs, so that each run is written
+    // with a single call.
+    std::vector<std::pair<u32, u32>> dirty_ranges;
     {
       std::unique_lock l(m_flush_mutex);
-      memcpy(&m_flush_buffer[0], &m_memcard_data[0], m_memory_card_size);
+      if (write_all)
+        std::fill(m_dirty_blocks.begin(), m_dirty_blocks.end(), true);
+
+      for (size_t block = 0; block < m_dirty_blocks.size();)
+      {
+        if (!m_dirty_blocks[block])
+        {
+          ++block;
+          continue;
+        }
+
+        const size_t first_block = block;
+        for (; block < m_dirty_blocks.size() && m_dirty_blocks[block]; ++block)
+          m_dirty_blocks[block] = false;
+
+        const u32 offset = static_cast<u32>(first_block * Memcard::BLOCK_SIZE);
+        const u32 end = std::min(static_cast<u32>(block * Memcard::BLOCK_SIZE), m_memory_card_size);
+        memcpy(&m_flush_buffer[offset], &m_memcard_data[offset], end - offset);
+        dirty_ranges.emplace_back(offset, end - offset);
+      }
+    }
+
+    u32 bytes_written = 0;
+    for (const auto& [offset, size] : dirty_ranges)
+    {
+      file.Seek(offset, File::SeekOrigin::Begin);
+      file.WriteBytes(&m_flush_buffer[offset], size);
+      bytes_written += size;
+    }
+    file.Close();
+
+    if (!dirty_ranges.empty())
+    {
+      const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start_time);
+      INFO_LOG_FMT(EXPANSIONINTERFACE, "Flushed {} bytes in {} writes to {} in {} us",
+                   bytes_written, dirty_ranges.size(), m_filename, duration.count());
     }
-    file.WriteBytes(&m_flush_buffer[0], m_memory_card_size);
 
     if (do_exit)
       return;
 
+    if (dirty_ranges.empty())
+      continue;
+
     Core::DisplayMessage(fmt::format("Wrote to Memory Card {}",
                                      m_card_slot == ExpansionInterface::Slot::A ? 'A' : 'B'),
                          4000);
@@ -167,6 +216,16 @@ void MemoryCard::MakeDirty()
   m_dirty.Set();
 }
 
+void MemoryCard::MarkBlocksDirty(u32 address, u32 length)
+{
+  if (length == 0)
+    return;
+
+  const u32 last_block = (address + length - 1) / Memcard::BLOCK_SIZE;
+  for (u32 block = address / Memcard::BLOCK_SIZE; block <= last_block; ++block)
+    m_dirty_blocks[block] = true;
+}
+
 s32 MemoryCard::Read(u32 src_address, s32 length, u8* dest_address)
 {
   if (!IsAddressInBounds(src_address, length))
@@ -191,6 +250,7 @@ s32 MemoryCard::Write(u32 dest_address, s32 length, const u8* src_address)
   {
     std::unique_lock l(m_flush_mutex);
     memcpy(&m_memcard_data[dest_address], src_address, length);
+    MarkBlocksDirty(dest_address, length);
   }
   MakeDirty();
   return length;
@@ -207,6 +267,7 @@ void MemoryCard::ClearBlock(u32 address)
   {
     std::unique_lock l(m_flush_mutex);
     memset(&m_memcard_data[address], 0xFF, Memcard::BLOCK_SIZE);
+    MarkBlocksDirty(address, Memcard::BLOCK_SIZE);
   }
   MakeDirty();
 }
@@ -216,6 +277,7 @@ void MemoryCard::ClearAll()
   {
     std::unique_lock l(m_flush_mutex);
     memset(&m_memcard_data[0], 0xFF, m_memory_card_size);
+    MarkBlocksDirty(0, m_memory_card_size);
   }
   MakeDirty();
 }
@@ -225,4 +287,12 @@ void MemoryCard::DoState(PointerWrap& p)
   p.Do(m_card_slot);
   p.Do(m_memory_card_size);
   p.DoArray(&m_memcard_data[0], m_memory_card_size);
+
+  // Loading a state doesn't flush the card by itself, but the next flush has to replace
+  // everything that was written before the state was saved, not only the blocks modified since.
+  if (p.IsReadMode())
+  {
+    std::unique_lock l(m_flush_mutex);
+    std::fill(m_dirty_blocks.begin(), m_dirty_blocks.end(), true);
+  }
 }
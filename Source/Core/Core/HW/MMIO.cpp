@@ -3,10 +3,16 @@
 
 #include "Core/HW/MMIO.h"
 
+#include <algorithm>
+#include <atomic>
 #include <functional>
+#include <utility>
+#include <vector>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/HW/MMIOHandlers.h"
 
 namespace MMIO
@@ -22,6 +28,7 @@ class ReadHandlingMethod
 public:
   virtual ~ReadHandlingMethod() = default;
   virtual void AcceptReadVisitor(ReadHandlingMethodVisitor<T>& v) const = 0;
+  virtual u64 GetAccessCount() const { return 0; }
 };
 template <typename T>
 class WriteHandlingMethod
@@ -29,8 +36,36 @@ class WriteHandlingMethod
 public:
   virtual ~WriteHandlingMethod() = default;
   virtual void AcceptWriteVisitor(WriteHandlingMethodVisitor<T>& v) const = 0;
+  virtual u64 GetAccessCount() const { return 0; }
 };
 
+// Whether to count the calls to handler lambdas is decided when the lambda is
+// registered, so that the counting costs nothing when it's disabled.
+template <typename T>
+static std::function<T(Core::System&, u32)>
+CountReadAccesses(std::function<T(Core::System&, u32)> lambda, std::atomic<u64>* counter)
+{
+  if (!Config::Get(Config::MAIN_DEBUG_COUNT_MMIO_ACCESSES))
+    return lambda;
+
+  return [lambda = std::move(lambda), counter](Core::System& system, u32 addr) {
+    counter->fetch_add(1, std::memory_order_relaxed);
+    return lambda(system, addr);
+  };
+}
+template <typename T>
+static std::function<void(Core::System&, u32, T)>
+CountWriteAccesses(std::function<void(Core::System&, u32, T)> lambda, std::atomic<u64>* counter)
+{
+  if (!Config::Get(Config::MAIN_DEBUG_COUNT_MMIO_ACCESSES))
+    return lambda;
+
+  return [lambda = std::move(lambda), counter](Core::System& system, u32 addr, T val) {
+    counter->fetch_add(1, std::memory_order_relaxed);
+    lambda(system, addr, val);
+  };
+}
+
 // Constant: handling method holds a single integer and passes it to the
 // visitor. This is a read only handling method: storing to a constant does not
 // mean anything.
@@ -113,12 +148,14 @@ class ComplexHandlingMethod : public ReadHandlingMethod<T>, public WriteHandling
 {
 public:
   explicit ComplexHandlingMethod(std::function<T(Core::System&, u32)> read_lambda)
-      : read_lambda_(read_lambda), write_lambda_(InvalidWriteLambda())
+      : read_lambda_(CountReadAccesses(std::move(read_lambda), &access_count_)),
+        write_lambda_(InvalidWriteLambda())
   {
   }
 
   explicit ComplexHandlingMethod(std::function<void(Core::System&, u32, T)> write_lambda)
-      : read_lambda_(InvalidReadLambda()), write_lambda_(write_lambda)
+      : read_lambda_(InvalidReadLambda()),
+        write_lambda_(CountWriteAccesses(std::move(write_lambda), &access_count_))
   {
   }
 
@@ -133,6 +170,8 @@ public:
     v.VisitComplex(&write_lambda_);
   }
 
+  u64 GetAccessCount() const override { return access_count_.load(std::memory_order_relaxed); }
+
 private:
   std::function<T(Core::System&, u32)> InvalidReadLambda() const
   {
@@ -153,6 +192,7 @@ private:
     };
   }
 
+  std::atomic<u64> access_count_ = 0;
   std::function<T(Core::System&, u32)> read_lambda_;
   std::function<void(Core::System&, u32, T)> write_lambda_;
 };
@@ -167,6 +207,41 @@ WriteHandlingMethod<T>* ComplexWrite(std::function<void(Core::System&, u32, T)>
   return new ComplexHandlingMethod<T>(lambda);
 }
 
+// ConditionalDirect: holds everything Direct and Complex read handling methods
+// hold, as well as a pointer to the flag that decides which of the two to use.
+template <typename T>
+class ConditionalDirectHandlingMethod : public ReadHandlingMethod<T>
+{
+public:
+  ConditionalDirectHandlingMethod(const T* addr, u32 mask, const bool* use_direct,
+                                  std::function<T(Core::System&, u32)> lambda)
+      : addr_(addr), mask_(mask), use_direct_(use_direct),
+        lambda_(CountReadAccesses(std::move(lambda), &access_count_))
+  {
+  }
+  virtual ~ConditionalDirectHandlingMethod() = default;
+  void AcceptReadVisitor(ReadHandlingMethodVisitor<T>& v) const override
+  {
+    v.VisitConditionalDirect(addr_, mask_, use_direct_, &lambda_);
+  }
+
+  u64 GetAccessCount() const override { return access_count_.load(std::memory_order_relaxed); }
+
+private:
+  const T* addr_;
+  u32 mask_;
+  const bool* use_direct_;
+  std::atomic<u64> access_count_ = 0;
+  std::function<T(Core::System&, u32)> lambda_;
+};
+template <typename T>
+ReadHandlingMethod<T>* ConditionalDirectRead(const T* addr, const bool* use_direct,
+                                             std::function<T(Core::System&, u32)> lambda,
+                                             u32 mask)
+{
+  return new ConditionalDirectHandlingMethod<T>(addr, mask, use_direct, std::move(lambda));
+}
+
 // Invalid: specialization of the complex handling type with lambdas that
 // display error messages.
 template <typename T>
@@ -303,6 +378,12 @@ T ReadHandler<T>::Read(Core::System& system, u32 addr)
   return m_ReadFunc(system, addr);
 }
 
+template <typename T>
+u64 ReadHandler<T>::GetAccessCount() const
+{
+  return m_Method ? m_Method->GetAccessCount() : 0;
+}
+
 template <typename T>
 void ReadHandler<T>::ResetMethod(ReadHandlingMethod<T>* method)
 {
@@ -328,6 +409,14 @@ void ReadHandler<T>::ResetMethod(ReadHandlingMethod<T>* method)
     {
       ret = *lambda;
     }
+
+    void VisitConditionalDirect(const T* addr, u32 mask, const bool* use_direct,
+                                const std::function<T(Core::System&, u32)>* lambda) override
+    {
+      ret = [addr, mask, use_direct, lambda](Core::System& system, u32 address) {
+        return *use_direct ? static_cast<T>(*addr & mask) : (*lambda)(system, address);
+      };
+    }
   };
 
   FuncCreatorVisitor v;
@@ -378,6 +467,12 @@ void WriteHandler<T>::Write(Core::System& system, u32 addr, T val)
   m_WriteFunc(system, addr, val);
 }
 
+template <typename T>
+u64 WriteHandler<T>::GetAccessCount() const
+{
+  return m_Method ? m_Method->GetAccessCount() : 0;
+}
+
 template <typename T>
 void WriteHandler<T>::ResetMethod(WriteHandlingMethod<T>* method)
 {
@@ -416,6 +511,51 @@ void WriteHandler<T>::InitializeInvalid()
   ResetMethod(InvalidWrite<T>());
 }
 
+void Mapping::LogAccessCounts() const
+{
+  struct Entry
+  {
+    u64 count;
+    u32 address;
+    u32 size;
+    bool write;
+  };
+  std::vector<Entry> entries;
+
+  const auto collect = [&entries](const auto& handlers, u32 size, bool write) {
+    for (size_t i = 0; i < handlers.size(); ++i)
+    {
+      const u64 count = handlers[i].GetAccessCount();
+      if (count == 0)
+        continue;
+
+      // Turn the unique ID back into an address
+      const u32 id = static_cast<u32>(i * size);
+      const u32 address = ((id >> 16) != 0 ? 0x0D000000 : 0x0C000000) | (id & 0xFFFF);
+      entries.push_back({count, address, size, write});
+    }
+  };
+  collect(m_read_handlers8, 1, false);
+  collect(m_read_handlers16, 2, false);
+  collect(m_read_handlers32, 4, false);
+  collect(m_write_handlers8, 1, true);
+  collect(m_write_handlers16, 2, true);
+  collect(m_write_handlers32, 4, true);
+  if (entries.empty())
+    return;
+
+  std::ranges::sort(entries, [](const Entry& a, const Entry& b) { return a.count > b.count; });
+
+  constexpr size_t MAX_ENTRIES = 32;
+  NOTICE_LOG_FMT(MEMMAP, "MMIO accesses which had to call a handler function:");
+  for (size_t i = 0; i < std::min(entries.size(), MAX_ENTRIES); ++i)
+  {
+    const Entry& entry = entries[i];
+    NOTICE_LOG_FMT(MEMMAP, "  {:08x} {:2}-bit {}: {}", entry.address, entry.size * 8,
+                   entry.write ? "write" : "read ", entry.count);
+  }
+}
+
 // Define all the public specializations that are exported in MMIOHandlers.h.
 #define MaybeExtern
 MMIO_PUBLIC_SPECIALIZATIONS()
@@ -162,6 +162,11 @@ public:
     return GetWriteHandler<Unit>(UniqueID(addr) / sizeof(Unit));
   }
 
+  // Logs the MMIOs which called handler functions the most often. The calls are
+  // only counted while MAIN_DEBUG_COUNT_MMIO_ACCESSES is enabled. This is meant to
+  // show which registers would be worth making accessible without a call.
+  void LogAccessCounts() const;
+
 private:
   // These arrays contain the handlers for each MMIO access type: read/write
   // to 8/16/32 bits. They are indexed using the UniqueID(addr) function
@@ -59,6 +59,16 @@ ReadHandlingMethod<T>* ComplexRead(std::function<T(Core::System&, u32)>);
 template <typename T>
 WriteHandlingMethod<T>* ComplexWrite(std::function<void(Core::System&, u32, T)>);
 
+// ConditionalDirect: use for frequently read MMIOs which can usually be read
+// directly, but sometimes need some work to be done first (e.g. syncing with
+// the GPU thread). While the flag at "use_direct" is set, this behaves like
+// Direct, and otherwise the lambda is called. This lets the JITs emit the
+// check and the direct read inline and only call out in the uncommon case.
+template <typename T>
+ReadHandlingMethod<T>* ConditionalDirectRead(const T* addr, const bool* use_direct,
+                                             std::function<T(Core::System&, u32)> lambda,
+                                             u32 mask = 0xFFFFFFFF);
+
 // Invalid: log an error and return -1 in case of a read. These are the default
 // handlers set for all MMIO types.
 template <typename T>
@@ -102,6 +112,8 @@ public:
   virtual void VisitConstant(T value) = 0;
   virtual void VisitDirect(const T* addr, u32 mask) = 0;
   virtual void VisitComplex(const std::function<T(Core::System&, u32)>* lambda) = 0;
+  virtual void VisitConditionalDirect(const T* addr, u32 mask, const bool* use_direct,
+                                      const std::function<T(Core::System&, u32)>* lambda) = 0;
 };
 template <typename T>
 class WriteHandlingMethodVisitor
@@ -132,6 +144,10 @@ public:
 
   T Read(Core::System& system, u32 addr);
 
+  // Number of times the handler had to call a lambda. Only counted while
+  // MAIN_DEBUG_COUNT_MMIO_ACCESSES is enabled.
+  u64 GetAccessCount() const;
+
   // Internal method called when changing the internal method object. Its
   // main role is to make sure the read function is updated at the same time.
   void ResetMethod(ReadHandlingMethod<T>* method);
@@ -159,6 +175,10 @@ public:
 
   void Write(Core::System& system, u32 addr, T val);
 
+  // Number of times the handler had to call a lambda. Only counted while
+  // MAIN_DEBUG_COUNT_MMIO_ACCESSES is enabled.
+  u64 GetAccessCount() const;
+
   // Internal method called when changing the internal method object. Its
   // main role is to make sure the write function is updated at the same
   // time.
@@ -190,6 +210,8 @@ private:
       std::function<T(Core::System&, u32)>);                                                       \
   MaybeExtern template WriteHandlingMethod<T>* ComplexWrite<T>(                                    \
       std::function<void(Core::System&, u32, T)>);                                                 \
+  MaybeExtern template ReadHandlingMethod<T>* ConditionalDirectRead<T>(                            \
+      const T* addr, const bool* use_direct, std::function<T(Core::System&, u32)>, u32 mask);      \
   MaybeExtern template ReadHandlingMethod<T>* InvalidRead<T>();                                    \
   MaybeExtern template WriteHandlingMethod<T>* InvalidWrite<T>();                                  \
   MaybeExtern template class ReadHandler<T>;                                                       \
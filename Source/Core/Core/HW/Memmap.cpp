@@ -17,8 +17,10 @@
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Hash.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemArena.h"
+#include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
 #include "Core/Config/MainSettings.h"
@@ -33,12 +35,17 @@
 #include "Core/HW/SI/SI.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/HW/WII_IPC.h"
+#include "Core/MemTools.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/PixelEngine.h"
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 namespace Memory
 {
 MemoryManager::MemoryManager(Core::System& system) : m_system(system)
@@ -121,7 +128,7 @@ void MemoryManager::Init()
     region.active = true;
     mem_size += region.size;
   }
-  m_arena.GrabSHMSegment(mem_size, "dolphin-emu");
+  m_arena.GrabSHMSegment(mem_size, "dolphin-emu", Config::Get(Config::MAIN_HUGE_PAGES));
 
   m_physical_page_mappings.fill(nullptr);
 
@@ -155,6 +162,16 @@ void MemoryManager::Init()
 
   Clear();
 
+#if defined(__APPLE__) || defined(_M_GENERIC)
+  // On macOS, faults are only forwarded to the fault handler for the CPU thread.
+  m_write_tracking_supported = false;
+#elif defined(_WIN32)
+  m_write_tracking_supported = EMM::IsExceptionHandlerSupported();
+#else
+  m_write_tracking_supported = EMM::IsExceptionHandlerSupported() &&
+                               sysconf(_SC_PAGESIZE) == WRITE_TRACKING_PAGE_SIZE;
+#endif
+
   INFO_LOG_FMT(MEMMAP, "Memory system initialized. RAM at {}", fmt::ptr(m_ram));
   m_is_initialized = true;
 }
@@ -230,16 +247,31 @@ bool MemoryManager::InitFastmemArena()
 
   m_is_fastmem_arena_initialized = true;
   m_fastmem_arena_size = memory_size;
+
+#ifdef _WIN32
+  // Views can only be placed with the allocation granularity of 64 KiB.
+  m_page_table_mapping_enabled = false;
+#else
+  m_page_table_mapping_enabled = sysconf(_SC_PAGESIZE) == PowerPC::HW_PAGE_SIZE;
+#endif
+  if (m_page_table_mapping_enabled)
+    m_page_table_mapped_pages.assign(0x1'0000'0000 / PowerPC::HW_PAGE_SIZE, false);
+
   return true;
 }
 
 void MemoryManager::UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
 {
+  // The new views would not be write-protected, so simply stop tracking everything.
+  std::lock_guard lk(m_write_tracking_mutex);
+  ResetWriteTracking();
+
   for (auto& entry : m_logical_mapped_entries)
   {
     m_arena.UnmapFromMemoryRegion(entry.mapped_pointer, entry.mapped_size);
   }
   m_logical_mapped_entries.clear();
+  ClearPageTableEntries();
 
   m_logical_page_mappings.fill(nullptr);
 
@@ -279,7 +311,7 @@ void MemoryManager::UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
                   intersection_start, mapped_size, logical_address);
               exit(0);
             }
-            m_logical_mapped_entries.push_back({mapped_pointer, mapped_size});
+            m_logical_mapped_entries.push_back({mapped_pointer, mapped_size, intersection_start});
           }
 
           m_logical_page_mappings[i] =
@@ -290,6 +322,99 @@ void MemoryManager::UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
   }
 }
 
+void MemoryManager::MapPageTableEntry(u32 logical_address, u32 physical_address)
+{
+  if (!CanMapPageTableEntry(logical_address))
+    return;
+
+  const u32 logical_page = logical_address & ~PowerPC::HW_PAGE_MASK;
+  const u32 physical_page = physical_address & ~PowerPC::HW_PAGE_MASK;
+  for (const PhysicalMemoryRegion& region : m_physical_regions)
+  {
+    const u32 region_offset = physical_page - region.physical_address;
+    if (!region.active || physical_page < region.physical_address || region_offset >= region.size)
+      continue;
+
+    std::lock_guard lk(m_write_tracking_mutex);
+    void* mapped_pointer = m_arena.MapInMemoryRegion(region.shm_position + region_offset,
+                                                     PowerPC::HW_PAGE_SIZE,
+                                                     m_logical_base + logical_page);
+    // Not being able to map the page only means that accesses to it keep taking the slow path
+    if (!mapped_pointer)
+      return;
+
+    // A tracked page has to be write-protected in every view of it
+    if (m_write_tracking_active)
+    {
+      const std::optional<size_t> index = GetWriteTrackingPageIndex(physical_page);
+      if (index && *index < m_write_tracking_pages.size() &&
+          m_write_tracking_pages[*index].is_protected)
+      {
+        Common::WriteProtectMemory(mapped_pointer, PowerPC::HW_PAGE_SIZE);
+      }
+    }
+
+    const LogicalMemoryView view{mapped_pointer, PowerPC::HW_PAGE_SIZE, physical_page};
+    m_page_table_mapped_entries[(logical_page >> PowerPC::HW_PAGE_INDEX_SHIFT) &
+                                PowerPC::HW_PAGE_INDEX_MASK]
+        .push_back({logical_page, view});
+    m_page_table_mapped_pages[logical_page >> PowerPC::HW_PAGE_INDEX_SHIFT] = true;
+    return;
+  }
+}
+
+void MemoryManager::UnmapPageTableEntry(const PageTableMapping& mapping)
+{
+  m_arena.UnmapFromMemoryRegion(mapping.view.mapped_pointer, mapping.view.mapped_size);
+  m_page_table_mapped_pages[mapping.logical_address >> PowerPC::HW_PAGE_INDEX_SHIFT] = false;
+}
+
+void MemoryManager::UnmapPageTableEntries(u32 logical_address)
+{
+  auto& entries = m_page_table_mapped_entries[(logical_address >> PowerPC::HW_PAGE_INDEX_SHIFT) &
+                                              PowerPC::HW_PAGE_INDEX_MASK];
+  if (entries.empty())
+    return;
+
+  std::lock_guard lk(m_write_tracking_mutex);
+  for (const PageTableMapping& mapping : entries)
+    UnmapPageTableEntry(mapping);
+  entries.clear();
+}
+
+void MemoryManager::UnmapPageTableEntriesInSegment(u32 segment)
+{
+  if (!m_page_table_mapping_enabled)
+    return;
+
+  std::lock_guard lk(m_write_tracking_mutex);
+  for (auto& entries : m_page_table_mapped_entries)
+  {
+    std::erase_if(entries, [&](const PageTableMapping& mapping) {
+      if (mapping.logical_address >> 28 != segment)
+        return false;
+      UnmapPageTableEntry(mapping);
+      return true;
+    });
+  }
+}
+
+void MemoryManager::UnmapAllPageTableEntries()
+{
+  std::lock_guard lk(m_write_tracking_mutex);
+  ClearPageTableEntries();
+}
+
+void MemoryManager::ClearPageTableEntries()
+{
+  for (auto& entries : m_page_table_mapped_entries)
+  {
+    for (const PageTableMapping& mapping : entries)
+      UnmapPageTableEntry(mapping);
+    entries.clear();
+  }
+}
+
 void MemoryManager::DoState(PointerWrap& p)
 {
   const u32 current_ram_size = GetRamSize();
@@ -328,21 +453,122 @@ void MemoryManager::DoState(PointerWrap& p)
     return;
   }
 
-  p.DoArray(m_ram, current_ram_size);
+  bool delta = m_save_delta_state;
+  p.Do(delta);
+  if (p.IsReadMode() || p.IsWriteMode())
+    ++m_delta_state_generation;
+
+  if (p.IsReadMode())
+  {
+    std::lock_guard lk(m_write_tracking_mutex);
+    ResetWriteTracking();
+  }
+
+  DoRegionState(p, delta, m_ram, current_ram_size, &m_page_hashes.ram);
   p.DoArray(m_l1_cache, current_l1_cache_size);
   p.DoMarker("Memory RAM");
   if (current_have_fake_vmem)
-    p.DoArray(m_fake_vmem, current_fake_vmem_size);
+    DoRegionState(p, delta, m_fake_vmem, current_fake_vmem_size, &m_page_hashes.fake_vmem);
   p.DoMarker("Memory FakeVMEM");
   if (current_have_exram)
-    p.DoArray(m_exram, current_exram_size);
+    DoRegionState(p, delta, m_exram, current_exram_size, &m_page_hashes.exram);
   p.DoMarker("Memory EXRAM");
 }
 
+static std::vector<u64> HashPages(const u8* data, u32 size, u32 page_size)
+{
+  std::vector<u64> hashes(size / page_size);
+  for (size_t i = 0; i < hashes.size(); ++i)
+    hashes[i] = Common::GetHash64(data + i * page_size, page_size, 0);
+  return hashes;
+}
+
+static u64 CombinePageHashes(const std::vector<u64>& hashes)
+{
+  if (hashes.empty())
+    return 0;
+  return Common::GetHash64(reinterpret_cast<const u8*>(hashes.data()),
+                           static_cast<u32>(hashes.size() * sizeof(u64)), 0);
+}
+
+void MemoryManager::DoRegionState(PointerWrap& p, bool delta, u8* data, u32 size,
+                                  std::vector<u64>* hashes)
+{
+  const u32 page_size = DELTA_STATE_PAGE_SIZE;
+  const u32 num_pages = size / page_size;
+
+  if (!delta)
+  {
+    p.DoArrayByReference(data, size);
+    if (p.IsReadMode() || p.IsWriteMode())
+      *hashes = HashPages(data, size, page_size);
+    return;
+  }
+
+  std::vector<u64> current_hashes = HashPages(data, size, page_size);
+
+  // The parent is identified by the hashes of all its pages, so a delta can't be applied on top of
+  // anything but the exact memory contents it was created against.
+  u64 parent_id = CombinePageHashes(*hashes);
+  p.Do(parent_id);
+
+  if (p.IsReadMode())
+  {
+    if (parent_id != CombinePageHashes(current_hashes))
+    {
+      Core::DisplayMessage("Delta state does not match the current state. Aborting load state.",
+                           3000);
+      p.SetVerifyMode();
+      return;
+    }
+
+    u32 num_changed_pages = 0;
+    p.Do(num_changed_pages);
+    for (u32 i = 0; i < num_changed_pages; ++i)
+    {
+      u32 page = 0;
+      p.Do(page);
+      if (page >= num_pages)
+      {
+        p.SetVerifyMode();
+        return;
+      }
+      p.DoArray(data + page * page_size, page_size);
+      current_hashes[page] = Common::GetHash64(data + page * page_size, page_size, 0);
+    }
+  }
+  else
+  {
+    std::vector<u32> changed_pages;
+    for (u32 page = 0; page < num_pages; ++page)
+    {
+      if (hashes->size() != num_pages || (*hashes)[page] != current_hashes[page])
+        changed_pages.push_back(page);
+    }
+
+    u32 num_changed_pages = static_cast<u32>(changed_pages.size());
+    p.Do(num_changed_pages);
+    for (u32 page : changed_pages)
+    {
+      p.Do(page);
+      p.DoArray(data + page * page_size, page_size);
+    }
+  }
+
+  if (p.IsReadMode() || p.IsWriteMode())
+    *hashes = std::move(current_hashes);
+}
+
 void MemoryManager::Shutdown()
 {
   ShutdownFastmemArena();
 
+  {
+    std::lock_guard lk(m_write_tracking_mutex);
+    ResetWriteTracking();
+    m_write_tracking_pages = {};
+  }
+
   m_is_initialized = false;
   for (const PhysicalMemoryRegion& region : m_physical_regions)
   {
@@ -353,7 +579,10 @@ void MemoryManager::Shutdown()
     *region.out_pointer = nullptr;
   }
   m_arena.ReleaseSHMSegment();
+  if (m_mmio_mapping)
+    m_mmio_mapping->LogAccessCounts();
   m_mmio_mapping.reset();
+  m_page_hashes = {};
   INFO_LOG_FMT(MEMMAP, "Memory system shut down.");
 }
 
@@ -362,6 +591,9 @@ void MemoryManager::ShutdownFastmemArena()
   if (!m_is_fastmem_arena_initialized)
     return;
 
+  std::lock_guard lk(m_write_tracking_mutex);
+  ResetWriteTracking();
+
   for (const PhysicalMemoryRegion& region : m_physical_regions)
   {
     if (!region.active)
@@ -376,6 +608,12 @@ void MemoryManager::ShutdownFastmemArena()
     m_arena.UnmapFromMemoryRegion(entry.mapped_pointer, entry.mapped_size);
   }
   m_logical_mapped_entries.clear();
+  {
+    std::lock_guard lk(m_write_tracking_mutex);
+    ClearPageTableEntries();
+  }
+  m_page_table_mapping_enabled = false;
+  m_page_table_mapped_pages.clear();
 
   m_arena.ReleaseMemoryRegion();
 
@@ -387,6 +625,365 @@ void MemoryManager::ShutdownFastmemArena()
   m_is_fastmem_arena_initialized = false;
 }
 
+std::optional<size_t> MemoryManager::GetWriteTrackingPageIndex(u32 physical_address) const
+{
+  if (m_ram && physical_address < GetRamSize())
+    return physical_address / WRITE_TRACKING_PAGE_SIZE;
+
+  const u32 exram_offset = physical_address - m_physical_regions[3].physical_address;
+  if (m_exram && exram_offset < GetExRamSize())
+    return (GetRamSize() + exram_offset) / WRITE_TRACKING_PAGE_SIZE;
+
+  return std::nullopt;
+}
+
+void MemoryManager::SetWriteTrackingPageProtection(size_t index, bool write_protect)
+{
+  const size_t ram_pages = GetRamSize() / WRITE_TRACKING_PAGE_SIZE;
+  const u32 offset = static_cast<u32>(index * WRITE_TRACKING_PAGE_SIZE);
+  u8* view;
+  u32 physical_address;
+  if (index < ram_pages)
+  {
+    view = m_ram + offset;
+    physical_address = offset;
+  }
+  else
+  {
+    view = m_exram + offset - GetRamSize();
+    physical_address = m_physical_regions[3].physical_address + offset - GetRamSize();
+  }
+
+  const auto set_protection = [write_protect](void* ptr) {
+    if (write_protect)
+      Common::WriteProtectMemory(ptr, WRITE_TRACKING_PAGE_SIZE);
+    else
+      Common::UnWriteProtectMemory(ptr, WRITE_TRACKING_PAGE_SIZE);
+  };
+
+  set_protection(view);
+  if (m_is_fastmem_arena_initialized)
+  {
+    set_protection(m_physical_base + physical_address);
+    for (const LogicalMemoryView& entry : m_logical_mapped_entries)
+    {
+      const u32 entry_offset = physical_address - entry.physical_address;
+      if (entry_offset < entry.mapped_size)
+        set_protection(static_cast<u8*>(entry.mapped_pointer) + entry_offset);
+    }
+    for (const auto& entries : m_page_table_mapped_entries)
+    {
+      for (const PageTableMapping& mapping : entries)
+      {
+        if (mapping.view.physical_address == physical_address)
+          set_protection(mapping.view.mapped_pointer);
+      }
+    }
+  }
+}
+
+void MemoryManager::UnprotectWriteTrackingPage(size_t index)
+{
+  WriteTrackingPage& page = m_write_tracking_pages[index];
+  if (!page.is_protected)
+    return;
+
+  SaveSnapshotPage(index);
+  SetWriteTrackingPageProtection(index, false);
+  page.is_protected = false;
+  page.last_write = ++m_write_tracking_serial;
+}
+
+void MemoryManager::ResetWriteTracking()
+{
+  if (!m_write_tracking_active)
+    return;
+
+  for (size_t i = 0; i < m_write_tracking_pages.size(); ++i)
+    UnprotectWriteTrackingPage(i);
+  m_write_tracking_last_reset = ++m_write_tracking_serial;
+  m_write_tracking_active = false;
+}
+
+u64 MemoryManager::TrackWrites(u32 address, u32 size)
+{
+  std::lock_guard lk(m_write_tracking_mutex);
+  if (!m_write_tracking_supported)
+    return m_write_tracking_serial;
+
+  if (m_write_tracking_pages.empty())
+  {
+    m_write_tracking_pages.resize((GetRamSize() + (m_exram ? GetExRamSize() : 0)) /
+                                  WRITE_TRACKING_PAGE_SIZE);
+  }
+
+  const u32 end = address + size;
+  for (u32 page_address = address & ~(WRITE_TRACKING_PAGE_SIZE - 1); page_address < end;
+       page_address += WRITE_TRACKING_PAGE_SIZE)
+  {
+    const std::optional<size_t> index = GetWriteTrackingPageIndex(page_address);
+    if (!index)
+      continue;
+
+    WriteTrackingPage& page = m_write_tracking_pages[*index];
+    if (!page.is_protected)
+    {
+      SetWriteTrackingPageProtection(*index, true);
+      page.is_protected = true;
+    }
+
+    // The snapshot must not lift the protection anymore
+    if (m_snapshot && *index < m_snapshot->protected_for_snapshot.size())
+      m_snapshot->protected_for_snapshot[*index] = false;
+  }
+
+  m_write_tracking_active = true;
+  return m_write_tracking_serial;
+}
+
+bool MemoryManager::HasBeenWrittenSince(u32 address, u32 size, u64 serial)
+{
+  std::lock_guard lk(m_write_tracking_mutex);
+  if (!m_write_tracking_supported || m_write_tracking_last_reset > serial)
+    return true;
+
+  const u32 end = address + size;
+  for (u32 page_address = address & ~(WRITE_TRACKING_PAGE_SIZE - 1); page_address < end;
+       page_address += WRITE_TRACKING_PAGE_SIZE)
+  {
+    const std::optional<size_t> index = GetWriteTrackingPageIndex(page_address);
+    if (!index || *index >= m_write_tracking_pages.size() ||
+        m_write_tracking_pages[*index].last_write > serial)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void MemoryManager::PrepareForHostWrite(const u8* ptr, size_t size)
+{
+  if (!m_write_tracking_active || !ptr || size == 0)
+    return;
+
+  std::optional<u32> start;
+  if (m_ram && ptr >= m_ram && ptr < m_ram + GetRamSize())
+    start = static_cast<u32>(ptr - m_ram);
+  else if (m_exram && ptr >= m_exram && ptr < m_exram + GetExRamSize())
+    start = m_physical_regions[3].physical_address + static_cast<u32>(ptr - m_exram);
+  if (!start)
+    return;
+
+  std::lock_guard lk(m_write_tracking_mutex);
+  const u32 end = *start + static_cast<u32>(size);
+  for (u32 page_address = *start & ~(WRITE_TRACKING_PAGE_SIZE - 1); page_address < end;
+       page_address += WRITE_TRACKING_PAGE_SIZE)
+  {
+    const std::optional<size_t> index = GetWriteTrackingPageIndex(page_address);
+    if (index && *index < m_write_tracking_pages.size())
+      UnprotectWriteTrackingPage(*index);
+  }
+}
+
+bool MemoryManager::HandleWriteTrackingFault(uintptr_t host_address)
+{
+  if (!m_write_tracking_active)
+    return false;
+
+  std::lock_guard lk(m_write_tracking_mutex);
+  const u8* ptr = reinterpret_cast<const u8*>(host_address);
+  std::optional<u32> physical_address;
+  if (m_ram && ptr >= m_ram && ptr < m_ram + GetRamSize())
+  {
+    physical_address = static_cast<u32>(ptr - m_ram);
+  }
+  else if (m_exram && ptr >= m_exram && ptr < m_exram + GetExRamSize())
+  {
+    physical_address = m_physical_regions[3].physical_address + static_cast<u32>(ptr - m_exram);
+  }
+  else if (m_is_fastmem_arena_initialized && ptr >= m_physical_base &&
+           ptr < m_physical_base + 0x1'0000'0000)
+  {
+    physical_address = static_cast<u32>(ptr - m_physical_base);
+  }
+  else if (m_is_fastmem_arena_initialized && ptr >= m_logical_base &&
+           ptr < m_logical_base + 0x1'0000'0000)
+  {
+    for (const LogicalMemoryView& entry : m_logical_mapped_entries)
+    {
+      const u8* mapped = static_cast<const u8*>(entry.mapped_pointer);
+      if (ptr >= mapped && ptr < mapped + entry.mapped_size)
+        physical_address = entry.physical_address + static_cast<u32>(ptr - mapped);
+    }
+
+    const u32 logical_address = static_cast<u32>(ptr - m_logical_base);
+    for (const PageTableMapping& mapping :
+         m_page_table_mapped_entries[(logical_address >> PowerPC::HW_PAGE_INDEX_SHIFT) &
+                                     PowerPC::HW_PAGE_INDEX_MASK])
+    {
+      if (mapping.logical_address == (logical_address & ~PowerPC::HW_PAGE_MASK))
+      {
+        physical_address =
+            mapping.view.physical_address + (logical_address & PowerPC::HW_PAGE_MASK);
+      }
+    }
+  }
+  if (!physical_address)
+    return false;
+
+  const std::optional<size_t> index = GetWriteTrackingPageIndex(*physical_address);
+  if (!index || *index >= m_write_tracking_pages.size())
+    return false;
+
+  // If the page is no longer protected, another thread has lifted the protection in the meantime,
+  // and the access only has to be retried.
+  UnprotectWriteTrackingPage(*index);
+  return true;
+}
+
+bool MemoryManager::BeginSnapshot()
+{
+  std::lock_guard lk(m_write_tracking_mutex);
+  if (!m_write_tracking_supported || m_snapshot || !m_ram)
+    return false;
+
+  if (m_write_tracking_pages.empty())
+  {
+    m_write_tracking_pages.resize((GetRamSize() + (m_exram ? GetExRamSize() : 0)) /
+                                  WRITE_TRACKING_PAGE_SIZE);
+  }
+
+  auto snapshot = std::make_unique<Snapshot>();
+  snapshot->ram = m_ram;
+  snapshot->ram_size = GetRamSize();
+  snapshot->exram = m_exram;
+  snapshot->exram_size = m_exram ? GetExRamSize() : 0;
+  snapshot->copies_size = m_write_tracking_pages.size() * WRITE_TRACKING_PAGE_SIZE;
+  snapshot->copies = static_cast<u8*>(Common::AllocateMemoryPages(snapshot->copies_size));
+  if (!snapshot->copies)
+    return false;
+  snapshot->pages.assign(m_write_tracking_pages.size(), SnapshotPage::Live);
+  snapshot->protected_for_snapshot.assign(m_write_tracking_pages.size(), false);
+
+  for (size_t i = 0; i < m_write_tracking_pages.size(); ++i)
+  {
+    WriteTrackingPage& page = m_write_tracking_pages[i];
+    if (!page.is_protected)
+    {
+      SetWriteTrackingPageProtection(i, true);
+      page.is_protected = true;
+      snapshot->protected_for_snapshot[i] = true;
+    }
+  }
+
+  m_snapshot = std::move(snapshot);
+  m_write_tracking_active = true;
+  return true;
+}
+
+bool MemoryManager::IsInSnapshot(const u8* ptr, size_t size)
+{
+  std::lock_guard lk(m_write_tracking_mutex);
+  if (!m_snapshot)
+    return false;
+
+  const auto is_in = [ptr, size](const u8* base, u32 base_size) {
+    return base && ptr >= base && size <= base_size &&
+           static_cast<size_t>(ptr - base) <= base_size - size;
+  };
+  return is_in(m_snapshot->ram, m_snapshot->ram_size) ||
+         is_in(m_snapshot->exram, m_snapshot->exram_size);
+}
+
+std::optional<size_t> MemoryManager::GetSnapshotPageIndex(const u8* ptr) const
+{
+  const Snapshot& snapshot = *m_snapshot;
+  if (snapshot.ram && ptr >= snapshot.ram && ptr < snapshot.ram + snapshot.ram_size)
+    return (ptr - snapshot.ram) / WRITE_TRACKING_PAGE_SIZE;
+  if (snapshot.exram && ptr >= snapshot.exram && ptr < snapshot.exram + snapshot.exram_size)
+    return (snapshot.ram_size + (ptr - snapshot.exram)) / WRITE_TRACKING_PAGE_SIZE;
+  return std::nullopt;
+}
+
+void MemoryManager::SaveSnapshotPage(size_t index)
+{
+  if (!m_snapshot || index >= m_snapshot->pages.size() ||
+      m_snapshot->pages[index] != SnapshotPage::Live)
+  {
+    return;
+  }
+
+  Snapshot& snapshot = *m_snapshot;
+  const size_t offset = index * WRITE_TRACKING_PAGE_SIZE;
+  const u8* page = offset < snapshot.ram_size ? snapshot.ram + offset :
+                                                snapshot.exram + (offset - snapshot.ram_size);
+  std::memcpy(snapshot.copies + offset, page, WRITE_TRACKING_PAGE_SIZE);
+  snapshot.pages[index] = SnapshotPage::Copied;
+}
+
+void MemoryManager::ReleaseSnapshotPage(size_t index)
+{
+  Snapshot& snapshot = *m_snapshot;
+
+  // Live pages always belong to the current RAM and EXRAM, since stopping write tracking copies
+  // all of them. Pages which only the snapshot protected can be written to freely again, without
+  // that being recorded as a write.
+  if (snapshot.pages[index] == SnapshotPage::Live && snapshot.protected_for_snapshot[index])
+  {
+    SetWriteTrackingPageProtection(index, false);
+    m_write_tracking_pages[index].is_protected = false;
+  }
+  snapshot.pages[index] = SnapshotPage::Released;
+}
+
+void MemoryManager::ReadSnapshot(const u8* ptr, size_t size, u8* out)
+{
+  size_t offset = 0;
+  while (offset < size)
+  {
+    const u8* const current = ptr + offset;
+    const size_t page_offset =
+        reinterpret_cast<uintptr_t>(current) & (WRITE_TRACKING_PAGE_SIZE - 1);
+    const size_t length = std::min<size_t>(WRITE_TRACKING_PAGE_SIZE - page_offset, size - offset);
+
+    // Holding the lock while a live page is read keeps writers out of it until it is read
+    std::lock_guard lk(m_write_tracking_mutex);
+    const std::optional<size_t> index = m_snapshot ? GetSnapshotPageIndex(current) : std::nullopt;
+    if (!index || m_snapshot->pages[*index] == SnapshotPage::Released)
+    {
+      ERROR_LOG_FMT(MEMMAP, "Read of a range which isn't in the snapshot");
+      std::memset(out + offset, 0, length);
+    }
+    else
+    {
+      const SnapshotPage page = m_snapshot->pages[*index];
+      const u8* source = page == SnapshotPage::Copied ?
+                             m_snapshot->copies + *index * WRITE_TRACKING_PAGE_SIZE + page_offset :
+                             current;
+      std::memcpy(out + offset, source, length);
+      if (length == WRITE_TRACKING_PAGE_SIZE)
+        ReleaseSnapshotPage(*index);
+    }
+    offset += length;
+  }
+}
+
+void MemoryManager::EndSnapshot()
+{
+  std::lock_guard lk(m_write_tracking_mutex);
+  if (!m_snapshot)
+    return;
+
+  for (size_t i = 0; i < m_snapshot->pages.size(); ++i)
+  {
+    if (m_snapshot->pages[i] == SnapshotPage::Live)
+      ReleaseSnapshotPage(i);
+  }
+  Common::FreeMemoryPages(m_snapshot->copies, m_snapshot->copies_size);
+  m_snapshot.reset();
+}
+
 void MemoryManager::Clear()
 {
   if (m_ram)
@@ -448,6 +1045,63 @@ void MemoryManager::CopyToEmu(u32 address, const void* data, size_t size)
   memcpy(pointer, data, size);
 }
 
+std::span<u8> MemoryManager::GetSpanForDMA(u32 address) const
+{
+  if (m_ram && (address & 0xF8000000) == 0x00000000)
+  {
+    const u32 offset = address & GetRamMask();
+    return std::span(m_ram + offset, GetRamSize() - offset);
+  }
+
+  if (m_exram && (address >> 28) == 0x1)
+  {
+    const u32 offset = address & GetExRamMask();
+    return std::span(m_exram + offset, GetExRamSize() - offset);
+  }
+
+  return {};
+}
+
+bool MemoryManager::DMACopyFromEmu(std::span<u8> data, u32 address) const
+{
+  while (!data.empty())
+  {
+    const std::span<u8> source = GetSpanForDMA(address);
+    if (source.empty())
+    {
+      PanicAlertFmt("Invalid DMA from {:#010x} ({:x} bytes left)", address, data.size());
+      return false;
+    }
+
+    const size_t length = std::min(source.size(), data.size());
+    std::memcpy(data.data(), source.data(), length);
+    data = data.subspan(length);
+    address += static_cast<u32>(length);
+  }
+
+  return true;
+}
+
+bool MemoryManager::DMACopyToEmu(u32 address, std::span<const u8> data)
+{
+  while (!data.empty())
+  {
+    const std::span<u8> destination = GetSpanForDMA(address);
+    if (destination.empty())
+    {
+      PanicAlertFmt("Invalid DMA to {:#010x} ({:x} bytes left)", address, data.size());
+      return false;
+    }
+
+    const size_t length = std::min(destination.size(), data.size());
+    std::memcpy(destination.data(), data.data(), length);
+    data = data.subspan(length);
+    address += static_cast<u32>(length);
+  }
+
+  return true;
+}
+
 void MemoryManager::Memset(u32 address, u8 value, size_t size)
 {
   if (size == 0)
@@ -4,7 +4,11 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <cstddef>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <span>
 #include <string>
 #include <vector>
@@ -54,6 +58,7 @@ struct LogicalMemoryView
 {
   void* mapped_pointer;
   u32 mapped_size;
+  u32 physical_address;
 };
 
 class MemoryManager
@@ -82,6 +87,14 @@ public:
   u8* GetLogicalBase() const { return m_logical_base; }
   u8* GetPhysicalPageMappingsBase() const { return m_physical_page_mappings_base; }
   u8* GetLogicalPageMappingsBase() const { return m_logical_page_mappings_base; }
+  void* GetPhysicalPageMapping(u32 address) const
+  {
+    return m_physical_page_mappings[address >> PowerPC::BAT_INDEX_SHIFT];
+  }
+  void* GetLogicalPageMapping(u32 address) const
+  {
+    return m_logical_page_mappings[address >> PowerPC::BAT_INDEX_SHIFT];
+  }
 
   // FIXME: these should not return their address, but AddressSpace wants that
   u8*& GetRAM() { return m_ram; }
@@ -99,8 +112,60 @@ public:
   void ShutdownFastmemArena();
   void DoState(PointerWrap& p);
 
+  // While set, DoState only saves the pages of RAM which have changed since the last state was
+  // saved or loaded. Loading such a state requires memory to match that parent state exactly.
+  void SetSaveDeltaState(bool delta) { m_save_delta_state = delta; }
+  // Incremented whenever a state is saved or loaded, so that a caller keeping a chain of delta
+  // states can tell whether anything else has moved the parent state out from under it.
+  u64 GetDeltaStateGeneration() const { return m_delta_state_generation; }
+
   void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
 
+  // With address translation enabled, the MMU maps each page that it translates through the page
+  // table into the logical fastmem area, so that the JITs can access the page directly from then
+  // on. These mappings are only valid as long as the page table translation is, and the MMU
+  // removes them when a TLB entry is invalidated or a segment register or SDR1 is written to.
+  // UpdateLogicalMemory removes all of them as well.
+  bool CanMapPageTableEntry(u32 logical_address) const
+  {
+    return m_page_table_mapping_enabled &&
+           !m_page_table_mapped_pages[logical_address >> PowerPC::HW_PAGE_INDEX_SHIFT];
+  }
+  void MapPageTableEntry(u32 logical_address, u32 physical_address);
+  // Removes the mappings of every page that shares a TLB entry with the given address.
+  void UnmapPageTableEntries(u32 logical_address);
+  void UnmapPageTableEntriesInSegment(u32 segment);
+  void UnmapAllPageTableEntries();
+
+  // Write tracking lets a caller find out whether a range of RAM or EXRAM has been written to
+  // without having to look at its contents. Tracked pages are write-protected in every host view
+  // of them, and the first write to such a page afterwards is caught by the fault handler, which
+  // records the write and lifts the protection again.
+  bool IsWriteTrackingSupported() const { return m_write_tracking_supported; }
+  // Starts tracking writes to the given physical range and returns a serial which can be passed to
+  // HasBeenWrittenSince. Every write which happens after this call is detected.
+  u64 TrackWrites(u32 address, u32 size);
+  // Returns true if the range may have been written to since TrackWrites returned the serial.
+  bool HasBeenWrittenSince(u32 address, u32 size, u64 serial);
+  // Must be called before memory is written by anything the fault handler cannot intercept, such
+  // as a system call which reads a file straight into emulated memory.
+  void PrepareForHostWrite(const u8* ptr, size_t size);
+  // Called from the fault handler. Returns true if the fault was caused by write tracking.
+  bool HandleWriteTrackingFault(uintptr_t host_address);
+
+  // A snapshot keeps RAM and EXRAM readable as they were when it was begun while emulation goes
+  // on. It is built on write tracking: every page is write-protected, and the first write to a
+  // page afterwards copies its old contents aside before the protection is lifted. Only one
+  // snapshot can exist at a time. Returns false if snapshots aren't supported or one exists.
+  bool BeginSnapshot();
+  // Whether the host range lies within RAM or EXRAM of the current snapshot.
+  bool IsInSnapshot(const u8* ptr, size_t size);
+  // Copies a range of the snapshot to out. Can be called from any thread. All pages which the
+  // range covers fully are released from the snapshot, so they can't be read again.
+  void ReadSnapshot(const u8* ptr, size_t size, u8* out);
+  // Releases all remaining pages and the copies.
+  void EndSnapshot();
+
   void Clear();
 
   // Routines to access physically addressed memory, designed for use by
@@ -118,6 +183,14 @@ public:
 
   void CopyFromEmu(void* data, u32 address, size_t size) const;
   void CopyToEmu(u32 address, const void* data, size_t size);
+
+  // Copies for DMA transfers done by emulated hardware. Unlike with CopyFromEmu and CopyToEmu, the
+  // range may run past the end of MEM1 or MEM2, in which case it continues in the next mirror of
+  // that region, as the memory controller ignores the upper address bits. Returns false if part of
+  // the range isn't backed by RAM.
+  bool DMACopyFromEmu(std::span<u8> data, u32 address) const;
+  bool DMACopyToEmu(u32 address, std::span<const u8> data);
+
   void Memset(u32 address, u8 value, size_t size);
   u8 Read_U8(u32 address) const;
   u16 Read_U16(u32 address) const;
@@ -196,6 +269,81 @@ private:
 
   bool m_is_fastmem_arena_initialized = false;
 
+  // Granularity of delta savestates, and the hashes of each page of RAM, EXRAM and FakeVMEM as of
+  // the last state saved or loaded.
+  static constexpr u32 DELTA_STATE_PAGE_SIZE = 0x1000;
+  struct PageHashes
+  {
+    std::vector<u64> ram;
+    std::vector<u64> exram;
+    std::vector<u64> fake_vmem;
+  };
+  PageHashes m_page_hashes;
+  bool m_save_delta_state = false;
+  u64 m_delta_state_generation = 0;
+
+  // Returns the RAM which a DMA to the given address accesses, up to the end of the mirror of
+  // MEM1 or MEM2 it is in. Returns an empty span if the address isn't in either region.
+  std::span<u8> GetSpanForDMA(u32 address) const;
+
+  void DoRegionState(PointerWrap& p, bool delta, u8* data, u32 size, std::vector<u64>* hashes);
+
+  // Granularity of write tracking. This has to match the host page size.
+  static constexpr u32 WRITE_TRACKING_PAGE_SIZE = 0x1000;
+  struct WriteTrackingPage
+  {
+    bool is_protected = false;
+    u64 last_write = 0;
+  };
+  bool m_write_tracking_supported = false;
+  std::atomic<bool> m_write_tracking_active = false;
+  // Protects everything below as well as m_logical_mapped_entries and
+  // m_page_table_mapped_entries, as faults can be handled on any thread which writes to emulated
+  // memory.
+  std::mutex m_write_tracking_mutex;
+  // Pages of RAM followed by pages of EXRAM.
+  std::vector<WriteTrackingPage> m_write_tracking_pages;
+  u64 m_write_tracking_serial = 0;
+  u64 m_write_tracking_last_reset = 0;
+
+  std::optional<size_t> GetWriteTrackingPageIndex(u32 physical_address) const;
+  void SetWriteTrackingPageProtection(size_t index, bool write_protect);
+  void UnprotectWriteTrackingPage(size_t index);
+  // Stops tracking every page. Requires m_write_tracking_mutex to be held.
+  void ResetWriteTracking();
+
+  enum class SnapshotPage : u8
+  {
+    // Still in memory and write-protected
+    Live,
+    // Written to since the snapshot was begun, so its old contents are in the copies
+    Copied,
+    Released,
+  };
+  struct Snapshot
+  {
+    const u8* ram = nullptr;
+    u32 ram_size = 0;
+    const u8* exram = nullptr;
+    u32 exram_size = 0;
+    // Indexed like m_write_tracking_pages. Committed by the host only for pages which are copied.
+    u8* copies = nullptr;
+    size_t copies_size = 0;
+    std::vector<SnapshotPage> pages;
+    // Pages which weren't tracked, so releasing them while they are live can lift the protection
+    std::vector<bool> protected_for_snapshot;
+  };
+  // Protected by m_write_tracking_mutex. Outlives Shutdown if the snapshot hasn't ended by then,
+  // at which point every page has been copied.
+  std::unique_ptr<Snapshot> m_snapshot;
+
+  std::optional<size_t> GetSnapshotPageIndex(const u8* ptr) const;
+  // Copies the page aside if it is still live in the snapshot.
+  // Requires m_write_tracking_mutex to be held.
+  void SaveSnapshotPage(size_t index);
+  // Requires m_write_tracking_mutex to be held.
+  void ReleaseSnapshotPage(size_t index);
+
   // STATE_TO_SAVE
   // Save the Init(), Shutdown() state
   bool m_is_initialized = false;
@@ -249,6 +397,23 @@ private:
 
   std::vector<LogicalMemoryView> m_logical_mapped_entries;
 
+  struct PageTableMapping
+  {
+    u32 logical_address;
+    LogicalMemoryView view;
+  };
+  // Views can only be mapped with the granularity of a PowerPC page if that is the host page size
+  bool m_page_table_mapping_enabled = false;
+  // Grouped by TLB index, so that a TLB invalidation only has to look at its own group.
+  std::array<std::vector<PageTableMapping>, PowerPC::HW_PAGE_INDEX_MASK + 1>
+      m_page_table_mapped_entries;
+  // One flag per logical page. Only used on the CPU thread, so it can be checked without locking.
+  std::vector<bool> m_page_table_mapped_pages;
+
+  void UnmapPageTableEntry(const PageTableMapping& mapping);
+  // Requires m_write_tracking_mutex to be held.
+  void ClearPageTableEntries();
+
   std::array<void*, PowerPC::BAT_PAGE_COUNT> m_physical_page_mappings{};
   std::array<void*, PowerPC::BAT_PAGE_COUNT> m_logical_page_mappings{};
 
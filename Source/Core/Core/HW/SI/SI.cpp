@@ -18,6 +18,7 @@
 #include "Common/Swap.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
+#include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/MMIO.h"
 #include "Core/HW/ProcessorInterface.h"
@@ -29,6 +30,8 @@
 
 #include "InputCommon/ControllerInterface/ControllerInterface.h"
 
+#include "VideoCommon/PerformanceMetrics.h"
+
 namespace SerialInterface
 {
 // SI Internal Hardware Addresses
@@ -190,8 +193,13 @@ void SerialInterfaceManager::RunSIBuffer(u64 user_data, s64 cycles_late)
 
 void SerialInterfaceManager::DoState(PointerWrap& p)
 {
+  // A state always holds sampled data, rather than depending on when the game reads it
+  if (!p.IsReadMode())
+    SamplePendingInput();
+
   for (int i = 0; i < MAX_SI_CHANNELS; i++)
   {
+    m_channel[i].is_sample_pending = false;
     p.Do(m_channel[i].in_hi.hex);
     p.Do(m_channel[i].in_lo.hex);
     p.Do(m_channel[i].out.hex);
@@ -369,6 +377,7 @@ void SerialInterfaceManager::RegisterMMIO(MMIO::Mapping* mmio, u32 base)
     mmio->Register(base | (SI_CHANNEL_0_IN_HI + 0xC * i),
                    MMIO::ComplexRead<u32>([i, rdst_bit](Core::System& system, u32) {
                      auto& si = system.GetSerialInterface();
+                     si.SamplePendingInput();
                      si.m_status_reg.hex &= ~(1U << rdst_bit);
                      si.UpdateInterrupts();
                      return si.m_channel[i].in_hi.hex;
@@ -377,6 +386,7 @@ void SerialInterfaceManager::RegisterMMIO(MMIO::Mapping* mmio, u32 base)
     mmio->Register(base | (SI_CHANNEL_0_IN_LO + 0xC * i),
                    MMIO::ComplexRead<u32>([i, rdst_bit](Core::System& system, u32) {
                      auto& si = system.GetSerialInterface();
+                     si.SamplePendingInput();
                      si.m_status_reg.hex &= ~(1U << rdst_bit);
                      si.UpdateInterrupts();
                      return si.m_channel[i].in_lo.hex;
@@ -492,6 +502,7 @@ void SerialInterfaceManager::AddDevice(std::unique_ptr<ISIDevice> device)
 
   // Set the new one
   m_channel.at(device_number).device = std::move(device);
+  m_channel.at(device_number).is_sample_pending = false;
 }
 
 void SerialInterfaceManager::AddDevice(const SIDevices device, int device_number)
@@ -532,6 +543,10 @@ void SerialInterfaceManager::ChangeDeviceDeterministic(SIDevices device, int cha
 
 void SerialInterfaceManager::UpdateDevices()
 {
+  // Data the game didn't read since the last poll is sampled now, so that every poll still samples
+  // each device exactly once
+  SamplePendingInput();
+
   // Check for device change requests:
   for (int i = 0; i != MAX_SI_CHANNELS; ++i)
   {
@@ -548,20 +563,36 @@ void SerialInterfaceManager::UpdateDevices()
   // succession, in order to optimize networking
   NetPlay::SetSIPollBatching(true);
 
+  // Games often read the data most of a frame after it was polled, so with late sampling the
+  // controllers which allow it are only sampled when it's read. Their data is always new.
+  // Movies and NetPlay need every sample to happen at the same point on every machine.
+  const bool late_sampling =
+      Config::Get(Config::MAIN_INPUT_LATE_SAMPLING) && !Core::WantsDeterminism();
+  bool any_sampled_now = false;
+  for (SSIChannel& channel : m_channel)
+  {
+    channel.is_sample_pending = late_sampling && channel.device->CanSampleLate();
+    any_sampled_now |= !channel.is_sample_pending;
+  }
+
   // Update inputs at the rate of SI
   // Typically 120hz but is variable
-  g_controller_interface.SetCurrentInputChannel(ciface::InputChannel::SerialInterface);
-  g_controller_interface.UpdateInput();
+  if (any_sampled_now)
+  {
+    g_controller_interface.SetCurrentInputChannel(ciface::InputChannel::SerialInterface);
+    g_controller_interface.UpdateInput();
+    g_perf_metrics.CountInputPoll();
+  }
 
   // Update channels and set the status bit if there's new data
-  m_status_reg.RDST0 =
-      !!m_channel[0].device->GetData(m_channel[0].in_hi.hex, m_channel[0].in_lo.hex);
-  m_status_reg.RDST1 =
-      !!m_channel[1].device->GetData(m_channel[1].in_hi.hex, m_channel[1].in_lo.hex);
-  m_status_reg.RDST2 =
-      !!m_channel[2].device->GetData(m_channel[2].in_hi.hex, m_channel[2].in_lo.hex);
-  m_status_reg.RDST3 =
-      !!m_channel[3].device->GetData(m_channel[3].in_hi.hex, m_channel[3].in_lo.hex);
+  const auto get_data = [](SSIChannel& channel) {
+    return channel.is_sample_pending ||
+           channel.device->GetData(channel.in_hi.hex, channel.in_lo.hex);
+  };
+  m_status_reg.RDST0 = get_data(m_channel[0]);
+  m_status_reg.RDST1 = get_data(m_channel[1]);
+  m_status_reg.RDST2 = get_data(m_channel[2]);
+  m_status_reg.RDST3 = get_data(m_channel[3]);
 
   UpdateInterrupts();
 
@@ -569,6 +600,28 @@ void SerialInterfaceManager::UpdateDevices()
   NetPlay::SetSIPollBatching(false);
 }
 
+void SerialInterfaceManager::SamplePendingInput()
+{
+  if (std::none_of(m_channel.begin(), m_channel.end(),
+                   [](const SSIChannel& channel) { return channel.is_sample_pending; }))
+  {
+    return;
+  }
+
+  g_controller_interface.SetCurrentInputChannel(ciface::InputChannel::SerialInterface);
+  g_controller_interface.UpdateInput();
+  g_perf_metrics.CountInputPoll();
+
+  for (SSIChannel& channel : m_channel)
+  {
+    if (!channel.is_sample_pending)
+      continue;
+
+    channel.is_sample_pending = false;
+    channel.device->GetData(channel.in_hi.hex, channel.in_lo.hex);
+  }
+}
+
 SIDevices SerialInterfaceManager::GetDeviceType(int channel) const
 {
   if (channel < 0 || channel >= MAX_SI_CHANNELS || !m_channel[channel].device)
@@ -77,6 +77,7 @@ private:
 
   void SetNoResponse(u32 channel);
   void UpdateInterrupts();
+  void SamplePendingInput();
   void GenerateSIInterrupt(SIInterruptType type);
 
   void ChangeDeviceDeterministic(SIDevices device, int channel);
@@ -132,6 +133,8 @@ private:
     std::unique_ptr<ISIDevice> device;
 
     bool has_recent_device_change = false;
+    // With late sampling, polled without having called GetData yet
+    bool is_sample_pending = false;
   };
 
   // SI Poll: Controls how often a device is polled
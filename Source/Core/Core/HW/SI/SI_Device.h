@@ -126,6 +126,10 @@ public:
   // Return true on new data
   virtual bool GetData(u32& hi, u32& low) = 0;
 
+  // Whether GetData may be called when the game reads the data rather than when the SI polls the
+  // device. This needs GetData to always have new data.
+  virtual bool CanSampleLate() const { return false; }
+
   // Send a command directly (no detour per buffer)
   virtual void SendCommand(u32 command, u8 poll) = 0;
 
@@ -65,6 +65,7 @@ public:
 
   // Return true on new data
   bool GetData(u32& hi, u32& low) override;
+  bool CanSampleLate() const override { return true; }
 
   // Send a command directly
   void SendCommand(u32 command, u8 poll) override;
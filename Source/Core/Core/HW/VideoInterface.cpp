@@ -80,6 +80,7 @@ void VideoInterfaceManager::DoState(PointerWrap& p)
   p.Do(m_target_refresh_rate_denominator);
   p.Do(m_ticks_last_line_start);
   p.Do(m_half_line_count);
+  m_vertical_beam_position = static_cast<u16>(1 + m_half_line_count / 2);
   p.Do(m_half_line_of_next_si_poll);
   p.Do(m_even_field_first_hl);
   p.Do(m_odd_field_first_hl);
@@ -165,6 +166,7 @@ void VideoInterfaceManager::Preset(bool _bNTSC)
 
   m_ticks_last_line_start = 0;
   m_half_line_count = 0;
+  m_vertical_beam_position = 1;
   m_half_line_of_next_si_poll = NUM_HALF_LINES_FOR_SI_POLL;  // first sampling starts at vsync
 
   UpdateParameters();
@@ -292,10 +294,7 @@ void VideoInterfaceManager::RegisterMMIO(MMIO::Mapping* mmio, u32 base)
 
   // MMIOs with unimplemented writes that trigger warnings.
   mmio->Register(
-      base | VI_VERTICAL_BEAM_POSITION, MMIO::ComplexRead<u16>([](Core::System& system, u32) {
-        auto& vi = system.GetVideoInterface();
-        return 1 + (vi.m_half_line_count) / 2;
-      }),
+      base | VI_VERTICAL_BEAM_POSITION, MMIO::DirectRead<u16>(&m_vertical_beam_position),
       MMIO::ComplexWrite<u16>([](Core::System& system, u32, u16 val) {
         WARN_LOG_FMT(
             VIDEOINTERFACE,
@@ -912,6 +911,7 @@ void VideoInterfaceManager::Update(u64 ticks)
   {
     m_half_line_count = 0;
   }
+  m_vertical_beam_position = static_cast<u16>(1 + m_half_line_count / 2);
 
   auto& core_timing = m_system.GetCoreTiming();
   if (!(m_half_line_count & 1))
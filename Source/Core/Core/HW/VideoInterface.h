@@ -439,6 +439,8 @@ private:
 
   u64 m_ticks_last_line_start = 0;  // number of ticks when the current full scanline started
   u32 m_half_line_count = 0;        // number of halflines that have occurred for this full frame
+  // 1 + m_half_line_count / 2, kept up to date so that the JITs can read the register directly
+  u16 m_vertical_beam_position = 1;
   u32 m_half_line_of_next_si_poll = 0;  // halfline when next SI poll results should be available
 
   // below indexes are 0-based
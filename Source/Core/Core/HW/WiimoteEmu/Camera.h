@@ -134,8 +134,11 @@ public:
 
   void Reset();
   void DoState(PointerWrap& p);
-  static std::array<CameraPoint, NUM_POINTS> GetCameraPoints(const Common::Matrix44& transform,
-                                                             Common::Vec2 field_of_view);
+  // The projection of a camera with the given field of view in radians.
+  static Common::Matrix44 GetProjection(Common::Vec2 field_of_view);
+  // camera_view is the projection combined with the transformation of the world around the
+  // wiimote.
+  static std::array<CameraPoint, NUM_POINTS> GetCameraPoints(const Common::Matrix44& camera_view);
   void Update(const std::array<CameraPoint, NUM_POINTS>& camera_points);
   void SetEnabled(bool is_enabled);
 
@@ -496,10 +496,12 @@ void Wiimote::BuildDesiredWiimoteState(DesiredWiimoteState* target_state,
                    IsSideways() ? dpad_sideways_bitmasks : dpad_bitmasks,
                    m_input_override_function);
 
+  const MotionBasis basis = GetMotionBasis();
+
   // Calculate accelerometer state.
   // Calibration values are 8-bit but we want 10-bit precision, so << 2.
   target_state->acceleration =
-      ConvertAccelData(GetTotalAcceleration(), ACCEL_ZERO_G << 2, ACCEL_ONE_G << 2);
+      ConvertAccelData(GetTotalAcceleration(basis), ACCEL_ZERO_G << 2, ACCEL_ONE_G << 2);
 
   // Calculate IR camera state.
   if (m_ir_passthrough->enabled)
@@ -508,10 +510,8 @@ void Wiimote::BuildDesiredWiimoteState(DesiredWiimoteState* target_state,
   }
   else if (sensor_bar_state == SensorBarState::Enabled)
   {
-    target_state->camera_points = CameraLogic::GetCameraPoints(
-        GetTotalTransformation(),
-        Common::Vec2(m_fov_x_setting.GetValue(), m_fov_y_setting.GetValue()) / 360 *
-            float(MathUtil::TAU));
+    target_state->camera_points =
+        CameraLogic::GetCameraPoints(GetCameraProjection() * GetTotalTransformation(basis));
   }
   else
   {
@@ -521,7 +521,7 @@ void Wiimote::BuildDesiredWiimoteState(DesiredWiimoteState* target_state,
 
   // Calculate MotionPlus state.
   if (m_motion_plus_setting.GetValue())
-    target_state->motion_plus = MotionPlus::GetGyroscopeData(GetTotalAngularVelocity());
+    target_state->motion_plus = MotionPlus::GetGyroscopeData(GetTotalAngularVelocity(basis));
   else
     target_state->motion_plus = std::nullopt;
 
@@ -865,10 +865,21 @@ void Wiimote::StepDynamics()
                    1.f / ::Wiimote::UPDATE_FREQ);
 }
 
-Common::Vec3 Wiimote::GetAcceleration(Common::Vec3 extra_acceleration) const
+Wiimote::MotionBasis Wiimote::GetMotionBasis() const
 {
-  Common::Vec3 accel = GetOrientation() * GetTransformation().Transform(
-                                              m_swing_state.acceleration + extra_acceleration, 0);
+  // TODO: Think about and clean up matrix order + make nunchuk match.
+  return {GetOrientation(), GetRotationalMatrix(-m_tilt_state.angle) *
+                                GetRotationalMatrix(-m_point_state.angle) *
+                                GetRotationalMatrix(-m_swing_state.angle)};
+}
+
+Common::Vec3 Wiimote::GetAcceleration(const MotionBasis& basis,
+                                      Common::Vec3 extra_acceleration) const
+{
+  // Accelerations are directions, so they are only affected by the rotational part of the
+  // transformation.
+  Common::Vec3 accel =
+      basis.orientation * (basis.rotation * (m_swing_state.acceleration + extra_acceleration));
 
   // Our shake effects have never been affected by orientation. Should they be?
   accel += m_shake_state.acceleration;
@@ -876,22 +887,20 @@ Common::Vec3 Wiimote::GetAcceleration(Common::Vec3 extra_acceleration) const
   return accel;
 }
 
-Common::Vec3 Wiimote::GetAngularVelocity(Common::Vec3 extra_angular_velocity) const
+Common::Vec3 Wiimote::GetAngularVelocity(const MotionBasis& basis,
+                                         Common::Vec3 extra_angular_velocity) const
 {
-  return GetOrientation() * (m_tilt_state.angular_velocity + m_swing_state.angular_velocity +
-                             m_point_state.angular_velocity + extra_angular_velocity);
+  return basis.orientation * (m_tilt_state.angular_velocity + m_swing_state.angular_velocity +
+                              m_point_state.angular_velocity + extra_angular_velocity);
 }
 
-Common::Matrix44 Wiimote::GetTransformation(const Common::Matrix33& extra_rotation) const
+Common::Matrix44 Wiimote::GetTransformation(const MotionBasis& basis,
+                                            const Common::Matrix33& extra_rotation) const
 {
   // Includes positional and rotational effects of:
   // Point, Swing, Tilt, Shake
-
-  // TODO: Think about and clean up matrix order + make nunchuk match.
   return Common::Matrix44::Translate(-m_shake_state.position) *
-         Common::Matrix44::FromMatrix33(extra_rotation * GetRotationalMatrix(-m_tilt_state.angle) *
-                                        GetRotationalMatrix(-m_point_state.angle) *
-                                        GetRotationalMatrix(-m_swing_state.angle)) *
+         Common::Matrix44::FromMatrix33(extra_rotation * basis.rotation) *
          Common::Matrix44::Translate(-m_swing_state.position - m_point_state.position);
 }
 
@@ -901,6 +910,21 @@ Common::Quaternion Wiimote::GetOrientation() const
          Common::Quaternion::RotateX(float(MathUtil::TAU / 4 * IsUpright()));
 }
 
+const Common::Matrix44& Wiimote::GetCameraProjection()
+{
+  const auto field_of_view =
+      Common::Vec2(m_fov_x_setting.GetValue(), m_fov_y_setting.GetValue()) / 360 *
+      float(MathUtil::TAU);
+
+  if (field_of_view != m_camera_projection_fov)
+  {
+    m_camera_projection_fov = field_of_view;
+    m_camera_projection = CameraLogic::GetProjection(field_of_view);
+  }
+
+  return m_camera_projection;
+}
+
 std::optional<Common::Vec3> Wiimote::OverrideVec3(const ControllerEmu::ControlGroup* control_group,
                                                   std::optional<Common::Vec3> optional_vec) const
 {
@@ -968,25 +992,25 @@ Wiimote::OverrideVec3(const ControllerEmu::ControlGroup* control_group, Common::
   return vec;
 }
 
-Common::Vec3 Wiimote::GetTotalAcceleration() const
+Common::Vec3 Wiimote::GetTotalAcceleration(const MotionBasis& basis) const
 {
   const Common::Vec3 default_accel = Common::Vec3(0, 0, float(GRAVITY_ACCELERATION));
   const Common::Vec3 accel = m_imu_accelerometer->GetState().value_or(default_accel);
 
-  return OverrideVec3(m_imu_accelerometer, GetAcceleration(accel));
+  return OverrideVec3(m_imu_accelerometer, GetAcceleration(basis, accel));
 }
 
-Common::Vec3 Wiimote::GetTotalAngularVelocity() const
+Common::Vec3 Wiimote::GetTotalAngularVelocity(const MotionBasis& basis) const
 {
   const Common::Vec3 default_ang_vel = {};
   const Common::Vec3 ang_vel = m_imu_gyroscope->GetState().value_or(default_ang_vel);
 
-  return OverrideVec3(m_imu_gyroscope, GetAngularVelocity(ang_vel));
+  return OverrideVec3(m_imu_gyroscope, GetAngularVelocity(basis, ang_vel));
 }
 
-Common::Matrix44 Wiimote::GetTotalTransformation() const
+Common::Matrix44 Wiimote::GetTotalTransformation(const MotionBasis& basis) const
 {
-  return GetTransformation(Common::Matrix33::FromQuaternion(
+  return GetTransformation(basis, Common::Matrix33::FromQuaternion(
       m_imu_cursor_state.rotation *
       Common::Quaternion::RotateX(m_imu_cursor_state.recentered_pitch)));
 }
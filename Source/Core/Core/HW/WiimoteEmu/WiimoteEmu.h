@@ -193,28 +193,43 @@ private:
   void UpdateButtonsStatus(const DesiredWiimoteState& target_state);
   void BuildDesiredWiimoteState(DesiredWiimoteState* target_state, SensorBarState sensor_bar_state);
 
+  // The rotations which the accelerometer, camera and MotionPlus data are all derived from.
+  // They are computed once per report and shared between them.
+  struct MotionBasis
+  {
+    // The world rotation from the effects of sideways/upright settings.
+    Common::Quaternion orientation;
+    // The rotation of the world around the wiimote from Point, Swing and Tilt.
+    Common::Matrix33 rotation;
+  };
+  MotionBasis GetMotionBasis() const;
+
   // Returns simulated accelerometer data in m/s^2.
-  Common::Vec3 GetAcceleration(Common::Vec3 extra_acceleration) const;
+  Common::Vec3 GetAcceleration(const MotionBasis& basis, Common::Vec3 extra_acceleration) const;
 
   // Returns simulated gyroscope data in radians/s.
-  Common::Vec3 GetAngularVelocity(Common::Vec3 extra_angular_velocity) const;
+  Common::Vec3 GetAngularVelocity(const MotionBasis& basis,
+                                  Common::Vec3 extra_angular_velocity) const;
 
   // Returns the transformation of the world around the wiimote.
-  // Used for simulating camera data and for rotating acceleration data.
+  // Used for simulating camera data.
   // Does not include orientation transformations.
-  Common::Matrix44
-  GetTransformation(const Common::Matrix33& extra_rotation = Common::Matrix33::Identity()) const;
+  Common::Matrix44 GetTransformation(const MotionBasis& basis,
+                                     const Common::Matrix33& extra_rotation) const;
 
   // Returns the world rotation from the effects of sideways/upright settings.
   Common::Quaternion GetOrientation() const;
 
+  // Returns the camera projection for the current field of view settings.
+  const Common::Matrix44& GetCameraProjection();
+
   std::optional<Common::Vec3> OverrideVec3(const ControllerEmu::ControlGroup* control_group,
                                            std::optional<Common::Vec3> optional_vec) const;
   Common::Vec3 OverrideVec3(const ControllerEmu::ControlGroup* control_group,
                             Common::Vec3 vec) const;
-  Common::Vec3 GetTotalAcceleration() const;
-  Common::Vec3 GetTotalAngularVelocity() const;
-  Common::Matrix44 GetTotalTransformation() const;
+  Common::Vec3 GetTotalAcceleration(const MotionBasis& basis) const;
+  Common::Vec3 GetTotalAngularVelocity(const MotionBasis& basis) const;
+  Common::Matrix44 GetTotalTransformation(const MotionBasis& basis) const;
 
   void HandleReportRumble(const WiimoteCommon::OutputReportRumble&);
   void HandleReportLeds(const WiimoteCommon::OutputReportLeds&);
@@ -352,6 +367,10 @@ private:
 
   IMUCursorState m_imu_cursor_state;
 
+  // Only rebuilt when the field of view settings change.
+  std::optional<Common::Vec2> m_camera_projection_fov;
+  Common::Matrix44 m_camera_projection;
+
   Config::ConfigChangedCallbackID m_config_changed_callback_id;
 };
 }  // namespace WiimoteEmu
@@ -4,6 +4,7 @@
 #include "Core/HW/WiimoteReal/WiimoteReal.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <mutex>
 #include <queue>
@@ -237,7 +238,7 @@ void Wiimote::ResetDataReporting()
 
 void Wiimote::ClearReadQueue()
 {
-  Report rpt;
+  ReceivedReport rpt;
 
   // The "Clear" function isn't thread-safe :/
   while (m_read_reports.Pop(rpt))
@@ -250,6 +251,7 @@ void Wiimote::EventLinked()
   m_is_linked = true;
 
   ClearReadQueue();
+  m_report_timing = ReportTiming{};
   ResetDataReporting();
   EnablePowerAssertionInternal();
 }
@@ -300,6 +302,7 @@ void Wiimote::Read()
 {
   Report rpt(MAX_PAYLOAD);
   auto const result = IORead(rpt.data());
+  const auto received_time = std::chrono::steady_clock::now();
 
   if (0 == result)
   {
@@ -324,7 +327,7 @@ void Wiimote::Read()
 
     // Add it to queue
     rpt.resize(result);
-    m_read_reports.Push(std::move(rpt));
+    m_read_reports.Push(ReceivedReport{std::move(rpt), received_time});
   }
 }
 
@@ -435,7 +438,12 @@ static bool IsDataReport(const Report& rpt)
 
 bool Wiimote::GetNextReport(Report* report)
 {
-  return m_read_reports.Pop(*report);
+  ReceivedReport rpt;
+  if (!m_read_reports.Pop(rpt))
+    return false;
+
+  *report = std::move(rpt.data);
+  return true;
 }
 
 // Returns the next report that should be sent
@@ -446,16 +454,73 @@ Report& Wiimote::ProcessReadQueue(bool repeat_last_data_report)
     m_last_input_report.clear();
 
   // Step through the read queue.
-  while (GetNextReport(&m_last_input_report))
+  ReceivedReport rpt;
+  std::optional<std::chrono::steady_clock::time_point> received_time;
+  while (m_read_reports.Pop(rpt))
   {
+    m_last_input_report = std::move(rpt.data);
+    received_time = rpt.time;
+    AddReportInterval(rpt.time);
+
     // Stop on a non-data report.
     if (!IsDataReport(m_last_input_report))
       break;
   }
 
+  if (received_time)
+    AddReportLatency(*received_time);
+
   return m_last_input_report;
 }
 
+void Wiimote::AddReportInterval(std::chrono::steady_clock::time_point received)
+{
+  auto& timing = m_report_timing;
+  if (timing.last_received)
+  {
+    const double interval_us =
+        std::chrono::duration<double, std::micro>(received - *timing.last_received).count();
+    ++timing.intervals;
+    timing.interval_total_us += interval_us;
+    timing.interval_squared_total_us += interval_us * interval_us;
+  }
+  timing.last_received = received;
+}
+
+void Wiimote::AddReportLatency(std::chrono::steady_clock::time_point received)
+{
+  constexpr auto REPORT_TIMING_LOG_INTERVAL = std::chrono::seconds(10);
+
+  auto& timing = m_report_timing;
+  const auto now = std::chrono::steady_clock::now();
+
+  const u64 latency_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(now - received).count();
+  ++timing.deliveries;
+  timing.latency_total_us += latency_us;
+  timing.latency_max_us = std::max(timing.latency_max_us, latency_us);
+
+  if (now < timing.next_log)
+    return;
+
+  if (timing.intervals != 0 && timing.deliveries != 0)
+  {
+    const double mean_interval_us = timing.interval_total_us / timing.intervals;
+    const double jitter_us = std::sqrt(std::max(
+        timing.interval_squared_total_us / timing.intervals - mean_interval_us * mean_interval_us,
+        0.0));
+    DEBUG_LOG_FMT(WIIMOTE,
+                  "Wii Remote {}: a report every {:.0f}us with {:.0f}us jitter, delivered after "
+                  "{}us on average, {}us max",
+                  m_index + 1, mean_interval_us, jitter_us,
+                  timing.latency_total_us / timing.deliveries, timing.latency_max_us);
+  }
+
+  timing = ReportTiming{};
+  timing.next_log = now + REPORT_TIMING_LOG_INTERVAL;
+  timing.last_received = received;
+}
+
 u8 Wiimote::GetWiimoteDeviceIndex() const
 {
   return m_bt_device_index;
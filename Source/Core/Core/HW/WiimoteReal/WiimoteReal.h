@@ -4,8 +4,10 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 #include <vector>
@@ -124,7 +126,32 @@ private:
   virtual bool ConnectInternal() = 0;
   virtual void DisconnectInternal() = 0;
 
+  // An input report with the time at which it was read from the device
+  struct ReceivedReport
+  {
+    Report data;
+    std::chrono::steady_clock::time_point time;
+  };
+
+  // Measured on the CPU thread as the reports are taken from the read queue, and logged
+  // periodically.
+  struct ReportTiming
+  {
+    std::chrono::steady_clock::time_point next_log;
+    std::optional<std::chrono::steady_clock::time_point> last_received;
+    // The intervals between consecutive reports, whose deviation is the jitter
+    u64 intervals = 0;
+    double interval_total_us = 0;
+    double interval_squared_total_us = 0;
+    // The time between reading a report and handing it to the emulated Bluetooth stack
+    u64 deliveries = 0;
+    u64 latency_total_us = 0;
+    u64 latency_max_us = 0;
+  };
+
   Report& ProcessReadQueue(bool repeat_last_data_report);
+  void AddReportInterval(std::chrono::steady_clock::time_point received);
+  void AddReportLatency(std::chrono::steady_clock::time_point received);
   void ClearReadQueue();
   void WriteReport(Report rpt);
 
@@ -153,12 +180,14 @@ private:
   // Triggered when the thread has finished ConnectInternal.
   Common::Event m_thread_ready_event;
 
-  Common::SPSCQueue<Report> m_read_reports;
+  Common::SPSCQueue<ReceivedReport> m_read_reports;
   Common::SPSCQueue<Report> m_write_reports;
 
   bool m_speaker_enabled_in_dolphin_config = false;
   int m_balance_board_dump_port = 0;
 
+  ReportTiming m_report_timing;
+
   Config::ConfigChangedCallbackID m_config_changed_callback_id;
 };
 
@@ -5,16 +5,15 @@
 
 #include <algorithm>
 #include <array>
-#include <iterator>
-#include <memory>
+#include <cstring>
 #include <optional>
 #include <vector>
 
-#include <mbedtls/sha1.h>
-
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
+#include "Common/Swap.h"
 #include "Core/HW/MMIO.h"
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
@@ -31,52 +30,59 @@ std::optional<IPCReply> ShaDevice::Open(const OpenRequest& request)
   return Device::Open(request);
 }
 
-static void ConvertContext(const ShaDevice::ShaContext& src, mbedtls_sha1_context* dest)
-{
-  std::copy(std::begin(src.length), std::end(src.length), std::begin(dest->total));
-  std::copy(std::begin(src.states), std::end(src.states), std::begin(dest->state));
-}
-
-static void ConvertContext(const mbedtls_sha1_context& src, ShaDevice::ShaContext* dest)
-{
-  std::copy(std::begin(src.total), std::end(src.total), std::begin(dest->length));
-  std::copy(std::begin(src.state), std::end(src.state), std::begin(dest->states));
-}
-
 HLE::ReturnCode ShaDevice::ProcessShaCommand(ShaIoctlv command, const IOCtlVRequest& request)
 {
   auto& system = GetSystem();
   auto& memory = system.GetMemory();
-  auto ret = 0;
-  std::array<u8, 20> output_hash{};
-  mbedtls_sha1_context context;
   ShaDevice::ShaContext engine_context;
   memory.CopyFromEmu(&engine_context, request.io_vectors[0].address, sizeof(ShaDevice::ShaContext));
-  ConvertContext(engine_context, &context);
 
   // reset the context
   if (command == ShaIoctlv::InitState)
   {
-    ret = mbedtls_sha1_starts_ret(&context);
+    engine_context.states = Common::SHA1::INITIAL_STATE;
+    engine_context.length = {};
   }
   else
   {
     std::vector<u8> input_data(request.in_vectors[0].size);
     memory.CopyFromEmu(input_data.data(), request.in_vectors[0].address, input_data.size());
-    ret = mbedtls_sha1_update_ret(&context, input_data.data(), input_data.size());
-    if (!ret && command == ShaIoctlv::FinalizeState)
+
+    // Only the final contribution may end with a partial block, since the context has no room
+    // for one. The length is kept in bytes, split into its low and high words.
+    const size_t num_blocks = input_data.size() / Common::SHA1::BLOCK_LEN;
+    Common::SHA1::ProcessBlocks(&engine_context.states, input_data.data(), num_blocks);
+    const u64 length = ((u64{engine_context.length[1]} << 32) | engine_context.length[0]) +
+                       input_data.size();
+    engine_context.length = {static_cast<u32>(length), static_cast<u32>(length >> 32)};
+
+    if (command == ShaIoctlv::FinalizeState)
     {
-      ret = mbedtls_sha1_finish_ret(&context, output_hash.data());
+      const size_t rem = input_data.size() % Common::SHA1::BLOCK_LEN;
+      std::array<u8, 2 * Common::SHA1::BLOCK_LEN> padding{};
+      std::copy_n(input_data.data() + num_blocks * Common::SHA1::BLOCK_LEN, rem, padding.data());
+      padding[rem] = 0x80;
+
+      // The bit length goes at the end of the last block, which is the second one if it doesn't
+      // fit after the 0x80
+      const size_t padding_blocks = rem + 1 + sizeof(u64) > Common::SHA1::BLOCK_LEN ? 2 : 1;
+      const Common::BigEndianValue<u64> bit_length(length * 8);
+      std::memcpy(&padding[padding_blocks * Common::SHA1::BLOCK_LEN - sizeof(u64)], &bit_length,
+                  sizeof(bit_length));
+      Common::SHA1::ProcessBlocks(&engine_context.states, padding.data(), padding_blocks);
+
+      Common::SHA1::Digest output_hash;
+      for (size_t i = 0; i < engine_context.states.size(); ++i)
+      {
+        const Common::BigEndianValue<u32> word(engine_context.states[i]);
+        std::memcpy(&output_hash[i * sizeof(u32)], &word, sizeof(word));
+      }
+      memory.CopyToEmu(request.io_vectors[1].address, output_hash.data(), output_hash.size());
     }
   }
 
-  ConvertContext(context, &engine_context);
   memory.CopyToEmu(request.io_vectors[0].address, &engine_context, sizeof(ShaDevice::ShaContext));
-  if (!ret && command == ShaIoctlv::FinalizeState)
-    memory.CopyToEmu(request.io_vectors[1].address, output_hash.data(), output_hash.size());
-
-  mbedtls_sha1_free(&context);
-  return ret ? HLE::ReturnCode::IPC_EACCES : HLE::ReturnCode::IPC_SUCCESS;
+  return HLE::ReturnCode::IPC_SUCCESS;
 }
 
 std::optional<IPCReply> ShaDevice::IOCtlV(const IOCtlVRequest& request)
@@ -5,7 +5,9 @@
 
 #include <array>
 #include <map>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -216,8 +218,23 @@ private:
     u32 m_uid = 0;
   };
 
+  // Title metadata which was read from the NAND. All of it is read again once anything on the
+  // NAND has changed.
+  struct MetadataCache
+  {
+    u64 modification_count = 0;
+    std::map<u64, ES::TMDReader> installed_tmds;
+    std::map<std::pair<u64, std::optional<u8>>, ES::TicketReader> signed_tickets;
+    std::optional<std::vector<u64>> installed_titles;
+  };
+  // Returns nullptr if the cache may not be used.
+  MetadataCache* GetMetadataCache() const;
+  ES::TicketReader ReadSignedTicket(u64 title_id, std::optional<u8> desired_version) const;
+
   Kernel& m_ios;
 
+  mutable MetadataCache m_metadata_cache;
+
   using ContentTable = std::array<OpenedContent, 16>;
   ContentTable m_content_table;
 
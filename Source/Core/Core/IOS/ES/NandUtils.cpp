@@ -19,6 +19,7 @@
 #include "Common/NandPaths.h"
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
+#include "Core/Core.h"
 #include "Core/IOS/ES/Formats.h"
 #include "Core/IOS/FS/FileSystemProxy.h"
 #include "Core/IOS/Uids.h"
@@ -44,12 +45,55 @@ ES::TMDReader ESCore::FindImportTMD(u64 title_id, Ticks ticks) const
                  ticks);
 }
 
+ESCore::MetadataCache* ESCore::GetMetadataCache() const
+{
+  // Skipping the reads would change the state of the emulated FS timing
+  if (Core::WantsDeterminism())
+    return nullptr;
+
+  const u64 modification_count = m_ios.GetFS()->GetModificationCount();
+  if (m_metadata_cache.modification_count != modification_count)
+  {
+    m_metadata_cache = {};
+    m_metadata_cache.modification_count = modification_count;
+  }
+  return &m_metadata_cache;
+}
+
 ES::TMDReader ESCore::FindInstalledTMD(u64 title_id, Ticks ticks) const
 {
-  return FindTMD(m_ios.GetFSCore(), Common::GetTMDFileName(title_id), ticks);
+  // Lookups whose time is emulated have to go through the FS
+  MetadataCache* cache = ticks.IsTracked() ? nullptr : GetMetadataCache();
+  if (cache)
+  {
+    const auto it = cache->installed_tmds.find(title_id);
+    if (it != cache->installed_tmds.end())
+      return it->second;
+  }
+
+  ES::TMDReader tmd = FindTMD(m_ios.GetFSCore(), Common::GetTMDFileName(title_id), ticks);
+  if (cache)
+    cache->installed_tmds.emplace(title_id, tmd);
+  return tmd;
 }
 
 ES::TicketReader ESCore::FindSignedTicket(u64 title_id, std::optional<u8> desired_version) const
+{
+  MetadataCache* cache = GetMetadataCache();
+  if (cache)
+  {
+    const auto it = cache->signed_tickets.find({title_id, desired_version});
+    if (it != cache->signed_tickets.end())
+      return it->second;
+  }
+
+  ES::TicketReader ticket = ReadSignedTicket(title_id, desired_version);
+  if (cache)
+    cache->signed_tickets.emplace(std::pair(title_id, desired_version), ticket);
+  return ticket;
+}
+
+ES::TicketReader ESCore::ReadSignedTicket(u64 title_id, std::optional<u8> desired_version) const
 {
   std::string path = desired_version == 1 ? Common::GetV1TicketFileName(title_id) :
                                             Common::GetTicketFileName(title_id);
@@ -127,7 +171,14 @@ static std::vector<u64> GetTitlesInTitleOrImport(FS::FileSystem* fs, const std::
 
 std::vector<u64> ESCore::GetInstalledTitles() const
 {
-  return GetTitlesInTitleOrImport(m_ios.GetFS().get(), "/title");
+  MetadataCache* cache = GetMetadataCache();
+  if (cache && cache->installed_titles)
+    return *cache->installed_titles;
+
+  std::vector<u64> titles = GetTitlesInTitleOrImport(m_ios.GetFS().get(), "/title");
+  if (cache)
+    cache->installed_titles = titles;
+  return titles;
 }
 
 std::vector<u64> ESCore::GetTitleImports() const
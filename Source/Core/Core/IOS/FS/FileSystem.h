@@ -291,6 +291,13 @@ public:
   virtual Result<ExtendedDirectoryStats> GetExtendedDirectoryStats(const std::string& path) = 0;
 
   virtual void SetNandRedirects(std::vector<NandRedirect> nand_redirects) = 0;
+
+  /// Write all changes which are still held in memory to the backing storage.
+  virtual void Flush() = 0;
+
+  /// Incremented by every operation which changes the file system, so that data which was read
+  /// from it earlier can be told apart from data that may be outdated.
+  virtual u64 GetModificationCount() const = 0;
 };
 
 template <typename T>
@@ -7,6 +7,7 @@
 
 #include "Common/Assert.h"
 #include "Common/FileUtil.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/IOS/Device.h"
 #include "Core/IOS/FS/HostBackend/FS.h"
 
@@ -41,7 +42,12 @@ std::unique_ptr<FileSystem> MakeFileSystem(Location location,
 {
   const std::string nand_root =
       File::GetUserPath(location == Location::Session ? D_SESSION_WIIROOT_IDX : D_WIIROOT_IDX);
-  return std::make_unique<HostFileSystem>(nand_root, std::move(nand_redirects));
+  // Only the session NAND is used by the emulated software, the configured one is only accessed
+  // in bulk when copying between the two
+  const u64 cache_size = location == Location::Session ?
+                             u64{Config::Get(Config::MAIN_WII_NAND_CACHE_SIZE)} << 20 :
+                             0;
+  return std::make_unique<HostFileSystem>(nand_root, std::move(nand_redirects), cache_size);
 }
 
 IOS::HLE::ReturnCode ConvertResult(ResultCode code)
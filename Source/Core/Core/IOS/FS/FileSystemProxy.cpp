@@ -326,8 +326,9 @@ std::optional<IPCReply> FSDevice::Read(const ReadWriteRequest& request)
   return MakeIPCReply([&](Ticks t) {
     auto& system = GetSystem();
     auto& memory = system.GetMemory();
-    return m_core.Read(request.fd, memory.GetPointerForRange(request.buffer, request.size),
-                       request.size, request.buffer, t);
+    u8* data = memory.GetPointerForRange(request.buffer, request.size);
+    memory.PrepareForHostWrite(data, request.size);
+    return m_core.Read(request.fd, data, request.size, request.buffer, t);
   });
 }
 
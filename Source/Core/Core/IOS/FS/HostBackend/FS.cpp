@@ -145,9 +145,13 @@ bool HostFileSystem::FstEntry::CheckPermission(Uid caller_uid, Gid caller_gid,
 }
 
 HostFileSystem::HostFileSystem(const std::string& root_path,
-                               std::vector<NandRedirect> nand_redirects)
-    : m_root_path{root_path}, m_nand_redirects(std::move(nand_redirects))
+                               std::vector<NandRedirect> nand_redirects, u64 cache_size)
+    : m_root_path{root_path}, m_nand_redirects(std::move(nand_redirects)),
+      m_file_cache_size{cache_size}
 {
+  m_write_back_thread.Reset("IOS FS Write-Back",
+                            [this](std::string host_path) { WriteBack(host_path); });
+
   while (m_root_path.ends_with('/'))
     m_root_path.pop_back();
   File::CreateFullPath(m_root_path + '/');
@@ -155,7 +159,12 @@ HostFileSystem::HostFileSystem(const std::string& root_path,
   LoadFst();
 }
 
-HostFileSystem::~HostFileSystem() = default;
+HostFileSystem::~HostFileSystem()
+{
+  // Closing the handles queues the write-backs of their files
+  m_handles = {};
+  m_write_back_thread.Shutdown();
+}
 
 std::string HostFileSystem::GetFstFilePath() const
 {
@@ -221,19 +230,10 @@ void HostFileSystem::SaveFst()
   };
   collect_entries(collect_entries, m_root_entry);
 
-  const std::string dest_path = GetFstFilePath();
-  const std::string temp_path = File::GetTempFilenameForAtomicWrite(dest_path);
-  {
-    // This temporary file must be closed before it can be renamed.
-    File::IOFile file{temp_path, "wb"};
-    if (!file.WriteArray(to_write.data(), to_write.size()))
-    {
-      PanicAlertFmt("IOS_FS: Failed to write new FST");
-      return;
-    }
-  }
-  if (!File::Rename(temp_path, dest_path))
-    PanicAlertFmt("IOS_FS: Failed to rename temporary FST file");
+  // Changes to the metadata often come in bursts, which are written back only once
+  std::vector<u8> data(to_write.size() * sizeof(SerializedFstEntry));
+  std::memcpy(data.data(), to_write.data(), data.size());
+  QueueWriteBack(GetFstFilePath(), std::move(data));
 }
 
 HostFileSystem::FstEntry* HostFileSystem::GetFstEntryForPath(const std::string& path)
@@ -377,6 +377,14 @@ void HostFileSystem::DoState(PointerWrap& p)
   for (Handle& handle : m_handles)
     handle.host_file.reset();
 
+  // The files are read from and written to the host directly below
+  Flush();
+  if (p.IsReadMode())
+  {
+    ClearFileCache();
+    ++m_modification_count;
+  }
+
   // The format for the next part of the save state is follows:
   // 1. bool Movie::WasMovieActiveWhenStateSaved() &&
   // WiiRoot::WasWiiRootTemporaryDirectoryWhenStateSaved()
@@ -448,13 +456,17 @@ ResultCode HostFileSystem::Format(Uid uid)
     return ResultCode::AccessDenied;
   if (m_root_path.empty())
     return ResultCode::AccessDenied;
+  // Reset and close all handles.
+  m_handles = {};
+  // Nothing may be written back into the formatted NAND
+  m_write_back_thread.WaitForCompletion();
+  ClearFileCache();
   const std::string root = BuildFilename("/").host_path;
   if (!File::DeleteDirRecursively(root) || !File::CreateDir(root))
     return ResultCode::UnknownError;
   ResetFst();
   SaveFst();
-  // Reset and close all handles.
-  m_handles = {};
+  ++m_modification_count;
   return ResultCode::Success;
 }
 
@@ -499,6 +511,7 @@ ResultCode HostFileSystem::CreateFileOrDirectory(Uid uid, Gid gid, const std::st
   child->data.gid = gid;
   child->data.attribute = attr;
   SaveFst();
+  ++m_modification_count;
   return ResultCode::Success;
 }
 
@@ -546,6 +559,10 @@ ResultCode HostFileSystem::Delete(Uid uid, Gid gid, const std::string& path)
   if (!File::Exists(host_path))
     return ResultCode::NotFound;
 
+  // Files which aren't opened can still have write-backs in flight
+  m_write_back_thread.WaitForCompletion();
+  InvalidateCachedFiles(host_path);
+
   if (File::IsFile(host_path) && !IsFileOpened(path))
     File::Delete(host_path);
   else if (File::IsDirectory(host_path) && !IsDirectoryInUse(path))
@@ -558,6 +575,7 @@ ResultCode HostFileSystem::Delete(Uid uid, Gid gid, const std::string& path)
   if (it != parent->children.end())
     parent->children.erase(it);
   SaveFst();
+  ++m_modification_count;
 
   return ResultCode::Success;
 }
@@ -601,6 +619,11 @@ ResultCode HostFileSystem::Rename(Uid uid, Gid gid, const std::string& old_path,
   const std::string& host_old_path = host_old_info.host_path;
   const std::string& host_new_path = host_new_info.host_path;
 
+  // Files which aren't opened can still have write-backs in flight
+  m_write_back_thread.WaitForCompletion();
+  InvalidateCachedFiles(host_old_path);
+  InvalidateCachedFiles(host_new_path);
+
   // If there is already something of the same type at the new path, delete it.
   if (File::Exists(host_new_path))
   {
@@ -654,6 +677,7 @@ ResultCode HostFileSystem::Rename(Uid uid, Gid gid, const std::string& old_path,
   }
 
   SaveFst();
+  ++m_modification_count;
 
   return ResultCode::Success;
 }
@@ -737,7 +761,7 @@ Result<Metadata> HostFileSystem::GetMetadata(Uid uid, Gid gid, const std::string
     return ResultCode::NotFound;
 
   Metadata metadata = entry->data;
-  metadata.size = File::GetSize(BuildFilename(path).host_path);
+  metadata.size = GetHostFileSize(BuildFilename(path).host_path);
   return metadata;
 }
 
@@ -756,7 +780,7 @@ ResultCode HostFileSystem::SetMetadata(Uid caller_uid, const std::string& path,
   if (caller_uid != 0 && uid != entry->data.uid)
     return ResultCode::AccessDenied;
 
-  const bool is_empty = File::GetSize(BuildFilename(path).host_path) == 0;
+  const bool is_empty = GetHostFileSize(BuildFilename(path).host_path) == 0;
   if (entry->data.uid != uid && entry->data.is_file && !is_empty)
     return ResultCode::FileNotEmpty;
 
@@ -768,6 +792,7 @@ ResultCode HostFileSystem::SetMetadata(Uid caller_uid, const std::string& path,
     entry->data.attribute = attr;
     entry->data.modes = modes;
     SaveFst();
+    ++m_modification_count;
   }
 
   return ResultCode::Success;
@@ -822,6 +847,9 @@ HostFileSystem::GetExtendedDirectoryStats(const std::string& wii_path)
   if (!IsValidPath(wii_path))
     return ResultCode::Invalid;
 
+  // The sizes of the files are taken from the host
+  Flush();
+
   ExtendedDirectoryStats stats{};
   std::string path(BuildFilename(wii_path).host_path);
   File::FileInfo info(path);
@@ -847,6 +875,10 @@ HostFileSystem::GetExtendedDirectoryStats(const std::string& wii_path)
 
 void HostFileSystem::SetNandRedirects(std::vector<NandRedirect> nand_redirects)
 {
+  // The redirected files may be moved on the host afterwards
+  Flush();
+  ClearFileCache();
   m_nand_redirects = std::move(nand_redirects);
+  ++m_modification_count;
 }
 }  // namespace IOS::HLE::FS
@@ -4,13 +4,17 @@
 #pragma once
 
 #include <array>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/IOS/FS/FileSystem.h"
 
 namespace IOS::HLE::FS
@@ -19,10 +23,18 @@ namespace IOS::HLE::FS
 ///
 /// Ignores metadata like permissions, attributes and various checks and also
 /// sometimes returns wrong information because metadata is not available.
+///
+/// The contents of files which fit into the file cache are kept in memory while they are opened
+/// and after they are closed, and the FST and changed files are written back to the host on a
+/// worker thread. Operations which look at the host directories directly write everything back
+/// first, and so do savestates and the destructor.
 class HostFileSystem final : public FileSystem
 {
 public:
-  HostFileSystem(const std::string& root_path, std::vector<NandRedirect> nand_redirects = {});
+  /// cache_size is the number of bytes used to cache the contents of files. Larger files are
+  /// always read from and written to the host directly, and 0 disables the cache.
+  HostFileSystem(const std::string& root_path, std::vector<NandRedirect> nand_redirects = {},
+                 u64 cache_size = 0);
   ~HostFileSystem();
 
   void DoState(PointerWrap& p) override;
@@ -59,6 +71,10 @@ public:
 
   void SetNandRedirects(std::vector<NandRedirect> nand_redirects) override;
 
+  void Flush() override;
+
+  u64 GetModificationCount() const override { return m_modification_count; }
+
 private:
   void DoStateWriteOrMeasure(PointerWrap& p, std::string start_directory_path);
   void DoStateRead(PointerWrap& p, std::string start_directory_path);
@@ -76,12 +92,25 @@ private:
     std::vector<FstEntry> children;
   };
 
+  /// A host file which is opened by at least one handle.
+  struct HostFile
+  {
+    bool IsOpen() const { return contents.has_value() || file.IsOpen(); }
+    u64 GetSize() const;
+
+    /// Only open if the contents aren't kept in memory.
+    File::IOFile file;
+    std::optional<std::vector<u8>> contents;
+    /// Whether the contents were changed since they were last written back.
+    bool dirty = false;
+  };
+
   struct Handle
   {
     bool opened = false;
     Mode mode = Mode::None;
     std::string wii_path;
-    std::shared_ptr<File::IOFile> host_file;
+    std::shared_ptr<HostFile> host_file;
     u32 file_offset = 0;
   };
   Handle* AssignFreeHandle();
@@ -94,7 +123,19 @@ private:
     bool is_redirect;
   };
   HostFilename BuildFilename(const std::string& wii_path) const;
-  std::shared_ptr<File::IOFile> OpenHostFile(const std::string& host_path);
+  std::shared_ptr<HostFile> OpenHostFile(const std::string& host_path);
+  void CloseHostFile(const std::string& host_path, HostFile* file);
+  u64 GetHostFileSize(const std::string& host_path);
+
+  std::optional<std::vector<u8>> TakeCachedFile(const std::string& host_path);
+  void AddCachedFile(const std::string& host_path, std::vector<u8> contents);
+  /// Drops the cached contents of the file or directory at host_path and everything in it.
+  void InvalidateCachedFiles(const std::string& host_path);
+  void ClearFileCache();
+
+  void QueueWriteBack(const std::string& host_path, std::vector<u8> contents);
+  void WaitForWriteBack(const std::string& host_path);
+  void WriteBack(const std::string& host_path);
 
   ResultCode CreateFileOrDirectory(Uid uid, Gid gid, const std::string& path,
                                    FileAttribute attribute, Modes modes, bool is_file);
@@ -120,11 +161,29 @@ private:
   /// filesystem root manually.
   FstEntry m_root_entry{};
   std::string m_root_path;
-  std::map<std::string, std::weak_ptr<File::IOFile>> m_open_files;
+  std::map<std::string, std::weak_ptr<HostFile>> m_open_files;
   std::array<Handle, 16> m_handles{};
 
   FstEntry m_redirect_fst{};
   std::vector<NandRedirect> m_nand_redirects;
+
+  u64 m_modification_count = 0;
+
+  struct CachedFile
+  {
+    std::string host_path;
+    std::vector<u8> contents;
+  };
+  /// Contents of files which were closed, least recently used first.
+  std::list<CachedFile> m_file_cache;
+  u64 m_file_cache_used = 0;
+  u64 m_file_cache_size;
+
+  /// Contents which are waiting to be written to the host, by host path. A file which is changed
+  /// again before its write-back has started is only written once.
+  std::mutex m_write_back_mutex;
+  std::map<std::string, std::vector<u8>> m_pending_write_backs;
+  Common::WorkQueueThread<std::string> m_write_back_thread;
 };
 
 }  // namespace IOS::HLE::FS
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <utility>
 
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
@@ -13,8 +14,13 @@
 
 namespace IOS::HLE::FS
 {
+u64 HostFileSystem::HostFile::GetSize() const
+{
+  return contents ? contents->size() : file.GetSize();
+}
+
 // This isn't theadsafe, but it's only called from the CPU thread.
-std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& host_path)
+std::shared_ptr<HostFileSystem::HostFile> HostFileSystem::OpenHostFile(const std::string& host_path)
 {
   // On the wii, all file operations are strongly ordered.
   // If a game opens the same file twice (or 8 times, looking at you PokePark Wii)
@@ -40,10 +46,18 @@ std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& ho
     return search->second.lock();
   }
 
+  auto host_file = std::make_unique<HostFile>();
+  host_file->contents = TakeCachedFile(host_path);
+  if (!host_file->contents)
+  {
+    // The file on the host is outdated until its write-back has finished
+    WaitForWriteBack(host_path);
+  }
+
   // All files are opened read/write. Actual access rights will be controlled per handle by the
   // read/write functions below
-  File::IOFile file;
-  while (!file.Open(host_path, "r+b"))
+  File::IOFile& file = host_file->file;
+  while (!host_file->contents && !file.Open(host_path, "r+b"))
   {
     const bool try_again =
         PanicYesNoFmt("File \"{}\" could not be opened!\n"
@@ -59,21 +73,169 @@ std::shared_ptr<File::IOFile> HostFileSystem::OpenHostFile(const std::string& ho
     }
   }
 
+  // Files which fit into the cache are read at once and kept in memory until they are closed.
+  if (m_file_cache_size != 0 && file.IsOpen() && file.GetSize() <= m_file_cache_size)
+  {
+    std::vector<u8> contents(file.GetSize());
+    if (file.ReadBytes(contents.data(), contents.size()))
+    {
+      host_file->contents = std::move(contents);
+      file.Close();
+    }
+  }
+
   // This code will be called when all references to the shared pointer below have been removed.
-  auto deleter = [this, host_path](File::IOFile* ptr) {
+  auto deleter = [this, host_path](HostFile* ptr) {
+    CloseHostFile(host_path, ptr);
     delete ptr;                     // IOFile's deconstructor closes the file.
     m_open_files.erase(host_path);  // erase the weak pointer from the list of open files.
   };
 
   // Use the custom deleter from above.
-  std::shared_ptr<File::IOFile> file_ptr(new File::IOFile(std::move(file)), deleter);
+  std::shared_ptr<HostFile> file_ptr(host_file.release(), deleter);
 
   // Store a weak pointer to our newly opened file in the cache.
-  m_open_files[host_path] = std::weak_ptr<File::IOFile>(file_ptr);
+  m_open_files[host_path] = std::weak_ptr<HostFile>(file_ptr);
 
   return file_ptr;
 }
 
+void HostFileSystem::CloseHostFile(const std::string& host_path, HostFile* file)
+{
+  if (!file->contents)
+    return;
+
+  if (file->dirty)
+    QueueWriteBack(host_path, *file->contents);
+  AddCachedFile(host_path, std::move(*file->contents));
+}
+
+u64 HostFileSystem::GetHostFileSize(const std::string& host_path)
+{
+  const auto open_file = m_open_files.find(host_path);
+  if (open_file != m_open_files.end())
+  {
+    if (const std::shared_ptr<HostFile> file = open_file->second.lock())
+      return file->GetSize();
+  }
+
+  const auto cached_file =
+      std::find_if(m_file_cache.begin(), m_file_cache.end(),
+                   [&host_path](const CachedFile& file) { return file.host_path == host_path; });
+  if (cached_file != m_file_cache.end())
+    return cached_file->contents.size();
+
+  WaitForWriteBack(host_path);
+  return File::GetSize(host_path);
+}
+
+std::optional<std::vector<u8>> HostFileSystem::TakeCachedFile(const std::string& host_path)
+{
+  const auto it =
+      std::find_if(m_file_cache.begin(), m_file_cache.end(),
+                   [&host_path](const CachedFile& file) { return file.host_path == host_path; });
+  if (it == m_file_cache.end())
+    return std::nullopt;
+
+  std::vector<u8> contents = std::move(it->contents);
+  m_file_cache_used -= contents.size();
+  m_file_cache.erase(it);
+  return contents;
+}
+
+void HostFileSystem::AddCachedFile(const std::string& host_path, std::vector<u8> contents)
+{
+  // Files can grow past the size of the cache while they are opened
+  if (contents.size() > m_file_cache_size)
+    return;
+
+  while (m_file_cache_used + contents.size() > m_file_cache_size)
+  {
+    m_file_cache_used -= m_file_cache.front().contents.size();
+    m_file_cache.pop_front();
+  }
+
+  m_file_cache_used += contents.size();
+  m_file_cache.push_back(CachedFile{host_path, std::move(contents)});
+}
+
+void HostFileSystem::InvalidateCachedFiles(const std::string& host_path)
+{
+  std::erase_if(m_file_cache, [this, &host_path](const CachedFile& file) {
+    if (file.host_path != host_path && !file.host_path.starts_with(host_path + '/'))
+      return false;
+    m_file_cache_used -= file.contents.size();
+    return true;
+  });
+}
+
+void HostFileSystem::ClearFileCache()
+{
+  m_file_cache.clear();
+  m_file_cache_used = 0;
+}
+
+void HostFileSystem::QueueWriteBack(const std::string& host_path, std::vector<u8> contents)
+{
+  std::lock_guard lk(m_write_back_mutex);
+  if (m_pending_write_backs.insert_or_assign(host_path, std::move(contents)).second)
+    m_write_back_thread.Push(host_path);
+}
+
+void HostFileSystem::WaitForWriteBack(const std::string& host_path)
+{
+  bool pending;
+  {
+    std::lock_guard lk(m_write_back_mutex);
+    pending = m_pending_write_backs.contains(host_path);
+  }
+
+  if (pending)
+    m_write_back_thread.WaitForCompletion();
+}
+
+// NOTE: Write-back thread
+void HostFileSystem::WriteBack(const std::string& host_path)
+{
+  std::vector<u8> contents;
+  {
+    std::lock_guard lk(m_write_back_mutex);
+    auto node = m_pending_write_backs.extract(host_path);
+    if (node.empty())
+      return;
+    contents = std::move(node.mapped());
+  }
+
+  // Written to a temporary file first, so that the file isn't left half written on a crash
+  const std::string temp_path = File::GetTempFilenameForAtomicWrite(host_path);
+  {
+    // This temporary file must be closed before it can be renamed.
+    File::IOFile file{temp_path, "wb"};
+    if (!file.WriteBytes(contents.data(), contents.size()))
+    {
+      PanicAlertFmt("IOS_FS: Failed to write back {}", host_path);
+      return;
+    }
+  }
+  if (!File::Rename(temp_path, host_path))
+    PanicAlertFmt("IOS_FS: Failed to rename temporary file for {}", host_path);
+}
+
+void HostFileSystem::Flush()
+{
+  for (const auto& [host_path, weak_file] : m_open_files)
+  {
+    const std::shared_ptr<HostFile> file = weak_file.lock();
+    if (file && file->dirty)
+    {
+      QueueWriteBack(host_path, *file->contents);
+      file->dirty = false;
+    }
+  }
+
+  m_write_back_thread.WaitForCompletion();
+}
+
 Result<FileHandle> HostFileSystem::OpenFile(Uid, Gid, const std::string& path, Mode mode)
 {
   Handle* handle = AssignFreeHandle();
@@ -126,11 +288,19 @@ Result<u32> HostFileSystem::ReadBytesFromFile(Fd fd, u8* ptr, u32 count)
   if (count + handle->file_offset > file_size)
     count = file_size - handle->file_offset;
 
+  if (const auto& contents = handle->host_file->contents)
+  {
+    std::copy_n(contents->begin() + handle->file_offset, count, ptr);
+    handle->file_offset += count;
+    return count;
+  }
+
   // File might be opened twice, need to seek before we read
-  handle->host_file->Seek(handle->file_offset, File::SeekOrigin::Begin);
-  const u32 actually_read = static_cast<u32>(fread(ptr, 1, count, handle->host_file->GetHandle()));
+  File::IOFile& file = handle->host_file->file;
+  file.Seek(handle->file_offset, File::SeekOrigin::Begin);
+  const u32 actually_read = static_cast<u32>(fread(ptr, 1, count, file.GetHandle()));
 
-  if (actually_read != count && ferror(handle->host_file->GetHandle()))
+  if (actually_read != count && ferror(file.GetHandle()))
     return ResultCode::AccessDenied;
 
   // IOS returns the number of bytes read and adds that value to the seek position,
@@ -148,10 +318,24 @@ Result<u32> HostFileSystem::WriteBytesToFile(Fd fd, const u8* ptr, u32 count)
   if ((u8(handle->mode) & u8(Mode::Write)) == 0)
     return ResultCode::AccessDenied;
 
+  if (auto& contents = handle->host_file->contents)
+  {
+    // Written back to the host once the file is closed
+    if (handle->file_offset + count > contents->size())
+      contents->resize(handle->file_offset + count);
+    std::copy_n(ptr, count, contents->begin() + handle->file_offset);
+    handle->host_file->dirty = true;
+    handle->file_offset += count;
+    ++m_modification_count;
+    return count;
+  }
+
   // File might be opened twice, need to seek before we read
-  handle->host_file->Seek(handle->file_offset, File::SeekOrigin::Begin);
-  if (!handle->host_file->WriteBytes(ptr, count))
+  File::IOFile& file = handle->host_file->file;
+  file.Seek(handle->file_offset, File::SeekOrigin::Begin);
+  if (!file.WriteBytes(ptr, count))
     return ResultCode::AccessDenied;
+  ++m_modification_count;
 
   handle->file_offset += count;
   return count;
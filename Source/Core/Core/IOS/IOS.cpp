@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <array>
 #include <deque>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -66,6 +67,7 @@ namespace IOS::HLE
 {
 constexpr u64 ENQUEUE_REQUEST_FLAG = 0x100000000ULL;
 static CoreTiming::EventType* s_event_enqueue;
+static CoreTiming::EventType* s_event_finish_async_command;
 static CoreTiming::EventType* s_event_finish_ppc_bootstrap;
 static CoreTiming::EventType* s_event_finish_ios_boot;
 
@@ -322,6 +324,13 @@ EmulationKernel::EmulationKernel(Core::System& system, u64 title_id)
   m_fs = FS::MakeFileSystem(IOS::HLE::FS::Location::Session, Core::GetActiveNandRedirects());
   ASSERT(m_fs);
 
+  m_async_requests_enabled =
+      Config::Get(Config::MAIN_ASYNC_IOS_REQUESTS) && !Core::WantsDeterminism();
+  for (auto& worker : m_async_workers)
+  {
+    worker.Reset("IOS Worker", [](std::packaged_task<IPCReply()> work) { work(); });
+  }
+
   AddDevice(std::make_unique<AesDevice>(*this, "/dev/aes"));
   AddDevice(std::make_unique<ShaDevice>(*this, "/dev/sha"));
 
@@ -336,6 +345,11 @@ EmulationKernel::EmulationKernel(Core::System& system, u64 title_id)
 EmulationKernel::~EmulationKernel()
 {
   m_system.GetCoreTiming().RemoveAllEvents(s_event_enqueue);
+  m_system.GetCoreTiming().RemoveAllEvents(s_event_finish_async_command);
+
+  // The work may still use the devices
+  for (auto& worker : m_async_workers)
+    worker.Shutdown();
 
   m_device_map.clear();
   m_socket_manager.reset();
@@ -768,14 +782,70 @@ void EmulationKernel::ExecuteIPCCommand(const u32 address)
   if (!result)
     return;
 
+  EnqueueOrderedIPCReply(request, *result);
+}
+
+void EmulationKernel::EnqueueOrderedIPCReply(const Request& request, IPCReply reply)
+{
   // Ensure replies happen in order
   auto& core_timing = GetSystem().GetCoreTiming();
   const s64 ticks_until_last_reply = m_last_reply_time - core_timing.GetTicks();
   if (ticks_until_last_reply > 0)
-    result->reply_delay_ticks += ticks_until_last_reply;
-  m_last_reply_time = core_timing.GetTicks() + result->reply_delay_ticks;
+    reply.reply_delay_ticks += ticks_until_last_reply;
+  m_last_reply_time = core_timing.GetTicks() + reply.reply_delay_ticks;
 
-  EnqueueIPCReply(request, result->return_value, result->reply_delay_ticks);
+  EnqueueIPCReply(request, reply.return_value, reply.reply_delay_ticks);
+}
+
+std::optional<IPCReply> EmulationKernel::ExecuteAsync(const Device& device, const Request& request,
+                                                      u64 min_reply_ticks,
+                                                      std::function<IPCReply()> work)
+{
+  if (!m_async_requests_enabled)
+    return work();
+
+  std::packaged_task<IPCReply()> task(std::move(work));
+  m_async_commands.insert_or_assign(request.address,
+                                    AsyncCommand{min_reply_ticks, task.get_future(), {}});
+
+  const size_t worker = std::hash<std::string_view>{}(device.GetDeviceName()) % ASYNC_WORKER_COUNT;
+  m_async_workers[worker].Push(std::move(task));
+
+  GetSystem().GetCoreTiming().ScheduleEvent(min_reply_ticks, s_event_finish_async_command,
+                                            request.address);
+  return std::nullopt;
+}
+
+void EmulationKernel::WaitForAsyncWork()
+{
+  for (auto& worker : m_async_workers)
+    worker.WaitForCompletion();
+}
+
+void EmulationKernel::FinishAsyncCommand(u32 request_address)
+{
+  const auto it = m_async_commands.find(request_address);
+  if (it == m_async_commands.end())
+  {
+    ERROR_LOG_FMT(IOS, "There is no asynchronous command for request {:#010x}", request_address);
+    return;
+  }
+
+  AsyncCommand& command = it->second;
+  if (!command.reply)
+  {
+    const u64 wall_time_before = Common::Timer::NowUs();
+    command.reply = command.future.get();
+    const u64 wall_time_after = Common::Timer::NowUs();
+    DEBUG_LOG_FMT(IOS, "Waited {} microseconds for the host work of request {:#010x}",
+                  wall_time_after - wall_time_before, request_address);
+  }
+
+  IPCReply reply = *command.reply;
+  reply.reply_delay_ticks -= std::min(reply.reply_delay_ticks, command.min_reply_ticks);
+  m_async_commands.erase(it);
+
+  EnqueueOrderedIPCReply(Request{GetSystem(), request_address}, reply);
 }
 
 // Happens AS SOON AS IPC gets a new pointer!
@@ -851,6 +921,8 @@ void EmulationKernel::UpdateDevices()
 
 void EmulationKernel::UpdateWantDeterminism(const bool new_want_determinism)
 {
+  // Commands which were already started on a worker still finish there
+  m_async_requests_enabled = Config::Get(Config::MAIN_ASYNC_IOS_REQUESTS) && !new_want_determinism;
   if (m_socket_manager)
     m_socket_manager->UpdateWantDeterminism(new_want_determinism);
   for (const auto& device : m_device_map)
@@ -859,6 +931,44 @@ void EmulationKernel::UpdateWantDeterminism(const bool new_want_determinism)
 
 void EmulationKernel::DoState(PointerWrap& p)
 {
+  // The devices' state may only be saved once their work has finished, and the results of
+  // commands which haven't replied yet are stored in the state
+  WaitForAsyncWork();
+  for (auto& [address, command] : m_async_commands)
+  {
+    if (!command.reply)
+      command.reply = command.future.get();
+  }
+
+  u32 async_command_count = static_cast<u32>(m_async_commands.size());
+  p.Do(async_command_count);
+  if (p.IsReadMode())
+  {
+    m_async_commands.clear();
+    for (u32 i = 0; i < async_command_count; ++i)
+    {
+      u32 address = 0;
+      u64 min_reply_ticks = 0;
+      IPCReply reply{0, 0};
+      p.Do(address);
+      p.Do(min_reply_ticks);
+      p.Do(reply.return_value);
+      p.Do(reply.reply_delay_ticks);
+      m_async_commands.emplace(address, AsyncCommand{min_reply_ticks, {}, reply});
+    }
+  }
+  else
+  {
+    for (auto& [address, command] : m_async_commands)
+    {
+      u32 address_copy = address;
+      p.Do(address_copy);
+      p.Do(command.min_reply_ticks);
+      p.Do(command.reply->return_value);
+      p.Do(command.reply->reply_delay_ticks);
+    }
+  }
+
   p.Do(m_request_queue);
   p.Do(m_reply_queue);
   p.Do(m_last_reply_time);
@@ -962,6 +1072,13 @@ void Init(Core::System& system)
           ios->HandleIPCEvent(userdata);
       });
 
+  s_event_finish_async_command = core_timing.RegisterEvent(
+      "IOSFinishAsyncCommand", [](Core::System& system_, u64 userdata, s64) {
+        auto* ios = system_.GetIOS();
+        if (ios)
+          ios->FinishAsyncCommand(static_cast<u32>(userdata));
+      });
+
   ESDevice::InitializeEmulationState(core_timing);
 
   s_event_finish_ppc_bootstrap =
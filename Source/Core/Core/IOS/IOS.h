@@ -5,6 +5,8 @@
 
 #include <array>
 #include <deque>
+#include <functional>
+#include <future>
 #include <map>
 #include <memory>
 #include <optional>
@@ -13,6 +15,7 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/IOS/IOSC.h"
@@ -71,6 +74,8 @@ public:
       *m_ticks += ticks;
   }
 
+  bool IsTracked() const { return m_ticks != nullptr; }
+
 private:
   u64* m_ticks = nullptr;
 };
@@ -176,6 +181,21 @@ public:
   void EnqueueIPCReply(const Request& request, s32 return_value, s64 cycles_in_future = 0,
                        CoreTiming::FromThread from = CoreTiming::FromThread::CPU);
 
+  // Runs the host side of a request, such as blocking file I/O, on an IOS worker thread while the
+  // emulated CPU keeps running. The reply is sent min_reply_ticks after the request, or after the
+  // delay of the reply itself if that is longer. If the work hasn't finished by then, the CPU
+  // thread waits for it, so that the emulated timing never depends on the host.
+  //
+  // The work may access emulated memory, and state of the device which nothing else touches
+  // until the work has finished. The work of one device runs in order. Returns std::nullopt,
+  // which the device should return as its reply. If asynchronous requests are disabled, the work
+  // runs right away and its reply is returned instead.
+  std::optional<IPCReply> ExecuteAsync(const Device& device, const Request& request,
+                                       u64 min_reply_ticks, std::function<IPCReply()> work);
+  // Waits until the work started by ExecuteAsync has finished on the host
+  void WaitForAsyncWork();
+  void FinishAsyncCommand(u32 request_address);
+
   void SetUidForPPC(u32 uid);
   u32 GetUidForPPC() const;
   void SetGidForPPC(u16 gid);
@@ -191,6 +211,7 @@ public:
 private:
   void ExecuteIPCCommand(u32 address);
   std::optional<IPCReply> HandleIPCCommand(const Request& request);
+  void EnqueueOrderedIPCReply(const Request& request, IPCReply reply);
 
   void AddDevice(std::unique_ptr<Device> device);
 
@@ -213,6 +234,22 @@ private:
   IPCMsgQueue m_reply_queue;    // arm -> ppc
   u64 m_last_reply_time = 0;
   bool m_ipc_paused = false;
+
+  struct AsyncCommand
+  {
+    u64 min_reply_ticks;
+    std::future<IPCReply> future;
+    // Taken from the future once the work has finished
+    std::optional<IPCReply> reply;
+  };
+  // By request address
+  std::map<u32, AsyncCommand> m_async_commands;
+  bool m_async_requests_enabled = false;
+
+  // Each device is always handled by the same worker, which keeps its work in order
+  static constexpr size_t ASYNC_WORKER_COUNT = 2;
+  std::array<Common::WorkQueueThread<std::packaged_task<IPCReply()>>, ASYNC_WORKER_COUNT>
+      m_async_workers;
 };
 
 // Used for controlling and accessing an IOS instance that is tied to emulation.
@@ -269,6 +269,15 @@ void WiiSocket::Update(bool read, bool write, bool except)
   auto it = pending_sockops.begin();
   while (it != pending_sockops.end())
   {
+    // A blocking operation which couldn't complete yet is only attempted again once the socket
+    // is ready for it
+    if (it->is_attempted && !it->is_aborted && !IsReadyFor(*it, read, write, except))
+    {
+      ++it;
+      continue;
+    }
+    it->is_attempted = true;
+
     s32 ReturnValue = 0;
     bool forceNonBlock = false;
     IPCCommandType ct = it->request.command;
@@ -650,6 +659,8 @@ void WiiSocket::Update(bool read, bool write, bool except)
           int data_len = BufferOutSize;
           // Not a string, Windows requires a char* for recvfrom
           char* data = reinterpret_cast<char*>(memory.GetPointerForRange(BufferOut, BufferOutSize));
+          // The kernel writes the data, so write tracking would not see it.
+          memory.PrepareForHostWrite(reinterpret_cast<u8*>(data), BufferOutSize);
 
           sockaddr_in local_name;
           memset(&local_name, 0, sizeof(sockaddr_in));
@@ -731,6 +742,29 @@ void WiiSocket::Update(bool read, bool write, bool except)
   }
 }
 
+bool WiiSocket::IsReadyFor(const sockop& op, bool read, bool write, bool except)
+{
+  // Errors and hangups have to be reported by the operation
+  if (except)
+    return true;
+
+  // mbedTLS may be waiting for either direction, depending on where the record layer is
+  if (op.is_ssl)
+    return read || write;
+
+  switch (op.net_type)
+  {
+  case IOCTL_SO_ACCEPT:
+  case IOCTLV_SO_RECVFROM:
+    return read;
+  case IOCTLV_SO_SENDTO:
+    return write;
+  default:
+    // Including connect, which has to check its timeout on every update
+    return true;
+  }
+}
+
 void WiiSocket::UpdateConnectingState(s32 connect_rv)
 {
   if (connect_rv == -SO_EAGAIN || connect_rv == -SO_EALREADY || connect_rv == -SO_EINPROGRESS)
@@ -996,52 +1030,41 @@ void WiiSockMan::EnqueueIPCReply(const Request& request, s32 return_value) const
 
 void WiiSockMan::Update()
 {
-  s32 nfds = 0;
-  fd_set read_fds, write_fds, except_fds;
-  struct timeval t = {0, 0};
-  FD_ZERO(&read_fds);
-  FD_ZERO(&write_fds);
-  FD_ZERO(&except_fds);
-
-  auto socket_iter = WiiSockets.begin();
-  auto end_socks = WiiSockets.end();
+  // Good time to clean up invalid sockets.
+  std::erase_if(WiiSockets, [](const auto& entry) { return !entry.second.IsValid(); });
 
-  while (socket_iter != end_socks)
+  m_update_fds.clear();
+  m_update_wii_fds.clear();
+  for (const auto& [wii_fd, sock] : WiiSockets)
   {
-    const WiiSocket& sock = socket_iter->second;
-    if (sock.IsValid())
-    {
-      FD_SET(sock.fd, &read_fds);
-      FD_SET(sock.fd, &write_fds);
-      FD_SET(sock.fd, &except_fds);
-      nfds = std::max(nfds, sock.fd + 1);
-      ++socket_iter;
-    }
-    else
-    {
-      // Good time to clean up invalid sockets.
-      socket_iter = WiiSockets.erase(socket_iter);
-    }
-  }
-
-  const s32 ret = select(nfds, &read_fds, &write_fds, &except_fds, &t);
+    if (sock.pending_sockops.empty())
+      continue;
 
-  if (ret >= 0)
-  {
-    for (auto& pair : WiiSockets)
-    {
-      WiiSocket& sock = pair.second;
-      sock.Update(FD_ISSET(sock.fd, &read_fds) != 0, FD_ISSET(sock.fd, &write_fds) != 0,
-                  FD_ISSET(sock.fd, &except_fds) != 0);
-    }
+    pollfd_t pfd{};
+    pfd.fd = sock.fd;
+    pfd.events = POLLIN | POLLOUT;
+    m_update_fds.push_back(pfd);
+    m_update_wii_fds.push_back(wii_fd);
   }
-  else
+
+  if (!m_update_fds.empty())
   {
-    for (auto& elem : WiiSockets)
+    const int ret = poll(m_update_fds.data(), m_update_fds.size(), 0);
+
+    // The sockets are looked up again, since accepting a connection adds one
+    for (size_t i = 0; i < m_update_wii_fds.size(); ++i)
     {
-      elem.second.Update(false, false, false);
+      const auto socket_entry = WiiSockets.find(m_update_wii_fds[i]);
+      if (socket_entry == WiiSockets.end())
+        continue;
+
+      // If polling failed, every operation is attempted again as if its socket was ready
+      const int revents = ret < 0 ? POLLIN | POLLOUT : m_update_fds[i].revents;
+      socket_entry->second.Update((revents & POLLIN) != 0, (revents & POLLOUT) != 0,
+                                  (revents & (POLLERR | POLLHUP | POLLNVAL)) != 0);
     }
   }
+
   UpdatePollCommands();
 }
 
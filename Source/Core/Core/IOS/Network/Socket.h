@@ -194,6 +194,7 @@ private:
     Request request;
     bool is_ssl;
     bool is_aborted = false;
+    bool is_attempted = false;
     union
     {
       NET_IOCTL net_type;
@@ -223,6 +224,7 @@ private:
   void DoSock(Request request, NET_IOCTL type);
   void DoSock(Request request, SSL_IOCTL type);
   void Update(bool read, bool write, bool except);
+  static bool IsReadyFor(const sockop& op, bool read, bool write, bool except);
   void UpdateConnectingState(s32 connect_rv);
   ConnectingState GetConnectingState() const;
   bool IsValid() const { return fd >= 0; }
@@ -311,6 +313,9 @@ private:
   std::unordered_map<s32, WiiSocket> WiiSockets;
   s32 errno_last = 0;
   std::vector<PollCommand> pending_polls;
+  // The sockets polled by Update, which are only the ones with pending operations
+  std::vector<pollfd_t> m_update_fds;
+  std::vector<s32> m_update_wii_fds;
   std::chrono::time_point<std::chrono::high_resolution_clock> last_time =
       std::chrono::high_resolution_clock::now();
 };
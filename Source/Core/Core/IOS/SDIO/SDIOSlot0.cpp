@@ -108,6 +108,7 @@ void SDIOSlot0Device::OpenInternal()
 
 std::optional<IPCReply> SDIOSlot0Device::Open(const OpenRequest& request)
 {
+  GetEmulationKernel().WaitForAsyncWork();
   OpenInternal();
   m_registers.fill(0);
 
@@ -118,6 +119,7 @@ std::optional<IPCReply> SDIOSlot0Device::Open(const OpenRequest& request)
 
 std::optional<IPCReply> SDIOSlot0Device::Close(u32 fd)
 {
+  GetEmulationKernel().WaitForAsyncWork();
   m_card.Close();
   m_block_length = 0;
   m_bus_width = 0;
@@ -287,7 +289,9 @@ s32 SDIOSlot0Device::ExecuteCommand(const Request& request, u32 buffer_in, u32 b
       if (!m_card.Seek(address, File::SeekOrigin::Begin))
         ERROR_LOG_FMT(IOS_SD, "Seek failed");
 
-      if (m_card.ReadBytes(memory.GetPointerForRange(req.addr, size), size))
+      u8* data = memory.GetPointerForRange(req.addr, size);
+      memory.PrepareForHostWrite(data, size);
+      if (m_card.ReadBytes(data, size))
       {
         DEBUG_LOG_FMT(IOS_SD, "Outbuffer size {} got {}", rw_buffer_size, size);
       }
@@ -309,6 +313,7 @@ s32 SDIOSlot0Device::ExecuteCommand(const Request& request, u32 buffer_in, u32 b
     INFO_LOG_FMT(IOS_SD, "{}Write {} Block(s) from {:#010x} bsize {} to offset {:#010x}!",
                  req.isDMA ? "DMA " : "", req.blocks, req.addr, req.bsize, req.arg);
 
+    // NOTE: This may run on an IOS worker thread
     if (m_card && Config::Get(Config::MAIN_ALLOW_SD_WRITES))
     {
       const u32 size = req.bsize * req.blocks;
@@ -449,6 +454,17 @@ std::optional<IPCReply> SDIOSlot0Device::SendCommand(const IOCtlRequest& request
   INFO_LOG_FMT(IOS_SD, "IOCTL_SENDCMD {:x} IPC:{:08x}", memory.Read_U32(request.buffer_in),
                request.address);
 
+  if (IsBlockTransfer(request.buffer_in))
+  {
+    return GetEmulationKernel().ExecuteAsync(*this, request, BLOCK_TRANSFER_TICKS, [this, request] {
+      ExecuteCommand(request, request.buffer_in, request.buffer_in_size, 0, 0, request.buffer_out,
+                     request.buffer_out_size);
+      return IPCReply(IPC_SUCCESS);
+    });
+  }
+
+  // Everything else may access the card, which the block transfers use on a worker thread
+  GetEmulationKernel().WaitForAsyncWork();
   const s32 return_value = ExecuteCommand(request, request.buffer_in, request.buffer_in_size, 0, 0,
                                           request.buffer_out, request.buffer_out_size);
 
@@ -464,6 +480,8 @@ std::optional<IPCReply> SDIOSlot0Device::SendCommand(const IOCtlRequest& request
 
 IPCReply SDIOSlot0Device::GetStatus(const IOCtlRequest& request)
 {
+  GetEmulationKernel().WaitForAsyncWork();
+
   // Since IOS does the SD initialization itself, we just say we're always initialized.
   if (m_card)
   {
@@ -513,7 +531,7 @@ IPCReply SDIOSlot0Device::GetOCRegister(const IOCtlRequest& request)
   return IPCReply(IPC_SUCCESS);
 }
 
-IPCReply SDIOSlot0Device::SendCommand(const IOCtlVRequest& request)
+std::optional<IPCReply> SDIOSlot0Device::SendCommand(const IOCtlVRequest& request)
 {
   auto& system = GetSystem();
   auto& memory = system.GetMemory();
@@ -521,12 +539,25 @@ IPCReply SDIOSlot0Device::SendCommand(const IOCtlVRequest& request)
   DEBUG_LOG_FMT(IOS_SD, "IOCTLV_SENDCMD {:#010x}", memory.Read_U32(request.in_vectors[0].address));
   memory.Memset(request.io_vectors[0].address, 0, request.io_vectors[0].size);
 
-  const s32 return_value =
-      ExecuteCommand(request, request.in_vectors[0].address, request.in_vectors[0].size,
-                     request.in_vectors[1].address, request.in_vectors[1].size,
-                     request.io_vectors[0].address, request.io_vectors[0].size);
+  const auto execute = [this, request] {
+    return IPCReply(ExecuteCommand(request, request.in_vectors[0].address,
+                                   request.in_vectors[0].size, request.in_vectors[1].address,
+                                   request.in_vectors[1].size, request.io_vectors[0].address,
+                                   request.io_vectors[0].size));
+  };
 
-  return IPCReply(return_value);
+  if (IsBlockTransfer(request.in_vectors[0].address))
+    return GetEmulationKernel().ExecuteAsync(*this, request, BLOCK_TRANSFER_TICKS, execute);
+
+  // Everything else may access the card, which the block transfers use on a worker thread
+  GetEmulationKernel().WaitForAsyncWork();
+  return execute();
+}
+
+bool SDIOSlot0Device::IsBlockTransfer(u32 buffer_in) const
+{
+  const u32 command = GetSystem().GetMemory().Read_U32(buffer_in);
+  return command == READ_MULTIPLE_BLOCK || command == WRITE_MULTIPLE_BLOCK;
 }
 
 u32 SDIOSlot0Device::GetOCRegister() const
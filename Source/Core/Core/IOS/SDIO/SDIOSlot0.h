@@ -117,6 +117,11 @@ private:
   // Used to trigger using SDHC instead of SDSC
   static constexpr u64 SDSC_MAX_SIZE = 0x80000000;
 
+  // The reply time of block transfers, which is the same as for the other commands. When the
+  // transfers are handled asynchronously, this is how long the host has to do them before the
+  // emulated CPU waits for them.
+  static constexpr u64 BLOCK_TRANSFER_TICKS = 4000_tbticks;
+
   struct Event
   {
     Event(EventType type_, Request request_) : type(type_), request(request_) {}
@@ -136,7 +141,9 @@ private:
   IPCReply GetStatus(const IOCtlRequest& request);
   IPCReply GetOCRegister(const IOCtlRequest& request);
 
-  IPCReply SendCommand(const IOCtlVRequest& request);
+  std::optional<IPCReply> SendCommand(const IOCtlVRequest& request);
+  // Block transfers are the only commands which are handled asynchronously
+  bool IsBlockTransfer(u32 buffer_in) const;
 
   s32 ExecuteCommand(const Request& request, u32 buffer_in, u32 buffer_in_size, u32 rw_buffer,
                      u32 rw_buffer_size, u32 buffer_out, u32 buffer_out_size);
@@ -297,7 +297,9 @@ std::optional<IPCReply> WFSSRVDevice::IOCtl(const IOCtlRequest& request)
       fd_obj->file.Seek(position, File::SeekOrigin::Begin);
     }
     size_t read_bytes;
-    fd_obj->file.ReadArray(memory.GetPointerForRange(addr, size), size, &read_bytes);
+    u8* data = memory.GetPointerForRange(addr, size);
+    memory.PrepareForHostWrite(data, size);
+    fd_obj->file.ReadArray(data, size, &read_bytes);
     // TODO(wfs): Handle read errors.
     if (absolute)
     {
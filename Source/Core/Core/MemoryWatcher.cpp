@@ -3,16 +3,27 @@
 
 #include "Core/MemoryWatcher.h"
 
+#include <algorithm>
 #include <cstring>
+#include <fcntl.h>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <new>
 #include <sstream>
+#include <sys/mman.h>
 #include <unistd.h>
 
 #include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/Swap.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/PowerPC/MMU.h"
 
+static constexpr size_t SHARED_MEMORY_SIZE =
+    sizeof(MemoryWatcher::SharedMemoryHeader) + MemoryWatcher::SHARED_MEMORY_DATA_SIZE;
+
 MemoryWatcher::MemoryWatcher()
 {
   m_running = false;
@@ -20,6 +31,14 @@ MemoryWatcher::MemoryWatcher()
     return;
   if (!OpenSocket(File::GetUserPath(F_MEMORYWATCHERSOCKET_IDX)))
     return;
+
+  m_binary_output = Config::Get(Config::MAIN_MEMORY_WATCHER_BINARY_OUTPUT);
+  if (Config::Get(Config::MAIN_MEMORY_WATCHER_SHARED_MEMORY) &&
+      !OpenSharedMemory(File::GetUserPath(F_MEMORYWATCHERSHAREDMEMORY_IDX)))
+  {
+    ERROR_LOG_FMT(CORE, "MemoryWatcher: Failed to set up the shared memory output");
+  }
+
   m_running = true;
 }
 
@@ -30,6 +49,8 @@ MemoryWatcher::~MemoryWatcher()
 
   m_running = false;
   close(m_fd);
+  if (m_shared_memory)
+    munmap(m_shared_memory, SHARED_MEMORY_SIZE);
 }
 
 bool MemoryWatcher::LoadAddresses(const std::string& path)
@@ -40,22 +61,35 @@ bool MemoryWatcher::LoadAddresses(const std::string& path)
     return false;
 
   std::string line;
-  while (std::getline(locations, line))
-    ParseLine(line);
+  for (u32 index = 0; std::getline(locations, line); ++index)
+    ParseLine(line, index);
 
-  return !m_values.empty();
+  return !m_watches.empty();
 }
 
-void MemoryWatcher::ParseLine(const std::string& line)
+void MemoryWatcher::ParseLine(const std::string& line, u32 index)
 {
-  m_values[line] = 0;
-  m_addresses[line] = std::vector<u32>();
+  Watch watch{line, index, {}, 0, {}};
 
-  std::istringstream offsets(line);
+  const size_t colon = line.find(':');
+  std::istringstream offsets(line.substr(0, colon));
   offsets >> std::hex;
   u32 offset;
   while (offsets >> offset)
-    m_addresses[line].push_back(offset);
+    watch.offsets.push_back(offset);
+
+  if (colon != std::string::npos)
+  {
+    std::istringstream size(line.substr(colon + 1));
+    if (!(size >> std::hex >> watch.range_size) || watch.range_size == 0 || watch.offsets.empty())
+    {
+      ERROR_LOG_FMT(CORE, "MemoryWatcher: Ignoring invalid range \"{}\"", line);
+      return;
+    }
+  }
+
+  watch.value.resize(watch.range_size != 0 ? watch.range_size : sizeof(u32));
+  m_watches.push_back(std::move(watch));
 }
 
 bool MemoryWatcher::OpenSocket(const std::string& path)
@@ -67,10 +101,29 @@ bool MemoryWatcher::OpenSocket(const std::string& path)
   return m_fd >= 0;
 }
 
-u32 MemoryWatcher::ChasePointer(const Core::CPUThreadGuard& guard, const std::string& line)
+bool MemoryWatcher::OpenSharedMemory(const std::string& path)
+{
+  const int fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd < 0)
+    return false;
+
+  void* memory = MAP_FAILED;
+  if (ftruncate(fd, SHARED_MEMORY_SIZE) == 0)
+    memory = mmap(nullptr, SHARED_MEMORY_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED)
+    return false;
+
+  m_shared_memory = new (memory) SharedMemoryHeader{SHARED_MEMORY_MAGIC, SHARED_MEMORY_VERSION,
+                                                    SHARED_MEMORY_DATA_SIZE, 0, 0};
+  m_shared_memory_data = static_cast<u8*>(memory) + sizeof(SharedMemoryHeader);
+  return true;
+}
+
+u32 MemoryWatcher::ChasePointer(const Core::CPUThreadGuard& guard, const Watch& watch)
 {
   u32 value = 0;
-  for (u32 offset : m_addresses[line])
+  for (u32 offset : watch.offsets)
   {
     value = PowerPC::MMU::HostRead_U32(guard, value + offset);
     if (!PowerPC::MMU::HostIsRAMAddress(guard, value))
@@ -79,34 +132,158 @@ u32 MemoryWatcher::ChasePointer(const Core::CPUThreadGuard& guard, const std::st
   return value;
 }
 
-std::string MemoryWatcher::ComposeMessages(const Core::CPUThreadGuard& guard)
+std::vector<u8> MemoryWatcher::ReadValue(const Core::CPUThreadGuard& guard, const Watch& watch)
+{
+  if (watch.range_size == 0)
+  {
+    const u32 value = Common::swap32(ChasePointer(guard, watch));
+    std::vector<u8> bytes(sizeof(u32));
+    std::memcpy(bytes.data(), &value, sizeof(u32));
+    return bytes;
+  }
+
+  // Follow all but the last offset, which is the offset of the range itself. If a pointer on the
+  // way isn't valid, the range reads as zeroes.
+  std::vector<u8> bytes(watch.range_size);
+  u32 address = 0;
+  for (size_t i = 0; i + 1 < watch.offsets.size(); ++i)
+  {
+    address = PowerPC::MMU::HostRead_U32(guard, address + watch.offsets[i]);
+    if (!PowerPC::MMU::HostIsRAMAddress(guard, address))
+      return bytes;
+  }
+  address += watch.offsets.back();
+
+  for (u32 i = 0; i < watch.range_size; ++i)
+  {
+    if (const auto result = PowerPC::MMU::HostTryReadU8(guard, address + i))
+      bytes[i] = result->value;
+  }
+  return bytes;
+}
+
+std::vector<const MemoryWatcher::Watch*>
+MemoryWatcher::UpdateValues(const Core::CPUThreadGuard& guard)
+{
+  std::vector<const Watch*> changed;
+  for (Watch& watch : m_watches)
+  {
+    std::vector<u8> new_value = ReadValue(guard, watch);
+    if (new_value != watch.value)
+    {
+      watch.value = std::move(new_value);
+      changed.push_back(&watch);
+    }
+  }
+  return changed;
+}
+
+std::string MemoryWatcher::ComposeTextMessage(const std::vector<const Watch*>& changed) const
 {
   std::ostringstream message_stream;
   message_stream << std::hex;
 
-  for (auto& entry : m_values)
+  for (const Watch* watch : changed)
   {
-    std::string address = entry.first;
-    u32& current_value = entry.second;
-
-    u32 new_value = ChasePointer(guard, address);
-    if (new_value != current_value)
+    message_stream << watch->line << '\n';
+    if (watch->range_size == 0)
     {
-      // Update the value
-      current_value = new_value;
-      message_stream << address << '\n' << new_value << '\n';
+      u32 value;
+      std::memcpy(&value, watch->value.data(), sizeof(u32));
+      message_stream << Common::swap32(value);
     }
+    else
+    {
+      for (u8 byte : watch->value)
+        message_stream << std::setw(2) << std::setfill('0') << static_cast<u32>(byte);
+    }
+    message_stream << '\n';
   }
 
   return message_stream.str();
 }
 
+std::vector<u8> MemoryWatcher::ComposeBinaryMessage(const std::vector<const Watch*>& changed) const
+{
+  size_t size = sizeof(u32);
+  for (const Watch* watch : changed)
+    size += 2 * sizeof(u32) + watch->value.size();
+
+  std::vector<u8> message(size);
+  u8* out = message.data();
+  const auto append = [&out](const void* data, size_t length) {
+    std::memcpy(out, data, length);
+    out += length;
+  };
+
+  const u32 count = static_cast<u32>(changed.size());
+  append(&count, sizeof(count));
+  for (const Watch* watch : changed)
+  {
+    const u32 value_size = static_cast<u32>(watch->value.size());
+    append(&watch->index, sizeof(watch->index));
+    append(&value_size, sizeof(value_size));
+    append(watch->value.data(), value_size);
+  }
+
+  return message;
+}
+
+void MemoryWatcher::WriteToSharedMemory(const std::vector<u8>& message)
+{
+  const u32 message_size = static_cast<u32>(message.size());
+  if (sizeof(u32) + message_size > SHARED_MEMORY_DATA_SIZE)
+  {
+    ERROR_LOG_FMT(CORE, "MemoryWatcher: Message of {} bytes doesn't fit into shared memory",
+                  message_size);
+    return;
+  }
+
+  // Only this thread writes, so the position can't change under us
+  u64 position = m_shared_memory->write_position.load(std::memory_order_relaxed);
+  const auto write = [this, &position](const u8* data, size_t length) {
+    while (length != 0)
+    {
+      const size_t offset = position % SHARED_MEMORY_DATA_SIZE;
+      const size_t chunk = std::min(length, SHARED_MEMORY_DATA_SIZE - offset);
+      std::memcpy(m_shared_memory_data + offset, data, chunk);
+      data += chunk;
+      length -= chunk;
+      position += chunk;
+    }
+  };
+
+  write(reinterpret_cast<const u8*>(&message_size), sizeof(message_size));
+  write(message.data(), message.size());
+  m_shared_memory->write_position.store(position, std::memory_order_release);
+}
+
 void MemoryWatcher::Step(const Core::CPUThreadGuard& guard)
 {
   if (!m_running)
     return;
 
-  std::string message = ComposeMessages(guard);
+  const std::vector<const Watch*> changed = UpdateValues(guard);
+
+  std::vector<u8> binary_message;
+  if ((m_binary_output || m_shared_memory) && !changed.empty())
+    binary_message = ComposeBinaryMessage(changed);
+
+  if (m_shared_memory && !binary_message.empty())
+    WriteToSharedMemory(binary_message);
+
+  if (m_binary_output)
+  {
+    // Consumers of the binary output are only notified about frames in which something changed
+    if (!binary_message.empty())
+    {
+      sendto(m_fd, binary_message.data(), binary_message.size(), 0,
+             reinterpret_cast<sockaddr*>(&m_addr), sizeof(m_addr));
+    }
+    return;
+  }
+
+  std::string message = ComposeTextMessage(changed);
   sendto(m_fd, message.c_str(), message.size() + 1, 0, reinterpret_cast<sockaddr*>(&m_addr),
          sizeof(m_addr));
 }
@@ -5,7 +5,7 @@
 
 #include "Common/CommonTypes.h"
 
-#include <map>
+#include <atomic>
 #include <string>
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -21,31 +21,84 @@ class CPUThreadGuard;
 //
 // The input file is a newline-separated list of hex memory addresses, without
 // the "0x". To follow pointers, separate addresses with a space. For example,
-// "ABCD EF" will watch the address at (*0xABCD) + 0xEF.
-// The output to the socket is two lines. The first is the address from the
-// input file, and the second is the new value in hex.
+// "ABCD EF" will watch the address at (*0xABCD) + 0xEF. To watch a range of
+// bytes rather than a single 32-bit value, append a colon and the size of the
+// range in hex, e.g. "ABCD EF:40".
+//
+// By default, the output to the socket is two lines per changed value. The
+// first is the address from the input file, and the second is the new value in
+// hex (or all bytes of a range in hex).
+//
+// With MemoryWatcherBinaryOutput set, a single binary datagram is sent for
+// every frame in which anything changed, and nothing for other frames. It
+// starts with the number of changed values as a u32 and then holds, for each
+// changed value, the 0-based line number of its watch in the input file as a
+// u32, the size of the value as a u32 and then the value itself as it is in
+// emulated memory (big endian). The u32s are in the host's byte order.
+//
+// With MemoryWatcherSharedMemory set, the same binary messages are also written
+// to the SharedMemory file next to the socket, which consumers can map instead
+// of reading from the socket. The file starts with a SharedMemoryHeader,
+// followed by a ring buffer of data_size bytes. Each message in the ring is
+// its size as a u32 followed by the message, both wrapping around the end of
+// the ring. write_position is the total number of bytes ever written, and is
+// only advanced after a message has been written completely. A consumer whose
+// own position falls more than data_size bytes behind has lost messages.
 class MemoryWatcher final
 {
 public:
+  struct SharedMemoryHeader
+  {
+    u32 magic;
+    u32 version;
+    u32 data_size;
+    u32 padding;
+    std::atomic<u64> write_position;
+  };
+  static_assert(sizeof(SharedMemoryHeader) == 24);
+
+  static constexpr u32 SHARED_MEMORY_MAGIC = 0x574D4C44;  // "DLMW"
+  static constexpr u32 SHARED_MEMORY_VERSION = 1;
+  static constexpr u32 SHARED_MEMORY_DATA_SIZE = 1024 * 1024;
+
   MemoryWatcher();
   ~MemoryWatcher();
   void Step(const Core::CPUThreadGuard& guard);
 
 private:
+  struct Watch
+  {
+    // The line from the input file, which the text output refers to the watch by
+    std::string line;
+    // The 0-based line number, which the binary output refers to the watch by
+    u32 index;
+    std::vector<u32> offsets;
+    // Zero for a single 32-bit value
+    u32 range_size;
+    // The current value as it is in emulated memory
+    std::vector<u8> value;
+  };
+
   bool LoadAddresses(const std::string& path);
   bool OpenSocket(const std::string& path);
+  bool OpenSharedMemory(const std::string& path);
 
-  void ParseLine(const std::string& line);
-  u32 ChasePointer(const Core::CPUThreadGuard& guard, const std::string& line);
-  std::string ComposeMessages(const Core::CPUThreadGuard& guard);
+  void ParseLine(const std::string& line, u32 index);
+  u32 ChasePointer(const Core::CPUThreadGuard& guard, const Watch& watch);
+  std::vector<u8> ReadValue(const Core::CPUThreadGuard& guard, const Watch& watch);
+  std::vector<const Watch*> UpdateValues(const Core::CPUThreadGuard& guard);
+  std::string ComposeTextMessage(const std::vector<const Watch*>& changed) const;
+  std::vector<u8> ComposeBinaryMessage(const std::vector<const Watch*>& changed) const;
+  void WriteToSharedMemory(const std::vector<u8>& message);
 
   bool m_running = false;
+  bool m_binary_output = false;
 
   int m_fd;
   sockaddr_un m_addr{};
 
-  // Address as stored in the file -> list of offsets to follow
-  std::map<std::string, std::vector<u32>> m_addresses;
-  // Address as stored in the file -> current value
-  std::map<std::string, u32> m_values;
+  SharedMemoryHeader* m_shared_memory = nullptr;
+  u8* m_shared_memory_data = nullptr;
+
+  std::vector<Watch> m_watches;
 };
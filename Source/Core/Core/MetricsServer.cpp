@@ -0,0 +1,240 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/MetricsServer.h"
+
+#include <array>
+#include <atomic>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <SFML/Network.hpp>
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Flag.h"
+#include "Common/HookableEvent.h"
+#include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+#include "Core/HW/DVD/DVDThread.h"
+#include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/System.h"
+
+#include "VideoCommon/PerformanceMetrics.h"
+#include "VideoCommon/Statistics.h"
+#include "VideoCommon/VideoEvents.h"
+
+namespace MetricsServer
+{
+namespace
+{
+constexpr size_t MAX_REQUEST_SIZE = 8192;
+
+Common::Flag s_running;
+std::thread s_thread;
+
+// g_stats is only valid on the video thread, so its per-frame values are added up here after
+// every frame.
+Common::EventHook s_after_frame_hook;
+std::atomic<u64> s_frames = 0;
+std::atomic<u64> s_draw_calls = 0;
+std::atomic<u64> s_primitives = 0;
+std::atomic<u64> s_texture_loads = 0;
+std::atomic<u64> s_textures_uploaded = 0;
+
+void CountFrameStatistics()
+{
+  const Statistics::ThisFrame& frame = g_stats.this_frame;
+  s_frames.fetch_add(1, std::memory_order_relaxed);
+  s_draw_calls.fetch_add(frame.num_draw_calls, std::memory_order_relaxed);
+  s_primitives.fetch_add(frame.num_prims + frame.num_dl_prims, std::memory_order_relaxed);
+  s_texture_loads.fetch_add(frame.num_texture_loads, std::memory_order_relaxed);
+  s_textures_uploaded.store(g_stats.num_textures_uploaded, std::memory_order_relaxed);
+}
+
+template <typename T>
+void AppendMetric(std::string* out, std::string_view name, std::string_view type,
+                  std::string_view help, T value)
+{
+  fmt::format_to(std::back_inserter(*out), "# HELP {0} {1}\n# TYPE {0} {2}\n{0} {3}\n", name, help,
+                 type, value);
+}
+
+void AppendDVDReadLatency(std::string* out)
+{
+  constexpr std::string_view name = "dolphin_dvd_read_latency_seconds";
+  const DVD::DVDThread::ReadLatencyHistogram histogram =
+      Core::System::GetInstance().GetDVDThread().GetReadLatencyHistogram();
+
+  fmt::format_to(std::back_inserter(*out),
+                 "# HELP {0} Time from queueing a disc read until the data was read.\n"
+                 "# TYPE {0} histogram\n",
+                 name);
+  u64 count = 0;
+  for (size_t i = 0; i < DVD::DVDThread::READ_LATENCY_BUCKETS_US.size(); ++i)
+  {
+    count += histogram.bucket_counts[i];
+    fmt::format_to(std::back_inserter(*out), "{}_bucket{{le=\"{}\"}} {}\n", name,
+                   DVD::DVDThread::READ_LATENCY_BUCKETS_US[i] / 1000000.0, count);
+  }
+  count += histogram.bucket_counts.back();
+  fmt::format_to(std::back_inserter(*out),
+                 "{0}_bucket{{le=\"+Inf\"}} {1}\n{0}_sum {2}\n{0}_count {1}\n", name, count,
+                 histogram.total_us / 1000000.0);
+}
+
+void HandleClient(sf::TcpSocket& client)
+{
+  sf::SocketSelector selector;
+  selector.add(client);
+
+  // Only the request line matters, but the whole header is read so that the client doesn't get a
+  // reset connection for unread data.
+  std::string request;
+  while (request.find("\r\n\r\n") == std::string::npos)
+  {
+    if (request.size() >= MAX_REQUEST_SIZE || !selector.wait(sf::seconds(1)))
+      return;
+
+    std::array<char, 1024> buffer;
+    std::size_t received;
+    if (client.receive(buffer.data(), buffer.size(), received) != sf::Socket::Done)
+      return;
+    request.append(buffer.data(), received);
+  }
+
+  std::string_view status = "200 OK";
+  std::string body;
+  if (request.starts_with("GET /metrics "))
+  {
+    body = FormatMetrics();
+  }
+  else
+  {
+    status = "404 Not Found";
+    body = "Metrics are served at /metrics\n";
+  }
+
+  const std::string response = fmt::format("HTTP/1.1 {}\r\n"
+                                           "Content-Type: text/plain; version=0.0.4\r\n"
+                                           "Content-Length: {}\r\n"
+                                           "Connection: close\r\n\r\n{}",
+                                           status, body.size(), body);
+  client.send(response.data(), response.size());
+}
+
+void ServerThread(u16 port)
+{
+  Common::SetCurrentThreadName("Metrics Server");
+
+  sf::TcpListener listener;
+  if (listener.listen(port) != sf::Socket::Done)
+  {
+    ERROR_LOG_FMT(CORE, "Metrics server failed to listen on port {}", port);
+    return;
+  }
+  NOTICE_LOG_FMT(CORE, "Metrics server listening on port {}", port);
+
+  sf::SocketSelector selector;
+  selector.add(listener);
+  while (s_running.IsSet())
+  {
+    // Wake up regularly to notice when the server is stopped
+    if (!selector.wait(sf::milliseconds(100)))
+      continue;
+
+    sf::TcpSocket client;
+    if (listener.accept(client) == sf::Socket::Done)
+      HandleClient(client);
+  }
+}
+}  // namespace
+
+void Start(u16 port)
+{
+  if (!s_running.TestAndSet())
+    return;
+
+  s_after_frame_hook = AfterFrameEvent::Register(
+      [](const Core::System&) { CountFrameStatistics(); }, "MetricsServer::CountFrameStatistics");
+  s_thread = std::thread(ServerThread, port);
+}
+
+void Stop()
+{
+  if (!s_running.TestAndClear())
+    return;
+
+  s_thread.join();
+  s_after_frame_hook.reset();
+}
+
+std::string FormatMetrics()
+{
+  std::string out;
+
+  AppendMetric(&out, "dolphin_fps", "gauge", "Frames per second.", g_perf_metrics.GetFPS());
+  AppendMetric(&out, "dolphin_vps", "gauge", "VBlanks per second.", g_perf_metrics.GetVPS());
+  AppendMetric(&out, "dolphin_emulation_speed_ratio", "gauge",
+               "Emulation speed relative to the console.", g_perf_metrics.GetSpeed());
+  AppendMetric(&out, "dolphin_max_emulation_speed_ratio", "gauge",
+               "Emulation speed that could be reached without throttling.",
+               g_perf_metrics.GetMaxSpeed());
+  AppendMetric(&out, "dolphin_present_latency_seconds", "gauge",
+               "Average time from the last input poll to presenting a frame.",
+               DT_s(g_perf_metrics.GetPresentLatency()).count());
+
+  AppendMetric(&out, "dolphin_audio_latency_seconds", "gauge",
+               "Average amount of audio buffered ahead of the output.",
+               DT_s(g_perf_metrics.GetAudioLatency()).count());
+  AppendMetric(&out, "dolphin_audio_underruns_total", "counter",
+               "Times the audio output ran out of samples.",
+               g_perf_metrics.GetAudioUnderrunCount());
+
+  AppendMetric(&out, "dolphin_shader_compile_queue_depth", "gauge",
+               "Shader compiles that are queued or running.",
+               g_perf_metrics.GetShaderCompileQueueDepth());
+  AppendMetric(&out, "dolphin_shader_compile_latency_seconds", "gauge",
+               "Average time from queueing a shader compile to finishing it.",
+               DT_s(g_perf_metrics.GetShaderCompileLatency()).count());
+
+  AppendMetric(&out, "dolphin_frames_total", "counter", "Frames rendered.",
+               s_frames.load(std::memory_order_relaxed));
+  AppendMetric(&out, "dolphin_draw_calls_total", "counter", "Draw calls issued to the backend.",
+               s_draw_calls.load(std::memory_order_relaxed));
+  AppendMetric(&out, "dolphin_primitives_total", "counter", "Primitives drawn.",
+               s_primitives.load(std::memory_order_relaxed));
+  AppendMetric(&out, "dolphin_texture_cache_lookups_total", "counter",
+               "Textures looked up in the texture cache.",
+               s_texture_loads.load(std::memory_order_relaxed));
+  AppendMetric(&out, "dolphin_textures_uploaded_total", "counter",
+               "Textures that missed the texture cache and were uploaded.",
+               s_textures_uploaded.load(std::memory_order_relaxed));
+
+  const JitBaseBlockCache::Statistics jit = JitBaseBlockCache::GetStatistics();
+  AppendMetric(&out, "dolphin_jit_blocks_compiled_total", "counter", "JIT blocks compiled.",
+               jit.blocks_compiled);
+  AppendMetric(&out, "dolphin_jit_blocks_invalidated_total", "counter",
+               "JIT blocks invalidated because their code was overwritten.",
+               jit.blocks_invalidated);
+  AppendMetric(&out, "dolphin_jit_cache_clears_total", "counter",
+               "Times the JIT cache was cleared.", jit.clears);
+  AppendMetric(&out, "dolphin_jit_cache_evictions_total", "counter",
+               "Times old JIT blocks were evicted to make room for new code.", jit.evictions);
+  AppendMetric(&out, "dolphin_jit_blocks_evicted_total", "counter",
+               "JIT blocks evicted to make room for new code.", jit.blocks_evicted);
+  AppendMetric(&out, "dolphin_jit_blocks", "gauge", "JIT blocks in the cache.", jit.live_blocks);
+  AppendMetric(&out, "dolphin_jit_indirect_branch_dispatches_total", "counter",
+               "Indirect branches which missed their inline cache and went to the dispatcher.",
+               JitBase::s_indirect_branch_dispatches.load(std::memory_order_relaxed));
+  AppendMetric(&out, "dolphin_jit_code_bytes", "gauge", "Bytes of code used by cached JIT blocks.",
+               jit.live_code_bytes);
+
+  AppendDVDReadLatency(&out);
+
+  return out;
+}
+}  // namespace MetricsServer
@@ -0,0 +1,19 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+// Serves performance counters over HTTP in the Prometheus text format, so that headless instances
+// can be monitored. Only GET /metrics is answered.
+namespace MetricsServer
+{
+void Start(u16 port);
+void Stop();
+
+// Returns the current values of all metrics in the Prometheus text exposition format.
+std::string FormatMetrics();
+}  // namespace MetricsServer
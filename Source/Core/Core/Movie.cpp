@@ -84,6 +84,9 @@ namespace Movie
 using namespace WiimoteCommon;
 using namespace WiimoteEmu;
 
+// How much of the input of a movie is read at once during playback
+static constexpr u64 INPUT_WINDOW_SIZE = 1024 * 1024;
+
 static bool IsMovieHeader(const std::array<u8, 4>& magic)
 {
   return magic[0] == 'D' && magic[1] == 'T' && magic[2] == 'M' && magic[3] == 0x1A;
@@ -198,6 +201,24 @@ void MovieManager::FrameUpdate()
   m_polled = false;
 }
 
+// NOTE: CPU Thread
+void MovieManager::OnFrameEnd()
+{
+  // The first frame is included so that seeking back to anywhere in the movie is possible
+  if (IsPlayingInput() &&
+      (m_current_frame == 1 || m_current_frame % SeekIndex::FRAME_INTERVAL == 0))
+  {
+    m_seek_index.Capture(m_system, m_current_frame);
+  }
+
+  // Playback can also end before the target is reached
+  if (m_seek_target_frame && (!IsPlayingInput() || m_current_frame >= *m_seek_target_frame))
+  {
+    FinishSeek();
+    m_system.GetCPU().Break();
+  }
+}
+
 // called when game is booting up, even if no movie is active,
 // but potentially after BeginRecordingInput or PlayInput has been called.
 // NOTE: EmuThread
@@ -560,6 +581,9 @@ bool MovieManager::BeginRecordingInput(const ControllerTypeArray& controllers,
     m_play_mode = PlayMode::Recording;
     m_author = Config::Get(Config::MAIN_MOVIE_MOVIE_AUTHOR);
     m_temp_input.clear();
+    m_temp_input_offset = 0;
+    m_input_file.Close();
+    m_seek_index.Close();
 
     m_current_byte = 0;
 
@@ -959,10 +983,18 @@ bool MovieManager::PlayInput(const std::string& movie_path,
 
   Core::UpdateWantDeterminism(m_system);
 
-  m_temp_input.resize(recording_file.GetSize() - 256);
-  recording_file.ReadBytes(m_temp_input.data(), m_temp_input.size());
+  // The input is read as it's needed, so that long movies don't have to be held in memory
+  m_input_file_size = recording_file.GetSize() - sizeof(DTMHeader);
+  m_input_file = std::move(recording_file);
+  m_input_file_path = movie_path;
+  m_temp_input.clear();
+  m_temp_input_offset = 0;
   m_current_byte = 0;
-  recording_file.Close();
+
+  if (Config::Get(Config::MAIN_MOVIE_SEEK_INDEX))
+    OpenSeekIndex(movie_path);
+  else
+    m_seek_index.Close();
 
   // Load savestate (and skip to frame data)
   if (m_temp_header.bFromSaveState && savestate_path)
@@ -1050,13 +1082,16 @@ void MovieManager::LoadInput(const std::string& movie_path)
     afterEnd = true;
   }
 
-  if (!m_read_only || m_temp_input.empty())
+  if (!m_read_only || GetInputSize() == 0)
   {
     m_total_frames = m_temp_header.frameCount;
     m_total_lag_count = m_temp_header.lagCount;
     m_total_input_count = m_temp_header.inputCount;
     m_total_tick_count = m_tick_count_at_last_input = m_temp_header.tickCount;
 
+    m_input_file.Close();
+    m_seek_index.Close();
+    m_temp_input_offset = 0;
     m_temp_input.resize(static_cast<size_t>(totalSavedBytes));
     t_record.ReadBytes(m_temp_input.data(), m_temp_input.size());
   }
@@ -1065,28 +1100,38 @@ void MovieManager::LoadInput(const std::string& movie_path)
     if (m_current_byte > totalSavedBytes)
     {
     }
-    else if (m_current_byte > m_temp_input.size())
+    else if (m_current_byte > GetInputSize())
     {
       afterEnd = true;
       PanicAlertFmtT(
           "Warning: You loaded a save that's after the end of the current movie. (byte {0} "
           "> {1}) (input {2} > {3}). You should load another save before continuing, or load "
           "this state with read-only mode off.",
-          m_current_byte + 256, m_temp_input.size() + 256, m_current_input_count,
+          m_current_byte + 256, GetInputSize() + 256, m_current_input_count,
           m_total_input_count);
     }
-    else if (m_current_byte > 0 && !m_temp_input.empty())
+    else if (m_current_byte > 0 && GetInputSize() != 0)
     {
       // verify identical from movie start to the save's current frame
       std::vector<u8> movInput(m_current_byte);
       t_record.ReadArray(movInput.data(), movInput.size());
 
-      const auto result = std::mismatch(movInput.begin(), movInput.end(), m_temp_input.begin());
-
-      if (result.first != movInput.end())
+      u64 mismatch_index = movInput.size();
+      for (u64 offset = 0; offset < movInput.size(); offset += INPUT_WINDOW_SIZE)
       {
-        const ptrdiff_t mismatch_index = std::distance(movInput.begin(), result.first);
+        const size_t length = static_cast<size_t>(
+            std::min<u64>(INPUT_WINDOW_SIZE, movInput.size() - offset));
+        const auto chunk = movInput.begin() + offset;
+        const auto result = std::mismatch(chunk, chunk + length, GetInput(offset, length));
+        if (result.first != chunk + length)
+        {
+          mismatch_index = std::distance(movInput.begin(), result.first);
+          break;
+        }
+      }
 
+      if (mismatch_index != movInput.size())
+      {
         // this is a "you did something wrong" alert for the user's benefit.
         // we'll try to say what's going on in excruciating detail, otherwise the user might not
         // believe us.
@@ -1100,13 +1145,16 @@ void MovieManager::LoadInput(const std::string& movie_path)
                          "read-only mode off. Otherwise you'll probably get a desync.",
                          byte_offset, byte_offset);
 
+          // The movie's input won't match the seek index anymore
+          LoadAllInput();
+          m_seek_index.Close();
           std::copy(movInput.begin(), movInput.end(), m_temp_input.begin());
         }
         else
         {
-          const ptrdiff_t frame = mismatch_index / sizeof(ControllerState);
+          const u64 frame = mismatch_index / sizeof(ControllerState);
           ControllerState curPadState;
-          memcpy(&curPadState, &m_temp_input[frame * sizeof(ControllerState)],
+          memcpy(&curPadState, GetInput(frame * sizeof(ControllerState), sizeof(ControllerState)),
                  sizeof(ControllerState));
           ControllerState movPadState;
           memcpy(&movPadState, &movInput[frame * sizeof(ControllerState)], sizeof(ControllerState));
@@ -1174,7 +1222,7 @@ void MovieManager::LoadInput(const std::string& movie_path)
 // NOTE: CPU Thread
 void MovieManager::CheckInputEnd()
 {
-  if (m_current_byte >= m_temp_input.size() ||
+  if (m_current_byte >= GetInputSize() ||
       (m_system.GetCoreTiming().GetTicks() > m_total_tick_count &&
        !IsRecordingInputFromSaveState()))
   {
@@ -1187,18 +1235,18 @@ void MovieManager::PlayController(GCPadStatus* PadStatus, int controllerID)
 {
   // Correct playback is entirely dependent on the emulator polling the controllers
   // in the same order done during recording
-  if (!IsPlayingInput() || !IsUsingPad(controllerID) || m_temp_input.empty())
+  if (!IsPlayingInput() || !IsUsingPad(controllerID) || GetInputSize() == 0)
     return;
 
-  if (m_current_byte + sizeof(ControllerState) > m_temp_input.size())
+  if (m_current_byte + sizeof(ControllerState) > GetInputSize())
   {
     PanicAlertFmtT("Premature movie end in PlayController. {0} + {1} > {2}", m_current_byte,
-                   sizeof(ControllerState), m_temp_input.size());
+                   sizeof(ControllerState), GetInputSize());
     EndPlayInput(!m_read_only);
     return;
   }
 
-  memcpy(&m_pad_state, &m_temp_input[m_current_byte], sizeof(ControllerState));
+  memcpy(&m_pad_state, GetInput(m_current_byte, sizeof(ControllerState)), sizeof(ControllerState));
   m_current_byte += sizeof(ControllerState);
 
   PadStatus->isConnected = m_pad_state.is_connected;
@@ -1278,19 +1326,19 @@ void MovieManager::PlayController(GCPadStatus* PadStatus, int controllerID)
 bool MovieManager::PlayWiimote(int wiimote, WiimoteCommon::DataReportBuilder& rpt,
                                ExtensionNumber ext, const EncryptionKey& key)
 {
-  if (!IsPlayingInput() || !IsUsingWiimote(wiimote) || m_temp_input.empty())
+  if (!IsPlayingInput() || !IsUsingWiimote(wiimote) || GetInputSize() == 0)
     return false;
 
-  if (m_current_byte > m_temp_input.size())
+  if (m_current_byte >= GetInputSize())
   {
     PanicAlertFmtT("Premature movie end in PlayWiimote. {0} > {1}", m_current_byte,
-                   m_temp_input.size());
+                   GetInputSize());
     EndPlayInput(!m_read_only);
     return false;
   }
 
   const u8 size = rpt.GetDataSize();
-  const u8 sizeInMovie = m_temp_input[m_current_byte];
+  const u8 sizeInMovie = *GetInput(m_current_byte, 1);
 
   if (size != sizeInMovie)
   {
@@ -1307,15 +1355,15 @@ bool MovieManager::PlayWiimote(int wiimote, WiimoteCommon::DataReportBuilder& rp
 
   m_current_byte++;
 
-  if (m_current_byte + size > m_temp_input.size())
+  if (m_current_byte + size > GetInputSize())
   {
     PanicAlertFmtT("Premature movie end in PlayWiimote. {0} + {1} > {2}", m_current_byte, size,
-                   m_temp_input.size());
+                   GetInputSize());
     EndPlayInput(!m_read_only);
     return false;
   }
 
-  memcpy(rpt.GetDataPtr(), &m_temp_input[m_current_byte], size);
+  memcpy(rpt.GetDataPtr(), GetInput(m_current_byte, size), size);
   m_current_byte += size;
 
   m_current_input_count++;
@@ -1332,6 +1380,10 @@ void MovieManager::EndPlayInput(bool cont)
     // If !IsMovieActive(), changing m_play_mode requires calling UpdateWantDeterminism
     ASSERT(IsMovieActive());
 
+    // Recording appends to the input, which needs all of it to be in memory
+    LoadAllInput();
+    m_seek_index.Close();
+
     m_play_mode = PlayMode::Recording;
     Core::DisplayMessage("Reached movie end. Resuming recording.", 2000);
   }
@@ -1361,6 +1413,10 @@ void MovieManager::EndPlayInput(bool cont)
 // NOTE: Save State + Host Thread
 void MovieManager::SaveRecording(const std::string& filename)
 {
+  // Overwriting the movie which is being played back would lose the input that hasn't been read
+  if (m_input_file.IsOpen() && filename == m_input_file_path)
+    LoadAllInput();
+
   File::IOFile save_record(filename, "wb");
   // Create the real header now and write it
   DTMHeader header;
@@ -1411,7 +1467,12 @@ void MovieManager::SaveRecording(const std::string& filename)
 
   save_record.WriteArray(&header, 1);
 
-  bool success = save_record.WriteBytes(m_temp_input.data(), m_temp_input.size());
+  bool success = true;
+  for (u64 offset = 0; success && offset < GetInputSize(); offset += INPUT_WINDOW_SIZE)
+  {
+    const size_t length = static_cast<size_t>(std::min(INPUT_WINDOW_SIZE, GetInputSize() - offset));
+    success = save_record.WriteBytes(GetInput(offset, length), length);
+  }
 
   if (success && m_recording_from_save_state)
   {
@@ -1552,5 +1613,110 @@ void MovieManager::Shutdown()
 {
   m_current_input_count = m_total_input_count = m_total_frames = m_tick_count_at_last_input = 0;
   m_temp_input.clear();
+  m_temp_input_offset = 0;
+  m_input_file.Close();
+  m_seek_index.Close();
+  if (m_seek_target_frame)
+    FinishSeek();
+}
+
+u64 MovieManager::GetInputSize() const
+{
+  return m_input_file.IsOpen() ? m_input_file_size : m_temp_input.size();
+}
+
+// Returns size bytes of the input starting at offset, which must be within GetInputSize(). The
+// pointer is only valid until the next call.
+const u8* MovieManager::GetInput(u64 offset, size_t size)
+{
+  if (m_input_file.IsOpen() &&
+      (offset < m_temp_input_offset || offset + size > m_temp_input_offset + m_temp_input.size()))
+  {
+    const u64 length = std::min(std::max<u64>(INPUT_WINDOW_SIZE, size), m_input_file_size - offset);
+    m_temp_input.resize(static_cast<size_t>(length));
+    m_temp_input_offset = offset;
+    if (!m_input_file.Seek(sizeof(DTMHeader) + offset, File::SeekOrigin::Begin) ||
+        !m_input_file.ReadBytes(m_temp_input.data(), m_temp_input.size()))
+    {
+      PanicAlertFmtT("Failed to read the input of the movie at byte {0}",
+                     sizeof(DTMHeader) + offset);
+      std::fill(m_temp_input.begin(), m_temp_input.end(), 0);
+    }
+  }
+
+  return m_temp_input.data() + (offset - m_temp_input_offset);
+}
+
+void MovieManager::LoadAllInput()
+{
+  if (!m_input_file.IsOpen())
+    return;
+
+  m_temp_input.resize(static_cast<size_t>(m_input_file_size));
+  m_temp_input_offset = 0;
+  if (!m_input_file.Seek(sizeof(DTMHeader), File::SeekOrigin::Begin) ||
+      !m_input_file.ReadBytes(m_temp_input.data(), m_temp_input.size()))
+  {
+    PanicAlertFmtT("Failed to read the input of the movie {0}", m_input_file_path);
+  }
+  m_input_file.Close();
+}
+
+void MovieManager::OpenSeekIndex(const std::string& movie_path)
+{
+  // The index is only valid for this exact movie. Its header includes the rerecord count, which
+  // changes whenever the input does.
+  std::vector<u8> movie_key(sizeof(DTMHeader) + sizeof(m_input_file_size));
+  std::memcpy(movie_key.data(), &m_temp_header, sizeof(DTMHeader));
+  std::memcpy(movie_key.data() + sizeof(DTMHeader), &m_input_file_size, sizeof(m_input_file_size));
+  m_seek_index.Open(movie_path, movie_key);
+}
+
+bool MovieManager::SeekToFrame(u64 frame)
+{
+  if (!IsPlayingInput())
+    return false;
+
+  bool success = false;
+  Core::RunOnCPUThread(
+      m_system,
+      [&] {
+        if (!IsPlayingInput())
+          return;
+
+        const u64 target_frame = std::min(frame, m_total_frames);
+        const std::optional<u64> seek_point = m_seek_index.FindSeekPoint(target_frame);
+
+        // Fast-forwarding from the current frame is quicker if it's after the nearest state
+        if (seek_point && (target_frame < m_current_frame || *seek_point > m_current_frame))
+        {
+          if (!m_seek_index.Load(m_system, *seek_point))
+            return;
+        }
+        else if (target_frame < m_current_frame)
+        {
+          return;
+        }
+
+        if (!m_seek_target_frame)
+        {
+          m_speed_before_seek = Config::Get(Config::MAIN_EMULATION_SPEED);
+          Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+        }
+        m_seek_target_frame = target_frame;
+        success = true;
+      },
+      true);
+
+  if (success && Core::GetState(m_system) == Core::State::Paused)
+    Core::SetState(m_system, Core::State::Running);
+
+  return success;
+}
+
+void MovieManager::FinishSeek()
+{
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, m_speed_before_seek);
+  m_seek_target_frame.reset();
 }
 }  // namespace Movie
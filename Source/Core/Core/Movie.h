@@ -12,6 +12,8 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Core/MovieSeekIndex.h"
 
 struct BootParameters;
 
@@ -162,6 +164,7 @@ public:
   ~MovieManager();
 
   void FrameUpdate();
+  void OnFrameEnd();
   void InputUpdate();
   void Init(const BootParameters& boot);
 
@@ -214,6 +217,10 @@ public:
   bool PlayWiimote(int wiimote, WiimoteCommon::DataReportBuilder& rpt,
                    WiimoteEmu::ExtensionNumber ext, const WiimoteEmu::EncryptionKey& key);
   void EndPlayInput(bool cont);
+  // NOTE: Host Thread. Continues playback from the given frame, by loading the nearest state of
+  // the seek index before it and fast-forwarding from there, and pauses once it's reached. Going
+  // back requires a state from the seek index.
+  bool SeekToFrame(u64 frame);
   void SaveRecording(const std::string& filename);
   void DoState(PointerWrap& p);
   void Shutdown();
@@ -229,6 +236,12 @@ private:
   void GetSettings();
   void CheckInputEnd();
 
+  u64 GetInputSize() const;
+  const u8* GetInput(u64 offset, size_t size);
+  void LoadAllInput();
+  void OpenSeekIndex(const std::string& movie_path);
+  void FinishSeek();
+
   void CheckMD5();
   void GetMD5();
 
@@ -240,7 +253,14 @@ private:
   std::array<bool, 4> m_wiimotes{};
   ControllerState m_pad_state{};
   DTMHeader m_temp_header{};
+  // While a movie plays back, its input is read from m_input_file as needed and m_temp_input only
+  // holds the part of it starting at m_temp_input_offset. Since the input can't be modified then,
+  // it's all read into m_temp_input before recording continues, and m_input_file is closed.
   std::vector<u8> m_temp_input;
+  u64 m_temp_input_offset = 0;
+  File::IOFile m_input_file;
+  std::string m_input_file_path;
+  u64 m_input_file_size = 0;
   u64 m_current_byte = 0;
   u64 m_current_frame = 0;
   u64 m_total_frames = 0;  // VI
@@ -270,6 +290,11 @@ private:
 
   std::string m_current_file_name;
 
+  SeekIndex m_seek_index;
+  // Only accessed on the CPU thread
+  std::optional<u64> m_seek_target_frame;
+  float m_speed_before_seek = 1.0f;
+
   // m_input_display is used by both CPU and GPU (is mutable).
   std::mutex m_input_display_lock;
   std::array<std::string, 8> m_input_display;
@@ -0,0 +1,224 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/MovieSeekIndex.h"
+
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include <zstd.h>
+
+#include "Common/Logging/Log.h"
+#include "Common/Version.h"
+#include "Core/State.h"
+
+namespace Movie
+{
+// The file starts with the magic, the version, and the movie key and Dolphin revision with their
+// sizes. Each state follows as a SeekPointHeader and its compressed data, in the order in which
+// they were captured.
+static constexpr u32 SEEK_INDEX_MAGIC = 0x534D5444;  // "DTMS"
+static constexpr u32 SEEK_INDEX_VERSION = 1;
+
+// States are captured while the movie plays, so compression speed matters more than size here
+static constexpr int SEEK_INDEX_COMPRESSION_LEVEL = 1;
+
+struct SeekPointHeader
+{
+  u64 frame;
+  u32 compressed_size;
+  u32 size;
+};
+static_assert(std::is_trivially_copyable_v<SeekPointHeader>);
+
+template <typename T>
+static void Append(std::vector<u8>* buffer, const T& value)
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+  const size_t offset = buffer->size();
+  buffer->resize(offset + sizeof(T));
+  std::memcpy(buffer->data() + offset, &value, sizeof(T));
+}
+
+static std::vector<u8> MakeFileHeader(std::span<const u8> movie_key)
+{
+  const std::string& revision = Common::GetScmRevGitStr();
+
+  std::vector<u8> header;
+  Append(&header, SEEK_INDEX_MAGIC);
+  Append(&header, SEEK_INDEX_VERSION);
+  Append(&header, static_cast<u32>(movie_key.size()));
+  header.insert(header.end(), movie_key.begin(), movie_key.end());
+  Append(&header, static_cast<u32>(revision.size()));
+  header.insert(header.end(), revision.begin(), revision.end());
+  return header;
+}
+
+SeekIndex::~SeekIndex()
+{
+  Close();
+}
+
+void SeekIndex::Open(const std::string& movie_path, std::span<const u8> movie_key)
+{
+  Close();
+
+  const std::string path = movie_path + ".seek";
+  const std::vector<u8> header = MakeFileHeader(movie_key);
+
+  {
+    std::lock_guard lk(m_mutex);
+
+    if (m_file.Open(path, "r+b"))
+    {
+      std::vector<u8> existing_header(header.size());
+      if (m_file.ReadBytes(existing_header.data(), existing_header.size()) &&
+          existing_header == header)
+      {
+        ReadSeekPoints(header.size());
+      }
+      else
+      {
+        INFO_LOG_FMT(CORE, "Discarding the seek index {}, which doesn't match the movie", path);
+        m_file.Close();
+      }
+    }
+
+    if (!m_file.IsOpen())
+    {
+      if (!m_file.Open(path, "w+b") || !m_file.WriteBytes(header.data(), header.size()))
+      {
+        WARN_LOG_FMT(CORE, "Failed to create the seek index {}", path);
+        m_file.Close();
+        return;
+      }
+      m_file_end = header.size();
+    }
+  }
+
+  m_write_thread.Reset("Movie Seek Index",
+                       [this](CapturedState state) { WriteSeekPoint(std::move(state)); });
+}
+
+void SeekIndex::Close()
+{
+  m_write_thread.Shutdown();
+
+  std::lock_guard lk(m_mutex);
+  m_file.Close();
+  m_file_end = 0;
+  m_seek_points.clear();
+  m_pending_frames.clear();
+}
+
+void SeekIndex::ReadSeekPoints(u64 offset)
+{
+  // A state left incomplete by a crash ends the index, and is overwritten by the next one
+  const u64 file_size = m_file.GetSize();
+  while (offset + sizeof(SeekPointHeader) <= file_size)
+  {
+    SeekPointHeader header;
+    if (!m_file.Seek(offset, File::SeekOrigin::Begin) || !m_file.ReadArray(&header, 1))
+      break;
+
+    const u64 data_offset = offset + sizeof(SeekPointHeader);
+    if (data_offset + header.compressed_size > file_size)
+      break;
+
+    m_seek_points.insert_or_assign(header.frame,
+                                   SeekPoint{data_offset, header.compressed_size, header.size});
+    offset = data_offset + header.compressed_size;
+  }
+
+  m_file_end = offset;
+}
+
+void SeekIndex::Capture(Core::System& system, u64 frame)
+{
+  {
+    std::lock_guard lk(m_mutex);
+    if (!m_file.IsOpen() || m_seek_points.contains(frame) || m_pending_frames.contains(frame))
+      return;
+    m_pending_frames.insert(frame);
+  }
+
+  CapturedState state{frame, {}};
+  State::SaveToBuffer(system, state.data);
+  m_write_thread.Push(std::move(state));
+}
+
+void SeekIndex::WriteSeekPoint(CapturedState state)
+{
+  std::vector<u8> compressed(ZSTD_compressBound(state.data.size()));
+  const size_t compressed_size = ZSTD_compress(compressed.data(), compressed.size(),
+                                               state.data.data(), state.data.size(),
+                                               SEEK_INDEX_COMPRESSION_LEVEL);
+
+  std::lock_guard lk(m_mutex);
+  m_pending_frames.erase(state.frame);
+
+  if (ZSTD_isError(compressed_size))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to compress the seek index state at frame {}", state.frame);
+    return;
+  }
+
+  const SeekPointHeader header{state.frame, static_cast<u32>(compressed_size),
+                               static_cast<u32>(state.data.size())};
+  if (!m_file.Seek(m_file_end, File::SeekOrigin::Begin) || !m_file.WriteArray(&header, 1) ||
+      !m_file.WriteBytes(compressed.data(), compressed_size))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to write the seek index state at frame {}", state.frame);
+    return;
+  }
+
+  const u64 data_offset = m_file_end + sizeof(SeekPointHeader);
+  m_seek_points.insert_or_assign(header.frame,
+                                 SeekPoint{data_offset, header.compressed_size, header.size});
+  m_file_end = data_offset + compressed_size;
+}
+
+std::optional<u64> SeekIndex::FindSeekPoint(u64 frame) const
+{
+  std::lock_guard lk(m_mutex);
+
+  auto it = m_seek_points.upper_bound(frame);
+  if (it == m_seek_points.begin())
+    return std::nullopt;
+  return std::prev(it)->first;
+}
+
+bool SeekIndex::Load(Core::System& system, u64 frame)
+{
+  std::vector<u8> buffer;
+  {
+    std::lock_guard lk(m_mutex);
+
+    const auto it = m_seek_points.find(frame);
+    if (it == m_seek_points.end())
+      return false;
+
+    const SeekPoint& seek_point = it->second;
+    std::vector<u8> compressed(seek_point.compressed_size);
+    if (!m_file.Seek(seek_point.offset, File::SeekOrigin::Begin) ||
+        !m_file.ReadBytes(compressed.data(), compressed.size()))
+    {
+      ERROR_LOG_FMT(CORE, "Failed to read the seek index state at frame {}", frame);
+      return false;
+    }
+
+    buffer.resize(seek_point.size);
+    if (ZSTD_decompress(buffer.data(), buffer.size(), compressed.data(), compressed.size()) !=
+        buffer.size())
+    {
+      ERROR_LOG_FMT(CORE, "Failed to decompress the seek index state at frame {}", frame);
+      return false;
+    }
+  }
+
+  State::LoadFromBuffer(system, buffer);
+  return true;
+}
+}  // namespace Movie
@@ -0,0 +1,83 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Savestates taken at regular intervals while a movie plays back, which let later playbacks of
+// the same movie jump to any frame by loading the nearest state before it and fast-forwarding
+// from there. They are stored in a file next to the movie rather than in the DTM itself, so that
+// the movie format stays readable by other tools.
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/WorkQueueThread.h"
+
+namespace Core
+{
+class System;
+}
+
+namespace Movie
+{
+class SeekIndex
+{
+public:
+  // One state per minute of emulated time, which keeps the file size reasonable and a seek at
+  // unlimited speed short
+  static constexpr u64 FRAME_INTERVAL = 3600;
+
+  SeekIndex() = default;
+  SeekIndex(const SeekIndex&) = delete;
+  SeekIndex& operator=(const SeekIndex&) = delete;
+  ~SeekIndex();
+
+  // Opens the index of the movie at movie_path and continues adding to it. An existing index is
+  // discarded if it was made for a movie with a different movie_key or by a different version of
+  // Dolphin, since its states couldn't be used then.
+  void Open(const std::string& movie_path, std::span<const u8> movie_key);
+  void Close();
+
+  // NOTE: CPU Thread. Captures a state at the given frame unless there already is one.
+  void Capture(Core::System& system, u64 frame);
+
+  // The frame of the latest state at or before the given frame
+  std::optional<u64> FindSeekPoint(u64 frame) const;
+
+  // NOTE: CPU Thread. Loads the state captured at the given frame.
+  bool Load(Core::System& system, u64 frame);
+
+private:
+  struct CapturedState
+  {
+    u64 frame;
+    std::vector<u8> data;
+  };
+
+  struct SeekPoint
+  {
+    u64 offset;
+    u32 compressed_size;
+    u32 size;
+  };
+
+  void ReadSeekPoints(u64 offset);
+  void WriteSeekPoint(CapturedState state);
+
+  Common::WorkQueueThread<CapturedState> m_write_thread;
+
+  mutable std::mutex m_mutex;
+  File::IOFile m_file;
+  u64 m_file_end = 0;
+  std::map<u64, SeekPoint> m_seek_points;
+  // Captured, but not written yet
+  std::set<u64> m_pending_frames;
+};
+}  // namespace Movie
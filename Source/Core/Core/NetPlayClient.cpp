@@ -40,6 +40,7 @@
 #include "Core/Config/SessionSettings.h"
 #include "Core/Config/WiimoteSettings.h"
 #include "Core/ConfigManager.h"
+#include "Core/Core.h"
 #include "Core/GeckoCode.h"
 #include "Core/HW/EXI/EXI.h"
 #include "Core/HW/EXI/EXI_DeviceIPL.h"
@@ -65,6 +66,7 @@
 #include "Core/Movie.h"
 #include "Core/NetPlayCommon.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/State.h"
 #include "Core/SyncIdentifier.h"
 #include "Core/System.h"
 #include "DiscIO/Blob.h"
@@ -80,6 +82,9 @@ namespace NetPlay
 {
 using namespace WiimoteCommon;
 
+// How long to wait for the inputs asked for before asking for them again
+static constexpr std::chrono::milliseconds INPUT_RESEND_REQUEST_INTERVAL{200};
+
 static std::mutex crit_netplay_client;
 static NetPlayClient* netplay_client = nullptr;
 static bool s_si_poll_batching = false;
@@ -391,14 +396,26 @@ void NetPlayClient::OnData(sf::Packet& packet)
     OnPadData(packet);
     break;
 
+  case MessageID::PadDataPacked:
+    OnPadDataPacked(packet);
+    break;
+
   case MessageID::PadHostData:
     OnPadHostData(packet);
     break;
 
+  case MessageID::PadDataResendRequest:
+    OnPadDataResendRequest(packet);
+    break;
+
   case MessageID::WiimoteData:
     OnWiimoteData(packet);
     break;
 
+  case MessageID::WiimoteDataResendRequest:
+    OnWiimoteDataResendRequest(packet);
+    break;
+
   case MessageID::PadBuffer:
     OnPadBuffer(packet);
     break;
@@ -448,6 +465,14 @@ void NetPlayClient::OnData(sf::Packet& packet)
     OnDesyncDetected(packet);
     break;
 
+  case MessageID::DesyncRecoveryRequest:
+    OnDesyncRecoveryRequest();
+    break;
+
+  case MessageID::DesyncRecoveryState:
+    OnDesyncRecoveryState(packet);
+    break;
+
   case MessageID::SyncSaveData:
     OnSyncSaveData(packet);
     break;
@@ -674,6 +699,55 @@ void NetPlayClient::OnGBAConfig(sf::Packet& packet)
   m_dialog->Update();
 }
 
+// Splits the inputs into runs which aren't too long to be read back
+template <typename T>
+static void WriteInputRuns(sf::Packet& packet, PadIndex map, u32 first_sequence,
+                           std::span<const T> inputs,
+                           void (*write_run)(sf::Packet&, PadIndex, u32, std::span<const T>))
+{
+  for (size_t i = 0; i < inputs.size(); i += MAX_INPUTS_PER_RUN)
+  {
+    const size_t count = std::min<size_t>(MAX_INPUTS_PER_RUN, inputs.size() - i);
+    write_run(packet, map, first_sequence + static_cast<u32>(i), inputs.subspan(i, count));
+  }
+}
+
+// Pushes the inputs of a run which haven't been received before. Returns false if the inputs
+// right before the run are missing, in which case none of them can be used yet.
+template <typename T>
+static bool ReceiveInputRun(const std::vector<T>& inputs, u32 first_sequence, u32* next_sequence,
+                            Common::SPSCSegmentedQueue<T>* buffer)
+{
+  if (first_sequence > *next_sequence)
+    return false;
+
+  const size_t first_new = *next_sequence - first_sequence;
+  if (first_new < inputs.size())
+  {
+    buffer->PushBatch(inputs.begin() + first_new, inputs.end());
+    *next_sequence += static_cast<u32>(inputs.size() - first_new);
+  }
+  return true;
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayClient::RequestInputResend(MessageID request, PadIndex map, ReceivedInputs& received)
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (now - received.last_resend_request < INPUT_RESEND_REQUEST_INTERVAL)
+    return;
+  received.last_resend_request = now;
+
+  INFO_LOG_FMT(NETPLAY, "Inputs of pad {} were lost, requesting them from input {}", map,
+               received.next_sequence);
+
+  sf::Packet packet;
+  packet << request;
+  packet << map;
+  packet << received.next_sequence;
+  Send(packet);
+}
+
 void NetPlayClient::OnPadData(sf::Packet& packet)
 {
   while (!packet.endOfPacket())
@@ -696,6 +770,53 @@ void NetPlayClient::OnPadData(sf::Packet& packet)
   }
 }
 
+void NetPlayClient::OnPadDataPacked(sf::Packet& packet)
+{
+  std::vector<GCPadStatus> inputs;
+  while (!packet.endOfPacket())
+  {
+    PadIndex map;
+    u32 first_sequence;
+    if (!ReadPadInputRun(packet, &map, &first_sequence, &inputs))
+    {
+      ERROR_LOG_FMT(NETPLAY, "Received malformed pad data");
+      return;
+    }
+
+    ReceivedInputs& received = m_received_pad_inputs[map];
+    if (ReceiveInputRun(inputs, first_sequence, &received.next_sequence, &m_pad_buffer[map]))
+      m_gc_pad_event.Set();
+    else
+      RequestInputResend(MessageID::PadDataResendRequest, map, received);
+  }
+}
+
+void NetPlayClient::OnPadDataResendRequest(sf::Packet& packet)
+{
+  PadIndex map;
+  u32 first_sequence;
+  packet >> map;
+  packet >> first_sequence;
+  if (map < 0 || map >= 4)
+    return;
+
+  sf::Packet response;
+  response << MessageID::PadDataPacked;
+  {
+    std::lock_guard lk(m_sent_inputs_mutex);
+    const auto inputs = m_sent_pad_inputs[map].GetFrom(first_sequence);
+    if (!inputs)
+    {
+      ERROR_LOG_FMT(NETPLAY, "Inputs of pad {} from input {} can't be sent again", map,
+                    first_sequence);
+      return;
+    }
+    WriteInputRuns(response, map, first_sequence, *inputs, WritePadInputRun);
+  }
+
+  Send(response);
+}
+
 void NetPlayClient::OnPadHostData(sf::Packet& packet)
 {
   while (!packet.endOfPacket())
@@ -725,29 +846,49 @@ void NetPlayClient::OnPadHostData(sf::Packet& packet)
 
 void NetPlayClient::OnWiimoteData(sf::Packet& packet)
 {
+  std::vector<WiimoteEmu::SerializedWiimoteState> inputs;
   while (!packet.endOfPacket())
   {
     PadIndex map;
-    packet >> map;
-
-    WiimoteEmu::SerializedWiimoteState pad;
-    packet >> pad.length;
-    ASSERT(pad.length <= pad.data.size());
-    if (pad.length <= pad.data.size())
+    u32 first_sequence;
+    if (!ReadWiimoteInputRun(packet, &map, &first_sequence, &inputs))
     {
-      for (size_t i = 0; i < pad.length; ++i)
-        packet >> pad.data[i];
+      ERROR_LOG_FMT(NETPLAY, "Received malformed Wii Remote data");
+      return;
     }
+
+    ReceivedInputs& received = m_received_wiimote_inputs[map];
+    if (ReceiveInputRun(inputs, first_sequence, &received.next_sequence, &m_wiimote_buffer[map]))
+      m_wii_pad_event.Set();
     else
+      RequestInputResend(MessageID::WiimoteDataResendRequest, map, received);
+  }
+}
+
+void NetPlayClient::OnWiimoteDataResendRequest(sf::Packet& packet)
+{
+  PadIndex map;
+  u32 first_sequence;
+  packet >> map;
+  packet >> first_sequence;
+  if (map < 0 || map >= 4)
+    return;
+
+  sf::Packet response;
+  response << MessageID::WiimoteData;
+  {
+    std::lock_guard lk(m_sent_inputs_mutex);
+    const auto inputs = m_sent_wiimote_inputs[map].GetFrom(first_sequence);
+    if (!inputs)
     {
-      pad.length = 0;
+      ERROR_LOG_FMT(NETPLAY, "Inputs of Wii Remote {} from input {} can't be sent again", map,
+                    first_sequence);
+      return;
     }
-
-    // Trusting server for good map value (>=0 && <4)
-    // add to pad buffer
-    m_wiimote_buffer.at(map).Push(pad);
-    m_wii_pad_event.Set();
+    WriteInputRuns(response, map, first_sequence, *inputs, WriteWiimoteInputRun);
   }
+
+  Send(response);
 }
 
 void NetPlayClient::OnPadBuffer(sf::Packet& packet)
@@ -763,6 +904,10 @@ void NetPlayClient::OnHostInputAuthority(sf::Packet& packet)
 {
   packet >> m_host_input_authority;
   m_dialog->OnHostInputAuthorityChanged(m_host_input_authority);
+
+  // Rollback finishes the predictions already made and then switches to the normal input path
+  if (m_host_input_authority && m_is_running.IsSet() && m_rollback)
+    m_rollback_stop_requested = true;
 }
 
 void NetPlayClient::OnGolfSwitch(sf::Packet& packet)
@@ -869,6 +1014,7 @@ void NetPlayClient::OnStartGame(sf::Packet& packet)
 
     packet >> m_net_settings.efb_access_enable;
     packet >> m_net_settings.bbox_enable;
+    packet >> m_net_settings.bbox_late_readback;
     packet >> m_net_settings.force_progressive;
     packet >> m_net_settings.efb_to_texture_enable;
     packet >> m_net_settings.xfb_to_texture_enable;
@@ -910,6 +1056,7 @@ void NetPlayClient::OnStartGame(sf::Packet& packet)
     packet >> m_net_settings.defer_efb_copies;
     packet >> m_net_settings.efb_access_tile_size;
     packet >> m_net_settings.efb_access_defer_invalidation;
+    packet >> m_net_settings.efb_access_allow_stale;
     packet >> m_net_settings.savedata_load;
     packet >> m_net_settings.savedata_write;
     packet >> m_net_settings.savedata_sync_all_wii;
@@ -999,6 +1146,58 @@ void NetPlayClient::OnDesyncDetected(sf::Packet& packet)
   m_dialog->OnDesync(frame, player);
 }
 
+void NetPlayClient::OnDesyncRecoveryRequest()
+{
+  // Saved at the end of the next field, see SendDesyncRecoveryState
+  if (m_local_player->IsHost())
+    m_desync_recovery_state_requested = true;
+}
+
+void NetPlayClient::OnDesyncRecoveryState(sf::Packet& packet)
+{
+  DesyncRecoveryState recovery;
+  packet >> recovery.timebase_frame;
+  for (u64& polls : recovery.pad_polls)
+    polls = Common::PacketReadU64(packet);
+
+  std::optional<std::vector<u8>> state = DecompressPacketIntoBuffer(packet);
+  if (!state)
+  {
+    ERROR_LOG_FMT(NETPLAY, "Received a broken state to recover from the desync");
+    return;
+  }
+  recovery.state = std::move(*state);
+
+  {
+    std::lock_guard lk(m_desync_recovery_mutex);
+    m_desync_recovery_state = std::move(recovery);
+  }
+
+  m_dialog->AppendChat(Common::GetStringT("Recovering from the desync..."));
+
+  // As with rollback, the state has to be loaded outside of the CPU loop
+  Core::QueueHostJob([](Core::System& system) {
+    Core::RunOnCPUThread(
+        system,
+        [&system] {
+          std::lock_guard lk(crit_netplay_client);
+          if (netplay_client)
+            netplay_client->RecoverFromDesync(system);
+        },
+        true);
+  });
+}
+
+static std::string GetSaveDataCacheDirectory()
+{
+  return File::GetUserPath(D_CACHE_IDX) + "NetPlaySaves" DIR_SEP;
+}
+
+static std::string GetSaveDataCacheFileName(const Common::SHA1::Digest& digest)
+{
+  return fmt::format("{:02x}.bin", fmt::join(digest, ""));
+}
+
 void NetPlayClient::OnSyncSaveData(sf::Packet& packet)
 {
   SyncSaveDataID sub_id;
@@ -1007,6 +1206,23 @@ void NetPlayClient::OnSyncSaveData(sf::Packet& packet)
   if (m_local_player->IsHost())
     return;
 
+  if (!m_save_data_requested.empty())
+  {
+    const Common::SHA1::Digest digest = Common::SHA1::CalculateDigest(
+        static_cast<const u8*>(packet.getData()), packet.getDataSize());
+    if (m_save_data_requested.erase(digest))
+    {
+      const std::string path = GetSaveDataCacheDirectory() + GetSaveDataCacheFileName(digest);
+      File::CreateFullPath(path);
+      if (!File::WriteStringToFile(
+              path, std::string_view(static_cast<const char*>(packet.getData()),
+                                     packet.getDataSize())))
+      {
+        WARN_LOG_FMT(NETPLAY, "Failed to cache the received save data in {}", path);
+      }
+    }
+  }
+
   INFO_LOG_FMT(NETPLAY, "Processing OnSyncSaveData sub id: {}", static_cast<u8>(sub_id));
 
   switch (sub_id)
@@ -1015,6 +1231,10 @@ void NetPlayClient::OnSyncSaveData(sf::Packet& packet)
     OnSyncSaveDataNotify(packet);
     break;
 
+  case SyncSaveDataID::Offer:
+    OnSyncSaveDataOffer(packet);
+    break;
+
   case SyncSaveDataID::RawData:
     OnSyncSaveDataRaw(packet);
     break;
@@ -1041,6 +1261,8 @@ void NetPlayClient::OnSyncSaveDataNotify(sf::Packet& packet)
 {
   packet >> m_sync_save_data_count;
   m_sync_save_data_success_count = 0;
+  m_save_data_offered.clear();
+  m_save_data_requested.clear();
 
   INFO_LOG_FMT(NETPLAY, "Initializing wait for {} savegame chunks.", m_sync_save_data_count);
 
@@ -1050,6 +1272,37 @@ void NetPlayClient::OnSyncSaveDataNotify(sf::Packet& packet)
     m_dialog->AppendChat(Common::GetStringT("Synchronizing save data..."));
 }
 
+void NetPlayClient::OnSyncSaveDataOffer(sf::Packet& packet)
+{
+  Common::SHA1::Digest digest;
+  for (u8& byte : digest)
+    packet >> byte;
+  m_save_data_offered.insert(digest);
+
+  // Identical save data from an earlier session doesn't have to be transferred again
+  std::string data;
+  const std::string file_name = GetSaveDataCacheFileName(digest);
+  if (File::ReadFileToString(GetSaveDataCacheDirectory() + file_name, data) &&
+      Common::SHA1::CalculateDigest(data) == digest)
+  {
+    INFO_LOG_FMT(NETPLAY, "Using cached save data {}.", file_name);
+    sf::Packet cached_packet;
+    cached_packet.append(data.data(), data.size());
+    OnData(cached_packet);
+    return;
+  }
+
+  INFO_LOG_FMT(NETPLAY, "Requesting save data {}.", file_name);
+  m_save_data_requested.insert(digest);
+
+  sf::Packet request_packet;
+  request_packet << MessageID::SyncSaveData;
+  request_packet << SyncSaveDataID::Request;
+  for (u8 byte : digest)
+    request_packet << byte;
+  Send(request_packet);
+}
+
 void NetPlayClient::OnSyncSaveDataRaw(sf::Packet& packet)
 {
   bool is_slot_a;
@@ -1522,7 +1775,7 @@ void NetPlayClient::OnGameDigestAbort()
 
 void NetPlayClient::Send(const sf::Packet& packet, const u8 channel_id)
 {
-  Common::ENet::SendPacket(m_server, packet, channel_id);
+  Common::ENet::SendPacket(m_server, packet, channel_id, channel_id != INPUT_CHANNEL);
 }
 
 void NetPlayClient::DisplayPlayersPing()
@@ -1709,14 +1962,55 @@ void NetPlayClient::AddPadStateToPacket(const int in_game_pad, const GCPadStatus
 }
 
 // called from ---CPU--- thread
-void NetPlayClient::AddWiimoteStateToPacket(int in_game_pad,
-                                            const WiimoteEmu::SerializedWiimoteState& state,
-                                            sf::Packet& packet)
+void NetPlayClient::SendPackedPadData()
 {
-  packet << static_cast<PadIndex>(in_game_pad);
-  packet << state.length;
-  for (size_t i = 0; i < state.length; ++i)
-    packet << state.data[i];
+  sf::Packet packet;
+  packet << MessageID::PadDataPacked;
+
+  bool data_added = false;
+  {
+    std::lock_guard lk(m_sent_inputs_mutex);
+    for (size_t i = 0; i < m_sent_pad_inputs.size(); ++i)
+    {
+      if (!m_sent_pad_inputs[i].HasUnsent())
+        continue;
+
+      u32 first_sequence;
+      const auto inputs = m_sent_pad_inputs[i].TakeUnsent(&first_sequence);
+      WriteInputRuns(packet, static_cast<PadIndex>(i), first_sequence, inputs, WritePadInputRun);
+      data_added = true;
+    }
+  }
+
+  // Every message repeats the inputs sent last, so losing one is usually harmless
+  if (data_added)
+    SendAsync(std::move(packet), INPUT_CHANNEL);
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::SendPackedWiimoteData()
+{
+  sf::Packet packet;
+  packet << MessageID::WiimoteData;
+
+  bool data_added = false;
+  {
+    std::lock_guard lk(m_sent_inputs_mutex);
+    for (size_t i = 0; i < m_sent_wiimote_inputs.size(); ++i)
+    {
+      if (!m_sent_wiimote_inputs[i].HasUnsent())
+        continue;
+
+      u32 first_sequence;
+      const auto inputs = m_sent_wiimote_inputs[i].TakeUnsent(&first_sequence);
+      WriteInputRuns(packet, static_cast<PadIndex>(i), first_sequence, inputs,
+                     WriteWiimoteInputRun);
+      data_added = true;
+    }
+  }
+
+  if (data_added)
+    SendAsync(std::move(packet), INPUT_CHANNEL);
 }
 
 // called from ---GUI--- thread
@@ -1754,6 +2048,26 @@ bool NetPlayClient::StartGame(const std::string& path)
   m_current_golfer = 1;
   m_wait_on_input = false;
 
+  // Rollback can only be used when every client emulates on its own inputs and those it receives,
+  // and it doesn't cover Wii Remotes or inputs being recorded to a movie
+  m_rollback = Config::Get(Config::NETPLAY_ROLLBACK) && !m_host_input_authority &&
+               !m_dialog->IsRecording() &&
+               std::none_of(m_wiimote_map.begin(), m_wiimote_map.end(),
+                            [](PlayerId pid) { return pid > 0; });
+  m_rollback_stop_requested = false;
+  ResetRollback();
+
+  m_pad_polls = {};
+  m_used_pad_inputs = {};
+  m_desync_recovery_skips = {};
+  m_desync_recovery_replays = {};
+  m_desync_recovery_resimulating = false;
+  m_desync_recovery_state_requested = false;
+  {
+    std::lock_guard lk(m_desync_recovery_mutex);
+    m_desync_recovery_state.reset();
+  }
+
   m_is_running.Set();
   NetPlay_Enable(this);
 
@@ -1827,6 +2141,19 @@ void NetPlayClient::SyncSaveDataResponse(const bool success)
   {
     if (++m_sync_save_data_success_count >= m_sync_save_data_count)
     {
+      // Only keep the save data of the last synchronization cached
+      const File::FSTEntry cache = File::ScanDirectoryTree(GetSaveDataCacheDirectory(), false);
+      for (const File::FSTEntry& entry : cache.children)
+      {
+        const bool offered =
+            std::any_of(m_save_data_offered.begin(), m_save_data_offered.end(),
+                        [&](const auto& digest) {
+                          return GetSaveDataCacheFileName(digest) == entry.virtualName;
+                        });
+        if (!entry.isDirectory && !offered)
+          File::Delete(entry.physicalName);
+      }
+
       sf::Packet response_packet;
       response_packet << MessageID::SyncSaveData;
       response_packet << SyncSaveDataID::Success;
@@ -1935,6 +2262,15 @@ void NetPlayClient::ClearBuffers()
     while (m_wiimote_buffer[i].Size())
       m_wiimote_buffer[i].Pop();
   }
+
+  m_received_pad_inputs = {};
+  m_received_wiimote_inputs = {};
+
+  std::lock_guard lk(m_sent_inputs_mutex);
+  for (auto& inputs : m_sent_pad_inputs)
+    inputs.Clear();
+  for (auto& inputs : m_sent_wiimote_inputs)
+    inputs.Clear();
 }
 
 // called from ---NETPLAY--- thread
@@ -2040,6 +2376,96 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
     m_wait_on_input_event.Wait();
   }
 
+  if (m_rollback)
+    return GetRollbackNetPads(pad_nb, batching, pad_status);
+
+  PollAndSendLocalPads(pad_nb, batching);
+
+  if (m_host_input_authority)
+  {
+    if (m_local_player->pid != m_current_golfer)
+    {
+      // CoreTiming acts funny and causes what looks like frame skip if
+      // we toggle the emulation speed too quickly, so to prevent this
+      // we wait until the buffer has been over for at least 1 second.
+
+      const bool buffer_over_target = m_pad_buffer[pad_nb].Size() > m_target_buffer_size + 1;
+      if (!buffer_over_target)
+        m_buffer_under_target_last = std::chrono::steady_clock::now();
+
+      std::chrono::duration<double> time_diff =
+          std::chrono::steady_clock::now() - m_buffer_under_target_last;
+      if (time_diff.count() >= 1.0 || !buffer_over_target)
+      {
+        // run fast if the buffer is overfilled, otherwise run normal speed
+        Config::SetCurrent(Config::MAIN_EMULATION_SPEED, buffer_over_target ? 0.0f : 1.0f);
+      }
+    }
+    else
+    {
+      // Set normal speed when we're the host, otherwise it can get stuck at unlimited
+      Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 1.0f);
+    }
+  }
+
+  const auto pop_pad_input = [&](GCPadStatus* status) {
+    // Now, we either use the data pushed earlier, or wait for the
+    // other clients to send it to us
+    while (m_pad_buffer[pad_nb].Size() == 0)
+    {
+      if (!m_is_running.IsSet())
+      {
+        return false;
+      }
+
+      m_gc_pad_event.Wait();
+    }
+
+    m_pad_buffer[pad_nb].Pop(*status);
+    return true;
+  };
+
+  if (!m_desync_recovery_replays[pad_nb].empty())
+  {
+    // Already used once before the state of the host was loaded
+    *pad_status = m_desync_recovery_replays[pad_nb].front();
+    m_desync_recovery_replays[pad_nb].pop_front();
+  }
+  else
+  {
+    // The host had already used these when it saved the state that was loaded
+    for (; m_desync_recovery_skips[pad_nb] != 0; --m_desync_recovery_skips[pad_nb])
+    {
+      GCPadStatus skipped_status;
+      if (!pop_pad_input(&skipped_status))
+        return false;
+      RecordUsedPadInput(pad_nb, skipped_status);
+    }
+
+    if (!pop_pad_input(pad_status))
+      return false;
+  }
+
+  RecordUsedPadInput(pad_nb, *pad_status);
+  if (m_desync_recovery_resimulating)
+    FinishDesyncRecovery();
+
+  auto& movie = Core::System::GetInstance().GetMovie();
+  if (movie.IsRecordingInput())
+  {
+    movie.RecordInput(pad_status, pad_nb);
+    movie.InputUpdate();
+  }
+  else
+  {
+    movie.CheckPadStatus(pad_status, pad_nb);
+  }
+
+  return true;
+}
+
+void NetPlayClient::PollAndSendLocalPads(const int pad_nb, const bool batching)
+{
   if (IsFirstInGamePad(pad_nb) && batching)
   {
     sf::Packet packet;
@@ -2057,6 +2483,8 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
 
     if (m_host_input_authority)
       SendPadHostPoll(-1);
+    else
+      SendPackedPadData();
   }
 
   if (!batching)
@@ -2072,61 +2500,381 @@ bool NetPlayClient::GetNetPads(const int pad_nb, const bool batching, GCPadStatu
 
     if (m_host_input_authority)
       SendPadHostPoll(pad_nb);
+    else
+      SendPackedPadData();
   }
+}
 
-  if (m_host_input_authority)
+static bool IsSamePadStatus(const GCPadStatus& a, const GCPadStatus& b)
+{
+  return a.button == b.button && a.stickX == b.stickX && a.stickY == b.stickY &&
+         a.substickX == b.substickX && a.substickY == b.substickY &&
+         a.triggerLeft == b.triggerLeft && a.triggerRight == b.triggerRight &&
+         a.analogA == b.analogA && a.analogB == b.analogB && a.isConnected == b.isConnected;
+}
+
+// called from ---CPU--- thread
+bool NetPlayClient::GetRollbackNetPads(const int pad_nb, const bool batching,
+                                       GCPadStatus* pad_status)
+{
+  RollbackInputs& inputs = m_rollback_inputs[pad_nb];
+  const u64 known_polls = inputs.first_poll + inputs.inputs.size();
+
+  // After a rollback, the polls up to where the emulation was before are answered from the
+  // history. The local pads were already polled and sent for those.
+  if (inputs.next_poll < known_polls)
   {
-    if (m_local_player->pid != m_current_golfer)
-    {
-      // CoreTiming acts funny and causes what looks like frame skip if
-      // we toggle the emulation speed too quickly, so to prevent this
-      // we wait until the buffer has been over for at least 1 second.
+    ConfirmRollbackInputs();
 
-      const bool buffer_over_target = m_pad_buffer[pad_nb].Size() > m_target_buffer_size + 1;
-      if (!buffer_over_target)
-        m_buffer_under_target_last = std::chrono::steady_clock::now();
+    GCPadStatus& input = inputs.inputs[inputs.next_poll - inputs.first_poll];
+    if (inputs.next_poll >= inputs.confirmed_polls)
+      input = inputs.last_confirmed;
 
-      std::chrono::duration<double> time_diff =
-          std::chrono::steady_clock::now() - m_buffer_under_target_last;
-      if (time_diff.count() >= 1.0 || !buffer_over_target)
-      {
-        // run fast if the buffer is overfilled, otherwise run normal speed
-        Config::SetCurrent(Config::MAIN_EMULATION_SPEED, buffer_over_target ? 0.0f : 1.0f);
-      }
+    *pad_status = input;
+    ++inputs.next_poll;
+    return true;
+  }
+
+  PollAndSendLocalPads(pad_nb, batching);
+
+  while (true)
+  {
+    ConfirmRollbackInputs();
+
+    // The input for this poll has already arrived, or only earlier ones are still missing
+    if (inputs.confirmed_polls == inputs.next_poll && m_pad_buffer[pad_nb].Size() != 0)
+    {
+      m_pad_buffer[pad_nb].Pop(inputs.last_confirmed);
+      inputs.inputs.push_back(inputs.last_confirmed);
+      ++inputs.confirmed_polls;
+      break;
     }
-    else
+
+    if (CanPredictRollbackInputs())
     {
-      // Set normal speed when we're the host, otherwise it can get stuck at unlimited
-      Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 1.0f);
+      inputs.inputs.push_back(inputs.last_confirmed);
+      break;
     }
+
+    if (!m_is_running.IsSet())
+      return false;
+
+    m_gc_pad_event.Wait();
   }
 
-  // Now, we either use the data pushed earlier, or wait for the
-  // other clients to send it to us
-  while (m_pad_buffer[pad_nb].Size() == 0)
+  *pad_status = inputs.inputs.back();
+  ++inputs.next_poll;
+  return true;
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::ConfirmRollbackInputs()
+{
+  bool mispredicted = false;
+  for (size_t i = 0; i < m_rollback_inputs.size(); ++i)
   {
-    if (!m_is_running.IsSet())
+    // Inputs for polls which haven't happened yet stay in the pad buffer
+    RollbackInputs& inputs = m_rollback_inputs[i];
+    while (inputs.confirmed_polls < inputs.first_poll + inputs.inputs.size() &&
+           m_pad_buffer[i].Size() != 0)
     {
+      GCPadStatus& predicted = inputs.inputs[inputs.confirmed_polls - inputs.first_poll];
+      m_pad_buffer[i].Pop(inputs.last_confirmed);
+      if (inputs.confirmed_polls < inputs.next_poll &&
+          !IsSamePadStatus(predicted, inputs.last_confirmed))
+      {
+        inputs.mispredicted_poll = std::min(inputs.mispredicted_poll, inputs.confirmed_polls);
+        mispredicted = true;
+      }
+      predicted = inputs.last_confirmed;
+      ++inputs.confirmed_polls;
+    }
+  }
+
+  if (mispredicted)
+    RequestRollback();
+}
+
+bool NetPlayClient::IsRollbackConfirmed(const std::array<u64, 4>& next_polls) const
+{
+  for (size_t i = 0; i < m_rollback_inputs.size(); ++i)
+  {
+    const RollbackInputs& inputs = m_rollback_inputs[i];
+    if (next_polls[i] > inputs.confirmed_polls || next_polls[i] > inputs.mispredicted_poll)
       return false;
+  }
+  return true;
+}
+
+bool NetPlayClient::CanPredictRollbackInputs() const
+{
+  if (m_rollback_stop_requested)
+    return false;
+
+  // There has to be a state to roll back to if the prediction is wrong, and it has to stay around
+  // until the input arrives
+  const auto it = std::find_if(m_rollback_snapshots.rbegin(), m_rollback_snapshots.rend(),
+                               [this](const RollbackSnapshot& snapshot) {
+                                 return IsRollbackConfirmed(snapshot.next_polls);
+                               });
+  return it != m_rollback_snapshots.rend() && m_rollback_frame - it->frame < MAX_ROLLBACK_FRAMES;
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::RequestRollback()
+{
+  if (m_rollback_pending)
+    return;
+  m_rollback_pending = true;
+
+  // A state can't be loaded in the middle of the CPU loop, so this goes through the host thread,
+  // which pauses the CPU and has it run the rollback as a job outside of the loop.
+  Core::QueueHostJob([](Core::System& system) {
+    Core::RunOnCPUThread(
+        system,
+        [&system] {
+          std::lock_guard lk(crit_netplay_client);
+          if (netplay_client && netplay_client->m_rollback_pending)
+            netplay_client->Rollback(system);
+        },
+        true);
+  });
+}
+
+void NetPlayClient::Rollback(Core::System& system)
+{
+  m_rollback_pending = false;
+
+  const auto target = std::find_if(m_rollback_snapshots.rbegin(), m_rollback_snapshots.rend(),
+                                   [this](const RollbackSnapshot& snapshot) {
+                                     return IsRollbackConfirmed(snapshot.next_polls);
+                                   });
+  if (target == m_rollback_snapshots.rend())
+  {
+    ERROR_LOG_FMT(NETPLAY, "Rollback: No state from before the misprediction is left");
+    return;
+  }
+
+  State::LoadNetPlayStateFromBuffer(system, target->state);
+
+  if (!m_rollback_resimulating)
+  {
+    m_rollback_resimulating = true;
+    m_rollback_resimulate_until = m_rollback_frame;
+    m_rollback_emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+  }
+
+  DEBUG_LOG_FMT(NETPLAY, "Rollback: Going back {} fields", m_rollback_frame - target->frame);
+  m_rollback_frame = target->frame;
+  m_timebase_frame = target->timebase_frame;
+  for (size_t i = 0; i < m_rollback_inputs.size(); ++i)
+  {
+    m_rollback_inputs[i].next_poll = target->next_polls[i];
+    m_rollback_inputs[i].mispredicted_poll = UINT64_MAX;
+  }
+
+  // Everything after the loaded state was based on the wrong inputs
+  m_rollback_snapshots.erase(target.base(), m_rollback_snapshots.end());
+  std::erase_if(m_rollback_timebases, [this](const RollbackTimeBase& timebase) {
+    return timebase.frame >= m_timebase_frame;
+  });
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::OnRollbackFrameEnd(Core::System& system)
+{
+  ++m_rollback_frame;
+  if (m_rollback_resimulating && m_rollback_frame >= m_rollback_resimulate_until)
+  {
+    m_rollback_resimulating = false;
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, m_rollback_emulation_speed);
+  }
+
+  const bool settled = !m_rollback_pending && !m_rollback_resimulating &&
+                       std::all_of(m_rollback_inputs.begin(), m_rollback_inputs.end(),
+                                   [](const RollbackInputs& inputs) {
+                                     return inputs.confirmed_polls == inputs.next_poll &&
+                                            inputs.next_poll ==
+                                                inputs.first_poll + inputs.inputs.size();
+                                   });
+  if (m_rollback_stop_requested && settled)
+  {
+    INFO_LOG_FMT(NETPLAY, "Rollback: Switching to delay-based input");
+    SendConfirmedRollbackTimeBases();
+    m_rollback = false;
+    ResetRollback();
+    return;
+  }
+
+  // Reuse the memory of the oldest state, which is no longer needed
+  std::vector<u8> state;
+  if (m_rollback_snapshots.size() > MAX_ROLLBACK_FRAMES)
+  {
+    state = std::move(m_rollback_snapshots.front().state);
+    m_rollback_snapshots.pop_front();
+  }
+  State::SaveToBuffer(system, state);
+
+  std::array<u64, 4> next_polls;
+  for (size_t i = 0; i < m_rollback_inputs.size(); ++i)
+    next_polls[i] = m_rollback_inputs[i].next_poll;
+  m_rollback_snapshots.push_back(
+      {m_rollback_frame, m_timebase_frame, next_polls, std::move(state)});
+
+  // Inputs from before the oldest state will never be needed again
+  for (size_t i = 0; i < m_rollback_inputs.size(); ++i)
+  {
+    RollbackInputs& inputs = m_rollback_inputs[i];
+    const u64 oldest_poll = std::min(m_rollback_snapshots.front().next_polls[i],
+                                     inputs.confirmed_polls);
+    while (inputs.first_poll < oldest_poll)
+    {
+      inputs.inputs.pop_front();
+      ++inputs.first_poll;
     }
+  }
 
-    m_gc_pad_event.Wait();
+  SendConfirmedRollbackTimeBases();
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::SendConfirmedRollbackTimeBases()
+{
+  // The server compares the time bases of all players to detect desyncs, so they must not be sent
+  // before it's certain that the field they come from will not be emulated again
+  while (!m_rollback_timebases.empty() &&
+         IsRollbackConfirmed(m_rollback_timebases.front().next_polls))
+  {
+    const RollbackTimeBase& timebase = m_rollback_timebases.front();
+
+    sf::Packet packet;
+    packet << MessageID::TimeBase;
+    packet << static_cast<sf::Uint64>(timebase.timebase);
+    packet << timebase.frame;
+    SendAsync(std::move(packet));
+
+    m_rollback_timebases.pop_front();
   }
+}
 
-  m_pad_buffer[pad_nb].Pop(*pad_status);
+void NetPlayClient::ResetRollback()
+{
+  m_rollback_inputs = {};
+  m_rollback_snapshots.clear();
+  m_rollback_timebases.clear();
+  m_rollback_frame = 0;
+  m_rollback_resimulate_until = 0;
+  m_rollback_resimulating = false;
+  m_rollback_pending = false;
+}
 
-  auto& movie = Core::System::GetInstance().GetMovie();
-  if (movie.IsRecordingInput())
+// called from ---CPU--- thread
+void NetPlayClient::RecordUsedPadInput(int pad_nb, const GCPadStatus& pad_status)
+{
+  ++m_pad_polls[pad_nb];
+  m_used_pad_inputs[pad_nb].push_back(pad_status);
+  if (m_used_pad_inputs[pad_nb].size() > MAX_DESYNC_RECOVERY_INPUTS)
+    m_used_pad_inputs[pad_nb].pop_front();
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::SendDesyncRecoveryState(Core::System& system)
+{
+  std::vector<u8> state;
+  State::SaveToBuffer(system, state);
+
+  sf::Packet packet;
+  packet << MessageID::DesyncRecoveryState;
+  packet << m_timebase_frame;
+  for (u64 polls : m_pad_polls)
+    packet << sf::Uint64{polls};
+  if (!CompressBufferIntoPacket(state, packet))
+    return;
+
+  INFO_LOG_FMT(NETPLAY, "Sending the state of field {} to recover from the desync",
+               m_timebase_frame);
+  SendAsync(std::move(packet));
+}
+
+void NetPlayClient::RecoverFromDesync(Core::System& system)
+{
+  std::optional<DesyncRecoveryState> recovery;
   {
-    movie.RecordInput(pad_status, pad_nb);
-    movie.InputUpdate();
+    std::lock_guard lk(m_desync_recovery_mutex);
+    recovery = std::move(m_desync_recovery_state);
+    m_desync_recovery_state.reset();
   }
-  else
+  if (!recovery)
+    return;
+
+  // Rollback and host input authority don't use the inputs in the same order as the host
+  bool can_recover = !m_rollback && !m_host_input_authority;
+  for (size_t i = 0; i < m_pad_polls.size(); ++i)
   {
-    movie.CheckPadStatus(pad_status, pad_nb);
+    // The inputs used since the host saved the state have to be known to use them again
+    can_recover = can_recover && m_desync_recovery_replays[i].empty() &&
+                  (recovery->pad_polls[i] >= m_pad_polls[i] ||
+                   m_pad_polls[i] - recovery->pad_polls[i] <= m_used_pad_inputs[i].size());
+  }
+  if (!can_recover)
+  {
+    ERROR_LOG_FMT(NETPLAY, "Can't recover from the desync with the state of field {}",
+                  recovery->timebase_frame);
+    m_dialog->AppendChat(Common::GetStringT("Failed to recover from the desync."));
+    return;
   }
 
-  return true;
+  State::LoadNetPlayStateFromBuffer(system, recovery->state);
+
+  for (size_t i = 0; i < m_pad_polls.size(); ++i)
+  {
+    if (recovery->pad_polls[i] >= m_pad_polls[i])
+    {
+      m_desync_recovery_skips[i] = recovery->pad_polls[i] - m_pad_polls[i];
+      continue;
+    }
+
+    std::deque<GCPadStatus>& used = m_used_pad_inputs[i];
+    const size_t count = m_pad_polls[i] - recovery->pad_polls[i];
+    m_desync_recovery_replays[i].assign(used.end() - count, used.end());
+    used.erase(used.end() - count, used.end());
+    m_pad_polls[i] = recovery->pad_polls[i];
+  }
+  m_timebase_frame = recovery->timebase_frame;
+
+  INFO_LOG_FMT(NETPLAY, "Loaded the state of field {} to recover from the desync",
+               m_timebase_frame);
+
+  if (!m_desync_recovery_resimulating)
+  {
+    m_desync_recovery_resimulating = true;
+    m_desync_recovery_emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
+    Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+  }
+}
+
+// called from ---CPU--- thread
+void NetPlayClient::FinishDesyncRecovery()
+{
+  const bool caught_up =
+      std::all_of(m_desync_recovery_replays.begin(), m_desync_recovery_replays.end(),
+                  [](const auto& replays) { return replays.empty(); }) &&
+      std::all_of(m_desync_recovery_skips.begin(), m_desync_recovery_skips.end(),
+                  [](u64 skips) { return skips == 0; });
+  if (!caught_up)
+    return;
+
+  m_desync_recovery_resimulating = false;
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, m_desync_recovery_emulation_speed);
+
+  // The server compares time bases again from here on
+  sf::Packet packet;
+  packet << MessageID::DesyncRecovered;
+  packet << m_timebase_frame;
+  SendAsync(std::move(packet));
+
+  m_dialog->AppendChat(Common::GetStringT("Recovered from the desync."));
 }
 
 u64 NetPlayClient::GetInitialRTCValue() const
@@ -2146,10 +2894,8 @@ bool NetPlayClient::WiimoteUpdate(const std::span<WiimoteDataBatchEntry>& entrie
                   fmt::join(std::span(entry.state->data.data(), entry.state->length), ", "));
     if (local_wiimote < 4)
     {
-      sf::Packet packet;
-      packet << MessageID::WiimoteData;
-      if (AddLocalWiimoteToBuffer(local_wiimote, *entry.state, packet))
-        SendAsync(std::move(packet));
+      AddLocalWiimoteToBuffer(local_wiimote, *entry.state);
+      SendPackedWiimoteData();
     }
 
     // Now, we either use the data pushed earlier, or wait for the
@@ -2217,21 +2963,19 @@ bool NetPlayClient::PollLocalPad(const int local_pad, sf::Packet& packet)
       // add to buffer
       m_pad_buffer[ingame_pad].Push(pad_status);
 
-      // add to packet
-      AddPadStateToPacket(ingame_pad, pad_status, packet);
-      data_added = true;
+      // add to the inputs to send, which are packed together in SendPackedPadData
+      std::lock_guard lk(m_sent_inputs_mutex);
+      m_sent_pad_inputs[ingame_pad].Push(pad_status);
     }
   }
 
   return data_added;
 }
 
-bool NetPlayClient::AddLocalWiimoteToBuffer(const int local_wiimote,
-                                            const WiimoteEmu::SerializedWiimoteState& state,
-                                            sf::Packet& packet)
+void NetPlayClient::AddLocalWiimoteToBuffer(const int local_wiimote,
+                                            const WiimoteEmu::SerializedWiimoteState& state)
 {
   const int ingame_pad = LocalWiimoteToInGameWiimote(local_wiimote);
-  bool data_added = false;
 
   // adjust the buffer either up or down
   // inserting multiple padstates or dropping states
@@ -2240,12 +2984,10 @@ bool NetPlayClient::AddLocalWiimoteToBuffer(const int local_wiimote,
     // add to buffer
     m_wiimote_buffer[ingame_pad].Push(state);
 
-    // add to packet
-    AddWiimoteStateToPacket(ingame_pad, state, packet);
-    data_added = true;
+    // add to the inputs to send
+    std::lock_guard lk(m_sent_inputs_mutex);
+    m_sent_wiimote_inputs[ingame_pad].Push(state);
   }
-
-  return data_added;
 }
 
 void NetPlayClient::SendPadHostPoll(const PadIndex pad_num)
@@ -2526,17 +3268,43 @@ void NetPlayClient::SendTimeBase()
   {
     const sf::Uint64 timebase = Core::System::GetInstance().GetSystemTimers().GetFakeTimeBase();
 
-    sf::Packet packet;
-    packet << MessageID::TimeBase;
-    packet << timebase;
-    packet << netplay_client->m_timebase_frame;
+    if (netplay_client->m_rollback)
+    {
+      // Held back until the inputs it depends on are confirmed
+      std::array<u64, 4> next_polls;
+      for (size_t i = 0; i < next_polls.size(); ++i)
+        next_polls[i] = netplay_client->m_rollback_inputs[i].next_poll;
+      netplay_client->m_rollback_timebases.push_back(
+          {netplay_client->m_timebase_frame, timebase, next_polls});
+    }
+    else
+    {
+      sf::Packet packet;
+      packet << MessageID::TimeBase;
+      packet << timebase;
+      packet << netplay_client->m_timebase_frame;
 
-    netplay_client->SendAsync(std::move(packet));
+      netplay_client->SendAsync(std::move(packet));
+    }
   }
 
   netplay_client->m_timebase_frame++;
 }
 
+// called from ---CPU--- thread
+void NetPlayClient::OnFrameEnd(Core::System& system)
+{
+  std::lock_guard lk(crit_netplay_client);
+
+  if (!netplay_client)
+    return;
+
+  if (netplay_client->m_rollback)
+    netplay_client->OnRollbackFrameEnd(system);
+  else if (netplay_client->m_desync_recovery_state_requested.exchange(false))
+    netplay_client->SendDesyncRecoveryState(system);
+}
+
 bool NetPlayClient::DoAllPlayersHaveGame()
 {
   std::lock_guard lkp(m_crit.players);
@@ -5,10 +5,14 @@
 
 #include <SFML/Network/Packet.hpp>
 #include <array>
+#include <atomic>
 #include <chrono>
+#include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <set>
 #include <span>
 #include <string>
 #include <thread>
@@ -17,15 +21,22 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
 #include "Common/Event.h"
 #include "Common/SPSCQueue.h"
 #include "Common/TraversalClient.h"
+#include "Core/NetPlayInputCodec.h"
 #include "Core/NetPlayProto.h"
 #include "Core/SyncIdentifier.h"
 #include "InputCommon/GCPadStatus.h"
 
 class BootSessionData;
 
+namespace Core
+{
+class System;
+}
+
 namespace IOS::HLE::FS
 {
 class FileSystem;
@@ -166,6 +177,8 @@ public:
   const PlayerId& GetLocalPlayerId() const;
 
   static void SendTimeBase();
+  // Called on the CPU thread at the end of every emulated field
+  static void OnFrameEnd(Core::System& system);
   bool DoAllPlayersHaveGame();
 
   const PadMappingArray& GetPadMapping() const;
@@ -186,6 +199,70 @@ protected:
     u8 channel_id = 0;
   };
 
+  // Rollback mode. Instead of waiting for the inputs of remote players, they are predicted to
+  // stay the same as the last ones received, and the emulation carries on. A savestate is kept
+  // for each of the last MAX_ROLLBACK_FRAMES fields, and if a prediction turns out to be wrong,
+  // the newest state from before it is loaded and the fields since are emulated again at
+  // unlimited speed with the inputs that are known by then. This is purely local, every client
+  // still sends and receives the same inputs as in delay-based mode.
+  static constexpr u64 MAX_ROLLBACK_FRAMES = 8;
+
+  struct RollbackInputs
+  {
+    // The inputs used for polls first_poll and onwards, confirmed ones followed by predicted ones
+    std::deque<GCPadStatus> inputs;
+    u64 first_poll = 0;
+    u64 next_poll = 0;
+    u64 confirmed_polls = 0;
+    // The earliest poll with a wrong prediction, or UINT64_MAX if there is none
+    u64 mispredicted_poll = UINT64_MAX;
+    GCPadStatus last_confirmed{};
+  };
+
+  struct RollbackSnapshot
+  {
+    u64 frame;
+    u32 timebase_frame;
+    std::array<u64, 4> next_polls;
+    std::vector<u8> state;
+  };
+
+  struct RollbackTimeBase
+  {
+    u32 frame;
+    u64 timebase;
+    std::array<u64, 4> next_polls;
+  };
+
+  bool GetRollbackNetPads(int pad_nb, bool batching, GCPadStatus* pad_status);
+  void PollAndSendLocalPads(int pad_nb, bool batching);
+  void ConfirmRollbackInputs();
+  bool CanPredictRollbackInputs() const;
+  bool IsRollbackConfirmed(const std::array<u64, 4>& next_polls) const;
+  void RequestRollback();
+  void Rollback(Core::System& system);
+  void OnRollbackFrameEnd(Core::System& system);
+  void SendConfirmedRollbackTimeBases();
+  void ResetRollback();
+
+  // Desync recovery. When the server notices that a client desynced, the host saves its state at
+  // the end of a field and sends it along with how many inputs it had used for each pad by then.
+  // The desynced client loads it, and then either skips the inputs it hadn't used yet or uses the
+  // ones it had used since again at unlimited speed, until it caught up with the others.
+  static constexpr size_t MAX_DESYNC_RECOVERY_INPUTS = 3600;
+
+  struct DesyncRecoveryState
+  {
+    u32 timebase_frame;
+    std::array<u64, 4> pad_polls;
+    std::vector<u8> state;
+  };
+
+  void RecordUsedPadInput(int pad_nb, const GCPadStatus& pad_status);
+  void SendDesyncRecoveryState(Core::System& system);
+  void RecoverFromDesync(Core::System& system);
+  void FinishDesyncRecovery();
+
   void ClearBuffers();
 
   struct
@@ -198,8 +275,22 @@ protected:
 
   Common::SPSCQueue<AsyncQueueEntry, false> m_async_queue;
 
-  std::array<Common::SPSCQueue<GCPadStatus>, 4> m_pad_buffer;
-  std::array<Common::SPSCQueue<WiimoteEmu::SerializedWiimoteState>, 4> m_wiimote_buffer;
+  std::array<Common::SPSCSegmentedQueue<GCPadStatus>, 4> m_pad_buffer;
+  std::array<Common::SPSCSegmentedQueue<WiimoteEmu::SerializedWiimoteState>, 4> m_wiimote_buffer;
+
+  // Which of the inputs of the local pads can still be sent again, guarded by
+  // m_sent_inputs_mutex since resend requests are handled on the NetPlay thread
+  std::mutex m_sent_inputs_mutex;
+  std::array<SentInputs<GCPadStatus>, 4> m_sent_pad_inputs;
+  std::array<SentInputs<WiimoteEmu::SerializedWiimoteState>, 4> m_sent_wiimote_inputs;
+
+  struct ReceivedInputs
+  {
+    u32 next_sequence = 0;
+    std::chrono::steady_clock::time_point last_resend_request{};
+  };
+  std::array<ReceivedInputs, 4> m_received_pad_inputs{};
+  std::array<ReceivedInputs, 4> m_received_wiimote_inputs{};
 
   std::array<GCPadStatus, 4> m_last_pad_status{};
   std::array<bool, 4> m_first_pad_status_received{};
@@ -259,13 +350,13 @@ private:
   bool PollLocalPad(int local_pad, sf::Packet& packet);
   void SendPadHostPoll(PadIndex pad_num);
 
-  bool AddLocalWiimoteToBuffer(int local_wiimote, const WiimoteEmu::SerializedWiimoteState& state,
-                               sf::Packet& packet);
+  void AddLocalWiimoteToBuffer(int local_wiimote, const WiimoteEmu::SerializedWiimoteState& state);
+  void SendPackedPadData();
+  void SendPackedWiimoteData();
+  void RequestInputResend(MessageID request, PadIndex map, ReceivedInputs& received);
 
   void UpdateDevices();
   void AddPadStateToPacket(int in_game_pad, const GCPadStatus& np, sf::Packet& packet);
-  void AddWiimoteStateToPacket(int in_game_pad, const WiimoteEmu::SerializedWiimoteState& np,
-                               sf::Packet& packet);
   void Send(const sf::Packet& packet, u8 channel_id = DEFAULT_CHANNEL);
   void Disconnect();
   bool Connect();
@@ -286,8 +377,11 @@ private:
   void OnWiimoteMapping(sf::Packet& packet);
   void OnGBAConfig(sf::Packet& packet);
   void OnPadData(sf::Packet& packet);
+  void OnPadDataPacked(sf::Packet& packet);
   void OnPadHostData(sf::Packet& packet);
+  void OnPadDataResendRequest(sf::Packet& packet);
   void OnWiimoteData(sf::Packet& packet);
+  void OnWiimoteDataResendRequest(sf::Packet& packet);
   void OnPadBuffer(sf::Packet& packet);
   void OnHostInputAuthority(sf::Packet& packet);
   void OnGolfSwitch(sf::Packet& packet);
@@ -300,8 +394,11 @@ private:
   void OnPing(sf::Packet& packet);
   void OnPlayerPingData(sf::Packet& packet);
   void OnDesyncDetected(sf::Packet& packet);
+  void OnDesyncRecoveryRequest();
+  void OnDesyncRecoveryState(sf::Packet& packet);
   void OnSyncSaveData(sf::Packet& packet);
   void OnSyncSaveDataNotify(sf::Packet& packet);
+  void OnSyncSaveDataOffer(sf::Packet& packet);
   void OnSyncSaveDataRaw(sf::Packet& packet);
   void OnSyncSaveDataGCI(sf::Packet& packet);
   void OnSyncSaveDataWii(sf::Packet& packet);
@@ -335,6 +432,10 @@ private:
   Common::Event m_first_pad_status_received_event;
   Common::Event m_wait_on_input_event;
   u8 m_sync_save_data_count = 0;
+  // The save data offered in the current synchronization, and the part of it which wasn't cached
+  // and is cached once it's received
+  std::set<Common::SHA1::Digest> m_save_data_offered;
+  std::set<Common::SHA1::Digest> m_save_data_requested;
   u8 m_sync_save_data_success_count = 0;
   u16 m_sync_gecko_codes_count = 0;
   u16 m_sync_gecko_codes_success_count = 0;
@@ -347,6 +448,31 @@ private:
   u64 m_initial_rtc = 0;
   u32 m_timebase_frame = 0;
 
+  // Only touched on the CPU thread, or while it is paused
+  bool m_rollback = false;
+  std::array<RollbackInputs, 4> m_rollback_inputs;
+  std::deque<RollbackSnapshot> m_rollback_snapshots;
+  std::deque<RollbackTimeBase> m_rollback_timebases;
+  u64 m_rollback_frame = 0;
+  u64 m_rollback_resimulate_until = 0;
+  bool m_rollback_resimulating = false;
+  float m_rollback_emulation_speed = 1.0f;
+  bool m_rollback_pending = false;
+  // Set when host input authority is enabled during a game, which rollback doesn't support
+  std::atomic<bool> m_rollback_stop_requested = false;
+
+  // Only touched on the CPU thread, or while it is paused
+  std::array<u64, 4> m_pad_polls{};
+  std::array<std::deque<GCPadStatus>, 4> m_used_pad_inputs;
+  std::array<u64, 4> m_desync_recovery_skips{};
+  std::array<std::deque<GCPadStatus>, 4> m_desync_recovery_replays;
+  bool m_desync_recovery_resimulating = false;
+  float m_desync_recovery_emulation_speed = 1.0f;
+  // Set on the NetPlay thread
+  std::atomic<bool> m_desync_recovery_state_requested = false;
+  std::mutex m_desync_recovery_mutex;
+  std::optional<DesyncRecoveryState> m_desync_recovery_state;
+
   std::unique_ptr<IOS::HLE::FS::FileSystem> m_wii_sync_fs;
   std::vector<u64> m_wii_sync_titles;
   std::string m_wii_sync_redirect_folder;
@@ -4,9 +4,12 @@
 #include "Core/NetPlayCommon.h"
 
 #include <algorithm>
+#include <future>
+#include <span>
+#include <thread>
 
 #include <fmt/format.h>
-#include <lzo/lzo1x.h>
+#include <zstd.h>
 
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
@@ -15,78 +18,136 @@
 
 namespace NetPlay
 {
-constexpr u32 LZO_IN_LEN = 1024 * 64;
-constexpr u32 LZO_OUT_LEN = LZO_IN_LEN + (LZO_IN_LEN / 16) + 64 + 3;
+// Data is split into chunks of this size which are compressed independently, so that they can
+// be compressed on all threads at once and decompressed into a buffer of a known size.
+constexpr size_t COMPRESSION_CHUNK_SIZE = 1024 * 1024;
+constexpr int COMPRESSION_LEVEL = 9;
 
-bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet)
+// The size of the data, then every compressed chunk preceded by its size, then a size of 0
+static bool CompressSpanIntoPacket(std::span<const u8> data, sf::Packet& packet)
 {
-  File::IOFile file(file_path, "rb");
-  if (!file)
-  {
-    PanicAlertFmtT("Failed to open file \"{0}\".", file_path);
-    return false;
-  }
-
-  const sf::Uint64 size = file.GetSize();
+  const sf::Uint64 size = data.size();
   packet << size;
 
   if (size == 0)
     return true;
 
-  std::vector<u8> in_buffer(LZO_IN_LEN);
-  std::vector<u8> out_buffer(LZO_OUT_LEN);
-  std::vector<u8> wrkmem(LZO1X_1_MEM_COMPRESS);
-
-  lzo_uint i = 0;
-  while (true)
+  const size_t chunk_count = (data.size() + COMPRESSION_CHUNK_SIZE - 1) / COMPRESSION_CHUNK_SIZE;
+  std::vector<std::vector<u8>> compressed_chunks(chunk_count);
+
+  const auto compress_chunk = [&](size_t i) {
+    const size_t offset = i * COMPRESSION_CHUNK_SIZE;
+    const std::span<const u8> chunk =
+        data.subspan(offset, std::min(COMPRESSION_CHUNK_SIZE, data.size() - offset));
+    std::vector<u8>& out_buffer = compressed_chunks[i];
+    out_buffer.resize(ZSTD_compressBound(chunk.size()));
+    const size_t out_len = ZSTD_compress(out_buffer.data(), out_buffer.size(), chunk.data(),
+                                         chunk.size(), COMPRESSION_LEVEL);
+    out_buffer.resize(ZSTD_isError(out_len) ? 0 : out_len);
+  };
+
+  const size_t thread_count =
+      std::min(chunk_count, std::max<size_t>(1, std::thread::hardware_concurrency()));
+  std::vector<std::future<void>> futures(thread_count);
+  for (size_t i = 0; i < thread_count; ++i)
   {
-    lzo_uint32 cur_len = 0;  // number of bytes to read
-    lzo_uint out_len = 0;    // number of bytes to write
+    futures[i] = std::async(std::launch::async, [&, i]() {
+      for (size_t j = i; j < chunk_count; j += thread_count)
+        compress_chunk(j);
+    });
+  }
+  for (std::future<void>& future : futures)
+    future.wait();
 
-    if ((i + LZO_IN_LEN) >= size)
-    {
-      cur_len = static_cast<lzo_uint32>(size - i);
-    }
-    else
+  for (const std::vector<u8>& chunk : compressed_chunks)
+  {
+    // A successfully compressed chunk is never empty, since it includes the zstd frame header
+    if (chunk.empty())
     {
-      cur_len = LZO_IN_LEN;
+      PanicAlertFmtT("Internal zstd Error - compression failed");
+      return false;
     }
 
-    if (cur_len <= 0)
-      break;  // EOF
+    packet << static_cast<u32>(chunk.size());
+    packet.append(chunk.data(), chunk.size());
+  }
 
-    if (!file.ReadBytes(in_buffer.data(), cur_len))
+  // Mark end of data
+  packet << static_cast<u32>(0);
+
+  return true;
+}
+
+// Calls write_chunk with every decompressed chunk in order
+template <typename WriteChunk>
+static bool DecompressPacketChunks(sf::Packet& packet, u64 size, WriteChunk write_chunk)
+{
+  std::vector<u8> in_buffer(ZSTD_compressBound(COMPRESSION_CHUNK_SIZE));
+  std::vector<u8> out_buffer(COMPRESSION_CHUNK_SIZE);
+
+  u64 offset = 0;
+  while (true)
+  {
+    u32 cur_len = 0;  // number of bytes to read
+    packet >> cur_len;
+    if (!cur_len)
+      break;  // We reached the end of the data stream
+
+    if (cur_len > in_buffer.size() || offset >= size)
     {
-      PanicAlertFmtT("Error reading file: {0}", file_path.c_str());
+      PanicAlertFmtT("Internal zstd Error - decompression failed");
       return false;
     }
 
-    if (lzo1x_1_compress(in_buffer.data(), cur_len, out_buffer.data(), &out_len, wrkmem.data()) !=
-        LZO_E_OK)
+    for (size_t j = 0; j < cur_len; j++)
     {
-      PanicAlertFmtT("Internal LZO Error - compression failed");
-      return false;
+      packet >> in_buffer[j];
     }
 
-    // The size of the data to write is 'out_len'
-    packet << static_cast<u32>(out_len);
-    for (size_t j = 0; j < out_len; j++)
+    const size_t expected_len =
+        static_cast<size_t>(std::min<u64>(COMPRESSION_CHUNK_SIZE, size - offset));
+    const size_t new_len =
+        ZSTD_decompress(out_buffer.data(), expected_len, in_buffer.data(), cur_len);
+    if (ZSTD_isError(new_len) || new_len != expected_len)
     {
-      packet << out_buffer[j];
+      PanicAlertFmtT("Internal zstd Error - decompression failed");
+      return false;
     }
 
-    if (cur_len != LZO_IN_LEN)
-      break;
+    if (!write_chunk(offset, std::span<const u8>(out_buffer.data(), new_len)))
+      return false;
 
-    i += cur_len;
+    offset += new_len;
   }
 
-  // Mark end of data
-  packet << static_cast<u32>(0);
+  if (offset != size)
+  {
+    PanicAlertFmtT("Internal zstd Error - decompression failed");
+    return false;
+  }
 
   return true;
 }
 
+bool CompressFileIntoPacket(const std::string& file_path, sf::Packet& packet)
+{
+  File::IOFile file(file_path, "rb");
+  if (!file)
+  {
+    PanicAlertFmtT("Failed to open file \"{0}\".", file_path);
+    return false;
+  }
+
+  std::vector<u8> data(file.GetSize());
+  if (!data.empty() && !file.ReadBytes(data.data(), data.size()))
+  {
+    PanicAlertFmtT("Error reading file: {0}", file_path.c_str());
+    return false;
+  }
+
+  return CompressSpanIntoPacket(data, packet);
+}
+
 static bool CompressFolderIntoPacketInternal(const File::FSTEntry& folder, sf::Packet& packet)
 {
   const sf::Uint64 size = folder.children.size();
@@ -118,57 +179,7 @@ bool CompressFolderIntoPacket(const std::string& folder_path, sf::Packet& packet
 
 bool CompressBufferIntoPacket(const std::vector<u8>& in_buffer, sf::Packet& packet)
 {
-  const sf::Uint64 size = in_buffer.size();
-  packet << size;
-
-  if (size == 0)
-    return true;
-
-  std::vector<u8> out_buffer(LZO_OUT_LEN);
-  std::vector<u8> wrkmem(LZO1X_1_MEM_COMPRESS);
-
-  lzo_uint i = 0;
-  while (true)
-  {
-    lzo_uint32 cur_len = 0;  // number of bytes to read
-    lzo_uint out_len = 0;    // number of bytes to write
-
-    if ((i + LZO_IN_LEN) >= size)
-    {
-      cur_len = static_cast<lzo_uint32>(size - i);
-    }
-    else
-    {
-      cur_len = LZO_IN_LEN;
-    }
-
-    if (cur_len <= 0)
-      break;  // end of buffer
-
-    if (lzo1x_1_compress(&in_buffer[i], cur_len, out_buffer.data(), &out_len, wrkmem.data()) !=
-        LZO_E_OK)
-    {
-      PanicAlertFmtT("Internal LZO Error - compression failed");
-      return false;
-    }
-
-    // The size of the data to write is 'out_len'
-    packet << static_cast<u32>(out_len);
-    for (size_t j = 0; j < out_len; j++)
-    {
-      packet << out_buffer[j];
-    }
-
-    if (cur_len != LZO_IN_LEN)
-      break;
-
-    i += cur_len;
-  }
-
-  // Mark end of data
-  packet << static_cast<u32>(0);
-
-  return true;
+  return CompressSpanIntoPacket(in_buffer, packet);
 }
 
 bool DecompressPacketIntoFile(sf::Packet& packet, const std::string& file_path)
@@ -185,38 +196,14 @@ bool DecompressPacketIntoFile(sf::Packet& packet, const std::string& file_path)
     return false;
   }
 
-  std::vector<u8> in_buffer(LZO_OUT_LEN);
-  std::vector<u8> out_buffer(LZO_IN_LEN);
-
-  while (true)
-  {
-    u32 cur_len = 0;       // number of bytes to read
-    lzo_uint new_len = 0;  // number of bytes to write
-
-    packet >> cur_len;
-    if (!cur_len)
-      break;  // We reached the end of the data stream
-
-    for (size_t j = 0; j < cur_len; j++)
-    {
-      packet >> in_buffer[j];
-    }
-
-    if (lzo1x_decompress(in_buffer.data(), cur_len, out_buffer.data(), &new_len, nullptr) !=
-        LZO_E_OK)
-    {
-      PanicAlertFmtT("Internal LZO Error - decompression failed");
-      return false;
-    }
-
-    if (!file.WriteBytes(out_buffer.data(), new_len))
+  return DecompressPacketChunks(packet, file_size, [&](u64, std::span<const u8> chunk) {
+    if (!file.WriteBytes(chunk.data(), chunk.size()))
     {
       PanicAlertFmtT("Error writing file: {0}", file_path);
       return false;
     }
-  }
-
-  return true;
+    return true;
+  });
 }
 
 static bool DecompressPacketIntoFolderInternal(sf::Packet& packet, const std::string& folder_path)
@@ -269,31 +256,13 @@ std::optional<std::vector<u8>> DecompressPacketIntoBuffer(sf::Packet& packet)
   if (size == 0)
     return out_buffer;
 
-  std::vector<u8> in_buffer(LZO_OUT_LEN);
-
-  lzo_uint i = 0;
-  while (true)
-  {
-    u32 cur_len = 0;       // number of bytes to read
-    lzo_uint new_len = 0;  // number of bytes to write
-
-    packet >> cur_len;
-    if (!cur_len)
-      break;  // We reached the end of the data stream
-
-    for (size_t j = 0; j < cur_len; j++)
-    {
-      packet >> in_buffer[j];
-    }
-
-    if (lzo1x_decompress(in_buffer.data(), cur_len, &out_buffer[i], &new_len, nullptr) != LZO_E_OK)
-    {
-      PanicAlertFmtT("Internal LZO Error - decompression failed");
-      return {};
-    }
-
-    i += new_len;
-  }
+  const bool success =
+      DecompressPacketChunks(packet, size, [&](u64 offset, std::span<const u8> chunk) {
+        std::copy(chunk.begin(), chunk.end(), out_buffer.begin() + offset);
+        return true;
+      });
+  if (!success)
+    return {};
 
   return out_buffer;
 }
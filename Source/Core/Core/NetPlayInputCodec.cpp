@@ -0,0 +1,257 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/NetPlayInputCodec.h"
+
+#include <algorithm>
+#include <array>
+#include <tuple>
+
+namespace NetPlay
+{
+// Bits of the change mask which starts every pad input
+enum : u32
+{
+  PAD_CHANGED_BUTTON = 1 << 0,
+  // Followed by one bit for each of PAD_ANALOG_FIELDS
+  PAD_CHANGED_FIRST_ANALOG = 1 << 1,
+  PAD_CHANGED_CONNECTED = 1 << 9,
+};
+
+static constexpr std::array PAD_ANALOG_FIELDS = {
+    &GCPadStatus::stickX,      &GCPadStatus::stickY,       &GCPadStatus::substickX,
+    &GCPadStatus::substickY,   &GCPadStatus::triggerLeft,  &GCPadStatus::triggerRight,
+    &GCPadStatus::analogA,     &GCPadStatus::analogB};
+
+// A Wiimote input that is the same as the one before it is just this byte
+static constexpr u8 WIIMOTE_UNCHANGED = 0xff;
+
+static GCPadStatus NeutralPadStatus()
+{
+  GCPadStatus status;
+  status.stickX = GCPadStatus::MAIN_STICK_CENTER_X;
+  status.stickY = GCPadStatus::MAIN_STICK_CENTER_Y;
+  status.substickX = GCPadStatus::C_STICK_CENTER_X;
+  status.substickY = GCPadStatus::C_STICK_CENTER_Y;
+  return status;
+}
+
+// Every field is read byte by byte, so running out of data is the only way for a read to fail
+template <typename T>
+static bool ReadByte(sf::Packet& packet, T* value)
+{
+  static_assert(sizeof(T) == 1);
+  if (packet.endOfPacket())
+    return false;
+  packet >> *value;
+  return true;
+}
+
+static void WriteVarInt(sf::Packet& packet, u32 value)
+{
+  while (value >= 0x80)
+  {
+    packet << static_cast<u8>(value | 0x80);
+    value >>= 7;
+  }
+  packet << static_cast<u8>(value);
+}
+
+static bool ReadVarInt(sf::Packet& packet, u32* value)
+{
+  *value = 0;
+  for (u32 shift = 0; shift < 32; shift += 7)
+  {
+    u8 byte;
+    if (!ReadByte(packet, &byte))
+      return false;
+
+    *value |= static_cast<u32>(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      return true;
+  }
+  return false;
+}
+
+static void WriteRunHeader(sf::Packet& packet, PadIndex pad, u32 first_sequence, size_t count)
+{
+  packet << pad;
+  WriteVarInt(packet, first_sequence);
+  WriteVarInt(packet, static_cast<u32>(count));
+}
+
+static bool ReadRunHeader(sf::Packet& packet, PadIndex* pad, u32* first_sequence, u32* count)
+{
+  if (!ReadByte(packet, pad) || *pad < 0 || *pad >= 4)
+    return false;
+  return ReadVarInt(packet, first_sequence) && ReadVarInt(packet, count) &&
+         *count <= MAX_INPUTS_PER_RUN;
+}
+
+void WritePadInputRun(sf::Packet& packet, PadIndex pad, u32 first_sequence,
+                      std::span<const GCPadStatus> inputs)
+{
+  WriteRunHeader(packet, pad, first_sequence, inputs.size());
+
+  GCPadStatus previous = NeutralPadStatus();
+  for (const GCPadStatus& input : inputs)
+  {
+    u32 mask = 0;
+    if (input.button != previous.button)
+      mask |= PAD_CHANGED_BUTTON;
+    for (size_t i = 0; i < PAD_ANALOG_FIELDS.size(); ++i)
+    {
+      if (input.*PAD_ANALOG_FIELDS[i] != previous.*PAD_ANALOG_FIELDS[i])
+        mask |= PAD_CHANGED_FIRST_ANALOG << i;
+    }
+    if (input.isConnected != previous.isConnected)
+      mask |= PAD_CHANGED_CONNECTED;
+
+    WriteVarInt(packet, mask);
+    if (mask & PAD_CHANGED_BUTTON)
+      WriteVarInt(packet, input.button ^ previous.button);
+    for (size_t i = 0; i < PAD_ANALOG_FIELDS.size(); ++i)
+    {
+      if (!(mask & (PAD_CHANGED_FIRST_ANALOG << i)))
+        continue;
+
+      // Zigzag encoded, so that the small movements between inputs take a single byte
+      const auto field = PAD_ANALOG_FIELDS[i];
+      const s8 delta = static_cast<s8>(input.*field - previous.*field);
+      WriteVarInt(packet, static_cast<u32>((delta << 1) ^ (delta >> 7)) & 0xff);
+    }
+
+    previous = input;
+  }
+}
+
+bool ReadPadInputRun(sf::Packet& packet, PadIndex* pad, u32* first_sequence,
+                     std::vector<GCPadStatus>* inputs)
+{
+  u32 count;
+  if (!ReadRunHeader(packet, pad, first_sequence, &count))
+    return false;
+
+  inputs->clear();
+  GCPadStatus previous = NeutralPadStatus();
+  for (u32 n = 0; n < count; ++n)
+  {
+    u32 mask;
+    if (!ReadVarInt(packet, &mask))
+      return false;
+
+    GCPadStatus input = previous;
+    if (mask & PAD_CHANGED_BUTTON)
+    {
+      u32 button;
+      if (!ReadVarInt(packet, &button))
+        return false;
+      input.button ^= static_cast<u16>(button);
+    }
+    for (size_t i = 0; i < PAD_ANALOG_FIELDS.size(); ++i)
+    {
+      if (!(mask & (PAD_CHANGED_FIRST_ANALOG << i)))
+        continue;
+
+      u32 zigzag;
+      if (!ReadVarInt(packet, &zigzag))
+        return false;
+      const auto field = PAD_ANALOG_FIELDS[i];
+      const s32 delta = static_cast<s32>(zigzag >> 1) ^ -static_cast<s32>(zigzag & 1);
+      input.*field = static_cast<u8>(input.*field + delta);
+    }
+    if (mask & PAD_CHANGED_CONNECTED)
+      input.isConnected = !input.isConnected;
+
+    inputs->push_back(input);
+    previous = input;
+  }
+
+  return true;
+}
+
+void WriteWiimoteInputRun(sf::Packet& packet, PadIndex pad, u32 first_sequence,
+                          std::span<const WiimoteEmu::SerializedWiimoteState> inputs)
+{
+  WriteRunHeader(packet, pad, first_sequence, inputs.size());
+
+  WiimoteEmu::SerializedWiimoteState previous{};
+  for (const WiimoteEmu::SerializedWiimoteState& input : inputs)
+  {
+    if (input.length == previous.length &&
+        std::equal(input.data.begin(), input.data.begin() + input.length, previous.data.begin()))
+    {
+      packet << WIIMOTE_UNCHANGED;
+      continue;
+    }
+
+    // The length, a bit for each byte telling whether it changed, and the bytes which did
+    packet << input.length;
+    for (size_t i = 0; i < input.length; i += 8)
+    {
+      u8 changed = 0;
+      for (size_t bit = 0; bit < 8 && i + bit < input.length; ++bit)
+      {
+        if (input.data[i + bit] != previous.data[i + bit])
+          changed |= 1 << bit;
+      }
+      packet << changed;
+    }
+    for (size_t i = 0; i < input.length; ++i)
+    {
+      if (input.data[i] != previous.data[i])
+        packet << input.data[i];
+    }
+
+    // Bytes past the length compare as zero next time
+    previous = WiimoteEmu::SerializedWiimoteState{};
+    previous.length = input.length;
+    std::copy_n(input.data.begin(), input.length, previous.data.begin());
+  }
+}
+
+bool ReadWiimoteInputRun(sf::Packet& packet, PadIndex* pad, u32* first_sequence,
+                         std::vector<WiimoteEmu::SerializedWiimoteState>* inputs)
+{
+  u32 count;
+  if (!ReadRunHeader(packet, pad, first_sequence, &count))
+    return false;
+
+  inputs->clear();
+  WiimoteEmu::SerializedWiimoteState previous{};
+  for (u32 n = 0; n < count; ++n)
+  {
+    u8 length;
+    if (!ReadByte(packet, &length))
+      return false;
+
+    if (length != WIIMOTE_UNCHANGED)
+    {
+      if (length > previous.data.size())
+        return false;
+
+      std::array<u8, (std::tuple_size_v<decltype(previous.data)> + 7) / 8> changed;
+      for (size_t i = 0; i < (length + 7u) / 8; ++i)
+      {
+        if (!ReadByte(packet, &changed[i]))
+          return false;
+      }
+
+      WiimoteEmu::SerializedWiimoteState input{};
+      input.length = length;
+      for (size_t i = 0; i < length; ++i)
+      {
+        if (!((changed[i / 8] >> (i % 8)) & 1))
+          input.data[i] = previous.data[i];
+        else if (!ReadByte(packet, &input.data[i]))
+          return false;
+      }
+      previous = input;
+    }
+
+    inputs->push_back(previous);
+  }
+
+  return true;
+}
+}  // namespace NetPlay
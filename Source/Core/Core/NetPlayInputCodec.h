@@ -0,0 +1,98 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Compact encoding of the controller inputs in PadDataPacked and WiimoteData messages.
+//
+// A message is a sequence of runs, each of which holds consecutive inputs of one in-game pad:
+// the PadIndex, the sequence number of the first input and the number of inputs as varints, and
+// then the inputs. Each input is delta-encoded against the one before it, the first one in a run
+// against a neutral state, so every run can be decoded on its own. Since an input that didn't
+// change costs a single byte, every message repeats the last few inputs that were already sent,
+// and a lost message doesn't have to be retransmitted before the inputs after it can be used.
+
+#pragma once
+
+#include <algorithm>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <SFML/Network/Packet.hpp>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/WiimoteEmu/DesiredWiimoteState.h"
+#include "Core/NetPlayProto.h"
+#include "InputCommon/GCPadStatus.h"
+
+namespace NetPlay
+{
+// How many of the inputs that were sent before are repeated in every message
+constexpr u32 REDUNDANT_INPUTS = 4;
+// Limits the size of a single run, including when inputs are sent again on request
+constexpr u32 MAX_INPUTS_PER_RUN = 256;
+
+void WritePadInputRun(sf::Packet& packet, PadIndex pad, u32 first_sequence,
+                      std::span<const GCPadStatus> inputs);
+void WriteWiimoteInputRun(sf::Packet& packet, PadIndex pad, u32 first_sequence,
+                          std::span<const WiimoteEmu::SerializedWiimoteState> inputs);
+
+// Return false if the packet is malformed, in which case the rest of it can't be read
+bool ReadPadInputRun(sf::Packet& packet, PadIndex* pad, u32* first_sequence,
+                     std::vector<GCPadStatus>* inputs);
+bool ReadWiimoteInputRun(sf::Packet& packet, PadIndex* pad, u32* first_sequence,
+                         std::vector<WiimoteEmu::SerializedWiimoteState>* inputs);
+
+// The inputs of one local pad which were sent recently, so that they can be repeated in the
+// following messages and sent again if a receiver missed too many of them.
+template <typename T>
+class SentInputs
+{
+public:
+  // About 17 seconds at 60 polls per second
+  static constexpr size_t MAX_INPUTS = 1024;
+
+  void Push(const T& input)
+  {
+    // Dropping old inputs in bulk keeps them contiguous at a constant amortized cost
+    if (m_inputs.size() == 2 * MAX_INPUTS)
+    {
+      m_inputs.erase(m_inputs.begin(), m_inputs.begin() + MAX_INPUTS);
+      m_first_sequence += MAX_INPUTS;
+    }
+    m_inputs.push_back(input);
+    ++m_unsent;
+  }
+
+  // The inputs which haven't been sent yet and the REDUNDANT_INPUTS before them. Afterwards,
+  // they all count as sent.
+  std::span<const T> TakeUnsent(u32* first_sequence)
+  {
+    const size_t count = std::min<size_t>(m_unsent + REDUNDANT_INPUTS, m_inputs.size());
+    m_unsent = 0;
+    *first_sequence = m_first_sequence + static_cast<u32>(m_inputs.size() - count);
+    return std::span(m_inputs).last(count);
+  }
+
+  // Everything from the given sequence number on, if it hasn't been dropped yet
+  std::optional<std::span<const T>> GetFrom(u32 sequence) const
+  {
+    if (sequence < m_first_sequence || sequence - m_first_sequence > m_inputs.size())
+      return std::nullopt;
+    return std::span(m_inputs).subspan(sequence - m_first_sequence);
+  }
+
+  bool HasUnsent() const { return m_unsent != 0; }
+
+  void Clear()
+  {
+    m_inputs.clear();
+    m_first_sequence = 0;
+    m_unsent = 0;
+  }
+
+private:
+  std::vector<T> m_inputs;
+  u32 m_first_sequence = 0;
+  u32 m_unsent = 0;
+};
+}  // namespace NetPlay
@@ -53,6 +53,7 @@ struct NetSettings
 
   bool efb_access_enable = false;
   bool bbox_enable = false;
+  bool bbox_late_readback = false;
   bool force_progressive = false;
   bool efb_to_texture_enable = false;
   bool xfb_to_texture_enable = false;
@@ -94,6 +95,7 @@ struct NetSettings
   bool defer_efb_copies = false;
   int efb_access_tile_size = 0;
   bool efb_access_defer_invalidation = false;
+  bool efb_access_allow_stale = false;
 
   bool savedata_load = false;
   bool savedata_write = false;
@@ -150,9 +152,12 @@ enum class MessageID : u8
   PadBuffer = 0x62,
   PadHostData = 0x63,
   GBAConfig = 0x64,
+  PadDataPacked = 0x65,
+  PadDataResendRequest = 0x66,
 
   WiimoteData = 0x70,
   WiimoteMapping = 0x71,
+  WiimoteDataResendRequest = 0x72,
 
   GolfRequest = 0x90,
   GolfSwitch = 0x91,
@@ -171,6 +176,9 @@ enum class MessageID : u8
 
   TimeBase = 0xB0,
   DesyncDetected = 0xB1,
+  DesyncRecoveryRequest = 0xB2,
+  DesyncRecoveryState = 0xB3,
+  DesyncRecovered = 0xB4,
 
   ComputeGameDigest = 0xC0,
   GameDigestProgress = 0xC1,
@@ -206,7 +214,10 @@ enum class SyncSaveDataID : u8
   RawData = 3,
   GCIData = 4,
   WiiData = 5,
-  GBAData = 6
+  GBAData = 6,
+  // The hash of the next piece of save data, which clients which don't have it cached request
+  Offer = 7,
+  Request = 8
 };
 
 enum class SyncCodeID : u8
@@ -228,6 +239,8 @@ enum : u8
 {
   DEFAULT_CHANNEL,
   CHUNKED_DATA_CHANNEL,
+  // Unreliable, for the packed input messages which repeat recent inputs instead
+  INPUT_CHANNEL,
   CHANNEL_COUNT
 };
 
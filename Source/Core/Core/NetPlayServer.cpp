@@ -61,6 +61,7 @@
 #include "Core/IOS/Uids.h"
 #include "Core/NetPlayClient.h"  //for NetPlayUI
 #include "Core/NetPlayCommon.h"
+#include "Core/NetPlayInputCodec.h"
 #include "Core/SyncIdentifier.h"
 
 #include "DiscIO/Enums.h"
@@ -873,41 +874,66 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
   }
   break;
 
+  case MessageID::PadDataPacked:
+  {
+    // if this is pad data from the last game still being received, ignore it
+    if (player.current_game != m_current_game)
+      break;
+
+    // The inputs are relayed as they are, after checking that they can be decoded and that
+    // they're all from the right player. Otherwise, disconnect them.
+    std::vector<GCPadStatus> inputs;
+    while (!packet.endOfPacket())
+    {
+      PadIndex map;
+      u32 first_sequence;
+      if (!ReadPadInputRun(packet, &map, &first_sequence, &inputs) ||
+          m_pad_map.at(map) != player.pid)
+      {
+        return 1;
+      }
+    }
+
+    SendToClients(packet, player.pid, INPUT_CHANNEL);
+  }
+  break;
+
   case MessageID::WiimoteData:
   {
     // if this is Wiimote data from the last game still being received, ignore it
     if (player.current_game != m_current_game)
       break;
 
-    sf::Packet spac;
-    spac << MessageID::WiimoteData;
-
+    std::vector<WiimoteEmu::SerializedWiimoteState> inputs;
     while (!packet.endOfPacket())
     {
       PadIndex map;
-      packet >> map;
-
-      // If the data is not from the correct player,
-      // then disconnect them.
-      if (m_wiimote_map.at(map) != player.pid)
+      u32 first_sequence;
+      if (!ReadWiimoteInputRun(packet, &map, &first_sequence, &inputs) ||
+          m_wiimote_map.at(map) != player.pid)
       {
         return 1;
       }
+    }
 
-      WiimoteEmu::SerializedWiimoteState pad;
-      packet >> pad.length;
-      if (pad.length > pad.data.size())
-        return 1;
-      for (size_t i = 0; i < pad.length; ++i)
-        packet >> pad.data[i];
+    SendToClients(packet, player.pid, INPUT_CHANNEL);
+  }
+  break;
 
-      spac << map;
-      spac << pad.length;
-      for (size_t i = 0; i < pad.length; ++i)
-        spac << pad.data[i];
-    }
+  case MessageID::PadDataResendRequest:
+  case MessageID::WiimoteDataResendRequest:
+  {
+    PadIndex map;
+    packet >> map;
+    if (map < 0 || map >= 4)
+      return 1;
 
-    SendToClients(spac, player.pid);
+    // Only the player the inputs are from still has them
+    const PlayerId owner = mid == MessageID::PadDataResendRequest ? m_pad_map[map] :
+                                                                    m_wiimote_map[map];
+    const auto it = m_players.find(owner);
+    if (it != m_players.end() && owner != player.pid)
+      Send(it->second.socket, packet);
   }
   break;
 
@@ -1082,8 +1108,47 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
         SendToClients(spac);
 
         m_desync_detected = true;
+        if (Config::Get(Config::NETPLAY_DESYNC_RECOVERY))
+          StartDesyncRecovery(pid_to_blame);
       }
       m_timebase_by_frame.erase(frame);
+
+      // Frames which some players reported while a desync was being recovered never complete
+      std::erase_if(m_timebase_by_frame,
+                    [frame](const auto& entry) { return entry.first < frame; });
+    }
+  }
+  break;
+
+  case MessageID::DesyncRecoveryState:
+  {
+    if (player.pid != 1)
+      break;
+
+    for (PlayerId pid : m_desync_recovery_pids)
+    {
+      if (m_players.find(pid) == m_players.end())
+        continue;
+
+      sf::Packet spac = packet;
+      SendChunked(std::move(spac), pid, "Desync Recovery");
+    }
+  }
+  break;
+
+  case MessageID::DesyncRecovered:
+  {
+    u32 frame;
+    packet >> frame;
+
+    if (m_desync_recovery_pids.erase(player.pid) == 0)
+      break;
+
+    INFO_LOG_FMT(NETPLAY, "Player {} recovered from the desync at frame {}", player.pid, frame);
+    if (m_desync_recovery_pids.empty())
+    {
+      m_timebase_by_frame.clear();
+      m_desync_detected = false;
     }
   }
   break;
@@ -1151,6 +1216,11 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
                        m_save_data_synced_players, m_players.size() - 1);
           m_dialog->AppendChat(Common::GetStringT("All players' saves synchronized."));
 
+          {
+            std::lock_guard lk(m_save_data_offers_mutex);
+            m_save_data_offers.clear();
+          }
+
           // Saves are synced, check if codes are as well and attempt to start the game
           m_saves_synced = true;
           CheckSyncAndStartGame();
@@ -1177,6 +1247,26 @@ unsigned int NetPlayServer::OnData(sf::Packet& packet, Client& player)
     }
     break;
 
+    case SyncSaveDataID::Request:
+    {
+      Common::SHA1::Digest digest;
+      for (u8& byte : digest)
+        packet >> byte;
+
+      std::lock_guard lk(m_save_data_offers_mutex);
+      const auto it = m_save_data_offers.find(digest);
+      if (it == m_save_data_offers.end())
+      {
+        ERROR_LOG_FMT(NETPLAY, "SyncSaveData: Player {} requested save data which isn't offered",
+                      player.pid);
+        break;
+      }
+
+      sf::Packet data_packet = it->second.packet;
+      SendChunked(std::move(data_packet), player.pid, it->second.title);
+    }
+    break;
+
     default:
       PanicAlertFmtT(
           "Unknown SYNC_SAVE_DATA message with id:{0} received from player:{1} Kicking player!",
@@ -1398,6 +1488,7 @@ bool NetPlayServer::SetupNetSettings()
 
   settings.efb_access_enable = Config::Get(Config::GFX_HACK_EFB_ACCESS_ENABLE);
   settings.bbox_enable = Config::Get(Config::GFX_HACK_BBOX_ENABLE);
+  settings.bbox_late_readback = Config::Get(Config::GFX_HACK_BBOX_LATE_READBACK);
   settings.force_progressive = Config::Get(Config::GFX_HACK_FORCE_PROGRESSIVE);
   settings.efb_to_texture_enable = Config::Get(Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM);
   settings.xfb_to_texture_enable = Config::Get(Config::GFX_HACK_SKIP_XFB_COPY_TO_RAM);
@@ -1441,6 +1532,7 @@ bool NetPlayServer::SetupNetSettings()
   settings.defer_efb_copies = Config::Get(Config::GFX_HACK_DEFER_EFB_COPIES);
   settings.efb_access_tile_size = Config::Get(Config::GFX_HACK_EFB_ACCESS_TILE_SIZE);
   settings.efb_access_defer_invalidation = Config::Get(Config::GFX_HACK_EFB_DEFER_INVALIDATION);
+  settings.efb_access_allow_stale = Config::Get(Config::GFX_HACK_EFB_ACCESS_ALLOW_STALE);
 
   settings.savedata_load = Config::Get(Config::NETPLAY_SAVEDATA_LOAD);
   settings.savedata_write = settings.savedata_load && Config::Get(Config::NETPLAY_SAVEDATA_WRITE);
@@ -1558,6 +1650,7 @@ bool NetPlayServer::StartGame()
 
   m_timebase_by_frame.clear();
   m_desync_detected = false;
+  m_desync_recovery_pids.clear();
   std::lock_guard lkg(m_crit.game);
   // only used as an identifier, not time value, so truncation is fine
   m_current_game = static_cast<u32>(Common::Timer::NowMs());
@@ -1607,6 +1700,7 @@ bool NetPlayServer::StartGame()
 
   spac << m_settings.efb_access_enable;
   spac << m_settings.bbox_enable;
+  spac << m_settings.bbox_late_readback;
   spac << m_settings.force_progressive;
   spac << m_settings.efb_to_texture_enable;
   spac << m_settings.xfb_to_texture_enable;
@@ -1648,6 +1742,7 @@ bool NetPlayServer::StartGame()
   spac << m_settings.defer_efb_copies;
   spac << m_settings.efb_access_tile_size;
   spac << m_settings.efb_access_defer_invalidation;
+  spac << m_settings.efb_access_allow_stale;
   spac << m_settings.savedata_load;
   spac << m_settings.savedata_write;
   spac << m_settings.savedata_sync_all_wii;
@@ -1798,6 +1893,11 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
 
   m_save_data_synced_players = 0;
 
+  {
+    std::lock_guard lk(m_save_data_offers_mutex);
+    m_save_data_offers.clear();
+  }
+
   {
     sf::Packet pac;
     pac << MessageID::SyncSaveData;
@@ -1848,8 +1948,8 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
         pac << sf::Uint64{0};
       }
 
-      SendChunkedToClients(std::move(pac), 1,
-                           fmt::format("Memory Card {} Synchronization", is_slot_a ? 'A' : 'B'));
+      OfferSaveData(std::move(pac),
+                    fmt::format("Memory Card {} Synchronization", is_slot_a ? 'A' : 'B'));
     }
     else if (Config::Get(Config::GetInfoForEXIDevice(slot)) ==
              ExpansionInterface::EXIDeviceType::MemoryCardFolder)
@@ -1888,8 +1988,8 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
         pac << static_cast<u8>(0);
       }
 
-      SendChunkedToClients(std::move(pac), 1,
-                           fmt::format("GCI Folder {} Synchronization", is_slot_a ? 'A' : 'B'));
+      OfferSaveData(std::move(pac),
+                    fmt::format("GCI Folder {} Synchronization", is_slot_a ? 'A' : 'B'));
     }
   }
 
@@ -1991,7 +2091,7 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
       pac << false;  // no redirected save
     }
 
-    SendChunkedToClients(std::move(pac), 1, "Wii Save Synchronization");
+    OfferSaveData(std::move(pac), "Wii Save Synchronization");
   }
 
   for (size_t i = 0; i < m_gba_config.size(); ++i)
@@ -2021,14 +2121,67 @@ bool NetPlayServer::SyncSaveData(const SaveSyncInfo& sync_info)
         pac << sf::Uint64{0};
       }
 
-      SendChunkedToClients(std::move(pac), 1,
-                           fmt::format("GBA{} Save File Synchronization", i + 1));
+      OfferSaveData(std::move(pac), fmt::format("GBA{} Save File Synchronization", i + 1));
     }
   }
 
   return true;
 }
 
+// Clients which already have this exact data from an earlier synchronization use their copy,
+// and only the others request it
+void NetPlayServer::OfferSaveData(sf::Packet&& packet, const std::string& title)
+{
+  const Common::SHA1::Digest digest = Common::SHA1::CalculateDigest(
+      static_cast<const u8*>(packet.getData()), packet.getDataSize());
+
+  {
+    std::lock_guard lk(m_save_data_offers_mutex);
+    m_save_data_offers.insert_or_assign(digest, SaveDataOffer{std::move(packet), title});
+  }
+
+  sf::Packet offer;
+  offer << MessageID::SyncSaveData;
+  offer << SyncSaveDataID::Offer;
+  for (u8 byte : digest)
+    offer << byte;
+
+  // sent on the chunked data channel to stay after the Notify message
+  SendAsyncToClients(std::move(offer), 1, CHUNKED_DATA_CHANNEL);
+}
+
+// called from ---NETPLAY--- thread
+void NetPlayServer::StartDesyncRecovery(int pid_to_blame)
+{
+  // The clients are recovered to the state of the host, so the host itself can't be the one that
+  // desynced. Recovery also relies on every client using the inputs of every GameCube controller
+  // in the same order, which isn't the case with host input authority or Wii Remotes.
+  if (pid_to_blame == 1 || m_host_input_authority ||
+      std::any_of(m_wiimote_map.begin(), m_wiimote_map.end(), [](PlayerId pid) { return pid > 0; }))
+  {
+    INFO_LOG_FMT(NETPLAY, "Not recovering from the desync of player {}", pid_to_blame);
+    return;
+  }
+
+  // If the culprit isn't known, everyone is brought back in sync with the host
+  m_desync_recovery_pids.clear();
+  for (const auto& [pid, client] : m_players)
+  {
+    if (pid != 1 && (pid_to_blame == 0 || pid == pid_to_blame))
+      m_desync_recovery_pids.insert(pid);
+  }
+
+  const auto host = m_players.find(1);
+  if (m_desync_recovery_pids.empty() || host == m_players.end())
+    return;
+
+  INFO_LOG_FMT(NETPLAY, "Recovering {} players from the desync", m_desync_recovery_pids.size());
+
+  sf::Packet spac;
+  spac << MessageID::DesyncRecoveryRequest;
+  Send(host->second.socket, spac);
+}
+
 bool NetPlayServer::SyncCodes()
 {
   INFO_LOG_FMT(NETPLAY, "Sending codes to clients.");
@@ -2203,7 +2356,7 @@ void NetPlayServer::SendToClients(const sf::Packet& packet, const PlayerId skip_
 
 void NetPlayServer::Send(ENetPeer* socket, const sf::Packet& packet, const u8 channel_id)
 {
-  Common::ENet::SendPacket(socket, packet, channel_id);
+  Common::ENet::SendPacket(socket, packet, channel_id, channel_id != INPUT_CHANNEL);
 }
 
 void NetPlayServer::KickPlayer(PlayerId player)
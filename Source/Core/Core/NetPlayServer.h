@@ -10,12 +10,14 @@
 #include <mutex>
 #include <optional>
 #include <queue>
+#include <set>
 #include <sstream>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
+#include "Common/Crypto/SHA1.h"
 #include "Common/Event.h"
 #include "Common/QoSSession.h"
 #include "Common/SPSCQueue.h"
@@ -152,9 +154,11 @@ private:
   void ChunkedDataThreadFunc();
   void ChunkedDataSend(sf::Packet&& packet, PlayerId pid, const TargetMode target_mode);
   void ChunkedDataAbort();
+  void OfferSaveData(sf::Packet&& packet, const std::string& title);
 
   void SetupIndex();
   bool PlayerHasControllerMapped(PlayerId pid) const;
+  void StartDesyncRecovery(int pid_to_blame);
 
   // pulled from OnConnect()
   void AssignNewUserAPad(const Client& player);
@@ -185,8 +189,19 @@ private:
 
   std::map<PlayerId, Client> m_players;
 
+  // The save data of the current synchronization, sent to the clients which request it
+  struct SaveDataOffer
+  {
+    sf::Packet packet;
+    std::string title;
+  };
+  std::mutex m_save_data_offers_mutex;
+  std::map<Common::SHA1::Digest, SaveDataOffer> m_save_data_offers;
+
   std::unordered_map<u32, std::vector<std::pair<PlayerId, u64>>> m_timebase_by_frame;
   bool m_desync_detected = false;
+  // The players which are loading the host's state to recover from the desync
+  std::set<PlayerId> m_desync_recovery_pids;
 
   struct
   {
@@ -3,6 +3,8 @@
 
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 
+#include <array>
+
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Core/ConfigManager.h"
@@ -23,6 +25,11 @@ struct CachedInterpreter::Instruction
   using InterpreterCallback = void (*)(Interpreter&, UGeckoInstruction);
   using CachedInterpreterCallback = void (*)(CachedInterpreter&, UGeckoInstruction);
   using ConditionalCachedInterpreterCallback = bool (*)(CachedInterpreter&, u32);
+  using FusedInterpreterCallback = void (*)(Interpreter&, UGeckoInstruction, UGeckoInstruction);
+
+  struct OperandTag
+  {
+  };
 
   Instruction() {}
   Instruction(const CommonCallback c, UGeckoInstruction i)
@@ -51,6 +58,14 @@ struct CachedInterpreter::Instruction
   {
   }
 
+  Instruction(const FusedInterpreterCallback c, UGeckoInstruction i)
+      : fused_interpreter_callback(c), data(i.hex), type(Type::FusedInterpreter)
+  {
+  }
+
+  // Holds the second instruction of a FusedInterpreter entry. Never executed on its own.
+  Instruction(OperandTag, UGeckoInstruction i) : data(i.hex), type(Type::Operand) {}
+
   enum class Type
   {
     Abort,
@@ -59,6 +74,8 @@ struct CachedInterpreter::Instruction
     Interpreter,
     CachedInterpreter,
     ConditionalCachedInterpreter,
+    FusedInterpreter,
+    Operand,
   };
 
   union
@@ -68,12 +85,65 @@ struct CachedInterpreter::Instruction
     const InterpreterCallback interpreter_callback;
     const CachedInterpreterCallback cached_interpreter_callback;
     const ConditionalCachedInterpreterCallback conditional_cached_interpreter_callback;
+    const FusedInterpreterCallback fused_interpreter_callback;
   };
 
   u32 data = 0;
   Type type = Type::Abort;
 };
 
+namespace
+{
+template <Interpreter::Instruction first, Interpreter::Instruction second>
+void RunFused(Interpreter& interpreter, UGeckoInstruction inst1, UGeckoInstruction inst2)
+{
+  first(interpreter, inst1);
+  second(interpreter, inst2);
+}
+
+struct FusedPair
+{
+  Interpreter::Instruction first;
+  Interpreter::Instruction second;
+  CachedInterpreter::Instruction::FusedInterpreterCallback fused;
+};
+
+template <Interpreter::Instruction first, Interpreter::Instruction second>
+constexpr FusedPair MakeFusedPair()
+{
+  return {first, second, RunFused<first, second>};
+}
+
+// Pairs of instructions which commonly appear back to back in games. When neither instruction of
+// a pair needs any checks emitted around it, both are run from a single entry, saving a trip
+// through the dispatch loop.
+constexpr std::array<FusedPair, 12> FUSED_PAIRS = {
+    MakeFusedPair<Interpreter::addis, Interpreter::addi>(),
+    MakeFusedPair<Interpreter::addis, Interpreter::ori>(),
+    MakeFusedPair<Interpreter::addi, Interpreter::addi>(),
+    MakeFusedPair<Interpreter::rlwinmx, Interpreter::rlwinmx>(),
+    MakeFusedPair<Interpreter::rlwinmx, Interpreter::addx>(),
+    MakeFusedPair<Interpreter::lwz, Interpreter::addi>(),
+    MakeFusedPair<Interpreter::lwz, Interpreter::lwz>(),
+    MakeFusedPair<Interpreter::lwz, Interpreter::rlwinmx>(),
+    MakeFusedPair<Interpreter::lwz, Interpreter::cmpi>(),
+    MakeFusedPair<Interpreter::addi, Interpreter::stw>(),
+    MakeFusedPair<Interpreter::stw, Interpreter::stw>(),
+    MakeFusedPair<Interpreter::orx, Interpreter::stw>(),
+};
+
+CachedInterpreter::Instruction::FusedInterpreterCallback GetFusedOp(Interpreter::Instruction first,
+                                                                    Interpreter::Instruction second)
+{
+  for (const FusedPair& pair : FUSED_PAIRS)
+  {
+    if (pair.first == first && pair.second == second)
+      return pair.fused;
+  }
+  return nullptr;
+}
+}  // namespace
+
 CachedInterpreter::CachedInterpreter(Core::System& system) : JitBase(system)
 {
 }
@@ -143,6 +213,12 @@ void CachedInterpreter::ExecuteOneBlock()
         return;
       break;
 
+    case Instruction::Type::FusedInterpreter:
+      code->fused_interpreter_callback(interpreter, UGeckoInstruction(code->data),
+                                       UGeckoInstruction(code[1].data));
+      ++code;
+      break;
+
     default:
       ERROR_LOG_FMT(POWERPC, "Unknown CachedInterpreter Instruction: {}",
                     static_cast<int>(code->type));
@@ -286,6 +362,29 @@ bool CachedInterpreter::HandleFunctionHooking(u32 address)
   return true;
 }
 
+void CachedInterpreter::EmitInterpreterOp(UGeckoInstruction inst)
+{
+  const Interpreter::Instruction func = Interpreter::GetInterpreterOp(inst);
+
+  // If nothing was emitted between the previous instruction and this one, the two can be fused.
+  // Any checks the previous instruction needed afterwards, or this one needs beforehand, would
+  // have been emitted in between.
+  if (!m_code.empty() && m_code.back().type == Instruction::Type::Interpreter)
+  {
+    Instruction& previous = m_code.back();
+    if (const auto fused = GetFusedOp(previous.interpreter_callback, func))
+    {
+      const UGeckoInstruction previous_inst(previous.data);
+      m_code.pop_back();
+      m_code.emplace_back(fused, previous_inst);
+      m_code.emplace_back(Instruction::OperandTag{}, inst);
+      return;
+    }
+  }
+
+  m_code.emplace_back(func, inst);
+}
+
 void CachedInterpreter::Jit(u32 address)
 {
   if (m_code.size() >= CODE_SIZE / sizeof(Instruction) - 0x1000 ||
@@ -337,7 +436,7 @@ void CachedInterpreter::Jit(u32 address)
           m_enable_debugging &&
           m_system.GetPowerPC().GetBreakPoints().IsAddressBreakPoint(op.address);
       const bool check_fpu = (op.opinfo->flags & FL_USE_FPU) && !js.firstFPInstructionFound;
-      const bool endblock = (op.opinfo->flags & FL_ENDBLOCK) != 0;
+      const bool endblock = (op.opinfo->flags & FL_ENDBLOCK) != 0 || op.canEndBlock;
       const bool memcheck = (op.opinfo->flags & FL_LOADSTORE) && jo.memcheck;
       const bool check_program_exception = !endblock && ShouldHandleFPExceptionForInstruction(&op);
       const bool idle_loop = op.branchIsIdleLoop;
@@ -354,7 +453,7 @@ void CachedInterpreter::Jit(u32 address)
         js.firstFPInstructionFound = true;
       }
 
-      m_code.emplace_back(Interpreter::GetInterpreterOp(op.inst), op.inst);
+      EmitInterpreterOp(op.inst);
       if (memcheck)
         m_code.emplace_back(CheckDSI, js.downcountAmount);
       if (check_program_exception)
@@ -35,13 +35,14 @@ public:
   const char* GetName() const override { return "Cached Interpreter"; }
   const CommonAsmRoutinesBase* GetAsmRoutines() override { return nullptr; }
 
-private:
   struct Instruction;
 
+private:
   u8* GetCodePtr();
   void ExecuteOneBlock();
 
   bool HandleFunctionHooking(u32 address);
+  void EmitInterpreterOp(UGeckoInstruction inst);
 
   static void EndBlock(CachedInterpreter& cached_interpreter, UGeckoInstruction data);
   static void UpdateNumLoadStoreInstructions(CachedInterpreter& cached_interpreter,
@@ -647,6 +647,7 @@ static void WriteRegister()
   else if (id >= 71 && id < 87)
   {
     ppc_state.sr[id - 71] = re32hex(bufptr);
+    system.GetMMU().SRUpdated(id - 71);
   }
   else if (id >= 88 && id < 104)
   {
@@ -677,6 +678,7 @@ static void WriteRegister()
       break;
     case 70:
       ppc_state.fpscr.Hex = re32hex(bufptr);
+      PowerPC::RecalculateAllFeatureFlags(ppc_state);
       break;
     case 87:
       ppc_state.spr[SPR_PVR] = re32hex(bufptr);
@@ -423,6 +423,7 @@ enum FPSCRExceptionFlag : u32
   FPSCR_UE = 1U << (31 - 26),
   FPSCR_ZE = 1U << (31 - 27),
   FPSCR_XE = 1U << (31 - 28),
+  FPSCR_NI = 1U << (31 - 29),
 
   FPSCR_VX_ANY = FPSCR_VXSNAN | FPSCR_VXISI | FPSCR_VXIDI | FPSCR_VXZDZ | FPSCR_VXIMZ | FPSCR_VXVC |
                  FPSCR_VXSOFT | FPSCR_VXSQRT | FPSCR_VXCVI,
@@ -931,6 +932,7 @@ enum CPUEmuFeatureFlags : u32
   FEATURE_FLAG_MSR_DR = 1 << 0,
   FEATURE_FLAG_MSR_IR = 1 << 1,
   FEATURE_FLAG_PERFMON = 1 << 2,
+  FEATURE_FLAG_FPSCR_NI = 1 << 3,
   FEATURE_FLAG_END_OF_ENUMERATION,
 };
 
@@ -3,6 +3,7 @@
 
 #include "Core/PowerPC/Interpreter/Interpreter.h"
 
+#include <algorithm>
 #include <array>
 #include <string>
 
@@ -67,7 +68,7 @@ void Interpreter::UpdatePC()
 Interpreter::Interpreter(Core::System& system, PowerPC::PowerPCState& ppc_state, PowerPC::MMU& mmu,
                          Core::BranchWatch& branch_watch, PPCSymbolDB& ppc_symbol_db)
     : m_system(system), m_ppc_state(ppc_state), m_mmu(mmu), m_branch_watch(branch_watch),
-      m_ppc_symbol_db(ppc_symbol_db)
+      m_ppc_symbol_db(ppc_symbol_db), m_decode_cache(DECODE_CACHE_SIZE)
 {
 }
 
@@ -106,6 +107,23 @@ void Interpreter::Trace(const UGeckoInstruction& inst)
                 ppc_inst);
 }
 
+const Interpreter::DecodedInstruction& Interpreter::Decode(UGeckoInstruction inst, u32 address)
+{
+  DecodedInstruction& entry = m_decode_cache[(address >> 2) & (DECODE_CACHE_SIZE - 1)];
+  if (entry.hex == inst.hex && entry.func != nullptr)
+    return entry;
+
+  entry.hex = inst.hex;
+  entry.func = GetInterpreterOp(inst);
+  entry.opinfo = PPCTables::GetOpInfo(inst, address);
+
+  // Don't cache invalid instructions, so that they get reported every time they are executed.
+  if (entry.func == unknown_instruction)
+    entry.func = nullptr;
+
+  return entry;
+}
+
 bool Interpreter::HandleFunctionHooking(u32 address)
 {
   const auto result =
@@ -122,6 +140,7 @@ int Interpreter::SingleStepInner()
 {
   if (HandleFunctionHooking(m_ppc_state.pc))
   {
+    m_idle_loop_pure = false;
     UpdatePC();
     // TODO: Does it make sense to use m_prev_inst here?
     // It seems like we should use the num_cycles for the instruction at PC instead
@@ -132,7 +151,9 @@ int Interpreter::SingleStepInner()
   m_ppc_state.npc = m_ppc_state.pc + sizeof(UGeckoInstruction);
   m_prev_inst.hex = m_mmu.Read_Opcode(m_ppc_state.pc);
 
-  const GekkoOPInfo* opinfo = PPCTables::GetOpInfo(m_prev_inst, m_ppc_state.pc);
+  const DecodedInstruction& decoded = Decode(m_prev_inst, m_ppc_state.pc);
+  const GekkoOPInfo* opinfo = decoded.opinfo;
+  const Instruction func = decoded.func ? decoded.func : unknown_instruction;
 
   // Uncomment to trace the interpreter
   // if ((m_ppc_state.pc & 0x00FFFFFF) >= 0x000AB54C &&
@@ -159,7 +180,7 @@ int Interpreter::SingleStepInner()
     }
     else if (m_ppc_state.msr.FP)
     {
-      RunInterpreterOp(*this, m_prev_inst);
+      func(*this, m_prev_inst);
       if ((m_ppc_state.Exceptions & EXCEPTION_DSI) != 0)
       {
         CheckExceptions();
@@ -175,7 +196,7 @@ int Interpreter::SingleStepInner()
       }
       else
       {
-        RunInterpreterOp(*this, m_prev_inst);
+        func(*this, m_prev_inst);
         if ((m_ppc_state.Exceptions & EXCEPTION_DSI) != 0)
         {
           CheckExceptions();
@@ -191,6 +212,18 @@ int Interpreter::SingleStepInner()
 
   UpdatePC();
 
+  switch (opinfo->type)
+  {
+  case OpType::Integer:
+  case OpType::CR:
+  case OpType::Load:
+  case OpType::Branch:
+    break;
+  default:
+    m_idle_loop_pure = false;
+    break;
+  }
+
   PowerPC::UpdatePerformanceMonitor(opinfo->num_cycles, (opinfo->flags & FL_LOADSTORE) != 0,
                                     (opinfo->flags & FL_USE_FPU) != 0, m_ppc_state);
   return opinfo->num_cycles;
@@ -217,6 +250,51 @@ void Interpreter::SingleStep()
   }
 }
 
+Interpreter::IdleLoopState Interpreter::GetIdleLoopState() const
+{
+  IdleLoopState state;
+  std::ranges::copy(m_ppc_state.gpr, state.gpr.begin());
+  std::ranges::copy(m_ppc_state.cr.fields, state.cr.begin());
+  state.lr = LR(m_ppc_state);
+  state.ctr = CTR(m_ppc_state);
+  state.xer_ca = m_ppc_state.xer_ca;
+  state.xer_so_ov = m_ppc_state.xer_so_ov;
+  return state;
+}
+
+void Interpreter::CheckForIdleLoop(u32 block_start)
+{
+  const u32 next_pc = m_ppc_state.pc;
+  if (next_pc == m_idle_loop_start)
+  {
+    if (m_idle_loop_pure && m_ppc_state.downcount > 0 && GetIdleLoopState() == m_idle_loop_state)
+    {
+      m_system.GetCoreTiming().Idle();
+      return;
+    }
+  }
+  else if (next_pc > block_start || block_start - next_pc > MAX_IDLE_LOOP_SIZE)
+  {
+    // Only short backwards branches start a new candidate.
+    return;
+  }
+
+  m_idle_loop_start = next_pc;
+  m_idle_loop_pure = true;
+  m_idle_loop_state = GetIdleLoopState();
+}
+
+int Interpreter::RunBasicBlock()
+{
+  m_end_block = false;
+
+  int cycles = 0;
+  while (!m_end_block)
+    cycles += SingleStepInner();
+
+  return cycles;
+}
+
 //#define SHOW_HISTORY
 #ifdef SHOW_HISTORY
 static std::vector<u32> s_pc_vec;
@@ -304,6 +382,7 @@ void Interpreter::Run()
       while (m_ppc_state.downcount > 0)
       {
         m_end_block = false;
+        const u32 block_start = m_ppc_state.pc;
 
         int cycles = 0;
         while (!m_end_block)
@@ -311,6 +390,8 @@ void Interpreter::Run()
           cycles += SingleStepInner();
         }
         m_ppc_state.downcount -= cycles;
+
+        CheckForIdleLoop(block_start);
       }
     }
   }
@@ -349,7 +430,7 @@ void Interpreter::unknown_instruction(Interpreter& interpreter, UGeckoInstructio
 
 void Interpreter::ClearCache()
 {
-  // Do nothing.
+  m_decode_cache.assign(DECODE_CACHE_SIZE, {});
 }
 
 void Interpreter::CheckExceptions()
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Core/PowerPC/CPUCoreBase.h"
@@ -20,6 +21,7 @@ class MMU;
 struct PowerPCState;
 }  // namespace PowerPC
 class PPCSymbolDB;
+struct GekkoOPInfo;
 
 class Interpreter : public CPUCoreBase
 {
@@ -36,6 +38,8 @@ public:
   void Shutdown() override;
   void SingleStep() override;
   int SingleStepInner();
+  // Runs until the end of the current basic block and returns the number of cycles spent.
+  int RunBasicBlock();
 
   void Run() override;
   void ClearCache() override;
@@ -295,6 +299,37 @@ public:
   static u32 Helper_Carry(u32 value1, u32 value2);
 
 private:
+  // Instructions are looked up in this direct-mapped cache by address before being decoded. An
+  // entry is only used if the fetched instruction still matches it, so it doesn't need to be
+  // invalidated when guest code is modified.
+  struct DecodedInstruction
+  {
+    u32 hex = 0;
+    Instruction func = nullptr;
+    const GekkoOPInfo* opinfo = nullptr;
+  };
+  static constexpr u32 DECODE_CACHE_SIZE = 0x4000;
+
+  const DecodedInstruction& Decode(UGeckoInstruction inst, u32 address);
+
+  // A snapshot of the registers an idle loop candidate may depend on.
+  struct IdleLoopState
+  {
+    std::array<u32, 32> gpr;
+    std::array<u64, 8> cr;
+    u32 lr;
+    u32 ctr;
+    u8 xer_ca;
+    u8 xer_so_ov;
+
+    bool operator==(const IdleLoopState&) const = default;
+  };
+  static constexpr u32 NO_IDLE_LOOP = 0xFFFFFFFF;
+  static constexpr u32 MAX_IDLE_LOOP_SIZE = 0x100;
+
+  IdleLoopState GetIdleLoopState() const;
+  void CheckForIdleLoop(u32 block_start);
+
   void CheckExceptions();
 
   bool HandleFunctionHooking(u32 address);
@@ -320,6 +355,18 @@ private:
   Core::BranchWatch& m_branch_watch;
   PPCSymbolDB& m_ppc_symbol_db;
 
+  std::vector<DecodedInstruction> m_decode_cache;
+
+  // Detects loops that keep polling memory without changing any state: if an iteration of the
+  // loop starting at m_idle_loop_start ran only instructions whose results depend on nothing but
+  // registers and loaded memory, and it left those registers exactly as it found them, every
+  // following iteration will do the same until a CoreTiming event changes memory. Unlike
+  // PPCAnalyzer::IsBusyWaitLoop, this also catches loops spanning several blocks, such as ones
+  // calling a leaf function to poll a hardware register.
+  u32 m_idle_loop_start = NO_IDLE_LOOP;
+  bool m_idle_loop_pure = false;
+  IdleLoopState m_idle_loop_state{};
+
   UGeckoInstruction m_prev_inst{};
   u32 m_last_pc = 0;
   bool m_end_block = false;
@@ -16,13 +16,16 @@
 #endif
 
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
 #include "Common/EnumUtils.h"
 #include "Common/GekkoDisassembler.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
+#include "Common/Tracing.h"
 #include "Common/x64ABI.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HLE/HLE.h"
@@ -45,6 +48,8 @@
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
 
+#include "VideoCommon/PerformanceMetrics.h"
+
 using namespace Gen;
 using namespace PowerPC;
 
@@ -151,6 +156,11 @@ bool Jit64::HandleFault(uintptr_t access_address, SContext* ctx)
                    "PC {:#018x}, access address {:#018x}, memory base {:#018x}, MSR.DR {}",
                    ctx->CTX_PC, access_address, memory_base, ppc_state.msr.DR);
     }
+    else if (ppc_state.msr.DR &&
+             m_mmu.HandleFastmemPageFault(static_cast<u32>(access_address - memory_base)))
+    {
+      return true;
+    }
 
     return BackPatch(ctx);
   }
@@ -268,7 +278,8 @@ void Jit64::Init()
   const size_t trampolines_size = jo.memcheck ? TRAMPOLINE_CODE_SIZE_MMU : TRAMPOLINE_CODE_SIZE;
   const size_t farcode_size = jo.memcheck ? FARCODE_SIZE_MMU : FARCODE_SIZE;
   const size_t constpool_size = m_const_pool.CONST_POOL_SIZE;
-  AllocCodeSpace(CODE_SIZE + routines_size + trampolines_size + farcode_size + constpool_size);
+  AllocCodeSpace(CODE_SIZE + routines_size + trampolines_size + farcode_size + constpool_size,
+                 Config::Get(Config::MAIN_HUGE_PAGES));
   AddChildCodeSpace(&asm_routines, routines_size);
   AddChildCodeSpace(&trampolines, trampolines_size);
   AddChildCodeSpace(&m_far_code, farcode_size);
@@ -609,6 +620,34 @@ void Jit64::WriteExitDestInRSCRATCH(bool bl, u32 after)
   }
 }
 
+void Jit64::WriteIndirectBranchExit(u32 origin, bool bl, u32 after)
+{
+  IndirectBranchTargets* targets = GetIndirectBranchTargets(origin);
+  if (targets && js.firstTier)
+  {
+    // First tier blocks only run a limited number of times, so the call is cheap enough.
+    ABI_PushRegistersAndAdjustStack(BitSet32{RSCRATCH}, 0);
+    MOV(32, R(ABI_PARAM2), R(RSCRATCH));
+    MOV(64, R(ABI_PARAM1), ImmPtr(targets));
+    ABI_CallFunction(&IndirectBranchTargets::Record);
+    ABI_PopRegistersAndAdjustStack(BitSet32{RSCRATCH}, 0);
+  }
+  else if (targets)
+  {
+    for (u32 i = 0; i < targets->count; ++i)
+    {
+      CMP(32, R(RSCRATCH), Imm32(targets->destinations[i]));
+      FixupBranch miss = J_CC(CC_NE, Jump::Near);
+      WriteExit(targets->destinations[i], bl, after);
+      SetJumpTarget(miss);
+    }
+  }
+
+  MOV(64, R(RSCRATCH2), ImmPtr(&s_indirect_branch_dispatches));
+  ADD(64, MatR(RSCRATCH2), Imm8(1));
+  WriteExitDestInRSCRATCH(bl, after);
+}
+
 void Jit64::WriteBLRExit()
 {
   if (!m_enable_blr_optimization)
@@ -731,13 +770,23 @@ void Jit64::Trace()
 
 void Jit64::Jit(u32 em_address)
 {
-  Jit(em_address, true);
+  Jit(em_address, OutOfCodeSpace::EvictOldBlocksAndRetry);
 }
 
-void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
+void Jit64::Jit(u32 em_address, OutOfCodeSpace on_out_of_code_space)
 {
   CleanUpAfterStackFault();
 
+  if (on_out_of_code_space == OutOfCodeSpace::EvictOldBlocksAndRetry &&
+      InterpretColdBlock(em_address))
+  {
+    return;
+  }
+
+  Common::Tracing::ScopedEvent trace_event("jit", "Compile block");
+  PerformanceMetrics::ScopedFrameSection frame_section(
+      PerformanceMetrics::FrameSection::JitCompile);
+
   if (trampolines.IsAlmostFull() || SConfig::GetInstance().bJITNoBlockCache)
   {
     if (!SConfig::GetInstance().bJITNoBlockCache)
@@ -781,11 +830,30 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     }
   }
 
+  js.firstTier = ShouldCompileFirstTier(em_address);
+  if (js.firstTier)
+  {
+    block_size = std::min(block_size, FIRST_TIER_BLOCK_SIZE);
+    analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_MERGE);
+    analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE);
+    analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
+    analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+  }
+
+  // Form superblocks out of blocks that are known to be hot: following more direct branches keeps
+  // guest registers in host registers across what would otherwise be linked block exits.
+  analyzer.SetBranchFollowingThreshold(js.hotBlockAddresses.contains(em_address) ?
+                                           SUPERBLOCK_BRANCH_FOLLOWING_THRESHOLD :
+                                           PPCAnalyst::PPCAnalyzer::DEFAULT_BRANCH_FOLLOWING_THRESHOLD);
+
   // Analyze the block, collect all instructions it is made of (including inlining,
   // if that is enabled), reorder instructions for optimal performance, and join joinable
   // instructions.
   const u32 nextPC = analyzer.Analyze(em_address, &code_block, &m_code_buffer, block_size);
 
+  if (js.firstTier)
+    EnableOptimization();
+
   if (code_block.m_memory_exception)
   {
     // Address of instruction could not be translated
@@ -797,6 +865,8 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     return;
   }
 
+  blocks.ProcessBlockForDiskCache(code_block, m_code_buffer);
+
   if (SetEmitterStateToFreeCodeRegion())
   {
     u8* near_start = GetWritableCodePtr();
@@ -825,16 +895,30 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
       blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
       return;
     }
+
+    blocks.DiscardBlock(*b);
   }
 
-  if (clear_cache_and_retry_on_failure)
+  // Code generation failed due to not enough free space in either the near or far code regions.
+  switch (on_out_of_code_space)
   {
-    // Code generation failed due to not enough free space in either the near or far code regions.
-    // Clear the entire JIT cache and retry.
+  case OutOfCodeSpace::EvictOldBlocksAndRetry:
+    // Evicting the older half of the blocks usually makes enough room, without the stutter of
+    // recompiling all the code that is currently running.
+    if (const size_t evicted = blocks.EvictOldBlocks(); evicted != 0)
+    {
+      INFO_LOG_FMT(DYNA_REC, "Evicted {} old blocks from the code caches", evicted);
+      Jit(em_address, OutOfCodeSpace::ClearCacheAndRetry);
+      return;
+    }
+    [[fallthrough]];
+  case OutOfCodeSpace::ClearCacheAndRetry:
     WARN_LOG_FMT(DYNA_REC, "flushing code caches, please report if this happens a lot");
     ClearCache();
-    Jit(em_address, false);
+    Jit(em_address, OutOfCodeSpace::Fail);
     return;
+  case OutOfCodeSpace::Fail:
+    break;
   }
 
   PanicAlertFmtT("JIT failed to find code space after a cache clear. This should never happen. "
@@ -891,6 +975,25 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   if (IsProfilingEnabled())
     ABI_CallFunctionP(&JitBlock::ProfileData::BeginProfiling, b->profile_data.get());
 
+  // Count the runs of first tier blocks, and have them recompiled once they are hot.
+  if (js.firstTier)
+  {
+    b->tier_up_countdown = TIER_UP_RUN_COUNT;
+    MOV(64, R(RSCRATCH), ImmPtr(&b->tier_up_countdown));
+    SUB(32, MatR(RSCRATCH), Imm8(1));
+    FixupBranch hot = J_CC(CC_Z, Jump::Near);
+
+    SwitchToFarCode();
+    SetJumpTarget(hot);
+    MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
+    ABI_PushRegistersAndAdjustStack({}, 0);
+    ABI_CallFunctionPC(JitInterface::CompileExceptionCheckFromJIT, &m_system.GetJitInterface(),
+                       static_cast<u32>(JitInterface::ExceptionType::HotBlock));
+    ABI_PopRegistersAndAdjustStack({}, 0);
+    JMP(asm_routines.dispatcher_no_check, Jump::Near);
+    SwitchToNearCode();
+  }
+
 #if defined(_DEBUG) || defined(DEBUGFAST) || defined(NAN_CHECK)
   // should help logged stack-traces become more accurate
   MOV(32, PPCSTATE(pc), Imm32(js.blockStart));
@@ -945,10 +1048,16 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   }
 
   // Translate instructions
+  const bool record_line_info = Common::JitRegister::IsLineInfoEnabled();
+  js.lineInfo.clear();
+
   for (u32 i = 0; i < code_block.m_num_instructions; i++)
   {
     PPCAnalyst::CodeOp& op = m_code_buffer[i];
 
+    if (record_line_info)
+      js.lineInfo.push_back({GetCodePtr(), op.address});
+
     js.compilerPC = op.address;
     js.op = &op;
     js.fpr_is_store_safe = op.fprIsStoreSafeBeforeInst;
@@ -1060,6 +1169,17 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
         SetJumpTarget(noBreakpoint);
       }
 
+      if (m_trace_recorder.IsRecording())
+      {
+        gpr.Flush();
+        fpr.Flush();
+
+        ABI_PushRegistersAndAdjustStack({}, 0);
+        ABI_CallFunctionPP(&Core::TraceRecorder::Record, &m_trace_recorder,
+                           m_trace_recorder.GetInstructionInfo(op));
+        ABI_PopRegistersAndAdjustStack({}, 0);
+      }
+
       if ((opinfo->flags & FL_USE_FPU) && !js.firstFPInstructionFound)
       {
         // This instruction uses FPU - needs to add FP exception bailout
@@ -1203,11 +1323,6 @@ bool Jit64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   return true;
 }
 
-BitSet8 Jit64::ComputeStaticGQRs(const PPCAnalyst::CodeBlock& cb) const
-{
-  return cb.m_gqr_used & ~cb.m_gqr_modified;
-}
-
 BitSet32 Jit64::CallerSavedRegistersInUse() const
 {
   BitSet32 in_use = gpr.RegistersInUse() | (fpr.RegistersInUse() << 16);
@@ -62,7 +62,7 @@ public:
   // Jit!
 
   void Jit(u32 em_address) override;
-  void Jit(u32 em_address, bool clear_cache_and_retry_on_failure);
+  void Jit(u32 em_address, OutOfCodeSpace on_out_of_code_space);
   bool DoJit(u32 em_address, JitBlock* b, u32 nextPC);
 
   // Finds a free memory region and sets the near and far code emitters to point at that region.
@@ -70,7 +70,6 @@ public:
   bool SetEmitterStateToFreeCodeRegion();
 
   BitSet32 CallerSavedRegistersInUse() const;
-  BitSet8 ComputeStaticGQRs(const PPCAnalyst::CodeBlock&) const;
 
   void IntializeSpeculativeConstants();
 
@@ -93,6 +92,9 @@ public:
   void WriteExit(u32 destination, bool bl = false, u32 after = 0);
   void JustWriteExit(u32 destination, bool bl, u32 after);
   void WriteExitDestInRSCRATCH(bool bl = false, u32 after = 0);
+  // Exits to the destination of the indirect branch at origin in RSCRATCH. Destinations that were
+  // seen before are checked first and jump straight to their blocks.
+  void WriteIndirectBranchExit(u32 origin, bool bl, u32 after);
   void WriteBLRExit();
   void WriteExceptionExit();
   void WriteExternalExceptionExit();
@@ -151,6 +153,7 @@ public:
                 bool Rc = false, bool carry = false);
   void FloatCompare(UGeckoInstruction inst, bool upper = false);
   void UpdateMXCSR();
+  void WriteNonIEEEModeExit(bool may_have_changed);
 
   // OPCODES
   using Instruction = void (Jit64::*)(UGeckoInstruction instCode);
@@ -262,6 +265,9 @@ public:
   void eieio(UGeckoInstruction inst);
 
 private:
+  // How many direct branches superblocks formed from hot blocks follow at most.
+  static constexpr u32 SUPERBLOCK_BRANCH_FOLLOWING_THRESHOLD = 8;
+
   void CompileInstruction(PPCAnalyst::CodeOp& op);
 
   bool HandleFunctionHooking(u32 address);
@@ -303,7 +303,7 @@ void Jit64::bcctrx(UGeckoInstruction inst)
       WriteBranchWatchDestInRSCRATCH(js.compilerPC, inst, ABI_PARAM1, RSCRATCH2,
                                      BitSet32{RSCRATCH});
     }
-    WriteExitDestInRSCRATCH(inst.LK_3, js.compilerPC + 4);
+    WriteIndirectBranchExit(js.compilerPC, inst.LK_3, js.compilerPC + 4);
   }
   else
   {
@@ -331,7 +331,7 @@ void Jit64::bcctrx(UGeckoInstruction inst)
         WriteBranchWatchDestInRSCRATCH(js.compilerPC, inst, ABI_PARAM1, RSCRATCH2,
                                        BitSet32{RSCRATCH});
       }
-      WriteExitDestInRSCRATCH(inst.LK_3, js.compilerPC + 4);
+      WriteIndirectBranchExit(js.compilerPC, inst.LK_3, js.compilerPC + 4);
       // Would really like to continue the block here, but it ends. TODO.
     }
     SetJumpTarget(b);
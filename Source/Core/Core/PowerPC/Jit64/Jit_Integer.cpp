@@ -427,7 +427,7 @@ void Jit64::DoMergedBranch()
       // ABI_PARAM1 is safe to use after a GPR flush for an optimization in this function.
       WriteBranchWatchDestInRSCRATCH(nextPC, next, ABI_PARAM1, RSCRATCH2, BitSet32{RSCRATCH});
     }
-    WriteExitDestInRSCRATCH(next.LK, nextPC + 4);
+    WriteIndirectBranchExit(nextPC, next.LK, nextPC + 4);
   }
   else if ((next.OPCD == 19) && (next.SUBOP10 == 16))  // bclrx
   {
@@ -746,6 +746,33 @@ void Jit64::UpdateMXCSR()
   LDMXCSR(MComplex(RSCRATCH2, RSCRATCH, SCALE_4, 0));
 }
 
+// Ends the block after a write to FPSCR.NI. Blocks are compiled for one value of NI (see
+// FEATURE_FLAG_FPSCR_NI), so if NI may have changed, feature_flags is updated and the next block
+// has to be looked up by the dispatcher.
+void Jit64::WriteNonIEEEModeExit(bool may_have_changed)
+{
+  gpr.Flush();
+  fpr.Flush();
+
+  if (!may_have_changed)
+  {
+    WriteExit(js.compilerPC + 4);
+    return;
+  }
+
+  static_assert(FEATURE_FLAG_FPSCR_NI == FPSCR_NI << 1);
+  const u32 other_feature_flags = m_ppc_state.feature_flags & ~FEATURE_FLAG_FPSCR_NI;
+  MOV(32, R(RSCRATCH), PPCSTATE(fpscr));
+  AND(32, R(RSCRATCH), Imm32(FPSCR_NI));
+  SHL(32, R(RSCRATCH), Imm8(1));
+  if (other_feature_flags != 0)
+    OR(32, R(RSCRATCH), Imm32(other_feature_flags));
+  MOV(32, PPCSTATE(feature_flags), R(RSCRATCH));
+
+  MOV(32, R(RSCRATCH), Imm32(js.compilerPC + 4));
+  WriteExitDestInRSCRATCH();
+}
+
 void Jit64::mtfsb0x(UGeckoInstruction inst)
 {
   INSTRUCTION_START
@@ -779,6 +806,9 @@ void Jit64::mtfsb0x(UGeckoInstruction inst)
     if (inst.CRBD >= 29)
       UpdateMXCSR();
   }
+
+  if (js.op->canEndBlock)
+    WriteNonIEEEModeExit((m_ppc_state.feature_flags & FEATURE_FLAG_FPSCR_NI) != 0);
 }
 
 void Jit64::mtfsb1x(UGeckoInstruction inst)
@@ -817,6 +847,9 @@ void Jit64::mtfsb1x(UGeckoInstruction inst)
   MOV(32, PPCSTATE(fpscr), R(RSCRATCH));
   if (inst.CRBD >= 29)
     UpdateMXCSR();
+
+  if (js.op->canEndBlock)
+    WriteNonIEEEModeExit((m_ppc_state.feature_flags & FEATURE_FLAG_FPSCR_NI) == 0);
 }
 
 void Jit64::mtfsfix(UGeckoInstruction inst)
@@ -848,6 +881,12 @@ void Jit64::mtfsfix(UGeckoInstruction inst)
   // Field 7 contains NI and RN.
   if (inst.CRFD == 7)
     LDMXCSR(MConst(s_fpscr_to_mxcsr, imm & 7));
+
+  if (js.op->canEndBlock)
+  {
+    const bool ni = (imm & FPSCR_NI) != 0;
+    WriteNonIEEEModeExit(ni != ((m_ppc_state.feature_flags & FEATURE_FLAG_FPSCR_NI) != 0));
+  }
 }
 
 void Jit64::mtfsfx(UGeckoInstruction inst)
@@ -894,4 +933,7 @@ void Jit64::mtfsfx(UGeckoInstruction inst)
 
   if (inst.FM & 1)
     UpdateMXCSR();
+
+  if (js.op->canEndBlock)
+    WriteNonIEEEModeExit(true);
 }
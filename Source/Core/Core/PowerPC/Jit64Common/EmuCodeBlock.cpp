@@ -225,6 +225,18 @@ public:
   {
     CallLambda(8 * sizeof(T), lambda);
   }
+  void VisitConditionalDirect(const T* addr, u32 mask, const bool* use_direct,
+                              const std::function<T(Core::System&, u32)>* lambda) override
+  {
+    m_code->MOV(64, R(RSCRATCH), ImmPtr(use_direct));
+    m_code->CMP(8, MatR(RSCRATCH), Imm8(0));
+    FixupBranch slow = m_code->J_CC(CC_Z, XEmitter::Jump::Near);
+    LoadAddrMaskToReg(8 * sizeof(T), addr, mask);
+    FixupBranch done = m_code->J(XEmitter::Jump::Near);
+    m_code->SetJumpTarget(slow);
+    CallLambda(8 * sizeof(T), lambda);
+    m_code->SetJumpTarget(done);
+  }
 
 private:
   // Generates code to load a constant to the destination register. In
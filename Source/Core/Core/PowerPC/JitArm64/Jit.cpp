@@ -5,15 +5,20 @@
 
 #include <cstdio>
 #include <optional>
+#include <vector>
 
 #include "Common/Arm64Emitter.h"
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
 #include "Common/EnumUtils.h"
 #include "Common/Logging/Log.h"
 #include "Common/MathUtil.h"
+#include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
+#include "Common/Tracing.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -29,6 +34,8 @@
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
 
+#include "VideoCommon/PerformanceMetrics.h"
+
 using namespace Arm64Gen;
 
 constexpr size_t NEAR_CODE_SIZE = 1024 * 1024 * 64;
@@ -55,7 +62,7 @@ void JitArm64::Init()
   // m_far_code_0, m_near_code_0, m_near_code_1, m_far_code_1.
   // AddChildCodeSpace grabs space from the end of the parent region,
   // so we have to call AddChildCodeSpace in reverse order.
-  AllocCodeSpace(TOTAL_CODE_SIZE);
+  AllocCodeSpace(TOTAL_CODE_SIZE, Config::Get(Config::MAIN_HUGE_PAGES));
   AddChildCodeSpace(&m_far_code_1, FAR_CODE_SIZE);
   AddChildCodeSpace(&m_near_code_1, NEAR_CODE_SIZE);
   AddChildCodeSpace(&m_near_code_0, NEAR_CODE_SIZE);
@@ -140,6 +147,11 @@ bool JitArm64::HandleFault(uintptr_t access_address, SContext* ctx)
                       fmt::ptr(m_ppc_state.mem_ptr), fmt::ptr(memory.GetPhysicalBase()),
                       fmt::ptr(memory.GetLogicalBase()));
       }
+      else if (m_ppc_state.msr.DR &&
+               m_mmu.HandleFastmemPageFault(static_cast<u32>(access_address - memory_base)))
+      {
+        success = true;
+      }
       else
       {
         success = HandleFastmemFault(ctx);
@@ -157,6 +169,7 @@ bool JitArm64::HandleFault(uintptr_t access_address, SContext* ctx)
 
 void JitArm64::ClearCache()
 {
+  const Common::ScopedJITPageWriteBatch jit_page_write_batch;
   m_fault_to_handler.clear();
 
   blocks.Clear();
@@ -615,6 +628,45 @@ void JitArm64::WriteExit(Arm64Gen::ARM64Reg dest, bool LK, u32 exit_address_afte
   }
 }
 
+void JitArm64::WriteIndirectBranchExit(u32 origin, ARM64Reg dest, bool LK,
+                                       u32 exit_address_after_return,
+                                       ARM64Reg exit_address_after_return_reg,
+                                       BitSet32 gpr_caller_save)
+{
+  const ARM64Reg WA = gpr.GetReg();
+  const ARM64Reg WB = gpr.GetReg();
+  const ARM64Reg XA = EncodeRegTo64(WA);
+  const ARM64Reg XB = EncodeRegTo64(WB);
+
+  IndirectBranchTargets* targets = GetIndirectBranchTargets(origin);
+  if (targets && js.firstTier)
+  {
+    // First tier blocks only run a limited number of times, so the call is cheap enough.
+    ABI_PushRegisters(gpr_caller_save);
+    ABI_CallFunction(&IndirectBranchTargets::Record, targets, dest);
+    ABI_PopRegisters(gpr_caller_save);
+  }
+  else if (targets)
+  {
+    for (u32 i = 0; i < targets->count; ++i)
+    {
+      CMPI2R(dest, targets->destinations[i], WA);
+      FixupBranch miss = B(CC_NEQ);
+      WriteExit(targets->destinations[i], LK, exit_address_after_return,
+                exit_address_after_return_reg);
+      SetJumpTarget(miss);
+    }
+  }
+
+  MOVP2R(XA, &s_indirect_branch_dispatches);
+  LDR(IndexType::Unsigned, XB, XA, 0);
+  ADD(XB, XB, 1);
+  STR(IndexType::Unsigned, XB, XA, 0);
+  gpr.Unlock(WA, WB);
+
+  WriteExit(dest, LK, exit_address_after_return, exit_address_after_return_reg);
+}
+
 void JitArm64::FakeLKExit(u32 exit_address_after_return, ARM64Reg exit_address_after_return_reg)
 {
   if (!m_enable_blr_optimization)
@@ -902,13 +954,26 @@ void JitArm64::Trace()
 
 void JitArm64::Jit(u32 em_address)
 {
-  Jit(em_address, true);
+  // A dispatcher miss can clear the cache, evict blocks, compile and link. None of it runs JIT
+  // code, so the code space only has to be made writable once.
+  const Common::ScopedJITPageWriteBatch jit_page_write_batch;
+  Jit(em_address, OutOfCodeSpace::EvictOldBlocksAndRetry);
 }
 
-void JitArm64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
+void JitArm64::Jit(u32 em_address, OutOfCodeSpace on_out_of_code_space)
 {
   CleanUpAfterStackFault();
 
+  if (on_out_of_code_space == OutOfCodeSpace::EvictOldBlocksAndRetry &&
+      InterpretColdBlock(em_address))
+  {
+    return;
+  }
+
+  Common::Tracing::ScopedEvent trace_event("jit", "Compile block");
+  PerformanceMetrics::ScopedFrameSection frame_section(
+      PerformanceMetrics::FrameSection::JitCompile);
+
   if (SConfig::GetInstance().bJITNoBlockCache)
     ClearCache();
 
@@ -963,11 +1028,21 @@ void JitArm64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     }
   }
 
+  js.firstTier = ShouldCompileFirstTier(em_address);
+  if (js.firstTier)
+  {
+    block_size = std::min(block_size, FIRST_TIER_BLOCK_SIZE);
+    SetOptimizationEnabled(false);
+  }
+
   // Analyze the block, collect all instructions it is made of (including inlining,
   // if that is enabled), reorder instructions for optimal performance, and join joinable
   // instructions.
   const u32 nextPC = analyzer.Analyze(em_address, &code_block, &m_code_buffer, block_size);
 
+  if (js.firstTier)
+    SetOptimizationEnabled(true);
+
   if (code_block.m_memory_exception)
   {
     // Address of instruction could not be translated
@@ -979,6 +1054,8 @@ void JitArm64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     return;
   }
 
+  blocks.ProcessBlockForDiskCache(code_block, m_code_buffer);
+
   if (std::optional<size_t> code_region_index = SetEmitterStateToFreeCodeRegion())
   {
     u8* near_start = GetWritableCodePtr();
@@ -1013,16 +1090,30 @@ void JitArm64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
       blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
       return;
     }
+
+    blocks.DiscardBlock(*b);
   }
 
-  if (clear_cache_and_retry_on_failure)
+  // Code generation failed due to not enough free space in either the near or far code regions.
+  switch (on_out_of_code_space)
   {
-    // Code generation failed due to not enough free space in either the near or far code regions.
-    // Clear the entire JIT cache and retry.
+  case OutOfCodeSpace::EvictOldBlocksAndRetry:
+    // Evicting the older half of the blocks usually makes enough room, without the stutter of
+    // recompiling all the code that is currently running.
+    if (const size_t evicted = blocks.EvictOldBlocks(); evicted != 0)
+    {
+      INFO_LOG_FMT(DYNA_REC, "Evicted {} old blocks from the code caches", evicted);
+      Jit(em_address, OutOfCodeSpace::ClearCacheAndRetry);
+      return;
+    }
+    [[fallthrough]];
+  case OutOfCodeSpace::ClearCacheAndRetry:
     WARN_LOG_FMT(DYNA_REC, "flushing code caches, please report if this happens a lot");
     ClearCache();
-    Jit(em_address, false);
+    Jit(em_address, OutOfCodeSpace::Fail);
     return;
+  case OutOfCodeSpace::Fail:
+    break;
   }
 
   PanicAlertFmtT("JIT failed to find code space after a cache clear. This should never happen. "
@@ -1084,7 +1175,6 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
 
   js.isLastInstruction = false;
   js.firstFPInstructionFound = false;
-  js.assumeNoPairedQuantize = false;
   js.blockStart = em_address;
   js.fifoBytesSinceCheck = 0;
   js.mustCheckFifo = false;
@@ -1101,14 +1191,59 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   if (IsProfilingEnabled())
     ABI_CallFunction(&JitBlock::ProfileData::BeginProfiling, b->profile_data.get());
 
-  if (code_block.m_gqr_used.Count() == 1 &&
-      js.pairedQuantizeAddresses.find(js.blockStart) == js.pairedQuantizeAddresses.end())
+  // Count the runs of first tier blocks, and have them recompiled once they are hot.
+  if (js.firstTier)
   {
-    int gqr = *code_block.m_gqr_used.begin();
-    if (!code_block.m_gqr_modified[gqr] && !GQR(m_ppc_state, gqr))
+    b->tier_up_countdown = TIER_UP_RUN_COUNT;
+    MOVP2R(ARM64Reg::X0, &b->tier_up_countdown);
+    LDR(IndexType::Unsigned, ARM64Reg::W1, ARM64Reg::X0, 0);
+    SUBS(ARM64Reg::W1, ARM64Reg::W1, 1);
+    STR(IndexType::Unsigned, ARM64Reg::W1, ARM64Reg::X0, 0);
+    FixupBranch not_hot = B(CC_NEQ);
+    FixupBranch hot = B();
+    SwitchToFarCode();
+    SetJumpTarget(hot);
+    MOVI2R(DISPATCHER_PC, js.blockStart);
+    STR(IndexType::Unsigned, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
+    ABI_CallFunction(&JitInterface::CompileExceptionCheckFromJIT, &m_system.GetJitInterface(),
+                     static_cast<u32>(JitInterface::ExceptionType::HotBlock));
+    B(dispatcher_no_check);
+    SwitchToNearCode();
+    SetJumpTarget(not_hot);
+  }
+
+  // Assume that GQR values don't change often at runtime, and specialise the quantized loads and
+  // stores of this block on the values they have now. If a guess turns out wrong, the block is
+  // recompiled without speculating.
+  js.constantGqrValid = BitSet8();
+  if (js.pairedQuantizeAddresses.find(js.blockStart) == js.pairedQuantizeAddresses.end())
+  {
+    // If there are GQRs used but not set, we'll treat those as constant and optimize them
+    const BitSet8 gqr_static = ComputeStaticGQRs(code_block);
+    if (gqr_static)
     {
-      LDR(IndexType::Unsigned, ARM64Reg::W0, PPC_REG, PPCSTATE_OFF_SPR(SPR_GQR0 + gqr));
-      FixupBranch no_fail = CBZ(ARM64Reg::W0);
+      // Insert a check that the GQRs are still the value we expect at
+      // the start of the block in case our guess turns out wrong.
+      std::vector<FixupBranch> fails;
+      for (int gqr : gqr_static)
+      {
+        const u32 value = GQR(m_ppc_state, gqr);
+        js.constantGqr[gqr] = value;
+        LDR(IndexType::Unsigned, ARM64Reg::W0, PPC_REG, PPCSTATE_OFF_SPR(SPR_GQR0 + gqr));
+        if (value == 0)
+        {
+          fails.push_back(CBNZ(ARM64Reg::W0));
+        }
+        else
+        {
+          MOVI2R(ARM64Reg::W1, value);
+          CMP(ARM64Reg::W0, ARM64Reg::W1);
+          fails.push_back(B(CC_NEQ));
+        }
+      }
+      FixupBranch no_fail = B();
+      for (const FixupBranch& fail : fails)
+        SetJumpTarget(fail);
       FixupBranch fail = B();
       SwitchToFarCode();
       SetJumpTarget(fail);
@@ -1119,7 +1254,7 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
       B(dispatcher_no_check);
       SwitchToNearCode();
       SetJumpTarget(no_fail);
-      js.assumeNoPairedQuantize = true;
+      js.constantGqrValid = gqr_static;
     }
   }
 
@@ -1133,10 +1268,16 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
   }
 
   // Translate instructions
+  const bool record_line_info = Common::JitRegister::IsLineInfoEnabled();
+  js.lineInfo.clear();
+
   for (u32 i = 0; i < code_block.m_num_instructions; i++)
   {
     PPCAnalyst::CodeOp& op = m_code_buffer[i];
 
+    if (record_line_info)
+      js.lineInfo.push_back({GetCodePtr(), op.address});
+
     js.compilerPC = op.address;
     js.op = &op;
     js.fpr_is_store_safe = op.fprIsStoreSafeBeforeInst;
@@ -1271,6 +1412,16 @@ bool JitArm64::DoJit(u32 em_address, JitBlock* b, u32 nextPC)
         SetJumpTarget(no_breakpoint);
       }
 
+      if (m_trace_recorder.IsRecording())
+      {
+        FlushCarry();
+        gpr.Flush(FlushMode::All, ARM64Reg::INVALID_REG);
+        fpr.Flush(FlushMode::All, ARM64Reg::INVALID_REG);
+
+        ABI_CallFunction(&Core::TraceRecorder::Record, &m_trace_recorder,
+                         m_trace_recorder.GetInstructionInfo(op));
+      }
+
       if ((opinfo->flags & FL_USE_FPU) && !js.firstFPInstructionFound)
       {
         // This instruction uses FPU - needs to add FP exception bailout
@@ -46,7 +46,7 @@ public:
   void SingleStep() override;
 
   void Jit(u32 em_address) override;
-  void Jit(u32 em_address, bool clear_cache_and_retry_on_failure);
+  void Jit(u32 em_address, OutOfCodeSpace on_out_of_code_space);
 
   const char* GetName() const override { return "JITARM64"; }
 
@@ -343,11 +343,18 @@ protected:
   FakeLKExit(u32 exit_address_after_return,
              Arm64Gen::ARM64Reg exit_address_after_return_reg = Arm64Gen::ARM64Reg::INVALID_REG);
   void WriteBLRExit(Arm64Gen::ARM64Reg dest);
+  // Exits to the destination of the indirect branch at origin in dest. Destinations that were seen
+  // before are checked first and jump straight to their blocks.
+  void WriteIndirectBranchExit(u32 origin, Arm64Gen::ARM64Reg dest, bool LK,
+                               u32 exit_address_after_return,
+                               Arm64Gen::ARM64Reg exit_address_after_return_reg,
+                               BitSet32 gpr_caller_save);
 
   Arm64Gen::FixupBranch JumpIfCRFieldBit(int field, int bit, bool jump_if_set);
   void FixGTBeforeSettingCRFieldBit(Arm64Gen::ARM64Reg reg);
   void UpdateFPExceptionSummary(Arm64Gen::ARM64Reg fpscr);
   void UpdateRoundingMode();
+  void WriteNonIEEEModeExit(bool may_have_changed);
 
   void ComputeRC0(Arm64Gen::ARM64Reg reg);
   void ComputeRC0(u32 imm);
@@ -360,7 +360,11 @@ void JitArm64::bcctrx(UGeckoInstruction inst)
     WriteBranchWatchDestInRegister(js.compilerPC, WA, inst, WC, WD, gpr_caller_save, {});
     gpr.Unlock(WC, WD);
   }
-  WriteExit(WA, inst.LK_3, js.compilerPC + 4, WB);
+  BitSet32 gpr_caller_save = BitSet32{DecodeReg(WA)};
+  if (WB != ARM64Reg::INVALID_REG)
+    gpr_caller_save[DecodeReg(WB)] = true;
+  gpr_caller_save &= CALLER_SAVED_GPRS;
+  WriteIndirectBranchExit(js.compilerPC, WA, inst.LK_3, js.compilerPC + 4, WB, gpr_caller_save);
 
   if (WB != ARM64Reg::INVALID_REG)
     gpr.Unlock(WB);
@@ -436,8 +436,11 @@ void JitArm64::FloatCompare(UGeckoInstruction inst, bool upper)
   // which does not progress past the title screen if a denormal single compares equal to zero.
   // Workaround: Perform the comparison using a double operation instead. This ensures that denormal
   // singles behave correctly in comparisons, but we still have a problem with denormal doubles.
-  const bool input_ftz_workaround =
-      !cpu_info.bAFP && (!js.fpr_is_store_safe[a] || !js.fpr_is_store_safe[b]);
+  // Blocks are compiled separately for FPSCR.NI = 0, in which case FPCR.FZ is clear and no
+  // workaround is needed.
+  const bool input_ftz_workaround = !cpu_info.bAFP &&
+                                    (m_ppc_state.feature_flags & FEATURE_FLAG_FPSCR_NI) &&
+                                    (!js.fpr_is_store_safe[a] || !js.fpr_is_store_safe[b]);
 
   const bool singles = fpr.IsSingle(a, !upper) && fpr.IsSingle(b, !upper) && !input_ftz_workaround;
   const RegType lower_type = singles ? RegType::LowerPairSingle : RegType::LowerPair;
@@ -742,14 +745,26 @@ void JitArm64::ConvertSingleToDoubleLower(size_t guest_reg, ARM64Reg dest_reg, A
   FlushCarry();
 
   // Do we know that the input isn't NaN, and that the input isn't denormal or FPCR.FZ is not set?
-  // (This check unfortunately also catches zeroes)
+  // If the block was compiled for FPSCR.NI = 0, FPCR.FZ is known to be clear and only NaNs need
+  // the bit-exact routine. Otherwise, the check unfortunately also catches zeroes.
+
+  const bool flush_to_zero = m_ppc_state.feature_flags & FEATURE_FLAG_FPSCR_NI;
+  const bool has_fast_path = !flush_to_zero || scratch_reg != ARM64Reg::INVALID_REG;
 
   FixupBranch fast;
-  if (scratch_reg != ARM64Reg::INVALID_REG)
+  if (has_fast_path)
   {
-    m_float_emit.FABS(EncodeRegToSingle(scratch_reg), EncodeRegToSingle(src_reg));
-    m_float_emit.FCMP(EncodeRegToSingle(scratch_reg));
-    fast = B(CCFlags::CC_GT);
+    if (flush_to_zero)
+    {
+      m_float_emit.FABS(EncodeRegToSingle(scratch_reg), EncodeRegToSingle(src_reg));
+      m_float_emit.FCMP(EncodeRegToSingle(scratch_reg));
+      fast = B(CCFlags::CC_GT);
+    }
+    else
+    {
+      m_float_emit.FCMP(EncodeRegToSingle(src_reg), EncodeRegToSingle(src_reg));
+      fast = B(CCFlags::CC_VC);
+    }
 
     if (switch_to_farcode)
     {
@@ -773,7 +788,7 @@ void JitArm64::ConvertSingleToDoubleLower(size_t guest_reg, ARM64Reg dest_reg, A
 
   // If yes, do a fast conversion with FCVT
 
-  if (scratch_reg != ARM64Reg::INVALID_REG)
+  if (has_fast_path)
   {
     FixupBranch continue1 = B();
 
@@ -804,26 +819,41 @@ void JitArm64::ConvertSingleToDoublePair(size_t guest_reg, ARM64Reg dest_reg, AR
   FlushCarry();
 
   // Do we know that neither input is NaN, and that neither input is denormal or FPCR.FZ is not set?
-  // (This check unfortunately also catches zeroes)
+  // If the block was compiled for FPSCR.NI = 0, FPCR.FZ is known to be clear and only NaNs need
+  // the bit-exact routine. Otherwise, the check unfortunately also catches zeroes.
 
   FixupBranch fast;
   if (scratch_reg != ARM64Reg::INVALID_REG)
   {
-    // Set each 32-bit element of scratch_reg to 0x0000'0000 or 0xFFFF'FFFF depending on whether
-    // the absolute value of the corresponding element in src_reg compares greater than 0
-    m_float_emit.MOVI(64, EncodeRegToDouble(scratch_reg), 0);
-    m_float_emit.FACGT(32, EncodeRegToDouble(scratch_reg), EncodeRegToDouble(src_reg),
-                       EncodeRegToDouble(scratch_reg));
-
-    // 0x0000'0000'0000'0000 (zero)     -> 0x0000'0000'0000'0000 (zero)
-    // 0x0000'0000'FFFF'FFFF (denormal) -> 0xFF00'0000'FFFF'FFFF (normal)
-    // 0xFFFF'FFFF'0000'0000 (NaN)      -> 0x00FF'FFFF'0000'0000 (normal)
-    // 0xFFFF'FFFF'FFFF'FFFF (NaN)      -> 0xFFFF'FFFF'FFFF'FFFF (NaN)
-    m_float_emit.INS(8, EncodeRegToDouble(scratch_reg), 7, EncodeRegToDouble(scratch_reg), 0);
-
-    // Is scratch_reg a NaN (0xFFFF'FFFF'FFFF'FFFF)?
-    m_float_emit.FCMP(EncodeRegToDouble(scratch_reg));
-    fast = B(CCFlags::CC_VS);
+    if (!(m_ppc_state.feature_flags & FEATURE_FLAG_FPSCR_NI))
+    {
+      // Set each 32-bit element of scratch_reg to 0x0000'0000 if it isn't NaN, or to 0xFFFF'FFFF
+      // if it is. Then scratch_reg is zero if neither element is NaN, and otherwise it is a NaN or
+      // a denormal double, neither of which compares equal to zero.
+      m_float_emit.FCMEQ(32, EncodeRegToDouble(scratch_reg), EncodeRegToDouble(src_reg),
+                         EncodeRegToDouble(src_reg));
+      m_float_emit.NOT(EncodeRegToDouble(scratch_reg), EncodeRegToDouble(scratch_reg));
+      m_float_emit.FCMP(EncodeRegToDouble(scratch_reg));
+      fast = B(CCFlags::CC_EQ);
+    }
+    else
+    {
+      // Set each 32-bit element of scratch_reg to 0x0000'0000 or 0xFFFF'FFFF depending on whether
+      // the absolute value of the corresponding element in src_reg compares greater than 0
+      m_float_emit.MOVI(64, EncodeRegToDouble(scratch_reg), 0);
+      m_float_emit.FACGT(32, EncodeRegToDouble(scratch_reg), EncodeRegToDouble(src_reg),
+                         EncodeRegToDouble(scratch_reg));
+
+      // 0x0000'0000'0000'0000 (zero)     -> 0x0000'0000'0000'0000 (zero)
+      // 0x0000'0000'FFFF'FFFF (denormal) -> 0xFF00'0000'FFFF'FFFF (normal)
+      // 0xFFFF'FFFF'0000'0000 (NaN)      -> 0x00FF'FFFF'0000'0000 (normal)
+      // 0xFFFF'FFFF'FFFF'FFFF (NaN)      -> 0xFFFF'FFFF'FFFF'FFFF (NaN)
+      m_float_emit.INS(8, EncodeRegToDouble(scratch_reg), 7, EncodeRegToDouble(scratch_reg), 0);
+
+      // Is scratch_reg a NaN (0xFFFF'FFFF'FFFF'FFFF)?
+      m_float_emit.FCMP(EncodeRegToDouble(scratch_reg));
+      fast = B(CCFlags::CC_VS);
+    }
 
     if (switch_to_farcode)
     {
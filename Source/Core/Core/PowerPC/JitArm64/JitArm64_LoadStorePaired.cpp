@@ -22,10 +22,6 @@ void JitArm64::psq_lXX(UGeckoInstruction inst)
   INSTRUCTION_START
   JITDISABLE(bJITLoadStorePairedOff);
 
-  // If fastmem is enabled, the asm routines assume address translation is on.
-  FALLBACK_IF(!js.assumeNoPairedQuantize && jo.fastmem &&
-              !(m_ppc_state.feature_flags & FEATURE_FLAG_MSR_DR));
-
   // X30 is LR
   // X0 is a temporary
   // X1 is the address
@@ -38,9 +34,17 @@ void JitArm64::psq_lXX(UGeckoInstruction inst)
   const int i = indexed ? inst.Ix : inst.I;
   const int w = indexed ? inst.Wx : inst.W;
 
+  // The load half of the GQR is the upper 16 bits
+  const bool gqr_is_constant = js.constantGqrValid[i];
+  const u32 gqr_value = js.constantGqr[i] >> 16;
+  const bool no_quantize = gqr_is_constant && (gqr_value & 0x3F07) == 0;
+
+  // If fastmem is enabled, the asm routines assume address translation is on.
+  FALLBACK_IF(!no_quantize && jo.fastmem && !(m_ppc_state.feature_flags & FEATURE_FLAG_MSR_DR));
+
   gpr.Lock(ARM64Reg::W1, ARM64Reg::W30);
   fpr.Lock(ARM64Reg::Q0);
-  if (!js.assumeNoPairedQuantize)
+  if (!no_quantize)
   {
     gpr.Lock(ARM64Reg::W0, ARM64Reg::W2, ARM64Reg::W3);
     fpr.Lock(ARM64Reg::Q1);
@@ -77,7 +81,7 @@ void JitArm64::psq_lXX(UGeckoInstruction inst)
     MOV(gpr.R(inst.RA), addr_reg);
   }
 
-  if (js.assumeNoPairedQuantize)
+  if (no_quantize)
   {
     BitSet32 gprs_in_use = gpr.GetCallerSavedUsed();
     BitSet32 fprs_in_use = fpr.GetCallerSavedUsed();
@@ -98,6 +102,21 @@ void JitArm64::psq_lXX(UGeckoInstruction inst)
     EmitBackpatchRoutine(flags, MemAccessMode::Auto, VS, EncodeRegTo64(addr_reg), gprs_in_use,
                          fprs_in_use);
   }
+  else if (gqr_is_constant)
+  {
+    // Stash PC in case asm routine needs to call into C++
+    MOVI2R(ARM64Reg::W30, js.compilerPC);
+    STR(IndexType::Unsigned, ARM64Reg::W30, PPC_REG, PPCSTATE_OFF(pc));
+
+    // We know what GQR is here, so we can load the scale and call into the load method directly.
+    MOVI2R(scale_reg, (gqr_value >> 8) & 0x3F);
+    MOVP2R(ARM64Reg::X30, (w ? single_load_quantized : paired_load_quantized)[gqr_value & 0x7]);
+    BLR(ARM64Reg::X30);
+
+    WriteConditionalExceptionExit(EXCEPTION_DSI, ARM64Reg::W30, ARM64Reg::Q1);
+
+    m_float_emit.ORR(EncodeRegToDouble(VS), ARM64Reg::D0, ARM64Reg::D0);
+  }
   else
   {
     LDR(IndexType::Unsigned, scale_reg, PPC_REG, PPCSTATE_OFF_SPR(SPR_GQR0 + i));
@@ -135,7 +154,7 @@ void JitArm64::psq_lXX(UGeckoInstruction inst)
 
   gpr.Unlock(ARM64Reg::W1, ARM64Reg::W30);
   fpr.Unlock(ARM64Reg::Q0);
-  if (!js.assumeNoPairedQuantize)
+  if (!no_quantize)
   {
     gpr.Unlock(ARM64Reg::W0, ARM64Reg::W2, ARM64Reg::W3);
     fpr.Unlock(ARM64Reg::Q1);
@@ -151,10 +170,6 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
   INSTRUCTION_START
   JITDISABLE(bJITLoadStorePairedOff);
 
-  // If fastmem is enabled, the asm routines assume address translation is on.
-  FALLBACK_IF(!js.assumeNoPairedQuantize && jo.fastmem &&
-              !(m_ppc_state.feature_flags & FEATURE_FLAG_MSR_DR));
-
   // X30 is LR
   // X0 is a temporary
   // X1 is the scale
@@ -167,15 +182,23 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
   const int i = indexed ? inst.Ix : inst.I;
   const int w = indexed ? inst.Wx : inst.W;
 
+  // The store half of the GQR is the lower 16 bits
+  const bool gqr_is_constant = js.constantGqrValid[i];
+  const u32 gqr_value = js.constantGqr[i] & 0xFFFF;
+  const bool no_quantize = gqr_is_constant && (gqr_value & 0x3F07) == 0;
+
+  // If fastmem is enabled, the asm routines assume address translation is on.
+  FALLBACK_IF(!no_quantize && jo.fastmem && !(m_ppc_state.feature_flags & FEATURE_FLAG_MSR_DR));
+
   fpr.Lock(ARM64Reg::Q0);
-  if (!js.assumeNoPairedQuantize)
+  if (!no_quantize)
     fpr.Lock(ARM64Reg::Q1);
 
   const bool have_single = fpr.IsSingle(inst.RS);
 
   ARM64Reg VS = fpr.R(inst.RS, have_single ? RegType::Single : RegType::Register);
 
-  if (js.assumeNoPairedQuantize)
+  if (no_quantize)
   {
     if (!have_single)
     {
@@ -205,9 +228,9 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
   }
 
   gpr.Lock(ARM64Reg::W1, ARM64Reg::W2, ARM64Reg::W30);
-  if (!js.assumeNoPairedQuantize || !jo.fastmem)
+  if (!no_quantize || !jo.fastmem)
     gpr.Lock(ARM64Reg::W0);
-  if (!js.assumeNoPairedQuantize && !jo.fastmem)
+  if (!no_quantize && !jo.fastmem)
     gpr.Lock(ARM64Reg::W3);
 
   constexpr ARM64Reg type_reg = ARM64Reg::W0;
@@ -236,7 +259,7 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
     MOV(gpr.R(inst.RA), addr_reg);
   }
 
-  if (js.assumeNoPairedQuantize)
+  if (no_quantize)
   {
     BitSet32 gprs_in_use = gpr.GetCallerSavedUsed();
     BitSet32 fprs_in_use = fpr.GetCallerSavedUsed();
@@ -255,6 +278,19 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
     EmitBackpatchRoutine(flags, MemAccessMode::Auto, VS, EncodeRegTo64(addr_reg), gprs_in_use,
                          fprs_in_use);
   }
+  else if (gqr_is_constant)
+  {
+    // Stash PC in case asm routine needs to call into C++
+    MOVI2R(ARM64Reg::W30, js.compilerPC);
+    STR(IndexType::Unsigned, ARM64Reg::W30, PPC_REG, PPCSTATE_OFF(pc));
+
+    // We know what GQR is here, so we can load the scale and call into the store method directly.
+    MOVI2R(scale_reg, (gqr_value >> 8) & 0x3F);
+    MOVP2R(ARM64Reg::X30, (w ? single_store_quantized : paired_store_quantized)[gqr_value & 0x7]);
+    BLR(ARM64Reg::X30);
+
+    WriteConditionalExceptionExit(EXCEPTION_DSI, ARM64Reg::W30, ARM64Reg::Q1);
+  }
   else
   {
     LDR(IndexType::Unsigned, scale_reg, PPC_REG, PPCSTATE_OFF_SPR(SPR_GQR0 + i));
@@ -279,15 +315,15 @@ void JitArm64::psq_stXX(UGeckoInstruction inst)
     MOV(gpr.R(inst.RA), addr_reg);
   }
 
-  if (js.assumeNoPairedQuantize && !have_single)
+  if (no_quantize && !have_single)
     fpr.Unlock(VS);
 
   gpr.Unlock(ARM64Reg::W1, ARM64Reg::W2, ARM64Reg::W30);
   fpr.Unlock(ARM64Reg::Q0);
-  if (!js.assumeNoPairedQuantize || !jo.fastmem)
+  if (!no_quantize || !jo.fastmem)
     gpr.Unlock(ARM64Reg::W0);
-  if (!js.assumeNoPairedQuantize && !jo.fastmem)
+  if (!no_quantize && !jo.fastmem)
     gpr.Unlock(ARM64Reg::W3);
-  if (!js.assumeNoPairedQuantize)
+  if (!no_quantize)
     fpr.Unlock(ARM64Reg::Q1);
 }
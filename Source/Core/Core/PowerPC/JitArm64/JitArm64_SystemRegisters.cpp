@@ -87,6 +87,25 @@ void JitArm64::UpdateRoundingMode()
   ABI_PopRegisters(gprs_to_save);
 }
 
+// Ends the block after a write to FPSCR.NI. Blocks are compiled for one value of NI (see
+// FEATURE_FLAG_FPSCR_NI), and UpdateRoundingMode has updated feature_flags, so if NI may have
+// changed, the next block has to be looked up by the dispatcher.
+void JitArm64::WriteNonIEEEModeExit(bool may_have_changed)
+{
+  gpr.Flush(FlushMode::All, ARM64Reg::INVALID_REG);
+  fpr.Flush(FlushMode::All, ARM64Reg::INVALID_REG);
+
+  if (may_have_changed)
+  {
+    MOVI2R(DISPATCHER_PC, js.compilerPC + 4);
+    WriteExit(DISPATCHER_PC);
+  }
+  else
+  {
+    WriteExit(js.compilerPC + 4);
+  }
+}
+
 void JitArm64::mtmsr(UGeckoInstruction inst)
 {
   INSTRUCTION_START
@@ -172,6 +191,8 @@ void JitArm64::mtsr(UGeckoInstruction inst)
 {
   INSTRUCTION_START
   JITDISABLE(bJITSystemRegistersOff);
+  // The MMU has to remove the segment's pages from the logical fastmem area
+  FALLBACK_IF(jo.fastmem_arena);
 
   STR(IndexType::Unsigned, gpr.R(inst.RS), PPC_REG, PPCSTATE_OFF_SR(inst.SR));
 }
@@ -200,6 +221,7 @@ void JitArm64::mtsrin(UGeckoInstruction inst)
 {
   INSTRUCTION_START
   JITDISABLE(bJITSystemRegistersOff);
+  FALLBACK_IF(jo.fastmem_arena);
 
   u32 b = inst.RB, d = inst.RD;
   gpr.BindToRegister(d, d == b);
@@ -838,6 +860,9 @@ void JitArm64::mtfsb0x(UGeckoInstruction inst)
 
   if (inst.CRBD >= 29)
     UpdateRoundingMode();
+
+  if (js.op->canEndBlock)
+    WriteNonIEEEModeExit((m_ppc_state.feature_flags & FEATURE_FLAG_FPSCR_NI) != 0);
 }
 
 void JitArm64::mtfsb1x(UGeckoInstruction inst)
@@ -874,6 +899,9 @@ void JitArm64::mtfsb1x(UGeckoInstruction inst)
 
   if (inst.CRBD >= 29)
     UpdateRoundingMode();
+
+  if (js.op->canEndBlock)
+    WriteNonIEEEModeExit((m_ppc_state.feature_flags & FEATURE_FLAG_FPSCR_NI) == 0);
 }
 
 void JitArm64::mtfsfix(UGeckoInstruction inst)
@@ -917,6 +945,12 @@ void JitArm64::mtfsfix(UGeckoInstruction inst)
   // Field 7 contains NI and RN.
   if (inst.CRFD == 7)
     UpdateRoundingMode();
+
+  if (js.op->canEndBlock)
+  {
+    const bool ni = (imm & FPSCR_NI) != 0;
+    WriteNonIEEEModeExit(ni != ((m_ppc_state.feature_flags & FEATURE_FLAG_FPSCR_NI) != 0));
+  }
 }
 
 void JitArm64::mtfsfx(UGeckoInstruction inst)
@@ -983,4 +1017,7 @@ void JitArm64::mtfsfx(UGeckoInstruction inst)
 
   if (inst.FM & 1)
     UpdateRoundingMode();
+
+  if (js.op->canEndBlock)
+    WriteNonIEEEModeExit(true);
 }
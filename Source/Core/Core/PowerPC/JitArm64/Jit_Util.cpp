@@ -113,6 +113,18 @@ public:
   {
     CallLambda(8 * sizeof(T), lambda);
   }
+  void VisitConditionalDirect(const T* addr, u32 mask, const bool* use_direct,
+                              const std::function<T(Core::System&, u32)>* lambda) override
+  {
+    const s32 offset = m_emit->MOVPage2R(ARM64Reg::X0, use_direct);
+    m_emit->LDRB(IndexType::Unsigned, ARM64Reg::W0, ARM64Reg::X0, offset);
+    FixupBranch slow = m_emit->CBZ(ARM64Reg::W0);
+    LoadAddrMaskToReg(8 * sizeof(T), addr, mask);
+    FixupBranch done = m_emit->B();
+    m_emit->SetJumpTarget(slow);
+    CallLambda(8 * sizeof(T), lambda);
+    m_emit->SetJumpTarget(done);
+  }
 
 private:
   void LoadConstantToReg(int sbits, u32 value)
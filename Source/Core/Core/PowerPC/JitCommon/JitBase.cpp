@@ -19,6 +19,8 @@
 #include "Core/CoreTiming.h"
 #include "Core/HW/CPU.h"
 #include "Core/MemTools.h"
+#include "Core/PowerPC/Interpreter/Interpreter.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
@@ -57,7 +59,7 @@
 // After resetting the stack to the top, we call _resetstkoflw() to restore
 // the guard page at the 256kb mark.
 
-const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 23> JitBase::JIT_SETTINGS{{
+const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 25> JitBase::JIT_SETTINGS{{
     {&JitBase::bJITOff, &Config::MAIN_DEBUG_JIT_OFF},
     {&JitBase::bJITLoadStoreOff, &Config::MAIN_DEBUG_JIT_LOAD_STORE_OFF},
     {&JitBase::bJITLoadStorelXzOff, &Config::MAIN_DEBUG_JIT_LOAD_STORE_LXZ_OFF},
@@ -81,6 +83,8 @@ const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 23> JitB
     {&JitBase::m_accurate_nans, &Config::MAIN_ACCURATE_NANS},
     {&JitBase::m_fastmem_enabled, &Config::MAIN_FASTMEM},
     {&JitBase::m_accurate_cpu_cache_enabled, &Config::MAIN_ACCURATE_CPU_CACHE},
+    {&JitBase::m_enable_tiered_compilation, &Config::MAIN_JIT_TIERED_COMPILATION},
+    {&JitBase::m_enable_deferred_compilation, &Config::MAIN_JIT_DEFERRED_COMPILATION},
 }};
 
 const u8* JitBase::Dispatch(JitBase& jit)
@@ -93,9 +97,12 @@ void JitTrampoline(JitBase& jit, u32 em_address)
   jit.Jit(em_address);
 }
 
+std::atomic<u64> JitBase::s_indirect_branch_dispatches = 0;
+
 JitBase::JitBase(Core::System& system)
     : m_code_buffer(code_buffer_size), m_system(system), m_ppc_state(system.GetPPCState()),
       m_mmu(system.GetMMU()), m_branch_watch(system.GetPowerPC().GetBranchWatch()),
+      m_trace_recorder(system.GetPowerPC().GetTraceRecorder()),
       m_ppc_symbol_db(system.GetPPCSymbolDB())
 {
   m_registered_config_callback_id = CPUThreadConfigCallback::AddConfigChangedCallback([this] {
@@ -142,6 +149,67 @@ void JitBase::RefreshConfig()
   jo.div_by_zero_exceptions = m_enable_div_by_zero_exceptions;
 }
 
+bool JitBase::ShouldCompileFirstTier(u32 em_address) const
+{
+  // Profiling and debugging want blocks to stay put.
+  if (!m_enable_tiered_compilation || m_enable_profiling || m_enable_debugging)
+    return false;
+
+  return !js.hotBlockAddresses.contains(em_address);
+}
+
+JitBase::IndirectBranchTargets* JitBase::GetIndirectBranchTargets(u32 address)
+{
+  // Without block linking, the inline cache would exit to the dispatcher anyway.
+  if (!jo.enableBlocklink)
+    return nullptr;
+
+  if (js.firstTier)
+    return &js.indirectBranchTargets[address];
+
+  const auto it = js.indirectBranchTargets.find(address);
+  return it != js.indirectBranchTargets.end() && it->second.count != 0 ? &it->second : nullptr;
+}
+
+void JitBase::IndirectBranchTargets::Record(IndirectBranchTargets* targets, u32 destination)
+{
+  const auto begin = targets->destinations.begin();
+  auto it = std::find(begin, begin + targets->count, destination);
+  if (it == begin + targets->count)
+  {
+    // Replace the least recently seen destination if there are too many.
+    if (targets->count < MAX_TARGETS)
+      ++targets->count;
+    it = begin + (targets->count - 1);
+  }
+
+  std::copy_backward(begin, it, it + 1);
+  *begin = destination;
+}
+
+bool JitBase::InterpretColdBlock(u32 em_address)
+{
+  if (!m_enable_deferred_compilation || m_enable_profiling || m_enable_debugging ||
+      m_trace_recorder.IsRecording())
+  {
+    return false;
+  }
+
+  const auto [it, inserted] = js.coldBlockRuns.try_emplace(em_address, 0);
+  if (it->second >= DEFERRED_COMPILATION_RUN_COUNT)
+  {
+    js.coldBlockRuns.erase(it);
+    return false;
+  }
+  ++it->second;
+
+  m_ppc_state.downcount -= m_system.GetInterpreter().RunBasicBlock();
+
+  // An exception or an rfi might have changed MSR.DR.
+  m_system.GetJitInterface().UpdateMembase();
+  return true;
+}
+
 void JitBase::InitFastmemArena()
 {
   auto& memory = m_system.GetMemory();
@@ -264,6 +332,9 @@ bool JitBase::CanMergeNextInstructions(int count) const
 {
   if (m_system.GetCPU().IsStepping() || js.instructionsLeft < count)
     return false;
+  // Every instruction needs its own trace record, and recording one kills flags as well
+  if (m_trace_recorder.IsRecording())
+    return false;
   // Be careful: a breakpoint kills flags in between instructions
   for (int i = 1; i <= count; i++)
   {
@@ -276,6 +347,11 @@ bool JitBase::CanMergeNextInstructions(int count) const
   return true;
 }
 
+BitSet8 JitBase::ComputeStaticGQRs(const PPCAnalyst::CodeBlock& cb) const
+{
+  return cb.m_gqr_used & ~cb.m_gqr_modified;
+}
+
 bool JitBase::ShouldHandleFPExceptionForInstruction(const PPCAnalyst::CodeOp* op)
 {
   if (jo.fp_exceptions)
@@ -4,14 +4,17 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <map>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
 #include "Common/BitSet.h"
 #include "Common/CommonTypes.h"
 #include "Common/Config/ConfigInfo.h"
+#include "Common/JitRegister.h"
 #include "Common/x64Emitter.h"
 #include "Core/CPUThreadConfigCallback.h"
 #include "Core/ConfigManager.h"
@@ -25,6 +28,7 @@ namespace Core
 {
 class BranchWatch;
 class System;
+class TraceRecorder;
 }  // namespace Core
 namespace PowerPC
 {
@@ -57,6 +61,18 @@ class PPCSymbolDB;
 class JitBase : public CPUCoreBase
 {
 protected:
+  // The last few destinations of an indirect branch, most recent first. They are recorded by
+  // first tier blocks, and the recompiled block checks them in an inline cache.
+  struct IndirectBranchTargets
+  {
+    static constexpr u32 MAX_TARGETS = 4;
+
+    static void Record(IndirectBranchTargets* targets, u32 destination);
+
+    std::array<u32, MAX_TARGETS> destinations{};
+    u32 count = 0;
+  };
+
   enum class CarryFlag
   {
     InPPCState,
@@ -102,7 +118,6 @@ protected:
     bool fixupExceptionHandler;
     Gen::FixupBranch exceptionHandler;
 
-    bool assumeNoPairedQuantize;
     BitSet8 constantGqrValid;
     std::array<u32, 8> constantGqr;
     bool firstFPInstructionFound;
@@ -124,9 +139,23 @@ protected:
 
     JitBlock* curBlock;
 
+    // Set if the current block is compiled as the first tier of tiered compilation.
+    bool firstTier;
+
     std::unordered_set<u32> fifoWriteAddresses;
     std::unordered_set<u32> pairedQuantizeAddresses;
     std::unordered_set<u32> noSpeculativeConstantsAddresses;
+    // Blocks which have run often enough to be compiled with all optimizations.
+    std::unordered_set<u32> hotBlockAddresses;
+    // How often blocks which haven't been compiled yet were run by the interpreter.
+    std::unordered_map<u32, u32> coldBlockRuns;
+    // Indexed by the address of the branch. Entries are never erased while blocks are compiled,
+    // since first tier blocks write to them.
+    std::unordered_map<u32, IndirectBranchTargets> indirectBranchTargets;
+
+    // Where the code for each guest instruction of the current block starts, for profilers.
+    // Only filled in if Common::JitRegister::IsLineInfoEnabled().
+    std::vector<Common::JitRegister::LineInfo> lineInfo;
   };
 
   PPCAnalyst::CodeBlock code_block;
@@ -158,11 +187,43 @@ protected:
   bool m_fastmem_enabled = false;
   bool m_accurate_cpu_cache_enabled = false;
 
+  bool m_enable_tiered_compilation = false;
+  bool m_enable_deferred_compilation = false;
+
   bool m_enable_blr_optimization = false;
   bool m_cleanup_after_stackfault = false;
   u8* m_stack_guard = nullptr;
 
-  static const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 23> JIT_SETTINGS;
+  static const std::array<std::pair<bool JitBase::*, const Config::Info<bool>*>, 25> JIT_SETTINGS;
+
+  // With tiered compilation, blocks are first compiled quickly: the analyzer only runs its
+  // cheap passes and blocks are kept short. Such a block counts how often it runs, and once it
+  // has run TIER_UP_RUN_COUNT times it gets invalidated and recompiled with all optimizations.
+  static constexpr u32 TIER_UP_RUN_COUNT = 1000;
+  static constexpr std::size_t FIRST_TIER_BLOCK_SIZE = 32;
+  bool ShouldCompileFirstTier(u32 em_address) const;
+
+  // With deferred compilation, the first DEFERRED_COMPILATION_RUN_COUNT runs of a block are
+  // executed by the interpreter instead of compiling the block. Code which only runs a few times,
+  // like initialization code or the relocation of a freshly loaded REL, then never stalls
+  // emulation while being compiled.
+  static constexpr u32 DEFERRED_COMPILATION_RUN_COUNT = 4;
+  // Returns true if the block was run by the interpreter and doesn't need to be compiled now.
+  bool InterpretColdBlock(u32 em_address);
+
+  // Returns the destinations that the exit of the indirect branch at the address should record if
+  // the current block is compiled as the first tier, or check otherwise. Returns nullptr if there
+  // is nothing to do.
+  IndirectBranchTargets* GetIndirectBranchTargets(u32 address);
+
+  // What Jit() does when the code regions have no space left for a block. Each retry that fails
+  // moves on to the next, more drastic step.
+  enum class OutOfCodeSpace
+  {
+    EvictOldBlocksAndRetry,
+    ClearCacheAndRetry,
+    Fail,
+  };
 
   bool DoesConfigNeedRefresh();
   void RefreshConfig();
@@ -175,10 +236,15 @@ protected:
   void CleanUpAfterStackFault();
 
   bool CanMergeNextInstructions(int count) const;
+  BitSet8 ComputeStaticGQRs(const PPCAnalyst::CodeBlock&) const;
 
   bool ShouldHandleFPExceptionForInstruction(const PPCAnalyst::CodeOp* op);
 
 public:
+  // Counts the indirect branches which exited to the dispatcher because no inline cache entry
+  // matched their destination. Incremented by the generated code, and can be read from any thread.
+  static std::atomic<u64> s_indirect_branch_dispatches;
+
   explicit JitBase(Core::System& system);
   JitBase(const JitBase&) = delete;
   JitBase(JitBase&&) = delete;
@@ -209,6 +275,7 @@ public:
   PowerPC::PowerPCState& m_ppc_state;
   PowerPC::MMU& m_mmu;
   Core::BranchWatch& m_branch_watch;
+  Core::TraceRecorder& m_trace_recorder;
   PPCSymbolDB& m_ppc_symbol_db;
 };
 
@@ -5,14 +5,20 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstring>
 #include <functional>
-#include <map>
+#include <limits>
 #include <set>
+#include <span>
+#include <string>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/JitRegister.h"
+#include "Common/MemoryUtil.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
@@ -26,10 +32,37 @@
 
 using namespace Gen;
 
+namespace
+{
+// Only one JIT runs at a time, so the statistics can be kept here rather than in each cache. That
+// way they can be read from other threads without worrying about the lifetime of the JIT.
+std::atomic<u64> s_blocks_compiled = 0;
+std::atomic<u64> s_blocks_invalidated = 0;
+std::atomic<u64> s_clears = 0;
+std::atomic<u64> s_evictions = 0;
+std::atomic<u64> s_blocks_evicted = 0;
+std::atomic<u64> s_live_blocks = 0;
+std::atomic<u64> s_live_code_bytes = 0;
+
+// Erases the addresses in [begin, begin + length) from the set. Walks the set instead of the range
+// when that is shorter, which it is for the DMAs of large blocks of code.
+void EraseAddressRange(std::unordered_set<u32>* set, u32 begin, u32 length)
+{
+  if (set->size() < length / 4)
+  {
+    std::erase_if(*set, [&](u32 address) { return address - begin < length; });
+    return;
+  }
+
+  for (u32 i = begin; i < begin + length; i += 4)
+    set->erase(i);
+}
+}  // namespace
+
 bool JitBlock::OverlapsPhysicalRange(u32 address, u32 length) const
 {
-  return physical_addresses.lower_bound(address) !=
-         physical_addresses.lower_bound(address + length);
+  const auto begin = std::lower_bound(physical_addresses.begin(), physical_addresses.end(), address);
+  return begin != physical_addresses.end() && *begin < address + length;
 }
 
 void JitBlock::ProfileData::BeginProfiling(ProfileData* data)
@@ -44,7 +77,8 @@ void JitBlock::ProfileData::EndProfiling(ProfileData* data, u32 downcount_amount
   data->time_spent += Clock::now() - data->time_start;
 }
 
-JitBaseBlockCache::JitBaseBlockCache(JitBase& jit) : m_jit{jit}
+JitBaseBlockCache::JitBaseBlockCache(JitBase& jit)
+    : m_jit{jit}, m_disk_cache{jit}, m_page_block_counts{std::make_unique<u32[]>(CODE_PAGE_COUNT)}
 {
 }
 
@@ -52,7 +86,8 @@ JitBaseBlockCache::~JitBaseBlockCache() = default;
 
 void JitBaseBlockCache::Init()
 {
-  Common::JitRegister::Init(Config::Get(Config::MAIN_PERF_MAP_DIR));
+  Common::JitRegister::Init(Config::Get(Config::MAIN_PERF_MAP_DIR),
+                            Config::Get(Config::MAIN_PERF_JITDUMP));
 
   m_entry_points_ptr = nullptr;
 #ifdef _ARCH_64
@@ -66,32 +101,64 @@ void JitBaseBlockCache::Init()
 void JitBaseBlockCache::Shutdown()
 {
   Common::JitRegister::Shutdown();
+  m_disk_cache.Shutdown();
 
   m_entry_points_arena.Release();
+
+  s_live_blocks.store(0, std::memory_order_relaxed);
+  s_live_code_bytes.store(0, std::memory_order_relaxed);
+}
+
+JitBaseBlockCache::Statistics JitBaseBlockCache::GetStatistics()
+{
+  return {
+      .blocks_compiled = s_blocks_compiled.load(std::memory_order_relaxed),
+      .blocks_invalidated = s_blocks_invalidated.load(std::memory_order_relaxed),
+      .clears = s_clears.load(std::memory_order_relaxed),
+      .evictions = s_evictions.load(std::memory_order_relaxed),
+      .blocks_evicted = s_blocks_evicted.load(std::memory_order_relaxed),
+      .live_blocks = s_live_blocks.load(std::memory_order_relaxed),
+      .live_code_bytes = s_live_code_bytes.load(std::memory_order_relaxed),
+  };
 }
 
 // This clears the JIT cache. It's called from JitCache.cpp when the JIT cache
 // is full and when saving and loading states.
 void JitBaseBlockCache::Clear()
 {
+  // Unlinking and destroying blocks writes to the code of many blocks.
+  const Common::ScopedJITPageWriteBatch jit_page_write_batch;
 #if defined(_DEBUG) || defined(DEBUGFAST)
   Core::DisplayMessage("Clearing code cache.", 3000);
 #endif
   m_jit.js.fifoWriteAddresses.clear();
   m_jit.js.pairedQuantizeAddresses.clear();
   m_jit.js.noSpeculativeConstantsAddresses.clear();
+  m_jit.js.hotBlockAddresses.clear();
+  m_jit.js.coldBlockRuns.clear();
+  m_jit.js.indirectBranchTargets.clear();
   for (auto& e : block_map)
   {
-    DestroyBlock(e.second);
+    for (const BlockMapEntry& entry : e.second)
+      DestroyBlock(*entry.block);
   }
   block_map.clear();
   links_to.clear();
   block_range_map.clear();
 
+  // Keep the slab chunks around, they are likely to be needed again right away.
+  m_free_blocks.clear();
+  m_block_slab_used = 0;
+
   valid_block.ClearAll();
+  std::fill_n(m_page_block_counts.get(), CODE_PAGE_COUNT, 0);
 
   if (m_entry_points_ptr)
     m_entry_points_arena.Clear();
+
+  s_clears.fetch_add(1, std::memory_order_relaxed);
+  s_live_blocks.store(0, std::memory_order_relaxed);
+  s_live_code_bytes.store(0, std::memory_order_relaxed);
 }
 
 void JitBaseBlockCache::Reset()
@@ -113,22 +180,142 @@ JitBlock** JitBaseBlockCache::GetFastBlockMapFallback()
 void JitBaseBlockCache::RunOnBlocks(const Core::CPUThreadGuard&,
                                     std::function<void(const JitBlock&)> f) const
 {
+  // Visit the blocks ordered by their physical address to keep the output of callers stable.
+  std::vector<const BlockMapEntry*> entries;
   for (const auto& e : block_map)
-    f(e.second);
+  {
+    for (const BlockMapEntry& entry : e.second)
+      entries.push_back(&entry);
+  }
+  std::sort(entries.begin(), entries.end(), [](const BlockMapEntry* a, const BlockMapEntry* b) {
+    return a->physical_address < b->physical_address;
+  });
+  for (const BlockMapEntry* entry : entries)
+    f(*entry->block);
+}
+
+JitBlock* JitBaseBlockCache::AllocateBlockStorage()
+{
+  if (!m_free_blocks.empty())
+  {
+    JitBlock* block = m_free_blocks.back();
+    m_free_blocks.pop_back();
+    return block;
+  }
+
+  const size_t chunk = m_block_slab_used / BLOCK_SLAB_CHUNK_ELEMENTS;
+  if (chunk == m_block_slab.size())
+    m_block_slab.push_back(std::make_unique<JitBlock[]>(BLOCK_SLAB_CHUNK_ELEMENTS));
+
+  JitBlock* block = &m_block_slab[chunk][m_block_slab_used % BLOCK_SLAB_CHUNK_ELEMENTS];
+  ++m_block_slab_used;
+  return block;
+}
+
+void JitBaseBlockCache::FreeBlockStorage(JitBlock* block)
+{
+  // Release the heap allocations owned by the block right away, the slot itself is reused.
+  *block = JitBlock();
+  m_free_blocks.push_back(block);
 }
 
 JitBlock* JitBaseBlockCache::AllocateBlock(u32 em_address)
 {
   const u32 physical_address = m_jit.m_mmu.JitCache_TranslateAddress(em_address).address;
-  JitBlock& b = block_map.emplace(physical_address, m_jit.IsProfilingEnabled())->second;
+  JitBlock& b = *AllocateBlockStorage();
+  b = JitBlock(m_jit.IsProfilingEnabled());
   b.effectiveAddress = em_address;
   b.physicalAddress = physical_address;
   b.feature_flags = m_jit.m_ppc_state.feature_flags;
-  b.linkData.clear();
   b.fast_block_map_index = 0;
+  b.allocation_sequence = m_next_allocation_sequence++;
+  block_map[physical_address >> BLOCK_MAP_PAGE_SHIFT].push_back(
+      {physical_address, em_address, b.feature_flags, &b});
   return &b;
 }
 
+void JitBaseBlockCache::RemoveFromBlockMap(const JitBlock& block)
+{
+  const auto it = block_map.find(block.physicalAddress >> BLOCK_MAP_PAGE_SHIFT);
+  if (it == block_map.end())
+    return;
+
+  std::vector<BlockMapEntry>& entries = it->second;
+  const auto entry = std::find_if(entries.begin(), entries.end(),
+                                  [&](const BlockMapEntry& e) { return e.block == &block; });
+  if (entry != entries.end())
+  {
+    *entry = entries.back();
+    entries.pop_back();
+  }
+  if (entries.empty())
+    block_map.erase(it);
+}
+
+void JitBaseBlockCache::RemoveFromBlockRangeMap(const JitBlock& block, u32 skipped_macro_block)
+{
+  u32 previous_macro_block = skipped_macro_block;
+  for (u32 addr : block.physical_addresses)
+  {
+    // physical_addresses is sorted, so all addresses within a macro block are adjacent.
+    const u32 macro_block = addr / BLOCK_RANGE_MAP_ELEMENTS;
+    if (macro_block == previous_macro_block || macro_block == skipped_macro_block)
+      continue;
+    previous_macro_block = macro_block;
+
+    const auto it = block_range_map.find(macro_block);
+    if (it == block_range_map.end())
+      continue;
+
+    std::vector<JitBlock*>& blocks = it->second;
+    const auto entry = std::find(blocks.begin(), blocks.end(), &block);
+    if (entry != blocks.end())
+    {
+      *entry = blocks.back();
+      blocks.pop_back();
+    }
+    if (blocks.empty())
+      block_range_map.erase(it);
+  }
+}
+
+void JitBaseBlockCache::AddToPageBlockCounts(const JitBlock& block)
+{
+  // physical_addresses is sorted, so all addresses within a page are adjacent.
+  u32 previous_page = 0;
+  for (size_t i = 0; i < block.physical_addresses.size(); ++i)
+  {
+    const u32 page = block.physical_addresses[i] >> CODE_PAGE_SHIFT;
+    if (i == 0 || page != previous_page)
+      ++m_page_block_counts[page];
+    previous_page = page;
+  }
+}
+
+void JitBaseBlockCache::RemoveFromPageBlockCounts(const JitBlock& block)
+{
+  u32 previous_page = 0;
+  for (size_t i = 0; i < block.physical_addresses.size(); ++i)
+  {
+    const u32 page = block.physical_addresses[i] >> CODE_PAGE_SHIFT;
+    if (i == 0 || page != previous_page)
+      --m_page_block_counts[page];
+    previous_page = page;
+  }
+}
+
+bool JitBaseBlockCache::RangeContainsBlocks(u32 physical_address, u32 length) const
+{
+  const u32 first_page = physical_address >> CODE_PAGE_SHIFT;
+  const u32 last_page = (physical_address + (length - 1)) >> CODE_PAGE_SHIFT;
+  for (u32 page = first_page; page <= last_page; ++page)
+  {
+    if (m_page_block_counts[page] != 0)
+      return true;
+  }
+  return false;
+}
+
 void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
                                       const std::set<u32>& physical_addresses)
 {
@@ -144,37 +331,99 @@ void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
   }
   block.fast_block_map_index = index;
 
-  block.physical_addresses = physical_addresses;
+  block.physical_addresses.assign(physical_addresses.begin(), physical_addresses.end());
+  AddToPageBlockCounts(block);
 
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
-  for (u32 addr : physical_addresses)
+  s_blocks_compiled.fetch_add(1, std::memory_order_relaxed);
+  s_live_blocks.fetch_add(1, std::memory_order_relaxed);
+  s_live_code_bytes.fetch_add(block.codeSize, std::memory_order_relaxed);
+
+  std::vector<JitBlock*>* macro_block_entries = nullptr;
+  u32 previous_macro_block = 0;
+  for (u32 addr : block.physical_addresses)
   {
     valid_block.Set(addr / 32);
-    block_range_map[addr & range_mask].insert(&block);
+
+    // The addresses are sorted, so each macro block only needs to be looked up once.
+    const u32 macro_block = addr / BLOCK_RANGE_MAP_ELEMENTS;
+    if (!macro_block_entries || macro_block != previous_macro_block)
+    {
+      macro_block_entries = &block_range_map[macro_block];
+      macro_block_entries->push_back(&block);
+      previous_macro_block = macro_block;
+    }
   }
 
   if (block_link)
   {
     for (const auto& e : block.linkData)
     {
-      links_to[e.exitAddress].insert(&block);
+      std::vector<JitBlock*>& sources = links_to[e.exitAddress];
+      if (std::find(sources.begin(), sources.end(), &block) == sources.end())
+        sources.push_back(&block);
     }
 
     LinkBlock(block);
   }
 
-  Common::Symbol* symbol = nullptr;
-  if (Common::JitRegister::IsEnabled() &&
-      (symbol = m_jit.m_ppc_symbol_db.GetSymbolFromAddr(block.effectiveAddress)) != nullptr)
+  if (Common::JitRegister::IsEnabled())
   {
-    Common::JitRegister::Register(block.normalEntry, block.codeSize, "JIT_PPC_{}_{:08x}",
-                                  symbol->function_name.c_str(), block.physicalAddress);
+    const std::span<const Common::JitRegister::LineInfo> line_info(m_jit.js.lineInfo);
+    const Common::Symbol* symbol = m_jit.m_ppc_symbol_db.GetSymbolFromAddr(block.effectiveAddress);
+    const std::string name =
+        symbol ? fmt::format("JIT_PPC_{}_{:08x}", symbol->function_name, block.physicalAddress) :
+                 fmt::format("JIT_PPC_{:08x}", block.physicalAddress);
+    Common::JitRegister::Register(block.normalEntry, block.codeSize, name, line_info);
   }
-  else
+}
+
+void JitBaseBlockCache::DiscardBlock(JitBlock& block)
+{
+  // The block was never linked or entered into any map other than block_map.
+  RemoveFromBlockMap(block);
+  FreeBlockStorage(&block);
+}
+
+size_t JitBaseBlockCache::EvictOldBlocks()
+{
+  const Common::ScopedJITPageWriteBatch jit_page_write_batch;
+  std::vector<JitBlock*> candidates;
+  for (const auto& e : block_map)
+  {
+    for (const BlockMapEntry& entry : e.second)
+    {
+      if (!m_jit.js.hotBlockAddresses.contains(entry.effective_address))
+        candidates.push_back(entry.block);
+    }
+  }
+
+  const auto evicted_end = candidates.begin() + (candidates.size() + 1) / 2;
+  std::nth_element(candidates.begin(), evicted_end, candidates.end(),
+                   [](const JitBlock* a, const JitBlock* b) {
+                     return a->allocation_sequence < b->allocation_sequence;
+                   });
+
+  // No macro block can have this index, so the block is removed from all of them.
+  constexpr u32 no_skipped_macro_block = std::numeric_limits<u32>::max();
+  for (auto it = candidates.begin(); it != evicted_end; ++it)
   {
-    Common::JitRegister::Register(block.normalEntry, block.codeSize, "JIT_PPC_{:08x}",
-                                  block.physicalAddress);
+    JitBlock* block = *it;
+
+    // The valid_block bits are left set. That only costs an unneeded lookup on invalidation.
+    RemoveFromBlockRangeMap(*block, no_skipped_macro_block);
+    RemoveFromPageBlockCounts(*block);
+
+    s_live_blocks.fetch_sub(1, std::memory_order_relaxed);
+    s_live_code_bytes.fetch_sub(block->codeSize, std::memory_order_relaxed);
+    DestroyBlock(*block);
+    RemoveFromBlockMap(*block);
+    FreeBlockStorage(block);
   }
+
+  const size_t evicted_count = evicted_end - candidates.begin();
+  s_evictions.fetch_add(1, std::memory_order_relaxed);
+  s_blocks_evicted.fetch_add(evicted_count, std::memory_order_relaxed);
+  return evicted_count;
 }
 
 JitBlock* JitBaseBlockCache::GetBlockFromStartAddress(u32 addr, CPUEmuFeatureFlags feature_flags)
@@ -190,12 +439,17 @@ JitBlock* JitBaseBlockCache::GetBlockFromStartAddress(u32 addr, CPUEmuFeatureFla
     translated_addr = translated.address;
   }
 
-  auto iter = block_map.equal_range(translated_addr);
-  for (; iter.first != iter.second; iter.first++)
+  const auto it = block_map.find(translated_addr >> BLOCK_MAP_PAGE_SHIFT);
+  if (it == block_map.end())
+    return nullptr;
+
+  for (const BlockMapEntry& entry : it->second)
   {
-    JitBlock& b = iter.first->second;
-    if (b.effectiveAddress == addr && b.feature_flags == feature_flags)
-      return &b;
+    if (entry.physical_address == translated_addr && entry.effective_address == addr &&
+        entry.feature_flags == feature_flags)
+    {
+      return entry.block;
+    }
   }
 
   return nullptr;
@@ -248,6 +502,8 @@ void JitBaseBlockCache::InvalidateICacheLine(u32 address)
 
 void JitBaseBlockCache::InvalidateICache(u32 initial_address, u32 initial_length, bool forced)
 {
+  // Large invalidations can destroy many blocks over several pages.
+  const Common::ScopedJITPageWriteBatch jit_page_write_batch;
   u32 address = initial_address;
   u32 length = initial_length;
   while (length > 0)
@@ -289,6 +545,15 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
     else
       valid_block.Clear(physical_address / 32);
   }
+  else if (!RangeContainsBlocks(physical_address, length))
+  {
+    // DMAs of data and repeated invalidations of the same code usually hit pages without any
+    // blocks. Their valid_block bits may still be set, but clearing them isn't worth walking the
+    // whole range, they only cost a lookup on the next single cache line invalidation.
+    if (!forced)
+      EraseModifiedCodeHints(address, length);
+    return;
+  }
   else if (length > 32)
   {
     // Even if we can't check the set for optimization, we still want to remove all fully covered
@@ -310,63 +575,88 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
     // be (this can clobber flags, and thus break any optimization that relies on flags
     // being in the right place between instructions).
     if (!forced)
-    {
-      for (u32 i = address; i < address + length; i += 4)
-      {
-        m_jit.js.fifoWriteAddresses.erase(i);
-        m_jit.js.pairedQuantizeAddresses.erase(i);
-        m_jit.js.noSpeculativeConstantsAddresses.erase(i);
-      }
-    }
+      EraseModifiedCodeHints(address, length);
   }
 }
 
+void JitBaseBlockCache::EraseModifiedCodeHints(u32 address, u32 length)
+{
+  EraseAddressRange(&m_jit.js.fifoWriteAddresses, address, length);
+  EraseAddressRange(&m_jit.js.pairedQuantizeAddresses, address, length);
+  EraseAddressRange(&m_jit.js.noSpeculativeConstantsAddresses, address, length);
+  EraseAddressRange(&m_jit.js.hotBlockAddresses, address, length);
+}
+
 void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
 {
-  // Iterate over all macro blocks which overlap the given range.
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
-  auto start = block_range_map.lower_bound(address & range_mask);
-  auto end = block_range_map.lower_bound(address + length);
-  while (start != end)
+  if (length == 0)
+    return;
+
+  const Common::ScopedJITPageWriteBatch jit_page_write_batch;
+
+  const u32 first_macro_block = address / BLOCK_RANGE_MAP_ELEMENTS;
+  const u32 last_macro_block = (address + (length - 1)) / BLOCK_RANGE_MAP_ELEMENTS;
+
+  // Collect the macro blocks which overlap the given range. For large ranges it is cheaper to
+  // walk the (usually sparse) map than to probe every macro block of the range.
+  std::vector<u32> macro_blocks;
+  if (last_macro_block - first_macro_block < block_range_map.size())
+  {
+    for (u32 i = first_macro_block; i <= last_macro_block; ++i)
+    {
+      if (block_range_map.contains(i))
+        macro_blocks.push_back(i);
+    }
+  }
+  else
   {
+    for (const auto& e : block_range_map)
+    {
+      if (e.first >= first_macro_block && e.first <= last_macro_block)
+        macro_blocks.push_back(e.first);
+    }
+  }
+
+  for (u32 macro_block : macro_blocks)
+  {
+    const auto it = block_range_map.find(macro_block);
+    if (it == block_range_map.end())
+      continue;
+
     // Iterate over all blocks in the macro block.
-    auto iter = start->second.begin();
-    while (iter != start->second.end())
+    std::vector<JitBlock*>& blocks = it->second;
+    size_t i = 0;
+    while (i < blocks.size())
     {
-      JitBlock* block = *iter;
+      JitBlock* block = blocks[i];
       if (block->OverlapsPhysicalRange(address, length))
       {
         // If the block overlaps, also remove all other occupied slots in the other macro blocks.
-        // This will leak empty macro blocks, but they may be reused or cleared later on.
-        for (u32 addr : block->physical_addresses)
-          if ((addr & range_mask) != start->first)
-            block_range_map[addr & range_mask].erase(block);
+        // Erasing from other buckets can't invalidate our reference, since each block is listed
+        // in a macro block at most once and this one is skipped.
+        RemoveFromBlockRangeMap(*block, macro_block);
+        RemoveFromPageBlockCounts(*block);
 
         // And remove the block.
+        s_blocks_invalidated.fetch_add(1, std::memory_order_relaxed);
+        s_live_blocks.fetch_sub(1, std::memory_order_relaxed);
+        s_live_code_bytes.fetch_sub(block->codeSize, std::memory_order_relaxed);
         DestroyBlock(*block);
-        auto block_map_iter = block_map.equal_range(block->physicalAddress);
-        while (block_map_iter.first != block_map_iter.second)
-        {
-          if (&block_map_iter.first->second == block)
-          {
-            block_map.erase(block_map_iter.first);
-            break;
-          }
-          block_map_iter.first++;
-        }
-        iter = start->second.erase(iter);
+        RemoveFromBlockMap(*block);
+        FreeBlockStorage(block);
+
+        blocks[i] = blocks.back();
+        blocks.pop_back();
       }
       else
       {
-        iter++;
+        ++i;
       }
     }
 
     // If the macro block is empty, drop it.
-    if (start->second.empty())
-      start = block_range_map.erase(start);
-    else
-      start++;
+    if (blocks.empty())
+      block_range_map.erase(it);
   }
 }
 
@@ -375,6 +665,12 @@ u32* JitBaseBlockCache::GetBlockBitSet() const
   return valid_block.m_valid_block.get();
 }
 
+void JitBaseBlockCache::ProcessBlockForDiskCache(const PPCAnalyst::CodeBlock& code_block,
+                                                 const PPCAnalyst::CodeBuffer& code_buffer)
+{
+  m_disk_cache.ProcessBlock(code_block, code_buffer);
+}
+
 void JitBaseBlockCache::WriteDestroyBlock(const JitBlock& block)
 {
 }
@@ -468,8 +764,14 @@ void JitBaseBlockCache::DestroyBlock(JitBlock& block)
     auto it = links_to.find(e.exitAddress);
     if (it == links_to.end())
       continue;
-    it->second.erase(&block);
-    if (it->second.empty())
+    std::vector<JitBlock*>& sources = it->second;
+    const auto source = std::find(sources.begin(), sources.end(), &block);
+    if (source != sources.end())
+    {
+      *source = sources.back();
+      sources.pop_back();
+    }
+    if (sources.empty())
       links_to.erase(it);
   }
 
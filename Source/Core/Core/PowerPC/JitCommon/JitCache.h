@@ -4,21 +4,21 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <bitset>
 #include <chrono>
 #include <cstring>
 #include <functional>
-#include <map>
 #include <memory>
 #include <set>
 #include <type_traits>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Core/HW/Memmap.h"
 #include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/JitCommon/JitDiskCache.h"
 
 class JitBase;
 
@@ -81,6 +81,7 @@ struct JitBlock : public JitBlockData
     Clock::time_point time_start;
   };
 
+  JitBlock() = default;
   explicit JitBlock(bool profiling_enabled)
       : profile_data(profiling_enabled ? std::make_unique<ProfileData>() : nullptr)
   {
@@ -102,10 +103,16 @@ struct JitBlock : public JitBlockData
   };
   std::vector<LinkData> linkData;
 
-  // This set stores all physical addresses of all occupied instructions.
-  std::set<u32> physical_addresses;
+  // The physical addresses of all occupied instructions, sorted in ascending order.
+  std::vector<u32> physical_addresses;
 
   std::unique_ptr<ProfileData> profile_data;
+
+  // Number of runs left before a first tier block gets recompiled. Decremented by the block.
+  u32 tier_up_countdown = 0;
+
+  // Increases with every allocated block, so that old blocks can be evicted first.
+  u64 allocation_sequence = 0;
 };
 
 typedef void (*CompiledCode)();
@@ -144,8 +151,8 @@ class JitBaseBlockCache
 {
 public:
   // The size of the fast map is determined like this:
-  // ((4 GiB guest memory space) / (4-byte alignment) * sizeof(JitBlock*)) << (3 feature flag bits)
-  static constexpr u64 FAST_BLOCK_MAP_SIZE = 0x10'0000'0000;
+  // ((4 GiB guest memory space) / (4-byte alignment) * sizeof(JitBlock*)) << (4 feature flag bits)
+  static constexpr u64 FAST_BLOCK_MAP_SIZE = 0x20'0000'0000;
   static constexpr u32 FAST_BLOCK_MAP_FALLBACK_ELEMENTS = 0x10000;
   static constexpr u32 FAST_BLOCK_MAP_FALLBACK_MASK = FAST_BLOCK_MAP_FALLBACK_ELEMENTS - 1;
 
@@ -164,6 +171,13 @@ public:
 
   JitBlock* AllocateBlock(u32 em_address);
   void FinalizeBlock(JitBlock& block, bool block_link, const std::set<u32>& physical_addresses);
+  // Frees a block from AllocateBlock() which couldn't be compiled and was never finalized.
+  void DiscardBlock(JitBlock& block);
+
+  // Destroys the older half of the blocks to make room in the code regions, which is much cheaper
+  // than clearing the cache and recompiling everything. Blocks which were recompiled because they
+  // are hot are kept. Returns the number of destroyed blocks.
+  size_t EvictOldBlocks();
 
   // Look for the block in the slow but accurate way.
   // This function shall be used if FastLookupIndexForAddress() failed.
@@ -182,6 +196,24 @@ public:
 
   u32* GetBlockBitSet() const;
 
+  struct Statistics
+  {
+    u64 blocks_compiled;
+    u64 blocks_invalidated;
+    u64 clears;
+    u64 evictions;
+    u64 blocks_evicted;
+    u64 live_blocks;
+    u64 live_code_bytes;
+  };
+
+  // Totals of the block cache of the running JIT. Can be called from any thread.
+  static Statistics GetStatistics();
+
+  // Applies and records the persistent hints for a block which is about to be compiled.
+  void ProcessBlockForDiskCache(const PPCAnalyst::CodeBlock& code_block,
+                                const PPCAnalyst::CodeBuffer& code_buffer);
+
 protected:
   virtual void DestroyBlock(JitBlock& block);
 
@@ -195,30 +227,67 @@ private:
   void LinkBlock(JitBlock& block);
   void UnlinkBlock(const JitBlock& block);
   void InvalidateICacheInternal(u32 physical_address, u32 address, u32 length, bool forced);
+  void EraseModifiedCodeHints(u32 address, u32 length);
 
   JitBlock* MoveBlockIntoFastCache(u32 em_address, CPUEmuFeatureFlags feature_flags);
 
   // Fast but risky block lookup based on fast_block_map.
   size_t FastLookupIndexForAddress(u32 address, u32 msr);
 
+  JitBlock* AllocateBlockStorage();
+  void FreeBlockStorage(JitBlock* block);
+  void RemoveFromBlockMap(const JitBlock& block);
+  void RemoveFromBlockRangeMap(const JitBlock& block, u32 skipped_macro_block);
+  void AddToPageBlockCounts(const JitBlock& block);
+  void RemoveFromPageBlockCounts(const JitBlock& block);
+  bool RangeContainsBlocks(u32 physical_address, u32 length) const;
+
+  // An entry of block_map. The lookup keys are duplicated from the block so that
+  // scanning a bucket doesn't have to touch the (much larger) blocks themselves.
+  struct BlockMapEntry
+  {
+    u32 physical_address;
+    u32 effective_address;
+    CPUEmuFeatureFlags feature_flags;
+    JitBlock* block;
+  };
+
+  // Storage for all blocks. Blocks are allocated from fixed-size chunks so that they stay
+  // close together in memory and never move; the slots of destroyed blocks are recycled.
+  static constexpr size_t BLOCK_SLAB_CHUNK_ELEMENTS = 0x400;
+  std::vector<std::unique_ptr<JitBlock[]>> m_block_slab;
+  std::vector<JitBlock*> m_free_blocks;
+  size_t m_block_slab_used = 0;
+  u64 m_next_allocation_sequence = 0;
+
   // links_to hold all exit points of all valid blocks in a reverse way.
   // It is used to query all blocks which links to an address.
-  std::unordered_map<u32, std::unordered_set<JitBlock*>> links_to;  // destination_PC -> number
+  std::unordered_map<u32, std::vector<JitBlock*>> links_to;  // destination_PC -> blocks
 
-  // Map indexed by the physical address of the entry point.
+  // Map indexed by the page of the physical address of the entry point.
   // This is used to query the block based on the current PC in a slow way.
-  std::multimap<u32, JitBlock> block_map;  // start_addr -> block
+  static constexpr u32 BLOCK_MAP_PAGE_SHIFT = 12;
+  std::unordered_map<u32, std::vector<BlockMapEntry>> block_map;  // start_addr >> shift -> blocks
 
-  // Range of overlapping code indexed by a masked physical address.
-  // This is used for invalidation of memory regions. The range is grouped
+  // Range of overlapping code indexed by a physical address divided by the size of a
+  // macro block. This is used for invalidation of memory regions. The range is grouped
   // in macro blocks of each 0x100 bytes.
   static constexpr u32 BLOCK_RANGE_MAP_ELEMENTS = 0x100;
-  std::map<u32, std::unordered_set<JitBlock*>> block_range_map;
+  std::unordered_map<u32, std::vector<JitBlock*>> block_range_map;
+
+  // Hints about blocks that are kept across sessions.
+  JitDiskCache m_disk_cache;
 
   // This bitsets shows which cachelines overlap with any blocks.
   // It is used to provide a fast way to query if no icache invalidation is needed.
   ValidBlockBitSet valid_block;
 
+  // The number of blocks which overlap each physical page. Unlike valid_block, this is exact, so
+  // invalidations of large ranges can skip the pages without any code in constant time.
+  static constexpr u32 CODE_PAGE_SHIFT = 12;
+  static constexpr u64 CODE_PAGE_COUNT = (1ULL << 32) >> CODE_PAGE_SHIFT;
+  std::unique_ptr<u32[]> m_page_block_counts;
+
   // This contains the entry points for each block.
   // It is used by the assembly dispatcher to quickly
   // know where to jump based on pc and msr bits.
@@ -0,0 +1,144 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/JitCommon/JitDiskCache.h"
+
+#include <algorithm>
+
+#include <fmt/format.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/PowerPC.h"
+
+JitDiskCache::JitDiskCache(JitBase& jit) : m_jit(jit)
+{
+}
+
+void JitDiskCache::Shutdown()
+{
+  Close();
+  m_game_id.clear();
+}
+
+void JitDiskCache::UpdateGame()
+{
+  const bool enabled = Config::Get(Config::MAIN_JIT_PERSISTENT_CACHE);
+  const std::string& game_id = SConfig::GetInstance().GetGameID();
+  if (enabled == m_enabled && game_id == m_game_id)
+    return;
+
+  Close();
+  m_enabled = enabled;
+  m_game_id = game_id;
+  if (m_enabled && !m_game_id.empty())
+    Open(m_game_id);
+}
+
+void JitDiskCache::Open(const std::string& game_id)
+{
+  const std::string dir = File::GetUserPath(D_CACHE_IDX) + JITCACHE_DIR DIR_SEP;
+  if (!File::IsDirectory(dir))
+    File::CreateFullPath(dir);
+
+  const std::string filename = fmt::format("{}{}.cache", dir, game_id);
+  const u32 count = m_disk_cache.Open(filename);
+  INFO_LOG_FMT(DYNA_REC, "Opened {} with {} cached JIT block hints", filename, count);
+}
+
+void JitDiskCache::Close()
+{
+  m_disk_cache.Sync();
+  m_disk_cache.Close();
+  m_hints.clear();
+}
+
+JitDiskCache::Key JitDiskCache::MakeKey(const PPCAnalyst::CodeBlock& code_block,
+                                        const PPCAnalyst::CodeBuffer& code_buffer,
+                                        u32 feature_flags)
+{
+  u32 crc = Common::StartCRC32();
+  for (u32 i = 0; i < code_block.m_num_instructions; ++i)
+  {
+    const PPCAnalyst::CodeOp& op = code_buffer[i];
+    const u32 words[2] = {op.address, op.inst.hex};
+    crc = Common::UpdateCRC32(crc, reinterpret_cast<const u8*>(words), sizeof(words));
+  }
+
+  return {code_block.m_address, feature_flags, code_block.m_num_instructions, crc};
+}
+
+std::vector<u32> JitDiskCache::GatherHints(const PPCAnalyst::CodeBlock& code_block,
+                                           const PPCAnalyst::CodeBuffer& code_buffer) const
+{
+  const auto& js = m_jit.js;
+  std::vector<u32> hints;
+
+  if (js.pairedQuantizeAddresses.contains(code_block.m_address))
+    hints.push_back(HINT_PAIRED_QUANTIZE);
+  if (js.noSpeculativeConstantsAddresses.contains(code_block.m_address))
+    hints.push_back(HINT_NO_SPECULATIVE_CONSTANTS);
+
+  for (u32 i = 0; i < code_block.m_num_instructions; ++i)
+  {
+    if (js.fifoWriteAddresses.contains(code_buffer[i].address))
+      hints.push_back(i << HINT_KIND_BITS | HINT_FIFO_WRITE);
+  }
+
+  return hints;
+}
+
+void JitDiskCache::ApplyHints(const std::vector<u32>& hints,
+                              const PPCAnalyst::CodeBlock& code_block,
+                              const PPCAnalyst::CodeBuffer& code_buffer)
+{
+  auto& js = m_jit.js;
+  for (const u32 hint : hints)
+  {
+    const u32 index = hint >> HINT_KIND_BITS;
+    if (index >= code_block.m_num_instructions)
+      continue;
+
+    switch (hint & ((1 << HINT_KIND_BITS) - 1))
+    {
+    case HINT_FIFO_WRITE:
+      js.fifoWriteAddresses.insert(code_buffer[index].address);
+      break;
+    case HINT_PAIRED_QUANTIZE:
+      js.pairedQuantizeAddresses.insert(code_block.m_address);
+      break;
+    case HINT_NO_SPECULATIVE_CONSTANTS:
+      js.noSpeculativeConstantsAddresses.insert(code_block.m_address);
+      break;
+    }
+  }
+}
+
+void JitDiskCache::ProcessBlock(const PPCAnalyst::CodeBlock& code_block,
+                                const PPCAnalyst::CodeBuffer& code_buffer)
+{
+  UpdateGame();
+  if (!m_enabled || m_game_id.empty() || code_block.m_num_instructions == 0)
+    return;
+
+  const Key key = MakeKey(code_block, code_buffer, m_jit.m_ppc_state.feature_flags);
+  std::vector<u32> stored_hints;
+  if (const auto it = m_hints.find(key); it != m_hints.end())
+    stored_hints = it->second;
+  else if (const auto value = m_disk_cache.Lookup(key))
+    stored_hints.assign(value->begin(), value->end());
+  ApplyHints(stored_hints, code_block, code_buffer);
+
+  // Anything learned since the block was last stored ends up as a new, larger entry.
+  std::vector<u32> hints = GatherHints(code_block, code_buffer);
+  if (hints.empty() || hints == stored_hints)
+    return;
+
+  m_disk_cache.Append(key, hints.data(), static_cast<u32>(hints.size()));
+  m_hints[key] = std::move(hints);
+}
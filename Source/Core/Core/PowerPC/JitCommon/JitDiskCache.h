@@ -0,0 +1,78 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/LinearDiskCache.h"
+#include "Core/PowerPC/PPCAnalyst.h"
+
+class JitBase;
+
+// Persists, per title, what the JIT learned about blocks at runtime so that the next session
+// can compile them correctly on the first try.
+//
+// Blocks normally get compiled optimistically: stores are assumed not to hit the gather pipe,
+// paired loads/stores are assumed to use simple quantizers and constant propagation is
+// speculative. When such an assumption turns out to be wrong, the block is invalidated and
+// recompiled with the matching exception check. This cache remembers those decisions, keyed
+// by a hash of the guest instructions of the block, and seeds them before the block is first
+// compiled in later sessions.
+//
+// Emitted host code isn't stored, since it embeds absolute addresses of asm routines and
+// other blocks and isn't relocatable.
+class JitDiskCache final
+{
+public:
+  explicit JitDiskCache(JitBase& jit);
+
+  void Shutdown();
+
+  // Called after a block has been analysed and before it is emitted.
+  // Applies the hints known for this block, and records new ones for the next session.
+  void ProcessBlock(const PPCAnalyst::CodeBlock& code_block,
+                    const PPCAnalyst::CodeBuffer& code_buffer);
+
+private:
+  struct Key
+  {
+    u32 effective_address;
+    u32 feature_flags;
+    u32 num_instructions;
+    u32 code_hash;
+
+    auto operator<=>(const Key&) const = default;
+  };
+
+  // A hint is stored as the index of the instruction within the block and the kind of hint.
+  enum HintKind : u32
+  {
+    HINT_FIFO_WRITE = 0,
+    HINT_PAIRED_QUANTIZE = 1,
+    HINT_NO_SPECULATIVE_CONSTANTS = 2,
+  };
+  static constexpr u32 HINT_KIND_BITS = 2;
+
+  void UpdateGame();
+  void Open(const std::string& game_id);
+  void Close();
+
+  static Key MakeKey(const PPCAnalyst::CodeBlock& code_block,
+                     const PPCAnalyst::CodeBuffer& code_buffer, u32 feature_flags);
+  std::vector<u32> GatherHints(const PPCAnalyst::CodeBlock& code_block,
+                               const PPCAnalyst::CodeBuffer& code_buffer) const;
+  void ApplyHints(const std::vector<u32>& hints, const PPCAnalyst::CodeBlock& code_block,
+                  const PPCAnalyst::CodeBuffer& code_buffer);
+
+  JitBase& m_jit;
+
+  bool m_enabled = false;
+  std::string m_game_id;
+  // Hints stored during this session. Older ones are looked up in m_disk_cache when needed.
+  std::map<Key, std::vector<u32>> m_hints;
+  Common::LinearDiskCache<Key, u32> m_disk_cache;
+};
@@ -15,6 +15,7 @@
 #include "Common/MsgHandler.h"
 
 #include "Core/Core.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
@@ -110,7 +111,9 @@ static std::string_view GetDescription(const CPUEmuFeatureFlags flags)
 {
   static constexpr std::array<std::string_view, (FEATURE_FLAG_END_OF_ENUMERATION - 1) << 1>
       descriptions = {
-          "", "DR", "IR", "DR|IR", "PERFMON", "DR|PERFMON", "IR|PERFMON", "DR|IR|PERFMON",
+          "", "DR", "IR", "DR|IR", "PERFMON", "DR|PERFMON", "IR|PERFMON", "DR|IR|PERFMON", "NI",
+          "DR|NI", "IR|NI", "DR|IR|NI", "PERFMON|NI", "DR|PERFMON|NI", "IR|PERFMON|NI",
+          "DR|IR|PERFMON|NI",
       };
   return descriptions[flags];
 }
@@ -226,6 +229,11 @@ JitInterface::GetHostCode(u32 address) const
 
 bool JitInterface::HandleFault(uintptr_t access_address, SContext* ctx)
 {
+  // Writes to pages which are write-protected to track modifications of texture memory can come
+  // from any thread, so check for them before anything else.
+  if (m_system.GetMemory().HandleWriteTrackingFault(access_address))
+    return true;
+
   // Prevent nullptr dereference on a crash with no JIT present
   if (!m_jit)
   {
@@ -313,6 +321,9 @@ void JitInterface::CompileExceptionCheck(ExceptionType type)
   case ExceptionType::SpeculativeConstants:
     exception_addresses = &m_jit->js.noSpeculativeConstantsAddresses;
     break;
+  case ExceptionType::HotBlock:
+    exception_addresses = &m_jit->js.hotBlockAddresses;
+    break;
   }
 
   auto& ppc_state = m_system.GetPPCState();
@@ -333,7 +344,7 @@ void JitInterface::CompileExceptionCheck(ExceptionType type)
     exception_addresses->insert(ppc_state.pc);
 
     // Invalidate the JIT block so that it gets recompiled with the external exception check
-    // included.
+    // included (or, for hot blocks, with all optimizations).
     m_jit->GetBlockCache()->InvalidateICache(ppc_state.pc, 4, true);
   }
 }
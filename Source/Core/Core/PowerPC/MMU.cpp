@@ -577,30 +577,89 @@ void MMU::Memcheck(u32 address, u64 var, bool write, size_t size)
   m_ppc_state.Exceptions |= EXCEPTION_DSI | EXCEPTION_FAKE_MEMCHECK_HIT;
 }
 
+u8* MMU::GetHostPointerForFastAccess(const u32 em_address, const u32 size) const
+{
+  // The data cache, uncached memory and accesses spanning two BAT pages (which may not be
+  // contiguous in host memory) are left to the slow path.
+  if (m_ppc_state.m_enable_dcache)
+    return nullptr;
+
+  const u32 offset = em_address & (BAT_PAGE_SIZE - 1);
+  if (offset + size > BAT_PAGE_SIZE)
+    return nullptr;
+
+  void* page;
+  if (m_ppc_state.msr.DR)
+  {
+    // BAT_PHYSICAL_BIT is only set for cached pages backed by memory without memchecks.
+    if ((m_dbat_table[em_address >> BAT_INDEX_SHIFT] & BAT_PHYSICAL_BIT) == 0)
+      return nullptr;
+    page = m_memory.GetLogicalPageMapping(em_address);
+  }
+  else
+  {
+    page = m_memory.GetPhysicalPageMapping(em_address);
+  }
+
+  return page ? static_cast<u8*>(page) + offset : nullptr;
+}
+
+template <typename T>
+bool MMU::TryReadFromMappedMemory(const u32 em_address, T* value) const
+{
+  const u8* ptr = GetHostPointerForFastAccess(em_address, sizeof(T));
+  if (!ptr)
+    return false;
+
+  std::memcpy(value, ptr, sizeof(T));
+  *value = bswap(*value);
+  return true;
+}
+
+template <typename T>
+bool MMU::TryWriteToMappedMemory(const u32 em_address, T value) const
+{
+  u8* ptr = GetHostPointerForFastAccess(em_address, sizeof(T));
+  if (!ptr)
+    return false;
+
+  value = bswap(value);
+  std::memcpy(ptr, &value, sizeof(T));
+  return true;
+}
+
 u8 MMU::Read_U8(const u32 address)
 {
-  u8 var = ReadFromHardware<XCheckTLBFlag::Read, u8>(address);
+  u8 var;
+  if (!TryReadFromMappedMemory(address, &var))
+    var = ReadFromHardware<XCheckTLBFlag::Read, u8>(address);
   Memcheck(address, var, false, 1);
   return var;
 }
 
 u16 MMU::Read_U16(const u32 address)
 {
-  u16 var = ReadFromHardware<XCheckTLBFlag::Read, u16>(address);
+  u16 var;
+  if (!TryReadFromMappedMemory(address, &var))
+    var = ReadFromHardware<XCheckTLBFlag::Read, u16>(address);
   Memcheck(address, var, false, 2);
   return var;
 }
 
 u32 MMU::Read_U32(const u32 address)
 {
-  u32 var = ReadFromHardware<XCheckTLBFlag::Read, u32>(address);
+  u32 var;
+  if (!TryReadFromMappedMemory(address, &var))
+    var = ReadFromHardware<XCheckTLBFlag::Read, u32>(address);
   Memcheck(address, var, false, 4);
   return var;
 }
 
 u64 MMU::Read_U64(const u32 address)
 {
-  u64 var = ReadFromHardware<XCheckTLBFlag::Read, u64>(address);
+  u64 var;
+  if (!TryReadFromMappedMemory(address, &var))
+    var = ReadFromHardware<XCheckTLBFlag::Read, u64>(address);
   Memcheck(address, var, false, 8);
   return var;
 }
@@ -683,13 +742,15 @@ std::optional<ReadResult<double>> MMU::HostTryReadF64(const Core::CPUThreadGuard
 void MMU::Write_U8(const u32 var, const u32 address)
 {
   Memcheck(address, var, true, 1);
-  WriteToHardware<XCheckTLBFlag::Write>(address, var, 1);
+  if (!TryWriteToMappedMemory(address, static_cast<u8>(var)))
+    WriteToHardware<XCheckTLBFlag::Write>(address, var, 1);
 }
 
 void MMU::Write_U16(const u32 var, const u32 address)
 {
   Memcheck(address, var, true, 2);
-  WriteToHardware<XCheckTLBFlag::Write>(address, var, 2);
+  if (!TryWriteToMappedMemory(address, static_cast<u16>(var)))
+    WriteToHardware<XCheckTLBFlag::Write>(address, var, 2);
 }
 void MMU::Write_U16_Swap(const u32 var, const u32 address)
 {
@@ -699,7 +760,8 @@ void MMU::Write_U16_Swap(const u32 var, const u32 address)
 void MMU::Write_U32(const u32 var, const u32 address)
 {
   Memcheck(address, var, true, 4);
-  WriteToHardware<XCheckTLBFlag::Write>(address, var, 4);
+  if (!TryWriteToMappedMemory(address, var))
+    WriteToHardware<XCheckTLBFlag::Write>(address, var, 4);
 }
 void MMU::Write_U32_Swap(const u32 var, const u32 address)
 {
@@ -709,6 +771,8 @@ void MMU::Write_U32_Swap(const u32 var, const u32 address)
 void MMU::Write_U64(const u64 var, const u32 address)
 {
   Memcheck(address, var, true, 8);
+  if (TryWriteToMappedMemory(address, var))
+    return;
   WriteToHardware<XCheckTLBFlag::Write>(address, static_cast<u32>(var >> 32), 4);
   WriteToHardware<XCheckTLBFlag::Write>(address + sizeof(u32), static_cast<u32>(var), 4);
 }
@@ -990,6 +1054,58 @@ bool MMU::HostIsRAMAddress(const Core::CPUThreadGuard& guard, u32 address,
   return false;
 }
 
+std::span<const u8> MMU::HostGetPageSpan(const Core::CPUThreadGuard& guard, u32 address,
+                                         RequestedAddressSpace space)
+{
+  return HostGetWritablePageSpan(guard, address, space);
+}
+
+std::span<u8> MMU::HostGetWritablePageSpan(const Core::CPUThreadGuard& guard, u32 address,
+                                           RequestedAddressSpace space)
+{
+  auto& mmu = guard.GetSystem().GetMMU();
+  const size_t size = HW_PAGE_SIZE - (address & HW_PAGE_MASK);
+
+  bool translate = false;
+  switch (space)
+  {
+  case RequestedAddressSpace::Effective:
+    translate = mmu.m_ppc_state.msr.DR;
+    break;
+  case RequestedAddressSpace::Physical:
+    break;
+  case RequestedAddressSpace::Virtual:
+    if (!mmu.m_ppc_state.msr.DR)
+      return {};
+    translate = true;
+    break;
+  }
+
+  if (translate)
+  {
+    auto translate_address = mmu.TranslateAddress<XCheckTLBFlag::NoException>(address);
+    if (!translate_address.Success())
+      return {};
+    address = translate_address.address;
+  }
+
+  // Same order of checks as ReadFromHardware, limited to what IsRAMAddress accepts
+  Memory::MemoryManager& memory = mmu.m_memory;
+  const u32 segment = address >> 28;
+  if (memory.GetL1Cache() && segment == 0xE && address < (0xE0000000 + memory.GetL1CacheSize()))
+  {
+    return std::span(&memory.GetL1Cache()[address & 0x0FFFFFFF], size);
+  }
+  if (memory.GetRAM() && segment == 0x0 && (address & 0x0FFFFFFF) < memory.GetRamSizeReal())
+    return std::span(&memory.GetRAM()[address & memory.GetRamMask()], size);
+  if (memory.GetEXRAM() && segment == 0x1 && (address & 0x0FFFFFFF) < memory.GetExRamSizeReal())
+    return std::span(&memory.GetEXRAM()[address & 0x0FFFFFFF], size);
+  if (memory.GetFakeVMEM() && (address & 0xFE000000) == 0x7E000000)
+    return std::span(&memory.GetFakeVMEM()[address & memory.GetFakeVMemMask()], size);
+
+  return {};
+}
+
 bool MMU::HostIsInstructionRAMAddress(const Core::CPUThreadGuard& guard, u32 address,
                                       RequestedAddressSpace space)
 {
@@ -1324,6 +1440,13 @@ void MMU::SDRUpdated()
 
   m_ppc_state.pagetable_base = htaborg << 16;
   m_ppc_state.pagetable_hashmask = ((htabmask << 10) | 0x3ff);
+
+  m_memory.UnmapAllPageTableEntries();
+}
+
+void MMU::SRUpdated(u32 index)
+{
+  m_memory.UnmapPageTableEntriesInSegment(index);
 }
 
 enum class TLBLookupResult
@@ -1335,7 +1458,7 @@ enum class TLBLookupResult
 
 static TLBLookupResult LookupTLBPageAddress(PowerPC::PowerPCState& ppc_state,
                                             const XCheckTLBFlag flag, const u32 vpa, const u32 vsid,
-                                            u32* paddr, bool* wi)
+                                            u32* paddr, bool* wi, bool* changed)
 {
   const u32 tag = vpa >> HW_PAGE_INDEX_SHIFT;
   const size_t tlb_index = IsOpcodeFlag(flag) ? PowerPC::INST_TLB_INDEX : PowerPC::DATA_TLB_INDEX;
@@ -1361,6 +1484,7 @@ static TLBLookupResult LookupTLBPageAddress(PowerPC::PowerPCState& ppc_state,
 
     *paddr = tlbe.paddr[0] | (vpa & 0xfff);
     *wi = (pte2.WIMG & 0b1100) != 0;
+    *changed = pte2.C != 0;
 
     return TLBLookupResult::Found;
   }
@@ -1384,6 +1508,7 @@ static TLBLookupResult LookupTLBPageAddress(PowerPC::PowerPCState& ppc_state,
 
     *paddr = tlbe.paddr[1] | (vpa & 0xfff);
     *wi = (pte2.WIMG & 0b1100) != 0;
+    *changed = pte2.C != 0;
 
     return TLBLookupResult::Found;
   }
@@ -1413,6 +1538,49 @@ void MMU::InvalidateTLBEntry(u32 address)
 
   m_ppc_state.tlb[PowerPC::DATA_TLB_INDEX][entry_index].Invalidate();
   m_ppc_state.tlb[PowerPC::INST_TLB_INDEX][entry_index].Invalidate();
+
+  m_memory.UnmapPageTableEntries(address);
+}
+
+void MMU::MapPageTableEntry(u32 effective_address, u32 physical_address, bool changed, bool wi)
+{
+  // Unless the C bit is already set, the first write to the page has to come through here so that
+  // the bit gets set. Uncached memory isn't mapped for the same reasons as with BATs.
+  if (!changed || wi || !m_memory.CanMapPageTableEntry(effective_address))
+    return;
+
+  // Fast accesses don't support memchecks
+  if (m_power_pc.GetMemChecks().OverlapsMemcheck(effective_address & ~HW_PAGE_MASK, HW_PAGE_SIZE))
+    return;
+
+  m_memory.MapPageTableEntry(effective_address, physical_address);
+}
+
+bool MMU::HandleFastmemPageFault(u32 effective_address)
+{
+  if (!m_memory.CanMapPageTableEntry(effective_address))
+    return false;
+
+  // The faulting access is a real access, so updating the R bit and the TLB like a read would is
+  // fine. If the page table translates the address, this maps the page.
+  TranslateAddress<XCheckTLBFlag::Read>(effective_address);
+  return !m_memory.CanMapPageTableEntry(effective_address);
+}
+
+// Returns a host pointer to a PTEG if it is in RAM, which it practically always is.
+static const u8* GetPTEGPointer(Memory::MemoryManager& memory, u32 pteg_addr)
+{
+  // PTEGs are 64-byte aligned, so one never crosses the end of a RAM mirror.
+  if (memory.GetRAM() && (pteg_addr & 0xF8000000) == 0x00000000)
+    return &memory.GetRAM()[pteg_addr & memory.GetRamMask()];
+
+  if (memory.GetEXRAM() && (pteg_addr >> 28) == 0x1 &&
+      (pteg_addr & 0x0FFFFFFF) < memory.GetExRamSizeReal())
+  {
+    return &memory.GetEXRAM()[pteg_addr & 0x0FFFFFFF];
+  }
+
+  return nullptr;
 }
 
 // Page Address Translation
@@ -1426,10 +1594,14 @@ MMU::TranslateAddressResult MMU::TranslatePageAddress(const EffectiveAddress add
   // This catches 99%+ of lookups in practice, so the actual page table entry code below doesn't
   // benefit much from optimization.
   u32 translated_address = 0;
-  const TLBLookupResult res =
-      LookupTLBPageAddress(m_ppc_state, flag, address.Hex, VSID, &translated_address, wi);
+  bool changed = false;
+  const TLBLookupResult res = LookupTLBPageAddress(m_ppc_state, flag, address.Hex, VSID,
+                                                   &translated_address, wi, &changed);
   if (res == TLBLookupResult::Found)
   {
+    if constexpr (flag == XCheckTLBFlag::Read || flag == XCheckTLBFlag::Write)
+      MapPageTableEntry(address.Hex, translated_address, changed, *wi);
+
     return TranslateAddressResult{TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED,
                                   translated_address};
   }
@@ -1468,15 +1640,22 @@ MMU::TranslateAddressResult MMU::TranslatePageAddress(const EffectiveAddress add
 
     u32 pteg_addr = ((hash & m_ppc_state.pagetable_hashmask) << 6) | m_ppc_state.pagetable_base;
 
+    // Unless the data cache is emulated, reading a PTE is a plain RAM read, so scan the PTEG
+    // directly rather than calling ReadFromHardware for every PTE.
+    const u8* pteg_ptr =
+        m_ppc_state.m_enable_dcache ? nullptr : GetPTEGPointer(m_memory, pteg_addr);
+
     for (int i = 0; i < 8; i++, pteg_addr += 8)
     {
       constexpr XCheckTLBFlag pte_read_flag =
           IsNoExceptionFlag(flag) ? XCheckTLBFlag::NoException : XCheckTLBFlag::Read;
-      const u32 pteg = ReadFromHardware<pte_read_flag, u32, true>(pteg_addr);
+      const u32 pteg = pteg_ptr ? Common::swap32(pteg_ptr + i * 8) :
+                                  ReadFromHardware<pte_read_flag, u32, true>(pteg_addr);
 
       if (pte1.Hex == pteg)
       {
-        UPTE_Hi pte2(ReadFromHardware<pte_read_flag, u32, true>(pteg_addr + 4));
+        UPTE_Hi pte2(pteg_ptr ? Common::swap32(pteg_ptr + i * 8 + 4) :
+                                ReadFromHardware<pte_read_flag, u32, true>(pteg_addr + 4));
 
         // set the access bits
         switch (flag)
@@ -1507,6 +1686,9 @@ MMU::TranslateAddressResult MMU::TranslatePageAddress(const EffectiveAddress add
 
         *wi = (pte2.WIMG & 0b1100) != 0;
 
+        if constexpr (flag == XCheckTLBFlag::Read || flag == XCheckTLBFlag::Write)
+          MapPageTableEntry(address.Hex, pte2.RPN << 12, pte2.C != 0, *wi);
+
         return TranslateAddressResult{TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED,
                                       (pte2.RPN << 12) | offset};
       }
@@ -1642,6 +1824,7 @@ void MMU::DBATUpdated()
 #ifndef _ARCH_32
   m_memory.UpdateLogicalMemory(m_dbat_table);
 #endif
+  ++m_dbat_generation;
 
   // IsOptimizable*Address and dcbz depends on the BAT mapping, so we need a flush here.
   m_system.GetJitInterface().ClearSafe();
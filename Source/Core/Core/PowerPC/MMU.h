@@ -6,6 +6,7 @@
 #include <array>
 #include <cstddef>
 #include <optional>
+#include <span>
 #include <string>
 
 #include "Common/BitField.h"
@@ -202,6 +203,16 @@ public:
   static bool HostIsRAMAddress(const Core::CPUThreadGuard& guard, u32 address,
                                RequestedAddressSpace space = RequestedAddressSpace::Effective);
 
+  // Returns the host memory backing the given address in the given address space, from the address
+  // up to the end of its page, or an empty span if the address isn't backed by RAM. This bypasses
+  // the emulated data cache, so it only matches HostRead when that isn't enabled.
+  static std::span<const u8>
+  HostGetPageSpan(const Core::CPUThreadGuard& guard, u32 address,
+                  RequestedAddressSpace space = RequestedAddressSpace::Effective);
+  static std::span<u8>
+  HostGetWritablePageSpan(const Core::CPUThreadGuard& guard, u32 address,
+                          RequestedAddressSpace space = RequestedAddressSpace::Effective);
+
   // Same as HostIsRAMAddress, but uses IBAT instead of DBAT.
   static bool
   HostIsInstructionRAMAddress(const Core::CPUThreadGuard& guard, u32 address,
@@ -238,6 +249,7 @@ public:
 
   // TLB functions
   void SDRUpdated();
+  void SRUpdated(u32 index);
   void InvalidateTLBEntry(u32 address);
   void DBATUpdated();
   void IBATUpdated();
@@ -253,9 +265,18 @@ public:
 
   std::optional<u32> GetTranslatedAddress(u32 address);
 
+  // Called by the JITs when a fastmem access with address translation enabled faults. Returns
+  // true if the page has been mapped into the logical fastmem area, in which case the access only
+  // has to be retried.
+  bool HandleFastmemPageFault(u32 effective_address);
+
   BatTable& GetIBATTable() { return m_ibat_table; }
   BatTable& GetDBATTable() { return m_dbat_table; }
 
+  // Changes whenever the DBAT mapping is rebuilt, so that users which cache results of
+  // IsOptimizableRAMAddress or host pointers for effective addresses know when to redo them.
+  u64 GetDBATGeneration() const { return m_dbat_generation; }
+
 private:
   enum class TranslateAddressResultEnum : u8
   {
@@ -297,6 +318,8 @@ private:
   template <const XCheckTLBFlag flag>
   TranslateAddressResult TranslatePageAddress(const EffectiveAddress address, bool* wi);
 
+  void MapPageTableEntry(u32 effective_address, u32 physical_address, bool changed, bool wi);
+
   void GenerateDSIException(u32 effective_address, bool write);
   void GenerateISIException(u32 effective_address);
 
@@ -305,6 +328,14 @@ private:
   void UpdateBATs(BatTable& bat_table, u32 base_spr);
   void UpdateFakeMMUBat(BatTable& bat_table, u32 start_addr);
 
+  // Returns a host pointer for a data access that can be done directly on the page mappings
+  // Memmap keeps for the current BATs, or nullptr if the access needs to take the slow path.
+  u8* GetHostPointerForFastAccess(u32 em_address, u32 size) const;
+  template <typename T>
+  bool TryReadFromMappedMemory(u32 em_address, T* value) const;
+  template <typename T>
+  bool TryWriteToMappedMemory(u32 em_address, T value) const;
+
   template <XCheckTLBFlag flag, typename T, bool never_translate = false>
   T ReadFromHardware(u32 em_address);
   template <XCheckTLBFlag flag, bool never_translate = false>
@@ -326,6 +357,7 @@ private:
 
   BatTable m_ibat_table;
   BatTable m_dbat_table;
+  u64 m_dbat_generation = 0;
 };
 
 void ClearDCacheLineFromJit(MMU& mmu, u32 address);
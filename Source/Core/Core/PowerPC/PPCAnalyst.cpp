@@ -41,9 +41,6 @@
 
 namespace PPCAnalyst
 {
-// 0 does not perform block merging
-constexpr u32 BRANCH_FOLLOWING_THRESHOLD = 2;
-
 constexpr u32 INVALID_BRANCH_TARGET = 0xFFFFFFFF;
 
 static u32 EvaluateBranchTarget(UGeckoInstruction instr, u32 pc)
@@ -213,8 +210,32 @@ static bool IsSprInstructionUsingMmcr(UGeckoInstruction inst)
   return index == SPR_MMCR0 || index == SPR_MMCR1;
 }
 
+// Blocks are compiled for one value of FPSCR.NI (see FEATURE_FLAG_FPSCR_NI), so instructions
+// which can change it end the block like MMCR writes do.
+static bool IsFPSCRInstructionWritingNI(UGeckoInstruction inst)
+{
+  if (inst.OPCD != 63)
+    return false;
+
+  switch (inst.SUBOP10)
+  {
+  case 38:  // mtfsb1x
+  case 70:  // mtfsb0x
+    return inst.CRBD == 29;
+  case 134:  // mtfsfix
+    return inst.CRFD == 7;
+  case 711:  // mtfsfx
+    return (inst.FM & 1) != 0;
+  default:
+    return false;
+  }
+}
+
 static bool InstructionCanEndBlock(const CodeOp& op)
 {
+  if (IsFPSCRInstructionWritingNI(op.inst))
+    return true;
+
   return (op.opinfo->flags & FL_ENDBLOCK) &&
          (!IsMtspr(op.inst) || IsSprInstructionUsingMmcr(op.inst));
 }
@@ -854,7 +875,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
 
     bool conditional_continue = false;
 
-    // TODO: Find the optimal value for BRANCH_FOLLOWING_THRESHOLD.
+    // TODO: Find the optimal value for DEFAULT_BRANCH_FOLLOWING_THRESHOLD.
     //       If it is small, the performance will be down.
     //       If it is big, the size of generated code will be big and
     //       cache clearning will happen many times.
@@ -885,7 +906,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
       {
         code[i].branchTo = code[caller].address + 4;
         if ((inst.BO & BO_DONT_DECREMENT_FLAG) && (inst.BO & BO_DONT_CHECK_CONDITION) &&
-            numFollows < BRANCH_FOLLOWING_THRESHOLD)
+            numFollows < m_branch_following_threshold)
         {
           // bclrx with unconditional branch = return
           // Follow it if we can propagate the LR value of the last CALL instruction.
@@ -945,7 +966,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer,
     code[i].branchIsIdleLoop =
         code[i].branchTo == block->m_address && IsBusyWaitLoop(block, code, i);
 
-    if (follow && numFollows < BRANCH_FOLLOWING_THRESHOLD)
+    if (follow && numFollows < m_branch_following_threshold)
     {
       // Follow the unconditional branch.
       numFollows++;
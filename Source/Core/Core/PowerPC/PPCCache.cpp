@@ -108,6 +108,7 @@ void Cache::Reset()
 void InstructionCache::Reset(JitInterface& jit_interface)
 {
   Cache::Reset();
+  m_last_block_address = 0xFFFFFFFF;
   jit_interface.ClearSafe();
 }
 
@@ -128,6 +129,7 @@ void InstructionCache::Init(Memory::MemoryManager& memory)
   RefreshConfig();
 
   Cache::Init(memory);
+  m_last_block_address = 0xFFFFFFFF;
 }
 
 void Cache::Store(Memory::MemoryManager& memory, u32 addr)
@@ -381,9 +383,23 @@ u32 InstructionCache::ReadInstruction(Memory::MemoryManager& memory,
   if (!HID0(ppc_state).ICE || m_disable_icache)  // instruction cache is disabled
     return memory.Read_U32(addr);
 
-  u32 value;
-  Read(memory, addr, &value, sizeof(value), HID0(ppc_state).ILOCK);
-  return Common::swap32(value);
+  const u32 block_address = addr & ~31;
+  const u32 word = (addr >> 2) & (CACHE_BLOCK_SIZE - 1);
+  if (block_address == m_last_block_address)
+    return Common::swap32(data[m_last_set][m_last_way][word]);
+
+  const auto [set, way] = GetCache(memory, addr, HID0(ppc_state).ILOCK);
+  if (way == 0xff)
+  {
+    u32 value;
+    memory.CopyFromEmu(&value, addr, sizeof(value));
+    return Common::swap32(value);
+  }
+
+  m_last_block_address = block_address;
+  m_last_set = set;
+  m_last_way = way;
+  return Common::swap32(data[set][way][word]);
 }
 
 void InstructionCache::Invalidate(Memory::MemoryManager& memory, JitInterface& jit_interface,
@@ -410,11 +426,20 @@ void InstructionCache::Invalidate(Memory::MemoryManager& memory, JitInterface& j
   }
   valid[set] = 0;
   modified[set] = 0;
+  if (((m_last_block_address >> 5) & 0x7f) == set)
+    m_last_block_address = 0xFFFFFFFF;
 
   // Also tell the JIT that the corresponding address has been invalidated
   jit_interface.InvalidateICacheLine(addr);
 }
 
+void InstructionCache::DoState(Memory::MemoryManager& memory, PointerWrap& p)
+{
+  Cache::DoState(memory, p);
+  if (p.IsReadMode())
+    m_last_block_address = 0xFFFFFFFF;
+}
+
 void InstructionCache::RefreshConfig()
 {
   m_disable_icache = Config::Get(Config::MAIN_DISABLE_ICACHE);
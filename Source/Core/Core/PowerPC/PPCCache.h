@@ -75,12 +75,21 @@ struct InstructionCache : public Cache
 
   bool m_disable_icache = false;
 
+  // The cache block that the last instruction was fetched from. Fetches from the same block can
+  // skip the lookup, since a block only leaves the cache through another fetch or an invalidation,
+  // and repeating the PLRU update for the same way changes nothing. The address is 32-byte aligned,
+  // so the initial value never matches.
+  u32 m_last_block_address = 0xFFFFFFFF;
+  u32 m_last_set = 0;
+  u32 m_last_way = 0;
+
   InstructionCache() = default;
   ~InstructionCache();
   u32 ReadInstruction(Memory::MemoryManager& memory, PowerPC::PowerPCState& ppc_state, u32 addr);
   void Invalidate(Memory::MemoryManager& memory, JitInterface& jit_interface, u32 addr);
   void Init(Memory::MemoryManager& memory);
   void Reset(JitInterface& jit_interface);
+  void DoState(Memory::MemoryManager& memory, PointerWrap& p);
   void RefreshConfig();
 };
 }  // namespace PowerPC
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <fstream>
 #include <map>
 #include <sstream>
 #include <string>
@@ -15,6 +16,7 @@
 #include <fmt/format.h>
 
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
@@ -489,6 +491,72 @@ bool PPCSymbolDB::SaveSymbolMap(const std::string& filename) const
   return true;
 }
 
+static constexpr std::string_view SYMBOL_CACHE_HEADER = "Dolphin symbol cache 1";
+
+bool PPCSymbolDB::LoadSymbolCache(const Core::CPUThreadGuard& guard, const std::string& filename)
+{
+  std::ifstream file;
+  File::OpenFStream(file, filename, std::ios_base::in);
+  std::string line;
+  if (!file || !std::getline(file, line) || line != SYMBOL_CACHE_HEADER)
+    return false;
+
+  Clear();
+  size_t count = 0;
+  while (std::getline(file, line))
+  {
+    std::istringstream iss(line);
+    u32 address, size, hash;
+    int type;
+    std::string name;
+    if (!(iss >> std::hex >> address >> size >> hash >> std::dec >> type) ||
+        (type != static_cast<int>(Common::Symbol::Type::Function) &&
+         type != static_cast<int>(Common::Symbol::Type::Data)))
+    {
+      ERROR_LOG_FMT(SYMBOLS, "Invalid line in symbol cache {}", filename);
+      Clear();
+      return false;
+    }
+    std::getline(iss >> std::ws, name);
+
+    AddKnownSymbol(guard, address, size, name, static_cast<Common::Symbol::Type>(type));
+    const Common::Symbol* symbol = GetSymbolFromAddr(address);
+    if (!symbol || (symbol->type == Common::Symbol::Type::Function && symbol->hash != hash))
+    {
+      INFO_LOG_FMT(SYMBOLS, "Symbol cache {} doesn't match {} at {:08x}, ignoring it", filename,
+                   name, address);
+      Clear();
+      return false;
+    }
+    ++count;
+  }
+
+  FillInCallers();
+  Index();
+  NOTICE_LOG_FMT(SYMBOLS, "{} symbols loaded from the symbol cache.", count);
+  return true;
+}
+
+bool PPCSymbolDB::SaveSymbolCache(const std::string& filename) const
+{
+  if (!File::CreateFullPath(filename))
+    return false;
+
+  File::IOFile f(filename, "w");
+  if (!f)
+    return false;
+
+  f.WriteString(fmt::format("{}\n", SYMBOL_CACHE_HEADER));
+  for (const auto& function : m_functions)
+  {
+    const Common::Symbol& symbol = function.second;
+    f.WriteString(fmt::format("{:08x} {:08x} {:08x} {} {}\n", symbol.address, symbol.size,
+                              symbol.hash, static_cast<int>(symbol.type), symbol.name));
+  }
+
+  return true;
+}
+
 // Save code map (won't work if Core is running)
 //
 // Notes:
@@ -36,6 +36,13 @@ public:
   bool SaveSymbolMap(const std::string& filename) const;
   bool SaveCodeMap(const Core::CPUThreadGuard& guard, const std::string& filename) const;
 
+  // The symbol cache keeps the functions found with signatures, along with their checksums, so
+  // that they don't have to be searched for and matched again the next time the game boots.
+  // Loading only succeeds if every cached function still has the same checksum. Otherwise the
+  // database is cleared.
+  bool LoadSymbolCache(const Core::CPUThreadGuard& guard, const std::string& filename);
+  bool SaveSymbolCache(const std::string& filename) const;
+
   void PrintCalls(u32 funcAddr) const;
   void PrintCallers(u32 funcAddr) const;
   void LogFunctionCall(u32 addr);
@@ -61,7 +61,7 @@ static void InvalidateCacheThreadSafe(Core::System& system, u64 userdata, s64 cy
 
 PowerPCManager::PowerPCManager(Core::System& system)
     : m_breakpoints(system), m_memchecks(system), m_debug_interface(system, m_symbol_db),
-      m_system(system)
+      m_trace_recorder(m_ppc_state), m_system(system)
 {
 }
 
@@ -306,6 +306,7 @@ void PowerPCManager::Shutdown()
 {
   CPUThreadConfigCallback::RemoveConfigChangedCallback(m_registered_config_callback_id);
   InjectExternalCPUCore(nullptr);
+  m_trace_recorder.Shutdown();
   m_system.GetJitInterface().Shutdown();
   m_system.GetInterpreter().Shutdown();
   m_cpu_core_base = nullptr;
@@ -680,6 +681,10 @@ void RoundingModeUpdated(PowerPCState& ppc_state)
   ASSERT(Core::IsCPUThread());
 
   Common::FPU::SetSIMDMode(ppc_state.fpscr.RN, ppc_state.fpscr.NI);
+
+  ppc_state.feature_flags = static_cast<CPUEmuFeatureFlags>(
+      (ppc_state.feature_flags & ~FEATURE_FLAG_FPSCR_NI) |
+      (ppc_state.fpscr.NI ? FEATURE_FLAG_FPSCR_NI : 0));
 }
 
 void MSRUpdated(PowerPCState& ppc_state)
@@ -690,7 +695,7 @@ void MSRUpdated(PowerPCState& ppc_state)
   static_assert(FEATURE_FLAG_MSR_IR == 1 << 1);
 
   ppc_state.feature_flags = static_cast<CPUEmuFeatureFlags>(
-      (ppc_state.feature_flags & FEATURE_FLAG_PERFMON) | ((ppc_state.msr.Hex >> 4) & 0x3));
+      (ppc_state.feature_flags & ~0x3) | ((ppc_state.msr.Hex >> 4) & 0x3));
 }
 
 void MMCRUpdated(PowerPCState& ppc_state)
@@ -708,8 +713,9 @@ void RecalculateAllFeatureFlags(PowerPCState& ppc_state)
   static_assert(FEATURE_FLAG_MSR_IR == 1 << 1);
 
   const bool perfmon = ppc_state.spr[SPR_MMCR0] || ppc_state.spr[SPR_MMCR1];
-  ppc_state.feature_flags = static_cast<CPUEmuFeatureFlags>(((ppc_state.msr.Hex >> 4) & 0x3) |
-                                                            (perfmon ? FEATURE_FLAG_PERFMON : 0));
+  ppc_state.feature_flags = static_cast<CPUEmuFeatureFlags>(
+      ((ppc_state.msr.Hex >> 4) & 0x3) | (perfmon ? FEATURE_FLAG_PERFMON : 0) |
+      (ppc_state.fpscr.NI ? FEATURE_FLAG_FPSCR_NI : 0));
 }
 
 void CheckExceptionsFromJIT(PowerPCManager& power_pc)
@@ -3,12 +3,16 @@
 
 #include "Core/PowerPC/SignatureDB/MEGASignatureDB.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdlib>
 #include <fstream>
+#include <future>
 #include <limits>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <utility>
 
 #include "Common/FileUtil.h"
@@ -101,21 +105,40 @@ bool GetRefs(MEGASignature* sig, std::istringstream* iss)
   return true;
 }
 
-bool Compare(const Core::CPUThreadGuard& guard, u32 address, u32 size, const MEGASignature& sig)
+bool Compare(std::span<const u32> code, const MEGASignature& sig)
 {
-  if (size != sig.code.size() * sizeof(u32))
-    return false;
-
   for (size_t i = 0; i < sig.code.size(); ++i)
   {
-    if (sig.code[i] != 0 && PowerPC::MMU::HostRead_U32(
-                                guard, static_cast<u32>(address + i * sizeof(u32))) != sig.code[i])
-    {
+    if (sig.code[i] != 0 && code[i] != sig.code[i])
       return false;
-    }
   }
   return true;
 }
+
+u64 GetIndexKey(size_t instruction_count, u32 first_instruction)
+{
+  return (static_cast<u64>(instruction_count) << 32) | first_instruction;
+}
+
+// Runs function(i) for every i in [0, count) spread over all available threads.
+template <typename F>
+void ForEachChunkInParallel(size_t count, F function)
+{
+  const size_t threads =
+      std::min(count, std::max<size_t>(1, std::thread::hardware_concurrency()));
+
+  std::vector<std::future<void>> futures(threads);
+  for (size_t i = 0; i < threads; ++i)
+  {
+    futures[i] = std::async(std::launch::async, [&function, count, threads, i]() {
+      for (size_t j = i; j < count; j += threads)
+        function(j);
+    });
+  }
+
+  for (std::future<void>& future : futures)
+    future.get();
+}
 }  // Anonymous namespace
 
 MEGASignatureDB::MEGASignatureDB() = default;
@@ -124,6 +147,8 @@ MEGASignatureDB::~MEGASignatureDB() = default;
 void MEGASignatureDB::Clear()
 {
   m_signatures.clear();
+  m_index.clear();
+  m_instruction_counts.clear();
 }
 
 bool MEGASignatureDB::Load(const std::string& file_path)
@@ -140,8 +165,10 @@ bool MEGASignatureDB::Load(const std::string& file_path)
     std::istringstream iss(line);
     MEGASignature sig;
 
-    if (GetCode(&sig, &iss) && GetName(&sig, &iss) && GetRefs(&sig, &iss))
+    if (GetCode(&sig, &iss) && GetName(&sig, &iss) && GetRefs(&sig, &iss) && !sig.code.empty())
     {
+      m_index[GetIndexKey(sig.code.size(), sig.code[0])].push_back(m_signatures.size());
+      m_instruction_counts.insert(sig.code.size());
       m_signatures.push_back(std::move(sig));
     }
     else
@@ -158,22 +185,70 @@ bool MEGASignatureDB::Save(const std::string& file_path) const
   return false;
 }
 
-void MEGASignatureDB::Apply(const Core::CPUThreadGuard& guard, PPCSymbolDB* symbol_db) const
+const MEGASignature* MEGASignatureDB::FindSignature(std::span<const u32> code) const
 {
-  for (auto& it : symbol_db->AccessSymbols())
+  // Like going through all signatures in order, the first one in the file wins
+  std::optional<size_t> match;
+  for (const u32 first_instruction : {code[0], 0u})
   {
-    auto& symbol = it.second;
-    for (const auto& sig : m_signatures)
+    const auto it = m_index.find(GetIndexKey(code.size(), first_instruction));
+    if (it == m_index.end())
+      continue;
+
+    for (const size_t i : it->second)
     {
-      if (Compare(guard, symbol.address, symbol.size, sig))
+      if (match && i > *match)
+        break;
+      if (Compare(code, m_signatures[i]))
       {
-        symbol.name = sig.name;
-        INFO_LOG_FMT(SYMBOLS, "Found {} at {:08x} (size: {:08x})!", sig.name, symbol.address,
-                     symbol.size);
+        match = i;
         break;
       }
     }
   }
+  return match ? &m_signatures[*match] : nullptr;
+}
+
+void MEGASignatureDB::Apply(const Core::CPUThreadGuard& guard, PPCSymbolDB* symbol_db) const
+{
+  // Read the code of every symbol which some signature could match up front, so that the
+  // matching itself can run on all threads without going through the MMU
+  std::vector<Common::Symbol*> symbols;
+  std::vector<size_t> code_offsets;
+  std::vector<u32> code;
+  for (auto& it : symbol_db->AccessSymbols())
+  {
+    Common::Symbol& symbol = it.second;
+    const size_t instruction_count = symbol.size / sizeof(u32);
+    if (symbol.size % sizeof(u32) != 0 || !m_instruction_counts.contains(instruction_count))
+      continue;
+
+    symbols.push_back(&symbol);
+    code_offsets.push_back(code.size());
+    for (size_t i = 0; i < instruction_count; ++i)
+    {
+      code.push_back(
+          PowerPC::MMU::HostRead_U32(guard, static_cast<u32>(symbol.address + i * sizeof(u32))));
+    }
+  }
+
+  std::vector<const MEGASignature*> matches(symbols.size());
+  ForEachChunkInParallel(symbols.size(), [&](size_t i) {
+    const std::span<const u32> symbol_code(code.data() + code_offsets[i],
+                                           symbols[i]->size / sizeof(u32));
+    matches[i] = FindSignature(symbol_code);
+  });
+
+  for (size_t i = 0; i < symbols.size(); ++i)
+  {
+    if (!matches[i])
+      continue;
+
+    Common::Symbol& symbol = *symbols[i];
+    symbol.name = matches[i]->name;
+    INFO_LOG_FMT(SYMBOLS, "Found {} at {:08x} (size: {:08x})!", symbol.name, symbol.address,
+                 symbol.size);
+  }
   symbol_db->Index();
 }
 
@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <span>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -58,5 +61,12 @@ public:
            const std::string& name) override;
 
 private:
+  const MEGASignature* FindSignature(std::span<const u32> code) const;
+
   std::vector<MEGASignature> m_signatures;
+
+  // Signatures are looked up by the number of instructions they cover and their first
+  // instruction, which is 0 if it's a wildcard. Each list is in the order of m_signatures.
+  std::unordered_map<u64, std::vector<size_t>> m_index;
+  std::unordered_set<size_t> m_instruction_counts;
 };
@@ -9,6 +9,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
+#include "Core/Boot/Boot.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 
@@ -79,6 +80,12 @@ void SignatureDB::Populate(const PPCSymbolDB* func_db, const std::string& filter
 void SignatureDB::Apply(const Core::CPUThreadGuard& guard, PPCSymbolDB* func_db) const
 {
   m_handler->Apply(guard, func_db);
+
+  // Finding functions and matching them against a large database takes a while, so remember the
+  // result for the next time the game boots
+  const std::string cache_file = CBoot::GetSymbolCacheFile();
+  if (!cache_file.empty() && !func_db->SaveSymbolCache(cache_file))
+    WARN_LOG_FMT(SYMBOLS, "Failed to write the symbol cache {}", cache_file);
 }
 
 bool SignatureDB::Add(const Core::CPUThreadGuard& guard, u32 start_addr, u32 size,
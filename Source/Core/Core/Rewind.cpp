@@ -0,0 +1,247 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/Rewind.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <lz4.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
+#include "Common/WorkQueueThread.h"
+#include "Core/AchievementManager.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
+#include "Core/NetPlayProto.h"
+#include "Core/State.h"
+#include "Core/System.h"
+
+namespace State::Rewind
+{
+// A full state is forced after this many delta states, so that the memory limit can be enforced
+// by dropping whole chains without having to keep an arbitrarily old full state around.
+static constexpr u32 MAX_DELTAS_PER_FULL_STATE = 30;
+
+struct CapturedState
+{
+  bool is_delta;
+  std::vector<u8> data;
+};
+
+struct StoredState
+{
+  bool is_delta;
+  u32 uncompressed_size;
+  std::vector<u8> compressed_data;
+};
+
+static Common::WorkQueueThread<CapturedState> s_compress_thread;
+
+// Compressed states, oldest first. The front entry is always a full state, and every delta state
+// applies on top of the entry before it.
+static std::mutex s_states_mutex;
+static std::deque<StoredState> s_states;
+static size_t s_states_memory = 0;
+// Set by the worker when a state had to be dropped, which breaks the chain of deltas after it.
+static bool s_chain_broken = false;
+
+// Only touched on the CPU thread.
+static u32 s_frames_since_capture = 0;
+static u32 s_deltas_since_full = 0;
+static bool s_have_parent = false;
+static u64 s_parent_generation = 0;
+static std::atomic<bool> s_force_full_state = false;
+
+static bool IsRewindAllowed()
+{
+  return !NetPlay::IsNetPlayRunning() && !AchievementManager::GetInstance().IsHardcoreModeActive();
+}
+
+static void EvictOldStates(size_t memory_limit)
+{
+  while (s_states_memory > memory_limit && !s_states.empty())
+  {
+    // Drop the oldest full state together with every delta state depending on it.
+    auto chain_end = s_states.begin() + 1;
+    while (chain_end != s_states.end() && chain_end->is_delta)
+      ++chain_end;
+
+    if (chain_end == s_states.end())
+    {
+      // The newest chain alone exceeds the limit. Keep it, but start a new chain as soon as
+      // possible so that it can be dropped next time.
+      s_force_full_state = true;
+      return;
+    }
+
+    for (auto it = s_states.begin(); it != chain_end; ++it)
+      s_states_memory -= it->compressed_data.size();
+    s_states.erase(s_states.begin(), chain_end);
+  }
+}
+
+static void CompressState(CapturedState state)
+{
+  const int uncompressed_size = static_cast<int>(state.data.size());
+  StoredState stored{state.is_delta, static_cast<u32>(uncompressed_size), {}};
+
+  bool success = state.data.size() <= LZ4_MAX_INPUT_SIZE;
+  if (success)
+  {
+    stored.compressed_data.resize(LZ4_compressBound(uncompressed_size));
+    const int compressed_size = LZ4_compress_default(
+        reinterpret_cast<const char*>(state.data.data()),
+        reinterpret_cast<char*>(stored.compressed_data.data()), uncompressed_size,
+        static_cast<int>(stored.compressed_data.size()));
+    success = compressed_size > 0;
+    stored.compressed_data.resize(std::max(compressed_size, 0));
+    stored.compressed_data.shrink_to_fit();
+  }
+
+  const size_t memory_limit =
+      static_cast<size_t>(std::max(Config::Get(Config::MAIN_REWIND_MAX_MEMORY_MB), 1)) * 1024 *
+      1024;
+
+  std::lock_guard lk(s_states_mutex);
+
+  if (!success)
+  {
+    ERROR_LOG_FMT(CORE, "Failed to compress rewind state of {} bytes", state.data.size());
+    s_chain_broken = true;
+    s_force_full_state = true;
+    return;
+  }
+
+  if (stored.is_delta && (s_chain_broken || s_states.empty()))
+    return;
+  s_chain_broken = false;
+
+  s_states_memory += stored.compressed_data.size();
+  s_states.push_back(std::move(stored));
+  EvictOldStates(memory_limit);
+}
+
+static bool DecompressState(const StoredState& stored, std::vector<u8>& buffer)
+{
+  buffer.resize(stored.uncompressed_size);
+  const int result = LZ4_decompress_safe(
+      reinterpret_cast<const char*>(stored.compressed_data.data()),
+      reinterpret_cast<char*>(buffer.data()), static_cast<int>(stored.compressed_data.size()),
+      static_cast<int>(buffer.size()));
+  return result == static_cast<int>(stored.uncompressed_size);
+}
+
+void Init(Core::System& system)
+{
+  Clear();
+  s_compress_thread.Reset("Rewind Worker", CompressState);
+}
+
+void Shutdown()
+{
+  s_compress_thread.Shutdown();
+  Clear();
+}
+
+void Clear()
+{
+  {
+    std::lock_guard lk(s_states_mutex);
+    std::deque<StoredState>().swap(s_states);
+    s_states_memory = 0;
+    s_chain_broken = false;
+  }
+
+  s_frames_since_capture = 0;
+  s_deltas_since_full = 0;
+  s_have_parent = false;
+  s_force_full_state = false;
+}
+
+void OnFrameEnd(Core::System& system)
+{
+  if (!Config::Get(Config::MAIN_REWIND_ENABLE) || !IsRewindAllowed())
+    return;
+
+  const u32 interval =
+      static_cast<u32>(std::max(Config::Get(Config::MAIN_REWIND_FRAME_INTERVAL), 1));
+  if (++s_frames_since_capture < interval)
+    return;
+  s_frames_since_capture = 0;
+
+  // A delta state is only usable if the previous rewind state is its parent. Any other savestate
+  // saved or loaded in the meantime moves the parent, so a full state is needed then.
+  auto& memory = system.GetMemory();
+  const bool full = s_force_full_state.exchange(false) || !s_have_parent ||
+                    memory.GetDeltaStateGeneration() != s_parent_generation ||
+                    s_deltas_since_full >= MAX_DELTAS_PER_FULL_STATE;
+
+  CapturedState state{!full, {}};
+  if (full)
+  {
+    SaveToBuffer(system, state.data);
+    s_deltas_since_full = 0;
+  }
+  else
+  {
+    SaveDeltaToBuffer(system, state.data);
+    ++s_deltas_since_full;
+  }
+
+  s_have_parent = true;
+  s_parent_generation = memory.GetDeltaStateGeneration();
+  s_compress_thread.Push(std::move(state));
+}
+
+bool StepBack(Core::System& system)
+{
+  if (!IsRewindAllowed())
+    return false;
+
+  bool success = false;
+  Core::RunOnCPUThread(
+      system,
+      [&] {
+        s_compress_thread.WaitForCompletion();
+
+        std::lock_guard lk(s_states_mutex);
+        if (s_states.empty())
+          return;
+
+        // Restore the newest state by loading the full state its chain starts from and then
+        // applying every delta state on top of it in order.
+        auto chain_start = s_states.end() - 1;
+        while (chain_start != s_states.begin() && chain_start->is_delta)
+          --chain_start;
+
+        std::vector<u8> buffer;
+        success = true;
+        for (auto it = chain_start; it != s_states.end(); ++it)
+        {
+          if (!DecompressState(*it, buffer))
+          {
+            ERROR_LOG_FMT(CORE, "Failed to decompress rewind state");
+            success = false;
+            break;
+          }
+          LoadFromBuffer(system, buffer);
+        }
+
+        s_states_memory -= s_states.back().compressed_data.size();
+        s_states.pop_back();
+
+        // Loading changed the delta state generation, so the next capture starts a new chain.
+        s_frames_since_capture = 0;
+      },
+      true);
+
+  return success;
+}
+}  // namespace State::Rewind
@@ -0,0 +1,28 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// In-memory ring of compressed savestates which allows stepping emulation backwards.
+
+#pragma once
+
+namespace Core
+{
+class System;
+}
+
+namespace State::Rewind
+{
+void Init(Core::System& system);
+void Shutdown();
+
+// Called on the CPU thread at the end of every emulated frame. Every MAIN_REWIND_FRAME_INTERVAL
+// frames, a state is captured and handed to a worker thread for compression. Most captures are
+// delta states which only store the pages of RAM that changed since the previous capture.
+void OnFrameEnd(Core::System& system);
+
+// Restores the most recent captured state and drops it from the buffer, so repeated calls keep
+// stepping further back. Returns false if there is nothing to rewind to.
+bool StepBack(Core::System& system);
+
+void Clear();
+}  // namespace State::Rewind
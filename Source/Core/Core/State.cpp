@@ -6,11 +6,14 @@
 #include <algorithm>
 #include <atomic>
 #include <condition_variable>
+#include <cstring>
 #include <filesystem>
+#include <future>
 #include <locale>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 #include <utility>
@@ -21,6 +24,7 @@
 
 #include <lz4.h>
 #include <lzo/lzo1x.h>
+#include <zstd.h>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -36,6 +40,7 @@
 
 #include "Core/AchievementManager.h"
 #include "Core/Config/AchievementSettings.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -47,6 +52,7 @@
 #include "Core/Movie.h"
 #include "Core/NetPlayClient.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/Rewind.h"
 #include "Core/System.h"
 
 #include "VideoCommon/FrameDumpFFMpeg.h"
@@ -75,9 +81,25 @@ static std::mutex s_undo_load_buffer_mutex;
 
 static std::mutex s_load_or_save_in_progress_mutex;
 
+// A state whose RAM and EXRAM are still in a memory snapshot, so that it is compressed by the
+// worker while emulation goes on.
+struct SnapshotState
+{
+  CompressionType compression_type;
+  std::vector<u8> buffer;
+  std::vector<PointerWrap::Span> spans;
+  std::vector<bool> spans_in_snapshot;
+  // The snapshot only covers RAM and EXRAM, so the other spans are copied.
+  std::vector<std::vector<u8>> span_copies;
+};
+
 struct CompressAndDumpState_args
 {
+  std::optional<SnapshotState> snapshot_state;
+  // Only used for uncompressed states, compressed states are compressed before being queued.
   std::vector<u8> buffer_vector;
+  StateExtendedHeader extended_header;
+  std::vector<std::vector<u8>> compressed_chunks;
   std::string filename;
   std::shared_ptr<Common::Event> state_write_done_event;
 };
@@ -98,14 +120,20 @@ static size_t s_state_writes_in_queue;
 static std::condition_variable s_state_write_queue_is_empty;
 
 // Don't forget to increase this after doing changes on the savestate system
-constexpr u32 STATE_VERSION = 168;  // Last changed in PR 12639
+constexpr u32 STATE_VERSION = 170;  // Last changed for asynchronous IOS requests
 
 // Increase this if the StateExtendedHeader definition changes
-constexpr u32 EXTENDED_HEADER_VERSION = 1;  // Last changed in PR 12217
+constexpr u32 EXTENDED_HEADER_VERSION = 2;  // Last changed for chunked compression
+constexpr u32 LEGACY_EXTENDED_HEADER_VERSION = 1;
 
 // Change this if we ever need to store more data in the extended header
 constexpr u32 COMPRESSED_DATA_OFFSET = 0;
 
+// Compressed states are split into chunks of at most this size, which get compressed and
+// decompressed on several threads at once.
+constexpr u32 COMPRESSION_CHUNK_SIZE = 4 * 1024 * 1024;
+constexpr int ZSTD_COMPRESSION_LEVEL = 1;
+
 constexpr u32 COOKIE_BASE = 0xBAADBABE;
 
 // Maps savestate versions to Dolphin versions.
@@ -204,6 +232,18 @@ static void DoState(Core::System& system, PointerWrap& p)
 #endif  // USE_RETRO_ACHIEVEMENTS
 }
 
+static void DoLoadFromBuffer(Core::System& system, std::vector<u8>& buffer)
+{
+  Core::RunOnCPUThread(
+      system,
+      [&] {
+        u8* ptr = buffer.data();
+        PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+        DoState(system, p);
+      },
+      true);
+}
+
 void LoadFromBuffer(Core::System& system, std::vector<u8>& buffer)
 {
   if (NetPlay::IsNetPlayRunning())
@@ -218,21 +258,41 @@ void LoadFromBuffer(Core::System& system, std::vector<u8>& buffer)
     return;
   }
 
+  DoLoadFromBuffer(system, buffer);
+}
+
+void LoadNetPlayStateFromBuffer(Core::System& system, std::vector<u8>& buffer)
+{
+  DoLoadFromBuffer(system, buffer);
+}
+
+void SaveToBuffer(Core::System& system, std::vector<u8>& buffer)
+{
   Core::RunOnCPUThread(
       system,
       [&] {
-        u8* ptr = buffer.data();
-        PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+        u8* ptr = nullptr;
+        PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+
+        DoState(system, p_measure);
+        const size_t buffer_size = reinterpret_cast<size_t>(ptr);
+        buffer.resize(buffer_size);
+
+        ptr = buffer.data();
+        PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
         DoState(system, p);
       },
       true);
 }
 
-void SaveToBuffer(Core::System& system, std::vector<u8>& buffer)
+void SaveDeltaToBuffer(Core::System& system, std::vector<u8>& buffer)
 {
   Core::RunOnCPUThread(
       system,
       [&] {
+        auto& memory = system.GetMemory();
+        memory.SetSaveDeltaState(true);
+
         u8* ptr = nullptr;
         PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
 
@@ -243,6 +303,8 @@ void SaveToBuffer(Core::System& system, std::vector<u8>& buffer)
         ptr = buffer.data();
         PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
         DoState(system, p);
+
+        memory.SetSaveDeltaState(false);
       },
       true);
 }
@@ -318,51 +380,209 @@ static bool CompareTimestamp(const SlotWithTimestamp& lhs, const SlotWithTimesta
   return lhs.timestamp < rhs.timestamp;
 }
 
-static void CompressBufferToFile(const u8* raw_buffer, u64 size, File::IOFile& f)
+// Runs function(i) for every i in [0, count) spread over all available threads. Returns whether
+// every call returned true.
+template <typename F>
+static bool ForEachChunkInParallel(size_t count, F function)
 {
-  u64 total_bytes_compressed = 0;
+  const size_t threads =
+      std::min(count, std::max<size_t>(1, std::thread::hardware_concurrency()));
 
-  while (true)
+  std::vector<std::future<bool>> futures(threads);
+  for (size_t i = 0; i < threads; ++i)
+  {
+    futures[i] = std::async(std::launch::async, [&function, count, threads, i]() {
+      bool success = true;
+      for (size_t j = i; j < count; j += threads)
+        success &= function(j);
+      return success;
+    });
+  }
+
+  bool success = true;
+  for (std::future<bool>& future : futures)
+    success &= future.get();
+  return success;
+}
+
+static bool CompressChunk(CompressionType type, const u8* in, size_t in_size, std::vector<u8>& out)
+{
+  if (type == CompressionType::Zstd)
   {
-    u64 bytes_left_to_compress = size - total_bytes_compressed;
+    out.resize(ZSTD_compressBound(in_size));
+    const size_t result =
+        ZSTD_compress(out.data(), out.size(), in, in_size, ZSTD_COMPRESSION_LEVEL);
+    if (ZSTD_isError(result))
+      return false;
+    out.resize(result);
+    return true;
+  }
 
-    int bytes_to_compress =
-        static_cast<int>(std::min(static_cast<u64>(LZ4_MAX_INPUT_SIZE), bytes_left_to_compress));
-    int compressed_buffer_size = LZ4_compressBound(bytes_to_compress);
-    auto compressed_buffer = std::make_unique<char[]>(compressed_buffer_size);
-    s32 compressed_len =
-        LZ4_compress_default(reinterpret_cast<const char*>(raw_buffer) + total_bytes_compressed,
-                             compressed_buffer.get(), bytes_to_compress, compressed_buffer_size);
+  out.resize(LZ4_compressBound(static_cast<int>(in_size)));
+  const int result =
+      LZ4_compress_default(reinterpret_cast<const char*>(in), reinterpret_cast<char*>(out.data()),
+                           static_cast<int>(in_size), static_cast<int>(out.size()));
+  if (result <= 0)
+    return false;
+  out.resize(result);
+  return true;
+}
 
-    if (compressed_len == 0)
+static bool DecompressChunk(CompressionType type, const u8* in, size_t in_size, u8* out,
+                            size_t out_size)
+{
+  if (type == CompressionType::Zstd)
+    return ZSTD_decompress(out, out_size, in, in_size) == out_size;
+
+  return LZ4_decompress_safe(reinterpret_cast<const char*>(in), reinterpret_cast<char*>(out),
+                             static_cast<int>(in_size),
+                             static_cast<int>(out_size)) == static_cast<int>(out_size);
+}
+
+static CompressionType GetCompressionType()
+{
+  if (!s_use_compression)
+    return CompressionType::Uncompressed;
+  return Config::Get(Config::MAIN_SAVESTATE_ZSTD_COMPRESSION) ? CompressionType::Zstd :
+                                                                CompressionType::LZ4;
+}
+
+struct StateRegion
+{
+  const u8* data;
+  size_t size;
+  bool by_reference;
+  // Has to be read through MemoryManager::ReadSnapshot
+  bool in_snapshot = false;
+};
+
+// Splits the state made up of the buffer with the spans inserted into it into regions of up to
+// COMPRESSION_CHUNK_SIZE bytes, each of which becomes one chunk. No region crosses a span boundary,
+// so loading can put the spans straight into their destination.
+static std::vector<StateRegion> SplitIntoRegions(const std::vector<u8>& buffer,
+                                                 const std::vector<PointerWrap::Span>& spans,
+                                                 const std::vector<bool>& spans_in_snapshot = {})
+{
+  std::vector<StateRegion> regions;
+  const auto add_regions = [&regions](const u8* data, size_t size, bool by_reference,
+                                      bool in_snapshot) {
+    for (size_t offset = 0; offset < size; offset += COMPRESSION_CHUNK_SIZE)
     {
-      PanicAlertFmtT("Internal LZ4 Error - compression failed");
-      break;
+      regions.push_back({data + offset, std::min<size_t>(COMPRESSION_CHUNK_SIZE, size - offset),
+                         by_reference, in_snapshot});
     }
+  };
+
+  size_t buffer_offset = 0;
+  for (size_t i = 0; i < spans.size(); ++i)
+  {
+    const PointerWrap::Span& span = spans[i];
+    add_regions(buffer.data() + buffer_offset, span.offset - buffer_offset, false, false);
+    add_regions(span.data, span.size, true, i < spans_in_snapshot.size() && spans_in_snapshot[i]);
+    buffer_offset = span.offset;
+  }
+  add_regions(buffer.data() + buffer_offset, buffer.size() - buffer_offset, false, false);
+
+  return regions;
+}
+
+static StateChunkInfo GetChunkInfo(const StateRegion& region, size_t compressed_size)
+{
+  return {static_cast<u32>(region.size), static_cast<u32>(compressed_size),
+          region.by_reference ? STATE_CHUNK_BY_REFERENCE : 0u};
+}
 
-    // The size of the data to write is 'compressed_len'
-    f.WriteArray(&compressed_len, 1);
-    f.WriteBytes(compressed_buffer.get(), compressed_len);
+static bool CompressRegions(Core::System& system, CompressionType type,
+                            const std::vector<StateRegion>& regions,
+                            StateExtendedHeader& extended_header,
+                            std::vector<std::vector<u8>>& compressed_chunks)
+{
+  compressed_chunks.resize(regions.size());
+  const bool success = ForEachChunkInParallel(regions.size(), [&](size_t i) {
+    const StateRegion& region = regions[i];
+    if (!region.in_snapshot)
+      return CompressChunk(type, region.data, region.size, compressed_chunks[i]);
+
+    std::vector<u8> data(region.size);
+    system.GetMemory().ReadSnapshot(region.data, region.size, data.data());
+    return CompressChunk(type, data.data(), data.size(), compressed_chunks[i]);
+  });
 
-    total_bytes_compressed += bytes_to_compress;
-    if (total_bytes_compressed == size)
-      break;
+  if (!success)
+  {
+    PanicAlertFmtT("Internal compression error - compression failed");
+    return false;
+  }
+
+  extended_header.chunks.resize(regions.size());
+  for (size_t i = 0; i < regions.size(); ++i)
+    extended_header.chunks[i] = GetChunkInfo(regions[i], compressed_chunks[i].size());
+
+  return true;
+}
+
+static void ConcatenateRegions(Core::System& system, const std::vector<StateRegion>& regions,
+                               StateExtendedHeader& extended_header, std::vector<u8>& out)
+{
+  size_t size = 0;
+  for (const StateRegion& region : regions)
+    size += region.size;
+  out.resize(size);
+
+  extended_header.chunks.resize(regions.size());
+  u8* out_ptr = out.data();
+  for (size_t i = 0; i < regions.size(); ++i)
+  {
+    if (regions[i].in_snapshot)
+      system.GetMemory().ReadSnapshot(regions[i].data, regions[i].size, out_ptr);
+    else
+      std::memcpy(out_ptr, regions[i].data, regions[i].size);
+    out_ptr += regions[i].size;
+    extended_header.chunks[i] = GetChunkInfo(regions[i], regions[i].size);
   }
 }
 
-static void CreateExtendedHeader(StateExtendedHeader& extended_header, size_t uncompressed_size)
+static void CreateExtendedHeader(StateExtendedHeader& extended_header, CompressionType type,
+                                 size_t uncompressed_size)
 {
   StateExtendedBaseHeader& base_header = extended_header.base_header;
   base_header.header_version = EXTENDED_HEADER_VERSION;
-  base_header.compression_type =
-      s_use_compression ? CompressionType::LZ4 : CompressionType::Uncompressed;
+  base_header.compression_type = type;
   base_header.payload_offset = COMPRESSED_DATA_OFFSET;
   base_header.uncompressed_size = uncompressed_size;
 
   // If more fields are added to StateExtendedHeader, set them here.
+  base_header.payload_offset +=
+      static_cast<u32>(sizeof(u32) + sizeof(StateChunkInfo) * extended_header.chunks.size());
 }
 
-static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
+// Fills in the headers and the data of save_args from the state buffer with the spans inserted.
+static bool PrepareStateData(Core::System& system, CompressionType type,
+                             const std::vector<u8>& buffer,
+                             const std::vector<PointerWrap::Span>& spans,
+                             const std::vector<bool>& spans_in_snapshot,
+                             CompressAndDumpState_args& save_args)
+{
+  size_t uncompressed_size = buffer.size();
+  for (const PointerWrap::Span& span : spans)
+    uncompressed_size += span.size;
+
+  bool success = true;
+  const std::vector<StateRegion> regions = SplitIntoRegions(buffer, spans, spans_in_snapshot);
+  if (type == CompressionType::Uncompressed)
+  {
+    ConcatenateRegions(system, regions, save_args.extended_header, save_args.buffer_vector);
+  }
+  else
+  {
+    success = CompressRegions(system, type, regions, save_args.extended_header,
+                              save_args.compressed_chunks);
+  }
+  CreateExtendedHeader(save_args.extended_header, type, uncompressed_size);
+  return success;
+}
+
+static void WriteHeadersToFile(const StateExtendedHeader& extended_header, File::IOFile& f)
 {
   StateHeader header{};
   SConfig::GetInstance().GetGameID().copy(header.legacy_header.game_id,
@@ -373,15 +593,15 @@ static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
   header.version_string = Common::GetScmRevStr();
   header.version_header.version_string_length = static_cast<u32>(header.version_string.length());
 
-  StateExtendedHeader extended_header{};
-  CreateExtendedHeader(extended_header, uncompressed_size);
-
   f.WriteArray(&header.legacy_header, 1);
   f.WriteArray(&header.version_header, 1);
   f.WriteString(header.version_string);
 
   f.WriteArray(&extended_header.base_header, 1);
   // If StateExtendedHeader is amended to include more than the base, add WriteBytes() calls here.
+  const u32 num_chunks = static_cast<u32>(extended_header.chunks.size());
+  f.WriteArray(&num_chunks, 1);
+  f.WriteArray(extended_header.chunks.data(), num_chunks);
 }
 
 static void CompressAndDumpState(Core::System& system, CompressAndDumpState_args& save_args)
@@ -408,12 +628,17 @@ static void CompressAndDumpState(Core::System& system, CompressAndDumpState_args
     return;
   }
 
-  WriteHeadersToFile(buffer_size, f);
+  WriteHeadersToFile(save_args.extended_header, f);
 
-  if (s_use_compression)
-    CompressBufferToFile(buffer_data, buffer_size, f);
-  else
+  if (save_args.extended_header.base_header.compression_type == CompressionType::Uncompressed)
+  {
     f.WriteBytes(buffer_data, buffer_size);
+  }
+  else
+  {
+    for (const std::vector<u8>& chunk : save_args.compressed_chunks)
+      f.WriteBytes(chunk.data(), chunk.size());
+  }
 
   if (!f.IsGood())
     Core::DisplayMessage("Failed to write state file", 2000);
@@ -484,9 +709,14 @@ void SaveAs(Core::System& system, const std::string& filename, bool wait)
           ++s_state_writes_in_queue;
         }
 
+        // Large regions of emulated memory are compressed in place rather than copied into the
+        // buffer first. That has to finish before emulation continues.
+        const CompressionType compression_type = GetCompressionType();
+        std::vector<PointerWrap::Span> spans;
+
         // Measure the size of the buffer.
         u8* ptr = nullptr;
-        PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+        PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure, &spans);
         DoState(system, p_measure);
         const size_t buffer_size = reinterpret_cast<size_t>(ptr);
 
@@ -494,17 +724,44 @@ void SaveAs(Core::System& system, const std::string& filename, bool wait)
         std::vector<u8> current_buffer;
         current_buffer.resize(buffer_size);
         ptr = current_buffer.data();
-        PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
+        PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write, &spans);
         DoState(system, p);
 
-        if (p.IsWriteMode())
+        CompressAndDumpState_args save_args;
+        bool success = p.IsWriteMode();
+        auto& memory = system.GetMemory();
+        if (success && Config::Get(Config::MAIN_SAVESTATE_COPY_ON_WRITE) && memory.BeginSnapshot())
+        {
+          // RAM and EXRAM are read from the snapshot by the worker, so only the rest of the
+          // state has to be copied before emulation continues.
+          SnapshotState& snapshot_state = save_args.snapshot_state.emplace();
+          snapshot_state.compression_type = compression_type;
+          snapshot_state.buffer = std::move(current_buffer);
+          snapshot_state.spans = std::move(spans);
+          for (PointerWrap::Span& span : snapshot_state.spans)
+          {
+            const bool in_snapshot = memory.IsInSnapshot(span.data, span.size);
+            snapshot_state.spans_in_snapshot.push_back(in_snapshot);
+            if (!in_snapshot)
+            {
+              std::vector<u8>& copy = snapshot_state.span_copies.emplace_back(
+                  span.data, span.data + span.size);
+              span.data = copy.data();
+            }
+          }
+        }
+        else if (success)
+        {
+          success = PrepareStateData(system, compression_type, current_buffer, spans, {},
+                                     save_args);
+        }
+
+        if (success)
         {
           Core::DisplayMessage("Saving State...", 1000);
 
           std::shared_ptr<Common::Event> sync_event;
 
-          CompressAndDumpState_args save_args;
-          save_args.buffer_vector = std::move(current_buffer);
           save_args.filename = filename;
           if (wait)
           {
@@ -723,6 +980,131 @@ static bool DecompressLZ4(std::vector<u8>& raw_buffer, u64 size, File::IOFile& f
   }
 }
 
+// Reads the chunks of a state saved with extended header version 2. Chunks of regions which were
+// saved by reference are only read once DoState asks for them, straight into their destination.
+class ChunkedStateReader
+{
+public:
+  ChunkedStateReader(File::IOFile file, CompressionType type, std::vector<StateChunkInfo> chunks)
+      : m_file(std::move(file)), m_type(type), m_chunks(std::move(chunks))
+  {
+    m_file_offsets.resize(m_chunks.size());
+    u64 offset = m_file.Tell();
+    for (size_t i = 0; i < m_chunks.size(); ++i)
+    {
+      m_file_offsets[i] = offset;
+      offset += m_chunks[i].compressed_size;
+    }
+  }
+
+  // Reads every chunk which belongs to the PointerWrap buffer.
+  bool ReadBuffer(std::vector<u8>& buffer)
+  {
+    std::vector<size_t> indices;
+    size_t size = 0;
+    for (size_t i = 0; i < m_chunks.size(); ++i)
+    {
+      if (m_chunks[i].flags & STATE_CHUNK_BY_REFERENCE)
+        continue;
+      indices.push_back(i);
+      size += m_chunks[i].uncompressed_size;
+    }
+
+    buffer.resize(size);
+    return ReadChunks(indices, buffer.data());
+  }
+
+  // Reads the chunks making up the next region which was saved by reference.
+  bool ReadSpan(u8* data, size_t size)
+  {
+    std::vector<size_t> indices;
+    size_t total_size = 0;
+    while (total_size < size)
+    {
+      while (m_next_span_chunk < m_chunks.size() &&
+             !(m_chunks[m_next_span_chunk].flags & STATE_CHUNK_BY_REFERENCE))
+      {
+        ++m_next_span_chunk;
+      }
+
+      if (m_next_span_chunk == m_chunks.size())
+        break;
+
+      total_size += m_chunks[m_next_span_chunk].uncompressed_size;
+      indices.push_back(m_next_span_chunk++);
+    }
+
+    if (total_size != size)
+    {
+      ERROR_LOG_FMT(CORE, "Savestate region of {} bytes doesn't match its chunks", size);
+      return false;
+    }
+
+    return ReadChunks(indices, data);
+  }
+
+private:
+  // Reads the given chunks into consecutive memory starting at out.
+  bool ReadChunks(const std::vector<size_t>& indices, u8* out)
+  {
+    std::vector<u8*> destinations(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+      destinations[i] = out;
+      out += m_chunks[indices[i]].uncompressed_size;
+    }
+
+    if (m_type == CompressionType::Uncompressed)
+    {
+      for (size_t i = 0; i < indices.size(); ++i)
+      {
+        if (!ReadChunkData(indices[i], destinations[i]))
+          return false;
+      }
+      return true;
+    }
+
+    std::vector<std::vector<u8>> compressed_data(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+      compressed_data[i].resize(m_chunks[indices[i]].compressed_size);
+      if (!ReadChunkData(indices[i], compressed_data[i].data()))
+        return false;
+    }
+
+    const bool success = ForEachChunkInParallel(indices.size(), [&](size_t i) {
+      const StateChunkInfo& chunk = m_chunks[indices[i]];
+      return DecompressChunk(m_type, compressed_data[i].data(), chunk.compressed_size,
+                             destinations[i], chunk.uncompressed_size);
+    });
+
+    if (!success)
+    {
+      PanicAlertFmtT("Internal compression error - decompression failed");
+      return false;
+    }
+
+    return true;
+  }
+
+  bool ReadChunkData(size_t index, u8* out)
+  {
+    if (!m_file.Seek(m_file_offsets[index], File::SeekOrigin::Begin) ||
+        !m_file.ReadBytes(out, m_chunks[index].compressed_size))
+    {
+      PanicAlertFmt("Could not read state data");
+      return false;
+    }
+    return true;
+  }
+
+  File::IOFile m_file;
+  CompressionType m_type;
+  std::vector<StateChunkInfo> m_chunks;
+  std::vector<u64> m_file_offsets;
+  size_t m_next_span_chunk = 0;
+};
+
 static bool ValidateHeaders(const StateHeader& header)
 {
   bool success = true;
@@ -770,7 +1152,8 @@ static bool ValidateHeaders(const StateHeader& header)
   return success;
 }
 
-static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_data)
+static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_data,
+                              std::optional<ChunkedStateReader>& ret_reader)
 {
   File::IOFile f;
 
@@ -802,7 +1185,8 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
   }
   // If StateExtendedHeader is amended to include more than the base, add ReadBytes() calls here.
 
-  if (extended_header.base_header.header_version != EXTENDED_HEADER_VERSION)
+  const u16 header_version = extended_header.base_header.header_version;
+  if (header_version != EXTENDED_HEADER_VERSION && header_version != LEGACY_EXTENDED_HEADER_VERSION)
   {
     PanicAlertFmt("State header corrupted");
     return;
@@ -810,6 +1194,42 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
 
   std::vector<u8> buffer;
 
+  if (header_version != LEGACY_EXTENDED_HEADER_VERSION)
+  {
+    const auto type = static_cast<CompressionType>(extended_header.base_header.compression_type);
+    if (type != CompressionType::Uncompressed && type != CompressionType::LZ4 &&
+        type != CompressionType::Zstd)
+    {
+      PanicAlertFmt("Unknown compression type {0}", extended_header.base_header.compression_type);
+      return;
+    }
+
+    u32 num_chunks;
+    if (!f.ReadArray(&num_chunks, 1))
+    {
+      PanicAlertFmt("Unable to read state header");
+      return;
+    }
+    extended_header.chunks.resize(num_chunks);
+    if (!f.ReadArray(extended_header.chunks.data(), num_chunks))
+    {
+      PanicAlertFmt("Unable to read state header");
+      return;
+    }
+
+    if (type != CompressionType::Uncompressed)
+      Core::DisplayMessage("Decompressing State...", 500);
+
+    ChunkedStateReader reader(std::move(f), type, std::move(extended_header.chunks));
+    if (!reader.ReadBuffer(buffer))
+      return;
+
+    ret_data.swap(buffer);
+    ret_reader.emplace(std::move(reader));
+    return;
+  }
+
+  // States from before chunked compression.
   switch (extended_header.base_header.compression_type)
   {
   case CompressionType::LZ4:
@@ -895,12 +1315,20 @@ void LoadAs(Core::System& system, const std::string& filename)
         // brackets here are so buffer gets freed ASAP
         {
           std::vector<u8> buffer;
-          LoadFileStateData(filename, buffer);
+          std::optional<ChunkedStateReader> reader;
+          LoadFileStateData(filename, buffer, reader);
 
           if (!buffer.empty())
           {
+            // Regions saved by reference are read from the file straight into emulated memory.
+            const PointerWrap::SpanReader span_reader = [&reader](u8* data, size_t size) {
+              return reader->ReadSpan(data, size);
+            };
+
             u8* ptr = buffer.data();
-            PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+            const size_t size = buffer.size();
+            PointerWrap p = reader ? PointerWrap(&ptr, size, PointerWrap::Mode::Read, span_reader) :
+                                     PointerWrap(&ptr, size, PointerWrap::Mode::Read);
             DoState(system, p);
             loaded = true;
             loadedSuccessfully = p.IsReadMode();
@@ -943,7 +1371,20 @@ void SetOnAfterLoadCallback(AfterLoadCallbackFunc callback)
 void Init(Core::System& system)
 {
   s_save_thread.Reset("Savestate Worker", [&system](CompressAndDumpState_args args) {
-    CompressAndDumpState(system, args);
+    bool success = true;
+    if (args.snapshot_state)
+    {
+      const SnapshotState& state = *args.snapshot_state;
+      success = PrepareStateData(system, state.compression_type, state.buffer, state.spans,
+                                 state.spans_in_snapshot, args);
+      system.GetMemory().EndSnapshot();
+      args.snapshot_state.reset();
+    }
+
+    if (success)
+      CompressAndDumpState(system, args);
+    else
+      Core::DisplayMessage("Unable to save: Failed to compress state", 4000);
 
     {
       std::lock_guard lk(s_state_writes_in_queue_mutex);
@@ -954,10 +1395,13 @@ void Init(Core::System& system)
     if (args.state_write_done_event)
       args.state_write_done_event->Set();
   });
+
+  Rewind::Init(system);
 }
 
 void Shutdown()
 {
+  Rewind::Shutdown();
   s_save_thread.Shutdown();
 
   // swapping with an empty vector, rather than clear()ing
@@ -55,6 +55,7 @@ enum CompressionType : u16
 {
   Uncompressed = 0,
   LZ4 = 1,
+  Zstd = 2,
   // Add new compression types after this, as the compression type
   // is numerically stored in the state file.
 };
@@ -72,9 +73,29 @@ static_assert(offsetof(StateExtendedBaseHeader, payload_offset) == 4);
 static_assert(offsetof(StateExtendedBaseHeader, uncompressed_size) == 8);
 static_assert(std::is_trivially_copyable_v<StateExtendedBaseHeader>);
 
+enum StateChunkFlags : u32
+{
+  // The chunk holds a region which was saved through PointerWrap::DoArrayByReference rather than
+  // part of the PointerWrap buffer, so it can be loaded directly into its destination.
+  STATE_CHUNK_BY_REFERENCE = 1,
+};
+
+struct StateChunkInfo
+{
+  u32 uncompressed_size;
+  // Equal to uncompressed_size for uncompressed states.
+  u32 compressed_size;
+  u32 flags;
+};
+static_assert(sizeof(StateChunkInfo) == 12);
+
 struct StateExtendedHeader
 {
   StateExtendedBaseHeader base_header;
+  // Since extended header version 2, payloads are split into chunks stored back to back, each of
+  // which is compressed independently. The chunk count followed by the info for each chunk comes
+  // after the base header.
+  std::vector<StateChunkInfo> chunks;
   // Feel free to add new fields here, adjusting COMPRESSED_DATA_OFFSET accordingly, as well as
   // CreateExtendedHeader(). Add the appropriate IOFile read/write calls within LoadFileStateData()
   // and WriteHeadersToFile()
@@ -107,7 +128,15 @@ void SaveAs(Core::System& system, const std::string& filename, bool wait = false
 void LoadAs(Core::System& system, const std::string& filename);
 
 void SaveToBuffer(Core::System& system, std::vector<u8>& buffer);
+// Like SaveToBuffer, but only stores the pages of emulated RAM which changed since the last state
+// was saved or loaded, whether to a buffer or a file. Such a state is loaded through
+// LoadFromBuffer, and only on top of that parent state, so a chain of delta states is restored
+// by loading its full state and then each delta in order.
+void SaveDeltaToBuffer(Core::System& system, std::vector<u8>& buffer);
 void LoadFromBuffer(Core::System& system, std::vector<u8>& buffer);
+// Like LoadFromBuffer, but also allowed during NetPlay. Only for NetPlay's rollback and desync
+// recovery, which load states that every client ends up in anyway.
+void LoadNetPlayStateFromBuffer(Core::System& system, std::vector<u8>& buffer);
 
 void LoadLastSaved(Core::System& system, int i = 1);
 void SaveFirstSaved(Core::System& system);
@@ -42,6 +42,7 @@ enum class BlobType
   MOD_DESCRIPTOR,
   NFS,
   SPLIT_PLAIN,
+  DEDUP,
 };
 
 // If you convert an ISO file to another format and then call GetDataSize on it, what is the result?
@@ -78,6 +79,11 @@ public:
 
   // NOT thread-safe - can't call this from multiple threads.
   virtual bool Read(u64 offset, u64 size, u8* out_ptr) = 0;
+
+  // Hints that the given range is going to be read soon. Only formats that map data offsets
+  // straight to file offsets do anything with this, by letting the OS read ahead in the
+  // background. Unlike Read, this may be called from any thread.
+  virtual void Prefetch(u64 offset, u64 size) const {}
   template <typename T>
   std::optional<T> ReadSwapped(u64 offset)
   {
@@ -203,5 +209,8 @@ bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
                        const std::string& outfile_path, bool rvz,
                        WIARVZCompressionType compression_type, int compression_level,
                        int chunk_size, CompressCB callback);
+bool ConvertToDedup(BlobReader* infile, const std::string& infile_path,
+                    const std::string& outfile_path, const std::string& store_path,
+                    CompressCB callback);
 
 }  // namespace DiscIO
@@ -0,0 +1,307 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/DedupBlob.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <zstd.h>
+
+#include "Common/Assert.h"
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/MsgHandler.h"
+#include "Common/StringUtil.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/VolumeWii.h"
+
+namespace DiscIO
+{
+// Same as a Wii partition group, so that groups line up with the encryption and hashing units
+static constexpr u32 GROUP_SIZE = VolumeWii::GROUP_TOTAL_SIZE;
+static constexpr int ZSTD_LEVEL = 5;
+
+std::string GetDedupGroupPath(const std::string& store_path, const Common::SHA1::Digest& hash)
+{
+  const std::string hex = Common::BytesToHexString(hash);
+  return store_path + '/' + hex.substr(0, 2) + '/' + hex;
+}
+
+static std::string ResolveStorePath(const std::string& index_path, const std::string& store_path)
+{
+  if (StringToPath(store_path).is_absolute())
+    return store_path;
+
+  std::string directory;
+  SplitPath(index_path, &directory, nullptr, nullptr);
+  return directory + store_path;
+}
+
+DedupFileReader::DedupFileReader(std::string path, DedupHeader header, std::string store_path,
+                                 std::vector<DedupGroupEntry> groups, u64 raw_size)
+    : m_path(std::move(path)), m_header(header), m_store_path(std::move(store_path)),
+      m_groups(std::move(groups)), m_raw_size(raw_size)
+{
+}
+
+std::unique_ptr<DedupFileReader> DedupFileReader::Create(File::IOFile file,
+                                                         const std::string& path)
+{
+  DedupHeader header;
+  if (!file.Seek(0, File::SeekOrigin::Begin) || !file.ReadArray(&header, 1) ||
+      header.magic != DEDUP_MAGIC)
+  {
+    return nullptr;
+  }
+
+  if (header.version != VERSION)
+  {
+    ERROR_LOG_FMT(DISCIO, "Unsupported dedup image version {}", header.version);
+    return nullptr;
+  }
+
+  if (header.group_size == 0 ||
+      header.number_of_groups != (header.data_size + header.group_size - 1) / header.group_size)
+  {
+    ERROR_LOG_FMT(DISCIO, "Invalid dedup image header");
+    return nullptr;
+  }
+
+  std::string store_path(header.store_path_size, '\0');
+  if (!file.ReadBytes(store_path.data(), store_path.size()))
+    return nullptr;
+
+  std::vector<DedupGroupEntry> groups(header.number_of_groups);
+  if (!file.ReadArray(groups.data(), groups.size()))
+    return nullptr;
+
+  return std::unique_ptr<DedupFileReader>(new DedupFileReader(
+      path, header, ResolveStorePath(path, store_path), std::move(groups), file.GetSize()));
+}
+
+std::unique_ptr<BlobReader> DedupFileReader::CopyReader() const
+{
+  return std::unique_ptr<DedupFileReader>(
+      new DedupFileReader(m_path, m_header, m_store_path, m_groups, m_raw_size));
+}
+
+bool DedupFileReader::LoadGroup(u64 group_index)
+{
+  if (group_index == m_cached_group_index)
+    return true;
+
+  const u64 group_offset = group_index * m_header.group_size;
+  const size_t group_size =
+      static_cast<size_t>(std::min<u64>(m_header.group_size, m_header.data_size - group_offset));
+  m_cached_group.resize(group_size);
+
+  const DedupGroupEntry& entry = m_groups[group_index];
+  if (entry.flags & GROUP_FLAG_ZERO)
+  {
+    std::fill(m_cached_group.begin(), m_cached_group.end(), 0);
+    m_cached_group_index = group_index;
+    return true;
+  }
+
+  // Invalidate the cache in case loading fails halfway through
+  m_cached_group_index = std::numeric_limits<u64>::max();
+
+  const std::string group_path = GetDedupGroupPath(m_store_path, entry.hash);
+  File::IOFile group_file(group_path, "rb");
+  const u64 stored_size = group_file.GetSize();
+  if (!group_file || stored_size == 0 || stored_size > group_size)
+  {
+    ERROR_LOG_FMT(DISCIO, "Missing or invalid dedup group {}", group_path);
+    return false;
+  }
+
+  if (stored_size == group_size)
+  {
+    if (!group_file.ReadBytes(m_cached_group.data(), group_size))
+      return false;
+  }
+  else
+  {
+    std::vector<u8> compressed(stored_size);
+    if (!group_file.ReadBytes(compressed.data(), compressed.size()))
+      return false;
+
+    const size_t result = ZSTD_decompress(m_cached_group.data(), m_cached_group.size(),
+                                          compressed.data(), compressed.size());
+    if (ZSTD_isError(result) || result != group_size)
+    {
+      ERROR_LOG_FMT(DISCIO, "Failed to decompress dedup group {}", group_path);
+      return false;
+    }
+  }
+
+  m_cached_group_index = group_index;
+  return true;
+}
+
+bool DedupFileReader::Read(u64 offset, u64 size, u8* out_ptr)
+{
+  if (offset + size > m_header.data_size || offset + size < offset)
+    return false;
+
+  while (size > 0)
+  {
+    const u64 group_index = offset / m_header.group_size;
+    const u64 offset_in_group = offset % m_header.group_size;
+    const u64 bytes_to_read = std::min(m_header.group_size - offset_in_group, size);
+
+    if (!LoadGroup(group_index))
+      return false;
+
+    std::memcpy(out_ptr, m_cached_group.data() + offset_in_group, bytes_to_read);
+
+    offset += bytes_to_read;
+    size -= bytes_to_read;
+    out_ptr += bytes_to_read;
+  }
+
+  return true;
+}
+
+// Adds the group to the store unless an identical group is already there
+static bool StoreGroup(const std::string& group_path, const u8* data, size_t size,
+                       std::vector<u8>* compressed)
+{
+  if (File::Exists(group_path))
+    return true;
+
+  compressed->resize(ZSTD_compressBound(size));
+  const size_t compressed_size =
+      ZSTD_compress(compressed->data(), compressed->size(), data, size, ZSTD_LEVEL);
+  const bool use_compressed = !ZSTD_isError(compressed_size) && compressed_size < size;
+
+  // Write to a temporary file first, so that a conversion that gets interrupted can't leave a
+  // truncated group behind for other images to pick up
+  const std::string temp_path = group_path + ".tmp";
+  if (!File::CreateFullPath(group_path))
+    return false;
+
+  {
+    File::IOFile file(temp_path, "wb");
+    if (!file || !file.WriteBytes(use_compressed ? compressed->data() : data,
+                                  use_compressed ? compressed_size : size))
+    {
+      return false;
+    }
+  }
+
+  return File::Rename(temp_path, group_path);
+}
+
+bool ConvertToDedup(BlobReader* infile, const std::string& infile_path,
+                    const std::string& outfile_path, const std::string& store_path,
+                    CompressCB callback)
+{
+  ASSERT(infile->GetDataSizeType() == DataSizeType::Accurate);
+
+  File::IOFile outfile(outfile_path, "wb");
+  if (!outfile)
+  {
+    PanicAlertFmtT(
+        "Failed to open the output file \"{0}\".\n"
+        "Check that you have permissions to write the target folder and that the media can "
+        "be written.",
+        outfile_path);
+    return false;
+  }
+
+  const u64 data_size = infile->GetDataSize();
+  const u32 number_of_groups = static_cast<u32>((data_size + GROUP_SIZE - 1) / GROUP_SIZE);
+
+  DedupHeader header{};
+  header.magic = DEDUP_MAGIC;
+  header.version = DedupFileReader::VERSION;
+  header.data_size = data_size;
+  header.group_size = GROUP_SIZE;
+  header.number_of_groups = number_of_groups;
+  header.store_path_size = static_cast<u32>(store_path.size());
+
+  const std::string resolved_store_path = ResolveStorePath(outfile_path, store_path);
+  std::vector<DedupGroupEntry> groups(number_of_groups);
+  std::vector<u8> buffer(GROUP_SIZE);
+  std::vector<u8> compressed;
+  u32 new_groups = 0;
+  bool success = true;
+
+  for (u32 i = 0; i < number_of_groups; ++i)
+  {
+    if (!callback(Common::GetStringT("Deduplicating"),
+                  static_cast<float>(i) / static_cast<float>(number_of_groups)))
+    {
+      success = false;
+      break;
+    }
+
+    const u64 offset = static_cast<u64>(i) * GROUP_SIZE;
+    const size_t size = static_cast<size_t>(std::min<u64>(GROUP_SIZE, data_size - offset));
+    if (!infile->Read(offset, size, buffer.data()))
+    {
+      PanicAlertFmtT("Failed to read from the input file \"{0}\".", infile_path);
+      success = false;
+      break;
+    }
+
+    DedupGroupEntry& entry = groups[i];
+    if (std::all_of(buffer.begin(), buffer.begin() + size, [](u8 x) { return x == 0; }))
+    {
+      entry.flags = DedupFileReader::GROUP_FLAG_ZERO;
+      continue;
+    }
+
+    entry.hash = Common::SHA1::CalculateDigest(buffer.data(), size);
+    const std::string group_path = GetDedupGroupPath(resolved_store_path, entry.hash);
+    if (!File::Exists(group_path))
+      ++new_groups;
+
+    if (!StoreGroup(group_path, buffer.data(), size, &compressed))
+    {
+      PanicAlertFmtT("Failed to write the dedup store \"{0}\".\n"
+                     "Check that you have enough space available on the target drive.",
+                     resolved_store_path);
+      success = false;
+      break;
+    }
+  }
+
+  if (success)
+  {
+    success = outfile.WriteArray(&header, 1) &&
+              outfile.WriteBytes(store_path.data(), store_path.size()) &&
+              outfile.WriteArray(groups.data(), groups.size());
+    if (!success)
+    {
+      PanicAlertFmtT("Failed to write the output file \"{0}\".\n"
+                     "Check that you have enough space available on the target drive.",
+                     outfile_path);
+    }
+  }
+
+  if (!success)
+  {
+    // Remove the incomplete output file. Groups already added to the store are left alone,
+    // since other images may refer to them by now.
+    outfile.Close();
+    File::Delete(outfile_path);
+    return false;
+  }
+
+  NOTICE_LOG_FMT(DISCIO, "Deduplicated {}: {} of {} groups were new to the store", infile_path,
+                 new_groups, number_of_groups);
+  return true;
+}
+
+}  // namespace DiscIO
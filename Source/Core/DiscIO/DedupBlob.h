@@ -0,0 +1,89 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
+#include "Common/IOFile.h"
+#include "DiscIO/Blob.h"
+
+namespace DiscIO
+{
+static constexpr u32 DEDUP_MAGIC = 0x50554444;  // "DDUP" (byteswapped to little endian)
+
+// A dedup image is a small index file that splits the disc into fixed-size groups and refers to
+// each group by the SHA-1 of its contents. The groups themselves are zstd compressed and kept in
+// a store directory that any number of images can share, so a group which is identical between
+// several images (e.g. regional variants of a GameCube game) is only stored once.
+//
+// The store is laid out as <store>/<first two hex digits of the hash>/<hash in hex>. A group file
+// which is as large as the group itself holds the data uncompressed. All-zero groups aren't
+// stored at all. The store path in the header is relative to the directory of the index file
+// unless it is absolute.
+struct DedupHeader
+{
+  u32 magic;
+  u32 version;
+  u64 data_size;
+  u32 group_size;
+  u32 number_of_groups;
+  u32 store_path_size;
+  u32 unused;
+};
+static_assert(sizeof(DedupHeader) == 32);
+
+struct DedupGroupEntry
+{
+  Common::SHA1::Digest hash;
+  u32 flags;
+};
+static_assert(sizeof(DedupGroupEntry) == 24);
+
+class DedupFileReader final : public BlobReader
+{
+public:
+  static std::unique_ptr<DedupFileReader> Create(File::IOFile file, const std::string& path);
+
+  BlobType GetBlobType() const override { return BlobType::DEDUP; }
+  std::unique_ptr<BlobReader> CopyReader() const override;
+
+  u64 GetRawSize() const override { return m_raw_size; }
+  u64 GetDataSize() const override { return m_header.data_size; }
+  DataSizeType GetDataSizeType() const override { return DataSizeType::Accurate; }
+
+  u64 GetBlockSize() const override { return m_header.group_size; }
+  bool HasFastRandomAccessInBlock() const override { return false; }
+  std::string GetCompressionMethod() const override { return "Zstandard"; }
+  std::optional<int> GetCompressionLevel() const override { return std::nullopt; }
+
+  bool Read(u64 offset, u64 size, u8* out_ptr) override;
+
+  static constexpr u32 VERSION = 1;
+  static constexpr u32 GROUP_FLAG_ZERO = 1;
+
+private:
+  DedupFileReader(std::string path, DedupHeader header, std::string store_path,
+                  std::vector<DedupGroupEntry> groups, u64 raw_size);
+
+  bool LoadGroup(u64 group_index);
+
+  std::string m_path;
+  DedupHeader m_header;
+  std::string m_store_path;
+  std::vector<DedupGroupEntry> m_groups;
+  u64 m_raw_size;
+
+  std::vector<u8> m_cached_group;
+  u64 m_cached_group_index = std::numeric_limits<u64>::max();
+};
+
+std::string GetDedupGroupPath(const std::string& store_path, const Common::SHA1::Digest& hash);
+
+}  // namespace DiscIO
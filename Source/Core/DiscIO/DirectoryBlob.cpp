@@ -97,9 +97,9 @@ bool DiscContent::Read(u64* offset, u64* length, u8** buffer, DirectoryBlobReade
     if (std::holds_alternative<ContentFile>(m_content_source))
     {
       const auto& content = std::get<ContentFile>(m_content_source);
-      File::IOFile file(content.m_filename, "rb");
-      if (!file.Seek(content.m_offset + offset_in_content, File::SeekOrigin::Begin) ||
-          !file.ReadBytes(*buffer, bytes_to_read))
+      File::IOFile* file = blob->OpenHostFile(content.m_filename);
+      if (!file || !file->Seek(content.m_offset + offset_in_content, File::SeekOrigin::Begin) ||
+          !file->ReadBytes(*buffer, bytes_to_read))
       {
         return false;
       }
@@ -544,6 +544,27 @@ BlobType DirectoryBlobReader::GetBlobType() const
   return BlobType::DIRECTORY;
 }
 
+File::IOFile* DirectoryBlobReader::OpenHostFile(const std::string& path)
+{
+  const auto it =
+      std::find_if(m_open_files.begin(), m_open_files.end(),
+                   [&path](const OpenHostFileEntry& entry) { return entry.path == path; });
+  if (it != m_open_files.end())
+  {
+    m_open_files.splice(m_open_files.begin(), m_open_files, it);
+    return &m_open_files.front().file;
+  }
+
+  File::IOFile file(path, "rb");
+  if (!file)
+    return nullptr;
+
+  if (m_open_files.size() >= MAX_OPEN_HOST_FILES)
+    m_open_files.pop_back();
+  m_open_files.push_front(OpenHostFileEntry{path, std::move(file)});
+  return &m_open_files.front().file;
+}
+
 std::unique_ptr<BlobReader> DirectoryBlobReader::CopyReader() const
 {
   return std::unique_ptr<DirectoryBlobReader>(new DirectoryBlobReader(*this));
@@ -6,6 +6,7 @@
 #include <array>
 #include <cstddef>
 #include <functional>
+#include <list>
 #include <map>
 #include <memory>
 #include <optional>
@@ -16,6 +17,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
+#include "Common/IOFile.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/Volume.h"
 #include "DiscIO/WiiEncryptionCache.h"
@@ -23,7 +25,6 @@
 namespace File
 {
 struct FSTEntry;
-class IOFile;
 }  // namespace File
 
 namespace DiscIO
@@ -313,6 +314,11 @@ private:
 
   DiscIO::VolumeDisc* GetWrappedVolume() { return m_wrapped_volume.get(); }
 
+  // Returns an open handle for a file in the host file system. A few of the most recently used
+  // files are kept open, since games usually read a file in many small pieces and opening a file
+  // can be slow on network shares. Returns nullptr if the file can't be opened.
+  File::IOFile* OpenHostFile(const std::string& path);
+
   // For GameCube:
   DirectoryBlobPartition m_gamecube_pseudopartition;
 
@@ -327,6 +333,17 @@ private:
   u64 m_data_size;
 
   std::unique_ptr<DiscIO::VolumeDisc> m_wrapped_volume;
+
+  struct OpenHostFileEntry
+  {
+    std::string path;
+    File::IOFile file;
+  };
+
+  static constexpr size_t MAX_OPEN_HOST_FILES = 16;
+
+  // Most recently used first
+  std::list<OpenHostFileEntry> m_open_files;
 };
 
 }  // namespace DiscIO
@@ -4,6 +4,9 @@
 #include "DiscIO/FileBlob.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
@@ -15,6 +18,13 @@
 
 namespace DiscIO
 {
+static std::atomic<bool> s_map_plain_files = false;
+
+void SetMapPlainFiles(bool enabled)
+{
+  s_map_plain_files = enabled;
+}
+
 PlainFileReader::PlainFileReader(File::IOFile file) : m_file(std::move(file))
 {
   m_size = m_file.GetSize();
@@ -33,8 +43,34 @@ std::unique_ptr<BlobReader> PlainFileReader::CopyReader() const
   return Create(m_file.Duplicate("rb"));
 }
 
+bool PlainFileReader::MapIfEnabled()
+{
+  if (m_mapping.GetData())
+    return true;
+  if (m_mapping_failed || !s_map_plain_files.load(std::memory_order_relaxed))
+    return false;
+
+  // Mapping a whole disc image needs a 64-bit address space. Don't retry if it doesn't work.
+  if (m_size > std::numeric_limits<size_t>::max() / 2 || !m_mapping.Map(m_file, m_size))
+  {
+    m_mapping_failed = true;
+    return false;
+  }
+
+  return true;
+}
+
 bool PlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
 {
+  if (MapIfEnabled())
+  {
+    if (offset > m_size || nbytes > m_size - offset)
+      return false;
+
+    std::memcpy(out_ptr, m_mapping.GetData() + offset, nbytes);
+    return true;
+  }
+
   if (m_file.Seek(offset, File::SeekOrigin::Begin) && m_file.ReadBytes(out_ptr, nbytes))
   {
     return true;
@@ -46,6 +82,17 @@ bool PlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
   }
 }
 
+void PlainFileReader::Prefetch(u64 offset, u64 size) const
+{
+  if (offset >= m_size)
+    return;
+
+  if (m_mapping.GetData())
+    m_mapping.HintWillNeed(offset, size);
+  else
+    m_file.HintWillRead(offset, std::min(size, m_size - offset));
+}
+
 bool ConvertToPlain(BlobReader* infile, const std::string& infile_path,
                     const std::string& outfile_path, CompressCB callback)
 {
@@ -9,10 +9,18 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 #include "DiscIO/Blob.h"
 
 namespace DiscIO
 {
+// Sets whether plain disc images are read through a memory mapping instead of seeking and reading
+// for every request. This saves a system call and a copy through the stdio buffer per read, but a
+// read error from the file (e.g. on a network share that goes away) crashes with a bus error
+// instead of failing the read, so it's only meant for local storage. Takes effect for existing
+// readers on their next read.
+void SetMapPlainFiles(bool enabled);
+
 class PlainFileReader : public BlobReader
 {
 public:
@@ -31,12 +39,17 @@ public:
   std::optional<int> GetCompressionLevel() const override { return std::nullopt; }
 
   bool Read(u64 offset, u64 nbytes, u8* out_ptr) override;
+  void Prefetch(u64 offset, u64 size) const override;
 
 private:
   PlainFileReader(File::IOFile file);
 
+  bool MapIfEnabled();
+
   File::IOFile m_file;
   u64 m_size;
+  File::MappedFile m_mapping;
+  bool m_mapping_failed = false;
 };
 
 }  // namespace DiscIO
@@ -0,0 +1,26 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/MultithreadedCompressor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace DiscIO
+{
+static std::atomic<unsigned int> s_compression_threads = 0;
+
+void SetCompressionThreadCount(unsigned int threads)
+{
+  s_compression_threads = threads;
+}
+
+unsigned int GetCompressionThreadCount()
+{
+  const unsigned int threads = s_compression_threads.load();
+  if (threads != 0)
+    return threads;
+  return std::max<unsigned int>(1, std::thread::hardware_concurrency());
+}
+}  // namespace DiscIO
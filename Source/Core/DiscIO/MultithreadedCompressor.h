@@ -29,6 +29,12 @@ enum class ConversionResultCode
 template <typename T>
 using ConversionResult = Common::Result<ConversionResultCode, T>;
 
+// Sets how many compression threads each MultithreadedCompressor that is created afterwards will
+// start. Since each thread holds at most one block of input and one block of output at a time,
+// this also bounds the memory used by a conversion. 0 means one thread per hardware thread.
+void SetCompressionThreadCount(unsigned int threads);
+unsigned int GetCompressionThreadCount();
+
 // This class starts a number of compression threads and one output thread.
 // The set_up_compress_thread_state function is called at the start of each compression thread.
 // When CompressAndWrite is called, the compress function will be called on one of the
@@ -48,7 +54,7 @@ public:
       std::function<ConversionResultCode(OutputParameters)> output)
       : m_set_up_compress_thread_state(std::move(set_up_compress_thread_state)),
         m_compress(std::move(compress)), m_output(std::move(output)),
-        m_threads(std::max<unsigned int>(1, std::thread::hardware_concurrency()))
+        m_threads(GetCompressionThreadCount())
   {
     m_compress_threads = std::make_unique<CompressThread[]>(m_threads);
 
@@ -7,6 +7,7 @@
 #include <locale>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include <fmt/format.h>
@@ -48,9 +49,10 @@ FileDataLoaderHostFS::FileDataLoaderHostFS(std::string sd_root, const std::strin
 
   // Then try to resolve the given patch_root as if it was a file path, and on success replace the
   // m_patch_root with it.
+  // This doesn't go through the cache, since relative paths resolve differently afterwards.
   if (!patch_root.empty())
   {
-    auto r = MakeAbsoluteFromRelative(patch_root);
+    auto r = ResolvePath(patch_root);
     if (r)
       m_patch_root = std::move(*r);
   }
@@ -58,6 +60,33 @@ FileDataLoaderHostFS::FileDataLoaderHostFS(std::string sd_root, const std::strin
 
 std::optional<std::string>
 FileDataLoaderHostFS::MakeAbsoluteFromRelative(std::string_view external_relative_path)
+{
+  std::lock_guard lk(m_cache_lock);
+  auto it = m_resolved_paths.find(external_relative_path);
+  if (it == m_resolved_paths.end())
+  {
+    it = m_resolved_paths
+             .emplace(std::string(external_relative_path), ResolvePath(external_relative_path))
+             .first;
+  }
+  return it->second;
+}
+
+const std::vector<std::string>& FileDataLoaderHostFS::GetDirectoryEntries(const std::string& path)
+{
+  auto it = m_directory_entries.find(path);
+  if (it == m_directory_entries.end())
+  {
+    std::vector<std::string> entries;
+    for (auto& f : ::File::ScanDirectoryTree(path, false).children)
+      entries.emplace_back(std::move(f.virtualName));
+    it = m_directory_entries.emplace(path, std::move(entries)).first;
+  }
+  return it->second;
+}
+
+std::optional<std::string>
+FileDataLoaderHostFS::ResolvePath(std::string_view external_relative_path)
 {
 #ifdef _WIN32
   // Riivolution treats a backslash as just a standard filename character, but we can't replicate
@@ -130,13 +159,12 @@ FileDataLoaderHostFS::MakeAbsoluteFromRelative(std::string_view external_relativ
         result.erase(result.size() - element.size(), element.size());
 
         // Re-attach an element that actually matches the capitalization in the host filesystem.
-        auto possible_files = ::File::ScanDirectoryTree(result, false);
         bool found = false;
-        for (auto& f : possible_files.children)
+        for (const std::string& name : GetDirectoryEntries(result))
         {
-          if (Common::CaseInsensitiveEquals(element, f.virtualName))
+          if (Common::CaseInsensitiveEquals(element, name))
           {
-            result += f.virtualName;
+            result += name;
             found = true;
             break;
           }
@@ -168,10 +196,15 @@ FileDataLoaderHostFS::GetExternalFileSize(std::string_view external_relative_pat
   auto path = MakeAbsoluteFromRelative(external_relative_path);
   if (!path)
     return std::nullopt;
-  ::File::FileInfo f(*path);
-  if (!f.IsFile())
-    return std::nullopt;
-  return f.GetSize();
+
+  std::lock_guard lk(m_cache_lock);
+  auto it = m_file_sizes.find(*path);
+  if (it == m_file_sizes.end())
+  {
+    ::File::FileInfo f(*path);
+    it = m_file_sizes.emplace(*path, f.IsFile() ? std::optional(f.GetSize()) : std::nullopt).first;
+  }
+  return it->second;
 }
 
 std::vector<u8> FileDataLoaderHostFS::GetFileContents(std::string_view external_relative_path)
@@ -398,35 +431,68 @@ static FSTBuilderNode* FindFileNodeInFST(std::string_view path, std::vector<FSTB
                            create_if_not_exists);
 }
 
-static DiscIO::FSTBuilderNode* FindFilenameNodeInFST(std::string_view filename,
-                                                     std::vector<FSTBuilderNode>& fst)
+namespace
 {
-  for (FSTBuilderNode& node : fst)
+// Patches without a full disc path apply to the first file in the FST with the given name.
+// Searching the whole FST for every one of these is slow for mods with many such patches.
+class FSTFilenameIndex
+{
+public:
+  explicit FSTFilenameIndex(std::vector<FSTBuilderNode>* fst) : m_fst(fst) {}
+
+  FSTBuilderNode* Find(std::string_view filename)
   {
-    if (node.IsFolder())
+    if (!m_is_built)
     {
-      DiscIO::FSTBuilderNode* result = FindFilenameNodeInFST(filename, node.GetFolderContent());
-      if (result)
-        return result;
+      m_nodes.clear();
+      Build(m_fst);
+      m_is_built = true;
     }
-    else if (Common::CaseInsensitiveEquals(node.m_filename, filename))
+
+    std::string key(filename);
+    Common::ToLower(&key);
+    const auto it = m_nodes.find(key);
+    return it != m_nodes.end() ? it->second : nullptr;
+  }
+
+  // Must be called when nodes are added to the FST, since the index then has to be rebuilt.
+  void Invalidate() { m_is_built = false; }
+
+private:
+  void Build(std::vector<FSTBuilderNode>* fst)
+  {
+    for (FSTBuilderNode& node : *fst)
     {
-      return &node;
+      if (node.IsFolder())
+      {
+        Build(&node.GetFolderContent());
+      }
+      else
+      {
+        std::string key = node.m_filename;
+        Common::ToLower(&key);
+        m_nodes.try_emplace(std::move(key), &node);
+      }
     }
   }
 
-  return nullptr;
-}
+  std::vector<FSTBuilderNode>* m_fst;
+  std::unordered_map<std::string, FSTBuilderNode*> m_nodes;
+  bool m_is_built = false;
+};
+}  // namespace
 
 static void ApplyFilePatchToFST(const Patch& patch, const File& file,
                                 std::vector<DiscIO::FSTBuilderNode>* fst,
-                                DiscIO::FSTBuilderNode* dol_node)
+                                DiscIO::FSTBuilderNode* dol_node, FSTFilenameIndex* index)
 {
   if (!file.m_disc.empty() && file.m_disc[0] == '/')
   {
     // If the disc path starts with a / then we should patch that specific disc path.
     DiscIO::FSTBuilderNode* node =
         FindFileNodeInFST(std::string_view(file.m_disc).substr(1), fst, file.m_create);
+    if (file.m_create)
+      index->Invalidate();
     if (node)
       ApplyPatchToFile(patch, file, node);
   }
@@ -438,7 +504,7 @@ static void ApplyFilePatchToFST(const Patch& patch, const File& file,
   else
   {
     // Otherwise we want to patch the first file in the FST that matches that filename.
-    DiscIO::FSTBuilderNode* node = FindFilenameNodeInFST(file.m_disc, *fst);
+    DiscIO::FSTBuilderNode* node = index->Find(file.m_disc);
     if (node)
       ApplyPatchToFile(patch, file, node);
   }
@@ -446,8 +512,8 @@ static void ApplyFilePatchToFST(const Patch& patch, const File& file,
 
 static void ApplyFolderPatchToFST(const Patch& patch, const Folder& folder,
                                   std::vector<DiscIO::FSTBuilderNode>* fst,
-                                  DiscIO::FSTBuilderNode* dol_node, std::string_view disc_path,
-                                  std::string_view external_path)
+                                  DiscIO::FSTBuilderNode* dol_node, FSTFilenameIndex* index,
+                                  std::string_view disc_path, std::string_view external_path)
 {
   const auto external_files = patch.m_file_data_loader->GetFolderContents(external_path);
   for (const auto& child : external_files)
@@ -469,7 +535,10 @@ static void ApplyFolderPatchToFST(const Patch& patch, const Folder& folder,
     if (child.m_is_directory)
     {
       if (folder.m_recursive)
-        ApplyFolderPatchToFST(patch, folder, fst, dol_node, child_disc_path, child_external_path);
+      {
+        ApplyFolderPatchToFST(patch, folder, fst, dol_node, index, child_disc_path,
+                              child_external_path);
+      }
     }
     else
     {
@@ -479,21 +548,22 @@ static void ApplyFolderPatchToFST(const Patch& patch, const Folder& folder,
       file.m_resize = folder.m_resize;
       file.m_create = folder.m_create;
       file.m_length = folder.m_length;
-      ApplyFilePatchToFST(patch, file, fst, dol_node);
+      ApplyFilePatchToFST(patch, file, fst, dol_node, index);
     }
   }
 }
 
 static void ApplyFolderPatchToFST(const Patch& patch, const Folder& folder,
                                   std::vector<DiscIO::FSTBuilderNode>* fst,
-                                  DiscIO::FSTBuilderNode* dol_node)
+                                  DiscIO::FSTBuilderNode* dol_node, FSTFilenameIndex* index)
 {
-  ApplyFolderPatchToFST(patch, folder, fst, dol_node, folder.m_disc, folder.m_external);
+  ApplyFolderPatchToFST(patch, folder, fst, dol_node, index, folder.m_disc, folder.m_external);
 }
 
 void ApplyPatchesToFiles(std::span<const Patch> patches, PatchIndex index,
                          std::vector<FSTBuilderNode>* fst, FSTBuilderNode* dol_node)
 {
+  FSTFilenameIndex filename_index(fst);
   for (const auto& patch : patches)
   {
     const auto& file_patches =
@@ -502,10 +572,10 @@ void ApplyPatchesToFiles(std::span<const Patch> patches, PatchIndex index,
         index == PatchIndex::DolphinSysFiles ? patch.m_sys_folder_patches : patch.m_folder_patches;
 
     for (const auto& file : file_patches)
-      ApplyFilePatchToFST(patch, file, fst, dol_node);
+      ApplyFilePatchToFST(patch, file, fst, dol_node, &filename_index);
 
     for (const auto& folder : folder_patches)
-      ApplyFolderPatchToFST(patch, folder, fst, dol_node);
+      ApplyFolderPatchToFST(patch, folder, fst, dol_node, &filename_index);
   }
 }
 
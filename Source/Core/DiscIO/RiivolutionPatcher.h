@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <map>
+#include <mutex>
 #include <optional>
 #include <span>
 #include <string>
@@ -66,9 +68,18 @@ public:
 
 private:
   std::optional<std::string> MakeAbsoluteFromRelative(std::string_view external_relative_path);
+  std::optional<std::string> ResolvePath(std::string_view external_relative_path);
+  const std::vector<std::string>& GetDirectoryEntries(const std::string& path);
 
   std::string m_sd_root;
   std::string m_patch_root;
+
+  // Mods often patch hundreds of files, and every patch resolves its path and file size. Resolving
+  // a path checks every path element with the host file system, so the results are kept here.
+  std::mutex m_cache_lock;
+  std::map<std::string, std::optional<std::string>, std::less<>> m_resolved_paths;
+  std::map<std::string, std::optional<u64>, std::less<>> m_file_sizes;
+  std::map<std::string, std::vector<std::string>, std::less<>> m_directory_entries;
 };
 
 enum class PatchIndex
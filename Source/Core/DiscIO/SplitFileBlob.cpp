@@ -98,4 +98,18 @@ bool SplitPlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
 
   return rest == 0;
 }
+
+void SplitPlainFileReader::Prefetch(u64 offset, u64 size) const
+{
+  const u64 end = offset + size;
+  for (const SingleFile& file : m_files)
+  {
+    const u64 file_end = file.offset + file.size;
+    if (offset < file_end && end > file.offset)
+    {
+      const u64 start_in_file = std::max(offset, file.offset) - file.offset;
+      file.file.HintWillRead(start_in_file, std::min(end, file_end) - file.offset - start_in_file);
+    }
+  }
+}
 }  // namespace DiscIO
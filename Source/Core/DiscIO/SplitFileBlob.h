@@ -33,6 +33,7 @@ public:
   std::optional<int> GetCompressionLevel() const override { return std::nullopt; }
 
   bool Read(u64 offset, u64 nbytes, u8* out_ptr) override;
+  void Prefetch(u64 offset, u64 size) const override;
 
 private:
   struct SingleFile
@@ -7,6 +7,7 @@
 #include <future>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -358,6 +359,11 @@ RedumpVerifier::Result RedumpVerifier::Finish(const Hashes<std::vector<u8>>& has
 }
 
 constexpr u64 DEFAULT_READ_SIZE = 0x20000;  // Arbitrary value
+// When using multiple threads, data that only needs to be hashed is read in larger pieces, so
+// that fewer round trips are made to the disc image and to the hashing threads
+constexpr u64 THREADED_READ_SIZE = VolumeWii::GROUP_TOTAL_SIZE;
+// How far ahead of the current position the blob reader is told to read in the background
+constexpr u64 PREFETCH_DISTANCE = 0x1000000;
 
 VolumeVerifier::VolumeVerifier(const Volume& volume, bool redump_verification,
                                Hashes<bool> hashes_to_calculate)
@@ -394,10 +400,17 @@ Hashes<bool> VolumeVerifier::GetDefaultHashesToCalculate()
   return hashes_to_calculate;
 }
 
+void VolumeVerifier::SetThreadCount(unsigned int threads)
+{
+  ASSERT(!m_started);
+  m_thread_count = std::max(threads, 1u);
+}
+
 void VolumeVerifier::Start()
 {
   ASSERT(!m_started);
   m_started = true;
+  m_read_size = m_thread_count > 1 ? THREADED_READ_SIZE : DEFAULT_READ_SIZE;
 
   if (m_redump_verification)
     m_redump_verifier.Start(m_volume);
@@ -1090,8 +1103,8 @@ void VolumeVerifier::WaitForAsyncOperations() const
     m_sha1_future.wait();
   if (m_content_future.valid())
     m_content_future.wait();
-  if (m_group_future.valid())
-    m_group_future.wait();
+  for (const std::future<void>& future : m_group_futures)
+    future.wait();
 }
 
 bool VolumeVerifier::ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read)
@@ -1128,7 +1141,7 @@ void VolumeVerifier::Process()
   IOS::ES::Content content{};
   bool content_read = false;
   bool group_read = false;
-  u64 bytes_to_read = DEFAULT_READ_SIZE;
+  u64 bytes_to_read = m_read_size;
   u64 excess_bytes = 0;
   if (m_content_index < m_content_offsets.size() &&
       m_content_offsets[m_content_index] == m_progress)
@@ -1188,6 +1201,15 @@ void VolumeVerifier::Process()
   }
 
   const bool is_data_needed = m_calculating_any_hash || content_read || group_read;
+
+  // Hint in large steps, so that the OS can keep several reads in flight without being asked for
+  // every chunk
+  if (is_data_needed && m_prefetched_until < m_progress + bytes_to_read + PREFETCH_DISTANCE / 2)
+  {
+    const u64 prefetch_start = std::max(m_prefetched_until, m_progress);
+    m_prefetched_until = m_progress + bytes_to_read + PREFETCH_DISTANCE;
+    m_volume.GetBlobReader().Prefetch(prefetch_start, m_prefetched_until - prefetch_start);
+  }
   const bool read_failed = is_data_needed && !ReadChunkAndWaitForAsyncOperations(bytes_to_read);
 
   if (read_failed)
@@ -1240,36 +1262,37 @@ void VolumeVerifier::Process()
 
   if (group_read)
   {
-    m_group_future = std::async(std::launch::async, [this, read_failed,
-                                                     group_index = m_group_index] {
-      const GroupToVerify& group = m_groups[group_index];
-      u64 offset_in_group = 0;
-      for (u64 block_index = group.block_index_start; block_index < group.block_index_end;
-           ++block_index, offset_in_group += VolumeWii::BLOCK_TOTAL_SIZE)
-      {
-        const u64 block_offset = group.offset + offset_in_group;
+    const GroupToVerify& group = m_groups[m_group_index];
+    const size_t blocks = group.block_index_end - group.block_index_start;
+    const size_t tasks = std::min<size_t>(m_thread_count, blocks);
 
-        if (!read_failed && m_volume.CheckBlockIntegrity(
-                                block_index, m_data.data() + offset_in_group, group.partition))
-        {
-          m_biggest_verified_offset =
-              std::max(m_biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
-        }
-        else
+    m_group_futures.clear();
+    if (tasks <= 1)
+    {
+      m_group_futures.push_back(std::async(
+          std::launch::async, &VolumeVerifier::CheckGroupBlocks, this, m_group_index,
+          group.block_index_start, group.block_index_end, read_failed));
+    }
+    else
+    {
+      // The partition's key and H3 table are loaded lazily, which isn't thread-safe, so check
+      // the first block before fanning out
+      CheckGroupBlocks(m_group_index, group.block_index_start, group.block_index_start + 1,
+                       read_failed);
+
+      const size_t remaining_blocks = blocks - 1;
+      for (size_t i = 0; i < tasks; ++i)
+      {
+        const size_t start = group.block_index_start + 1 + remaining_blocks * i / tasks;
+        const size_t end = group.block_index_start + 1 + remaining_blocks * (i + 1) / tasks;
+        if (start != end)
         {
-          if (m_scrubber.CanBlockBeScrubbed(block_offset))
-          {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block_offset);
-            m_unused_block_errors[group.partition]++;
-          }
-          else
-          {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
-            m_block_errors[group.partition]++;
-          }
+          m_group_futures.push_back(std::async(std::launch::async,
+                                               &VolumeVerifier::CheckGroupBlocks, this,
+                                               m_group_index, start, end, read_failed));
         }
       }
-    });
+    }
 
     m_group_index++;
   }
@@ -1277,6 +1300,50 @@ void VolumeVerifier::Process()
   m_progress += byte_increment;
 }
 
+void VolumeVerifier::CheckGroupBlocks(size_t group_index, size_t block_index_start,
+                                      size_t block_index_end, bool read_failed)
+{
+  const GroupToVerify& group = m_groups[group_index];
+
+  u64 biggest_verified_offset = 0;
+  size_t block_errors = 0;
+  size_t unused_block_errors = 0;
+
+  for (size_t block_index = block_index_start; block_index < block_index_end; ++block_index)
+  {
+    const u64 offset_in_group =
+        (block_index - group.block_index_start) * VolumeWii::BLOCK_TOTAL_SIZE;
+    const u64 block_offset = group.offset + offset_in_group;
+
+    if (!read_failed &&
+        m_volume.CheckBlockIntegrity(block_index, m_data.data() + offset_in_group, group.partition))
+    {
+      biggest_verified_offset =
+          std::max(biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
+    }
+    else
+    {
+      if (m_scrubber.CanBlockBeScrubbed(block_offset))
+      {
+        WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block_offset);
+        unused_block_errors++;
+      }
+      else
+      {
+        WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
+        block_errors++;
+      }
+    }
+  }
+
+  std::lock_guard lk(m_group_results_mutex);
+  m_biggest_verified_offset = std::max(m_biggest_verified_offset, biggest_verified_offset);
+  if (block_errors > 0)
+    m_block_errors[group.partition] += block_errors;
+  if (unused_block_errors > 0)
+    m_unused_block_errors[group.partition] += unused_block_errors;
+}
+
 u64 VolumeVerifier::GetBytesProcessed() const
 {
   return m_progress;
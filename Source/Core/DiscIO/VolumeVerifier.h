@@ -6,6 +6,7 @@
 #include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -21,6 +22,7 @@
 // To be used as follows:
 //
 // VolumeVerifier verifier(volume, redump_verification, hashes_to_calculate);
+// verifier.SetThreadCount(threads);  // Optional
 // verifier.Start();
 // while (verifier.GetBytesProcessed() != verifier.GetTotalBytes())
 //   verifier.Process();
@@ -128,6 +130,9 @@ public:
   ~VolumeVerifier();
 
   static Hashes<bool> GetDefaultHashesToCalculate();
+  // Sets how many threads may check the blocks of a Wii partition group at once, in addition to
+  // the threads calculating the hashes of the whole disc. Must be called before Start.
+  void SetThreadCount(unsigned int threads);
   void Start();
   void Process();
   u64 GetBytesProcessed() const;
@@ -158,6 +163,8 @@ private:
   void SetUpHashing();
   void WaitForAsyncOperations() const;
   bool ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read);
+  void CheckGroupBlocks(size_t group_index, size_t block_index_start, size_t block_index_end,
+                        bool read_failed);
 
   void AddProblem(Severity severity, std::string text);
 
@@ -184,7 +191,12 @@ private:
   std::future<void> m_md5_future;
   std::future<void> m_sha1_future;
   std::future<void> m_content_future;
-  std::future<void> m_group_future;
+  std::vector<std::future<void>> m_group_futures;
+  // Protects the block check results below while m_group_futures are running
+  std::mutex m_group_results_mutex;
+  unsigned int m_thread_count = 1;
+  u64 m_read_size = 0;
+  u64 m_prefetched_until = 0;
 
   DiscScrubber m_scrubber;
   IOS::ES::TicketReader m_ticket;
@@ -512,71 +512,79 @@ bool VolumeWii::HashGroup(const std::array<u8, BLOCK_DATA_SIZE> in[BLOCKS_PER_GR
                           HashBlock out[BLOCKS_PER_GROUP],
                           const std::function<bool(size_t block)>& read_function)
 {
-  std::array<std::future<void>, BLOCKS_PER_GROUP> hash_futures;
-  bool success = true;
-
-  for (size_t i = 0; i < BLOCKS_PER_GROUP; ++i)
-  {
-    if (read_function && success)
-      success = read_function(i);
+  // Each subgroup of 8 blocks shares one set of H1 hashes, so a subgroup can be hashed as soon as
+  // its blocks have been read, independently of the others. Using one task per subgroup rather
+  // than per block keeps the number of threads started for every group down, since each task only
+  // has a few milliseconds of work to do (or less with hardware accelerated SHA-1).
+  constexpr size_t BLOCKS_PER_SUBGROUP = 8;
+  constexpr size_t SUBGROUPS = BLOCKS_PER_GROUP / BLOCKS_PER_SUBGROUP;
 
-    hash_futures[i] = std::async(std::launch::async, [&in, &out, &hash_futures, success, i]() {
-      const size_t h1_base = Common::AlignDown(i, 8);
+  const auto hash_subgroup = [&in, &out](size_t subgroup) {
+    const size_t h1_base = subgroup * BLOCKS_PER_SUBGROUP;
 
-      if (success)
-      {
-        // H0 hashes
-        for (size_t j = 0; j < 31; ++j)
-          out[i].h0[j] = Common::SHA1::CalculateDigest(in[i].data() + j * 0x400, 0x400);
+    for (size_t i = h1_base; i < h1_base + BLOCKS_PER_SUBGROUP; ++i)
+    {
+      // H0 hashes
+      for (size_t j = 0; j < 31; ++j)
+        out[i].h0[j] = Common::SHA1::CalculateDigest(in[i].data() + j * 0x400, 0x400);
 
-        // H0 padding
-        out[i].padding_0 = {};
+      // H0 padding
+      out[i].padding_0 = {};
 
-        // H1 hash
-        out[h1_base].h1[i - h1_base] = Common::SHA1::CalculateDigest(out[i].h0);
-      }
+      // H1 hash
+      out[h1_base].h1[i - h1_base] = Common::SHA1::CalculateDigest(out[i].h0);
+    }
 
-      if (i % 8 == 7)
-      {
-        for (size_t j = 0; j < 7; ++j)
-          hash_futures[h1_base + j].get();
+    // H1 padding
+    out[h1_base].padding_1 = {};
 
-        if (success)
-        {
-          // H1 padding
-          out[h1_base].padding_1 = {};
+    // H1 copies
+    for (size_t j = 1; j < BLOCKS_PER_SUBGROUP; ++j)
+      out[h1_base + j].h1 = out[h1_base].h1;
 
-          // H1 copies
-          for (size_t j = 1; j < 8; ++j)
-            out[h1_base + j].h1 = out[h1_base].h1;
+    // H2 hash
+    out[0].h2[subgroup] = Common::SHA1::CalculateDigest(out[h1_base].h1);
+  };
 
-          // H2 hash
-          out[0].h2[h1_base / 8] = Common::SHA1::CalculateDigest(out[i].h1);
-        }
+  std::array<std::future<void>, SUBGROUPS> hash_futures;
+  bool success = true;
 
-        if (i == BLOCKS_PER_GROUP - 1)
-        {
-          for (size_t j = 0; j < 7; ++j)
-            hash_futures[j * 8 + 7].get();
+  for (size_t subgroup = 0; subgroup < SUBGROUPS && success; ++subgroup)
+  {
+    if (read_function)
+    {
+      for (size_t i = 0; i < BLOCKS_PER_SUBGROUP && success; ++i)
+        success = read_function(subgroup * BLOCKS_PER_SUBGROUP + i);
+    }
 
-          if (success)
-          {
-            // H2 padding
-            out[0].padding_2 = {};
+    if (!success)
+      break;
 
-            // H2 copies
-            for (size_t j = 1; j < BLOCKS_PER_GROUP; ++j)
-              out[j].h2 = out[0].h2;
-          }
-        }
-      }
-    });
+    // The last subgroup is hashed on this thread, since there is nothing left to read
+    if (subgroup == SUBGROUPS - 1)
+      hash_subgroup(subgroup);
+    else
+      hash_futures[subgroup] = std::async(std::launch::async, hash_subgroup, subgroup);
   }
 
   // Wait for all the async tasks to finish
-  hash_futures.back().get();
+  for (std::future<void>& future : hash_futures)
+  {
+    if (future.valid())
+      future.get();
+  }
 
-  return success;
+  if (!success)
+    return false;
+
+  // H2 padding
+  out[0].padding_2 = {};
+
+  // H2 copies
+  for (size_t j = 1; j < BLOCKS_PER_GROUP; ++j)
+    out[j].h2 = out[0].h2;
+
+  return true;
 }
 
 bool VolumeWii::EncryptGroup(
@@ -614,28 +622,32 @@ bool VolumeWii::EncryptGroup(
   const unsigned int threads =
       std::min(BLOCKS_PER_GROUP, std::max<unsigned int>(1, std::thread::hardware_concurrency()));
 
-  std::vector<std::future<void>> encryption_futures(threads);
-
   auto aes_context = Common::AES::CreateContextEncrypt(key.data());
 
-  for (size_t i = 0; i < threads; ++i)
-  {
-    encryption_futures[i] = std::async(
-        std::launch::async,
-        [&unencrypted_data, &unencrypted_hashes, &aes_context, &out](size_t start, size_t end) {
-          for (size_t j = start; j < end; ++j)
-          {
-            u8* out_ptr = out->data() + j * BLOCK_TOTAL_SIZE;
+  const auto encrypt_blocks = [&unencrypted_data, &unencrypted_hashes, &aes_context,
+                               &out](size_t start, size_t end) {
+    for (size_t j = start; j < end; ++j)
+    {
+      u8* out_ptr = out->data() + j * BLOCK_TOTAL_SIZE;
 
-            aes_context->CryptIvZero(reinterpret_cast<u8*>(&unencrypted_hashes[j]), out_ptr,
-                                     BLOCK_HEADER_SIZE);
+      aes_context->CryptIvZero(reinterpret_cast<u8*>(&unencrypted_hashes[j]), out_ptr,
+                               BLOCK_HEADER_SIZE);
 
-            aes_context->Crypt(out_ptr + 0x3D0, unencrypted_data[j].data(),
-                               out_ptr + BLOCK_HEADER_SIZE, BLOCK_DATA_SIZE);
-          }
-        },
-        i * BLOCKS_PER_GROUP / threads, (i + 1) * BLOCKS_PER_GROUP / threads);
+      aes_context->Crypt(out_ptr + 0x3D0, unencrypted_data[j].data(), out_ptr + BLOCK_HEADER_SIZE,
+                         BLOCK_DATA_SIZE);
+    }
+  };
+
+  // The first range is encrypted on this thread instead of waiting for the others
+  std::vector<std::future<void>> encryption_futures;
+  encryption_futures.reserve(threads - 1);
+  for (size_t i = 1; i < threads; ++i)
+  {
+    encryption_futures.push_back(std::async(std::launch::async, encrypt_blocks,
+                                            i * BLOCKS_PER_GROUP / threads,
+                                            (i + 1) * BLOCKS_PER_GROUP / threads));
   }
+  encrypt_blocks(0, BLOCKS_PER_GROUP / threads);
 
   for (std::future<void>& future : encryption_futures)
     future.get();
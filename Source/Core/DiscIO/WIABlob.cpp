@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstring>
 #include <limits>
 #include <map>
@@ -56,6 +57,19 @@ static void PushBack(std::vector<u8>* vector, const T& x)
   PushBack(vector, x_ptr, x_ptr + sizeof(T));
 }
 
+// Read lazily, since the boot volume is usually opened before the settings have been applied
+static std::atomic<u64> s_max_chunk_cache_size = 32 * 1024 * 1024;
+static std::atomic<u32> s_decompression_threads = 2;
+
+// How many groups past the end of a read to decompress ahead of time
+static constexpr u64 GROUPS_TO_PREFETCH = 4;
+
+void SetWIARVZChunkCacheLimits(u64 max_cache_size, u32 decompression_threads)
+{
+  s_max_chunk_cache_size = max_cache_size;
+  s_decompression_threads = decompression_threads;
+}
+
 std::pair<int, int> GetAllowedCompressionLevels(WIARVZCompressionType compression_type, bool gui)
 {
   switch (compression_type)
@@ -501,6 +515,10 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
   data_size += skipped_data;
 
   const u64 start_group_index = (*offset - data_offset) / chunk_size;
+  const u64 end_group_index = (*offset + *size - data_offset + chunk_size - 1) / chunk_size;
+  PrefetchGroups(chunk_size, data_offset, data_size, group_index, number_of_groups,
+                 start_group_index + 1, end_group_index + GROUPS_TO_PREFETCH, exception_lists);
+
   for (u64 i = start_group_index; i < number_of_groups && (*size) > 0; ++i)
   {
     const u64 total_group_index = group_index + i;
@@ -542,7 +560,7 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
 
       if (!chunk.Read(offset_in_group, bytes_to_read, *out_ptr))
       {
-        m_cached_chunk_offset = std::numeric_limits<u64>::max();  // Invalidate the cache
+        EvictChunk(group_offset_in_file);
         return false;
       }
 
@@ -565,6 +583,80 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
   return true;
 }
 
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::PrefetchGroups(u64 chunk_size, u64 data_offset, u64 data_size,
+                                           u32 group_index, u32 number_of_groups,
+                                           u64 first_group, u64 end_group, u32 exception_lists)
+{
+  const u32 thread_count = s_decompression_threads.load(std::memory_order_relaxed);
+  end_group = std::min<u64>(end_group, number_of_groups);
+  if (thread_count == 0 || first_group >= end_group)
+  {
+    m_pending_chunks.clear();
+    return;
+  }
+
+  // Anything queued earlier that isn't part of this range belongs to a read that the game has
+  // moved away from. Workers that are still busy with such a chunk just finish it unobserved.
+  std::map<u64, std::shared_ptr<PendingChunk>> still_wanted;
+
+  for (u64 i = first_group; i < end_group; ++i)
+  {
+    const u64 total_group_index = group_index + i;
+    if (total_group_index >= m_group_entries.size())
+      break;
+
+    const GroupEntry& group = m_group_entries[total_group_index];
+    const u64 group_offset_in_data = i * chunk_size;
+    if (group_offset_in_data >= data_size)
+      break;
+
+    u32 group_data_size = Common::swap32(group.data_size);
+    WIARVZCompressionType compression_type = m_compression_type;
+    u32 rvz_packed_size = 0;
+    if constexpr (RVZ)
+    {
+      if ((group_data_size & 0x80000000) == 0)
+        compression_type = WIARVZCompressionType::None;
+
+      group_data_size &= 0x7FFFFFFF;
+
+      rvz_packed_size = Common::swap32(group.rvz_packed_size);
+    }
+
+    const u64 group_offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
+    if (group_data_size == 0 || m_cached_chunks.contains(group_offset_in_file))
+      continue;
+
+    if (const auto it = m_pending_chunks.find(group_offset_in_file); it != m_pending_chunks.end())
+    {
+      still_wanted.emplace(group_offset_in_file, std::move(it->second));
+      continue;
+    }
+
+    if (m_decompression_threads.size() < thread_count)
+    {
+      File::IOFile file = m_file.Duplicate("rb");
+      if (!file.IsOpen())
+        break;
+      m_decompression_threads.emplace_back(std::make_unique<DecompressionThread>(std::move(file)));
+    }
+
+    DecompressionThread& thread =
+        *m_decompression_threads[m_next_decompression_thread++ % m_decompression_threads.size()];
+
+    auto pending = std::make_shared<PendingChunk>();
+    pending->chunk = CreateChunk(&thread.file, group_offset_in_file, group_data_size,
+                                 std::min(chunk_size, data_size - group_offset_in_data),
+                                 compression_type, exception_lists, rvz_packed_size,
+                                 group_offset_in_data);
+    thread.thread.Push(pending);
+    still_wanted.emplace(group_offset_in_file, std::move(pending));
+  }
+
+  m_pending_chunks = std::move(still_wanted);
+}
+
 template <bool RVZ>
 typename WIARVZFileReader<RVZ>::Chunk&
 WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_size,
@@ -572,9 +664,51 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
                                           WIARVZCompressionType compression_type,
                                           u32 exception_lists, u32 rvz_packed_size, u64 data_offset)
 {
-  if (offset_in_file == m_cached_chunk_offset)
-    return m_cached_chunk;
+  if (const auto it = m_cached_chunks.find(offset_in_file); it != m_cached_chunks.end())
+  {
+    m_chunk_lru.splice(m_chunk_lru.begin(), m_chunk_lru, it->second.lru_position);
+    return *it->second.chunk;
+  }
 
+  std::shared_ptr<Chunk> chunk;
+  if (const auto it = m_pending_chunks.find(offset_in_file); it != m_pending_chunks.end())
+  {
+    const std::shared_ptr<PendingChunk> pending = std::move(it->second);
+    m_pending_chunks.erase(it);
+
+    pending->done.Wait();
+    if (pending->success)
+    {
+      chunk = std::make_shared<Chunk>(std::move(pending->chunk));
+      chunk->SetFile(&m_file);
+    }
+  }
+
+  if (!chunk)
+  {
+    chunk = std::make_shared<Chunk>(CreateChunk(&m_file, offset_in_file, compressed_size,
+                                                decompressed_size, compression_type,
+                                                exception_lists, rvz_packed_size, data_offset));
+  }
+
+  m_chunk_lru.push_front(offset_in_file);
+  m_cached_chunks_size += chunk->GetAllocatedSize();
+  m_cached_chunks.emplace(offset_in_file, CachedChunk{chunk, m_chunk_lru.begin()});
+
+  // The chunk that was just added is never evicted here, since the caller is about to use it
+  const u64 max_size = s_max_chunk_cache_size.load(std::memory_order_relaxed);
+  while (m_cached_chunks_size > max_size && m_chunk_lru.size() > 1)
+    EvictChunk(m_chunk_lru.back());
+
+  return *chunk;
+}
+
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::Chunk
+WIARVZFileReader<RVZ>::CreateChunk(File::IOFile* file, u64 offset_in_file, u64 compressed_size,
+                                   u64 decompressed_size, WIARVZCompressionType compression_type,
+                                   u32 exception_lists, u32 rvz_packed_size, u64 data_offset) const
+{
   std::unique_ptr<Decompressor> decompressor;
   switch (compression_type)
   {
@@ -603,11 +737,36 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
 
   const bool compressed_exception_lists = compression_type > WIARVZCompressionType::Purge;
 
-  m_cached_chunk =
-      Chunk(&m_file, offset_in_file, compressed_size, decompressed_size, exception_lists,
-            compressed_exception_lists, rvz_packed_size, data_offset, std::move(decompressor));
-  m_cached_chunk_offset = offset_in_file;
-  return m_cached_chunk;
+  return Chunk(file, offset_in_file, compressed_size, decompressed_size, exception_lists,
+               compressed_exception_lists, rvz_packed_size, data_offset, std::move(decompressor));
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::EvictChunk(u64 offset_in_file)
+{
+  const auto it = m_cached_chunks.find(offset_in_file);
+  if (it == m_cached_chunks.end())
+    return;
+
+  m_cached_chunks_size -= it->second.chunk->GetAllocatedSize();
+  m_chunk_lru.erase(it->second.lru_position);
+  m_cached_chunks.erase(it);
+}
+
+template <bool RVZ>
+WIARVZFileReader<RVZ>::DecompressionThread::DecompressionThread(File::IOFile file_)
+    : file(std::move(file_))
+{
+  thread.Reset("WIA/RVZ Decompression", [](std::shared_ptr<PendingChunk> pending) {
+    pending->success = pending->chunk.DecompressAll();
+    pending->done.Set();
+  });
+}
+
+template <bool RVZ>
+WIARVZFileReader<RVZ>::DecompressionThread::~DecompressionThread()
+{
+  thread.Shutdown(true);
 }
 
 template <bool RVZ>
@@ -757,6 +916,17 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
   return true;
 }
 
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::DecompressAll()
+{
+  const size_t size = m_out.data.size() - m_out_bytes_allocated_for_exceptions;
+  if (size == 0)
+    return true;
+
+  u8 last_byte;
+  return Read(size - 1, 1, &last_byte);
+}
+
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::Chunk::Decompress()
 {
@@ -5,6 +5,7 @@
 
 #include <array>
 #include <limits>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -13,8 +14,10 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/Crypto/SHA1.h"
+#include "Common/Event.h"
 #include "Common/IOFile.h"
 #include "Common/Swap.h"
+#include "Common/WorkQueueThread.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/MultithreadedCompressor.h"
 #include "DiscIO/WIACompression.h"
@@ -37,6 +40,11 @@ enum class WIARVZCompressionType : u32
 
 std::pair<int, int> GetAllowedCompressionLevels(WIARVZCompressionType compression_type, bool gui);
 
+// Sets how many bytes of decompressed chunks each WIA/RVZ reader may keep cached, and how many
+// threads each reader may use for decompressing upcoming chunks ahead of time (0 disables this).
+// Takes effect for existing readers too.
+void SetWIARVZChunkCacheLimits(u64 max_cache_size, u32 decompression_threads);
+
 constexpr u32 WIA_MAGIC = 0x01414957;  // "WIA\x1" (byteswapped to little endian)
 constexpr u32 RVZ_MAGIC = 0x015A5652;  // "RVZ\x1" (byteswapped to little endian)
 
@@ -204,6 +212,12 @@ private:
       return Read(0, vector->size() * sizeof(T), reinterpret_cast<u8*>(vector->data()));
     }
 
+    // Decompresses all data up front, so that later reads don't have to access the file
+    bool DecompressAll();
+
+    void SetFile(File::IOFile* file) { m_file = file; }
+    size_t GetAllocatedSize() const { return m_in.data.size() + m_out.data.size(); }
+
   private:
     bool Decompress();
     bool HandleExceptions(const u8* data, size_t bytes_allocated, size_t bytes_written,
@@ -240,6 +254,15 @@ private:
   Chunk& ReadCompressedData(u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
                             WIARVZCompressionType compression_type, u32 exception_lists = 0,
                             u32 rvz_packed_size = 0, u64 data_offset = 0);
+  Chunk CreateChunk(File::IOFile* file, u64 offset_in_file, u64 compressed_size,
+                    u64 decompressed_size, WIARVZCompressionType compression_type,
+                    u32 exception_lists, u32 rvz_packed_size, u64 data_offset) const;
+  void EvictChunk(u64 offset_in_file);
+
+  // Starts decompressing groups first_group up to (but excluding) end_group of a data entry on the
+  // decompression threads, skipping the ones that are already cached.
+  void PrefetchGroups(u64 chunk_size, u64 data_offset, u64 data_size, u32 group_index,
+                      u32 number_of_groups, u64 first_group, u64 end_group, u32 exception_lists);
 
   static bool ApplyHashExceptions(const std::vector<HashExceptionEntry>& exception_list,
                                   VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]);
@@ -367,10 +390,19 @@ private:
 
   File::IOFile m_file;
   std::string m_path;
-  Chunk m_cached_chunk;
-  u64 m_cached_chunk_offset = std::numeric_limits<u64>::max();
   WiiEncryptionCache m_encryption_cache;
 
+  // Decompressed chunks by offset in the file, with the most recently used chunk at the front of
+  // m_chunk_lru.
+  struct CachedChunk
+  {
+    std::shared_ptr<Chunk> chunk;
+    std::list<u64>::iterator lru_position;
+  };
+  std::map<u64, CachedChunk> m_cached_chunks;
+  std::list<u64> m_chunk_lru;
+  size_t m_cached_chunks_size = 0;
+
   std::vector<HashExceptionEntry> m_exception_list;
   bool m_write_to_exception_list = false;
   u64 m_exception_list_last_group_index;
@@ -394,6 +426,29 @@ private:
   static constexpr u32 RVZ_VERSION = 0x01000000;
   static constexpr u32 RVZ_VERSION_WRITE_COMPATIBLE = 0x00030000;
   static constexpr u32 RVZ_VERSION_READ_COMPATIBLE = 0x00030000;
+
+  struct PendingChunk
+  {
+    Chunk chunk;
+    bool success = false;
+    Common::Event done;
+  };
+
+  struct DecompressionThread
+  {
+    explicit DecompressionThread(File::IOFile file_);
+    ~DecompressionThread();
+
+    File::IOFile file;
+    Common::WorkQueueThread<std::shared_ptr<PendingChunk>> thread;
+  };
+
+  // Chunks being decompressed ahead of time, by offset in the file. The decompression threads
+  // are only started once a read spans multiple chunks. These are declared last so that the
+  // threads are stopped before anything else is destroyed.
+  std::map<u64, std::shared_ptr<PendingChunk>> m_pending_chunks;
+  std::vector<std::unique_ptr<DecompressionThread>> m_decompression_threads;
+  size_t m_next_decompression_thread = 0;
 };
 
 using WIAFileReader = WIARVZFileReader<false>;
@@ -4,26 +4,43 @@
 #include "DolphinNoGUI/Platform.h"
 
 #include <OptionParser.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <functional>
+#include <optional>
 #include <signal.h>
 #include <string>
 #include <vector>
 
+#include <fmt/format.h>
+
 #ifndef _WIN32
 #include <unistd.h>
 #else
 #include <Windows.h>
 #endif
 
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
+#include "Common/HookableEvent.h"
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
+#include "Core/HW/Memmap.h"
 #include "Core/Host.h"
+#include "Core/MetricsServer.h"
+#include "Core/Movie.h"
 #include "Core/System.h"
 
 #include "UICommon/CommandLineParse.h"
@@ -35,8 +52,14 @@
 #include "InputCommon/GCAdapter.h"
 
 #include "VideoCommon/VideoBackendBase.h"
+#include "VideoCommon/VideoEvents.h"
 
 static std::unique_ptr<Platform> s_platform;
+static std::atomic<bool> s_shutdown_signaled = false;
+
+// Watches the movie given with --movie when --turbo or --hash_interval are used
+static Common::EventHook s_movie_frame_hook;
+static std::atomic<u64> s_movie_frames_played = 0;
 
 static void signal_handler(int)
 {
@@ -49,6 +72,7 @@ static void signal_handler(int)
   }
 #endif
 
+  s_shutdown_signaled = true;
   s_platform->RequestShutdown();
 }
 
@@ -160,6 +184,10 @@ static std::unique_ptr<Platform> GetPlatform(const optparse::Values& options)
 {
   std::string platform_name = static_cast<const char*>(options.get("platform"));
 
+  // Nothing is presented in turbo mode, so there's no need for a window
+  if (platform_name.empty() && options.is_set("turbo"))
+    platform_name = "headless";
+
 #if HAVE_X11
   if (platform_name == "x11" || platform_name.empty())
     return Platform::CreateX11Platform();
@@ -185,6 +213,57 @@ static std::unique_ptr<Platform> GetPlatform(const optparse::Values& options)
   return nullptr;
 }
 
+static void ApplyTurboSettings(const optparse::Values& options)
+{
+  // Presenting frames and playing back audio don't affect the emulated state, so skip all of it.
+  // The Null video backend also skips EFB copies, so another backend can be chosen with -v for
+  // games which depend on them.
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+  Config::SetCurrent(Config::MAIN_AUDIO_BACKEND, std::string(BACKEND_NULLSOUND));
+  Config::SetCurrent(Config::MAIN_MOVIE_PAUSE_MOVIE, false);
+  Config::SetCurrent(Config::MAIN_MOVIE_DUMP_FRAMES, false);
+  Config::SetCurrent(Config::MAIN_DUMP_AUDIO, false);
+  Config::SetCurrent(Config::GFX_VSYNC, false);
+  Config::SetCurrent(Config::GFX_HACK_SKIP_DUPLICATE_XFBS, true);
+  if (!options.is_set_by_user("video_backend"))
+    Config::SetCurrent(Config::MAIN_GFX_BACKEND, std::string("Null"));
+}
+
+// Prints a hash of the emulated memory, which tells whether two playbacks of a movie diverged
+// without depending on the video backend
+static void PrintMemoryHash(Core::System& system, u64 frame)
+{
+  auto& memory = system.GetMemory();
+  u32 crc = Common::StartCRC32();
+  crc = Common::UpdateCRC32(crc, memory.GetRAM(), memory.GetRamSizeReal());
+  if (memory.GetEXRAM())
+    crc = Common::UpdateCRC32(crc, memory.GetEXRAM(), memory.GetExRamSizeReal());
+
+  fmt::print(stdout, "Frame {}: {:08x}\n", frame, crc);
+  std::fflush(stdout);
+}
+
+static void WatchMovie(bool stop_at_end, u64 hash_interval)
+{
+  s_movie_frame_hook = VIEndFieldEvent::Register(
+      [stop_at_end, hash_interval] {
+        auto& system = Core::System::GetInstance();
+        auto& movie = system.GetMovie();
+        if (!movie.IsPlayingInput())
+        {
+          if (stop_at_end)
+            s_platform->Stop();
+          return;
+        }
+
+        const u64 frame = movie.GetCurrentFrame();
+        s_movie_frames_played = frame;
+        if (hash_interval != 0 && frame % hash_interval == 0)
+          PrintMemoryHash(system, frame);
+      },
+      "MovieVerification");
+}
+
 #ifdef _WIN32
 #define main app_main
 #endif
@@ -216,6 +295,35 @@ int main(int argc, char* argv[])
             "macos"
 #endif
       });
+  parser->add_option("-t", "--turbo")
+      .action("store_true")
+      .help("Play the movies given with --movie or --movie_list as fast as possible without "
+            "video or audio output, then exit");
+  parser->add_option("--movie_list")
+      .action("store")
+      .metavar("<file>")
+      .help("Play every movie listed in <file>, one path per line, one after another");
+  parser->add_option("--hash_interval")
+      .action("store")
+      .type("int")
+      .metavar("<frames>")
+      .help("While playing a movie, print a hash of the emulated memory every <frames> "
+            "frames");
+  parser->add_option("--fifo_benchmark")
+      .action("store")
+      .metavar("<file>")
+      .help("Play the given fifolog without a frame limit, then exit and write the timing of "
+            "every frame to <file>, as JSON if it ends in .json and as CSV otherwise");
+  parser->add_option("--fifo_benchmark_loops")
+      .action("store")
+      .type("int")
+      .metavar("<count>")
+      .help("How many times --fifo_benchmark plays the fifolog (default: 10)");
+  parser->add_option("--metrics_port")
+      .action("store")
+      .type("int")
+      .metavar("<port>")
+      .help("Serve performance metrics in the Prometheus format at http://<host>:<port>/metrics");
 
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
@@ -226,15 +334,18 @@ int main(int argc, char* argv[])
     save_state_path = static_cast<const char*>(options.get("save_state"));
   }
 
-  std::unique_ptr<BootParameters> boot;
+  // Every run, such as every movie of a --movie_list, boots from its own BootParameters
+  std::function<std::unique_ptr<BootParameters>()> create_boot;
   bool game_specified = false;
   if (options.is_set("exec"))
   {
     const std::list<std::string> paths_list = options.all("exec");
     const std::vector<std::string> paths{std::make_move_iterator(std::begin(paths_list)),
                                          std::make_move_iterator(std::end(paths_list))};
-    boot = BootParameters::GenerateFromFile(
-        paths, BootSessionData(save_state_path, DeleteSavestateAfterBoot::No));
+    create_boot = [paths, save_state_path] {
+      return BootParameters::GenerateFromFile(
+          paths, BootSessionData(save_state_path, DeleteSavestateAfterBoot::No));
+    };
     game_specified = true;
   }
   else if (options.is_set("nand_title"))
@@ -247,12 +358,16 @@ int main(int argc, char* argv[])
       return 1;
     }
     const u64 title_id = std::stoull(hex_string, nullptr, 16);
-    boot = std::make_unique<BootParameters>(BootParameters::NANDTitle{title_id});
+    create_boot = [title_id] {
+      return std::make_unique<BootParameters>(BootParameters::NANDTitle{title_id});
+    };
   }
   else if (args.size())
   {
-    boot = BootParameters::GenerateFromFile(
-        args.front(), BootSessionData(save_state_path, DeleteSavestateAfterBoot::No));
+    create_boot = [path = args.front(), save_state_path] {
+      return BootParameters::GenerateFromFile(
+          path, BootSessionData(save_state_path, DeleteSavestateAfterBoot::No));
+    };
     args.erase(args.begin());
     game_specified = true;
   }
@@ -262,6 +377,33 @@ int main(int argc, char* argv[])
     return 0;
   }
 
+  // An empty path stands for a run without a movie
+  std::vector<std::string> movie_paths;
+  if (options.is_set("movie_list"))
+  {
+    const std::string list_path = static_cast<const char*>(options.get("movie_list"));
+    std::string list;
+    if (!File::ReadFileToString(list_path, list))
+    {
+      fprintf(stderr, "Could not read the movie list %s\n", list_path.c_str());
+      return 1;
+    }
+    for (std::string& line : SplitString(list, '\n'))
+    {
+      line = StripWhitespace(line);
+      if (!line.empty())
+        movie_paths.push_back(std::move(line));
+    }
+  }
+  else if (options.is_set("movie"))
+  {
+    movie_paths.emplace_back(static_cast<const char*>(options.get("movie")));
+  }
+  else
+  {
+    movie_paths.emplace_back();
+  }
+
   std::string user_directory;
   if (options.is_set("user"))
     user_directory = static_cast<const char*>(options.get("user"));
@@ -284,12 +426,45 @@ int main(int argc, char* argv[])
     UICommon::Shutdown();
   });
 
+  if (options.is_set("metrics_port"))
+  {
+    Config::SetCurrent(Config::MAIN_NETWORK_METRICS_SERVER_PORT,
+                       static_cast<int>(options.get("metrics_port")));
+  }
+  const int metrics_port = Config::Get(Config::MAIN_NETWORK_METRICS_SERVER_PORT);
+  if (metrics_port > 0 && metrics_port <= 0xffff)
+    MetricsServer::Start(static_cast<u16>(metrics_port));
+  Common::ScopeGuard metrics_server_guard([] { MetricsServer::Stop(); });
+
   if (save_state_path && !game_specified)
   {
     fprintf(stderr, "A save state cannot be loaded without specifying a game to launch.\n");
     return 1;
   }
 
+  const bool turbo = options.is_set("turbo");
+  const u64 hash_interval =
+      options.is_set("hash_interval") ?
+          static_cast<u64>(std::max(static_cast<int>(options.get("hash_interval")), 0)) :
+          0;
+  if (movie_paths.front().empty() && (turbo || hash_interval != 0))
+  {
+    fprintf(stderr, "--turbo and --hash_interval require a movie to be specified.\n");
+    return 1;
+  }
+
+  std::string fifo_benchmark_path;
+  u32 fifo_benchmark_loops = 10;
+  if (options.is_set("fifo_benchmark"))
+  {
+    fifo_benchmark_path = static_cast<const char*>(options.get("fifo_benchmark"));
+    if (options.is_set("fifo_benchmark_loops"))
+    {
+      fifo_benchmark_loops =
+          static_cast<u32>(std::max(static_cast<int>(options.get("fifo_benchmark_loops")), 1));
+    }
+  }
+
   Core::AddOnStateChangedCallback([](Core::State state) {
     if (state == Core::State::Uninitialized)
       s_platform->Stop();
@@ -310,23 +485,82 @@ int main(int argc, char* argv[])
 
   DolphinAnalytics::Instance().ReportDolphinStart("nogui");
 
-  if (!BootManager::BootCore(Core::System::GetInstance(), std::move(boot), wsi))
+  // The movies of a list are played one after another, so that the process and everything it has
+  // loaded and cached is reused between them
+  int result = 0;
+  for (const std::string& movie_path : movie_paths)
   {
-    fprintf(stderr, "Could not boot the specified file\n");
-    return 1;
-  }
+    if (s_shutdown_signaled)
+      break;
+
+    // Set again for every run, since the settings of a run are reset when it ends
+    if (turbo)
+      ApplyTurboSettings(options);
+
+    if (!fifo_benchmark_path.empty())
+    {
+      Core::System::GetInstance().GetFifoPlayer().SetBenchmark(fifo_benchmark_loops,
+                                                               fifo_benchmark_path);
+    }
+
+    std::unique_ptr<BootParameters> boot = create_boot();
+    if (!movie_path.empty())
+    {
+      std::optional<std::string> movie_save_state_path;
+      if (!Core::System::GetInstance().GetMovie().PlayInput(movie_path, &movie_save_state_path))
+      {
+        fprintf(stderr, "Could not play the movie %s\n", movie_path.c_str());
+        result = 1;
+        continue;
+      }
+      if (movie_save_state_path)
+      {
+        boot->boot_session_data.SetSavestateData(std::move(movie_save_state_path),
+                                                 DeleteSavestateAfterBoot::No);
+      }
+
+      s_movie_frames_played = 0;
+      if (turbo || hash_interval != 0)
+        WatchMovie(turbo, hash_interval);
+    }
+
+    if (!BootManager::BootCore(Core::System::GetInstance(), std::move(boot), wsi))
+    {
+      fprintf(stderr, "Could not boot the specified file\n");
+      Core::System::GetInstance().GetMovie().EndPlayInput(false);
+      s_movie_frame_hook.reset();
+      result = 1;
+      continue;
+    }
 
 #ifdef USE_DISCORD_PRESENCE
-  Discord::UpdateDiscordPresence();
+    Discord::UpdateDiscordPresence();
 #endif
 
-  s_platform->MainLoop();
-  Core::Stop(Core::System::GetInstance());
+    const auto start_time = std::chrono::steady_clock::now();
+    s_platform->MainLoop();
+    Core::Stop(Core::System::GetInstance());
+    s_movie_frame_hook.reset();
+
+    if (turbo)
+    {
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+      const u64 frames = s_movie_frames_played;
+      fmt::print(stdout, "{}: Played {} frames in {:.2f} seconds ({:.1f} FPS)\n", movie_path,
+                 frames, elapsed.count(), elapsed.count() > 0 ? frames / elapsed.count() : 0.0);
+    }
+
+    // Waits for the emulation thread, which has to be done before booting again
+    Core::Shutdown(Core::System::GetInstance());
+    auto& movie = Core::System::GetInstance().GetMovie();
+    if (movie.IsMovieActive())
+      movie.EndPlayInput(false);
+    s_platform->Reset();
+  }
 
-  Core::Shutdown(Core::System::GetInstance());
   s_platform.reset();
 
-  return 0;
+  return result;
 }
 
 #ifdef _WIN32
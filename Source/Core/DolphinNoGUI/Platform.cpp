@@ -44,6 +44,13 @@ void Platform::Stop()
   m_running.Clear();
 }
 
+void Platform::Reset()
+{
+  m_running.Set();
+  m_shutdown_requested.Clear();
+  m_tried_graceful_shutdown.Clear();
+}
+
 void Platform::RequestShutdown()
 {
   m_shutdown_requested.Set();
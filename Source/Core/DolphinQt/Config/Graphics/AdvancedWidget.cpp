@@ -60,6 +60,8 @@ void AdvancedWidget::CreateWidgets()
   m_show_vps = new ConfigBool(tr("Show VPS"), Config::GFX_SHOW_VPS);
   m_show_vtimes = new ConfigBool(tr("Show VBlank Times"), Config::GFX_SHOW_VTIMES);
   m_show_graphs = new ConfigBool(tr("Show Performance Graphs"), Config::GFX_SHOW_GRAPHS);
+  m_show_frame_breakdown =
+      new ConfigBool(tr("Show Frame Time Breakdown"), Config::GFX_SHOW_FRAME_BREAKDOWN);
   m_show_speed = new ConfigBool(tr("Show % Speed"), Config::GFX_SHOW_SPEED);
   m_show_speed_colors = new ConfigBool(tr("Show Speed Colors"), Config::GFX_SHOW_SPEED_COLORS);
   m_perf_samp_window = new ConfigInteger(0, 10000, Config::GFX_PERF_SAMP_WINDOW, 100);
@@ -77,6 +79,7 @@ void AdvancedWidget::CreateWidgets()
   performance_layout->addWidget(m_perf_samp_window, 3, 1);
   performance_layout->addWidget(m_log_render_time, 4, 0);
   performance_layout->addWidget(m_show_speed_colors, 4, 1);
+  performance_layout->addWidget(m_show_frame_breakdown, 5, 0);
 
   // Debugging
   auto* debugging_box = new QGroupBox(tr("Debugging"));
@@ -191,11 +194,17 @@ void AdvancedWidget::CreateWidgets()
 
   m_defer_efb_access_invalidation =
       new ConfigBool(tr("Defer EFB Cache Invalidation"), Config::GFX_HACK_EFB_DEFER_INVALIDATION);
+  m_allow_stale_efb_access = new ConfigBool(tr("Allow One-Frame-Stale EFB Access"),
+                                            Config::GFX_HACK_EFB_ACCESS_ALLOW_STALE);
+  m_late_bbox_readback =
+      new ConfigBool(tr("Late Bounding Box Readback"), Config::GFX_HACK_BBOX_LATE_READBACK);
   m_manual_texture_sampling =
       new ConfigBool(tr("Manual Texture Sampling"), Config::GFX_HACK_FAST_TEXTURE_SAMPLING, true);
 
   experimental_layout->addWidget(m_defer_efb_access_invalidation, 0, 0);
   experimental_layout->addWidget(m_manual_texture_sampling, 0, 1);
+  experimental_layout->addWidget(m_allow_stale_efb_access, 1, 0);
+  experimental_layout->addWidget(m_late_bbox_readback, 1, 1);
 
   main_layout->addWidget(performance_box);
   main_layout->addWidget(debugging_box);
@@ -277,6 +286,11 @@ void AdvancedWidget::AddDescriptions()
       QT_TR_NOOP("Shows frametime graph along with statistics as a representation of "
                  "emulation performance.<br><br><dolphin_emphasis>If unsure, leave this "
                  "unchecked.</dolphin_emphasis>");
+  static const char TR_SHOW_FRAME_BREAKDOWN_DESCRIPTION[] =
+      QT_TR_NOOP("Shows a graph of how long each frame spent in parts of the emulation such as "
+                 "JIT compilation, vertex loading and shader compilation. If Log Render Time to "
+                 "File is enabled, the times are also written to User/Logs/frame_breakdown.csv."
+                 "<br><br><dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>");
   static const char TR_SHOW_SPEED_DESCRIPTION[] =
       QT_TR_NOOP("Shows the % speed of emulation compared to full speed."
                  "<br><br><dolphin_emphasis>If unsure, leave this "
@@ -406,6 +420,19 @@ void AdvancedWidget::AddDescriptions()
       "<br><br>May improve performance in some games which rely on CPU EFB Access at the cost "
       "of stability.<br><br><dolphin_emphasis>If unsure, leave this "
       "unchecked.</dolphin_emphasis>");
+  static const char TR_ALLOW_STALE_EFB_ACCESS_DESCRIPTION[] = QT_TR_NOOP(
+      "Reads back the EFB regions the CPU accessed recently at the end of every frame, and lets "
+      "EFB access during the following frame return that copy instead of waiting for the GPU. "
+      "<br><br>Greatly improves performance in games which use CPU EFB Access for effects such "
+      "as lens flares, but the values read are one frame old, which may cause visual glitches "
+      "or break games relying on them for game logic.<br><br><dolphin_emphasis>If unsure, leave "
+      "this unchecked.</dolphin_emphasis>");
+  static const char TR_LATE_BBOX_READBACK_DESCRIPTION[] = QT_TR_NOOP(
+      "Lets reads of the bounding box return the result of an earlier draw if the GPU hasn't "
+      "finished the latest one yet, instead of waiting for it.<br><br>Improves performance in "
+      "games which read the bounding box often, such as Paper Mario: The Thousand-Year Door, "
+      "but may cause visual glitches or break them.<br><br><dolphin_emphasis>If unsure, leave "
+      "this unchecked.</dolphin_emphasis>");
   static const char TR_MANUAL_TEXTURE_SAMPLING_DESCRIPTION[] = QT_TR_NOOP(
       "Use a manual implementation of texture sampling instead of the graphics backend's built-in "
       "functionality.<br><br>"
@@ -435,6 +462,7 @@ void AdvancedWidget::AddDescriptions()
   m_show_vps->SetDescription(tr(TR_SHOW_VPS_DESCRIPTION));
   m_show_vtimes->SetDescription(tr(TR_SHOW_VTIMES_DESCRIPTION));
   m_show_graphs->SetDescription(tr(TR_SHOW_GRAPHS_DESCRIPTION));
+  m_show_frame_breakdown->SetDescription(tr(TR_SHOW_FRAME_BREAKDOWN_DESCRIPTION));
   m_show_speed->SetDescription(tr(TR_SHOW_SPEED_DESCRIPTION));
   m_log_render_time->SetDescription(tr(TR_LOG_RENDERTIME_DESCRIPTION));
   m_show_speed_colors->SetDescription(tr(TR_SHOW_SPEED_COLORS_DESCRIPTION));
@@ -478,5 +506,7 @@ void AdvancedWidget::AddDescriptions()
   m_borderless_fullscreen->SetDescription(tr(TR_BORDERLESS_FULLSCREEN_DESCRIPTION));
 #endif
   m_defer_efb_access_invalidation->SetDescription(tr(TR_DEFER_EFB_ACCESS_INVALIDATION_DESCRIPTION));
+  m_allow_stale_efb_access->SetDescription(tr(TR_ALLOW_STALE_EFB_ACCESS_DESCRIPTION));
+  m_late_bbox_readback->SetDescription(tr(TR_LATE_BBOX_READBACK_DESCRIPTION));
   m_manual_texture_sampling->SetDescription(tr(TR_MANUAL_TEXTURE_SAMPLING_DESCRIPTION));
 }
@@ -41,6 +41,7 @@ private:
   ConfigBool* m_show_vps;
   ConfigBool* m_show_vtimes;
   ConfigBool* m_show_graphs;
+  ConfigBool* m_show_frame_breakdown;
   ConfigBool* m_show_speed;
   ConfigBool* m_show_speed_colors;
   ConfigInteger* m_perf_samp_window;
@@ -75,5 +76,7 @@ private:
 
   // Experimental
   ConfigBool* m_defer_efb_access_invalidation;
+  ConfigBool* m_allow_stale_efb_access;
+  ConfigBool* m_late_bbox_readback;
   ConfigBool* m_manual_texture_sampling;
 };
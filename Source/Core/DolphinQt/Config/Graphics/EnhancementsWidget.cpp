@@ -141,6 +141,8 @@ void EnhancementsWidget::CreateWidgets()
                                      static_cast<int>(OutputResamplingMode::SharpBilinear));
   m_output_resampling_combo->addItem(tr("Area Sampling"),
                                      static_cast<int>(OutputResamplingMode::AreaSampling));
+  m_output_resampling_combo->addItem(tr("Edge Adaptive (FSR 1)"),
+                                     static_cast<int>(OutputResamplingMode::EdgeAdaptive));
 
   m_configure_color_correction = new ToolTipPushButton(tr("Configure"));
 
@@ -543,6 +545,12 @@ void EnhancementsWidget::AddDescriptions()
                  "<br>Weighs pixels by the percentage of area they occupy. Gamma corrected."
                  "<br>Best for downscaling by more than 2x."
 
+                 "<br><br><b>Edge Adaptive (FSR 1)</b> - [12 samples]"
+                 "<br>Gamma corrected upscaling that follows the direction of edges,"
+                 "<br>keeping them sharp without adding halos."
+                 "<br>Allows a lower internal resolution for a similar looking output."
+                 "<br>Uses Area Sampling when downscaling."
+
                  "<br><br><dolphin_emphasis>If unsure, select 'Default'.</dolphin_emphasis>");
   static const char TR_COLOR_CORRECTION_DESCRIPTION[] =
       QT_TR_NOOP("A group of features to make the colors more accurate, matching the color space "
@@ -72,6 +72,8 @@ void GeneralWidget::CreateWidgets()
   m_custom_aspect_height->setHidden(true);
   m_adapter_combo = new ToolTipComboBox;
   m_enable_vsync = new ConfigBool(tr("V-Sync"), Config::GFX_VSYNC);
+  m_low_latency_present =
+      new ConfigBool(tr("Low Latency Presentation"), Config::GFX_LOW_LATENCY_PRESENT);
   m_enable_fullscreen = new ConfigBool(tr("Start in Fullscreen"), Config::MAIN_FULLSCREEN);
 
   m_video_box->setLayout(m_video_layout);
@@ -97,6 +99,7 @@ void GeneralWidget::CreateWidgets()
 
   m_video_layout->addWidget(m_enable_vsync, 5, 0);
   m_video_layout->addWidget(m_enable_fullscreen, 5, 1, 1, -1);
+  m_video_layout->addWidget(m_low_latency_present, 6, 0, 1, -1);
 
   // Other
   auto* m_options_box = new QGroupBox(tr("Other"));
@@ -275,6 +278,14 @@ void GeneralWidget::AddDescriptions()
       "if emulation speed is below 100%.<br><br><dolphin_emphasis>If unsure, leave "
       "this "
       "unchecked.</dolphin_emphasis>");
+  static const char TR_LOW_LATENCY_PRESENT_DESCRIPTION[] = QT_TR_NOOP(
+      "Waits for the previous frame to be shown before presenting the next one, so that frames "
+      "don't queue up behind each other. This reduces input latency, especially with V-Sync, "
+      "but can lower performance if the GPU can't keep up.<br><br>The estimated latency from "
+      "reading the controllers to showing the frame is shown with the frame time "
+      "statistics.<br><br>Supported by the D3D11, D3D12, Metal and Vulkan backends. Vulkan "
+      "requires VK_KHR_present_wait.<br><br><dolphin_emphasis>If unsure, leave this "
+      "unchecked.</dolphin_emphasis>");
   static const char TR_SHOW_NETPLAY_PING_DESCRIPTION[] = QT_TR_NOOP(
       "Shows the player's maximum ping while playing on "
       "NetPlay.<br><br><dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>");
@@ -323,6 +334,8 @@ void GeneralWidget::AddDescriptions()
 
   m_enable_vsync->SetDescription(tr(TR_VSYNC_DESCRIPTION));
 
+  m_low_latency_present->SetDescription(tr(TR_LOW_LATENCY_PRESENT_DESCRIPTION));
+
   m_enable_fullscreen->SetDescription(tr(TR_FULLSCREEN_DESCRIPTION));
 
   m_show_ping->SetDescription(tr(TR_SHOW_NETPLAY_PING_DESCRIPTION));
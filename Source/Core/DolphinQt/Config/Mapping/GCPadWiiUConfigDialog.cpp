@@ -6,6 +6,8 @@
 #include <QCheckBox>
 #include <QDialogButtonBox>
 #include <QLabel>
+#include <QStringList>
+#include <QTimer>
 #include <QVBoxLayout>
 
 #include "Core/Config/MainSettings.h"
@@ -38,6 +40,8 @@ void GCPadWiiUConfigDialog::CreateLayout()
   m_status_label = new QLabel();
   m_rumble = new QCheckBox(tr("Enable Rumble"));
   m_simulate_bongos = new QCheckBox(tr("Simulate DK Bongos"));
+  m_polling_label = new QLabel();
+  m_polling_timer = new QTimer(this);
   m_button_box = new QDialogButtonBox(QDialogButtonBox::Ok);
 
   UpdateAdapterStatus();
@@ -48,6 +52,7 @@ void GCPadWiiUConfigDialog::CreateLayout()
   m_layout->addWidget(m_status_label);
   m_layout->addWidget(m_rumble);
   m_layout->addWidget(m_simulate_bongos);
+  m_layout->addWidget(m_polling_label);
   m_layout->addWidget(m_button_box);
 
   setLayout(m_layout);
@@ -58,6 +63,10 @@ void GCPadWiiUConfigDialog::ConnectWidgets()
   connect(m_rumble, &QCheckBox::toggled, this, &GCPadWiiUConfigDialog::SaveSettings);
   connect(m_simulate_bongos, &QCheckBox::toggled, this, &GCPadWiiUConfigDialog::SaveSettings);
   connect(m_button_box, &QDialogButtonBox::accepted, this, &GCPadWiiUConfigDialog::accept);
+  connect(m_polling_timer, &QTimer::timeout, this, &GCPadWiiUConfigDialog::UpdatePollingStats);
+
+  UpdatePollingStats();
+  m_polling_timer->start(1000);
 }
 
 void GCPadWiiUConfigDialog::UpdateAdapterStatus()
@@ -85,6 +94,46 @@ void GCPadWiiUConfigDialog::UpdateAdapterStatus()
   m_simulate_bongos->setEnabled(detected);
 }
 
+void GCPadWiiUConfigDialog::UpdatePollingStats()
+{
+  const GCAdapter::PollingStats stats = GCAdapter::GetPollingStats();
+
+  u64 intervals = 0;
+  for (const u64 count : stats.interval_histogram)
+    intervals += count;
+
+  if (intervals == 0)
+  {
+    m_polling_label->clear();
+    return;
+  }
+
+  QStringList lines{tr("Time between polls:")};
+  for (size_t i = 0; i < stats.interval_histogram.size(); ++i)
+  {
+    const u64 count = stats.interval_histogram[i];
+    if (count == 0)
+      continue;
+
+    const double percentage = 100.0 * count / intervals;
+    const double min_ms = i * GCAdapter::PollingStats::BUCKET_US / 1000.0;
+    if (i == stats.interval_histogram.size() - 1)
+    {
+      lines.push_back(tr("%1 ms or more: %2%").arg(min_ms, 0, 'f', 2).arg(percentage, 0, 'f', 1));
+    }
+    else
+    {
+      const double max_ms = min_ms + GCAdapter::PollingStats::BUCKET_US / 1000.0;
+      lines.push_back(tr("%1 to %2 ms: %3%")
+                          .arg(min_ms, 0, 'f', 2)
+                          .arg(max_ms, 0, 'f', 2)
+                          .arg(percentage, 0, 'f', 1));
+    }
+  }
+
+  m_polling_label->setText(lines.join(QLatin1Char('\n')));
+}
+
 void GCPadWiiUConfigDialog::LoadSettings()
 {
   m_rumble->setChecked(Config::Get(Config::GetInfoForAdapterRumble(m_port)));
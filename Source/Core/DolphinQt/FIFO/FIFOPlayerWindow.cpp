@@ -144,8 +144,11 @@ void FIFOPlayerWindow::CreateWidgets()
   m_frame_record_count->setMaximum(3600);
   m_frame_record_count->setValue(3);
 
+  m_compress = new ToolTipCheckBox(tr("Compress Saved Logs"));
+
   recording_layout->addWidget(m_frame_record_count_label);
   recording_layout->addWidget(m_frame_record_count);
+  recording_layout->addWidget(m_compress);
   recording_group->setLayout(recording_layout);
 
   m_button_box = new QDialogButtonBox(QDialogButtonBox::Close);
@@ -181,6 +184,7 @@ void FIFOPlayerWindow::LoadSettings()
 {
   m_early_memory_updates->setChecked(Config::Get(Config::MAIN_FIFOPLAYER_EARLY_MEMORY_UPDATES));
   m_loop->setChecked(Config::Get(Config::MAIN_FIFOPLAYER_LOOP_REPLAY));
+  m_compress->setChecked(Config::Get(Config::MAIN_FIFOPLAYER_COMPRESS_RECORDINGS));
 }
 
 void FIFOPlayerWindow::ConnectWidgets()
@@ -192,6 +196,7 @@ void FIFOPlayerWindow::ConnectWidgets()
   connect(m_button_box, &QDialogButtonBox::rejected, this, &FIFOPlayerWindow::hide);
   connect(m_early_memory_updates, &QCheckBox::toggled, this, &FIFOPlayerWindow::OnConfigChanged);
   connect(m_loop, &QCheckBox::toggled, this, &FIFOPlayerWindow::OnConfigChanged);
+  connect(m_compress, &QCheckBox::toggled, this, &FIFOPlayerWindow::OnConfigChanged);
 
   connect(m_frame_range_from, &QSpinBox::valueChanged, this, &FIFOPlayerWindow::OnLimitsChanged);
   connect(m_frame_range_to, &QSpinBox::valueChanged, this, &FIFOPlayerWindow::OnLimitsChanged);
@@ -210,9 +215,15 @@ void FIFOPlayerWindow::AddDescriptions()
       QT_TR_NOOP("If unchecked, then playback of the fifolog stops after the final frame.<br><br>"
                  "This is generally only useful when a frame-dumping option is enabled.<br><br>"
                  "<dolphin_emphasis>If unsure, leave this checked.</dolphin_emphasis>");
+  static const char TR_COMPRESS_DESCRIPTION[] =
+      QT_TR_NOOP("If checked, then the frames of saved fifologs are compressed with zstd.<br><br>"
+                 "This makes large fifologs much smaller, but they can't be played by versions "
+                 "of Dolphin from before this option was added.<br><br>"
+                 "<dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>");
 
   m_early_memory_updates->SetDescription(tr(TR_MEMORY_UPDATES_DESCRIPTION));
   m_loop->SetDescription(tr(TR_LOOP_DESCRIPTION));
+  m_compress->SetDescription(tr(TR_COMPRESS_DESCRIPTION));
 }
 
 void FIFOPlayerWindow::LoadRecording()
@@ -236,7 +247,7 @@ void FIFOPlayerWindow::SaveRecording()
 
   FifoDataFile* file = m_fifo_recorder.GetRecordedFile();
 
-  bool result = file->Save(path.toStdString());
+  bool result = file->Save(path.toStdString(), m_compress->isChecked());
 
   if (!result)
   {
@@ -309,8 +320,9 @@ void FIFOPlayerWindow::UpdateInfo()
 
     for (u32 i = 0; i < file->GetFrameCount(); ++i)
     {
-      fifo_bytes += file->GetFrame(i).fifoData.size();
-      for (const auto& mem_update : file->GetFrame(i).memoryUpdates)
+      const auto frame = file->GetFrame(i);
+      fifo_bytes += frame->fifoData.size();
+      for (const auto& mem_update : frame->memoryUpdates)
         mem_bytes += mem_update.data.size();
     }
 
@@ -356,6 +368,7 @@ void FIFOPlayerWindow::OnConfigChanged()
   Config::SetBase(Config::MAIN_FIFOPLAYER_EARLY_MEMORY_UPDATES,
                   m_early_memory_updates->isChecked());
   Config::SetBase(Config::MAIN_FIFOPLAYER_LOOP_REPLAY, m_loop->isChecked());
+  Config::SetBase(Config::MAIN_FIFOPLAYER_COMPRESS_RECORDINGS, m_compress->isChecked());
 }
 
 void FIFOPlayerWindow::OnLimitsChanged()
@@ -28,7 +28,7 @@ static const QStringList game_filters{
     QStringLiteral("*.[wW][iI][aA]"),    QStringLiteral("*.[rR][vV][zZ]"),
     QStringLiteral("hif_000000.nfs"),    QStringLiteral("*.[wW][aA][dD]"),
     QStringLiteral("*.[eE][lL][fF]"),    QStringLiteral("*.[dD][oO][lL]"),
-    QStringLiteral("*.[jJ][sS][oO][nN]")};
+    QStringLiteral("*.[jJ][sS][oO][nN]"), QStringLiteral("*.[dD][dD][uU][pP]")};
 
 GameTracker::GameTracker(QObject* parent) : QFileSystemWatcher(parent)
 {
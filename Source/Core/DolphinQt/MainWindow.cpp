@@ -12,6 +12,7 @@
 #include <QDropEvent>
 #include <QFileInfo>
 #include <QIcon>
+#include <QInputDialog>
 #include <QMimeData>
 #include <QStackedWidget>
 #include <QStyleHints>
@@ -20,6 +21,8 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <climits>
 #include <future>
 #include <optional>
 #include <variant>
@@ -574,6 +577,7 @@ void MainWindow::ConnectMenuBar()
   connect(m_menu_bar, &MenuBar::StartRecording, this, &MainWindow::OnStartRecording);
   connect(m_menu_bar, &MenuBar::StopRecording, this, &MainWindow::OnStopRecording);
   connect(m_menu_bar, &MenuBar::ExportRecording, this, &MainWindow::OnExportRecording);
+  connect(m_menu_bar, &MenuBar::SeekRecording, this, &MainWindow::OnSeekRecording);
   connect(m_menu_bar, &MenuBar::ShowTASInput, this, &MainWindow::ShowTASInput);
 
   // View
@@ -775,7 +779,7 @@ QStringList MainWindow::PromptFileNames()
       this, tr("Select a File"),
       settings.value(QStringLiteral("mainwindow/lastdir"), QString{}).toString(),
       QStringLiteral("%1 (*.elf *.dol *.gcm *.iso *.tgc *.wbfs *.ciso *.gcz *.wia *.rvz "
-                     "hif_000000.nfs *.wad *.dff *.m3u *.json);;%2 (*)")
+                     "*.ddup hif_000000.nfs *.wad *.dff *.m3u *.json);;%2 (*)")
           .arg(tr("All GC/Wii files"))
           .arg(tr("All Files")));
 
@@ -1941,6 +1945,34 @@ void MainWindow::OnExportRecording()
     system.GetMovie().SaveRecording(dtm_file.toStdString());
 }
 
+void MainWindow::OnSeekRecording()
+{
+  auto& movie = Core::System::GetInstance().GetMovie();
+  if (!movie.IsPlayingInput())
+  {
+    ModalMessageBox::information(this, tr("Seek to Frame"),
+                                 tr("Seeking is only possible while playing back a movie."));
+    return;
+  }
+
+  bool ok;
+  const int frame = QInputDialog::getInt(
+      this, tr("Seek to Frame"), tr("Frame:"),
+      static_cast<int>(std::min<u64>(movie.GetCurrentFrame(), INT_MAX)), 0,
+      static_cast<int>(std::min<u64>(movie.GetTotalFrames(), INT_MAX)), 1, &ok);
+  if (!ok)
+    return;
+
+  if (!movie.SeekToFrame(static_cast<u64>(frame)))
+  {
+    ModalMessageBox::warning(this, tr("Seek to Frame"),
+                             tr("Seeking back to frame %1 requires a seek index state before it. "
+                                "Enable \"Create Seek Index During Playback\" and play the movie "
+                                "past that frame first.")
+                                 .arg(frame));
+  }
+}
+
 void MainWindow::OnActivateChat()
 {
   if (g_netplay_chat_ui)
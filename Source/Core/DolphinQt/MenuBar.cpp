@@ -13,6 +13,7 @@
 #include <QFontDialog>
 #include <QInputDialog>
 #include <QMap>
+#include <QSignalBlocker>
 #include <QUrl>
 
 #include <fmt/format.h>
@@ -22,6 +23,7 @@
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/StringUtil.h"
+#include "Common/Tracing.h"
 
 #include "Core/AchievementManager.h"
 #include "Core/Boot/Boot.h"
@@ -137,6 +139,7 @@ void MenuBar::OnEmulationStateChanged(Core::State state)
   {
     m_recording_stop->setEnabled(false);
     m_recording_export->setEnabled(false);
+    m_recording_seek->setEnabled(false);
   }
   const bool can_start_from_boot = m_game_selected && state == Core::State::Uninitialized;
   const bool can_start_from_savestate =
@@ -156,6 +159,13 @@ void MenuBar::OnEmulationStateChanged(Core::State state)
   m_jit_log_coverage->setEnabled(!running);
   m_jit_search_instruction->setEnabled(running);
   m_jit_write_cache_log_dump->setEnabled(running && jit_exists);
+  m_jit_record_trace->setEnabled(running && jit_exists);
+  if (!running)
+  {
+    // The trace has been finished on shutdown already
+    const QSignalBlocker blocker(m_jit_record_trace);
+    m_jit_record_trace->setChecked(false);
+  }
 
   // Symbols
   m_symbols->setEnabled(running);
@@ -220,6 +230,66 @@ void MenuBar::OnWriteJitBlockLogDump()
   }
 }
 
+void MenuBar::OnRecordInstructionTrace(bool enabled)
+{
+  auto& system = Core::System::GetInstance();
+  auto& trace_recorder = system.GetPowerPC().GetTraceRecorder();
+
+  if (!enabled)
+  {
+    u64 record_count;
+    {
+      const Core::CPUThreadGuard guard(system);
+      record_count = trace_recorder.GetRecordCount();
+      trace_recorder.Stop(guard);
+    }
+    ModalMessageBox::information(this, tr("Success"),
+                                 tr("Recorded %1 instructions.").arg(record_count));
+    return;
+  }
+
+  const std::string filename = fmt::format("{}{}.trace", File::GetUserPath(D_DUMPDEBUG_IDX),
+                                           SConfig::GetInstance().GetGameID());
+  bool started;
+  {
+    const Core::CPUThreadGuard guard(system);
+    started = trace_recorder.Start(guard, filename);
+  }
+  if (!started)
+  {
+    ModalMessageBox::warning(
+        this, tr("Error"),
+        tr("Failed to open \"%1\" for writing.").arg(QString::fromStdString(filename)));
+    const QSignalBlocker blocker(m_jit_record_trace);
+    m_jit_record_trace->setChecked(false);
+  }
+}
+
+void MenuBar::OnRecordPerformanceTrace(bool enabled)
+{
+  const std::string filename = File::GetUserPath(D_DUMPDEBUG_IDX) + "trace.json";
+
+  if (enabled)
+  {
+    File::CreateFullPath(filename);
+    Common::Tracing::Start(filename);
+    return;
+  }
+
+  if (!Common::Tracing::Stop())
+  {
+    ModalMessageBox::warning(
+        this, tr("Error"),
+        tr("Failed to write the trace to \"%1\".").arg(QString::fromStdString(filename)));
+    return;
+  }
+
+  ModalMessageBox::information(
+      this, tr("Success"),
+      tr("Wrote the trace to \"%1\". It can be opened with chrome://tracing or Perfetto.")
+          .arg(QString::fromStdString(filename)));
+}
+
 void MenuBar::AddFileMenu()
 {
   QMenu* file_menu = addMenu(tr("&File"));
@@ -784,11 +854,14 @@ void MenuBar::AddMovieMenu()
                                            [this] { emit StopRecording(); });
   m_recording_export =
       movie_menu->addAction(tr("Export Recording..."), this, [this] { emit ExportRecording(); });
+  m_recording_seek =
+      movie_menu->addAction(tr("Seek to Frame..."), this, [this] { emit SeekRecording(); });
 
   m_recording_start->setEnabled(false);
   m_recording_play->setEnabled(false);
   m_recording_stop->setEnabled(false);
   m_recording_export->setEnabled(false);
+  m_recording_seek->setEnabled(false);
 
   m_recording_read_only = movie_menu->addAction(tr("&Read-Only Mode"));
   m_recording_read_only->setCheckable(true);
@@ -806,6 +879,12 @@ void MenuBar::AddMovieMenu()
   connect(pause_at_end, &QAction::toggled,
           [](bool value) { Config::SetBaseOrCurrent(Config::MAIN_MOVIE_PAUSE_MOVIE, value); });
 
+  auto* seek_index = movie_menu->addAction(tr("Create Seek Index During Playback"));
+  seek_index->setCheckable(true);
+  seek_index->setChecked(Config::Get(Config::MAIN_MOVIE_SEEK_INDEX));
+  connect(seek_index, &QAction::toggled,
+          [](bool value) { Config::SetBaseOrCurrent(Config::MAIN_MOVIE_SEEK_INDEX, value); });
+
   auto* rerecord_counter = movie_menu->addAction(tr("Show Rerecord Counter"));
   rerecord_counter->setCheckable(true);
   rerecord_counter->setChecked(Config::Get(Config::MAIN_MOVIE_SHOW_RERECORD));
@@ -923,6 +1002,13 @@ void MenuBar::AddJITMenu()
   });
   m_jit_write_cache_log_dump =
       m_jit->addAction(tr("Write JIT Block Log Dump"), this, &MenuBar::OnWriteJitBlockLogDump);
+  m_jit_record_trace = m_jit->addAction(tr("Record Instruction Trace"));
+  m_jit_record_trace->setCheckable(true);
+  connect(m_jit_record_trace, &QAction::toggled, this, &MenuBar::OnRecordInstructionTrace);
+  m_jit_record_performance_trace = m_jit->addAction(tr("Record Performance Trace"));
+  m_jit_record_performance_trace->setCheckable(true);
+  connect(m_jit_record_performance_trace, &QAction::toggled, this,
+          &MenuBar::OnRecordPerformanceTrace);
 
   m_jit->addSeparator();
 
@@ -1279,6 +1365,7 @@ void MenuBar::OnRecordingStatusChanged(bool recording)
   m_recording_start->setEnabled(!recording && (can_start_from_boot || can_start_from_savestate));
   m_recording_stop->setEnabled(recording);
   m_recording_export->setEnabled(recording);
+  m_recording_seek->setEnabled(recording);
 }
 
 void MenuBar::OnReadOnlyModeChanged(bool read_only)
@@ -1562,11 +1649,15 @@ void MenuBar::LoadSymbolMap()
     {
       const Core::CPUThreadGuard guard(system);
 
-      PPCAnalyst::FindFunctions(guard, Memory::MEM1_BASE_ADDR + 0x1300000,
-                                Memory::MEM1_BASE_ADDR + memory.GetRamSizeReal(), &ppc_symbol_db);
-      SignatureDB db(SignatureDB::HandlerType::DSY);
-      if (db.Load(File::GetSysDirectory() + TOTALDB))
-        db.Apply(guard, &ppc_symbol_db);
+      if (!ppc_symbol_db.LoadSymbolCache(guard, CBoot::GetSymbolCacheFile()))
+      {
+        PPCAnalyst::FindFunctions(guard, Memory::MEM1_BASE_ADDR + 0x1300000,
+                                  Memory::MEM1_BASE_ADDR + memory.GetRamSizeReal(),
+                                  &ppc_symbol_db);
+        SignatureDB db(SignatureDB::HandlerType::DSY);
+        if (db.Load(File::GetSysDirectory() + TOTALDB))
+          db.Apply(guard, &ppc_symbol_db);
+      }
     }
 
     ModalMessageBox::warning(this, tr("Warning"),
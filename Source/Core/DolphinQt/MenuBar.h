@@ -119,6 +119,7 @@ signals:
   void StartRecording();
   void StopRecording();
   void ExportRecording();
+  void SeekRecording();
   void ShowTASInput();
 
   void SelectionChanged(std::shared_ptr<const UICommon::GameFile> game_file);
@@ -186,6 +187,8 @@ private:
   void OnReadOnlyModeChanged(bool read_only);
   void OnDebugModeToggled(bool enabled);
   void OnWriteJitBlockLogDump();
+  void OnRecordInstructionTrace(bool enabled);
+  void OnRecordPerformanceTrace(bool enabled);
 
   QString GetSignatureSelector() const;
 
@@ -232,6 +235,7 @@ private:
 
   // Movie
   QAction* m_recording_export;
+  QAction* m_recording_seek;
   QAction* m_recording_play;
   QAction* m_recording_start;
   QAction* m_recording_stop;
@@ -271,6 +275,8 @@ private:
   QAction* m_jit_search_instruction;
   QAction* m_jit_profile_blocks;
   QAction* m_jit_write_cache_log_dump;
+  QAction* m_jit_record_trace;
+  QAction* m_jit_record_performance_trace;
   QAction* m_jit_off;
   QAction* m_jit_loadstore_off;
   QAction* m_jit_loadstore_lbzx_off;
@@ -208,6 +208,15 @@ void NetPlayDialog::CreateMainLayout()
   m_network_mode_group->addAction(m_golf_mode_action);
   m_fixed_delay_action->setChecked(true);
 
+  m_network_menu->addSeparator();
+  m_desync_recovery_action = m_network_menu->addAction(tr("Recover From Desyncs"));
+  m_desync_recovery_action->setToolTip(
+      tr("When a player desyncs, sends them the state of the host's game, which they load and "
+         "then catch up with the others at unlimited speed.
+Only works with Fair Input Delay "
+         "and GameCube controllers."));
+  m_desync_recovery_action->setCheckable(true);
+
   m_game_digest_menu = m_menu_bar->addMenu(tr("Checksum"));
   m_game_digest_menu->addAction(tr("Current game"), this, [this] {
     Settings::Instance().GetNetPlayServer()->ComputeGameDigest(m_current_game_identifier);
@@ -227,12 +236,19 @@ void NetPlayDialog::CreateMainLayout()
   });
 
   m_other_menu = m_menu_bar->addMenu(tr("Other"));
+  m_other_menu->setToolTipsVisible(true);
   m_record_input_action = m_other_menu->addAction(tr("Record Inputs"));
   m_record_input_action->setCheckable(true);
   m_golf_mode_overlay_action = m_other_menu->addAction(tr("Show Golf Mode Overlay"));
   m_golf_mode_overlay_action->setCheckable(true);
   m_hide_remote_gbas_action = m_other_menu->addAction(tr("Hide Remote GBAs"));
   m_hide_remote_gbas_action->setCheckable(true);
+  m_rollback_action = m_other_menu->addAction(tr("Predict Remote Inputs (Rollback)"));
+  m_rollback_action->setCheckable(true);
+  m_rollback_action->setToolTip(
+      tr("Instead of waiting for the inputs of other players, assumes they stay the same and "
+         "corrects the emulation once they arrive. Takes effect when the next game starts and "
+         "only covers GameCube controllers."));
 
   m_game_button->setDefault(false);
   m_game_button->setAutoDefault(false);
@@ -426,6 +442,8 @@ void NetPlayDialog::ConnectWidgets()
   connect(m_golf_mode_overlay_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   connect(m_fixed_delay_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
   connect(m_hide_remote_gbas_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
+  connect(m_rollback_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
+  connect(m_desync_recovery_action, &QAction::toggled, this, &NetPlayDialog::SaveSettings);
 }
 
 void NetPlayDialog::SendMessage(const std::string& msg)
@@ -1137,6 +1155,8 @@ void NetPlayDialog::LoadSettings()
   const bool strict_settings_sync = Config::Get(Config::NETPLAY_STRICT_SETTINGS_SYNC);
   const bool golf_mode_overlay = Config::Get(Config::NETPLAY_GOLF_MODE_OVERLAY);
   const bool hide_remote_gbas = Config::Get(Config::NETPLAY_HIDE_REMOTE_GBAS);
+  const bool rollback = Config::Get(Config::NETPLAY_ROLLBACK);
+  const bool desync_recovery = Config::Get(Config::NETPLAY_DESYNC_RECOVERY);
 
   m_buffer_size_box->setValue(buffer_size);
 
@@ -1153,6 +1173,8 @@ void NetPlayDialog::LoadSettings()
   m_strict_settings_sync_action->setChecked(strict_settings_sync);
   m_golf_mode_overlay_action->setChecked(golf_mode_overlay);
   m_hide_remote_gbas_action->setChecked(hide_remote_gbas);
+  m_rollback_action->setChecked(rollback);
+  m_desync_recovery_action->setChecked(desync_recovery);
 
   const std::string network_mode = Config::Get(Config::NETPLAY_NETWORK_MODE);
 
@@ -1196,6 +1218,8 @@ void NetPlayDialog::SaveSettings()
   Config::SetBase(Config::NETPLAY_STRICT_SETTINGS_SYNC, m_strict_settings_sync_action->isChecked());
   Config::SetBase(Config::NETPLAY_GOLF_MODE_OVERLAY, m_golf_mode_overlay_action->isChecked());
   Config::SetBase(Config::NETPLAY_HIDE_REMOTE_GBAS, m_hide_remote_gbas_action->isChecked());
+  Config::SetBase(Config::NETPLAY_ROLLBACK, m_rollback_action->isChecked());
+  Config::SetBase(Config::NETPLAY_DESYNC_RECOVERY, m_desync_recovery_action->isChecked());
 
   std::string network_mode;
   if (m_fixed_delay_action->isChecked())
@@ -3,11 +3,15 @@
 
 #include "DolphinTool/ConvertCommand.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <iostream>
 #include <limits>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <OptionParser.h>
@@ -15,8 +19,10 @@
 #include <fmt/ostream.h>
 
 #include "Common/CommonTypes.h"
+#include "Common/StringUtil.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/DiscUtils.h"
+#include "DiscIO/MultithreadedCompressor.h"
 #include "DiscIO/ScrubbedBlob.h"
 #include "DiscIO/Volume.h"
 #include "DiscIO/VolumeDisc.h"
@@ -56,6 +62,234 @@ static std::optional<DiscIO::BlobType> ParseFormatString(const std::string& form
   return std::nullopt;
 }
 
+static std::string GetFormatExtension(DiscIO::BlobType format)
+{
+  switch (format)
+  {
+  case DiscIO::BlobType::GCZ:
+    return ".gcz";
+  case DiscIO::BlobType::WIA:
+    return ".wia";
+  case DiscIO::BlobType::RVZ:
+    return ".rvz";
+  default:
+    return ".iso";
+  }
+}
+
+namespace
+{
+struct ConvertSettings
+{
+  DiscIO::BlobType format;
+  bool scrub;
+  std::optional<int> block_size;
+  std::optional<DiscIO::WIARVZCompressionType> compression;
+  std::optional<int> compression_level;
+};
+}  // namespace
+
+// Messages are prefixed with message_prefix, so that they can be told apart in batch mode
+static bool ConvertImage(const std::string& input_file_path, const std::string& output_file_path,
+                         const ConvertSettings& settings, const std::string& message_prefix,
+                         const DiscIO::CompressCB& callback)
+{
+  const DiscIO::BlobType format = settings.format;
+  const bool scrub = settings.scrub;
+
+  // Open the blob reader
+  std::unique_ptr<DiscIO::BlobReader> blob_reader = DiscIO::CreateBlobReader(input_file_path);
+  if (!blob_reader)
+  {
+    fmt::print(std::cerr, "{}Error: The input file could not be opened.\n", message_prefix);
+    return false;
+  }
+
+  // Open the volume
+  std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateDisc(input_file_path);
+  if (!volume)
+  {
+    if (scrub)
+    {
+      fmt::print(std::cerr, "{}Error: Scrubbing is only supported for GC/Wii disc images.\n",
+                 message_prefix);
+      return false;
+    }
+
+    fmt::print(std::cerr,
+               "{}Warning: The input file is not a GC/Wii disc image. Continuing anyway.\n",
+               message_prefix);
+  }
+
+  if (scrub)
+  {
+    if (volume->IsDatelDisc())
+    {
+      fmt::print(std::cerr, "{}Error: Scrubbing a Datel disc is not supported.\n",
+                 message_prefix);
+      return false;
+    }
+
+    blob_reader = DiscIO::ScrubbedBlob::Create(input_file_path);
+
+    if (!blob_reader)
+    {
+      fmt::print(std::cerr,
+                 "{}Error: Unable to process disc image. Try again without --scrub.\n",
+                 message_prefix);
+      return false;
+    }
+  }
+
+  if (!scrub && format == DiscIO::BlobType::GCZ && volume &&
+      volume->GetVolumeType() == DiscIO::Platform::WiiDisc && !volume->IsDatelDisc())
+  {
+    fmt::print(std::cerr,
+               "{}Warning: Converting Wii disc images to GCZ without scrubbing may not "
+               "offer space advantages over ISO. Continuing anyway.\n",
+               message_prefix);
+  }
+
+  if (volume && volume->IsNKit())
+  {
+    fmt::print(
+        std::cerr,
+        "{}Warning: Converting an NKit file, output will still be NKit! Continuing anyway.\n",
+        message_prefix);
+  }
+
+  if (format == DiscIO::BlobType::GCZ && volume &&
+      !DiscIO::IsGCZBlockSizeLegacyCompatible(settings.block_size.value(), volume->GetDataSize()))
+  {
+    fmt::print(std::cerr,
+               "{}Warning: For GCZs to be compatible with Dolphin < 5.0-11893, the file size "
+               "must be an integer multiple of the block size and must not be an integer "
+               "multiple of the block size multiplied by 32. Continuing anyway.\n",
+               message_prefix);
+  }
+
+  // Perform the conversion
+  bool success = false;
+
+  switch (format)
+  {
+  case DiscIO::BlobType::PLAIN:
+  {
+    success =
+        DiscIO::ConvertToPlain(blob_reader.get(), input_file_path, output_file_path, callback);
+    break;
+  }
+
+  case DiscIO::BlobType::GCZ:
+  {
+    u32 sub_type = std::numeric_limits<u32>::max();
+    if (volume)
+    {
+      if (volume->GetVolumeType() == DiscIO::Platform::GameCubeDisc)
+        sub_type = 0;
+      else if (volume->GetVolumeType() == DiscIO::Platform::WiiDisc)
+        sub_type = 1;
+    }
+    success = DiscIO::ConvertToGCZ(blob_reader.get(), input_file_path, output_file_path, sub_type,
+                                   settings.block_size.value(), callback);
+    break;
+  }
+
+  case DiscIO::BlobType::WIA:
+  case DiscIO::BlobType::RVZ:
+  {
+    success = DiscIO::ConvertToWIAOrRVZ(
+        blob_reader.get(), input_file_path, output_file_path, format == DiscIO::BlobType::RVZ,
+        settings.compression.value(), settings.compression_level.value(),
+        settings.block_size.value(), callback);
+    break;
+  }
+
+  default:
+  {
+    ASSERT(false);
+    break;
+  }
+  }
+
+  if (!success)
+  {
+    fmt::print(std::cerr, "{}Error: Conversion failed\n", message_prefix);
+    return false;
+  }
+
+  return true;
+}
+
+// Converts the given images into output_dir, several at a time. The compression threads are
+// divided between the images being converted, which also keeps the memory use the same as for
+// converting a single image.
+static int ConvertBatch(const std::vector<std::string>& input_paths, std::string output_dir,
+                        const ConvertSettings& settings, int jobs)
+{
+  if (!output_dir.empty() && output_dir.back() != '/')
+    output_dir += '/';
+
+  const unsigned int hardware_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  const unsigned int parallel_images =
+      static_cast<unsigned int>(std::min<size_t>(jobs, input_paths.size()));
+  DiscIO::SetCompressionThreadCount(std::max(hardware_threads / parallel_images, 1u));
+
+  std::mutex print_mutex;
+  std::atomic<size_t> next_image = 0;
+  std::atomic<size_t> failed_images = 0;
+
+  const auto convert_images = [&] {
+    for (size_t i = next_image++; i < input_paths.size(); i = next_image++)
+    {
+      const std::string& input_path = input_paths[i];
+      std::string name;
+      SplitPath(input_path, nullptr, &name, nullptr);
+      const std::string output_path = output_dir + name + GetFormatExtension(settings.format);
+      const std::string prefix = fmt::format("[{}/{}] {}: ", i + 1, input_paths.size(), name);
+
+      // Report progress in steps of 10% to keep the output readable with many images at once
+      int last_reported_step = -1;
+      const auto callback = [&](const std::string&, float percent) {
+        const int step = static_cast<int>(percent * 10);
+        if (step != last_reported_step)
+        {
+          last_reported_step = step;
+          std::lock_guard lk(print_mutex);
+          fmt::print(std::cout, "{}{}%\n", prefix, step * 10);
+        }
+        return true;
+      };
+
+      const bool success = ConvertImage(input_path, output_path, settings, prefix, callback);
+
+      std::lock_guard lk(print_mutex);
+      if (success)
+      {
+        fmt::print(std::cout, "{}Done: {}\n", prefix, output_path);
+      }
+      else
+      {
+        ++failed_images;
+        fmt::print(std::cout, "{}Failed\n", prefix);
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < parallel_images; ++i)
+    threads.emplace_back(convert_images);
+  convert_images();
+  for (std::thread& thread : threads)
+    thread.join();
+
+  DiscIO::SetCompressionThreadCount(0);
+
+  fmt::print(std::cout, "Converted {} of {} images\n", input_paths.size() - failed_images,
+             input_paths.size());
+  return failed_images == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 int ConvertCommand(const std::vector<std::string>& args)
 {
   optparse::OptionParser parser;
@@ -81,6 +315,19 @@ int ConvertCommand(const std::vector<std::string>& args)
       .help("Path to the destination FILE.")
       .metavar("FILE");
 
+  parser.add_option("-d", "--output_dir")
+      .type("string")
+      .action("store")
+      .help("Batch mode. Convert every FILE given as an argument into DIR, keeping the file names.")
+      .metavar("DIR");
+
+  parser.add_option("-j", "--jobs")
+      .type("int")
+      .action("store")
+      .help("In batch mode, how many images to convert at once. The compression threads are "
+            "shared between them. Defaults to 1.")
+      .set_default(1);
+
   parser.add_option("-f", "--format")
       .type("string")
       .action("store")
@@ -118,73 +365,50 @@ int ConvertCommand(const std::vector<std::string>& args)
   UICommon::Init();
 
   // Validate options
+  std::vector<std::string> input_paths = parser.args();
+  const bool batch = options.is_set("output_dir");
 
   // --input
-  if (!options.is_set("input"))
+  if (options.is_set("input"))
+    input_paths.insert(input_paths.begin(), options["input"]);
+  if (input_paths.empty())
   {
     fmt::print(std::cerr, "Error: No input set\n");
     return EXIT_FAILURE;
   }
-  const std::string& input_file_path = options["input"];
 
   // --output
-  if (!options.is_set("output"))
+  if (!batch && !options.is_set("output"))
   {
     fmt::print(std::cerr, "Error: No output set\n");
     return EXIT_FAILURE;
   }
-  const std::string& output_file_path = options["output"];
 
-  // --format
-  const std::optional<DiscIO::BlobType> format_o = ParseFormatString(options["format"]);
-  if (!format_o.has_value())
+  if (!batch && input_paths.size() > 1)
   {
-    fmt::print(std::cerr, "Error: No output format set\n");
+    fmt::print(std::cerr, "Error: Converting multiple files requires --output_dir\n");
     return EXIT_FAILURE;
   }
-  const DiscIO::BlobType format = format_o.value();
 
-  // Open the blob reader
-  std::unique_ptr<DiscIO::BlobReader> blob_reader = DiscIO::CreateBlobReader(input_file_path);
-  if (!blob_reader)
+  // --jobs
+  const int jobs = static_cast<int>(options.get("jobs"));
+  if (jobs < 1)
   {
-    fmt::print(std::cerr, "Error: The input file could not be opened.\n");
+    fmt::print(std::cerr, "Error: Number of jobs must be at least 1\n");
     return EXIT_FAILURE;
   }
 
-  // --scrub
-  const bool scrub = static_cast<bool>(options.get("scrub"));
-
-  // Open the volume
-  std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateDisc(input_file_path);
-  if (!volume)
+  // --format
+  const std::optional<DiscIO::BlobType> format_o = ParseFormatString(options["format"]);
+  if (!format_o.has_value())
   {
-    if (scrub)
-    {
-      fmt::print(std::cerr, "Error: Scrubbing is only supported for GC/Wii disc images.\n");
-      return EXIT_FAILURE;
-    }
-
-    fmt::print(std::cerr,
-               "Warning: The input file is not a GC/Wii disc image. Continuing anyway.\n");
+    fmt::print(std::cerr, "Error: No output format set\n");
+    return EXIT_FAILURE;
   }
+  const DiscIO::BlobType format = format_o.value();
 
-  if (scrub)
-  {
-    if (volume->IsDatelDisc())
-    {
-      fmt::print(std::cerr, "Error: Scrubbing a Datel disc is not supported.\n");
-      return EXIT_FAILURE;
-    }
-
-    blob_reader = DiscIO::ScrubbedBlob::Create(input_file_path);
-
-    if (!blob_reader)
-    {
-      fmt::print(std::cerr, "Error: Unable to process disc image. Try again without --scrub.\n");
-      return EXIT_FAILURE;
-    }
-  }
+  // --scrub
+  const bool scrub = static_cast<bool>(options.get("scrub"));
 
   if (scrub && format == DiscIO::BlobType::RVZ)
   {
@@ -198,19 +422,6 @@ int ConvertCommand(const std::vector<std::string>& args)
                           "using external compression. Continuing anyway.\n");
   }
 
-  if (!scrub && format == DiscIO::BlobType::GCZ && volume &&
-      volume->GetVolumeType() == DiscIO::Platform::WiiDisc && !volume->IsDatelDisc())
-  {
-    fmt::print(std::cerr, "Warning: Converting Wii disc images to GCZ without scrubbing may not "
-                          "offer space advantages over ISO. Continuing anyway.\n");
-  }
-
-  if (volume && volume->IsNKit())
-  {
-    fmt::print(std::cerr,
-               "Warning: Converting an NKit file, output will still be NKit! Continuing anyway.\n");
-  }
-
   // --block_size
   std::optional<int> block_size_o;
   if (options.is_set("block_size"))
@@ -237,15 +448,6 @@ int ConvertCommand(const std::vector<std::string>& args)
       fmt::print(std::cerr,
                  "Warning: Block size is not ideal for performance. Continuing anyway.\n");
     }
-
-    if (format == DiscIO::BlobType::GCZ && volume &&
-        !DiscIO::IsGCZBlockSizeLegacyCompatible(block_size_o.value(), volume->GetDataSize()))
-    {
-      fmt::print(std::cerr,
-                 "Warning: For GCZs to be compatible with Dolphin < 5.0-11893, the file size "
-                 "must be an integer multiple of the block size and must not be an integer "
-                 "multiple of the block size multiplied by 32. Continuing anyway.\n");
-    }
   }
 
   // --compress, --compress_level
@@ -296,57 +498,16 @@ int ConvertCommand(const std::vector<std::string>& args)
     }
   }
 
-  // Perform the conversion
-  const auto NOOP_STATUS_CALLBACK = [](const std::string& text, float percent) { return true; };
-
-  bool success = false;
+  const ConvertSettings settings{format, scrub, block_size_o, compression_o, compression_level_o};
 
-  switch (format)
-  {
-  case DiscIO::BlobType::PLAIN:
-  {
-    success = DiscIO::ConvertToPlain(blob_reader.get(), input_file_path, output_file_path,
-                                     NOOP_STATUS_CALLBACK);
-    break;
-  }
+  if (batch)
+    return ConvertBatch(input_paths, options["output_dir"], settings, jobs);
 
-  case DiscIO::BlobType::GCZ:
-  {
-    u32 sub_type = std::numeric_limits<u32>::max();
-    if (volume)
-    {
-      if (volume->GetVolumeType() == DiscIO::Platform::GameCubeDisc)
-        sub_type = 0;
-      else if (volume->GetVolumeType() == DiscIO::Platform::WiiDisc)
-        sub_type = 1;
-    }
-    success = DiscIO::ConvertToGCZ(blob_reader.get(), input_file_path, output_file_path, sub_type,
-                                   block_size_o.value(), NOOP_STATUS_CALLBACK);
-    break;
-  }
-
-  case DiscIO::BlobType::WIA:
-  case DiscIO::BlobType::RVZ:
-  {
-    success = DiscIO::ConvertToWIAOrRVZ(blob_reader.get(), input_file_path, output_file_path,
-                                        format == DiscIO::BlobType::RVZ, compression_o.value(),
-                                        compression_level_o.value(), block_size_o.value(),
-                                        NOOP_STATUS_CALLBACK);
-    break;
-  }
-
-  default:
-  {
-    ASSERT(false);
-    break;
-  }
-  }
+  // Perform the conversion
+  const auto NOOP_STATUS_CALLBACK = [](const std::string& text, float percent) { return true; };
 
-  if (!success)
-  {
-    fmt::print(std::cerr, "Error: Conversion failed\n");
+  if (!ConvertImage(input_paths.front(), options["output"], settings, "", NOOP_STATUS_CALLBACK))
     return EXIT_FAILURE;
-  }
 
   return EXIT_SUCCESS;
 }
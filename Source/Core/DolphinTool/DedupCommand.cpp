@@ -0,0 +1,130 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/DedupCommand.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "DiscIO/Blob.h"
+#include "UICommon/UICommon.h"
+
+namespace DolphinTool
+{
+int DedupCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: dedup [options]... import|export");
+  parser.description(
+      "import: Converts a disc image into a dedup image, which stores the disc's data in a store "
+      "directory that can be shared between images. Data that is already in the store is not "
+      "stored again.\n"
+      "export: Converts a dedup image back into a plain disc image.");
+
+  parser.add_option("-u", "--user")
+      .type("string")
+      .action("store")
+      .help("User folder path, required for temporary processing files. "
+            "Will be automatically created if this option is not set.")
+      .set_default("");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to the input FILE.")
+      .metavar("FILE");
+
+  parser.add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to the destination FILE.")
+      .metavar("FILE");
+
+  parser.add_option("-s", "--store")
+      .type("string")
+      .action("store")
+      .help("For import, the store DIR to put the data in. Relative paths are relative to the "
+            "directory of the output file, and are kept relative in the dedup image.")
+      .metavar("DIR");
+
+  const optparse::Values& options = parser.parse_args(args);
+  const std::vector<std::string> mode = parser.args();
+
+  // Initialize the dolphin user directory, required for temporary processing files
+  // If this is not set, destructive file operations could occur due to path confusion
+  UICommon::SetUserDirectory(options["user"]);
+  UICommon::Init();
+
+  // Validate options
+  if (mode.size() != 1 || (mode[0] != "import" && mode[0] != "export"))
+  {
+    fmt::print(std::cerr, "Error: Either import or export must be given\n");
+    return EXIT_FAILURE;
+  }
+  const bool import = mode[0] == "import";
+
+  if (!options.is_set("input"))
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+  const std::string& input_file_path = options["input"];
+
+  if (!options.is_set("output"))
+  {
+    fmt::print(std::cerr, "Error: No output set\n");
+    return EXIT_FAILURE;
+  }
+  const std::string& output_file_path = options["output"];
+
+  if (import && !options.is_set("store"))
+  {
+    fmt::print(std::cerr, "Error: No store set\n");
+    return EXIT_FAILURE;
+  }
+
+  const std::unique_ptr<DiscIO::BlobReader> blob_reader =
+      DiscIO::CreateBlobReader(input_file_path);
+  if (!blob_reader)
+  {
+    fmt::print(std::cerr, "Error: The input file could not be opened.\n");
+    return EXIT_FAILURE;
+  }
+
+  if (!import && blob_reader->GetBlobType() != DiscIO::BlobType::DEDUP)
+  {
+    fmt::print(std::cerr, "Error: The input file is not a dedup image.\n");
+    return EXIT_FAILURE;
+  }
+
+  if (blob_reader->GetDataSizeType() != DiscIO::DataSizeType::Accurate)
+  {
+    fmt::print(std::cerr, "Error: The size of the input file's data is not known exactly.\n");
+    return EXIT_FAILURE;
+  }
+
+  const auto NOOP_STATUS_CALLBACK = [](const std::string& text, float percent) { return true; };
+
+  const bool success =
+      import ? DiscIO::ConvertToDedup(blob_reader.get(), input_file_path, output_file_path,
+                                      options["store"], NOOP_STATUS_CALLBACK) :
+               DiscIO::ConvertToPlain(blob_reader.get(), input_file_path, output_file_path,
+                                      NOOP_STATUS_CALLBACK);
+
+  if (!success)
+  {
+    fmt::print(std::cerr, "Error: Conversion failed\n");
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+}  // namespace DolphinTool
@@ -0,0 +1,128 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/TexturePackCommand.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "VideoCommon/Assets/DirectFilesystemAssetLibrary.h"
+#include "VideoCommon/Assets/TexturePack.h"
+#include "VideoCommon/Assets/TextureAsset.h"
+
+namespace DolphinTool
+{
+// Additional mip levels are stored with the texture they belong to
+static bool IsMipLevelFile(std::string_view filename)
+{
+  const size_t mip_index = filename.rfind("_mip");
+  if (mip_index == std::string_view::npos || mip_index + 4 == filename.size())
+    return false;
+
+  return std::ranges::all_of(filename.substr(mip_index + 4),
+                             [](char c) { return std::isdigit(static_cast<unsigned char>(c)); });
+}
+
+int TexturePackCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: texturepack [options]... DIR");
+  parser.description("Packs the custom textures in DIR and its subdirectories into a single file. "
+                     "Put the pack in the texture directory of a game instead of the textures.");
+
+  parser.add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to the destination FILE, which should have the extension .dtp.")
+      .metavar("FILE");
+
+  const optparse::Values& options = parser.parse_args(args);
+  const std::vector<std::string> input_paths = parser.args();
+
+  // Validate options
+  if (input_paths.size() != 1)
+  {
+    fmt::print(std::cerr, "Error: Exactly one input directory must be given\n");
+    return EXIT_FAILURE;
+  }
+  if (!File::IsDirectory(input_paths[0]))
+  {
+    fmt::print(std::cerr, "Error: The input is not a directory\n");
+    return EXIT_FAILURE;
+  }
+
+  if (!options.is_set("output"))
+  {
+    fmt::print(std::cerr, "Error: No output set\n");
+    return EXIT_FAILURE;
+  }
+  const std::string& output_file_path = options["output"];
+
+  VideoCommon::TexturePackWriter writer;
+  if (!writer.Open(output_file_path))
+  {
+    fmt::print(std::cerr, "Error: The output file could not be created\n");
+    return EXIT_FAILURE;
+  }
+
+  VideoCommon::DirectFilesystemAssetLibrary library;
+  const auto texture_paths =
+      Common::DoFileSearch({input_paths[0]}, {".png", ".dds"}, /*recursive*/ true);
+
+  size_t num_packed = 0;
+  for (const std::string& path : texture_paths)
+  {
+    std::string filename;
+    SplitPath(path, nullptr, &filename, nullptr);
+    if (!filename.starts_with("tex1_") || IsMipLevelFile(filename))
+      continue;
+
+    const size_t arb_index = filename.rfind("_arb");
+    const bool has_arbitrary_mipmaps = arb_index != std::string::npos;
+    if (has_arbitrary_mipmaps)
+      filename.erase(arb_index, 4);
+
+    library.SetAssetIDMapData(filename, VideoCommon::DirectFilesystemAssetLibrary::AssetMap{
+                                            {"texture", StringToPath(path)}});
+
+    VideoCommon::TextureData data;
+    if (library.LoadTexture(filename, &data).m_bytes_loaded == 0 || data.m_texture.m_slices.empty())
+    {
+      fmt::print(std::cerr, "Warning: Skipping '{}', which could not be loaded\n", path);
+      continue;
+    }
+
+    if (!writer.AddTexture(filename, has_arbitrary_mipmaps, data.m_texture.m_slices[0]))
+    {
+      fmt::print(std::cerr, "Warning: Skipping '{}', which is already packed or failed to write\n",
+                 path);
+      continue;
+    }
+
+    ++num_packed;
+  }
+
+  if (!writer.Finish())
+  {
+    fmt::print(std::cerr, "Error: The output file could not be written\n");
+    return EXIT_FAILURE;
+  }
+
+  fmt::print(std::cout, "Packed {} textures\n", num_packed);
+  return EXIT_SUCCESS;
+}
+}  // namespace DolphinTool
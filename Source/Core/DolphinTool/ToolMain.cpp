@@ -15,15 +15,21 @@
 #include "Core/Core.h"
 
 #include "DolphinTool/ConvertCommand.h"
+#include "DolphinTool/DedupCommand.h"
 #include "DolphinTool/ExtractCommand.h"
 #include "DolphinTool/HeaderCommand.h"
+#include "DolphinTool/TexturePackCommand.h"
+#include "DolphinTool/TraceCommand.h"
+#include "DolphinTool/UIDCacheCommand.h"
 #include "DolphinTool/VerifyCommand.h"
 
 static void PrintUsage()
 {
-  fmt::print(std::cerr, "usage: dolphin-tool COMMAND -h\n"
-                        "\n"
-                        "commands supported: [convert, verify, header, extract]\n");
+  fmt::print(std::cerr,
+             "usage: dolphin-tool COMMAND -h\n"
+             "\n"
+             "commands supported: [convert, verify, header, extract, uidcache, dedup, trace, "
+             "texturepack]\n");
 }
 
 #ifdef _WIN32
@@ -52,6 +58,14 @@ int main(int argc, char* argv[])
     return DolphinTool::HeaderCommand(args);
   else if (command_str == "extract")
     return DolphinTool::Extract(args);
+  else if (command_str == "uidcache")
+    return DolphinTool::UIDCacheCommand(args);
+  else if (command_str == "dedup")
+    return DolphinTool::DedupCommand(args);
+  else if (command_str == "trace")
+    return DolphinTool::TraceCommand(args);
+  else if (command_str == "texturepack")
+    return DolphinTool::TexturePackCommand(args);
   PrintUsage();
   return EXIT_FAILURE;
 }
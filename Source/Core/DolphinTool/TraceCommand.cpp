@@ -0,0 +1,248 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/TraceCommand.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/GekkoDisassembler.h"
+#include "Common/IOFile.h"
+#include "Common/MappedFile.h"
+#include "Common/StringUtil.h"
+#include "Core/Debugger/TraceRecorder.h"
+
+namespace DolphinTool
+{
+struct TraceFilter
+{
+  std::optional<u32> pc;
+  std::optional<u32> memory_start;
+  std::optional<u32> memory_end;
+  std::optional<u32> gpr;
+  std::optional<u32> fpr;
+  bool loads = false;
+  bool stores = false;
+
+  bool Matches(const Core::TraceRecord& record) const
+  {
+    if (pc && record.pc != *pc)
+      return false;
+    if (memory_start && (!(record.flags & Core::TRACE_FLAG_HAS_MEMORY_ADDRESS) ||
+                         record.memory_address < *memory_start ||
+                         record.memory_address > *memory_end))
+    {
+      return false;
+    }
+    if (gpr && !(((record.gprs_read | record.gprs_written) >> *gpr) & 1))
+      return false;
+    if (fpr && !(((record.fprs_read | record.fprs_written) >> *fpr) & 1))
+      return false;
+    if ((loads || stores) && !((loads && (record.flags & Core::TRACE_FLAG_LOAD)) ||
+                               (stores && (record.flags & Core::TRACE_FLAG_STORE))))
+    {
+      return false;
+    }
+    return true;
+  }
+};
+
+static std::optional<u32> ParseHex(const std::string& str)
+{
+  u32 value;
+  if (!TryParse(str, &value, 16))
+    return std::nullopt;
+  return value;
+}
+
+static std::optional<u32> ParseRegister(const std::string& str)
+{
+  u32 value;
+  if (!TryParse(str, &value) || value >= 32)
+    return std::nullopt;
+  return value;
+}
+
+static void PrintRecord(u64 index, const Core::TraceRecord& record)
+{
+  const std::string disassembly = Common::GekkoDisassembler::Disassemble(record.inst, record.pc);
+  if (record.flags & Core::TRACE_FLAG_HAS_MEMORY_ADDRESS)
+  {
+    const char* access = (record.flags & Core::TRACE_FLAG_LOAD)  ? "load" :
+                         (record.flags & Core::TRACE_FLAG_STORE) ? "store" :
+                                                                   "access";
+    fmt::print(std::cout, "{:>10} {:08x} {:08x} {:<40} {} {:08x}\n", index, record.pc,
+               record.inst, disassembly, access, record.memory_address);
+  }
+  else
+  {
+    fmt::print(std::cout, "{:>10} {:08x} {:08x} {}\n", index, record.pc, record.inst,
+               disassembly);
+  }
+}
+
+int TraceCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: trace [options]...");
+  parser.description("Prints the instructions in a trace file recorded with \"Record Instruction "
+                     "Trace\" which match all of the given filters.");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to the trace FILE.")
+      .metavar("FILE");
+
+  parser.add_option("-p", "--pc")
+      .type("string")
+      .action("store")
+      .help("Optional. Only print instructions at this ADDRESS (in hex).")
+      .metavar("ADDRESS");
+
+  parser.add_option("-m", "--memory")
+      .type("string")
+      .action("store")
+      .help("Optional. Only print loads, stores and cache instructions accessing an address in "
+            "this RANGE, given as START[-END] in hex.")
+      .metavar("RANGE");
+
+  parser.add_option("-r", "--gpr")
+      .type("string")
+      .action("store")
+      .help("Optional. Only print instructions reading or writing this GPR (0-31).")
+      .metavar("REGISTER");
+
+  parser.add_option("-f", "--fpr")
+      .type("string")
+      .action("store")
+      .help("Optional. Only print instructions reading or writing this FPR (0-31).")
+      .metavar("REGISTER");
+
+  parser.add_option("-l", "--loads").action("store_true").help("Optional. Only print loads.");
+
+  parser.add_option("-s", "--stores").action("store_true").help("Optional. Only print stores.");
+
+  parser.add_option("-n", "--limit")
+      .type("int")
+      .action("store")
+      .help("Optional. Stop after printing COUNT instructions.")
+      .metavar("COUNT");
+
+  parser.add_option("-c", "--count")
+      .action("store_true")
+      .help("Optional. Only print the number of matching instructions.");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  if (!options.is_set("input"))
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+  const std::string& input_file_path = options["input"];
+
+  TraceFilter filter;
+  if (options.is_set("pc"))
+  {
+    filter.pc = ParseHex(options["pc"]);
+    if (!filter.pc)
+    {
+      fmt::print(std::cerr, "Error: Invalid address \"{}\"\n", options["pc"]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (options.is_set("memory"))
+  {
+    const std::string& range = options["memory"];
+    const size_t dash = range.find('-');
+    filter.memory_start = ParseHex(range.substr(0, dash));
+    filter.memory_end =
+        dash == std::string::npos ? filter.memory_start : ParseHex(range.substr(dash + 1));
+    if (!filter.memory_start || !filter.memory_end || *filter.memory_end < *filter.memory_start)
+    {
+      fmt::print(std::cerr, "Error: Invalid address range \"{}\"\n", range);
+      return EXIT_FAILURE;
+    }
+  }
+  if (options.is_set("gpr"))
+  {
+    filter.gpr = ParseRegister(options["gpr"]);
+    if (!filter.gpr)
+    {
+      fmt::print(std::cerr, "Error: Invalid GPR \"{}\"\n", options["gpr"]);
+      return EXIT_FAILURE;
+    }
+  }
+  if (options.is_set("fpr"))
+  {
+    filter.fpr = ParseRegister(options["fpr"]);
+    if (!filter.fpr)
+    {
+      fmt::print(std::cerr, "Error: Invalid FPR \"{}\"\n", options["fpr"]);
+      return EXIT_FAILURE;
+    }
+  }
+  filter.loads = static_cast<bool>(options.get("loads"));
+  filter.stores = static_cast<bool>(options.get("stores"));
+
+  const bool count_only = static_cast<bool>(options.get("count"));
+  std::optional<u64> limit;
+  if (options.is_set("limit"))
+    limit = static_cast<u64>(static_cast<int>(options.get("limit")));
+
+  File::IOFile file(input_file_path, "rb");
+  Core::TraceFileHeader header;
+  if (!file || !file.ReadArray(&header, 1) || header.magic != Core::TraceRecorder::MAGIC)
+  {
+    fmt::print(std::cerr, "Error: The input file is not a trace file.\n");
+    return EXIT_FAILURE;
+  }
+  if (header.version != Core::TraceRecorder::VERSION ||
+      header.record_size != sizeof(Core::TraceRecord))
+  {
+    fmt::print(std::cerr, "Error: Unsupported trace file version {}.\n", header.version);
+    return EXIT_FAILURE;
+  }
+
+  // Mapping the file lets the OS read ahead while we go through it, and keeps traces which are
+  // larger than the available memory usable
+  const u64 record_count = (file.GetSize() - sizeof(header)) / sizeof(Core::TraceRecord);
+  File::MappedFile mapped_file;
+  if (record_count != 0 &&
+      !mapped_file.Map(file, sizeof(header) + record_count * sizeof(Core::TraceRecord)))
+  {
+    fmt::print(std::cerr, "Error: The input file could not be mapped.\n");
+    return EXIT_FAILURE;
+  }
+
+  const u8* records = mapped_file.GetData() + sizeof(header);
+  u64 matches = 0;
+  for (u64 i = 0; i < record_count && (!limit || matches < *limit); ++i)
+  {
+    Core::TraceRecord record;
+    std::memcpy(&record, records + i * sizeof(record), sizeof(record));
+    if (!filter.Matches(record))
+      continue;
+
+    ++matches;
+    if (!count_only)
+      PrintRecord(i, record);
+  }
+
+  if (count_only)
+    fmt::print(std::cout, "{}\n", matches);
+
+  return EXIT_SUCCESS;
+}
+}  // namespace DolphinTool
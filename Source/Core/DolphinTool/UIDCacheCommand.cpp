@@ -0,0 +1,114 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/UIDCacheCommand.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Common/FileUtil.h"
+#include "UICommon/UICommon.h"
+#include "VideoCommon/PipelineUIDCache.h"
+
+namespace DolphinTool
+{
+int UIDCacheCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: uidcache [options]... FILE...");
+  parser.description("Merges pipeline UID caches, dropping duplicate UIDs. Installing the result "
+                     "for a game lets Dolphin compile all of its pipelines before the game starts "
+                     "when \"Compile Shaders Before Starting\" is enabled.");
+
+  parser.add_option("-u", "--user")
+      .type("string")
+      .action("store")
+      .help("User folder path, used to find the UID cache of the game set with --game_id. "
+            "Will be automatically created if this option is not set.")
+      .set_default("");
+
+  parser.add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to write the merged UID cache to.")
+      .metavar("FILE");
+
+  parser.add_option("-g", "--game_id")
+      .type("string")
+      .action("store")
+      .help("Merge into the UID cache Dolphin uses for this game ID in the user folder.")
+      .metavar("ID");
+
+  const optparse::Values& options = parser.parse_args(args);
+  const std::vector<std::string> input_paths = parser.args();
+
+  // Validate options
+  if (!options.is_set("output") && !options.is_set("game_id"))
+  {
+    fmt::print(std::cerr, "Error: Neither an output nor a game ID is set\n");
+    return EXIT_FAILURE;
+  }
+  if (input_paths.empty())
+  {
+    fmt::print(std::cerr, "Error: No input files set\n");
+    return EXIT_FAILURE;
+  }
+
+  UICommon::SetUserDirectory(options["user"]);
+  UICommon::Init();
+
+  std::vector<VideoCommon::SerializedGXPipelineUid> uids;
+  std::string game_cache_path;
+  if (options.is_set("game_id"))
+  {
+    // Start from what the game already has, so that existing UIDs keep their order.
+    game_cache_path = VideoCommon::PipelineUIDCache::GetFilename(options["game_id"]);
+    if (File::Exists(game_cache_path))
+    {
+      if (auto existing = VideoCommon::PipelineUIDCache::ReadFile(game_cache_path))
+        uids = std::move(*existing);
+      else
+        fmt::print(std::cerr, "Warning: Replacing invalid or outdated {}\n", game_cache_path);
+    }
+  }
+
+  for (const std::string& path : input_paths)
+  {
+    const auto input = VideoCommon::PipelineUIDCache::ReadFile(path);
+    if (!input)
+    {
+      fmt::print(std::cerr,
+                 "Error: {} is not a UID cache, is corrupted, or was written by a different "
+                 "version of Dolphin\n",
+                 path);
+      return EXIT_FAILURE;
+    }
+
+    const size_t added = VideoCommon::PipelineUIDCache::Merge(uids, *input);
+    fmt::print(std::cout, "{}: {} UIDs, {} new\n", path, input->size(), added);
+  }
+
+  for (const std::string& path : {options["output"], game_cache_path})
+  {
+    if (path.empty())
+      continue;
+
+    if (!VideoCommon::PipelineUIDCache::WriteFile(path, uids))
+    {
+      fmt::print(std::cerr, "Error: Failed to write {}\n", path);
+      return EXIT_FAILURE;
+    }
+    fmt::print(std::cout, "Wrote {} UIDs to {}\n", uids.size(), path);
+  }
+
+  return EXIT_SUCCESS;
+}
+}  // namespace DolphinTool
@@ -3,6 +3,7 @@
 
 #include "DolphinTool/VerifyCommand.h"
 
+#include <chrono>
 #include <cstdlib>
 #include <string>
 #include <vector>
@@ -29,7 +30,8 @@ static std::string HashToHexString(const std::vector<u8>& hash)
   return ss.str();
 }
 
-static void PrintFullReport(const DiscIO::VolumeVerifier::Result& result)
+static void PrintFullReport(const DiscIO::VolumeVerifier::Result& result, u64 bytes,
+                            double seconds)
 {
   if (!result.hashes.crc32.empty())
     fmt::print(std::cout, "CRC32: {}\n", HashToHexString(result.hashes.crc32));
@@ -46,6 +48,9 @@ static void PrintFullReport(const DiscIO::VolumeVerifier::Result& result)
   else
     fmt::print(std::cout, "SHA1 not computed\n");
 
+  fmt::print(std::cout, "Time: {:.2f} s ({:.1f} MiB/s)\n", seconds,
+             seconds > 0 ? bytes / seconds / (1024 * 1024) : 0.0);
+
   fmt::print(std::cout, "Problems Found: {}\n", result.problems.empty() ? "No" : "Yes");
 
   for (const auto& problem : result.problems)
@@ -99,6 +104,13 @@ int VerifyCommand(const std::vector<std::string>& args)
             "[%choices]")
       .choices({"crc32", "md5", "sha1"});
 
+  parser.add_option("-j", "--jobs")
+      .type("int")
+      .action("store")
+      .help("Optional. Number of threads to use for checking the hashes of Wii partition data, "
+            "in addition to the threads computing digests. Defaults to 1.")
+      .set_default(1);
+
   const optparse::Values& options = parser.parse_args(args);
 
   // Initialize the dolphin user directory, required for temporary processing files
@@ -146,8 +158,17 @@ int VerifyCommand(const std::vector<std::string>& args)
     return EXIT_FAILURE;
   }
 
+  const int jobs = static_cast<int>(options.get("jobs"));
+  if (jobs < 1)
+  {
+    fmt::print(std::cerr, "Error: Number of jobs must be at least 1\n");
+    return EXIT_FAILURE;
+  }
+
   // Verify the volume
+  const auto start_time = std::chrono::steady_clock::now();
   DiscIO::VolumeVerifier verifier(*volume, false, hashes_to_calculate);
+  verifier.SetThreadCount(static_cast<unsigned int>(jobs));
   verifier.Start();
   while (verifier.GetBytesProcessed() != verifier.GetTotalBytes())
   {
@@ -155,11 +176,12 @@ int VerifyCommand(const std::vector<std::string>& args)
   }
   verifier.Finish();
   const DiscIO::VolumeVerifier::Result& result = verifier.GetResult();
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
 
   // Print the report
   if (!algorithm_is_set)
   {
-    PrintFullReport(result);
+    PrintFullReport(result, verifier.GetTotalBytes(), elapsed.count());
   }
   else
   {
@@ -7,6 +7,7 @@
 
 #include "Common/Assert.h"
 #include "Common/Logging/Log.h"
+#include "Common/Thread.h"
 #include "Core/HW/WiimoteReal/WiimoteReal.h"
 
 #ifdef CIFACE_USE_WIN32
@@ -47,6 +48,13 @@ static thread_local ciface::InputChannel tls_input_channel = ciface::InputChanne
 
 static thread_local bool tls_is_updating_devices = false;
 
+// Devices which poll in the background are read at about 1000Hz, well above the rate at which the
+// emulated controllers are updated
+constexpr auto POLLING_INTERVAL = std::chrono::milliseconds(1);
+// Without any of them, the polling thread only checks for new devices every now and then
+constexpr auto IDLE_POLLING_INTERVAL = std::chrono::milliseconds(100);
+constexpr auto POLLING_LATENCY_LOG_INTERVAL = std::chrono::seconds(10);
+
 void ControllerInterface::Initialize(const WindowSystemInfo& wsi)
 {
   if (m_is_init)
@@ -99,6 +107,9 @@ void ControllerInterface::Initialize(const WindowSystemInfo& wsi)
 
   if (m_populating_devices_counter.fetch_sub(1) == 1 && !devices_empty)
     InvokeDevicesChangedCallbacks();
+
+  m_polling_thread_running.Set();
+  m_polling_thread = std::thread(&ControllerInterface::PollingThread, this);
 }
 
 void ControllerInterface::ChangeWindow(void* hwnd, WindowChangeReason reason)
@@ -192,6 +203,12 @@ void ControllerInterface::Shutdown()
   // Additional safety measure to avoid InvokeDevicesChangedCallbacks()
   m_populating_devices_counter = 1;
 
+  // Stop polling before the devices and backends go away.
+  m_polling_thread_running.Clear();
+  m_polling_thread_wakeup.Set();
+  if (m_polling_thread.joinable())
+    m_polling_thread.join();
+
   // Update control references so shared_ptr<Device>s are freed up BEFORE we shutdown the backends.
   ClearDevices();
 
@@ -227,7 +244,9 @@ void ControllerInterface::ClearDevices()
     // Devices could still be alive after this as there might be shared ptrs around holding them.
     // The InvokeDevicesChangedCallbacks() underneath should always clean all of them (it needs to).
     m_devices.clear();
+    ++m_devices_generation;
   }
+  m_polling_thread_wakeup.Set();
 
   InvokeDevicesChangedCallbacks();
 }
@@ -285,7 +304,9 @@ bool ControllerInterface::AddDevice(std::shared_ptr<ciface::Core::Device> device
                        // the order on other platforms that are less tested.
                        return a->GetSortPriority() > b->GetSortPriority();
                      });
+    ++m_devices_generation;
   }
+  m_polling_thread_wakeup.Set();
 
   if (!m_populating_devices_counter)
     InvokeDevicesChangedCallbacks();
@@ -319,6 +340,8 @@ void ControllerInterface::RemoveDevice(std::function<bool(const ciface::Core::De
     const size_t prev_size = m_devices.size();
     m_devices.erase(it, m_devices.end());
     any_removed = m_devices.size() != prev_size;
+    if (any_removed)
+      ++m_devices_generation;
   }
 
   if (any_removed && (!m_populating_devices_counter || force_devices_release))
@@ -378,6 +401,75 @@ void ControllerInterface::UpdateInput()
   }
 }
 
+void ControllerInterface::PollingThread()
+{
+  Common::SetCurrentThreadName("Input Polling Thread");
+
+  // Weak pointers, so that removed devices aren't kept alive here until the list is updated
+  std::vector<std::weak_ptr<ciface::Core::Device>> devices;
+  u32 devices_generation = m_devices_generation.load() - 1;
+  auto next_latency_log = std::chrono::steady_clock::now() + POLLING_LATENCY_LOG_INTERVAL;
+
+  while (m_polling_thread_running.IsSet())
+  {
+    const u32 generation = m_devices_generation.load();
+    if (generation != devices_generation)
+    {
+      std::lock_guard lk(m_devices_mutex);
+      devices.clear();
+      for (const auto& d : m_devices)
+      {
+        if (d->PollsInBackground())
+          devices.emplace_back(d);
+      }
+      devices_generation = generation;
+    }
+
+    for (const auto& weak_device : devices)
+    {
+      // If the device was removed in the meantime, it's destroyed here once its poll finishes
+      if (const auto device = weak_device.lock())
+        device->PollInput();
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now >= next_latency_log)
+    {
+      LogPollingLatency();
+      next_latency_log = now + POLLING_LATENCY_LOG_INTERVAL;
+    }
+
+    m_polling_thread_wakeup.WaitFor(devices.empty() ? IDLE_POLLING_INTERVAL : POLLING_INTERVAL);
+  }
+}
+
+void ControllerInterface::AddPollingLatencySample(std::chrono::steady_clock::duration latency)
+{
+  const u64 latency_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+
+  m_polling_latency_total_us += latency_us;
+  ++m_polling_latency_samples;
+
+  u64 max_us = m_polling_latency_max_us.load();
+  while (latency_us > max_us && !m_polling_latency_max_us.compare_exchange_weak(max_us, latency_us))
+  {
+  }
+}
+
+void ControllerInterface::LogPollingLatency()
+{
+  const u64 samples = m_polling_latency_samples.exchange(0);
+  const u64 total_us = m_polling_latency_total_us.exchange(0);
+  const u64 max_us = m_polling_latency_max_us.exchange(0);
+  if (samples == 0)
+    return;
+
+  DEBUG_LOG_FMT(CONTROLLERINTERFACE,
+                "Background input polling: {} states picked up, latency {}us on average, {}us max",
+                samples, total_us / samples, max_us);
+}
+
 void ControllerInterface::SetCurrentInputChannel(ciface::InputChannel input_channel)
 {
   tls_input_channel = input_channel;
@@ -4,12 +4,17 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <thread>
 
+#include "Common/Event.h"
+#include "Common/Flag.h"
 #include "Common/Matrix.h"
+#include "Common/TripleBuffer.h"
 #include "Common/WindowSystemInfo.h"
 #include "InputCommon/ControllerInterface/CoreDevice.h"
 #include "InputCommon/ControllerInterface/InputBackend.h"
@@ -119,6 +124,9 @@ public:
   void UnregisterDevicesChangedCallback(const HotplugCallbackHandle& handle);
   void InvokeDevicesChangedCallbacks() const;
 
+  // How long a state read by the input polling thread took to be picked up by UpdateInput
+  void AddPollingLatencySample(std::chrono::steady_clock::duration latency);
+
   static void SetCurrentInputChannel(ciface::InputChannel);
   static ciface::InputChannel GetCurrentInputChannel();
 
@@ -126,6 +134,8 @@ public:
 
 private:
   void ClearDevices();
+  void PollingThread();
+  void LogPollingLatency();
 
   std::list<std::function<void()>> m_devices_changed_callbacks;
   mutable std::recursive_mutex m_devices_population_mutex;
@@ -140,6 +150,15 @@ private:
   std::atomic<bool> m_requested_mouse_centering = false;
 
   std::vector<std::unique_ptr<ciface::InputBackend>> m_input_backends;
+
+  std::thread m_polling_thread;
+  Common::Flag m_polling_thread_running;
+  Common::Event m_polling_thread_wakeup;
+  // Changed along with m_devices, so the polling thread knows when to look at them again
+  std::atomic<u32> m_devices_generation = 0;
+  std::atomic<u64> m_polling_latency_total_us = 0;
+  std::atomic<u64> m_polling_latency_max_us = 0;
+  std::atomic<u64> m_polling_latency_samples = 0;
 };
 
 namespace ciface
@@ -173,6 +192,44 @@ private:
   std::array<T, int(InputChannel::Count)> m_value;
   std::array<T, int(InputChannel::Count)> m_delta;
 };
+
+// The state of a device which is read by its PollInput on the input polling thread
+template <typename T>
+class BackgroundInputState
+{
+public:
+  // NOTE: Input polling thread.
+  void Publish(const T& state)
+  {
+    Snapshot& snapshot = m_buffer.GetWriteBuffer();
+    snapshot.state = state;
+    snapshot.time = std::chrono::steady_clock::now();
+    m_buffer.Publish();
+  }
+
+  // Returns the latest state, or nullptr if nothing new was published since the last update
+  const T* Update();
+
+private:
+  struct Snapshot
+  {
+    T state{};
+    std::chrono::steady_clock::time_point time;
+  };
+
+  Common::TripleBuffer<Snapshot> m_buffer;
+};
 }  // namespace ciface
 
 extern ControllerInterface g_controller_interface;
+
+template <typename T>
+const T* ciface::BackgroundInputState<T>::Update()
+{
+  if (!m_buffer.Update())
+    return nullptr;
+
+  const Snapshot& snapshot = m_buffer.GetReadBuffer();
+  g_controller_interface.AddPollingLatencySample(std::chrono::steady_clock::now() - snapshot.time);
+  return &snapshot.state;
+}
@@ -131,6 +131,12 @@ public:
   std::string GetQualifiedName() const;
   virtual DeviceRemoval UpdateInput() { return DeviceRemoval::Keep; }
 
+  // Devices which are slow to read from can do so in PollInput instead, which is called from the
+  // input polling thread at a high rate. It should publish what it read through a
+  // BackgroundInputState, so that UpdateInput only has to pick up the latest state.
+  virtual bool PollsInBackground() const { return false; }
+  virtual void PollInput() {}
+
   // May be overridden to implement hotplug removal.
   // Currently handled on a per-backend basis but this could change.
   virtual bool IsValid() const { return true; }
@@ -264,9 +264,10 @@ std::string Device::GetSource() const
   return "XInput";
 }
 
-Core::DeviceRemoval Device::UpdateInput()
+void Device::PollInput()
 {
-  PXInputGetState(m_index, &m_state_in);
+  PolledState polled{};
+  PXInputGetState(m_index, &polled.state);
 
   XINPUT_BATTERY_INFORMATION battery_info = {};
   if (SUCCEEDED(PXInputGetBatteryInformation(m_index, BATTERY_DEVTYPE_GAMEPAD, &battery_info)))
@@ -275,18 +276,30 @@ Core::DeviceRemoval Device::UpdateInput()
     {
     case BATTERY_TYPE_DISCONNECTED:
     case BATTERY_TYPE_UNKNOWN:
-      m_battery_level = 0;
+      polled.battery_level = 0;
       break;
     case BATTERY_TYPE_WIRED:
-      m_battery_level = BATTERY_INPUT_MAX_VALUE;
+      polled.battery_level = BATTERY_INPUT_MAX_VALUE;
       break;
     default:
-      m_battery_level =
+      polled.battery_level =
           battery_info.BatteryLevel / ControlState(BATTERY_LEVEL_FULL) * BATTERY_INPUT_MAX_VALUE;
       break;
     }
   }
 
+  m_polled_state.Publish(polled);
+}
+
+Core::DeviceRemoval Device::UpdateInput()
+{
+  if (const PolledState* polled = m_polled_state.Update())
+  {
+    m_state_in = polled->state;
+    if (polled->battery_level)
+      m_battery_level = *polled->battery_level;
+  }
+
   return Core::DeviceRemoval::Keep;
 }
 
@@ -11,6 +11,8 @@
 #include <windows.h>
 #include <XInput.h>
 
+#include <optional>
+
 #include "InputCommon/ControllerInterface/ControllerInterface.h"
 
 #ifndef XINPUT_DEVSUBTYPE_FLIGHT_STICK
@@ -33,11 +35,22 @@ public:
   std::optional<int> GetPreferredId() const override;
   int GetSortPriority() const override { return -2; }
 
+  // XInputGetState can take long, in particular for disconnected controllers
+  bool PollsInBackground() const override { return true; }
+  void PollInput() override;
   Core::DeviceRemoval UpdateInput() override;
 
   void UpdateMotors();
 
 private:
+  struct PolledState
+  {
+    XINPUT_STATE state;
+    // Kept as it was if it couldn't be read
+    std::optional<ControlState> battery_level;
+  };
+
+  BackgroundInputState<PolledState> m_polled_state;
   XINPUT_STATE m_state_in{};
   XINPUT_VIBRATION m_state_out{};
   ControlState m_battery_level{};
@@ -13,6 +13,7 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <mutex>
 #include <optional>
 
@@ -24,6 +25,7 @@
 
 #include "Common/BitUtils.h"
 #include "Common/Config/Config.h"
+#include "Common/EnumUtils.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "Common/Logging/Log.h"
@@ -61,6 +63,10 @@ namespace GCAdapter
 
 constexpr unsigned int USB_TIMEOUT_MS = 100;
 
+// Reads are kept in flight back to back, so that none of the adapter's polls is missed while the
+// previous one is processed
+constexpr size_t IN_FLIGHT_READS = 4;
+
 static bool CheckDeviceAccess(libusb_device* device);
 static void AddGCAdapter(libusb_device* device);
 static void ResetRumbleLockNeeded();
@@ -117,6 +123,8 @@ struct PortState
 
 // Only access with s_mutex held!
 static std::array<PortState, SerialInterface::MAX_SI_CHANNELS> s_port_states;
+static PollingStats s_polling_stats;
+static std::optional<std::chrono::steady_clock::time_point> s_last_poll_time;
 
 static std::array<u8, CONTROLLER_OUTPUT_RUMBLE_PAYLOAD_SIZE> s_controller_write_payload;
 static std::atomic<int> s_controller_write_payload_size{0};
@@ -155,6 +163,18 @@ static std::unique_ptr<LibusbUtils::Context> s_libusb_context;
 
 static u8 s_endpoint_in = 0;
 static u8 s_endpoint_out = 0;
+
+struct ReadTransfer
+{
+  libusb_transfer* transfer = nullptr;
+  std::array<u8, CONTROLLER_INPUT_PAYLOAD_EXPECTED_SIZE> buffer{};
+  // Cleared by the callback when it doesn't resubmit the transfer
+  std::atomic<bool> in_flight = false;
+};
+static std::array<ReadTransfer, IN_FLIGHT_READS> s_read_transfers;
+// Set when one of the reads failed with an error that calls for resetting the device
+static Common::Flag s_read_transfer_failed;
+static Common::Event s_read_transfers_changed;
 #endif
 
 static u64 s_last_init = 0;
@@ -164,6 +184,77 @@ static std::optional<Config::ConfigChangedCallbackID> s_config_callback_id = std
 static bool s_is_adapter_wanted = false;
 static std::array<bool, SerialInterface::MAX_SI_CHANNELS> s_config_rumble_enabled{};
 
+#if GCADAPTER_USE_LIBUSB_IMPLEMENTATION
+// Called from the libusb event thread
+static void ReadTransferCallback(libusb_transfer* transfer)
+{
+  auto& read = *static_cast<ReadTransfer*>(transfer->user_data);
+
+  if (transfer->status == LIBUSB_TRANSFER_COMPLETED)
+  {
+    ProcessInputPayload(transfer->buffer, transfer->actual_length);
+  }
+  else if (transfer->status != LIBUSB_TRANSFER_TIMED_OUT &&
+           transfer->status != LIBUSB_TRANSFER_CANCELLED)
+  {
+    ERROR_LOG_FMT(CONTROLLERINTERFACE, "Read: libusb transfer failed, status: {:#04x}",
+                  Common::ToUnderlying(transfer->status));
+    if (transfer->status == LIBUSB_TRANSFER_ERROR)
+      s_read_transfer_failed.Set();
+  }
+
+  const bool can_resubmit = transfer->status == LIBUSB_TRANSFER_COMPLETED ||
+                            transfer->status == LIBUSB_TRANSFER_TIMED_OUT;
+  if (can_resubmit && s_read_adapter_thread_running.IsSet() &&
+      libusb_submit_transfer(transfer) == LIBUSB_SUCCESS)
+  {
+    return;
+  }
+
+  // The read thread takes over from here
+  read.in_flight = false;
+  s_read_transfers_changed.Set();
+}
+
+static void SubmitReadTransfers()
+{
+  for (ReadTransfer& read : s_read_transfers)
+  {
+    if (read.in_flight)
+      continue;
+
+    libusb_fill_interrupt_transfer(read.transfer, s_handle, s_endpoint_in, read.buffer.data(),
+                                   int(read.buffer.size()), ReadTransferCallback, &read,
+                                   USB_TIMEOUT_MS);
+    read.in_flight = true;
+    const int error = libusb_submit_transfer(read.transfer);
+    if (error != LIBUSB_SUCCESS)
+    {
+      ERROR_LOG_FMT(CONTROLLERINTERFACE, "Read: libusb_submit_transfer failed: {}",
+                    LibusbUtils::ErrorWrap(error));
+      read.in_flight = false;
+    }
+  }
+}
+
+static void CancelReadTransfers()
+{
+  // A callback may have resubmitted its transfer just before the read thread stopped running, so
+  // cancelling is repeated until every transfer has come back.
+  while (std::ranges::any_of(s_read_transfers, [](const ReadTransfer& read) {
+    return read.in_flight.load();
+  }))
+  {
+    for (ReadTransfer& read : s_read_transfers)
+    {
+      if (read.in_flight)
+        libusb_cancel_transfer(read.transfer);
+    }
+    s_read_transfers_changed.WaitFor(std::chrono::milliseconds(USB_TIMEOUT_MS));
+  }
+}
+#endif
+
 static void ReadThreadFunc()
 {
   Common::SetCurrentThreadName("GCAdapter Read Thread");
@@ -200,25 +291,25 @@ static void ReadThreadFunc()
   // Reset rumble once on initial reading
   ResetRumble();
 
+#if GCADAPTER_USE_LIBUSB_IMPLEMENTATION
+  // The reads complete on the libusb event thread, which processes them and submits them again.
+  // This thread only restarts the ones that stopped.
+  for (ReadTransfer& read : s_read_transfers)
+    read.transfer = libusb_alloc_transfer(0);
+  s_read_transfer_failed.Clear();
+#endif
+
   while (s_read_adapter_thread_running.IsSet())
   {
 #if GCADAPTER_USE_LIBUSB_IMPLEMENTATION
-    std::array<u8, CONTROLLER_INPUT_PAYLOAD_EXPECTED_SIZE> input_buffer;
-
-    int payload_size = 0;
-    int error = libusb_interrupt_transfer(s_handle, s_endpoint_in, input_buffer.data(),
-                                          int(input_buffer.size()), &payload_size, USB_TIMEOUT_MS);
-    if (error != LIBUSB_SUCCESS)
-    {
-      ERROR_LOG_FMT(CONTROLLERINTERFACE, "Read: libusb_interrupt_transfer failed: {}",
-                    LibusbUtils::ErrorWrap(error));
-    }
-    if (error == LIBUSB_ERROR_IO)
+    if (s_read_transfer_failed.TestAndClear())
     {
       // s_read_adapter_thread_running is cleared by the joiner, not the stopper.
 
-      // Reset the device, which may trigger a replug.
-      error = libusb_reset_device(s_handle);
+      // Wait for the other reads to fail as well, then reset the device, which may trigger a
+      // replug.
+      CancelReadTransfers();
+      const int error = libusb_reset_device(s_handle);
       ERROR_LOG_FMT(CONTROLLERINTERFACE, "Read: libusb_reset_device: {}",
                     LibusbUtils::ErrorWrap(error));
 
@@ -226,7 +317,8 @@ static void ReadThreadFunc()
       // and cleanup program state without getting another thread to call Reset().
     }
 
-    ProcessInputPayload(input_buffer.data(), payload_size);
+    SubmitReadTransfers();
+    s_read_transfers_changed.WaitFor(std::chrono::milliseconds(USB_TIMEOUT_MS));
 
 #elif GCADAPTER_USE_ANDROID_IMPLEMENTATION
     const int payload_size = env->CallStaticIntMethod(s_adapter_class, input_func);
@@ -246,6 +338,15 @@ static void ReadThreadFunc()
     Common::YieldCPU();
   }
 
+#if GCADAPTER_USE_LIBUSB_IMPLEMENTATION
+  CancelReadTransfers();
+  for (ReadTransfer& read : s_read_transfers)
+  {
+    libusb_free_transfer(read.transfer);
+    read.transfer = nullptr;
+  }
+#endif
+
   // Terminate the write thread on leaving
   if (s_write_adapter_thread_running.TestAndClear())
   {
@@ -713,7 +814,12 @@ static void Reset()
     s_read_adapter_thread.join();
   // The read thread will close the write thread
 
-  s_port_states.fill({});
+  {
+    std::lock_guard lk(s_read_mutex);
+    s_port_states.fill({});
+    s_polling_stats = {};
+    s_last_poll_time.reset();
+  }
 
 #if GCADAPTER_USE_LIBUSB_IMPLEMENTATION
   s_status = AdapterStatus::NotDetected;
@@ -797,6 +903,17 @@ void ProcessInputPayload(const u8* data, std::size_t size)
   {
     std::lock_guard lk(s_read_mutex);
 
+    const auto now = std::chrono::steady_clock::now();
+    if (s_last_poll_time)
+    {
+      const auto interval_us =
+          std::chrono::duration_cast<std::chrono::microseconds>(now - *s_last_poll_time).count();
+      const size_t bucket = std::min<size_t>(interval_us / PollingStats::BUCKET_US,
+                                             PollingStats::NUM_BUCKETS - 1);
+      ++s_polling_stats.interval_histogram[bucket];
+    }
+    s_last_poll_time = now;
+
     for (int chan = 0; chan != SerialInterface::MAX_SI_CHANNELS; ++chan)
     {
       const u8* const channel_data = &data[1 + (9 * chan)];
@@ -870,6 +987,12 @@ void ProcessInputPayload(const u8* data, std::size_t size)
   }
 }
 
+PollingStats GetPollingStats()
+{
+  std::lock_guard lk(s_read_mutex);
+  return s_polling_stats;
+}
+
 bool DeviceConnected(int chan)
 {
   std::lock_guard lk(s_read_mutex);
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <functional>
 
 #include "Common/CommonTypes.h"
@@ -23,6 +24,18 @@ void StopScanThread();
 GCPadStatus Input(int chan);
 
 void Output(int chan, u8 rumble_command);
+
+// The time between consecutive polls of the adapter since it was connected
+struct PollingStats
+{
+  static constexpr u32 BUCKET_US = 250;
+  // The last bucket also counts all longer intervals
+  static constexpr size_t NUM_BUCKETS = 40;
+
+  std::array<u64, NUM_BUCKETS> interval_histogram{};
+};
+PollingStats GetPollingStats();
+
 bool IsDetected(const char** error_message);
 bool DeviceConnected(int chan);
 void ResetDeviceType(int chan);
@@ -4,12 +4,15 @@
 #include "UICommon/GameFileCache.h"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstddef>
 #include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -26,14 +29,14 @@
 
 namespace UICommon
 {
-static constexpr u32 CACHE_REVISION = 25;  // Last changed in PR 12702
+static constexpr u32 CACHE_REVISION = 26;  // Last changed when adding BlobType::DEDUP
 
 std::vector<std::string> FindAllGamePaths(const std::vector<std::string>& directories_to_scan,
                                           bool recursive_scan)
 {
   static const std::vector<std::string> search_extensions = {
       ".gcm", ".tgc", ".iso", ".ciso", ".gcz", ".wbfs", ".wia",
-      ".rvz", ".nfs", ".wad", ".dol",  ".elf", ".json"};
+      ".rvz", ".nfs", ".ddup", ".wad", ".dol", ".elf", ".json"};
 
   // TODO: We could process paths iteratively as they are found
   return Common::DoFileSearch(directories_to_scan, search_extensions, recursive_scan);
@@ -131,13 +134,54 @@ bool GameFileCache::Update(std::span<const std::string> all_game_paths,
 
   // Now that the previous loop has run, game_paths only contains paths that
   // aren't in m_cached_files, so we simply add all of them to m_cached_files.
-  for (const std::string& path : game_paths)
+  // Creating a GameFile mostly consists of waiting for the disc image to be read, which is slow
+  // on network storage, so several of them are created at once. The callbacks are still only
+  // called from this thread.
+  const std::vector<std::string> new_paths(game_paths.begin(), game_paths.end());
+  const size_t thread_count =
+      std::min<size_t>(new_paths.size(), std::clamp(std::thread::hardware_concurrency(), 2u, 8u));
+
+  std::atomic<size_t> next_index = 0;
+  std::mutex results_mutex;
+  std::condition_variable results_cv;
+  std::vector<std::shared_ptr<GameFile>> results;
+  size_t running_threads = thread_count;
+
+  std::vector<std::thread> threads;
+  threads.reserve(thread_count);
+  for (size_t i = 0; i < thread_count; ++i)
   {
-    if (processing_halted)
-      break;
+    threads.emplace_back([&] {
+      size_t index;
+      while (!processing_halted && (index = next_index++) < new_paths.size())
+      {
+        auto file = std::make_shared<GameFile>(new_paths[index]);
+        if (!file->IsValid())
+          continue;
+
+        std::lock_guard lk(results_mutex);
+        results.push_back(std::move(file));
+        results_cv.notify_one();
+      }
+
+      std::lock_guard lk(results_mutex);
+      --running_threads;
+      results_cv.notify_one();
+    });
+  }
 
-    auto file = std::make_shared<GameFile>(path);
-    if (file->IsValid())
+  std::vector<std::shared_ptr<GameFile>> new_files;
+  while (true)
+  {
+    {
+      std::unique_lock lk(results_mutex);
+      results_cv.wait(lk, [&] { return !results.empty() || running_threads == 0; });
+      if (results.empty())
+        break;
+      std::swap(results, new_files);
+    }
+
+    for (std::shared_ptr<GameFile>& file : new_files)
     {
       if (game_added_to_cache)
         game_added_to_cache(file);
@@ -145,8 +189,12 @@ bool GameFileCache::Update(std::span<const std::string> all_game_paths,
       cache_changed = true;
       m_cached_files.push_back(std::move(file));
     }
+    new_files.clear();
   }
 
+  for (std::thread& thread : threads)
+    thread.join();
+
   return cache_changed;
 }
 
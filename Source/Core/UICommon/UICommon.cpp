@@ -27,6 +27,7 @@
 #include "Common/MathUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
+#include "Common/Thread.h"
 
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigLoaders/BaseConfigLoader.h"
@@ -123,6 +124,8 @@ static void RefreshConfig()
 {
   Common::SetEnableAlert(Config::Get(Config::MAIN_USE_PANIC_HANDLERS));
   Common::SetAbortOnPanicAlert(Config::Get(Config::MAIN_ABORT_ON_PANIC_ALERT));
+  Common::SetThreadPlacement(Config::Get(Config::MAIN_PIN_THREADS),
+                             Config::Get(Config::MAIN_ADJUST_THREAD_PRIORITIES));
 }
 
 void Init()
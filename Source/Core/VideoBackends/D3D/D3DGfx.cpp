@@ -168,6 +168,11 @@ void Gfx::PresentBackbuffer()
   m_swap_chain->Present();
 }
 
+bool Gfx::WaitForPresentCompletion()
+{
+  return m_swap_chain && m_swap_chain->WaitForFrameLatency();
+}
+
 void Gfx::OnConfigChanged(u32 bits)
 {
   AbstractGfx::OnConfigChanged(bits);
@@ -178,6 +183,9 @@ void Gfx::OnConfigChanged(u32 bits)
 
   if (bits & CONFIG_CHANGE_BIT_HDR && m_swap_chain)
     m_swap_chain->SetHDR(SwapChain::WantsHDR());
+
+  if (bits & CONFIG_CHANGE_BIT_VSYNC && m_swap_chain)
+    m_swap_chain->SetLowLatency(SwapChain::WantsLowLatency());
 }
 
 void Gfx::CheckForSwapChainChanges()
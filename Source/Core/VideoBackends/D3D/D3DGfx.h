@@ -62,6 +62,7 @@ public:
                              u32 groupsize_z, u32 groups_x, u32 groups_y, u32 groups_z) override;
   void BindBackbuffer(const ClearColor& clear_color = {}) override;
   void PresentBackbuffer() override;
+  bool WaitForPresentCompletion() override;
   void SetFullscreen(bool enable_fullscreen) override;
   bool IsFullscreen() const override;
 
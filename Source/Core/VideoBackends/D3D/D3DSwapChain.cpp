@@ -21,7 +21,7 @@ std::unique_ptr<SwapChain> SwapChain::Create(const WindowSystemInfo& wsi)
 {
   std::unique_ptr<SwapChain> swap_chain =
       std::make_unique<SwapChain>(wsi, D3D::dxgi_factory.Get(), D3D::device.Get());
-  if (!swap_chain->CreateSwapChain(WantsStereo(), WantsHDR()))
+  if (!swap_chain->CreateSwapChain(WantsStereo(), WantsHDR(), WantsLowLatency()))
     return nullptr;
 
   return swap_chain;
@@ -11,14 +11,4 @@
 namespace DX12
 {
 using Microsoft::WRL::ComPtr;
-
-static void ResourceBarrier(ID3D12GraphicsCommandList* cmdlist, ID3D12Resource* resource,
-                            D3D12_RESOURCE_STATES from_state, D3D12_RESOURCE_STATES to_state)
-{
-  const D3D12_RESOURCE_BARRIER barrier = {
-      D3D12_RESOURCE_BARRIER_TYPE_TRANSITION,
-      D3D12_RESOURCE_BARRIER_FLAG_NONE,
-      {{resource, D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, from_state, to_state}}};
-  cmdlist->ResourceBarrier(1, &barrier);
-}
 }  // namespace DX12
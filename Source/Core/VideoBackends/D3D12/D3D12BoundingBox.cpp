@@ -29,12 +29,12 @@ bool D3D12BoundingBox::Initialize()
 std::vector<BBoxType> D3D12BoundingBox::Read(u32 index, u32 length)
 {
   // Copy from GPU->CPU buffer, and wait for the GPU to finish the copy.
-  ResourceBarrier(g_dx_context->GetCommandList(), m_gpu_buffer.Get(),
-                  D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
+  g_dx_context->ResourceBarrier(m_gpu_buffer.Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+                                D3D12_RESOURCE_STATE_COPY_SOURCE);
   g_dx_context->GetCommandList()->CopyBufferRegion(m_readback_buffer.Get(), 0, m_gpu_buffer.Get(),
                                                    0, BUFFER_SIZE);
-  ResourceBarrier(g_dx_context->GetCommandList(), m_gpu_buffer.Get(),
-                  D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+  g_dx_context->ResourceBarrier(m_gpu_buffer.Get(), D3D12_RESOURCE_STATE_COPY_SOURCE,
+                                D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
   Gfx::GetInstance()->ExecuteCommandList(true);
 
   // Read back to cached values.
@@ -74,15 +74,15 @@ void D3D12BoundingBox::Write(u32 index, std::span<const BBoxType> values)
   std::memcpy(m_upload_buffer.GetCurrentHostPointer(), values.data(), copy_size);
   m_upload_buffer.CommitMemory(copy_size);
 
-  ResourceBarrier(g_dx_context->GetCommandList(), m_gpu_buffer.Get(),
-                  D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_DEST);
+  g_dx_context->ResourceBarrier(m_gpu_buffer.Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+                                D3D12_RESOURCE_STATE_COPY_DEST);
 
   g_dx_context->GetCommandList()->CopyBufferRegion(m_gpu_buffer.Get(), index * sizeof(BBoxType),
                                                    m_upload_buffer.GetBuffer(),
                                                    upload_buffer_offset, copy_size);
 
-  ResourceBarrier(g_dx_context->GetCommandList(), m_gpu_buffer.Get(),
-                  D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+  g_dx_context->ResourceBarrier(m_gpu_buffer.Get(), D3D12_RESOURCE_STATE_COPY_DEST,
+                                D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 }
 
 bool D3D12BoundingBox::CreateBuffers()
@@ -180,8 +180,11 @@ void VertexManager::UpdatePixelShaderConstants()
   auto& system = Core::System::GetInstance();
   auto& pixel_shader_manager = system.GetPixelShaderManager();
 
-  if (!ReserveConstantStorage())
+  if ((!pixel_shader_manager.dirty && !pixel_shader_manager.custom_constants_dirty) ||
+      !ReserveConstantStorage())
+  {
     return;
+  }
 
   if (pixel_shader_manager.dirty)
   {
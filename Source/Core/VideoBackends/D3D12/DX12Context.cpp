@@ -500,6 +500,8 @@ void DXContext::MoveToNextCommandList()
 void DXContext::ExecuteCommandList(bool wait_for_completion)
 {
   CommandListResources& res = m_command_lists[m_current_command_list];
+  if (!m_pending_barriers.empty())
+    FlushResourceBarriers();
 
   // Close and queue command list.
   HRESULT hr = res.command_list->Close();
@@ -518,6 +520,37 @@ void DXContext::ExecuteCommandList(bool wait_for_completion)
     WaitForFence(res.ready_fence_value);
 }
 
+void DXContext::ResourceBarrier(ID3D12Resource* resource, D3D12_RESOURCE_STATES from_state,
+                                D3D12_RESOURCE_STATES to_state)
+{
+  // Transitions are only queued between uses of the command list, so nothing can have accessed
+  // the resource in its intermediate state.
+  const auto it = std::ranges::find_if(m_pending_barriers, [resource](const auto& barrier) {
+    return barrier.Transition.pResource == resource;
+  });
+  if (it != m_pending_barriers.end())
+  {
+    ASSERT(it->Transition.StateAfter == from_state);
+    if (it->Transition.StateBefore == to_state)
+      m_pending_barriers.erase(it);
+    else
+      it->Transition.StateAfter = to_state;
+    return;
+  }
+
+  m_pending_barriers.push_back(
+      {D3D12_RESOURCE_BARRIER_TYPE_TRANSITION,
+       D3D12_RESOURCE_BARRIER_FLAG_NONE,
+       {{resource, D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, from_state, to_state}}});
+}
+
+void DXContext::FlushResourceBarriers()
+{
+  m_command_lists[m_current_command_list].command_list->ResourceBarrier(
+      static_cast<UINT>(m_pending_barriers.size()), m_pending_barriers.data());
+  m_pending_barriers.clear();
+}
+
 void DXContext::DeferResourceDestruction(ID3D12Resource* resource)
 {
   resource->AddRef();
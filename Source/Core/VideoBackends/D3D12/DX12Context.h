@@ -5,6 +5,7 @@
 
 #include <array>
 #include <memory>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/HRWrap.h"
@@ -63,8 +64,12 @@ public:
   ID3D12CommandQueue* GetCommandQueue() const { return m_command_queue.Get(); }
 
   // Returns the current command list, commands can be recorded directly.
-  ID3D12GraphicsCommandList* GetCommandList() const
+  // Any pending resource barriers are recorded first, so don't hold on to the returned pointer
+  // across resource transitions.
+  ID3D12GraphicsCommandList* GetCommandList()
   {
+    if (!m_pending_barriers.empty())
+      FlushResourceBarriers();
     return m_command_lists[m_current_command_list].command_list.Get();
   }
   DescriptorAllocator* GetDescriptorAllocator()
@@ -114,6 +119,15 @@ public:
   // Executes the current command list.
   void ExecuteCommandList(bool wait_for_completion);
 
+  // Queues a transition of all subresources of a resource. Queued transitions are recorded in a
+  // single call the next time the command list is accessed, and a transition that is followed by
+  // another one of the same resource is merged with it, or dropped if it's a round trip.
+  void ResourceBarrier(ID3D12Resource* resource, D3D12_RESOURCE_STATES from_state,
+                       D3D12_RESOURCE_STATES to_state);
+
+  // Records all queued transitions to the current command list.
+  void FlushResourceBarriers();
+
   // Waits for a specific fence.
   void WaitForFence(u64 fence);
 
@@ -175,6 +189,7 @@ private:
 
   std::array<CommandListResources, NUM_COMMAND_LISTS> m_command_lists;
   u32 m_current_command_list = NUM_COMMAND_LISTS - 1;
+  std::vector<D3D12_RESOURCE_BARRIER> m_pending_barriers;
 
   DescriptorHeapManager m_descriptor_heap_manager;
   DescriptorHeapManager m_rtv_heap_manager;
@@ -409,7 +409,7 @@ void DXTexture::TransitionToState(D3D12_RESOURCE_STATES state) const
   if (m_state == state)
     return;
 
-  ResourceBarrier(g_dx_context->GetCommandList(), m_resource.Get(), m_state, state);
+  g_dx_context->ResourceBarrier(m_resource.Get(), m_state, state);
   m_state = state;
 }
 
@@ -3,6 +3,8 @@
 
 #include "VideoBackends/D3D12/DescriptorAllocator.h"
 
+#include <cstring>
+
 #include "Common/Assert.h"
 
 #include "VideoBackends/D3D12/DX12Context.h"
@@ -47,6 +49,45 @@ bool DescriptorAllocator::Allocate(u32 num_handles, DescriptorHandle* out_base_h
 void DescriptorAllocator::Reset()
 {
   m_current_offset = 0;
+  m_texture_map.clear();
+}
+
+bool operator<(const TextureDescriptorSet& lhs, const TextureDescriptorSet& rhs)
+{
+  return std::memcmp(lhs.handles.data(), rhs.handles.data(), sizeof(lhs.handles)) < 0;
+}
+
+bool DescriptorAllocator::GetTextureGroupHandle(const TextureDescriptorSet& tds,
+                                                D3D12_GPU_DESCRIPTOR_HANDLE* handle)
+{
+  // A texture was destroyed, so a handle may now refer to a different texture.
+  const u64 generation = g_dx_context->GetDescriptorHeapManager().GetGeneration();
+  if (m_texture_map_generation != generation)
+  {
+    m_texture_map.clear();
+    m_texture_map_generation = generation;
+  }
+
+  auto it = m_texture_map.find(tds);
+  if (it != m_texture_map.end())
+  {
+    *handle = it->second;
+    return true;
+  }
+
+  DescriptorHandle allocation;
+  if (!Allocate(VideoCommon::MAX_PIXEL_SHADER_SAMPLERS, &allocation))
+    return false;
+
+  static constexpr std::array<UINT, VideoCommon::MAX_PIXEL_SHADER_SAMPLERS> source_sizes = {
+      {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1}};
+  g_dx_context->GetDevice()->CopyDescriptors(
+      1, &allocation.cpu_handle, &VideoCommon::MAX_PIXEL_SHADER_SAMPLERS,
+      VideoCommon::MAX_PIXEL_SHADER_SAMPLERS, tds.handles.data(), source_sizes.data(),
+      D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+  *handle = allocation.gpu_handle;
+  m_texture_map.emplace(tds, allocation.gpu_handle);
+  return true;
 }
 
 bool operator==(const SamplerStateSet& lhs, const SamplerStateSet& rhs)
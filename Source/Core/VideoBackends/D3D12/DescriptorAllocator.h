@@ -3,12 +3,20 @@
 
 #pragma once
 
+#include <array>
 #include <map>
 #include "VideoBackends/D3D12/DescriptorHeapManager.h"
 #include "VideoCommon/Constants.h"
 
 namespace DX12
 {
+struct TextureDescriptorSet final
+{
+  std::array<D3D12_CPU_DESCRIPTOR_HANDLE, VideoCommon::MAX_PIXEL_SHADER_SAMPLERS> handles;
+};
+
+bool operator<(const TextureDescriptorSet& lhs, const TextureDescriptorSet& rhs);
+
 class DescriptorAllocator
 {
 public:
@@ -23,6 +31,11 @@ public:
   bool Allocate(u32 num_handles, DescriptorHandle* out_base_handle);
   void Reset();
 
+  // Returns a table with copies of the given texture descriptors. Combinations which were already
+  // copied since the last reset are reused, so switching back and forth between textures doesn't
+  // copy descriptors every time.
+  bool GetTextureGroupHandle(const TextureDescriptorSet& tds, D3D12_GPU_DESCRIPTOR_HANDLE* handle);
+
 protected:
   ComPtr<ID3D12DescriptorHeap> m_descriptor_heap;
   u32 m_descriptor_increment_size = 0;
@@ -31,6 +44,11 @@ protected:
 
   D3D12_CPU_DESCRIPTOR_HANDLE m_heap_base_cpu = {};
   D3D12_GPU_DESCRIPTOR_HANDLE m_heap_base_gpu = {};
+
+  // Texture tables copied since the last reset, and the generation of the source heap they were
+  // copied at.
+  std::map<TextureDescriptorSet, D3D12_GPU_DESCRIPTOR_HANDLE> m_texture_map;
+  u64 m_texture_map_generation = 0;
 };
 
 struct SamplerStateSet final
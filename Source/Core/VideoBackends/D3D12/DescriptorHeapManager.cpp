@@ -74,6 +74,7 @@ void DescriptorHeapManager::Free(u32 index)
   u32 group = index / BITSET_SIZE;
   u32 bit = index % BITSET_SIZE;
   m_free_slots[group][bit] = true;
+  m_generation++;
 }
 
 void DescriptorHeapManager::Free(const DescriptorHandle& handle)
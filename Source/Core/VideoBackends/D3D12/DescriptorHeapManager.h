@@ -35,10 +35,15 @@ public:
   void Free(const DescriptorHandle& handle);
   void Free(u32 index);
 
+  // Incremented whenever a descriptor is freed, after which its slot may be reused for a different
+  // view. Copies of descriptors from this heap are only known to be current for one generation.
+  u64 GetGeneration() const { return m_generation; }
+
 private:
   ComPtr<ID3D12DescriptorHeap> m_descriptor_heap;
   u32 m_num_descriptors = 0;
   u32 m_descriptor_increment_size = 0;
+  u64 m_generation = 0;
 
   D3D12_CPU_DESCRIPTOR_HANDLE m_heap_base_cpu = {};
 
@@ -56,13 +56,24 @@ bool SwapChain::WantsHDR()
   return g_ActiveConfig.bHDR;
 }
 
+bool SwapChain::WantsLowLatency()
+{
+  return g_ActiveConfig.bLowLatencyPresent;
+}
+
 u32 SwapChain::GetSwapChainFlags() const
 {
   // This flag is necessary if we want to use a flip-model swapchain without locking the framerate
-  return m_allow_tearing_supported ? DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING : 0;
+  u32 flags = m_allow_tearing_supported ? DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING : 0;
+
+  // The flag has to be the same for all ResizeBuffers() calls as when the swap chain was created.
+  if (m_low_latency)
+    flags |= DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+
+  return flags;
 }
 
-bool SwapChain::CreateSwapChain(bool stereo, bool hdr)
+bool SwapChain::CreateSwapChain(bool stereo, bool hdr, bool low_latency)
 {
   RECT client_rc;
   if (GetClientRect(static_cast<HWND>(m_wsi.render_surface), &client_rc))
@@ -73,6 +84,7 @@ bool SwapChain::CreateSwapChain(bool stereo, bool hdr)
 
   m_stereo = false;
   m_hdr = false;
+  m_low_latency = low_latency;
 
   // Try using the Win8 version if available.
   Microsoft::WRL::ComPtr<IDXGIFactory2> dxgi_factory2;
@@ -118,6 +130,7 @@ bool SwapChain::CreateSwapChain(bool stereo, bool hdr)
   if (FAILED(hr))
   {
     hdr = false;
+    m_low_latency = false;
 
     DXGI_SWAP_CHAIN_DESC desc = {};
     desc.BufferDesc.Width = m_width;
@@ -150,6 +163,21 @@ bool SwapChain::CreateSwapChain(bool stereo, bool hdr)
 
   m_stereo = stereo;
 
+  if (m_low_latency)
+  {
+    // Only queue one frame, and wait for it to be shown before rendering the next one, instead
+    // of blocking in Present() with up to three frames queued.
+    Microsoft::WRL::ComPtr<IDXGISwapChain2> swap_chain2;
+    hr = m_swap_chain->QueryInterface(IID_PPV_ARGS(&swap_chain2));
+    if (SUCCEEDED(hr))
+      hr = swap_chain2->SetMaximumFrameLatency(1);
+    if (SUCCEEDED(hr))
+      m_frame_latency_waitable = swap_chain2->GetFrameLatencyWaitableObject();
+    else
+      WARN_LOG_FMT(VIDEO, "Failed to set up the frame latency waitable object: {}",
+                   Common::HRWrap(hr));
+  }
+
   if (hdr)
   {
     // Only try to activate HDR here, to avoid failing when creating the swapchain
@@ -195,6 +223,12 @@ void SwapChain::DestroySwapChain()
 {
   DestroySwapChainBuffers();
 
+  if (m_frame_latency_waitable)
+  {
+    CloseHandle(m_frame_latency_waitable);
+    m_frame_latency_waitable = nullptr;
+  }
+
   // Can't destroy swap chain while it's fullscreen.
   if (m_swap_chain && GetFullscreenState(m_swap_chain.Get()))
     m_swap_chain->SetFullscreenState(FALSE, nullptr);
@@ -236,7 +270,7 @@ void SwapChain::SetStereo(bool stereo)
 
   DestroySwapChain();
   // Do not try to re-activate HDR here if it had already failed
-  if (!CreateSwapChain(stereo, m_hdr))
+  if (!CreateSwapChain(stereo, m_hdr, m_low_latency))
   {
     PanicAlertFmt("Failed to switch swap chain stereo mode");
     CreateSwapChain(false, false);
@@ -253,13 +287,36 @@ void SwapChain::SetHDR(bool hdr)
 
   DestroySwapChain();
   // Do not try to re-activate stereo mode here if it had already failed
-  if (!CreateSwapChain(m_stereo, hdr))
+  if (!CreateSwapChain(m_stereo, hdr, m_low_latency))
   {
     PanicAlertFmt("Failed to switch swap chain SDR/HDR mode");
     CreateSwapChain(false, false);
   }
 }
 
+void SwapChain::SetLowLatency(bool low_latency)
+{
+  if (m_low_latency == low_latency)
+    return;
+
+  // The waitable object can only be requested when creating the swap chain.
+  DestroySwapChain();
+  if (!CreateSwapChain(m_stereo, m_hdr, low_latency))
+  {
+    PanicAlertFmt("Failed to switch swap chain latency mode");
+    CreateSwapChain(false, false);
+  }
+}
+
+bool SwapChain::WaitForFrameLatency()
+{
+  if (!m_frame_latency_waitable)
+    return false;
+
+  // Don't hang forever if the window is hidden and frames are never shown.
+  return WaitForSingleObjectEx(m_frame_latency_waitable, 100, TRUE) == WAIT_OBJECT_0;
+}
+
 bool SwapChain::GetFullscreen() const
 {
   return GetFullscreenState(m_swap_chain.Get());
@@ -317,7 +374,7 @@ bool SwapChain::ChangeSurface(void* native_handle)
   DestroySwapChain();
   m_wsi.render_surface = native_handle;
   // We only keep the swap chain settings (HDR/Stereo) that had successfully applied beofre
-  return CreateSwapChain(m_stereo, m_hdr);
+  return CreateSwapChain(m_stereo, m_hdr, m_low_latency);
 }
 
 }  // namespace D3DCommon
@@ -27,6 +27,8 @@ public:
 
   static bool WantsHDR();
 
+  static bool WantsLowLatency();
+
   IDXGISwapChain* GetDXGISwapChain() const { return m_swap_chain.Get(); }
   AbstractTextureFormat GetFormat() const
   {
@@ -34,6 +36,7 @@ public:
   }
   u32 GetWidth() const { return m_width; }
   u32 GetHeight() const { return m_height; }
+  bool IsLowLatency() const { return m_low_latency; }
 
   // Mode switches.
   bool GetFullscreen() const;
@@ -49,10 +52,16 @@ public:
   bool ResizeSwapChain();
   void SetStereo(bool stereo);
   void SetHDR(bool hdr);
+  void SetLowLatency(bool low_latency);
+
+  // Waits until the swap chain can queue another frame without blocking, which with a maximum
+  // frame latency of one means the previous frame has been shown.
+  // Returns false if the swap chain wasn't created with a frame latency waitable object.
+  bool WaitForFrameLatency();
 
 protected:
   u32 GetSwapChainFlags() const;
-  bool CreateSwapChain(bool stereo = false, bool hdr = false);
+  bool CreateSwapChain(bool stereo = false, bool hdr = false, bool low_latency = false);
   void DestroySwapChain();
 
   virtual bool CreateSwapChainBuffers() = 0;
@@ -70,6 +79,8 @@ protected:
 
   bool m_stereo = false;
   bool m_hdr = false;
+  bool m_low_latency = false;
+  HANDLE m_frame_latency_waitable = nullptr;
   bool m_allow_tearing_supported = false;
   bool m_has_fullscreen = false;
   bool m_fullscreen_request = false;
@@ -6,6 +6,9 @@
 #include <Metal/Metal.h>
 #include <QuartzCore/QuartzCore.h>
 
+#include <memory>
+
+#include "Common/Event.h"
 #include "VideoCommon/AbstractGfx.h"
 
 #include "VideoBackends/Metal/MRCHelpers.h"
@@ -69,12 +72,17 @@ public:
                              u32 groupsize_z, u32 groups_x, u32 groups_y, u32 groups_z) override;
   void BindBackbuffer(const ClearColor& clear_color = {}) override;
   void PresentBackbuffer() override;
+  bool WaitForPresentCompletion() override;
 
   SurfaceInfo GetSurfaceInfo() const override;
 
 private:
   MRCOwned<CAMetalLayer*> m_layer;
   MRCOwned<id<CAMetalDrawable>> m_drawable;
+  // Set once the last drawable presented in low latency mode was shown.
+  // Shared with the presented handler, which may run after we're destroyed.
+  std::shared_ptr<Common::Event> m_drawable_presented = std::make_shared<Common::Event>();
+  bool m_waiting_for_present = false;
   std::unique_ptr<Texture> m_bb_texture;
   std::unique_ptr<Framebuffer> m_backbuffer;
   u32 m_texture_counter = 0;
@@ -22,6 +22,7 @@ Metal::Gfx::Gfx(MRCOwned<CAMetalLayer*> layer) : m_layer(std::move(layer))
 {
   UpdateActiveConfig();
   [m_layer setDisplaySyncEnabled:g_ActiveConfig.bVSyncActive];
+  [m_layer setMaximumDrawableCount:g_ActiveConfig.bLowLatencyPresent ? 2 : 3];
 
   SetupSurface();
   g_state_tracker->FlushEncoders();
@@ -288,7 +289,10 @@ void Metal::Gfx::OnConfigChanged(u32 bits)
   AbstractGfx::OnConfigChanged(bits);
 
   if (bits & CONFIG_CHANGE_BIT_VSYNC)
+  {
     [m_layer setDisplaySyncEnabled:g_ActiveConfig.bVSyncActive];
+    [m_layer setMaximumDrawableCount:g_ActiveConfig.bLowLatencyPresent ? 2 : 3];
+  }
 
   if (bits & CONFIG_CHANGE_BIT_ANISOTROPY)
   {
@@ -466,6 +470,15 @@ void Metal::Gfx::PresentBackbuffer()
     g_state_tracker->EndRenderPass();
     if (m_drawable)
     {
+      if (g_ActiveConfig.bLowLatencyPresent)
+      {
+        m_drawable_presented->Reset();
+        [m_drawable addPresentedHandler:[presented = m_drawable_presented](id<MTLDrawable>) {
+          presented->Set();
+        }];
+        m_waiting_for_present = true;
+      }
+
       // PresentDrawable refuses to allow Dolphin to present faster than the display's refresh rate
       // when windowed (or fullscreen with vsync enabled, but that's more understandable).
       // On the other hand, it helps Xcode's GPU captures start and stop on frame boundaries
@@ -484,6 +497,16 @@ void Metal::Gfx::PresentBackbuffer()
   }
 }
 
+bool Metal::Gfx::WaitForPresentCompletion()
+{
+  if (!m_waiting_for_present)
+    return false;
+
+  // Don't hang forever if the window is hidden and frames are never shown.
+  m_waiting_for_present = false;
+  return m_drawable_presented->WaitFor(std::chrono::milliseconds(100));
+}
+
 void Metal::Gfx::CheckForSurfaceChange()
 {
   if (!g_presenter->SurfaceChangedTestAndClear())
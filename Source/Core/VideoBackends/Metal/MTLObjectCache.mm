@@ -8,6 +8,8 @@
 #include <optional>
 
 #include "Common/Assert.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 
 #include "VideoBackends/Metal/MTLPipeline.h"
@@ -16,6 +18,7 @@
 
 #include "VideoCommon/AbstractPipeline.h"
 #include "VideoCommon/NativeVertexFormat.h"
+#include "VideoCommon/ShaderGenCommon.h"
 #include "VideoCommon/VertexShaderGen.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -29,11 +32,14 @@ static void SetupDepthStencil(
 Metal::ObjectCache::ObjectCache()
 {
   m_internal = std::make_unique<Internal>();
+  if (g_ActiveConfig.bShaderCache)
+    m_internal->LoadArchive();
   SetupDepthStencil(m_dss);
 }
 
 Metal::ObjectCache::~ObjectCache()
 {
+  m_internal->SaveArchive();
 }
 
 void Metal::ObjectCache::Initialize(MRCOwned<id<MTLDevice>> device)
@@ -379,6 +385,113 @@ public:
   std::map<const Shader*, std::vector<PipelineID>> m_shaders;
   std::array<u32, 3> m_pipeline_counter;
 
+  // Compiled pipelines are recorded in a binary archive, so pipelines which are precompiled from
+  // the UID caches on the next launch are loaded from it instead of going through the compiler.
+  // Holds an id<MTLBinaryArchive>, which is only available on macOS 11 and iOS 14.
+  MRCOwned<id> m_archive;
+  std::string m_archive_filename;
+  std::mutex m_archive_mtx;
+  bool m_archive_dirty = false;
+
+  void LoadArchive()
+  {
+    if (@available(macOS 11, iOS 14, *))
+    {
+      @autoreleasepool
+      {
+        m_archive_filename =
+            GetDiskShaderCacheFileName(APIType::Metal, "PipelineArchive", false, true);
+        NSString* path = [NSString stringWithUTF8String:m_archive_filename.c_str()];
+        auto desc = MRCTransfer([MTLBinaryArchiveDescriptor new]);
+        if (File::Exists(m_archive_filename))
+          [desc setUrl:[NSURL fileURLWithPath:path]];
+        NSError* err = nullptr;
+        m_archive = MRCTransfer<id>([g_device newBinaryArchiveWithDescriptor:desc error:&err]);
+        if (!m_archive && [desc url])
+        {
+          // Most likely written by a different driver version. Start over with an empty archive.
+          WARN_LOG_FMT(VIDEO, "Failed to load pipeline archive {}: {}", m_archive_filename,
+                       [[err localizedDescription] UTF8String]);
+          File::Delete(m_archive_filename);
+          [desc setUrl:nil];
+          m_archive = MRCTransfer<id>([g_device newBinaryArchiveWithDescriptor:desc error:&err]);
+        }
+        if (!m_archive)
+        {
+          WARN_LOG_FMT(VIDEO, "Failed to create pipeline archive: {}",
+                       [[err localizedDescription] UTF8String]);
+        }
+      }
+    }
+  }
+
+  void SaveArchive()
+  {
+    if (@available(macOS 11, iOS 14, *))
+    {
+      std::lock_guard<std::mutex> lock(m_archive_mtx);
+      if (!m_archive || !m_archive_dirty)
+        return;
+      @autoreleasepool
+      {
+        id<MTLBinaryArchive> archive = m_archive;
+        NSError* err = nullptr;
+        NSURL* url =
+            [NSURL fileURLWithPath:[NSString stringWithUTF8String:m_archive_filename.c_str()]];
+        if (![archive serializeToURL:url error:&err])
+        {
+          WARN_LOG_FMT(VIDEO, "Failed to save pipeline archive {}: {}", m_archive_filename,
+                       [[err localizedDescription] UTF8String]);
+        }
+        m_archive_dirty = false;
+      }
+    }
+  }
+
+  id<MTLRenderPipelineState> NewPipelineState(MTLRenderPipelineDescriptor* desc,
+                                              MTLRenderPipelineReflection** reflection,
+                                              NSError** err)
+  {
+    constexpr MTLPipelineOption options = MTLPipelineOptionArgumentInfo;
+    if (@available(macOS 11, iOS 14, *))
+    {
+      if (m_archive)
+      {
+        id<MTLBinaryArchive> archive = m_archive;
+        [desc setBinaryArchives:@[ archive ]];
+        id<MTLRenderPipelineState> pipe = [g_device
+            newRenderPipelineStateWithDescriptor:desc
+                                         options:options | MTLPipelineOptionFailOnBinaryArchiveMiss
+                                      reflection:reflection
+                                           error:nil];
+        if (pipe)
+          return pipe;
+
+        // Not in the archive yet. Compile it as usual and record it for the next launch.
+        pipe = [g_device newRenderPipelineStateWithDescriptor:desc
+                                                      options:options
+                                                   reflection:reflection
+                                                        error:err];
+        if (pipe)
+        {
+          std::lock_guard<std::mutex> lock(m_archive_mtx);
+          NSError* add_err = nullptr;
+          if ([archive addRenderPipelineFunctionsWithDescriptor:desc error:&add_err])
+            m_archive_dirty = true;
+          else
+            WARN_LOG_FMT(VIDEO, "Failed to add pipeline to archive: {}",
+                         [[add_err localizedDescription] UTF8String]);
+        }
+        return pipe;
+      }
+    }
+
+    return [g_device newRenderPipelineStateWithDescriptor:desc
+                                                  options:options
+                                               reflection:reflection
+                                                    error:err];
+  }
+
   StoredPipeline CreatePipeline(const AbstractPipelineConfig& config)
   {
     @autoreleasepool
@@ -438,11 +551,7 @@ public:
         [desc setStencilAttachmentPixelFormat:Util::FromAbstract(fs.depth_texture_format)];
       NSError* err = nullptr;
       MTLRenderPipelineReflection* reflection = nullptr;
-      id<MTLRenderPipelineState> pipe =
-          [g_device newRenderPipelineStateWithDescriptor:desc
-                                                 options:MTLPipelineOptionArgumentInfo
-                                              reflection:&reflection
-                                                   error:&err];
+      id<MTLRenderPipelineState> pipe = NewPipelineState(desc, &reflection, &err);
       if (err)
       {
         PanicAlertFmt("Failed to compile pipeline for {} and {}: {}",
@@ -324,6 +324,7 @@ bool PopulateConfig(GLContext* m_main_gl_context)
   supports_glsl_cache = GLExtensions::Supports("GL_ARB_get_program_binary");
   g_ogl_config.bSupportsGLPinnedMemory = GLExtensions::Supports("GL_AMD_pinned_memory");
   g_ogl_config.bSupportsGLSync = GLExtensions::Supports("GL_ARB_sync");
+  g_ogl_config.bSupportsTimerQuery = GLExtensions::Supports("GL_ARB_timer_query");
   g_ogl_config.bSupportsGLBaseVertex = GLExtensions::Supports("GL_ARB_draw_elements_base_vertex") ||
                                        GLExtensions::Supports("GL_EXT_draw_elements_base_vertex") ||
                                        GLExtensions::Supports("GL_OES_draw_elements_base_vertex");
@@ -334,6 +335,8 @@ bool PopulateConfig(GLContext* m_main_gl_context)
   g_ogl_config.bSupportsDebug =
       GLExtensions::Supports("GL_KHR_debug") || GLExtensions::Supports("GL_ARB_debug_output");
   g_ogl_config.bSupportsTextureStorage = GLExtensions::Supports("GL_ARB_texture_storage");
+  // glBindTextures is only loaded for GL 4.4 contexts, not for the extension alone.
+  g_ogl_config.bSupportsMultiBind = GLExtensions::Supports("VERSION_4_4");
   g_ogl_config.SupportedMultisampleTexStorage = MultisampleTexStorageType::TexStorageNone;
   g_ogl_config.bSupportsImageLoadStore = GLExtensions::Supports("GL_ARB_shader_image_load_store");
   g_ogl_config.bSupportsConservativeDepth = GLExtensions::Supports("GL_ARB_conservative_depth");
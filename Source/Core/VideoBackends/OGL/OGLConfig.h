@@ -58,6 +58,7 @@ struct VideoConfig
   bool bIsES;
   bool bSupportsGLPinnedMemory;
   bool bSupportsGLSync;
+  bool bSupportsTimerQuery;
   bool bSupportsGLBaseVertex;
   bool bSupportsGLBufferStorage;
   bool bSupportsMSAA;
@@ -75,6 +76,7 @@ struct VideoConfig
   bool bSupportsAniso;
   bool bSupportsBitfield;
   bool bSupportsTextureSubImage;
+  bool bSupportsMultiBind;
   EsFbFetchType SupportedFramebufferFetch;
   bool bSupportsKHRShaderSubgroup;  // basic + arithmetic + ballot
   bool bSupportsExplicitLayoutInShader;
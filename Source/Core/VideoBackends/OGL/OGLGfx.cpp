@@ -23,6 +23,8 @@
 #include "VideoCommon/VideoConfig.h"
 
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <string_view>
 
 namespace OGL
@@ -200,6 +202,10 @@ OGLGfx::OGLGfx(std::unique_ptr<GLContext> main_gl_context, float backbuffer_scal
 
 OGLGfx::~OGLGfx()
 {
+  StopGPUTimer();
+  for (const GLuint query : m_gpu_timer_queries)
+    glDeleteQueries(1, &query);
+
   glDeleteFramebuffers(1, &m_shared_draw_framebuffer);
   glDeleteFramebuffers(1, &m_shared_read_framebuffer);
 }
@@ -273,12 +279,18 @@ void OGLGfx::SetViewport(float x, float y, float width, float height, float near
 
 void OGLGfx::Draw(u32 base_vertex, u32 num_vertices)
 {
+  if (m_pending_texture_bindings != 0)
+    BindPendingTextures();
+
   glDrawArrays(static_cast<const OGLPipeline*>(m_current_pipeline)->GetGLPrimitive(), base_vertex,
                num_vertices);
 }
 
 void OGLGfx::DrawIndexed(u32 base_index, u32 num_indices, u32 base_vertex)
 {
+  if (m_pending_texture_bindings != 0)
+    BindPendingTextures();
+
   if (g_ogl_config.bSupportsGLBaseVertex)
   {
     glDrawElementsBaseVertex(static_cast<const OGLPipeline*>(m_current_pipeline)->GetGLPrimitive(),
@@ -295,6 +307,9 @@ void OGLGfx::DrawIndexed(u32 base_index, u32 num_indices, u32 base_vertex)
 void OGLGfx::DispatchComputeShader(const AbstractShader* shader, u32 groupsize_x, u32 groupsize_y,
                                    u32 groupsize_z, u32 groups_x, u32 groups_y, u32 groups_z)
 {
+  if (m_pending_texture_bindings != 0)
+    BindPendingTextures();
+
   glUseProgram(static_cast<const OGLShader*>(shader)->GetGLComputeProgramID());
   glDispatchCompute(groups_x, groups_y, groups_z);
 
@@ -456,6 +471,45 @@ void OGLGfx::WaitForGPUIdle()
   glFinish();
 }
 
+void OGLGfx::StartGPUTimer()
+{
+  if (!g_ogl_config.bSupportsTimerQuery || m_gpu_timer_running)
+    return;
+
+  GLuint query;
+  glGenQueries(1, &query);
+  glBeginQuery(GL_TIME_ELAPSED, query);
+  m_gpu_timer_queries.push_back(query);
+  m_gpu_timer_running = true;
+}
+
+void OGLGfx::StopGPUTimer()
+{
+  if (!m_gpu_timer_running)
+    return;
+
+  glEndQuery(GL_TIME_ELAPSED);
+  m_gpu_timer_running = false;
+}
+
+std::optional<u64> OGLGfx::PopGPUTimerResult()
+{
+  if (m_gpu_timer_queries.size() <= (m_gpu_timer_running ? 1u : 0u))
+    return std::nullopt;
+
+  const GLuint query = m_gpu_timer_queries.front();
+  GLuint available = GL_FALSE;
+  glGetQueryObjectuiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+  if (!available)
+    return std::nullopt;
+
+  GLuint64 result = 0;
+  glGetQueryObjectui64v(query, GL_QUERY_RESULT, &result);
+  glDeleteQueries(1, &query);
+  m_gpu_timer_queries.pop_front();
+  return result;
+}
+
 void OGLGfx::CheckForSurfaceChange()
 {
   if (!g_presenter->SurfaceChangedTestAndClear())
@@ -643,12 +697,39 @@ void OGLGfx::SetTexture(u32 index, const AbstractTexture* texture)
   if (m_bound_textures[index] == gl_texture)
     return;
 
+  m_bound_textures[index] = gl_texture;
+
+  // Binding zero with glBindTextures would also unbind the texel buffers that share the units, so
+  // only non-null textures are deferred.
+  if (gl_texture && g_ogl_config.bSupportsMultiBind)
+  {
+    m_pending_texture_bindings |= 1u << index;
+    return;
+  }
+
+  m_pending_texture_bindings &= ~(1u << index);
   glActiveTexture(GL_TEXTURE0 + index);
   if (gl_texture)
     glBindTexture(gl_texture->GetGLTarget(), gl_texture->GetGLTextureId());
   else
     glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
-  m_bound_textures[index] = gl_texture;
+}
+
+void OGLGfx::BindPendingTextures()
+{
+  // Each run of consecutive units is bound with a single call.
+  std::array<GLuint, VideoCommon::MAX_PIXEL_SHADER_SAMPLERS> textures;
+  u32 pending = m_pending_texture_bindings;
+  while (pending != 0)
+  {
+    const u32 first = static_cast<u32>(std::countr_zero(pending));
+    const u32 count = static_cast<u32>(std::countr_one(pending >> first));
+    for (u32 i = 0; i < count; i++)
+      textures[i] = m_bound_textures[first + i]->GetGLTextureId();
+    glBindTextures(first, count, textures.data());
+    pending &= ~(((1u << count) - 1) << first);
+  }
+  m_pending_texture_bindings = 0;
 }
 
 void OGLGfx::SetSamplerState(u32 index, const SamplerState& state)
@@ -685,6 +766,7 @@ void OGLGfx::UnbindTexture(const AbstractTexture* texture)
     glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + i));
     glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
     m_bound_textures[i] = nullptr;
+    m_pending_texture_bindings &= ~(1u << i);
   }
 
   for (size_t i = 0; i < m_bound_image_textures.size(); i++)
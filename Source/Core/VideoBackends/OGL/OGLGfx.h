@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <deque>
+
 #include "VideoCommon/AbstractGfx.h"
 #include "VideoCommon/Constants.h"
 
@@ -67,6 +69,10 @@ public:
   void WaitForGPUIdle() override;
   void OnConfigChanged(u32 bits) override;
 
+  void StartGPUTimer() override;
+  void StopGPUTimer() override;
+  std::optional<u64> PopGPUTimerResult() override;
+
   virtual void SelectLeftBuffer() override;
   virtual void SelectRightBuffer() override;
   virtual void SelectMainBuffer() override;
@@ -78,7 +84,11 @@ public:
   bool IsGLES() const;
 
   // Invalidates a cached texture binding. Required for texel buffers when they borrow the units.
-  void InvalidateTextureBinding(u32 index) { m_bound_textures[index] = nullptr; }
+  void InvalidateTextureBinding(u32 index)
+  {
+    m_bound_textures[index] = nullptr;
+    m_pending_texture_bindings &= ~(1u << index);
+  }
 
   // The shared framebuffer exists for copying textures when extensions are not available. It is
   // slower, but the only way to do these things otherwise.
@@ -100,9 +110,14 @@ private:
   void ApplyDepthState(const DepthState state);
   void ApplyBlendingState(const BlendingState state);
 
+  // Binds the textures that were set since the last draw with as few calls as possible.
+  void BindPendingTextures();
+
   std::unique_ptr<GLContext> m_main_gl_context;
   std::unique_ptr<OGLFramebuffer> m_system_framebuffer;
   std::array<const OGLTexture*, VideoCommon::MAX_PIXEL_SHADER_SAMPLERS> m_bound_textures{};
+  // Units of m_bound_textures which haven't been bound yet, only used with ARB_multi_bind.
+  u32 m_pending_texture_bindings = 0;
   std::array<const AbstractTexture*, VideoCommon::MAX_COMPUTE_SHADER_SAMPLERS>
       m_bound_image_textures{};
   AbstractTexture* m_bound_image_texture = nullptr;
@@ -112,6 +127,11 @@ private:
   u32 m_shared_read_framebuffer = 0;
   u32 m_shared_draw_framebuffer = 0;
   float m_backbuffer_scale;
+
+  // GL_TIME_ELAPSED queries which haven't been read back yet, the last one of which is still
+  // running if m_gpu_timer_running is set
+  std::deque<u32> m_gpu_timer_queries;
+  bool m_gpu_timer_running = false;
 };
 
 inline OGLGfx* GetOGLGfx()
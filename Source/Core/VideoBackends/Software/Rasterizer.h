@@ -9,7 +9,9 @@ struct OutputVertexData;
 
 namespace Rasterizer
 {
+// Starts the worker threads used for shading large triangles.
 void Init();
+void Shutdown();
 void ScissorChanged();
 
 void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
@@ -5,8 +5,15 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <span>
 
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
 #include "Common/CommonTypes.h"
 #include "Common/MsgHandler.h"
 #include "Common/SpanUtils.h"
@@ -70,6 +77,62 @@ static inline void AddTexel(const u8* inTexel, u32* outTexel, u32 fract)
   outTexel[3] += inTexel[3] * fract;
 }
 
+// Blends four texels with bilinear weights summing to 128 * 128. All channels are blended at once
+// where SIMD is available, with the same integer math as the scalar path.
+static inline void BilinearBlend(const u8 (&texels)[4][4], u32 fractS, u32 fractT, u8* sample)
+{
+  const u32 w00 = (128 - fractS) * (128 - fractT);
+  const u32 w10 = fractS * (128 - fractT);
+  const u32 w01 = (128 - fractS) * fractT;
+  const u32 w11 = fractS * fractT;
+
+#if defined(_M_X86_64)
+  u32 t[4];
+  std::memcpy(t, texels, sizeof(t));
+
+  // Interleave the 16-bit channels of two texels, so that madd weights and sums each pair.
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i t0010 = _mm_unpacklo_epi8(
+      _mm_unpacklo_epi8(_mm_cvtsi32_si128(t[0]), _mm_cvtsi32_si128(t[1])), zero);
+  const __m128i t0111 = _mm_unpacklo_epi8(
+      _mm_unpacklo_epi8(_mm_cvtsi32_si128(t[2]), _mm_cvtsi32_si128(t[3])), zero);
+  const __m128i w0010 = _mm_set1_epi32(static_cast<s32>(w00 | (w10 << 16)));
+  const __m128i w0111 = _mm_set1_epi32(static_cast<s32>(w01 | (w11 << 16)));
+
+  __m128i sum = _mm_add_epi32(_mm_madd_epi16(t0010, w0010), _mm_madd_epi16(t0111, w0111));
+  sum = _mm_srli_epi32(sum, 14);
+  sum = _mm_packs_epi32(sum, sum);
+  sum = _mm_packus_epi16(sum, sum);
+
+  const u32 result = static_cast<u32>(_mm_cvtsi128_si32(sum));
+  std::memcpy(sample, &result, sizeof(result));
+#elif defined(_M_ARM_64)
+  const uint8x16_t t = vld1q_u8(&texels[0][0]);
+  const uint16x8_t t0010 = vmovl_u8(vget_low_u8(t));
+  const uint16x8_t t0111 = vmovl_u8(vget_high_u8(t));
+
+  uint32x4_t sum = vmull_n_u16(vget_low_u16(t0010), static_cast<u16>(w00));
+  sum = vmlal_n_u16(sum, vget_high_u16(t0010), static_cast<u16>(w10));
+  sum = vmlal_n_u16(sum, vget_low_u16(t0111), static_cast<u16>(w01));
+  sum = vmlal_n_u16(sum, vget_high_u16(t0111), static_cast<u16>(w11));
+
+  const uint16x4_t result = vshrn_n_u32(sum, 14);
+  vst1_lane_u32(reinterpret_cast<u32*>(sample),
+                vreinterpret_u32_u8(vmovn_u16(vcombine_u16(result, result))), 0);
+#else
+  u32 texel[4];
+  SetTexel(texels[0], texel, w00);
+  AddTexel(texels[1], texel, w10);
+  AddTexel(texels[2], texel, w01);
+  AddTexel(texels[3], texel, w11);
+
+  sample[0] = (u8)(texel[0] >> 14);
+  sample[1] = (u8)(texel[1] >> 14);
+  sample[2] = (u8)(texel[2] >> 14);
+  sample[3] = (u8)(texel[3] >> 14);
+#endif
+}
+
 void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
 {
   int baseMip = 0;
@@ -194,8 +257,7 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     int imageTPlus1 = imageT + 1;
     const int fractT = t & 0x7f;
 
-    u8 sampledTex[4];
-    u32 texel[4];
+    u8 sampledTex[4][4];
 
     WrapCoord(&imageS, tm0.wrap_s, image_width_minus_1 + 1);
     WrapCoord(&imageT, tm0.wrap_t, image_height_minus_1 + 1);
@@ -204,45 +266,28 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
 
     if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1.cache_manually_managed))
     {
-      TexDecoder_DecodeTexel(sampledTex, image_src, imageS, imageT, image_width_minus_1, texfmt,
-                             tlut, tlutfmt);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, image_src, imageSPlus1, imageT, image_width_minus_1,
+      TexDecoder_DecodeTexel(sampledTex[0], image_src, imageS, imageT, image_width_minus_1,
                              texfmt, tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, image_src, imageS, imageTPlus1, image_width_minus_1,
+      TexDecoder_DecodeTexel(sampledTex[1], image_src, imageSPlus1, imageT, image_width_minus_1,
                              texfmt, tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, image_src, imageSPlus1, imageTPlus1, image_width_minus_1,
+      TexDecoder_DecodeTexel(sampledTex[2], image_src, imageS, imageTPlus1, image_width_minus_1,
                              texfmt, tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
+      TexDecoder_DecodeTexel(sampledTex[3], image_src, imageSPlus1, imageTPlus1,
+                             image_width_minus_1, texfmt, tlut, tlutfmt);
     }
     else
     {
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, image_src, image_src_odd, imageS, imageT,
-                                          image_width_minus_1);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, image_src, image_src_odd, imageSPlus1, imageT,
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[0], image_src, image_src_odd, imageS, imageT,
                                           image_width_minus_1);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, image_src, image_src_odd, imageS, imageTPlus1,
-                                          image_width_minus_1);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, image_src, image_src_odd, imageSPlus1,
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[1], image_src, image_src_odd, imageSPlus1,
+                                          imageT, image_width_minus_1);
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[2], image_src, image_src_odd, imageS,
+                                          imageTPlus1, image_width_minus_1);
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[3], image_src, image_src_odd, imageSPlus1,
                                           imageTPlus1, image_width_minus_1);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
     }
 
-    sample[0] = (u8)(texel[0] >> 14);
-    sample[1] = (u8)(texel[1] >> 14);
-    sample[2] = (u8)(texel[2] >> 14);
-    sample[3] = (u8)(texel[3] >> 14);
+    BilinearBlend(sampledTex, fractS, fractT, sample);
   }
   else
   {
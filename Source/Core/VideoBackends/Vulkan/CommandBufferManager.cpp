@@ -3,6 +3,7 @@
 
 #include "VideoBackends/Vulkan/CommandBufferManager.h"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 
@@ -15,8 +16,9 @@
 
 namespace Vulkan
 {
-CommandBufferManager::CommandBufferManager(bool use_threaded_submission)
-    : m_use_threaded_submission(use_threaded_submission)
+CommandBufferManager::CommandBufferManager(bool use_threaded_submission, u32 frames_in_flight)
+    : m_frames_in_flight(std::clamp<u32>(frames_in_flight, 1, MAX_FRAMES_IN_FLIGHT)),
+      m_use_threaded_submission(use_threaded_submission)
 {
 }
 
@@ -51,6 +53,21 @@ bool CommandBufferManager::CreateCommandBuffers()
   VkDevice device = g_vulkan_context->GetDevice();
   VkResult res;
 
+  if (g_vulkan_context->SupportsTimelineSemaphores())
+  {
+    const VkSemaphoreTypeCreateInfoKHR type_create_info = {
+        VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR, nullptr, VK_SEMAPHORE_TYPE_TIMELINE_KHR,
+        0};
+    const VkSemaphoreCreateInfo timeline_create_info = {VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+                                                        &type_create_info, 0};
+    res = vkCreateSemaphore(device, &timeline_create_info, nullptr, &m_timeline_semaphore);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkCreateSemaphore failed: ");
+      return false;
+    }
+  }
+
   for (CmdBufferResources& resources : m_command_buffers)
   {
     resources.init_command_buffer_used = false;
@@ -77,14 +94,18 @@ bool CommandBufferManager::CreateCommandBuffers()
       return false;
     }
 
-    VkFenceCreateInfo fence_info = {VK_STRUCTURE_TYPE_FENCE_CREATE_INFO, nullptr,
-                                    VK_FENCE_CREATE_SIGNALED_BIT};
-
-    res = vkCreateFence(device, &fence_info, nullptr, &resources.fence);
-    if (res != VK_SUCCESS)
+    // The timeline semaphore tracks completion instead.
+    if (m_timeline_semaphore == VK_NULL_HANDLE)
     {
-      LOG_VULKAN_ERROR(res, "vkCreateFence failed: ");
-      return false;
+      VkFenceCreateInfo fence_info = {VK_STRUCTURE_TYPE_FENCE_CREATE_INFO, nullptr,
+                                      VK_FENCE_CREATE_SIGNALED_BIT};
+
+      res = vkCreateFence(device, &fence_info, nullptr, &resources.fence);
+      if (res != VK_SUCCESS)
+      {
+        LOG_VULKAN_ERROR(res, "vkCreateFence failed: ");
+        return false;
+      }
     }
 
     res = vkCreateSemaphore(device, &semaphore_create_info, nullptr, &resources.semaphore);
@@ -141,6 +162,9 @@ void CommandBufferManager::DestroyCommandBuffers()
   }
 
   vkDestroySemaphore(device, m_present_semaphore, nullptr);
+
+  if (m_timeline_semaphore != VK_NULL_HANDLE)
+    vkDestroySemaphore(device, m_timeline_semaphore, nullptr);
 }
 
 VkDescriptorPool CommandBufferManager::CreateDescriptorPool(u32 max_descriptor_sets)
@@ -258,6 +282,70 @@ void CommandBufferManager::WaitForFenceCounter(u64 fence_counter)
   WaitForCommandBufferCompletion(index);
 }
 
+bool CommandBufferManager::CheckFenceCounter(u64 fence_counter)
+{
+  if (m_completed_fence_counter >= fence_counter)
+    return true;
+
+  // Find the first command buffer which covers this counter value.
+  u32 index = (m_current_cmd_buffer + 1) % NUM_COMMAND_BUFFERS;
+  while (index != m_current_cmd_buffer)
+  {
+    if (m_command_buffers[index].fence_counter >= fence_counter)
+      break;
+
+    index = (index + 1) % NUM_COMMAND_BUFFERS;
+  }
+
+  // The current command buffer hasn't been submitted yet.
+  if (index == m_current_cmd_buffer)
+    return false;
+
+  // A single query of the timeline semaphore covers all the submitted command buffers.
+  u64 completed_timeline_value = 0;
+  if (m_timeline_semaphore != VK_NULL_HANDLE)
+  {
+    const VkResult res = vkGetSemaphoreCounterValueKHR(
+        g_vulkan_context->GetDevice(), m_timeline_semaphore, &completed_timeline_value);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkGetSemaphoreCounterValueKHR failed: ");
+      return false;
+    }
+  }
+
+  if (!IsCommandBufferCompleted(index, completed_timeline_value))
+    return false;
+
+  // Later command buffers may have completed too, so clean them up now as well.
+  if (m_timeline_semaphore != VK_NULL_HANDLE)
+  {
+    for (u32 next_index = (index + 1) % NUM_COMMAND_BUFFERS;
+         next_index != m_current_cmd_buffer &&
+         IsCommandBufferCompleted(next_index, completed_timeline_value);
+         next_index = (next_index + 1) % NUM_COMMAND_BUFFERS)
+    {
+      index = next_index;
+    }
+  }
+
+  // The command buffer has already completed, so this only cleans up.
+  WaitForCommandBufferCompletion(index);
+  return true;
+}
+
+bool CommandBufferManager::IsCommandBufferCompleted(u32 index, u64 completed_timeline_value) const
+{
+  const CmdBufferResources& resources = m_command_buffers[index];
+  if (resources.waiting_for_submit.load(std::memory_order_acquire))
+    return false;
+
+  if (m_timeline_semaphore != VK_NULL_HANDLE)
+    return completed_timeline_value >= resources.fence_counter;
+
+  return vkGetFenceStatus(g_vulkan_context->GetDevice(), resources.fence) == VK_SUCCESS;
+}
+
 void CommandBufferManager::WaitForCommandBufferCompletion(u32 index)
 {
   CmdBufferResources& resources = m_command_buffers[index];
@@ -271,10 +359,25 @@ void CommandBufferManager::WaitForCommandBufferCompletion(u32 index)
   }
 
   // Wait for this command buffer to be completed.
-  VkResult res =
-      vkWaitForFences(g_vulkan_context->GetDevice(), 1, &resources.fence, VK_TRUE, UINT64_MAX);
-  if (res != VK_SUCCESS)
-    LOG_VULKAN_ERROR(res, "vkWaitForFences failed: ");
+  if (m_timeline_semaphore != VK_NULL_HANDLE)
+  {
+    const VkSemaphoreWaitInfoKHR wait_info = {VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR,
+                                              nullptr,
+                                              0,
+                                              1,
+                                              &m_timeline_semaphore,
+                                              &resources.fence_counter};
+    VkResult res = vkWaitSemaphoresKHR(g_vulkan_context->GetDevice(), &wait_info, UINT64_MAX);
+    if (res != VK_SUCCESS)
+      LOG_VULKAN_ERROR(res, "vkWaitSemaphoresKHR failed: ");
+  }
+  else
+  {
+    VkResult res =
+        vkWaitForFences(g_vulkan_context->GetDevice(), 1, &resources.fence, VK_TRUE, UINT64_MAX);
+    if (res != VK_SUCCESS)
+      LOG_VULKAN_ERROR(res, "vkWaitForFences failed: ");
+  }
 
   // Clean up any resources for command buffers between the last known completed buffer and this
   // now-completed command buffer. If we use >2 buffers, this may be more than one buffer.
@@ -336,7 +439,7 @@ void CommandBufferManager::SubmitCommandBuffer(bool submit_on_worker_thread,
 
   if (present_swap_chain != VK_NULL_HANDLE)
   {
-    m_current_frame = (m_current_frame + 1) % NUM_FRAMES_IN_FLIGHT;
+    m_current_frame = (m_current_frame + 1) % m_frames_in_flight;
 
     // Wait for all command buffers that used the descriptor pool to finish
     u32 cmd_buffer_index = (m_current_cmd_buffer + 1) % NUM_COMMAND_BUFFERS;
@@ -374,6 +477,7 @@ void CommandBufferManager::SubmitCommandBuffer(bool submit_on_worker_thread,
     }
 
     frame_resources.current_descriptor_pool_index = 0;
+    m_descriptor_pool_generation++;
   }
 
   // Switch to next cmdbuffer.
@@ -411,11 +515,23 @@ void CommandBufferManager::SubmitCommandBuffer(u32 command_buffer_index,
     submit_info.waitSemaphoreCount = 1;
   }
 
+  // The timeline semaphore is signaled with the fence counter, the present semaphore is binary
+  // so its value is ignored.
+  std::array<VkSemaphore, 2> signal_semaphores;
+  const std::array<u64, 2> signal_values = {resources.fence_counter, 0};
+  u32 signal_semaphore_count = 0;
+  if (m_timeline_semaphore != VK_NULL_HANDLE)
+    signal_semaphores[signal_semaphore_count++] = m_timeline_semaphore;
   if (present_swap_chain != VK_NULL_HANDLE)
-  {
-    submit_info.signalSemaphoreCount = 1;
-    submit_info.pSignalSemaphores = &m_present_semaphore;
-  }
+    signal_semaphores[signal_semaphore_count++] = m_present_semaphore;
+  submit_info.signalSemaphoreCount = signal_semaphore_count;
+  submit_info.pSignalSemaphores = signal_semaphores.data();
+
+  VkTimelineSemaphoreSubmitInfoKHR timeline_submit_info = {
+      VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR, nullptr, 0, nullptr,
+      signal_semaphore_count, signal_values.data()};
+  if (m_timeline_semaphore != VK_NULL_HANDLE)
+    submit_info.pNext = &timeline_submit_info;
 
   VkResult res =
       vkQueueSubmit(g_vulkan_context->GetGraphicsQueue(), 1, &submit_info, resources.fence);
@@ -439,10 +555,22 @@ void CommandBufferManager::SubmitCommandBuffer(u32 command_buffer_index,
                                      &present_image_index,
                                      nullptr};
 
+    // Tag the present so that we can wait for it to be shown.
+    const u64 present_id = m_next_present_id++;
+    VkPresentIdKHR present_id_info = {VK_STRUCTURE_TYPE_PRESENT_ID_KHR, nullptr, 1, &present_id};
+    if (g_vulkan_context->SupportsPresentWait())
+      present_info.pNext = &present_id_info;
+
     m_last_present_result = vkQueuePresentKHR(g_vulkan_context->GetPresentQueue(), &present_info);
     m_last_present_done.Set();
+    m_last_present_swap_chain = present_swap_chain;
+    m_last_present_id = present_id;
     if (m_last_present_result != VK_SUCCESS)
     {
+      // A present that failed is never shown, so don't wait for it.
+      if (m_last_present_result != VK_SUBOPTIMAL_KHR)
+        m_last_present_swap_chain = VK_NULL_HANDLE;
+
       // VK_ERROR_OUT_OF_DATE_KHR is not fatal, just means we need to recreate our swap chain.
       if (m_last_present_result != VK_ERROR_OUT_OF_DATE_KHR &&
           m_last_present_result != VK_SUBOPTIMAL_KHR &&
@@ -463,6 +591,23 @@ void CommandBufferManager::SubmitCommandBuffer(u32 command_buffer_index,
   }
 }
 
+bool CommandBufferManager::WaitForLastPresent(VkSwapchainKHR swap_chain, u64 timeout_ns)
+{
+  if (!g_vulkan_context->SupportsPresentWait())
+    return false;
+
+  // The present has to be queued before we can wait for it.
+  WaitForWorkerThreadIdle();
+  if (m_last_present_swap_chain == VK_NULL_HANDLE || m_last_present_swap_chain != swap_chain)
+    return false;
+
+  const VkResult res =
+      vkWaitForPresentKHR(g_vulkan_context->GetDevice(), swap_chain, m_last_present_id, timeout_ns);
+  if (res != VK_SUCCESS && res != VK_TIMEOUT)
+    LOG_VULKAN_ERROR(res, "vkWaitForPresentKHR failed: ");
+  return res == VK_SUCCESS;
+}
+
 void CommandBufferManager::BeginCommandBuffer()
 {
   // Move to the next command buffer.
@@ -474,9 +619,13 @@ void CommandBufferManager::BeginCommandBuffer()
     WaitForCommandBufferCompletion(next_buffer_index);
 
   // Reset fence to unsignaled before starting.
-  VkResult res = vkResetFences(g_vulkan_context->GetDevice(), 1, &resources.fence);
-  if (res != VK_SUCCESS)
-    LOG_VULKAN_ERROR(res, "vkResetFences failed: ");
+  VkResult res;
+  if (resources.fence != VK_NULL_HANDLE)
+  {
+    res = vkResetFences(g_vulkan_context->GetDevice(), 1, &resources.fence);
+    if (res != VK_SUCCESS)
+      LOG_VULKAN_ERROR(res, "vkResetFences failed: ");
+  }
 
   // Reset command pools to beginning since we can re-use the memory now
   res = vkResetCommandPool(g_vulkan_context->GetDevice(), resources.command_pool, 0);
@@ -26,7 +26,7 @@ namespace Vulkan
 class CommandBufferManager
 {
 public:
-  explicit CommandBufferManager(bool use_threaded_submission);
+  CommandBufferManager(bool use_threaded_submission, u32 frames_in_flight);
   ~CommandBufferManager();
 
   bool Initialize();
@@ -47,10 +47,16 @@ public:
   // Allocates a descriptors set from the pool reserved for the current frame.
   VkDescriptorSet AllocateDescriptorSet(VkDescriptorSetLayout set_layout);
 
+  // Changes whenever a new frame starts using its descriptor pools. Descriptor sets that were
+  // allocated before may be reset with the pools, so they can't be reused afterwards.
+  u64 GetDescriptorPoolGeneration() const { return m_descriptor_pool_generation; }
+
   // Fence "counters" are used to track which commands have been completed by the GPU.
   // If the last completed fence counter is greater or equal to N, it means that the work
   // associated counter N has been completed by the GPU. The value of N to associate with
   // commands can be retreived by calling GetCurrentFenceCounter().
+  // With VK_KHR_timeline_semaphore, the counter is the value of a timeline semaphore that each
+  // submission signals, otherwise every command buffer has its own fence.
   u64 GetCompletedFenceCounter() const { return m_completed_fence_counter; }
 
   // Gets the fence that will be signaled when the currently executing command buffer is
@@ -77,6 +83,9 @@ public:
   // Also invokes callbacks for completion.
   void WaitForFenceCounter(u64 fence_counter);
 
+  // Returns whether a fence has been completed, without waiting for it.
+  bool CheckFenceCounter(u64 fence_counter);
+
   void SubmitCommandBuffer(bool submit_on_worker_thread, bool wait_for_completion,
                            VkSwapchainKHR present_swap_chain = VK_NULL_HANDLE,
                            uint32_t present_image_index = 0xFFFFFFFF);
@@ -86,6 +95,11 @@ public:
   VkResult GetLastPresentResult() const { return m_last_present_result; }
   bool CheckLastPresentDone() { return m_last_present_done.TestAndClear(); }
 
+  // Waits until the last frame presented to the given swap chain has been shown, or the timeout
+  // expires. Returns false if that can't be known, because VK_KHR_present_wait is unsupported or
+  // nothing was presented to this swap chain yet.
+  bool WaitForLastPresent(VkSwapchainKHR swap_chain, u64 timeout_ns);
+
   // Schedule a vulkan resource for destruction later on. This will occur when the command buffer
   // is next re-used, and the GPU has finished working with the specified resource.
   void DeferBufferViewDestruction(VkBufferView object);
@@ -101,6 +115,8 @@ private:
   bool CreateSubmitThread();
 
   void WaitForCommandBufferCompletion(u32 command_buffer_index);
+  // Returns whether the command buffer has been submitted and completed, without waiting.
+  bool IsCommandBufferCompleted(u32 command_buffer_index, u64 completed_timeline_value) const;
   void SubmitCommandBuffer(u32 command_buffer_index, VkSwapchainKHR present_swap_chain,
                            u32 present_image_index);
   void BeginCommandBuffer();
@@ -141,9 +157,14 @@ private:
   u64 m_next_fence_counter = 1;
   u64 m_completed_fence_counter = 0;
 
-  std::array<FrameResources, NUM_FRAMES_IN_FLIGHT> m_frame_resources;
+  std::array<FrameResources, MAX_FRAMES_IN_FLIGHT> m_frame_resources;
   std::array<CmdBufferResources, NUM_COMMAND_BUFFERS> m_command_buffers;
+  u32 m_frames_in_flight;
   u32 m_current_frame = 0;
+  u64 m_descriptor_pool_generation = 0;
+
+  // Signaled with the fence counter of each command buffer, replaces the fences when supported.
+  VkSemaphore m_timeline_semaphore = VK_NULL_HANDLE;
   u32 m_current_cmd_buffer = 0;
 
   // Threaded command buffer execution
@@ -158,6 +179,10 @@ private:
   Common::Flag m_last_present_failed;
   Common::Flag m_last_present_done;
   VkResult m_last_present_result = VK_SUCCESS;
+  // Only accessed by the thread presenting, or after waiting for the worker thread.
+  u64 m_next_present_id = 1;
+  u64 m_last_present_id = 0;
+  VkSwapchainKHR m_last_present_swap_chain = VK_NULL_HANDLE;
   bool m_use_threaded_submission = false;
   u32 m_descriptor_set_count = DESCRIPTOR_SETS_PER_POOL;
 };
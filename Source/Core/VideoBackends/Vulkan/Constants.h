@@ -14,8 +14,9 @@ namespace Vulkan
 // Number of command buffers.
 constexpr size_t NUM_COMMAND_BUFFERS = 8;
 
-// Number of frames in flight, will be used to decide how many descriptor pools are used
-constexpr size_t NUM_FRAMES_IN_FLIGHT = 2;
+// Maximum number of frames in flight, each frame in flight has its own descriptor pools
+// The number that is used is set by the MaxFramesInFlight setting
+constexpr size_t MAX_FRAMES_IN_FLIGHT = 4;
 
 // Staging buffer usage - optimize for uploads or readbacks
 enum STAGING_BUFFER_TYPE
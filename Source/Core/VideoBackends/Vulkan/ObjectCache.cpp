@@ -37,6 +37,7 @@ ObjectCache::~ObjectCache()
   DestroyPipelineLayouts();
   DestroyDescriptorSetLayouts();
   DestroyRenderPassCache();
+  DestroyPipelineLibraryCache();
   m_dummy_texture.reset();
 }
 
@@ -216,6 +217,15 @@ bool ObjectCache::CreateDescriptorSetLayouts()
     create_infos[DESCRIPTOR_SET_LAYOUT_STANDARD_UNIFORM_BUFFERS].bindingCount--;
   }
 
+  // The sampler sets are pushed straight into the command buffer if possible, see StateTracker.
+  if (g_vulkan_context->SupportsPushDescriptors())
+  {
+    create_infos[DESCRIPTOR_SET_LAYOUT_STANDARD_SAMPLERS].flags |=
+        VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+    create_infos[DESCRIPTOR_SET_LAYOUT_UTILITY_SAMPLERS].flags |=
+        VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+  }
+
   // Remove the dynamic vertex loader's buffer if it'll never be needed
   if (!g_ActiveConfig.backend_info.bSupportsDynamicVertexLoader)
     create_infos[DESCRIPTOR_SET_LAYOUT_STANDARD_SHADER_STORAGE_BUFFERS].bindingCount--;
@@ -507,6 +517,41 @@ void ObjectCache::DestroyRenderPassCache()
   m_render_pass_cache.clear();
 }
 
+VkPipeline ObjectCache::FindPipelineLibrary(const PipelineLibraryKey& key)
+{
+  std::lock_guard lk(m_pipeline_library_mutex);
+  auto it = m_pipeline_library_cache.find(key);
+  return it != m_pipeline_library_cache.end() ? it->second : VK_NULL_HANDLE;
+}
+
+VkPipeline ObjectCache::InsertPipelineLibrary(const PipelineLibraryKey& key, VkPipeline library)
+{
+  std::lock_guard lk(m_pipeline_library_mutex);
+  auto [it, inserted] = m_pipeline_library_cache.emplace(key, library);
+  if (!inserted)
+    vkDestroyPipeline(g_vulkan_context->GetDevice(), library, nullptr);
+  return it->second;
+}
+
+void ObjectCache::DestroyPipelineLibraries(u64 shader_id)
+{
+  std::lock_guard lk(m_pipeline_library_mutex);
+  std::erase_if(m_pipeline_library_cache, [shader_id](const auto& it) {
+    if (std::get<1>(it.first) != shader_id && std::get<2>(it.first) != shader_id)
+      return false;
+    vkDestroyPipeline(g_vulkan_context->GetDevice(), it.second, nullptr);
+    return true;
+  });
+}
+
+void ObjectCache::DestroyPipelineLibraryCache()
+{
+  std::lock_guard lk(m_pipeline_library_mutex);
+  for (auto& it : m_pipeline_library_cache)
+    vkDestroyPipeline(g_vulkan_context->GetDevice(), it.second, nullptr);
+  m_pipeline_library_cache.clear();
+}
+
 class PipelineCacheReadCallback : public Common::LinearDiskCacheReader<u32, u8>
 {
 public:
@@ -7,6 +7,7 @@
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -65,6 +66,18 @@ public:
   // Pipeline cache. Used when creating pipelines for drivers to store compiled programs.
   VkPipelineCache GetPipelineCache() const { return m_pipeline_cache; }
 
+  // Graphics pipeline library cache. Keyed by the library part, the ids of the shaders it is built
+  // from, the vertex format, two words of packed render state, the layout and the render pass.
+  // Safe to call from the shader compiler threads.
+  using PipelineLibraryKey = std::tuple<u32, u64, u64, const VertexFormat*, u32, u32,
+                                        VkPipelineLayout, VkRenderPass>;
+  VkPipeline FindPipelineLibrary(const PipelineLibraryKey& key);
+  // Returns the library that ends up in the cache, which is not the one passed in if another
+  // thread created the same library in the meantime.
+  VkPipeline InsertPipelineLibrary(const PipelineLibraryKey& key, VkPipeline library);
+  // Destroys all libraries built from the given shader. Called when the shader is destroyed.
+  void DestroyPipelineLibraries(u64 shader_id);
+
   // Clear sampler cache, use when anisotropy mode changes
   // WARNING: Ensure none of the objects from here are in use when calling
   void ClearSamplerCache();
@@ -83,6 +96,7 @@ private:
   bool CreateStaticSamplers();
   void DestroySamplers();
   void DestroyRenderPassCache();
+  void DestroyPipelineLibraryCache();
   bool CreatePipelineCache();
   bool LoadPipelineCache();
   bool ValidatePipelineCache(const u8* data, size_t data_length);
@@ -105,6 +119,10 @@ private:
   using RenderPassCacheKey = std::tuple<VkFormat, VkFormat, u32, VkAttachmentLoadOp, std::size_t>;
   std::map<RenderPassCacheKey, VkRenderPass> m_render_pass_cache;
 
+  // Graphics pipeline library cache
+  std::mutex m_pipeline_library_mutex;
+  std::map<PipelineLibraryKey, VkPipeline> m_pipeline_library_cache;
+
   // pipeline cache
   VkPipelineCache m_pipeline_cache = VK_NULL_HANDLE;
   std::string m_pipeline_cache_filename;
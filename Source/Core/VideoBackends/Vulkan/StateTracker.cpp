@@ -3,6 +3,10 @@
 
 #include "VideoBackends/Vulkan/StateTracker.h"
 
+#include <algorithm>
+
+#include <xxhash.h>
+
 #include "Common/Assert.h"
 
 #include "VideoBackends/Vulkan/CommandBufferManager.h"
@@ -14,11 +18,32 @@
 #include "VideoBackends/Vulkan/VKVertexFormat.h"
 #include "VideoBackends/Vulkan/VulkanContext.h"
 #include "VideoCommon/Constants.h"
+#include "VideoCommon/Statistics.h"
 
 namespace Vulkan
 {
 static std::unique_ptr<StateTracker> s_state_tracker;
 
+static bool IsSameImageInfo(const VkDescriptorImageInfo& lhs, const VkDescriptorImageInfo& rhs)
+{
+  return lhs.sampler == rhs.sampler && lhs.imageView == rhs.imageView &&
+         lhs.imageLayout == rhs.imageLayout;
+}
+
+// The padding of the bindings isn't initialized, so only the members are hashed.
+static u64 HashSamplers(
+    const std::array<VkDescriptorImageInfo, VideoCommon::MAX_PIXEL_SHADER_SAMPLERS>& samplers)
+{
+  std::array<u64, VideoCommon::MAX_PIXEL_SHADER_SAMPLERS * 3> values;
+  for (size_t i = 0; i < samplers.size(); i++)
+  {
+    values[i * 3] = reinterpret_cast<u64>(samplers[i].sampler);
+    values[i * 3 + 1] = reinterpret_cast<u64>(samplers[i].imageView);
+    values[i * 3 + 2] = samplers[i].imageLayout;
+  }
+  return XXH3_64bits(values.data(), sizeof(values));
+}
+
 StateTracker::StateTracker() = default;
 
 StateTracker::~StateTracker() = default;
@@ -92,6 +117,8 @@ bool StateTracker::Initialize()
     m_bindings.image_textures[i].sampler = g_object_cache->GetPointSampler();
   }
 
+  m_use_push_descriptors = g_vulkan_context->SupportsPushDescriptors();
+
   // Default dirty flags include all descriptors
   InvalidateCachedState();
   return true;
@@ -146,7 +173,12 @@ void StateTracker::SetPipeline(const VKPipeline* pipeline)
   m_pipeline = pipeline;
   m_dirty_flags |= DIRTY_FLAG_PIPELINE;
   if (new_usage)
+  {
     m_dirty_flags |= DIRTY_FLAG_DESCRIPTOR_SETS;
+    // Pushed descriptors don't live in a set, so they have to be pushed again.
+    if (m_use_push_descriptors)
+      m_dirty_flags |= DIRTY_FLAG_GX_SAMPLERS | DIRTY_FLAG_UTILITY_BINDINGS;
+  }
 }
 
 void StateTracker::SetComputeShader(const VKShader* shader)
@@ -248,6 +280,13 @@ void StateTracker::SetImageTexture(u32 index, VkImageView view)
 
 void StateTracker::UnbindTexture(VkImageView view)
 {
+  // The view may be destroyed, and its handle reused by a different view.
+  std::erase_if(m_cached_gx_sampler_sets, [view](const auto& it) {
+    return std::ranges::any_of(it.second.samplers, [view](const VkDescriptorImageInfo& info) {
+      return info.imageView == view;
+    });
+  });
+
   for (VkDescriptorImageInfo& it : m_bindings.samplers)
   {
     if (it.imageView == view)
@@ -517,22 +556,64 @@ void StateTracker::UpdateGXDescriptorSet()
     m_dirty_flags = (m_dirty_flags & ~DIRTY_FLAG_GX_UBOS) | DIRTY_FLAG_DESCRIPTOR_SETS;
   }
 
-  if (m_dirty_flags & DIRTY_FLAG_GX_SAMPLERS || m_gx_descriptor_sets[1] == VK_NULL_HANDLE)
+  if (m_use_push_descriptors)
   {
-    m_gx_descriptor_sets[1] = g_command_buffer_mgr->AllocateDescriptorSet(
-        g_object_cache->GetDescriptorSetLayout(DESCRIPTOR_SET_LAYOUT_STANDARD_SAMPLERS));
+    if (m_dirty_flags & DIRTY_FLAG_GX_SAMPLERS)
+    {
+      const VkWriteDescriptorSet write = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                                          nullptr,
+                                          VK_NULL_HANDLE,
+                                          0,
+                                          0,
+                                          static_cast<u32>(VideoCommon::MAX_PIXEL_SHADER_SAMPLERS),
+                                          VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                                          m_bindings.samplers.data(),
+                                          nullptr,
+                                          nullptr};
+      vkCmdPushDescriptorSetKHR(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+                                VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetVkPipelineLayout(),
+                                1, 1, &write);
+      INCSTAT(g_stats.this_frame.num_descriptor_pushes);
+      m_dirty_flags &= ~DIRTY_FLAG_GX_SAMPLERS;
+    }
+  }
+  else if (m_dirty_flags & DIRTY_FLAG_GX_SAMPLERS || m_gx_descriptor_sets[1] == VK_NULL_HANDLE)
+  {
+    const u64 hash = HashSamplers(m_bindings.samplers);
+    if (const VkDescriptorSet cached_set = FindCachedGXSamplerSet(hash))
+    {
+      if (cached_set != m_gx_descriptor_sets[1])
+      {
+        m_gx_descriptor_sets[1] = cached_set;
+        m_dirty_flags |= DIRTY_FLAG_DESCRIPTOR_SETS;
+      }
+      m_dirty_flags &= ~DIRTY_FLAG_GX_SAMPLERS;
+    }
+    else
+    {
+      m_gx_descriptor_sets[1] = g_command_buffer_mgr->AllocateDescriptorSet(
+          g_object_cache->GetDescriptorSetLayout(DESCRIPTOR_SET_LAYOUT_STANDARD_SAMPLERS));
 
-    writes[num_writes++] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-                            nullptr,
-                            m_gx_descriptor_sets[1],
-                            0,
-                            0,
-                            static_cast<u32>(VideoCommon::MAX_PIXEL_SHADER_SAMPLERS),
-                            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                            m_bindings.samplers.data(),
-                            nullptr,
-                            nullptr};
-    m_dirty_flags = (m_dirty_flags & ~DIRTY_FLAG_GX_SAMPLERS) | DIRTY_FLAG_DESCRIPTOR_SETS;
+      writes[num_writes++] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                              nullptr,
+                              m_gx_descriptor_sets[1],
+                              0,
+                              0,
+                              static_cast<u32>(VideoCommon::MAX_PIXEL_SHADER_SAMPLERS),
+                              VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                              m_bindings.samplers.data(),
+                              nullptr,
+                              nullptr};
+      m_dirty_flags = (m_dirty_flags & ~DIRTY_FLAG_GX_SAMPLERS) | DIRTY_FLAG_DESCRIPTOR_SETS;
+
+      if (m_gx_descriptor_sets[1] != VK_NULL_HANDLE)
+      {
+        if (m_cached_gx_sampler_sets.size() >= MAX_CACHED_SAMPLER_SETS)
+          m_cached_gx_sampler_sets.clear();
+        m_cached_gx_sampler_sets.insert_or_assign(
+            hash, CachedSamplerSet{m_bindings.samplers, m_gx_descriptor_sets[1]});
+      }
+    }
   }
 
   const bool needs_bbox_ssbo = g_ActiveConfig.backend_info.bSupportsBBox;
@@ -571,9 +652,28 @@ void StateTracker::UpdateGXDescriptorSet()
   }
 
   if (num_writes > 0)
+  {
     vkUpdateDescriptorSets(g_vulkan_context->GetDevice(), num_writes, writes.data(), 0, nullptr);
+    ADDSTAT(g_stats.this_frame.num_descriptor_writes, num_writes);
+  }
 
-  if (m_dirty_flags & DIRTY_FLAG_DESCRIPTOR_SETS)
+  if (m_use_push_descriptors && (m_dirty_flags & DIRTY_FLAG_DESCRIPTOR_SETS))
+  {
+    // Set 1 is pushed, so sets 0 and 2 have to be bound separately.
+    vkCmdBindDescriptorSets(
+        g_command_buffer_mgr->GetCurrentCommandBuffer(), VK_PIPELINE_BIND_POINT_GRAPHICS,
+        m_pipeline->GetVkPipelineLayout(), 0, 1, m_gx_descriptor_sets.data(),
+        needs_gs_ubo ? NUM_UBO_DESCRIPTOR_SET_BINDINGS : (NUM_UBO_DESCRIPTOR_SET_BINDINGS - 1),
+        m_bindings.gx_ubo_offsets.data());
+    if (needs_ssbo)
+    {
+      vkCmdBindDescriptorSets(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+                              VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetVkPipelineLayout(),
+                              2, 1, &m_gx_descriptor_sets[2], 0, nullptr);
+    }
+    m_dirty_flags &= ~(DIRTY_FLAG_DESCRIPTOR_SETS | DIRTY_FLAG_GX_UBO_OFFSETS);
+  }
+  else if (m_dirty_flags & DIRTY_FLAG_DESCRIPTOR_SETS)
   {
     vkCmdBindDescriptorSets(g_command_buffer_mgr->GetCurrentCommandBuffer(),
                             VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetVkPipelineLayout(), 0,
@@ -595,6 +695,26 @@ void StateTracker::UpdateGXDescriptorSet()
   }
 }
 
+VkDescriptorSet StateTracker::FindCachedGXSamplerSet(u64 hash)
+{
+  const u64 generation = g_command_buffer_mgr->GetDescriptorPoolGeneration();
+  if (m_cached_sampler_sets_generation != generation)
+  {
+    m_cached_gx_sampler_sets.clear();
+    m_cached_sampler_sets_generation = generation;
+    return VK_NULL_HANDLE;
+  }
+
+  const auto it = m_cached_gx_sampler_sets.find(hash);
+  if (it == m_cached_gx_sampler_sets.end() ||
+      !std::ranges::equal(it->second.samplers, m_bindings.samplers, IsSameImageInfo))
+  {
+    return VK_NULL_HANDLE;
+  }
+
+  return it->second.set;
+}
+
 void StateTracker::UpdateUtilityDescriptorSet()
 {
   // Max number of updates - UBO, Samplers, TexelBuffer
@@ -621,7 +741,27 @@ void StateTracker::UpdateUtilityDescriptorSet()
     m_dirty_flags = (m_dirty_flags & ~DIRTY_FLAG_UTILITY_UBO) | DIRTY_FLAG_DESCRIPTOR_SETS;
   }
 
-  if (m_dirty_flags & DIRTY_FLAG_UTILITY_BINDINGS || m_utility_descriptor_sets[1] == VK_NULL_HANDLE)
+  if (m_use_push_descriptors)
+  {
+    if (m_dirty_flags & DIRTY_FLAG_UTILITY_BINDINGS)
+    {
+      const std::array<VkWriteDescriptorSet, 2> push_writes = {{
+          {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, VK_NULL_HANDLE, 0, 0,
+           NUM_UTILITY_PIXEL_SAMPLERS, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+           m_bindings.samplers.data(), nullptr, nullptr},
+          {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, VK_NULL_HANDLE, 8, 0, 1,
+           VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER, nullptr, nullptr,
+           m_bindings.texel_buffers.data()},
+      }};
+      vkCmdPushDescriptorSetKHR(g_command_buffer_mgr->GetCurrentCommandBuffer(),
+                                VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetVkPipelineLayout(),
+                                1, static_cast<u32>(push_writes.size()), push_writes.data());
+      INCSTAT(g_stats.this_frame.num_descriptor_pushes);
+      m_dirty_flags &= ~DIRTY_FLAG_UTILITY_BINDINGS;
+    }
+  }
+  else if (m_dirty_flags & DIRTY_FLAG_UTILITY_BINDINGS ||
+           m_utility_descriptor_sets[1] == VK_NULL_HANDLE)
   {
     m_utility_descriptor_sets[1] = g_command_buffer_mgr->AllocateDescriptorSet(
         g_object_cache->GetDescriptorSetLayout(DESCRIPTOR_SET_LAYOUT_UTILITY_SAMPLERS));
@@ -651,14 +791,18 @@ void StateTracker::UpdateUtilityDescriptorSet()
   }
 
   if (writes > 0)
+  {
     vkUpdateDescriptorSets(g_vulkan_context->GetDevice(), writes, dswrites.data(), 0, nullptr);
+    ADDSTAT(g_stats.this_frame.num_descriptor_writes, writes);
+  }
 
   if (m_dirty_flags & DIRTY_FLAG_DESCRIPTOR_SETS)
   {
+    // With push descriptors, only the uniform buffer set is bound.
     vkCmdBindDescriptorSets(g_command_buffer_mgr->GetCurrentCommandBuffer(),
                             VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipeline->GetVkPipelineLayout(), 0,
-                            NUM_UTILITY_DESCRIPTOR_SETS, m_utility_descriptor_sets.data(), 1,
-                            &m_bindings.utility_ubo_offset);
+                            m_use_push_descriptors ? 1 : NUM_UTILITY_DESCRIPTOR_SETS,
+                            m_utility_descriptor_sets.data(), 1, &m_bindings.utility_ubo_offset);
     m_dirty_flags &= ~(DIRTY_FLAG_DESCRIPTOR_SETS | DIRTY_FLAG_UTILITY_UBO_OFFSET);
   }
   else if (m_dirty_flags & DIRTY_FLAG_UTILITY_UBO_OFFSET)
@@ -723,6 +867,7 @@ void StateTracker::UpdateComputeDescriptorSet()
 
     vkUpdateDescriptorSets(g_vulkan_context->GetDevice(), static_cast<uint32_t>(dswrites.size()),
                            dswrites.data(), 0, nullptr);
+    ADDSTAT(g_stats.this_frame.num_descriptor_writes, dswrites.size());
     m_dirty_flags =
         (m_dirty_flags & ~DIRTY_FLAG_COMPUTE_BINDINGS) | DIRTY_FLAG_COMPUTE_DESCRIPTOR_SET;
   }
@@ -6,6 +6,7 @@
 #include <array>
 #include <cstddef>
 #include <memory>
+#include <unordered_map>
 
 #include "Common/CommonTypes.h"
 #include "VideoBackends/Vulkan/Constants.h"
@@ -118,12 +119,18 @@ private:
 
   void UpdateDescriptorSet();
   void UpdateGXDescriptorSet();
+  // Returns a GX sampler set written with the current samplers during this frame, if any.
+  VkDescriptorSet FindCachedGXSamplerSet(u64 hash);
   void UpdateUtilityDescriptorSet();
   void UpdateComputeDescriptorSet();
 
   // Which bindings/state has to be updated before the next draw.
   u32 m_dirty_flags = 0;
 
+  // Sampler sets (set 1 of the GX and utility layouts) are pushed with vkCmdPushDescriptorSetKHR
+  // instead of being allocated and written for every texture change.
+  bool m_use_push_descriptors = false;
+
   // input assembly
   VkBuffer m_vertex_buffer = VK_NULL_HANDLE;
   VkDeviceSize m_vertex_buffer_offset = 0;
@@ -149,6 +156,18 @@ private:
     std::array<VkDescriptorImageInfo, VideoCommon::MAX_COMPUTE_SHADER_SAMPLERS> image_textures;
   } m_bindings = {};
   std::array<VkDescriptorSet, NUM_GX_DESCRIPTOR_SETS> m_gx_descriptor_sets = {};
+
+  // Without push descriptors, GX sampler sets are kept until the descriptor pools of the frame
+  // are reset, so that going back to textures that were already bound in this frame, or binding
+  // the same textures in the next command buffer, doesn't allocate and write a new set.
+  struct CachedSamplerSet
+  {
+    std::array<VkDescriptorImageInfo, VideoCommon::MAX_PIXEL_SHADER_SAMPLERS> samplers;
+    VkDescriptorSet set;
+  };
+  static constexpr size_t MAX_CACHED_SAMPLER_SETS = 256;
+  std::unordered_map<u64, CachedSamplerSet> m_cached_gx_sampler_sets;
+  u64 m_cached_sampler_sets_generation = 0;
   std::array<VkDescriptorSet, NUM_UTILITY_DESCRIPTOR_SETS> m_utility_descriptor_sets = {};
   VkDescriptorSet m_compute_descriptor_set = VK_NULL_HANDLE;
 
@@ -38,6 +38,41 @@ bool VKBoundingBox::Initialize()
 }
 
 std::vector<BBoxType> VKBoundingBox::Read(u32 index, u32 length)
+{
+  CopyToReadbackBuffer();
+
+  // Wait until these commands complete.
+  VKGfx::GetInstance()->ExecuteCommandBuffer(false, true);
+
+  return ReadFromReadbackBuffer(index, length);
+}
+
+bool VKBoundingBox::StartAsyncRead()
+{
+  CopyToReadbackBuffer();
+  m_async_read_fence_counter = g_command_buffer_mgr->GetCurrentFenceCounter();
+  return true;
+}
+
+std::optional<std::vector<BBoxType>> VKBoundingBox::FinishAsyncRead(bool wait)
+{
+  if (m_async_read_fence_counter == g_command_buffer_mgr->GetCurrentFenceCounter())
+  {
+    // The copy is still in the command buffer being recorded, so submit it.
+    VKGfx::GetInstance()->ExecuteCommandBuffer(!wait, wait);
+  }
+  else if (wait)
+  {
+    g_command_buffer_mgr->WaitForFenceCounter(m_async_read_fence_counter);
+  }
+
+  if (!g_command_buffer_mgr->CheckFenceCounter(m_async_read_fence_counter))
+    return std::nullopt;
+
+  return ReadFromReadbackBuffer(0, NUM_BBOX_VALUES);
+}
+
+void VKBoundingBox::CopyToReadbackBuffer()
 {
   // Can't be done within a render pass.
   StateTracker::GetInstance()->EndRenderPass();
@@ -63,10 +98,10 @@ std::vector<BBoxType> VKBoundingBox::Read(u32 index, u32 length)
       VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
   m_readback_buffer->FlushGPUCache(g_command_buffer_mgr->GetCurrentCommandBuffer(),
                                    VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+}
 
-  // Wait until these commands complete.
-  VKGfx::GetInstance()->ExecuteCommandBuffer(false, true);
-
+std::vector<BBoxType> VKBoundingBox::ReadFromReadbackBuffer(u32 index, u32 length)
+{
   // Cache is now valid.
   m_readback_buffer->InvalidateCPUCache();
 
@@ -5,7 +5,9 @@
 
 #include <array>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "VideoBackends/Vulkan/StagingBuffer.h"
@@ -28,16 +30,23 @@ protected:
   std::vector<BBoxType> Read(u32 index, u32 length) override;
   void Write(u32 index, std::span<const BBoxType> values) override;
 
+  bool StartAsyncRead() override;
+  std::optional<std::vector<BBoxType>> FinishAsyncRead(bool wait) override;
+
 private:
   bool CreateGPUBuffer();
   bool CreateReadbackBuffer();
 
+  void CopyToReadbackBuffer();
+  std::vector<BBoxType> ReadFromReadbackBuffer(u32 index, u32 length);
+
   VkBuffer m_gpu_buffer = VK_NULL_HANDLE;
   VmaAllocation m_gpu_allocation = VK_NULL_HANDLE;
 
   static constexpr size_t BUFFER_SIZE = sizeof(BBoxType) * NUM_BBOX_VALUES;
 
   std::unique_ptr<StagingBuffer> m_readback_buffer;
+  u64 m_async_read_fence_counter = 0;
 };
 
 }  // namespace Vulkan
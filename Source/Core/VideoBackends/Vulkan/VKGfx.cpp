@@ -319,6 +319,16 @@ void VKGfx::PresentBackbuffer()
   StateTracker::GetInstance()->InvalidateCachedState();
 }
 
+bool VKGfx::WaitForPresentCompletion()
+{
+  if (!m_swap_chain)
+    return false;
+
+  // Don't hang forever if the window is hidden and frames are never shown.
+  constexpr u64 TIMEOUT_NS = 100'000'000;
+  return g_command_buffer_mgr->WaitForLastPresent(m_swap_chain->GetSwapChain(), TIMEOUT_NS);
+}
+
 void VKGfx::SetFullscreen(bool enable_fullscreen)
 {
   if (!m_swap_chain->IsFullscreenSupported())
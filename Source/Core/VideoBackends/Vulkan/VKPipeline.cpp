@@ -3,6 +3,7 @@
 
 #include "VideoBackends/Vulkan/VKPipeline.h"
 
+#include <algorithm>
 #include <array>
 
 #include "Common/Assert.h"
@@ -240,6 +241,126 @@ GetVulkanColorBlendState(const BlendingState& state,
   return vk_state;
 }
 
+static VkPipeline GetPipelineLibrary(const ObjectCache::PipelineLibraryKey& key,
+                                     VkGraphicsPipelineLibraryFlagsEXT part,
+                                     VkGraphicsPipelineCreateInfo info)
+{
+  VkPipeline library = g_object_cache->FindPipelineLibrary(key);
+  if (library != VK_NULL_HANDLE)
+    return library;
+
+  VkGraphicsPipelineLibraryCreateInfoEXT library_info = {
+      VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT, nullptr, part};
+  info.pNext = &library_info;
+  info.flags |= VK_PIPELINE_CREATE_LIBRARY_BIT_KHR;
+
+  VkResult res =
+      vkCreateGraphicsPipelines(g_vulkan_context->GetDevice(), g_object_cache->GetPipelineCache(),
+                                1, &info, nullptr, &library);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkCreateGraphicsPipelines failed for pipeline library: ");
+    return VK_NULL_HANDLE;
+  }
+
+  return g_object_cache->InsertPipelineLibrary(key, library);
+}
+
+// Builds the pipeline out of four libraries: vertex input, pre-rasterization (vertex and geometry
+// shaders), fragment shader and fragment output. Each of them only depends on part of the config
+// and is cached, so a new combination of shaders and state usually only needs one or two new
+// libraries and a link, which drivers advertising fast linking can do in well under a millisecond.
+static VkPipeline LinkPipelineFromLibraries(const AbstractPipelineConfig& config,
+                                            const VkGraphicsPipelineCreateInfo& full_info)
+{
+  const u64 vs_id = static_cast<const VKShader*>(config.vertex_shader)->GetId();
+  const u64 gs_id =
+      config.geometry_shader ? static_cast<const VKShader*>(config.geometry_shader)->GetId() : 0;
+  const u64 ps_id = static_cast<const VKShader*>(config.pixel_shader)->GetId();
+  const auto* vertex_format = static_cast<const VertexFormat*>(config.vertex_format);
+
+  // The shader stages are laid out as vertex, geometry (optional), fragment.
+  const u32 num_pre_raster_stages = full_info.stageCount - 1;
+  const VkPipelineShaderStageCreateInfo* fragment_stage =
+      &full_info.pStages[num_pre_raster_stages];
+
+  VkGraphicsPipelineCreateInfo vertex_input_info = {};
+  vertex_input_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+  vertex_input_info.pVertexInputState = full_info.pVertexInputState;
+  vertex_input_info.pInputAssemblyState = full_info.pInputAssemblyState;
+
+  VkGraphicsPipelineCreateInfo pre_raster_info = {};
+  pre_raster_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+  pre_raster_info.stageCount = num_pre_raster_stages;
+  pre_raster_info.pStages = full_info.pStages;
+  pre_raster_info.pViewportState = full_info.pViewportState;
+  pre_raster_info.pRasterizationState = full_info.pRasterizationState;
+  pre_raster_info.pDynamicState = full_info.pDynamicState;
+  pre_raster_info.layout = full_info.layout;
+  pre_raster_info.renderPass = full_info.renderPass;
+
+  VkGraphicsPipelineCreateInfo fragment_shader_info = {};
+  fragment_shader_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+  fragment_shader_info.stageCount = 1;
+  fragment_shader_info.pStages = fragment_stage;
+  fragment_shader_info.pMultisampleState = full_info.pMultisampleState;
+  fragment_shader_info.pDepthStencilState = full_info.pDepthStencilState;
+  fragment_shader_info.layout = full_info.layout;
+  fragment_shader_info.renderPass = full_info.renderPass;
+
+  VkGraphicsPipelineCreateInfo fragment_output_info = {};
+  fragment_output_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+  fragment_output_info.pMultisampleState = full_info.pMultisampleState;
+  fragment_output_info.pColorBlendState = full_info.pColorBlendState;
+  fragment_output_info.renderPass = full_info.renderPass;
+
+  const u32 primitive = static_cast<u32>(config.rasterization_state.primitive.Value());
+  const std::array<VkPipeline, 4> libraries = {
+      GetPipelineLibrary({VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT, 0, 0,
+                          vertex_format, primitive, 0, VK_NULL_HANDLE, VK_NULL_HANDLE},
+                         VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT,
+                         vertex_input_info),
+      GetPipelineLibrary({VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT, vs_id,
+                          gs_id, nullptr, config.rasterization_state.hex, 0, full_info.layout,
+                          full_info.renderPass},
+                         VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT,
+                         pre_raster_info),
+      GetPipelineLibrary({VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT, ps_id, 0, nullptr,
+                          config.depth_state.hex, config.framebuffer_state.hex, full_info.layout,
+                          full_info.renderPass},
+                         VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT,
+                         fragment_shader_info),
+      GetPipelineLibrary({VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT, 0, 0,
+                          nullptr, config.blending_state.hex, config.framebuffer_state.hex,
+                          VK_NULL_HANDLE, full_info.renderPass},
+                         VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT,
+                         fragment_output_info),
+  };
+  if (std::find(libraries.begin(), libraries.end(), VK_NULL_HANDLE) != libraries.end())
+    return VK_NULL_HANDLE;
+
+  VkPipelineLibraryCreateInfoKHR link_library_info = {
+      VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR, nullptr,
+      static_cast<u32>(libraries.size()), libraries.data()};
+  VkGraphicsPipelineCreateInfo link_info = {};
+  link_info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+  link_info.pNext = &link_library_info;
+  link_info.layout = full_info.layout;
+  link_info.renderPass = full_info.renderPass;
+
+  VkPipeline pipeline;
+  VkResult res =
+      vkCreateGraphicsPipelines(g_vulkan_context->GetDevice(), g_object_cache->GetPipelineCache(),
+                                1, &link_info, nullptr, &pipeline);
+  if (res != VK_SUCCESS)
+  {
+    LOG_VULKAN_ERROR(res, "vkCreateGraphicsPipelines failed to link pipeline libraries: ");
+    return VK_NULL_HANDLE;
+  }
+
+  return pipeline;
+}
+
 std::unique_ptr<VKPipeline> VKPipeline::Create(const AbstractPipelineConfig& config)
 {
   DEBUG_ASSERT(config.vertex_shader && config.pixel_shader);
@@ -417,13 +538,22 @@ std::unique_ptr<VKPipeline> VKPipeline::Create(const AbstractPipelineConfig& con
   };
 
   VkPipeline pipeline;
-  VkResult res =
-      vkCreateGraphicsPipelines(g_vulkan_context->GetDevice(), g_object_cache->GetPipelineCache(),
-                                1, &pipeline_info, nullptr, &pipeline);
-  if (res != VK_SUCCESS)
+  if (g_vulkan_context->SupportsGraphicsPipelineLibrary())
   {
-    LOG_VULKAN_ERROR(res, "vkCreateGraphicsPipelines failed: ");
-    return VK_NULL_HANDLE;
+    pipeline = LinkPipelineFromLibraries(config, pipeline_info);
+    if (pipeline == VK_NULL_HANDLE)
+      return nullptr;
+  }
+  else
+  {
+    VkResult res =
+        vkCreateGraphicsPipelines(g_vulkan_context->GetDevice(), g_object_cache->GetPipelineCache(),
+                                  1, &pipeline_info, nullptr, &pipeline);
+    if (res != VK_SUCCESS)
+    {
+      LOG_VULKAN_ERROR(res, "vkCreateGraphicsPipelines failed: ");
+      return nullptr;
+    }
   }
 
   return std::make_unique<VKPipeline>(config, pipeline, pipeline_layout, config.usage);
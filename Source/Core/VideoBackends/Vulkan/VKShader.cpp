@@ -3,6 +3,8 @@
 
 #include "VideoBackends/Vulkan/VKShader.h"
 
+#include <atomic>
+
 #include "Common/Align.h"
 #include "Common/Assert.h"
 
@@ -14,10 +16,12 @@
 
 namespace Vulkan
 {
+static std::atomic<u64> s_next_shader_id = 1;
+
 VKShader::VKShader(ShaderStage stage, std::vector<u32> spv, VkShaderModule mod,
                    std::string_view name)
     : AbstractShader(stage), m_spv(std::move(spv)), m_module(mod),
-      m_compute_pipeline(VK_NULL_HANDLE), m_name(name)
+      m_compute_pipeline(VK_NULL_HANDLE), m_name(name), m_id(s_next_shader_id++)
 {
   if (!m_name.empty() && g_ActiveConfig.backend_info.bSupportsSettingObjectNames)
   {
@@ -32,7 +36,7 @@ VKShader::VKShader(ShaderStage stage, std::vector<u32> spv, VkShaderModule mod,
 
 VKShader::VKShader(std::vector<u32> spv, VkPipeline compute_pipeline, std::string_view name)
     : AbstractShader(ShaderStage::Compute), m_spv(std::move(spv)), m_module(VK_NULL_HANDLE),
-      m_compute_pipeline(compute_pipeline), m_name(name)
+      m_compute_pipeline(compute_pipeline), m_name(name), m_id(s_next_shader_id++)
 {
   if (!m_name.empty() && g_ActiveConfig.backend_info.bSupportsSettingObjectNames)
   {
@@ -48,7 +52,11 @@ VKShader::VKShader(std::vector<u32> spv, VkPipeline compute_pipeline, std::strin
 VKShader::~VKShader()
 {
   if (m_stage != ShaderStage::Compute)
+  {
     vkDestroyShaderModule(g_vulkan_context->GetDevice(), m_module, nullptr);
+    if (g_object_cache)
+      g_object_cache->DestroyPipelineLibraries(m_id);
+  }
   else
     vkDestroyPipeline(g_vulkan_context->GetDevice(), m_compute_pipeline, nullptr);
 }
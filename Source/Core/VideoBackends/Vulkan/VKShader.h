@@ -24,6 +24,8 @@ public:
 
   VkShaderModule GetShaderModule() const { return m_module; }
   VkPipeline GetComputePipeline() const { return m_compute_pipeline; }
+  // Unique for the lifetime of the process, unlike the shader module handle.
+  u64 GetId() const { return m_id; }
   BinaryData GetBinary() const override;
 
   static std::unique_ptr<VKShader> CreateFromSource(ShaderStage stage, std::string_view source,
@@ -36,6 +38,7 @@ private:
   VkShaderModule m_module;
   VkPipeline m_compute_pipeline;
   std::string m_name;
+  u64 m_id;
 };
 
 }  // namespace Vulkan
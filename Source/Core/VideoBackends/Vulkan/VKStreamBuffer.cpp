@@ -9,6 +9,7 @@
 
 #include "Common/Align.h"
 #include "Common/Assert.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 
 #include "VideoBackends/Vulkan/CommandBufferManager.h"
@@ -22,6 +23,14 @@ StreamBuffer::StreamBuffer(VkBufferUsageFlags usage, u32 size) : m_usage(usage),
 
 StreamBuffer::~StreamBuffer()
 {
+  if (m_gpu_wait_count != 0 || m_submit_stall_count != 0)
+  {
+    INFO_LOG_FMT(VIDEO,
+                 "Stream buffer with usage {:#x} and size {} KiB waited for the GPU {} times and "
+                 "for command buffer execution {} times",
+                 m_usage, m_size / 1024, m_gpu_wait_count, m_submit_stall_count);
+  }
+
   // VMA_ALLOCATION_CREATE_MAPPED_BIT automatically handles unmapping for us
   if (m_buffer != VK_NULL_HANDLE)
     g_command_buffer_mgr->DeferBufferDestruction(m_buffer, m_alloc);
@@ -50,12 +59,18 @@ bool StreamBuffer::AllocateBuffer()
       nullptr                                // const uint32_t*        pQueueFamilyIndices
   };
 
+  // Host visible VRAM is slower in practice when it is only the small BAR window, so it is only
+  // preferred with resizable BAR or on integrated GPUs. Upload buffers are only read once by the
+  // GPU, so they stay in system memory.
+  const bool prefer_vram = g_vulkan_context->PrefersHostVisibleVRAM() &&
+                           (m_usage & VK_BUFFER_USAGE_TRANSFER_SRC_BIT) == 0;
+
   VmaAllocationCreateInfo alloc_create_info = {};
   alloc_create_info.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
                             VMA_ALLOCATION_CREATE_WITHIN_BUDGET_BIT |
                             VMA_ALLOCATION_CREATE_MAPPED_BIT;
   alloc_create_info.usage =
-      VMA_MEMORY_USAGE_AUTO_PREFER_HOST;  // Host visible VRAM is slower in practice
+      prefer_vram ? VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE : VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
   alloc_create_info.pool = VK_NULL_HANDLE;
   alloc_create_info.pUserData = nullptr;
   alloc_create_info.priority = 0.0;
@@ -67,12 +82,23 @@ bool StreamBuffer::AllocateBuffer()
   VmaAllocationInfo alloc_info;
   VkResult res = vmaCreateBuffer(g_vulkan_context->GetMemoryAllocator(), &buffer_create_info,
                                  &alloc_create_info, &buffer, &alloc, &alloc_info);
+  if (res != VK_SUCCESS && prefer_vram)
+  {
+    WARN_LOG_FMT(VIDEO, "Stream buffer with usage {:#x} doesn't fit in VRAM, using system memory",
+                 m_usage);
+    alloc_create_info.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+    res = vmaCreateBuffer(g_vulkan_context->GetMemoryAllocator(), &buffer_create_info,
+                          &alloc_create_info, &buffer, &alloc, &alloc_info);
+  }
   if (res != VK_SUCCESS)
   {
     LOG_VULKAN_ERROR(res, "vmaCreateBuffer failed: ");
     return false;
   }
 
+  INFO_LOG_FMT(VIDEO, "Stream buffer with usage {:#x} and size {} KiB uses memory type {}",
+               m_usage, m_size / 1024, alloc_info.memoryType);
+
   // Destroy the backings for the buffer after the command buffer executes
   // VMA_ALLOCATION_CREATE_MAPPED_BIT automatically handles unmapping for us
   if (m_buffer != VK_NULL_HANDLE)
@@ -152,6 +178,7 @@ bool StreamBuffer::ReserveMemory(u32 num_bytes, u32 alignment)
   // We tried everything we could, and still couldn't get anything. This means that too much space
   // in the buffer is being used by the command buffer currently being recorded. Therefore, the
   // only option is to execute it, and wait until it's done.
+  m_submit_stall_count++;
   return false;
 }
 
@@ -273,7 +300,11 @@ bool StreamBuffer::WaitForClearSpace(u32 num_bytes)
   }
 
   // Wait until this fence is signaled. This will fire the callback, updating the GPU position.
-  g_command_buffer_mgr->WaitForFenceCounter(iter->first);
+  if (!g_command_buffer_mgr->CheckFenceCounter(iter->first))
+  {
+    m_gpu_wait_count++;
+    g_command_buffer_mgr->WaitForFenceCounter(iter->first);
+  }
   m_tracked_fences.erase(m_tracked_fences.begin(),
                          m_current_offset == iter->second ? m_tracked_fences.end() : ++iter);
   m_current_offset = new_offset;
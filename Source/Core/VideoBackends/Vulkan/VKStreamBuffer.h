@@ -29,6 +29,13 @@ public:
 
   static std::unique_ptr<StreamBuffer> Create(VkBufferUsageFlags usage, u32 size);
 
+  // Stall counters, logged when the buffer is destroyed to help tune the buffer sizes.
+  // GPU waits are allocations that had to wait for a command buffer to complete, submit stalls
+  // are allocations that failed because the command buffer being recorded had to be executed
+  // first.
+  u64 GetGPUWaitCount() const { return m_gpu_wait_count; }
+  u64 GetSubmitStallCount() const { return m_submit_stall_count; }
+
 private:
   bool AllocateBuffer();
   void UpdateCurrentFencePosition();
@@ -49,6 +56,9 @@ private:
 
   // List of fences and the corresponding positions in the buffer
   std::deque<std::pair<u64, u32>> m_tracked_fences;
+
+  u64 m_gpu_wait_count = 0;
+  u64 m_submit_stall_count = 0;
 };
 
 }  // namespace Vulkan
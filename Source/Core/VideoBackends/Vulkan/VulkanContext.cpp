@@ -13,6 +13,7 @@
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 
+#include "VideoCommon/Constants.h"
 #include "VideoCommon/DriverDetails.h"
 #include "VideoCommon/VideoCommon.h"
 
@@ -587,6 +588,10 @@ bool VulkanContext::SelectDeviceExtensions(bool enable_surface)
   if (enable_surface && !AddExtension(VK_KHR_SWAPCHAIN_EXTENSION_NAME, true))
     return false;
 
+  // VK_KHR_present_wait depends on VK_KHR_present_id, used for low latency presentation.
+  if (enable_surface && AddExtension(VK_KHR_PRESENT_ID_EXTENSION_NAME, false))
+    AddExtension(VK_KHR_PRESENT_WAIT_EXTENSION_NAME, false);
+
 #ifdef SUPPORTS_VULKAN_EXCLUSIVE_FULLSCREEN
   // VK_EXT_full_screen_exclusive
   if (AddExtension(VK_EXT_FULL_SCREEN_EXCLUSIVE_EXTENSION_NAME, true))
@@ -596,6 +601,12 @@ bool VulkanContext::SelectDeviceExtensions(bool enable_surface)
   AddExtension(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME, false);
   AddExtension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME, false);
 
+  // VK_EXT_graphics_pipeline_library depends on VK_KHR_pipeline_library.
+  if (AddExtension(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME, false))
+    AddExtension(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME, false);
+  AddExtension(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME, false);
+  AddExtension(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME, false);
+
   return true;
 }
 
@@ -633,9 +644,130 @@ bool VulkanContext::SelectDeviceFeatures()
   m_device_features.shaderClipDistance = available_features.shaderClipDistance;
   m_device_features.depthClamp = available_features.depthClamp;
   m_device_features.textureCompressionBC = available_features.textureCompressionBC;
+
+  // Linking pipelines from libraries is only worth it if the driver can do it quickly.
+  m_supports_graphics_pipeline_library = false;
+  const bool has_vulkan_1_1 = VK_VERSION_MAJOR(properties.apiVersion) > 1 ||
+                             VK_VERSION_MINOR(properties.apiVersion) >= 1;
+  if (has_vulkan_1_1 && vkGetPhysicalDeviceFeatures2 && vkGetPhysicalDeviceProperties2 &&
+      SupportsDeviceExtension(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME))
+  {
+    VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT gpl_features = {};
+    gpl_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+    VkPhysicalDeviceFeatures2 features_2 = {};
+    features_2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features_2.pNext = &gpl_features;
+    vkGetPhysicalDeviceFeatures2(m_physical_device, &features_2);
+
+    VkPhysicalDeviceGraphicsPipelineLibraryPropertiesEXT gpl_properties = {};
+    gpl_properties.sType =
+        VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_PROPERTIES_EXT;
+    VkPhysicalDeviceProperties2 properties_2 = {};
+    properties_2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties_2.pNext = &gpl_properties;
+    vkGetPhysicalDeviceProperties2(m_physical_device, &properties_2);
+
+    m_supports_graphics_pipeline_library =
+        gpl_features.graphicsPipelineLibrary == VK_TRUE &&
+        gpl_properties.graphicsPipelineLibraryFastLinking == VK_TRUE;
+    if (m_supports_graphics_pipeline_library)
+      INFO_LOG_FMT(VIDEO, "Using VK_EXT_graphics_pipeline_library for pipeline creation.");
+  }
+
+  m_supports_push_descriptors = false;
+  if (has_vulkan_1_1 && vkGetPhysicalDeviceProperties2 &&
+      SupportsDeviceExtension(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME))
+  {
+    VkPhysicalDevicePushDescriptorPropertiesKHR push_properties = {};
+    push_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PUSH_DESCRIPTOR_PROPERTIES_KHR;
+    VkPhysicalDeviceProperties2 properties_2 = {};
+    properties_2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties_2.pNext = &push_properties;
+    vkGetPhysicalDeviceProperties2(m_physical_device, &properties_2);
+
+    m_supports_push_descriptors =
+        push_properties.maxPushDescriptors >= VideoCommon::MAX_PIXEL_SHADER_SAMPLERS;
+    if (m_supports_push_descriptors)
+      INFO_LOG_FMT(VIDEO, "Using VK_KHR_push_descriptor for sampler bindings.");
+  }
+
+  m_supports_present_wait = false;
+  if (has_vulkan_1_1 && vkGetPhysicalDeviceFeatures2 &&
+      SupportsDeviceExtension(VK_KHR_PRESENT_WAIT_EXTENSION_NAME))
+  {
+    VkPhysicalDevicePresentWaitFeaturesKHR present_wait_features = {};
+    present_wait_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+    VkPhysicalDevicePresentIdFeaturesKHR present_id_features = {};
+    present_id_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+    present_id_features.pNext = &present_wait_features;
+    VkPhysicalDeviceFeatures2 features_2 = {};
+    features_2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features_2.pNext = &present_id_features;
+    vkGetPhysicalDeviceFeatures2(m_physical_device, &features_2);
+
+    m_supports_present_wait = present_id_features.presentId == VK_TRUE &&
+                              present_wait_features.presentWait == VK_TRUE;
+    if (m_supports_present_wait)
+      INFO_LOG_FMT(VIDEO, "Using VK_KHR_present_wait for low latency presentation.");
+  }
+
+  m_supports_timeline_semaphores = false;
+  if (has_vulkan_1_1 && vkGetPhysicalDeviceFeatures2 &&
+      SupportsDeviceExtension(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME))
+  {
+    VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timeline_features = {};
+    timeline_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+    VkPhysicalDeviceFeatures2 features_2 = {};
+    features_2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features_2.pNext = &timeline_features;
+    vkGetPhysicalDeviceFeatures2(m_physical_device, &features_2);
+
+    m_supports_timeline_semaphores = timeline_features.timelineSemaphore == VK_TRUE;
+    if (m_supports_timeline_semaphores)
+      INFO_LOG_FMT(VIDEO, "Using VK_KHR_timeline_semaphore for command buffer tracking.");
+  }
+
+  SelectMemoryPreferences();
+
   return true;
 }
 
+void VulkanContext::SelectMemoryPreferences()
+{
+  // Without resizable BAR, only a 256 MiB window of VRAM is host visible.
+  constexpr VkDeviceSize BAR_WINDOW_SIZE = 256 * 1024 * 1024;
+
+  const VkPhysicalDeviceMemoryProperties& properties = m_device_memory_properties;
+  for (u32 i = 0; i < properties.memoryHeapCount; i++)
+  {
+    const VkMemoryHeap& heap = properties.memoryHeaps[i];
+    INFO_LOG_FMT(VIDEO, "Vulkan memory heap {}: {} MiB, flags {:#x}", i, heap.size / (1024 * 1024),
+                 heap.flags);
+  }
+
+  bool has_large_host_visible_vram = false;
+  for (u32 i = 0; i < properties.memoryTypeCount; i++)
+  {
+    const VkMemoryType& type = properties.memoryTypes[i];
+    INFO_LOG_FMT(VIDEO, "Vulkan memory type {}: heap {}, flags {:#x}", i, type.heapIndex,
+                 type.propertyFlags);
+
+    constexpr VkMemoryPropertyFlags host_visible_vram =
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+    if ((type.propertyFlags & host_visible_vram) == host_visible_vram &&
+        properties.memoryHeaps[type.heapIndex].size > BAR_WINDOW_SIZE)
+    {
+      has_large_host_visible_vram = true;
+    }
+  }
+
+  m_prefers_host_visible_vram =
+      has_large_host_visible_vram ||
+      m_device_properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU;
+  if (m_prefers_host_visible_vram)
+    INFO_LOG_FMT(VIDEO, "Using host visible VRAM for stream buffers.");
+}
+
 bool VulkanContext::CreateDevice(VkSurfaceKHR surface, bool enable_validation_layer)
 {
   u32 queue_family_count;
@@ -755,6 +887,34 @@ bool VulkanContext::CreateDevice(VkSurfaceKHR surface, bool enable_validation_la
 
   device_info.pEnabledFeatures = &m_device_features;
 
+  VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT gpl_features = {};
+  gpl_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+  gpl_features.graphicsPipelineLibrary = VK_TRUE;
+  if (m_supports_graphics_pipeline_library)
+    device_info.pNext = &gpl_features;
+
+  VkPhysicalDevicePresentWaitFeaturesKHR present_wait_features = {};
+  present_wait_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+  present_wait_features.presentWait = VK_TRUE;
+  VkPhysicalDevicePresentIdFeaturesKHR present_id_features = {};
+  present_id_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+  present_id_features.presentId = VK_TRUE;
+  if (m_supports_present_wait)
+  {
+    present_wait_features.pNext = const_cast<void*>(device_info.pNext);
+    present_id_features.pNext = &present_wait_features;
+    device_info.pNext = &present_id_features;
+  }
+
+  VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timeline_features = {};
+  timeline_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+  timeline_features.timelineSemaphore = VK_TRUE;
+  if (m_supports_timeline_semaphores)
+  {
+    timeline_features.pNext = const_cast<void*>(device_info.pNext);
+    device_info.pNext = &timeline_features;
+  }
+
   // Enable debug layer on debug builds
   if (enable_validation_layer)
   {
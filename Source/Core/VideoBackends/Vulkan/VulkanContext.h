@@ -83,6 +83,17 @@ public:
   }
   u32 GetShaderSubgroupSize() const { return m_shader_subgroup_size; }
   bool SupportsShaderSubgroupOperations() const { return m_supports_shader_subgroup_operations; }
+  // VK_EXT_graphics_pipeline_library with fast linking, see VKPipeline::Create.
+  bool SupportsGraphicsPipelineLibrary() const { return m_supports_graphics_pipeline_library; }
+  // VK_KHR_push_descriptor with room for the largest sampler set, see StateTracker.
+  bool SupportsPushDescriptors() const { return m_supports_push_descriptors; }
+  // VK_KHR_present_id and VK_KHR_present_wait, see VKGfx::WaitForPresentCompletion.
+  bool SupportsPresentWait() const { return m_supports_present_wait; }
+  // VK_KHR_timeline_semaphore, see CommandBufferManager.
+  bool SupportsTimelineSemaphores() const { return m_supports_timeline_semaphores; }
+  // All of VRAM can be written by the CPU (resizable BAR), or the GPU uses system memory anyway.
+  // See StreamBuffer::AllocateBuffer.
+  bool PrefersHostVisibleVRAM() const { return m_prefers_host_visible_vram; }
 
   // Helpers for getting constants
   VkDeviceSize GetUniformBufferAlignment() const
@@ -119,6 +130,7 @@ private:
                                        bool validation_layer_enabled);
   bool SelectDeviceExtensions(bool enable_surface);
   bool SelectDeviceFeatures();
+  void SelectMemoryPreferences();
   bool CreateDevice(VkSurfaceKHR surface, bool enable_validation_layer);
   void InitDriverDetails();
   void PopulateShaderSubgroupSupport();
@@ -143,6 +155,11 @@ private:
 
   u32 m_shader_subgroup_size = 1;
   bool m_supports_shader_subgroup_operations = false;
+  bool m_supports_graphics_pipeline_library = false;
+  bool m_supports_push_descriptors = false;
+  bool m_supports_present_wait = false;
+  bool m_supports_timeline_semaphores = false;
+  bool m_prefers_host_visible_vram = false;
 
   std::vector<std::string> m_device_extensions;
 };
@@ -10,6 +10,7 @@
 
 #include <array>
 #include <memory>
+#include <optional>
 #include <vector>
 
 class AbstractFramebuffer;
@@ -106,6 +107,11 @@ public:
   // Presents the backbuffer to the window system, or "swaps buffers".
   virtual void PresentBackbuffer() {}
 
+  // Blocks until the previously presented frame has been shown, or the swap chain can accept
+  // another frame without queuing it. Used by the low latency presentation mode before drawing a
+  // frame. Returns false if the backend can't tell when that happens.
+  virtual bool WaitForPresentCompletion() { return false; }
+
   // Shader modules/objects.
   virtual std::unique_ptr<AbstractShader> CreateShaderFromSource(ShaderStage stage,
                                                                  std::string_view source,
@@ -143,6 +149,14 @@ public:
   virtual void Flush() {}
   virtual void WaitForGPUIdle() {}
 
+  // Measures how long the host GPU takes to execute the commands between StartGPUTimer() and
+  // StopGPUTimer(). PopGPUTimerResult() returns the measurements in nanoseconds and in order, once
+  // the GPU has gotten to them, without waiting for it. Backends which can't measure this never
+  // return any.
+  virtual void StartGPUTimer() {}
+  virtual void StopGPUTimer() {}
+  virtual std::optional<u64> PopGPUTimerResult() { return std::nullopt; }
+
   // For opengl's glDrawBuffer
   virtual void SelectLeftBuffer() {}
   virtual void SelectRightBuffer() {}
@@ -0,0 +1,147 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/Assets/AssetResidencyManager.h"
+
+#include <iterator>
+
+#include "VideoCommon/Assets/CustomAsset.h"
+
+namespace VideoCommon
+{
+void AssetResidencyManager::Touch(const CustomAsset* asset, Entry* entry)
+{
+  const u64 last_use = ++m_use_counter;
+  if (entry->state == State::Queued)
+  {
+    m_queue.erase(entry->last_use);
+    m_queue.emplace(last_use, asset);
+  }
+  else if (entry->state == State::Resident)
+  {
+    m_resident_by_use.erase(entry->last_use);
+    m_resident_by_use.emplace(last_use, asset);
+  }
+  entry->last_use = last_use;
+}
+
+bool AssetResidencyManager::Request(const std::shared_ptr<CustomAsset>& asset)
+{
+  auto [it, inserted] = m_entries.try_emplace(asset.get());
+  Entry& entry = it->second;
+  if (!inserted)
+  {
+    Touch(asset.get(), &entry);
+    if (entry.state != State::Evicted)
+      return false;
+  }
+  else
+  {
+    entry.asset = asset;
+    entry.last_use = ++m_use_counter;
+  }
+
+  entry.state = State::Queued;
+  m_queue.emplace(entry.last_use, asset.get());
+  return true;
+}
+
+void AssetResidencyManager::MarkUsed(const CustomAsset* asset)
+{
+  if (auto it = m_entries.find(asset); it != m_entries.end())
+    Touch(asset, &it->second);
+}
+
+std::shared_ptr<CustomAsset> AssetResidencyManager::PopNextLoad()
+{
+  while (!m_queue.empty())
+  {
+    const auto queue_it = std::prev(m_queue.end());
+    const auto entry_it = m_entries.find(queue_it->second);
+    m_queue.erase(queue_it);
+
+    if (auto asset = entry_it->second.asset.lock())
+    {
+      entry_it->second.state = State::Loading;
+      return asset;
+    }
+    m_entries.erase(entry_it);
+  }
+
+  return nullptr;
+}
+
+std::vector<std::shared_ptr<CustomAsset>> AssetResidencyManager::OnLoaded(const CustomAsset* asset,
+                                                                         std::size_t bytes)
+{
+  std::vector<std::shared_ptr<CustomAsset>> evicted;
+
+  const auto it = m_entries.find(asset);
+  if (it == m_entries.end())
+    return evicted;
+
+  Entry& entry = it->second;
+  if (entry.state == State::Resident)
+  {
+    m_resident_bytes -= entry.bytes;
+    m_resident_by_use.erase(entry.last_use);
+  }
+  else if (entry.state == State::Queued)
+  {
+    m_queue.erase(entry.last_use);
+  }
+  entry.state = State::Resident;
+  entry.bytes = bytes;
+  m_resident_bytes += bytes;
+  m_resident_by_use.emplace(entry.last_use, asset);
+
+  while (m_resident_bytes > m_memory_budget && !m_resident_by_use.empty())
+  {
+    const auto lru_it = m_resident_by_use.begin();
+    Entry& lru_entry = m_entries[lru_it->second];
+    m_resident_by_use.erase(lru_it);
+
+    m_resident_bytes -= lru_entry.bytes;
+    lru_entry.bytes = 0;
+    lru_entry.state = State::Evicted;
+    if (auto lru_asset = lru_entry.asset.lock())
+      evicted.push_back(std::move(lru_asset));
+  }
+
+  return evicted;
+}
+
+void AssetResidencyManager::OnLoadFailed(const CustomAsset* asset)
+{
+  if (auto it = m_entries.find(asset); it != m_entries.end() && it->second.state == State::Loading)
+    it->second.state = State::Failed;
+}
+
+void AssetResidencyManager::Remove(const CustomAsset* asset)
+{
+  const auto it = m_entries.find(asset);
+  if (it == m_entries.end())
+    return;
+
+  const Entry& entry = it->second;
+  if (entry.state == State::Queued)
+  {
+    m_queue.erase(entry.last_use);
+  }
+  else if (entry.state == State::Resident)
+  {
+    m_resident_by_use.erase(entry.last_use);
+    m_resident_bytes -= entry.bytes;
+  }
+  m_entries.erase(it);
+}
+
+void AssetResidencyManager::Clear()
+{
+  m_entries.clear();
+  m_queue.clear();
+  m_resident_by_use.clear();
+  m_resident_bytes = 0;
+  m_use_counter = 0;
+}
+}  // namespace VideoCommon
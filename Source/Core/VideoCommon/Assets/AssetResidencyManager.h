@@ -0,0 +1,86 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace VideoCommon
+{
+class CustomAsset;
+
+// Decides in which order custom assets are loaded and which of them stay in memory
+// Assets are loaded in the order of their last use, most recent first, so that what the game
+// needs right now doesn't wait behind a prefetch of the whole pack. Once the loaded assets exceed
+// the memory budget, the least recently used ones are evicted; they are queued again the next
+// time they are requested.
+// Note: not thread safe, expected to be called by the loader with its lock held
+class AssetResidencyManager
+{
+public:
+  void SetMemoryBudget(std::size_t bytes) { m_memory_budget = bytes; }
+  std::size_t GetMemoryBudget() const { return m_memory_budget; }
+  std::size_t GetResidentBytes() const { return m_resident_bytes; }
+  std::size_t GetQueuedCount() const { return m_queue.size(); }
+
+  // Marks an asset that is about to be used as the most recently used one
+  // Returns true if the asset was queued for loading, because it wasn't loaded or queued yet
+  bool Request(const std::shared_ptr<CustomAsset>& asset);
+
+  // Only marks the asset as used, so that it is evicted after assets that weren't used as recently
+  void MarkUsed(const CustomAsset* asset);
+
+  // Takes the queued asset that was requested most recently, or returns nullptr if there is none
+  std::shared_ptr<CustomAsset> PopNextLoad();
+
+  // Records that the asset was loaded or reloaded with the given size
+  // Returns the assets that have to be unloaded to stay within the budget, which includes the
+  // asset itself if all the other ones were used more recently
+  std::vector<std::shared_ptr<CustomAsset>> OnLoaded(const CustomAsset* asset, std::size_t bytes);
+
+  // Records that the asset couldn't be loaded, so that requesting it doesn't queue it again
+  void OnLoadFailed(const CustomAsset* asset);
+
+  // Forgets an asset that is being destroyed
+  void Remove(const CustomAsset* asset);
+
+  void Clear();
+
+private:
+  enum class State
+  {
+    Queued,
+    Loading,
+    Resident,
+    Evicted,
+    Failed,
+  };
+
+  struct Entry
+  {
+    std::weak_ptr<CustomAsset> asset;
+    State state = State::Queued;
+    u64 last_use = 0;
+    std::size_t bytes = 0;
+  };
+
+  void Touch(const CustomAsset* asset, Entry* entry);
+
+  std::size_t m_memory_budget = std::numeric_limits<std::size_t>::max();
+  std::size_t m_resident_bytes = 0;
+  u64 m_use_counter = 0;
+
+  std::unordered_map<const CustomAsset*, Entry> m_entries;
+
+  // Both are keyed by the last use of the asset, which is unique
+  std::map<u64, const CustomAsset*> m_queue;
+  std::map<u64, const CustomAsset*> m_resident_by_use;
+};
+}  // namespace VideoCommon
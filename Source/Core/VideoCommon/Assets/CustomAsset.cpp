@@ -23,6 +23,17 @@ bool CustomAsset::Load()
   return load_information.m_bytes_loaded != 0;
 }
 
+void CustomAsset::Unload()
+{
+  UnloadImpl();
+
+  // Resetting the load time makes users that cached the time while the asset was unloaded pick up
+  // the data once it is loaded again
+  std::lock_guard lk(m_info_lock);
+  m_bytes_loaded = 0;
+  m_last_loaded_time = {};
+}
+
 CustomAssetLibrary::TimeType CustomAsset::GetLastWriteTime() const
 {
   return m_owning_library->GetLastAssetWriteTime(m_asset_id);
@@ -3,7 +3,11 @@
 
 #include "VideoCommon/Assets/CustomAssetLoader.h"
 
+#include <algorithm>
+
 #include "Common/MemoryUtil.h"
+#include "Common/Thread.h"
+#include "Core/Config/GraphicsSettings.h"
 #include "VideoCommon/Assets/CustomAssetLibrary.h"
 
 namespace VideoCommon
@@ -12,11 +16,22 @@ void CustomAssetLoader::Init()
 {
   m_asset_monitor_thread_shutdown.Clear();
 
-  const size_t sys_mem = Common::MemPhysical();
-  const size_t recommended_min_mem = 2 * size_t(1024 * 1024 * 1024);
-  // keep 2GB memory for system stability if system RAM is 4GB+ - use half of memory in other cases
-  m_max_memory_available =
-      (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
+  const int memory_budget_mb = Config::Get(Config::GFX_CUSTOM_ASSET_MEMORY_BUDGET);
+  if (memory_budget_mb > 0)
+  {
+    m_residency.SetMemoryBudget(size_t(memory_budget_mb) * 1024 * 1024);
+  }
+  else
+  {
+    const size_t sys_mem = Common::MemPhysical();
+    const size_t recommended_min_mem = 2 * size_t(1024 * 1024 * 1024);
+    // keep 2GB memory for system stability if system RAM is 4GB+ - use half of memory in other
+    // cases
+    const size_t max_memory_available =
+        (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
+    m_residency.SetMemoryBudget(max_memory_available);
+  }
+  m_memory_budget_reached = false;
 
   m_asset_monitor_thread = std::thread([this]() {
     Common::SetCurrentThreadName("Asset monitor");
@@ -30,53 +45,101 @@ void CustomAssetLoader::Init()
       std::this_thread::sleep_for(TIME_BETWEEN_ASSET_MONITOR_CHECKS);
 
       std::lock_guard lk(m_asset_load_lock);
+      std::vector<std::shared_ptr<CustomAsset>> evicted_assets;
       for (auto& [asset_id, asset_to_monitor] : m_assets_to_monitor)
       {
         if (auto ptr = asset_to_monitor.lock())
         {
           const auto write_time = ptr->GetLastWriteTime();
-          if (write_time > ptr->GetLastLoadedTime())
+          if (write_time > ptr->GetLastLoadedTime() && ptr->Load())
           {
-            (void)ptr->Load();
+            // The size of the asset may have changed
+            auto evicted = m_residency.OnLoaded(ptr.get(), ptr->GetByteSizeInMemory());
+            evicted_assets.insert(evicted_assets.end(), evicted.begin(), evicted.end());
           }
         }
       }
+      UnloadEvictedAssets(evicted_assets);
     }
   });
 
-  m_asset_load_thread.Reset("Custom Asset Loader", [this](std::weak_ptr<CustomAsset> asset) {
-    if (auto ptr = asset.lock())
-    {
-      if (m_memory_exceeded)
-        return;
+  std::lock_guard lk(m_asset_load_lock);
+  m_asset_loads_enabled = true;
+}
 
-      if (ptr->Load())
-      {
-        std::lock_guard lk(m_asset_load_lock);
-        const std::size_t asset_memory_size = ptr->GetByteSizeInMemory();
-        m_total_bytes_loaded += asset_memory_size;
-        m_assets_to_monitor.try_emplace(ptr->GetAssetId(), ptr);
-        if (m_total_bytes_loaded > m_max_memory_available)
-        {
-          ERROR_LOG_FMT(VIDEO,
-                        "Asset memory exceeded with asset '{}', future assets won't load until "
-                        "memory is available.",
-                        ptr->GetAssetId());
-          m_memory_exceeded = true;
-        }
-      }
-    }
-  });
+void CustomAssetLoader::LoadNextAsset()
+{
+  std::shared_ptr<CustomAsset> asset;
+  {
+    std::lock_guard lk(m_asset_load_lock);
+    asset = m_residency.PopNextLoad();
+  }
+  if (!asset)
+    return;
+
+  const bool loaded = asset->Load();
+
+  std::lock_guard lk(m_asset_load_lock);
+  if (!loaded)
+  {
+    m_residency.OnLoadFailed(asset.get());
+    return;
+  }
+
+  const auto evicted_assets = m_residency.OnLoaded(asset.get(), asset->GetByteSizeInMemory());
+  if (std::ranges::find(evicted_assets, asset) == evicted_assets.end())
+    m_assets_to_monitor.try_emplace(asset->GetAssetId(), asset);
+  UnloadEvictedAssets(evicted_assets);
+}
+
+void CustomAssetLoader::UnloadEvictedAssets(
+    const std::vector<std::shared_ptr<CustomAsset>>& evicted_assets)
+{
+  if (evicted_assets.empty())
+    return;
+
+  if (!m_memory_budget_reached)
+  {
+    INFO_LOG_FMT(VIDEO,
+                 "Asset memory budget of {} MiB reached, the least recently used assets will be "
+                 "unloaded.",
+                 m_residency.GetMemoryBudget() / (1024 * 1024));
+    m_memory_budget_reached = true;
+  }
+
+  for (const auto& asset : evicted_assets)
+  {
+    m_assets_to_monitor.erase(asset->GetAssetId());
+    asset->Unload();
+  }
+}
+
+void CustomAssetLoader::RequestLoad(const std::shared_ptr<CustomAsset>& asset)
+{
+  std::lock_guard lk(m_asset_load_lock);
+  if (m_residency.Request(asset) && m_asset_loads_enabled)
+    m_asset_load_tasks.Schedule([this] { LoadNextAsset(); });
+}
+
+void CustomAssetLoader::MarkUsed(const CustomAsset& asset)
+{
+  std::lock_guard lk(m_asset_load_lock);
+  m_residency.MarkUsed(&asset);
 }
 
 void CustomAssetLoader ::Shutdown()
 {
-  m_asset_load_thread.Shutdown(true);
+  {
+    std::lock_guard lk(m_asset_load_lock);
+    m_asset_loads_enabled = false;
+  }
+  m_asset_load_tasks.Cancel();
+  m_asset_load_tasks.Wait();
 
   m_asset_monitor_thread_shutdown.Set();
   m_asset_monitor_thread.join();
   m_assets_to_monitor.clear();
-  m_total_bytes_loaded = 0;
+  m_residency.Clear();
 }
 
 std::shared_ptr<GameTextureAsset>
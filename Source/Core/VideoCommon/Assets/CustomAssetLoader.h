@@ -8,10 +8,12 @@
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include "Common/Flag.h"
 #include "Common/Logging/Log.h"
-#include "Common/WorkQueueThread.h"
+#include "Common/TaskScheduler.h"
+#include "VideoCommon/Assets/AssetResidencyManager.h"
 #include "VideoCommon/Assets/CustomAsset.h"
 #include "VideoCommon/Assets/MaterialAsset.h"
 #include "VideoCommon/Assets/MeshAsset.h"
@@ -22,6 +24,8 @@ namespace VideoCommon
 {
 // This class is responsible for loading data asynchronously when requested
 // and watches that data asynchronously reloading it if it changes
+// Assets that were requested most recently are loaded first, and the least recently used
+// ones are unloaded when the memory budget is exceeded
 class CustomAssetLoader
 {
 public:
@@ -52,6 +56,13 @@ public:
   std::shared_ptr<MeshAsset> LoadMesh(const CustomAssetLibrary::AssetID& asset_id,
                                       std::shared_ptr<CustomAssetLibrary> library);
 
+  // Marks an asset that is about to be used, raising its load priority
+  // If the asset was unloaded to stay within the memory budget, it is loaded again
+  void RequestLoad(const std::shared_ptr<CustomAsset>& asset);
+
+  // Marks an asset as used, so that it is kept loaded over assets that weren't used as recently
+  void MarkUsed(const CustomAsset& asset);
+
 private:
   // TODO C++20: use a 'derived_from' concept against 'CustomAsset' when available
   template <typename AssetType>
@@ -65,26 +76,27 @@ private:
     {
       auto shared = it->second.lock();
       if (shared)
+      {
+        RequestLoad(shared);
         return shared;
+      }
     }
     std::shared_ptr<AssetType> ptr(new AssetType(std::move(library), asset_id), [&](AssetType* a) {
       {
         std::lock_guard lk(m_asset_load_lock);
-        m_total_bytes_loaded -= a->GetByteSizeInMemory();
+        m_residency.Remove(a);
         m_assets_to_monitor.erase(a->GetAssetId());
-        if (m_max_memory_available >= m_total_bytes_loaded && m_memory_exceeded)
-        {
-          INFO_LOG_FMT(VIDEO, "Asset memory went below limit, new assets can begin loading.");
-          m_memory_exceeded = false;
-        }
       }
       delete a;
     });
     it->second = ptr;
-    m_asset_load_thread.Push(it->second);
+    RequestLoad(ptr);
     return ptr;
   }
 
+  void LoadNextAsset();
+  void UnloadEvictedAssets(const std::vector<std::shared_ptr<CustomAsset>>& evicted_assets);
+
   static constexpr auto TIME_BETWEEN_ASSET_MONITOR_CHECKS = std::chrono::milliseconds{500};
 
   std::map<CustomAssetLibrary::AssetID, std::weak_ptr<GameTextureAsset>> m_game_textures;
@@ -94,15 +106,17 @@ private:
   std::thread m_asset_monitor_thread;
   Common::Flag m_asset_monitor_thread_shutdown;
 
-  std::size_t m_total_bytes_loaded = 0;
-  std::size_t m_max_memory_available = 0;
-  std::atomic_bool m_memory_exceeded = false;
+  AssetResidencyManager m_residency;
+  bool m_memory_budget_reached = false;
 
   std::map<CustomAssetLibrary::AssetID, std::weak_ptr<CustomAsset>> m_assets_to_monitor;
 
   // Use a recursive mutex to handle the scenario where an asset goes out of scope while
   // iterating over the assets to monitor which calls the lock above in 'LoadOrCreateAsset'
   std::recursive_mutex m_asset_load_lock;
-  Common::WorkQueueThread<std::weak_ptr<CustomAsset>> m_asset_load_thread;
+
+  // The assets to load are picked by the residency manager, each task loads the next one
+  Common::TaskGroup m_asset_load_tasks{Common::TaskPriority::Normal};
+  bool m_asset_loads_enabled = false;
 };
 }  // namespace VideoCommon
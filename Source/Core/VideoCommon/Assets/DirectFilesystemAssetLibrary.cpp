@@ -49,32 +49,70 @@ std::size_t GetAssetSize(const CustomTextureData& data)
   }
   return total;
 }
+
+CustomAssetLibrary::TimeType GetLastWriteTime(const DirectFilesystemAssetLibrary::AssetMap& files)
+{
+  CustomAssetLibrary::TimeType max_entry;
+  for (const auto& [key, value] : files)
+  {
+    std::error_code ec;
+    const auto tp = std::filesystem::last_write_time(value, ec);
+    if (ec)
+      continue;
+    auto tp_sys = FileTimeToSysTime(tp);
+    if (tp_sys > max_entry)
+      max_entry = tp_sys;
+  }
+  return max_entry;
+}
+
+// Paths reported by the watcher may be spelled differently than the ones of the asset map, for
+// instance FSEvents reports them with symbolic links resolved
+std::string GetPathKey(const std::filesystem::path& path)
+{
+  std::error_code ec;
+  const auto canonical_path = std::filesystem::weakly_canonical(path, ec);
+  return PathToString(ec ? path.lexically_normal() : canonical_path);
+}
 }  // namespace
+
+DirectFilesystemAssetLibrary::DirectFilesystemAssetLibrary()
+    : m_watcher([this](const std::string& path) { OnFileChanged(path); })
+{
+}
 CustomAssetLibrary::TimeType
 DirectFilesystemAssetLibrary::GetLastAssetWriteTime(const AssetID& asset_id) const
 {
   std::lock_guard lk(m_lock);
+  if (const auto iter = m_cached_write_times.find(asset_id); iter != m_cached_write_times.end())
+    return iter->second;
+
   if (auto iter = m_assetid_to_asset_map_path.find(asset_id);
       iter != m_assetid_to_asset_map_path.end())
   {
-    const auto& asset_map_path = iter->second;
-    CustomAssetLibrary::TimeType max_entry;
-    for (const auto& [key, value] : asset_map_path)
-    {
-      std::error_code ec;
-      const auto tp = std::filesystem::last_write_time(value, ec);
-      if (ec)
-        continue;
-      auto tp_sys = FileTimeToSysTime(tp);
-      if (tp_sys > max_entry)
-        max_entry = tp_sys;
-    }
-    return max_entry;
+    const auto write_time = GetLastWriteTime(iter->second);
+    if (m_watched_assets.contains(asset_id))
+      m_cached_write_times.emplace(asset_id, write_time);
+    return write_time;
   }
 
   return {};
 }
 
+void DirectFilesystemAssetLibrary::OnFileChanged(const std::string& path)
+{
+  std::lock_guard lk(m_lock);
+  if (path.empty())
+  {
+    m_cached_write_times.clear();
+    return;
+  }
+
+  const auto [begin, end] = m_path_to_asset_ids.equal_range(GetPathKey(StringToPath(path)));
+  for (auto iter = begin; iter != end; ++iter)
+    m_cached_write_times.erase(iter->second);
+}
+
 CustomAssetLibrary::LoadInfo DirectFilesystemAssetLibrary::LoadPixelShader(const AssetID& asset_id,
                                                                            PixelShaderData* data)
 {
@@ -436,8 +474,35 @@ CustomAssetLibrary::LoadInfo DirectFilesystemAssetLibrary::LoadTexture(const Ass
 void DirectFilesystemAssetLibrary::SetAssetIDMapData(const AssetID& asset_id,
                                                      AssetMap asset_path_map)
 {
+  // The watcher is called without holding the lock, as it may wait for pending notifications
+  bool watched = true;
+  for (const auto& [key, path] : asset_path_map)
+    watched &= m_watcher.Watch(PathToString(path.parent_path().lexically_normal()));
+
   std::lock_guard lk(m_lock);
-  m_assetid_to_asset_map_path[asset_id] = std::move(asset_path_map);
+  auto& asset_map = m_assetid_to_asset_map_path[asset_id];
+  for (const auto& [key, path] : asset_map)
+  {
+    const auto [begin, end] = m_path_to_asset_ids.equal_range(GetPathKey(path));
+    for (auto iter = begin; iter != end; ++iter)
+    {
+      if (iter->second == asset_id)
+      {
+        m_path_to_asset_ids.erase(iter);
+        break;
+      }
+    }
+  }
+
+  asset_map = std::move(asset_path_map);
+  for (const auto& [key, path] : asset_map)
+    m_path_to_asset_ids.emplace(GetPathKey(path), asset_id);
+
+  m_cached_write_times.erase(asset_id);
+  if (watched)
+    m_watched_assets.insert(asset_id);
+  else
+    m_watched_assets.erase(asset_id);
 }
 
 bool DirectFilesystemAssetLibrary::LoadMips(const std::filesystem::path& asset_path,
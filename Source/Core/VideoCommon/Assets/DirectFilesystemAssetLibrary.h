@@ -6,8 +6,10 @@
 #include <filesystem>
 #include <map>
 #include <mutex>
+#include <set>
 #include <string>
 
+#include "Common/DirectoryWatcher.h"
 #include "VideoCommon/Assets/CustomAssetLibrary.h"
 #include "VideoCommon/Assets/CustomTextureData.h"
 
@@ -15,11 +17,15 @@ namespace VideoCommon
 {
 // This class implements 'CustomAssetLibrary' and loads any assets
 // directly from the filesystem
+// The directories of the assets are watched for changes when the OS supports it, so that the
+// write times of unchanged assets don't have to be read from the filesystem again
 class DirectFilesystemAssetLibrary final : public CustomAssetLibrary
 {
 public:
   using AssetMap = std::map<std::string, std::filesystem::path>;
 
+  DirectFilesystemAssetLibrary();
+
   LoadInfo LoadTexture(const AssetID& asset_id, TextureData* data) override;
   LoadInfo LoadPixelShader(const AssetID& asset_id, PixelShaderData* data) override;
   LoadInfo LoadMaterial(const AssetID& asset_id, MaterialData* data) override;
@@ -40,7 +46,20 @@ private:
   // Gets the asset map given an asset id
   AssetMap GetAssetMapForID(const AssetID& asset_id) const;
 
+  // Called by the watcher when a file in one of the watched directories changed
+  void OnFileChanged(const std::string& path);
+
   mutable std::mutex m_lock;
   std::map<AssetID, std::map<std::string, std::filesystem::path>> m_assetid_to_asset_map_path;
+
+  // The write times of assets don't change until the watcher reports that one of their files
+  // changed, so they are only read once for the assets whose directories are all watched
+  std::set<AssetID> m_watched_assets;
+  std::multimap<std::string, AssetID> m_path_to_asset_ids;
+  mutable std::map<AssetID, TimeType> m_cached_write_times;
+
+  // Declared last, so that the watcher stops reporting changes before the members above are
+  // destroyed
+  Common::DirectoryWatcher m_watcher;
 };
 }  // namespace VideoCommon
@@ -0,0 +1,283 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/Assets/TexturePack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include <xxhash.h>
+
+#include "Common/Logging/Log.h"
+
+namespace VideoCommon
+{
+static constexpr u32 TEXTURE_PACK_MAGIC = 0x50544444;  // "DDTP"
+static constexpr u32 TEXTURE_PACK_VERSION = 1;
+
+enum : u32
+{
+  ENTRY_FLAG_ARBITRARY_MIPMAPS = 1 << 0,
+};
+
+struct TexturePackHeader
+{
+  u32 magic;
+  u32 version;
+  u32 num_textures;
+  u32 padding;
+  u64 toc_offset;
+};
+static_assert(std::is_trivially_copyable_v<TexturePackHeader>);
+
+struct TexturePack::Entry
+{
+  u64 name_hash;
+  // Of the table of levels
+  u64 offset;
+  // Relative to the start of the names
+  u32 name_offset;
+  u32 name_length;
+  u32 num_levels;
+  u32 flags;
+};
+
+struct TexturePackLevel
+{
+  u64 offset;
+  u64 size;
+  AbstractTextureFormat format;
+  u32 width;
+  u32 height;
+  u32 row_length;
+};
+static_assert(std::is_trivially_copyable_v<TexturePackLevel>);
+
+static u64 HashName(std::string_view name)
+{
+  return XXH3_64bits(name.data(), name.size());
+}
+
+template <typename T>
+static T ReadMapped(const File::MappedFile& mapping, u64 offset)
+{
+  T value;
+  std::memcpy(&value, mapping.GetData() + offset, sizeof(T));
+  return value;
+}
+
+std::unique_ptr<TexturePack> TexturePack::Open(const std::string& path)
+{
+  std::unique_ptr<TexturePack> pack(new TexturePack);
+  if (!pack->m_file.Open(path, "rb"))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to open the texture pack '{}'", path);
+    return nullptr;
+  }
+
+  const u64 size = pack->m_file.GetSize();
+  if (size < sizeof(TexturePackHeader) || !pack->m_mapping.Map(pack->m_file, size))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to map the texture pack '{}'", path);
+    return nullptr;
+  }
+
+  const auto header = ReadMapped<TexturePackHeader>(pack->m_mapping, 0);
+  if (header.magic != TEXTURE_PACK_MAGIC || header.version != TEXTURE_PACK_VERSION ||
+      header.toc_offset > size ||
+      header.num_textures > (size - header.toc_offset) / sizeof(Entry))
+  {
+    ERROR_LOG_FMT(VIDEO, "'{}' is not a valid texture pack", path);
+    return nullptr;
+  }
+
+  pack->m_num_textures = header.num_textures;
+  pack->m_toc_offset = header.toc_offset;
+  return pack;
+}
+
+TexturePack::Entry TexturePack::GetEntry(u32 index) const
+{
+  return ReadMapped<Entry>(m_mapping, m_toc_offset + u64(index) * sizeof(Entry));
+}
+
+std::string_view TexturePack::GetName(const Entry& entry) const
+{
+  const u64 names_offset = m_toc_offset + u64(m_num_textures) * sizeof(Entry);
+  const u64 names_size = m_mapping.GetSize() - names_offset;
+  if (entry.name_offset > names_size || entry.name_length > names_size - entry.name_offset)
+    return {};
+
+  return {reinterpret_cast<const char*>(m_mapping.GetData() + names_offset + entry.name_offset),
+          entry.name_length};
+}
+
+void TexturePack::ForEachTexture(
+    const std::function<void(std::string_view name, bool has_arbitrary_mipmaps)>& callback) const
+{
+  for (u32 i = 0; i < m_num_textures; ++i)
+  {
+    const Entry entry = GetEntry(i);
+    callback(GetName(entry), (entry.flags & ENTRY_FLAG_ARBITRARY_MIPMAPS) != 0);
+  }
+}
+
+std::optional<TexturePack::Entry> TexturePack::Find(std::string_view name) const
+{
+  const u64 hash = HashName(name);
+
+  // Binary search for the first entry with the hash, then check the names of all entries with it
+  u32 first = 0;
+  u32 count = m_num_textures;
+  while (count > 0)
+  {
+    const u32 step = count / 2;
+    if (GetEntry(first + step).name_hash < hash)
+    {
+      first += step + 1;
+      count -= step + 1;
+    }
+    else
+    {
+      count = step;
+    }
+  }
+
+  for (u32 i = first; i < m_num_textures; ++i)
+  {
+    const Entry entry = GetEntry(i);
+    if (entry.name_hash != hash)
+      break;
+    if (GetName(entry) == name)
+      return entry;
+  }
+
+  return std::nullopt;
+}
+
+bool TexturePack::FindTexture(std::string_view name, bool* has_arbitrary_mipmaps) const
+{
+  const std::optional<Entry> entry = Find(name);
+  if (!entry)
+    return false;
+
+  *has_arbitrary_mipmaps = (entry->flags & ENTRY_FLAG_ARBITRARY_MIPMAPS) != 0;
+  return true;
+}
+
+bool TexturePack::LoadTexture(std::string_view name, CustomTextureData::ArraySlice* slice) const
+{
+  const std::optional<Entry> entry = Find(name);
+  if (!entry)
+    return false;
+
+  const u64 size = m_mapping.GetSize();
+  if (entry->offset > size || entry->num_levels > (size - entry->offset) / sizeof(TexturePackLevel))
+  {
+    ERROR_LOG_FMT(VIDEO, "Texture pack entry '{}' is corrupted", name);
+    return false;
+  }
+
+  slice->m_levels.clear();
+  slice->m_levels.reserve(entry->num_levels);
+  for (u32 i = 0; i < entry->num_levels; ++i)
+  {
+    const auto level =
+        ReadMapped<TexturePackLevel>(m_mapping, entry->offset + u64(i) * sizeof(TexturePackLevel));
+    if (level.offset > size || level.size > size - level.offset ||
+        level.format >= AbstractTextureFormat::Undefined)
+    {
+      ERROR_LOG_FMT(VIDEO, "Texture pack entry '{}' is corrupted", name);
+      return false;
+    }
+
+    m_mapping.HintWillNeed(level.offset, level.size);
+    const u8* const data = m_mapping.GetData() + level.offset;
+
+    auto& loaded_level = slice->m_levels.emplace_back();
+    loaded_level.data.assign(data, data + level.size);
+    loaded_level.format = level.format;
+    loaded_level.width = level.width;
+    loaded_level.height = level.height;
+    loaded_level.row_length = level.row_length;
+  }
+
+  return true;
+}
+
+bool TexturePackWriter::Open(const std::string& path)
+{
+  m_entries.clear();
+  m_entries_by_hash.clear();
+  m_names.clear();
+
+  const TexturePackHeader header{};
+  return m_file.Open(path, "wb") && m_file.WriteArray(&header, 1);
+}
+
+bool TexturePackWriter::AddTexture(std::string_view name, bool has_arbitrary_mipmaps,
+                                   const CustomTextureData::ArraySlice& slice)
+{
+  const u64 name_hash = HashName(name);
+  const auto [first, last] = m_entries_by_hash.equal_range(name_hash);
+  for (auto it = first; it != last; ++it)
+  {
+    const PendingEntry& entry = m_entries[it->second];
+    if (std::string_view(m_names).substr(entry.name_offset, entry.name_length) == name)
+      return false;
+  }
+
+  const u64 offset = m_file.Tell();
+  u64 data_offset = offset + slice.m_levels.size() * sizeof(TexturePackLevel);
+  for (const auto& level : slice.m_levels)
+  {
+    const TexturePackLevel packed_level{data_offset,  level.data.size(), level.format,
+                                        level.width,  level.height,      level.row_length};
+    if (!m_file.WriteArray(&packed_level, 1))
+      return false;
+    data_offset += level.data.size();
+  }
+  for (const auto& level : slice.m_levels)
+  {
+    if (!m_file.WriteBytes(level.data.data(), level.data.size()))
+      return false;
+  }
+
+  m_entries_by_hash.emplace(name_hash, m_entries.size());
+  m_entries.push_back({name_hash, static_cast<u32>(m_names.size()), static_cast<u32>(name.size()),
+                       has_arbitrary_mipmaps, static_cast<u32>(slice.m_levels.size()), offset});
+  m_names.append(name);
+  return true;
+}
+
+bool TexturePackWriter::Finish()
+{
+  const std::string_view names = m_names;
+  const auto get_name = [&](const PendingEntry& entry) {
+    return names.substr(entry.name_offset, entry.name_length);
+  };
+  std::ranges::sort(m_entries, [&](const PendingEntry& a, const PendingEntry& b) {
+    return std::pair(a.name_hash, get_name(a)) < std::pair(b.name_hash, get_name(b));
+  });
+
+  const TexturePackHeader header{TEXTURE_PACK_MAGIC, TEXTURE_PACK_VERSION,
+                                 static_cast<u32>(m_entries.size()), 0, m_file.Tell()};
+  for (const PendingEntry& pending : m_entries)
+  {
+    const u32 flags = pending.has_arbitrary_mipmaps ? ENTRY_FLAG_ARBITRARY_MIPMAPS : 0;
+    const TexturePack::Entry entry{pending.name_hash,   pending.offset,     pending.name_offset,
+                                   pending.name_length, pending.num_levels, flags};
+    if (!m_file.WriteArray(&entry, 1))
+      return false;
+  }
+
+  const bool success = m_file.WriteString(m_names) && m_file.Seek(0, File::SeekOrigin::Begin) &&
+                       m_file.WriteArray(&header, 1) && m_file.Close();
+  m_entries.clear();
+  m_entries_by_hash.clear();
+  m_names.clear();
+  return success;
+}
+}  // namespace VideoCommon
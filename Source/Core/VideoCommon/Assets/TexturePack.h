@@ -0,0 +1,93 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Custom textures packed into a single file. The file is memory mapped, so that a pack with many
+// textures can be indexed without reading it, and the data of a texture is only read from disk
+// once the texture is loaded.
+//
+// The file starts with a header, which is followed by the textures. Each of them is a table of
+// its levels and then the data of the levels, stored in the format the GPU samples them in. The
+// table of contents after the textures lists them sorted by the hash of their names, and their
+// names follow it.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/MappedFile.h"
+#include "VideoCommon/Assets/CustomTextureData.h"
+
+namespace VideoCommon
+{
+class TexturePack
+{
+public:
+  static constexpr std::string_view EXTENSION = ".dtp";
+
+  TexturePack(const TexturePack&) = delete;
+  TexturePack& operator=(const TexturePack&) = delete;
+
+  static std::unique_ptr<TexturePack> Open(const std::string& path);
+
+  u32 GetTextureCount() const { return m_num_textures; }
+  void ForEachTexture(const std::function<void(std::string_view name, bool has_arbitrary_mipmaps)>&
+                          callback) const;
+
+  // Returns false if there is no texture with the given name
+  bool FindTexture(std::string_view name, bool* has_arbitrary_mipmaps) const;
+  bool LoadTexture(std::string_view name, CustomTextureData::ArraySlice* slice) const;
+
+private:
+  friend class TexturePackWriter;
+  struct Entry;
+
+  TexturePack() = default;
+
+  Entry GetEntry(u32 index) const;
+  std::string_view GetName(const Entry& entry) const;
+  std::optional<Entry> Find(std::string_view name) const;
+
+  File::IOFile m_file;
+  File::MappedFile m_mapping;
+  u32 m_num_textures = 0;
+  u64 m_toc_offset = 0;
+};
+
+// Writes a pack, one texture at a time, so that only the table of contents is kept in memory
+class TexturePackWriter
+{
+public:
+  bool Open(const std::string& path);
+
+  // Returns false if the texture couldn't be written, or if there already is one with this name
+  bool AddTexture(std::string_view name, bool has_arbitrary_mipmaps,
+                  const CustomTextureData::ArraySlice& slice);
+
+  // Writes the table of contents and closes the file
+  bool Finish();
+
+private:
+  struct PendingEntry
+  {
+    u64 name_hash;
+    u32 name_offset;
+    u32 name_length;
+    bool has_arbitrary_mipmaps;
+    u32 num_levels;
+    u64 offset;
+  };
+
+  File::IOFile m_file;
+  std::vector<PendingEntry> m_entries;
+  std::unordered_multimap<u64, size_t> m_entries_by_hash;
+  std::string m_names;
+};
+}  // namespace VideoCommon
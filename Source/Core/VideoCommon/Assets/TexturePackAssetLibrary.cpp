@@ -0,0 +1,125 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/Assets/TexturePackAssetLibrary.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include "Common/Logging/Log.h"
+#include "VideoCommon/Assets/TextureAsset.h"
+#include "VideoCommon/RenderState.h"
+
+namespace VideoCommon
+{
+CustomAssetLibrary::LoadInfo TexturePackAssetLibrary::LoadTexture(const AssetID& asset_id,
+                                                                  TextureData* data)
+{
+  const auto open_pack = GetPackWithTexture(asset_id);
+  if (!open_pack)
+  {
+    ERROR_LOG_FMT(VIDEO, "Asset '{}' error - not found in any texture pack!", asset_id);
+    return {};
+  }
+
+  data->m_sampler = RenderState::GetLinearSamplerState();
+  data->m_type = TextureData::Type::Type_Texture2D;
+  data->m_texture.m_slices.resize(1);
+
+  auto& slice = data->m_texture.m_slices[0];
+  if (!open_pack->pack->LoadTexture(asset_id, &slice))
+  {
+    ERROR_LOG_FMT(VIDEO, "Asset '{}' error - could not load the texture from its pack!",
+                  asset_id);
+    return {};
+  }
+
+  std::size_t bytes_loaded = 0;
+  for (const auto& level : slice.m_levels)
+    bytes_loaded += level.data.size();
+
+  return LoadInfo{bytes_loaded, open_pack->open_time};
+}
+
+CustomAssetLibrary::LoadInfo TexturePackAssetLibrary::LoadPixelShader(const AssetID& asset_id,
+                                                                      PixelShaderData* data)
+{
+  ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture packs can't contain pixel shaders!", asset_id);
+  return {};
+}
+
+CustomAssetLibrary::LoadInfo TexturePackAssetLibrary::LoadMaterial(const AssetID& asset_id,
+                                                                   MaterialData* data)
+{
+  ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture packs can't contain materials!", asset_id);
+  return {};
+}
+
+CustomAssetLibrary::LoadInfo TexturePackAssetLibrary::LoadMesh(const AssetID& asset_id,
+                                                               MeshData* data)
+{
+  ERROR_LOG_FMT(VIDEO, "Asset '{}' error - texture packs can't contain meshes!", asset_id);
+  return {};
+}
+
+CustomAssetLibrary::TimeType
+TexturePackAssetLibrary::GetLastAssetWriteTime(const AssetID& asset_id) const
+{
+  const auto open_pack = GetPackWithTexture(asset_id);
+  return open_pack ? open_pack->open_time : TimeType{};
+}
+
+bool TexturePackAssetLibrary::AddPack(const std::string& path)
+{
+  {
+    std::lock_guard lk(m_lock);
+    const auto is_open = [&](const auto& open_pack) { return open_pack->path == path; };
+    if (std::ranges::any_of(m_packs, is_open))
+      return true;
+  }
+
+  auto pack = TexturePack::Open(path);
+  if (!pack)
+    return false;
+
+  auto open_pack = std::make_shared<const OpenPack>(
+      OpenPack{path, std::move(pack), std::chrono::system_clock::now()});
+
+  std::lock_guard lk(m_lock);
+  m_packs.push_back(std::move(open_pack));
+  return true;
+}
+
+bool TexturePackAssetLibrary::FindTexture(std::string_view name, bool* has_arbitrary_mipmaps) const
+{
+  std::lock_guard lk(m_lock);
+  for (const auto& open_pack : m_packs)
+  {
+    if (open_pack->pack->FindTexture(name, has_arbitrary_mipmaps))
+      return true;
+  }
+  return false;
+}
+
+void TexturePackAssetLibrary::ForEachTexture(
+    const std::function<void(std::string_view name, bool has_arbitrary_mipmaps)>& callback) const
+{
+  std::lock_guard lk(m_lock);
+  for (const auto& open_pack : m_packs)
+    open_pack->pack->ForEachTexture(callback);
+}
+
+std::shared_ptr<const TexturePackAssetLibrary::OpenPack>
+TexturePackAssetLibrary::GetPackWithTexture(std::string_view name) const
+{
+  std::lock_guard lk(m_lock);
+  for (const auto& open_pack : m_packs)
+  {
+    bool has_arbitrary_mipmaps;
+    if (open_pack->pack->FindTexture(name, &has_arbitrary_mipmaps))
+      return open_pack;
+  }
+  return nullptr;
+}
+}  // namespace VideoCommon
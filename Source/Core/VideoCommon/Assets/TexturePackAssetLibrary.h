@@ -0,0 +1,52 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "VideoCommon/Assets/CustomAssetLibrary.h"
+#include "VideoCommon/Assets/TexturePack.h"
+
+namespace VideoCommon
+{
+// This class implements 'CustomAssetLibrary' and loads raw textures from texture packs, where
+// the asset id is the name of the texture
+class TexturePackAssetLibrary final : public CustomAssetLibrary
+{
+public:
+  LoadInfo LoadTexture(const AssetID& asset_id, TextureData* data) override;
+  LoadInfo LoadPixelShader(const AssetID& asset_id, PixelShaderData* data) override;
+  LoadInfo LoadMaterial(const AssetID& asset_id, MaterialData* data) override;
+  LoadInfo LoadMesh(const AssetID& asset_id, MeshData* data) override;
+
+  // Packs don't change while they are open, so this is the time at which the pack was opened
+  TimeType GetLastAssetWriteTime(const AssetID& asset_id) const override;
+
+  // Textures in packs that were added earlier take precedence. Adding a pack that is already open
+  // does nothing.
+  bool AddPack(const std::string& path);
+
+  bool FindTexture(std::string_view name, bool* has_arbitrary_mipmaps) const;
+  void ForEachTexture(const std::function<void(std::string_view name, bool has_arbitrary_mipmaps)>&
+                          callback) const;
+
+private:
+  struct OpenPack
+  {
+    std::string path;
+    std::unique_ptr<TexturePack> pack;
+    TimeType open_time;
+  };
+
+  std::shared_ptr<const OpenPack> GetPackWithTexture(std::string_view name) const;
+
+  mutable std::mutex m_lock;
+  std::vector<std::shared_ptr<const OpenPack>> m_packs;
+};
+}  // namespace VideoCommon
@@ -12,6 +12,8 @@
 #include "Core/Core.h"
 #include "Core/System.h"
 
+#include "VideoCommon/PerformanceMetrics.h"
+
 namespace VideoCommon
 {
 AsyncShaderCompiler::AsyncShaderCompiler()
@@ -25,20 +27,71 @@ AsyncShaderCompiler::~AsyncShaderCompiler()
   ASSERT(!HasWorkerThreads());
 }
 
-void AsyncShaderCompiler::QueueWorkItem(WorkItemPtr item, u32 priority)
+AsyncShaderCompiler::WorkItemHandle AsyncShaderCompiler::QueueWorkItem(WorkItemPtr item,
+                                                                      u32 priority)
 {
   // If no worker threads are available, compile synchronously.
   if (!HasWorkerThreads())
   {
     item->Compile();
     m_completed_work.push_back(std::move(item));
+    return {};
   }
-  else
+
+  auto queued_item = std::make_shared<QueuedWorkItem>();
+  queued_item->item = std::move(item);
+  queued_item->queue_time = Clock::now();
+  WorkItemHandle handle = queued_item;
+
+  // Spread the work over the queues of the running worker threads.
+  WorkerQueue& queue = *m_worker_queues[m_next_worker_queue++ % m_worker_threads.size()];
   {
-    std::lock_guard<std::mutex> guard(m_pending_work_lock);
-    m_pending_work.emplace(priority, std::move(item));
-    m_worker_thread_wake.notify_one();
+    std::lock_guard<std::mutex> guard(queue.lock);
+    queue.items.emplace(priority, std::move(queued_item));
+    queue.front_priority.store(queue.items.begin()->first, std::memory_order_relaxed);
   }
+
+  m_pending_items++;
+  g_perf_metrics.CountShaderCompileQueued();
+  WakeWorkerThreads(false);
+  return handle;
+}
+
+void AsyncShaderCompiler::BoostWorkItem(const WorkItemHandle& handle)
+{
+  QueuedWorkItemPtr queued_item = handle.lock();
+  if (!queued_item || queued_item->boosted.exchange(true) || queued_item->taken.test())
+    return;
+
+  {
+    std::lock_guard<std::mutex> guard(m_boosted_work_lock);
+    m_boosted_work.push_back(std::move(queued_item));
+  }
+  WakeWorkerThreads(false);
+}
+
+void AsyncShaderCompiler::CancelPendingWork()
+{
+  u32 cancelled_items = 0;
+  for (const auto& queue : m_worker_queues)
+  {
+    std::lock_guard<std::mutex> guard(queue->lock);
+    for (const auto& [priority, queued_item] : queue->items)
+    {
+      if (!queued_item->taken.test_and_set())
+      {
+        m_pending_items--;
+        cancelled_items++;
+      }
+    }
+    queue->items.clear();
+    queue->front_priority.store(NO_PRIORITY, std::memory_order_relaxed);
+  }
+
+  g_perf_metrics.CountShaderCompilesCancelled(cancelled_items);
+
+  std::lock_guard<std::mutex> guard(m_boosted_work_lock);
+  m_boosted_work.clear();
 }
 
 void AsyncShaderCompiler::RetrieveWorkItems()
@@ -58,8 +111,7 @@ void AsyncShaderCompiler::RetrieveWorkItems()
 
 bool AsyncShaderCompiler::HasPendingWork()
 {
-  std::lock_guard<std::mutex> guard(m_pending_work_lock);
-  return !m_pending_work.empty() || m_busy_workers.load() != 0;
+  return m_pending_items.load() != 0 || m_busy_workers.load() != 0;
 }
 
 bool AsyncShaderCompiler::HasCompletedWork()
@@ -88,10 +140,8 @@ bool AsyncShaderCompiler::WaitUntilCompletion(
   // Grab the number of pending items. We use this to work out how many are left.
   size_t total_items;
   {
-    // Safe to hold both locks here, since nowhere else does.
-    std::lock_guard<std::mutex> pending_guard(m_pending_work_lock);
     std::lock_guard<std::mutex> completed_guard(m_completed_work_lock);
-    total_items = m_completed_work.size() + m_pending_work.size() + m_busy_workers.load() + 1;
+    total_items = m_completed_work.size() + m_pending_items.load() + m_busy_workers.load() + 1;
   }
 
   // Update progress while the compiles complete.
@@ -100,13 +150,9 @@ bool AsyncShaderCompiler::WaitUntilCompletion(
     if (Core::GetState(Core::System::GetInstance()) == Core::State::Stopping)
       return false;
 
-    size_t remaining_items;
-    {
-      std::lock_guard<std::mutex> pending_guard(m_pending_work_lock);
-      if (m_pending_work.empty() && !m_busy_workers.load())
-        break;
-      remaining_items = m_pending_work.size();
-    }
+    if (!HasPendingWork())
+      break;
+    const size_t remaining_items = m_pending_items.load();
 
     progress_callback(total_items - remaining_items, total_items);
     std::this_thread::sleep_for(CHECK_INTERVAL);
@@ -119,6 +165,9 @@ bool AsyncShaderCompiler::StartWorkerThreads(u32 num_worker_threads)
   if (num_worker_threads == 0)
     return true;
 
+  while (m_worker_queues.size() < num_worker_threads)
+    m_worker_queues.push_back(std::make_unique<WorkerQueue>());
+
   for (u32 i = 0; i < num_worker_threads; i++)
   {
     void* thread_param = nullptr;
@@ -130,7 +179,8 @@ bool AsyncShaderCompiler::StartWorkerThreads(u32 num_worker_threads)
 
     m_worker_thread_start_result.store(false);
 
-    std::thread thr(&AsyncShaderCompiler::WorkerThreadEntryPoint, this, thread_param);
+    std::thread thr(&AsyncShaderCompiler::WorkerThreadEntryPoint, this, thread_param,
+                    static_cast<size_t>(i));
     m_init_event.Wait();
 
     if (!m_worker_thread_start_result.load())
@@ -166,11 +216,8 @@ void AsyncShaderCompiler::StopWorkerThreads()
     return;
 
   // Signal worker threads to stop, and wake all of them.
-  {
-    std::lock_guard<std::mutex> guard(m_pending_work_lock);
-    m_exit_flag.Set();
-    m_worker_thread_wake.notify_all();
-  }
+  m_exit_flag.Set();
+  WakeWorkerThreads(true);
 
   // Wait for worker threads to exit.
   for (std::thread& thr : m_worker_threads)
@@ -193,9 +240,10 @@ void AsyncShaderCompiler::WorkerThreadExit(void* param)
 {
 }
 
-void AsyncShaderCompiler::WorkerThreadEntryPoint(void* param)
+void AsyncShaderCompiler::WorkerThreadEntryPoint(void* param, size_t worker_index)
 {
   Common::SetCurrentThreadName("AsyncShaderCompiler Worker");
+  Common::SetCurrentThreadRole(Common::ThreadRole::Background);
 
   // Initialize worker thread with backend-specific method.
   if (!WorkerThreadInitWorkerThread(param))
@@ -209,36 +257,114 @@ void AsyncShaderCompiler::WorkerThreadEntryPoint(void* param)
   m_worker_thread_start_result.store(true);
   m_init_event.Set();
 
-  WorkerThreadRun();
+  WorkerThreadRun(worker_index);
 
   WorkerThreadExit(param);
 }
 
-void AsyncShaderCompiler::WorkerThreadRun()
+void AsyncShaderCompiler::WorkerThreadRun(size_t worker_index)
 {
-  std::unique_lock<std::mutex> pending_lock(m_pending_work_lock);
   while (!m_exit_flag.IsSet())
   {
-    m_worker_thread_wake.wait(pending_lock);
+    QueuedWorkItemPtr queued_item = TakeWorkItem(worker_index);
+    if (!queued_item)
+    {
+      std::unique_lock<std::mutex> wake_lock(m_wake_lock);
+      m_worker_thread_wake.wait(wake_lock, [this] {
+        return m_exit_flag.IsSet() || m_pending_items.load() != 0;
+      });
+      continue;
+    }
+
+    WorkItemPtr item = std::move(queued_item->item);
+    const bool completed = item->Compile();
+    g_perf_metrics.CountShaderCompile(Clock::now() - queued_item->queue_time);
+    queued_item.reset();
+
+    if (completed)
+    {
+      std::lock_guard<std::mutex> completed_guard(m_completed_work_lock);
+      m_completed_work.push_back(std::move(item));
+    }
+
+    m_busy_workers--;
+  }
+}
 
-    while (!m_pending_work.empty() && !m_exit_flag.IsSet())
+AsyncShaderCompiler::QueuedWorkItemPtr AsyncShaderCompiler::TakeWorkItem(size_t worker_index)
+{
+  {
+    std::lock_guard<std::mutex> guard(m_boosted_work_lock);
+    while (!m_boosted_work.empty())
     {
-      m_busy_workers++;
-      auto iter = m_pending_work.begin();
-      WorkItemPtr item(std::move(iter->second));
-      m_pending_work.erase(iter);
-      pending_lock.unlock();
+      QueuedWorkItemPtr queued_item = std::move(m_boosted_work.front());
+      m_boosted_work.pop_front();
+      if (TryTakeWorkItem(*queued_item))
+        return queued_item;
+    }
+  }
 
-      if (item->Compile())
+  for (;;)
+  {
+    // Take the most urgent item of any queue, starting with our own one for equal priorities.
+    WorkerQueue* best_queue = nullptr;
+    u32 best_priority = NO_PRIORITY;
+    for (size_t i = 0; i < m_worker_queues.size(); i++)
+    {
+      WorkerQueue& queue = *m_worker_queues[(worker_index + i) % m_worker_queues.size()];
+      const u32 priority = queue.front_priority.load(std::memory_order_relaxed);
+      if (priority < best_priority)
       {
-        std::lock_guard<std::mutex> completed_guard(m_completed_work_lock);
-        m_completed_work.push_back(std::move(item));
+        best_queue = &queue;
+        best_priority = priority;
       }
+    }
+    if (!best_queue)
+      return nullptr;
 
-      pending_lock.lock();
-      m_busy_workers--;
+    QueuedWorkItemPtr queued_item;
+    {
+      std::lock_guard<std::mutex> guard(best_queue->lock);
+      if (best_queue->items.empty())
+        continue;
+
+      const auto iter = best_queue->items.begin();
+      queued_item = std::move(iter->second);
+      best_queue->items.erase(iter);
+      best_queue->front_priority.store(
+          best_queue->items.empty() ? NO_PRIORITY : best_queue->items.begin()->first,
+          std::memory_order_relaxed);
     }
+
+    // Boosted items may have been taken from m_boosted_work already.
+    if (TryTakeWorkItem(*queued_item))
+      return queued_item;
+  }
+}
+
+bool AsyncShaderCompiler::TryTakeWorkItem(QueuedWorkItem& queued_item)
+{
+  if (queued_item.taken.test_and_set())
+    return false;
+
+  // Count the worker as busy before the item stops being pending, so that HasPendingWork() can't
+  // miss it in between.
+  m_busy_workers++;
+  m_pending_items--;
+  return true;
+}
+
+void AsyncShaderCompiler::WakeWorkerThreads(bool all)
+{
+  // Taking the lock makes sure that a worker thread which is about to wait sees the new state.
+  {
+    std::lock_guard<std::mutex> guard(m_wake_lock);
   }
+
+  if (all)
+    m_worker_thread_wake.notify_all();
+  else
+    m_worker_thread_wake.notify_one();
 }
 
 }  // namespace VideoCommon
@@ -7,6 +7,7 @@
 #include <condition_variable>
 #include <deque>
 #include <functional>
+#include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -22,6 +23,9 @@ namespace VideoCommon
 {
 class AsyncShaderCompiler
 {
+private:
+  struct QueuedWorkItem;
+
 public:
   class WorkItem
   {
@@ -33,6 +37,10 @@ public:
 
   using WorkItemPtr = std::unique_ptr<WorkItem>;
 
+  // Refers to a queued work item, so that it can be boosted later on. Expires once the work item
+  // has been compiled.
+  using WorkItemHandle = std::weak_ptr<QueuedWorkItem>;
+
   AsyncShaderCompiler();
   virtual ~AsyncShaderCompiler();
 
@@ -44,7 +52,15 @@ public:
 
   // Queues a new work item to the compiler threads. The lower the priority, the sooner
   // this work item will be compiled, relative to the other work items.
-  void QueueWorkItem(WorkItemPtr item, u32 priority);
+  WorkItemHandle QueueWorkItem(WorkItemPtr item, u32 priority);
+
+  // Moves a queued work item ahead of every work item which hasn't been boosted.
+  void BoostWorkItem(const WorkItemHandle& handle);
+
+  // Drops every work item which hasn't been started yet, without compiling or retrieving it.
+  // Used when the queued work is stale, e.g. because the shaders are about to be recreated anyway.
+  void CancelPendingWork();
+
   void RetrieveWorkItems();
   bool HasPendingWork();
   bool HasCompletedWork();
@@ -65,8 +81,36 @@ protected:
   virtual void WorkerThreadExit(void* param);
 
 private:
-  void WorkerThreadEntryPoint(void* param);
-  void WorkerThreadRun();
+  struct QueuedWorkItem
+  {
+    WorkItemPtr item;
+    TimePoint queue_time;
+    // Set by whichever thread gets to compile or cancel the item. Boosted items are also in
+    // m_boosted_work, so they can be found in two queues.
+    std::atomic_flag taken;
+    std::atomic_bool boosted{false};
+  };
+  using QueuedWorkItemPtr = std::shared_ptr<QueuedWorkItem>;
+
+  // Every worker thread mostly takes work from its own queue, and steals from the others when
+  // they have more urgent work.
+  struct WorkerQueue
+  {
+    // A multimap is used to store the work items. We can't use a priority_queue here, because
+    // there's no way to obtain a non-const reference, which we need for the unique_ptr.
+    std::multimap<u32, QueuedWorkItemPtr> items;
+    std::mutex lock;
+    // Priority of the first item, so that other workers can pick a queue without locking it.
+    std::atomic<u32> front_priority{NO_PRIORITY};
+  };
+
+  static constexpr u32 NO_PRIORITY = std::numeric_limits<u32>::max();
+
+  void WorkerThreadEntryPoint(void* param, size_t worker_index);
+  void WorkerThreadRun(size_t worker_index);
+  QueuedWorkItemPtr TakeWorkItem(size_t worker_index);
+  bool TryTakeWorkItem(QueuedWorkItem& queued_item);
+  void WakeWorkerThreads(bool all);
 
   Common::Flag m_exit_flag;
   Common::Event m_init_event;
@@ -74,12 +118,17 @@ private:
   std::vector<std::thread> m_worker_threads;
   std::atomic_bool m_worker_thread_start_result{false};
 
-  // A multimap is used to store the work items. We can't use a priority_queue here, because
-  // there's no way to obtain a non-const reference, which we need for the unique_ptr.
-  std::multimap<u32, WorkItemPtr> m_pending_work;
-  std::mutex m_pending_work_lock;
-  std::condition_variable m_worker_thread_wake;
+  // Queues are only ever added, since they can still hold work when the threads are resized.
+  std::vector<std::unique_ptr<WorkerQueue>> m_worker_queues;
+  size_t m_next_worker_queue = 0;
+  std::deque<QueuedWorkItemPtr> m_boosted_work;
+  std::mutex m_boosted_work_lock;
+
+  // Number of queued work items which haven't been taken yet.
+  std::atomic_size_t m_pending_items{0};
   std::atomic_size_t m_busy_workers{0};
+  std::mutex m_wake_lock;
+  std::condition_variable m_worker_thread_wake;
 
   std::deque<WorkItemPtr> m_completed_work;
   std::mutex m_completed_work_lock;
@@ -400,6 +400,7 @@ static void BPWritten(PixelShaderManager& pixel_shader_manager, XFStateManager&
         (1 << bpmem.tmem_config.tlut_dest.tmem_line_count.NumBits()) * TMEM_LINE_SIZE;
     static_assert(MAX_LOADABLE_TMEM_ADDR + MAX_TMEM_LINE_COUNT < TMEM_SIZE);
 
+    g_texture_cache->FlushEFBCopiesInRange(addr, tmem_transfer_count);
     auto& memory = system.GetMemory();
     memory.CopyFromEmu(s_tex_mem.data() + tmem_addr, addr, tmem_transfer_count);
 
@@ -588,6 +589,10 @@ static void BPWritten(PixelShaderManager& pixel_shader_manager, XFStateManager&
       u32 bytes_read = 0;
       u32 tmem_addr_even = tmem_cfg.preload_tmem_even * TMEM_LINE_SIZE;
 
+      const u32 preload_size = tmem_cfg.preload_tile_info.count * TMEM_LINE_SIZE *
+                               (tmem_cfg.preload_tile_info.type == 3 ? 2 : 1);
+      g_texture_cache->FlushEFBCopiesInRange(src_addr, preload_size);
+
       if (tmem_cfg.preload_tile_info.type != 3)
       {
         if (tmem_addr_even < TMEM_SIZE)
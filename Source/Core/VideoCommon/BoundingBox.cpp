@@ -4,6 +4,7 @@
 #include "VideoCommon/BoundingBox.h"
 
 #include <algorithm>
+#include <utility>
 
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
@@ -34,6 +35,10 @@ void BoundingBox::Flush()
 
   m_is_valid = false;
 
+  // A read started before this draw would miss it, which is only acceptable for late readback.
+  if (!g_ActiveConfig.bBBoxLateReadback)
+    m_async_read_pending = false;
+
   if (std::none_of(m_dirty.begin(), m_dirty.end(), [](bool dirty) { return dirty; }))
     return;
 
@@ -55,12 +60,43 @@ void BoundingBox::Flush()
   }
 }
 
+void BoundingBox::AfterDraw()
+{
+  // Only copy the values back when the game is reading them, as the copy splits the render pass.
+  if (!m_was_read)
+    return;
+
+  // Late reads wait for the copy in flight to arrive rather than replacing it, or they would never
+  // get any values while the game keeps drawing.
+  if (m_async_read_pending && g_ActiveConfig.bBBoxLateReadback)
+    return;
+
+  m_was_read = false;
+  m_async_read_pending = StartAsyncRead();
+}
+
 void BoundingBox::Readback()
 {
   if (!g_ActiveConfig.backend_info.bSupportsBBox)
     return;
 
-  auto read_values = Read(0, NUM_BBOX_VALUES);
+  std::vector<BBoxType> read_values;
+  if (m_async_read_pending)
+  {
+    auto async_values = FinishAsyncRead(!g_ActiveConfig.bBBoxLateReadback);
+    if (!async_values)
+    {
+      // Keep returning the values of an earlier draw until the copy arrives.
+      return;
+    }
+
+    m_async_read_pending = false;
+    read_values = std::move(*async_values);
+  }
+  else
+  {
+    read_values = Read(0, NUM_BBOX_VALUES);
+  }
 
   // Preserve dirty values, that way we don't need to sync.
   for (u32 i = 0; i < NUM_BBOX_VALUES; i++)
@@ -79,6 +115,7 @@ u16 BoundingBox::Get(u32 index)
   if (!g_ActiveConfig.bBBoxEnable || !g_ActiveConfig.backend_info.bSupportsBBox)
     return m_bounding_box_fallback[index];
 
+  m_was_read = true;
   if (!m_is_valid)
     Readback();
 
@@ -122,6 +159,8 @@ void BoundingBox::DoState(PointerWrap& p)
 
     if (g_ActiveConfig.backend_info.bSupportsBBox)
       Write(0, backend_values);
+
+    m_async_read_pending = false;
   }
   else
   {
@@ -5,6 +5,7 @@
 
 #include <array>
 #include <memory>
+#include <optional>
 #include <span>
 #include <vector>
 
@@ -27,6 +28,8 @@ public:
   void Disable(PixelShaderManager& pixel_shader_manager);
 
   void Flush();
+  // Called after a draw with bounding box enabled
+  void AfterDraw();
 
   u16 Get(u32 index);
   void Set(u32 index, u16 value);
@@ -41,6 +44,13 @@ protected:
   virtual std::vector<BBoxType> Read(u32 index, u32 length) = 0;
   virtual void Write(u32 index, std::span<const BBoxType> values) = 0;
 
+  // Starts copying all the values to the CPU without waiting for the GPU. Backends which can't do
+  // this return false, in which case the values are always read synchronously.
+  virtual bool StartAsyncRead() { return false; }
+  // Returns the values copied by the last StartAsyncRead, or std::nullopt if wait is false and the
+  // GPU hasn't executed the copy yet.
+  virtual std::optional<std::vector<BBoxType>> FinishAsyncRead(bool wait) { return std::nullopt; }
+
 private:
   void Readback();
 
@@ -50,6 +60,11 @@ private:
   std::array<bool, NUM_BBOX_VALUES> m_dirty = {};
   bool m_is_valid = true;
 
+  // Whether the game has read the values since the last async read was started, and whether that
+  // read is still to be used.
+  bool m_was_read = false;
+  bool m_async_read_pending = false;
+
   // Nintendo's SDK seems to write "default" bounding box values before every draw (1023 0 1023 0
   // are the only values encountered so far, which happen to be the extents allowed by the BP
   // registers) to reset the registers for comparison in the pixel engine, and presumably to detect
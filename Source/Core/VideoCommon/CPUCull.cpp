@@ -110,6 +110,35 @@ static CPUCull::CullFunction GetCullFunction0()
 #endif
 }
 
+template <OpcodeDecoder::Primitive Primitive, CullMode Mode>
+static CPUCull::CullPrimitivesFunction GetCullPrimitivesFunction0()
+{
+#if defined(USE_SSE)
+  if (MIN_SSE >= 50 || cpu_info.bAVX)
+    return CPUCull_AVX::CullPrimitives<Primitive, Mode>;
+  else if (MIN_SSE >= 30 || cpu_info.bSSE3)
+    return CPUCull_SSE3::CullPrimitives<Primitive, Mode>;
+  else
+    return CPUCull_SSE::CullPrimitives<Primitive, Mode>;
+#elif defined(USE_NEON)
+  return CPUCull_NEON::CullPrimitives<Primitive, Mode>;
+#else
+  return CPUCull_Scalar::CullPrimitives<Primitive, Mode>;
+#endif
+}
+
+template <OpcodeDecoder::Primitive Primitive>
+static Common::EnumMap<CPUCull::CullPrimitivesFunction, CullMode::All>
+GetCullPrimitivesFunction1()
+{
+  return {
+      GetCullPrimitivesFunction0<Primitive, CullMode::None>(),
+      GetCullPrimitivesFunction0<Primitive, CullMode::Back>(),
+      GetCullPrimitivesFunction0<Primitive, CullMode::Front>(),
+      GetCullPrimitivesFunction0<Primitive, CullMode::All>(),
+  };
+}
+
 template <OpcodeDecoder::Primitive Primitive>
 static Common::EnumMap<CPUCull::CullFunction, CullMode::All> GetCullFunction1()
 {
@@ -135,13 +164,19 @@ void CPUCull::Init()
   m_cull_table[Prim::GX_DRAW_TRIANGLES] = GetCullFunction1<Prim::GX_DRAW_TRIANGLES>();
   m_cull_table[Prim::GX_DRAW_TRIANGLE_STRIP] = GetCullFunction1<Prim::GX_DRAW_TRIANGLE_STRIP>();
   m_cull_table[Prim::GX_DRAW_TRIANGLE_FAN] = GetCullFunction1<Prim::GX_DRAW_TRIANGLE_FAN>();
+  m_cull_primitives_table[Prim::GX_DRAW_QUADS] = GetCullPrimitivesFunction1<Prim::GX_DRAW_QUADS>();
+  m_cull_primitives_table[Prim::GX_DRAW_QUADS_2] =
+      GetCullPrimitivesFunction1<Prim::GX_DRAW_QUADS>();
+  m_cull_primitives_table[Prim::GX_DRAW_TRIANGLES] =
+      GetCullPrimitivesFunction1<Prim::GX_DRAW_TRIANGLES>();
+  m_cull_primitives_table[Prim::GX_DRAW_TRIANGLE_STRIP] =
+      GetCullPrimitivesFunction1<Prim::GX_DRAW_TRIANGLE_STRIP>();
+  m_cull_primitives_table[Prim::GX_DRAW_TRIANGLE_FAN] =
+      GetCullPrimitivesFunction1<Prim::GX_DRAW_TRIANGLE_FAN>();
 }
 
-bool CPUCull::AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
-                                   const u8* src, u32 count)
+CullMode CPUCull::TransformVertices(VertexLoaderBase* loader, const u8* src, u32 count)
 {
-  ASSERT_MSG(VIDEO, primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES,
-             "CPUCull should not be called on lines or points");
   const u32 stride = loader->m_native_vtx_decl.stride;
   const bool posHas3Elems = loader->m_native_vtx_decl.position.components >= 3;
   const bool perVertexPosMtx = loader->m_native_vtx_decl.posmtx.enable;
@@ -165,10 +200,29 @@ bool CPUCull::AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Prim
     cullmode = cullmode_invert[cullmode];
   const TransformFunction transform = m_transform_table[posHas3Elems][perVertexPosMtx];
   transform(m_transform_buffer.get(), src, stride, count);
+  return cullmode;
+}
+
+bool CPUCull::AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
+                                   const u8* src, u32 count)
+{
+  ASSERT_MSG(VIDEO, primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES,
+             "CPUCull should not be called on lines or points");
+  const CullMode cullmode = TransformVertices(loader, src, count);
   const CullFunction cull = m_cull_table[primitive][cullmode];
   return cull(m_transform_buffer.get(), count);
 }
 
+u32 CPUCull::CullPrimitives(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
+                            const u8* src, u32 count, u16* out_indices)
+{
+  ASSERT_MSG(VIDEO, primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES,
+             "CPUCull should not be called on lines or points");
+  const CullMode cullmode = TransformVertices(loader, src, count);
+  const CullPrimitivesFunction cull = m_cull_primitives_table[primitive][cullmode];
+  return cull(m_transform_buffer.get(), count, out_indices);
+}
+
 template <typename T>
 void CPUCull::BufferDeleter<T>::operator()(T* ptr)
 {
@@ -14,6 +14,10 @@ public:
   void Init();
   bool AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
                             const u8* src, u32 count);
+  // Writes the vertex indices of every triangle which is not culled to out_indices, which needs
+  // room for three indices per triangle of the primitive, and returns the number of triangles.
+  u32 CullPrimitives(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive, const u8* src,
+                     u32 count, u16* out_indices);
 
   struct alignas(16) TransformedVertex
   {
@@ -22,6 +26,7 @@ public:
 
   using TransformFunction = void (*)(void*, const void*, u32, int);
   using CullFunction = bool (*)(const CPUCull::TransformedVertex*, int);
+  using CullPrimitivesFunction = u32 (*)(const CPUCull::TransformedVertex*, int, u16*);
 
 private:
   template <typename T>
@@ -35,4 +40,10 @@ private:
   Common::EnumMap<Common::EnumMap<CullFunction, CullMode::All>,
                   OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_FAN>
       m_cull_table{};
+  Common::EnumMap<Common::EnumMap<CullPrimitivesFunction, CullMode::All>,
+                  OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_FAN>
+      m_cull_primitives_table{};
+
+  // Transforms the vertices to clip space and returns the cull mode to test them against.
+  CullMode TransformVertices(VertexLoaderBase* loader, const u8* src, u32 count);
 };
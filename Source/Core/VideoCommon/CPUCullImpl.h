@@ -708,6 +708,65 @@ ATTR_TARGET static bool AreAllVerticesCulled(const CPUCull::TransformedVertex* t
   return true;
 }
 
+template <CullMode Mode>
+ATTR_TARGET DOLPHIN_FORCE_INLINE static u16*
+KeepTriangle(const CPUCull::TransformedVertex* transformed, u16* out, u16 a, u16 b, u16 c)
+{
+  if (!CullTriangle<Mode>(transformed[a], transformed[b], transformed[c]))
+  {
+    out[0] = a;
+    out[1] = b;
+    out[2] = c;
+    out += 3;
+  }
+  return out;
+}
+
+template <OpcodeDecoder::Primitive Primitive, CullMode Mode>
+ATTR_TARGET static u32 CullPrimitives(const CPUCull::TransformedVertex* transformed, int count,
+                                      u16* out)
+{
+  // Triangles are emitted with the same vertex order IndexGenerator uses without primitive restart.
+  u16* const out_start = out;
+  switch (Primitive)
+  {
+  case OpcodeDecoder::Primitive::GX_DRAW_QUADS:
+  case OpcodeDecoder::Primitive::GX_DRAW_QUADS_2:
+  {
+    int i = 3;
+    for (; i < count; i += 4)
+    {
+      out = KeepTriangle<Mode>(transformed, out, i - 3, i - 2, i - 1);
+      out = KeepTriangle<Mode>(transformed, out, i - 3, i - 1, i - 0);
+    }
+    // three vertices remaining, so render a triangle
+    if (i == count)
+      out = KeepTriangle<Mode>(transformed, out, i - 3, i - 2, i - 1);
+    break;
+  }
+  case OpcodeDecoder::Primitive::GX_DRAW_TRIANGLES:
+    for (int i = 2; i < count; i += 3)
+      out = KeepTriangle<Mode>(transformed, out, i - 2, i - 1, i - 0);
+    break;
+  case OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_STRIP:
+  {
+    bool wind = false;
+    for (int i = 2; i < count; ++i)
+    {
+      out = KeepTriangle<Mode>(transformed, out, i - 2, i - !wind, i - wind);
+      wind = !wind;
+    }
+    break;
+  }
+  case OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_FAN:
+    for (int i = 2; i < count; ++i)
+      out = KeepTriangle<Mode>(transformed, out, 0, i - 1, i);
+    break;
+  }
+
+  return static_cast<u32>(out - out_start) / 3;
+}
+
 }  // namespace VECTOR_NAMESPACE
 
 #undef ATTR_TARGET
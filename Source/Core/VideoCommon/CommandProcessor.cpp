@@ -326,11 +326,15 @@ void CommandProcessorManager::RegisterMMIO(MMIO::Mapping* mmio, u32 base)
   MMIO::WriteHandlingMethod<u16>* fifo_read_hi_w;
   if (is_on_thread)
   {
-    fifo_read_hi_r = MMIO::ComplexRead<u16>([](Core::System& system_, u32) {
-      auto& fifo_ = system_.GetCommandProcessor().GetFifo();
-      system_.GetFifo().SyncGPUForRegisterAccess();
-      return fifo_.SafeCPReadPointer.load(std::memory_order_relaxed) >> 16;
-    });
+    // Games poll this while waiting for the GPU, so let the JITs read it inline unless a sync is
+    // needed.
+    fifo_read_hi_r = MMIO::ConditionalDirectRead<u16>(
+        MMIO::Utils::HighPart(&m_fifo.SafeCPReadPointer),
+        m_system.GetFifo().GetRegisterAccessNeedsNoSync(), [](Core::System& system_, u32) {
+          auto& fifo_ = system_.GetCommandProcessor().GetFifo();
+          system_.GetFifo().SyncGPUForRegisterAccess();
+          return fifo_.SafeCPReadPointer.load(std::memory_order_relaxed) >> 16;
+        });
     fifo_read_hi_w =
         MMIO::ComplexWrite<u16>([WMASK_HI_RESTRICT](Core::System& system_, u32, u16 val) {
           auto& fifo_ = system_.GetCommandProcessor().GetFifo();
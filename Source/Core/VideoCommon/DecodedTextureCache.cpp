@@ -0,0 +1,77 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/DecodedTextureCache.h"
+
+#include <fmt/format.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+#include "Core/ConfigManager.h"
+
+namespace VideoCommon
+{
+// Bump this whenever the output of the texture decoders changes, so that stale entries are
+// no longer used.
+static constexpr u32 CACHE_VERSION = 1;
+
+DecodedTextureCache::DecodedTextureCache()
+{
+  m_write_thread.Reset("Decoded Texture Writer", WriteFile);
+}
+
+DecodedTextureCache::~DecodedTextureCache()
+{
+  m_write_thread.Shutdown();
+}
+
+std::string DecodedTextureCache::GetFilename(const Key& key)
+{
+  return fmt::format("{}DecodedTextures/v{}/{}/{:016x}_{}_{}_{}x{}_{}.bin",
+                     File::GetUserPath(D_CACHE_IDX), CACHE_VERSION,
+                     SConfig::GetInstance().GetGameID(), key.hash, static_cast<int>(key.format),
+                     static_cast<int>(key.tlut_format), key.width, key.height, key.levels);
+}
+
+bool DecodedTextureCache::Load(const Key& key, u8* dst, size_t size)
+{
+  File::IOFile file(GetFilename(key), "rb");
+  if (!file.IsOpen() || file.GetSize() != size)
+    return false;
+
+  return file.ReadBytes(dst, size);
+}
+
+void DecodedTextureCache::Store(const Key& key, const u8* data, size_t size)
+{
+  m_write_thread.EmplaceItem(GetFilename(key), std::vector<u8>(data, data + size));
+}
+
+void DecodedTextureCache::WriteFile(WriteRequest request)
+{
+  const auto& [filename, data] = request;
+  if (File::Exists(filename))
+    return;
+
+  // Write to a temporary file first so that an interrupted write never leaves a truncated entry
+  // which would then be loaded in a later session.
+  const std::string temp_filename = filename + ".tmp";
+  File::CreateFullPath(filename);
+  {
+    File::IOFile file(temp_filename, "wb");
+    if (!file.WriteBytes(data.data(), data.size()))
+    {
+      WARN_LOG_FMT(VIDEO, "Failed to write decoded texture cache entry {}", filename);
+      file.Close();
+      File::Delete(temp_filename);
+      return;
+    }
+  }
+
+  if (!File::Rename(temp_filename, filename))
+    File::Delete(temp_filename);
+}
+}  // namespace VideoCommon
@@ -0,0 +1,55 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
+#include "VideoCommon/TextureDecoder.h"
+
+namespace VideoCommon
+{
+// Keeps the CPU-decoded contents of large textures on disk, so that later sessions only have to
+// hash a texture instead of decoding it again. Entries are addressed by the texture's full hash
+// (which covers the palette of paletted textures) together with its format and dimensions.
+class DecodedTextureCache
+{
+public:
+  struct Key
+  {
+    u64 hash;
+    TextureFormat format;
+    TLUTFormat tlut_format;
+    u32 width;
+    u32 height;
+    u32 levels;
+  };
+
+  DecodedTextureCache();
+  ~DecodedTextureCache();
+
+  // Only textures with at least this many texels in their base level are cached. Decoding smaller
+  // textures is cheaper than opening a file.
+  static constexpr u32 MIN_TEXELS = 256 * 256;
+
+  // Reads the decoded levels of the texture into dst. Returns false if the texture is not cached
+  // or the cached data does not have exactly the given size.
+  bool Load(const Key& key, u8* dst, size_t size);
+
+  // Writes a copy of the decoded levels to the cache on a worker thread.
+  void Store(const Key& key, const u8* data, size_t size);
+
+private:
+  using WriteRequest = std::pair<std::string, std::vector<u8>>;
+
+  static std::string GetFilename(const Key& key);
+  static void WriteFile(WriteRequest request);
+
+  Common::WorkQueueThread<WriteRequest> m_write_thread;
+};
+}  // namespace VideoCommon
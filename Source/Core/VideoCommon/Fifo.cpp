@@ -3,7 +3,9 @@
 
 #include "VideoCommon/Fifo.h"
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstring>
 
 #include "Common/Assert.h"
@@ -11,8 +13,11 @@
 #include "Common/ChunkFile.h"
 #include "Common/Event.h"
 #include "Common/FPURoundMode.h"
+#include "Common/Logging/Log.h"
 #include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/Timer.h"
+#include "Common/Tracing.h"
 
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
@@ -28,6 +33,7 @@
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/PerformanceMetrics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoBackendBase.h"
@@ -48,6 +54,18 @@ void FifoManager::RefreshConfig()
   m_config_sync_gpu_max_distance = Config::Get(Config::MAIN_SYNC_GPU_MAX_DISTANCE);
   m_config_sync_gpu_min_distance = Config::Get(Config::MAIN_SYNC_GPU_MIN_DISTANCE);
   m_config_sync_gpu_overclock = Config::Get(Config::MAIN_SYNC_GPU_OVERCLOCK);
+  UpdateRegisterAccessNeedsNoSync();
+
+  m_gpu_mainloop.SetAdaptiveSpinning(
+      Config::Get(Config::MAIN_GPU_ADAPTIVE_SPIN),
+      std::chrono::microseconds(std::max(Config::Get(Config::MAIN_GPU_SPIN_MIN_US), 0)),
+      std::chrono::microseconds(std::max(Config::Get(Config::MAIN_GPU_SPIN_MAX_US), 0)));
+}
+
+void FifoManager::UpdateRegisterAccessNeedsNoSync()
+{
+  m_register_access_needs_no_sync =
+      m_system.IsDualCoreMode() && !m_use_deterministic_gpu_thread && !m_config_sync_gpu;
 }
 
 void FifoManager::DoState(PointerWrap& p)
@@ -105,6 +123,17 @@ void FifoManager::Shutdown()
   if (m_gpu_mainloop.IsRunning())
     PanicAlertFmt("FIFO shutting down while active");
 
+  if (m_system.IsDualCoreMode())
+  {
+    const Common::BlockingLoop::Statistics stats = m_gpu_mainloop.GetStatistics();
+    INFO_LOG_FMT(COMMANDPROCESSOR,
+                 "GPU thread slept {} times, was woken {} times with {} us average latency, "
+                 "found new work while spinning {} times, final spin duration {} us",
+                 stats.sleeps, stats.wakeups,
+                 stats.wakeups ? stats.total_wakeup_latency.count() / stats.wakeups : 0,
+                 stats.spin_hits, stats.spin_duration.count());
+  }
+
   Common::FreeMemoryPages(m_video_buffer, FIFO_SIZE + 4);
   m_video_buffer = nullptr;
   m_video_buffer_write_ptr = nullptr;
@@ -307,6 +336,9 @@ void FifoManager::RunGpuLoop()
           // See comment in SyncGPU
           if (write_ptr > seen_ptr)
           {
+            Common::Tracing::ScopedEvent trace_event("gpu", "Run FIFO");
+            PerformanceMetrics::ScopedFrameSection frame_section(
+                PerformanceMetrics::FrameSection::FifoParse);
             m_video_buffer_read_ptr =
                 OpcodeDecoder::RunFifo(DataReader(m_video_buffer_read_ptr, write_ptr), nullptr);
             m_video_buffer_seen_ptr = write_ptr;
@@ -318,6 +350,11 @@ void FifoManager::RunGpuLoop()
           auto& fifo = command_processor.GetFifo();
           command_processor.SetCPStatusFromGPU();
 
+          // Only add an event to the trace if there was something to run, as this is reached
+          // every time the GPU thread wakes up.
+          const u64 trace_start_us = Common::Tracing::IsEnabled() ? Common::Timer::NowUs() : 0;
+          bool ran_commands = false;
+
           // check if we are able to run this buffer
           while (!command_processor.IsInterruptWaiting() &&
                  fifo.bFF_GPReadEnable.load(std::memory_order_relaxed) &&
@@ -327,6 +364,7 @@ void FifoManager::RunGpuLoop()
             if (m_config_sync_gpu && m_sync_ticks.load() < m_config_sync_gpu_min_distance)
               break;
 
+            ran_commands = true;
             u32 cyclesExecuted = 0;
             u32 readPtr = fifo.CPReadPointer.load(std::memory_order_relaxed);
             ReadDataFromFifo(readPtr);
@@ -345,8 +383,12 @@ void FifoManager::RunGpuLoop()
                        distance);
 
             u8* write_ptr = m_video_buffer_write_ptr;
-            m_video_buffer_read_ptr = OpcodeDecoder::RunFifo(
-                DataReader(m_video_buffer_read_ptr, write_ptr), &cyclesExecuted);
+            {
+              PerformanceMetrics::ScopedFrameSection frame_section(
+                  PerformanceMetrics::FrameSection::FifoParse);
+              m_video_buffer_read_ptr = OpcodeDecoder::RunFifo(
+                  DataReader(m_video_buffer_read_ptr, write_ptr), &cyclesExecuted);
+            }
 
             fifo.CPReadPointer.store(readPtr, std::memory_order_relaxed);
             fifo.CPReadWriteDistance.fetch_sub(GPFifo::GATHER_PIPE_SIZE, std::memory_order_seq_cst);
@@ -376,6 +418,12 @@ void FifoManager::RunGpuLoop()
             AsyncRequests::GetInstance()->PullEvents();
           }
 
+          if (ran_commands && trace_start_us != 0)
+          {
+            Common::Tracing::AddEvent("gpu", "Run FIFO", trace_start_us,
+                                      Common::Timer::NowUs() - trace_start_us);
+          }
+
           // fast skip remaining GPU time if fifo is empty
           if (m_sync_ticks.load() > 0)
           {
@@ -465,8 +513,12 @@ int FifoManager::RunGpuOnCpu(int ticks)
       }
       ReadDataFromFifo(fifo.CPReadPointer.load(std::memory_order_relaxed));
       u32 cycles = 0;
-      m_video_buffer_read_ptr = OpcodeDecoder::RunFifo(
-          DataReader(m_video_buffer_read_ptr, m_video_buffer_write_ptr), &cycles);
+      {
+        PerformanceMetrics::ScopedFrameSection frame_section(
+            PerformanceMetrics::FrameSection::FifoParse);
+        m_video_buffer_read_ptr = OpcodeDecoder::RunFifo(
+            DataReader(m_video_buffer_read_ptr, m_video_buffer_write_ptr), &cycles);
+      }
       available_ticks -= cycles;
     }
 
@@ -532,6 +584,7 @@ void FifoManager::UpdateWantDeterminism(bool want)
       CopyPreprocessCPStateFromMain();
       VertexLoaderManager::MarkAllDirty();
     }
+    UpdateRegisterAccessNeedsNoSync();
   }
 }
 
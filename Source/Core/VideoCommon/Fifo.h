@@ -63,12 +63,19 @@ public:
   // In single core mode, this runs the GPU for a single slice.
   // In dual core mode, this synchronizes with the GPU thread.
   void SyncGPUForRegisterAccess();
+  // Points to a flag which is set while SyncGPUForRegisterAccess has nothing to do, so that MMIOs
+  // which would call it can be read directly.
+  const bool* GetRegisterAccessNeedsNoSync() const { return &m_register_access_needs_no_sync; }
 
   void PushFifoAuxBuffer(const void* ptr, size_t size);
   void* PopFifoAuxBuffer(size_t size);
 
   void FlushGpu();
   void RunGpu();
+  Common::BlockingLoop::Statistics GetGpuLoopStatistics() const
+  {
+    return m_gpu_mainloop.GetStatistics();
+  }
   void GpuMaySleep();
   void RunGpuLoop();
   void ExitGpuLoop();
@@ -77,6 +84,7 @@ public:
 
 private:
   void RefreshConfig();
+  void UpdateRegisterAccessNeedsNoSync();
   void ReadDataFromFifo(u32 read_ptr);
   void ReadDataFromFifoOnCPU(u32 read_ptr);
   int RunGpuOnCpu(int ticks);
@@ -97,6 +105,7 @@ private:
   // This could be in SConfig, but it depends on multiple settings
   // and can change at runtime.
   bool m_use_deterministic_gpu_thread = false;
+  bool m_register_access_needs_no_sync = false;
 
   CoreTiming::EventType* m_event_sync_gpu = nullptr;
 
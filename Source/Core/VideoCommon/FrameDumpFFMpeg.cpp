@@ -7,7 +7,10 @@
 #define __STDC_CONSTANT_MACROS 1
 #endif
 
+#include <algorithm>
 #include <array>
+#include <memory>
+#include <span>
 #include <sstream>
 #include <string>
 
@@ -18,6 +21,7 @@ extern "C" {
 #include <libavcodec/avcodec.h>
 #include <libavformat/avformat.h>
 #include <libavutil/error.h>
+#include <libavutil/hwcontext.h>
 #include <libavutil/log.h>
 #include <libavutil/mathematics.h>
 #include <libavutil/opt.h>
@@ -31,6 +35,7 @@ extern "C" {
 #include "Common/Logging/LogManager.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
+#include "Common/WorkQueueThread.h"
 
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
@@ -42,6 +47,12 @@ extern "C" {
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
 
+struct AVPacketDeleter
+{
+  void operator()(AVPacket* packet) const { av_packet_free(&packet); }
+};
+using AVPacketPtr = std::unique_ptr<AVPacket, AVPacketDeleter>;
+
 struct FrameDumpContext
 {
   AVFormatContext* format = nullptr;
@@ -51,7 +62,17 @@ struct FrameDumpContext
   AVFrame* scaled_frame = nullptr;
   SwsContext* sws = nullptr;
 
+  // Set when the encoder takes frames in GPU memory, which scaled_frame is uploaded to.
+  AVBufferRef* hw_device = nullptr;
+  AVBufferRef* hw_frames = nullptr;
+  AVFrame* hw_frame = nullptr;
+
+  // Writes the encoded packets to the file, so that encoding doesn't wait for the disk.
+  Common::WorkQueueThread<AVPacketPtr> writer;
+
   s64 last_pts = AV_NOPTS_VALUE;
+  u32 encoded_frames = 0;
+  u32 dropped_frames = 0;
 
   int width = 0;
   int height = 0;
@@ -158,6 +179,131 @@ std::string AVErrorString(int error)
   return fmt::format("{:8x} {}", (u32)error, &msg[0]);
 }
 
+std::span<const AVPixelFormat> GetSupportedPixelFormats(const AVCodec* codec)
+{
+  const AVPixelFormat* pix_fmts = nullptr;
+  int count = 0;
+#if LIBAVCODEC_VERSION_INT >= AV_VERSION_INT(61, 13, 100)
+  const void* configs = nullptr;
+  if (avcodec_get_supported_config(nullptr, codec, AV_CODEC_CONFIG_PIX_FORMAT, 0, &configs,
+                                   &count) < 0)
+  {
+    return {};
+  }
+  pix_fmts = static_cast<const AVPixelFormat*>(configs);
+#else
+  pix_fmts = codec->pix_fmts;
+  while (pix_fmts && pix_fmts[count] != AV_PIX_FMT_NONE)
+    ++count;
+#endif
+  if (!pix_fmts)
+    return {};
+  return {pix_fmts, static_cast<size_t>(count)};
+}
+
+bool IsMatchingFrameLayout(AVPixelFormat pix_fmt)
+{
+  // Frames are read back as RGBA, and encoders taking RGB0 ignore the alpha byte.
+  return pix_fmt == AV_PIX_FMT_RGBA || pix_fmt == AV_PIX_FMT_RGB0;
+}
+
+// Encoders which only take frames in GPU memory (e.g. VAAPI) need a hardware frames context.
+const AVCodecHWConfig* GetHWFramesConfig(const AVCodec* codec, AVPixelFormat pix_fmt)
+{
+  for (int i = 0;; ++i)
+  {
+    const AVCodecHWConfig* const config = avcodec_get_hw_config(codec, i);
+    if (!config)
+      return nullptr;
+    if (config->pix_fmt == pix_fmt && (config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_FRAMES_CTX))
+      return config;
+  }
+}
+
+AVPixelFormat ChoosePixelFormat(const AVCodec* codec)
+{
+  if (codec->id == AV_CODEC_ID_FFV1)
+    return AV_PIX_FMT_BGR0;
+  if (codec->id == AV_CODEC_ID_UTVIDEO)
+    return AV_PIX_FMT_GBRP;
+
+  const std::span<const AVPixelFormat> pix_fmts = GetSupportedPixelFormats(codec);
+  const auto matching_layout = std::ranges::find_if(pix_fmts, IsMatchingFrameLayout);
+
+  // Hardware encoders converting the colours themselves save the conversion on the CPU.
+  if ((codec->capabilities & AV_CODEC_CAP_HARDWARE) && matching_layout != pix_fmts.end())
+    return *matching_layout;
+
+  if (pix_fmts.empty() || std::ranges::find(pix_fmts, AV_PIX_FMT_YUV420P) != pix_fmts.end())
+    return AV_PIX_FMT_YUV420P;
+
+  if (matching_layout != pix_fmts.end())
+    return *matching_layout;
+
+  // Prefer frames in GPU memory over any other format the CPU would have to convert to.
+  if (const auto it = std::ranges::find_if(
+          pix_fmts, [codec](AVPixelFormat pix_fmt) { return GetHWFramesConfig(codec, pix_fmt); });
+      it != pix_fmts.end())
+  {
+    return *it;
+  }
+  return pix_fmts.front();
+}
+
+AVPixelFormat CreateHWFrames(FrameDumpContext* context, AVHWDeviceType device_type,
+                             AVPixelFormat pix_fmt)
+{
+  if (const int error =
+          av_hwdevice_ctx_create(&context->hw_device, device_type, nullptr, nullptr, 0))
+  {
+    ERROR_LOG_FMT(FRAMEDUMP, "Could not create {} device: {}",
+                  av_hwdevice_get_type_name(device_type), AVErrorString(error));
+    return AV_PIX_FMT_NONE;
+  }
+
+  // Upload frames as NV12 where possible, as that is what hardware encoders work with internally.
+  AVPixelFormat sw_pix_fmt = AV_PIX_FMT_NV12;
+  if (AVHWFramesConstraints* constraints =
+          av_hwdevice_get_hwframe_constraints(context->hw_device, nullptr))
+  {
+    const AVPixelFormat* const formats = constraints->valid_sw_formats;
+    if (formats && formats[0] != AV_PIX_FMT_NONE)
+    {
+      bool has_nv12 = false;
+      for (const AVPixelFormat* format = formats; *format != AV_PIX_FMT_NONE; ++format)
+        has_nv12 |= *format == AV_PIX_FMT_NV12;
+      if (!has_nv12)
+        sw_pix_fmt = formats[0];
+    }
+    av_hwframe_constraints_free(&constraints);
+  }
+
+  context->hw_frames = av_hwframe_ctx_alloc(context->hw_device);
+  if (!context->hw_frames)
+    return AV_PIX_FMT_NONE;
+
+  auto* const frames = reinterpret_cast<AVHWFramesContext*>(context->hw_frames->data);
+  frames->format = pix_fmt;
+  frames->sw_format = sw_pix_fmt;
+  frames->width = context->width;
+  frames->height = context->height;
+  frames->initial_pool_size = 20;
+  if (const int error = av_hwframe_ctx_init(context->hw_frames))
+  {
+    ERROR_LOG_FMT(FRAMEDUMP, "Could not create hardware frames: {}", AVErrorString(error));
+    return AV_PIX_FMT_NONE;
+  }
+
+  context->codec->hw_frames_ctx = av_buffer_ref(context->hw_frames);
+  context->hw_frame = av_frame_alloc();
+  if (!context->codec->hw_frames_ctx || !context->hw_frame)
+    return AV_PIX_FMT_NONE;
+
+  INFO_LOG_FMT(FRAMEDUMP, "Encoding from {} frames uploaded as {}",
+               av_hwdevice_get_type_name(device_type), av_get_pix_fmt_name(sw_pix_fmt));
+  return sw_pix_fmt;
+}
+
 }  // namespace
 
 bool FFMpegFrameDump::Start(int w, int h, u64 start_ticks)
@@ -276,23 +422,28 @@ bool FFMpegFrameDump::CreateVideoFile()
   }
 
   if (pix_fmt == AV_PIX_FMT_NONE)
-  {
-    if (m_context->codec->codec_id == AV_CODEC_ID_FFV1)
-      pix_fmt = AV_PIX_FMT_BGR0;
-    else if (m_context->codec->codec_id == AV_CODEC_ID_UTVIDEO)
-      pix_fmt = AV_PIX_FMT_GBRP;
-    else
-      pix_fmt = AV_PIX_FMT_YUV420P;
-  }
+    pix_fmt = ChoosePixelFormat(codec);
 
   m_context->codec->pix_fmt = pix_fmt;
 
+  AVPixelFormat sw_pix_fmt = pix_fmt;
+  if (const AVCodecHWConfig* const hw_config = GetHWFramesConfig(codec, pix_fmt))
+  {
+    sw_pix_fmt = CreateHWFrames(m_context.get(), hw_config->device_type, pix_fmt);
+    if (sw_pix_fmt == AV_PIX_FMT_NONE)
+      return false;
+  }
+
   if (m_context->codec->codec_id == AV_CODEC_ID_UTVIDEO)
     av_opt_set_int(m_context->codec->priv_data, "pred", 3, 0);  // median
 
   if (output_format->flags & AVFMT_GLOBALHEADER)
     m_context->codec->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
 
+  // Let the encoder pick its thread count, and work on several frames at once where it can.
+  m_context->codec->thread_count = 0;
+  m_context->codec->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
   if (avcodec_open2(m_context->codec, codec, nullptr) < 0)
   {
     ERROR_LOG_FMT(FRAMEDUMP, "Could not open codec");
@@ -302,7 +453,7 @@ bool FFMpegFrameDump::CreateVideoFile()
   m_context->src_frame = av_frame_alloc();
   m_context->scaled_frame = av_frame_alloc();
 
-  m_context->scaled_frame->format = m_context->codec->pix_fmt;
+  m_context->scaled_frame->format = sw_pix_fmt;
   m_context->scaled_frame->width = m_context->width;
   m_context->scaled_frame->height = m_context->height;
 
@@ -327,6 +478,11 @@ bool FFMpegFrameDump::CreateVideoFile()
     return false;
   }
 
+  m_context->writer.Reset("FrameDumpWriter", [format = m_context->format](AVPacketPtr pkt) {
+    if (const int write_error = av_interleaved_write_frame(format, pkt.get()))
+      ERROR_LOG_FMT(FRAMEDUMP, "Error writing packet: {}", AVErrorString(write_error));
+  });
+
   if (av_cmp_q(m_context->stream->time_base, time_base) != 0)
   {
     WARN_LOG_FMT(FRAMEDUMP, "Stream time base differs at {}/{}", m_context->stream->time_base.den,
@@ -366,6 +522,7 @@ void FFMpegFrameDump::AddFrame(const FrameData& frame)
     if (pts <= m_context->last_pts)
     {
       WARN_LOG_FMT(FRAMEDUMP, "PTS delta < 1. Current frame will not be dumped.");
+      m_context->dropped_frames++;
       return;
     }
     else if (pts > m_context->last_pts + 1 && !m_context->gave_vfr_warning)
@@ -384,41 +541,68 @@ void FFMpegFrameDump::AddFrame(const FrameData& frame)
   m_context->src_frame->width = m_context->width;
   m_context->src_frame->height = m_context->height;
 
-  // Convert image from RGBA to desired pixel format.
-  m_context->sws = sws_getCachedContext(
-      m_context->sws, frame.width, frame.height, pix_fmt, m_context->width, m_context->height,
-      m_context->codec->pix_fmt, SWS_BICUBIC, nullptr, nullptr, nullptr);
-  if (m_context->sws)
+  AVFrame* encode_frame = m_context->scaled_frame;
+  if (IsMatchingFrameLayout(static_cast<AVPixelFormat>(m_context->scaled_frame->format)) &&
+      frame.width == m_context->width && frame.height == m_context->height)
+  {
+    // The encoder takes the frame as it was read back.
+    m_context->src_frame->format = m_context->scaled_frame->format;
+    encode_frame = m_context->src_frame;
+  }
+  else
+  {
+    // Convert image from RGBA to desired pixel format.
+    m_context->sws = sws_getCachedContext(
+        m_context->sws, frame.width, frame.height, pix_fmt, m_context->width, m_context->height,
+        static_cast<AVPixelFormat>(m_context->scaled_frame->format), SWS_BICUBIC, nullptr, nullptr,
+        nullptr);
+    if (m_context->sws)
+    {
+      sws_scale(m_context->sws, m_context->src_frame->data, m_context->src_frame->linesize, 0,
+                frame.height, m_context->scaled_frame->data, m_context->scaled_frame->linesize);
+    }
+  }
+
+  if (m_context->hw_frames)
   {
-    sws_scale(m_context->sws, m_context->src_frame->data, m_context->src_frame->linesize, 0,
-              frame.height, m_context->scaled_frame->data, m_context->scaled_frame->linesize);
+    av_frame_unref(m_context->hw_frame);
+    int error = av_hwframe_get_buffer(m_context->hw_frames, m_context->hw_frame, 0);
+    if (!error)
+      error = av_hwframe_transfer_data(m_context->hw_frame, encode_frame, 0);
+    if (error)
+    {
+      ERROR_LOG_FMT(FRAMEDUMP, "Error while uploading video frame: {}", AVErrorString(error));
+      m_context->dropped_frames++;
+      return;
+    }
+    encode_frame = m_context->hw_frame;
   }
 
   m_context->last_pts = pts;
-  m_context->scaled_frame->pts = pts;
+  encode_frame->pts = pts;
 
-  if (const int error = avcodec_send_frame(m_context->codec, m_context->scaled_frame))
+  if (const int error = avcodec_send_frame(m_context->codec, encode_frame))
   {
     ERROR_LOG_FMT(FRAMEDUMP, "Error while encoding video: {}", AVErrorString(error));
+    m_context->dropped_frames++;
     return;
   }
 
+  m_context->encoded_frames++;
   ProcessPackets();
 }
 
 void FFMpegFrameDump::ProcessPackets()
 {
-  auto pkt = std::unique_ptr<AVPacket, std::function<void(AVPacket*)>>(
-      av_packet_alloc(), [](AVPacket* packet) { av_packet_free(&packet); });
-
-  if (!pkt)
-  {
-    ERROR_LOG_FMT(FRAMEDUMP, "Could not allocate packet");
-    return;
-  }
-
   while (true)
   {
+    AVPacketPtr pkt(av_packet_alloc());
+    if (!pkt)
+    {
+      ERROR_LOG_FMT(FRAMEDUMP, "Could not allocate packet");
+      return;
+    }
+
     const int receive_error = avcodec_receive_packet(m_context->codec, pkt.get());
 
     if (receive_error == AVERROR(EAGAIN) || receive_error == AVERROR_EOF)
@@ -436,11 +620,7 @@ void FFMpegFrameDump::ProcessPackets()
     av_packet_rescale_ts(pkt.get(), m_context->codec->time_base, m_context->stream->time_base);
     pkt->stream_index = m_context->stream->index;
 
-    if (const int write_error = av_interleaved_write_frame(m_context->format, pkt.get()))
-    {
-      ERROR_LOG_FMT(FRAMEDUMP, "Error writing packet: {}", AVErrorString(write_error));
-      break;
-    }
+    m_context->writer.Push(std::move(pkt));
   }
 }
 
@@ -454,10 +634,15 @@ void FFMpegFrameDump::Stop()
     WARN_LOG_FMT(FRAMEDUMP, "Error sending flush packet: {}", AVErrorString(flush_error));
 
   ProcessPackets();
+
+  // Wait for the remaining packets to be written.
+  m_context->writer.Shutdown();
   av_write_trailer(m_context->format);
+
+  NOTICE_LOG_FMT(FRAMEDUMP, "Stopping frame dump: {} frames encoded, {} dropped",
+                 m_context->encoded_frames, m_context->dropped_frames);
   CloseVideoFile();
 
-  NOTICE_LOG_FMT(FRAMEDUMP, "Stopping frame dump");
   OSD::AddMessage("Stopped dumping frames");
 }
 
@@ -468,10 +653,15 @@ bool FFMpegFrameDump::IsStarted() const
 
 void FFMpegFrameDump::CloseVideoFile()
 {
+  m_context->writer.Shutdown();
+
   av_frame_free(&m_context->src_frame);
   av_frame_free(&m_context->scaled_frame);
+  av_frame_free(&m_context->hw_frame);
 
   avcodec_free_context(&m_context->codec);
+  av_buffer_unref(&m_context->hw_frames);
+  av_buffer_unref(&m_context->hw_device);
 
   if (m_context->format)
     avio_closep(&m_context->format->pb);
@@ -3,6 +3,8 @@
 
 #include "VideoCommon/FrameDumper.h"
 
+#include <chrono>
+
 #include "Common/Assert.h"
 #include "Common/FileUtil.h"
 #include "Common/Image.h"
@@ -62,12 +64,27 @@ void FrameDumper::DumpCurrentFrame(const AbstractTexture* src_texture,
     copy_rect = src_texture->GetRect();
   }
 
-  if (!CheckFrameDumpReadbackTexture(target_width, target_height))
+  // A frame that is dumped again before the end of the frame replaces the earlier copy.
+  std::unique_ptr<AbstractStagingTexture> readback;
+  if (m_frame_dump_needs_flush)
+  {
+    readback = std::move(m_pending_readbacks.back().texture);
+    m_pending_readbacks.pop_back();
+    m_frame_dump_needs_flush = false;
+    if (readback->GetWidth() != static_cast<u32>(target_width) ||
+        readback->GetHeight() != static_cast<u32>(target_height))
+    {
+      m_free_readback_textures.push_back(std::move(readback));
+    }
+  }
+  if (!readback)
+    readback = GetFrameDumpReadbackTexture(target_width, target_height);
+  if (!readback)
     return;
 
-  m_frame_dump_readback_texture->CopyFromTexture(src_texture, copy_rect, 0, 0,
-                                                 m_frame_dump_readback_texture->GetRect());
-  m_last_frame_state = m_ffmpeg_dump.FetchState(ticks, frame_number);
+  readback->CopyFromTexture(src_texture, copy_rect, 0, 0, readback->GetRect());
+  m_pending_readbacks.push_back(
+      PendingReadback{std::move(readback), m_ffmpeg_dump.FetchState(ticks, frame_number)});
   m_frame_dump_needs_flush = true;
 }
 
@@ -99,21 +116,40 @@ bool FrameDumper::CheckFrameDumpRenderTexture(u32 target_width, u32 target_heigh
   return true;
 }
 
-bool FrameDumper::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height)
+std::unique_ptr<AbstractStagingTexture>
+FrameDumper::GetFrameDumpReadbackTexture(u32 target_width, u32 target_height)
 {
-  std::unique_ptr<AbstractStagingTexture>& rbtex = m_frame_dump_readback_texture;
-  if (rbtex && rbtex->GetWidth() == target_width && rbtex->GetHeight() == target_height)
-    return true;
+  ReclaimEncodedFrames(false);
+  if (m_free_readback_textures.empty() && m_readback_texture_count == MAX_READBACK_TEXTURES)
+  {
+    // Every texture holds a frame, so hand all of them to the encoder and wait for the oldest one.
+    QueuePendingReadbacks(0);
+    ReclaimEncodedFrames(true);
+  }
 
-  rbtex.reset();
-  rbtex = g_gfx->CreateStagingTexture(StagingTextureType::Readback,
-                                      TextureConfig(target_width, target_height, 1, 1, 1,
-                                                    AbstractTextureFormat::RGBA8, 0,
-                                                    AbstractTextureType::Texture_2DArray));
-  if (!rbtex)
-    return false;
+  if (!m_free_readback_textures.empty())
+  {
+    std::unique_ptr<AbstractStagingTexture> rbtex = std::move(m_free_readback_textures.back());
+    m_free_readback_textures.pop_back();
+    if (rbtex->GetWidth() == target_width && rbtex->GetHeight() == target_height)
+      return rbtex;
+
+    // Release before creating so we don't temporarily use twice the RAM.
+    rbtex.reset();
+    m_readback_texture_count--;
+  }
 
-  return true;
+  if (m_readback_texture_count == MAX_READBACK_TEXTURES)
+    return nullptr;
+
+  std::unique_ptr<AbstractStagingTexture> rbtex =
+      g_gfx->CreateStagingTexture(StagingTextureType::Readback,
+                                  TextureConfig(target_width, target_height, 1, 1, 1,
+                                                AbstractTextureFormat::RGBA8, 0,
+                                                AbstractTextureType::Texture_2DArray));
+  if (rbtex)
+    m_readback_texture_count++;
+  return rbtex;
 }
 
 void FrameDumper::FlushFrameDump()
@@ -121,152 +157,170 @@ void FrameDumper::FlushFrameDump()
   if (!m_frame_dump_needs_flush)
     return;
 
-  // Ensure dumping thread is done with output texture before swapping.
-  FinishFrameData();
-
-  std::swap(m_frame_dump_output_texture, m_frame_dump_readback_texture);
-
-  // Queue encoding of the last frame dumped.
-  auto& output = m_frame_dump_output_texture;
-  output->Flush();
-  if (output->Map())
-  {
-    DumpFrameData(reinterpret_cast<u8*>(output->GetMappedPointer()), output->GetConfig().width,
-                  output->GetConfig().height, static_cast<int>(output->GetMappedStride()));
-  }
-  else
-  {
-    ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
-  }
-
   m_frame_dump_needs_flush = false;
 
+  // Queue encoding of the frames whose readback has completed by now. Screenshots are taken from
+  // the frame they were requested on, so don't hold frames back when only taking a screenshot.
+  ReclaimEncodedFrames(false);
+  QueuePendingReadbacks(Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES) ? READBACK_FRAMES_IN_FLIGHT :
+                                                                      0);
+
   // Shutdown frame dumping if it is no longer active.
   if (!IsFrameDumping())
     ShutdownFrameDumping();
 }
 
-void FrameDumper::ShutdownFrameDumping()
+void FrameDumper::QueuePendingReadbacks(size_t frames_to_keep)
 {
-  // Ensure the last queued readback has been sent to the encoder.
-  FlushFrameDump();
-
-  if (!m_frame_dump_thread_running.IsSet())
-    return;
+  while (m_pending_readbacks.size() > frames_to_keep)
+  {
+    PendingReadback readback = std::move(m_pending_readbacks.front());
+    m_pending_readbacks.pop_front();
 
-  // Ensure previous frame has been encoded.
-  FinishFrameData();
+    auto& output = readback.texture;
+    output->Flush();
+    if (!output->Map())
+    {
+      ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
+      m_free_readback_textures.push_back(std::move(output));
+      continue;
+    }
 
-  // Wake thread up, and wait for it to exit.
-  m_frame_dump_thread_running.Clear();
-  m_frame_dump_start.Set();
-  if (m_frame_dump_thread.joinable())
-    m_frame_dump_thread.join();
-  m_frame_dump_render_framebuffer.reset();
-  m_frame_dump_render_texture.reset();
+    if (!m_frame_dump_thread_running)
+      StartFrameDumpThread();
 
-  m_frame_dump_readback_texture.reset();
-  m_frame_dump_output_texture.reset();
+    m_frame_dump_thread.EmplaceItem(FrameData{
+        reinterpret_cast<u8*>(output->GetMappedPointer()), static_cast<int>(output->GetWidth()),
+        static_cast<int>(output->GetHeight()), static_cast<int>(output->GetMappedStride()),
+        readback.state});
+    m_frames_queued++;
+    m_encoding_textures.push_back(std::move(output));
+  }
 }
 
-void FrameDumper::DumpFrameData(const u8* data, int w, int h, int stride)
+void FrameDumper::ReclaimEncodedFrames(bool wait)
 {
-  m_frame_dump_data = FrameData{data, w, h, stride, m_last_frame_state};
-
-  if (!m_frame_dump_thread_running.IsSet())
+  if (wait && !m_encoding_textures.empty() &&
+      m_frames_queued - m_frames_encoded.load() == m_encoding_textures.size())
   {
-    if (m_frame_dump_thread.joinable())
-      m_frame_dump_thread.join();
-    m_frame_dump_thread_running.Set();
-    m_frame_dump_thread = std::thread(&FrameDumper::FrameDumpThreadFunc, this);
+    const auto wait_start = std::chrono::steady_clock::now();
+    while (m_frames_queued - m_frames_encoded.load() == m_encoding_textures.size())
+      m_frame_dump_done.Wait();
+
+    m_late_frames++;
+    m_late_frame_wait_us += std::chrono::duration_cast<std::chrono::microseconds>(
+                                std::chrono::steady_clock::now() - wait_start)
+                                .count();
   }
 
-  // Wake worker thread up.
-  m_frame_dump_start.Set();
-  m_frame_dump_frame_running = true;
-}
-
-void FrameDumper::FinishFrameData()
-{
-  if (!m_frame_dump_frame_running)
-    return;
-
-  m_frame_dump_done.Wait();
-  m_frame_dump_frame_running = false;
-
-  m_frame_dump_output_texture->Unmap();
+  const size_t frames_in_encoder = m_frames_queued - m_frames_encoded.load();
+  while (m_encoding_textures.size() > frames_in_encoder)
+  {
+    m_encoding_textures.front()->Unmap();
+    m_free_readback_textures.push_back(std::move(m_encoding_textures.front()));
+    m_encoding_textures.pop_front();
+  }
 }
 
-void FrameDumper::FrameDumpThreadFunc()
+void FrameDumper::StartFrameDumpThread()
 {
-  Common::SetCurrentThreadName("FrameDumping");
-
-  bool dump_to_ffmpeg = !g_ActiveConfig.bDumpFramesAsImages;
-  bool frame_dump_started = false;
+  m_dump_to_ffmpeg = !g_ActiveConfig.bDumpFramesAsImages;
+  m_frame_dump_started = false;
 
 // If Dolphin was compiled without ffmpeg, we only support dumping to images.
 #if !defined(HAVE_FFMPEG)
-  if (dump_to_ffmpeg)
+  if (m_dump_to_ffmpeg)
   {
     WARN_LOG_FMT(VIDEO, "FrameDump: Dolphin was not compiled with FFmpeg, using fallback option. "
                         "Frames will be saved as PNG images instead.");
-    dump_to_ffmpeg = false;
+    m_dump_to_ffmpeg = false;
   }
 #endif
 
-  while (true)
-  {
-    m_frame_dump_start.Wait();
-    if (!m_frame_dump_thread_running.IsSet())
-      break;
+  m_frames_queued = 0;
+  m_frames_encoded = 0;
+  m_late_frames = 0;
+  m_late_frame_wait_us = 0;
 
-    auto frame = m_frame_dump_data;
+  m_frame_dump_thread.Reset("FrameDumping", [this](const FrameData& frame) {
+    ProcessFrame(frame);
+    m_frames_encoded++;
+    m_frame_dump_done.Set();
+  });
+  m_frame_dump_thread_running = true;
+}
 
-    // Save screenshot
-    if (m_screenshot_request.TestAndClear())
-    {
-      std::lock_guard<std::mutex> lk(m_screenshot_lock);
+void FrameDumper::ShutdownFrameDumping()
+{
+  // Ensure the queued readbacks have been sent to the encoder.
+  FlushFrameDump();
+  QueuePendingReadbacks(0);
 
-      if (DumpFrameToPNG(frame, m_screenshot_name))
-        OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
+  if (!m_frame_dump_thread_running)
+    return;
 
-      // Reset settings
-      m_screenshot_name.clear();
-      m_screenshot_completed.Set();
-    }
+  // Wait for the remaining frames to be encoded, and for the thread to exit.
+  m_frame_dump_thread.Shutdown();
+  m_frame_dump_thread_running = false;
+  ReclaimEncodedFrames(false);
 
-    if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
+  if (m_frame_dump_started)
+  {
+    // No additional cleanup is needed when dumping to images.
+    if (m_dump_to_ffmpeg)
+      StopFrameDumpToFFMPEG();
+
+    if (m_late_frames != 0)
     {
-      if (!frame_dump_started)
-      {
-        if (dump_to_ffmpeg)
-          frame_dump_started = StartFrameDumpToFFMPEG(frame);
-        else
-          frame_dump_started = StartFrameDumpToImage(frame);
-
-        // Stop frame dumping if we fail to start.
-        if (!frame_dump_started)
-          Config::SetCurrent(Config::MAIN_MOVIE_DUMP_FRAMES, false);
-      }
-
-      // If we failed to start frame dumping, don't write a frame.
-      if (frame_dump_started)
-      {
-        if (dump_to_ffmpeg)
-          DumpFrameToFFMPEG(frame);
-        else
-          DumpFrameToImage(frame);
-      }
+      NOTICE_LOG_FMT(FRAMEDUMP, "Waited for the encoder on {} of {} frames, {} ms in total",
+                     m_late_frames, m_frames_queued, m_late_frame_wait_us / 1000);
     }
+  }
 
-    m_frame_dump_done.Set();
+  m_frame_dump_render_framebuffer.reset();
+  m_frame_dump_render_texture.reset();
+
+  m_free_readback_textures.clear();
+  m_readback_texture_count = 0;
+}
+
+void FrameDumper::ProcessFrame(const FrameData& frame)
+{
+  // Save screenshot
+  if (m_screenshot_request.TestAndClear())
+  {
+    std::lock_guard<std::mutex> lk(m_screenshot_lock);
+
+    if (DumpFrameToPNG(frame, m_screenshot_name))
+      OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
+
+    // Reset settings
+    m_screenshot_name.clear();
+    m_screenshot_completed.Set();
   }
 
-  if (frame_dump_started)
+  if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
   {
-    // No additional cleanup is needed when dumping to images.
-    if (dump_to_ffmpeg)
-      StopFrameDumpToFFMPEG();
+    if (!m_frame_dump_started)
+    {
+      if (m_dump_to_ffmpeg)
+        m_frame_dump_started = StartFrameDumpToFFMPEG(frame);
+      else
+        m_frame_dump_started = StartFrameDumpToImage(frame);
+
+      // Stop frame dumping if we fail to start.
+      if (!m_frame_dump_started)
+        Config::SetCurrent(Config::MAIN_MOVIE_DUMP_FRAMES, false);
+    }
+
+    // If we failed to start frame dumping, don't write a frame.
+    if (m_frame_dump_started)
+    {
+      if (m_dump_to_ffmpeg)
+        DumpFrameToFFMPEG(frame);
+      else
+        DumpFrameToImage(frame);
+    }
   }
 }
 
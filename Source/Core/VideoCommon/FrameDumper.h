@@ -3,11 +3,19 @@
 
 #pragma once
 
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "Common/MathUtil.h"
 #include "Common/Thread.h"
+#include "Common/WorkQueueThread.h"
 
 #include "VideoCommon/FrameDumpFFMpeg.h"
 #include "VideoCommon/VideoEvents.h"
@@ -38,8 +46,22 @@ public:
   void DoState(PointerWrap& p);
 
 private:
+  // Frames are read back while later frames are rendered, so that mapping them doesn't wait for
+  // the GPU. Only used when dumping frames, screenshots are read back immediately.
+  static constexpr size_t READBACK_FRAMES_IN_FLIGHT = 2;
+
+  // Readback textures, including the ones being encoded. When all of them are in use, the video
+  // thread has to wait for the encoder.
+  static constexpr size_t MAX_READBACK_TEXTURES = READBACK_FRAMES_IN_FLIGHT + 3;
+
+  struct PendingReadback
+  {
+    std::unique_ptr<AbstractStagingTexture> texture;
+    FrameState state;
+  };
+
   // NOTE: The methods below are called on the framedumping thread.
-  void FrameDumpThreadFunc();
+  void ProcessFrame(const FrameData&);
   bool StartFrameDumpToFFMPEG(const FrameData&);
   void DumpFrameToFFMPEG(const FrameData&);
   void StopFrameDumpToFFMPEG();
@@ -47,46 +69,53 @@ private:
   bool StartFrameDumpToImage(const FrameData&);
   void DumpFrameToImage(const FrameData&);
 
+  void StartFrameDumpThread();
   void ShutdownFrameDumping();
 
   // Checks that the frame dump render texture exists and is the correct size.
   bool CheckFrameDumpRenderTexture(u32 target_width, u32 target_height);
 
-  // Checks that the frame dump readback texture exists and is the correct size.
-  bool CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height);
-
-  // Asynchronously encodes the specified pointer of frame data to the frame dump.
-  void DumpFrameData(const u8* data, int w, int h, int stride);
+  // Returns an unused readback texture of the given size, waiting for the encoder if there is none.
+  std::unique_ptr<AbstractStagingTexture> GetFrameDumpReadbackTexture(u32 target_width,
+                                                                      u32 target_height);
 
-  // Ensures all encoded frames have been written to the output file.
-  void FinishFrameData();
+  // Maps all but the newest frames_to_keep pending readbacks and queues them for encoding.
+  void QueuePendingReadbacks(size_t frames_to_keep);
 
-  std::thread m_frame_dump_thread;
-  Common::Flag m_frame_dump_thread_running;
+  // Unmaps the textures of frames the encoder is done with so that they can be reused.
+  // If wait is set, blocks until at least one frame has been encoded.
+  void ReclaimEncodedFrames(bool wait);
 
-  // Used to kick frame dump thread.
-  Common::Event m_frame_dump_start;
+  Common::WorkQueueThread<FrameData> m_frame_dump_thread;
+  bool m_frame_dump_thread_running = false;
 
   // Set by frame dump thread on frame completion.
   Common::Event m_frame_dump_done;
 
-  // Holds emulation state during the last swap when dumping.
-  FrameState m_last_frame_state;
+  // Frames queued on the video thread and finished on the dump thread.
+  size_t m_frames_queued = 0;
+  std::atomic<size_t> m_frames_encoded = 0;
+
+  // Frames the video thread had to wait for the encoder on, and the total time it waited.
+  u32 m_late_frames = 0;
+  u64 m_late_frame_wait_us = 0;
 
-  // Communication of frame between video and dump threads.
-  FrameData m_frame_dump_data;
+  // Chosen for the whole run of the dump thread.
+  bool m_dump_to_ffmpeg = false;
+  bool m_frame_dump_started = false;
 
   // Texture used for screenshot/frame dumping
   std::unique_ptr<AbstractTexture> m_frame_dump_render_texture;
   std::unique_ptr<AbstractFramebuffer> m_frame_dump_render_framebuffer;
 
-  // Double buffer:
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_readback_texture;
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_output_texture;
-  // Set when readback texture holds a frame that needs to be dumped.
+  // Readbacks that haven't been mapped yet, oldest first.
+  std::deque<PendingReadback> m_pending_readbacks;
+  // Mapped textures of frames queued for encoding, oldest first.
+  std::deque<std::unique_ptr<AbstractStagingTexture>> m_encoding_textures;
+  std::vector<std::unique_ptr<AbstractStagingTexture>> m_free_readback_textures;
+  size_t m_readback_texture_count = 0;
+  // Set when the newest pending readback holds the current frame, which may still be replaced.
   bool m_frame_dump_needs_flush = false;
-  // Set when thread is processing output texture.
-  bool m_frame_dump_frame_running = false;
 
   // Used to generate screenshot names.
   u32 m_frame_dump_image_counter = 0;
@@ -94,6 +94,7 @@ void FramebufferManager::RecreateEFBFramebuffer()
 {
   FlushEFBPokes();
   InvalidatePeekCache(true);
+  m_efb_modification_count++;
 
   DestroyReadbackFramebuffer();
   DestroyEFBFramebuffer();
@@ -399,6 +400,7 @@ bool FramebufferManager::ReinterpretPixelData(EFBReinterpretType convtype)
   std::swap(m_efb_framebuffer, m_efb_convert_framebuffer);
   g_gfx->EndUtilityDrawing();
   InvalidatePeekCache(true);
+  m_efb_modification_count++;
   return true;
 }
 
@@ -458,6 +460,28 @@ bool FramebufferManager::IsEFBCacheTilePresent(bool depth, u32 x, u32 y, u32* ti
   return data.tiles[*tile_index].present;
 }
 
+bool FramebufferManager::IsEFBCacheTileLikelyAccessed(const EFBCacheData& data,
+                                                      u32 tile_index) const
+{
+  if (data.tiles[tile_index].frame_access_mask != 0)
+    return true;
+  if (!IsUsingTiledEFBCache())
+    return false;
+
+  // Peeks tend to follow something moving across the screen (e.g. the sun for lens flares), so
+  // the tiles next to ones accessed in the last two frames are likely to be accessed as well.
+  const u32 tile_x = tile_index % m_efb_cache_tile_row_stride;
+  const u32 tile_y = tile_index / m_efb_cache_tile_row_stride;
+  const u32 tile_rows = static_cast<u32>(data.tiles.size()) / m_efb_cache_tile_row_stride;
+  const auto recently_accessed = [&](u32 x, u32 y) {
+    return (data.tiles[y * m_efb_cache_tile_row_stride + x].frame_access_mask & 0b11) != 0;
+  };
+  return (tile_x > 0 && recently_accessed(tile_x - 1, tile_y)) ||
+         (tile_x + 1 < m_efb_cache_tile_row_stride && recently_accessed(tile_x + 1, tile_y)) ||
+         (tile_y > 0 && recently_accessed(tile_x, tile_y - 1)) ||
+         (tile_y + 1 < tile_rows && recently_accessed(tile_x, tile_y + 1));
+}
+
 MathUtil::Rectangle<int> FramebufferManager::GetEFBCacheTileRect(u32 tile_index) const
 {
   if (!IsUsingTiledEFBCache())
@@ -538,20 +562,7 @@ void FramebufferManager::RefreshPeekCache()
     return;
   }
 
-  bool flush_command_buffer = false;
-  for (u32 i = 0; i < m_efb_color_cache.tiles.size(); i++)
-  {
-    if (m_efb_color_cache.tiles[i].frame_access_mask != 0 && !m_efb_color_cache.tiles[i].present)
-    {
-      PopulateEFBCache(false, i, true);
-      flush_command_buffer = true;
-    }
-    if (m_efb_depth_cache.tiles[i].frame_access_mask != 0 && !m_efb_depth_cache.tiles[i].present)
-    {
-      PopulateEFBCache(true, i, true);
-      flush_command_buffer = true;
-    }
-  }
+  const bool flush_command_buffer = PrefetchEFBCache(false) | PrefetchEFBCache(true);
 
   m_efb_depth_cache.needs_refresh = false;
   m_efb_color_cache.needs_refresh = false;
@@ -562,6 +573,21 @@ void FramebufferManager::RefreshPeekCache()
   }
 }
 
+bool FramebufferManager::PrefetchEFBCache(bool depth)
+{
+  const EFBCacheData& data = depth ? m_efb_depth_cache : m_efb_color_cache;
+  bool populated = false;
+  for (u32 i = 0; i < data.tiles.size(); i++)
+  {
+    if (!data.tiles[i].present && IsEFBCacheTileLikelyAccessed(data, i))
+    {
+      PopulateEFBCache(depth, i, true);
+      populated = true;
+    }
+  }
+  return populated;
+}
+
 void FramebufferManager::InvalidatePeekCache(bool forced)
 {
   if (forced || m_efb_color_cache.out_of_date)
@@ -598,6 +624,13 @@ void FramebufferManager::InvalidatePeekCache(bool forced)
 
 void FramebufferManager::FlagPeekCacheAsOutOfDate()
 {
+  // This is called after every draw and clear.
+  m_efb_modification_count++;
+
+  // Stale peeks keep reading the copy made at the end of the previous frame.
+  if (g_ActiveConfig.bEFBAccessAllowStale)
+    return;
+
   if (m_efb_color_cache.has_active_tiles)
     m_efb_color_cache.out_of_date = true;
   if (m_efb_depth_cache.has_active_tiles)
@@ -614,6 +647,15 @@ void FramebufferManager::EndOfFrame()
     m_efb_color_cache.tiles[i].frame_access_mask <<= 1;
     m_efb_depth_cache.tiles[i].frame_access_mask <<= 1;
   }
+
+  // The EFB hasn't been cleared for the next frame yet, so read back the tiles which are likely to
+  // be accessed during it. Their readback completes while the next frame is being drawn.
+  if (g_ActiveConfig.bEFBAccessAllowStale &&
+      (m_efb_color_cache.has_active_tiles || m_efb_depth_cache.has_active_tiles))
+  {
+    InvalidatePeekCache(true);
+    RefreshPeekCache();
+  }
 }
 
 bool FramebufferManager::CompileReadbackPipelines()
@@ -950,6 +992,7 @@ void FramebufferManager::PokeEFBColor(u32 x, u32 y, u32 color)
     FlushEFBPokes();
 
   CreatePokeVertices(&m_color_poke_vertices, x, y, 0.0f, color);
+  m_efb_modification_count++;
 
   // See comment above for reasoning for lower-left coordinates.
   if (g_ActiveConfig.backend_info.bUsesLowerLeftOrigin)
@@ -968,6 +1011,7 @@ void FramebufferManager::PokeEFBDepth(u32 x, u32 y, float depth)
     FlushEFBPokes();
 
   CreatePokeVertices(&m_depth_poke_vertices, x, y, depth, 0);
+  m_efb_modification_count++;
 
   // See comment above for reasoning for lower-left coordinates.
   if (g_ActiveConfig.backend_info.bUsesLowerLeftOrigin)
@@ -1140,6 +1184,7 @@ void FramebufferManager::DoLoadState(PointerWrap& p)
 {
   // Invalidate any peek cache tiles.
   InvalidatePeekCache(true);
+  m_efb_modification_count++;
 
   // Deserialize the color and depth textures. This could fail.
   auto color_tex = g_texture_cache->DeserializeTexture(p);
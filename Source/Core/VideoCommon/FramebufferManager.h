@@ -123,6 +123,9 @@ public:
   void FlagPeekCacheAsOutOfDate();
   void EndOfFrame();
 
+  // Incremented whenever the contents of the EFB may have changed.
+  u64 GetEFBModificationCount() const { return m_efb_modification_count; }
+
   // Writes a value to the framebuffer. This will never block, and writes will be batched.
   void PokeEFBColor(u32 x, u32 y, u32 color);
   void PokeEFBDepth(u32 x, u32 y, float depth);
@@ -180,8 +183,10 @@ protected:
 
   bool IsUsingTiledEFBCache() const;
   bool IsEFBCacheTilePresent(bool depth, u32 x, u32 y, u32* tile_index) const;
+  bool IsEFBCacheTileLikelyAccessed(const EFBCacheData& data, u32 tile_index) const;
   MathUtil::Rectangle<int> GetEFBCacheTileRect(u32 tile_index) const;
   void PopulateEFBCache(bool depth, u32 tile_index, bool async = false);
+  bool PrefetchEFBCache(bool depth);
 
   void CreatePokeVertices(std::vector<EFBPokeVertex>* destination_list, u32 x, u32 y, float z,
                           u32 color);
@@ -227,6 +232,8 @@ protected:
   EFBCacheData m_efb_color_cache = {};
   EFBCacheData m_efb_depth_cache = {};
 
+  u64 m_efb_modification_count = 0;
+
   // EFB clear pipelines
   // Indexed by [color_write_enabled][alpha_write_enabled][depth_write_enabled]
   std::array<std::array<std::array<std::unique_ptr<AbstractPipeline>, 2>, 2>, 2> m_clear_pipelines;
@@ -2,6 +2,10 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "VideoCommon/GraphicsModSystem/Runtime/CustomShaderCache.h"
+
+#include <xxhash.h>
+
+#include "Common/Logging/Log.h"
 #include "VideoCommon/AbstractGfx.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -9,6 +13,7 @@ CustomShaderCache::CustomShaderCache()
 {
   m_api_type = g_ActiveConfig.backend_info.api_type;
   m_host_config.bits = ShaderHostConfig::GetCurrent().bits;
+  OpenDiskCaches();
 
   m_async_shader_compiler = g_gfx->CreateAsyncShaderCompiler();
   m_async_shader_compiler->StartWorkerThreads(1);  // TODO
@@ -29,6 +34,45 @@ CustomShaderCache::~CustomShaderCache()
     m_async_uber_shader_compiler->StopWorkerThreads();
 }
 
+u64 CustomShaderCache::GetCustomShadersHash(const CustomShaderInstance& custom_shaders)
+{
+  u64 hash = 0;
+  for (const CustomPixelShader& shader : custom_shaders.pixel_contents.shaders)
+  {
+    hash = XXH3_64bits_withSeed(shader.custom_shader.data(), shader.custom_shader.size(), hash);
+    hash = XXH3_64bits_withSeed(shader.material_uniform_block.data(),
+                                shader.material_uniform_block.size(), hash);
+  }
+  return hash;
+}
+
+bool CustomShaderCache::UseDiskCache()
+{
+  return g_ActiveConfig.bShaderCache && g_ActiveConfig.backend_info.bSupportsShaderBinaries;
+}
+
+void CustomShaderCache::OpenDiskCaches()
+{
+  if (!UseDiskCache() || m_api_type == APIType::Nothing)
+    return;
+
+  const std::string ps_filename = GetDiskShaderCacheFileName(m_api_type, "custom-ps", true, true);
+  const u32 ps_count = m_ps_disk_cache.Open(ps_filename);
+  INFO_LOG_FMT(VIDEO, "Found {} cached custom pixel shaders in {}", ps_count, ps_filename);
+
+  const std::string uber_ps_filename =
+      GetDiskShaderCacheFileName(m_api_type, "custom-uber-ps", true, true);
+  const u32 uber_ps_count = m_uber_ps_disk_cache.Open(uber_ps_filename);
+  INFO_LOG_FMT(VIDEO, "Found {} cached custom uber pixel shaders in {}", uber_ps_count,
+               uber_ps_filename);
+}
+
+void CustomShaderCache::CloseDiskCaches()
+{
+  m_ps_disk_cache.Close();
+  m_uber_ps_disk_cache.Close();
+}
+
 void CustomShaderCache::RetrieveAsyncShaders()
 {
   m_async_shader_compiler->RetrieveWorkItems();
@@ -52,6 +96,10 @@ void CustomShaderCache::Reload()
   m_uber_ps_cache = {};
   m_pipeline_cache = {};
   m_uber_pipeline_cache = {};
+
+  // The file names depend on the host config.
+  CloseDiskCaches();
+  OpenDiskCaches();
 }
 
 std::optional<const AbstractPipeline*>
@@ -276,16 +324,42 @@ void CustomShaderCache::QueuePixelShaderCompile(const PixelShaderUid& uid,
                         const CustomShaderInstance& custom_shaders, PixelShaderIterator iter)
         : m_shader_cache(shader_cache), m_uid(uid), m_custom_shaders(custom_shaders), m_iter(iter)
     {
+      if (!UseDiskCache())
+        return;
+
+      m_disk_key.uid = uid;
+      m_disk_key.custom_shaders_hash = GetCustomShadersHash(custom_shaders);
+      if (const auto binary = m_shader_cache->m_ps_disk_cache.Lookup(m_disk_key))
+        m_binary.assign(binary->begin(), binary->end());
     }
 
     bool Compile() override
     {
-      m_shader = m_shader_cache->CompilePixelShader(m_uid, m_custom_shaders);
+      // Binaries from an older driver may be rejected, in which case the source is compiled.
+      if (!m_binary.empty())
+      {
+        m_shader =
+            g_gfx->CreateShaderFromBinary(ShaderStage::Pixel, m_binary.data(), m_binary.size());
+      }
+      if (!m_shader)
+      {
+        m_shader = m_shader_cache->CompilePixelShader(m_uid, m_custom_shaders);
+        m_compiled_from_source = true;
+      }
       return true;
     }
 
     void Retrieve() override
     {
+      if (m_shader && m_compiled_from_source && UseDiskCache())
+      {
+        const auto binary = m_shader->GetBinary();
+        if (!binary.empty())
+        {
+          m_shader_cache->m_ps_disk_cache.Append(m_disk_key, binary.data(),
+                                                 static_cast<u32>(binary.size()));
+        }
+      }
       m_shader_cache->NotifyPixelShaderFinished(m_iter, std::move(m_shader));
     }
 
@@ -295,6 +369,9 @@ void CustomShaderCache::QueuePixelShaderCompile(const PixelShaderUid& uid,
     PixelShaderUid m_uid;
     CustomShaderInstance m_custom_shaders;
     PixelShaderIterator m_iter;
+    PixelShaderDiskKey m_disk_key;
+    std::vector<u8> m_binary;
+    bool m_compiled_from_source = false;
   };
 
   auto list_iter = m_ps_cache.InsertElement(uid, custom_shaders);
@@ -314,16 +391,42 @@ void CustomShaderCache::QueuePixelShaderCompile(const UberShader::PixelShaderUid
                         const CustomShaderInstance& custom_shaders, UberPixelShaderIterator iter)
         : m_shader_cache(shader_cache), m_uid(uid), m_custom_shaders(custom_shaders), m_iter(iter)
     {
+      if (!UseDiskCache())
+        return;
+
+      m_disk_key.uid = uid;
+      m_disk_key.custom_shaders_hash = GetCustomShadersHash(custom_shaders);
+      if (const auto binary = m_shader_cache->m_uber_ps_disk_cache.Lookup(m_disk_key))
+        m_binary.assign(binary->begin(), binary->end());
     }
 
     bool Compile() override
     {
-      m_shader = m_shader_cache->CompilePixelShader(m_uid, m_custom_shaders);
+      // Binaries from an older driver may be rejected, in which case the source is compiled.
+      if (!m_binary.empty())
+      {
+        m_shader =
+            g_gfx->CreateShaderFromBinary(ShaderStage::Pixel, m_binary.data(), m_binary.size());
+      }
+      if (!m_shader)
+      {
+        m_shader = m_shader_cache->CompilePixelShader(m_uid, m_custom_shaders);
+        m_compiled_from_source = true;
+      }
       return true;
     }
 
     void Retrieve() override
     {
+      if (m_shader && m_compiled_from_source && UseDiskCache())
+      {
+        const auto binary = m_shader->GetBinary();
+        if (!binary.empty())
+        {
+          m_shader_cache->m_uber_ps_disk_cache.Append(m_disk_key, binary.data(),
+                                                      static_cast<u32>(binary.size()));
+        }
+      }
       m_shader_cache->NotifyPixelShaderFinished(m_iter, std::move(m_shader));
     }
 
@@ -333,6 +436,9 @@ void CustomShaderCache::QueuePixelShaderCompile(const UberShader::PixelShaderUid
     UberShader::PixelShaderUid m_uid;
     CustomShaderInstance m_custom_shaders;
     UberPixelShaderIterator m_iter;
+    UberPixelShaderDiskKey m_disk_key;
+    std::vector<u8> m_binary;
+    bool m_compiled_from_source = false;
   };
 
   auto list_iter = m_uber_ps_cache.InsertElement(uid, custom_shaders);
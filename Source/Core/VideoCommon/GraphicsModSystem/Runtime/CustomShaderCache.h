@@ -4,13 +4,17 @@
 #pragma once
 
 #include <array>
+#include <cstring>
 #include <list>
 #include <map>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
+#include "Common/CommonTypes.h"
+#include "Common/LinearDiskCache.h"
 #include "VideoCommon/AbstractPipeline.h"
 #include "VideoCommon/AbstractShader.h"
 #include "VideoCommon/AsyncShaderCompiler.h"
@@ -38,6 +42,7 @@ public:
   CustomShaderCache& operator=(CustomShaderCache&&) = delete;
 
   // Changes the shader host config. Shaders should be reloaded afterwards.
+  // Reload() also switches to the disk caches of the new host config.
   void SetHostConfig(const ShaderHostConfig& host_config) { m_host_config.bits = host_config.bits; }
 
   // Retrieves all pending shaders/pipelines from the async compiler.
@@ -63,6 +68,28 @@ private:
   std::unique_ptr<VideoCommon::AsyncShaderCompiler> m_async_shader_compiler;
   std::unique_ptr<VideoCommon::AsyncShaderCompiler> m_async_uber_shader_compiler;
 
+  // Compiled pixel shaders are kept on disk, keyed by their uid and a hash of the custom shader
+  // code, so that they don't have to be compiled from source again in later sessions.
+  template <typename Uid>
+  struct DiskCacheKey
+  {
+    // Keys are compared as bytes, so the padding has to be zeroed.
+    DiskCacheKey() { std::memset(static_cast<void*>(this), 0, sizeof(*this)); }
+
+    Uid uid;
+    u64 custom_shaders_hash;
+  };
+  using PixelShaderDiskKey = DiskCacheKey<PixelShaderUid>;
+  using UberPixelShaderDiskKey = DiskCacheKey<UberShader::PixelShaderUid>;
+
+  Common::LinearDiskCache<PixelShaderDiskKey, u8> m_ps_disk_cache;
+  Common::LinearDiskCache<UberPixelShaderDiskKey, u8> m_uber_ps_disk_cache;
+
+  static u64 GetCustomShadersHash(const CustomShaderInstance& custom_shaders);
+  static bool UseDiskCache();
+  void OpenDiskCaches();
+  void CloseDiskCaches();
+
   void AsyncCreatePipeline(const VideoCommon::GXPipelineUid& uid,
                            const CustomShaderInstance& custom_shaders,
                            const AbstractPipelineConfig& pipeline_config);
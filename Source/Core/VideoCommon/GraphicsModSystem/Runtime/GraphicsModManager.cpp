@@ -7,6 +7,8 @@
 #include <string_view>
 #include <variant>
 
+#include <xxhash.h>
+
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
 #include "Common/VariantUtil.h"
@@ -114,54 +116,80 @@ GraphicsModManager::GetProjectionActions(ProjectionType projection_type) const
   return m_default;
 }
 
-const std::vector<GraphicsModAction*>&
-GraphicsModManager::GetProjectionTextureActions(ProjectionType projection_type,
-                                                const std::string& texture_name) const
+u64 GraphicsModManager::GetTextureId(std::string_view texture_name)
 {
-  const auto lookup = fmt::format("{}_{}", texture_name, static_cast<int>(projection_type));
-  if (const auto it = m_projection_texture_target_to_actions.find(lookup);
-      it != m_projection_texture_target_to_actions.end())
+  return XXH3_64bits(texture_name.data(), texture_name.size());
+}
+
+std::array<u32, 2> GraphicsModManager::GetTextureIdFilterBits(u64 texture_id)
+{
+  // Two probes taken from different bits of the id.
+  return {static_cast<u32>(texture_id) % TEXTURE_ID_FILTER_BITS,
+          static_cast<u32>(texture_id >> 32) % TEXTURE_ID_FILTER_BITS};
+}
+
+bool GraphicsModManager::MayHaveTextureActions(u64 texture_id) const
+{
+  for (const u32 bit : GetTextureIdFilterBits(texture_id))
   {
-    return it->second;
+    if ((m_texture_id_filter[bit / 64] & (u64{1} << (bit % 64))) == 0)
+      return false;
   }
+  return true;
+}
 
-  return m_default;
+void GraphicsModManager::AddTextureAction(
+    std::unordered_map<u64, std::vector<GraphicsModAction*>>* map, std::string_view texture_name,
+    GraphicsModAction* action)
+{
+  const u64 texture_id = GetTextureId(texture_name);
+  (*map)[texture_id].push_back(action);
+
+  for (const u32 bit : GetTextureIdFilterBits(texture_id))
+    m_texture_id_filter[bit / 64] |= u64{1} << (bit % 64);
 }
 
-const std::vector<GraphicsModAction*>&
-GraphicsModManager::GetDrawStartedActions(const std::string& texture_name) const
+const std::vector<GraphicsModAction*>& GraphicsModManager::FindTextureActions(
+    const std::unordered_map<u64, std::vector<GraphicsModAction*>>& map,
+    std::string_view texture_name) const
 {
-  if (const auto it = m_draw_started_target_to_actions.find(texture_name);
-      it != m_draw_started_target_to_actions.end())
-  {
+  if (map.empty())
+    return m_default;
+
+  const u64 texture_id = GetTextureId(texture_name);
+  if (!MayHaveTextureActions(texture_id))
+    return m_default;
+
+  if (const auto it = map.find(texture_id); it != map.end())
     return it->second;
-  }
 
   return m_default;
 }
 
 const std::vector<GraphicsModAction*>&
-GraphicsModManager::GetTextureLoadActions(const std::string& texture_name) const
+GraphicsModManager::GetProjectionTextureActions(ProjectionType projection_type,
+                                                const std::string& texture_name) const
 {
-  if (const auto it = m_load_texture_target_to_actions.find(texture_name);
-      it != m_load_texture_target_to_actions.end())
-  {
-    return it->second;
-  }
+  return FindTextureActions(
+      m_projection_texture_target_to_actions[static_cast<u32>(projection_type)], texture_name);
+}
 
-  return m_default;
+const std::vector<GraphicsModAction*>&
+GraphicsModManager::GetDrawStartedActions(const std::string& texture_name) const
+{
+  return FindTextureActions(m_draw_started_target_to_actions, texture_name);
 }
 
 const std::vector<GraphicsModAction*>&
-GraphicsModManager::GetTextureCreateActions(const std::string& texture_name) const
+GraphicsModManager::GetTextureLoadActions(const std::string& texture_name) const
 {
-  if (const auto it = m_create_texture_target_to_actions.find(texture_name);
-      it != m_create_texture_target_to_actions.end())
-  {
-    return it->second;
-  }
+  return FindTextureActions(m_load_texture_target_to_actions, texture_name);
+}
 
-  return m_default;
+const std::vector<GraphicsModAction*>&
+GraphicsModManager::GetTextureCreateActions(const std::string& texture_name) const
+{
+  return FindTextureActions(m_create_texture_target_to_actions, texture_name);
 }
 
 const std::vector<GraphicsModAction*>& GraphicsModManager::GetEFBActions(const FBInfo& efb) const
@@ -261,16 +289,16 @@ void GraphicsModManager::Load(const GraphicsModGroupConfig& config)
         std::visit(
             overloaded{
                 [&](const DrawStartedTextureTarget& the_target) {
-                  m_draw_started_target_to_actions[the_target.m_texture_info_string].push_back(
-                      m_actions.back().get());
+                  AddTextureAction(&m_draw_started_target_to_actions,
+                                   the_target.m_texture_info_string, m_actions.back().get());
                 },
                 [&](const LoadTextureTarget& the_target) {
-                  m_load_texture_target_to_actions[the_target.m_texture_info_string].push_back(
-                      m_actions.back().get());
+                  AddTextureAction(&m_load_texture_target_to_actions,
+                                   the_target.m_texture_info_string, m_actions.back().get());
                 },
                 [&](const CreateTextureTarget& the_target) {
-                  m_create_texture_target_to_actions[the_target.m_texture_info_string].push_back(
-                      m_actions.back().get());
+                  AddTextureAction(&m_create_texture_target_to_actions,
+                                   the_target.m_texture_info_string, m_actions.back().get());
                 },
                 [&](const EFBTarget& the_target) {
                   FBInfo info;
@@ -289,10 +317,10 @@ void GraphicsModManager::Load(const GraphicsModGroupConfig& config)
                 [&](const ProjectionTarget& the_target) {
                   if (the_target.m_texture_info_string)
                   {
-                    const auto lookup = fmt::format("{}_{}", *the_target.m_texture_info_string,
-                                                    static_cast<int>(the_target.m_projection_type));
-                    m_projection_texture_target_to_actions[lookup].push_back(
-                        m_actions.back().get());
+                    const u32 type = static_cast<u32>(the_target.m_projection_type);
+                    AddTextureAction(&m_projection_texture_target_to_actions[type],
+                                     *the_target.m_texture_info_string, m_actions.back().get());
+                    m_has_projection_texture_actions = true;
                   }
                   else
                   {
@@ -361,10 +389,13 @@ void GraphicsModManager::Reset()
   m_actions.clear();
   m_groups.clear();
   m_projection_target_to_actions.clear();
-  m_projection_texture_target_to_actions.clear();
+  for (auto& actions : m_projection_texture_target_to_actions)
+    actions.clear();
+  m_has_projection_texture_actions = false;
   m_draw_started_target_to_actions.clear();
   m_load_texture_target_to_actions.clear();
   m_create_texture_target_to_actions.clear();
   m_efb_target_to_actions.clear();
   m_xfb_target_to_actions.clear();
+  m_texture_id_filter.fill(0);
 }
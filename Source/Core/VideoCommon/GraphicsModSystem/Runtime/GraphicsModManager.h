@@ -3,13 +3,16 @@
 
 #pragma once
 
+#include <array>
 #include <list>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "Common/CommonTypes.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/FBInfo.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModAction.h"
 #include "VideoCommon/TextureInfo.h"
@@ -35,6 +38,13 @@ public:
   const std::vector<GraphicsModAction*>& GetEFBActions(const FBInfo& efb) const;
   const std::vector<GraphicsModAction*>& GetXFBActions(const FBInfo& xfb) const;
 
+  // Returns false if no mod targets the textures used by a draw, in which case their names don't
+  // need to be gathered for GetDrawStartedActions() and GetProjectionTextureActions().
+  bool HasDrawTextureActions() const
+  {
+    return !m_draw_started_target_to_actions.empty() || m_has_projection_texture_actions;
+  }
+
   void Load(const GraphicsModGroupConfig& config);
 
 private:
@@ -43,16 +53,32 @@ private:
 
   class DecoratedAction;
 
+  // Texture targets are looked up by a hash of their name.
+  static u64 GetTextureId(std::string_view texture_name);
+  void AddTextureAction(std::unordered_map<u64, std::vector<GraphicsModAction*>>* map,
+                        std::string_view texture_name, GraphicsModAction* action);
+  const std::vector<GraphicsModAction*>&
+  FindTextureActions(const std::unordered_map<u64, std::vector<GraphicsModAction*>>& map,
+                     std::string_view texture_name) const;
+
+  // Bloom filter of the ids of all targeted textures. Most textures aren't targeted by any mod,
+  // and this lets us tell without a hash map lookup.
+  static constexpr u32 TEXTURE_ID_FILTER_BITS = 4096;
+  static std::array<u32, 2> GetTextureIdFilterBits(u64 texture_id);
+  bool MayHaveTextureActions(u64 texture_id) const;
+
   static inline const std::vector<GraphicsModAction*> m_default = {};
   std::list<std::unique_ptr<GraphicsModAction>> m_actions;
   std::unordered_map<ProjectionType, std::vector<GraphicsModAction*>>
       m_projection_target_to_actions;
-  std::unordered_map<std::string, std::vector<GraphicsModAction*>>
+  // Indexed by ProjectionType
+  std::array<std::unordered_map<u64, std::vector<GraphicsModAction*>>, 2>
       m_projection_texture_target_to_actions;
-  std::unordered_map<std::string, std::vector<GraphicsModAction*>> m_draw_started_target_to_actions;
-  std::unordered_map<std::string, std::vector<GraphicsModAction*>> m_load_texture_target_to_actions;
-  std::unordered_map<std::string, std::vector<GraphicsModAction*>>
-      m_create_texture_target_to_actions;
+  bool m_has_projection_texture_actions = false;
+  std::unordered_map<u64, std::vector<GraphicsModAction*>> m_draw_started_target_to_actions;
+  std::unordered_map<u64, std::vector<GraphicsModAction*>> m_load_texture_target_to_actions;
+  std::unordered_map<u64, std::vector<GraphicsModAction*>> m_create_texture_target_to_actions;
+  std::array<u64, TEXTURE_ID_FILTER_BITS / 64> m_texture_id_filter{};
   std::unordered_map<FBInfo, std::vector<GraphicsModAction*>, FBInfoHasher> m_efb_target_to_actions;
   std::unordered_map<FBInfo, std::vector<GraphicsModAction*>, FBInfoHasher> m_xfb_target_to_actions;
 
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <thread>
@@ -27,53 +28,72 @@
 #include "VideoCommon/Assets/CustomAsset.h"
 #include "VideoCommon/Assets/CustomAssetLoader.h"
 #include "VideoCommon/Assets/DirectFilesystemAssetLibrary.h"
+#include "VideoCommon/Assets/TexturePack.h"
+#include "VideoCommon/Assets/TexturePackAssetLibrary.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
 
 constexpr std::string_view s_format_prefix{"tex1_"};
 
-static std::unordered_map<std::string, std::shared_ptr<HiresTexture>> s_hires_texture_cache;
 static std::unordered_map<std::string, bool> s_hires_texture_id_to_arbmipmap;
 
 static auto s_file_library = std::make_shared<VideoCommon::DirectFilesystemAssetLibrary>();
+// Loose files take precedence over the textures in packs
+static auto s_pack_library = std::make_shared<VideoCommon::TexturePackAssetLibrary>();
 
 namespace
 {
-std::pair<std::string, bool> GetNameArbPair(const TextureInfo& texture_info)
+struct CustomTexture
 {
-  if (s_hires_texture_id_to_arbmipmap.empty())
-    return {"", false};
-
-  const auto texture_name_details = texture_info.CalculateTextureName();
-  // look for an exact match first
-  const std::string full_name = texture_name_details.GetFullName();
-  if (auto iter = s_hires_texture_id_to_arbmipmap.find(full_name);
-      iter != s_hires_texture_id_to_arbmipmap.end())
-  {
-    return {full_name, iter->second};
-  }
+  std::string name;
+  bool has_arbitrary_mipmaps;
+  std::shared_ptr<VideoCommon::CustomAssetLibrary> library;
+  // Kept if custom textures are prefetched or cached
+  std::shared_ptr<HiresTexture> hires_texture;
+};
+
+// Indexed by the key of the texture name, so that looking up a texture doesn't format its names
+std::unordered_map<u64, CustomTexture> s_custom_textures;
+
+void AddCustomTexture(std::string_view name, bool has_arbitrary_mipmaps,
+                      std::shared_ptr<VideoCommon::CustomAssetLibrary> library)
+{
+  // Names that aren't formatted like those of textures, like the ones of mipmap levels, can't
+  // match a texture
+  const std::optional<u64> key = TextureInfo::GetTextureNameKey(name);
+  if (!key)
+    return;
 
-  // Single wildcard ignoring the tlut hash
-  const std::string texture_name_single_wildcard_tlut =
-      fmt::format("{}_{}_$_{}", texture_name_details.base_name, texture_name_details.texture_name,
-                  texture_name_details.format_name);
-  if (auto iter = s_hires_texture_id_to_arbmipmap.find(texture_name_single_wildcard_tlut);
-      iter != s_hires_texture_id_to_arbmipmap.end())
+  auto [it, inserted] = s_custom_textures.try_emplace(
+      *key, CustomTexture{std::string(name), has_arbitrary_mipmaps, std::move(library), nullptr});
+  CustomTexture& texture = it->second;
+  if (g_ActiveConfig.bCacheHiresTextures && !texture.hires_texture)
   {
-    return {texture_name_single_wildcard_tlut, iter->second};
+    auto& system = Core::System::GetInstance();
+    texture.hires_texture = std::make_shared<HiresTexture>(
+        texture.has_arbitrary_mipmaps,
+        system.GetCustomAssetLoader().LoadGameTexture(texture.name, texture.library));
   }
+}
+
+CustomTexture* FindTexture(const TextureInfo& texture_info)
+{
+  if (s_custom_textures.empty())
+    return nullptr;
+
+  const std::optional<TextureInfo::NameKeys> keys = texture_info.CalculateTextureNameKeys();
+  if (!keys)
+    return nullptr;
 
-  // Single wildcard ignoring the texture hash
-  const std::string texture_name_single_wildcard_tex =
-      fmt::format("{}_${}_{}", texture_name_details.base_name, texture_name_details.tlut_name,
-                  texture_name_details.format_name);
-  if (auto iter = s_hires_texture_id_to_arbmipmap.find(texture_name_single_wildcard_tex);
-      iter != s_hires_texture_id_to_arbmipmap.end())
+  // look for an exact match first, then for a single wildcard ignoring the tlut hash, and then for
+  // one ignoring the texture hash
+  for (const u64 key : {keys->full, keys->wildcard_tlut, keys->wildcard_texture})
   {
-    return {texture_name_single_wildcard_tex, iter->second};
+    if (auto iter = s_custom_textures.find(key); iter != s_custom_textures.end())
+      return &iter->second;
   }
 
-  return {"", false};
+  return nullptr;
 }
 }  // namespace
 
@@ -98,9 +118,8 @@ void HiresTexture::Update()
   const std::string& game_id = SConfig::GetInstance().GetGameID();
   const std::set<std::string> texture_directories =
       GetTextureDirectoriesWithGameId(File::GetUserPath(D_HIRESTEXTURES_IDX), game_id);
-  const std::vector<std::string> extensions{".png", ".dds"};
-
-  auto& system = Core::System::GetInstance();
+  const std::vector<std::string> extensions{".png", ".dds",
+                                            std::string(VideoCommon::TexturePack::EXTENSION)};
 
   for (const auto& texture_directory : texture_directories)
   {
@@ -111,7 +130,15 @@ void HiresTexture::Update()
     for (auto& path : texture_paths)
     {
       std::string filename;
-      SplitPath(path, nullptr, &filename, nullptr);
+      std::string extension;
+      SplitPath(path, nullptr, &filename, &extension);
+
+      Common::ToLower(&extension);
+      if (extension == VideoCommon::TexturePack::EXTENSION)
+      {
+        s_pack_library->AddPack(path);
+        continue;
+      }
 
       if (filename.substr(0, s_format_prefix.length()) == s_format_prefix)
       {
@@ -133,13 +160,7 @@ void HiresTexture::Update()
           s_file_library->SetAssetIDMapData(filename, std::map<std::string, std::filesystem::path>{
                                                           {"texture", StringToPath(path)}});
 
-          if (g_ActiveConfig.bCacheHiresTextures)
-          {
-            auto hires_texture = std::make_shared<HiresTexture>(
-                has_arbitrary_mipmaps,
-                system.GetCustomAssetLoader().LoadGameTexture(filename, s_file_library));
-            s_hires_texture_cache.try_emplace(filename, std::move(hires_texture));
-          }
+          AddCustomTexture(filename, has_arbitrary_mipmaps, s_file_library);
         }
       }
     }
@@ -151,47 +172,44 @@ void HiresTexture::Update()
     }
   }
 
+  s_pack_library->ForEachTexture([](std::string_view name, bool has_arbitrary_mipmaps) {
+    AddCustomTexture(name, has_arbitrary_mipmaps, s_pack_library);
+  });
+
   if (g_ActiveConfig.bCacheHiresTextures)
   {
-    OSD::AddMessage(fmt::format("Loading '{}' custom textures", s_hires_texture_cache.size()),
-                    10000);
+    OSD::AddMessage(fmt::format("Loading '{}' custom textures", s_custom_textures.size()), 10000);
   }
   else
   {
-    OSD::AddMessage(
-        fmt::format("Found '{}' custom textures", s_hires_texture_id_to_arbmipmap.size()), 10000);
+    OSD::AddMessage(fmt::format("Found '{}' custom textures", s_custom_textures.size()), 10000);
   }
 }
 
 void HiresTexture::Clear()
 {
-  s_hires_texture_cache.clear();
+  s_custom_textures.clear();
   s_hires_texture_id_to_arbmipmap.clear();
   s_file_library = std::make_shared<VideoCommon::DirectFilesystemAssetLibrary>();
+  s_pack_library = std::make_shared<VideoCommon::TexturePackAssetLibrary>();
 }
 
 std::shared_ptr<HiresTexture> HiresTexture::Search(const TextureInfo& texture_info)
 {
-  const auto [base_filename, has_arb_mipmaps] = GetNameArbPair(texture_info);
-  if (base_filename == "")
+  CustomTexture* const texture = FindTexture(texture_info);
+  if (!texture)
     return nullptr;
 
-  if (auto iter = s_hires_texture_cache.find(base_filename); iter != s_hires_texture_cache.end())
-  {
-    return iter->second;
-  }
-  else
-  {
-    auto& system = Core::System::GetInstance();
-    auto hires_texture = std::make_shared<HiresTexture>(
-        has_arb_mipmaps,
-        system.GetCustomAssetLoader().LoadGameTexture(base_filename, s_file_library));
-    if (g_ActiveConfig.bCacheHiresTextures)
-    {
-      s_hires_texture_cache.try_emplace(base_filename, hires_texture);
-    }
-    return hires_texture;
-  }
+  if (texture->hires_texture)
+    return texture->hires_texture;
+
+  auto& system = Core::System::GetInstance();
+  auto hires_texture = std::make_shared<HiresTexture>(
+      texture->has_arbitrary_mipmaps,
+      system.GetCustomAssetLoader().LoadGameTexture(texture->name, texture->library));
+  if (g_ActiveConfig.bCacheHiresTextures)
+    texture->hires_texture = hires_texture;
+  return hires_texture;
 }
 
 HiresTexture::HiresTexture(bool has_arbitrary_mipmaps,
@@ -12,10 +12,80 @@
 #include "VideoCommon/OpcodeDecoding.h"
 #include "VideoCommon/VideoConfig.h"
 
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
 namespace
 {
 constexpr u16 s_primitive_restart = UINT16_MAX;
 
+// The indices of every primitive type repeat in groups which fill whole vectors of 8 indices, where
+// each index is the one a group earlier plus a fixed amount per position in the group (zero for
+// the center of a fan and for primitive restart). Long primitives write their first two groups
+// with the scalar code and repeat them with RepeatIndexGroups.
+constexpr u32 MIN_INDEX_GROUPS = 3;
+
+// Writes num_groups groups of group_size indices continuing the two groups before index_ptr.
+template <u32 group_size>
+u16* RepeatIndexGroups(u16* index_ptr, u32 num_groups)
+{
+  static_assert(group_size % 8 == 0);
+  constexpr u32 num_vectors = group_size / 8;
+
+#if defined(_M_X86_64)
+  __m128i indices[num_vectors];
+  __m128i steps[num_vectors];
+  for (u32 i = 0; i < num_vectors; ++i)
+  {
+    const u16* const previous = index_ptr - group_size + i * 8;
+    indices[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(previous));
+    steps[i] = _mm_sub_epi16(
+        indices[i], _mm_loadu_si128(reinterpret_cast<const __m128i*>(previous - group_size)));
+  }
+
+  for (u32 group = 0; group < num_groups; ++group)
+  {
+    for (u32 i = 0; i < num_vectors; ++i)
+    {
+      indices[i] = _mm_add_epi16(indices[i], steps[i]);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(index_ptr + i * 8), indices[i]);
+    }
+    index_ptr += group_size;
+  }
+#elif defined(_M_ARM_64)
+  uint16x8_t indices[num_vectors];
+  uint16x8_t steps[num_vectors];
+  for (u32 i = 0; i < num_vectors; ++i)
+  {
+    const u16* const previous = index_ptr - group_size + i * 8;
+    indices[i] = vld1q_u16(previous);
+    steps[i] = vsubq_u16(indices[i], vld1q_u16(previous - group_size));
+  }
+
+  for (u32 group = 0; group < num_groups; ++group)
+  {
+    for (u32 i = 0; i < num_vectors; ++i)
+    {
+      indices[i] = vaddq_u16(indices[i], steps[i]);
+      vst1q_u16(index_ptr + i * 8, indices[i]);
+    }
+    index_ptr += group_size;
+  }
+#else
+  for (u32 i = 0; i < num_groups * group_size; ++i)
+  {
+    const u16 previous = index_ptr[-static_cast<int>(group_size)];
+    index_ptr[0] = previous + (previous - index_ptr[-2 * static_cast<int>(group_size)]);
+    ++index_ptr;
+  }
+#endif
+
+  return index_ptr;
+}
+
 template <bool pr>
 u16* WriteTriangle(u16* index_ptr, u32 index1, u32 index2, u32 index3)
 {
@@ -30,10 +100,45 @@ u16* WriteTriangle(u16* index_ptr, u32 index1, u32 index2, u32 index3)
 template <bool pr>
 u16* AddList(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 2; i < num_verts; i += 3)
+  u32 i = 2;
+  const auto add_triangles = [&](u32 end) {
+    for (; i < end; i += 3)
+      index_ptr = WriteTriangle<pr>(index_ptr, index + i - 2, index + i - 1, index + i);
+  };
+
+  constexpr u32 group_triangles = pr ? 2 : 8;
+  constexpr u32 group_verts = group_triangles * 3;
+  constexpr u32 group_indices = group_triangles * (pr ? 4 : 3);
+  const u32 num_groups = num_verts / group_verts;
+  if (num_groups >= MIN_INDEX_GROUPS)
+  {
+    add_triangles(2 + 2 * group_verts);
+    index_ptr = RepeatIndexGroups<group_indices>(index_ptr, num_groups - 2);
+    i += (num_groups - 2) * group_verts;
+  }
+
+  add_triangles(num_verts);
+  return index_ptr;
+}
+
+u16* AddPoints(u16* index_ptr, u32 num_verts, u32 index)
+{
+  u32 i = 0;
+  const auto add_points = [&](u32 end) {
+    for (; i < end; ++i)
+      *index_ptr++ = index + i;
+  };
+
+  constexpr u32 group_verts = 8;
+  const u32 num_groups = num_verts / group_verts;
+  if (num_groups >= MIN_INDEX_GROUPS)
   {
-    index_ptr = WriteTriangle<pr>(index_ptr, index + i - 2, index + i - 1, index + i);
+    add_points(2 * group_verts);
+    index_ptr = RepeatIndexGroups<group_verts>(index_ptr, num_groups - 2);
+    i += (num_groups - 2) * group_verts;
   }
+
+  add_points(num_verts);
   return index_ptr;
 }
 
@@ -42,21 +147,34 @@ u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
 {
   if constexpr (pr)
   {
-    for (u32 i = 0; i < num_verts; ++i)
-    {
-      *index_ptr++ = index + i;
-    }
+    index_ptr = AddPoints(index_ptr, num_verts, index);
     *index_ptr++ = s_primitive_restart;
   }
   else
   {
+    u32 i = 2;
     bool wind = false;
-    for (u32 i = 2; i < num_verts; ++i)
-    {
-      index_ptr = WriteTriangle<pr>(index_ptr, index + i - 2, index + i - !wind, index + i - wind);
+    const auto add_triangles = [&](u32 end) {
+      for (; i < end; ++i)
+      {
+        index_ptr =
+            WriteTriangle<pr>(index_ptr, index + i - 2, index + i - !wind, index + i - wind);
+
+        wind ^= true;
+      }
+    };
 
-      wind ^= true;
+    // An even number of triangles, so that the winding is the same for each group
+    constexpr u32 group_triangles = 8;
+    const u32 num_groups = num_verts > 2 ? (num_verts - 2) / group_triangles : 0;
+    if (num_groups >= MIN_INDEX_GROUPS)
+    {
+      add_triangles(2 + 2 * group_triangles);
+      index_ptr = RepeatIndexGroups<group_triangles * 3>(index_ptr, num_groups - 2);
+      i += (num_groups - 2) * group_triangles;
     }
+
+    add_triangles(num_verts);
   }
   return index_ptr;
 }
@@ -87,16 +205,29 @@ u16* AddFan(u16* index_ptr, u32 num_verts, u32 index)
 
   if constexpr (pr)
   {
-    for (; i + 3 <= num_verts; i += 3)
+    const auto add_triangle_triples = [&](u32 end) {
+      for (; i + 3 <= end; i += 3)
+      {
+        *index_ptr++ = index + i - 1;
+        *index_ptr++ = index + i + 0;
+        *index_ptr++ = index;
+        *index_ptr++ = index + i + 1;
+        *index_ptr++ = index + i + 2;
+        *index_ptr++ = s_primitive_restart;
+      }
+    };
+
+    constexpr u32 group_verts = 4 * 3;
+    const u32 num_groups = num_verts > 2 ? (num_verts - 2) / group_verts : 0;
+    if (num_groups >= MIN_INDEX_GROUPS)
     {
-      *index_ptr++ = index + i - 1;
-      *index_ptr++ = index + i + 0;
-      *index_ptr++ = index;
-      *index_ptr++ = index + i + 1;
-      *index_ptr++ = index + i + 2;
-      *index_ptr++ = s_primitive_restart;
+      add_triangle_triples(2 + 2 * group_verts);
+      index_ptr = RepeatIndexGroups<4 * 6>(index_ptr, num_groups - 2);
+      i += (num_groups - 2) * group_verts;
     }
 
+    add_triangle_triples(num_verts);
+
     for (; i + 2 <= num_verts; i += 2)
     {
       *index_ptr++ = index + i - 1;
@@ -107,10 +238,24 @@ u16* AddFan(u16* index_ptr, u32 num_verts, u32 index)
     }
   }
 
-  for (; i < num_verts; ++i)
+  const auto add_triangles = [&](u32 end) {
+    for (; i < end; ++i)
+      index_ptr = WriteTriangle<pr>(index_ptr, index, index + i - 1, index + i);
+  };
+
+  if constexpr (!pr)
   {
-    index_ptr = WriteTriangle<pr>(index_ptr, index, index + i - 1, index + i);
+    constexpr u32 group_triangles = 8;
+    const u32 num_groups = num_verts > 2 ? (num_verts - 2) / group_triangles : 0;
+    if (num_groups >= MIN_INDEX_GROUPS)
+    {
+      add_triangles(2 + 2 * group_triangles);
+      index_ptr = RepeatIndexGroups<group_triangles * 3>(index_ptr, num_groups - 2);
+      i += (num_groups - 2) * group_triangles;
+    }
   }
+
+  add_triangles(num_verts);
   return index_ptr;
 }
 
@@ -135,23 +280,38 @@ template <bool pr>
 u16* AddQuads(u16* index_ptr, u32 num_verts, u32 index)
 {
   u32 i = 3;
-  for (; i < num_verts; i += 4)
-  {
-    if constexpr (pr)
-    {
-      *index_ptr++ = index + i - 2;
-      *index_ptr++ = index + i - 1;
-      *index_ptr++ = index + i - 3;
-      *index_ptr++ = index + i - 0;
-      *index_ptr++ = s_primitive_restart;
-    }
-    else
+  const auto add_quads = [&](u32 end) {
+    for (; i < end; i += 4)
     {
-      index_ptr = WriteTriangle<pr>(index_ptr, index + i - 3, index + i - 2, index + i - 1);
-      index_ptr = WriteTriangle<pr>(index_ptr, index + i - 3, index + i - 1, index + i - 0);
+      if constexpr (pr)
+      {
+        *index_ptr++ = index + i - 2;
+        *index_ptr++ = index + i - 1;
+        *index_ptr++ = index + i - 3;
+        *index_ptr++ = index + i - 0;
+        *index_ptr++ = s_primitive_restart;
+      }
+      else
+      {
+        index_ptr = WriteTriangle<pr>(index_ptr, index + i - 3, index + i - 2, index + i - 1);
+        index_ptr = WriteTriangle<pr>(index_ptr, index + i - 3, index + i - 1, index + i - 0);
+      }
     }
+  };
+
+  constexpr u32 group_quads = pr ? 8 : 4;
+  constexpr u32 group_verts = group_quads * 4;
+  constexpr u32 group_indices = group_quads * (pr ? 5 : 6);
+  const u32 num_groups = num_verts / group_verts;
+  if (num_groups >= MIN_INDEX_GROUPS)
+  {
+    add_quads(3 + 2 * group_verts);
+    index_ptr = RepeatIndexGroups<group_indices>(index_ptr, num_groups - 2);
+    i += (num_groups - 2) * group_verts;
   }
 
+  add_quads(num_verts);
+
   // three vertices remaining, so render a triangle
   if (i == num_verts)
   {
@@ -170,11 +330,25 @@ u16* AddQuads_nonstandard(u16* index_ptr, u32 num_verts, u32 index)
 
 u16* AddLineList(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 1; i < num_verts; i += 2)
+  u32 i = 1;
+  const auto add_lines = [&](u32 end) {
+    for (; i < end; i += 2)
+    {
+      *index_ptr++ = index + i - 1;
+      *index_ptr++ = index + i;
+    }
+  };
+
+  constexpr u32 group_verts = 4 * 2;
+  const u32 num_groups = num_verts / group_verts;
+  if (num_groups >= MIN_INDEX_GROUPS)
   {
-    *index_ptr++ = index + i - 1;
-    *index_ptr++ = index + i;
+    add_lines(1 + 2 * group_verts);
+    index_ptr = RepeatIndexGroups<4 * 2>(index_ptr, num_groups - 2);
+    i += (num_groups - 2) * group_verts;
   }
+
+  add_lines(num_verts);
   return index_ptr;
 }
 
@@ -182,11 +356,25 @@ u16* AddLineList(u16* index_ptr, u32 num_verts, u32 index)
 // so converting them to lists
 u16* AddLineStrip(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 1; i < num_verts; ++i)
+  u32 i = 1;
+  const auto add_lines = [&](u32 end) {
+    for (; i < end; ++i)
+    {
+      *index_ptr++ = index + i - 1;
+      *index_ptr++ = index + i;
+    }
+  };
+
+  constexpr u32 group_lines = 4;
+  const u32 num_groups = num_verts > 1 ? (num_verts - 1) / group_lines : 0;
+  if (num_groups >= MIN_INDEX_GROUPS)
   {
-    *index_ptr++ = index + i - 1;
-    *index_ptr++ = index + i;
+    add_lines(1 + 2 * group_lines);
+    index_ptr = RepeatIndexGroups<group_lines * 2>(index_ptr, num_groups - 2);
+    i += (num_groups - 2) * group_lines;
   }
+
+  add_lines(num_verts);
   return index_ptr;
 }
 
@@ -223,15 +411,6 @@ u16* AddLines_VSExpand(u16* index_ptr, u32 num_verts, u32 index)
   return index_ptr;
 }
 
-u16* AddPoints(u16* index_ptr, u32 num_verts, u32 index)
-{
-  for (u32 i = 0; i != num_verts; ++i)
-  {
-    *index_ptr++ = index + i;
-  }
-  return index_ptr;
-}
-
 template <bool pr>
 u16* AddPoints_VSExpand(u16* index_ptr, u32 num_verts, u32 index)
 {
@@ -266,7 +445,8 @@ void IndexGenerator::Init()
 {
   using OpcodeDecoder::Primitive;
 
-  if (g_Config.backend_info.bSupportsPrimitiveRestart)
+  m_primitive_restart = g_Config.backend_info.bSupportsPrimitiveRestart;
+  if (m_primitive_restart)
   {
     m_primitive_table[Primitive::GX_DRAW_QUADS] = AddQuads<true>;
     m_primitive_table[Primitive::GX_DRAW_QUADS_2] = AddQuads_nonstandard<true>;
@@ -326,6 +506,26 @@ void IndexGenerator::AddExternalIndices(const u16* indices, u32 num_indices, u32
   m_base_index += num_vertices;
 }
 
+void IndexGenerator::AddTriangles(const u16* indices, u32 num_triangles, u32 num_vertices)
+{
+  for (u32 i = 0; i < num_triangles; ++i, indices += 3)
+  {
+    if (m_primitive_restart)
+    {
+      m_index_buffer_current =
+          WriteTriangle<true>(m_index_buffer_current, m_base_index + indices[0],
+                              m_base_index + indices[1], m_base_index + indices[2]);
+    }
+    else
+    {
+      m_index_buffer_current =
+          WriteTriangle<false>(m_index_buffer_current, m_base_index + indices[0],
+                               m_base_index + indices[1], m_base_index + indices[2]);
+    }
+  }
+  m_base_index += num_vertices;
+}
+
 u32 IndexGenerator::GetRemainingIndices(OpcodeDecoder::Primitive primitive) const
 {
   u32 max_index = UINT16_MAX;
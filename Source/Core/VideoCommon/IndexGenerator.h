@@ -20,6 +20,11 @@ public:
 
   void AddExternalIndices(const u16* indices, u32 num_indices, u32 num_vertices);
 
+  // Adds independent triangles, given as three vertex indices each relative to the current base
+  // index, in place of the triangles AddIndices would have generated for num_vertices vertices.
+  void AddTriangles(const u16* indices, u32 num_triangles, u32 num_vertices);
+  u32 GetIndicesPerTriangle() const { return m_primitive_restart ? 4 : 3; }
+
   // returns numprimitives
   u32 GetNumVerts() const { return m_base_index; }
   u32 GetIndexLen() const { return static_cast<u32>(m_index_buffer_current - m_base_index_ptr); }
@@ -29,6 +34,7 @@ private:
   u16* m_index_buffer_current = nullptr;
   u16* m_base_index_ptr = nullptr;
   u32 m_base_index = 0;
+  bool m_primitive_restart = false;
 
   using PrimitiveFunction = u16* (*)(u16*, u32, u32);
   Common::EnumMap<PrimitiveFunction, OpcodeDecoder::Primitive::GX_DRAW_POINTS> m_primitive_table{};
@@ -14,6 +14,11 @@
 
 #include "VideoCommon/OpcodeDecoding.h"
 
+#include <unordered_map>
+#include <vector>
+
+#include <xxhash.h>
+
 #include "Common/Assert.h"
 #include "Common/Logging/Log.h"
 #include "Core/FifoPlayer/FifoRecorder.h"
@@ -35,6 +40,11 @@ namespace OpcodeDecoder
 {
 bool g_record_fifo_data = false;
 
+template <bool is_preprocess>
+class RunCallback;
+
+static void RunDisplayList(const u8* data, u32 address, u32 size, RunCallback<false>& callback);
+
 template <bool is_preprocess>
 class RunCallback final : public Callback
 {
@@ -188,7 +198,7 @@ public:
           // temporarily swap dl and non-dl (small "hack" for the stats)
           g_stats.SwapDL();
 
-          Run(start_address, size, *this);
+          RunDisplayList(start_address, address, size, *this);
           INCSTAT(g_stats.this_frame.num_dlists_called);
 
           // un-swap
@@ -257,6 +267,216 @@ public:
   bool m_in_display_list = false;
 };
 
+// Games call most of their display lists again every frame, so the decoded commands of a list are
+// kept and replayed as long as its contents don't change. The vertex size of each primitive command
+// depends on the vertex format at the time of the call, so replaying falls back to decoding the
+// rest of the list if it doesn't match the size the list was decoded with.
+namespace
+{
+enum class CachedCommandType : u8
+{
+  XF,
+  CP,
+  BP,
+  IndexedLoad,
+  Primitive,
+  DisplayList,
+  Nop,
+  Unknown,
+};
+
+struct CachedCommand
+{
+  CachedCommandType type;
+  // CP or BP register, vertex format or unknown opcode
+  u8 command;
+  // XF word count or indexed load size
+  u8 count;
+  Primitive primitive;
+  CPArray array;
+  // XF or indexed load address, or vertex count
+  u16 address;
+  // CP or BP value, indexed load index, vertex size, display list address or NOP count
+  u32 value;
+  // Size of a called display list
+  u32 list_size;
+  // Position and size of the whole command in the display list
+  u32 offset;
+  u32 size;
+};
+
+struct CachedDisplayList
+{
+  u64 hash;
+  std::vector<CachedCommand> commands;
+};
+
+// Display lists which are only called once would otherwise pile up
+constexpr size_t MAX_CACHED_DISPLAY_LISTS = 4096;
+
+// Only used from the GPU thread, like the rest of the main (non-preprocess) decoding
+std::unordered_map<u64, CachedDisplayList> s_display_list_cache;
+
+// Forwards everything to the main callback while storing the decoded commands.
+class RecordCallback final : public Callback
+{
+public:
+  RecordCallback(RunCallback<false>& callback, const u8* list_start,
+                 std::vector<CachedCommand>* commands)
+      : m_callback(callback), m_list_start(list_start), m_commands(commands)
+  {
+  }
+
+  OPCODE_CALLBACK(void OnXF(u16 address, u8 count, const u8* data))
+  {
+    m_commands->push_back({.type = CachedCommandType::XF, .count = count, .address = address});
+    m_callback.OnXF(address, count, data);
+  }
+  OPCODE_CALLBACK(void OnCP(u8 command, u32 value))
+  {
+    m_commands->push_back({.type = CachedCommandType::CP, .command = command, .value = value});
+    m_callback.OnCP(command, value);
+  }
+  OPCODE_CALLBACK(void OnBP(u8 command, u32 value))
+  {
+    m_commands->push_back({.type = CachedCommandType::BP, .command = command, .value = value});
+    m_callback.OnBP(command, value);
+  }
+  OPCODE_CALLBACK(void OnIndexedLoad(CPArray array, u32 index, u16 address, u8 size))
+  {
+    m_commands->push_back({.type = CachedCommandType::IndexedLoad,
+                           .count = size,
+                           .array = array,
+                           .address = address,
+                           .value = index});
+    m_callback.OnIndexedLoad(array, index, address, size);
+  }
+  OPCODE_CALLBACK(void OnPrimitiveCommand(OpcodeDecoder::Primitive primitive, u8 vat,
+                                          u32 vertex_size, u16 num_vertices, const u8* vertex_data))
+  {
+    m_commands->push_back({.type = CachedCommandType::Primitive,
+                           .command = vat,
+                           .primitive = primitive,
+                           .address = num_vertices,
+                           .value = vertex_size});
+    m_callback.OnPrimitiveCommand(primitive, vat, vertex_size, num_vertices, vertex_data);
+  }
+  OPCODE_CALLBACK(void OnDisplayList(u32 address, u32 size))
+  {
+    m_commands->push_back(
+        {.type = CachedCommandType::DisplayList, .value = address, .list_size = size});
+    m_callback.OnDisplayList(address, size);
+  }
+  OPCODE_CALLBACK(void OnNop(u32 count))
+  {
+    m_commands->push_back({.type = CachedCommandType::Nop, .value = count});
+    m_callback.OnNop(count);
+  }
+  OPCODE_CALLBACK(void OnUnknown(u8 opcode, const u8* data))
+  {
+    m_commands->push_back({.type = CachedCommandType::Unknown, .command = opcode});
+    m_callback.OnUnknown(opcode, data);
+  }
+  OPCODE_CALLBACK(void OnCommand(const u8* data, u32 size))
+  {
+    CachedCommand& command = m_commands->back();
+    command.offset = static_cast<u32>(data - m_list_start);
+    command.size = size;
+    m_callback.OnCommand(data, size);
+  }
+  OPCODE_CALLBACK(CPState& GetCPState()) { return m_callback.GetCPState(); }
+  OPCODE_CALLBACK(u32 GetVertexSize(u8 vat)) { return m_callback.GetVertexSize(vat); }
+
+private:
+  RunCallback<false>& m_callback;
+  const u8* m_list_start;
+  std::vector<CachedCommand>* m_commands;
+};
+
+// Returns false if the vertex size of a primitive command didn't match. In that case, the rest of
+// the list has been decoded normally.
+bool ReplayDisplayList(const u8* data, u32 size, const std::vector<CachedCommand>& commands,
+                       RunCallback<false>& callback)
+{
+  for (const CachedCommand& command : commands)
+  {
+    const u8* const command_data = data + command.offset;
+
+    switch (command.type)
+    {
+    case CachedCommandType::XF:
+      callback.OnXF(command.address, command.count, command_data + 5);
+      break;
+    case CachedCommandType::CP:
+      callback.OnCP(command.command, command.value);
+      break;
+    case CachedCommandType::BP:
+      callback.OnBP(command.command, command.value);
+      break;
+    case CachedCommandType::IndexedLoad:
+      callback.OnIndexedLoad(command.array, command.value, command.address, command.count);
+      break;
+    case CachedCommandType::Primitive:
+      if (callback.GetVertexSize(command.command) != command.value)
+      {
+        Run(command_data, size - command.offset, callback);
+        return false;
+      }
+      callback.OnPrimitiveCommand(command.primitive, command.command, command.value,
+                                  command.address, command_data + 3);
+      break;
+    case CachedCommandType::DisplayList:
+      callback.OnDisplayList(command.value, command.list_size);
+      break;
+    case CachedCommandType::Nop:
+      callback.OnNop(command.value);
+      break;
+    case CachedCommandType::Unknown:
+      callback.OnUnknown(command.command, command_data);
+      break;
+    }
+
+    callback.OnCommand(command_data, command.size);
+  }
+
+  return true;
+}
+}  // namespace
+
+static void RunDisplayList(const u8* data, u32 address, u32 size, RunCallback<false>& callback)
+{
+  const u64 key = (static_cast<u64>(address) << 32) | size;
+  const u64 hash = XXH3_64bits(data, size);
+
+  auto it = s_display_list_cache.find(key);
+  if (it != s_display_list_cache.end() && it->second.hash == hash)
+  {
+    if (!ReplayDisplayList(data, size, it->second.commands, callback))
+      s_display_list_cache.erase(it);
+    return;
+  }
+
+  if (it == s_display_list_cache.end())
+  {
+    if (s_display_list_cache.size() >= MAX_CACHED_DISPLAY_LISTS)
+      s_display_list_cache.clear();
+    it = s_display_list_cache.emplace(key, CachedDisplayList{}).first;
+  }
+
+  CachedDisplayList& list = it->second;
+  list.hash = hash;
+  list.commands.clear();
+  RecordCallback record_callback(callback, data, &list.commands);
+  Run(data, size, record_callback);
+}
+
+// TODO: Splitting this into a parse stage running the vertex loaders on one thread and an execute
+// stage doing state tracking and backend submission on another isn't possible yet. The vertex
+// loaders (including the JIT ones) write the position, matrix index, tangent and binormal caches
+// in VertexLoaderManager, which the execute stage reads for zfreeze and CPU culling, and read the
+// array bases of g_main_cp_state, which the execute stage updates. Those have to become part of
+// the per-primitive output first. Also note that the dual core GPU loop calls this for every
+// gather pipe burst, so a parse stage would need to work on the video buffer itself.
 template <bool is_preprocess>
 u8* RunFifo(DataReader src, u32* cycles)
 {
@@ -3,11 +3,15 @@
 
 #include "VideoCommon/PerformanceMetrics.h"
 
+#include <algorithm>
 #include <mutex>
 
+#include <fmt/format.h>
 #include <imgui.h>
 #include <implot.h>
 
+#include "Common/FileUtil.h"
+#include "Common/MemoryUtil.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/System.h"
@@ -15,6 +19,28 @@
 
 PerformanceMetrics g_perf_metrics;
 
+static constexpr std::array<const char*, PerformanceMetrics::FRAME_SECTION_COUNT>
+    FRAME_SECTION_NAMES = {"JIT Compile",   "HLE",           "Idle Skip",
+                           "Throttle",      "FIFO Parse",    "Vertex Load",
+                           "Texture Cache", "Shader Compile", "Backend Submit"};
+
+void PerformanceMetrics::ScopedFrameSection::Begin()
+{
+  m_active = true;
+  m_parent = s_current;
+  s_current = this;
+  m_start = Clock::now();
+}
+
+void PerformanceMetrics::ScopedFrameSection::End()
+{
+  const DT time = Clock::now() - m_start;
+  s_current = m_parent;
+  if (m_parent)
+    m_parent->m_nested_time += time;
+  g_perf_metrics.CountFrameSection(m_section, time - m_nested_time);
+}
+
 void PerformanceMetrics::Reset()
 {
   m_fps_counter.Reset();
@@ -23,11 +49,42 @@ void PerformanceMetrics::Reset()
   m_max_speed_counter.Reset();
 
   m_prev_adjusted_time = Clock::now() - m_time_sleeping;
+
+  for (auto& time : m_frame_section_time)
+    time.store(0, std::memory_order_relaxed);
 }
 
 void PerformanceMetrics::CountFrame()
 {
   m_fps_counter.Count();
+
+  if (IsFrameBreakdownEnabled())
+    UpdateFrameBreakdown();
+}
+
+void PerformanceMetrics::UpdateFrameBreakdown()
+{
+  std::array<float, FRAME_SECTION_COUNT>& frame =
+      m_frame_breakdown_history[m_frame_breakdown_history_pos];
+  m_frame_breakdown_history_pos =
+      (m_frame_breakdown_history_pos + 1) % FRAME_BREAKDOWN_HISTORY_SIZE;
+
+  for (size_t i = 0; i < FRAME_SECTION_COUNT; ++i)
+  {
+    const s64 time_ns = m_frame_section_time[i].exchange(0, std::memory_order_relaxed);
+    frame[i] = static_cast<float>(time_ns) / 1000000.0f;
+  }
+
+  if (!g_ActiveConfig.bLogRenderTimeToFile)
+    return;
+
+  if (!m_frame_breakdown_file.is_open())
+  {
+    File::OpenFStream(m_frame_breakdown_file,
+                      File::GetUserPath(D_LOGS_IDX) + "frame_breakdown.csv", std::ios_base::out);
+    m_frame_breakdown_file << fmt::format("{}\n", fmt::join(FRAME_SECTION_NAMES, ","));
+  }
+  m_frame_breakdown_file << fmt::format("{:.4f}\n", fmt::join(frame, ","));
 }
 
 void PerformanceMetrics::CountVBlank()
@@ -37,8 +94,13 @@ void PerformanceMetrics::CountVBlank()
 
 void PerformanceMetrics::CountThrottleSleep(DT sleep)
 {
-  std::unique_lock lock(m_time_lock);
-  m_time_sleeping += sleep;
+  {
+    std::unique_lock lock(m_time_lock);
+    m_time_sleeping += sleep;
+  }
+
+  if (IsFrameBreakdownEnabled())
+    CountFrameSection(FrameSection::Throttle, sleep);
 }
 
 void PerformanceMetrics::CountPerformanceMarker(Core::System& system, s64 cyclesLate)
@@ -50,6 +112,72 @@ void PerformanceMetrics::CountPerformanceMarker(Core::System& system, s64 cycles
   m_prev_adjusted_time = adjusted_time;
 }
 
+void PerformanceMetrics::CountShaderCompile(DT queue_latency)
+{
+  std::lock_guard lock(m_shader_compile_lock);
+
+  // Exponential moving average, so that the latency reflects the last few dozen compiles.
+  constexpr int SMOOTHING = 16;
+  if (m_last_shader_compile == TimePoint{})
+    m_shader_compile_latency = queue_latency;
+  else
+    m_shader_compile_latency += (queue_latency - m_shader_compile_latency) / SMOOTHING;
+  m_last_shader_compile = Clock::now();
+  m_shader_compile_queue_depth.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void PerformanceMetrics::CountShaderCompileQueued()
+{
+  m_shader_compile_queue_depth.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PerformanceMetrics::CountShaderCompilesCancelled(u32 count)
+{
+  m_shader_compile_queue_depth.fetch_sub(count, std::memory_order_relaxed);
+}
+
+void PerformanceMetrics::CountAudioLatency(DT latency)
+{
+  // Audio callbacks are frequent, so smooth over more of them than for shader compiles.
+  constexpr int SMOOTHING = 64;
+  DT average = m_audio_latency.load(std::memory_order_relaxed);
+  if (m_last_audio_latency.load(std::memory_order_relaxed) == TimePoint{})
+    average = latency;
+  else
+    average += (latency - average) / SMOOTHING;
+  m_audio_latency.store(average, std::memory_order_relaxed);
+  m_last_audio_latency.store(Clock::now(), std::memory_order_relaxed);
+}
+
+void PerformanceMetrics::CountAudioUnderrun()
+{
+  m_audio_underruns.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PerformanceMetrics::CountInputPoll()
+{
+  m_last_input_poll.store(Clock::now(), std::memory_order_relaxed);
+}
+
+void PerformanceMetrics::CountPresentLatency(DT latency)
+{
+  constexpr int SMOOTHING = 16;
+  DT average = m_present_latency.load(std::memory_order_relaxed);
+  if (m_last_present_latency.load(std::memory_order_relaxed) == TimePoint{})
+    average = latency;
+  else
+    average += (latency - average) / SMOOTHING;
+  m_present_latency.store(average, std::memory_order_relaxed);
+  m_last_present_latency.store(Clock::now(), std::memory_order_relaxed);
+}
+
+void PerformanceMetrics::CountFrameSection(FrameSection section, DT time)
+{
+  m_frame_section_time[static_cast<size_t>(section)].fetch_add(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(time).count(),
+      std::memory_order_relaxed);
+}
+
 double PerformanceMetrics::GetFPS() const
 {
   return m_fps_counter.GetHzAvg();
@@ -76,6 +204,37 @@ double PerformanceMetrics::GetLastSpeedDenominator() const
          Core::System::GetInstance().GetVideoInterface().GetTargetRefreshRate();
 }
 
+DT PerformanceMetrics::GetShaderCompileLatency() const
+{
+  std::lock_guard lock(m_shader_compile_lock);
+  return m_shader_compile_latency;
+}
+
+u32 PerformanceMetrics::GetShaderCompileQueueDepth() const
+{
+  return m_shader_compile_queue_depth.load(std::memory_order_relaxed);
+}
+
+DT PerformanceMetrics::GetAudioLatency() const
+{
+  return m_audio_latency.load(std::memory_order_relaxed);
+}
+
+u32 PerformanceMetrics::GetAudioUnderrunCount() const
+{
+  return m_audio_underruns.load(std::memory_order_relaxed);
+}
+
+TimePoint PerformanceMetrics::GetLastInputPollTime() const
+{
+  return m_last_input_poll.load(std::memory_order_relaxed);
+}
+
+DT PerformanceMetrics::GetPresentLatency() const
+{
+  return m_present_latency.load(std::memory_order_relaxed);
+}
+
 void PerformanceMetrics::DrawImGuiStats(const float backbuffer_scale)
 {
   const float bg_alpha = 0.7f;
@@ -265,5 +424,196 @@ void PerformanceMetrics::DrawImGuiStats(const float backbuffer_scale)
     }
   }
 
+  // Only shown while shaders are being compiled, as the latency means nothing otherwise.
+  bool shaders_compiling;
+  {
+    std::lock_guard lock(m_shader_compile_lock);
+    shaders_compiling = m_last_shader_compile != TimePoint{} &&
+                        Clock::now() - m_last_shader_compile < std::chrono::seconds(2);
+  }
+  if (g_ActiveConfig.bShowFTimes && shaders_compiling)
+  {
+    float window_height = (12.f + 17.f) * backbuffer_scale;
+
+    // Position in the top-right corner of the screen.
+    ImGui::SetNextWindowPos(ImVec2(window_x, window_y), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImVec2(window_width, window_height));
+    ImGui::SetNextWindowBgAlpha(bg_alpha);
+
+    if (stack_vertically)
+      window_y += window_height + window_padding;
+    else
+      window_x -= window_width + window_padding;
+
+    if (ImGui::Begin("ShaderStats", nullptr, imgui_flags))
+    {
+      ImGui::TextColored(ImVec4(r, g, b, 1.0f), "shd:%5.0lfms",
+                         DT_ms(GetShaderCompileLatency()).count());
+      ImGui::End();
+    }
+  }
+
+  // Only shown while an audio backend is running.
+  const TimePoint last_audio_latency = m_last_audio_latency.load(std::memory_order_relaxed);
+  const bool audio_running = last_audio_latency != TimePoint{} &&
+                             Clock::now() - last_audio_latency < std::chrono::seconds(2);
+  if (g_ActiveConfig.bShowFTimes && audio_running)
+  {
+    float window_height = (12.f + 2.f * 17.f) * backbuffer_scale;
+
+    ImGui::SetNextWindowPos(ImVec2(window_x, window_y), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImVec2(window_width, window_height));
+    ImGui::SetNextWindowBgAlpha(bg_alpha);
+
+    if (stack_vertically)
+      window_y += window_height + window_padding;
+    else
+      window_x -= window_width + window_padding;
+
+    if (ImGui::Begin("AudioStats", nullptr, imgui_flags))
+    {
+      ImGui::TextColored(ImVec4(r, g, b, 1.0f), "aud:%5.0lfms", DT_ms(GetAudioLatency()).count());
+      ImGui::TextColored(ImVec4(r, g, b, 1.0f), "und:%7u", GetAudioUnderrunCount());
+      ImGui::End();
+    }
+  }
+
+  // Only shown while the backend reports when frames are shown.
+  const TimePoint last_present_latency = m_last_present_latency.load(std::memory_order_relaxed);
+  const bool present_latency_known = last_present_latency != TimePoint{} &&
+                                     Clock::now() - last_present_latency < std::chrono::seconds(2);
+  if (g_ActiveConfig.bShowFTimes && present_latency_known)
+  {
+    float window_height = (12.f + 17.f) * backbuffer_scale;
+
+    ImGui::SetNextWindowPos(ImVec2(window_x, window_y), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImVec2(window_width, window_height));
+    ImGui::SetNextWindowBgAlpha(bg_alpha);
+
+    if (stack_vertically)
+      window_y += window_height + window_padding;
+    else
+      window_x -= window_width + window_padding;
+
+    if (ImGui::Begin("LatencyStats", nullptr, imgui_flags))
+    {
+      ImGui::TextColored(ImVec4(r, g, b, 1.0f), "lat:%5.0lfms", DT_ms(GetPresentLatency()).count());
+      ImGui::End();
+    }
+  }
+
+  // Only shown on platforms which enforce W^X per thread, where switching it costs time.
+  const u64 jit_page_write_toggles = Common::GetJITPageWriteToggleCount();
+  if (g_ActiveConfig.bShowFTimes && jit_page_write_toggles != 0)
+  {
+    const TimePoint now = Clock::now();
+    const DT elapsed = now - m_jit_page_write_sample_time;
+    if (elapsed >= std::chrono::seconds(1))
+    {
+      if (m_jit_page_write_sample_time != TimePoint{})
+      {
+        m_jit_page_write_toggles_per_second =
+            (jit_page_write_toggles - m_jit_page_write_sample_count) /
+            DT_s(elapsed).count();
+      }
+      m_jit_page_write_sample_time = now;
+      m_jit_page_write_sample_count = jit_page_write_toggles;
+    }
+
+    float window_height = (12.f + 17.f) * backbuffer_scale;
+
+    ImGui::SetNextWindowPos(ImVec2(window_x, window_y), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImVec2(window_width, window_height));
+    ImGui::SetNextWindowBgAlpha(bg_alpha);
+
+    if (stack_vertically)
+      window_y += window_height + window_padding;
+    else
+      window_x -= window_width + window_padding;
+
+    if (ImGui::Begin("JITPageWriteStats", nullptr, imgui_flags))
+    {
+      ImGui::TextColored(ImVec4(r, g, b, 1.0f), "W^X:%6.0lf/s",
+                         m_jit_page_write_toggles_per_second);
+      ImGui::End();
+    }
+  }
+
+  // The sections are only timed while the breakdown is shown. Anything counted before it was last
+  // hidden is stale, so start over when it is shown again.
+  const bool show_frame_breakdown = g_ActiveConfig.bShowFrameBreakdown;
+  if (show_frame_breakdown != IsFrameBreakdownEnabled())
+  {
+    for (auto& time : m_frame_section_time)
+      time.store(0, std::memory_order_relaxed);
+    m_frame_breakdown_history = {};
+    m_frame_breakdown_enabled.store(show_frame_breakdown, std::memory_order_relaxed);
+  }
+  if (show_frame_breakdown)
+    DrawFrameBreakdown(backbuffer_scale);
+
   ImGui::PopStyleVar(2);
 }
+
+void PerformanceMetrics::DrawFrameBreakdown(const float backbuffer_scale)
+{
+  const auto imgui_flags = ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoInputs |
+                           ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoSavedSettings |
+                           ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoNav |
+                           ImGuiWindowFlags_NoFocusOnAppearing;
+
+  // Stack the sections of each frame on top of each other, starting with the oldest frame.
+  std::array<float, FRAME_BREAKDOWN_HISTORY_SIZE> frames;
+  std::array<std::array<float, FRAME_BREAKDOWN_HISTORY_SIZE>, FRAME_SECTION_COUNT + 1> stacked{};
+  float max_time = 1.0f;
+  for (size_t frame = 0; frame < FRAME_BREAKDOWN_HISTORY_SIZE; ++frame)
+  {
+    const auto& times = m_frame_breakdown_history[(m_frame_breakdown_history_pos + frame) %
+                                                  FRAME_BREAKDOWN_HISTORY_SIZE];
+    frames[frame] = static_cast<float>(frame);
+    for (size_t i = 0; i < FRAME_SECTION_COUNT; ++i)
+      stacked[i + 1][frame] = stacked[i][frame] + times[i];
+    max_time = std::max(max_time, stacked[FRAME_SECTION_COUNT][frame]);
+  }
+
+  const float window_padding = 8.f * backbuffer_scale;
+  const float graph_width = 400.f * backbuffer_scale;
+  const float graph_height =
+      std::min(200.f * backbuffer_scale, ImGui::GetIO().DisplaySize.y - 2.f * window_padding);
+
+  // Position in the bottom-left corner of the screen, out of the way of the other statistics.
+  ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0, 4.f * backbuffer_scale));
+  ImGui::SetNextWindowPos(ImVec2(window_padding, ImGui::GetIO().DisplaySize.y - window_padding),
+                          ImGuiCond_Always, ImVec2(0.0f, 1.0f));
+  ImGui::SetNextWindowSize(ImVec2(graph_width, graph_height));
+  ImGui::SetNextWindowBgAlpha(0.7f);
+
+  if (ImGui::Begin("FrameBreakdown", nullptr, imgui_flags))
+  {
+    if (ImPlot::BeginPlot("FrameBreakdown", ImVec2(-1.0, -1.0),
+                          ImPlotFlags_NoFrame | ImPlotFlags_NoTitle | ImPlotFlags_NoMenus))
+    {
+      ImPlot::PushStyleColor(ImPlotCol_PlotBg, {0, 0, 0, 0});
+      ImPlot::PushStyleColor(ImPlotCol_LegendBg, {0, 0, 0, 0.2f});
+      ImPlot::PushStyleVar(ImPlotStyleVar_FitPadding, ImVec2(0.f, 0.f));
+      ImPlot::SetupAxes(
+          nullptr, nullptr,
+          ImPlotAxisFlags_Lock | ImPlotAxisFlags_NoDecorations | ImPlotAxisFlags_NoHighlight,
+          ImPlotAxisFlags_Lock | ImPlotAxisFlags_NoLabel | ImPlotAxisFlags_NoHighlight);
+      ImPlot::SetupAxisFormat(ImAxis_Y1, "%.1f");
+      ImPlot::SetupAxesLimits(0, FRAME_BREAKDOWN_HISTORY_SIZE - 1, 0, max_time * 1.1,
+                              ImGuiCond_Always);
+      ImPlot::SetupLegend(ImPlotLocation_NorthWest, ImPlotLegendFlags_None);
+      for (size_t i = 0; i < FRAME_SECTION_COUNT; ++i)
+      {
+        ImPlot::PlotShaded(FRAME_SECTION_NAMES[i], frames.data(), stacked[i].data(),
+                           stacked[i + 1].data(), static_cast<int>(FRAME_BREAKDOWN_HISTORY_SIZE));
+      }
+      ImPlot::EndPlot();
+      ImPlot::PopStyleVar();
+      ImPlot::PopStyleColor(2);
+    }
+  }
+  ImGui::End();
+  ImGui::PopStyleVar();
+}
@@ -4,6 +4,9 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <fstream>
+#include <mutex>
 #include <shared_mutex>
 
 #include "Common/CommonTypes.h"
@@ -17,6 +20,50 @@ class System;
 class PerformanceMetrics
 {
 public:
+  // Parts of the emulation that are timed for the frame time breakdown. The first few sections
+  // run on the CPU thread and the rest on the GPU thread (or the CPU thread in single core).
+  enum class FrameSection
+  {
+    JitCompile,
+    HLE,
+    IdleSkip,
+    Throttle,
+    FifoParse,
+    VertexLoad,
+    TextureCache,
+    ShaderCompile,
+    BackendSubmit,
+    Count,
+  };
+
+  static constexpr size_t FRAME_SECTION_COUNT = static_cast<size_t>(FrameSection::Count);
+
+  // Counts the time until it goes out of scope towards a section of the frame time breakdown.
+  // Time spent in a nested section is only counted towards the innermost one.
+  class ScopedFrameSection
+  {
+  public:
+    explicit ScopedFrameSection(FrameSection section);
+    ~ScopedFrameSection();
+
+    ScopedFrameSection(const ScopedFrameSection&) = delete;
+    ScopedFrameSection& operator=(const ScopedFrameSection&) = delete;
+    ScopedFrameSection(ScopedFrameSection&&) = delete;
+    ScopedFrameSection& operator=(ScopedFrameSection&&) = delete;
+
+  private:
+    void Begin();
+    void End();
+
+    static inline thread_local ScopedFrameSection* s_current = nullptr;
+
+    FrameSection m_section;
+    bool m_active = false;
+    TimePoint m_start;
+    DT m_nested_time{};
+    ScopedFrameSection* m_parent = nullptr;
+  };
+
   PerformanceMetrics() = default;
   ~PerformanceMetrics() = default;
 
@@ -33,6 +80,31 @@ public:
   void CountThrottleSleep(DT sleep);
   void CountPerformanceMarker(Core::System& system, s64 cyclesLate);
 
+  // Called from the shader compiler threads with the time from queueing a compile to finishing it.
+  void CountShaderCompile(DT queue_latency);
+  // Called when compiles are queued for the shader compiler threads or are cancelled before they
+  // started.
+  void CountShaderCompileQueued();
+  void CountShaderCompilesCancelled(u32 count);
+
+  // Called from the audio thread with how much audio is buffered ahead of the output, and whenever
+  // the output has to be padded because the emulated audio didn't arrive in time.
+  void CountAudioLatency(DT latency);
+  void CountAudioUnderrun();
+
+  // Called from the CPU thread whenever the emulated controllers are read.
+  void CountInputPoll();
+  // Called from the video thread once a frame has been shown, with the time since the last input
+  // poll before the frame was presented.
+  void CountPresentLatency(DT latency);
+
+  // Can be called from any thread, usually through ScopedFrameSection.
+  void CountFrameSection(FrameSection section, DT time);
+  bool IsFrameBreakdownEnabled() const
+  {
+    return m_frame_breakdown_enabled.load(std::memory_order_relaxed);
+  }
+
   // Getter Functions
   double GetFPS() const;
   double GetVPS() const;
@@ -41,10 +113,26 @@ public:
 
   double GetLastSpeedDenominator() const;
 
+  // Average queue latency of recent shader compiles.
+  DT GetShaderCompileLatency() const;
+  // Number of queued shader compiles that haven't finished yet.
+  u32 GetShaderCompileQueueDepth() const;
+
+  // Average amount of buffered audio over the last few audio callbacks.
+  DT GetAudioLatency() const;
+  u32 GetAudioUnderrunCount() const;
+
+  TimePoint GetLastInputPollTime() const;
+  // Average estimated input to photon latency of recent frames.
+  DT GetPresentLatency() const;
+
   // ImGui Functions
   void DrawImGuiStats(const float backbuffer_scale);
 
 private:
+  void UpdateFrameBreakdown();
+  void DrawFrameBreakdown(const float backbuffer_scale);
+
   PerformanceTracker m_fps_counter{"render_times.txt"};
   PerformanceTracker m_vps_counter{"vblank_times.txt"};
   PerformanceTracker m_speed_counter{std::nullopt, 1280000};
@@ -55,6 +143,52 @@ private:
   mutable std::shared_mutex m_time_lock;
   TimePoint m_prev_adjusted_time{};
   DT m_time_sleeping{};
+
+  mutable std::mutex m_shader_compile_lock;
+  DT m_shader_compile_latency{};
+  TimePoint m_last_shader_compile{};
+  std::atomic<u32> m_shader_compile_queue_depth{0};
+
+  // Only written by the audio thread, so atomics are enough to avoid blocking it.
+  std::atomic<DT> m_audio_latency{};
+  std::atomic<TimePoint> m_last_audio_latency{};
+  std::atomic<u32> m_audio_underruns{0};
+
+  std::atomic<TimePoint> m_last_input_poll{};
+  // Only written by the video thread.
+  std::atomic<DT> m_present_latency{};
+  std::atomic<TimePoint> m_last_present_latency{};
+
+  // Rate of Common::GetJITPageWriteToggleCount(), sampled by the video thread every second.
+  TimePoint m_jit_page_write_sample_time{};
+  u64 m_jit_page_write_sample_count = 0;
+  double m_jit_page_write_toggles_per_second = 0.0;
+
+  // Set from the video thread while the breakdown is shown, so that the sections aren't timed
+  // otherwise.
+  std::atomic<bool> m_frame_breakdown_enabled{false};
+  // Time counted towards each section since the last frame, in nanoseconds.
+  std::array<std::atomic<s64>, FRAME_SECTION_COUNT> m_frame_section_time{};
+
+  // Per-frame times of the last frames in milliseconds, only accessed by the video thread.
+  static constexpr size_t FRAME_BREAKDOWN_HISTORY_SIZE = 256;
+  std::array<std::array<float, FRAME_SECTION_COUNT>, FRAME_BREAKDOWN_HISTORY_SIZE>
+      m_frame_breakdown_history{};
+  size_t m_frame_breakdown_history_pos = 0;
+  std::ofstream m_frame_breakdown_file;
 };
 
 extern PerformanceMetrics g_perf_metrics;
+
+inline PerformanceMetrics::ScopedFrameSection::ScopedFrameSection(FrameSection section)
+    : m_section(section)
+{
+  if (g_perf_metrics.IsFrameBreakdownEnabled())
+    Begin();
+}
+
+inline PerformanceMetrics::ScopedFrameSection::~ScopedFrameSection()
+{
+  if (m_active)
+    End();
+}
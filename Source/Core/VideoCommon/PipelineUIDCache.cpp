@@ -0,0 +1,75 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/PipelineUIDCache.h"
+
+#include <cstring>
+#include <set>
+
+#include <fmt/format.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+
+namespace VideoCommon::PipelineUIDCache
+{
+namespace
+{
+// UIDs are written to disk as raw bytes, so comparing the bytes is what identifies duplicates.
+struct UIDLess
+{
+  bool operator()(const SerializedGXPipelineUid& a, const SerializedGXPipelineUid& b) const
+  {
+    return std::memcmp(&a, &b, sizeof(SerializedGXPipelineUid)) < 0;
+  }
+};
+}  // namespace
+
+std::string GetFilename(std::string_view game_id)
+{
+  return fmt::format("{}{}.uidcache", File::GetUserPath(D_CACHE_IDX), game_id);
+}
+
+std::optional<std::vector<SerializedGXPipelineUid>> ReadFile(const std::string& path)
+{
+  File::IOFile file(path, "rb");
+  u32 magic;
+  u32 version;
+  if (!file.ReadBytes(&magic, sizeof(magic)) || !file.ReadBytes(&version, sizeof(version)) ||
+      magic != FILE_MAGIC || version != GX_PIPELINE_UID_VERSION)
+  {
+    return std::nullopt;
+  }
+
+  const u64 data_size = file.GetSize() - HEADER_SIZE;
+  if (data_size % sizeof(SerializedGXPipelineUid) != 0)
+    return std::nullopt;
+
+  std::vector<SerializedGXPipelineUid> uids(data_size / sizeof(SerializedGXPipelineUid));
+  if (!file.ReadArray(uids.data(), uids.size()))
+    return std::nullopt;
+  return uids;
+}
+
+bool WriteFile(const std::string& path, std::span<const SerializedGXPipelineUid> uids)
+{
+  File::IOFile file(path, "wb");
+  return file.WriteBytes(&FILE_MAGIC, sizeof(FILE_MAGIC)) &&
+         file.WriteBytes(&GX_PIPELINE_UID_VERSION, sizeof(GX_PIPELINE_UID_VERSION)) &&
+         file.WriteArray(uids.data(), uids.size());
+}
+
+size_t Merge(std::vector<SerializedGXPipelineUid>& dest,
+             std::span<const SerializedGXPipelineUid> source)
+{
+  std::set<SerializedGXPipelineUid, UIDLess> seen(dest.begin(), dest.end());
+  const size_t old_size = dest.size();
+  for (const SerializedGXPipelineUid& uid : source)
+  {
+    if (seen.insert(uid).second)
+      dest.push_back(uid);
+  }
+  return dest.size() - old_size;
+}
+}  // namespace VideoCommon::PipelineUIDCache
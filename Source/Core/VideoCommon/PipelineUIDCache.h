@@ -0,0 +1,37 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Reading, writing and merging of the per-game files listing the pipelines a game has used, so
+// that they can be compiled ahead of time.
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/GXPipelineTypes.h"
+
+namespace VideoCommon::PipelineUIDCache
+{
+// A file starts with the magic and GX_PIPELINE_UID_VERSION, followed by the UIDs.
+constexpr u32 FILE_MAGIC = 0x44495550;  // PUID
+constexpr size_t HEADER_SIZE = sizeof(u32) + sizeof(u32);
+
+// Path of the UID cache Dolphin uses for the given game.
+std::string GetFilename(std::string_view game_id);
+
+// Returns std::nullopt if the file can't be read, is truncated, or was written with a different
+// UID version.
+std::optional<std::vector<SerializedGXPipelineUid>> ReadFile(const std::string& path);
+bool WriteFile(const std::string& path, std::span<const SerializedGXPipelineUid> uids);
+
+// Appends every UID in source which isn't in dest yet, keeping the order of both.
+// Returns the number of UIDs added.
+size_t Merge(std::vector<SerializedGXPipelineUid>& dest,
+             std::span<const SerializedGXPipelineUid> source);
+}  // namespace VideoCommon::PipelineUIDCache
@@ -6,6 +6,8 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdio>
+#include <string>
+#include <unordered_map>
 #include <fmt/format.h>
 
 #include "Common/Assert.h"
@@ -344,9 +346,9 @@ void ClearUnusedPixelShaderUidBits(APIType api_type, const ShaderHostConfig& hos
   uid_data->bounding_box &= host_config.bounding_box && host_config.backend_bbox;
 }
 
-void WritePixelShaderCommonHeader(ShaderCode& out, APIType api_type,
-                                  const ShaderHostConfig& host_config, bool bounding_box,
-                                  const CustomPixelShaderContents& custom_details)
+static void GeneratePixelShaderCommonHeader(ShaderCode& out, APIType api_type,
+                                            const ShaderHostConfig& host_config, bool bounding_box,
+                                            const CustomPixelShaderContents& custom_details)
 {
   // dot product for integer vectors
   out.Write("int idot(int3 x, int3 y)\n"
@@ -761,6 +763,35 @@ uint WrapCoord(int coord, uint wrap, int size) {{
   }
 }
 
+void WritePixelShaderCommonHeader(ShaderCode& out, APIType api_type,
+                                  const ShaderHostConfig& host_config, bool bounding_box,
+                                  const CustomPixelShaderContents& custom_details)
+{
+  // Custom shaders add their uniforms to the header.
+  if (!custom_details.shaders.empty() &&
+      !custom_details.shaders.back().material_uniform_block.empty())
+  {
+    GeneratePixelShaderCommonHeader(out, api_type, host_config, bounding_box, custom_details);
+    return;
+  }
+
+  // Otherwise the header only depends on a few settings, so each shader generating thread only
+  // generates it once for each of their combinations.
+  thread_local std::unordered_map<u64, std::string> headers;
+  const u64 key = host_config.bits | static_cast<u64>(api_type) << 32 |
+                  static_cast<u64>(bounding_box) << 40 |
+                  static_cast<u64>(g_ActiveConfig.backend_info.bSupportsTextureQueryLevels) << 41 |
+                  static_cast<u64>(g_ActiveConfig.backend_info.bSupportsCoarseDerivatives) << 42;
+  auto [it, inserted] = headers.try_emplace(key);
+  if (inserted)
+  {
+    ShaderCode header;
+    GeneratePixelShaderCommonHeader(header, api_type, host_config, bounding_box, custom_details);
+    it->second = header.GetBuffer();
+  }
+  out.Write("{}", it->second);
+}
+
 void WriteCustomShaderStructImpl(ShaderCode* out, u32 num_stages, bool per_pixel_lighting,
                                  const pixel_shader_uid_data* uid_data)
 {
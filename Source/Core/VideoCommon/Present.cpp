@@ -16,6 +16,7 @@
 #include "VideoCommon/FrameDumper.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/OnScreenUI.h"
+#include "VideoCommon/PerformanceMetrics.h"
 #include "VideoCommon/PostProcessing.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexManagerBase.h"
@@ -157,9 +158,20 @@ bool Presenter::FetchXFB(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_heigh
   return old_xfb_id == m_last_xfb_id;
 }
 
+bool Presenter::UpdateFrameSkip()
+{
+  const bool skipped = m_skip_rendering;
+  m_skipped_frames = skipped ? m_skipped_frames + 1 : 0;
+  m_skip_rendering = m_skipped_frames < g_ActiveConfig.iFrameSkip;
+  m_last_xfb_skipped = skipped;
+  return skipped;
+}
+
 void Presenter::ViSwap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height, u64 ticks)
 {
   bool is_duplicate = FetchXFB(xfb_addr, fb_width, fb_stride, fb_height, ticks);
+  // Duplicates of a skipped frame don't contain its draws either
+  const bool is_skipped = is_duplicate ? m_last_xfb_skipped : UpdateFrameSkip();
 
   PresentInfo present_info;
   present_info.emulated_timestamp = ticks;
@@ -196,7 +208,7 @@ void Presenter::ViSwap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_height,
 
   BeforePresentEvent::Trigger(present_info);
 
-  if (!is_duplicate || !g_ActiveConfig.bSkipPresentingDuplicateXFBs)
+  if (!is_skipped && (!is_duplicate || !g_ActiveConfig.bSkipPresentingDuplicateXFBs))
   {
     Present();
     ProcessFrameDumping(ticks);
@@ -217,6 +229,9 @@ void Presenter::ImmediateSwap(u32 xfb_addr, u32 fb_width, u32 fb_stride, u32 fb_
 
   BeforePresentEvent::Trigger(present_info);
 
+  if (UpdateFrameSkip())
+    return;
+
   Present();
   ProcessFrameDumping(ticks);
 
@@ -815,6 +830,17 @@ void Presenter::Present()
 
   UpdateDrawRectangle();
 
+  // In low latency mode, don't start drawing until the previous frame was shown, so that frames
+  // are never queued behind each other. Once it was shown we also know how old the input it was
+  // based on is by the time it reached the display.
+  const TimePoint input_time = g_perf_metrics.GetLastInputPollTime();
+  if (g_ActiveConfig.bLowLatencyPresent && g_gfx->WaitForPresentCompletion() &&
+      m_last_present_input_time != TimePoint{})
+  {
+    g_perf_metrics.CountPresentLatency(Clock::now() - m_last_present_input_time);
+  }
+  m_last_present_input_time = input_time;
+
   g_gfx->BeginUtilityDrawing();
   g_gfx->BindBackbuffer({{0.0f, 0.0f, 0.0f, 1.0f}});
 
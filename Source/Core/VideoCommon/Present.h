@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "Common/CommonTypes.h"
 #include "Common/Flag.h"
 #include "Common/MathUtil.h"
 
@@ -94,6 +95,10 @@ public:
 
   int FrameCount() const { return m_frame_count; }
 
+  // True while the current frame is skipped because of frame skipping. Draws of skipped frames
+  // only need to be rendered when they affect emulated state.
+  bool IsSkippingRendering() const { return m_skip_rendering; }
+
   void DoState(PointerWrap& p);
 
   const MathUtil::Rectangle<int>& GetTargetRectangle() const { return m_target_rectangle; }
@@ -105,6 +110,10 @@ private:
 
   void ProcessFrameDumping(u64 ticks) const;
 
+  // Called when a new frame has been output. Returns whether that frame was skipped, and decides
+  // whether the next one is.
+  bool UpdateFrameSkip();
+
   void OnBackBufferSizeChanged();
 
   // Scales a raw XFB resolution to the target (display) aspect ratio,
@@ -147,6 +156,11 @@ private:
   // Tracking of XFB textures so we don't render duplicate frames.
   u64 m_last_xfb_id = std::numeric_limits<u64>::max();
 
+  // Frame skipping
+  bool m_skip_rendering = false;
+  bool m_last_xfb_skipped = false;
+  u32 m_skipped_frames = 0;
+
   // These will be set on the first call to SetSuggestedWindowSize.
   int m_last_window_request_width = 0;
   int m_last_window_request_height = 0;
@@ -157,6 +171,9 @@ private:
   u64 m_frame_count = 0;
   u64 m_present_count = 0;
 
+  // Time of the last input poll before the previous frame was presented
+  TimePoint m_last_present_input_time{};
+
   // XFB tracking
   u64 m_last_xfb_ticks = 0;
   u32 m_last_xfb_addr = 0;
@@ -8,6 +8,7 @@
 #include "Common/Assert.h"
 #include "Common/FileUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/Tracing.h"
 #include "Core/ConfigManager.h"
 
 #include "VideoCommon/AbstractGfx.h"
@@ -15,6 +16,8 @@
 #include "VideoCommon/DriverDetails.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/FramebufferShaderGen.h"
+#include "VideoCommon/PerformanceMetrics.h"
+#include "VideoCommon/PipelineUIDCache.h"
 #include "VideoCommon/Present.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
@@ -77,7 +80,7 @@ void ShaderCache::InitializeShaderCache()
 
 void ShaderCache::Reload()
 {
-  WaitForAsyncCompiler();
+  CancelAsyncShaders();
   ClosePipelineUIDCache();
   ClearCaches();
 
@@ -104,6 +107,16 @@ void ShaderCache::RetrieveAsyncShaders()
   m_async_shader_compiler->RetrieveWorkItems();
 }
 
+void ShaderCache::CancelAsyncShaders()
+{
+  // Everything which is still queued would be created for the old configuration. Only wait for
+  // the work items which are already compiling, and don't let pipelines re-queue themselves.
+  m_async_shader_compiler->CancelPendingWork();
+  m_cancelling_async_shaders = true;
+  WaitForAsyncCompiler();
+  m_cancelling_async_shaders = false;
+}
+
 void ShaderCache::Shutdown()
 {
   // This may leave shaders uncommitted to the cache, but it's better than blocking shutdown
@@ -120,6 +133,8 @@ const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid)
   if (it != m_gx_pipeline_cache.end() && !it->second.second)
     return it->second.first.get();
 
+  PerformanceMetrics::ScopedFrameSection frame_section(
+      PerformanceMetrics::FrameSection::ShaderCompile);
   const bool exists_in_cache = it != m_gx_pipeline_cache.end();
   std::unique_ptr<AbstractPipeline> pipeline;
   std::optional<AbstractPipelineConfig> pipeline_config = GetGXPipelineConfig(uid);
@@ -138,8 +153,10 @@ std::optional<const AbstractPipeline*> ShaderCache::GetPipelineForUidAsync(const
     // .second is the pending flag, i.e. compiling in the background.
     if (!it->second.second)
       return it->second.first.get();
-    else
-      return {};
+
+    // The caller has to fall back to the ubershader until this is done, so hurry it up.
+    BoostPipelineCompile(uid);
+    return {};
   }
 
   AppendGXPipelineUID(uid);
@@ -153,6 +170,8 @@ const AbstractPipeline* ShaderCache::GetUberPipelineForUid(const GXUberPipelineU
   if (it != m_gx_uber_pipeline_cache.end() && !it->second.second)
     return it->second.first.get();
 
+  PerformanceMetrics::ScopedFrameSection frame_section(
+      PerformanceMetrics::FrameSection::ShaderCompile);
   std::unique_ptr<AbstractPipeline> pipeline;
   std::optional<AbstractPipelineConfig> pipeline_config = GetGXPipelineConfig(uid);
   if (pipeline_config)
@@ -160,6 +179,22 @@ const AbstractPipeline* ShaderCache::GetUberPipelineForUid(const GXUberPipelineU
   return InsertGXUberPipeline(uid, std::move(pipeline));
 }
 
+std::optional<const AbstractPipeline*>
+ShaderCache::GetUberPipelineForUidAsync(const GXUberPipelineUid& uid)
+{
+  auto it = m_gx_uber_pipeline_cache.find(uid);
+  if (it != m_gx_uber_pipeline_cache.end())
+  {
+    if (!it->second.second)
+      return it->second.first.get();
+    return {};
+  }
+
+  if (m_async_shader_compiler->HasWorkerThreads())
+    QueueUberPipelineCompile(uid, COMPILE_PRIORITY_UBERSHADER_VARIANT_PIPELINE);
+  return {};
+}
+
 void ShaderCache::WaitForAsyncCompiler()
 {
   bool running = true;
@@ -351,6 +386,8 @@ void ShaderCache::ClearPipelineCache(T& cache, Y& disk_cache)
 
 void ShaderCache::LoadCaches()
 {
+  Common::Tracing::ScopedEvent trace_event("video", "Load shader caches");
+
   // Ubershader caches, if present.
   if (g_ActiveConfig.backend_info.bSupportsShaderBinaries)
   {
@@ -384,6 +421,7 @@ void ShaderCache::LoadCaches()
 void ShaderCache::ClearCaches()
 {
   ClearPipelineCache(m_gx_pipeline_cache, m_gx_pipeline_disk_cache);
+  m_pending_pipeline_compiles.clear();
   ClearShaderCache(m_vs_cache);
   ClearShaderCache(m_gs_cache);
   ClearShaderCache(m_ps_cache);
@@ -872,6 +910,8 @@ ShaderCache::GetGXPipelineConfig(const GXUberPipelineUid& config_in)
 const AbstractPipeline* ShaderCache::InsertGXPipeline(const GXPipelineUid& config,
                                                       std::unique_ptr<AbstractPipeline> pipeline)
 {
+  m_pending_pipeline_compiles.erase(config);
+
   auto& entry = m_gx_pipeline_cache[config];
   entry.second = false;
   if (!entry.first && pipeline)
@@ -922,10 +962,9 @@ ShaderCache::InsertGXUberPipeline(const GXUberPipelineUid& config,
 
 void ShaderCache::LoadPipelineUIDCache()
 {
-  constexpr u32 CACHE_FILE_MAGIC = 0x44495550;  // PUID
-  constexpr size_t CACHE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
-  std::string filename =
-      File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID() + ".uidcache";
+  constexpr u32 CACHE_FILE_MAGIC = PipelineUIDCache::FILE_MAGIC;
+  constexpr size_t CACHE_HEADER_SIZE = PipelineUIDCache::HEADER_SIZE;
+  std::string filename = PipelineUIDCache::GetFilename(SConfig::GetInstance().GetGameID());
   if (m_gx_pipeline_uid_cache_file.Open(filename, "rb+"))
   {
     // If an existing case exists, validate the version before reading entries.
@@ -1051,9 +1090,10 @@ void ShaderCache::QueueVertexShaderCompile(const VertexShaderUid& uid, u32 prior
     VertexShaderUid uid;
   };
 
-  m_vs_cache.shader_map[uid].pending = true;
+  auto& entry = m_vs_cache.shader_map[uid];
+  entry.pending = true;
   auto wi = m_async_shader_compiler->CreateWorkItem<VertexShaderWorkItem>(this, uid);
-  m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
+  entry.compile_handle = m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
 }
 
 void ShaderCache::QueueVertexUberShaderCompile(const UberShader::VertexShaderUid& uid, u32 priority)
@@ -1109,9 +1149,10 @@ void ShaderCache::QueuePixelShaderCompile(const PixelShaderUid& uid, u32 priorit
     PixelShaderUid uid;
   };
 
-  m_ps_cache.shader_map[uid].pending = true;
+  auto& entry = m_ps_cache.shader_map[uid];
+  entry.pending = true;
   auto wi = m_async_shader_compiler->CreateWorkItem<PixelShaderWorkItem>(this, uid);
-  m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
+  entry.compile_handle = m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
 }
 
 void ShaderCache::QueuePixelUberShaderCompile(const UberShader::PixelShaderUid& uid, u32 priority)
@@ -1195,9 +1236,8 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
       else
       {
         // Re-queue for next frame.
-        auto wi = shader_cache->m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(
-            shader_cache, uid, priority);
-        shader_cache->m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
+        if (!shader_cache->m_cancelling_async_shaders)
+          shader_cache->QueuePipelineCompile(uid, priority);
       }
     }
 
@@ -1211,8 +1251,38 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
   };
 
   auto wi = m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(this, uid, priority);
-  m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
+  PendingPipelineCompile& pending = m_pending_pipeline_compiles[uid];
+  pending.handle = m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
   m_gx_pipeline_cache[uid].second = true;
+
+  // Re-queued pipelines keep their boost, including for shaders queued since it was boosted.
+  if (pending.boosted)
+  {
+    pending.boosted = false;
+    BoostPipelineCompile(uid);
+  }
+}
+
+void ShaderCache::BoostPipelineCompile(const GXPipelineUid& uid)
+{
+  const auto it = m_pending_pipeline_compiles.find(uid);
+  if (it == m_pending_pipeline_compiles.end() || it->second.boosted)
+    return;
+
+  it->second.boosted = true;
+  m_async_shader_compiler->BoostWorkItem(it->second.handle);
+
+  // The pipeline can't be created before its shaders, so those have to be boosted as well.
+  const GXPipelineUid actual_uid = ApplyDriverBugs(uid);
+  const auto vs_it = m_vs_cache.shader_map.find(actual_uid.vs_uid);
+  if (vs_it != m_vs_cache.shader_map.end() && vs_it->second.pending)
+    m_async_shader_compiler->BoostWorkItem(vs_it->second.compile_handle);
+
+  PixelShaderUid ps_uid = actual_uid.ps_uid;
+  ClearUnusedPixelShaderUidBits(m_api_type, m_host_config, &ps_uid);
+  const auto ps_it = m_ps_cache.shader_map.find(ps_uid);
+  if (ps_it != m_ps_cache.shader_map.end() && ps_it->second.pending)
+    m_async_shader_compiler->BoostWorkItem(ps_it->second.compile_handle);
 }
 
 void ShaderCache::QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 priority)
@@ -1270,9 +1340,8 @@ void ShaderCache::QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 pri
       else
       {
         // Re-queue for next frame.
-        auto wi = shader_cache->m_async_shader_compiler->CreateWorkItem<UberPipelineWorkItem>(
-            shader_cache, uid, priority);
-        shader_cache->m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
+        if (!shader_cache->m_cancelling_async_shaders)
+          shader_cache->QueueUberPipelineCompile(uid, priority);
       }
     }
 
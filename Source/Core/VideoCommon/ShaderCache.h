@@ -62,6 +62,9 @@ public:
   // Retrieves all pending shaders/pipelines from the async compiler.
   void RetrieveAsyncShaders();
 
+  // Drops all queued shaders/pipelines and retrieves the ones which are already compiling.
+  void CancelAsyncShaders();
+
   // Accesses ShaderGen shader caches
   const AbstractPipeline* GetPipelineForUid(const GXPipelineUid& uid);
   const AbstractPipeline* GetUberPipelineForUid(const GXUberPipelineUid& uid);
@@ -69,6 +72,10 @@ public:
   // Accesses ShaderGen shader caches asynchronously.
   // The optional will be empty if this pipeline is now background compiling.
   std::optional<const AbstractPipeline*> GetPipelineForUidAsync(const GXPipelineUid& uid);
+  // Used for the partially specialized ubershader variants, which are only worth having if they
+  // can be compiled in the background. Always empty if there are no compiler threads.
+  std::optional<const AbstractPipeline*>
+  GetUberPipelineForUidAsync(const GXUberPipelineUid& uid);
 
   // Shared shaders
   const AbstractShader* GetScreenQuadVertexShader() const
@@ -169,6 +176,7 @@ private:
   void QueuePixelUberShaderCompile(const UberShader::PixelShaderUid& uid, u32 priority);
   void QueuePipelineCompile(const GXPipelineUid& uid, u32 priority);
   void QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 priority);
+  void BoostPipelineCompile(const GXPipelineUid& uid);
 
   // Populating various caches.
   template <ShaderStage stage, typename K, typename T>
@@ -184,10 +192,12 @@ private:
   // Priorities for compiling. The lower the value, the sooner the pipeline is compiled.
   // The shader cache is compiled last, as it is the least likely to be required. On demand
   // shaders are always compiled before pending ubershaders, as we want to use the ubershader
-  // for as few frames as possible, otherwise we risk framerate drops.
+  // for as few frames as possible, otherwise we risk framerate drops. Ubershader variants are a
+  // stopgap until the specialized pipeline is ready, so they come after on demand pipelines.
   enum : u32
   {
     COMPILE_PRIORITY_ONDEMAND_PIPELINE = 100,
+    COMPILE_PRIORITY_UBERSHADER_VARIANT_PIPELINE = 150,
     COMPILE_PRIORITY_UBERSHADER_PIPELINE = 200,
     COMPILE_PRIORITY_SHADERCACHE_PIPELINE = 300
   };
@@ -214,6 +224,7 @@ private:
     {
       std::unique_ptr<AbstractShader> shader;
       bool pending = false;
+      AsyncShaderCompiler::WorkItemHandle compile_handle;
     };
     std::map<Uid, Shader> shader_map;
     Common::LinearDiskCache<Uid, u8> disk_cache;
@@ -228,6 +239,14 @@ private:
   std::map<GXPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>> m_gx_pipeline_cache;
   std::map<GXUberPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>>
       m_gx_uber_pipeline_cache;
+  // Pipelines queued on the async compiler, so that they can be boosted once they are drawn.
+  struct PendingPipelineCompile
+  {
+    AsyncShaderCompiler::WorkItemHandle handle;
+    bool boosted = false;
+  };
+  std::map<GXPipelineUid, PendingPipelineCompile> m_pending_pipeline_compiles;
+  bool m_cancelling_async_shaders = false;
   File::IOFile m_gx_pipeline_uid_cache_file;
   Common::LinearDiskCache<SerializedGXPipelineUid, u8> m_gx_pipeline_disk_cache;
   Common::LinearDiskCache<SerializedGXUberPipelineUid, u8> m_gx_uber_pipeline_disk_cache;
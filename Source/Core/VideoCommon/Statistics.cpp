@@ -90,6 +90,11 @@ void Statistics::Display() const
   draw_statistic("Textures created", "%d", num_textures_created);
   draw_statistic("Textures uploaded", "%d", num_textures_uploaded);
   draw_statistic("Textures alive", "%d", num_textures_alive);
+  draw_statistic("Textures evicted", "%d", num_textures_evicted);
+  draw_statistic("Texture VRAM", "%i kB", texture_cache_textures_kb);
+  draw_statistic("EFB/XFB copy VRAM", "%i kB", texture_cache_copies_kb);
+  draw_statistic("Texture pool VRAM", "%i kB", texture_cache_pool_kb);
+  draw_statistic("Texture loads", "%d", this_frame.num_texture_loads);
   draw_statistic("pshaders created", "%d", num_pixel_shaders_created);
   draw_statistic("pshaders alive", "%d", num_pixel_shaders_alive);
   draw_statistic("vshaders created", "%d", num_vertex_shaders_created);
@@ -109,9 +114,14 @@ void Statistics::Display() const
   draw_statistic("Vertex streamed", "%i kB", this_frame.bytes_vertex_streamed / 1024);
   draw_statistic("Index streamed", "%i kB", this_frame.bytes_index_streamed / 1024);
   draw_statistic("Uniform streamed", "%i kB", this_frame.bytes_uniform_streamed / 1024);
+  draw_statistic("Descriptor writes", "%d", this_frame.num_descriptor_writes);
+  draw_statistic("Descriptor pushes", "%d", this_frame.num_descriptor_pushes);
   draw_statistic("Vertex Loaders", "%d", num_vertex_loaders);
+  draw_statistic("Vertex cache hits", "%d/%d", this_frame.num_vertex_cache_hits,
+                 this_frame.num_vertex_cache_hits + this_frame.num_vertex_cache_misses);
   draw_statistic("EFB peeks:", "%d", this_frame.num_efb_peeks);
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
+  draw_statistic("EFB copies skipped:", "%d", this_frame.num_efb_copies_skipped);
   draw_statistic("Draw dones:", "%d", this_frame.num_draw_done);
   draw_statistic("Tokens:", "%d/%d", this_frame.num_token, this_frame.num_token_int);
 
@@ -18,6 +18,12 @@ struct Statistics
   int num_textures_created = 0;
   int num_textures_uploaded = 0;
   int num_textures_alive = 0;
+  int num_textures_evicted = 0;
+
+  // Video memory held by the texture cache, updated once per frame
+  int texture_cache_textures_kb = 0;
+  int texture_cache_copies_kb = 0;
+  int texture_cache_pool_kb = 0;
 
   int num_vertex_loaders = 0;
 
@@ -58,10 +64,17 @@ struct Statistics
 
     int num_dlists_called = 0;
 
+    int num_texture_loads = 0;
+
     int bytes_vertex_streamed = 0;
     int bytes_index_streamed = 0;
     int bytes_uniform_streamed = 0;
 
+    // Backends with descriptor sets: number of descriptors written to freshly allocated sets, and
+    // number of sets pushed straight into the command buffer instead.
+    int num_descriptor_writes = 0;
+    int num_descriptor_pushes = 0;
+
     int num_triangles_clipped = 0;
     int num_triangles_in = 0;
     int num_triangles_rejected = 0;
@@ -70,11 +83,14 @@ struct Statistics
     int rasterized_pixels = 0;
     int num_triangles_drawn = 0;
     int num_vertices_loaded = 0;
+    int num_vertex_cache_hits = 0;
+    int num_vertex_cache_misses = 0;
     int tev_pixels_in = 0;
     int tev_pixels_out = 0;
 
     int num_efb_peeks = 0;
     int num_efb_pokes = 0;
+    int num_efb_copies_skipped = 0;
 
     int num_draw_done = 0;
     int num_token = 0;
@@ -36,6 +36,7 @@
 #include "VideoCommon/AbstractFramebuffer.h"
 #include "VideoCommon/AbstractGfx.h"
 #include "VideoCommon/AbstractStagingTexture.h"
+#include "VideoCommon/Assets/CustomAssetLoader.h"
 #include "VideoCommon/Assets/CustomTextureData.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/FramebufferManager.h"
@@ -44,6 +45,7 @@
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModManager.h"
 #include "VideoCommon/HiresTextures.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/PerformanceMetrics.h"
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/Present.h"
 #include "VideoCommon/ShaderCache.h"
@@ -79,6 +81,33 @@ TCacheEntry::~TCacheEntry()
   g_texture_cache->ReleaseToPool(this);
 }
 
+u64 TextureCacheBase::GetTrackedHash(u32 address, const u8* ptr, u32 size, u32 sample_size)
+{
+  auto& memory = Core::System::GetInstance().GetMemory();
+  if (!g_ActiveConfig.bTextureWriteTracking || !memory.IsWriteTrackingSupported())
+    return Common::GetHash64(ptr, size, sample_size);
+
+  const u64 key = (u64(address) << 32) | size;
+  const auto it = m_tracked_hashes.find(key);
+  if (it != m_tracked_hashes.end() && it->second.sample_size == sample_size &&
+      !memory.HasBeenWrittenSince(address, size, it->second.serial))
+  {
+    return it->second.hash;
+  }
+
+  // Keep the map from growing without bound in games which stream textures to ever-changing
+  // addresses. Clearing it only costs a rehash of each texture in use.
+  static constexpr size_t MAX_TRACKED_HASHES = 16384;
+  if (it == m_tracked_hashes.end() && m_tracked_hashes.size() >= MAX_TRACKED_HASHES)
+    m_tracked_hashes.clear();
+
+  // Start tracking before hashing, so that a write racing with the hash is never missed.
+  const u64 serial = memory.TrackWrites(address, size);
+  const u64 hash = Common::GetHash64(ptr, size, sample_size);
+  m_tracked_hashes.insert_or_assign(key, TrackedHash{serial, hash, sample_size});
+  return hash;
+}
+
 void TextureCacheBase::CheckTempSize(size_t required_size)
 {
   if (required_size <= m_temp_size)
@@ -141,6 +170,8 @@ void TextureCacheBase::Invalidate()
     bind.reset();
   m_textures_by_hash.clear();
   m_textures_by_address.clear();
+  m_tracked_hashes.clear();
+  m_recent_efb_copies.clear();
 
   m_texture_pool.clear();
 }
@@ -176,6 +207,8 @@ void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
 
 void TextureCacheBase::Cleanup(int _frameCount)
 {
+  auto& asset_loader = Core::System::GetInstance().GetCustomAssetLoader();
+
   TexAddrCache::iterator iter = m_textures_by_address.begin();
   TexAddrCache::iterator tcend = m_textures_by_address.end();
   while (iter != tcend)
@@ -183,6 +216,11 @@ void TextureCacheBase::Cleanup(int _frameCount)
     if (iter->second->frameCount == FRAMECOUNT_INVALID)
     {
       iter->second->frameCount = _frameCount;
+
+      // Keep the custom textures in use loaded over the ones that are idle
+      for (const auto& cached_asset : iter->second->linked_game_texture_assets)
+        asset_loader.MarkUsed(*cached_asset.m_asset);
+
       ++iter;
     }
     else if (_frameCount > TEXTURE_KILL_THRESHOLD + iter->second->frameCount)
@@ -214,6 +252,9 @@ void TextureCacheBase::Cleanup(int _frameCount)
     }
   }
 
+  if (g_ActiveConfig.iCustomTextureVRAMBudgetMB > 0)
+    EvictCustomTextures(_frameCount);
+
   TexPool::iterator iter2 = m_texture_pool.begin();
   TexPool::iterator tcend2 = m_texture_pool.end();
   while (iter2 != tcend2)
@@ -231,6 +272,160 @@ void TextureCacheBase::Cleanup(int _frameCount)
       ++iter2;
     }
   }
+
+  VRAMUsage usage = GetVRAMUsage();
+  if (g_ActiveConfig.iTextureCacheVRAMBudgetMB > 0)
+    EvictTexturesOverBudget(_frameCount, &usage);
+
+  SETSTAT(g_stats.texture_cache_textures_kb, usage.textures / 1024);
+  SETSTAT(g_stats.texture_cache_copies_kb, usage.copies / 1024);
+  SETSTAT(g_stats.texture_cache_pool_kb, usage.pool / 1024);
+}
+
+static size_t GetTextureSizeInBytes(const TextureConfig& config)
+{
+  const u32 block_size = AbstractTexture::GetBlockSizeForFormat(config.format);
+  size_t size = 0;
+  for (u32 level = 0; level < config.levels; ++level)
+  {
+    const u32 height = std::max(config.height >> level, 1u);
+    size += config.GetMipStride(level) * ((height + block_size - 1) / block_size);
+  }
+  return size * config.layers;
+}
+
+void TextureCacheBase::EvictCustomTextures(int frame_count)
+{
+  const size_t budget = size_t(g_ActiveConfig.iCustomTextureVRAMBudgetMB) * 1024 * 1024;
+
+  size_t total_size = 0;
+  std::vector<TexAddrCache::iterator> idle_textures;
+  for (auto iter = m_textures_by_address.begin(); iter != m_textures_by_address.end(); ++iter)
+  {
+    const TCacheEntry& entry = *iter->second;
+    if (!entry.is_custom_tex || !entry.texture)
+      continue;
+
+    total_size += GetTextureSizeInBytes(entry.texture->GetConfig());
+    if (entry.frameCount < frame_count)
+      idle_textures.push_back(iter);
+  }
+
+  if (total_size <= budget)
+    return;
+
+  // Evicted textures are created again when the game uses them, from the loaded custom texture
+  // or from the game's texture until the custom one is loaded again
+  std::ranges::sort(idle_textures, {}, [](const auto& iter) { return iter->second->frameCount; });
+  for (const auto& iter : idle_textures)
+  {
+    if (total_size <= budget)
+      break;
+
+    RcTcacheEntry entry = iter->second;
+    total_size -= GetTextureSizeInBytes(entry->texture->GetConfig());
+    InvalidateTexture(iter);
+
+    // Free the video memory right away, instead of keeping the texture in the pool
+    if (entry.use_count() == 1)
+    {
+      entry->framebuffer.reset();
+      entry->texture.reset();
+    }
+  }
+}
+
+TextureCacheBase::VRAMUsage TextureCacheBase::GetVRAMUsage() const
+{
+  VRAMUsage usage;
+  for (const auto& [address, entry] : m_textures_by_address)
+  {
+    if (!entry->texture)
+      continue;
+
+    const size_t size = GetTextureSizeInBytes(entry->texture->GetConfig());
+    if (entry->IsCopy())
+      usage.copies += size;
+    else
+      usage.textures += size;
+  }
+  for (const auto& [config, entry] : m_texture_pool)
+  {
+    if (entry.texture)
+      usage.pool += GetTextureSizeInBytes(config);
+  }
+  return usage;
+}
+
+void TextureCacheBase::EvictTexturesOverBudget(int frame_count, VRAMUsage* usage)
+{
+  const size_t budget = size_t(g_ActiveConfig.iTextureCacheVRAMBudgetMB) * 1024 * 1024;
+  if (usage->Total() <= budget)
+    return;
+
+  // The pool only keeps textures around to avoid creating them again, so it is emptied first
+  std::vector<TexPool::iterator> pool_entries;
+  for (auto iter = m_texture_pool.begin(); iter != m_texture_pool.end(); ++iter)
+    pool_entries.push_back(iter);
+  std::ranges::sort(pool_entries, {}, [](const auto& iter) { return iter->second.frameCount; });
+  for (const auto& iter : pool_entries)
+  {
+    if (usage->Total() <= budget)
+      return;
+
+    if (iter->second.texture)
+      usage->pool -= GetTextureSizeInBytes(iter->first);
+    m_texture_pool.erase(iter);
+  }
+
+  // EFB copies which were only written to video memory can't be loaded again, and neither can
+  // XFB copies or pending EFB copies, so only idle textures and EFB copies which are also in RAM
+  // are evicted. If that isn't enough, the cache stays over the budget.
+  struct Candidate
+  {
+    TexAddrCache::iterator iter;
+    size_t size;
+  };
+  std::vector<Candidate> candidates;
+  for (auto iter = m_textures_by_address.begin(); iter != m_textures_by_address.end(); ++iter)
+  {
+    const TCacheEntry& entry = *iter->second;
+    if (!entry.texture || entry.frameCount >= frame_count || entry.IsLocked() ||
+        entry.is_xfb_copy || entry.is_xfb_container || entry.pending_efb_copy)
+    {
+      continue;
+    }
+    if (entry.is_efb_copy && g_ActiveConfig.bSkipEFBCopyToRam)
+      continue;
+
+    candidates.push_back({iter, GetTextureSizeInBytes(entry.texture->GetConfig())});
+  }
+
+  // Least recently used first, and of the textures last used in the same frame, the biggest first
+  std::ranges::sort(candidates, [](const Candidate& a, const Candidate& b) {
+    if (a.iter->second->frameCount != b.iter->second->frameCount)
+      return a.iter->second->frameCount < b.iter->second->frameCount;
+    return a.size > b.size;
+  });
+  for (const Candidate& candidate : candidates)
+  {
+    if (usage->Total() <= budget)
+      break;
+
+    RcTcacheEntry entry = candidate.iter->second;
+    InvalidateTexture(candidate.iter);
+    INCSTAT(g_stats.num_textures_evicted);
+
+    // Free the video memory right away, instead of keeping the texture in the pool. Textures
+    // which are still referenced elsewhere go to the pool once they are released.
+    if (entry.use_count() == 1)
+    {
+      (entry->IsCopy() ? usage->copies : usage->textures) -= candidate.size;
+      entry->framebuffer.reset();
+      entry->texture.reset();
+    }
+  }
+  SETSTAT(g_stats.num_textures_alive, static_cast<int>(m_textures_by_address.size()));
 }
 
 bool TCacheEntry::OverlapsMemoryRange(u32 range_address, u32 range_size) const
@@ -715,8 +910,8 @@ void TextureCacheBase::DoLoadState(PointerWrap& p)
     // Even if the texture isn't valid, we still need to create the cache entry object
     // to update the point in the state state. We'll just throw it away if it's invalid.
     auto tex = DeserializeTexture(p);
-    auto entry =
-        std::make_shared<TCacheEntry>(std::move(tex->texture), std::move(tex->framebuffer));
+    auto entry = std::allocate_shared<TCacheEntry>(m_entry_allocator, std::move(tex->texture),
+                                                   std::move(tex->framebuffer));
     entry->textures_by_hash_iter = m_textures_by_hash.end();
     entry->DoState(p);
     if (entry->texture && commit_state)
@@ -1245,6 +1440,10 @@ private:
 
 TCacheEntry* TextureCacheBase::Load(const TextureInfo& texture_info)
 {
+  PerformanceMetrics::ScopedFrameSection frame_section(
+      PerformanceMetrics::FrameSection::TextureCache);
+  INCSTAT(g_stats.this_frame.num_texture_loads);
+
   if (auto entry = LoadImpl(texture_info, false))
   {
     if (!DidLinkedAssetsChange(*entry))
@@ -1282,9 +1481,22 @@ TCacheEntry* TextureCacheBase::LoadImpl(const TextureInfo& texture_info, bool fo
 
     // Otherwise, hash the backing memory and check it's unchanged.
     // FIXME: this doesn't correctly handle textures from tmem.
-    if (!entry->invalidated && entry->base_hash == entry->CalculateHash())
+    if (!entry->invalidated)
     {
-      return entry;
+      u64 hash;
+      if (!entry->IsCopy() && entry->memory_stride == entry->BytesPerRow())
+      {
+        FlushEFBCopiesInRange(entry->addr, entry->size_in_bytes);
+        auto& memory = Core::System::GetInstance().GetMemory();
+        const u8* ptr = memory.GetPointerForRange(entry->addr, entry->size_in_bytes);
+        hash = GetTrackedHash(entry->addr, ptr, entry->size_in_bytes, entry->HashSampleSize());
+      }
+      else
+      {
+        hash = entry->CalculateHash();
+      }
+      if (entry->base_hash == hash)
+        return entry;
     }
   }
 
@@ -1351,8 +1563,20 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
 
   // TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more data
   // from the low tmem bank than it should)
-  base_hash = Common::GetHash64(texture_info.GetData(), texture_info.GetTextureSize(),
-                                textureCacheSafetyColorSampleSize);
+  if (texture_info.IsFromTmem())
+  {
+    base_hash = Common::GetHash64(texture_info.GetData(), texture_info.GetTextureSize(),
+                                  textureCacheSafetyColorSampleSize);
+  }
+  else
+  {
+    // Deferred EFB copies to this memory have to reach RAM before it is hashed, unless this
+    // texture is the copy itself, which will be used from VRAM.
+    FlushEFBCopiesInRange(texture_info.GetRawAddress(), texture_info.GetFullLevelSize(),
+                          &texture_info);
+    base_hash = GetTrackedHash(texture_info.GetRawAddress(), texture_info.GetData(),
+                               texture_info.GetTextureSize(), textureCacheSafetyColorSampleSize);
+  }
   u32 palette_size = 0;
   if (texture_info.GetPaletteSize())
   {
@@ -1625,9 +1849,12 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
     }
   }
 
+  auto& asset_loader = Core::System::GetInstance().GetCustomAssetLoader();
   data_for_assets.reserve(cached_game_assets.size());
   for (auto& cached_asset : cached_game_assets)
   {
+    asset_loader.RequestLoad(cached_asset.m_asset);
+
     auto data = cached_asset.m_asset->GetData();
     if (data)
     {
@@ -1719,15 +1946,41 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
     // banks, and if we're doing an copy we may as well just do the whole thing on the CPU, since
     // there's no conversion between formats. In the future this could be extended with a separate
     // shader, however.
+    // Small textures are left to the CPU if configured, since the dispatch overhead dominates.
     const bool decode_on_gpu =
         g_ActiveConfig.UseGPUTextureDecoding() &&
-        !(texture_info.IsFromTmem() && texture_info.GetTextureFormat() == TextureFormat::RGBA8);
+        !(texture_info.IsFromTmem() && texture_info.GetTextureFormat() == TextureFormat::RGBA8) &&
+        expanded_width * expanded_height >=
+            static_cast<u32>(std::max(g_ActiveConfig.iGPUTextureDecodingMinTexels, 0));
 
     ArbitraryMipmapDetector arbitrary_mip_detector;
 
     // Initialized to null because only software loading uses this buffer
     u8* dst_buffer = nullptr;
 
+    // When all levels are decoded on the CPU, large textures can be loaded from the decoded
+    // texture cache instead. This needs a hash which covers the whole texture.
+    std::optional<VideoCommon::DecodedTextureCache::Key> decoded_cache_key;
+    size_t decoded_cache_size = 0;
+    bool from_decoded_cache = false;
+    if (g_ActiveConfig.bCacheDecodedTextures && !decode_on_gpu && safety_color_sample_size == 0 &&
+        !g_ActiveConfig.bTexFmtOverlayEnable &&
+        expanded_width * expanded_height >= VideoCommon::DecodedTextureCache::MIN_TEXELS)
+    {
+      decoded_cache_key = VideoCommon::DecodedTextureCache::Key{
+          creation_info.full_hash, texture_info.GetTextureFormat(), texture_info.GetTlutFormat(),
+          expanded_width, expanded_height, texLevels};
+      decoded_cache_size = expanded_width * sizeof(u32) * expanded_height;
+      for (u32 level = 1; level != texLevels; ++level)
+      {
+        if (const auto mip_level = texture_info.GetMipMapLevel(level - 1))
+        {
+          decoded_cache_size +=
+              mip_level->GetExpandedWidth() * sizeof(u32) * mip_level->GetExpandedHeight();
+        }
+      }
+    }
+
     if (!decode_on_gpu ||
         !DecodeTextureOnGPU(
             entry, 0, texture_info.GetData(), texture_info.GetTextureSize(),
@@ -1755,11 +2008,19 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
 
       CheckTempSize(total_texture_size);
       dst_buffer = m_temp;
-      if (!(texture_info.GetTextureFormat() == TextureFormat::RGBA8 && texture_info.IsFromTmem()))
+      from_decoded_cache =
+          decoded_cache_key &&
+          m_decoded_texture_cache.Load(*decoded_cache_key, dst_buffer, decoded_cache_size);
+      if (from_decoded_cache)
+      {
+        // Every level is already in the buffer.
+      }
+      else if (!(texture_info.GetTextureFormat() == TextureFormat::RGBA8 &&
+                 texture_info.IsFromTmem()))
       {
-        TexDecoder_Decode(dst_buffer, texture_info.GetData(), expanded_width, expanded_height,
-                          texture_info.GetTextureFormat(), texture_info.GetTlutAddress(),
-                          texture_info.GetTlutFormat());
+        TexDecoder_DecodeParallel(dst_buffer, texture_info.GetData(), expanded_width,
+                                  expanded_height, texture_info.GetTextureFormat(),
+                                  texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
       }
       else
       {
@@ -1793,9 +2054,13 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
         // No need to call CheckTempSize here, as the whole buffer is preallocated at the beginning
         const u32 decoded_mip_size =
             mip_level->GetExpandedWidth() * sizeof(u32) * mip_level->GetExpandedHeight();
-        TexDecoder_Decode(dst_buffer, mip_level->GetData(), mip_level->GetExpandedWidth(),
-                          mip_level->GetExpandedHeight(), texture_info.GetTextureFormat(),
-                          texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
+        if (!from_decoded_cache)
+        {
+          TexDecoder_DecodeParallel(dst_buffer, mip_level->GetData(),
+                                    mip_level->GetExpandedWidth(), mip_level->GetExpandedHeight(),
+                                    texture_info.GetTextureFormat(), texture_info.GetTlutAddress(),
+                                    texture_info.GetTlutFormat());
+        }
         entry->texture->Load(level, mip_level->GetRawWidth(), mip_level->GetRawHeight(),
                              mip_level->GetExpandedWidth(), dst_buffer, decoded_mip_size);
 
@@ -1806,6 +2071,9 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
       }
     }
 
+    if (decoded_cache_key && !from_decoded_cache)
+      m_decoded_texture_cache.Store(*decoded_cache_key, m_temp, dst_buffer - m_temp);
+
     entry->has_arbitrary_mips = arbitrary_mip_detector.HasArbitraryMipmaps(dst_buffer);
 
     if (g_ActiveConfig.bDumpTextures && !skip_texture_dump && texLevels > 0)
@@ -2299,6 +2567,34 @@ void TextureCacheBase::CopyRenderTargetToTexture(
     return;
   }
 
+  // Games often copy the same region of the EFB to the same place several times without drawing
+  // in between. When the copy only goes to VRAM, its texture cache entry is the only result of the
+  // copy, so if it is still there the copy can be skipped.
+  const bool can_skip_copy = !is_xfb_copy && copy_to_vram && !copy_to_ram &&
+                             dstStride >= bytes_per_row && !g_ActiveConfig.bGraphicMods &&
+                             !OpcodeDecoder::g_record_fifo_data;
+  const EFBCopyRecord copy_record{.dst_addr = dstAddr,
+                                  .dst_format = dstFormat,
+                                  .width = width,
+                                  .height = height,
+                                  .dst_stride = dstStride,
+                                  .is_depth_copy = is_depth_copy,
+                                  .src_rect = srcRect,
+                                  .is_intensity = isIntensity,
+                                  .scale_by_half = scaleByHalf,
+                                  .gamma = gamma,
+                                  .clamp_top = clamp_top,
+                                  .clamp_bottom = clamp_bottom,
+                                  .filter_coefficients = filter_coefficients,
+                                  .efb_format = bpmem.zcontrol.pixel_format,
+                                  .scaled_width = scaled_tex_w,
+                                  .scaled_height = scaled_tex_h};
+  if (can_skip_copy && IsEFBCopyRedundant(copy_record))
+  {
+    INCSTAT(g_stats.this_frame.num_efb_copies_skipped);
+    return;
+  }
+
   if (g_ActiveConfig.bGraphicMods)
   {
     FBInfo info;
@@ -2540,10 +2836,59 @@ void TextureCacheBase::CopyRenderTargetToTexture(
   {
     const u64 hash = entry->CalculateHash();
     entry->SetHashes(hash, hash);
+    if (can_skip_copy)
+      RecordEFBCopy(copy_record, entry);
     m_textures_by_address.emplace(dstAddr, std::move(entry));
   }
 }
 
+bool TextureCacheBase::IsEFBCopyRedundant(const EFBCopyRecord& record)
+{
+  const u64 modification_count = g_framebuffer_manager->GetEFBModificationCount();
+  if (modification_count != m_recent_efb_copies_modification_count)
+  {
+    m_recent_efb_copies.clear();
+    m_recent_efb_copies_modification_count = modification_count;
+    return false;
+  }
+
+  const auto it = std::ranges::find(m_recent_efb_copies, record, &RecentEFBCopy::record);
+  if (it == m_recent_efb_copies.end())
+    return false;
+
+  // The entry mustn't have been invalidated or partly overwritten by another copy, and its memory
+  // mustn't have been written to.
+  const TCacheEntry* entry = it->entry.get();
+  const auto range = m_textures_by_address.equal_range(record.dst_addr);
+  const bool in_cache = std::any_of(range.first, range.second, [entry](const auto& pair) {
+    return pair.second.get() == entry;
+  });
+  if (in_cache && !entry->may_have_overlapping_textures && entry->hash == entry->CalculateHash())
+    return true;
+
+  m_recent_efb_copies.erase(it);
+  return false;
+}
+
+void TextureCacheBase::RecordEFBCopy(const EFBCopyRecord& record, const RcTcacheEntry& entry)
+{
+  // Limit the number of entries which are kept alive.
+  constexpr size_t MAX_RECENT_EFB_COPIES = 16;
+
+  const u64 modification_count = g_framebuffer_manager->GetEFBModificationCount();
+  if (modification_count != m_recent_efb_copies_modification_count)
+  {
+    m_recent_efb_copies.clear();
+    m_recent_efb_copies_modification_count = modification_count;
+  }
+  else if (m_recent_efb_copies.size() >= MAX_RECENT_EFB_COPIES)
+  {
+    m_recent_efb_copies.erase(m_recent_efb_copies.begin());
+  }
+
+  m_recent_efb_copies.push_back({record, entry});
+}
+
 void TextureCacheBase::FlushEFBCopies()
 {
   if (m_pending_efb_copies.empty())
@@ -2554,6 +2899,49 @@ void TextureCacheBase::FlushEFBCopies()
   m_pending_efb_copies.clear();
 }
 
+void TextureCacheBase::FlushEFBCopiesInRange(u32 address, u32 size,
+                                             const TextureInfo* texture_info)
+{
+  if (m_pending_efb_copies.empty())
+    return;
+
+  const auto is_loaded_from_vram = [texture_info](const TCacheEntry& entry) {
+    return texture_info && entry.addr == texture_info->GetRawAddress() &&
+           entry.native_width == texture_info->GetRawWidth() &&
+           entry.native_height == texture_info->GetRawHeight() &&
+           entry.memory_stride == entry.BytesPerRow() && !entry.may_have_overlapping_textures;
+  };
+
+  // A copy which is flushed would be overwritten by any earlier copy to the same memory that is
+  // flushed after it, so walk the copies from newest to oldest and pull those in as well.
+  std::vector<bool> flush(m_pending_efb_copies.size());
+  std::vector<std::pair<u32, u32>> ranges;
+  for (size_t i = m_pending_efb_copies.size(); i-- > 0;)
+  {
+    const TCacheEntry& entry = *m_pending_efb_copies[i];
+    const u32 covered_range = entry.pending_efb_copy_height * entry.memory_stride;
+    flush[i] = (entry.OverlapsMemoryRange(address, size) && !is_loaded_from_vram(entry)) ||
+               std::ranges::any_of(ranges, [&entry](const auto& range) {
+                 return entry.OverlapsMemoryRange(range.first, range.second);
+               });
+    if (flush[i])
+      ranges.emplace_back(entry.addr, covered_range);
+  }
+
+  if (ranges.empty())
+    return;
+
+  size_t remaining = 0;
+  for (size_t i = 0; i < m_pending_efb_copies.size(); ++i)
+  {
+    if (flush[i])
+      FlushEFBCopy(m_pending_efb_copies[i].get());
+    else
+      m_pending_efb_copies[remaining++] = std::move(m_pending_efb_copies[i]);
+  }
+  m_pending_efb_copies.resize(remaining);
+}
+
 void TextureCacheBase::FlushStaleBinds()
 {
   for (u32 i = 0; i < m_bound_textures.size(); i++)
@@ -2695,8 +3083,8 @@ RcTcacheEntry TextureCacheBase::AllocateCacheEntry(const TextureConfig& config)
   if (!alloc)
     return {};
 
-  auto cacheEntry =
-      std::make_shared<TCacheEntry>(std::move(alloc->texture), std::move(alloc->framebuffer));
+  auto cacheEntry = std::allocate_shared<TCacheEntry>(m_entry_allocator, std::move(alloc->texture),
+                                                      std::move(alloc->framebuffer));
   cacheEntry->textures_by_hash_iter = m_textures_by_hash.end();
   cacheEntry->id = m_last_entry_id++;
   return cacheEntry;
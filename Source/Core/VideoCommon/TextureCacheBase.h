@@ -20,10 +20,12 @@
 #include "Common/CommonTypes.h"
 #include "Common/Flag.h"
 #include "Common/MathUtil.h"
+#include "Common/PoolAllocator.h"
 
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/Assets/CustomAsset.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/DecodedTextureCache.h"
 #include "VideoCommon/TextureConfig.h"
 #include "VideoCommon/TextureDecoder.h"
 #include "VideoCommon/TextureInfo.h"
@@ -154,7 +156,9 @@ struct TCacheEntry
 
   // Keep an iterator to the entry in m_textures_by_hash, so it does not need to be searched when
   // removing the cache entry
-  std::multimap<u64, std::shared_ptr<TCacheEntry>>::iterator textures_by_hash_iter;
+  std::multimap<u64, std::shared_ptr<TCacheEntry>, std::less<u64>,
+                Common::PoolAllocator<std::pair<const u64, std::shared_ptr<TCacheEntry>>>>::iterator
+      textures_by_hash_iter;
 
   // This is used to keep track of both:
   //   * efb copies used by this partially updated texture
@@ -296,6 +300,11 @@ public:
   // Flushes all pending EFB copies to emulated RAM.
   void FlushEFBCopies();
 
+  // Flushes the pending EFB copies which overlap a range of guest memory that is about to be read,
+  // along with the earlier pending copies they overlap, so that they land in the right order.
+  // Copies which the texture would use directly from VRAM are left pending.
+  void FlushEFBCopiesInRange(u32 address, u32 size, const TextureInfo* texture_info = nullptr);
+
   // Flush any Bound textures that can't be reused
   void FlushStaleBinds();
 
@@ -339,13 +348,36 @@ protected:
   size_t m_temp_size = 0;
 
 private:
-  using TexAddrCache = std::multimap<u32, RcTcacheEntry>;
-  using TexHashCache = std::multimap<u64, RcTcacheEntry>;
+  // Cache entries and the nodes of both indices are created and destroyed constantly in games
+  // which stream lots of small textures, so they are all recycled through a single pool.
+  using TexAddrCache = std::multimap<u32, RcTcacheEntry, std::less<u32>,
+                                     Common::PoolAllocator<std::pair<const u32, RcTcacheEntry>>>;
+  using TexHashCache = std::multimap<u64, RcTcacheEntry, std::less<u64>,
+                                     Common::PoolAllocator<std::pair<const u64, RcTcacheEntry>>>;
 
   using TexPool = std::unordered_multimap<TextureConfig, TexPoolEntry>;
 
   static bool DidLinkedAssetsChange(const TCacheEntry& entry);
 
+  // Invalidates the least recently used custom textures that weren't used in the current frame
+  // until the custom textures fit in the video memory budget
+  void EvictCustomTextures(int frame_count);
+
+  // Video memory held by the texture cache, in bytes
+  struct VRAMUsage
+  {
+    size_t textures = 0;
+    size_t copies = 0;
+    size_t pool = 0;
+
+    size_t Total() const { return textures + copies + pool; }
+  };
+  VRAMUsage GetVRAMUsage() const;
+
+  // Frees pooled textures, then the least recently used textures that weren't used in the current
+  // frame, until the texture cache fits in the video memory budget
+  void EvictTexturesOverBudget(int frame_count, VRAMUsage* usage);
+
   TCacheEntry* LoadImpl(const TextureInfo& texture_info, bool force_reload);
 
   bool CreateUtilityTextures();
@@ -370,6 +402,10 @@ private:
 
   void CheckTempSize(size_t required_size);
 
+  // Hashes a contiguous range of emulated memory. With texture write tracking, the hash is only
+  // recomputed if the memory may have been written to since it was last hashed.
+  u64 GetTrackedHash(u32 address, const u8* ptr, u32 size, u32 sample_size);
+
   RcTcacheEntry AllocateCacheEntry(const TextureConfig& config);
   std::optional<TexPoolEntry> AllocateTexture(const TextureConfig& config);
   TexPool::iterator FindMatchingTextureFromPool(const TextureConfig& config);
@@ -384,6 +420,34 @@ private:
   TexAddrCache::iterator InvalidateTexture(TexAddrCache::iterator t_iter,
                                            bool discard_pending_efb_copy = false);
 
+  // Everything that determines the result of an EFB copy, apart from the EFB contents.
+  struct EFBCopyRecord
+  {
+    u32 dst_addr;
+    EFBCopyFormat dst_format;
+    u32 width;
+    u32 height;
+    u32 dst_stride;
+    bool is_depth_copy;
+    MathUtil::Rectangle<int> src_rect;
+    bool is_intensity;
+    bool scale_by_half;
+    float gamma;
+    bool clamp_top;
+    bool clamp_bottom;
+    CopyFilterCoefficients::Values filter_coefficients;
+    PixelFormat efb_format;
+    u32 scaled_width;
+    u32 scaled_height;
+
+    bool operator==(const EFBCopyRecord&) const = default;
+  };
+
+  // Returns true if the same EFB copy was made since the EFB was last changed, and its texture
+  // cache entry is still valid.
+  bool IsEFBCopyRedundant(const EFBCopyRecord& record);
+  void RecordEFBCopy(const EFBCopyRecord& record, const RcTcacheEntry& entry);
+
   void UninitializeEFBMemory(u8* dst, u32 stride, u32 bytes_per_row, u32 num_blocks_y);
   void UninitializeXFBMemory(u8* dst, u32 stride, u32 bytes_per_row, u32 num_blocks_y);
 
@@ -408,13 +472,15 @@ private:
   void DoSaveState(PointerWrap& p);
   void DoLoadState(PointerWrap& p);
 
+  Common::PoolAllocator<TCacheEntry> m_entry_allocator;
+
   // m_textures_by_address is the authoritive version of what's actually "in" the texture cache
   // but it's possible for invalidated TCache entries to live on elsewhere
-  TexAddrCache m_textures_by_address;
+  TexAddrCache m_textures_by_address{m_entry_allocator};
 
   // m_textures_by_hash is an alternative view of the texture cache
   // All textures in here will also be in m_textures_by_address
-  TexHashCache m_textures_by_hash;
+  TexHashCache m_textures_by_hash{m_entry_allocator};
 
   // m_bound_textures are actually active in the current draw
   // It's valid for textures to be in here after they've been invalidated
@@ -457,6 +523,15 @@ private:
   // It's valid for textures to live be in here after they've been invalidated
   std::vector<RcTcacheEntry> m_pending_efb_copies;
 
+  // EFB copies made since the EFB was last changed (according to its modification count).
+  struct RecentEFBCopy
+  {
+    EFBCopyRecord record;
+    RcTcacheEntry entry;
+  };
+  std::vector<RecentEFBCopy> m_recent_efb_copies;
+  u64 m_recent_efb_copies_modification_count = 0;
+
   // Staging texture used for readbacks.
   // We store this in the class so that the same staging texture can be used for multiple
   // readbacks, saving the overhead of allocating a new buffer every time.
@@ -468,6 +543,16 @@ private:
       AfterFrameEvent::Register([this](Core::System&) { OnFrameEnd(); }, "TextureCache");
 
   VideoCommon::TextureUtils::TextureDumper m_texture_dumper;
+  VideoCommon::DecodedTextureCache m_decoded_texture_cache;
+
+  struct TrackedHash
+  {
+    u64 serial;
+    u64 hash;
+    u32 sample_size;
+  };
+  // Keyed by address in the upper and size in the lower 32 bits.
+  std::unordered_map<u64, TrackedHash> m_tracked_hashes;
 };
 
 extern std::unique_ptr<TextureCacheBase> g_texture_cache;
@@ -5,7 +5,10 @@
 #include <array>
 #include <cmath>
 #include <cstddef>
+#include <future>
 #include <span>
+#include <thread>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/MsgHandler.h"
@@ -307,6 +310,47 @@ void TexDecoder_Decode(u8* dst, const u8* src, int width, int height, TextureFor
     TexDecoder_DrawOverlay(dst, width, height, texformat);
 }
 
+void TexDecoder_DecodeParallel(u8* dst, const u8* src, int width, int height,
+                               TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt)
+{
+  // Below this size, starting the threads costs more than decoding the texture.
+  constexpr int MIN_TEXELS_PER_BAND = 256 * 256;
+  constexpr int MAX_BANDS = 8;
+
+  const int block_height = TexDecoder_GetBlockHeightInTexels(texformat);
+  const int block_rows = height / block_height;
+  const int max_bands = std::max(width * height / MIN_TEXELS_PER_BAND, 1);
+  const int num_bands =
+      std::min({block_rows, max_bands, MAX_BANDS,
+                std::max(static_cast<int>(std::thread::hardware_concurrency()), 1)});
+  if (num_bands <= 1 || height % block_height != 0)
+  {
+    TexDecoder_Decode(dst, src, width, height, texformat, tlut, tlutfmt);
+    return;
+  }
+
+  // Blocks are stored row by row, so every band of whole block rows is a contiguous part of both
+  // the source and the destination.
+  const auto decode_band = [&](int band) {
+    const int first_row = block_rows * band / num_bands * block_height;
+    const int end_row = block_rows * (band + 1) / num_bands * block_height;
+    _TexDecoder_DecodeImpl(reinterpret_cast<u32*>(dst) + first_row * width,
+                           src + TexDecoder_GetTextureSizeInBytes(width, first_row, texformat),
+                           width, end_row - first_row, texformat, tlut, tlutfmt);
+  };
+
+  std::vector<std::future<void>> futures;
+  futures.reserve(num_bands - 1);
+  for (int band = 1; band < num_bands; ++band)
+    futures.push_back(std::async(std::launch::async, decode_band, band));
+  decode_band(0);
+  for (auto& future : futures)
+    future.get();
+
+  if (TexFmt_Overlay_Enable)
+    TexDecoder_DrawOverlay(dst, width, height, texformat);
+}
+
 static inline u32 DecodePixel_IA8(u16 val)
 {
   int a = val & 0xFF;
@@ -425,6 +425,31 @@ static void TexDecoder_DecodeImpl_I8_SSSE3(u32* dst, const u8* src, int width, i
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_I8_AVX2(u32* dst, const u8* src, int width, int height,
+                                          TextureFormat texformat, const u8* tlut,
+                                          TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // Same as the SSSE3 version, but expands a whole row of the block with a single shuffle.
+  const __m256i mask = _mm256_set_epi8(7, 7, 7, 7, 6, 6, 6, 6, 5, 5, 5, 5, 4, 4, 4, 4, 3, 3, 3, 3,
+                                       2, 2, 2, 2, 1, 1, 1, 1, 0, 0, 0, 0);
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 4; ++iy, xStep++)
+      {
+        // Load 64 bits from `src` into both 128-bit lanes: (hgfe dcba hgfe dcba)
+        const __m256i r =
+            _mm256_broadcastsi128_si256(_mm_loadl_epi64((const __m128i*)(src + 8 * xStep)));
+        // Shuffle to (hhhh gggg ffff eeee dddd cccc bbbb aaaa)
+        const __m256i rgba = _mm256_shuffle_epi8(r, mask);
+        _mm256_storeu_si256((__m256i*)(dst + (y + iy) * width + x), rgba);
+      }
+    }
+  }
+}
+
 static void TexDecoder_DecodeImpl_I8(u32* dst, const u8* src, int width, int height,
                                      TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt,
                                      int Wsteps4, int Wsteps8)
@@ -604,6 +629,34 @@ static void TexDecoder_DecodeImpl_IA8_SSSE3(u32* dst, const u8* src, int width,
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_IA8_AVX2(u32* dst, const u8* src, int width, int height,
+                                           TextureFormat texformat, const u8* tlut,
+                                           TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // Same as the SSSE3 version, but decodes the same row of two horizontally adjacent blocks at
+  // once. The caller ensures that the width is a multiple of 8.
+  const __m256i mask = _mm256_set_epi8(6, 7, 7, 7, 4, 5, 5, 5, 2, 3, 3, 3, 0, 1, 1, 1, 6, 7, 7, 7,
+                                       4, 5, 5, 5, 2, 3, 3, 3, 0, 1, 1, 1);
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 8, yStep += 2)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 4; iy++, xStep++)
+      {
+        // Load 4x 16-bit IA8 samples of both blocks into the two 128-bit lanes:
+        // (0000 0000 ponm lkji 0000 0000 hgfe dcba)
+        const __m128i left = _mm_loadl_epi64((const __m128i*)(src + 8 * xStep));
+        const __m128i right = _mm_loadl_epi64((const __m128i*)(src + 8 * (xStep + 4)));
+        const __m256i r0 = _mm256_inserti128_si256(_mm256_castsi128_si256(left), right, 1);
+        // Shuffle to (oppp mnnn klll ijjj ghhh efff cddd abbb)
+        const __m256i r1 = _mm256_shuffle_epi8(r0, mask);
+        _mm256_storeu_si256((__m256i*)(dst + (y + iy) * width + x), r1);
+      }
+    }
+  }
+}
+
 static void TexDecoder_DecodeImpl_IA8(u32* dst, const u8* src, int width, int height,
                                       TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt,
                                       int Wsteps4, int Wsteps8)
@@ -1036,6 +1089,35 @@ static void TexDecoder_DecodeImpl_RGBA8_SSSE3(u32* dst, const u8* src, int width
   }
 }
 
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_RGBA8_AVX2(u32* dst, const u8* src, int width, int height,
+                                             TextureFormat texformat, const u8* tlut,
+                                             TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // Same as the SSSE3 version, but interleaves the upper and lower halves of the block in the two
+  // 128-bit lanes, so that each lane ends up holding a different row.
+  const __m256i mask0312 = _mm256_set_epi8(12, 15, 13, 14, 8, 11, 9, 10, 4, 7, 5, 6, 0, 3, 1, 2,
+                                           12, 15, 13, 14, 8, 11, 9, 10, 4, 7, 5, 6, 0, 3, 1, 2);
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      const u8* src2 = src + 64 * yStep;
+      const __m256i ar = _mm256_loadu_si256((const __m256i*)src2);
+      const __m256i gb = _mm256_loadu_si256((const __m256i*)src2 + 1);
+
+      // Rows 0 and 2 in the low and high lanes, then rows 1 and 3
+      const __m256i rgba02 = _mm256_shuffle_epi8(_mm256_unpacklo_epi8(ar, gb), mask0312);
+      const __m256i rgba13 = _mm256_shuffle_epi8(_mm256_unpackhi_epi8(ar, gb), mask0312);
+
+      _mm_storeu_si128((__m128i*)(dst + (y + 0) * width + x), _mm256_castsi256_si128(rgba02));
+      _mm_storeu_si128((__m128i*)(dst + (y + 1) * width + x), _mm256_castsi256_si128(rgba13));
+      _mm_storeu_si128((__m128i*)(dst + (y + 2) * width + x), _mm256_extracti128_si256(rgba02, 1));
+      _mm_storeu_si128((__m128i*)(dst + (y + 3) * width + x), _mm256_extracti128_si256(rgba13, 1));
+    }
+  }
+}
+
 static void TexDecoder_DecodeImpl_RGBA8(u32* dst, const u8* src, int width, int height,
                                         TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt,
                                         int Wsteps4, int Wsteps8)
@@ -1434,7 +1516,10 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::I8:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_I8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                    Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_I8_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                      Wsteps8);
     else
@@ -1450,7 +1535,10 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::IA8:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2 && width % 8 == 0)
+      TexDecoder_DecodeImpl_IA8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                     Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_IA8_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                       Wsteps8);
     else
@@ -1478,7 +1566,10 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::RGBA8:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_RGBA8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                       Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_RGBA8_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                         Wsteps8);
     else
@@ -3,7 +3,9 @@
 
 #include "VideoCommon/TextureInfo.h"
 
+#include <charconv>
 #include <span>
+#include <type_traits>
 
 #include <fmt/format.h>
 #include <xxhash.h>
@@ -128,11 +130,72 @@ std::string TextureInfo::NameDetails::GetFullName() const
   return fmt::format("{}_{}{}_{}", base_name, texture_name, tlut_name, format_name);
 }
 
-TextureInfo::NameDetails TextureInfo::CalculateTextureName() const
+namespace
 {
-  if (!IsDataValid())
-    return NameDetails{};
+// How the texture or palette hash appears in a texture name
+enum class NameHashKind : u8
+{
+  None,
+  Value,
+  Wildcard,
+};
 
+struct NameKeyData
+{
+  u64 texture_hash;
+  u64 tlut_hash;
+  u32 width;
+  u32 height;
+  u32 format;
+  u8 mipmaps;
+  NameHashKind texture_kind;
+  NameHashKind tlut_kind;
+  u8 padding;
+};
+static_assert(std::has_unique_object_representations_v<NameKeyData>);
+
+u64 GetNameKey(const NameKeyData& data)
+{
+  return XXH3_64bits(&data, sizeof(data));
+}
+
+std::string FormatNameHash(NameHashKind kind, u64 hash)
+{
+  switch (kind)
+  {
+  case NameHashKind::Value:
+    return fmt::format("{:016x}", hash);
+  case NameHashKind::Wildcard:
+    return "$";
+  default:
+    return "";
+  }
+}
+
+template <typename T>
+bool ParseNamePart(std::string_view part, T* value, int base)
+{
+  const char* const end = part.data() + part.size();
+  const auto [ptr, ec] = std::from_chars(part.data(), end, *value, base);
+  return !part.empty() && ec == std::errc{} && ptr == end;
+}
+
+bool ParseNameHash(std::string_view part, NameHashKind* kind, u64* hash)
+{
+  if (part == "$")
+  {
+    *kind = NameHashKind::Wildcard;
+    *hash = 0;
+    return true;
+  }
+
+  *kind = NameHashKind::Value;
+  return ParseNamePart(part, hash, 16);
+}
+}  // namespace
+
+TextureInfo::NameHashes TextureInfo::CalculateNameHashes() const
+{
   const u8* tlut = m_tlut_ptr;
   size_t tlut_size = m_palette_size ? *m_palette_size : 0;
 
@@ -180,19 +243,121 @@ TextureInfo::NameDetails TextureInfo::CalculateTextureName() const
 
   DEBUG_ASSERT(tlut_size <= m_palette_size.value_or(0));
 
-  const u64 tex_hash = XXH64(m_ptr, m_texture_size, 0);
-  const u64 tlut_hash = tlut_size ? XXH64(tlut, tlut_size, 0) : 0;
+  NameHashes hashes;
+  hashes.texture_hash = XXH64(m_ptr, m_texture_size, 0);
+  if (tlut_size)
+    hashes.tlut_hash = XXH64(tlut, tlut_size, 0);
+  return hashes;
+}
+
+TextureInfo::NameDetails TextureInfo::CalculateTextureName() const
+{
+  if (!IsDataValid())
+    return NameDetails{};
+
+  const NameHashes hashes = CalculateNameHashes();
 
   NameDetails result;
   result.base_name = fmt::format("{}{}x{}{}", format_prefix, m_raw_width, m_raw_height,
                                  m_mipmaps_enabled ? "_m" : "");
-  result.texture_name = fmt::format("{:016x}", tex_hash);
-  result.tlut_name = tlut_size ? fmt::format("_{:016x}", tlut_hash) : "";
+  result.texture_name = fmt::format("{:016x}", hashes.texture_hash);
+  result.tlut_name = hashes.tlut_hash ? fmt::format("_{:016x}", *hashes.tlut_hash) : "";
   result.format_name = fmt::to_string(static_cast<int>(m_texture_format));
 
   return result;
 }
 
+std::optional<TextureInfo::NameKeys> TextureInfo::CalculateTextureNameKeys() const
+{
+  if (!IsDataValid())
+    return std::nullopt;
+
+  const NameHashes hashes = CalculateNameHashes();
+
+  NameKeyData data{};
+  data.texture_hash = hashes.texture_hash;
+  data.tlut_hash = hashes.tlut_hash.value_or(0);
+  data.width = m_raw_width;
+  data.height = m_raw_height;
+  data.format = static_cast<u32>(m_texture_format);
+  data.mipmaps = m_mipmaps_enabled;
+  data.texture_kind = NameHashKind::Value;
+  data.tlut_kind = hashes.tlut_hash ? NameHashKind::Value : NameHashKind::None;
+
+  NameKeys keys;
+  keys.full = GetNameKey(data);
+
+  NameKeyData wildcard_tlut = data;
+  wildcard_tlut.tlut_hash = 0;
+  wildcard_tlut.tlut_kind = NameHashKind::Wildcard;
+  keys.wildcard_tlut = GetNameKey(wildcard_tlut);
+
+  NameKeyData wildcard_texture = data;
+  wildcard_texture.texture_hash = 0;
+  wildcard_texture.texture_kind = NameHashKind::Wildcard;
+  keys.wildcard_texture = GetNameKey(wildcard_texture);
+
+  return keys;
+}
+
+std::optional<u64> TextureInfo::GetTextureNameKey(std::string_view name)
+{
+  if (!name.starts_with(format_prefix))
+    return std::nullopt;
+
+  std::vector<std::string_view> parts;
+  for (std::string_view rest = name.substr(format_prefix.size());;)
+  {
+    const size_t separator = rest.find('_');
+    parts.push_back(rest.substr(0, separator));
+    if (separator == std::string_view::npos)
+      break;
+    rest.remove_prefix(separator + 1);
+  }
+
+  // {width}x{height}[_m]_{texture hash}[_{tlut hash}]_{format}
+  NameKeyData data{};
+  const std::string_view size = parts[0];
+  const size_t x = size.find('x');
+  if (x == std::string_view::npos || !ParseNamePart(size.substr(0, x), &data.width, 10) ||
+      !ParseNamePart(size.substr(x + 1), &data.height, 10))
+  {
+    return std::nullopt;
+  }
+
+  size_t index = 1;
+  if (index < parts.size() && parts[index] == "m")
+  {
+    data.mipmaps = true;
+    ++index;
+  }
+
+  const size_t num_hashes = parts.size() - index - 1;
+  if ((num_hashes != 1 && num_hashes != 2) ||
+      !ParseNameHash(parts[index], &data.texture_kind, &data.texture_hash) ||
+      (num_hashes == 2 && !ParseNameHash(parts[index + 1], &data.tlut_kind, &data.tlut_hash)) ||
+      !ParseNamePart(parts.back(), &data.format, 10))
+  {
+    return std::nullopt;
+  }
+
+  if (data.texture_kind == NameHashKind::Wildcard && data.tlut_kind == NameHashKind::Wildcard)
+    return std::nullopt;
+
+  // Only names which are formatted exactly like the ones of textures can match one
+  const std::string tlut_name =
+      data.tlut_kind == NameHashKind::None ? "" :
+                                             "_" + FormatNameHash(data.tlut_kind, data.tlut_hash);
+  const std::string canonical_name =
+      fmt::format("{}{}x{}{}_{}{}_{}", format_prefix, data.width, data.height,
+                  data.mipmaps ? "_m" : "", FormatNameHash(data.texture_kind, data.texture_hash),
+                  tlut_name, data.format);
+  if (canonical_name != name)
+    return std::nullopt;
+
+  return GetNameKey(data);
+}
+
 bool TextureInfo::IsDataValid() const
 {
   return m_data_valid;
@@ -34,6 +34,20 @@ public:
   };
   NameDetails CalculateTextureName() const;
 
+  // Keys that identify the name of the texture, and its names with a wildcard for the palette or
+  // the texture hash, without formatting them
+  struct NameKeys
+  {
+    u64 full;
+    u64 wildcard_tlut;
+    u64 wildcard_texture;
+  };
+  std::optional<NameKeys> CalculateTextureNameKeys() const;
+
+  // Returns the key that CalculateTextureNameKeys gives for the given name, or std::nullopt if it
+  // isn't the name of a texture
+  static std::optional<u64> GetTextureNameKey(std::string_view name);
+
   bool IsDataValid() const;
 
   const u8* GetData() const;
@@ -100,6 +114,13 @@ public:
   static constexpr std::string_view format_prefix{"tex1_"};
 
 private:
+  struct NameHashes
+  {
+    u64 texture_hash;
+    std::optional<u64> tlut_hash;
+  };
+  NameHashes CalculateNameHashes() const;
+
   const u8* m_ptr;
   const u8* m_tlut_ptr;
 
@@ -75,9 +75,11 @@ void WriteLightingFunction(ShaderCode& out)
 void WriteVertexLighting(ShaderCode& out, APIType api_type, std::string_view world_pos_var,
                          std::string_view normal_var, std::string_view in_color_0_var,
                          std::string_view in_color_1_var, std::string_view out_color_0_var,
-                         std::string_view out_color_1_var)
+                         std::string_view out_color_1_var, std::optional<u32> lit_channels)
 {
   out.Write("// Lighting\n");
+  if (lit_channels)
+    out.Write("const uint lit_channels = {}u;\n", *lit_channels);
   out.Write("for (uint chan = 0u; chan < {}u; chan++) {{\n", NUM_XF_COLOR_CHANNELS);
   out.Write("  uint colorreg = xfmem_color(chan);\n"
             "  uint alphareg = xfmem_alpha(chan);\n"
@@ -96,7 +98,10 @@ void WriteVertexLighting(ShaderCode& out, APIType api_type, std::string_view wor
             "    mat.w = " I_MATERIALS " [chan + 2u].w;\n"
             "\n");
 
-  out.Write("  if ({} != 0u) {{\n", BitfieldExtract<&LitChannel::enablelighting>("colorreg"));
+  if (!lit_channels)
+    out.Write("  if ({} != 0u) {{\n", BitfieldExtract<&LitChannel::enablelighting>("colorreg"));
+  else
+    out.Write("  if ((lit_channels & (1u << chan)) != 0u) {{\n");
   out.Write("    if ({} != 0u)\n", BitfieldExtract<&LitChannel::ambsource>("colorreg"));
   out.Write("      lacc.xyz = int3(round(((chan == 0u) ? {}.xyz : {}.xyz) * 255.0));\n",
             in_color_0_var, in_color_1_var);
@@ -117,7 +122,10 @@ void WriteVertexLighting(ShaderCode& out, APIType api_type, std::string_view wor
             "  }}\n"
             "\n");
 
-  out.Write("  if ({} != 0u) {{\n", BitfieldExtract<&LitChannel::enablelighting>("alphareg"));
+  if (!lit_channels)
+    out.Write("  if ({} != 0u) {{\n", BitfieldExtract<&LitChannel::enablelighting>("alphareg"));
+  else
+    out.Write("  if ((lit_channels & (4u << chan)) != 0u) {{\n");
   out.Write("    if ({} != 0u) {{\n", BitfieldExtract<&LitChannel::ambsource>("alphareg"));
   out.Write("      if ((components & ({}u << chan)) != 0u) // VB_HAS_COL0\n",
             Common::ToUnderlying(VB_HAS_COL0));
@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <optional>
 #include <string_view>
 
+#include "Common/CommonTypes.h"
+
 class ShaderCode;
 enum class APIType;
 union ShaderHostConfig;
@@ -12,9 +15,12 @@ union ShaderHostConfig;
 namespace UberShader
 {
 // Vertex lighting
+// If lit_channels is set, it replaces the enablelighting bits of the color (bits 0-1) and alpha
+// (bits 2-3) channels. As it is a constant, the light loops of unlit channels get compiled out.
 void WriteLightingFunction(ShaderCode& out);
 void WriteVertexLighting(ShaderCode& out, APIType api_type, std::string_view world_pos_var,
                          std::string_view normal_var, std::string_view in_color_0_var,
                          std::string_view in_color_1_var, std::string_view out_color_0_var,
-                         std::string_view out_color_1_var);
+                         std::string_view out_color_1_var,
+                         std::optional<u32> lit_channels = std::nullopt);
 }  // namespace UberShader
@@ -293,6 +293,19 @@ PixelShaderUid GetPixelShaderUid()
   return out;
 }
 
+void SpecializePixelShaderUid(PixelShaderUid* uid)
+{
+  pixel_ubershader_uid_data* const uid_data = uid->GetUidData();
+  uid_data->specialized = 1;
+  uid_data->num_stages = bpmem.genMode.numtevstages;
+  uid_data->lit_channels = 0;
+  for (u32 chan = 0; chan < NUM_XF_COLOR_CHANNELS; chan++)
+  {
+    uid_data->lit_channels |= (xfmem.color[chan].enablelighting ? 1u : 0u) << chan;
+    uid_data->lit_channels |= (xfmem.alpha[chan].enablelighting ? 4u : 0u) << chan;
+  }
+}
+
 void ClearUnusedPixelShaderUidBits(APIType api_type, const ShaderHostConfig& host_config,
                                    PixelShaderUid* uid)
 {
@@ -310,6 +323,10 @@ void ClearUnusedPixelShaderUidBits(APIType api_type, const ShaderHostConfig& hos
   // uint output when logic op is not supported (i.e. driver/device does not support D3D11.1).
   if (api_type != APIType::D3D || !host_config.backend_logic_op)
     uid_data->uint_output = 0;
+
+  // Lighting is only done in the pixel shader with per-pixel lighting.
+  if (!host_config.per_pixel_lighting)
+    uid_data->lit_channels = 0;
 }
 
 ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
@@ -326,6 +343,7 @@ ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
   const bool per_pixel_depth = uid_data->per_pixel_depth != 0;
   const bool bounding_box = host_config.bounding_box;
   const u32 numTexgen = uid_data->num_texgens;
+  const bool specialized = uid_data->specialized != 0;
   ShaderCode out;
 
   ASSERT_MSG(VIDEO, !(use_dual_source && use_framebuffer_fetch),
@@ -876,8 +894,16 @@ ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
   out.Write("void main()\n{{\n");
   out.Write("  float4 rawpos = gl_FragCoord;\n");
 
-  out.Write("  uint num_stages = {};\n\n",
-            BitfieldExtract<&GenMode::numtevstages>("bpmem_genmode"));
+  if (specialized)
+  {
+    // A constant lets the compiler unroll the TEV stage loop.
+    out.Write("  const uint num_stages = {}u;\n\n", uid_data->num_stages);
+  }
+  else
+  {
+    out.Write("  uint num_stages = {};\n\n",
+              BitfieldExtract<&GenMode::numtevstages>("bpmem_genmode"));
+  }
 
   bool has_custom_shader_details = false;
   if (std::any_of(custom_details.shaders.begin(), custom_details.shaders.end(),
@@ -933,7 +959,8 @@ ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
               "  float3 lit_normal = normalize(Normal.xyz);\n"
               "  float3 lit_pos = WorldPos.xyz;\n");
     WriteVertexLighting(out, api_type, "lit_pos", "lit_normal", "colors_0", "colors_1",
-                        "lit_colors_0", "lit_colors_1");
+                        "lit_colors_0", "lit_colors_1",
+                        specialized ? std::optional<u32>(uid_data->lit_channels) : std::nullopt);
     color_input_prefix = "lit_";
     out.Write("  // The number of colors available to TEV is determined by numColorChans.\n"
               "  // Normally this is performed in the vertex shader after lighting,\n"
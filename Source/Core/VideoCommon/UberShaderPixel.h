@@ -19,6 +19,11 @@ struct pixel_ubershader_uid_data
   u32 per_pixel_depth : 1;
   u32 uint_output : 1;
   u32 no_dual_src : 1;
+  // Variants generated on demand from the current state have the TEV stage count and, with
+  // per-pixel lighting, the enabled lighting channels baked in rather than read from uniforms.
+  u32 specialized : 1;
+  u32 num_stages : 4;
+  u32 lit_channels : 4;
 
   u32 NumValues() const { return sizeof(pixel_ubershader_uid_data); }
 };
@@ -27,6 +32,7 @@ struct pixel_ubershader_uid_data
 using PixelShaderUid = ShaderUid<pixel_ubershader_uid_data>;
 
 PixelShaderUid GetPixelShaderUid();
+void SpecializePixelShaderUid(PixelShaderUid* uid);
 
 ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
                           const pixel_ubershader_uid_data* uid_data,
@@ -45,8 +51,11 @@ struct fmt::formatter<UberShader::pixel_ubershader_uid_data>
   auto format(const UberShader::pixel_ubershader_uid_data& uid, FormatContext& ctx) const
   {
     return fmt::format_to(
-        ctx.out(), "Pixel UberShader for {} texgens{}{}{}{}", uid.num_texgens,
+        ctx.out(), "Pixel UberShader for {} texgens{}{}{}{}{}", uid.num_texgens,
         uid.early_depth ? ", early-depth" : "", uid.per_pixel_depth ? ", per-pixel depth" : "",
-        uid.uint_output ? ", uint output" : "", uid.no_dual_src ? ", no dual-source blending" : "");
+        uid.uint_output ? ", uint output" : "", uid.no_dual_src ? ", no dual-source blending" : "",
+        uid.specialized ? fmt::format(", {} stages, lit channels {:04b}", uid.num_stages + 1,
+                                      uid.lit_channels) :
+                          "");
   }
 };
@@ -24,6 +24,18 @@ VertexShaderUid GetVertexShaderUid()
   return out;
 }
 
+void SpecializeVertexShaderUid(VertexShaderUid* uid)
+{
+  vertex_ubershader_uid_data* const uid_data = uid->GetUidData();
+  uid_data->specialized = 1;
+  uid_data->lit_channels = 0;
+  for (u32 chan = 0; chan < NUM_XF_COLOR_CHANNELS; chan++)
+  {
+    uid_data->lit_channels |= (xfmem.color[chan].enablelighting ? 1u : 0u) << chan;
+    uid_data->lit_channels |= (xfmem.alpha[chan].enablelighting ? 4u : 0u) << chan;
+  }
+}
+
 static void GenVertexShaderTexGens(APIType api_type, const ShaderHostConfig& host_config,
                                    u32 num_texgen, ShaderCode& out);
 static void LoadVertexAttribute(ShaderCode& code, const ShaderHostConfig& host_config, u32 indent,
@@ -333,7 +345,9 @@ float3 load_input_float3_rawtex(uint vtx_offset, uint attr_offset) {{
             "}}\n");
 
   WriteVertexLighting(out, api_type, "pos.xyz", "_normal", "vertex_color_0", "vertex_color_1",
-                      "o.colors_0", "o.colors_1");
+                      "o.colors_0", "o.colors_1",
+                      uid_data->specialized ? std::optional<u32>(uid_data->lit_channels) :
+                                              std::nullopt);
 
   // Texture Coordinates
   if (num_texgen > 0)
@@ -12,6 +12,10 @@ namespace UberShader
 struct vertex_ubershader_uid_data
 {
   u32 num_texgens : 4;
+  // Variants generated on demand from the current state have the enabled lighting channels baked
+  // in rather than read from uniforms.
+  u32 specialized : 1;
+  u32 lit_channels : 4;
 
   u32 NumValues() const { return sizeof(vertex_ubershader_uid_data); }
 };
@@ -20,6 +24,7 @@ struct vertex_ubershader_uid_data
 using VertexShaderUid = ShaderUid<vertex_ubershader_uid_data>;
 
 VertexShaderUid GetVertexShaderUid();
+void SpecializeVertexShaderUid(VertexShaderUid* uid);
 
 ShaderCode GenVertexShader(APIType api_type, const ShaderHostConfig& host_config,
                            const vertex_ubershader_uid_data* uid_data);
@@ -33,6 +38,8 @@ struct fmt::formatter<UberShader::vertex_ubershader_uid_data>
   template <typename FormatContext>
   auto format(const UberShader::vertex_ubershader_uid_data& uid, FormatContext& ctx) const
   {
-    return fmt::format_to(ctx.out(), "Vertex UberShader for {} texgens", uid.num_texgens);
+    return fmt::format_to(
+        ctx.out(), "Vertex UberShader for {} texgens{}", uid.num_texgens,
+        uid.specialized ? fmt::format(", lit channels {:04b}", uid.lit_channels) : "");
   }
 };
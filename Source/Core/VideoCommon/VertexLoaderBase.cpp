@@ -20,6 +20,7 @@
 
 #include "VideoCommon/VertexLoader.h"
 #include "VideoCommon/VertexLoaderManager.h"
+#include "VideoCommon/VertexLoaderSpecialized.h"
 #include "VideoCommon/VertexLoader_Color.h"
 #include "VideoCommon/VertexLoader_Normal.h"
 #include "VideoCommon/VertexLoader_Position.h"
@@ -164,6 +165,23 @@ private:
   std::vector<u8> buffer_b;
 };
 
+bool VertexLoaderBase::HasIndexedAttributes() const
+{
+  if (IsIndexed(m_VtxDesc.low.Position) || IsIndexed(m_VtxDesc.low.Normal))
+    return true;
+  for (const VertexComponentFormat color : m_VtxDesc.low.Color)
+  {
+    if (IsIndexed(color))
+      return true;
+  }
+  for (const VertexComponentFormat tex_coord : m_VtxDesc.high.TexCoord)
+  {
+    if (IsIndexed(tex_coord))
+      return true;
+  }
+  return false;
+}
+
 u32 VertexLoaderBase::GetVertexSize(const TVtxDesc& vtx_desc, const VAT& vtx_attr)
 {
   u32 size = 0;
@@ -241,6 +259,9 @@ std::unique_ptr<VertexLoaderBase> VertexLoaderBase::CreateVertexLoader(const TVt
   // (not currently applicable, as both VertexLoaderX64 and VertexLoaderARM64
   // are always usable, but if a loader that only works on some CPUs is created
   // then this fallback would be used)
+  // The specialised software loaders cover common formats, and the generic one all others.
+  if (!loader)
+    loader = VertexLoaderSpecialized::Create(vtx_desc, vtx_attr);
   if (!loader)
     loader = std::make_unique<VertexLoader>(vtx_desc, vtx_attr);
 
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -61,6 +62,12 @@ public:
                                                               const VAT& vtx_attr);
   virtual ~VertexLoaderBase() {}
   virtual int RunVertices(const u8* src, u8* dst, int count) = 0;
+  // Whether RunVertices can be called for disjoint ranges of a batch from several threads at once.
+  // The zfreeze and tangent/binormal caches are still written by every call.
+  virtual bool CanRunInParallel() const { return false; }
+  // Whether any attribute is read from an array in memory rather than from the vertex itself, in
+  // which case the result depends on more than the vertex data.
+  bool HasIndexedAttributes() const;
 
   // per loader public state
   PortableVertexDeclaration m_native_vtx_decl{};
@@ -69,7 +76,7 @@ public:
 
   // used by VertexLoaderManager
   NativeVertexFormat* m_native_vertex_format = nullptr;
-  int m_numLoadedVertices = 0;
+  std::atomic<int> m_numLoadedVertices = 0;
 
 protected:
   VertexLoaderBase(const TVtxDesc& vtx_desc, const VAT& vtx_attr)
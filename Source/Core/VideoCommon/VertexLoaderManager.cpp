@@ -4,15 +4,20 @@
 #include "VideoCommon/VertexLoaderManager.h"
 
 #include <algorithm>
+#include <cstring>
+#include <future>
 #include <iterator>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include <xxhash.h>
+
 #include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
 #include "Common/Logging/Log.h"
@@ -27,6 +32,7 @@
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/NativeVertexFormat.h"
+#include "VideoCommon/PerformanceMetrics.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexManagerBase.h"
@@ -69,8 +75,34 @@ void Init()
   SETSTAT(g_stats.num_vertex_loaders, 0);
 }
 
+// Converted vertices of recently loaded batches, keyed by the address of their source data.
+struct CachedVertices
+{
+  VertexLoaderBase* loader = nullptr;
+  int count = 0;
+  u64 hash = 0;
+  int loaded_count = 0;
+  std::vector<u8> data;
+
+  // The zfreeze and tangent/binormal caches as they were after loading the batch.
+  std::array<std::array<float, 4>, 3> position_cache;
+  std::array<u32, 3> position_matrix_index_cache;
+  std::array<float, 4> tangent_cache;
+  std::array<float, 4> binormal_cache;
+};
+static std::unordered_map<const u8*, CachedVertices> s_vertex_cache;
+static size_t s_vertex_cache_size = 0;
+
+static void ClearVertexCache()
+{
+  s_vertex_cache.clear();
+  s_vertex_cache_size = 0;
+}
+
 void Clear()
 {
+  ClearVertexCache();
+
   std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
   s_vertex_loader_map.clear();
   s_native_vertex_map.clear();
@@ -375,6 +407,116 @@ static void CheckCPConfiguration(int vtx_attr_group)
   }
 }
 
+// Batches smaller than this are not worth the cost of handing work to other threads.
+static constexpr int MIN_VERTICES_PER_THREAD = 8192;
+static constexpr int MAX_VERTEX_LOADER_THREADS = 8;
+
+static int LoadVertices(VertexLoaderBase* loader, const u8* src, u8* dst, int count)
+{
+  const int num_threads =
+      std::min({count / MIN_VERTICES_PER_THREAD, MAX_VERTEX_LOADER_THREADS,
+                static_cast<int>(std::max(std::thread::hardware_concurrency(), 1u))});
+  if (num_threads < 2 || !loader->CanRunInParallel())
+    return loader->RunVertices(src, dst, count);
+
+  // Every range is written to the part of the buffer it would have been written to if no vertex
+  // was skipped, and the gaps left by skipped vertices are closed afterwards. The last range runs
+  // on this thread.
+  const int vertices_per_thread = count / num_threads;
+  const u32 src_stride = loader->m_vertex_size;
+  const u32 dst_stride = loader->m_native_vtx_decl.stride;
+  std::vector<std::future<int>> workers;
+  workers.reserve(num_threads - 1);
+  for (int i = 0; i < num_threads - 1; ++i)
+  {
+    const int first = i * vertices_per_thread;
+    workers.push_back(std::async(std::launch::async, [=] {
+      return loader->RunVertices(src + first * src_stride, dst + first * dst_stride,
+                                 vertices_per_thread);
+    }));
+  }
+
+  const int last_first = (num_threads - 1) * vertices_per_thread;
+  const int last_loaded = loader->RunVertices(src + last_first * src_stride,
+                                              dst + last_first * dst_stride, count - last_first);
+
+  int loaded = 0;
+  for (int i = 0; i < num_threads; ++i)
+  {
+    const int first = i * vertices_per_thread;
+    const int range_loaded = i < num_threads - 1 ? workers[i].get() : last_loaded;
+    if (loaded != first)
+      memmove(dst + loaded * dst_stride, dst + first * dst_stride, range_loaded * dst_stride);
+    loaded += range_loaded;
+  }
+
+  // The other threads may have overwritten the zfreeze and tangent/binormal caches after the last
+  // range set them, so load the last vertices once more to restore them. The caches only depend on
+  // the final three vertices.
+  static std::vector<u8> s_cache_scratch;
+  const int num_tail_vertices = std::min(count, 3);
+  s_cache_scratch.resize(num_tail_vertices * dst_stride);
+  loader->RunVertices(src + (count - num_tail_vertices) * src_stride, s_cache_scratch.data(),
+                      num_tail_vertices);
+
+  return loaded;
+}
+
+// Vertices are loaded here before they are culled when the vertex buffer is in GPU memory.
+static std::vector<u8> s_cull_vertex_buffer;
+
+// Hashing and copying the data costs more than loading very small batches, and very large ones
+// are rarely drawn more than once.
+static constexpr int MIN_CACHED_VERTICES = 64;
+static constexpr int MAX_CACHED_VERTICES = 65536;
+static constexpr size_t MAX_VERTEX_CACHE_SIZE = 64 * 1024 * 1024;
+
+static int LoadVerticesCached(VertexLoaderBase* loader, const u8* src, u8* dst, int count)
+{
+  // Indexed attributes would make the result depend on array memory, which isn't hashed.
+  if (!g_ActiveConfig.bCacheLoadedVertices || count < MIN_CACHED_VERTICES ||
+      count > MAX_CACHED_VERTICES || loader->HasIndexedAttributes())
+  {
+    return LoadVertices(loader, src, dst, count);
+  }
+
+  const u32 dst_stride = loader->m_native_vtx_decl.stride;
+  const u64 hash = XXH3_64bits(src, static_cast<size_t>(count) * loader->m_vertex_size);
+  const auto it = s_vertex_cache.find(src);
+  if (it != s_vertex_cache.end() && it->second.loader == loader && it->second.count == count &&
+      it->second.hash == hash)
+  {
+    const CachedVertices& cached = it->second;
+    std::memcpy(dst, cached.data.data(), cached.data.size());
+    position_cache = cached.position_cache;
+    position_matrix_index_cache = cached.position_matrix_index_cache;
+    tangent_cache = cached.tangent_cache;
+    binormal_cache = cached.binormal_cache;
+    INCSTAT(g_stats.this_frame.num_vertex_cache_hits);
+    return cached.loaded_count;
+  }
+
+  INCSTAT(g_stats.this_frame.num_vertex_cache_misses);
+  const int loaded_count = LoadVertices(loader, src, dst, count);
+
+  const size_t size = static_cast<size_t>(loaded_count) * dst_stride;
+  if (it == s_vertex_cache.end() && s_vertex_cache_size + size > MAX_VERTEX_CACHE_SIZE)
+    ClearVertexCache();
+
+  CachedVertices& cached = it != s_vertex_cache.end() ? it->second : s_vertex_cache[src];
+  s_vertex_cache_size += size - cached.data.size();
+  cached.loader = loader;
+  cached.count = count;
+  cached.hash = hash;
+  cached.loaded_count = loaded_count;
+  cached.data.assign(dst, dst + size);
+  cached.position_cache = position_cache;
+  cached.position_matrix_index_cache = position_matrix_index_cache;
+  cached.tangent_cache = tangent_cache;
+  cached.binormal_cache = binormal_cache;
+  return loaded_count;
+}
+
 template <bool IsPreprocess>
 int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count, const u8* src)
 {
@@ -382,6 +524,8 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
     return 0;
   ASSERT(count > 0);
 
+  PerformanceMetrics::ScopedFrameSection frame_section(
+      PerformanceMetrics::FrameSection::VertexLoad);
   VertexLoaderBase* loader = RefreshLoader<IsPreprocess>(vtx_attr_group);
 
   int size = count * loader->m_vertex_size;
@@ -423,13 +567,38 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
     const bool cullall = (bpmem.genMode.cullmode == CullMode::All &&
                           primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES);
 
+    // Culling individual triangles only trims the index buffer, so it's useful for every draw.
+    const bool cull_primitives = g_ActiveConfig.bCPUCull && g_ActiveConfig.bCPUCullPrimitives &&
+                                 primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES && !cullall;
+
     const int stride = loader->m_native_vtx_decl.stride;
     DataReader dst = g_vertex_manager->PrepareForAdditionalData(primitive, count, stride,
                                                                 cullall || can_cpu_cull);
 
-    count = loader->RunVertices(src, dst.GetPointer(), count);
+    // Reading the vertices back from a buffer in GPU memory is slow, so when they are going to be
+    // culled, load them into CPU memory first.
+    u8* load_dst = dst.GetPointer();
+    if (cull_primitives && !can_cpu_cull)
+    {
+      s_cull_vertex_buffer.resize(static_cast<size_t>(count) * stride);
+      load_dst = s_cull_vertex_buffer.data();
+    }
+
+    count = LoadVerticesCached(loader, src, load_dst, count);
 
-    if (can_cpu_cull && !cullall)
+    bool indices_added = false;
+    if (cull_primitives)
+    {
+      const u32 num_triangles =
+          g_vertex_manager->CullPrimitives(loader, primitive, load_dst, count);
+      if (can_cpu_cull && num_triangles != 0)
+        dst = g_vertex_manager->DisableCullAll(stride);
+      if (load_dst != dst.GetPointer())
+        memmove(dst.GetPointer(), load_dst, count * stride);
+      if (!can_cpu_cull || num_triangles != 0)
+        indices_added = g_vertex_manager->AddCulledIndices(num_triangles, count);
+    }
+    else if (can_cpu_cull && !cullall)
     {
       if (!g_vertex_manager->AreAllVerticesCulled(loader, primitive, dst.GetPointer(), count))
       {
@@ -438,7 +607,8 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
       }
     }
 
-    g_vertex_manager->AddIndices(primitive, count);
+    if (!indices_added)
+      g_vertex_manager->AddIndices(primitive, count);
     g_vertex_manager->FlushData(count, loader->m_native_vtx_decl.stride);
 
     ADDSTAT(g_stats.this_frame.num_prims, count);
@@ -0,0 +1,373 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/VertexLoaderSpecialized.h"
+
+#include <array>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+#include "Common/CommonTypes.h"
+#include "Common/Inline.h"
+
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/VertexLoaderManager.h"
+#include "VideoCommon/VertexLoaderUtils.h"
+
+namespace
+{
+using VCF = VertexComponentFormat;
+using FMT = ComponentFormat;
+using TCC = TexComponentCount;
+
+// The attributes a specialised function reads. Normals are only supported without tangents and
+// binormals, and colors only in the RGBA8888 format. Formats of absent attributes are left at
+// their defaults, so that they don't have to match.
+struct Layout
+{
+  bool pos_mtx = false;
+  VCF position = VCF::Direct;
+  FMT position_format = FMT::UByte;
+  VCF normal = VCF::NotPresent;
+  FMT normal_format = FMT::UByte;
+  VCF color0 = VCF::NotPresent;
+  VCF tex_coord0 = VCF::NotPresent;
+  FMT tex_coord0_format = FMT::UByte;
+  TCC tex_coord0_elements = TCC::S;
+
+  constexpr bool operator==(const Layout&) const = default;
+};
+
+template <FMT Format>
+using ComponentType = std::conditional_t<
+    Format == FMT::UByte, u8,
+    std::conditional_t<
+        Format == FMT::Byte, s8,
+        std::conditional_t<Format == FMT::UShort, u16,
+                           std::conditional_t<Format == FMT::Short, s16, float>>>>;
+
+template <typename T>
+DOLPHIN_FORCE_INLINE float Dequantize(T value, float scale)
+{
+  if constexpr (std::is_same_v<T, float>)
+    return value;
+  else
+    return value * scale;
+}
+
+// Same as the adjustment of the generic normal loader
+template <typename T>
+DOLPHIN_FORCE_INLINE float NormalFracAdjust(T value)
+{
+  if constexpr (std::is_same_v<T, float>)
+    return value;
+  else
+    return value / float(1u << (sizeof(T) * 8 - std::is_signed_v<T> - 1));
+}
+
+// Returns the data of an attribute, which is either part of the vertex or read from its array.
+template <VCF Format, u32 DirectSize>
+DOLPHIN_FORCE_INLINE const u8* GetAttributeData(const u8*& src, CPArray array,
+                                                bool* skip_vertex = nullptr)
+{
+  if constexpr (Format == VCF::Direct)
+  {
+    const u8* data = src;
+    src += DirectSize;
+    return data;
+  }
+  else
+  {
+    using I = std::conditional_t<Format == VCF::Index8, u8, u16>;
+    const I index = DataRead<I>(&src);
+    if (skip_vertex)
+      *skip_vertex = index == std::numeric_limits<I>::max();
+    return VertexLoaderManager::cached_arraybases[array] +
+           index * g_main_cp_state.array_strides[array];
+  }
+}
+
+template <typename T>
+DOLPHIN_FORCE_INLINE void Write(u8*& dst, T value)
+{
+  std::memcpy(dst, &value, sizeof(T));
+  dst += sizeof(T);
+}
+
+template <Layout L>
+int RunSpecialized(const VertexLoaderSpecialized* loader, const u8* src, u8* dst, int count)
+{
+  using PositionType = ComponentType<L.position_format>;
+  using NormalType = ComponentType<L.normal_format>;
+  using TexCoordType = ComponentType<L.tex_coord0_format>;
+  constexpr u32 tex_coord_elements = L.tex_coord0_elements == TCC::ST ? 2 : 1;
+
+  const float pos_scale = loader->m_posScale;
+  const float tc_scale = loader->m_tcScale[0];
+  const u32 stride = loader->m_native_vtx_decl.stride;
+  int skipped_vertices = 0;
+
+  for (int remaining = count - 1; remaining >= 0; remaining--)
+  {
+    if constexpr (L.pos_mtx)
+    {
+      const u32 pos_mtx = DataRead<u8>(&src) & 0x3f;
+      if (remaining < 3)
+        VertexLoaderManager::position_matrix_index_cache[remaining] = pos_mtx;
+      Write(dst, pos_mtx);
+    }
+
+    bool skip_vertex = false;
+    const u8* position = GetAttributeData<L.position, 3 * sizeof(PositionType)>(
+        src, CPArray::Position, &skip_vertex);
+    for (int i = 0; i < 3; i++)
+    {
+      const float value =
+          Dequantize(DataPeek<PositionType>(i * sizeof(PositionType), position), pos_scale);
+      if (remaining < 3 && !skip_vertex)
+        VertexLoaderManager::position_cache[remaining][i] = value;
+      Write(dst, value);
+    }
+
+    if constexpr (L.normal != VCF::NotPresent)
+    {
+      const u8* normal = GetAttributeData<L.normal, 3 * sizeof(NormalType)>(src, CPArray::Normal);
+      for (int i = 0; i < 3; i++)
+        Write(dst, NormalFracAdjust(DataPeek<NormalType>(i * sizeof(NormalType), normal)));
+    }
+
+    if constexpr (L.color0 != VCF::NotPresent)
+    {
+      // The colors are written in the byte order they have in memory
+      const u8* color = GetAttributeData<L.color0, sizeof(u32)>(src, CPArray::Color0);
+      std::memcpy(dst, color, sizeof(u32));
+      dst += sizeof(u32);
+    }
+
+    if constexpr (L.tex_coord0 != VCF::NotPresent)
+    {
+      const u8* tex_coord =
+          GetAttributeData<L.tex_coord0, tex_coord_elements * sizeof(TexCoordType)>(
+              src, CPArray::TexCoord0);
+      for (u32 i = 0; i < tex_coord_elements; i++)
+      {
+        Write(dst,
+              Dequantize(DataPeek<TexCoordType>(i * sizeof(TexCoordType), tex_coord), tc_scale));
+      }
+    }
+
+    if constexpr (IsIndexed(L.position))
+    {
+      if (skip_vertex)
+      {
+        dst -= stride;
+        skipped_vertices++;
+      }
+    }
+  }
+
+  return count - skipped_vertices;
+}
+
+struct Specialization
+{
+  Layout layout;
+  VertexLoaderSpecialized::RunFunction function;
+};
+
+template <Layout L>
+constexpr Specialization Specialize()
+{
+  return {L, RunSpecialized<L>};
+}
+
+// Indexed models with and without skinning, followed by directly specified geometry as it is used
+// for 2D elements. Formats which aren't listed use the generic loader.
+constexpr std::array s_specializations = {
+    Specialize<Layout{.position = VCF::Index16,
+                      .position_format = FMT::Float,
+                      .normal = VCF::Index16,
+                      .normal_format = FMT::Float,
+                      .tex_coord0 = VCF::Index16,
+                      .tex_coord0_format = FMT::Float,
+                      .tex_coord0_elements = TCC::ST}>(),
+    Specialize<Layout{.position = VCF::Index16,
+                      .position_format = FMT::Float,
+                      .normal = VCF::Index16,
+                      .normal_format = FMT::Short,
+                      .tex_coord0 = VCF::Index16,
+                      .tex_coord0_format = FMT::UShort,
+                      .tex_coord0_elements = TCC::ST}>(),
+    Specialize<Layout{.position = VCF::Index16,
+                      .position_format = FMT::Short,
+                      .normal = VCF::Index16,
+                      .normal_format = FMT::Byte,
+                      .tex_coord0 = VCF::Index16,
+                      .tex_coord0_format = FMT::Short,
+                      .tex_coord0_elements = TCC::ST}>(),
+    Specialize<Layout{.position = VCF::Index16,
+                      .position_format = FMT::Short,
+                      .normal = VCF::Index16,
+                      .normal_format = FMT::Short,
+                      .tex_coord0 = VCF::Index16,
+                      .tex_coord0_format = FMT::Short,
+                      .tex_coord0_elements = TCC::ST}>(),
+    Specialize<Layout{.position = VCF::Index16,
+                      .position_format = FMT::Float,
+                      .normal = VCF::Index16,
+                      .normal_format = FMT::Float,
+                      .color0 = VCF::Index16,
+                      .tex_coord0 = VCF::Index16,
+                      .tex_coord0_format = FMT::Float,
+                      .tex_coord0_elements = TCC::ST}>(),
+    Specialize<Layout{.position = VCF::Index16,
+                      .position_format = FMT::Short,
+                      .normal = VCF::Index16,
+                      .normal_format = FMT::Byte,
+                      .color0 = VCF::Index16,
+                      .tex_coord0 = VCF::Index16,
+                      .tex_coord0_format = FMT::Short,
+                      .tex_coord0_elements = TCC::ST}>(),
+    Specialize<Layout{.position = VCF::Index16,
+                      .position_format = FMT::Float,
+                      .tex_coord0 = VCF::Index16,
+                      .tex_coord0_format = FMT::Float,
+                      .tex_coord0_elements = TCC::ST}>(),
+    Specialize<Layout{.position = VCF::Index16,
+                      .position_format = FMT::Short,
+                      .tex_coord0 = VCF::Index16,
+                      .tex_coord0_format = FMT::Short,
+                      .tex_coord0_elements = TCC::ST}>(),
+    Specialize<Layout{.position = VCF::Index16,
+                      .position_format = FMT::Float,
+                      .color0 = VCF::Index16,
+                      .tex_coord0 = VCF::Index16,
+                      .tex_coord0_format = FMT::Float,
+                      .tex_coord0_elements = TCC::ST}>(),
+    Specialize<Layout{.position = VCF::Index16,
+                      .position_format = FMT::Short,
+                      .color0 = VCF::Index16,
+                      .tex_coord0 = VCF::Index16,
+                      .tex_coord0_format = FMT::Short,
+                      .tex_coord0_elements = TCC::ST}>(),
+    Specialize<Layout{.pos_mtx = true,
+                      .position = VCF::Index16,
+                      .position_format = FMT::Float,
+                      .normal = VCF::Index16,
+                      .normal_format = FMT::Float,
+                      .tex_coord0 = VCF::Index16,
+                      .tex_coord0_format = FMT::Float,
+                      .tex_coord0_elements = TCC::ST}>(),
+    Specialize<Layout{.pos_mtx = true,
+                      .position = VCF::Index16,
+                      .position_format = FMT::Short,
+                      .normal = VCF::Index16,
+                      .normal_format = FMT::Byte,
+                      .tex_coord0 = VCF::Index16,
+                      .tex_coord0_format = FMT::Short,
+                      .tex_coord0_elements = TCC::ST}>(),
+    Specialize<Layout{.pos_mtx = true,
+                      .position = VCF::Index16,
+                      .position_format = FMT::Short,
+                      .normal = VCF::Index16,
+                      .normal_format = FMT::Short,
+                      .tex_coord0 = VCF::Index16,
+                      .tex_coord0_format = FMT::Short,
+                      .tex_coord0_elements = TCC::ST}>(),
+    Specialize<Layout{.position = VCF::Direct,
+                      .position_format = FMT::Float,
+                      .color0 = VCF::Direct,
+                      .tex_coord0 = VCF::Direct,
+                      .tex_coord0_format = FMT::Float,
+                      .tex_coord0_elements = TCC::ST}>(),
+    Specialize<Layout{.position = VCF::Direct,
+                      .position_format = FMT::Float,
+                      .tex_coord0 = VCF::Direct,
+                      .tex_coord0_format = FMT::Float,
+                      .tex_coord0_elements = TCC::ST}>(),
+    Specialize<Layout{.position = VCF::Direct,
+                      .position_format = FMT::Float,
+                      .color0 = VCF::Direct}>(),
+    Specialize<Layout{.position = VCF::Direct,
+                      .position_format = FMT::Short,
+                      .color0 = VCF::Direct,
+                      .tex_coord0 = VCF::Direct,
+                      .tex_coord0_format = FMT::Short,
+                      .tex_coord0_elements = TCC::ST}>(),
+};
+}  // namespace
+
+std::unique_ptr<VertexLoaderBase> VertexLoaderSpecialized::Create(const TVtxDesc& vtx_desc,
+                                                                  const VAT& vtx_attr)
+{
+  const RunFunction function = GetFunction(vtx_desc, vtx_attr);
+  if (!function)
+    return nullptr;
+  return std::make_unique<VertexLoaderSpecialized>(vtx_desc, vtx_attr, function);
+}
+
+VertexLoaderSpecialized::VertexLoaderSpecialized(const TVtxDesc& vtx_desc, const VAT& vtx_attr,
+                                                 RunFunction function)
+    : VertexLoader(vtx_desc, vtx_attr), m_function(function)
+{
+}
+
+int VertexLoaderSpecialized::RunVertices(const u8* src, u8* dst, int count)
+{
+  m_numLoadedVertices += count;
+  return m_function(this, src, dst, count);
+}
+
+VertexLoaderSpecialized::RunFunction VertexLoaderSpecialized::GetFunction(const TVtxDesc& vtx_desc,
+                                                                          const VAT& vtx_attr)
+{
+  // Texture matrix indices, the second color and further texture coordinates are never used by
+  // the specialised functions.
+  for (size_t i = 0; i < vtx_desc.low.TexMatIdx.Size(); i++)
+  {
+    if (vtx_desc.low.TexMatIdx[i])
+      return nullptr;
+  }
+  for (size_t i = 1; i < vtx_desc.high.TexCoord.Size(); i++)
+  {
+    if (vtx_desc.high.TexCoord[i] != VCF::NotPresent)
+      return nullptr;
+  }
+  if (vtx_desc.low.Color1 != VCF::NotPresent)
+    return nullptr;
+  if (vtx_attr.g0.PosElements != CoordComponentCount::XYZ)
+    return nullptr;
+
+  Layout layout;
+  layout.pos_mtx = vtx_desc.low.PosMatIdx;
+  layout.position = vtx_desc.low.Position;
+  layout.position_format = vtx_attr.g0.PosFormat;
+  if (vtx_desc.low.Normal != VCF::NotPresent)
+  {
+    if (vtx_attr.g0.NormalElements != NormalComponentCount::N)
+      return nullptr;
+    layout.normal = vtx_desc.low.Normal;
+    layout.normal_format = vtx_attr.g0.NormalFormat;
+  }
+  if (vtx_desc.low.Color0 != VCF::NotPresent)
+  {
+    if (vtx_attr.g0.Color0Comp != ColorFormat::RGBA8888)
+      return nullptr;
+    layout.color0 = vtx_desc.low.Color0;
+  }
+  if (vtx_desc.high.Tex0Coord != VCF::NotPresent)
+  {
+    layout.tex_coord0 = vtx_desc.high.Tex0Coord;
+    layout.tex_coord0_format = vtx_attr.g0.Tex0CoordFormat;
+    layout.tex_coord0_elements = vtx_attr.g0.Tex0CoordElements;
+  }
+
+  for (const Specialization& specialization : s_specializations)
+  {
+    if (specialization.layout == layout)
+      return specialization.function;
+  }
+  return nullptr;
+}
@@ -0,0 +1,33 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/VertexLoader.h"
+
+// A software loader for some common vertex formats, where all attributes of a vertex are read by
+// one function generated from a template instead of a pipeline of function calls. This is what
+// platforms without a JIT loader use whenever the format is one of the specialised ones.
+class VertexLoaderSpecialized final : public VertexLoader
+{
+public:
+  using RunFunction = int (*)(const VertexLoaderSpecialized* loader, const u8* src, u8* dst,
+                              int count);
+
+  // Returns nullptr if there is no specialised function for the format.
+  static std::unique_ptr<VertexLoaderBase> Create(const TVtxDesc& vtx_desc, const VAT& vtx_attr);
+
+  VertexLoaderSpecialized(const TVtxDesc& vtx_desc, const VAT& vtx_attr, RunFunction function);
+
+  int RunVertices(const u8* src, u8* dst, int count) override;
+  // Unlike the generic loader, the specialised functions only keep their state on the stack.
+  bool CanRunInParallel() const override { return true; }
+
+  static RunFunction GetFunction(const TVtxDesc& vtx_desc, const VAT& vtx_attr);
+
+private:
+  RunFunction m_function;
+};
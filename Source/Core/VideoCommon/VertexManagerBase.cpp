@@ -3,10 +3,13 @@
 
 #include "VideoCommon/VertexManagerBase.h"
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <memory>
 
+#include <xxhash.h>
+
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
@@ -31,8 +34,10 @@
 #include "VideoCommon/NativeVertexFormat.h"
 #include "VideoCommon/OpcodeDecoding.h"
 #include "VideoCommon/PerfQueryBase.h"
+#include "VideoCommon/PerformanceMetrics.h"
 #include "VideoCommon/PixelShaderGen.h"
 #include "VideoCommon/PixelShaderManager.h"
+#include "VideoCommon/Present.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/TextureInfo.h"
@@ -145,6 +150,24 @@ bool VertexManagerBase::AreAllVerticesCulled(VertexLoaderBase* loader,
   return m_cpu_cull.AreAllVerticesCulled(loader, primitive, src, count);
 }
 
+u32 VertexManagerBase::CullPrimitives(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
+                                      const u8* src, u32 count)
+{
+  // No primitive has more triangles than vertices.
+  m_culled_indices.resize(count * 3);
+  return m_cpu_cull.CullPrimitives(loader, primitive, src, count, m_culled_indices.data());
+}
+
+bool VertexManagerBase::AddCulledIndices(u32 num_triangles, u32 num_vertices)
+{
+  const u32 num_indices = num_triangles * m_index_generator.GetIndicesPerTriangle();
+  if (num_indices > MAXIBUFFERSIZE - m_index_generator.GetIndexLen())
+    return false;
+
+  m_index_generator.AddTriangles(m_culled_indices.data(), num_triangles, num_vertices);
+  return true;
+}
+
 DataReader VertexManagerBase::PrepareForAdditionalData(OpcodeDecoder::Primitive primitive,
                                                        u32 count, u32 stride, bool cullall)
 {
@@ -347,13 +370,15 @@ void VertexManagerBase::CommitBuffer(u32 num_vertices, u32 vertex_stride, u32 nu
 void VertexManagerBase::DrawCurrentBatch(u32 base_index, u32 num_indices, u32 base_vertex)
 {
   // If bounding box is enabled, we need to flush any changes first, then invalidate what we have.
-  if (g_bounding_box->IsEnabled() && g_ActiveConfig.bBBoxEnable &&
-      g_ActiveConfig.backend_info.bSupportsBBox)
-  {
+  const bool bounding_box = g_bounding_box->IsEnabled() && g_ActiveConfig.bBBoxEnable &&
+                            g_ActiveConfig.backend_info.bSupportsBBox;
+  if (bounding_box)
     g_bounding_box->Flush();
-  }
 
   g_gfx->DrawIndexed(base_index, num_indices, base_vertex);
+
+  if (bounding_box)
+    g_bounding_box->AfterDraw();
 }
 
 void VertexManagerBase::UploadUniforms()
@@ -369,6 +394,11 @@ void VertexManagerBase::InvalidateConstants()
   vertex_shader_manager.dirty = true;
   geometry_shader_manager.dirty = true;
   pixel_shader_manager.dirty = true;
+
+  // Backends only rebind the blocks that are dirty, so the custom block has to be uploaded again
+  // as well if something else was bound in its place.
+  if (!pixel_shader_manager.custom_constants.empty())
+    pixel_shader_manager.custom_constants_dirty = true;
 }
 
 void VertexManagerBase::UploadUtilityUniforms(const void* uniforms, u32 uniforms_size)
@@ -438,6 +468,8 @@ void VertexManagerBase::Flush()
     return;
 
   m_is_flushed = true;
+  PerformanceMetrics::ScopedFrameSection frame_section(
+      PerformanceMetrics::FrameSection::BackendSubmit);
 
   if (m_draw_counter == 0)
   {
@@ -566,7 +598,8 @@ void VertexManagerBase::Flush()
   std::array<SamplerState, 8> samplers;
   if (!m_cull_all)
   {
-    if (!g_ActiveConfig.bGraphicMods)
+    // The texture names are only needed if a mod could match them.
+    if (!g_ActiveConfig.bGraphicMods || !g_graphics_mod_manager->HasDrawTextureActions())
     {
       for (const u32 i : used_textures)
       {
@@ -648,6 +681,13 @@ void VertexManagerBase::Flush()
     if (PerfQueryBase::ShouldEmulate())
       g_perf_query->EnableQuery(bpmem.zcontrol.early_ztest ? PQG_ZCOMP_ZCOMPLOC : PQG_ZCOMP);
 
+    // Draws of skipped frames are dropped unless bounding box or perf queries observe them.
+    if (g_presenter->IsSkippingRendering() && !PerfQueryBase::ShouldEmulate() &&
+        !(g_bounding_box->IsEnabled() && g_ActiveConfig.bBBoxEnable))
+    {
+      skip = true;
+    }
+
     if (!skip)
     {
       UpdatePipelineConfig();
@@ -882,20 +922,31 @@ void VertexManagerBase::UpdatePipelineObject()
   m_current_pipeline_object = nullptr;
   m_pipeline_config_changed = false;
 
+  // Ubershaders are never cached here, as we want to switch to the specialized pipeline as soon as
+  // it has been compiled.
+  const u64 hash = XXH3_64bits(&m_current_pipeline_config, sizeof(m_current_pipeline_config));
+  if (g_ActiveConfig.iShaderCompilationMode != ShaderCompilationMode::SynchronousUberShaders)
+  {
+    m_current_pipeline_object = FindRecentPipeline(hash);
+    if (m_current_pipeline_object)
+      return;
+  }
+
   switch (g_ActiveConfig.iShaderCompilationMode)
   {
   case ShaderCompilationMode::Synchronous:
   {
     // Ubershaders disabled? Block and compile the specialized shader.
     m_current_pipeline_object = g_shader_cache->GetPipelineForUid(m_current_pipeline_config);
+    if (m_current_pipeline_object)
+      AddRecentPipeline(hash, m_current_pipeline_object);
   }
   break;
 
   case ShaderCompilationMode::SynchronousUberShaders:
   {
     // Exclusive ubershader mode, always use ubershaders.
-    m_current_pipeline_object =
-        g_shader_cache->GetUberPipelineForUid(m_current_uber_pipeline_config);
+    m_current_pipeline_object = GetUberPipelineObject();
   }
   break;
 
@@ -908,14 +959,15 @@ void VertexManagerBase::UpdatePipelineObject()
     {
       // Specialized shaders are ready, prefer these.
       m_current_pipeline_object = *res;
+      if (m_current_pipeline_object)
+        AddRecentPipeline(hash, m_current_pipeline_object);
       return;
     }
 
     if (g_ActiveConfig.iShaderCompilationMode == ShaderCompilationMode::AsynchronousUberShaders)
     {
       // Specialized shaders not ready, use the ubershaders.
-      m_current_pipeline_object =
-          g_shader_cache->GetUberPipelineForUid(m_current_uber_pipeline_config);
+      m_current_pipeline_object = GetUberPipelineObject();
     }
     else
     {
@@ -928,6 +980,50 @@ void VertexManagerBase::UpdatePipelineObject()
   }
 }
 
+const AbstractPipeline* VertexManagerBase::FindRecentPipeline(u64 hash)
+{
+  for (size_t i = 0; i < m_recent_pipeline_count; i++)
+  {
+    const RecentPipeline& entry = m_recent_pipelines[i];
+    if (entry.hash != hash || entry.uid != m_current_pipeline_config)
+      continue;
+
+    // Keep the entries ordered by their last use.
+    const auto it = m_recent_pipelines.begin() + i;
+    std::rotate(m_recent_pipelines.begin(), it, it + 1);
+    return m_recent_pipelines[0].pipeline;
+  }
+
+  return nullptr;
+}
+
+void VertexManagerBase::AddRecentPipeline(u64 hash, const AbstractPipeline* pipeline)
+{
+  // Replace the least recently used entry once full.
+  if (m_recent_pipeline_count < RECENT_PIPELINE_COUNT)
+    m_recent_pipeline_count++;
+  std::move_backward(m_recent_pipelines.begin(),
+                     m_recent_pipelines.begin() + m_recent_pipeline_count - 1,
+                     m_recent_pipelines.begin() + m_recent_pipeline_count);
+  m_recent_pipelines[0] = {hash, m_current_pipeline_config, pipeline};
+}
+
+const AbstractPipeline* VertexManagerBase::GetUberPipelineObject()
+{
+  if (g_ActiveConfig.bUberShaderVariants)
+  {
+    // Prefer a variant specialized on the current state, but don't wait for it to compile.
+    VideoCommon::GXUberPipelineUid variant_config = m_current_uber_pipeline_config;
+    UberShader::SpecializeVertexShaderUid(&variant_config.vs_uid);
+    UberShader::SpecializePixelShaderUid(&variant_config.ps_uid);
+    const auto res = g_shader_cache->GetUberPipelineForUidAsync(variant_config);
+    if (res && *res)
+      return *res;
+  }
+
+  return g_shader_cache->GetUberPipelineForUid(m_current_uber_pipeline_config);
+}
+
 void VertexManagerBase::OnConfigChange()
 {
   // Reload index generator function tables in case VS expand config changed
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -110,6 +111,13 @@ public:
   void AddIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices);
   bool AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
                             const u8* src, u32 count);
+  /// Culls the triangles of a primitive individually and keeps the ones which remain visible.
+  /// Returns the number of these triangles.
+  u32 CullPrimitives(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive, const u8* src,
+                     u32 count);
+  /// Adds the triangles kept by the last CullPrimitives call in place of AddIndices.
+  /// Returns false without adding anything if they don't fit into the index buffer.
+  bool AddCulledIndices(u32 num_triangles, u32 num_vertices);
   virtual DataReader PrepareForAdditionalData(OpcodeDecoder::Primitive primitive, u32 count,
                                               u32 stride, bool cullall);
   /// Switch cullall off after a call to PrepareForAdditionalData with cullall true
@@ -134,6 +142,8 @@ public:
     m_current_pipeline_object = nullptr;
     m_pipeline_config_changed = true;
   }
+  // Must be called before the shader cache destroys its pipelines.
+  void ClearRecentPipelines() { m_recent_pipeline_count = 0; }
   void NotifyCustomShaderCacheOfHostChange(const ShaderHostConfig& host_config);
 
   // Utility pipeline drawing (e.g. EFB copies, post-processing, UI).
@@ -203,6 +213,7 @@ protected:
   // Alternative buffers in CPU memory for primitives we are going to discard.
   std::vector<u8> m_cpu_vertex_buffer;
   std::vector<u16> m_cpu_index_buffer;
+  std::vector<u16> m_culled_indices;
 
   Slope m_zslope = {};
 
@@ -216,6 +227,18 @@ protected:
   bool m_blending_state_changed = true;
   bool m_cull_all = false;
 
+  // Specialized pipelines that were used most recently, so that switching back and forth between a
+  // few of them doesn't need a lookup in the shader cache maps each time.
+  struct RecentPipeline
+  {
+    u64 hash;
+    VideoCommon::GXPipelineUid uid;
+    const AbstractPipeline* pipeline;
+  };
+  static constexpr size_t RECENT_PIPELINE_COUNT = 8;
+  std::array<RecentPipeline, RECENT_PIPELINE_COUNT> m_recent_pipelines{};
+  size_t m_recent_pipeline_count = 0;
+
   IndexGenerator m_index_generator;
   CPUCull m_cpu_cull;
 
@@ -230,6 +253,9 @@ private:
                       const AbstractPipeline* current_pipeline);
   void UpdatePipelineConfig();
   void UpdatePipelineObject();
+  const AbstractPipeline* GetUberPipelineObject();
+  const AbstractPipeline* FindRecentPipeline(u64 hash);
+  void AddRecentPipeline(u64 hash, const AbstractPipeline* pipeline);
 
   const AbstractPipeline*
   GetCustomPipeline(const CustomPixelShaderContents& custom_pixel_shader_contents,
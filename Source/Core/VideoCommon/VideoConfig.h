@@ -64,6 +64,9 @@ enum class OutputResamplingMode : int
   CatmullRom,
   SharpBilinear,
   AreaSampling,
+  // 7 and 8 are used by resampling methods of the default post-processing shader that aren't
+  // offered in the UI.
+  EdgeAdaptive = 9,
 };
 
 enum class ColorCorrectionRegion : int
@@ -116,6 +119,8 @@ struct VideoConfig final
   // General
   bool bVSync = false;
   bool bVSyncActive = false;
+  // Waits for the previous frame to be displayed before presenting the next one, where supported.
+  bool bLowLatencyPresent = false;
   bool bWidescreenHack = false;
   AspectMode aspect_mode{};
   int custom_aspect_width = 1;
@@ -168,6 +173,7 @@ struct VideoConfig final
   bool bShowVPS = false;
   bool bShowVTimes = false;
   bool bShowGraphs = false;
+  bool bShowFrameBreakdown = false;
   bool bShowSpeed = false;
   bool bShowSpeedColors = false;
   int iPerfSampleUSec = 0;
@@ -190,6 +196,8 @@ struct VideoConfig final
   bool bDumpBaseTextures = false;
   bool bHiresTextures = false;
   bool bCacheHiresTextures = false;
+  int iCustomTextureVRAMBudgetMB = 0;
+  int iTextureCacheVRAMBudgetMB = 0;
   bool bDumpEFBTarget = false;
   bool bDumpXFBTarget = false;
   bool bDumpFramesAsImages = false;
@@ -203,6 +211,13 @@ struct VideoConfig final
       FrameDumpResolutionType::XFBAspectRatioCorrectedResolution;
   bool bBorderlessFullscreen = false;
   bool bEnableGPUTextureDecoding = false;
+  // Textures with fewer texels than this are still decoded on the CPU when GPU texture decoding is
+  // enabled, as the cost of a compute dispatch outweighs the decoding work for small textures.
+  int iGPUTextureDecodingMinTexels = 0;
+  bool bCacheDecodedTextures = false;
+  // Write-protects the memory backing cached textures, so that textures which have not been
+  // written to since they were last hashed do not have to be hashed again.
+  bool bTextureWriteTracking = false;
   bool bPreferVSForLinePointExpansion = false;
   int iBitrateKbps = 0;
   bool bGraphicMods = false;
@@ -211,10 +226,21 @@ struct VideoConfig final
   // Hacks
   bool bEFBAccessEnable = false;
   bool bEFBAccessDeferInvalidation = false;
+  bool bEFBAccessAllowStale = false;
   bool bPerfQueriesEnable = false;
   bool bBBoxEnable = false;
+  bool bBBoxLateReadback = false;
   bool bForceProgressive = false;
   bool bCPUCull = false;
+  // With CPU culling, also leaves the culled triangles of partially visible draws out of the index
+  // buffer instead of only skipping draws which are culled entirely.
+  bool bCPUCullPrimitives = false;
+  // Keeps the converted vertices of batches which only use direct attributes, so that batches
+  // which are drawn again with identical data skip the vertex loader.
+  bool bCacheLoadedVertices = false;
+  // Number of frames which are emulated without rendering their draws after every rendered frame.
+  // Skipped frames aren't presented.
+  u32 iFrameSkip = 0;
 
   bool bEFBEmulateFormatChanges = false;
   bool bSkipEFBCopyToRam = false;
@@ -265,9 +291,16 @@ struct VideoConfig final
   // Currently only supported with Vulkan.
   int iCommandBufferExecuteInterval = 0;
 
+  // Number of frames the CPU may queue before waiting for the GPU to catch up.
+  // Only read when the backend starts, currently only supported with Vulkan.
+  int iMaxFramesInFlight = 2;
+
   // Shader compilation settings.
   bool bWaitForShadersBeforeStarting = false;
   ShaderCompilationMode iShaderCompilationMode{};
+  // While ubershaders are in use, compile variants of them in the background which have the TEV
+  // stage count and lighting channels of the current draw baked in, and prefer those once ready.
+  bool bUberShaderVariants = false;
 
   // Number of shader compiler threads.
   // 0 disables background compilation.
@@ -275,6 +308,10 @@ struct VideoConfig final
   int iShaderCompilerThreads = 0;
   int iShaderPrecompilerThreads = 0;
 
+  // Number of threads shading pixels in the software renderer, including the video thread.
+  // -1 uses an automatic number based on the CPU threads.
+  int iSWRasterizerThreads = 0;
+
   // Loading custom drivers on Android
   std::string customDriverLibraryName;
 
@@ -381,6 +418,7 @@ struct VideoConfig final
   bool UsingUberShaders() const;
   u32 GetShaderCompilerThreads() const;
   u32 GetShaderPrecompilerThreads() const;
+  u32 GetSWRasterizerThreads() const;
 
   float GetCustomAspectRatio() const { return (float)custom_aspect_width / custom_aspect_height; }
 };
@@ -28,6 +28,37 @@ static void XFMemWritten(XFStateManager& xf_state_manager, u32 transferSize, u32
   xf_state_manager.InvalidateXFRange(baseAddress, baseAddress + transferSize);
 }
 
+// Games commonly upload the same matrices and lights again for every draw. Only break the current
+// batch if something actually changes, and only invalidate the words from the first to the last
+// one that changed, so that unchanged matrices don't have to be uploaded again.
+static void WriteXFMem(XFStateManager& xf_state_manager, u32 address, u32 size, const u8* data)
+{
+  u32* const xf_mem = &((u32*)&xfmem)[address];
+
+  u32 first = 0;
+  while (first < size && xf_mem[first] == Common::swap32(data + first * 4))
+    first++;
+  if (first == size)
+    return;
+
+  u32 last = size;
+  while (xf_mem[last - 1] == Common::swap32(data + (last - 1) * 4))
+    last--;
+
+  XFMemWritten(xf_state_manager, last - first, address + first);
+  for (u32 i = first; i < last; i++)
+    xf_mem[i] = Common::swap32(data + i * 4);
+}
+
+// Whether writing a register with the value it already has can have an effect. For the matrix
+// indices, the value is compared against the copies in CP state instead, and the vertex specs
+// need a new CP/XF consistency check. Everything else only reacts to changes.
+static bool IsXFRegWriteAlwaysNeeded(u32 address)
+{
+  return address == XFMEM_CLIPDISABLE || address == XFMEM_VTXSPECS ||
+         address == XFMEM_SETMATRIXINDA || address == XFMEM_SETMATRIXINDB;
+}
+
 static void XFRegWritten(Core::System& system, XFStateManager& xf_state_manager, u32 address,
                          u32 value)
 {
@@ -120,6 +151,8 @@ static void XFRegWritten(Core::System& system, XFStateManager& xf_state_manager,
     case XFMEM_SETVIEWPORT + 3:
     case XFMEM_SETVIEWPORT + 4:
     case XFMEM_SETVIEWPORT + 5:
+      if (((u32*)&xfmem)[address] == value)
+        break;
       g_vertex_manager->Flush();
       xf_state_manager.SetViewportChanged();
       system.GetPixelShaderManager().SetViewportChanged();
@@ -133,6 +166,8 @@ static void XFRegWritten(Core::System& system, XFStateManager& xf_state_manager,
     case XFMEM_SETPROJECTION + 4:
     case XFMEM_SETPROJECTION + 5:
     case XFMEM_SETPROJECTION + 6:
+      if (((u32*)&xfmem)[address] == value)
+        break;
       g_vertex_manager->Flush();
       xf_state_manager.SetProjectionChanged();
       system.GetGeometryShaderManager().SetProjectionChanged();
@@ -151,6 +186,8 @@ static void XFRegWritten(Core::System& system, XFStateManager& xf_state_manager,
     case XFMEM_SETTEXMTXINFO + 5:
     case XFMEM_SETTEXMTXINFO + 6:
     case XFMEM_SETTEXMTXINFO + 7:
+      if (((u32*)&xfmem)[address] == value)
+        break;
       g_vertex_manager->Flush();
       xf_state_manager.SetTexMatrixInfoChanged(address - XFMEM_SETTEXMTXINFO);
       break;
@@ -163,6 +200,8 @@ static void XFRegWritten(Core::System& system, XFStateManager& xf_state_manager,
     case XFMEM_SETPOSTMTXINFO + 5:
     case XFMEM_SETPOSTMTXINFO + 6:
     case XFMEM_SETPOSTMTXINFO + 7:
+      if (((u32*)&xfmem)[address] == value)
+        break;
       g_vertex_manager->Flush();
       xf_state_manager.SetTexMatrixInfoChanged(address - XFMEM_SETPOSTMTXINFO);
       break;
@@ -232,25 +271,24 @@ void LoadXFReg(u16 base_address, u8 transfer_size, const u8* data)
       base_address = XFMEM_REGISTERS_START;
     }
 
-    XFMemWritten(xf_state_manager, xf_mem_transfer_size, xf_mem_base);
-    for (u32 i = 0; i < xf_mem_transfer_size; i++)
-    {
-      ((u32*)&xfmem)[xf_mem_base + i] = Common::swap32(data);
-      data += 4;
-    }
+    WriteXFMem(xf_state_manager, xf_mem_base, xf_mem_transfer_size, data);
+    data += xf_mem_transfer_size * 4;
   }
 
   // write to XF regs
   if (base_address >= XFMEM_REGISTERS_START)
   {
+    u32* const xf_regs = (u32*)&xfmem;
     for (u32 address = base_address; address < end_address; address++)
     {
       const u32 value = Common::swap32(data);
+      data += 4;
 
-      XFRegWritten(system, xf_state_manager, address, value);
-      ((u32*)&xfmem)[address] = value;
+      if (xf_regs[address] == value && !IsXFRegWriteAlwaysNeeded(address))
+        continue;
 
-      data += 4;
+      XFRegWritten(system, xf_state_manager, address, value);
+      xf_regs[address] = value;
     }
   }
 }
@@ -261,38 +299,22 @@ void LoadIndexedXF(CPArray array, u32 index, u16 address, u8 size)
   // load stuff from array to address in xf mem
 
   const u32 buf_size = size * sizeof(u32);
-  u32* currData = reinterpret_cast<u32*>(&xfmem) + address;
-  u32* newData;
+  const u8* new_data;
   auto& system = Core::System::GetInstance();
   auto& fifo = system.GetFifo();
   if (fifo.UseDeterministicGPUThread())
   {
-    newData = reinterpret_cast<u32*>(fifo.PopFifoAuxBuffer(buf_size));
+    new_data = static_cast<const u8*>(fifo.PopFifoAuxBuffer(buf_size));
   }
   else
   {
     auto& memory = system.GetMemory();
-    newData = reinterpret_cast<u32*>(memory.GetPointerForRange(
+    new_data = memory.GetPointerForRange(
         g_main_cp_state.array_bases[array] + g_main_cp_state.array_strides[array] * index,
-        buf_size));
+        buf_size);
   }
 
-  auto& xf_state_manager = system.GetXFStateManager();
-  bool changed = false;
-  for (u32 i = 0; i < size; ++i)
-  {
-    if (currData[i] != Common::swap32(newData[i]))
-    {
-      changed = true;
-      XFMemWritten(xf_state_manager, size, address);
-      break;
-    }
-  }
-  if (changed)
-  {
-    for (u32 i = 0; i < size; ++i)
-      currData[i] = Common::swap32(newData[i]);
-  }
+  WriteXFMem(system.GetXFStateManager(), address, size, new_data);
 }
 
 void PreprocessIndexedXF(CPArray array, u32 index, u16 address, u8 size)
@@ -0,0 +1,35 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Runs the microbenchmarks of hot code paths. Results can be written as JSON to track regressions,
+// e.g. dolphin-benchmarks --benchmark_out=results.json --benchmark_out_format=json
+
+#include <cstdio>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include "Common/MsgHandler.h"
+#include "Core/Core.h"
+
+namespace
+{
+bool BenchmarkMsgHandler(const char* caption, const char* text, bool yes_no, Common::MsgType style)
+{
+  fmt::print(stderr, "{}\n", text);
+  return true;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  Common::RegisterMsgAlertHandler(BenchmarkMsgHandler);
+  Core::DeclareAsHostThread();
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
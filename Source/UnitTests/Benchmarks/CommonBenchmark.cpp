@@ -0,0 +1,103 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <xxhash.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+#include "Common/SPSCQueue.h"
+
+namespace
+{
+std::vector<u8> RandomBytes(size_t size)
+{
+  std::mt19937 rng(static_cast<u32>(size));
+  std::vector<u8> data(size);
+  for (u8& byte : data)
+    byte = static_cast<u8>(rng());
+  return data;
+}
+
+template <typename HashFunction>
+void BenchmarkHash(benchmark::State& state, HashFunction hash)
+{
+  const std::vector<u8> data = RandomBytes(state.range(0));
+  for (auto _ : state)
+    benchmark::DoNotOptimize(hash(data.data(), data.size()));
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+void BM_HashAdler32(benchmark::State& state)
+{
+  BenchmarkHash(state, Common::HashAdler32);
+}
+BENCHMARK(BM_HashAdler32)->Range(1 << 10, 1 << 20);
+
+void BM_ComputeCRC32(benchmark::State& state)
+{
+  BenchmarkHash(state,
+                [](const u8* data, size_t size) { return Common::ComputeCRC32(data, size); });
+}
+BENCHMARK(BM_ComputeCRC32)->Range(1 << 10, 1 << 20);
+
+void BM_GetHash64(benchmark::State& state)
+{
+  BenchmarkHash(state, [](const u8* data, size_t size) {
+    return Common::GetHash64(data, static_cast<u32>(size), 0);
+  });
+}
+BENCHMARK(BM_GetHash64)->Range(1 << 10, 1 << 20);
+
+void BM_XXH3_64bits(benchmark::State& state)
+{
+  BenchmarkHash(state, XXH3_64bits);
+}
+BENCHMARK(BM_XXH3_64bits)->Range(1 << 10, 1 << 20);
+
+template <typename Queue>
+void BM_SPSCQueueSingleThread(benchmark::State& state)
+{
+  Queue queue;
+  u64 value = 0;
+  for (auto _ : state)
+  {
+    queue.Push(value);
+    queue.Pop(value);
+  }
+  benchmark::DoNotOptimize(value);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SPSCQueueSingleThread<Common::SPSCQueue<u64>>);
+BENCHMARK(BM_SPSCQueueSingleThread<Common::SPSCSegmentedQueue<u64>>);
+
+// Measures handing items from one thread to another, which is how the queue is used.
+template <typename Queue>
+void BM_SPSCQueueProducerConsumer(benchmark::State& state)
+{
+  constexpr u64 ITEMS = 1 << 20;
+  for (auto _ : state)
+  {
+    Queue queue;
+    std::thread consumer([&queue] {
+      u64 value;
+      u64 received = 0;
+      while (received < ITEMS)
+      {
+        if (queue.Pop(value))
+          ++received;
+      }
+    });
+    for (u64 i = 0; i < ITEMS; ++i)
+      queue.Push(i);
+    consumer.join();
+  }
+  state.SetItemsProcessed(state.iterations() * ITEMS);
+}
+BENCHMARK(BM_SPSCQueueProducerConsumer<Common::SPSCQueue<u64>>)->UseRealTime();
+BENCHMARK(BM_SPSCQueueProducerConsumer<Common::SPSCSegmentedQueue<u64>>)->UseRealTime();
+}  // namespace
@@ -0,0 +1,174 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <lz4.h>
+#include <zstd.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+#include "UICommon/UICommon.h"
+
+namespace
+{
+// The same settings as savestates use, see State.cpp.
+constexpr size_t STATE_CHUNK_SIZE = 4 * 1024 * 1024;
+constexpr int STATE_ZSTD_COMPRESSION_LEVEL = 1;
+
+// Emulated memory is a mix of code and data, long runs of zeroes and repeated patterns, so the
+// chunk is made up of 4 KiB pages of each.
+std::vector<u8> StateLikeData()
+{
+  constexpr size_t PAGE_SIZE = 4096;
+  std::mt19937 rng(0);
+  std::vector<u8> data(STATE_CHUNK_SIZE);
+  for (size_t page = 0; page < data.size() / PAGE_SIZE; ++page)
+  {
+    u8* const page_data = data.data() + page * PAGE_SIZE;
+    for (size_t i = 0; i < PAGE_SIZE; ++i)
+    {
+      switch (page % 3)
+      {
+      case 0:
+        page_data[i] = static_cast<u8>(rng());
+        break;
+      case 1:
+        page_data[i] = 0;
+        break;
+      default:
+        page_data[i] = static_cast<u8>(i % 16 + page);
+        break;
+      }
+    }
+  }
+  return data;
+}
+
+void BM_StateCompressLZ4(benchmark::State& state)
+{
+  const std::vector<u8> data = StateLikeData();
+  std::vector<char> out(LZ4_compressBound(static_cast<int>(data.size())));
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(LZ4_compress_default(reinterpret_cast<const char*>(data.data()),
+                                                  out.data(), static_cast<int>(data.size()),
+                                                  static_cast<int>(out.size())));
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_StateCompressLZ4);
+
+void BM_StateDecompressLZ4(benchmark::State& state)
+{
+  const std::vector<u8> data = StateLikeData();
+  std::vector<char> compressed(LZ4_compressBound(static_cast<int>(data.size())));
+  compressed.resize(LZ4_compress_default(reinterpret_cast<const char*>(data.data()),
+                                         compressed.data(), static_cast<int>(data.size()),
+                                         static_cast<int>(compressed.size())));
+  std::vector<char> out(data.size());
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(LZ4_decompress_safe(compressed.data(), out.data(),
+                                                 static_cast<int>(compressed.size()),
+                                                 static_cast<int>(out.size())));
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_StateDecompressLZ4);
+
+void BM_StateCompressZstd(benchmark::State& state)
+{
+  const std::vector<u8> data = StateLikeData();
+  std::vector<u8> out(ZSTD_compressBound(data.size()));
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(ZSTD_compress(out.data(), out.size(), data.data(), data.size(),
+                                           STATE_ZSTD_COMPRESSION_LEVEL));
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_StateCompressZstd);
+
+void BM_StateDecompressZstd(benchmark::State& state)
+{
+  const std::vector<u8> data = StateLikeData();
+  std::vector<u8> compressed(ZSTD_compressBound(data.size()));
+  compressed.resize(ZSTD_compress(compressed.data(), compressed.size(), data.data(), data.size(),
+                                  STATE_ZSTD_COMPRESSION_LEVEL));
+  std::vector<u8> out(data.size());
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(
+        ZSTD_decompress(out.data(), out.size(), compressed.data(), compressed.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_StateDecompressZstd);
+
+u64 s_events_run = 0;
+
+void CountEvent(Core::System&, u64, s64)
+{
+  ++s_events_run;
+}
+
+// Schedules a batch of events at random times and advances through all of them, like the
+// hardware emulation does all the time.
+void BM_CoreTimingScheduleAndAdvance(benchmark::State& state)
+{
+  const std::string profile_path = File::CreateTempDir();
+  if (profile_path.empty())
+  {
+    state.SkipWithError("Failed to create a temporary user directory");
+    return;
+  }
+
+  auto& system = Core::System::GetInstance();
+  Core::DeclareAsCPUThread();
+  UICommon::SetUserDirectory(profile_path);
+  Config::Init();
+  SConfig::Init();
+  system.GetPowerPC().Init(PowerPC::CPUCore::Interpreter);
+  auto& core_timing = system.GetCoreTiming();
+  core_timing.Init();
+
+  auto& ppc_state = system.GetPPCState();
+  CoreTiming::EventType* const event = core_timing.RegisterEvent("BenchmarkEvent", CountEvent);
+  const u64 num_events = state.range(0);
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<s64> distribution(1, 100000);
+
+  core_timing.Advance();
+  for (auto _ : state)
+  {
+    s_events_run = 0;
+    for (u64 i = 0; i < num_events; ++i)
+      core_timing.ScheduleEvent(distribution(rng), event, i);
+    while (s_events_run < num_events)
+    {
+      // Pretend the whole slice was executed.
+      ppc_state.downcount = 0;
+      core_timing.Advance();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_events);
+
+  core_timing.Shutdown();
+  system.GetPowerPC().Shutdown();
+  SConfig::Shutdown();
+  Config::Shutdown();
+  Core::UndeclareAsCPUThread();
+  File::DeleteDirRecursively(profile_path);
+}
+BENCHMARK(BM_CoreTimingScheduleAndAdvance)->Range(8, 512);
+}  // namespace
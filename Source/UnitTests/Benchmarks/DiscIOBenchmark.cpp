@@ -0,0 +1,112 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Common/CommonTypes.h"
+#include "DiscIO/WIACompression.h"
+
+namespace
+{
+// A typical chunk size for RVZ files.
+constexpr size_t CHUNK_SIZE = 128 * 1024;
+
+enum class Method
+{
+  Bzip2,
+  LZMA,
+  LZMA2,
+  Zstd,
+};
+
+// Game data is partly compressible, so half of the chunk is random and the rest is text-like.
+std::vector<u8> ChunkData()
+{
+  std::mt19937 rng(0);
+  std::vector<u8> data(CHUNK_SIZE);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = i < data.size() / 2 ? static_cast<u8>(rng()) : static_cast<u8>('a' + rng() % 8);
+  return data;
+}
+
+void BM_WIADecompressChunk(benchmark::State& state)
+{
+  const Method method = static_cast<Method>(state.range(0));
+  const std::vector<u8> data = ChunkData();
+
+  std::array<u8, 7> compressor_data{};
+  u8 compressor_data_size = 0;
+  std::unique_ptr<DiscIO::Compressor> compressor;
+  switch (method)
+  {
+  case Method::Bzip2:
+    compressor = std::make_unique<DiscIO::Bzip2Compressor>(9);
+    break;
+  case Method::LZMA:
+  case Method::LZMA2:
+    compressor = std::make_unique<DiscIO::LZMACompressor>(
+        method == Method::LZMA2, 5, compressor_data.data(), &compressor_data_size);
+    break;
+  case Method::Zstd:
+    compressor = std::make_unique<DiscIO::ZstdCompressor>(5);
+    break;
+  }
+
+  if (!compressor->Start(data.size()) || !compressor->Compress(data.data(), data.size()) ||
+      !compressor->End())
+  {
+    state.SkipWithError("Failed to compress the chunk");
+    return;
+  }
+
+  DiscIO::DecompressionBuffer in;
+  in.data.assign(compressor->GetData(), compressor->GetData() + compressor->GetSize());
+  in.bytes_written = in.data.size();
+  DiscIO::DecompressionBuffer out;
+  out.data.resize(data.size());
+
+  for (auto _ : state)
+  {
+    std::unique_ptr<DiscIO::Decompressor> decompressor;
+    switch (method)
+    {
+    case Method::Bzip2:
+      decompressor = std::make_unique<DiscIO::Bzip2Decompressor>();
+      break;
+    case Method::LZMA:
+    case Method::LZMA2:
+      decompressor = std::make_unique<DiscIO::LZMADecompressor>(
+          method == Method::LZMA2, compressor_data.data(), compressor_data_size);
+      break;
+    case Method::Zstd:
+      decompressor = std::make_unique<DiscIO::ZstdDecompressor>();
+      break;
+    }
+
+    out.bytes_written = 0;
+    size_t in_bytes_read = 0;
+    while (!decompressor->Done() && out.bytes_written < out.data.size())
+    {
+      if (!decompressor->Decompress(in, &out, &in_bytes_read))
+      {
+        state.SkipWithError("Failed to decompress the chunk");
+        return;
+      }
+    }
+  }
+  if (out.data != data)
+    state.SkipWithError("The decompressed chunk doesn't match");
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_WIADecompressChunk)
+    ->ArgName("method")
+    ->Arg(static_cast<int>(Method::Bzip2))
+    ->Arg(static_cast<int>(Method::LZMA))
+    ->Arg(static_cast<int>(Method::LZMA2))
+    ->Arg(static_cast<int>(Method::Zstd));
+}  // namespace
@@ -0,0 +1,192 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <bit>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Swap.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/CPUCull.h"
+#include "VideoCommon/IndexGenerator.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/VertexLoaderBase.h"
+#include "VideoCommon/VertexLoaderManager.h"
+#include "VideoCommon/VideoConfig.h"
+
+using OpcodeDecoder::Primitive;
+
+namespace
+{
+constexpr std::array<TextureFormat, 10> TEXTURE_FORMATS{
+    TextureFormat::I4, TextureFormat::I8, TextureFormat::IA4, TextureFormat::IA8,
+    TextureFormat::RGB565, TextureFormat::RGB5A3, TextureFormat::RGBA8, TextureFormat::C4,
+    TextureFormat::C8, TextureFormat::CMPR};
+
+constexpr u32 NUM_VERTICES = 60000;
+
+std::vector<u8> RandomBytes(size_t size)
+{
+  std::mt19937 rng(static_cast<u32>(size));
+  std::vector<u8> data(size);
+  for (u8& byte : data)
+    byte = static_cast<u8>(rng());
+  return data;
+}
+
+void BM_TextureDecode(benchmark::State& state)
+{
+  constexpr int width = 512;
+  constexpr int height = 512;
+  const TextureFormat format = TEXTURE_FORMATS[state.range(0)];
+  const std::vector<u8> src = RandomBytes(width * height * sizeof(u32));
+  const std::vector<u8> tlut = RandomBytes(16384 * sizeof(u16));
+  std::vector<u8> dst(width * height * sizeof(u32));
+
+  for (auto _ : state)
+  {
+    TexDecoder_Decode(dst.data(), src.data(), width, height, format, tlut.data(),
+                      TLUTFormat::RGB5A3);
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetItemsProcessed(state.iterations() * width * height);
+}
+BENCHMARK(BM_TextureDecode)->ArgName("format")->DenseRange(0, TEXTURE_FORMATS.size() - 1);
+
+// The attributes most games use: a position, a color and a texture coordinate.
+std::unique_ptr<VertexLoaderBase> CreateVertexLoader(VertexComponentFormat addr,
+                                                     ComponentFormat position_format)
+{
+  TVtxDesc vtx_desc;
+  vtx_desc.low.Hex = 0;
+  vtx_desc.high.Hex = 0;
+  vtx_desc.low.Position = addr;
+  vtx_desc.low.Color0 = addr;
+  vtx_desc.high.Tex0Coord = addr;
+
+  VAT vtx_attr;
+  vtx_attr.g0.Hex = 0;
+  vtx_attr.g1.Hex = 0;
+  vtx_attr.g2.Hex = 0;
+  vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
+  vtx_attr.g0.PosFormat = position_format;
+  vtx_attr.g0.ByteDequant = true;
+  vtx_attr.g0.Color0Elements = ColorComponentCount::RGBA;
+  vtx_attr.g0.Color0Comp = ColorFormat::RGBA8888;
+  vtx_attr.g0.Tex0CoordElements = TexComponentCount::ST;
+  vtx_attr.g0.Tex0CoordFormat = ComponentFormat::Float;
+
+  return VertexLoaderBase::CreateVertexLoader(vtx_desc, vtx_attr);
+}
+
+void BenchmarkVertexLoader(benchmark::State& state, VertexComponentFormat addr)
+{
+  const std::unique_ptr<VertexLoaderBase> loader =
+      CreateVertexLoader(addr, static_cast<ComponentFormat>(state.range(0)));
+  const std::vector<u8> src = RandomBytes(NUM_VERTICES * loader->m_vertex_size);
+  std::vector<u8> dst(NUM_VERTICES * loader->m_native_vtx_decl.stride);
+
+  // Every array has room for any 16-bit index.
+  constexpr u32 array_stride = 16;
+  std::vector<u8> arrays = RandomBytes(65536 * array_stride);
+  for (int i = 0; i < NUM_VERTEX_COMPONENT_ARRAYS; ++i)
+  {
+    VertexLoaderManager::cached_arraybases[static_cast<CPArray>(i)] = arrays.data();
+    g_main_cp_state.array_strides[static_cast<CPArray>(i)] = array_stride;
+  }
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(loader->RunVertices(src.data(), dst.data(), NUM_VERTICES));
+  state.SetItemsProcessed(state.iterations() * NUM_VERTICES);
+}
+
+void BM_VertexLoaderDirect(benchmark::State& state)
+{
+  BenchmarkVertexLoader(state, VertexComponentFormat::Direct);
+}
+BENCHMARK(BM_VertexLoaderDirect)
+    ->ArgName("position_format")
+    ->Arg(static_cast<int>(ComponentFormat::Byte))
+    ->Arg(static_cast<int>(ComponentFormat::Short))
+    ->Arg(static_cast<int>(ComponentFormat::Float));
+
+void BM_VertexLoaderIndex16(benchmark::State& state)
+{
+  BenchmarkVertexLoader(state, VertexComponentFormat::Index16);
+}
+BENCHMARK(BM_VertexLoaderIndex16)
+    ->ArgName("position_format")
+    ->Arg(static_cast<int>(ComponentFormat::Short))
+    ->Arg(static_cast<int>(ComponentFormat::Float));
+
+void BM_IndexGenerator(benchmark::State& state)
+{
+  const Primitive primitive = static_cast<Primitive>(state.range(0));
+  g_Config.backend_info.bSupportsPrimitiveRestart = state.range(1) != 0;
+  g_Config.backend_info.bSupportsVSLinePointExpand = false;
+  std::vector<u16> indices(NUM_VERTICES * 4);
+  IndexGenerator generator;
+  generator.Init();
+
+  for (auto _ : state)
+  {
+    generator.Start(indices.data());
+    generator.AddIndices(primitive, NUM_VERTICES);
+    benchmark::DoNotOptimize(indices.data());
+  }
+  state.SetItemsProcessed(state.iterations() * NUM_VERTICES);
+}
+BENCHMARK(BM_IndexGenerator)
+    ->ArgNames({"primitive", "primitive_restart"})
+    ->ArgsProduct({{static_cast<int>(Primitive::GX_DRAW_QUADS),
+                    static_cast<int>(Primitive::GX_DRAW_TRIANGLES),
+                    static_cast<int>(Primitive::GX_DRAW_TRIANGLE_STRIP),
+                    static_cast<int>(Primitive::GX_DRAW_TRIANGLE_FAN),
+                    static_cast<int>(Primitive::GX_DRAW_LINE_STRIP)},
+                   {0, 1}});
+
+void BM_CPUCullPrimitives(benchmark::State& state)
+{
+  const Primitive primitive = static_cast<Primitive>(state.range(0));
+  const std::unique_ptr<VertexLoaderBase> loader =
+      CreateVertexLoader(VertexComponentFormat::Direct, ComponentFormat::Float);
+
+  // Culling works on vertices which have already been loaded.
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+  std::vector<u8> src(NUM_VERTICES * loader->m_vertex_size);
+  for (u32 i = 0; i < NUM_VERTICES; ++i)
+  {
+    for (u32 j = 0; j < 3; ++j)
+    {
+      const u32 value = Common::swap32(std::bit_cast<u32>(distribution(rng)));
+      std::memcpy(&src[i * loader->m_vertex_size + j * sizeof(u32)], &value, sizeof(u32));
+    }
+  }
+  std::vector<u8> vertices(NUM_VERTICES * loader->m_native_vtx_decl.stride);
+  loader->RunVertices(src.data(), vertices.data(), NUM_VERTICES);
+
+  CPUCull cpu_cull;
+  cpu_cull.Init();
+  std::vector<u16> indices(NUM_VERTICES * 3);
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(cpu_cull.CullPrimitives(loader.get(), primitive, vertices.data(),
+                                                     NUM_VERTICES, indices.data()));
+  }
+  state.SetItemsProcessed(state.iterations() * NUM_VERTICES);
+}
+BENCHMARK(BM_CPUCullPrimitives)
+    ->ArgName("primitive")
+    ->Arg(static_cast<int>(Primitive::GX_DRAW_QUADS))
+    ->Arg(static_cast<int>(Primitive::GX_DRAW_TRIANGLES))
+    ->Arg(static_cast<int>(Primitive::GX_DRAW_TRIANGLE_STRIP))
+    ->Arg(static_cast<int>(Primitive::GX_DRAW_TRIANGLE_FAN));
+}  // namespace
@@ -77,3 +77,34 @@ TEST(BlockingLoop, MultiThreaded)
     loop_thread.join();
   }
 }
+
+TEST(BlockingLoop, AdaptiveSpinning)
+{
+  Common::BlockingLoop loop;
+  loop.SetAdaptiveSpinning(true, std::chrono::microseconds(1), std::chrono::microseconds(100));
+
+  std::atomic<int> signaled(0);
+  std::atomic<int> received(0);
+  std::thread loop_thread([&]() { loop.Run([&]() { received.store(signaled.load()); }); });
+  loop.Prepare();
+
+  for (int i = 0; i < 100; i++)
+  {
+    signaled++;
+    loop.Wakeup();
+    loop.Wait();
+    EXPECT_EQ(signaled.load(), received.load());
+
+    // Stay idle for much longer than the maximum spin duration.
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  loop.Stop();
+  loop_thread.join();
+
+  // Without any AllowSleep() calls, the worker has to have gone to sleep by itself while idle.
+  const Common::BlockingLoop::Statistics stats = loop.GetStatistics();
+  EXPECT_GE(stats.sleeps, 100u);
+  EXPECT_LE(stats.spin_duration, std::chrono::microseconds(100));
+  EXPECT_GE(stats.spin_duration, std::chrono::microseconds(1));
+}
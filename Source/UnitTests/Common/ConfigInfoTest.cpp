@@ -0,0 +1,87 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+
+#include "Common/Config/ConfigInfo.h"
+
+namespace
+{
+enum class TestEnum
+{
+  A,
+  B,
+};
+
+const Config::Location TEST_LOCATION{Config::System::Main, "Test", "Value"};
+}  // namespace
+
+static_assert(Config::detail::IsLockFreeCacheable<bool>::value);
+static_assert(Config::detail::IsLockFreeCacheable<int>::value);
+static_assert(Config::detail::IsLockFreeCacheable<TestEnum>::value);
+static_assert(!Config::detail::IsLockFreeCacheable<std::string>::value);
+
+TEST(ConfigInfo, CachedValueOnlyMovesForward)
+{
+  const Config::Info<int> info{TEST_LOCATION, 1};
+  EXPECT_EQ(1, info.GetCachedValue().value);
+  EXPECT_EQ(0u, info.GetCachedValue().config_version);
+
+  info.SetCachedValue({5, 2});
+  EXPECT_EQ(5, info.GetCachedValue().value);
+  EXPECT_EQ(2u, info.GetCachedValue().config_version);
+
+  // An older value, for example from a thread which read the layers before another thread
+  // changed them, must not replace a newer one.
+  info.SetCachedValue({3, 1});
+  EXPECT_EQ(5, info.GetCachedValue().value);
+  EXPECT_EQ(2u, info.GetCachedValue().config_version);
+}
+
+TEST(ConfigInfo, CachedStringValue)
+{
+  const Config::Info<std::string> info{TEST_LOCATION, "default"};
+  info.SetCachedValue({"new", 1});
+  EXPECT_EQ("new", info.GetCachedValue().value);
+  info.SetCachedValue({"old", 1});
+  EXPECT_EQ("new", info.GetCachedValue().value);
+}
+
+TEST(ConfigInfo, CopiesKeepCachedValue)
+{
+  const Config::Info<TestEnum> info{TEST_LOCATION, TestEnum::A};
+  info.SetCachedValue({TestEnum::B, 3});
+
+  const Config::Info<TestEnum> copy = info;
+  EXPECT_EQ(TestEnum::B, copy.GetCachedValue().value);
+  EXPECT_EQ(3u, copy.GetCachedValue().config_version);
+
+  const Config::Info<int> casted = info;
+  EXPECT_EQ(static_cast<int>(TestEnum::B), casted.GetCachedValue().value);
+  EXPECT_EQ(3u, casted.GetCachedValue().config_version);
+}
+
+TEST(ConfigInfo, ConcurrentReadsSeeMatchingValues)
+{
+  const Config::Info<u64> info{TEST_LOCATION, 0};
+  constexpr u64 VERSIONS = 100000;
+
+  std::thread writer([&info] {
+    for (u64 version = 1; version <= VERSIONS; ++version)
+      info.SetCachedValue({version, version});
+  });
+
+  // The value always belongs to the read version or a newer one.
+  u64 last_version = 0;
+  while (last_version < VERSIONS)
+  {
+    const Config::CachedValue<u64> cached_value = info.GetCachedValue();
+    EXPECT_GE(cached_value.config_version, last_version);
+    EXPECT_GE(cached_value.value, cached_value.config_version);
+    last_version = cached_value.config_version;
+  }
+  writer.join();
+}
@@ -0,0 +1,56 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/AES.h"
+
+// F.2.1 and F.2.2 of NIST SP 800-38A
+static constexpr std::array<u8, 16> KEY{0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                                        0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
+static constexpr std::array<u8, 16> IV{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                                       0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f};
+static constexpr std::array<u8, 32> PLAINTEXT{
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+    0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51};
+static constexpr std::array<u8, 32> CIPHERTEXT{
+    0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46, 0xce, 0xe9, 0x8e, 0x9b, 0x12, 0xe9, 0x19, 0x7d,
+    0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72, 0x19, 0xee, 0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2};
+
+TEST(AES, CBCVectors)
+{
+  std::array<u8, 32> actual;
+  std::array<u8, 16> iv_out;
+
+  const auto encrypt = Common::AES::CreateContextEncrypt(KEY.data());
+  ASSERT_TRUE(
+      encrypt->Crypt(IV.data(), iv_out.data(), PLAINTEXT.data(), actual.data(), actual.size()));
+  EXPECT_EQ(CIPHERTEXT, actual);
+  // The IV for the next block is the last block of ciphertext
+  EXPECT_TRUE(std::equal(iv_out.begin(), iv_out.end(), CIPHERTEXT.end() - iv_out.size()));
+
+  const auto decrypt = Common::AES::CreateContextDecrypt(KEY.data());
+  ASSERT_TRUE(decrypt->Crypt(IV.data(), CIPHERTEXT.data(), actual.data(), actual.size()));
+  EXPECT_EQ(PLAINTEXT, actual);
+}
+
+TEST(AES, Throughput)
+{
+  constexpr size_t SIZE = 16 * 1024 * 1024;
+  std::vector<u8> data(SIZE, 0xa5);
+  std::vector<u8> decrypted(SIZE);
+
+  const auto context = Common::AES::CreateContextDecrypt(KEY.data());
+  const auto start = std::chrono::steady_clock::now();
+  ASSERT_TRUE(context->Crypt(IV.data(), data.data(), decrypted.data(), SIZE));
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  fmt::print("decryption: {:.1f} MiB/s\n", SIZE / (1024 * 1024) / elapsed.count());
+}
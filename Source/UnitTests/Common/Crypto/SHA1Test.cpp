@@ -1,6 +1,13 @@
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include <fmt/format.h>
 #include <gtest/gtest.h>
 
+#include "Common/CommonTypes.h"
 #include "Common/Crypto/SHA1.h"
+#include "Common/Swap.h"
 
 // Just a few quick sanity checks
 TEST(SHA1, Vectors)
@@ -28,3 +35,35 @@ TEST(SHA1, Vectors)
     EXPECT_EQ(test.expected, actual);
   }
 }
+
+TEST(SHA1, ProcessBlocks)
+{
+  // "abc", padded by hand
+  std::vector<u8> block(Common::SHA1::BLOCK_LEN);
+  std::memcpy(block.data(), "abc\x80", 4);
+  block.back() = 3 * 8;
+
+  Common::SHA1::State state = Common::SHA1::INITIAL_STATE;
+  Common::SHA1::ProcessBlocks(&state, block.data(), 1);
+
+  Common::SHA1::Digest actual;
+  for (size_t i = 0; i < state.size(); ++i)
+  {
+    const Common::BigEndianValue<u32> word(state[i]);
+    std::memcpy(&actual[i * sizeof(u32)], &word, sizeof(word));
+  }
+  EXPECT_EQ(Common::SHA1::CalculateDigest("abc"), actual);
+}
+
+TEST(SHA1, Throughput)
+{
+  const std::vector<u8> data(16 * 1024 * 1024, 0xa5);
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto digest = Common::SHA1::CalculateDigest(data);
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  EXPECT_NE(Common::SHA1::Digest{}, digest);
+  fmt::print("hardware accelerated: {}, {:.1f} MiB/s\n",
+             Common::SHA1::CreateContext()->HwAccelerated(), 16 / elapsed.count());
+}
@@ -0,0 +1,56 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+
+#include "Common/DirectoryWatcher.h"
+#include "Common/Event.h"
+#include "Common/FileUtil.h"
+
+class DirectoryWatcherTest : public testing::Test
+{
+protected:
+  DirectoryWatcherTest() : m_directory(File::CreateTempDir()) {}
+
+  ~DirectoryWatcherTest() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override
+  {
+    if (m_directory.empty())
+      FAIL();
+  }
+
+  const std::string m_directory;
+};
+
+TEST_F(DirectoryWatcherTest, ReportsChangedFiles)
+{
+  Common::Event changed;
+  Common::DirectoryWatcher watcher([&](const std::string& path) {
+    // The reported path may resolve symbolic links of the directory
+    if (path.empty() || path.ends_with("/file.txt"))
+      changed.Set();
+  });
+  if (!watcher.Watch(m_directory))
+    GTEST_SKIP() << "Change notifications aren't supported";
+
+  // Directories are only watched once
+  EXPECT_TRUE(watcher.Watch(m_directory));
+
+  ASSERT_TRUE(File::WriteStringToFile(m_directory + "/file.txt", "data"));
+  EXPECT_TRUE(changed.WaitFor(std::chrono::seconds(5)));
+}
+
+TEST_F(DirectoryWatcherTest, RejectsMissingDirectories)
+{
+  Common::DirectoryWatcher watcher([](const std::string&) {});
+  EXPECT_FALSE(watcher.Watch(m_directory + "/missing"));
+  EXPECT_FALSE(watcher.Watch(m_directory + "/missing"));
+}
@@ -0,0 +1,125 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/LinearDiskCache.h"
+
+namespace
+{
+class Reader final : public Common::LinearDiskCacheReader<u32, u8>
+{
+public:
+  void Read(const u32& key, const u8* value, u32 value_size) override
+  {
+    entries.emplace_back(key, std::string(reinterpret_cast<const char*>(value), value_size));
+  }
+
+  std::vector<std::pair<u32, std::string>> entries;
+};
+
+void Append(Common::LinearDiskCache<u32, u8>& cache, u32 key, const std::string& value)
+{
+  cache.Append(key, reinterpret_cast<const u8*>(value.data()), static_cast<u32>(value.size()));
+}
+
+std::string Lookup(Common::LinearDiskCache<u32, u8>& cache, u32 key)
+{
+  const auto value = cache.Lookup(key);
+  if (!value)
+    return "<missing>";
+  return std::string(reinterpret_cast<const char*>(value->data()), value->size());
+}
+}  // namespace
+
+class LinearDiskCacheTest : public testing::Test
+{
+protected:
+  LinearDiskCacheTest()
+      : m_directory(File::CreateTempDir()), m_filename(m_directory + "/test.cache")
+  {
+  }
+
+  ~LinearDiskCacheTest() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override
+  {
+    if (m_directory.empty())
+      FAIL();
+  }
+
+  const std::string m_directory;
+  const std::string m_filename;
+};
+
+TEST_F(LinearDiskCacheTest, AppendAndLookup)
+{
+  Common::LinearDiskCache<u32, u8> cache;
+  EXPECT_EQ(0u, cache.Open(m_filename));
+
+  Append(cache, 1, "first");
+  Append(cache, 2, "");
+  Append(cache, 1, "replaced");
+  EXPECT_EQ("replaced", Lookup(cache, 1));
+  EXPECT_EQ("", Lookup(cache, 2));
+  EXPECT_EQ("<missing>", Lookup(cache, 3));
+  cache.Close();
+
+  EXPECT_EQ(2u, cache.Open(m_filename));
+  EXPECT_EQ("replaced", Lookup(cache, 1));
+  Append(cache, 3, "third");
+  EXPECT_EQ("third", Lookup(cache, 3));
+  cache.Close();
+
+  Reader reader;
+  EXPECT_EQ(3u, cache.OpenAndRead(m_filename, reader));
+  const std::vector<std::pair<u32, std::string>> expected = {
+      {2, ""}, {1, "replaced"}, {3, "third"}};
+  EXPECT_EQ(expected, reader.entries);
+}
+
+TEST_F(LinearDiskCacheTest, RecoversWithoutIndex)
+{
+  const std::string copy_filename = m_directory + "/copy.cache";
+  {
+    Common::LinearDiskCache<u32, u8> cache;
+    cache.Open(m_filename);
+    Append(cache, 1, "one");
+    Append(cache, 2, "two");
+    cache.Sync();
+
+    // Copying the file before it is closed leaves out the index.
+    ASSERT_TRUE(File::Copy(m_filename, copy_filename));
+  }
+
+  Common::LinearDiskCache<u32, u8> cache;
+  EXPECT_EQ(2u, cache.Open(copy_filename));
+  EXPECT_EQ("one", Lookup(cache, 1));
+  EXPECT_EQ("two", Lookup(cache, 2));
+}
+
+TEST_F(LinearDiskCacheTest, CompactsReplacedEntries)
+{
+  const std::string value(1000, 'x');
+  Common::LinearDiskCache<u32, u8> cache;
+  cache.Open(m_filename);
+  for (u32 i = 0; i < 100; ++i)
+    Append(cache, i % 2, value + std::to_string(i));
+  cache.Close();
+
+  EXPECT_LT(File::GetSize(m_filename), 4 * value.size());
+
+  EXPECT_EQ(2u, cache.Open(m_filename));
+  EXPECT_EQ(value + "98", Lookup(cache, 0));
+  EXPECT_EQ(value + "99", Lookup(cache, 1));
+}
@@ -0,0 +1,78 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <thread>
+#include <vector>
+
+#include "Common/MPSCQueue.h"
+
+TEST(MPSCQueue, Simple)
+{
+  Common::MPSCQueue<u32> q;
+
+  EXPECT_TRUE(q.Empty());
+
+  q.Push(1);
+  EXPECT_FALSE(q.Empty());
+
+  u32 v;
+  EXPECT_TRUE(q.Pop(v));
+  EXPECT_EQ(1u, v);
+  EXPECT_TRUE(q.Empty());
+  EXPECT_FALSE(q.Pop(v));
+
+  // Test the FIFO order.
+  for (u32 i = 0; i < 1000; ++i)
+    q.Push(i);
+  for (u32 i = 0; i < 1000; ++i)
+  {
+    u32 v2;
+    EXPECT_TRUE(q.Pop(v2));
+    EXPECT_EQ(i, v2);
+  }
+  EXPECT_TRUE(q.Empty());
+
+  // Elements left in the queue are freed by the destructor.
+  for (u32 i = 0; i < 1000; ++i)
+    q.Push(i);
+}
+
+TEST(MPSCQueue, MultiThreaded)
+{
+  constexpr u32 NUM_PRODUCERS = 4;
+  constexpr u32 NUM_ELEMENTS = 100000;
+
+  Common::MPSCQueue<u32> q;
+
+  std::vector<std::thread> inserter_threads;
+  for (u32 producer = 0; producer < NUM_PRODUCERS; ++producer)
+  {
+    inserter_threads.emplace_back([&q, producer]() {
+      for (u32 i = 0; i < NUM_ELEMENTS; ++i)
+        q.Push(producer << 24 | i);
+    });
+  }
+
+  // Elements from each producer must arrive in order, and none may get lost.
+  std::array<u32, NUM_PRODUCERS> next_expected{};
+  for (u32 received = 0; received < NUM_PRODUCERS * NUM_ELEMENTS;)
+  {
+    u32 v;
+    if (!q.Pop(v))
+      continue;
+
+    const u32 producer = v >> 24;
+    ASSERT_LT(producer, NUM_PRODUCERS);
+    EXPECT_EQ(next_expected[producer], v & 0xFFFFFF);
+    next_expected[producer] = (v & 0xFFFFFF) + 1;
+    ++received;
+  }
+
+  for (std::thread& thread : inserter_threads)
+    thread.join();
+
+  EXPECT_TRUE(q.Empty());
+}
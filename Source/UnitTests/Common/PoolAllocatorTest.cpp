@@ -0,0 +1,52 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <utility>
+
+#include "Common/CommonTypes.h"
+#include "Common/PoolAllocator.h"
+
+TEST(PoolAllocator, ReusesFreedBlocks)
+{
+  Common::PoolAllocator<u64> allocator;
+
+  u64* const first = allocator.allocate(1);
+  allocator.deallocate(first, 1);
+  u64* const second = allocator.allocate(1);
+  EXPECT_EQ(first, second);
+  allocator.deallocate(second, 1);
+
+  // Arrays bypass the pool.
+  u64* const array = allocator.allocate(4);
+  array[3] = 1;
+  allocator.deallocate(array, 4);
+}
+
+TEST(PoolAllocator, SharedBetweenRebinds)
+{
+  using PairAllocator = Common::PoolAllocator<std::pair<const int, int>>;
+  Common::PoolAllocator<int> allocator;
+  std::multimap<int, int, std::less<int>, PairAllocator> map{allocator};
+
+  for (int i = 0; i < 1000; ++i)
+    map.emplace(i % 10, i);
+  EXPECT_EQ(1000u, map.size());
+  EXPECT_EQ(100u, map.count(3));
+  map.clear();
+
+  // The pool must outlive the allocator it was created from as long as something uses it.
+  std::shared_ptr<int> value;
+  {
+    Common::PoolAllocator<int> temp_allocator;
+    value = std::allocate_shared<int>(temp_allocator, 42);
+  }
+  EXPECT_EQ(42, *value);
+  value.reset();
+
+  EXPECT_TRUE(allocator == PairAllocator(allocator));
+  EXPECT_FALSE(allocator == Common::PoolAllocator<int>());
+}
@@ -2,7 +2,10 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <gtest/gtest.h>
+#include <iterator>
+#include <memory>
 #include <thread>
+#include <vector>
 
 #include "Common/SPSCQueue.h"
 
@@ -68,3 +71,122 @@ TEST(SPSCQueue, MultiThreaded)
   popper_thread.join();
   inserter_thread.join();
 }
+
+TEST(SPSCSegmentedQueue, Simple)
+{
+  // A small segment size makes sure segments are crossed and reused.
+  Common::SPSCSegmentedQueue<u32, true, 4> q;
+
+  EXPECT_EQ(0u, q.Size());
+  EXPECT_TRUE(q.Empty());
+
+  q.Push(1);
+  EXPECT_EQ(1u, q.Size());
+  EXPECT_FALSE(q.Empty());
+  EXPECT_EQ(1u, q.Front());
+
+  u32 v;
+  EXPECT_TRUE(q.Pop(v));
+  EXPECT_EQ(1u, v);
+  EXPECT_EQ(0u, q.Size());
+  EXPECT_TRUE(q.Empty());
+  EXPECT_FALSE(q.Pop(v));
+
+  // Test the FIFO order.
+  for (int round = 0; round < 3; ++round)
+  {
+    for (u32 i = 0; i < 1000; ++i)
+      q.Push(i);
+    EXPECT_EQ(1000u, q.Size());
+    for (u32 i = 0; i < 1000; ++i)
+    {
+      u32 v2;
+      EXPECT_TRUE(q.Pop(v2));
+      EXPECT_EQ(i, v2);
+    }
+    EXPECT_TRUE(q.Empty());
+  }
+
+  for (u32 i = 0; i < 1000; ++i)
+    q.Push(i);
+  EXPECT_FALSE(q.Empty());
+  q.Clear();
+  EXPECT_TRUE(q.Empty());
+  q.Push(5);
+  EXPECT_EQ(5u, q.Front());
+}
+
+TEST(SPSCSegmentedQueue, Batch)
+{
+  Common::SPSCSegmentedQueue<u32, true, 4> q;
+
+  std::vector<u32> values(10);
+  for (u32 i = 0; i < values.size(); ++i)
+    values[i] = i;
+  q.PushBatch(values.begin(), values.end());
+  q.PushBatch(values.begin(), values.begin());
+  EXPECT_EQ(10u, q.Size());
+
+  std::vector<u32> popped;
+  EXPECT_EQ(7u, q.PopBatch(std::back_inserter(popped), 7));
+  EXPECT_EQ(3u, q.PopBatch(std::back_inserter(popped), 7));
+  EXPECT_EQ(0u, q.PopBatch(std::back_inserter(popped), 7));
+  EXPECT_EQ(values, popped);
+  EXPECT_TRUE(q.Empty());
+}
+
+TEST(SPSCSegmentedQueue, ReleasesPoppedElements)
+{
+  Common::SPSCSegmentedQueue<std::shared_ptr<u32>, false, 4> q;
+  const auto value = std::make_shared<u32>(1);
+
+  q.Push(value);
+  q.Push(value);
+  EXPECT_EQ(3, value.use_count());
+  q.Pop();
+  EXPECT_EQ(2, value.use_count());
+  std::shared_ptr<u32> popped;
+  q.Pop(popped);
+  popped.reset();
+  EXPECT_EQ(1, value.use_count());
+}
+
+TEST(SPSCSegmentedQueue, MultiThreaded)
+{
+  Common::SPSCSegmentedQueue<u32, true, 16> q;
+
+  auto inserter = [&q]() {
+    for (u32 i = 0; i < 100000; i += 10)
+    {
+      if (i % 20 == 0)
+      {
+        for (u32 j = i; j < i + 10; ++j)
+          q.Push(j);
+      }
+      else
+      {
+        std::vector<u32> values(10);
+        for (u32 j = 0; j < 10; ++j)
+          values[j] = i + j;
+        q.PushBatch(values.begin(), values.end());
+      }
+    }
+  };
+
+  auto popper = [&q]() {
+    for (u32 i = 0; i < 100000; ++i)
+    {
+      while (q.Empty())
+        ;
+      u32 v;
+      q.Pop(v);
+      EXPECT_EQ(i, v);
+    }
+  };
+
+  std::thread popper_thread(popper);
+  std::thread inserter_thread(inserter);
+
+  popper_thread.join();
+  inserter_thread.join();
+}
@@ -0,0 +1,118 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "Common/Event.h"
+#include "Common/TaskScheduler.h"
+
+TEST(TaskScheduler, RunsAllTasks)
+{
+  std::atomic<u32> count = 0;
+  {
+    Common::TaskScheduler scheduler(4);
+    EXPECT_EQ(4u, scheduler.GetThreadCount());
+    for (u32 i = 0; i < 1000; ++i)
+    {
+      scheduler.Schedule(static_cast<Common::TaskPriority>(i % 3), [&count] { ++count; });
+    }
+  }
+  EXPECT_EQ(1000u, count.load());
+}
+
+TEST(TaskScheduler, TasksCanScheduleTasks)
+{
+  std::atomic<u32> count = 0;
+  Common::TaskScheduler scheduler(2);
+  Common::TaskGroup group(scheduler, Common::TaskPriority::Normal);
+  for (u32 i = 0; i < 10; ++i)
+  {
+    group.Schedule([&] {
+      for (u32 j = 0; j < 10; ++j)
+        group.Schedule([&count] { ++count; });
+    });
+  }
+  group.Wait();
+  EXPECT_EQ(100u, count.load());
+}
+
+TEST(TaskScheduler, HigherPriorityFirst)
+{
+  Common::TaskScheduler scheduler(1);
+  Common::Event started;
+  Common::Event release;
+  std::vector<Common::TaskPriority> order;
+
+  Common::TaskGroup group(scheduler, Common::TaskPriority::Normal);
+  group.Schedule([&] {
+    started.Set();
+    release.Wait();
+  });
+  started.Wait();
+
+  // The only worker is busy, so all of these are queued before any of them runs.
+  for (const auto priority : {Common::TaskPriority::Background, Common::TaskPriority::Normal,
+                              Common::TaskPriority::High})
+  {
+    scheduler.Schedule(priority, [&order, priority] { order.push_back(priority); });
+  }
+  release.Set();
+
+  // With a single worker, this runs after all the tasks above.
+  Common::TaskGroup last(scheduler, Common::TaskPriority::Background);
+  last.Schedule([] {});
+  last.Wait();
+  EXPECT_EQ(order, (std::vector<Common::TaskPriority>{Common::TaskPriority::High,
+                                                      Common::TaskPriority::Normal,
+                                                      Common::TaskPriority::Background}));
+}
+
+TEST(TaskGroup, CancelDropsQueuedTasks)
+{
+  Common::TaskScheduler scheduler(1);
+  Common::Event started;
+  Common::Event release;
+  std::atomic<u32> count = 0;
+
+  Common::TaskGroup group(scheduler, Common::TaskPriority::Normal);
+  group.Schedule([&] {
+    started.Set();
+    release.Wait();
+    ++count;
+  });
+  started.Wait();
+  for (u32 i = 0; i < 10; ++i)
+    group.Schedule([&count] { ++count; });
+
+  group.Cancel();
+  release.Set();
+  group.Wait();
+  EXPECT_EQ(1u, count.load());
+
+  // The group can still be used after cancelling.
+  group.Schedule([&count] { ++count; });
+  group.Wait();
+  EXPECT_EQ(2u, count.load());
+}
+
+TEST(TaskGroup, DestructorWaitsForRunningTasks)
+{
+  Common::TaskScheduler scheduler(2);
+  std::atomic<bool> done = false;
+  {
+    Common::Event started;
+    Common::TaskGroup group(scheduler, Common::TaskPriority::Background);
+    group.Schedule([&] {
+      started.Set();
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      done = true;
+    });
+    started.Wait();
+  }
+  EXPECT_TRUE(done.load());
+}
@@ -0,0 +1,69 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "Common/FileUtil.h"
+#include "Common/Tracing.h"
+
+class TracingTest : public testing::Test
+{
+protected:
+  TracingTest() : m_directory(File::CreateTempDir()) {}
+
+  ~TracingTest() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override
+  {
+    if (m_directory.empty())
+      FAIL();
+  }
+
+  const std::string m_directory;
+};
+
+TEST_F(TracingTest, WritesRecordedEvents)
+{
+  const std::string path = m_directory + "/trace.json";
+
+  // Events outside of a trace are ignored
+  Common::Tracing::AddEvent("test", "Ignored", 0, 1);
+  EXPECT_FALSE(Common::Tracing::IsEnabled());
+
+  Common::Tracing::Start(path);
+  EXPECT_TRUE(Common::Tracing::IsEnabled());
+  {
+    Common::Tracing::ScopedEvent event("test", "Scope");
+  }
+  Common::Tracing::AddEvent("test", "Quote \" and \\", Common::Timer::NowUs(), 5);
+  ASSERT_TRUE(Common::Tracing::Stop());
+  EXPECT_FALSE(Common::Tracing::IsEnabled());
+
+  std::string trace;
+  ASSERT_TRUE(File::ReadFileToString(path, trace));
+  EXPECT_TRUE(trace.starts_with("{\"traceEvents\":["));
+  EXPECT_NE(std::string::npos, trace.find("\"name\":\"Scope\",\"cat\":\"test\",\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, trace.find("\"name\":\"Quote \\\" and \\\\\""));
+  EXPECT_NE(std::string::npos, trace.find("\"dur\":5,"));
+  EXPECT_EQ(std::string::npos, trace.find("Ignored"));
+}
+
+TEST_F(TracingTest, ScopesOpenedBeforeTheTraceAreIgnored)
+{
+  const std::string path = m_directory + "/trace.json";
+  {
+    Common::Tracing::ScopedEvent event("test", "Early");
+    Common::Tracing::Start(path);
+  }
+  ASSERT_TRUE(Common::Tracing::Stop());
+
+  std::string trace;
+  ASSERT_TRUE(File::ReadFileToString(path, trace));
+  EXPECT_EQ(std::string::npos, trace.find("Early"));
+}
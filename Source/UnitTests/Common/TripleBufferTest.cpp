@@ -0,0 +1,65 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "Common/TripleBuffer.h"
+
+TEST(TripleBuffer, Simple)
+{
+  Common::TripleBuffer<u32> buffer;
+
+  EXPECT_FALSE(buffer.Update());
+  EXPECT_EQ(0u, buffer.GetReadBuffer());
+
+  buffer.GetWriteBuffer() = 1;
+  buffer.Publish();
+  EXPECT_TRUE(buffer.Update());
+  EXPECT_EQ(1u, buffer.GetReadBuffer());
+  EXPECT_FALSE(buffer.Update());
+  EXPECT_EQ(1u, buffer.GetReadBuffer());
+
+  // Only the latest value is read
+  for (u32 i = 2; i < 10; ++i)
+  {
+    buffer.GetWriteBuffer() = i;
+    buffer.Publish();
+  }
+  EXPECT_TRUE(buffer.Update());
+  EXPECT_EQ(9u, buffer.GetReadBuffer());
+  EXPECT_FALSE(buffer.Update());
+}
+
+TEST(TripleBuffer, MultiThread)
+{
+  struct Value
+  {
+    u32 a;
+    u32 b;
+  };
+  Common::TripleBuffer<Value> buffer;
+  constexpr u32 COUNT = 1000000;
+
+  std::thread writer([&buffer] {
+    for (u32 i = 1; i <= COUNT; ++i)
+    {
+      buffer.GetWriteBuffer() = {i, ~i};
+      buffer.Publish();
+    }
+  });
+
+  // Values are never torn and never go back in time
+  u32 last = 0;
+  while (last != COUNT)
+  {
+    if (!buffer.Update())
+      continue;
+    const Value& value = buffer.GetReadBuffer();
+    EXPECT_EQ(~value.a, value.b);
+    EXPECT_GT(value.a, last);
+    last = value.a;
+  }
+
+  writer.join();
+}
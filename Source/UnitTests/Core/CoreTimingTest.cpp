@@ -6,6 +6,8 @@
 #include <array>
 #include <bitset>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
@@ -180,6 +182,50 @@ TEST(CoreTiming, SharedSlot)
   EXPECT_EQ(0x1FULL, s_callbacks_ran_flags.to_ullong());
 }
 
+TEST(CoreTiming, RemoveEvent)
+{
+  auto& system = Core::System::GetInstance();
+
+  ScopeInit guard(system);
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  auto& core_timing = system.GetCoreTiming();
+  auto& ppc_state = system.GetPPCState();
+
+  CoreTiming::EventType* cb_a = core_timing.RegisterEvent("callbackA", CallbackTemplate<0>);
+  CoreTiming::EventType* cb_b = core_timing.RegisterEvent("callbackB", CallbackTemplate<1>);
+  CoreTiming::EventType* cb_c = core_timing.RegisterEvent("callbackC", CallbackTemplate<2>);
+  CoreTiming::EventType* cb_d = core_timing.RegisterEvent("callbackD", CallbackTemplate<3>);
+
+  // Enter slice 0
+  core_timing.Advance();
+
+  core_timing.ScheduleEvent(100, cb_a, CB_IDS[0]);
+  core_timing.ScheduleEvent(200, cb_b, CB_IDS[1]);
+  core_timing.ScheduleEvent(300, cb_c, CB_IDS[2]);
+  core_timing.ScheduleEvent(250, cb_d, CB_IDS[3]);
+  core_timing.RemoveEvent(cb_d);
+
+  // Rescheduling a removed event must only run the new instance.
+  core_timing.RemoveEvent(cb_b);
+  core_timing.ScheduleEvent(250, cb_b, CB_IDS[1]);
+  EXPECT_EQ(100, ppc_state.downcount);
+
+  AdvanceAndCheck(system, 0, 150);
+  AdvanceAndCheck(system, 1, 50);
+  AdvanceAndCheck(system, 2, MAX_SLICE_LENGTH);
+
+  // Events removed from the front of the queue must not shorten the slice.
+  core_timing.ScheduleEvent(100, cb_d, CB_IDS[3]);
+  core_timing.ScheduleEvent(1000, cb_a, CB_IDS[0]);
+  core_timing.RemoveEvent(cb_d);
+  s_callbacks_ran_flags = 0;
+  ppc_state.downcount = 0;
+  core_timing.Advance();
+  EXPECT_EQ(0U, s_callbacks_ran_flags.to_ulong());
+  EXPECT_EQ(900, ppc_state.downcount);
+}
+
 TEST(CoreTiming, PredictableLateness)
 {
   auto& system = Core::System::GetInstance();
@@ -327,6 +373,58 @@ TEST(CoreTiming, ScheduleIntoPast)
   AdvanceAndCheck(system, 0, MAX_SLICE_LENGTH, 1000);
 }
 
+namespace ScheduleFromManyThreadsTest
+{
+static u64 s_num_callbacks = 0;
+
+static void CountingCallback(Core::System& system, u64 userdata, s64 lateness)
+{
+  ++s_num_callbacks;
+}
+}  // namespace ScheduleFromManyThreadsTest
+
+TEST(CoreTiming, ScheduleFromManyThreads)
+{
+  using namespace ScheduleFromManyThreadsTest;
+
+  constexpr u32 NUM_THREADS = 4;
+  constexpr u32 NUM_EVENTS_PER_THREAD = 10000;
+
+  auto& system = Core::System::GetInstance();
+
+  ScopeInit guard(system);
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  auto& core_timing = system.GetCoreTiming();
+  auto& ppc_state = system.GetPPCState();
+
+  CoreTiming::EventType* cb = core_timing.RegisterEvent("callbackCount", CountingCallback);
+  s_num_callbacks = 0;
+
+  // Enter slice 0
+  core_timing.Advance();
+
+  std::vector<std::thread> threads;
+  for (u32 i = 0; i < NUM_THREADS; ++i)
+  {
+    threads.emplace_back([&core_timing, cb]() {
+      for (u32 j = 0; j < NUM_EVENTS_PER_THREAD; ++j)
+        core_timing.ScheduleEvent(0, cb, 0, CoreTiming::FromThread::NON_CPU);
+    });
+  }
+
+  // Drain the queue from the CPU thread while the other threads are still scheduling events.
+  for (u32 i = 0; i < NUM_THREADS * NUM_EVENTS_PER_THREAD / 100; ++i)
+    core_timing.MoveEvents();
+
+  for (std::thread& thread : threads)
+    thread.join();
+
+  ppc_state.downcount = 0;
+  core_timing.Advance();
+  EXPECT_EQ(NUM_THREADS * NUM_EVENTS_PER_THREAD, s_num_callbacks);
+}
+
 TEST(CoreTiming, Overclocking)
 {
   auto& system = Core::System::GetInstance();
@@ -0,0 +1,62 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/DSPHLE/UCodes/AXMix.h"
+
+TEST(AXMix, MatchesScalar)
+{
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<int> sample_dist(-32768, 32767);
+  std::uniform_int_distribution<int> u16_dist(0, 0xFFFF);
+
+  // Odd counts cover the scalar tail after the SIMD loop
+  for (u32 count : {0u, 1u, 3u, 4u, 7u, 32u, 95u, 96u})
+  {
+    for (int iteration = 0; iteration < 100; ++iteration)
+    {
+      std::array<s16, 96> input;
+      std::array<int, 96> out;
+      for (size_t i = 0; i < input.size(); ++i)
+      {
+        input[i] = static_cast<s16>(sample_dist(rng));
+        out[i] = sample_dist(rng);
+      }
+      std::array<int, 96> expected_out = out;
+
+      u16 volume = static_cast<u16>(u16_dist(rng));
+      u16 expected_volume = volume;
+      // Also test close to wrapping around, and without ramping
+      const u16 volume_delta = iteration % 4 == 0 ? 0 : static_cast<u16>(u16_dist(rng));
+      s16 dpop = 1;
+      s16 expected_dpop = 1;
+
+      DSP::HLE::MixAddWithVolumeRamp(out.data(), input.data(), count, &volume, volume_delta,
+                                     &dpop);
+      DSP::HLE::MixAddWithVolumeRampScalar(expected_out.data(), input.data(), count,
+                                           &expected_volume, volume_delta, &expected_dpop);
+
+      EXPECT_EQ(expected_out, out);
+      EXPECT_EQ(expected_volume, volume);
+      EXPECT_EQ(expected_dpop, dpop);
+    }
+  }
+}
+
+TEST(AXMix, Saturates)
+{
+  const std::array<s16, 4> input{-32768, 32767, -32768, 32767};
+  std::array<int, 4> out{};
+  u16 volume = 0xFFFF;
+  s16 dpop = 0;
+
+  DSP::HLE::MixAddWithVolumeRamp(out.data(), input.data(), 4, &volume, 0, &dpop);
+
+  EXPECT_EQ((std::array<int, 4>{-32767, 32767, -32767, 32767}), out);
+  EXPECT_EQ(32767, dpop);
+}
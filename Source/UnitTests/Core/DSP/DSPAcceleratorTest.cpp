@@ -185,3 +185,49 @@ TEST(DSPAccelerator, CurrentAddressSkips)
   accelerator.TestRead();
   EXPECT_EQ(accelerator.GetCurrentAddress(), 0x00000013u);
 }
+
+// Accelerator backed by memory filled with a pattern, so that decoding produces varied samples.
+class PatternAccelerator final : public DSP::Accelerator
+{
+protected:
+  void OnEndException() override {}
+  u8 ReadMemory(u32 address) override { return static_cast<u8>(address * 0x9d + (address >> 5)); }
+  void WriteMemory(u32 address, u8 value) override {}
+};
+
+TEST(DSPAccelerator, ReadSamplesMatchesRead)
+{
+  constexpr std::array<s16, 16> coefs{0x04ab, -0x0200, 0x0800, 0x0100, -0x0400, 0x0300, 0x0600,
+                                      -0x0100, 0x0123, 0x0456, -0x0789, 0x0abc, 0x0111, -0x0222,
+                                      0x0333, -0x0444};
+
+  for (const u16 format : {0x00, 0x0A, 0x19})
+  {
+    PatternAccelerator single;
+    PatternAccelerator bulk;
+    for (PatternAccelerator* accelerator : {&single, &bulk})
+    {
+      accelerator->SetSampleFormat(format);
+      accelerator->SetStartAddress(0x00000102);
+      accelerator->SetEndAddress(0x00000177);
+      accelerator->SetCurrentAddress(0x00000102);
+      accelerator->SetPredScale(0x23);
+      accelerator->SetYn1(0);
+      accelerator->SetYn2(0);
+    }
+
+    // Long enough to hit the end address and stop reading.
+    std::array<s16, 200> expected;
+    for (s16& sample : expected)
+      sample = static_cast<s16>(single.Read(coefs.data()));
+
+    std::array<s16, 200> samples;
+    bulk.ReadSamples(samples.data(), static_cast<u32>(samples.size()), coefs.data());
+
+    EXPECT_EQ(expected, samples);
+    EXPECT_EQ(single.GetCurrentAddress(), bulk.GetCurrentAddress());
+    EXPECT_EQ(single.GetYn1(), bulk.GetYn1());
+    EXPECT_EQ(single.GetYn2(), bulk.GetYn2());
+    EXPECT_EQ(single.GetPredScale(), bulk.GetPredScale());
+  }
+}
@@ -138,3 +138,26 @@ TEST_F(MappingTest, ReadWriteComplex)
   EXPECT_TRUE(read_called);
   EXPECT_TRUE(write_called);
 }
+
+TEST_F(MappingTest, ReadConditionalDirect)
+{
+  u16 target = 0x1234;
+  bool use_direct = true;
+  bool read_called = false;
+
+  m_mapping->RegisterRead(0x0C001234, MMIO::ConditionalDirectRead<u16>(
+                                          &target, &use_direct,
+                                          [&read_called](Core::System&, u32 addr) {
+                                            EXPECT_EQ(0x0C001234u, addr);
+                                            read_called = true;
+                                            return u16(0x5678);
+                                          },
+                                          0xFF00));
+
+  EXPECT_EQ(0x1200, m_mapping->Read<u16>(*m_system, 0x0C001234));
+  EXPECT_FALSE(read_called);
+
+  use_direct = false;
+  EXPECT_EQ(0x5678, m_mapping->Read<u16>(*m_system, 0x0C001234));
+  EXPECT_TRUE(read_called);
+}
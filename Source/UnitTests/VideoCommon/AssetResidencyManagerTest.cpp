@@ -0,0 +1,126 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "VideoCommon/Assets/AssetResidencyManager.h"
+#include "VideoCommon/Assets/CustomAsset.h"
+
+using VideoCommon::AssetResidencyManager;
+using VideoCommon::CustomAsset;
+
+namespace
+{
+class TestAsset final : public CustomAsset
+{
+public:
+  TestAsset() : CustomAsset(nullptr, "test") {}
+
+private:
+  VideoCommon::CustomAssetLibrary::LoadInfo LoadImpl(const std::string&) override { return {}; }
+  void UnloadImpl() override {}
+};
+
+std::vector<std::shared_ptr<CustomAsset>> MakeAssets(size_t count)
+{
+  std::vector<std::shared_ptr<CustomAsset>> assets(count);
+  for (auto& asset : assets)
+    asset = std::make_shared<TestAsset>();
+  return assets;
+}
+
+void LoadAll(AssetResidencyManager* residency, size_t bytes)
+{
+  while (const auto asset = residency->PopNextLoad())
+    EXPECT_TRUE(residency->OnLoaded(asset.get(), bytes).empty());
+}
+}  // namespace
+
+TEST(AssetResidencyManager, LoadsMostRecentlyRequestedFirst)
+{
+  const auto assets = MakeAssets(3);
+  AssetResidencyManager residency;
+  EXPECT_TRUE(residency.Request(assets[0]));
+  EXPECT_TRUE(residency.Request(assets[1]));
+  EXPECT_TRUE(residency.Request(assets[2]));
+
+  // Requesting a queued asset again raises its priority without queuing it twice
+  EXPECT_FALSE(residency.Request(assets[0]));
+  EXPECT_EQ(3u, residency.GetQueuedCount());
+
+  EXPECT_EQ(assets[0], residency.PopNextLoad());
+  EXPECT_EQ(assets[2], residency.PopNextLoad());
+  EXPECT_EQ(assets[1], residency.PopNextLoad());
+  EXPECT_EQ(nullptr, residency.PopNextLoad());
+
+  // Assets that are loading or failed to load aren't queued again
+  EXPECT_FALSE(residency.Request(assets[0]));
+  residency.OnLoadFailed(assets[0].get());
+  EXPECT_FALSE(residency.Request(assets[0]));
+  EXPECT_EQ(nullptr, residency.PopNextLoad());
+}
+
+TEST(AssetResidencyManager, EvictsLeastRecentlyUsed)
+{
+  const auto assets = MakeAssets(4);
+  AssetResidencyManager residency;
+  residency.SetMemoryBudget(300);
+  for (size_t i = 0; i < 3; ++i)
+    residency.Request(assets[i]);
+  LoadAll(&residency, 100);
+  EXPECT_EQ(300u, residency.GetResidentBytes());
+
+  // Using an asset protects it from eviction
+  residency.MarkUsed(assets[0].get());
+
+  EXPECT_TRUE(residency.Request(assets[3]));
+  const auto asset = residency.PopNextLoad();
+  EXPECT_EQ(assets[3], asset);
+  const auto evicted = residency.OnLoaded(asset.get(), 100);
+  ASSERT_EQ(1u, evicted.size());
+  EXPECT_EQ(assets[1], evicted[0]);
+  EXPECT_EQ(300u, residency.GetResidentBytes());
+
+  // Evicted assets are loaded again when they are requested
+  EXPECT_TRUE(residency.Request(assets[1]));
+  EXPECT_FALSE(residency.Request(assets[0]));
+}
+
+TEST(AssetResidencyManager, EvictsLoadedAssetIfOthersAreMoreRecent)
+{
+  const auto assets = MakeAssets(2);
+  AssetResidencyManager residency;
+  residency.SetMemoryBudget(100);
+  residency.Request(assets[0]);
+  residency.Request(assets[1]);
+
+  const auto first = residency.PopNextLoad();
+  EXPECT_TRUE(residency.OnLoaded(first.get(), 100).empty());
+  residency.MarkUsed(first.get());
+
+  const auto second = residency.PopNextLoad();
+  const auto evicted = residency.OnLoaded(second.get(), 100);
+  ASSERT_EQ(1u, evicted.size());
+  EXPECT_EQ(second, evicted[0]);
+  EXPECT_EQ(100u, residency.GetResidentBytes());
+}
+
+TEST(AssetResidencyManager, RemovesDestroyedAssets)
+{
+  auto assets = MakeAssets(2);
+  AssetResidencyManager residency;
+  residency.Request(assets[0]);
+  residency.Request(assets[1]);
+  LoadAll(&residency, 100);
+
+  residency.Remove(assets[0].get());
+  EXPECT_EQ(100u, residency.GetResidentBytes());
+
+  // A queued asset that was destroyed without being removed is skipped
+  residency.Request(assets[0]);
+  assets[0].reset();
+  EXPECT_EQ(nullptr, residency.PopNextLoad());
+}
@@ -0,0 +1,211 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/IndexGenerator.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VideoConfig.h"
+
+using OpcodeDecoder::Primitive;
+
+namespace
+{
+constexpr u16 PRIMITIVE_RESTART = UINT16_MAX;
+constexpr size_t INDEX_BUFFER_SIZE = 65536 * 4;
+
+using Triangle = std::array<u16, 3>;
+
+// Rotates a triangle to start with its lowest index, which keeps its winding.
+Triangle Normalize(Triangle triangle)
+{
+  std::ranges::rotate(triangle, std::ranges::min_element(triangle));
+  return triangle;
+}
+
+void AddExpectedTriangles(std::vector<Triangle>* triangles, Primitive primitive, u32 num_vertices,
+                          u32 base)
+{
+  const auto add = [&](u32 a, u32 b, u32 c) {
+    triangles->push_back(Normalize(
+        {static_cast<u16>(base + a), static_cast<u16>(base + b), static_cast<u16>(base + c)}));
+  };
+
+  switch (primitive)
+  {
+  case Primitive::GX_DRAW_QUADS:
+  case Primitive::GX_DRAW_QUADS_2:
+    for (u32 i = 3; i < num_vertices; i += 4)
+    {
+      add(i - 3, i - 2, i - 1);
+      add(i - 3, i - 1, i);
+    }
+    if (num_vertices % 4 == 3)
+      add(num_vertices - 3, num_vertices - 2, num_vertices - 1);
+    break;
+  case Primitive::GX_DRAW_TRIANGLES:
+    for (u32 i = 2; i < num_vertices; i += 3)
+      add(i - 2, i - 1, i);
+    break;
+  case Primitive::GX_DRAW_TRIANGLE_STRIP:
+    for (u32 i = 2; i < num_vertices; ++i)
+    {
+      if (i % 2 == 0)
+        add(i - 2, i - 1, i);
+      else
+        add(i - 2, i, i - 1);
+    }
+    break;
+  case Primitive::GX_DRAW_TRIANGLE_FAN:
+    for (u32 i = 2; i < num_vertices; ++i)
+      add(0, i - 1, i);
+    break;
+  default:
+    break;
+  }
+}
+
+// Turns lists of triangles, or triangle strips separated by primitive restarts, into triangles.
+std::vector<Triangle> DecodeTriangles(const u16* indices, u32 num_indices, bool primitive_restart)
+{
+  std::vector<Triangle> triangles;
+  if (!primitive_restart)
+  {
+    for (u32 i = 0; i + 2 < num_indices; i += 3)
+      triangles.push_back(Normalize({indices[i], indices[i + 1], indices[i + 2]}));
+    return triangles;
+  }
+
+  u32 strip_start = 0;
+  for (u32 i = 0; i <= num_indices; ++i)
+  {
+    if (i != num_indices && indices[i] != PRIMITIVE_RESTART)
+      continue;
+
+    for (u32 j = strip_start; j + 2 < i; ++j)
+    {
+      if ((j - strip_start) % 2 == 0)
+        triangles.push_back(Normalize({indices[j], indices[j + 1], indices[j + 2]}));
+      else
+        triangles.push_back(Normalize({indices[j], indices[j + 2], indices[j + 1]}));
+    }
+    strip_start = i + 1;
+  }
+  return triangles;
+}
+
+class IndexGeneratorTest : public testing::Test
+{
+protected:
+  void Init(bool primitive_restart)
+  {
+    g_Config.backend_info.bSupportsPrimitiveRestart = primitive_restart;
+    g_Config.backend_info.bSupportsVSLinePointExpand = false;
+    m_generator.Init();
+    m_generator.Start(m_indices.data());
+  }
+
+  std::vector<u16> m_indices = std::vector<u16>(INDEX_BUFFER_SIZE);
+  IndexGenerator m_generator;
+};
+
+class IndexGeneratorTriangleTest
+    : public IndexGeneratorTest,
+      public testing::WithParamInterface<std::tuple<Primitive, bool>>
+{
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    PrimitivesAndRestart, IndexGeneratorTriangleTest,
+    testing::Combine(testing::Values(Primitive::GX_DRAW_QUADS, Primitive::GX_DRAW_TRIANGLES,
+                                     Primitive::GX_DRAW_TRIANGLE_STRIP,
+                                     Primitive::GX_DRAW_TRIANGLE_FAN),
+                     testing::Bool()));
+}  // namespace
+
+TEST_P(IndexGeneratorTriangleTest, MatchesPrimitive)
+{
+  const auto [primitive, primitive_restart] = GetParam();
+
+  // Covers everything up to several groups of indices, each starting at a different base index.
+  for (u32 num_vertices = 0; num_vertices < 150; ++num_vertices)
+  {
+    Init(primitive_restart);
+    std::vector<Triangle> expected;
+    AddExpectedTriangles(&expected, primitive, 5, 0);
+    m_generator.AddIndices(primitive, 5);
+    AddExpectedTriangles(&expected, primitive, num_vertices, 5);
+    m_generator.AddIndices(primitive, num_vertices);
+
+    EXPECT_EQ(DecodeTriangles(m_indices.data(), m_generator.GetIndexLen(), primitive_restart),
+              expected)
+        << "with " << num_vertices << " vertices";
+    EXPECT_EQ(m_generator.GetNumVerts(), 5 + num_vertices);
+  }
+}
+
+TEST_F(IndexGeneratorTest, Lines)
+{
+  for (u32 num_vertices = 0; num_vertices < 100; ++num_vertices)
+  {
+    Init(false);
+    m_generator.AddIndices(Primitive::GX_DRAW_LINES, num_vertices);
+    m_generator.AddIndices(Primitive::GX_DRAW_LINE_STRIP, num_vertices);
+
+    std::vector<u16> expected;
+    for (u32 i = 1; i < num_vertices; i += 2)
+      expected.insert(expected.end(), {static_cast<u16>(i - 1), static_cast<u16>(i)});
+    for (u32 i = 1; i < num_vertices; ++i)
+    {
+      expected.insert(expected.end(), {static_cast<u16>(num_vertices + i - 1),
+                                       static_cast<u16>(num_vertices + i)});
+    }
+
+    EXPECT_EQ(std::vector<u16>(m_indices.begin(), m_indices.begin() + m_generator.GetIndexLen()),
+              expected)
+        << "with " << num_vertices << " vertices";
+  }
+}
+
+TEST_F(IndexGeneratorTest, Points)
+{
+  for (u32 num_vertices = 0; num_vertices < 100; ++num_vertices)
+  {
+    Init(false);
+    m_generator.AddIndices(Primitive::GX_DRAW_POINTS, 3);
+    m_generator.AddIndices(Primitive::GX_DRAW_POINTS, num_vertices);
+
+    ASSERT_EQ(m_generator.GetIndexLen(), 3 + num_vertices);
+    for (u32 i = 0; i < 3 + num_vertices; ++i)
+      EXPECT_EQ(m_indices[i], i);
+  }
+}
+
+class IndexGeneratorSpeedTest : public IndexGeneratorTest,
+                                public testing::WithParamInterface<std::tuple<Primitive, bool>>
+{
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    PrimitivesAndRestart, IndexGeneratorSpeedTest,
+    testing::Combine(testing::Values(Primitive::GX_DRAW_QUADS, Primitive::GX_DRAW_TRIANGLES,
+                                     Primitive::GX_DRAW_TRIANGLE_STRIP,
+                                     Primitive::GX_DRAW_TRIANGLE_FAN,
+                                     Primitive::GX_DRAW_LINE_STRIP),
+                     testing::Bool()));
+
+TEST_P(IndexGeneratorSpeedTest, LargePrimitive)
+{
+  const auto [primitive, primitive_restart] = GetParam();
+  for (int i = 0; i < 1000; ++i)
+  {
+    Init(primitive_restart);
+    m_generator.AddIndices(primitive, 60000);
+  }
+}
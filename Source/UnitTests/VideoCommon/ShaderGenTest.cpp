@@ -0,0 +1,85 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <string>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/PixelShaderGen.h"
+#include "VideoCommon/ShaderGenCommon.h"
+#include "VideoCommon/VideoCommon.h"
+
+namespace
+{
+pixel_shader_uid_data MakeUid(u32 num_stages, u32 num_texgens)
+{
+  pixel_shader_uid_data uid_data{};
+  uid_data.genMode_numtevstages = num_stages - 1;
+  uid_data.genMode_numtexgens = num_texgens;
+  uid_data.numColorChans = 2;
+  for (u32 i = 0; i < num_stages; ++i)
+  {
+    uid_data.stagehash[i].cc = 0x8fff0 + i;
+    uid_data.stagehash[i].ac = 0x8fff0 + i;
+    uid_data.stagehash[i].tevorders_enable = num_texgens != 0;
+    uid_data.stagehash[i].tevorders_texcoord = num_texgens != 0 ? i % num_texgens : 0;
+    uid_data.stagehash[i].tevorders_texmap = i % 8;
+  }
+  return uid_data;
+}
+
+std::string GenerateHeader(const ShaderHostConfig& host_config, bool bounding_box)
+{
+  ShaderCode out;
+  WritePixelShaderCommonHeader(out, APIType::Vulkan, host_config, bounding_box, {});
+  return out.GetBuffer();
+}
+}  // namespace
+
+TEST(PixelShaderGen, CommonHeaderDependsOnConfig)
+{
+  ShaderHostConfig host_config{};
+  const std::string header = GenerateHeader(host_config, false);
+  EXPECT_EQ(GenerateHeader(host_config, false), header);
+  EXPECT_NE(GenerateHeader(host_config, true), header);
+
+  host_config.per_pixel_lighting = true;
+  EXPECT_NE(GenerateHeader(host_config, false), header);
+}
+
+TEST(PixelShaderGen, GeneratesSameCode)
+{
+  ShaderHostConfig host_config{};
+  const pixel_shader_uid_data uid_data = MakeUid(4, 2);
+  const std::string code =
+      GeneratePixelShaderCode(APIType::Vulkan, host_config, &uid_data, {}).GetBuffer();
+  EXPECT_FALSE(code.empty());
+  EXPECT_EQ(GeneratePixelShaderCode(APIType::Vulkan, host_config, &uid_data, {}).GetBuffer(),
+            code);
+}
+
+TEST(PixelShaderGen, GenerationSpeed)
+{
+  ShaderHostConfig host_config{};
+  host_config.per_pixel_lighting = true;
+
+  u32 num_shaders = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < 20; ++i)
+  {
+    for (u32 num_stages = 1; num_stages <= 16; ++num_stages)
+    {
+      for (u32 num_texgens = 0; num_texgens <= 8; ++num_texgens)
+      {
+        const pixel_shader_uid_data uid_data = MakeUid(num_stages, num_texgens);
+        GeneratePixelShaderCode(APIType::Vulkan, host_config, &uid_data, {});
+        ++num_shaders;
+      }
+    }
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  fmt::print("{} pixel shaders generated per second\n", num_shaders / elapsed.count());
+}
@@ -0,0 +1,88 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TextureDecoder.h"
+
+namespace
+{
+constexpr std::array<TextureFormat, 10> FORMATS{
+    TextureFormat::I4, TextureFormat::I8, TextureFormat::IA4, TextureFormat::IA8,
+    TextureFormat::RGB565, TextureFormat::RGB5A3, TextureFormat::RGBA8, TextureFormat::C4,
+    TextureFormat::C8, TextureFormat::CMPR};
+
+std::vector<u8> RandomBytes(size_t size)
+{
+  std::mt19937 rng(size);
+  std::vector<u8> data(size);
+  for (u8& byte : data)
+    byte = static_cast<u8>(rng());
+  return data;
+}
+
+std::vector<u8> Decode(const std::vector<u8>& src, const std::vector<u8>& tlut, int width,
+                       int height, TextureFormat format, bool parallel)
+{
+  std::vector<u8> dst(width * height * sizeof(u32));
+  if (parallel)
+    TexDecoder_DecodeParallel(dst.data(), src.data(), width, height, format, tlut.data(),
+                              TLUTFormat::RGB5A3);
+  else
+    TexDecoder_Decode(dst.data(), src.data(), width, height, format, tlut.data(),
+                      TLUTFormat::RGB5A3);
+  return dst;
+}
+}  // namespace
+
+TEST(TextureDecoder, ParallelMatchesSerial)
+{
+  constexpr int width = 1024;
+  constexpr int height = 1024;
+  const std::vector<u8> src = RandomBytes(width * height * sizeof(u32));
+  const std::vector<u8> tlut = RandomBytes(16384 * sizeof(u16));
+
+  for (TextureFormat format : FORMATS)
+  {
+    EXPECT_EQ(Decode(src, tlut, width, height, format, false),
+              Decode(src, tlut, width, height, format, true))
+        << "format " << static_cast<int>(format);
+  }
+}
+
+#ifdef _M_X86_64
+TEST(TextureDecoder, AVX2MatchesSSSE3)
+{
+  if (!cpu_info.bAVX2 || !cpu_info.bSSSE3)
+    GTEST_SKIP() << "AVX2 is not supported on this CPU";
+
+  // Include a width which is not a multiple of two 4-texel blocks.
+  constexpr std::array<std::array<int, 2>, 3> sizes{{{256, 128}, {20, 8}, {8, 4}}};
+  for (const auto& [width, height] : sizes)
+  {
+    const std::vector<u8> src = RandomBytes(width * height * sizeof(u32));
+    const std::vector<u8> tlut = RandomBytes(16384 * sizeof(u16));
+
+    for (TextureFormat format : FORMATS)
+    {
+      if (width % TexDecoder_GetBlockWidthInTexels(format) != 0 ||
+          height % TexDecoder_GetBlockHeightInTexels(format) != 0)
+      {
+        continue;
+      }
+
+      cpu_info.bAVX2 = false;
+      const std::vector<u8> expected = Decode(src, tlut, width, height, format, false);
+      cpu_info.bAVX2 = true;
+      EXPECT_EQ(expected, Decode(src, tlut, width, height, format, false))
+          << "format " << static_cast<int>(format) << ", " << width << "x" << height;
+    }
+  }
+}
+#endif
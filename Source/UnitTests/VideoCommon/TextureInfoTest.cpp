@@ -0,0 +1,86 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/TextureInfo.h"
+
+namespace
+{
+TextureInfo MakeTextureInfo(const std::vector<u8>& data, const std::vector<u8>& tlut,
+                            TextureFormat format, std::optional<u32> mip_count = std::nullopt)
+{
+  return TextureInfo(0, data, tlut, 0x80000000, format, TLUTFormat::RGB565, 8, 8, false, {}, {},
+                     mip_count);
+}
+
+void ExpectKeysMatchNames(const TextureInfo& texture_info)
+{
+  const auto keys = texture_info.CalculateTextureNameKeys();
+  ASSERT_TRUE(keys.has_value());
+
+  const auto name_details = texture_info.CalculateTextureName();
+  EXPECT_EQ(keys->full, TextureInfo::GetTextureNameKey(name_details.GetFullName()));
+  EXPECT_EQ(keys->wildcard_tlut,
+            TextureInfo::GetTextureNameKey(fmt::format("{}_{}_$_{}", name_details.base_name,
+                                                       name_details.texture_name,
+                                                       name_details.format_name)));
+  EXPECT_EQ(keys->wildcard_texture,
+            TextureInfo::GetTextureNameKey(fmt::format("{}_${}_{}", name_details.base_name,
+                                                       name_details.tlut_name,
+                                                       name_details.format_name)));
+
+  EXPECT_NE(keys->full, keys->wildcard_tlut);
+  EXPECT_NE(keys->full, keys->wildcard_texture);
+  EXPECT_NE(keys->wildcard_tlut, keys->wildcard_texture);
+}
+}  // namespace
+
+TEST(TextureInfo, NameKeysMatchNames)
+{
+  std::vector<u8> data(8 * 8 * 4);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<u8>(i * 7);
+  const std::vector<u8> tlut(256 * 2, 0x55);
+
+  ExpectKeysMatchNames(MakeTextureInfo(data, {}, TextureFormat::RGBA8));
+  ExpectKeysMatchNames(MakeTextureInfo(data, {}, TextureFormat::I8, 1));
+  ExpectKeysMatchNames(MakeTextureInfo(data, tlut, TextureFormat::C8));
+}
+
+TEST(TextureInfo, NameKeysDependOnTexture)
+{
+  std::vector<u8> data(8 * 8 * 4, 1);
+  const auto keys = MakeTextureInfo(data, {}, TextureFormat::RGBA8).CalculateTextureNameKeys();
+  data[0] = 2;
+  const auto other_keys =
+      MakeTextureInfo(data, {}, TextureFormat::RGBA8).CalculateTextureNameKeys();
+  ASSERT_TRUE(keys && other_keys);
+
+  EXPECT_NE(keys->full, other_keys->full);
+  EXPECT_NE(keys->wildcard_tlut, other_keys->wildcard_tlut);
+  EXPECT_EQ(keys->wildcard_texture, other_keys->wildcard_texture);
+}
+
+TEST(TextureInfo, GetTextureNameKeyRejectsOtherNames)
+{
+  EXPECT_TRUE(TextureInfo::GetTextureNameKey("tex1_8x8_0123456789abcdef_6"));
+  EXPECT_TRUE(TextureInfo::GetTextureNameKey("tex1_8x8_m_0123456789abcdef_fedcba9876543210_9"));
+
+  EXPECT_FALSE(TextureInfo::GetTextureNameKey(""));
+  EXPECT_FALSE(TextureInfo::GetTextureNameKey("tex1_8x8"));
+  EXPECT_FALSE(TextureInfo::GetTextureNameKey("tex1_8x8_m"));
+  EXPECT_FALSE(TextureInfo::GetTextureNameKey("tex2_8x8_0123456789abcdef_6"));
+  EXPECT_FALSE(TextureInfo::GetTextureNameKey("tex1_8x8_0123456789ABCDEF_6"));
+  EXPECT_FALSE(TextureInfo::GetTextureNameKey("tex1_8x8_123456789abcdef_6"));
+  EXPECT_FALSE(TextureInfo::GetTextureNameKey("tex1_08x8_0123456789abcdef_6"));
+  EXPECT_FALSE(TextureInfo::GetTextureNameKey("tex1_8x8_$_$_6"));
+  EXPECT_FALSE(TextureInfo::GetTextureNameKey("tex1_8x8_0123456789abcdef_6_mip1"));
+}
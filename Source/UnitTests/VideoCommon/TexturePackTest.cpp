@@ -0,0 +1,145 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "VideoCommon/Assets/TexturePack.h"
+
+namespace
+{
+VideoCommon::CustomTextureData::ArraySlice::Level MakeLevel(AbstractTextureFormat format, u32 width,
+                                                            u32 height, u8 fill)
+{
+  VideoCommon::CustomTextureData::ArraySlice::Level level;
+  level.data.assign(width * height * 4, fill);
+  level.format = format;
+  level.width = width;
+  level.height = height;
+  level.row_length = width;
+  return level;
+}
+
+VideoCommon::CustomTextureData::ArraySlice MakeSlice(
+    std::vector<VideoCommon::CustomTextureData::ArraySlice::Level> levels)
+{
+  VideoCommon::CustomTextureData::ArraySlice slice;
+  slice.m_levels = std::move(levels);
+  return slice;
+}
+}  // namespace
+
+class TexturePackTest : public testing::Test
+{
+protected:
+  TexturePackTest() : m_directory(File::CreateTempDir()), m_filename(m_directory + "/test.dtp") {}
+
+  ~TexturePackTest() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override
+  {
+    if (m_directory.empty())
+      FAIL();
+  }
+
+  const std::string m_directory;
+  const std::string m_filename;
+};
+
+TEST_F(TexturePackTest, WriteAndLoad)
+{
+  VideoCommon::TexturePackWriter writer;
+  ASSERT_TRUE(writer.Open(m_filename));
+  EXPECT_TRUE(writer.AddTexture(
+      "tex1_8x8_0123456789abcdef_5", false,
+      MakeSlice({MakeLevel(AbstractTextureFormat::RGBA8, 8, 8, 0x11),
+                 MakeLevel(AbstractTextureFormat::RGBA8, 4, 4, 0x22)})));
+  EXPECT_TRUE(writer.AddTexture("tex1_4x4_fedcba9876543210_$_14", true,
+                                MakeSlice({MakeLevel(AbstractTextureFormat::BPTC, 4, 4, 0x33)})));
+  EXPECT_FALSE(writer.AddTexture("tex1_8x8_0123456789abcdef_5", true,
+                                 MakeSlice({MakeLevel(AbstractTextureFormat::RGBA8, 1, 1, 0)})));
+  ASSERT_TRUE(writer.Finish());
+
+  const auto pack = VideoCommon::TexturePack::Open(m_filename);
+  ASSERT_NE(nullptr, pack);
+  EXPECT_EQ(2u, pack->GetTextureCount());
+
+  bool has_arbitrary_mipmaps = true;
+  EXPECT_TRUE(pack->FindTexture("tex1_8x8_0123456789abcdef_5", &has_arbitrary_mipmaps));
+  EXPECT_FALSE(has_arbitrary_mipmaps);
+  EXPECT_TRUE(pack->FindTexture("tex1_4x4_fedcba9876543210_$_14", &has_arbitrary_mipmaps));
+  EXPECT_TRUE(has_arbitrary_mipmaps);
+  EXPECT_FALSE(pack->FindTexture("tex1_8x8_0123456789abcdef_6", &has_arbitrary_mipmaps));
+
+  VideoCommon::CustomTextureData::ArraySlice slice;
+  ASSERT_TRUE(pack->LoadTexture("tex1_8x8_0123456789abcdef_5", &slice));
+  ASSERT_EQ(2u, slice.m_levels.size());
+  EXPECT_EQ(AbstractTextureFormat::RGBA8, slice.m_levels[0].format);
+  EXPECT_EQ(8u, slice.m_levels[0].width);
+  EXPECT_EQ(8u, slice.m_levels[0].height);
+  EXPECT_EQ(8u, slice.m_levels[0].row_length);
+  EXPECT_EQ(std::vector<u8>(8 * 8 * 4, 0x11), slice.m_levels[0].data);
+  EXPECT_EQ(4u, slice.m_levels[1].width);
+  EXPECT_EQ(std::vector<u8>(4 * 4 * 4, 0x22), slice.m_levels[1].data);
+
+  ASSERT_TRUE(pack->LoadTexture("tex1_4x4_fedcba9876543210_$_14", &slice));
+  ASSERT_EQ(1u, slice.m_levels.size());
+  EXPECT_EQ(AbstractTextureFormat::BPTC, slice.m_levels[0].format);
+  EXPECT_EQ(std::vector<u8>(4 * 4 * 4, 0x33), slice.m_levels[0].data);
+
+  std::vector<std::pair<std::string, bool>> textures;
+  pack->ForEachTexture([&](std::string_view name, bool arbitrary_mipmaps) {
+    textures.emplace_back(name, arbitrary_mipmaps);
+  });
+  std::ranges::sort(textures);
+  const std::vector<std::pair<std::string, bool>> expected_textures{
+      {"tex1_4x4_fedcba9876543210_$_14", true}, {"tex1_8x8_0123456789abcdef_5", false}};
+  EXPECT_EQ(expected_textures, textures);
+}
+
+TEST_F(TexturePackTest, ManyTextures)
+{
+  VideoCommon::TexturePackWriter writer;
+  ASSERT_TRUE(writer.Open(m_filename));
+  for (u32 i = 0; i < 1000; ++i)
+  {
+    EXPECT_TRUE(writer.AddTexture(
+        "tex1_" + std::to_string(i), false,
+        MakeSlice({MakeLevel(AbstractTextureFormat::RGBA8, 1, 1, static_cast<u8>(i))})));
+  }
+  ASSERT_TRUE(writer.Finish());
+
+  const auto pack = VideoCommon::TexturePack::Open(m_filename);
+  ASSERT_NE(nullptr, pack);
+  for (u32 i = 0; i < 1000; ++i)
+  {
+    VideoCommon::CustomTextureData::ArraySlice slice;
+    ASSERT_TRUE(pack->LoadTexture("tex1_" + std::to_string(i), &slice));
+    ASSERT_EQ(1u, slice.m_levels.size());
+    EXPECT_EQ(std::vector<u8>(4, static_cast<u8>(i)), slice.m_levels[0].data);
+  }
+}
+
+TEST_F(TexturePackTest, RejectsInvalidFiles)
+{
+  EXPECT_EQ(nullptr, VideoCommon::TexturePack::Open(m_filename));
+
+  {
+    File::IOFile file(m_filename, "wb");
+    const std::string data(64, 'x');
+    ASSERT_TRUE(file.WriteString(data));
+  }
+  EXPECT_EQ(nullptr, VideoCommon::TexturePack::Open(m_filename));
+}
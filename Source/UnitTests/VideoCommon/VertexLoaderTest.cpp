@@ -15,8 +15,10 @@
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VertexLoader.h"
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
+#include "VideoCommon/VertexLoaderSpecialized.h"
 
 TEST(VertexLoaderUID, UniqueEnough)
 {
@@ -1065,6 +1067,65 @@ TEST_P(VertexLoaderSkippedTexCoordsTest, SkippedTextures)
   }
 }
 
+TEST_F(VertexLoaderTest, SpecializedMatchesGeneric)
+{
+  m_vtx_desc.low.Position = VertexComponentFormat::Index16;
+  m_vtx_desc.low.Normal = VertexComponentFormat::Index16;
+  m_vtx_desc.low.Color0 = VertexComponentFormat::Index16;
+  m_vtx_desc.high.Tex0Coord = VertexComponentFormat::Index16;
+  m_vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
+  m_vtx_attr.g0.PosFormat = ComponentFormat::Short;
+  m_vtx_attr.g0.PosFrac = 4;
+  m_vtx_attr.g0.NormalElements = NormalComponentCount::N;
+  m_vtx_attr.g0.NormalFormat = ComponentFormat::Byte;
+  m_vtx_attr.g0.Color0Comp = ColorFormat::RGBA8888;
+  m_vtx_attr.g0.Tex0CoordElements = TexComponentCount::ST;
+  m_vtx_attr.g0.Tex0CoordFormat = ComponentFormat::Short;
+  m_vtx_attr.g0.Tex0Frac = 3;
+
+  std::unique_ptr<VertexLoaderBase> specialized =
+      VertexLoaderSpecialized::Create(m_vtx_desc, m_vtx_attr);
+  ASSERT_NE(nullptr, specialized);
+  VertexLoader generic(m_vtx_desc, m_vtx_attr);
+  ASSERT_EQ(generic.m_vertex_size, specialized->m_vertex_size);
+  ASSERT_EQ(generic.m_native_vtx_decl, specialized->m_native_vtx_decl);
+
+  // Every array holds 16 elements of distinct bytes.
+  constexpr u32 NUM_ELEMENTS = 16;
+  for (CPArray array : {CPArray::Position, CPArray::Normal, CPArray::Color0, CPArray::TexCoord0})
+  {
+    u8* const base = input_memory + 0x10000 * (static_cast<u32>(array) + 1);
+    for (u32 i = 0; i < NUM_ELEMENTS * 8; i++)
+      base[i] = static_cast<u8>(i * 37 + static_cast<u32>(array));
+    VertexLoaderManager::cached_arraybases[array] = base;
+    g_main_cp_state.array_strides[array] = 8;
+  }
+
+  // The vertex with the index 0xFFFF is skipped.
+  constexpr int NUM_VERTICES = 20;
+  for (int i = 0; i < NUM_VERTICES; i++)
+  {
+    Input<u16>(i == 5 ? 0xFFFF : i % NUM_ELEMENTS);
+    Input<u16>((i + 3) % NUM_ELEMENTS);
+    Input<u16>((i + 7) % NUM_ELEMENTS);
+    Input<u16>((i + 11) % NUM_ELEMENTS);
+  }
+
+  const u32 output_size = NUM_VERTICES * generic.m_native_vtx_decl.stride;
+  u8* const generic_output = output_memory + output_size;
+  EXPECT_EQ(NUM_VERTICES - 1, generic.RunVertices(input_memory, generic_output, NUM_VERTICES));
+  const auto generic_cache = VertexLoaderManager::position_cache;
+
+  EXPECT_EQ(NUM_VERTICES - 1,
+            specialized->RunVertices(input_memory, output_memory, NUM_VERTICES));
+  EXPECT_EQ(0, memcmp(generic_output, output_memory, output_size));
+  EXPECT_EQ(generic_cache, VertexLoaderManager::position_cache);
+
+  // Formats without a specialised function use the generic loader.
+  m_vtx_desc.low.Color1 = VertexComponentFormat::Direct;
+  EXPECT_EQ(nullptr, VertexLoaderSpecialized::Create(m_vtx_desc, m_vtx_attr));
+}
+
 // For gtest, which doesn't know about our fmt::formatters by default
 static void PrintTo(const VertexComponentFormat& t, std::ostream* os)
 {